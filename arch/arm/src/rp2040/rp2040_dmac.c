@@ -101,6 +101,8 @@ static struct dma_channel_s g_dmach[RP2040_DMA_NCHANNELS];
 static int rp2040_dmac_interrupt(int irq, void *context, void *arg)
 {
   struct dma_channel_s *dmach;
+  dma_callback_t callback;
+  void *cbarg;
   int result = OK;
   unsigned int ch;
   uint32_t stat;
@@ -128,15 +130,19 @@ static int rp2040_dmac_interrupt(int irq, void *context, void *arg)
 
       dmach = &g_dmach[ch];
 
-      /* Call the DMA completion callback */
+      /* Call the DMA completion callback.  It is cleared first, so that the
+       * callback may start the next transfer of the channel.
+       */
 
-      if (dmach->callback)
+      callback        = dmach->callback;
+      cbarg           = dmach->arg;
+      dmach->callback = NULL;
+      dmach->arg      = NULL;
+
+      if (callback)
         {
-          dmach->callback((DMA_HANDLE)dmach, result, dmach->arg);
-          dmach->callback = NULL;
+          callback((DMA_HANDLE)dmach, result, cbarg);
         }
-
-      dmach->arg = NULL;
     }
 
   return OK;
@@ -178,6 +184,10 @@ void weak_function arm_dma_initialize(void)
 
   irq_attach(RP2040_DMA_IRQ_0, rp2040_dmac_interrupt, NULL);
   up_enable_irq(RP2040_DMA_IRQ_0);
+
+#ifdef CONFIG_RP2040_DMAENGINE
+  rp2040_dmaengine_initialize();
+#endif
 }
 
 /****************************************************************************
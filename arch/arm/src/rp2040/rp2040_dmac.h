@@ -334,6 +334,21 @@ void rp2040_dmastop(DMA_HANDLE handle);
 
 uintptr_t rp2040_dma_register(DMA_HANDLE handle, uint16_t offset);
 
+/****************************************************************************
+ * Name: rp2040_dmaengine_initialize
+ *
+ * Description:
+ *   Register the DMAC as the "rp2040" controller of the generic DMA engine
+ *   interface of nuttx/dma/dma.h, for the drivers that use DMA_GET_CHAN()
+ *   and DMA_START() instead of this interface.  Called by
+ *   arm_dma_initialize().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RP2040_DMAENGINE
+void rp2040_dmaengine_initialize(void);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -0,0 +1,488 @@
+/****************************************************************************
+ * arch/arm/src/rp2040/rp2040_dmaengine.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+
+#include "arm_internal.h"
+#include "hardware/rp2040_dma.h"
+
+/* rp2040_dmac.h and nuttx/dma/dma.h both define a dma_callback_t */
+
+#define dma_callback_t rp2040_dmac_callback_t
+#include "rp2040_dmac.h"
+#undef dma_callback_t
+
+#include <nuttx/dma/dma.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The request number of the transfers that are not paced by a peripheral */
+
+#define RP2040_DMA_DREQ_PERMANENT  0x3f
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A channel of the DMA engine interface, bound to a channel of the DMAC */
+
+struct rp2040_dmaengine_s
+{
+  struct dma_chan_s chan;       /* Must be first */
+  DMA_HANDLE        handle;     /* The DMAC channel, NULL if free */
+  dma_config_t      config;     /* The DMAC configuration */
+  unsigned int      direction;  /* DMA_MEM_TO_DEV, ... */
+  dma_callback_t    callback;   /* The callback of the client */
+  FAR void         *arg;        /* The argument of the callback */
+  uintptr_t         dst;        /* The destination of the transfer */
+  uintptr_t         src;        /* The source of the transfer */
+  size_t            len;        /* The length of the transfer */
+  size_t            period;     /* The period of a cyclic transfer, or 0 */
+  size_t            offset;     /* The offset of the running segment */
+  size_t            nbytes;     /* The length of the running segment */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static FAR struct dma_chan_s *
+rp2040_dmaengine_get_chan(FAR struct dma_dev_s *dev, unsigned int ident);
+static void rp2040_dmaengine_put_chan(FAR struct dma_dev_s *dev,
+                                      FAR struct dma_chan_s *chan);
+
+static void rp2040_dmaengine_done(DMA_HANDLE handle, uint8_t status,
+                                  FAR void *arg);
+static int rp2040_dmaengine_config(FAR struct dma_chan_s *chan,
+                                   FAR const struct dma_config_s *cfg);
+static int rp2040_dmaengine_start(FAR struct dma_chan_s *chan,
+                                  dma_callback_t callback, FAR void *arg,
+                                  uintptr_t dst, uintptr_t src, size_t len);
+static int rp2040_dmaengine_start_cyclic(FAR struct dma_chan_s *chan,
+                                         dma_callback_t callback,
+                                         FAR void *arg, uintptr_t dst,
+                                         uintptr_t src, size_t len,
+                                         size_t period_len);
+static int rp2040_dmaengine_stop(FAR struct dma_chan_s *chan);
+static int rp2040_dmaengine_pause(FAR struct dma_chan_s *chan);
+static int rp2040_dmaengine_resume(FAR struct dma_chan_s *chan);
+static size_t rp2040_dmaengine_residual(FAR struct dma_chan_s *chan);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct dma_ops_s g_rp2040_dmaengine_ops =
+{
+  .config       = rp2040_dmaengine_config,
+  .start        = rp2040_dmaengine_start,
+  .start_cyclic = rp2040_dmaengine_start_cyclic,
+  .stop         = rp2040_dmaengine_stop,
+  .pause        = rp2040_dmaengine_pause,
+  .resume       = rp2040_dmaengine_resume,
+  .residual     = rp2040_dmaengine_residual,
+};
+
+static struct dma_dev_s g_rp2040_dmaengine_dev =
+{
+  .get_chan     = rp2040_dmaengine_get_chan,
+  .put_chan     = rp2040_dmaengine_put_chan,
+};
+
+static struct rp2040_dmaengine_s g_rp2040_dmaengine[RP2040_DMA_NCHANNELS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rp2040_dmaengine_get_chan
+ *
+ * Description:
+ *   Allocate any free channel of the DMAC, 'ident' is not used:  The
+ *   requests of the peripherals may be routed to all the channels.
+ *
+ ****************************************************************************/
+
+static FAR struct dma_chan_s *
+rp2040_dmaengine_get_chan(FAR struct dma_dev_s *dev, unsigned int ident)
+{
+  FAR struct rp2040_dmaengine_s *priv = NULL;
+  DMA_HANDLE handle;
+  irqstate_t flags;
+  int i;
+
+  handle = rp2040_dmachannel();
+  if (handle == NULL)
+    {
+      return NULL;
+    }
+
+  /* There are as many slots as channels, so one of them is free */
+
+  flags = enter_critical_section();
+  for (i = 0; i < RP2040_DMA_NCHANNELS; i++)
+    {
+      if (g_rp2040_dmaengine[i].handle == NULL)
+        {
+          priv         = &g_rp2040_dmaengine[i];
+          priv->handle = handle;
+          break;
+        }
+    }
+
+  leave_critical_section(flags);
+
+  DEBUGASSERT(priv != NULL);
+  priv->chan.ops    = &g_rp2040_dmaengine_ops;
+  priv->direction   = DMA_MEM_TO_MEM;
+  priv->config.dreq = RP2040_DMA_DREQ_PERMANENT;
+  priv->config.size = RP2040_DMA_SIZE_BYTE;
+  priv->callback    = NULL;
+  return &priv->chan;
+}
+
+/****************************************************************************
+ * Name: rp2040_dmaengine_put_chan
+ ****************************************************************************/
+
+static void rp2040_dmaengine_put_chan(FAR struct dma_dev_s *dev,
+                                      FAR struct dma_chan_s *chan)
+{
+  FAR struct rp2040_dmaengine_s *priv =
+    (FAR struct rp2040_dmaengine_s *)chan;
+  DMA_HANDLE handle = priv->handle;
+
+  DEBUGASSERT(handle != NULL);
+
+  priv->callback = NULL;
+  priv->handle   = NULL;
+  rp2040_dmafree(handle);
+}
+
+/****************************************************************************
+ * Name: rp2040_dmaengine_segment
+ *
+ * Description:
+ *   Program and start the DMAC channel for 'nbytes' at 'offset' of the
+ *   transfer.
+ *
+ ****************************************************************************/
+
+static void rp2040_dmaengine_segment(FAR struct rp2040_dmaengine_s *priv,
+                                     size_t offset, size_t nbytes)
+{
+  uintptr_t src = priv->src;
+
+  if (priv->direction == DMA_MEM_TO_DEV)
+    {
+      rp2040_txdmasetup(priv->handle, priv->dst, src + offset, nbytes,
+                        priv->config);
+    }
+  else
+    {
+      /* The DMAC increments the write address only, the read address
+       * too if the source is memory.
+       */
+
+      if (priv->direction == DMA_MEM_TO_MEM)
+        {
+          src += offset;
+        }
+
+      rp2040_rxdmasetup(priv->handle, src, priv->dst + offset, nbytes,
+                        priv->config);
+
+      if (priv->direction == DMA_MEM_TO_MEM)
+        {
+          setbits_reg32(RP2040_DMA_CTRL_TRIG_INCR_READ,
+                        rp2040_dma_register(priv->handle,
+                                            RP2040_DMA_AL1_CTRL_OFFSET));
+        }
+    }
+
+  priv->offset = offset;
+  priv->nbytes = nbytes;
+  rp2040_dmastart(priv->handle, rp2040_dmaengine_done, priv);
+}
+
+/****************************************************************************
+ * Name: rp2040_dmaengine_done
+ *
+ * Description:
+ *   The completion of a segment, from the interrupt handler of the DMAC.
+ *   The next period of a cyclic transfer is started before the client is
+ *   called back:  The DMAC has no descriptor ring, so the periods are
+ *   chained in software.
+ *
+ ****************************************************************************/
+
+static void rp2040_dmaengine_done(DMA_HANDLE handle, uint8_t status,
+                                  FAR void *arg)
+{
+  FAR struct rp2040_dmaengine_s *priv = arg;
+  dma_callback_t callback = priv->callback;
+  ssize_t len = priv->nbytes;
+  size_t offset;
+
+  if (callback == NULL)
+    {
+      return;                   /* Stopped */
+    }
+
+  if (status != 0)
+    {
+      priv->callback = NULL;
+      callback(&priv->chan, priv->arg, -(ssize_t)status);
+      return;
+    }
+
+  if (priv->period > 0)
+    {
+      offset = priv->offset + priv->nbytes;
+      if (offset >= priv->len)
+        {
+          offset = 0;
+        }
+
+      rp2040_dmaengine_segment(priv, offset,
+                               MIN(priv->period, priv->len - offset));
+    }
+  else
+    {
+      priv->callback = NULL;
+    }
+
+  callback(&priv->chan, priv->arg, len);
+}
+
+/****************************************************************************
+ * Name: rp2040_dmaengine_config
+ ****************************************************************************/
+
+static int rp2040_dmaengine_config(FAR struct dma_chan_s *chan,
+                                   FAR const struct dma_config_s *cfg)
+{
+  FAR struct rp2040_dmaengine_s *priv =
+    (FAR struct rp2040_dmaengine_s *)chan;
+  unsigned int width;
+
+  switch (cfg->direction)
+    {
+      case DMA_MEM_TO_DEV:
+        priv->config.dreq = cfg->dst_drq;
+        width = cfg->dst_width;
+        break;
+
+      case DMA_DEV_TO_MEM:
+        priv->config.dreq = cfg->src_drq;
+        width = cfg->src_width;
+        break;
+
+      case DMA_MEM_TO_MEM:
+        priv->config.dreq = RP2040_DMA_DREQ_PERMANENT;
+        width = cfg->src_width;
+        break;
+
+      default:
+        return -EINVAL;
+    }
+
+  /* The DMAC reads and writes with the same width */
+
+  switch (width)
+    {
+      case 0:
+        break;
+
+      case 1:
+        priv->config.size = RP2040_DMA_SIZE_BYTE;
+        break;
+
+      case 2:
+        priv->config.size = RP2040_DMA_SIZE_HALFWORD;
+        break;
+
+      case 4:
+        priv->config.size = RP2040_DMA_SIZE_WORD;
+        break;
+
+      default:
+        return -EINVAL;
+    }
+
+  priv->config.noincr = false;
+  priv->direction     = cfg->direction;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rp2040_dmaengine_start
+ ****************************************************************************/
+
+static int rp2040_dmaengine_start(FAR struct dma_chan_s *chan,
+                                  dma_callback_t callback, FAR void *arg,
+                                  uintptr_t dst, uintptr_t src, size_t len)
+{
+  return rp2040_dmaengine_start_cyclic(chan, callback, arg, dst, src,
+                                       len, 0);
+}
+
+/****************************************************************************
+ * Name: rp2040_dmaengine_start_cyclic
+ ****************************************************************************/
+
+static int rp2040_dmaengine_start_cyclic(FAR struct dma_chan_s *chan,
+                                         dma_callback_t callback,
+                                         FAR void *arg, uintptr_t dst,
+                                         uintptr_t src, size_t len,
+                                         size_t period_len)
+{
+  FAR struct rp2040_dmaengine_s *priv =
+    (FAR struct rp2040_dmaengine_s *)chan;
+  size_t mask = (1 << priv->config.size) - 1;
+
+  if (len == 0 || (len & mask) != 0 || (period_len & mask) != 0)
+    {
+      return -EINVAL;
+    }
+
+  priv->callback = callback;
+  priv->arg      = arg;
+  priv->dst      = dst;
+  priv->src      = src;
+  priv->len      = len;
+  priv->period   = period_len;
+
+  rp2040_dmaengine_segment(priv, 0, period_len > 0 ?
+                                    MIN(period_len, len) : len);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rp2040_dmaengine_stop
+ ****************************************************************************/
+
+static int rp2040_dmaengine_stop(FAR struct dma_chan_s *chan)
+{
+  FAR struct rp2040_dmaengine_s *priv =
+    (FAR struct rp2040_dmaengine_s *)chan;
+
+  priv->callback = NULL;
+  rp2040_dmastop(priv->handle);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rp2040_dmaengine_pause
+ *
+ * Description:
+ *   Clearing the enable bit of a busy channel pauses the transfer, the
+ *   alias of the control register does not trigger the channel.
+ *
+ ****************************************************************************/
+
+static int rp2040_dmaengine_pause(FAR struct dma_chan_s *chan)
+{
+  FAR struct rp2040_dmaengine_s *priv =
+    (FAR struct rp2040_dmaengine_s *)chan;
+
+  clrbits_reg32(RP2040_DMA_CTRL_TRIG_EN,
+                rp2040_dma_register(priv->handle,
+                                    RP2040_DMA_AL1_CTRL_OFFSET));
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rp2040_dmaengine_resume
+ ****************************************************************************/
+
+static int rp2040_dmaengine_resume(FAR struct dma_chan_s *chan)
+{
+  FAR struct rp2040_dmaengine_s *priv =
+    (FAR struct rp2040_dmaengine_s *)chan;
+
+  setbits_reg32(RP2040_DMA_CTRL_TRIG_EN,
+                rp2040_dma_register(priv->handle,
+                                    RP2040_DMA_AL1_CTRL_OFFSET));
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rp2040_dmaengine_residual
+ *
+ * Description:
+ *   Return the bytes left up to the end of the buffer, the remaining
+ *   transfers of the running segment included.
+ *
+ ****************************************************************************/
+
+static size_t rp2040_dmaengine_residual(FAR struct dma_chan_s *chan)
+{
+  FAR struct rp2040_dmaengine_s *priv =
+    (FAR struct rp2040_dmaengine_s *)chan;
+  uint32_t count;
+
+  count = getreg32(rp2040_dma_register(priv->handle,
+                                       RP2040_DMA_TRANS_COUNT_OFFSET));
+  return priv->len - priv->offset - priv->nbytes +
+         (count << priv->config.size);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rp2040_dmaengine_initialize
+ *
+ * Description:
+ *   Register the DMAC as the "rp2040" controller of the DMA engine
+ *   interface.
+ *
+ ****************************************************************************/
+
+void rp2040_dmaengine_initialize(void)
+{
+  int ret;
+
+  ret = dma_register("rp2040", &g_rp2040_dmaengine_dev);
+  if (ret < 0)
+    {
+      dmaerr("ERROR: dma_register failed: %d\n", ret);
+    }
+}
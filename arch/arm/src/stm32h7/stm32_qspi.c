@@ -327,6 +327,9 @@ static int      qspi_memory(struct qspi_dev_s *dev,
                   struct qspi_meminfo_s *meminfo);
 static void *qspi_alloc(struct qspi_dev_s *dev, size_t buflen);
 static void     qspi_free(struct qspi_dev_s *dev, void *buffer);
+static void    *qspi_memmap(struct qspi_dev_s *dev,
+                  const struct qspi_meminfo_s *meminfo);
+static void     qspi_unmap(struct qspi_dev_s *dev);
 
 /* Initialization */
 
@@ -351,6 +354,8 @@ static const struct qspi_ops_s g_qspi0ops =
   .memory            = qspi_memory,
   .alloc             = qspi_alloc,
   .free              = qspi_free,
+  .memmap            = qspi_memmap,
+  .unmap             = qspi_unmap,
 };
 
 /* This is the overall state of the QSPI0 controller */
@@ -2538,6 +2543,137 @@ static int qspi_hw_initialize(struct stm32h7_qspidev_s *priv)
   return OK;
 }
 
+/****************************************************************************
+ * Name: qspi_entermemmap
+ *
+ * Description:
+ *   Put the QSPI device into memory mapped mode.  The QSPI must be locked.
+ *
+ * Input Parameters:
+ *   priv - Device state structure.
+ *   meminfo - parameters like for a memory transfer used for reading
+ *   lpto - Low-power timeout, zero to keep the chip selected
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void qspi_entermemmap(struct stm32h7_qspidev_s *priv,
+                             const struct qspi_meminfo_s *meminfo,
+                             uint32_t lpto)
+{
+  uint32_t regval;
+  struct qspi_xctnspec_s xctn;
+
+  if (priv->memmap)
+    {
+      return;
+    }
+
+  /* Abort anything in-progress */
+
+  qspi_abort(priv);
+
+  /* Wait till BUSY flag reset */
+
+  qspi_waitstatusflags(priv, QSPI_SR_BUSY, 0);
+
+  /* if we want the 'low-power timeout counter' */
+
+  if (lpto > 0)
+    {
+      /* Set the Low Power Timeout value (automatically de-assert
+       * CS if memory is not accessed for a while)
+       */
+
+      qspi_putreg(priv, lpto, STM32_QUADSPI_LPTR_OFFSET);
+
+      /* Clear Timeout interrupt */
+
+      qspi_putreg(&g_qspi0dev, QSPI_FCR_CTOF, STM32_QUADSPI_FCR_OFFSET);
+
+#ifdef CONFIG_STM32H7_QSPI_INTERRUPTS
+      /* Enable Timeout interrupt */
+
+      regval  = qspi_getreg(priv, STM32_QUADSPI_CR_OFFSET);
+      regval |= (QSPI_CR_TCEN | QSPI_CR_TOIE);
+      qspi_putreg(priv, regval, STM32_QUADSPI_CR_OFFSET);
+#endif
+    }
+  else
+    {
+      regval  = qspi_getreg(priv, STM32_QUADSPI_CR_OFFSET);
+      regval &= ~QSPI_CR_TCEN;
+      qspi_putreg(priv, regval, STM32_QUADSPI_CR_OFFSET);
+    }
+
+  /* create a transaction object */
+
+  qspi_setupxctnfrommem(&xctn, meminfo);
+
+#ifdef CONFIG_STM32H7_QSPI_INTERRUPTS
+  priv->xctn = NULL;
+#endif
+
+  /* set it into the ccr */
+
+  qspi_ccrconfig(priv, &xctn, CCR_FMODE_MEMMAP);
+  priv->memmap = true;
+
+  /* we should be in memory mapped mode now */
+
+  qspi_dumpregs(priv, "After memory mapped:");
+}
+
+/****************************************************************************
+ * Name: qspi_memmap
+ *
+ * Description:
+ *   Put the controller in memory-mapped mode.  See QSPI_MEMMAP.
+ *
+ * Input Parameters:
+ *   dev     - Device-specific state data
+ *   meminfo - Describes the read command
+ *
+ * Returned Value:
+ *   The base address of the memory-mapped window.
+ *
+ ****************************************************************************/
+
+static void *qspi_memmap(struct qspi_dev_s *dev,
+                         const struct qspi_meminfo_s *meminfo)
+{
+  struct stm32h7_qspidev_s *priv = (struct stm32h7_qspidev_s *)dev;
+
+  qspi_entermemmap(priv, meminfo, 0);
+  return (void *)STM32_FMC_BANK4;
+}
+
+/****************************************************************************
+ * Name: qspi_unmap
+ *
+ * Description:
+ *   Take the controller out of memory-mapped mode.  See QSPI_UNMAP.
+ *
+ * Input Parameters:
+ *   dev - Device-specific state data
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void qspi_unmap(struct qspi_dev_s *dev)
+{
+  struct stm32h7_qspidev_s *priv = (struct stm32h7_qspidev_s *)dev;
+
+  /* A simple abort is sufficient */
+
+  qspi_abort(priv);
+  priv->memmap = false;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -2701,76 +2837,10 @@ void stm32h7_qspi_enter_memorymapped(struct qspi_dev_s *dev,
                                      const struct qspi_meminfo_s *meminfo,
                                      uint32_t lpto)
 {
-  struct stm32h7_qspidev_s *priv = (struct stm32h7_qspidev_s *)dev;
-  uint32_t regval;
-  struct qspi_xctnspec_s xctn;
-
   /* lock during this mode change */
 
   qspi_lock(dev, true);
-
-  if (priv->memmap)
-    {
-      qspi_lock(dev, false);
-      return;
-    }
-
-  /* Abort anything in-progress */
-
-  qspi_abort(priv);
-
-  /* Wait till BUSY flag reset */
-
-  qspi_waitstatusflags(priv, QSPI_SR_BUSY, 0);
-
-  /* if we want the 'low-power timeout counter' */
-
-  if (lpto > 0)
-    {
-      /* Set the Low Power Timeout value (automatically de-assert
-       * CS if memory is not accessed for a while)
-       */
-
-      qspi_putreg(priv, lpto, STM32_QUADSPI_LPTR_OFFSET);
-
-      /* Clear Timeout interrupt */
-
-      qspi_putreg(&g_qspi0dev, QSPI_FCR_CTOF, STM32_QUADSPI_FCR_OFFSET);
-
-#ifdef CONFIG_STM32H7_QSPI_INTERRUPTS
-      /* Enable Timeout interrupt */
-
-      regval  = qspi_getreg(priv, STM32_QUADSPI_CR_OFFSET);
-      regval |= (QSPI_CR_TCEN | QSPI_CR_TOIE);
-      qspi_putreg(priv, regval, STM32_QUADSPI_CR_OFFSET);
-#endif
-    }
-  else
-    {
-      regval  = qspi_getreg(priv, STM32_QUADSPI_CR_OFFSET);
-      regval &= ~QSPI_CR_TCEN;
-      qspi_putreg(priv, regval, STM32_QUADSPI_CR_OFFSET);
-    }
-
-  /* create a transaction object */
-
-  qspi_setupxctnfrommem(&xctn, meminfo);
-
-#ifdef CONFIG_STM32H7_QSPI_INTERRUPTS
-  priv->xctn = NULL;
-#endif
-
-  /* set it into the ccr */
-
-  qspi_ccrconfig(priv, &xctn, CCR_FMODE_MEMMAP);
-  priv->memmap = true;
-
-  /* we should be in memory mapped mode now */
-
-  qspi_dumpregs(priv, "After memory mapped:");
-
-  /* finished this mode change */
-
+  qspi_entermemmap((struct stm32h7_qspidev_s *)dev, meminfo, lpto);
   qspi_lock(dev, false);
 }
 
@@ -2790,15 +2860,8 @@ void stm32h7_qspi_enter_memorymapped(struct qspi_dev_s *dev,
 
 void stm32h7_qspi_exit_memorymapped(struct qspi_dev_s *dev)
 {
-  struct stm32h7_qspidev_s *priv = (struct stm32h7_qspidev_s *)dev;
-
   qspi_lock(dev, true);
-
-  /* A simple abort is sufficient */
-
-  qspi_abort(priv);
-  priv->memmap = false;
-
+  qspi_unmap(dev);
   qspi_lock(dev, false);
 }
 
@@ -211,6 +211,12 @@
 #define REG_FPSR            (0)
 #define REG_FPCR            (1)
 
+/* 64 bit registers:  With CONFIG_ARCH_LAZYFPU, non zero if the frame holds
+ * the FPU registers of the thread.
+ */
+
+#define REG_FPU_TRAP        (65)
+
 /* FPU registers(Q0~Q31, 128bit): 32x2 = 64
  * FPU FPSR/SPSR(32 bit) : 1
  * FPU TRAP: 1
@@ -564,6 +564,15 @@ int up_addrenv_destroy(arch_addrenv_t *addrenv)
     {
       for (i = 0; i < ENTRIES_PER_PGT; i++, vaddr += pgsize)
         {
+#ifdef CONFIG_MM_HUGEPAGE
+          /* A block entry maps a huge page of SHM, there is no table */
+
+          if ((ptprev[i] & PTE_DESC_TYPE_MASK) == PTE_BLOCK_DESC)
+            {
+              continue;
+            }
+
+#endif
           ptlast = (uintptr_t *)arm64_pgvaddr(mmu_pte_to_paddr(ptprev[i]));
           if (ptlast)
             {
@@ -115,4 +115,78 @@ int up_shmdt(uintptr_t vaddr, unsigned int npages)
   return arm64_unmap_pages(addrenv, vaddr, npages);
 }
 
+/****************************************************************************
+ * Name: up_shmat_huge
+ *
+ * Description:
+ *   Attach, i.e, map, a shared memory region of huge pages to a user
+ *   virtual address
+ *
+ * Input Parameters:
+ *   pages - A pointer to the first element in a array of physical address,
+ *     each corresponding to one huge page of memory.
+ *   nhuge - The number of huge pages in the list to be mapped.
+ *   vaddr - The virtual address corresponding to the beginning of the
+ *     (contiguous) virtual address region.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HUGEPAGE
+int up_shmat_huge(uintptr_t *pages, unsigned int nhuge, uintptr_t vaddr)
+{
+  struct tcb_s          *tcb     = this_task();
+  struct arch_addrenv_s *addrenv = &tcb->addrenv_own->addrenv;
+
+  /* Sanity checks */
+
+  DEBUGASSERT(tcb && tcb->addrenv_own);
+  DEBUGASSERT(pages != NULL && nhuge > 0);
+  DEBUGASSERT(vaddr >= CONFIG_ARCH_SHM_VBASE && vaddr < ARCH_SHM_VEND);
+  DEBUGASSERT((vaddr & MM_HUGEPGMASK) == 0);
+
+  /* Let arm64_map_hugepages do the work */
+
+  return arm64_map_hugepages(addrenv, pages, nhuge, vaddr, MMU_UDATA_FLAGS);
+}
+
+/****************************************************************************
+ * Name: up_shmdt_huge
+ *
+ * Description:
+ *   Detach, i.e, unmap, a shared memory region of huge pages from a user
+ *   virtual address
+ *
+ * Input Parameters:
+ *   vaddr - The virtual address corresponding to the beginning of the
+ *     (contiguous) virtual address region.
+ *   nhuge - The number of huge pages to be unmapped
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+int up_shmdt_huge(uintptr_t vaddr, unsigned int nhuge)
+{
+  struct tcb_s          *tcb     = this_task();
+  struct arch_addrenv_s *addrenv = &tcb->addrenv_own->addrenv;
+
+  /* Sanity checks */
+
+  DEBUGASSERT(tcb && tcb->addrenv_own);
+  DEBUGASSERT(nhuge > 0);
+  DEBUGASSERT(vaddr >= CONFIG_ARCH_SHM_VBASE && vaddr < ARCH_SHM_VEND);
+  DEBUGASSERT((vaddr & MM_HUGEPGMASK) == 0);
+
+  /* Let arm64_unmap_hugepages do the work */
+
+  return arm64_unmap_hugepages(addrenv, vaddr, nhuge);
+}
+#endif /* CONFIG_MM_HUGEPAGE */
+
 #endif /* CONFIG_BUILD_KERNEL */
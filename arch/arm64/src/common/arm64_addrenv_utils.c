@@ -183,6 +183,9 @@ int arm64_unmap_pages(arch_addrenv_t *addrenv, uintptr_t vaddr,
   uintptr_t ptprev;
   uintptr_t ptlevel;
   uintptr_t paddr;
+  uintptr_t start = vaddr;
+  unsigned int i;
+  int ret = OK;
 
   /* Get the current level MAX_LEVELS-1 entry corresponding to this vaddr */
 
@@ -197,7 +200,7 @@ int arm64_unmap_pages(arch_addrenv_t *addrenv, uintptr_t vaddr,
 
   /* Remove the references from the caller's address environment */
 
-  for (; npages > 0; npages--)
+  for (i = 0; i < npages; i++)
     {
       /* Get the current final level entry corresponding to this vaddr */
 
@@ -205,16 +208,173 @@ int arm64_unmap_pages(arch_addrenv_t *addrenv, uintptr_t vaddr,
       ptlast = arm64_pgvaddr(paddr);
       if (!ptlast)
         {
-          return -EFAULT;
+          ret = -EFAULT;
+          break;
         }
 
-      /* Then wipe the reference */
+      /* Then wipe the reference, the TLB is flushed once for all pages */
 
-      mmu_ln_clear(ptlevel + 1, ptlast, vaddr);
+      mmu_ln_clear_batch(ptlevel + 1, ptlast, vaddr);
       vaddr += MM_PGSIZE;
     }
 
+  if (i > 0)
+    {
+      mmu_invalidate_tlb_range(start, i);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: arm64_map_hugepages
+ *
+ * Description:
+ *   Map physical huge pages into a continuous virtual memory block.  Each
+ *   huge page is mapped with a single level 2 block entry, unless a page
+ *   table already covers its virtual addresses, then with the entries of
+ *   that page table.
+ *
+ * Input Parameters:
+ *   addrenv - Pointer to a structure describing the address environment.
+ *   pages - A pointer to the first element in a array of physical address,
+ *     each corresponding to one huge page of memory.
+ *   nhuge - The number of huge pages in the list to be mapped.
+ *   vaddr - The virtual address corresponding to the beginning of the
+ *     (continuous) virtual address region, aligned to MM_HUGEPGSIZE.
+ *   prot - MMU flags to use for a page.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HUGEPAGE
+int arm64_map_hugepages(arch_addrenv_t *addrenv, uintptr_t *pages,
+                        unsigned int nhuge, uintptr_t vaddr, uint64_t prot)
+{
+  uintptr_t ptlast;
+  uintptr_t ptprev;
+  uintptr_t ptlevel;
+  uintptr_t entry;
+  uintptr_t paddr;
+  unsigned int i;
+
+  DEBUGASSERT((vaddr & MM_HUGEPGMASK) == 0);
+
+  ptlevel = MMU_PGT_LEVEL_MAX - 1;
+  ptprev  = arm64_pgvaddr(addrenv->spgtables[ptlevel]);
+  if (!ptprev)
+    {
+      /* Something is very wrong */
+
+      return -EFAULT;
+    }
+
+  for (; nhuge > 0; nhuge--, vaddr += MM_HUGEPGSIZE)
+    {
+      paddr = *pages++;
+      entry = mmu_ln_getentry(ptlevel, ptprev, vaddr);
+      if (entry == 0)
+        {
+          /* Map the whole huge page with a block entry */
+
+          mmu_ln_setentry(ptlevel, ptprev, paddr, vaddr,
+                          (prot & ~PTE_DESC_TYPE_MASK) | PTE_BLOCK_DESC);
+          continue;
+        }
+
+      /* A page table is already there, map the huge page with it */
+
+      ptlast = arm64_pgvaddr(mmu_pte_to_paddr(entry));
+      if (!ptlast || (entry & PTE_DESC_TYPE_MASK) != PTE_TABLE_DESC)
+        {
+          return -EFAULT;
+        }
+
+      for (i = 0; i < MM_HUGEPGPAGES; i++)
+        {
+          mmu_ln_setentry(ptlevel + 1, ptlast, paddr + i * MM_PGSIZE,
+                          vaddr + i * MM_PGSIZE, prot);
+        }
+    }
+
   return OK;
 }
 
+/****************************************************************************
+ * Name: arm64_unmap_hugepages
+ *
+ * Description:
+ *   Unmap a virtual memory region mapped by arm64_map_hugepages().
+ *
+ * Input Parameters:
+ *   addrenv - Pointer to a structure describing the address environment.
+ *   vaddr - The virtual address corresponding to the beginning of the
+ *     (continuous) virtual address region, aligned to MM_HUGEPGSIZE.
+ *   nhuge - The number of huge pages to be unmapped
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+int arm64_unmap_hugepages(arch_addrenv_t *addrenv, uintptr_t vaddr,
+                          unsigned int nhuge)
+{
+  uintptr_t ptlast;
+  uintptr_t ptprev;
+  uintptr_t ptlevel;
+  uintptr_t entry;
+  uintptr_t start = vaddr;
+  unsigned int n;
+  unsigned int i;
+  int ret = OK;
+
+  DEBUGASSERT((vaddr & MM_HUGEPGMASK) == 0);
+
+  ptlevel = MMU_PGT_LEVEL_MAX - 1;
+  ptprev  = arm64_pgvaddr(addrenv->spgtables[ptlevel]);
+  if (!ptprev)
+    {
+      /* Something is very wrong */
+
+      return -EFAULT;
+    }
+
+  for (n = 0; n < nhuge; n++, vaddr += MM_HUGEPGSIZE)
+    {
+      entry = mmu_ln_getentry(ptlevel, ptprev, vaddr);
+      if ((entry & PTE_DESC_TYPE_MASK) == PTE_BLOCK_DESC)
+        {
+          mmu_ln_clear_batch(ptlevel, ptprev, vaddr);
+          continue;
+        }
+
+      ptlast = arm64_pgvaddr(mmu_pte_to_paddr(entry));
+      if (!ptlast)
+        {
+          ret = -EFAULT;
+          break;
+        }
+
+      for (i = 0; i < MM_HUGEPGPAGES; i++)
+        {
+          mmu_ln_clear_batch(ptlevel + 1, ptlast, vaddr + i * MM_PGSIZE);
+        }
+    }
+
+  /* Flush the TLB once for all the huge pages unmapped */
+
+  if (n > 0)
+    {
+      mmu_invalidate_tlb_range(start, (size_t)n * MM_HUGEPGPAGES);
+    }
+
+  return ret;
+}
+#endif /* CONFIG_MM_HUGEPAGE */
+
 #endif /* CONFIG_BUILD_KERNEL */
@@ -182,6 +182,9 @@ pid_t arm64_fork(const struct fork_s *context)
 #ifdef CONFIG_ARCH_FPU
   child->cmn.xcp.fpu_regs = (void *)(newsp - FPU_CONTEXT_SIZE);
   memcpy(child->cmn.xcp.fpu_regs, context->fpu, FPU_CONTEXT_SIZE);
+#  ifdef CONFIG_ARCH_LAZYFPU
+  child->cmn.xcp.fpu_regs[REG_FPU_TRAP] = 1;
+#  endif
 #endif
 
   child->cmn.xcp.regs             = (void *)(newsp - XCPTCONTEXT_SIZE);
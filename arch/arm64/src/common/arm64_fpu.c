@@ -52,7 +52,7 @@
  ***************************************************************************/
 
 #define FPU_CALLEE_REGS     (8)
-#define FPU_PROC_LINELEN    (64 * CONFIG_SMP_NCPUS)
+#define FPU_PROC_LINELEN    (128 * CONFIG_SMP_NCPUS)
 
 /***************************************************************************
  * Private Types
@@ -79,8 +79,6 @@ struct arm64_fpu_procfs_file_s
 
 #ifdef CONFIG_FS_PROCFS_REGISTER
 
-static struct arm64_cpu_fpu_context g_cpu_fpu_ctx[CONFIG_SMP_NCPUS];
-
 /* procfs methods */
 
 static int arm64_fpu_procfs_open(struct file *filep, const char *relpath,
@@ -118,6 +116,12 @@ static const struct procfs_entry_s g_procfs_arm64_fpu =
 
 #endif
 
+/***************************************************************************
+ * Public Data
+ ***************************************************************************/
+
+struct arm64_cpu_fpu_context g_cpu_fpu_ctx[CONFIG_SMP_NCPUS];
+
 /***************************************************************************
  * Private Functions
  ***************************************************************************/
@@ -227,10 +231,10 @@ static ssize_t arm64_fpu_procfs_read(struct file *filep, char *buffer,
       ctx = &g_cpu_fpu_ctx[i];
       linesize += snprintf(attr->line + linesize,
                            FPU_PROC_LINELEN,
-                           "CPU%d: save: %d restore: %d "
-                           "switch: %d exedepth: %d\n",
+                           "CPU%d: save: %" PRIu64 " restore: %" PRIu64
+                           " skip: %" PRIu64 " trap: %" PRIu64 "\n",
                            i, ctx->save_count, ctx->restore_count,
-                           ctx->switch_count, ctx->exe_depth_count);
+                           ctx->skip_count, ctx->trap_count);
     }
 
   attr->linesize = linesize;
@@ -277,6 +281,31 @@ void arm64_fpu_disable(void)
   up_irq_restore(flags);
 }
 
+/***************************************************************************
+ * Name: arm64_fpu_trap
+ *
+ * Description:
+ *   Handle the trapped first use of the FPU by a thread, see
+ *   arm64_fpu_enter() and arm64_fpu_exit().  The thread starts with clean
+ *   FPU registers, from now on its exception frames hold them.
+ *
+ * Input Parameters:
+ *   regs - The exception frame of the trap.
+ *
+ ***************************************************************************/
+
+#ifdef CONFIG_ARCH_LAZYFPU
+void arm64_fpu_trap(uint64_t *regs)
+{
+  uint64_t *fpu = regs + ARM64_CONTEXT_REGS;
+
+  memset(fpu, 0, FPU_CONTEXT_SIZE);
+  fpu[REG_FPU_TRAP] = 1;
+
+  g_cpu_fpu_ctx[up_cpu_index()].trap_count++;
+}
+#endif
+
 /***************************************************************************
  * Name: up_fpucmp
  *
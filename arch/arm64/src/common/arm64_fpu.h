@@ -21,6 +21,18 @@
 #ifndef __ARCH_ARM64_SRC_COMMON_ARM64_FPU_H
 #define __ARCH_ARM64_SRC_COMMON_ARM64_FPU_H
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Offsets of the counters in struct arm64_cpu_fpu_context */
+
+#define FPU_CTX_SAVE        (0)
+#define FPU_CTX_RESTORE     (8)
+#define FPU_CTX_SKIP        (16)
+#define FPU_CTX_TRAP        (24)
+#define FPU_CTX_SHIFT       (5)
+
 #ifndef __ASSEMBLY__
 
 /****************************************************************************
@@ -36,26 +48,24 @@
  * Type Declarations
  ****************************************************************************/
 
+/* The FPU switch counters of one CPU, updated from the exception entry and
+ * return with CONFIG_ARCH_LAZYFPU.
+ */
+
 struct arm64_cpu_fpu_context
 {
-  /* owner of current CPU's FPU */
-
-  struct tcb_s *fpu_owner;
-
-  struct tcb_s *idle_thread;
-
-  /* for statistic propose */
-
-  int save_count;
-  int restore_count;
-  int switch_count;
-  int exe_depth_count;
+  uint64_t save_count;    /* Exception frames that saved the FPU */
+  uint64_t restore_count; /* Exception returns that restored the FPU */
+  uint64_t skip_count;    /* Exception frames of threads not using the FPU */
+  uint64_t trap_count;    /* First uses of the FPU by a thread */
 };
 
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
+extern struct arm64_cpu_fpu_context g_cpu_fpu_ctx[CONFIG_SMP_NCPUS];
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -73,6 +83,12 @@ void arm64_fpu_enable(void);
 void arm64_fpu_save(uint64_t *context);
 void arm64_fpu_restore(uint64_t *context);
 
+#ifdef CONFIG_ARCH_LAZYFPU
+void arm64_fpu_enter(uint64_t *context);
+void arm64_fpu_exit(uint64_t *context);
+void arm64_fpu_trap(uint64_t *regs);
+#endif
+
 #endif /* __ASSEMBLY__ */
 
 #endif /* __ARCH_ARM64_SRC_COMMON_ARM64_FPU_H */
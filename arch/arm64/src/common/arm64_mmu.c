@@ -786,6 +786,27 @@ void mmu_ln_restore(uint32_t ptlevel, uintptr_t lnvaddr, uintptr_t vaddr,
   mmu_invalidate_tlb_by_vaddr(vaddr);
 }
 
+void mmu_ln_clear_batch(uint32_t ptlevel, uintptr_t lnvaddr,
+                        uintptr_t vaddr)
+{
+  uintptr_t *lntable = (uintptr_t *)lnvaddr;
+  uint32_t  index;
+
+  DEBUGASSERT(ptlevel >= XLAT_TABLE_BASE_LEVEL &&
+              ptlevel <= XLAT_TABLE_LEVEL_MAX);
+
+  index = XLAT_TABLE_VA_IDX(vaddr, ptlevel);
+
+  lntable[index] = 0;
+
+  /* Update with memory by flushing the cache, the TLB is left to the
+   * caller.
+   */
+
+  up_flush_dcache((uintptr_t)&lntable[index],
+                  (uintptr_t)&lntable[index] + sizeof(uintptr_t));
+}
+
 size_t mmu_get_region_size(uint32_t ptlevel)
 {
   DEBUGASSERT(ptlevel >= XLAT_TABLE_BASE_LEVEL &&
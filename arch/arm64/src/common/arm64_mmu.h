@@ -260,6 +260,10 @@
 
 #define MMU_PAGE_ENTRIES            (MMU_PAGE_SIZE / sizeof(uintptr_t))
 
+/* Pages flushed one by one from the TLB, the whole TLB beyond */
+
+#define MMU_TLB_RANGE_MAX           (64)
+
 /* Amount of page table levels */
 
 #define MMU_PGT_LEVELS              (4U)
@@ -436,6 +440,63 @@ static inline void mmu_invalidate_tlbs(void)
     );
 }
 
+/****************************************************************************
+ * Name: mmu_invalidate_tlb_range
+ *
+ * Description:
+ *   Flush the TLB for the entries of npages pages from vaddr, with a single
+ *   barrier.  The whole TLB is flushed beyond MMU_TLB_RANGE_MAX pages.
+ *
+ * Input Parameters:
+ *   vaddr  - The virtual address of the first page to flush
+ *   npages - The number of pages to flush
+ *
+ ****************************************************************************/
+
+static inline void mmu_invalidate_tlb_range(uintptr_t vaddr, size_t npages)
+{
+  __asm__ __volatile__
+    (
+      "dsb ishst\n"
+      :
+      :
+      : "memory"
+    );
+
+  if (npages > MMU_TLB_RANGE_MAX)
+    {
+      __asm__ __volatile__
+        (
+          "tlbi vmalle1is\n"
+          :
+          :
+          : "memory"
+        );
+    }
+  else
+    {
+      for (; npages > 0; npages--, vaddr += MMU_PAGE_SIZE)
+        {
+          __asm__ __volatile__
+            (
+              "tlbi vale1is, %0\n"
+              :
+              : "r" (TLBI_ARG(vaddr, 0))
+              : "memory"
+            );
+        }
+    }
+
+  __asm__ __volatile__
+    (
+      "dsb ish\n"
+      "isb"
+      :
+      :
+      : "memory"
+    );
+}
+
 /****************************************************************************
  * Name: mmu_write_ttbr0
  *
@@ -634,6 +695,27 @@ void mmu_ln_restore(uint32_t ptlevel, uintptr_t lnvaddr, uintptr_t vaddr,
 #define mmu_ln_clear(ptlevel, lnvaddr, vaddr) \
   mmu_ln_restore(ptlevel, lnvaddr, vaddr, 0)
 
+/****************************************************************************
+ * Name: mmu_ln_clear_batch
+ *
+ * Description:
+ *   Unmap a level n translation table entry, as mmu_ln_clear() but without
+ *   flushing the TLB:  The caller flushes the TLB once for all the entries
+ *   it unmapped, see mmu_invalidate_tlb_range().
+ *
+ * Input Parameters:
+ *   ptlevel - The translation table level, amount of levels is
+ *     MMU implementation specific
+ *   lnvaddr - The virtual address of the beginning of the page table at
+ *     level n
+ *   vaddr - The virtual address to get pte for. Must be aligned to a PPN
+ *     address boundary which is dependent on the level of the entry
+ *
+ ****************************************************************************/
+
+void mmu_ln_clear_batch(uint32_t ptlevel, uintptr_t lnvaddr,
+                        uintptr_t vaddr);
+
 /****************************************************************************
  * Name: mmu_get_region_size
  *
@@ -859,7 +859,7 @@ static int rx65n_transmit(struct rx65n_ethmac_s *priv)
   /* Increment statistics */
 
 #if defined(CONFIG_NETDEV_STATISTICS)
-  (priv->dev.d_statistics.tx_packets)++;
+  NETDEV_STATS(&priv->dev).tx_packets++;
 #endif
 
 #if OPTIMAL_ETH_BUFSIZE > CONFIG_RX65N_ETH_BUFSIZE
@@ -1401,7 +1401,7 @@ static int rx65n_recvframe(struct rx65n_ethmac_s *priv)
               /* Increment statistics */
 
 #if defined(CONFIG_NETDEV_STATISTICS)
-  (priv->dev.d_statistics.rx_packets)++;
+  NETDEV_STATS(&priv->dev).rx_packets++;
 #endif
 
               /* Return success, remembering where we should re-start
@@ -1421,7 +1421,7 @@ static int rx65n_recvframe(struct rx65n_ethmac_s *priv)
               /* Increment statistics */
 
 #if defined(CONFIG_NETDEV_STATISTICS)
-  (priv->dev.d_statistics.rx_errors)++;
+  NETDEV_STATS(&priv->dev).rx_errors++;
 #endif
 
               /* Drop the frame that contains the errors, reset the segment
@@ -1520,7 +1520,7 @@ static void rx65n_receive(struct rx65n_ethmac_s *priv)
           /* Increment statistics */
 
 #if defined(CONFIG_NETDEV_STATISTICS)
-          (priv->dev.d_statistics.rx_ipv4)++;
+          NETDEV_STATS(&priv->dev).rx_ipv4++;
 #endif
 
           ipv4_input(&priv->dev);
@@ -1571,7 +1571,7 @@ static void rx65n_receive(struct rx65n_ethmac_s *priv)
           /* Increment statistics */
 
 #if defined(CONFIG_NETDEV_STATISTICS)
-          (priv->dev.d_statistics.rx_arp)++;
+          NETDEV_STATS(&priv->dev).rx_arp++;
 #endif
 
           /* Handle ARP packet */
@@ -1593,7 +1593,7 @@ static void rx65n_receive(struct rx65n_ethmac_s *priv)
         {
           nerr("ERROR: Dropped, Unknown type: %04x\n", BUF->type);
 #if defined(CONFIG_NETDEV_STATISTICS)
-          (priv->dev.d_statistics.rx_dropped)++;
+          NETDEV_STATS(&priv->dev).rx_dropped++;
 #endif
         }
 
@@ -1869,7 +1869,7 @@ static void rx65n_interrupt_work(void *arg)
       /* Increment statistics */
 
 #if defined(CONFIG_NETDEV_STATISTICS)
-  (priv->dev.d_statistics.tx_done)++;
+  NETDEV_STATS(&priv->dev).tx_done++;
 #endif
 
       /* Check if there are pending transmissions */
@@ -1966,8 +1966,8 @@ static void rx65n_txtimeout_work(void *arg)
   /* Increment statistics */
 
 #if defined(CONFIG_NETDEV_STATISTICS)
-  (priv->dev.d_statistics.tx_errors)++;
-  (priv->dev.d_statistics.tx_timeouts)++;
+  NETDEV_STATS(&priv->dev).tx_errors++;
+  NETDEV_STATS(&priv->dev).tx_timeouts++;
 #endif
 
   rx65n_ifdown(&priv->dev);
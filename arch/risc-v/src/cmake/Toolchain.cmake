@@ -355,6 +355,12 @@ if(CONFIG_MM_KASAN_ALL)
   add_compile_options(-fsanitize=kernel-address)
 endif()
 
+if(CONFIG_MM_KASAN_INLINE)
+  add_compile_options(
+    -fasan-shadow-offset=${CONFIG_MM_KASAN_SHADOW_OFFSET}
+    --param=asan-instrumentation-with-call-threshold=10000)
+endif()
+
 if(CONFIG_MM_KASAN_DISABLE_READS_CHECK)
   add_compile_options(--param=asan-instrument-reads=0)
 endif()
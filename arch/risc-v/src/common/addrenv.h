@@ -128,5 +128,57 @@ int riscv_map_pages(arch_addrenv_t *addrenv, uintptr_t *pages,
 int riscv_unmap_pages(arch_addrenv_t *addrenv, uintptr_t vaddr,
                       unsigned int npages);
 
+/****************************************************************************
+ * Name: riscv_map_hugepages
+ *
+ * Description:
+ *   Map physical huge pages into a continuous virtual memory block.  Each
+ *   huge page is mapped with a single megapage leaf entry, unless a page
+ *   table already covers its virtual addresses, then with the entries of
+ *   that page table.
+ *
+ * Input Parameters:
+ *   addrenv - Pointer to a structure describing the address environment.
+ *   pages - A pointer to the first element in a array of physical address,
+ *     each corresponding to one huge page of memory.
+ *   nhuge - The number of huge pages in the list to be mapped.
+ *   vaddr - The virtual address corresponding to the beginning of the
+ *     (continuous) virtual address region, aligned to MM_HUGEPGSIZE.
+ *   prot - MMU flags to use for a page.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HUGEPAGE
+int riscv_map_hugepages(arch_addrenv_t *addrenv, uintptr_t *pages,
+                        unsigned int nhuge, uintptr_t vaddr, int prot);
+#endif
+
+/****************************************************************************
+ * Name: riscv_unmap_hugepages
+ *
+ * Description:
+ *   Unmap a virtual memory region mapped by riscv_map_hugepages().
+ *
+ * Input Parameters:
+ *   addrenv - Pointer to a structure describing the address environment.
+ *   vaddr - The virtual address corresponding to the beginning of the
+ *     (continuous) virtual address region, aligned to MM_HUGEPGSIZE.
+ *   nhuge - The number of huge pages to be unmapped
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HUGEPAGE
+int riscv_unmap_hugepages(arch_addrenv_t *addrenv, uintptr_t vaddr,
+                          unsigned int nhuge);
+#endif
+
 #endif /* CONFIG_ARCH_ADDRENV */
 #endif /* __ARCH_RISC_V_SRC_COMMON_ADDRENV_H */
@@ -544,6 +544,15 @@ int up_addrenv_destroy(arch_addrenv_t *addrenv)
       i = (ARCH_SPGTS < 2) ? vaddr / pgsize : 0;
       for (; i < ENTRIES_PER_PGT; i++, vaddr += pgsize)
         {
+#ifdef CONFIG_MM_HUGEPAGE
+          /* A leaf entry maps a huge page of SHM, there is no table */
+
+          if (ptprev[i] & PTE_LEAF_MASK)
+            {
+              continue;
+            }
+
+#endif
           ptlast = (uintptr_t *)riscv_pgvaddr(mmu_pte_to_paddr(ptprev[i]));
           if (ptlast)
             {
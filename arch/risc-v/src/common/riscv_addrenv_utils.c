@@ -192,6 +192,9 @@ int riscv_unmap_pages(arch_addrenv_t *addrenv, uintptr_t vaddr,
   uintptr_t ptprev;
   uintptr_t ptlevel;
   uintptr_t paddr;
+  uintptr_t start = vaddr;
+  unsigned int i;
+  int ret = OK;
 
   ptlevel =  ARCH_SPGTS;
   ptprev  =  riscv_pgvaddr(addrenv->spgtables[ARCH_SPGTS - 1]);
@@ -204,7 +207,7 @@ int riscv_unmap_pages(arch_addrenv_t *addrenv, uintptr_t vaddr,
 
   /* Remove the references from the caller's address environment */
 
-  for (; npages > 0; npages--)
+  for (i = 0; i < npages; i++)
     {
       /* Get the current final level entry corresponding to this vaddr */
 
@@ -212,12 +215,13 @@ int riscv_unmap_pages(arch_addrenv_t *addrenv, uintptr_t vaddr,
       ptlast = riscv_pgvaddr(paddr);
       if (!ptlast)
         {
-          return -EFAULT;
+          ret = -EFAULT;
+          break;
         }
 
-      /* Then wipe the reference */
+      /* Then wipe the reference, the TLB is flushed once for all pages */
 
-      mmu_ln_clear(ptlevel + 1, ptlast, vaddr);
+      mmu_ln_clear_batch(ptlevel + 1, ptlast, vaddr);
       vaddr += MM_PGSIZE;
     }
 
@@ -225,7 +229,170 @@ int riscv_unmap_pages(arch_addrenv_t *addrenv, uintptr_t vaddr,
 
   __DMB();
 
+  if (i > 0)
+    {
+      mmu_invalidate_tlb_range(start, i);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: riscv_map_hugepages
+ *
+ * Description:
+ *   Map physical huge pages into a continuous virtual memory block.  Each
+ *   huge page is mapped with a single megapage leaf entry, unless a page
+ *   table already covers its virtual addresses, then with the entries of
+ *   that page table.
+ *
+ * Input Parameters:
+ *   addrenv - Pointer to a structure describing the address environment.
+ *   pages - A pointer to the first element in a array of physical address,
+ *     each corresponding to one huge page of memory.
+ *   nhuge - The number of huge pages in the list to be mapped.
+ *   vaddr - The virtual address corresponding to the beginning of the
+ *     (continuous) virtual address region, aligned to MM_HUGEPGSIZE.
+ *   prot - MMU flags to use for a page.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HUGEPAGE
+int riscv_map_hugepages(arch_addrenv_t *addrenv, uintptr_t *pages,
+                        unsigned int nhuge, uintptr_t vaddr, int prot)
+{
+  uintptr_t ptlast;
+  uintptr_t ptprev;
+  uintptr_t ptlevel;
+  uintptr_t entry;
+  uintptr_t paddr;
+  unsigned int i;
+
+  DEBUGASSERT((vaddr & MM_HUGEPGMASK) == 0);
+
+  ptlevel =  ARCH_SPGTS;
+  ptprev  =  riscv_pgvaddr(addrenv->spgtables[ARCH_SPGTS - 1]);
+  if (!ptprev)
+    {
+      /* Something is very wrong */
+
+      return -EFAULT;
+    }
+
+  for (; nhuge > 0; nhuge--, vaddr += MM_HUGEPGSIZE)
+    {
+      paddr = *pages++;
+      entry = mmu_ln_getentry(ptlevel, ptprev, vaddr);
+      if (entry == 0)
+        {
+          /* Map the whole huge page with a leaf entry */
+
+          mmu_ln_setentry(ptlevel, ptprev, paddr, vaddr, prot);
+          continue;
+        }
+
+      /* A page table is already there, map the huge page with it */
+
+      ptlast = riscv_pgvaddr(mmu_pte_to_paddr(entry));
+      if (!ptlast || (entry & PTE_LEAF_MASK) != 0)
+        {
+          return -EFAULT;
+        }
+
+      for (i = 0; i < MM_HUGEPGPAGES; i++)
+        {
+          mmu_ln_setentry(ptlevel + 1, ptlast, paddr + i * MM_PGSIZE,
+                          vaddr + i * MM_PGSIZE, prot);
+        }
+    }
+
+  /* Flush the data cache, so the changes are committed to memory */
+
+  __DMB();
+
   return OK;
 }
 
+/****************************************************************************
+ * Name: riscv_unmap_hugepages
+ *
+ * Description:
+ *   Unmap a virtual memory region mapped by riscv_map_hugepages().
+ *
+ * Input Parameters:
+ *   addrenv - Pointer to a structure describing the address environment.
+ *   vaddr - The virtual address corresponding to the beginning of the
+ *     (continuous) virtual address region, aligned to MM_HUGEPGSIZE.
+ *   nhuge - The number of huge pages to be unmapped
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+int riscv_unmap_hugepages(arch_addrenv_t *addrenv, uintptr_t vaddr,
+                          unsigned int nhuge)
+{
+  uintptr_t ptlast;
+  uintptr_t ptprev;
+  uintptr_t ptlevel;
+  uintptr_t entry;
+  uintptr_t start = vaddr;
+  unsigned int n;
+  unsigned int i;
+  int ret = OK;
+
+  DEBUGASSERT((vaddr & MM_HUGEPGMASK) == 0);
+
+  ptlevel =  ARCH_SPGTS;
+  ptprev  =  riscv_pgvaddr(addrenv->spgtables[ARCH_SPGTS - 1]);
+  if (!ptprev)
+    {
+      /* Something is very wrong */
+
+      return -EFAULT;
+    }
+
+  for (n = 0; n < nhuge; n++, vaddr += MM_HUGEPGSIZE)
+    {
+      entry = mmu_ln_getentry(ptlevel, ptprev, vaddr);
+      if (entry & PTE_LEAF_MASK)
+        {
+          mmu_ln_clear_batch(ptlevel, ptprev, vaddr);
+          continue;
+        }
+
+      ptlast = riscv_pgvaddr(mmu_pte_to_paddr(entry));
+      if (!ptlast)
+        {
+          ret = -EFAULT;
+          break;
+        }
+
+      for (i = 0; i < MM_HUGEPGPAGES; i++)
+        {
+          mmu_ln_clear_batch(ptlevel + 1, ptlast, vaddr + i * MM_PGSIZE);
+        }
+    }
+
+  /* Flush the data cache, so the changes are committed to memory */
+
+  __DMB();
+
+  /* Flush the TLB once for all the huge pages unmapped */
+
+  if (n > 0)
+    {
+      mmu_invalidate_tlb_range(start, (size_t)n * MM_HUGEPGPAGES);
+    }
+
+  return ret;
+}
+#endif /* CONFIG_MM_HUGEPAGE */
+
 #endif /* CONFIG_BUILD_KERNEL */
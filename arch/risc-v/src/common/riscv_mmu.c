@@ -135,6 +135,21 @@ void mmu_ln_restore(uint32_t ptlevel, uintptr_t lnvaddr, uintptr_t vaddr,
   mmu_invalidate_tlb_by_vaddr(vaddr);
 }
 
+void mmu_ln_clear_batch(uint32_t ptlevel, uintptr_t lnvaddr,
+                        uintptr_t vaddr)
+{
+  uintptr_t *lntable = (uintptr_t *)lnvaddr;
+  uint32_t  index;
+
+  DEBUGASSERT(ptlevel > 0 && ptlevel <= RV_MMU_PT_LEVELS);
+
+  index = (vaddr >> RV_MMU_VADDR_SHIFT(ptlevel)) & RV_MMU_VPN_MASK;
+
+  /* The TLB is left to the caller */
+
+  lntable[index] = 0;
+}
+
 void mmu_ln_map_region(uint32_t ptlevel, uintptr_t lnvaddr, uintptr_t paddr,
                        uintptr_t vaddr, size_t size, uint64_t mmuflags)
 {
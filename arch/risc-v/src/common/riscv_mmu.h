@@ -31,6 +31,10 @@
 #define RV_MMU_PAGE_SIZE        (1 << RV_MMU_PAGE_SHIFT) /* 4K pages */
 #define RV_MMU_PAGE_MASK        (RV_MMU_PAGE_SIZE - 1)
 
+/* Pages flushed one by one from the TLB, the whole TLB beyond */
+
+#define RV_MMU_TLB_RANGE_MAX    (64)
+
 /* Entries per PGT */
 
 #define RV_MMU_PAGE_ENTRIES     (RV_MMU_PAGE_SIZE / sizeof(uintptr_t))
@@ -303,6 +307,33 @@ static inline void mmu_invalidate_tlbs(void)
     );
 }
 
+/****************************************************************************
+ * Name: mmu_invalidate_tlb_range
+ *
+ * Description:
+ *   Flush the TLB for the entries of npages pages from vaddr.  The whole
+ *   TLB is flushed beyond RV_MMU_TLB_RANGE_MAX pages.
+ *
+ * Input Parameters:
+ *   vaddr  - The virtual address of the first page to flush
+ *   npages - The number of pages to flush
+ *
+ ****************************************************************************/
+
+static inline void mmu_invalidate_tlb_range(uintptr_t vaddr, size_t npages)
+{
+  if (npages > RV_MMU_TLB_RANGE_MAX)
+    {
+      mmu_invalidate_tlbs();
+      return;
+    }
+
+  for (; npages > 0; npages--, vaddr += RV_MMU_PAGE_SIZE)
+    {
+      mmu_invalidate_tlb_by_vaddr(vaddr);
+    }
+}
+
 /****************************************************************************
  * Name: mmu_enable
  *
@@ -464,6 +495,27 @@ void mmu_ln_restore(uint32_t ptlevel, uintptr_t lnvaddr, uintptr_t vaddr,
 #define mmu_ln_clear(ptlevel, lnvaddr, vaddr) \
   mmu_ln_restore(ptlevel, lnvaddr, vaddr, 0)
 
+/****************************************************************************
+ * Name: mmu_ln_clear_batch
+ *
+ * Description:
+ *   Unmap a level n translation table entry, as mmu_ln_clear() but without
+ *   flushing the TLB:  The caller flushes the TLB once for all the entries
+ *   it unmapped, see mmu_invalidate_tlb_range().
+ *
+ * Input Parameters:
+ *   ptlevel - The translation table level, amount of levels is
+ *     MMU implementation specific
+ *   lnvaddr - The virtual address of the beginning of the page table at
+ *     level n
+ *   vaddr - The virtual address to get pte for. Must be aligned to a PPN
+ *     address boundary which is dependent on the level of the entry
+ *
+ ****************************************************************************/
+
+void mmu_ln_clear_batch(uint32_t ptlevel, uintptr_t lnvaddr,
+                        uintptr_t vaddr);
+
 /****************************************************************************
  * Name: mmu_ln_map_region
  *
@@ -22,6 +22,10 @@
  * Included Files
  ****************************************************************************/
 
+#ifdef __linux__
+#  define _GNU_SOURCE 1 /* For pthread_setaffinity_np() */
+#endif
+
 #include <stdint.h>
 #include <pthread.h>
 #include <stdlib.h>
@@ -29,6 +33,7 @@
 #include <signal.h>
 #include <sched.h>
 #include <errno.h>
+#include <unistd.h>
 
 #include "sim_internal.h"
 
@@ -57,6 +62,33 @@ static pthread_t     g_cpu_thread[CONFIG_SMP_NCPUS];
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: sim_cpu_pin
+ *
+ * Description:
+ *   Pin the host thread of the calling CPU to its host CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_CPU_AFFINITY
+static void sim_cpu_pin(int cpu)
+{
+  long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+  cpu_set_t cpuset;
+
+  if (ncpus <= 0)
+    {
+      return;
+    }
+
+  CPU_ZERO(&cpuset);
+  CPU_SET((CONFIG_SIM_CPU_AFFINITY_FIRST + cpu) % ncpus, &cpuset);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+}
+#else
+#  define sim_cpu_pin(cpu)
+#endif
+
 /****************************************************************************
  * Name: sim_idle_trampoline
  *
@@ -92,6 +124,8 @@ static void *sim_idle_trampoline(void *arg)
       return NULL;
     }
 
+  sim_cpu_pin(cpuinfo->cpu);
+
   /* Let up_cpu_start() continue */
 
   pthread_mutex_lock(&cpuinfo->cpu_init_lock);
@@ -163,6 +197,8 @@ void host_cpu0_start(void)
     {
       return;
     }
+
+  sim_cpu_pin(0);
 }
 
 /****************************************************************************
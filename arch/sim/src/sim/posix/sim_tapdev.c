@@ -64,7 +64,9 @@
 #include <sys/uio.h>
 #include <sys/socket.h>
 
+#include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <unistd.h>
@@ -108,9 +110,12 @@ struct sel_arg_struct
 #ifdef TAPDEV_DEBUG
 static int  gdrop = 0;
 #endif
-static int  gtapdevfd[CONFIG_SIM_NETDEV_NUMBER] =
+static int  gtapdevfd[CONFIG_SIM_NETDEV_NUMBER][CONFIG_SIM_NETDEV_QUEUES] =
 {
-  [0 ... CONFIG_SIM_NETDEV_NUMBER - 1] = -1
+  [0 ... CONFIG_SIM_NETDEV_NUMBER - 1] =
+  {
+    [0 ... CONFIG_SIM_NETDEV_QUEUES - 1] = -1
+  }
 };
 static char gdevname[CONFIG_SIM_NETDEV_NUMBER][IFNAMSIZ];
 static void *g_priv[CONFIG_SIM_NETDEV_NUMBER];
@@ -149,6 +154,44 @@ static inline void dump_ethhdr(const char *msg, unsigned char *buf,
 #  define dump_ethhdr(m,b,l)
 #endif
 
+/* Open one queue of the tap device 'ifr', that gets the name of the device
+ * the first time.  The queues are non-blocking, so that the frames are
+ * read until there are no more without polling for each one.
+ */
+
+static int tapdev_open(struct ifreq *ifr)
+{
+  int tapdevfd;
+  int ret;
+
+  tapdevfd = open(DEVTAP, O_RDWR | O_NONBLOCK, 0644);
+  if (tapdevfd < 0)
+    {
+      syslog(LOG_ERR, "TAPDEV: open failed: %d\n", -tapdevfd);
+      return -1;
+    }
+
+  ret = ioctl(tapdevfd, TUNSETIFF, (unsigned long)ifr);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "TAPDEV: ioctl failed: %d\n", -ret);
+      close(tapdevfd);
+      return -1;
+    }
+
+  return tapdevfd;
+}
+
+static void tapdev_close(int *tapdevfd, int nqueues)
+{
+  int queue;
+
+  for (queue = 0; queue < nqueues; queue++)
+    {
+      close(tapdevfd[queue]);
+    }
+}
+
 static void set_macaddr(int devidx)
 {
   unsigned char mac[7];
@@ -190,30 +233,28 @@ void sim_tapdev_init(int devidx, void *priv,
                  void (*tx_done_intr_cb)(void *priv),
                  void (*rx_ready_intr_cb)(void *priv))
 {
+  int tapdevfd[CONFIG_SIM_NETDEV_QUEUES];
   struct ifreq ifr;
-  int tapdevfd;
+  int queue;
   int ret;
   int sockfd;
 
-  /* Open the tap device */
-
-  tapdevfd = open(DEVTAP, O_RDWR, 0644);
-  if (tapdevfd < 0)
-    {
-      syslog(LOG_ERR, "TAPDEV: open failed: %d\n", -tapdevfd);
-      return;
-    }
-
-  /* Configure the tap device */
+  /* Open and configure the queues of the tap device */
 
   memset(&ifr, 0, sizeof(ifr));
   ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
-  ret = ioctl(tapdevfd, TUNSETIFF, (unsigned long) &ifr);
-  if (ret < 0)
+#if CONFIG_SIM_NETDEV_QUEUES > 1
+  ifr.ifr_flags |= IFF_MULTI_QUEUE;
+#endif
+
+  for (queue = 0; queue < CONFIG_SIM_NETDEV_QUEUES; queue++)
     {
-      syslog(LOG_ERR, "TAPDEV: ioctl failed: %d\n", -ret);
-      close(tapdevfd);
-      return;
+      tapdevfd[queue] = tapdev_open(&ifr);
+      if (tapdevfd[queue] < 0)
+        {
+          tapdev_close(tapdevfd, queue);
+          return;
+        }
     }
 
   /* Save the tap device name */
@@ -228,7 +269,7 @@ void sim_tapdev_init(int devidx, void *priv,
   if (sockfd < 0)
     {
       syslog(LOG_ERR, "TAPDEV: Can't open socket: %d\n", -sockfd);
-      close(tapdevfd);
+      tapdev_close(tapdevfd, CONFIG_SIM_NETDEV_QUEUES);
       return;
     }
 
@@ -246,7 +287,7 @@ void sim_tapdev_init(int devidx, void *priv,
              "bridge %s): %d\n",
              gdevname[devidx], CONFIG_SIM_NET_BRIDGE_DEVICE, -ret);
       close(sockfd);
-      close(tapdevfd);
+      tapdev_close(tapdevfd, CONFIG_SIM_NETDEV_QUEUES);
       return;
     }
 #endif
@@ -260,7 +301,7 @@ void sim_tapdev_init(int devidx, void *priv,
       syslog(LOG_ERR, "TAPDEV: ioctl failed (can't set MTU "
                       "for %s): %d\n", gdevname[devidx], -ret);
       close(sockfd);
-      close(tapdevfd);
+      tapdev_close(tapdevfd, CONFIG_SIM_NETDEV_QUEUES);
       return;
     }
 
@@ -270,7 +311,7 @@ void sim_tapdev_init(int devidx, void *priv,
     {
       syslog(LOG_ERR, "TAPDEV: ioctl failed (can't get MTU "
              "from %s): %d\n", gdevname[devidx], -ret);
-      close(tapdevfd);
+      tapdev_close(tapdevfd, CONFIG_SIM_NETDEV_QUEUES);
       return;
     }
   else
@@ -278,7 +319,7 @@ void sim_tapdev_init(int devidx, void *priv,
       sim_netdriver_setmtu(devidx, ifr.ifr_mtu);
     }
 
-  gtapdevfd[devidx] = tapdevfd;
+  memcpy(gtapdevfd[devidx], tapdevfd, sizeof(tapdevfd));
   g_priv[devidx] = priv;
 
   /* Register the emulated TX done interrupt callback */
@@ -296,41 +337,67 @@ void sim_tapdev_init(int devidx, void *priv,
 
 int sim_tapdev_avail(int devidx)
 {
-  struct timeval tv;
-  fd_set fdset;
+  return sim_tapdev_pending(devidx) != 0;
+}
+
+unsigned int sim_tapdev_pending(int devidx)
+{
+  struct pollfd fds[CONFIG_SIM_NETDEV_QUEUES];
+  unsigned int pending = 0;
+  int queue;
 
   /* We can't do anything if we failed to open the tap device */
 
-  if (gtapdevfd[devidx] < 0)
+  if (gtapdevfd[devidx][0] < 0)
     {
       return 0;
     }
 
-  /* Wait for data on the tap device (or a timeout) */
+  /* Check all queues for data at once, without waiting */
 
-  tv.tv_sec  = 0;
-  tv.tv_usec = 0;
+  for (queue = 0; queue < CONFIG_SIM_NETDEV_QUEUES; queue++)
+    {
+      fds[queue].fd      = gtapdevfd[devidx][queue];
+      fds[queue].events  = POLLIN;
+      fds[queue].revents = 0;
+    }
 
-  FD_ZERO(&fdset);
-  FD_SET(gtapdevfd[devidx], &fdset);
+  if (poll(fds, CONFIG_SIM_NETDEV_QUEUES, 0) > 0)
+    {
+      for (queue = 0; queue < CONFIG_SIM_NETDEV_QUEUES; queue++)
+        {
+          if (fds[queue].revents & POLLIN)
+            {
+              pending |= 1u << queue;
+            }
+        }
+    }
 
-  return select(gtapdevfd[devidx] + 1, &fdset, NULL, NULL, &tv) > 0;
+  return pending;
 }
 
-unsigned int sim_tapdev_read(int devidx, unsigned char *buf,
-                             unsigned int buflen)
+unsigned int sim_tapdev_readq(int devidx, int queue, unsigned char *buf,
+                              unsigned int buflen)
 {
   int ret;
 
-  if (!sim_tapdev_avail(devidx))
+  if (gtapdevfd[devidx][queue] < 0)
     {
       return 0;
     }
 
-  ret = read(gtapdevfd[devidx], buf, buflen);
+  /* The queue is non-blocking:  The frames are read one after the other
+   * until there are no more, with no poll in between.
+   */
+
+  ret = read(gtapdevfd[devidx][queue], buf, buflen);
   if (ret < 0)
     {
-      syslog(LOG_ERR, "TAPDEV: read failed: %d\n", -ret);
+      if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+          syslog(LOG_ERR, "TAPDEV: read failed: %d\n", -errno);
+        }
+
       return 0;
     }
 
@@ -338,11 +405,18 @@ unsigned int sim_tapdev_read(int devidx, unsigned char *buf,
   return ret;
 }
 
-void sim_tapdev_send(int devidx, unsigned char *buf, unsigned int buflen)
+unsigned int sim_tapdev_read(int devidx, unsigned char *buf,
+                             unsigned int buflen)
+{
+  return sim_tapdev_readq(devidx, 0, buf, buflen);
+}
+
+void sim_tapdev_sendq(int devidx, int queue, unsigned char *buf,
+                      unsigned int buflen)
 {
   int ret;
 
-  if (gtapdevfd[devidx] < 0)
+  if (gtapdevfd[devidx][queue] < 0)
     {
       return;
     }
@@ -358,14 +432,31 @@ void sim_tapdev_send(int devidx, unsigned char *buf, unsigned int buflen)
     }
 #endif
 
-  ret = write(gtapdevfd[devidx], buf, buflen);
+  ret = write(gtapdevfd[devidx][queue], buf, buflen);
   if (ret < 0)
     {
-      syslog(LOG_ERR, "TAPDEV: write failed: %d\n", -ret);
+      /* The queue of the host is full, drop the frame as a NIC would */
+
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+          return;
+        }
+
+      syslog(LOG_ERR, "TAPDEV: write failed: %d\n", -errno);
       exit(1);
     }
 
   dump_ethhdr("write", buf, buflen);
+}
+
+void sim_tapdev_send(int devidx, unsigned char *buf, unsigned int buflen)
+{
+  if (gtapdevfd[devidx][0] < 0)
+    {
+      return;
+    }
+
+  sim_tapdev_sendq(devidx, 0, buf, buflen);
 
   /* Emulate TX done interrupt */
 
@@ -394,7 +485,7 @@ void sim_tapdev_ifup(int devidx, void *ifaddr)
 #  endif
 #endif
 
-  if (gtapdevfd[devidx] < 0)
+  if (gtapdevfd[devidx][0] < 0)
     {
       return;
     }
@@ -479,7 +570,7 @@ void sim_tapdev_ifdown(int devidx)
   int sockfd;
   int ret;
 
-  if (gtapdevfd[devidx] < 0)
+  if (gtapdevfd[devidx][0] < 0)
     {
       return;
     }
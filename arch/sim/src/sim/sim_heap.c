@@ -26,6 +26,7 @@
 
 #include <assert.h>
 #include <debug.h>
+#include <errno.h>
 #include <string.h>
 #include <stdbool.h>
 
@@ -339,6 +340,19 @@ void mm_free_delaylist(struct mm_heap_s *heap)
     }
 }
 
+/****************************************************************************
+ * Name: mm_reclaim
+ *
+ * Description:
+ *   The host heap has no memory pools to reclaim.
+ *
+ ****************************************************************************/
+
+size_t mm_reclaim(struct mm_heap_s *heap)
+{
+  return 0;
+}
+
 /****************************************************************************
  * Name: mm_realloc
  *
@@ -678,6 +692,20 @@ size_t mm_heapfree_largest(FAR struct mm_heap_s *heap)
   return SIZE_MAX;
 }
 
+/****************************************************************************
+ * Name: mm_fraginfo
+ *
+ * Description:
+ *   Return the free memory of the heap by size class, which the host heap
+ *   does not provide.
+ *
+ ****************************************************************************/
+
+int mm_fraginfo(FAR struct mm_heap_s *heap, FAR struct mm_fraginfo_s *info)
+{
+  return -ENOSYS;
+}
+
 #else /* CONFIG_MM_CUSTOMIZE_MANAGER */
 
 void up_allocate_heap(void **heap_start, size_t *heap_size)
@@ -64,6 +64,10 @@
 #  define CONFIG_SIM_WIFIDEV_NUMBER 0
 #endif
 
+#ifndef CONFIG_SIM_NETDEV_QUEUES
+#  define CONFIG_SIM_NETDEV_QUEUES 1
+#endif
+
 /* Determine which (if any) console driver to use */
 
 #ifndef CONFIG_DEV_CONSOLE
@@ -355,6 +359,16 @@ void sim_tapdev_send(int devidx, unsigned char *buf, unsigned int buflen);
 void sim_tapdev_ifup(int devidx, void *ifaddr);
 void sim_tapdev_ifdown(int devidx);
 
+/* The queues of a multi-queue TAP device, as a bitmask of the queues with
+ * frames pending for pending()
+ */
+
+unsigned int sim_tapdev_pending(int devidx);
+unsigned int sim_tapdev_readq(int devidx, int queue, unsigned char *buf,
+                              unsigned int buflen);
+void sim_tapdev_sendq(int devidx, int queue, unsigned char *buf,
+                      unsigned int buflen);
+
 #  define sim_netdev_init(idx,priv,txcb,rxcb) sim_tapdev_init(idx,priv,txcb,rxcb)
 #  define sim_netdev_avail(idx)               sim_tapdev_avail(idx)
 #  define sim_netdev_read(idx,buf,buflen)     sim_tapdev_read(idx,buf,buflen)
@@ -84,8 +84,9 @@
 
 /* Get index / buffer from dev pointer. */
 
-#define DEVIDX(p) ((struct sim_netdev_s *)(p) - g_sim_dev)
-#define DEVBUF(p) (((struct sim_netdev_s *)(p))->buf)
+#define DEVIDX(p)     ((struct sim_netdev_s *)(p) - g_sim_dev)
+#define DEVQBUF(p, q) (((struct sim_netdev_s *)(p))->buf[q])
+#define DEVBUF(p)     DEVQBUF(p, 0)
 
 #if CONFIG_SIM_WIFIDEV_NUMBER != 0
 #  include "sim_wifidriver.c"
@@ -97,7 +98,10 @@
 struct sim_netdev_s
 {
   struct netdev_lowerhalf_s dev;
-  uint8_t buf[SIM_NETDEV_BUFSIZE]; /* Used when packet buffer is fragmented */
+
+  /* Used when packet buffer is fragmented, one per queue */
+
+  uint8_t buf[CONFIG_SIM_NETDEV_QUEUES][SIM_NETDEV_BUFSIZE];
 };
 #endif
 
@@ -109,6 +113,12 @@ static int netdriver_send(struct netdev_lowerhalf_s *dev, netpkt_t *pkt);
 static netpkt_t *netdriver_recv(struct netdev_lowerhalf_s *dev);
 static int netdriver_ifup(struct netdev_lowerhalf_s *dev);
 static int netdriver_ifdown(struct netdev_lowerhalf_s *dev);
+#if CONFIG_SIM_NETDEV_QUEUES > 1
+static int netdriver_sendq(struct netdev_lowerhalf_s *dev, netpkt_t *pkt,
+                           unsigned int queue);
+static netpkt_t *netdriver_recvq(struct netdev_lowerhalf_s *dev,
+                                 unsigned int queue);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -122,7 +132,24 @@ static const struct netdev_ops_s g_ops =
   netdriver_ifup,   /* ifup */
   netdriver_ifdown, /* ifdown */
   netdriver_send,   /* transmit */
-  netdriver_recv    /* receive */
+  netdriver_recv,   /* receive */
+#if CONFIG_SIM_NETDEV_QUEUES > 1
+#  ifdef CONFIG_NET_MCASTGROUP
+  NULL,             /* addmac */
+  NULL,             /* rmmac */
+#  endif
+#  ifdef CONFIG_NETDEV_IOCTL
+  NULL,             /* ioctl */
+#  endif
+  NULL,             /* reclaim */
+#  ifdef CONFIG_NETDEV_NAPI
+  NULL,             /* rxint */
+#  endif
+  netdriver_sendq,  /* transmitq */
+  netdriver_recvq,  /* receiveq */
+  NULL,             /* reclaimq */
+  NULL              /* steer, the host steers the flows itself */
+#endif
 };
 
 /****************************************************************************
@@ -186,6 +213,68 @@ static netpkt_t *netdriver_recv(struct netdev_lowerhalf_s *dev)
   return pkt;
 }
 
+#if CONFIG_SIM_NETDEV_QUEUES > 1
+static int netdriver_sendq(struct netdev_lowerhalf_s *dev, netpkt_t *pkt,
+                           unsigned int queue)
+{
+  unsigned int len = netpkt_getdatalen(dev, pkt);
+
+  /* The queue is only served by its own worker, so is its buffer */
+
+  if (netpkt_is_fragmented(pkt))
+    {
+      netpkt_copyout(dev, DEVQBUF(dev, queue), pkt, len, 0);
+      sim_tapdev_sendq(DEVIDX(dev), queue, DEVQBUF(dev, queue), len);
+    }
+  else
+    {
+      sim_tapdev_sendq(DEVIDX(dev), queue, netpkt_getdata(dev, pkt), len);
+    }
+
+  netpkt_free(dev, pkt, NETPKT_TX);
+  netdev_lower_txdone_queue(dev, queue);
+  return OK;
+}
+
+static netpkt_t *netdriver_recvq(struct netdev_lowerhalf_s *dev,
+                                 unsigned int queue)
+{
+  netpkt_t *pkt;
+  unsigned int len;
+
+  /* Read the frames of the queue until there are no more, without asking
+   * the host whether there is one before each of them.
+   */
+
+  pkt = netpkt_alloc(dev, NETPKT_RX);
+  if (pkt == NULL)
+    {
+      return NULL;
+    }
+
+#ifdef SIM_NETDEV_RECV_OFFLOAD
+  len = sim_tapdev_readq(DEVIDX(dev), queue, netpkt_getdata(dev, pkt),
+                         SIM_NETDEV_BUFSIZE);
+#else
+  len = sim_tapdev_readq(DEVIDX(dev), queue, DEVQBUF(dev, queue),
+                         SIM_NETDEV_BUFSIZE);
+#endif
+  if (len == 0)
+    {
+      netpkt_free(dev, pkt, NETPKT_RX);
+      return NULL;
+    }
+
+#ifdef SIM_NETDEV_RECV_OFFLOAD
+  netpkt_setdatalen(dev, pkt, len);
+#else
+  netpkt_copyin(dev, pkt, DEVQBUF(dev, queue), len, 0);
+#endif
+
+  return pkt;
+}
+#endif
+
 static int netdriver_ifup(struct netdev_lowerhalf_s *dev)
 {
 #ifdef CONFIG_NET_IPv4
@@ -249,11 +338,14 @@ int sim_netdriver_init(void)
                       netdriver_txdone_interrupt,
                       netdriver_rxready_interrupt);
 
-      /* 1TX + 1RX is enough for sim. */
+      /* 1TX + 1RX per queue is enough for sim. */
 
-      dev->quota[NETPKT_TX] = 1;
-      dev->quota[NETPKT_RX] = 1;
+      dev->quota[NETPKT_TX] = CONFIG_SIM_NETDEV_QUEUES;
+      dev->quota[NETPKT_RX] = CONFIG_SIM_NETDEV_QUEUES;
       dev->ops              = &g_ops;
+#if CONFIG_SIM_NETDEV_QUEUES > 1
+      dev->nqueues          = CONFIG_SIM_NETDEV_QUEUES;
+#endif
 
 #if CONFIG_SIM_WIFIDEV_NUMBER != 0
       if (devidx < CONFIG_SIM_WIFIDEV_NUMBER)
@@ -288,6 +380,24 @@ void sim_netdriver_setmtu(int devidx, int mtu)
 void sim_netdriver_loop(void)
 {
   int devidx;
+#if CONFIG_SIM_NETDEV_QUEUES > 1
+  unsigned int pending;
+  unsigned int queue;
+
+  /* Ask the host once for all queues of a device */
+
+  for (devidx = 0; devidx < CONFIG_SIM_NETDEV_NUMBER; devidx++)
+    {
+      pending = sim_tapdev_pending(devidx);
+      for (queue = 0; pending != 0; queue++, pending >>= 1)
+        {
+          if (pending & 1)
+            {
+              netdev_lower_rxready_queue(&g_sim_dev[devidx].dev, queue);
+            }
+        }
+    }
+#else
   for (devidx = 0; devidx < CONFIG_SIM_NETDEV_NUMBER; devidx++)
     {
       if (sim_netdev_avail(devidx))
@@ -295,4 +405,5 @@ void sim_netdriver_loop(void)
           netdev_lower_rxready(&g_sim_dev[devidx].dev);
         }
     }
+#endif
 }
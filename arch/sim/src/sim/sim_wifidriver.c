@@ -157,7 +157,10 @@ struct sim_bss_info_s
 struct sim_netdev_s
 {
   struct netdev_lowerhalf_s dev;
-  uint8_t buf[SIM_NETDEV_BUFSIZE]; /* Used when packet buffer is fragmented */
+
+  /* Used when packet buffer is fragmented, one per queue */
+
+  uint8_t buf[CONFIG_SIM_NETDEV_QUEUES][SIM_NETDEV_BUFSIZE];
   char ssid[SSID_MAX_LEN];
   char bssid[ETH_ALEN];
   uint16_t channel;
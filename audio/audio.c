@@ -34,6 +34,7 @@
 #include <unistd.h>
 #include <string.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <assert.h>
 #include <errno.h>
 #include <debug.h>
@@ -42,7 +43,9 @@
 #include <nuttx/mqueue.h>
 #include <nuttx/arch.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/irq.h>
 #include <nuttx/audio/audio.h>
+#include <nuttx/mm/map.h>
 #include <nuttx/mutex.h>
 
 #include <arch/irq.h>
@@ -65,6 +68,11 @@
 #  define CONFIG_AUDIO_BUFFER_DEQUEUE_PRIO  1
 #endif
 
+/* The size of a shared ring with 'n' periods */
+
+#define AUDIO_RINGSIZE(n) \
+  (sizeof(struct audio_ring_s) + ((n) - 1) * sizeof(FAR uint8_t *))
+
 /****************************************************************************
  * Private Type Definitions
  ****************************************************************************/
@@ -78,6 +86,13 @@ struct audio_upperhalf_s
   mutex_t           lock;             /* Supports mutual exclusion */
   FAR struct audio_lowerhalf_s *dev;  /* lower-half state */
   struct file      *usermq;           /* User mode app's message queue */
+#ifdef CONFIG_AUDIO_LOWLATENCY
+  bool              capture;          /* True: the ring is an input */
+  uint32_t          queued;           /* Periods enqueued to the lower-half */
+  FAR struct audio_ring_s *ring;      /* The shared ring, or NULL */
+  FAR struct ap_buffer_s **ringapb;   /* The AP Buffer of each period */
+  FAR struct pollfd *fds[CONFIG_AUDIO_NPOLLWAITERS];
+#endif
 };
 
 /****************************************************************************
@@ -95,6 +110,14 @@ static ssize_t  audio_write(FAR struct file *filep,
 static int      audio_ioctl(FAR struct file *filep,
                             int cmd,
                             unsigned long arg);
+#ifdef CONFIG_AUDIO_LOWLATENCY
+static void     audio_freering(FAR struct audio_upperhalf_s *upper);
+static int      audio_mmap(FAR struct file *filep,
+                           FAR struct mm_map_entry_s *map);
+static int      audio_poll(FAR struct file *filep,
+                           FAR struct pollfd *fds,
+                           bool setup);
+#endif
 #ifdef CONFIG_AUDIO_MULTI_SESSION
 static int      audio_start(FAR struct audio_upperhalf_s *upper,
                             FAR void *session);
@@ -123,6 +146,11 @@ static const struct file_operations g_audioops =
   audio_write, /* write */
   NULL,        /* seek */
   audio_ioctl, /* ioctl */
+#ifdef CONFIG_AUDIO_LOWLATENCY
+  audio_mmap,  /* mmap */
+  NULL,        /* truncate */
+  audio_poll,  /* poll */
+#endif
 };
 
 /****************************************************************************
@@ -227,6 +255,12 @@ static int audio_close(FAR struct file *filep)
 
       lower->ops->shutdown(lower);
       upper->usermq = NULL;
+
+#ifdef CONFIG_AUDIO_LOWLATENCY
+      /* The shutdown dequeued all the periods of the ring */
+
+      audio_freering(upper);
+#endif
     }
 
   ret = OK;
@@ -236,6 +270,338 @@ errout:
   return ret;
 }
 
+#ifdef CONFIG_AUDIO_LOWLATENCY
+/****************************************************************************
+ * Name: audio_freering
+ *
+ * Description:
+ *   Free the shared ring and its periods.  None of the periods may be
+ *   enqueued to the lower-half.
+ *
+ ****************************************************************************/
+
+static void audio_freering(FAR struct audio_upperhalf_s *upper)
+{
+  FAR struct audio_lowerhalf_s *lower = upper->dev;
+  struct audio_buf_desc_s bufdesc;
+  uint32_t i;
+
+  if (upper->ring == NULL)
+    {
+      return;
+    }
+
+  for (i = 0; i < upper->ring->nperiods; i++)
+    {
+      if (upper->ringapb[i] == NULL)
+        {
+          continue;
+        }
+
+      memset(&bufdesc, 0, sizeof(bufdesc));
+      bufdesc.u.buffer = upper->ringapb[i];
+      if (lower->ops->freebuffer)
+        {
+          lower->ops->freebuffer(lower, &bufdesc);
+        }
+      else
+        {
+          apb_free(upper->ringapb[i]);
+        }
+    }
+
+  kmm_free(upper->ringapb);
+  kumm_free(upper->ring);
+  upper->ringapb = NULL;
+  upper->ring    = NULL;
+}
+
+/****************************************************************************
+ * Name: audio_queuering
+ *
+ * Description:
+ *   Enqueue to the lower-half the periods released by the application.  A
+ *   period refused because the queue of the lower-half is full is enqueued
+ *   again by the next AUDIOIOC_COMMITRING.
+ *
+ ****************************************************************************/
+
+static int audio_queuering(FAR struct audio_upperhalf_s *upper)
+{
+  FAR struct audio_lowerhalf_s *lower = upper->dev;
+  FAR struct audio_ring_s *ring = upper->ring;
+  FAR struct ap_buffer_s *apb;
+  int ret;
+
+  DEBUGASSERT(lower->ops->enqueuebuffer != NULL);
+
+  while (upper->queued != ring->appl)
+    {
+      apb = upper->ringapb[upper->queued % ring->nperiods];
+
+      apb->nbytes  = upper->capture ? 0 : ring->period_bytes;
+      apb->curbyte = 0;
+      apb->flags  &= ~(AUDIO_APB_OUTPUT_ENQUEUED | AUDIO_APB_OUTPUT_PROCESS |
+                       AUDIO_APB_DEQUEUED | AUDIO_APB_FINAL);
+
+      ret = lower->ops->enqueuebuffer(lower, apb);
+      if (ret < 0)
+        {
+          return ret == -ENOMEM ? OK : ret;
+        }
+
+      upper->queued++;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: audio_setupring
+ *
+ * Description:
+ *   Handle the AUDIOIOC_SETUPRING ioctl command:  Allocate the periods
+ *   with the lower-half, so that it can transfer them in place, and
+ *   enqueue them all for an input.
+ *
+ ****************************************************************************/
+
+static int audio_setupring(FAR struct audio_upperhalf_s *upper,
+                           FAR const struct audio_ring_desc_s *desc)
+{
+  FAR struct audio_lowerhalf_s *lower = upper->dev;
+  FAR struct audio_ring_s *ring;
+  struct audio_buf_desc_s bufdesc;
+  uint32_t i;
+  int ret;
+
+  if (upper->started)
+    {
+      return -EBUSY;
+    }
+
+  audio_freering(upper);
+  if (desc->nperiods == 0)
+    {
+      return OK;
+    }
+
+  if (desc->period_bytes == 0 ||
+      (desc->type != AUDIO_TYPE_OUTPUT && desc->type != AUDIO_TYPE_INPUT))
+    {
+      return -EINVAL;
+    }
+
+  ring = kumm_zalloc(AUDIO_RINGSIZE(desc->nperiods));
+  if (ring == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  upper->ringapb = kmm_zalloc(desc->nperiods *
+                              sizeof(FAR struct ap_buffer_s *));
+  if (upper->ringapb == NULL)
+    {
+      kumm_free(ring);
+      return -ENOMEM;
+    }
+
+  ring->nperiods     = desc->nperiods;
+  ring->period_bytes = desc->period_bytes;
+  upper->ring        = ring;
+
+  for (i = 0; i < ring->nperiods; i++)
+    {
+      memset(&bufdesc, 0, sizeof(bufdesc));
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+      bufdesc.session   = desc->session;
+#endif
+      bufdesc.numbytes  = desc->period_bytes;
+      bufdesc.u.pbuffer = &upper->ringapb[i];
+
+      if (lower->ops->allocbuffer)
+        {
+          ret = lower->ops->allocbuffer(lower, &bufdesc);
+        }
+      else
+        {
+          ret = apb_alloc(&bufdesc);
+        }
+
+      if (ret < 0)
+        {
+          upper->ringapb[i] = NULL;
+          audio_freering(upper);
+          return ret;
+        }
+
+      upper->ringapb[i]->flags |= AUDIO_APB_RING;
+      ring->period[i] = upper->ringapb[i]->samp;
+    }
+
+  /* An input starts with all the periods released */
+
+  upper->capture = desc->type == AUDIO_TYPE_INPUT;
+  upper->queued  = 0;
+  ring->appl     = upper->capture ? ring->nperiods : 0;
+
+  return audio_queuering(upper);
+}
+
+/****************************************************************************
+ * Name: audio_commitring
+ *
+ * Description:
+ *   Handle the AUDIOIOC_COMMITRING ioctl command
+ *
+ ****************************************************************************/
+
+static int audio_commitring(FAR struct audio_upperhalf_s *upper,
+                            uint32_t nperiods)
+{
+  FAR struct audio_ring_s *ring = upper->ring;
+
+  if (ring == NULL)
+    {
+      return -ENODEV;
+    }
+
+  if (nperiods > ring->nperiods - (ring->appl - ring->hw))
+    {
+      return -EINVAL;
+    }
+
+  ring->appl += nperiods;
+  return audio_queuering(upper);
+}
+
+/****************************************************************************
+ * Name: audio_ringevents
+ *
+ * Description:
+ *   Return the poll events of the ring:  Periods may be filled (output) or
+ *   consumed (input).
+ *
+ ****************************************************************************/
+
+static pollevent_t audio_ringevents(FAR struct audio_upperhalf_s *upper)
+{
+  FAR struct audio_ring_s *ring = upper->ring;
+
+  if (ring == NULL)
+    {
+      return POLLIN | POLLOUT;
+    }
+
+  if (ring->appl - ring->hw >= ring->nperiods)
+    {
+      return 0;
+    }
+
+  return upper->capture ? POLLIN : POLLOUT;
+}
+
+/****************************************************************************
+ * Name: audio_mmap
+ *
+ * Description:
+ *   Map the shared ring of the low-latency mode
+ *
+ ****************************************************************************/
+
+static int audio_mmap(FAR struct file *filep,
+                      FAR struct mm_map_entry_s *map)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct audio_upperhalf_s *upper = inode->i_private;
+  int ret;
+
+  ret = nxmutex_lock(&upper->lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (upper->ring == NULL)
+    {
+      ret = -ENODEV;
+    }
+  else if (map->offset != 0 || map->length == 0 ||
+           map->length > AUDIO_RINGSIZE(upper->ring->nperiods))
+    {
+      ret = -EINVAL;
+    }
+  else
+    {
+      map->vaddr = upper->ring;
+    }
+
+  nxmutex_unlock(&upper->lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: audio_poll
+ *
+ * Description:
+ *   Wait for the periods of the shared ring
+ *
+ ****************************************************************************/
+
+static int audio_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                      bool setup)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct audio_upperhalf_s *upper = inode->i_private;
+  irqstate_t flags;
+  int ret;
+  int i;
+
+  ret = nxmutex_lock(&upper->lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* The periods complete in the callback of the lower-half, which may run
+   * in an interrupt handler.
+   */
+
+  flags = enter_critical_section();
+  if (setup)
+    {
+      for (i = 0; i < CONFIG_AUDIO_NPOLLWAITERS; i++)
+        {
+          if (upper->fds[i] == NULL)
+            {
+              upper->fds[i] = fds;
+              fds->priv     = &upper->fds[i];
+              break;
+            }
+        }
+
+      if (i == CONFIG_AUDIO_NPOLLWAITERS)
+        {
+          ret = -EBUSY;
+        }
+      else
+        {
+          poll_notify(&fds, 1, audio_ringevents(upper));
+        }
+    }
+  else if (fds->priv != NULL)
+    {
+      FAR struct pollfd **slot = fds->priv;
+      *slot     = NULL;
+      fds->priv = NULL;
+    }
+
+  leave_critical_section(flags);
+  nxmutex_unlock(&upper->lock);
+  return ret;
+}
+#endif /* CONFIG_AUDIO_LOWLATENCY */
+
 /****************************************************************************
  * Name: audio_read
  *
@@ -649,6 +1015,35 @@ static int audio_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+#ifdef CONFIG_AUDIO_LOWLATENCY
+      /* AUDIOIOC_SETUPRING - Set up the shared ring
+       *
+       *   ioctl argument - pointer to an audio_ring_desc_s structure
+       */
+
+      case AUDIOIOC_SETUPRING:
+        {
+          audinfo("AUDIOIOC_SETUPRING\n");
+
+          ret = audio_setupring(upper,
+                  (FAR const struct audio_ring_desc_s *)((uintptr_t)arg));
+        }
+        break;
+
+      /* AUDIOIOC_COMMITRING - Release periods of the shared ring
+       *
+       *   ioctl argument - the number of periods
+       */
+
+      case AUDIOIOC_COMMITRING:
+        {
+          audinfo("AUDIOIOC_COMMITRING\n");
+
+          ret = audio_commitring(upper, (uint32_t)arg);
+        }
+        break;
+#endif
+
       /* Any unrecognized IOCTL commands might be
        * platform-specific ioctl commands
        */
@@ -911,6 +1306,20 @@ static void audio_callback(FAR void *handle, uint16_t reason,
     {
       case AUDIO_CALLBACK_DEQUEUE:
         {
+#ifdef CONFIG_AUDIO_LOWLATENCY
+          /* A period of the shared ring completed:  Wake up the pollers
+           * instead of sending a message.
+           */
+
+          if (apb != NULL && (apb->flags & AUDIO_APB_RING) != 0)
+            {
+              upper->ring->hw++;
+              poll_notify(upper->fds, CONFIG_AUDIO_NPOLLWAITERS,
+                          audio_ringevents(upper));
+              break;
+            }
+#endif
+
           /* Call the dequeue routine */
 
 #ifdef CONFIG_AUDIO_MULTI_SESSION
@@ -961,6 +1370,13 @@ static void audio_callback(FAR void *handle, uint16_t reason,
 
       case AUDIO_CALLBACK_UNDERRUN:
         {
+#ifdef CONFIG_AUDIO_LOWLATENCY
+          if (upper->ring != NULL)
+            {
+              upper->ring->xruns++;
+            }
+#endif
+
           /* send underrun status */
 #ifdef CONFIG_AUDIO_MULTI_SESSION
           audio_underrun(upper, apb, status, session);
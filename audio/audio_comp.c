@@ -25,10 +25,14 @@
  ****************************************************************************/
 
 #include <stdarg.h>
+#include <debug.h>
 
 #include <nuttx/audio/audio.h>
 #include <nuttx/audio/audio_comp.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wqueue.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -38,6 +42,45 @@
  * Private Types
  ****************************************************************************/
 
+#ifdef CONFIG_AUDIO_COMP_FANOUT
+/* A buffer in flight:  Each contained device that accepts buffers receives
+ * its own copy of the buffer descriptor, that shares the samples of the
+ * buffer.
+ */
+
+struct audio_comp_slot_s
+{
+  FAR struct ap_buffer_s *apb;      /* The buffer, NULL if the slot is free */
+  FAR struct ap_buffer_s *clones;   /* A copy per contained device */
+  uint8_t                 pending;  /* Copies not dequeued yet */
+};
+#endif
+
+#ifdef CONFIG_AUDIO_COMP_PARALLEL
+/* The operations dispatched concurrently to the contained devices */
+
+enum audio_comp_op_e
+{
+  AUDIO_COMP_CONFIGURE = 0,
+  AUDIO_COMP_START,
+  AUDIO_COMP_STOP,
+  AUDIO_COMP_PAUSE,
+  AUDIO_COMP_RESUME
+};
+
+/* An operation of a contained device run on the low priority work queue */
+
+struct audio_comp_priv_s;
+
+struct audio_comp_call_s
+{
+  struct work_s                 work;
+  FAR struct audio_comp_priv_s *priv;
+  int                           index;
+  int                           result;
+};
+#endif
+
 /* This structure describes the internal state of the audio composite */
 
 struct audio_comp_priv_s
@@ -53,6 +96,26 @@ struct audio_comp_priv_s
 
   FAR struct audio_lowerhalf_s **lower;
   int count;
+
+#ifdef CONFIG_AUDIO_COMP_FANOUT
+  /* The buffers in flight */
+
+  struct audio_comp_slot_s slots[CONFIG_AUDIO_COMP_NBUFFERS];
+  FAR struct ap_buffer_s *clones;
+  spinlock_t lock;
+  uint8_t nfanout;                  /* Devices that got the last buffer */
+  uint8_t ncomplete;                /* Devices that completed the stream */
+#endif
+
+#ifdef CONFIG_AUDIO_COMP_PARALLEL
+  /* The operation in progress and a call per contained device */
+
+  FAR struct audio_comp_call_s *calls;
+  FAR const struct audio_caps_s *caps;
+  FAR void *session;
+  uint8_t op;
+  sem_t done;
+#endif
 };
 
 /****************************************************************************
@@ -165,6 +228,374 @@ static const struct audio_ops_s g_audio_comp_ops =
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_AUDIO_COMP_PARALLEL
+/****************************************************************************
+ * Name: audio_comp_call
+ *
+ * Description:
+ *   Run the operation in progress on a contained device.
+ *
+ ****************************************************************************/
+
+static int audio_comp_call(FAR struct audio_comp_priv_s *priv, int i)
+{
+  FAR struct audio_lowerhalf_s *lower = priv->lower[i];
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+  FAR void **sess = priv->session;
+#endif
+
+  switch (priv->op)
+    {
+      case AUDIO_COMP_CONFIGURE:
+        if (lower->ops->configure)
+          {
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+            return lower->ops->configure(lower, sess[i], priv->caps);
+#else
+            return lower->ops->configure(lower, priv->caps);
+#endif
+          }
+        break;
+
+      case AUDIO_COMP_START:
+        if (lower->ops->start)
+          {
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+            return lower->ops->start(lower, sess[i]);
+#else
+            return lower->ops->start(lower);
+#endif
+          }
+        break;
+
+#ifndef CONFIG_AUDIO_EXCLUDE_STOP
+      case AUDIO_COMP_STOP:
+        if (lower->ops->stop)
+          {
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+            return lower->ops->stop(lower, sess[i]);
+#else
+            return lower->ops->stop(lower);
+#endif
+          }
+        break;
+#endif
+
+#ifndef CONFIG_AUDIO_EXCLUDE_PAUSE_RESUME
+      case AUDIO_COMP_PAUSE:
+        if (lower->ops->pause)
+          {
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+            return lower->ops->pause(lower, sess[i]);
+#else
+            return lower->ops->pause(lower);
+#endif
+          }
+        break;
+
+      case AUDIO_COMP_RESUME:
+        if (lower->ops->resume)
+          {
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+            return lower->ops->resume(lower, sess[i]);
+#else
+            return lower->ops->resume(lower);
+#endif
+          }
+        break;
+#endif
+
+      default:
+        break;
+    }
+
+  return -ENOTTY;
+}
+
+/****************************************************************************
+ * Name: audio_comp_worker
+ ****************************************************************************/
+
+static void audio_comp_worker(FAR void *arg)
+{
+  FAR struct audio_comp_call_s *call = arg;
+
+  call->result = audio_comp_call(call->priv, call->index);
+  nxsem_post(&call->priv->done);
+}
+
+/****************************************************************************
+ * Name: audio_comp_parallel
+ *
+ * Description:
+ *   Run an operation on all the contained devices at once:  The first one
+ *   in the calling thread, the others on the low priority work queue.  A
+ *   start or a resume that fails on any device is undone on the others.
+ *
+ ****************************************************************************/
+
+static int audio_comp_parallel(FAR struct audio_comp_priv_s *priv,
+                               uint8_t op, FAR void *session,
+                               FAR const struct audio_caps_s *caps)
+{
+  FAR struct audio_comp_call_s *call;
+  int nqueued = 0;
+  int ret = -ENOTTY;
+  int i;
+
+  priv->op      = op;
+  priv->session = session;
+  priv->caps    = caps;
+
+  for (i = 1; i < priv->count; i++)
+    {
+      call        = &priv->calls[i];
+      call->priv  = priv;
+      call->index = i;
+
+      if (work_queue(LPWORK, &call->work, audio_comp_worker, call, 0) < 0)
+        {
+          call->result = audio_comp_call(priv, i);
+        }
+      else
+        {
+          nqueued++;
+        }
+    }
+
+  priv->calls[0].result = audio_comp_call(priv, 0);
+
+  while (nqueued-- > 0)
+    {
+      nxsem_wait_uninterruptible(&priv->done);
+    }
+
+  for (i = 0; i < priv->count; i++)
+    {
+      int tmp = priv->calls[i].result;
+      if (tmp == -ENOTTY)
+        {
+          continue;
+        }
+
+      if (tmp < 0 || ret == -ENOTTY || ret >= 0)
+        {
+          ret = tmp;
+        }
+    }
+
+  if (ret < 0 && (op == AUDIO_COMP_START || op == AUDIO_COMP_RESUME))
+    {
+      priv->op = op == AUDIO_COMP_START ? AUDIO_COMP_STOP : AUDIO_COMP_PAUSE;
+      for (i = priv->count - 1; i >= 0; i--)
+        {
+          if (priv->calls[i].result >= 0)
+            {
+              audio_comp_call(priv, i);
+            }
+        }
+    }
+
+  return ret;
+}
+#endif /* CONFIG_AUDIO_COMP_PARALLEL */
+
+#ifdef CONFIG_AUDIO_COMP_FANOUT
+/****************************************************************************
+ * Name: audio_comp_findslot
+ *
+ * Description:
+ *   Return the slot of a copy of a buffer given to a contained device, NULL
+ *   if the buffer is not such a copy.
+ *
+ ****************************************************************************/
+
+static FAR struct audio_comp_slot_s *
+audio_comp_findslot(FAR struct audio_comp_priv_s *priv,
+                    FAR struct ap_buffer_s *apb)
+{
+  FAR struct audio_comp_slot_s *slot = NULL;
+  irqstate_t flags;
+  int i;
+
+  flags = spin_lock_irqsave(&priv->lock);
+  for (i = 0; i < CONFIG_AUDIO_COMP_NBUFFERS; i++)
+    {
+      if (priv->slots[i].apb != NULL && apb >= priv->slots[i].clones &&
+          apb < priv->slots[i].clones + priv->count)
+        {
+          slot = &priv->slots[i];
+          break;
+        }
+    }
+
+  spin_unlock_irqrestore(&priv->lock, flags);
+  return slot;
+}
+
+/****************************************************************************
+ * Name: audio_comp_putslot
+ *
+ * Description:
+ *   Drop a reference to a slot.  Return its buffer once all the copies are
+ *   dequeued and the slot is free, NULL otherwise.
+ *
+ ****************************************************************************/
+
+static FAR struct ap_buffer_s *
+audio_comp_putslot(FAR struct audio_comp_priv_s *priv,
+                   FAR struct audio_comp_slot_s *slot)
+{
+  FAR struct ap_buffer_s *apb = NULL;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&priv->lock);
+  if (--slot->pending == 0)
+    {
+      apb       = slot->apb;
+      slot->apb = NULL;
+    }
+
+  spin_unlock_irqrestore(&priv->lock, flags);
+  return apb;
+}
+
+/****************************************************************************
+ * Name: audio_comp_fanout
+ *
+ * Description:
+ *   Give a copy of the descriptor of a buffer to each contained device that
+ *   accepts buffers.  The slot holds a reference while the copies are
+ *   enqueued, so that it stays in use if a device dequeues its copy at
+ *   once.
+ *
+ ****************************************************************************/
+
+static int audio_comp_fanout(FAR struct audio_comp_priv_s *priv,
+                             FAR struct ap_buffer_s *apb)
+{
+  FAR struct audio_lowerhalf_s **lower = priv->lower;
+  FAR struct audio_comp_slot_s *slot = NULL;
+  FAR struct ap_buffer_s *clone;
+  irqstate_t flags;
+  int ret = -ENOTTY;
+  int n = 0;
+  int i;
+
+  flags = spin_lock_irqsave(&priv->lock);
+  for (i = 0; i < CONFIG_AUDIO_COMP_NBUFFERS; i++)
+    {
+      if (priv->slots[i].apb == NULL)
+        {
+          slot          = &priv->slots[i];
+          slot->apb     = apb;
+          slot->pending = 1;
+          break;
+        }
+    }
+
+  spin_unlock_irqrestore(&priv->lock, flags);
+
+  if (slot == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0; i < priv->count; i++)
+    {
+      if (lower[i]->ops->enqueuebuffer == NULL)
+        {
+          continue;
+        }
+
+      clone            = &slot->clones[i];
+      clone->i         = apb->i;
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+      clone->session   = apb->session;
+#endif
+      clone->nmaxbytes = apb->nmaxbytes;
+      clone->nbytes    = apb->nbytes;
+      clone->curbyte   = apb->curbyte;
+      clone->nsamples  = apb->nsamples;
+      clone->flags     = apb->flags;
+      clone->crefs     = 1;
+      clone->samp      = apb->samp;
+
+      flags = spin_lock_irqsave(&priv->lock);
+      slot->pending++;
+      spin_unlock_irqrestore(&priv->lock, flags);
+
+      ret = lower[i]->ops->enqueuebuffer(lower[i], clone);
+      if (ret < 0)
+        {
+          if (ret != -ENOTTY)
+            {
+              auderr("ERROR: Device %d refused %p: %d\n", i, apb, ret);
+            }
+
+          audio_comp_putslot(priv, slot);
+          continue;
+        }
+
+      n++;
+    }
+
+  if (n > 0)
+    {
+      /* The buffer is in flight, even if some of the devices refused it */
+
+      priv->nfanout = n;
+      ret = OK;
+    }
+
+  if (audio_comp_putslot(priv, slot) != NULL && n > 0)
+    {
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+      priv->export.upper(priv->export.priv, AUDIO_CALLBACK_DEQUEUE, apb,
+                         OK, apb->session);
+#else
+      priv->export.upper(priv->export.priv, AUDIO_CALLBACK_DEQUEUE, apb,
+                         OK);
+#endif
+    }
+
+  return ret;
+}
+#endif /* CONFIG_AUDIO_COMP_FANOUT */
+
+/****************************************************************************
+ * Name: audio_comp_freeres
+ *
+ * Description:
+ *   Free the buffer copies and the calls of a composite device.
+ *
+ ****************************************************************************/
+
+static void audio_comp_freeres(FAR struct audio_comp_priv_s *priv)
+{
+#ifdef CONFIG_AUDIO_COMP_FANOUT
+  int i;
+
+  if (priv->clones != NULL)
+    {
+      for (i = 0; i < CONFIG_AUDIO_COMP_NBUFFERS * priv->count; i++)
+        {
+          nxmutex_destroy(&priv->clones[i].lock);
+        }
+
+      kmm_free(priv->clones);
+    }
+#endif
+
+#ifdef CONFIG_AUDIO_COMP_PARALLEL
+  if (priv->calls != NULL)
+    {
+      nxsem_destroy(&priv->done);
+      kmm_free(priv->calls);
+    }
+#endif
+}
+
 /****************************************************************************
  * Name: audio_comp_getcaps
  *
@@ -249,6 +680,14 @@ static int audio_comp_configure(FAR struct audio_lowerhalf_s *dev,
   int ret = -ENOTTY;
   int i;
 
+#ifdef CONFIG_AUDIO_COMP_PARALLEL
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+  return audio_comp_parallel(priv, AUDIO_COMP_CONFIGURE, session, caps);
+#else
+  return audio_comp_parallel(priv, AUDIO_COMP_CONFIGURE, NULL, caps);
+#endif
+#endif
+
   for (i = 0; i < priv->count; i++)
     {
       if (lower[i]->ops->configure)
@@ -332,6 +771,18 @@ static int audio_comp_start(FAR struct audio_lowerhalf_s *dev)
   int ret = -ENOTTY;
   int i;
 
+#ifdef CONFIG_AUDIO_COMP_FANOUT
+  priv->ncomplete = 0;
+#endif
+
+#ifdef CONFIG_AUDIO_COMP_PARALLEL
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+  return audio_comp_parallel(priv, AUDIO_COMP_START, session, NULL);
+#else
+  return audio_comp_parallel(priv, AUDIO_COMP_START, NULL, NULL);
+#endif
+#endif
+
   for (i = 0; i < priv->count; i++)
     {
       if (lower[i]->ops->start)
@@ -394,6 +845,14 @@ static int audio_comp_stop(FAR struct audio_lowerhalf_s *dev)
   int ret = -ENOTTY;
   int i;
 
+#ifdef CONFIG_AUDIO_COMP_PARALLEL
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+  return audio_comp_parallel(priv, AUDIO_COMP_STOP, session, NULL);
+#else
+  return audio_comp_parallel(priv, AUDIO_COMP_STOP, NULL, NULL);
+#endif
+#endif
+
   for (i = priv->count - 1; i >= 0; i--)
     {
       if (lower[i]->ops->stop)
@@ -442,6 +901,14 @@ static int audio_comp_pause(FAR struct audio_lowerhalf_s *dev)
   int ret = -ENOTTY;
   int i;
 
+#ifdef CONFIG_AUDIO_COMP_PARALLEL
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+  return audio_comp_parallel(priv, AUDIO_COMP_PAUSE, session, NULL);
+#else
+  return audio_comp_parallel(priv, AUDIO_COMP_PAUSE, NULL, NULL);
+#endif
+#endif
+
   for (i = priv->count - 1; i >= 0; i--)
     {
       if (lower[i]->ops->pause)
@@ -490,6 +957,14 @@ static int audio_comp_resume(FAR struct audio_lowerhalf_s *dev)
   int ret = -ENOTTY;
   int i;
 
+#ifdef CONFIG_AUDIO_COMP_PARALLEL
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+  return audio_comp_parallel(priv, AUDIO_COMP_RESUME, session, NULL);
+#else
+  return audio_comp_parallel(priv, AUDIO_COMP_RESUME, NULL, NULL);
+#endif
+#endif
+
   for (i = 0; i < priv->count; i++)
     {
       if (lower[i]->ops->resume)
@@ -615,6 +1090,10 @@ static int audio_comp_enqueuebuffer(FAR struct audio_lowerhalf_s *dev,
   int ret = -ENOTTY;
   int i;
 
+#ifdef CONFIG_AUDIO_COMP_FANOUT
+  return audio_comp_fanout(priv, apb);
+#endif
+
   for (i = 0; i < priv->count; i++)
     {
       if (lower[i]->ops->enqueuebuffer)
@@ -645,6 +1124,37 @@ static int audio_comp_cancelbuffer(FAR struct audio_lowerhalf_s *dev,
   int ret = -ENOTTY;
   int i;
 
+#ifdef CONFIG_AUDIO_COMP_FANOUT
+  int j;
+
+  /* Cancel the copies of the buffer */
+
+  for (j = 0; j < CONFIG_AUDIO_COMP_NBUFFERS; j++)
+    {
+      FAR struct audio_comp_slot_s *slot = &priv->slots[j];
+
+      if (slot->apb != apb)
+        {
+          continue;
+        }
+
+      for (i = 0; i < priv->count; i++)
+        {
+          if (lower[i]->ops->cancelbuffer)
+            {
+              int tmp = lower[i]->ops->cancelbuffer(lower[i],
+                                                    &slot->clones[i]);
+              if (tmp != -ENOTTY)
+                {
+                  ret = tmp;
+                }
+            }
+        }
+    }
+
+  return ret;
+#endif
+
   for (i = 0; i < priv->count; i++)
     {
       if (lower[i]->ops->cancelbuffer)
@@ -908,6 +1418,44 @@ static void audio_comp_callback(FAR void *arg, uint16_t reason,
 {
   FAR struct audio_comp_priv_s *priv = arg;
 
+#ifdef CONFIG_AUDIO_COMP_FANOUT
+  FAR struct audio_comp_slot_s *slot;
+  irqstate_t flags;
+  bool last;
+
+  /* A buffer is dequeued with the last of its copies, and the stream is
+   * complete once all the devices that played it are complete.
+   */
+
+  if (reason == AUDIO_CALLBACK_DEQUEUE && apb != NULL)
+    {
+      slot = audio_comp_findslot(priv, apb);
+      if (slot != NULL)
+        {
+          apb = audio_comp_putslot(priv, slot);
+          if (apb == NULL)
+            {
+              return;
+            }
+        }
+    }
+  else if (reason == AUDIO_CALLBACK_COMPLETE)
+    {
+      flags = spin_lock_irqsave(&priv->lock);
+      last  = ++priv->ncomplete >= priv->nfanout;
+      if (last)
+        {
+          priv->ncomplete = 0;
+        }
+
+      spin_unlock_irqrestore(&priv->lock, flags);
+      if (!last)
+        {
+          return;
+        }
+    }
+#endif
+
 #ifdef CONFIG_AUDIO_MULTI_SESSION
   priv->export.upper(priv->export.priv, reason, apb, status, session);
 #else
@@ -980,18 +1528,53 @@ FAR struct audio_lowerhalf_s *audio_comp_initialize(FAR const char *name,
     }
 
   va_end(ap);
+
+#ifdef CONFIG_AUDIO_COMP_FANOUT
+  /* Each slot has a copy of its buffer for each contained device */
+
+  priv->clones = kmm_calloc(CONFIG_AUDIO_COMP_NBUFFERS * priv->count,
+                            sizeof(struct ap_buffer_s));
+  if (priv->clones == NULL)
+    {
+      goto free_all;
+    }
+
+  for (i = 0; i < CONFIG_AUDIO_COMP_NBUFFERS * priv->count; i++)
+    {
+      nxmutex_init(&priv->clones[i].lock);
+    }
+
+  for (i = 0; i < CONFIG_AUDIO_COMP_NBUFFERS; i++)
+    {
+      priv->slots[i].clones = &priv->clones[i * priv->count];
+    }
+
+  spin_lock_init(&priv->lock);
+#endif
+
+#ifdef CONFIG_AUDIO_COMP_PARALLEL
+  priv->calls = kmm_calloc(priv->count, sizeof(struct audio_comp_call_s));
+  if (priv->calls == NULL)
+    {
+      goto free_all;
+    }
+
+  nxsem_init(&priv->done, 0, 0);
+#endif
+
   if (name != NULL)
     {
       ret = audio_register(name, &priv->export);
       if (ret < 0)
         {
-          goto free_lower;
+          goto free_all;
         }
     }
 
   return &priv->export;
 
-free_lower:
+free_all:
+  audio_comp_freeres(priv);
   kmm_free(priv->lower);
 free_priv:
   kmm_free(priv);
@@ -31,10 +31,31 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+
 #include <string.h>
 #include <sys/types.h>
 #include <crypto/aes.h>
 
+#if defined(CONFIG_CRYPTO_SW_AES_HW) && defined(__AES__) && \
+    defined(__SSE2__)
+#  include <wmmintrin.h>
+#  define AES_HW_AESNI 1
+#elif defined(CONFIG_CRYPTO_SW_AES_HW) && defined(__ARM_NEON) && \
+      (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#  include <arm_neon.h>
+#  define AES_HW_ARMV8 1
+#endif
+
+/* The AES instructions targeted by the compiler replace the bitsliced
+ * implementation:  sk[] then holds the round keys of the encryption and
+ * sk_exp[] those of the equivalent inverse cipher, both in byte order.
+ */
+
+#if defined(AES_HW_AESNI) || defined(AES_HW_ARMV8)
+#  define AES_HW 1
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -842,8 +863,129 @@ void aes_ct_bitslice_decrypt(unsigned num_rounds,
   add_round_key(q, skey);
 }
 
+#ifdef AES_HW
+
+/* Set the round keys of the encryption from the key schedule and derive
+ * those of the decryption with InvMixColumns.
+ */
+
+static unsigned aes_hw_keysched(FAR AES_CTX *ctx,
+                                FAR const uint8_t *key, size_t key_len)
+{
+  FAR uint8_t *ek = (FAR uint8_t *)ctx->sk;
+  FAR uint8_t *dk = (FAR uint8_t *)ctx->sk_exp;
+  uint32_t skey[60];
+  unsigned num_rounds;
+  unsigned u;
+
+  num_rounds = aes_keysched_base(skey, key, key_len);
+  for (u = 0; u < ((num_rounds + 1) << 2); u++)
+    {
+      enc32le(ek + (u << 2), skey[u]);
+    }
+
+  memcpy(dk, ek + (num_rounds << 4), 16);
+  for (u = 1; u < num_rounds; u++)
+    {
+#ifdef AES_HW_AESNI
+      _mm_storeu_si128((FAR __m128i *)(dk + (u << 4)),
+        _mm_aesimc_si128(_mm_loadu_si128((FAR const __m128i *)
+                                         (ek + ((num_rounds - u) << 4)))));
+#else
+      vst1q_u8(dk + (u << 4),
+               vaesimcq_u8(vld1q_u8(ek + ((num_rounds - u) << 4))));
+#endif
+    }
+
+  memcpy(dk + (num_rounds << 4), ek, 16);
+  return num_rounds;
+}
+
+static void aes_hw_encrypt(FAR const AES_CTX *ctx, FAR const uint8_t *src,
+                           FAR uint8_t *dst, size_t num_blocks)
+{
+  FAR const uint8_t *rk = (FAR const uint8_t *)ctx->sk;
+  unsigned num_rounds = ctx->num_rounds;
+  unsigned u;
+
+  for (; num_blocks > 0; num_blocks--, src += 16, dst += 16)
+    {
+#ifdef AES_HW_AESNI
+      __m128i s;
+
+      s = _mm_xor_si128(_mm_loadu_si128((FAR const __m128i *)src),
+                        _mm_loadu_si128((FAR const __m128i *)rk));
+      for (u = 1; u < num_rounds; u++)
+        {
+          s = _mm_aesenc_si128(s, _mm_loadu_si128((FAR const __m128i *)
+                                                  (rk + (u << 4))));
+        }
+
+      s = _mm_aesenclast_si128(s, _mm_loadu_si128((FAR const __m128i *)
+                                                  (rk + (u << 4))));
+      _mm_storeu_si128((FAR __m128i *)dst, s);
+#else
+      uint8x16_t s;
+
+      s = vld1q_u8(src);
+      for (u = 0; u < num_rounds - 1; u++)
+        {
+          s = vaesmcq_u8(vaeseq_u8(s, vld1q_u8(rk + (u << 4))));
+        }
+
+      s = vaeseq_u8(s, vld1q_u8(rk + (u << 4)));
+      s = veorq_u8(s, vld1q_u8(rk + ((u + 1) << 4)));
+      vst1q_u8(dst, s);
+#endif
+    }
+}
+
+static void aes_hw_decrypt(FAR const AES_CTX *ctx, FAR const uint8_t *src,
+                           FAR uint8_t *dst, size_t num_blocks)
+{
+  FAR const uint8_t *rk = (FAR const uint8_t *)ctx->sk_exp;
+  unsigned num_rounds = ctx->num_rounds;
+  unsigned u;
+
+  for (; num_blocks > 0; num_blocks--, src += 16, dst += 16)
+    {
+#ifdef AES_HW_AESNI
+      __m128i s;
+
+      s = _mm_xor_si128(_mm_loadu_si128((FAR const __m128i *)src),
+                        _mm_loadu_si128((FAR const __m128i *)rk));
+      for (u = 1; u < num_rounds; u++)
+        {
+          s = _mm_aesdec_si128(s, _mm_loadu_si128((FAR const __m128i *)
+                                                  (rk + (u << 4))));
+        }
+
+      s = _mm_aesdeclast_si128(s, _mm_loadu_si128((FAR const __m128i *)
+                                                  (rk + (u << 4))));
+      _mm_storeu_si128((FAR __m128i *)dst, s);
+#else
+      uint8x16_t s;
+
+      s = vld1q_u8(src);
+      for (u = 0; u < num_rounds - 1; u++)
+        {
+          s = vaesimcq_u8(vaesdq_u8(s, vld1q_u8(rk + (u << 4))));
+        }
+
+      s = vaesdq_u8(s, vld1q_u8(rk + (u << 4)));
+      s = veorq_u8(s, vld1q_u8(rk + ((u + 1) << 4)));
+      vst1q_u8(dst, s);
+#endif
+    }
+}
+#endif /* AES_HW */
+
 int aes_setkey(FAR AES_CTX *ctx, FAR const uint8_t *key, int len)
 {
+#ifdef AES_HW
+  ctx->num_rounds = aes_hw_keysched(ctx, key, len);
+  return ctx->num_rounds == 0 ? -1 : 0;
+#else
   ctx->num_rounds = aes_ct_keysched(ctx->sk, key, len);
   if (ctx->num_rounds == 0)
     {
@@ -852,11 +994,15 @@ int aes_setkey(FAR AES_CTX *ctx, FAR const uint8_t *key, int len)
 
   aes_ct_skey_expand(ctx->sk_exp, ctx->num_rounds, ctx->sk);
   return 0;
+#endif
 }
 
 void aes_encrypt_ecb(FAR AES_CTX *ctx, FAR const uint8_t *src,
                      FAR uint8_t *dst, size_t num_blocks)
 {
+#ifdef AES_HW
+  aes_hw_encrypt(ctx, src, dst, num_blocks);
+#else
   while (num_blocks > 0)
     {
       uint32_t q[8];
@@ -902,11 +1048,15 @@ void aes_encrypt_ecb(FAR AES_CTX *ctx, FAR const uint8_t *src,
           break;
         }
     }
+#endif
 }
 
 void aes_decrypt_ecb(FAR AES_CTX *ctx, FAR const uint8_t *src,
                      FAR uint8_t *dst, size_t num_blocks)
 {
+#ifdef AES_HW
+  aes_hw_decrypt(ctx, src, dst, num_blocks);
+#else
   while (num_blocks > 0)
     {
       uint32_t q[8];
@@ -952,6 +1102,7 @@ void aes_decrypt_ecb(FAR AES_CTX *ctx, FAR const uint8_t *src,
           break;
         }
     }
+#endif
 }
 
 void aes_encrypt(FAR AES_CTX *ctx, FAR const uint8_t *src, FAR uint8_t *dst)
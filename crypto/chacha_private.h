@@ -13,6 +13,22 @@
 
 #include <string.h>
 #include <sys/types.h>
+#include <sys/param.h>
+
+/* Several blocks are computed at once in the lanes of the vectors of the
+ * compiler, one block per lane: 4 blocks in 128-bit vectors, 8 blocks in
+ * the 256-bit vectors of AVX2.
+ */
+
+#if defined(CONFIG_CRYPTO_CHACHAPOLY_SIMD) && \
+    (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__SSE2__) || defined(__ARM_NEON) || defined(__riscv_vector))
+#  ifdef __AVX2__
+#    define CHACHA_LANES 8
+#  else
+#    define CHACHA_LANES 4
+#  endif
+#endif
 
 typedef struct
 {
@@ -20,6 +36,23 @@ typedef struct
 }
 chacha_ctx;
 
+#ifdef CHACHA_LANES
+typedef uint32_t chacha_lanes_t
+  __attribute__((vector_size(CHACHA_LANES * sizeof(uint32_t))));
+
+#define LANES_ROTATE(v, c) (((v) << (c)) | ((v) >> (32 - (c))))
+
+#define LANES_QUARTERROUND(a, b, c, d)                \
+  do                                                  \
+    {                                                 \
+      a += b; d = LANES_ROTATE(d ^ a, 16);            \
+      c += d; b = LANES_ROTATE(b ^ c, 12);            \
+      a += b; d = LANES_ROTATE(d ^ a, 8);             \
+      c += d; b = LANES_ROTATE(b ^ c, 7);             \
+    }                                                 \
+  while (0)
+#endif
+
 #define U8C(v) (v##U)
 #define U32C(v) (v##U)
 
@@ -146,6 +179,95 @@ static void chacha_ivsetup(FAR chacha_ctx *x,
   x->input[15] = U8TO32_LITTLE(iv + 4);
 }
 
+#ifdef CHACHA_LANES
+static void chacha_encrypt_lanes(FAR chacha_ctx *x,
+                                 FAR const uint8_t *m,
+                                 FAR uint8_t *c,
+                                 uint32_t bytes)
+{
+  chacha_lanes_t zero =
+  {
+    0
+  };
+
+  chacha_lanes_t v[16];
+  chacha_lanes_t j12;
+  chacha_lanes_t j13;
+  uint8_t tmp[64];
+  uint32_t n;
+  u_int blocks;
+  u_int i;
+  u_int k;
+
+  /* Lane 'i' holds the block of counter input[12] + i */
+
+  for (i = 0; i < CHACHA_LANES; i++)
+    {
+      j12[i] = x->input[12] + i;
+      j13[i] = x->input[13] + (j12[i] < x->input[12]);
+    }
+
+  for (k = 0; k < 16; k++)
+    {
+      v[k] = zero + x->input[k];
+    }
+
+  v[12] = j12;
+  v[13] = j13;
+
+  for (i = 20; i > 0; i -= 2)
+    {
+      LANES_QUARTERROUND(v[0], v[4], v[8], v[12]);
+      LANES_QUARTERROUND(v[1], v[5], v[9], v[13]);
+      LANES_QUARTERROUND(v[2], v[6], v[10], v[14]);
+      LANES_QUARTERROUND(v[3], v[7], v[11], v[15]);
+      LANES_QUARTERROUND(v[0], v[5], v[10], v[15]);
+      LANES_QUARTERROUND(v[1], v[6], v[11], v[12]);
+      LANES_QUARTERROUND(v[2], v[7], v[8], v[13]);
+      LANES_QUARTERROUND(v[3], v[4], v[9], v[14]);
+    }
+
+  for (k = 0; k < 12; k++)
+    {
+      v[k] += x->input[k];
+    }
+
+  v[12] += j12;
+  v[13] += j13;
+  v[14] += x->input[14];
+  v[15] += x->input[15];
+
+  blocks = (bytes + 63) / 64;
+  for (i = 0; i < blocks; i++, m += 64, c += 64, bytes -= 64)
+    {
+      if (bytes < 64)
+        {
+          for (k = 0; k < 16; k++)
+            {
+              U32TO8_LITTLE(tmp + 4 * k, v[k][i]);
+            }
+
+          for (k = 0; k < bytes; k++)
+            {
+              c[k] = m[k] ^ tmp[k];
+            }
+
+          explicit_bzero(tmp, sizeof(tmp));
+          break;
+        }
+
+      for (k = 0; k < 16; k++)
+        {
+          n = XOR(v[k][i], U8TO32_LITTLE(m + 4 * k));
+          U32TO8_LITTLE(c + 4 * k, n);
+        }
+    }
+
+  x->input[12] = j12[blocks - 1] + 1;
+  x->input[13] = j13[blocks - 1] + (x->input[12] == 0);
+}
+#endif
+
 static void chacha_encrypt_bytes(FAR chacha_ctx *x,
                                  FAR const uint8_t *m,
                                  FAR uint8_t *c,
@@ -192,6 +314,24 @@ static void chacha_encrypt_bytes(FAR chacha_ctx *x,
       return;
     }
 
+#ifdef CHACHA_LANES
+  /* The lanes are not worth it for a single block */
+
+  while (bytes > 64)
+    {
+      i = MIN(bytes, CHACHA_LANES * 64);
+      chacha_encrypt_lanes(x, m, c, i);
+      if (bytes == i)
+        {
+          return;
+        }
+
+      bytes -= i;
+      m += i;
+      c += i;
+    }
+#endif
+
   j0 = x->input[0];
   j1 = x->input[1];
   j2 = x->input[2];
@@ -21,6 +21,8 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+
 #include <endian.h>
 #include <sys/param.h>
 
@@ -72,6 +74,13 @@ void chacha20_crypt(caddr_t key, FAR uint8_t *data)
                        CHACHA20_BLOCK_LEN);
 }
 
+void chacha20_stream(caddr_t key, FAR uint8_t *data, size_t len)
+{
+  FAR struct chacha20_ctx *ctx = (FAR struct chacha20_ctx *)key;
+
+  chacha_encrypt_bytes((FAR chacha_ctx *)ctx->block, data, data, len);
+}
+
 void chacha20_poly1305_init(FAR void *xctx)
 {
   FAR CHACHA20_POLY1305_CTX *ctx = xctx;
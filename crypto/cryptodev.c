@@ -42,6 +42,8 @@
 #include <errno.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/crypto/crypto.h>
 #include <nuttx/drivers/drivers.h>
@@ -50,6 +52,22 @@
 #include <crypto/cryptodev.h>
 #include <crypto/cryptosoft.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The sessions of a descriptor are shared with the worker of its
+ * asynchronous operations.
+ */
+
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+#  define fcrlock(fcr)          nxmutex_lock(&(fcr)->lock)
+#  define fcrunlock(fcr)        nxmutex_unlock(&(fcr)->lock)
+#else
+#  define fcrlock(fcr)
+#  define fcrunlock(fcr)
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -90,12 +108,27 @@ struct csession
   int error;
 };
 
+/* An asynchronous operation of CIOCNCRYPTM */
+
+struct cryptaop
+{
+  TAILQ_ENTRY(cryptaop) next;
+  struct crypt_n_op nop;
+};
+
 struct fcrypt
 {
   TAILQ_HEAD(csessionlist, csession) csessions;
   TAILQ_HEAD(cryptkoplist, cryptkop) crpk_ret;
   int sesn;
   FAR struct pollfd *fds;
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+  TAILQ_HEAD(cryptaoplist, cryptaop) crpa_queue; /* Queued */
+  TAILQ_HEAD(, cryptaop) crpa_ret;               /* Done */
+  int crpa_num;                                  /* Queued and done */
+  mutex_t lock;
+  struct work_s work;
+#endif
 };
 
 /****************************************************************************
@@ -110,6 +143,8 @@ static ssize_t cryptof_write(FAR struct file *filep,
                              FAR const char *buffer, size_t len);
 static int cryptof_ioctl(FAR struct file *filep,
                          int cmd, unsigned long arg);
+static int cryptof_doioctl(FAR struct fcrypt *fcr,
+                           int cmd, unsigned long arg);
 static int cryptof_poll(FAR struct file *filep,
                         FAR struct pollfd *fds, bool setup);
 static int cryptof_open(FAR struct file *filep);
@@ -135,6 +170,11 @@ static int csefree(FAR struct csession *);
 
 static int cryptodev_op(FAR struct csession *,
                         FAR struct crypt_op *);
+static int cryptodev_mop(FAR struct fcrypt *, FAR struct crypt_mop *);
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+static void cryptodev_worker(FAR void *);
+static int cryptodev_getstatus(FAR struct fcrypt *, FAR struct cryptret *);
+#endif
 static int cryptodev_key(FAR struct fcrypt *, FAR struct crypt_kop *);
 static int cryptodevkey_cb(FAR struct cryptkop *);
 static int cryptodev_getkeystatus(FAR struct fcrypt *,
@@ -201,10 +241,21 @@ static ssize_t cryptof_write(FAR struct file *filep,
 
 static int cryptof_ioctl(FAR struct file *filep,
                          int cmd, unsigned long arg)
+{
+  FAR struct fcrypt *fcr = filep->f_priv;
+  int error;
+
+  fcrlock(fcr);
+  error = cryptof_doioctl(fcr, cmd, arg);
+  fcrunlock(fcr);
+  return error;
+}
+
+static int cryptof_doioctl(FAR struct fcrypt *fcr,
+                           int cmd, unsigned long arg)
 {
   struct cryptoini cria;
   struct cryptoini crie;
-  FAR struct fcrypt *fcr = filep->f_priv;
   FAR struct csession *cse;
   FAR struct session_op *sop;
   FAR struct crypt_op *cop;
@@ -366,6 +417,14 @@ bail:
 
         error = cryptodev_op(cse, cop);
         break;
+      case CIOCNCRYPTM:
+        error = cryptodev_mop(fcr, (FAR struct crypt_mop *)arg);
+        break;
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+      case CIOCNCRYPTRET:
+        error = cryptodev_getstatus(fcr, (FAR struct cryptret *)arg);
+        break;
+#endif
       case CIOCKEY:
         error = cryptodev_key(fcr, (FAR struct crypt_kop *)arg);
         break;
@@ -554,6 +613,132 @@ bail:
   return error;
 }
 
+/* Do the operations of CIOCNCRYPTM, or queue those flagged
+ * COP_FLAG_ASYNC to the worker of the descriptor.
+ */
+
+static int cryptodev_mop(FAR struct fcrypt *fcr, FAR struct crypt_mop *mop)
+{
+  FAR struct crypt_n_op *nop;
+  FAR struct csession *cse;
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+  FAR struct cryptaop *aop;
+  bool queued = false;
+#endif
+  uint32_t i;
+
+  if (mop->count > 0 && mop->reqs == NULL)
+    {
+      return -EINVAL;
+    }
+
+  for (i = 0; i < mop->count; i++)
+    {
+      nop = &mop->reqs[i];
+      cse = csefind(fcr, nop->cop.ses);
+      if (cse == NULL)
+        {
+          nop->status = -EINVAL;
+          continue;
+        }
+
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+      if (nop->cop.flags & COP_FLAG_ASYNC)
+        {
+          if (fcr->crpa_num >= CONFIG_CRYPTO_CRYPTODEV_ASYNC_DEPTH)
+            {
+              nop->status = -EAGAIN;
+              continue;
+            }
+
+          aop = kmm_malloc(sizeof(*aop));
+          if (aop == NULL)
+            {
+              nop->status = -ENOMEM;
+              continue;
+            }
+
+          nop->status = -EINPROGRESS;
+          aop->nop = *nop;
+          TAILQ_INSERT_TAIL(&fcr->crpa_queue, aop, next);
+          fcr->crpa_num++;
+          queued = true;
+          continue;
+        }
+#endif
+
+      nop->status = cryptodev_op(cse, &nop->cop);
+    }
+
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+  if (queued && work_available(&fcr->work))
+    {
+      work_queue(LPWORK, &fcr->work, cryptodev_worker, fcr, 0);
+    }
+#endif
+
+  return OK;
+}
+
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+
+/* Do the queued operations of a descriptor, releasing the descriptor
+ * after each one so that more can be queued meanwhile.
+ */
+
+static void cryptodev_worker(FAR void *arg)
+{
+  FAR struct fcrypt *fcr = arg;
+  FAR struct cryptaop *aop;
+  FAR struct csession *cse;
+
+  fcrlock(fcr);
+  while ((aop = TAILQ_FIRST(&fcr->crpa_queue)) != NULL)
+    {
+      TAILQ_REMOVE(&fcr->crpa_queue, aop, next);
+
+      /* The session may have been freed since the operation was queued */
+
+      cse = csefind(fcr, aop->nop.cop.ses);
+      aop->nop.status = cse ? cryptodev_op(cse, &aop->nop.cop) : -EINVAL;
+
+      TAILQ_INSERT_TAIL(&fcr->crpa_ret, aop, next);
+      if (fcr->fds != NULL)
+        {
+          poll_notify(&fcr->fds, 1, POLLIN);
+        }
+
+      fcrunlock(fcr);
+      fcrlock(fcr);
+    }
+
+  fcrunlock(fcr);
+}
+
+/* Return the results of the queued operations done so far */
+
+static int cryptodev_getstatus(FAR struct fcrypt *fcr,
+                               FAR struct cryptret *ret)
+{
+  FAR struct cryptaop *aop;
+  uint32_t n = 0;
+
+  while (n < ret->count && (aop = TAILQ_FIRST(&fcr->crpa_ret)) != NULL)
+    {
+      TAILQ_REMOVE(&fcr->crpa_ret, aop, next);
+      ret->results[n].reqid = aop->nop.reqid;
+      ret->results[n].status = aop->nop.status;
+      ret->results[n].opaque = aop->nop.opaque;
+      fcr->crpa_num--;
+      kmm_free(aop);
+      n++;
+    }
+
+  ret->count = n;
+  return n > 0 ? OK : -EAGAIN;
+}
+#endif /* CONFIG_CRYPTO_CRYPTODEV_ASYNC */
+
 static int cryptodev_key(FAR struct fcrypt *fcr, FAR struct crypt_kop *kop)
 {
   FAR struct cryptkop *krp = NULL;
@@ -808,7 +993,11 @@ static int cryptof_poll(FAR struct file *filep,
 
   if (setup)
     {
-      if (!TAILQ_EMPTY(&fcr->crpk_ret))
+      if (!TAILQ_EMPTY(&fcr->crpk_ret)
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+          || !TAILQ_EMPTY(&fcr->crpa_ret)
+#endif
+         )
         {
           poll_notify(&fds, 1, POLLIN);
           return OK;
@@ -836,8 +1025,30 @@ static int cryptof_close(FAR struct file *filep)
   FAR struct fcrypt *fcr = filep->f_priv;
   FAR struct csession *cse;
   FAR struct cryptkop *krp;
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+  FAR struct cryptaop *aop;
+#endif
   int i;
 
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+  /* Wait for the operation in progress, drop the others */
+
+  work_cancel_sync(LPWORK, &fcr->work);
+  while ((aop = TAILQ_FIRST(&fcr->crpa_queue)) != NULL)
+    {
+      TAILQ_REMOVE(&fcr->crpa_queue, aop, next);
+      kmm_free(aop);
+    }
+
+  while ((aop = TAILQ_FIRST(&fcr->crpa_ret)) != NULL)
+    {
+      TAILQ_REMOVE(&fcr->crpa_ret, aop, next);
+      kmm_free(aop);
+    }
+
+  nxmutex_destroy(&fcr->lock);
+#endif
+
   while ((cse = TAILQ_FIRST(&fcr->csessions)))
     {
       TAILQ_REMOVE(&fcr->csessions, cse, next);
@@ -899,6 +1110,13 @@ static int cryptof_open(FAR struct file *filep)
     }
 
   TAILQ_INIT(&fcrd->csessions);
+  TAILQ_INIT(&fcrd->crpk_ret);
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+  TAILQ_INIT(&fcrd->crpa_queue);
+  TAILQ_INIT(&fcrd->crpa_ret);
+  nxmutex_init(&fcrd->lock);
+#endif
+
   TAILQ_FOREACH(cse, &fcr->csessions, next)
     {
       bzero(&crie, sizeof(crie));
@@ -1025,6 +1243,11 @@ static int cryptoioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
         TAILQ_INIT(&fcr->csessions);
         TAILQ_INIT(&fcr->crpk_ret);
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+        TAILQ_INIT(&fcr->crpa_queue);
+        TAILQ_INIT(&fcr->crpa_ret);
+        nxmutex_init(&fcr->lock);
+#endif
 
         fd = file_allocate(&g_cryptoinode, 0,
                            0, fcr, 0, true);
@@ -45,6 +45,10 @@
 #  define howmany(x, y)  (((x) + ((y) - 1)) / (y))
 #endif
 
+/* The bytes encrypted and authenticated at a time by the counter modes */
+
+#define SWCR_AUTHENC_CHUNK 256
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -115,6 +119,18 @@ int swcr_encdec(FAR struct cryptop *crp, FAR struct cryptodesc *crd,
       exf->reinit((caddr_t)sw->sw_kschedule, iv);
     }
 
+  /* The counter modes encrypt and decrypt the whole data at once */
+
+  if (exf->stream)
+    {
+      bcopy(buf + crd->crd_skip, crp->crp_dst, crd->crd_len);
+      exf->stream((caddr_t)sw->sw_kschedule, (FAR uint8_t *)crp->crp_dst,
+                  crd->crd_len);
+      crp->crp_dst += crd->crd_len;
+      bcopy(ivp, crp->crp_iv, ivlen);
+      return 0;
+    }
+
   i = crd->crd_len;
 
   buf = buf + crd->crd_skip;
@@ -275,7 +291,9 @@ int swcr_hash(FAR struct cryptop *crp,
 int swcr_authenc(FAR struct cryptop *crp)
 {
   uint32_t blkbuf[howmany(EALG_MAX_BLOCK_LEN, sizeof(uint32_t))];
+  uint32_t chunkbuf[SWCR_AUTHENC_CHUNK / sizeof(uint32_t)];
   FAR u_char *blk = (u_char *)blkbuf;
+  FAR u_char *chunk = (u_char *)chunkbuf;
   u_char aalg[AALG_MAX_RESULT_LEN];
   u_char iv[EALG_MAX_BLOCK_LEN];
   union authctx ctx;
@@ -435,9 +453,34 @@ int swcr_authenc(FAR struct cryptop *crp)
       exf->reinit((caddr_t)swe->sw_kschedule, iv);
     }
 
-  /* Do encryption/decryption with MAC */
+  /* Do encryption/decryption with MAC:  The counter modes encrypt and
+   * hash the data in one pass, a chunk of blocks at a time.
+   */
+
+  if (buf && exf->stream)
+    {
+      for (i = 0; i < crde->crd_len; i += SWCR_AUTHENC_CHUNK)
+        {
+          len = MIN(crde->crd_len - i, SWCR_AUTHENC_CHUNK);
+          bcopy(buf + i, chunk, len);
+          if (crde->crd_flags & CRD_F_ENCRYPT)
+            {
+              exf->stream((caddr_t)swe->sw_kschedule, chunk, len);
+              axf->update(&ctx, chunk, len);
+            }
+          else
+            {
+              axf->update(&ctx, chunk, len);
+              exf->stream((caddr_t)swe->sw_kschedule, chunk, len);
+            }
 
-  if (buf)
+          if (crp->crp_dst)
+            {
+              bcopy(chunk, crp->crp_dst + i, len);
+            }
+        }
+    }
+  else if (buf)
     {
       for (i = 0; i < crde->crd_len; i += blksz)
         {
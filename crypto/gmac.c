@@ -28,12 +28,176 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+
 #include <endian.h>
 #include <strings.h>
 #include <sys/param.h>
 #include <crypto/aes.h>
 #include <crypto/gmac.h>
 
+#if defined(CONFIG_CRYPTO_SW_AES_HW) && defined(__PCLMUL__)
+#  include <wmmintrin.h>
+#  define GHASH_CLMUL_PCLMUL 1
+#elif defined(CONFIG_CRYPTO_SW_AES_HW) && defined(__ARM_NEON) && \
+      (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#  include <arm_neon.h>
+#  define GHASH_CLMUL_PMULL 1
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline uint64_t ghash_dec64be(FAR const uint8_t *buf)
+{
+  return ((uint64_t)buf[0] << 56) | ((uint64_t)buf[1] << 48)
+    | ((uint64_t)buf[2] << 40) | ((uint64_t)buf[3] << 32)
+    | ((uint64_t)buf[4] << 24) | ((uint64_t)buf[5] << 16)
+    | ((uint64_t)buf[6] << 8) | (uint64_t)buf[7];
+}
+
+static inline void ghash_enc64be(FAR uint8_t *buf, uint64_t x)
+{
+  int i;
+
+  for (i = 7; i >= 0; i--, x >>= 8)
+    {
+      buf[i] = (uint8_t)x;
+    }
+}
+
+#if !defined(GHASH_CLMUL_PCLMUL) && !defined(GHASH_CLMUL_PMULL)
+
+/* The low 32 bits of the carry-less product of x and y, with integer
+ * multiplications of the bits 4 apart:  The carries of the (up to 8)
+ * products summed in a bit cannot reach the next bit of the same class,
+ * so masking them out leaves the XOR of the products, in constant time.
+ */
+
+static inline uint32_t ghash_bmul32(uint32_t x, uint32_t y)
+{
+  uint32_t x0 = x & 0x11111111;
+  uint32_t x1 = x & 0x22222222;
+  uint32_t x2 = x & 0x44444444;
+  uint32_t x3 = x & 0x88888888;
+  uint32_t y0 = y & 0x11111111;
+  uint32_t y1 = y & 0x22222222;
+  uint32_t y2 = y & 0x44444444;
+  uint32_t y3 = y & 0x88888888;
+  uint32_t z0;
+  uint32_t z1;
+  uint32_t z2;
+  uint32_t z3;
+
+  z0 = (x0 * y0) ^ (x1 * y3) ^ (x2 * y2) ^ (x3 * y1);
+  z1 = (x0 * y1) ^ (x1 * y0) ^ (x2 * y3) ^ (x3 * y2);
+  z2 = (x0 * y2) ^ (x1 * y1) ^ (x2 * y0) ^ (x3 * y3);
+  z3 = (x0 * y3) ^ (x1 * y2) ^ (x2 * y1) ^ (x3 * y0);
+
+  return (z0 & 0x11111111) | (z1 & 0x22222222) |
+         (z2 & 0x44444444) | (z3 & 0x88888888);
+}
+
+static inline uint32_t ghash_rev32(uint32_t x)
+{
+  x = ((x & 0x55555555) << 1) | ((x >> 1) & 0x55555555);
+  x = ((x & 0x33333333) << 2) | ((x >> 2) & 0x33333333);
+  x = ((x & 0x0f0f0f0f) << 4) | ((x >> 4) & 0x0f0f0f0f);
+  x = ((x & 0x00ff00ff) << 8) | ((x >> 8) & 0x00ff00ff);
+  return (x << 16) | (x >> 16);
+}
+
+/* The 64-bit carry-less product of x and y:  The high half is the low
+ * half of the product of the bit reversed operands, reversed.
+ */
+
+static inline uint64_t ghash_clmul32(uint32_t x, uint32_t y)
+{
+  uint32_t hi;
+
+  hi = ghash_rev32(ghash_bmul32(ghash_rev32(x), ghash_rev32(y))) >> 1;
+  return ((uint64_t)hi << 32) | ghash_bmul32(x, y);
+}
+#endif
+
+/* The 128-bit carry-less product of x and y, with the carry-less multiply
+ * instruction targeted by the compiler or three 32-bit multiplications
+ * (Karatsuba).
+ */
+
+static inline void ghash_clmul64(uint64_t x, uint64_t y,
+                                 FAR uint64_t *hi, FAR uint64_t *lo)
+{
+#if defined(GHASH_CLMUL_PCLMUL)
+  uint64_t z[2];
+
+  _mm_storeu_si128((FAR __m128i *)z,
+                   _mm_clmulepi64_si128(_mm_set_epi64x(0, x),
+                                        _mm_set_epi64x(0, y), 0));
+  *lo = z[0];
+  *hi = z[1];
+#elif defined(GHASH_CLMUL_PMULL)
+  uint64x2_t z;
+
+  z = vreinterpretq_u64_p128(vmull_p64((poly64_t)x, (poly64_t)y));
+  *lo = vgetq_lane_u64(z, 0);
+  *hi = vgetq_lane_u64(z, 1);
+#else
+  uint32_t x0 = (uint32_t)x;
+  uint32_t x1 = (uint32_t)(x >> 32);
+  uint32_t y0 = (uint32_t)y;
+  uint32_t y1 = (uint32_t)(y >> 32);
+  uint64_t z0;
+  uint64_t z1;
+  uint64_t z2;
+
+  z0 = ghash_clmul32(x0, y0);
+  z2 = ghash_clmul32(x1, y1);
+  z1 = ghash_clmul32(x0 ^ x1, y0 ^ y1) ^ z0 ^ z2;
+  *lo = z0 ^ (z1 << 32);
+  *hi = z2 ^ (z1 >> 32);
+#endif
+}
+
+/* Multiply y1:y0 by h1:h0 in GF(2^128), the 64-bit halves of the blocks
+ * loaded in big endian:  The bits of the field elements are reflected, so
+ * the 256-bit product is shifted by one bit and reduced from its low half
+ * by x^128 + x^7 + x^2 + x + 1.
+ */
+
+static void ghash_mul(FAR uint64_t *y1, FAR uint64_t *y0,
+                      uint64_t h1, uint64_t h0)
+{
+  uint64_t v0;
+  uint64_t v1;
+  uint64_t v2;
+  uint64_t v3;
+  uint64_t t0;
+  uint64_t t1;
+
+  ghash_clmul64(*y0, h0, &v1, &v0);
+  ghash_clmul64(*y1, h1, &v3, &v2);
+  ghash_clmul64(*y0 ^ *y1, h0 ^ h1, &t1, &t0);
+  t0 ^= v0 ^ v2;
+  t1 ^= v1 ^ v3;
+  v1 ^= t0;
+  v2 ^= t1;
+
+  v3 = (v3 << 1) | (v2 >> 63);
+  v2 = (v2 << 1) | (v1 >> 63);
+  v1 = (v1 << 1) | (v0 >> 63);
+  v0 = v0 << 1;
+
+  v2 ^= v0 ^ (v0 >> 1) ^ (v0 >> 2) ^ (v0 >> 7);
+  v1 ^= (v0 << 63) ^ (v0 << 62) ^ (v0 << 57);
+  v3 ^= v1 ^ (v1 >> 1) ^ (v1 >> 2) ^ (v1 >> 7);
+  v2 ^= (v1 << 63) ^ (v1 << 62) ^ (v1 << 57);
+
+  *y1 = v3;
+  *y0 = v2;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -51,68 +215,32 @@ CODE void (*ghash_update)(FAR GHASH_CTX *,
 
 void ghash_gfmul(FAR uint32_t *X, FAR uint32_t *Y, FAR uint32_t *product)
 {
-  uint32_t v[4];
-  uint32_t z[4] =
-  {
-    0, 0, 0, 0
-  };
-
-  FAR uint8_t *x = (FAR uint8_t *)X;
-  uint32_t mask;
-  int i;
-
-  v[0] = betoh32(Y[0]);
-  v[1] = betoh32(Y[1]);
-  v[2] = betoh32(Y[2]);
-  v[3] = betoh32(Y[3]);
+  uint64_t y1 = ghash_dec64be((FAR uint8_t *)X);
+  uint64_t y0 = ghash_dec64be((FAR uint8_t *)X + 8);
 
-  for (i = 0; i < GMAC_BLOCK_LEN * 8; i++)
-    {
-      /* update Z */
-
-      mask = !!(x[i >> 3] & (1 << (~i & 7)));
-      mask = ~(mask - 1);
-      z[0] ^= v[0] & mask;
-      z[1] ^= v[1] & mask;
-      z[2] ^= v[2] & mask;
-      z[3] ^= v[3] & mask;
-
-      /* update V */
-
-      mask = ~((v[3] & 1) - 1);
-      v[3] = (v[2] << 31) | (v[3] >> 1);
-      v[2] = (v[1] << 31) | (v[2] >> 1);
-      v[1] = (v[0] << 31) | (v[1] >> 1);
-      v[0] = (v[0] >> 1) ^ (0xe1000000 & mask);
-    }
-
-  product[0] = htobe32(z[0]);
-  product[1] = htobe32(z[1]);
-  product[2] = htobe32(z[2]);
-  product[3] = htobe32(z[3]);
+  ghash_mul(&y1, &y0, ghash_dec64be((FAR uint8_t *)Y),
+            ghash_dec64be((FAR uint8_t *)Y + 8));
+  ghash_enc64be((FAR uint8_t *)product, y1);
+  ghash_enc64be((FAR uint8_t *)product + 8, y0);
 }
 
 void ghash_update_mi(FAR GHASH_CTX *ctx, FAR uint8_t *X, size_t len)
 {
-  FAR uint32_t *x = (FAR uint32_t *)X;
-  FAR uint32_t *s = (FAR uint32_t *)ctx->S;
-  FAR uint32_t *y = (FAR uint32_t *)ctx->Z;
-  int i;
+  uint64_t h1 = ghash_dec64be(ctx->H);
+  uint64_t h0 = ghash_dec64be(ctx->H + 8);
+  uint64_t y1 = ghash_dec64be(ctx->Z);
+  uint64_t y0 = ghash_dec64be(ctx->Z + 8);
 
-  for (i = 0; i < len / GMAC_BLOCK_LEN; i++)
+  for (; len >= GMAC_BLOCK_LEN; len -= GMAC_BLOCK_LEN)
     {
-      s[0] = y[0] ^ x[0];
-      s[1] = y[1] ^ x[1];
-      s[2] = y[2] ^ x[2];
-      s[3] = y[3] ^ x[3];
-
-      ghash_gfmul((FAR uint32_t *)ctx->S, (FAR uint32_t *)ctx->H,
-          (FAR uint32_t *)ctx->S);
-
-      y = s;
-      x += 4;
+      y1 ^= ghash_dec64be(X);
+      y0 ^= ghash_dec64be(X + 8);
+      ghash_mul(&y1, &y0, h1, h0);
+      X += GMAC_BLOCK_LEN;
     }
 
+  ghash_enc64be(ctx->S, y1);
+  ghash_enc64be(ctx->S + 8, y0);
   bcopy(ctx->S, ctx->Z, GMAC_BLOCK_LEN);
 }
 
@@ -35,7 +35,9 @@
 #include <nuttx/random.h>
 #include <nuttx/board.h>
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
 #include <nuttx/mutex.h>
+#include <nuttx/sched.h>
 #include <nuttx/crypto/blake2s.h>
 
 /****************************************************************************
@@ -45,6 +47,23 @@
 #define ROTL_32(x,n) (((x) << (n)) | ((x) >> (32 - (n))))
 #define ROTR_32(x,n) (((x) >> (n)) | ((x) << (32 - (n))))
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_PERCPU
+#  define RNG_CPU_KEYWORDS    8
+#  define RNG_CPU_BLOCKWORDS  16
+#  define RNG_CPU_RESEED \
+     SEC2TICK(CONFIG_CRYPTO_RANDOM_POOL_RESEED_INTERVAL)
+
+#  define CHACHA_QR(a, b, c, d) \
+     do \
+       { \
+         a += b; d = ROTL_32(d ^ a, 16); \
+         c += d; b = ROTL_32(b ^ c, 12); \
+         a += b; d = ROTL_32(d ^ a, 8); \
+         c += d; b = ROTL_32(b ^ c, 7); \
+       } \
+     while (0)
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -66,6 +85,7 @@ struct rng_s
   mutex_t rd_lock; /* Threads can only exclusively access the RNG */
   volatile uint32_t rd_addptr;
   volatile uint32_t rd_newentr;
+  volatile uint32_t rd_generation; /* Incremented at each reseed */
   volatile uint8_t rd_rotate;
   volatile uint8_t rd_prev_time;
   volatile uint16_t rd_prev_irq;
@@ -73,6 +93,20 @@ struct rng_s
   struct blake2xs_rng_s blake2xs;
 };
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_PERCPU
+/* The ChaCha20 generator of a CPU, only accessed by the CPU with the
+ * interrupts disabled.
+ */
+
+struct rng_cpu_s
+{
+  uint32_t key[RNG_CPU_KEYWORDS];
+  uint32_t generation;  /* rd_generation of the pool at the last seed */
+  clock_t seedtime;     /* Time of the last seed */
+  bool seeded;
+};
+#endif
+
 enum
 {
   POOL_SIZE = ENTROPY_POOL_SIZE,
@@ -91,6 +125,10 @@ static struct rng_s g_rng =
   NXMUTEX_INITIALIZER,
 };
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_PERCPU
+static struct rng_cpu_s g_rng_cpu[CONFIG_SMP_NCPUS];
+#endif
+
 #ifdef CONFIG_BOARD_ENTROPY_POOL
 /* Entropy pool structure can be provided by board source. Use for this is,
  * for example, allocate entropy pool from special area of RAM which content
@@ -304,6 +342,7 @@ static void rng_reseed(void)
   g_rng.blake2xs.param.node_depth = 0;
 
   g_rng.output_initialized = true;
+  g_rng.rd_generation++;
 }
 
 static void rng_buf_internal(FAR uint8_t *bytes, size_t nbytes)
@@ -357,6 +396,134 @@ static void rng_buf_internal(FAR uint8_t *bytes, size_t nbytes)
     }
 }
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_PERCPU
+
+/****************************************************************************
+ * Name: rng_cpu_block
+ *
+ * Description:
+ *   Compute the ChaCha20 block 'counter' of 'key', with a zero nonce.
+ *
+ ****************************************************************************/
+
+static void rng_cpu_block(FAR const uint32_t *key, uint32_t counter,
+                          FAR uint32_t *out)
+{
+  uint32_t x[RNG_CPU_BLOCKWORDS];
+  int i;
+
+  out[0] = 0x61707865;
+  out[1] = 0x3320646e;
+  out[2] = 0x79622d32;
+  out[3] = 0x6b206574;
+  memcpy(&out[4], key, RNG_CPU_KEYWORDS * sizeof(uint32_t));
+  out[12] = counter;
+  out[13] = 0;
+  out[14] = 0;
+  out[15] = 0;
+
+  memcpy(x, out, sizeof(x));
+  for (i = 0; i < 10; i++)
+    {
+      CHACHA_QR(x[0], x[4], x[8], x[12]);
+      CHACHA_QR(x[1], x[5], x[9], x[13]);
+      CHACHA_QR(x[2], x[6], x[10], x[14]);
+      CHACHA_QR(x[3], x[7], x[11], x[15]);
+      CHACHA_QR(x[0], x[5], x[10], x[15]);
+      CHACHA_QR(x[1], x[6], x[11], x[12]);
+      CHACHA_QR(x[2], x[7], x[8], x[13]);
+      CHACHA_QR(x[3], x[4], x[9], x[14]);
+    }
+
+  for (i = 0; i < RNG_CPU_BLOCKWORDS; i++)
+    {
+      out[i] += x[i];
+    }
+
+  explicit_bzero(x, sizeof(x));
+}
+
+/****************************************************************************
+ * Name: rng_cpu_buf
+ *
+ * Description:
+ *   Fill a buffer with the generator of the current CPU.  The first block
+ *   of the generator gives its next key and the key of the output (fast
+ *   key erasure), a request does not reveal the previous outputs and the
+ *   lock of the pool is only taken to reseed the generator.
+ *
+ ****************************************************************************/
+
+static void rng_cpu_buf(FAR uint8_t *bytes, size_t nbytes)
+{
+  FAR struct rng_cpu_s *crng;
+  uint32_t block[RNG_CPU_BLOCKWORDS];
+  uint32_t seed[RNG_CPU_KEYWORDS];
+  uint32_t generation;
+  uint32_t counter;
+  irqstate_t flags;
+  size_t len;
+  int i;
+
+  flags = up_irq_save();
+  crng = &g_rng_cpu[this_cpu()];
+
+  if (!crng->seeded || crng->generation != g_rng.rd_generation ||
+      clock_systime_ticks() - crng->seedtime >= RNG_CPU_RESEED)
+    {
+      up_irq_restore(flags);
+
+      nxmutex_lock(&g_rng.rd_lock);
+      rng_buf_internal((FAR uint8_t *)seed, sizeof(seed));
+      generation = g_rng.rd_generation;
+      nxmutex_unlock(&g_rng.rd_lock);
+
+      /* The thread may run on another CPU now, seed that one */
+
+      flags = up_irq_save();
+      crng = &g_rng_cpu[this_cpu()];
+      for (i = 0; i < RNG_CPU_KEYWORDS; i++)
+        {
+          crng->key[i] ^= seed[i];
+        }
+
+      crng->generation = generation;
+      crng->seedtime = clock_systime_ticks();
+      crng->seeded = true;
+      explicit_bzero(seed, sizeof(seed));
+    }
+
+  rng_cpu_block(crng->key, 0, block);
+  memcpy(crng->key, block, sizeof(crng->key));
+  up_irq_restore(flags);
+
+  /* A short request takes the rest of the block, a longer one is the key
+   * stream of the rest of the block.
+   */
+
+  if (nbytes <= sizeof(block) - sizeof(crng->key))
+    {
+      memcpy(bytes, &block[RNG_CPU_KEYWORDS], nbytes);
+    }
+  else
+    {
+      memcpy(seed, &block[RNG_CPU_KEYWORDS], sizeof(seed));
+      for (counter = 0; nbytes > 0; counter++)
+        {
+          rng_cpu_block(seed, counter, block);
+          len = MIN(nbytes, sizeof(block));
+          memcpy(bytes, block, len);
+          bytes += len;
+          nbytes -= len;
+        }
+
+      explicit_bzero(seed, sizeof(seed));
+    }
+
+  explicit_bzero(block, sizeof(block));
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -524,7 +691,11 @@ void up_randompool_initialize(void)
 
 void up_rngbuf(FAR void *bytes, size_t nbytes)
 {
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_PERCPU
+  rng_cpu_buf(bytes, nbytes);
+#else
   nxmutex_lock(&g_rng.rd_lock);
   rng_buf_internal(bytes, nbytes);
   nxmutex_unlock(&g_rng.rd_lock);
+#endif
 }
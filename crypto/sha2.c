@@ -38,11 +38,24 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+
 #include <endian.h>
 #include <string.h>
+#include <sys/param.h>
 #include <sys/time.h>
 #include <crypto/sha2.h>
 
+#if defined(CONFIG_CRYPTO_SHA2_HW) && defined(__SHA__) && \
+    defined(__SSE4_1__)
+#  include <immintrin.h>
+#  define SHA256_HW_SHANI 1
+#elif defined(CONFIG_CRYPTO_SHA2_HW) && defined(__ARM_NEON) && \
+      (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#  include <arm_neon.h>
+#  define SHA256_HW_ARMV8 1
+#endif
+
 /* UNROLLED TRANSFORM LOOP NOTE:
  * You can define SHA2_UNROLL_TRANSFORM to use the unrolled transform
  * loop version for the hash transform rounds (defined using macros
@@ -62,6 +75,31 @@
 #  endif
 #endif
 
+/* The SHA-256 instructions targeted by the compiler replace the SHA-256
+ * transform.
+ */
+
+#if defined(SHA256_HW_SHANI) || defined(SHA256_HW_ARMV8)
+#  define SHA256_HW 1
+#endif
+
+/* sha256multi() and sha512multi() hash the messages in the lanes of the
+ * generic vectors of the compiler, when it targets a SIMD unit and there
+ * are no SHA-256 instructions:  They hash the messages one after the
+ * other otherwise.
+ */
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__SSE2__) || defined(__ARM_NEON) || defined(__riscv_vector))
+#  if defined(SHA256_HW)
+#  elif defined(__AVX2__)
+#    define SHA256_MB_LANES 8
+#  else
+#    define SHA256_MB_LANES 4
+#  endif
+#  define SHA512_MB_LANES 2
+#endif
+
 /* SHA-256/384/512 Machine Architecture Definitions */
 
 /* BYTE_ORDER NOTE:
@@ -299,6 +337,276 @@ const static uint64_t sha512_initial_hash_value[8] =
   0x5be0cd19137e2179ull
 };
 
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef SHA256_MB_LANES
+typedef uint32_t sha256_lanes_t
+  __attribute__((vector_size(SHA256_MB_LANES * 4)));
+#endif
+
+#ifdef SHA512_MB_LANES
+typedef uint64_t sha512_lanes_t
+  __attribute__((vector_size(SHA512_MB_LANES * 8)));
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#if defined(SHA256_MB_LANES) || defined(SHA512_MB_LANES)
+
+/* Return block 'b' of a message of 'len' bytes as hashed, the last blocks
+ * are padded in 'buf':  The bit count is a 64-bit or 128-bit big endian
+ * integer of 'lenbytes' bytes.
+ */
+
+static FAR const uint8_t *sha2_mb_block(FAR const uint8_t *data,
+                                        size_t len, size_t b,
+                                        size_t bsize, size_t lenbytes,
+                                        FAR uint8_t *buf)
+{
+  size_t off = b * bsize;
+  uint64_t bitcount;
+  int i;
+
+  if (off + bsize <= len)
+    {
+      return data + off;
+    }
+
+  memset(buf, 0, bsize);
+  if (off <= len)
+    {
+      memcpy(buf, data + off, len - off);
+      buf[len - off] = 0x80;
+    }
+
+  if (b == (len + lenbytes) / bsize)
+    {
+      bitcount = (uint64_t)len << 3;
+      for (i = 1; i <= 8; i++, bitcount >>= 8)
+        {
+          buf[bsize - i] = (uint8_t)bitcount;
+        }
+    }
+
+  return buf;
+}
+#endif
+
+#ifdef SHA256_MB_LANES
+
+/* Hash up to SHA256_MB_LANES messages, a lane each.  The lanes of the
+ * messages that are complete keep their state.
+ */
+
+static void sha256_mb(FAR uint8_t (*digests)[SHA256_DIGEST_LENGTH],
+                      FAR const void *const *data,
+                      FAR const size_t *len, size_t n)
+{
+  uint8_t buf[SHA256_MB_LANES][SHA256_BLOCK_LENGTH];
+  FAR const uint8_t *block[SHA256_MB_LANES];
+  size_t nblocks[SHA256_MB_LANES];
+  size_t maxblocks = 0;
+  sha256_lanes_t state[8];
+  sha256_lanes_t w[16];
+  sha256_lanes_t v[8];
+  sha256_lanes_t mask;
+  sha256_lanes_t t1;
+  sha256_lanes_t t2;
+  size_t b;
+  int i;
+  int j;
+  int l;
+
+  for (l = 0; l < SHA256_MB_LANES; l++)
+    {
+      nblocks[l] = l < n ? (len[l] + 8) / SHA256_BLOCK_LENGTH + 1 : 0;
+      maxblocks = MAX(maxblocks, nblocks[l]);
+    }
+
+  for (i = 0; i < 8; i++)
+    {
+      for (l = 0; l < SHA256_MB_LANES; l++)
+        {
+          state[i][l] = sha256_initial_hash_value[i];
+        }
+    }
+
+  for (b = 0; b < maxblocks; b++)
+    {
+      for (l = 0; l < SHA256_MB_LANES; l++)
+        {
+          mask[l] = b < nblocks[l] ? 0xffffffff : 0;
+          block[l] = b < nblocks[l] ?
+                     sha2_mb_block(data[l], len[l], b, SHA256_BLOCK_LENGTH,
+                                   8, buf[l]) : buf[0];
+        }
+
+      for (j = 0; j < 16; j++)
+        {
+          for (l = 0; l < SHA256_MB_LANES; l++)
+            {
+              FAR const uint8_t *p = block[l] + (j << 2);
+
+              w[j][l] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+                        ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+            }
+        }
+
+      memcpy(v, state, sizeof(v));
+      for (j = 0; j < 64; j++)
+        {
+          if (j >= 16)
+            {
+              w[j & 0x0f] += sigma1_256(w[(j + 14) & 0x0f]) +
+                             w[(j + 9) & 0x0f] +
+                             sigma0_256(w[(j + 1) & 0x0f]);
+            }
+
+          t1 = v[7] + SIGMA1_256(v[4]) + CH(v[4], v[5], v[6]) +
+               K256[j] + w[j & 0x0f];
+          t2 = SIGMA0_256(v[0]) + MAJ(v[0], v[1], v[2]);
+          v[7] = v[6];
+          v[6] = v[5];
+          v[5] = v[4];
+          v[4] = v[3] + t1;
+          v[3] = v[2];
+          v[2] = v[1];
+          v[1] = v[0];
+          v[0] = t1 + t2;
+        }
+
+      for (i = 0; i < 8; i++)
+        {
+          state[i] += v[i] & mask;
+        }
+    }
+
+  for (l = 0; l < n; l++)
+    {
+      for (i = 0; i < 8; i++)
+        {
+          digests[l][(i << 2) + 0] = (uint8_t)(state[i][l] >> 24);
+          digests[l][(i << 2) + 1] = (uint8_t)(state[i][l] >> 16);
+          digests[l][(i << 2) + 2] = (uint8_t)(state[i][l] >> 8);
+          digests[l][(i << 2) + 3] = (uint8_t)state[i][l];
+        }
+    }
+
+  explicit_bzero(buf, sizeof(buf));
+}
+#endif /* SHA256_MB_LANES */
+
+#ifdef SHA512_MB_LANES
+
+/* Hash up to SHA512_MB_LANES messages, as sha256_mb() */
+
+static void sha512_mb(FAR uint8_t (*digests)[SHA512_DIGEST_LENGTH],
+                      FAR const void *const *data,
+                      FAR const size_t *len, size_t n)
+{
+  uint8_t buf[SHA512_MB_LANES][SHA512_BLOCK_LENGTH];
+  FAR const uint8_t *block[SHA512_MB_LANES];
+  size_t nblocks[SHA512_MB_LANES];
+  size_t maxblocks = 0;
+  sha512_lanes_t state[8];
+  sha512_lanes_t w[16];
+  sha512_lanes_t v[8];
+  sha512_lanes_t mask;
+  sha512_lanes_t t1;
+  sha512_lanes_t t2;
+  size_t b;
+  int i;
+  int j;
+  int k;
+  int l;
+
+  for (l = 0; l < SHA512_MB_LANES; l++)
+    {
+      nblocks[l] = l < n ? (len[l] + 16) / SHA512_BLOCK_LENGTH + 1 : 0;
+      maxblocks = MAX(maxblocks, nblocks[l]);
+    }
+
+  for (i = 0; i < 8; i++)
+    {
+      for (l = 0; l < SHA512_MB_LANES; l++)
+        {
+          state[i][l] = sha512_initial_hash_value[i];
+        }
+    }
+
+  for (b = 0; b < maxblocks; b++)
+    {
+      for (l = 0; l < SHA512_MB_LANES; l++)
+        {
+          mask[l] = b < nblocks[l] ? 0xffffffffffffffffull : 0;
+          block[l] = b < nblocks[l] ?
+                     sha2_mb_block(data[l], len[l], b, SHA512_BLOCK_LENGTH,
+                                   16, buf[l]) : buf[0];
+        }
+
+      for (j = 0; j < 16; j++)
+        {
+          for (l = 0; l < SHA512_MB_LANES; l++)
+            {
+              FAR const uint8_t *p = block[l] + (j << 3);
+
+              w[j][l] = 0;
+              for (k = 0; k < 8; k++)
+                {
+                  w[j][l] = (w[j][l] << 8) | p[k];
+                }
+            }
+        }
+
+      memcpy(v, state, sizeof(v));
+      for (j = 0; j < 80; j++)
+        {
+          if (j >= 16)
+            {
+              w[j & 0x0f] += sigma1_512(w[(j + 14) & 0x0f]) +
+                             w[(j + 9) & 0x0f] +
+                             sigma0_512(w[(j + 1) & 0x0f]);
+            }
+
+          t1 = v[7] + SIGMA1_512(v[4]) + CH(v[4], v[5], v[6]) +
+               K512[j] + w[j & 0x0f];
+          t2 = SIGMA0_512(v[0]) + MAJ(v[0], v[1], v[2]);
+          v[7] = v[6];
+          v[6] = v[5];
+          v[5] = v[4];
+          v[4] = v[3] + t1;
+          v[3] = v[2];
+          v[2] = v[1];
+          v[1] = v[0];
+          v[0] = t1 + t2;
+        }
+
+      for (i = 0; i < 8; i++)
+        {
+          state[i] += v[i] & mask;
+        }
+    }
+
+  for (l = 0; l < n; l++)
+    {
+      for (i = 0; i < 8; i++)
+        {
+          for (k = 0; k < 8; k++)
+            {
+              digests[l][(i << 3) + k] =
+                (uint8_t)(state[i][l] >> (56 - (k << 3)));
+            }
+        }
+    }
+
+  explicit_bzero(buf, sizeof(buf));
+}
+#endif /* SHA512_MB_LANES */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -315,7 +623,130 @@ void sha256init(FAR SHA2_CTX *context)
   context->bitcount[0] = 0;
 }
 
-#ifdef SHA2_UNROLL_TRANSFORM
+#if defined(SHA256_HW_SHANI)
+
+/* SHA-NI keeps the state as ABEF and CDGH.  A step does the rounds 4i to
+ * 4i + 3, with the words 4i to 4i + 3 of the message schedule in 'm0',
+ * and replaces them with the words 4i + 16 to 4i + 19.
+ */
+
+#define SHA256_HW_STEP(i, m0, m1, m2, m3)                                  \
+  do                                                                       \
+    {                                                                      \
+      t = _mm_add_epi32(m0, _mm_loadu_si128((FAR const __m128i *)          \
+                                            &K256[(i) << 2]));            \
+      cdgh = _mm_sha256rnds2_epu32(cdgh, abef, t);                         \
+      abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(t, 0x0e));\
+      if ((i) < 12)                                                        \
+        {                                                                  \
+          m0 = _mm_sha256msg2_epu32(                                       \
+                 _mm_add_epi32(_mm_sha256msg1_epu32(m0, m1),               \
+                               _mm_alignr_epi8(m3, m2, 4)), m3);           \
+        }                                                                  \
+    }                                                                      \
+  while (0)
+
+void sha256transform(FAR uint32_t *state, FAR const uint8_t *data)
+{
+  const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bull,
+                                       0x0405060700010203ull);
+  __m128i abef;
+  __m128i cdgh;
+  __m128i save0;
+  __m128i save1;
+  __m128i m0;
+  __m128i m1;
+  __m128i m2;
+  __m128i m3;
+  __m128i t;
+  int i;
+
+  t = _mm_shuffle_epi32(_mm_loadu_si128((FAR const __m128i *)state), 0xb1);
+  cdgh = _mm_shuffle_epi32(_mm_loadu_si128((FAR const __m128i *)
+                                           (state + 4)), 0x1b);
+  abef = _mm_alignr_epi8(t, cdgh, 8);
+  cdgh = _mm_blend_epi16(cdgh, t, 0xf0);
+  save0 = abef;
+  save1 = cdgh;
+
+  m0 = _mm_shuffle_epi8(_mm_loadu_si128((FAR const __m128i *)data), bswap);
+  m1 = _mm_shuffle_epi8(_mm_loadu_si128((FAR const __m128i *)
+                                        (data + 16)), bswap);
+  m2 = _mm_shuffle_epi8(_mm_loadu_si128((FAR const __m128i *)
+                                        (data + 32)), bswap);
+  m3 = _mm_shuffle_epi8(_mm_loadu_si128((FAR const __m128i *)
+                                        (data + 48)), bswap);
+
+  for (i = 0; i < 16; i += 4)
+    {
+      SHA256_HW_STEP(i, m0, m1, m2, m3);
+      SHA256_HW_STEP(i + 1, m1, m2, m3, m0);
+      SHA256_HW_STEP(i + 2, m2, m3, m0, m1);
+      SHA256_HW_STEP(i + 3, m3, m0, m1, m2);
+    }
+
+  abef = _mm_add_epi32(abef, save0);
+  cdgh = _mm_add_epi32(cdgh, save1);
+
+  t = _mm_shuffle_epi32(abef, 0x1b);
+  cdgh = _mm_shuffle_epi32(cdgh, 0xb1);
+  _mm_storeu_si128((FAR __m128i *)state, _mm_blend_epi16(t, cdgh, 0xf0));
+  _mm_storeu_si128((FAR __m128i *)(state + 4), _mm_alignr_epi8(cdgh, t, 8));
+}
+
+#elif defined(SHA256_HW_ARMV8)
+
+/* The ARMv8 instructions keep the state as ABCD and EFGH, a step is as
+ * with SHA-NI.
+ */
+
+#define SHA256_HW_STEP(i, m0, m1, m2, m3)                                  \
+  do                                                                       \
+    {                                                                      \
+      t = vaddq_u32(m0, vld1q_u32(&K256[(i) << 2]));                       \
+      abcd0 = abcd;                                                        \
+      abcd = vsha256hq_u32(abcd, efgh, t);                                 \
+      efgh = vsha256h2q_u32(efgh, abcd0, t);                               \
+      if ((i) < 12)                                                        \
+        {                                                                  \
+          m0 = vsha256su1q_u32(vsha256su0q_u32(m0, m1), m2, m3);           \
+        }                                                                  \
+    }                                                                      \
+  while (0)
+
+void sha256transform(FAR uint32_t *state, FAR const uint8_t *data)
+{
+  uint32x4_t abcd;
+  uint32x4_t efgh;
+  uint32x4_t abcd0;
+  uint32x4_t m0;
+  uint32x4_t m1;
+  uint32x4_t m2;
+  uint32x4_t m3;
+  uint32x4_t t;
+  int i;
+
+  abcd = vld1q_u32(state);
+  efgh = vld1q_u32(state + 4);
+
+  m0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data)));
+  m1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16)));
+  m2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 32)));
+  m3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 48)));
+
+  for (i = 0; i < 16; i += 4)
+    {
+      SHA256_HW_STEP(i, m0, m1, m2, m3);
+      SHA256_HW_STEP(i + 1, m1, m2, m3, m0);
+      SHA256_HW_STEP(i + 2, m2, m3, m0, m1);
+      SHA256_HW_STEP(i + 3, m3, m0, m1, m2);
+    }
+
+  vst1q_u32(state, vaddq_u32(abcd, vld1q_u32(state)));
+  vst1q_u32(state + 4, vaddq_u32(efgh, vld1q_u32(state + 4)));
+}
+
+#elif defined(SHA2_UNROLL_TRANSFORM)
 
 /* Unrolled SHA-256 round macros: */
 
@@ -678,6 +1109,30 @@ void sha256final(FAR uint8_t *digest, FAR SHA2_CTX *context)
   explicit_bzero(context, sizeof(*context));
 }
 
+void sha256multi(FAR uint8_t (*digests)[SHA256_DIGEST_LENGTH],
+                 FAR const void *const *data, FAR const size_t *len,
+                 size_t n)
+{
+  size_t i;
+
+#ifdef SHA256_MB_LANES
+  for (i = 0; i < n; i += SHA256_MB_LANES)
+    {
+      sha256_mb(digests + i, data + i, len + i,
+                MIN(n - i, SHA256_MB_LANES));
+    }
+#else
+  SHA2_CTX ctx;
+
+  for (i = 0; i < n; i++)
+    {
+      sha256init(&ctx);
+      sha256update(&ctx, data[i], len[i]);
+      sha256final(digests[i], &ctx);
+    }
+#endif
+}
+
 /* SHA-224: */
 
 void sha224init(FAR SHA2_CTX *context)
@@ -1093,6 +1548,30 @@ void sha512final(FAR uint8_t *digest, FAR SHA2_CTX *context)
   explicit_bzero(context, sizeof(*context));
 }
 
+void sha512multi(FAR uint8_t (*digests)[SHA512_DIGEST_LENGTH],
+                 FAR const void *const *data, FAR const size_t *len,
+                 size_t n)
+{
+  size_t i;
+
+#ifdef SHA512_MB_LANES
+  for (i = 0; i < n; i += SHA512_MB_LANES)
+    {
+      sha512_mb(digests + i, data + i, len + i,
+                MIN(n - i, SHA512_MB_LANES));
+    }
+#else
+  SHA2_CTX ctx;
+
+  for (i = 0; i < n; i++)
+    {
+      sha512init(&ctx);
+      sha512update(&ctx, data[i], len[i]);
+      sha512final(digests[i], &ctx);
+    }
+#endif
+}
+
 /* SHA-384: */
 
 void sha384init(FAR SHA2_CTX *context)
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <endian.h>
 #include <stdbool.h>
 #include <string.h>
 #include <poll.h>
@@ -37,20 +38,18 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/crypto/crypto.h>
 
+#include <crypto/chachapoly.h>
+
 #ifdef CONFIG_CRYPTO_ALGTEST
 
 #include "testmngr.h"
 
 /****************************************************************************
- * Pre-processor Definitions
+ * Private Functions
  ****************************************************************************/
 
 #if defined(CONFIG_CRYPTO_AES)
 
-/****************************************************************************
- * Private Functions
- ****************************************************************************/
-
 static int do_test_aes(FAR struct cipher_testvec *test,
                        int mode,
                        int encrypt)
@@ -106,6 +105,58 @@ static int test_aes(void)
 }
 #endif
 
+static int do_test_chachapoly(FAR struct aead_testvec *test)
+{
+  FAR uint8_t *out = kmm_zalloc(test->rlen);
+  uint64_t nonce;
+  int res = -ENOMEM;
+
+  if (out == NULL)
+    {
+      return res;
+    }
+
+  memcpy(&nonce, test->iv, sizeof(nonce));
+  nonce = le64toh(nonce);
+
+  chacha20poly1305_encrypt(out, (FAR uint8_t *)test->input, test->ilen,
+                           (FAR uint8_t *)test->assoc, test->alen, nonce,
+                           (FAR uint8_t *)test->key);
+  res = memcmp(out, test->result, test->rlen);
+  if (res == 0)
+    {
+      memset(out, 0, test->rlen);
+      res = !chacha20poly1305_decrypt(out, (FAR uint8_t *)test->result,
+                                      test->rlen, (FAR uint8_t *)test->assoc,
+                                      test->alen, nonce,
+                                      (FAR uint8_t *)test->key);
+    }
+
+  if (res == 0)
+    {
+      res = memcmp(out, test->input, test->ilen);
+    }
+
+  kmm_free(out);
+  return res;
+}
+
+static int test_chachapoly(void)
+{
+  int i;
+
+  for (i = 0; i < nitems(chachapoly_tv_template); i++)
+    {
+      if (do_test_chachapoly(chachapoly_tv_template + i))
+        {
+          crypterr("ERROR: Failed ChaCha20-Poly1305 test #%i\n", i);
+          return -1;
+        }
+    }
+
+  return OK;
+}
+
 int crypto_test(void)
 {
 #if defined(CONFIG_CRYPTO_AES)
@@ -115,6 +166,11 @@ int crypto_test(void)
     }
 #endif
 
+  if (test_chachapoly())
+    {
+      return -1;
+    }
+
   return OK;
 }
 
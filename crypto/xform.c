@@ -83,6 +83,12 @@
 
 #define CRC32_XOR_VALUE 0xFFFFFFFFUL
 
+/* The counter blocks encrypted per call of the cipher by the counter
+ * modes:  The bitsliced AES encrypts two blocks at a time.
+ */
+
+#define AESCTR_STREAMBLOCKS 8
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -120,6 +126,7 @@ void aes_cfb8_decrypt(caddr_t, FAR uint8_t *);
 void aes_cfb128_decrypt(caddr_t, FAR uint8_t *);
 
 void aes_ctr_crypt(caddr_t, FAR uint8_t *);
+void aes_ctr_stream(caddr_t, FAR uint8_t *, size_t);
 
 void aes_ctr_reinit(caddr_t, FAR uint8_t *);
 void aes_xts_reinit(caddr_t, FAR uint8_t *);
@@ -217,7 +224,8 @@ const struct enc_xform enc_xform_aes_ctr =
   aes_ctr_crypt,
   aes_ctr_crypt,
   aes_ctr_setkey,
-  aes_ctr_reinit
+  aes_ctr_reinit,
+  aes_ctr_stream
 };
 
 const struct enc_xform enc_xform_aes_gcm =
@@ -228,7 +236,8 @@ const struct enc_xform enc_xform_aes_gcm =
   aes_ctr_crypt,
   aes_ctr_crypt,
   aes_ctr_setkey,
-  aes_gcm_reinit
+  aes_gcm_reinit,
+  aes_ctr_stream
 };
 
 const struct enc_xform enc_xform_aes_gmac =
@@ -303,7 +312,8 @@ const struct enc_xform enc_xform_chacha20_poly1305 =
   chacha20_crypt,
   chacha20_crypt,
   chacha20_setkey,
-  chacha20_reinit
+  chacha20_reinit,
+  chacha20_stream
 };
 
 const struct enc_xform enc_xform_null =
@@ -606,30 +616,54 @@ void aes_gcm_reinit(caddr_t key, FAR uint8_t *iv)
 }
 
 void aes_ctr_crypt(caddr_t key, FAR uint8_t *data)
+{
+  aes_ctr_stream(key, data, AESCTR_BLOCKSIZE);
+}
+
+void aes_ctr_stream(caddr_t key, FAR uint8_t *data, size_t len)
 {
   FAR struct aes_ctr_ctx *ctx;
-  uint8_t keystream[AESCTR_BLOCKSIZE];
-  int i;
+  uint8_t keystream[AESCTR_BLOCKSIZE * AESCTR_STREAMBLOCKS];
+  size_t nblocks;
+  size_t n;
+  size_t i;
+  int j;
 
   ctx = (FAR struct aes_ctr_ctx *)key;
 
-  /* increment counter */
-
-  for (i = AESCTR_BLOCKSIZE - 1;
-        i >= AESCTR_NONCESIZE + AESCTR_IVSIZE; i--)
+  while (len > 0)
     {
-      /* continue on overflow */
+      nblocks = MIN((len + AESCTR_BLOCKSIZE - 1) / AESCTR_BLOCKSIZE,
+                    AESCTR_STREAMBLOCKS);
+      for (n = 0; n < nblocks; n++)
+        {
+          /* increment counter */
 
-      if (++ctx->ac_block[i])
+          for (j = AESCTR_BLOCKSIZE - 1;
+               j >= AESCTR_NONCESIZE + AESCTR_IVSIZE; j--)
+            {
+              /* continue on overflow */
+
+              if (++ctx->ac_block[j])
+                {
+                  break;
+                }
+            }
+
+          memcpy(keystream + n * AESCTR_BLOCKSIZE, ctx->ac_block,
+                 AESCTR_BLOCKSIZE);
+        }
+
+      aes_encrypt_ecb(&ctx->ac_key, keystream, keystream, nblocks);
+
+      n = MIN(len, nblocks * AESCTR_BLOCKSIZE);
+      for (i = 0; i < n; i++)
         {
-          break;
+          data[i] ^= keystream[i];
         }
-    }
 
-  aes_encrypt(&ctx->ac_key, ctx->ac_block, keystream);
-  for (i = 0; i < AESCTR_BLOCKSIZE; i++)
-    {
-      data[i] ^= keystream[i];
+      data += n;
+      len -= n;
     }
 
   explicit_bzero(keystream, sizeof(keystream));
@@ -49,19 +49,42 @@ struct bchlib_s
   FAR struct inode *inode; /* I-node of the block driver */
   uint32_t sectsize;       /* The size of one sector on the device */
   size_t nsectors;         /* Number of sectors supported by the device */
+#ifdef CONFIG_BCH_CACHE
+  size_t next;             /* The sector that follows the last miss */
+#else
   size_t sector;           /* The current sector in the buffer */
+#endif
   mutex_t lock;            /* For atomic accesses to this structure */
   uint8_t refs;            /* Number of references */
+#ifndef CONFIG_BCH_CACHE
   bool dirty;              /* true: Data has been written to the buffer */
+#endif
   bool readonly;           /* true: Only read operations are supported */
   bool unlinked;           /* true: The driver has been unlinked */
+#ifdef CONFIG_BCH_CACHE
+  FAR uint8_t *burst;      /* Buffer of the multi-sector transfers */
+#else
   FAR uint8_t *buffer;     /* One sector buffer */
+#endif
 
 #if defined(CONFIG_BCH_ENCRYPTION)
   uint8_t key[CONFIG_BCH_ENCRYPTION_KEY_SIZE];  /* Encryption key */
 #endif
 };
 
+#ifdef CONFIG_BCH_CACHE
+/* The statistics of the block cache shared by all the BCH instances */
+
+struct bchlib_cachestat_s
+{
+  uint32_t hits;           /* Sectors found in the cache */
+  uint32_t misses;         /* Sectors read from the device */
+  uint32_t readahead;      /* Sectors read ahead from the device */
+  uint32_t writes;         /* Writes of dirty sectors to the device */
+  uint32_t written;        /* Dirty sectors written to the device */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -82,7 +105,17 @@ EXTERN const struct file_operations g_bch_fops;
  ****************************************************************************/
 
 EXTERN int  bchlib_flushsector(FAR struct bchlib_s *bch, bool discard);
-EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector);
+EXTERN int  bchlib_syncsectors(FAR struct bchlib_s *bch, size_t sector,
+                               size_t nsectors, bool discard);
+EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, FAR uint8_t *buffer,
+                              size_t sector, size_t offset, size_t len);
+EXTERN int  bchlib_writesector(FAR struct bchlib_s *bch,
+                               FAR const uint8_t *buffer, size_t sector,
+                               size_t offset, size_t len);
+EXTERN void bchlib_freecache(FAR struct bchlib_s *bch);
+#ifdef CONFIG_BCH_CACHE
+EXTERN void bchlib_cachestat(FAR struct bchlib_cachestat_s *stat);
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
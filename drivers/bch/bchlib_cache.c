@@ -27,16 +27,59 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
 
+#include <nuttx/mutex.h>
+
 #include "bch.h"
 
 #if defined(CONFIG_BCH_ENCRYPTION)
 #  include <nuttx/crypto/crypto.h>
 #endif
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_BCH_CACHE
+#  define BCH_CACHE_NLINES (CONFIG_BCH_CACHE_NSETS * CONFIG_BCH_CACHE_NWAYS)
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef CONFIG_BCH_CACHE
+/* One line of the block cache.  The cache is shared by all the BCH
+ * instances:  A sector can be held in any of the CONFIG_BCH_CACHE_NWAYS
+ * lines of its set, the least recently used line of the set is replaced.
+ */
+
+struct bchlib_cline_s
+{
+  FAR struct bchlib_s *bch;  /* The owner of the line, NULL if unused */
+  size_t sector;             /* The sector in the line */
+  uint32_t stamp;            /* Time of the last use */
+  uint32_t size;             /* The size of the buffer */
+  bool dirty;                /* true: Data has been written to the line */
+  FAR uint8_t *buffer;       /* The data of the sector */
+};
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_BCH_CACHE
+static struct bchlib_cline_s g_bch_cache[BCH_CACHE_NLINES];
+static struct bchlib_cachestat_s g_bch_cachestat;
+static mutex_t g_bch_cachelock = NXMUTEX_INITIALIZER;
+static uint32_t g_bch_stamp;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -60,10 +103,11 @@ static void bch_xor(uint32_t *R, uint32_t *A, uint32_t *B)
  ****************************************************************************/
 
 #if defined(CONFIG_BCH_ENCRYPTION)
-static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
+static int bch_cypher(FAR struct bchlib_s *bch, FAR uint8_t *data,
+                      size_t sector, int encrypt)
 {
   int blocks = bch->sectsize / 16;
-  FAR uint32_t *buffer = (FAR uint32_t *)bch->buffer;
+  FAR uint32_t *buffer = (FAR uint32_t *)data;
   int i;
 
   for (i = 0; i < blocks; i++, buffer += 16 / sizeof(uint32_t) )
@@ -71,7 +115,7 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
       uint32_t T[4];
       uint32_t X[4] =
       {
-        bch->sector, 0, 0, i
+        sector, 0, 0, i
       };
 
       aes_cypher(X, X, 16, NULL, bch->key, CONFIG_BCH_ENCRYPTION_KEY_SIZE,
@@ -89,10 +133,581 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
 }
 #endif
 
+/****************************************************************************
+ * Name: bch_alloc
+ *
+ * Description:
+ *   Allocate a buffer of 'size' bytes for the transfers with the device.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *bch_alloc(size_t size)
+{
+#if CONFIG_BCH_BUFFER_ALIGNMENT != 0
+  return kmm_memalign(CONFIG_BCH_BUFFER_ALIGNMENT, size);
+#else
+  return kmm_malloc(size);
+#endif
+}
+
+#ifdef CONFIG_BCH_CACHE
+
+/****************************************************************************
+ * Name: bch_cache_set
+ *
+ * Description:
+ *   Return the first line of the set that can hold a sector.  The
+ *   consecutive sectors of a device fall into consecutive sets.
+ *
+ ****************************************************************************/
+
+static FAR struct bchlib_cline_s *bch_cache_set(FAR struct bchlib_s *bch,
+                                                size_t sector)
+{
+  size_t set = (sector + ((uintptr_t)bch >> 4)) % CONFIG_BCH_CACHE_NSETS;
+
+  return &g_bch_cache[set * CONFIG_BCH_CACHE_NWAYS];
+}
+
+/****************************************************************************
+ * Name: bch_cache_find
+ *
+ * Description:
+ *   Return the line that holds a sector, NULL if it is not cached.
+ *
+ ****************************************************************************/
+
+static FAR struct bchlib_cline_s *bch_cache_find(FAR struct bchlib_s *bch,
+                                                 size_t sector)
+{
+  FAR struct bchlib_cline_s *line = bch_cache_set(bch, sector);
+  int i;
+
+  for (i = 0; i < CONFIG_BCH_CACHE_NWAYS; i++, line++)
+    {
+      if (line->bch == bch && line->sector == sector)
+        {
+          return line;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: bch_cache_writeback
+ *
+ * Description:
+ *   Write a dirty line to its device, together with the dirty lines of the
+ *   sectors around it:  Up to CONFIG_BCH_CACHE_BURST consecutive sectors
+ *   are written with one request to the device.
+ *
+ ****************************************************************************/
+
+static int bch_cache_writeback(FAR struct bchlib_cline_s *line)
+{
+  FAR struct bchlib_cline_s *run[CONFIG_BCH_CACHE_BURST];
+  FAR struct bchlib_s *bch = line->bch;
+  FAR struct inode *inode = bch->inode;
+  FAR struct bchlib_cline_s *tmp;
+  FAR uint8_t *buffer;
+  size_t sector = line->sector;
+  ssize_t ret;
+  int count = 1;
+  int i;
+
+  /* Find the first dirty sector of the run, then the following ones */
+
+  while (sector > 0 && count < CONFIG_BCH_CACHE_BURST &&
+         (tmp = bch_cache_find(bch, sector - 1)) != NULL && tmp->dirty)
+    {
+      sector--;
+      count++;
+    }
+
+  for (count = 0; count < CONFIG_BCH_CACHE_BURST; count++)
+    {
+      tmp = bch_cache_find(bch, sector + count);
+      if (tmp == NULL || !tmp->dirty)
+        {
+          break;
+        }
+
+      run[count] = tmp;
+    }
+
+  DEBUGASSERT(count > 0);
+
+  if (count > 1 && bch->burst == NULL)
+    {
+      bch->burst = bch_alloc(bch->sectsize * CONFIG_BCH_CACHE_BURST);
+    }
+
+  if (count == 1 || bch->burst == NULL)
+    {
+      /* Write the line alone */
+
+      run[0] = line;
+      sector = line->sector;
+      count  = 1;
+      buffer = line->buffer;
+    }
+  else
+    {
+      buffer = bch->burst;
+      for (i = 0; i < count; i++)
+        {
+          memcpy(buffer + i * bch->sectsize, run[i]->buffer, bch->sectsize);
+        }
+    }
+
+#if defined(CONFIG_BCH_ENCRYPTION)
+  for (i = 0; i < count; i++)
+    {
+      bch_cypher(bch, buffer + i * bch->sectsize, sector + i,
+                 CYPHER_ENCRYPT);
+    }
+#endif
+
+  ret = inode->u.i_bops->write(inode, buffer, sector, count);
+
+#if defined(CONFIG_BCH_ENCRYPTION)
+  if (buffer == line->buffer)
+    {
+      bch_cypher(bch, buffer, sector, CYPHER_DECRYPT);
+    }
+#endif
+
+  if (ret < 0)
+    {
+      ferr("Write failed: %zd\n", ret);
+      return (int)ret;
+    }
+
+  for (i = 0; i < count; i++)
+    {
+      run[i]->dirty = false;
+    }
+
+  g_bch_cachestat.writes++;
+  g_bch_cachestat.written += count;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bch_cache_alloc
+ *
+ * Description:
+ *   Take a line of the set of a sector for the sector, the least recently
+ *   used one if they are all in use.  The data of the line is undefined.
+ *
+ ****************************************************************************/
+
+static FAR struct bchlib_cline_s *bch_cache_alloc(FAR struct bchlib_s *bch,
+                                                  size_t sector,
+                                                  FAR int *errcode)
+{
+  FAR struct bchlib_cline_s *line = bch_cache_set(bch, sector);
+  FAR struct bchlib_cline_s *victim = line;
+  int ret;
+  int i;
+
+  for (i = 0; i < CONFIG_BCH_CACHE_NWAYS; i++, line++)
+    {
+      if (line->bch == NULL)
+        {
+          victim = line;
+          break;
+        }
+      else if ((int32_t)(line->stamp - victim->stamp) < 0)
+        {
+          victim = line;
+        }
+    }
+
+  if (victim->bch != NULL && victim->dirty)
+    {
+      ret = bch_cache_writeback(victim);
+      if (ret < 0)
+        {
+          *errcode = ret;
+          return NULL;
+        }
+    }
+
+  victim->bch = NULL;
+
+  if (victim->size != bch->sectsize)
+    {
+      kmm_free(victim->buffer);
+      victim->size   = 0;
+      victim->buffer = bch_alloc(bch->sectsize);
+      if (victim->buffer == NULL)
+        {
+          ferr("Failed to allocate sector buffer\n");
+          *errcode = -ENOMEM;
+          return NULL;
+        }
+
+      victim->size = bch->sectsize;
+    }
+
+  victim->bch    = bch;
+  victim->sector = sector;
+  victim->stamp  = g_bch_stamp++;
+  victim->dirty  = false;
+  return victim;
+}
+
+/****************************************************************************
+ * Name: bch_cache_readahead
+ *
+ * Description:
+ *   Read a sector and the sectors that follow it, up to the first one
+ *   already cached, with one request to the device.
+ *
+ ****************************************************************************/
+
+static FAR struct bchlib_cline_s *
+bch_cache_readahead(FAR struct bchlib_s *bch, size_t sector,
+                    FAR int *errcode)
+{
+  FAR struct bchlib_cline_s *lines[CONFIG_BCH_CACHE_BURST];
+  FAR struct inode *inode = bch->inode;
+  size_t count;
+  size_t i;
+  ssize_t ret;
+
+  if (bch->burst == NULL)
+    {
+      bch->burst = bch_alloc(bch->sectsize * CONFIG_BCH_CACHE_BURST);
+      if (bch->burst == NULL)
+        {
+          return NULL;
+        }
+    }
+
+  /* The consecutive sectors fall into different sets, so the lines taken
+   * here do not replace each other.
+   */
+
+  for (count = 1; count < CONFIG_BCH_CACHE_BURST &&
+                  count < CONFIG_BCH_CACHE_NSETS &&
+                  sector + count < bch->nsectors; count++)
+    {
+      if (bch_cache_find(bch, sector + count) != NULL)
+        {
+          break;
+        }
+    }
+
+  /* Take the lines first:  Writing back the lines that they replace may
+   * use the burst buffer.
+   */
+
+  for (i = 0; i < count; i++)
+    {
+      lines[i] = bch_cache_alloc(bch, sector + i, errcode);
+      if (lines[i] == NULL)
+        {
+          count = i;
+          goto errout;
+        }
+    }
+
+  ret = inode->u.i_bops->read(inode, bch->burst, sector, count);
+  if (ret < 0)
+    {
+      ferr("Read failed: %zd\n", ret);
+      *errcode = ret;
+      goto errout;
+    }
+
+  for (i = 0; i < count; i++)
+    {
+      memcpy(lines[i]->buffer, bch->burst + i * bch->sectsize,
+             bch->sectsize);
+#if defined(CONFIG_BCH_ENCRYPTION)
+      bch_cypher(bch, lines[i]->buffer, sector + i, CYPHER_DECRYPT);
+#endif
+    }
+
+  g_bch_cachestat.readahead += count - 1;
+  bch->next = sector + count;
+  return lines[0];
+
+errout:
+  for (i = 0; i < count; i++)
+    {
+      lines[i]->bch = NULL;
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: bch_cache_load
+ *
+ * Description:
+ *   Return the line that holds a sector, reading it from the device if it
+ *   is not cached.  A miss on the sector that follows the last miss is
+ *   a sequential access, the following sectors are read ahead.
+ *
+ ****************************************************************************/
+
+static FAR struct bchlib_cline_s *bch_cache_load(FAR struct bchlib_s *bch,
+                                                 size_t sector,
+                                                 FAR int *errcode)
+{
+  FAR struct inode *inode = bch->inode;
+  FAR struct bchlib_cline_s *line;
+  ssize_t ret;
+
+  line = bch_cache_find(bch, sector);
+  if (line != NULL)
+    {
+      g_bch_cachestat.hits++;
+      line->stamp = g_bch_stamp++;
+      return line;
+    }
+
+  g_bch_cachestat.misses++;
+
+  if (CONFIG_BCH_CACHE_BURST > 1 && sector == bch->next)
+    {
+      line = bch_cache_readahead(bch, sector, errcode);
+      if (line != NULL || bch->burst != NULL)
+        {
+          return line;
+        }
+    }
+
+  line = bch_cache_alloc(bch, sector, errcode);
+  if (line == NULL)
+    {
+      return NULL;
+    }
+
+  ret = inode->u.i_bops->read(inode, line->buffer, sector, 1);
+  if (ret < 0)
+    {
+      ferr("Read failed: %zd\n", ret);
+      line->bch = NULL;
+      *errcode  = ret;
+      return NULL;
+    }
+
+#if defined(CONFIG_BCH_ENCRYPTION)
+  bch_cypher(bch, line->buffer, sector, CYPHER_DECRYPT);
+#endif
+
+  bch->next = sector + 1;
+  return line;
+}
+
+#endif /* CONFIG_BCH_CACHE */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+#ifdef CONFIG_BCH_CACHE
+
+/****************************************************************************
+ * Name: bchlib_syncsectors
+ *
+ * Description:
+ *   Write the dirty cached sectors of a range to the media, or drop all
+ *   the cached sectors of the range if 'discard' is true;  This is done
+ *   before the range is read or written directly.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_syncsectors(FAR struct bchlib_s *bch, size_t sector,
+                       size_t nsectors, bool discard)
+{
+  FAR struct bchlib_cline_s *line;
+  int ret = OK;
+  int i;
+
+  nxmutex_lock(&g_bch_cachelock);
+
+  for (i = 0; i < BCH_CACHE_NLINES; i++)
+    {
+      line = &g_bch_cache[i];
+      if (line->bch != bch || line->sector < sector ||
+          line->sector - sector >= nsectors)
+        {
+          continue;
+        }
+
+      if (discard)
+        {
+          line->bch   = NULL;
+          line->dirty = false;
+        }
+      else if (line->dirty)
+        {
+          ret = bch_cache_writeback(line);
+          if (ret < 0)
+            {
+              break;
+            }
+        }
+    }
+
+  nxmutex_unlock(&g_bch_cachelock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: bchlib_flushsector
+ *
+ * Description:
+ *   Flush the dirty cached sectors of a device
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_flushsector(FAR struct bchlib_s *bch, bool discard)
+{
+  int ret;
+
+  ret = bchlib_syncsectors(bch, 0, SIZE_MAX, false);
+  if (ret >= 0 && discard)
+    {
+      ret = bchlib_syncsectors(bch, 0, SIZE_MAX, true);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: bchlib_readsector
+ *
+ * Description:
+ *   Read 'len' bytes at 'offset' in a sector through the cache
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_readsector(FAR struct bchlib_s *bch, FAR uint8_t *buffer,
+                      size_t sector, size_t offset, size_t len)
+{
+  FAR struct bchlib_cline_s *line;
+  int ret = OK;
+
+  DEBUGASSERT(offset + len <= bch->sectsize);
+
+  nxmutex_lock(&g_bch_cachelock);
+
+  line = bch_cache_load(bch, sector, &ret);
+  if (line != NULL)
+    {
+      memcpy(buffer, line->buffer + offset, len);
+    }
+  else if (ret >= 0)
+    {
+      ret = -ENOMEM;
+    }
+
+  nxmutex_unlock(&g_bch_cachelock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: bchlib_writesector
+ *
+ * Description:
+ *   Write 'len' bytes at 'offset' in a sector to the cache.  The sector is
+ *   written to the media when its line is replaced or flushed.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_writesector(FAR struct bchlib_s *bch, FAR const uint8_t *buffer,
+                       size_t sector, size_t offset, size_t len)
+{
+  FAR struct bchlib_cline_s *line;
+  int ret = OK;
+
+  DEBUGASSERT(offset + len <= bch->sectsize);
+
+  nxmutex_lock(&g_bch_cachelock);
+
+  /* A whole sector need not be read first */
+
+  line = bch_cache_find(bch, sector);
+  if (line == NULL && len == bch->sectsize)
+    {
+      line = bch_cache_alloc(bch, sector, &ret);
+    }
+  else
+    {
+      line = bch_cache_load(bch, sector, &ret);
+    }
+
+  if (line != NULL)
+    {
+      memcpy(line->buffer + offset, buffer, len);
+      line->stamp = g_bch_stamp++;
+      line->dirty = true;
+    }
+  else if (ret >= 0)
+    {
+      ret = -ENOMEM;
+    }
+
+  nxmutex_unlock(&g_bch_cachelock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: bchlib_freecache
+ *
+ * Description:
+ *   Release the cached sectors of a device that is closed.  The dirty
+ *   sectors must have been flushed:  They are lost.
+ *
+ ****************************************************************************/
+
+void bchlib_freecache(FAR struct bchlib_s *bch)
+{
+  bchlib_syncsectors(bch, 0, SIZE_MAX, true);
+
+  if (bch->burst != NULL)
+    {
+      kmm_free(bch->burst);
+      bch->burst = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: bchlib_cachestat
+ *
+ * Description:
+ *   Return the statistics of the block cache
+ *
+ ****************************************************************************/
+
+void bchlib_cachestat(FAR struct bchlib_cachestat_s *stat)
+{
+  nxmutex_lock(&g_bch_cachelock);
+  *stat = g_bch_cachestat;
+  nxmutex_unlock(&g_bch_cachelock);
+}
+
+#else /* CONFIG_BCH_CACHE */
+
 /****************************************************************************
  * Name: bchlib_flushsector
  *
@@ -120,7 +735,7 @@ int bchlib_flushsector(FAR struct bchlib_s *bch, bool discard)
 #if defined(CONFIG_BCH_ENCRYPTION)
       /* Encrypt data as necessary */
 
-      bch_cypher(bch, CYPHER_ENCRYPT);
+      bch_cypher(bch, bch->buffer, bch->sector, CYPHER_ENCRYPT);
 #endif
 
       /* Write the sector to the media */
@@ -137,7 +752,7 @@ int bchlib_flushsector(FAR struct bchlib_s *bch, bool discard)
        * TODO: Add configuration switch for extra sector buffer
        */
 
-      bch_cypher(bch, CYPHER_DECRYPT);
+      bch_cypher(bch, bch->buffer, bch->sector, CYPHER_DECRYPT);
 #endif
 
       /* The sector is now in sync with the media */
@@ -154,28 +769,51 @@ int bchlib_flushsector(FAR struct bchlib_s *bch, bool discard)
 }
 
 /****************************************************************************
- * Name: bchlib_readsector
+ * Name: bchlib_syncsectors
+ *
+ * Description:
+ *   Prepare a range for a direct transfer:  The sector buffer is flushed
+ *   if it belongs to the range.  Before a write ('discard' true), it is
+ *   flushed anyway to keep the sector sequence, and it is discarded if it
+ *   belongs to the range.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_syncsectors(FAR struct bchlib_s *bch, size_t sector,
+                       size_t nsectors, bool discard)
+{
+  bool inrange = sector <= bch->sector && bch->sector - sector < nsectors;
+
+  if (!inrange && !discard)
+    {
+      return OK;
+    }
+
+  return bchlib_flushsector(bch, inrange && discard);
+}
+
+/****************************************************************************
+ * Name: bchlib_loadsector
  *
  * Description:
- *   Read the current sector contents into buffer
+ *   Read the sector contents into the sector buffer
  *
  * Assumptions:
  *   Caller must assume mutual exclusion
  *
  ****************************************************************************/
 
-int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
+static int bchlib_loadsector(FAR struct bchlib_s *bch, size_t sector)
 {
   FAR struct inode *inode;
   ssize_t ret = OK;
 
   if (bch->buffer == NULL)
     {
-#if CONFIG_BCH_BUFFER_ALIGNMENT != 0
-      bch->buffer = kmm_memalign(CONFIG_BCH_BUFFER_ALIGNMENT, bch->sectsize);
-#else
-      bch->buffer = kmm_malloc(bch->sectsize);
-#endif
+      bch->buffer = bch_alloc(bch->sectsize);
       if (bch->buffer == NULL)
         {
           ferr("Failed to allocate sector buffer\n");
@@ -203,9 +841,79 @@ int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
 
       bch->sector = sector;
 #if defined(CONFIG_BCH_ENCRYPTION)
-      bch_cypher(bch, CYPHER_DECRYPT);
+      bch_cypher(bch, bch->buffer, sector, CYPHER_DECRYPT);
 #endif
     }
 
   return (int)ret;
 }
+
+/****************************************************************************
+ * Name: bchlib_readsector
+ *
+ * Description:
+ *   Read 'len' bytes at 'offset' in a sector through the sector buffer
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_readsector(FAR struct bchlib_s *bch, FAR uint8_t *buffer,
+                      size_t sector, size_t offset, size_t len)
+{
+  int ret;
+
+  ret = bchlib_loadsector(bch, sector);
+  if (ret >= 0)
+    {
+      memcpy(buffer, &bch->buffer[offset], len);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: bchlib_writesector
+ *
+ * Description:
+ *   Write 'len' bytes at 'offset' in a sector to the sector buffer
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_writesector(FAR struct bchlib_s *bch, FAR const uint8_t *buffer,
+                       size_t sector, size_t offset, size_t len)
+{
+  int ret;
+
+  ret = bchlib_loadsector(bch, sector);
+  if (ret >= 0)
+    {
+      memcpy(&bch->buffer[offset], buffer, len);
+      bch->dirty = true;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: bchlib_freecache
+ *
+ * Description:
+ *   Free the sector buffer of a device that is closed
+ *
+ ****************************************************************************/
+
+void bchlib_freecache(FAR struct bchlib_s *bch)
+{
+  if (bch->buffer)
+    {
+      kmm_free(bch->buffer);
+      bch->buffer = NULL;
+    }
+}
+
+#endif /* CONFIG_BCH_CACHE */
@@ -0,0 +1,222 @@
+/****************************************************************************
+ * drivers/bch/bchlib_procfs.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#include "bch.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define BCHCACHE_LINELEN 64
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct bchcache_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     bchcache_open(FAR struct file *filep, FAR const char *relpath,
+                             int oflags, mode_t mode);
+static int     bchcache_close(FAR struct file *filep);
+static ssize_t bchcache_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen);
+static int     bchcache_dup(FAR const struct file *oldp,
+                            FAR struct file *newp);
+static int     bchcache_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_procfs.c -- this structure is explicitly externed there. */
+
+const struct procfs_operations g_bchcache_operations =
+{
+  bchcache_open,      /* open */
+  bchcache_close,     /* close */
+  bchcache_read,      /* read */
+  NULL,               /* write */
+  NULL,               /* poll */
+
+  bchcache_dup,       /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  bchcache_stat       /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bchcache_open
+ ****************************************************************************/
+
+static int bchcache_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct bchcache_file_s *attr;
+
+  /* This PROCFS file is read-only.  Any attempt to open with write access
+   * is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  attr = kmm_zalloc(sizeof(struct bchcache_file_s));
+  if (attr == NULL)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  filep->f_priv = attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bchcache_close
+ ****************************************************************************/
+
+static int bchcache_close(FAR struct file *filep)
+{
+  DEBUGASSERT(filep->f_priv);
+
+  kmm_free(filep->f_priv);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bchcache_read
+ ****************************************************************************/
+
+static ssize_t bchcache_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  struct bchlib_cachestat_s stat;
+  char line[BCHCACHE_LINELEN];
+  size_t copysize;
+  size_t totalsize;
+  size_t linesize;
+  uint32_t total;
+  off_t offset;
+
+  bchlib_cachestat(&stat);
+  total = stat.hits + stat.misses;
+
+  offset    = filep->f_pos;
+  linesize  = snprintf(line, sizeof(line), "%-10s %-10s %-8s %-10s "
+                       "%-10s %s\n", "hits", "misses", "hitrate",
+                       "readahead", "writes", "written");
+  totalsize = procfs_memcpy(line, linesize, buffer, buflen, &offset);
+
+  linesize  = snprintf(line, sizeof(line),
+                       "%-10" PRIu32 " %-10" PRIu32 " %3" PRIu32 "%%     "
+                       "%-10" PRIu32 " %-10" PRIu32 " %" PRIu32 "\n",
+                       stat.hits, stat.misses,
+                       total > 0 ? (uint32_t)((uint64_t)stat.hits * 100 /
+                                              total) : 0,
+                       stat.readahead, stat.writes, stat.written);
+  copysize  = procfs_memcpy(line, linesize, buffer + totalsize,
+                            buflen - totalsize, &offset);
+  totalsize += copysize;
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: bchcache_dup
+ ****************************************************************************/
+
+static int bchcache_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct bchcache_file_s *newattr;
+
+  DEBUGASSERT(oldp->f_priv);
+
+  newattr = kmm_malloc(sizeof(struct bchcache_file_s));
+  if (newattr == NULL)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  memcpy(newattr, oldp->f_priv, sizeof(struct bchcache_file_s));
+  newp->f_priv = newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bchcache_stat
+ ****************************************************************************/
+
+static int bchcache_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
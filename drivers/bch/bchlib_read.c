@@ -99,14 +99,6 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, off_t offset,
   bytesread = 0;
   if (sectoffset > 0)
     {
-      /* Read the sector into the sector buffer */
-
-      ret = bchlib_readsector(bch, sector);
-      if (ret < 0)
-        {
-          return ret;
-        }
-
       /* Copy the tail end of the sector to the user buffer */
 
       if (sectoffset + len > bch->sectsize)
@@ -118,7 +110,12 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, off_t offset,
           nbytes = len;
         }
 
-      memcpy(buffer, &bch->buffer[sectoffset], nbytes);
+      ret = bchlib_readsector(bch, (FAR uint8_t *)buffer, sector,
+                              sectoffset, nbytes);
+      if (ret < 0)
+        {
+          return ret;
+        }
 
       /* Adjust pointers and counts */
 
@@ -146,6 +143,15 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, off_t offset,
           nsectors = bch->nsectors - sector;
         }
 
+      /* The media must hold the sectors written to the cache */
+
+      ret = bchlib_syncsectors(bch, sector, nsectors, false);
+      if (ret < 0)
+        {
+          ferr("ERROR: Flush failed: %d\n", ret);
+          return ret;
+        }
+
       ret = bch->inode->u.i_bops->read(bch->inode, (FAR uint8_t *)buffer,
                                        sector, nsectors);
       if (ret < 0)
@@ -173,18 +179,14 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, off_t offset,
 
   if (len > 0)
     {
-      /* Read the sector into the sector buffer */
+      /* Copy the head end of the sector to the user buffer */
 
-      ret = bchlib_readsector(bch, sector);
+      ret = bchlib_readsector(bch, (FAR uint8_t *)buffer, sector, 0, len);
       if (ret < 0)
         {
           return ret;
         }
 
-      /* Copy the head end of the sector to the user buffer */
-
-      memcpy(buffer, bch->buffer, len);
-
       /* Adjust counts */
 
       bytesread += len;
@@ -108,7 +108,11 @@ int bchlib_setup(FAR const char *blkdev, bool readonly, FAR void **handle)
   nxmutex_init(&bch->lock);
   bch->nsectors = geo.geo_nsectors;
   bch->sectsize = geo.geo_sectorsize;
+#ifdef CONFIG_BCH_CACHE
+  bch->next     = (size_t)-1;
+#else
   bch->sector   = (size_t)-1;
+#endif
   bch->readonly = readonly;
   *handle = bch;
   return OK;
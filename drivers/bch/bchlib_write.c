@@ -83,14 +83,6 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
   byteswritten = 0;
   if (sectoffset > 0)
     {
-      /* Read the full sector into the sector buffer */
-
-      ret = bchlib_readsector(bch, sector);
-      if (ret < 0)
-        {
-          return ret;
-        }
-
       /* Copy the tail end of the sector from the user buffer */
 
       if (sectoffset + len > bch->sectsize)
@@ -102,8 +94,12 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
           nbytes = len;
         }
 
-      memcpy(&bch->buffer[sectoffset], buffer, nbytes);
-      bch->dirty = true;
+      ret = bchlib_writesector(bch, (FAR const uint8_t *)buffer, sector,
+                               sectoffset, nbytes);
+      if (ret < 0)
+        {
+          return ret;
+        }
 
       /* Adjust pointers and counts */
 
@@ -131,10 +127,9 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
           nsectors = bch->nsectors - sector;
         }
 
-      /* Flush the dirty sector to keep the sector sequence */
+      /* Drop the cached sectors that are overwritten */
 
-      ret = bchlib_flushsector(bch, sector <= bch->sector &&
-                               bch->sector < (sector + nsectors));
+      ret = bchlib_syncsectors(bch, sector, nsectors, true);
       if (ret < 0)
         {
           ferr("ERROR: Flush failed: %d\n", ret);
@@ -170,19 +165,15 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
 
   if (len > 0)
     {
-      /* Read the sector into the sector buffer */
+      /* Copy the head end of the sector from the user buffer */
 
-      ret = bchlib_readsector(bch, sector);
+      ret = bchlib_writesector(bch, (FAR const uint8_t *)buffer, sector, 0,
+                               len);
       if (ret < 0)
         {
           return ret;
         }
 
-      /* Copy the head end of the sector from the user buffer */
-
-      memcpy(bch->buffer, buffer, len);
-      bch->dirty = true;
-
       /* Adjust counts */
 
       byteswritten += len;
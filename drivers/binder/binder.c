@@ -473,11 +473,16 @@ static int binder_mmap(FAR struct file *filep,
 {
   FAR struct binder_proc *proc = filep->f_priv;
   struct binder_mmap_area vma;
+  int ret;
 
   vma.area_start = map->vaddr;
   vma.area_size = MIN(map->length, CONFIG_DRIVERS_BINDER_MAX_VMSIZE);
 
-  binder_alloc_mmap(&proc->alloc, &vma);
+  ret = binder_alloc_mmap(&proc->alloc, &vma);
+  if (ret < 0)
+    {
+      return ret;
+    }
 
   map->munmap = binder_munmap;
   map->priv.p = (void *)proc;
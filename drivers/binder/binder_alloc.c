@@ -116,6 +116,24 @@ static bool check_buffer(FAR struct binder_alloc *alloc,
   return ret;
 }
 
+/* Return the bin of the free buffers of 'size' bytes */
+
+static int free_bin(size_t size)
+{
+  int bin = 0;
+
+  for (size >>= 4; size != 0 && bin < BINDER_ALLOC_NBINS - 1; size >>= 1)
+    {
+      bin++;
+    }
+
+  return bin;
+}
+
+/* The size of a free buffer only changes while it is out of its bin: Its
+ * neighbours are allocated buffers, merged with it once they are freed.
+ */
+
 static void insert_free_buffer(FAR struct binder_alloc *alloc,
                                FAR struct binder_buffer *new_buffer)
 {
@@ -125,7 +143,50 @@ static void insert_free_buffer(FAR struct binder_alloc *alloc,
                "alloc->pid=%d add free buffer %p, data %p\n",
                alloc->pid, new_buffer, new_buffer->user_data);
 
-  list_add_tail(&alloc->free_buffers_list, &new_buffer->rb_node);
+  list_add_head(&alloc->free_bins[free_bin(alloc_buffer_size(alloc,
+                                                             new_buffer))],
+                &new_buffer->rb_node);
+}
+
+/****************************************************************************
+ * Name: find_free_buffer
+ *
+ * Description:
+ *   Find the smallest free buffer of at least 'size' bytes:  Only the bin
+ *   of 'size' is searched for a fit, the buffers of the larger bins all
+ *   fit, so the first non empty one has the best of them.
+ *
+ ****************************************************************************/
+
+static FAR struct binder_buffer *find_free_buffer(
+  FAR struct binder_alloc *alloc, size_t size, FAR size_t *buffer_size)
+{
+  FAR struct binder_buffer *buffer = NULL;
+  FAR struct binder_buffer *tmp;
+  size_t tmp_size;
+  int bin;
+
+  for (bin = free_bin(size); bin < BINDER_ALLOC_NBINS && buffer == NULL;
+       bin++)
+    {
+      list_for_every_entry(&alloc->free_bins[bin], tmp,
+                           struct binder_buffer, rb_node)
+        {
+          tmp_size = alloc_buffer_size(alloc, tmp);
+          if (tmp_size >= size &&
+              (buffer == NULL || tmp_size < *buffer_size))
+            {
+              buffer = tmp;
+              *buffer_size = tmp_size;
+              if (tmp_size == size)
+                {
+                  break;
+                }
+            }
+        }
+    }
+
+  return buffer;
 }
 
 FAR static struct binder_buffer * prepare_to_free_locked(
@@ -210,8 +271,7 @@ static FAR struct binder_buffer *binder_alloc_new_buf_locked(
   FAR struct binder_alloc *alloc, struct binder_buffer *new_buffer,
   size_t size, int is_async, FAR int * p_ret)
 {
-  FAR struct binder_buffer *buffer = NULL;
-  FAR struct binder_buffer *tmp;
+  FAR struct binder_buffer *buffer;
   size_t buffer_size = 0;
   FAR void *has_page_addr;
   FAR void *end_page_addr;
@@ -220,19 +280,7 @@ static FAR struct binder_buffer *binder_alloc_new_buf_locked(
 
   BUG_ON((alloc->buffer_data_size == 0));
 
-  list_for_every_entry(&alloc->free_buffers_list, tmp,
-                       struct binder_buffer, rb_node)
-  {
-    buffer_size = alloc_buffer_size(alloc, tmp);
-    if (size <= buffer_size)
-      {
-        buffer = tmp;
-        break;
-      }
-  }
-
-  WARN_ON(buffer == NULL && buffer_size != size);
-
+  buffer = find_free_buffer(alloc, size, &buffer_size);
   if (buffer == NULL)
     {
       binder_debug(BINDER_DEBUG_ERROR,
@@ -243,6 +291,10 @@ static FAR struct binder_buffer *binder_alloc_new_buf_locked(
       goto out;
     }
 
+  /* Take the buffer out of its bin before its size changes */
+
+  list_delete_init(&buffer->rb_node);
+
   if (buffer_size != size)
     {
       list_initialize(&new_buffer->entry);
@@ -278,7 +330,6 @@ static FAR struct binder_buffer *binder_alloc_new_buf_locked(
       goto out;
     }
 
-  list_delete_init(&buffer->rb_node);
   buffer->free = 0;
   buffer->allow_user_free = 0;
   buffer->async_transaction = is_async;
@@ -437,53 +488,6 @@ static void binder_free_buf_locked(FAR struct binder_alloc *alloc,
   insert_free_buffer(alloc, buffer);
 }
 
-/****************************************************************************
- * Name: binder_alloc_get_page
- *
- * Description:
- *   Lookup the struct page corresponding to the address
- *   at buffer_offset into buffer->user_data. If pgoffp is not
- *   NULL, the byte-offset into the page is written there.
- *
- *   The caller is responsible to ensure that the offset points
- *   to a valid address within the buffer and that buffer is
- *   not freeable by the user. Since it can't be freed, we are
- *   guaranteed that the corresponding elements of alloc->pages[]
- *   cannot change.
- *
- * Input Parameters:
- *   alloc - binder_alloc for this proc
- *   buffer - binder buffer to be accessed
- *   buffer_offset - offset into buffer data
- *   pgoffp - address to copy final page offset to
- *
- * Returned Value:
- *   struct page
- *
- ****************************************************************************/
-
-static void *binder_alloc_get_page(
-  FAR struct binder_alloc *alloc, FAR struct binder_buffer *buffer,
-  binder_size_t buffer_offset, FAR unsigned long *pgoffp)
-{
-  binder_size_t buffer_space_offset;
-  unsigned long pgoff;
-  size_t index;
-  FAR struct binder_page *lru_page;
-
-  buffer_space_offset = buffer_offset +
-                        (buffer->user_data - alloc->buffer_data);
-  pgoff = buffer_space_offset & ~PAGE_MASK;
-  index = buffer_space_offset >> PAGE_SHIFT;
-
-  lru_page = &alloc->pages_array[index];
-  *pgoffp = pgoff;
-
-  BUG_ON(lru_page->page_ptr == NULL);
-
-  return lru_page->page_ptr;
-}
-
 /****************************************************************************
  * Name: binder_alloc_clear_buf
  *
@@ -499,23 +503,7 @@ static void *binder_alloc_get_page(
 static void binder_alloc_clear_buf(
   FAR struct binder_alloc *alloc, FAR struct binder_buffer *buffer)
 {
-  size_t bytes = alloc_buffer_size(alloc, buffer);
-  binder_size_t buffer_offset = 0;
-
-  while (bytes)
-    {
-      unsigned long size;
-      void *page;
-      unsigned long pgoff;
-      void *kptr;
-
-      page = binder_alloc_get_page(alloc, buffer, buffer_offset, &pgoff);
-      size = MIN(bytes, PAGE_SIZE - pgoff);
-      kptr = page + pgoff;
-      memset(kptr, 0, size);
-      bytes -= size;
-      buffer_offset += size;
-    }
+  memset(buffer->user_data, 0, alloc_buffer_size(alloc, buffer));
 }
 
 static int binder_alloc_do_buffer_copy(
@@ -530,34 +518,17 @@ static int binder_alloc_do_buffer_copy(
       return -EINVAL;
     }
 
-  while (bytes)
-    {
-      unsigned long size;
-      FAR void *page;
-      unsigned long pgoff;
-      FAR void *tmpptr;
-      FAR void *base_ptr;
-
-      page = binder_alloc_get_page(alloc, buffer,
-                                   buffer_offset, &pgoff);
-      size = MIN(bytes, (size_t)(PAGE_SIZE - pgoff));
-      base_ptr = page;
-      tmpptr = base_ptr + pgoff;
-      if (to_buffer)
-        {
-          BUG_ON(pgoff + size > PAGE_SIZE);
-          memcpy(tmpptr, ptr, size);
-        }
-      else
-        {
-          BUG_ON(pgoff + size > PAGE_SIZE);
-          memcpy(ptr, tmpptr, size);
-        }
+  /* The mmap area is one contiguous block, mapped by the receiver as is,
+   * so the buffer is copied at once and never page by page.
+   */
 
-      bytes -= size;
-      pgoff = 0;
-      ptr = ptr + size;
-      buffer_offset += size;
+  if (to_buffer)
+    {
+      memcpy(buffer->user_data + buffer_offset, ptr, bytes);
+    }
+  else
+    {
+      memcpy(ptr, buffer->user_data + buffer_offset, bytes);
     }
 
   return 0;
@@ -911,13 +882,19 @@ err_alloc_maparea_failed:
 
 void binder_alloc_init(FAR struct binder_alloc *alloc, pid_t pid)
 {
+  int i;
+
   alloc->pid = pid;
   alloc->buffer_data = NULL;
   alloc->buffer_data_size = 0;
 
   nxmutex_init(&alloc->alloc_lock);
   list_initialize(&alloc->buffers_list);
-  list_initialize(&alloc->free_buffers_list);
+  for (i = 0; i < BINDER_ALLOC_NBINS; i++)
+    {
+      list_initialize(&alloc->free_bins[i]);
+    }
+
   list_initialize(&alloc->allocated_buffers_list);
 
   alloc->pages_array = NULL;
@@ -47,6 +47,13 @@
 #define PAGE_MASK (~((1 << PAGE_SHIFT) - 1))
 
 #define SZ_4M 0x00400000
+
+/* The free buffers are binned by size class:  Bin n holds the buffers of
+ * 2^(n + 3) up to 2^(n + 4) - 1 bytes, the last one the larger buffers up
+ * to SZ_4M.
+ */
+
+#define BINDER_ALLOC_NBINS 20
 #define ALIGN(x, a) ALIGN_UP_MASK((x), ((typeof(x))(a) - 1))
 
 #define put_value(val, ptr)           \
@@ -242,8 +249,7 @@ struct binder_page
  * buffer_data: base of per-proc address space mapped via mmap
  * buffer_data_size: size of address space specified via mmap
  * buffers_list: list of all buffers for this proc
- * free_buffers_list: list of buffers available for allocation
- * sorted by size
+ * free_bins: buffers available for allocation, binned by size class
  * allocated_buffers_list:rb tree of allocated buffers sorted by address
  * pages_array: array of binder_lru_page
  *
@@ -260,7 +266,7 @@ struct binder_alloc
   size_t buffer_data_size;
 
   struct list_node buffers_list;
-  struct list_node free_buffers_list;
+  struct list_node free_bins[BINDER_ALLOC_NBINS];
   struct list_node allocated_buffers_list;
 
   FAR struct binder_page *pages_array;
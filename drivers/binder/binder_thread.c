@@ -83,6 +83,11 @@ static void binder_wakeup_poll_threads_ilocked(FAR struct binder_proc *proc,
 {
   FAR struct binder_thread *thread;
 
+  /* With CONFIG_DRIVERS_BINDER_POLL_WAKE_ONE one thread takes the work:  It
+   * goes to the end of the list so that the next work wakes another polling
+   * thread.
+   */
+
   list_for_every_entry(&proc->threads, thread, struct binder_thread,
                        thread_node)
   {
@@ -97,6 +102,12 @@ static void binder_wakeup_poll_threads_ilocked(FAR struct binder_proc *proc,
           {
             wait_wake_up(&thread->wait, 0);
           }
+
+#ifdef CONFIG_DRIVERS_BINDER_POLL_WAKE_ONE
+        list_delete(&thread->thread_node);
+        list_add_tail(&proc->threads, &thread->thread_node);
+        break;
+#endif
       }
   }
 }
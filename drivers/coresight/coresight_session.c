@@ -0,0 +1,232 @@
+/****************************************************************************
+ * drivers/coresight/coresight_session.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <errno.h>
+#include <debug.h>
+#include <inttypes.h>
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/mutex.h>
+#include <nuttx/panic_notifier.h>
+
+#include <nuttx/coresight/coresight_session.h>
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct coresight_session_s
+{
+  FAR struct coresight_dev_s *srcdevs[CONFIG_CORESIGHT_SESSION_MAX_SOURCES];
+  int nsrc;                              /* Number of the source devices. */
+  FAR struct coresight_tmc_dev_s *sink;  /* The sink, NULL without session. */
+  clock_t threshold;                     /* Latency threshold, perf ticks. */
+  mutex_t lock;                          /* Mutex for start/stop. */
+#ifdef CONFIG_CORESIGHT_SESSION_PANIC
+  struct notifier_block nb;              /* Panic notifier. */
+#endif
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct coresight_session_s g_cs_session =
+{
+  .lock = NXMUTEX_INITIALIZER,
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: coresight_session_panic
+ *
+ * Description:
+ *   Freeze the trace when the system panics, the trace stays in the memory
+ *   of the sink for a debugger or a warm reset.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_CORESIGHT_SESSION_PANIC
+static int coresight_session_panic(FAR struct notifier_block *nb,
+                                   unsigned long action, FAR void *data)
+{
+  if (action == PANIC_KERNEL)
+    {
+      coresight_session_freeze("panic");
+    }
+
+  return 0;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: coresight_session_start
+ ****************************************************************************/
+
+int coresight_session_start(FAR struct coresight_dev_s **srcdevs, int nsrc,
+                            FAR struct coresight_tmc_dev_s *sink,
+                            uint32_t threshold)
+{
+  FAR struct coresight_session_s *session = &g_cs_session;
+  irqstate_t flags;
+  int ret;
+  int i;
+
+  if (nsrc <= 0 || nsrc > CONFIG_CORESIGHT_SESSION_MAX_SOURCES ||
+      sink == NULL || sink->config_type != TMC_CONFIG_TYPE_ETR)
+    {
+      return -EINVAL;
+    }
+
+  ret = nxmutex_lock(&session->lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (session->sink != NULL)
+    {
+      ret = -EBUSY;
+      goto out;
+    }
+
+  for (i = 0; i < nsrc; i++)
+    {
+      ret = coresight_enable(srcdevs[i], &sink->csdev);
+      if (ret < 0)
+        {
+          cserr("%s: enable trace to %s failed: %d\n",
+                srcdevs[i]->name, sink->csdev.name, ret);
+
+          while (i-- > 0)
+            {
+              coresight_disable(srcdevs[i]);
+            }
+
+          goto out;
+        }
+
+      session->srcdevs[i] = srcdevs[i];
+    }
+
+  flags = enter_critical_section();
+  session->nsrc      = nsrc;
+  session->threshold = (uint64_t)threshold * perf_getfreq() / NSEC_PER_SEC;
+  session->sink      = sink;
+  leave_critical_section(flags);
+
+#ifdef CONFIG_CORESIGHT_SESSION_PANIC
+  session->nb.notifier_call = coresight_session_panic;
+  panic_notifier_chain_register(&session->nb);
+#endif
+
+out:
+  nxmutex_unlock(&session->lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: coresight_session_stop
+ ****************************************************************************/
+
+void coresight_session_stop(void)
+{
+  FAR struct coresight_session_s *session = &g_cs_session;
+  irqstate_t flags;
+  int i;
+
+  if (nxmutex_lock(&session->lock) < 0)
+    {
+      return;
+    }
+
+  if (session->sink != NULL)
+    {
+#ifdef CONFIG_CORESIGHT_SESSION_PANIC
+      panic_notifier_chain_unregister(&session->nb);
+#endif
+
+      flags = enter_critical_section();
+      session->sink = NULL;
+      leave_critical_section(flags);
+
+      for (i = 0; i < session->nsrc; i++)
+        {
+          coresight_disable(session->srcdevs[i]);
+        }
+
+      session->nsrc = 0;
+    }
+
+  nxmutex_unlock(&session->lock);
+}
+
+/****************************************************************************
+ * Name: coresight_session_freeze
+ ****************************************************************************/
+
+int coresight_session_freeze(FAR const char *reason)
+{
+  FAR struct coresight_tmc_dev_s *sink;
+  irqstate_t flags;
+  int ret = -ENODEV;
+
+  flags = enter_critical_section();
+  sink  = g_cs_session.sink;
+  if (sink != NULL)
+    {
+      ret = tmc_etr_freeze(sink);
+      if (ret >= 0)
+        {
+          _alert("%s: trace frozen by %s, %" PRIu32 " bytes at %p+%"
+                 PRIu32 "\n", sink->csdev.name, reason, sink->len,
+                 sink->buf, sink->offset);
+        }
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: coresight_session_latency
+ ****************************************************************************/
+
+void coresight_session_latency(clock_t start)
+{
+  clock_t threshold = g_cs_session.threshold;
+
+  if (threshold > 0 && perf_gettime() - start > threshold &&
+      g_cs_session.sink != NULL && !g_cs_session.sink->frozen)
+    {
+      coresight_session_freeze("latency");
+    }
+}
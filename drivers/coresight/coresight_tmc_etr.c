@@ -280,6 +280,7 @@ static int tmc_etr_enable(FAR struct coresight_dev_s *csdev)
       return ret;
     }
 
+  tmcdev->frozen = false;
   ret = tmc_etr_hw_enable(tmcdev);
   if (ret < 0)
     {
@@ -298,7 +299,15 @@ static void tmc_etr_disable(FAR struct coresight_dev_s *csdev)
   FAR struct coresight_tmc_dev_s *tmcdev =
     (FAR struct coresight_tmc_dev_s *)csdev;
 
-  tmc_etr_hw_disable(tmcdev);
+  /* A frozen capture is already stopped, its trace is kept until it is
+   * read.
+   */
+
+  if (!tmcdev->frozen)
+    {
+      tmc_etr_hw_disable(tmcdev);
+    }
+
   coresight_disclaim_device(tmcdev->csdev.addr);
 }
 
@@ -331,7 +340,13 @@ static int tmc_etr_open(FAR struct file *filep)
       irqstate_t flags;
 
       flags = enter_critical_section();
-      if (tmcdev->csdev.refcnt > 0)
+      if (tmcdev->frozen)
+        {
+          /* The capture was stopped by tmc_etr_freeze(), the buffer is
+           * already read.
+           */
+        }
+      else if (tmcdev->csdev.refcnt > 0)
         {
           tmc_etr_hw_disable_and_read(tmcdev);
         }
@@ -378,6 +393,7 @@ static int tmc_etr_close(FAR struct file *filep)
       irqstate_t flags;
 
       flags = enter_critical_section();
+      tmcdev->frozen = false;
       if (tmcdev->csdev.refcnt > 0)
         {
           if (tmc_etr_hw_enable(tmcdev) < 0)
@@ -498,6 +514,34 @@ cs_err:
   return ret;
 }
 
+/****************************************************************************
+ * Name: tmc_etr_freeze
+ ****************************************************************************/
+
+int tmc_etr_freeze(FAR struct coresight_tmc_dev_s *tmcdev)
+{
+  irqstate_t flags;
+  int ret = 0;
+
+  flags = enter_critical_section();
+  if (tmcdev->csdev.refcnt == 0)
+    {
+      ret = -EACCES;
+    }
+  else if (tmcdev->frozen || tmcdev->opencnt > 0)
+    {
+      ret = -EALREADY;
+    }
+  else
+    {
+      tmc_etr_hw_disable_and_read(tmcdev);
+      tmcdev->frozen = true;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
 /****************************************************************************
  * Name: tmc_etr_unregister
  ****************************************************************************/
@@ -0,0 +1,235 @@
+/****************************************************************************
+ * drivers/cpufreq/cpufreq_schedutil.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched.h>
+#include <nuttx/wdog.h>
+#include <nuttx/wqueue.h>
+#include <sys/param.h>
+
+#include "cpufreq_internal.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The frequency is chosen with 25% headroom over the utilization */
+
+#define CPUFREQ_SCHEDUTIL_FREQ(freq, util) \
+  ((unsigned int)((uint64_t)(freq) * (util) * 5 / 4 / SCHED_UTIL_SCALE))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct cpufreq_schedutil_s
+{
+  struct work_s work;
+  struct wdog_s wdog;
+  clock_t last;                         /* Ticks of the last update */
+  clock_t rate_limit;                   /* Ticks between updates */
+  clock_t period;                       /* Ticks between updates if busy */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int cpufreq_gov_schedutil_init(FAR struct cpufreq_policy *policy);
+static int cpufreq_gov_schedutil_exit(FAR struct cpufreq_policy *policy);
+static int cpufreq_gov_schedutil_start(FAR struct cpufreq_policy *policy);
+static void cpufreq_gov_schedutil_stop(FAR struct cpufreq_policy *policy);
+static void cpufreq_gov_schedutil_limits(FAR struct cpufreq_policy *policy);
+static void cpufreq_schedutil_timer(wdparm_t arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct cpufreq_governor g_cpufreq_gov_schedutil =
+{
+  .name   = "schedutil",
+  .init   = cpufreq_gov_schedutil_init,
+  .exit   = cpufreq_gov_schedutil_exit,
+  .start  = cpufreq_gov_schedutil_start,
+  .stop   = cpufreq_gov_schedutil_stop,
+  .limits = cpufreq_gov_schedutil_limits,
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* The utilization is not invariant with the frequency:  It is the share of
+ * the time that the CPU was busy at about the current frequency, so the
+ * frequency follows the current one.  A fully busy CPU ramps up by 25% at
+ * each update, up to the limits of the QoS requests.
+ */
+
+static void cpufreq_schedutil_worker(FAR void *arg)
+{
+  FAR struct cpufreq_policy *policy = arg;
+  FAR struct cpufreq_schedutil_s *data;
+  unsigned int target_freq;
+  unsigned int util = 0;
+  int cpu;
+
+  data = policy->governor_data;
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      util = MAX(util, nxsched_get_util(cpu));
+    }
+
+  nxmutex_lock(&policy->lock);
+  target_freq = CPUFREQ_SCHEDUTIL_FREQ(policy->cur, util);
+  cpufreq_driver_target(policy, target_freq, CPUFREQ_RELATION_L);
+  data->last = clock_systime_ticks();
+  nxmutex_unlock(&policy->lock);
+
+  /* A thread that keeps running does not switch context:  Update again
+   * later unless the CPUs are idle.
+   */
+
+  if (util > 0)
+    {
+      wd_start(&data->wdog, data->period, cpufreq_schedutil_timer,
+               (wdparm_t)policy);
+    }
+}
+
+static void cpufreq_schedutil_timer(wdparm_t arg)
+{
+  FAR struct cpufreq_policy *policy = (FAR struct cpufreq_policy *)arg;
+  FAR struct cpufreq_schedutil_s *data = policy->governor_data;
+
+  work_queue(HPWORK, &data->work, cpufreq_schedutil_worker, policy, 0);
+}
+
+/* Called at each context switch with interrupts disabled:  The frequency
+ * can't be changed here, so the update is deferred to the high priority
+ * work queue through a watchdog, at most once per rate limit.
+ */
+
+static void cpufreq_schedutil_update(int cpu, unsigned int util,
+                                     FAR void *arg)
+{
+  FAR struct cpufreq_policy *policy = arg;
+  FAR struct cpufreq_schedutil_s *data = policy->governor_data;
+  unsigned int target_freq;
+  sclock_t delay;
+
+  if (!work_available(&data->work))
+    {
+      return;
+    }
+
+  target_freq = CPUFREQ_SCHEDUTIL_FREQ(policy->cur, util);
+  target_freq = cpufreq_table_resolve_freq(policy, target_freq,
+                                           CPUFREQ_RELATION_L, NULL);
+  if (target_freq == policy->cur)
+    {
+      return;
+    }
+
+  delay = data->last + data->rate_limit - clock_systime_ticks();
+  if (delay < 0)
+    {
+      delay = 0;
+    }
+
+  if (!WDOG_ISACTIVE(&data->wdog) || wd_gettime(&data->wdog) > delay)
+    {
+      wd_start(&data->wdog, delay, cpufreq_schedutil_timer,
+               (wdparm_t)policy);
+    }
+}
+
+static int cpufreq_gov_schedutil_init(FAR struct cpufreq_policy *policy)
+{
+  FAR struct cpufreq_schedutil_s *data;
+
+  data = kmm_zalloc(sizeof(struct cpufreq_schedutil_s));
+  if (!data)
+    {
+      return -ENOMEM;
+    }
+
+  data->rate_limit = USEC2TICK(CONFIG_CPUFREQ_SCHEDUTIL_RATE_LIMIT);
+  data->period = MAX(USEC2TICK(CONFIG_CPUFREQ_SCHEDUTIL_PERIOD), 1);
+  policy->governor_data = data;
+  return 0;
+}
+
+static int cpufreq_gov_schedutil_exit(FAR struct cpufreq_policy *policy)
+{
+  FAR struct cpufreq_schedutil_s *data = policy->governor_data;
+
+  kmm_free(data);
+  return 0;
+}
+
+static int cpufreq_gov_schedutil_start(FAR struct cpufreq_policy *policy)
+{
+  nxsched_util_register(cpufreq_schedutil_update, policy);
+  return 0;
+}
+
+static void cpufreq_gov_schedutil_stop(FAR struct cpufreq_policy *policy)
+{
+  FAR struct cpufreq_schedutil_s *data = policy->governor_data;
+
+  nxsched_util_register(NULL, NULL);
+  wd_cancel(&data->wdog);
+
+  if (sched_idletask())
+    {
+      work_cancel(HPWORK, &data->work);
+    }
+  else
+    {
+      work_cancel_sync(HPWORK, &data->work);
+    }
+
+  /* The worker may have started the watchdog again */
+
+  wd_cancel(&data->wdog);
+}
+
+/* The limits of the QoS requests changed:  Update now */
+
+static void cpufreq_gov_schedutil_limits(FAR struct cpufreq_policy *policy)
+{
+  FAR struct cpufreq_schedutil_s *data = policy->governor_data;
+
+  work_queue(HPWORK, &data->work, cpufreq_schedutil_worker, policy, 0);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+FAR struct cpufreq_governor *cpufreq_default_governor(void)
+{
+  return &g_cpufreq_gov_schedutil;
+}
@@ -0,0 +1,337 @@
+/****************************************************************************
+ * drivers/dma/dma.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include <nuttx/cache.h>
+#include <nuttx/dma/dma.h>
+#include <nuttx/mutex.h>
+#include <nuttx/semaphore.h>
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct dma_entry_s
+{
+  FAR const char       *name;
+  FAR struct dma_dev_s *dev;
+};
+
+/* The state of a synchronous dma_memcpy() */
+
+struct dma_wait_s
+{
+  sem_t   done;
+  ssize_t result;
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void dma_sg_callback(FAR struct dma_chan_s *chan, FAR void *arg,
+                            ssize_t len);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static mutex_t g_dma_lock = NXMUTEX_INITIALIZER;
+static struct dma_entry_s g_dma_devices[CONFIG_DMA_NDEVICES];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: dma_sg_next
+ *
+ * Description:
+ *   Start the next segment of a scatter-gather transfer chained in
+ *   software.
+ *
+ ****************************************************************************/
+
+static int dma_sg_next(FAR struct dma_chan_s *chan,
+                       FAR struct dma_sgxfer_s *xfer)
+{
+  FAR const struct dma_sg_s *sg = &xfer->sg[xfer->next++];
+
+  return DMA_START(chan, dma_sg_callback, xfer, sg->dst, sg->src, sg->len);
+}
+
+/****************************************************************************
+ * Name: dma_sg_callback
+ *
+ * Description:
+ *   The completion of a segment, called by the controller driver usually
+ *   from its interrupt handler:  The next segment is started from there.
+ *
+ ****************************************************************************/
+
+static void dma_sg_callback(FAR struct dma_chan_s *chan, FAR void *arg,
+                            ssize_t len)
+{
+  FAR struct dma_sgxfer_s *xfer = arg;
+  int ret;
+
+  if (len >= 0)
+    {
+      xfer->total += len;
+      if (xfer->next < xfer->nsg)
+        {
+          ret = dma_sg_next(chan, xfer);
+          if (ret >= 0)
+            {
+              return;
+            }
+
+          len = ret;
+        }
+      else
+        {
+          len = xfer->total;
+        }
+    }
+
+  xfer->callback(chan, xfer->arg, len);
+}
+
+/****************************************************************************
+ * Name: dma_memcpy_callback
+ ****************************************************************************/
+
+static void dma_memcpy_callback(FAR struct dma_chan_s *chan,
+                                FAR void *arg, ssize_t len)
+{
+  FAR struct dma_wait_s *wait = arg;
+
+  wait->result = len;
+  nxsem_post(&wait->done);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: dma_register
+ ****************************************************************************/
+
+int dma_register(FAR const char *name, FAR struct dma_dev_s *dev)
+{
+  FAR struct dma_entry_s *slot = NULL;
+  int ret = OK;
+  int i;
+
+  DEBUGASSERT(name != NULL && dev != NULL);
+
+  nxmutex_lock(&g_dma_lock);
+  for (i = 0; i < CONFIG_DMA_NDEVICES; i++)
+    {
+      if (g_dma_devices[i].dev == NULL)
+        {
+          if (slot == NULL)
+            {
+              slot = &g_dma_devices[i];
+            }
+        }
+      else if (strcmp(g_dma_devices[i].name, name) == 0)
+        {
+          ret = -EEXIST;
+          break;
+        }
+    }
+
+  if (ret >= 0)
+    {
+      if (slot != NULL)
+        {
+          slot->name = name;
+          slot->dev  = dev;
+        }
+      else
+        {
+          ret = -ENOSPC;
+        }
+    }
+
+  nxmutex_unlock(&g_dma_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: dma_unregister
+ ****************************************************************************/
+
+int dma_unregister(FAR struct dma_dev_s *dev)
+{
+  int ret = -ENOENT;
+  int i;
+
+  nxmutex_lock(&g_dma_lock);
+  for (i = 0; i < CONFIG_DMA_NDEVICES; i++)
+    {
+      if (g_dma_devices[i].dev == dev)
+        {
+          g_dma_devices[i].dev  = NULL;
+          g_dma_devices[i].name = NULL;
+          ret = OK;
+          break;
+        }
+    }
+
+  nxmutex_unlock(&g_dma_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: dma_lookup
+ ****************************************************************************/
+
+FAR struct dma_dev_s *dma_lookup(FAR const char *name)
+{
+  FAR struct dma_dev_s *dev = NULL;
+  int i;
+
+  nxmutex_lock(&g_dma_lock);
+  for (i = 0; i < CONFIG_DMA_NDEVICES; i++)
+    {
+      if (g_dma_devices[i].dev != NULL &&
+          strcmp(g_dma_devices[i].name, name) == 0)
+        {
+          dev = g_dma_devices[i].dev;
+          break;
+        }
+    }
+
+  nxmutex_unlock(&g_dma_lock);
+  return dev;
+}
+
+/****************************************************************************
+ * Name: dma_start_sg
+ ****************************************************************************/
+
+int dma_start_sg(FAR struct dma_chan_s *chan, FAR struct dma_sgxfer_s *xfer,
+                 FAR const struct dma_sg_s *sg, unsigned int nsg,
+                 dma_callback_t callback, FAR void *arg)
+{
+  DEBUGASSERT(chan != NULL && callback != NULL);
+
+  if (sg == NULL || nsg == 0)
+    {
+      return -EINVAL;
+    }
+
+  if (chan->ops->start_sg != NULL)
+    {
+      return DMA_START_SG(chan, callback, arg, sg, nsg);
+    }
+
+  DEBUGASSERT(xfer != NULL);
+
+  xfer->sg       = sg;
+  xfer->nsg      = nsg;
+  xfer->next     = 0;
+  xfer->total    = 0;
+  xfer->callback = callback;
+  xfer->arg      = arg;
+
+  return dma_sg_next(chan, xfer);
+}
+
+/****************************************************************************
+ * Name: dma_memcpy_async
+ ****************************************************************************/
+
+int dma_memcpy_async(FAR struct dma_chan_s *chan, FAR void *dst,
+                     FAR const void *src, size_t len,
+                     dma_callback_t callback, FAR void *arg)
+{
+  struct dma_config_s cfg;
+  uintptr_t align;
+  unsigned int width;
+  int ret;
+
+  DEBUGASSERT(chan != NULL && callback != NULL);
+
+  /* The widest beat that the addresses and the length allow */
+
+  align = (uintptr_t)dst | (uintptr_t)src | len;
+  width = (align & 3) == 0 ? 4 : (align & 1) == 0 ? 2 : 1;
+
+  memset(&cfg, 0, sizeof(cfg));
+  cfg.direction = DMA_MEM_TO_MEM;
+  cfg.dst_width = width;
+  cfg.src_width = width;
+  cfg.dst_step  = width;
+  cfg.src_step  = width;
+
+  ret = DMA_CONFIG(chan, &cfg);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Write the source to memory and drop the destination from the cache,
+   * so that no dirty line is written back over the copy.
+   */
+
+  up_clean_dcache((uintptr_t)src, (uintptr_t)src + len);
+  up_flush_dcache((uintptr_t)dst, (uintptr_t)dst + len);
+
+  return DMA_START(chan, callback, arg, (uintptr_t)dst, (uintptr_t)src,
+                   len);
+}
+
+/****************************************************************************
+ * Name: dma_memcpy
+ ****************************************************************************/
+
+ssize_t dma_memcpy(FAR struct dma_chan_s *chan, FAR void *dst,
+                   FAR const void *src, size_t len)
+{
+  struct dma_wait_s wait;
+  ssize_t ret;
+
+  nxsem_init(&wait.done, 0, 0);
+  wait.result = 0;
+
+  ret = dma_memcpy_async(chan, dst, src, len, dma_memcpy_callback, &wait);
+  if (ret >= 0)
+    {
+      nxsem_wait_uninterruptible(&wait.done);
+      up_invalidate_dcache((uintptr_t)dst, (uintptr_t)dst + len);
+      ret = wait.result;
+    }
+
+  nxsem_destroy(&wait.done);
+  return ret;
+}
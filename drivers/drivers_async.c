@@ -0,0 +1,516 @@
+/****************************************************************************
+ * drivers/drivers_async.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <errno.h>
+#include <debug.h>
+#include <syslog.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/boottrace.h>
+#include <nuttx/clock.h>
+#include <nuttx/drivers/drivers_async.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/mutex.h>
+#include <nuttx/semaphore.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The states of a probe */
+
+#define PROBE_IDLE      0   /* Not queued */
+#define PROBE_QUEUED    1   /* Waiting for a thread, or for its dependency */
+#define PROBE_RUNNING   2
+#define PROBE_DONE      3
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A driver waiting for its first open */
+
+struct drivers_deferred_s
+{
+  FAR const struct file_operations *fops;  /* The operations of the driver */
+  FAR void                         *priv;  /* The private data of the driver */
+  FAR struct drivers_probe_s       *probe; /* Runs at the first open */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int drivers_deferred_open(FAR struct file *filep);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_deferred_fops =
+{
+  drivers_deferred_open, /* open */
+};
+
+static mutex_t g_async_lock = NXMUTEX_INITIALIZER;
+static mutex_t g_deferred_lock = NXMUTEX_INITIALIZER;
+static sem_t g_async_sem = SEM_INITIALIZER(0);
+
+static FAR struct drivers_probe_s *g_async_queue; /* Queued probes */
+static FAR struct drivers_probe_s *g_async_done;  /* Completed probes */
+
+/* The threads waiting for a completed probe, the threads of asynchronous
+ * probes, and whether the init task was started.
+ */
+
+static int g_async_nwaiters;
+static int g_async_nthreads;
+static bool g_async_closed;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: drivers_async_now
+ *
+ * Description:
+ *   Return the time since boot in microseconds.
+ *
+ ****************************************************************************/
+
+static unsigned long drivers_async_now(void)
+{
+  struct timespec ts;
+
+  clock_systime_timespec(&ts);
+  return ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+}
+
+/****************************************************************************
+ * Name: drivers_async_ready
+ *
+ * Description:
+ *   Return true if the dependency of a probe has completed, or was never
+ *   queued.  Called with g_async_lock held.
+ *
+ ****************************************************************************/
+
+static bool drivers_async_ready(FAR struct drivers_probe_s *probe)
+{
+  return probe->after == NULL ||
+         probe->after->state == PROBE_IDLE ||
+         probe->after->state == PROBE_DONE;
+}
+
+/****************************************************************************
+ * Name: drivers_async_sleep
+ *
+ * Description:
+ *   Wait for the next completed probe.  Called with g_async_lock held.
+ *
+ ****************************************************************************/
+
+static void drivers_async_sleep(void)
+{
+  g_async_nwaiters++;
+  nxmutex_unlock(&g_async_lock);
+  nxsem_wait_uninterruptible(&g_async_sem);
+  nxmutex_lock(&g_async_lock);
+}
+
+/****************************************************************************
+ * Name: drivers_async_wakeup
+ *
+ * Description:
+ *   Wake up all threads waiting for a completed probe.  Called with
+ *   g_async_lock held.
+ *
+ ****************************************************************************/
+
+static void drivers_async_wakeup(void)
+{
+  while (g_async_nwaiters > 0)
+    {
+      g_async_nwaiters--;
+      nxsem_post(&g_async_sem);
+    }
+}
+
+/****************************************************************************
+ * Name: drivers_async_run
+ *
+ * Description:
+ *   Run a probe that is ready and wake up the threads waiting for it.
+ *   Called with g_async_lock held, which is released while probing.
+ *
+ ****************************************************************************/
+
+static void drivers_async_run(FAR struct drivers_probe_s *probe)
+{
+  bool done = probe->state == PROBE_DONE;
+
+  probe->state = PROBE_RUNNING;
+  nxmutex_unlock(&g_async_lock);
+
+  boottrace_begin("probe %s", probe->name);
+  probe->cpu    = up_cpu_index();
+  probe->start  = drivers_async_now();
+  probe->result = probe->probe(probe->arg);
+  probe->end    = drivers_async_now();
+  boottrace_end("probe %s", probe->name);
+
+  if (probe->result < 0)
+    {
+      serr("ERROR: %s probe failed: %d\n", probe->name, probe->result);
+    }
+
+  nxmutex_lock(&g_async_lock);
+  probe->state = PROBE_DONE;
+
+  /* A deferred probe that failed runs again, it is already in the list */
+
+  if (!done)
+    {
+      probe->flink = g_async_done;
+      g_async_done = probe;
+    }
+
+  drivers_async_wakeup();
+}
+
+/****************************************************************************
+ * Name: drivers_async_next
+ *
+ * Description:
+ *   Remove the first probe that is ready from the queue, if any.  Called
+ *   with g_async_lock held.
+ *
+ ****************************************************************************/
+
+static FAR struct drivers_probe_s *drivers_async_next(void)
+{
+  FAR struct drivers_probe_s **prev;
+  FAR struct drivers_probe_s *probe;
+
+  for (prev = &g_async_queue; (probe = *prev) != NULL;
+       prev = &probe->flink)
+    {
+      if (drivers_async_ready(probe))
+        {
+          *prev = probe->flink;
+          return probe;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: drivers_async_thread
+ *
+ * Description:
+ *   The threads of asynchronous probes run the queued probes until the
+ *   init task was started and the queue is empty.
+ *
+ ****************************************************************************/
+
+static int drivers_async_thread(int argc, FAR char *argv[])
+{
+  FAR struct drivers_probe_s *probe;
+
+  nxmutex_lock(&g_async_lock);
+  while (!g_async_closed || g_async_queue != NULL)
+    {
+      probe = drivers_async_next();
+      if (probe != NULL)
+        {
+          drivers_async_run(probe);
+        }
+      else
+        {
+          drivers_async_sleep();
+        }
+    }
+
+  g_async_nthreads--;
+  drivers_async_wakeup();
+  nxmutex_unlock(&g_async_lock);
+  return OK;
+}
+
+#ifdef CONFIG_DRIVERS_ASYNC_INIT_TIMELINE
+/****************************************************************************
+ * Name: drivers_async_report
+ *
+ * Description:
+ *   Print the boot timeline of the completed probes:  Their sum is the
+ *   time that probing them serially would have taken.
+ *
+ ****************************************************************************/
+
+static void drivers_async_report(void)
+{
+  FAR struct drivers_probe_s *probe;
+  unsigned long total = 0;
+
+  syslog(LOG_INFO, "%-24s %4s %10s %10s %6s\n",
+         "PROBE", "CPU", "START(us)", "TIME(us)", "RESULT");
+
+  for (probe = g_async_done; probe != NULL; probe = probe->flink)
+    {
+      syslog(LOG_INFO, "%-24s %4d %10lu %10lu %6d\n",
+             probe->name, probe->cpu, probe->start,
+             probe->end - probe->start, probe->result);
+      total += probe->end - probe->start;
+    }
+
+  syslog(LOG_INFO, "Probes done at %lu us, %lu us of probes\n",
+         drivers_async_now(), total);
+}
+#else
+#  define drivers_async_report()
+#endif
+
+/****************************************************************************
+ * Name: drivers_deferred_open
+ *
+ * Description:
+ *   Run the probe of a deferred driver at its first open, then put the
+ *   operations of the driver in place and open it.
+ *
+ ****************************************************************************/
+
+static int drivers_deferred_open(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct drivers_deferred_s *deferred;
+  FAR struct drivers_probe_s *probe;
+  int ret;
+
+  ret = nxmutex_lock(&g_deferred_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (inode->u.i_ops == &g_deferred_fops)
+    {
+      deferred = inode->i_private;
+      probe    = deferred->probe;
+
+      nxmutex_lock(&g_async_lock);
+      while (!drivers_async_ready(probe))
+        {
+          drivers_async_sleep();
+        }
+
+      drivers_async_run(probe);
+      nxmutex_unlock(&g_async_lock);
+
+      if (probe->result < 0)
+        {
+          nxmutex_unlock(&g_deferred_lock);
+          return probe->result;
+        }
+
+      inode->i_private = deferred->priv;
+      inode->u.i_ops   = deferred->fops;
+      kmm_free(deferred);
+    }
+
+  nxmutex_unlock(&g_deferred_lock);
+
+  if (inode->u.i_ops->open != NULL)
+    {
+      return inode->u.i_ops->open(filep);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: drivers_async_probe
+ *
+ * Description:
+ *   Queue a probe to run on the threads of asynchronous probes.
+ *
+ ****************************************************************************/
+
+void drivers_async_probe(FAR struct drivers_probe_s *probe)
+{
+  nxmutex_lock(&g_async_lock);
+
+  if (g_async_closed)
+    {
+      while (!drivers_async_ready(probe))
+        {
+          drivers_async_sleep();
+        }
+
+      drivers_async_run(probe);
+    }
+  else
+    {
+      FAR struct drivers_probe_s **prev;
+
+      /* Queue in order, so that the probes start in the order they were
+       * queued.
+       */
+
+      for (prev = &g_async_queue; *prev != NULL; prev = &(*prev)->flink)
+        {
+        }
+
+      probe->flink = NULL;
+      probe->state = PROBE_QUEUED;
+      *prev        = probe;
+
+      if (g_async_nwaiters > 0)
+        {
+          g_async_nwaiters--;
+          nxsem_post(&g_async_sem);
+        }
+    }
+
+  nxmutex_unlock(&g_async_lock);
+}
+
+/****************************************************************************
+ * Name: drivers_async_start
+ *
+ * Description:
+ *   Start the threads of asynchronous probes.
+ *
+ ****************************************************************************/
+
+void drivers_async_start(void)
+{
+  int ret;
+  int i;
+
+  for (i = 0; i < CONFIG_DRIVERS_ASYNC_INIT_NTHREADS; i++)
+    {
+      nxmutex_lock(&g_async_lock);
+      g_async_nthreads++;
+      nxmutex_unlock(&g_async_lock);
+
+      ret = kthread_create("drvprobe", CONFIG_DRIVERS_ASYNC_INIT_PRIORITY,
+                           CONFIG_DRIVERS_ASYNC_INIT_STACKSIZE,
+                           drivers_async_thread, NULL);
+      if (ret < 0)
+        {
+          serr("ERROR: Failed to start drvprobe: %d\n", ret);
+
+          nxmutex_lock(&g_async_lock);
+          g_async_nthreads--;
+          nxmutex_unlock(&g_async_lock);
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: drivers_async_wait
+ *
+ * Description:
+ *   Wait for all queued probes to complete and print the boot timeline.
+ *
+ ****************************************************************************/
+
+void drivers_async_wait(void)
+{
+  FAR struct drivers_probe_s *probe;
+
+  nxmutex_lock(&g_async_lock);
+  g_async_closed = true;
+
+  /* Help the threads of asynchronous probes, or run all probes here if
+   * there are none.
+   */
+
+  while (g_async_queue != NULL || g_async_nthreads > 0)
+    {
+      probe = drivers_async_next();
+      if (probe != NULL)
+        {
+          drivers_async_run(probe);
+        }
+      else
+        {
+          /* Wake up the idle threads, so that they see that they are
+           * done.
+           */
+
+          drivers_async_wakeup();
+          drivers_async_sleep();
+        }
+    }
+
+  drivers_async_report();
+  nxmutex_unlock(&g_async_lock);
+}
+
+/****************************************************************************
+ * Name: register_deferred_driver
+ *
+ * Description:
+ *   Register a character driver whose probe runs at its first open.
+ *
+ ****************************************************************************/
+
+int register_deferred_driver(FAR const char *path,
+                             FAR const struct file_operations *fops,
+                             mode_t mode, FAR void *priv,
+                             FAR struct drivers_probe_s *probe)
+{
+  FAR struct drivers_deferred_s *deferred;
+  int ret;
+
+  deferred = kmm_malloc(sizeof(struct drivers_deferred_s));
+  if (deferred == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  deferred->fops  = fops;
+  deferred->priv  = priv;
+  deferred->probe = probe;
+
+  ret = register_driver(path, &g_deferred_fops, mode, deferred);
+  if (ret < 0)
+    {
+      kmm_free(deferred);
+    }
+
+  return ret;
+}
@@ -0,0 +1,328 @@
+/****************************************************************************
+ * drivers/i2c/i2c_queue.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/queue.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/i2c/i2c_master.h>
+#include <nuttx/i2c/i2c_queue.h>
+
+/* Only one request of a queue is active at a time:  It is started from the
+ * completion of the one before it, from the interrupt handler of the lower
+ * half if the lower half completes it asynchronously, so the transfers of
+ * the bus run back-to-back without a context switch between them.  Lower
+ * halves without the transfer_async method, or busy with a synchronous
+ * transfer, run the requests from the low priority work queue instead.
+ */
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct i2c_queue_s
+{
+  FAR struct i2c_master_s *i2c;              /* The lower half */
+  sq_queue_t pending[I2C_PRIO_NCLASSES];     /* The pending requests */
+  FAR struct i2c_request_s *active;          /* The running request */
+  spinlock_t lock;                           /* Protects the requests */
+  struct work_s work;                        /* For synchronous transfers */
+};
+
+/* The state of i2c_queue_transfer() */
+
+struct i2c_queue_wait_s
+{
+  struct i2c_request_s req;
+  sem_t done;
+  int result;
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void i2c_queue_start(FAR struct i2c_queue_s *queue,
+                            FAR struct i2c_request_s *req);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: i2c_queue_complete
+ *
+ * Description:
+ *   Complete the active request and start the next one.  Called from the
+ *   interrupt handler of the lower half or from the work queue.
+ *
+ ****************************************************************************/
+
+static void i2c_queue_complete(FAR void *arg, int result)
+{
+  FAR struct i2c_queue_s *queue = arg;
+  FAR struct i2c_request_s *req;
+  FAR struct i2c_request_s *next = NULL;
+  irqstate_t flags;
+  int prio;
+
+  flags = spin_lock_irqsave(&queue->lock);
+
+  req = queue->active;
+  DEBUGASSERT(req != NULL);
+
+  for (prio = 0; prio < I2C_PRIO_NCLASSES && next == NULL; prio++)
+    {
+      next = (FAR struct i2c_request_s *)sq_remfirst(&queue->pending[prio]);
+    }
+
+  queue->active = next;
+  spin_unlock_irqrestore(&queue->lock, flags);
+
+  /* Keep the bus busy before running the callback */
+
+  if (next != NULL)
+    {
+      i2c_queue_start(queue, next);
+    }
+
+  req->callback(req, result);
+}
+
+/****************************************************************************
+ * Name: i2c_queue_worker
+ *
+ * Description:
+ *   Run the active request synchronously.
+ *
+ ****************************************************************************/
+
+static void i2c_queue_worker(FAR void *arg)
+{
+  FAR struct i2c_queue_s *queue = arg;
+  FAR struct i2c_request_s *req = queue->active;
+
+  i2c_queue_complete(queue, I2C_TRANSFER(queue->i2c, req->msgs, req->count));
+}
+
+/****************************************************************************
+ * Name: i2c_queue_start
+ *
+ * Description:
+ *   Start the active request.
+ *
+ ****************************************************************************/
+
+static void i2c_queue_start(FAR struct i2c_queue_s *queue,
+                            FAR struct i2c_request_s *req)
+{
+  int ret;
+
+  ret = I2C_TRANSFER_ASYNC(queue->i2c, req->msgs, req->count,
+                           i2c_queue_complete, queue);
+  if (ret < 0)
+    {
+      /* Fall back to a synchronous transfer, which also reports a real
+       * error:  Completing the request here would start the next one
+       * recursively.
+       */
+
+      work_queue(LPWORK, &queue->work, i2c_queue_worker, queue, 0);
+    }
+}
+
+/****************************************************************************
+ * Name: i2c_queue_wakeup
+ ****************************************************************************/
+
+static void i2c_queue_wakeup(FAR struct i2c_request_s *req, int result)
+{
+  FAR struct i2c_queue_wait_s *wait = req->arg;
+
+  wait->result = result;
+  nxsem_post(&wait->done);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: i2c_queue_initialize
+ *
+ * Description:
+ *   Create the transfer queue of an I2C bus.
+ *
+ ****************************************************************************/
+
+FAR struct i2c_queue_s *i2c_queue_initialize(FAR struct i2c_master_s *i2c)
+{
+  FAR struct i2c_queue_s *queue;
+  int prio;
+
+  DEBUGASSERT(i2c != NULL);
+
+  queue = kmm_zalloc(sizeof(struct i2c_queue_s));
+  if (queue == NULL)
+    {
+      return NULL;
+    }
+
+  queue->i2c = i2c;
+  spin_lock_init(&queue->lock);
+
+  for (prio = 0; prio < I2C_PRIO_NCLASSES; prio++)
+    {
+      sq_init(&queue->pending[prio]);
+    }
+
+  return queue;
+}
+
+/****************************************************************************
+ * Name: i2c_queue_uninitialize
+ *
+ * Description:
+ *   Free a transfer queue.
+ *
+ ****************************************************************************/
+
+void i2c_queue_uninitialize(FAR struct i2c_queue_s *queue)
+{
+  DEBUGASSERT(queue != NULL && queue->active == NULL);
+  kmm_free(queue);
+}
+
+/****************************************************************************
+ * Name: i2c_queue_submit
+ *
+ * Description:
+ *   Queue a request.
+ *
+ ****************************************************************************/
+
+int i2c_queue_submit(FAR struct i2c_queue_s *queue,
+                     FAR struct i2c_request_s *req)
+{
+  irqstate_t flags;
+
+  if (req == NULL || req->msgs == NULL || req->count <= 0 ||
+      req->callback == NULL || req->prio >= I2C_PRIO_NCLASSES)
+    {
+      return -EINVAL;
+    }
+
+  flags = spin_lock_irqsave(&queue->lock);
+
+  if (queue->active != NULL)
+    {
+      sq_addlast(&req->node, &queue->pending[req->prio]);
+      spin_unlock_irqrestore(&queue->lock, flags);
+      return OK;
+    }
+
+  queue->active = req;
+  spin_unlock_irqrestore(&queue->lock, flags);
+
+  i2c_queue_start(queue, req);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: i2c_queue_cancel
+ *
+ * Description:
+ *   Remove a request that has not started yet.
+ *
+ ****************************************************************************/
+
+int i2c_queue_cancel(FAR struct i2c_queue_s *queue,
+                     FAR struct i2c_request_s *req)
+{
+  FAR sq_entry_t *node;
+  irqstate_t flags;
+  int ret = -ENOENT;
+
+  flags = spin_lock_irqsave(&queue->lock);
+
+  if (req == queue->active)
+    {
+      ret = -EBUSY;
+    }
+  else if (req->prio < I2C_PRIO_NCLASSES)
+    {
+      sq_for_every(&queue->pending[req->prio], node)
+        {
+          if (node == &req->node)
+            {
+              sq_rem(node, &queue->pending[req->prio]);
+              ret = OK;
+              break;
+            }
+        }
+    }
+
+  spin_unlock_irqrestore(&queue->lock, flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: i2c_queue_transfer
+ *
+ * Description:
+ *   Queue a transfer and wait for its completion.
+ *
+ ****************************************************************************/
+
+int i2c_queue_transfer(FAR struct i2c_queue_s *queue,
+                       FAR struct i2c_msg_s *msgs, int count,
+                       enum i2c_prio_e prio)
+{
+  struct i2c_queue_wait_s wait;
+  int ret;
+
+  wait.req.msgs     = msgs;
+  wait.req.count    = count;
+  wait.req.prio     = prio;
+  wait.req.callback = i2c_queue_wakeup;
+  wait.req.arg      = &wait;
+
+  nxsem_init(&wait.done, 0, 0);
+
+  ret = i2c_queue_submit(queue, &wait.req);
+  if (ret >= 0)
+    {
+      nxsem_wait_uninterruptible(&wait.done);
+      ret = wait.result;
+    }
+
+  nxsem_destroy(&wait.done);
+  return ret;
+}
@@ -34,6 +34,8 @@
 #include <nuttx/mutex.h>
 #include <nuttx/list.h>
 #include <nuttx/circbuf.h>
+#include <nuttx/clock.h>
+#include <nuttx/wqueue.h>
 
 /****************************************************************************
  * Private Types
@@ -46,6 +48,15 @@ struct mouse_openpriv_s
   FAR struct pollfd *fds;     /* Polling structure of waiting thread */
   sem_t              waitsem; /* Used to wait for the availability of data */
   mutex_t            lock;    /* Manages exclusive access to this structure */
+#ifdef CONFIG_INPUT_BATCH
+  struct work_s      work;    /* Wakes up the reader of a partial batch */
+  uint16_t           pending; /* Reports since the last wakeup */
+  bool               staged;  /* A move waits in 'stage' */
+
+  /* The last move, not queued yet as it may be replaced by the next one */
+
+  struct mouse_report_s stage;
+#endif
 };
 
 /* This structure is for mouse upper half driver */
@@ -56,6 +67,9 @@ struct mouse_upperhalf_s
   mutex_t          lock;               /* Manages exclusive access to this structure */
   struct list_node head;               /* Opened file buffer chain header node */
   FAR struct mouse_lowerhalf_s *lower; /* A pointer of lower half instance */
+#ifdef CONFIG_INPUT_BATCH
+  uint8_t          buttons;            /* Buttons of the last report */
+#endif
 };
 
 /****************************************************************************
@@ -68,6 +82,9 @@ static ssize_t mouse_read(FAR struct file *filep, FAR char *buffer,
                           size_t buflen);
 static int     mouse_poll(FAR struct file *filep, FAR struct pollfd *fds,
                           bool setup);
+#ifdef CONFIG_INPUT_BATCH
+static void    mouse_commit(FAR struct mouse_openpriv_s *openpriv);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -154,6 +171,9 @@ static int mouse_close(FAR struct file *filep)
     }
 
   list_delete(&openpriv->node);
+#ifdef CONFIG_INPUT_BATCH
+  work_cancel_sync(HPWORK, &openpriv->work);
+#endif
   circbuf_uninit(&openpriv->circbuf);
   nxsem_destroy(&openpriv->waitsem);
   nxmutex_destroy(&openpriv->lock);
@@ -184,6 +204,10 @@ static ssize_t mouse_read(FAR struct file *filep, FAR char *buffer,
       return ret;
     }
 
+#ifdef CONFIG_INPUT_BATCH
+  mouse_commit(openpriv);
+#endif
+
   while (circbuf_is_empty(&openpriv->circbuf))
     {
       if (filep->f_oflags & O_NONBLOCK)
@@ -205,9 +229,20 @@ static ssize_t mouse_read(FAR struct file *filep, FAR char *buffer,
             {
               return ret;
             }
+
+#ifdef CONFIG_INPUT_BATCH
+          mouse_commit(openpriv);
+#endif
         }
     }
 
+  /* Return as many whole reports as the buffer holds */
+
+  if (len >= sizeof(struct mouse_report_s))
+    {
+      len -= len % sizeof(struct mouse_report_s);
+    }
+
   ret = circbuf_read(&openpriv->circbuf, buffer, len);
 
 out:
@@ -250,6 +285,13 @@ static int mouse_poll(FAR struct file *filep,
           eventset |= POLLIN;
         }
 
+#ifdef CONFIG_INPUT_BATCH
+      if (openpriv->staged)
+        {
+          eventset |= POLLIN;
+        }
+#endif
+
       poll_notify(&fds, 1, eventset);
     }
   else if (fds->priv)
@@ -263,6 +305,126 @@ errout:
   return ret;
 }
 
+/****************************************************************************
+ * Name: mouse_wakeup
+ ****************************************************************************/
+
+static void mouse_wakeup(FAR struct mouse_openpriv_s *openpriv)
+{
+  int semcount;
+
+  nxsem_get_value(&openpriv->waitsem, &semcount);
+  if (semcount < 1)
+    {
+      nxsem_post(&openpriv->waitsem);
+    }
+
+  if (openpriv->fds && openpriv->fds->fd >= 0)
+    {
+      poll_notify(&openpriv->fds, 1, POLLIN);
+    }
+}
+
+#ifdef CONFIG_INPUT_BATCH
+/****************************************************************************
+ * Name: mouse_commit
+ *
+ * Description:
+ *   Queue the staged move, if any.
+ *
+ ****************************************************************************/
+
+static void mouse_commit(FAR struct mouse_openpriv_s *openpriv)
+{
+  if (openpriv->staged)
+    {
+      circbuf_overwrite(&openpriv->circbuf, &openpriv->stage,
+                        sizeof(struct mouse_report_s));
+      openpriv->staged = false;
+    }
+}
+
+/****************************************************************************
+ * Name: mouse_batch_worker
+ *
+ * Description:
+ *   Wake up the reader of a partial batch once the timeout expires.
+ *
+ ****************************************************************************/
+
+static void mouse_batch_worker(FAR void *arg)
+{
+  FAR struct mouse_openpriv_s *openpriv = arg;
+
+  nxmutex_lock(&openpriv->lock);
+  if (openpriv->pending > 0)
+    {
+      mouse_commit(openpriv);
+      openpriv->pending = 0;
+      mouse_wakeup(openpriv);
+    }
+
+  nxmutex_unlock(&openpriv->lock);
+}
+
+/****************************************************************************
+ * Name: mouse_batch
+ *
+ * Description:
+ *   Queue a report for a reader and wake it up once the batch is full or
+ *   the buttons change, otherwise once the timeout expires.
+ *
+ ****************************************************************************/
+
+static void mouse_batch(FAR struct mouse_openpriv_s *openpriv,
+                        FAR const struct mouse_report_s *sample,
+                        bool move)
+{
+  nxmutex_lock(&openpriv->lock);
+
+#ifdef CONFIG_INPUT_BATCH_COALESCE
+  /* A move replaces the staged one */
+
+  if (openpriv->staged && move)
+    {
+      openpriv->stage = *sample;
+      nxmutex_unlock(&openpriv->lock);
+      return;
+    }
+
+  mouse_commit(openpriv);
+
+  if (move)
+    {
+      openpriv->stage  = *sample;
+      openpriv->staged = true;
+    }
+  else
+#endif
+    {
+      circbuf_overwrite(&openpriv->circbuf, sample,
+                        sizeof(struct mouse_report_s));
+    }
+
+  if (++openpriv->pending >= CONFIG_INPUT_BATCH_THRESHOLD || !move)
+    {
+      mouse_commit(openpriv);
+      openpriv->pending = 0;
+      work_cancel(HPWORK, &openpriv->work);
+      mouse_wakeup(openpriv);
+    }
+#if CONFIG_INPUT_BATCH_TIMEOUT > 0
+  else if (openpriv->pending == 1)
+    {
+      work_queue(HPWORK, &openpriv->work, mouse_batch_worker, openpriv,
+                 USEC2TICK(CONFIG_INPUT_BATCH_TIMEOUT));
+    }
+#endif
+
+  nxmutex_unlock(&openpriv->lock);
+}
+#endif /* CONFIG_INPUT_BATCH */
+
 /****************************************************************************
  * Public Function
  ****************************************************************************/
@@ -275,28 +437,31 @@ void mouse_event(FAR void *priv, FAR const struct mouse_report_s *sample)
 {
   FAR struct mouse_upperhalf_s *upper = priv;
   FAR struct mouse_openpriv_s  *openpriv;
-  int semcount;
+#ifdef CONFIG_INPUT_BATCH
+  bool move;
+#endif
 
   if (nxmutex_lock(&upper->lock) < 0)
     {
       return;
     }
 
+#ifdef CONFIG_INPUT_BATCH
+  /* A report with the same buttons as the previous one is a move */
+
+  move           = sample->buttons == upper->buttons;
+  upper->buttons  = sample->buttons;
+#endif
+
   list_for_every_entry(&upper->head, openpriv, struct mouse_openpriv_s, node)
     {
+#ifdef CONFIG_INPUT_BATCH
+      mouse_batch(openpriv, sample, move);
+#else
       circbuf_overwrite(&openpriv->circbuf, sample,
                         sizeof(struct mouse_report_s));
-
-      nxsem_get_value(&openpriv->waitsem, &semcount);
-      if (semcount < 1)
-        {
-          nxsem_post(&openpriv->waitsem);
-        }
-
-      if (openpriv->fds && openpriv->fds->fd >= 0)
-        {
-          poll_notify(&openpriv->fds, 1, POLLIN);
-        }
+      mouse_wakeup(openpriv);
+#endif
     }
 
   nxmutex_unlock(&upper->lock);
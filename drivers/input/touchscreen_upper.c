@@ -39,6 +39,8 @@
 #include <nuttx/mutex.h>
 #include <nuttx/list.h>
 #include <nuttx/circbuf.h>
+#include <nuttx/clock.h>
+#include <nuttx/wqueue.h>
 
 /****************************************************************************
  * Private Types
@@ -51,6 +53,18 @@ struct touch_openpriv_s
   FAR struct pollfd *fds;     /* Polling structure of waiting thread */
   sem_t              waitsem; /* Used to wait for the availability of data */
   mutex_t            lock;    /* Manages exclusive access to this structure */
+#ifdef CONFIG_INPUT_BATCH
+  struct work_s      work;    /* Wakes up the reader of a partial batch */
+  uint16_t           pending; /* Samples since the last wakeup */
+  bool               staged;  /* A move waits in 'stage' */
+
+  /* The wakeup policy of the reader, and the last move, not queued yet as
+   * it may be replaced by the next one.
+   */
+
+  struct touch_batch_s batch;
+  FAR struct touch_sample_s *stage;
+#endif
 };
 
 /* This structure is for touchscreen upper half driver */
@@ -81,6 +95,9 @@ static int     touch_poll(FAR struct file *filep, FAR struct pollfd *fds,
 
 static void    touch_event_notify(FAR struct touch_openpriv_s  *openpriv,
                                   FAR const struct touch_sample_s *sample);
+#ifdef CONFIG_INPUT_BATCH
+static void    touch_commit(FAR struct touch_openpriv_s *openpriv);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -129,9 +146,28 @@ static int touch_open(FAR struct file *filep)
       return ret;
     }
 
+#ifdef CONFIG_INPUT_BATCH
+  openpriv->stage = kmm_malloc(SIZEOF_TOUCH_SAMPLE_S(lower->maxpoint));
+  if (openpriv->stage == NULL)
+    {
+      circbuf_uninit(&openpriv->circbuf);
+      kmm_free(openpriv);
+      return -ENOMEM;
+    }
+
+  openpriv->batch.threshold = CONFIG_INPUT_BATCH_THRESHOLD;
+  openpriv->batch.timeout   = CONFIG_INPUT_BATCH_TIMEOUT;
+#  ifdef CONFIG_INPUT_BATCH_COALESCE
+  openpriv->batch.coalesce  = true;
+#  endif
+#endif
+
   ret = nxmutex_lock(&upper->lock);
   if (ret < 0)
     {
+#ifdef CONFIG_INPUT_BATCH
+      kmm_free(openpriv->stage);
+#endif
       circbuf_uninit(&openpriv->circbuf);
       kmm_free(openpriv);
       return ret;
@@ -173,6 +209,10 @@ static int touch_close(FAR struct file *filep)
     }
 
   list_delete(&openpriv->node);
+#ifdef CONFIG_INPUT_BATCH
+  work_cancel_sync(HPWORK, &openpriv->work);
+  kmm_free(openpriv->stage);
+#endif
   circbuf_uninit(&openpriv->circbuf);
   nxsem_destroy(&openpriv->waitsem);
   nxmutex_destroy(&openpriv->lock);
@@ -209,6 +249,9 @@ static ssize_t touch_read(FAR struct file *filep, FAR char *buffer,
                           size_t len)
 {
   FAR struct touch_openpriv_s *openpriv = filep->f_priv;
+  struct touch_sample_s sample;
+  size_t nbytes;
+  size_t size;
   int ret;
 
   if (!buffer || !len)
@@ -222,6 +265,10 @@ static ssize_t touch_read(FAR struct file *filep, FAR char *buffer,
       return ret;
     }
 
+#ifdef CONFIG_INPUT_BATCH
+  touch_commit(openpriv);
+#endif
+
   while (circbuf_is_empty(&openpriv->circbuf))
     {
       if (filep->f_oflags & O_NONBLOCK)
@@ -243,10 +290,31 @@ static ssize_t touch_read(FAR struct file *filep, FAR char *buffer,
             {
               return ret;
             }
+
+#ifdef CONFIG_INPUT_BATCH
+          touch_commit(openpriv);
+#endif
         }
     }
 
-  ret = circbuf_read(&openpriv->circbuf, buffer, len);
+  /* Return as many whole samples as the buffer holds, a part of the first
+   * one only if the buffer is smaller.
+   */
+
+  for (nbytes = 0; nbytes < circbuf_used(&openpriv->circbuf);
+       nbytes += size)
+    {
+      circbuf_peekat(&openpriv->circbuf, openpriv->circbuf.tail + nbytes,
+                     &sample.npoints, sizeof(sample.npoints));
+
+      size = SIZEOF_TOUCH_SAMPLE_S(sample.npoints);
+      if (nbytes + size > len)
+        {
+          break;
+        }
+    }
+
+  ret = circbuf_read(&openpriv->circbuf, buffer, nbytes > 0 ? nbytes : len);
 
 out:
   nxmutex_unlock(&openpriv->lock);
@@ -301,6 +369,27 @@ static int touch_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
             }
         }
         break;
+#ifdef CONFIG_INPUT_BATCH
+      case TSIOC_SETBATCH:
+        {
+          FAR const struct touch_batch_s *batch =
+            (FAR const struct touch_batch_s *)((uintptr_t)arg);
+
+          if (batch == NULL || batch->threshold == 0)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          nxmutex_lock(&openpriv->lock);
+          openpriv->batch = *batch;
+          touch_commit(openpriv);
+          nxmutex_unlock(&openpriv->lock);
+          ret = OK;
+        }
+        break;
+#endif
+
       default:
         {
           if (lower->control)
@@ -354,6 +443,13 @@ static int touch_poll(FAR struct file *filep, FAR struct pollfd *fds,
           eventset |= POLLIN;
         }
 
+#ifdef CONFIG_INPUT_BATCH
+      if (openpriv->staged)
+        {
+          eventset |= POLLIN;
+        }
+#endif
+
       poll_notify(&fds, 1, eventset);
     }
   else if (fds->priv)
@@ -368,18 +464,17 @@ errout:
 }
 
 /****************************************************************************
- * Name: touch_event_notify
+ * Name: touch_wakeup
+ *
+ * Description:
+ *   Wake up the reader.  Called with the lock of the open structure held.
+ *
  ****************************************************************************/
 
-static void touch_event_notify(FAR struct touch_openpriv_s  *openpriv,
-                               FAR const struct touch_sample_s *sample)
+static void touch_wakeup(FAR struct touch_openpriv_s *openpriv)
 {
   int semcount;
 
-  nxmutex_lock(&openpriv->lock);
-  circbuf_overwrite(&openpriv->circbuf, sample,
-                    SIZEOF_TOUCH_SAMPLE_S(sample->npoints));
-
   nxsem_get_value(&openpriv->waitsem, &semcount);
   if (semcount < 1)
     {
@@ -387,6 +482,164 @@ static void touch_event_notify(FAR struct touch_openpriv_s  *openpriv,
     }
 
   poll_notify(&openpriv->fds, 1, POLLIN);
+}
+
+#ifdef CONFIG_INPUT_BATCH
+/****************************************************************************
+ * Name: touch_commit
+ *
+ * Description:
+ *   Queue the staged move, if any.
+ *
+ ****************************************************************************/
+
+static void touch_commit(FAR struct touch_openpriv_s *openpriv)
+{
+  if (openpriv->staged)
+    {
+      circbuf_overwrite(&openpriv->circbuf, openpriv->stage,
+                        SIZEOF_TOUCH_SAMPLE_S(openpriv->stage->npoints));
+      openpriv->staged = false;
+    }
+}
+
+/****************************************************************************
+ * Name: touch_ismove
+ *
+ * Description:
+ *   Return true if a sample neither starts nor ends a contact.
+ *
+ ****************************************************************************/
+
+static bool touch_ismove(FAR const struct touch_sample_s *sample)
+{
+  int i;
+
+  for (i = 0; i < sample->npoints; i++)
+    {
+      if ((sample->point[i].flags & (TOUCH_DOWN | TOUCH_UP)) != 0)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: touch_samecontacts
+ *
+ * Description:
+ *   Return true if two samples report the same contacts.
+ *
+ ****************************************************************************/
+
+static bool touch_samecontacts(FAR const struct touch_sample_s *a,
+                               FAR const struct touch_sample_s *b)
+{
+  int i;
+
+  if (a->npoints != b->npoints)
+    {
+      return false;
+    }
+
+  for (i = 0; i < a->npoints; i++)
+    {
+      if (a->point[i].id != b->point[i].id)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: touch_batch_worker
+ *
+ * Description:
+ *   Wake up the reader of a partial batch once the timeout expires.
+ *
+ ****************************************************************************/
+
+static void touch_batch_worker(FAR void *arg)
+{
+  FAR struct touch_openpriv_s *openpriv = arg;
+
+  nxmutex_lock(&openpriv->lock);
+  if (openpriv->pending > 0)
+    {
+      touch_commit(openpriv);
+      openpriv->pending = 0;
+      touch_wakeup(openpriv);
+    }
+
+  nxmutex_unlock(&openpriv->lock);
+}
+#endif /* CONFIG_INPUT_BATCH */
+
+/****************************************************************************
+ * Name: touch_event_notify
+ ****************************************************************************/
+
+static void touch_event_notify(FAR struct touch_openpriv_s  *openpriv,
+                               FAR const struct touch_sample_s *sample)
+{
+#ifdef CONFIG_INPUT_BATCH
+  bool move = touch_ismove(sample);
+#endif
+
+  nxmutex_lock(&openpriv->lock);
+
+#ifdef CONFIG_INPUT_BATCH
+  /* A move replaces the staged move of the same contacts */
+
+  if (openpriv->staged && move &&
+      touch_samecontacts(openpriv->stage, sample))
+    {
+      memcpy(openpriv->stage, sample,
+             SIZEOF_TOUCH_SAMPLE_S(sample->npoints));
+      nxmutex_unlock(&openpriv->lock);
+      return;
+    }
+
+  touch_commit(openpriv);
+
+  if (openpriv->batch.coalesce && move)
+    {
+      memcpy(openpriv->stage, sample,
+             SIZEOF_TOUCH_SAMPLE_S(sample->npoints));
+      openpriv->staged = true;
+    }
+  else
+    {
+      circbuf_overwrite(&openpriv->circbuf, sample,
+                        SIZEOF_TOUCH_SAMPLE_S(sample->npoints));
+    }
+
+  /* Wake up the reader once the batch is full or the contacts change,
+   * otherwise once the timeout expires after the first sample.
+   */
+
+  if (++openpriv->pending >= openpriv->batch.threshold || !move)
+    {
+      touch_commit(openpriv);
+      openpriv->pending = 0;
+      work_cancel(HPWORK, &openpriv->work);
+      touch_wakeup(openpriv);
+    }
+  else if (openpriv->pending == 1 && openpriv->batch.timeout > 0)
+    {
+      work_queue(HPWORK, &openpriv->work, touch_batch_worker, openpriv,
+                 USEC2TICK(openpriv->batch.timeout));
+    }
+#else
+  circbuf_overwrite(&openpriv->circbuf, sample,
+                    SIZEOF_TOUCH_SAMPLE_S(sample->npoints));
+  touch_wakeup(openpriv);
+#endif
+
   nxmutex_unlock(&openpriv->lock);
 }
 
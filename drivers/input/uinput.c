@@ -303,11 +303,33 @@ static ssize_t uinput_touch_notify(FAR void *uinput_lower,
 {
   FAR struct uinput_touch_lowerhalf_s *utcs_lower =
     (FAR struct uinput_touch_lowerhalf_s *)uinput_lower;
-  FAR const struct touch_sample_s *sample =
-    (FAR const struct touch_sample_s *)buffer;
+  FAR const struct touch_sample_s *sample;
+  size_t nbytes = 0;
+  size_t size;
 
-  touch_event(utcs_lower->lower.priv, sample);
-  return buflen;
+  /* The buffer may hold several samples, notify them one by one */
+
+  while (buflen - nbytes >= SIZEOF_TOUCH_SAMPLE_S(1))
+    {
+      sample = (FAR const struct touch_sample_s *)(buffer + nbytes);
+      size   = SIZEOF_TOUCH_SAMPLE_S(sample->npoints);
+      if (sample->npoints < 1 || size > buflen - nbytes)
+        {
+          break;
+        }
+
+      touch_event(utcs_lower->lower.priv, sample);
+      nbytes += size;
+    }
+
+  if (nbytes == 0)
+    {
+      touch_event(utcs_lower->lower.priv,
+                  (FAR const struct touch_sample_s *)buffer);
+      nbytes = buflen;
+    }
+
+  return nbytes;
 }
 
 /****************************************************************************
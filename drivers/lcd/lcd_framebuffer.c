@@ -33,7 +33,9 @@
 #include <nuttx/board.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/lcd/lcd.h>
+#include <nuttx/mutex.h>
 #include <nuttx/video/fb.h>
+#include <nuttx/wqueue.h>
 
 #ifdef CONFIG_LCD_FRAMEBUFFER
 
@@ -45,6 +47,20 @@
 
 #define VIDEO_PLANE 0
 
+/* The damaged areas are written to the LCD by the low priority work queue
+ * if there is one.
+ */
+
+#ifdef CONFIG_LCD_FRAMEBUFFER_DAMAGE
+#  ifdef CONFIG_SCHED_LPWORK
+#    define LCDFB_WORK LPWORK
+#  else
+#    define LCDFB_WORK HPWORK
+#  endif
+
+#  define LCDFB_AREASIZE(a) ((uint32_t)(a)->w * (a)->h)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -63,6 +79,15 @@ struct lcdfb_dev_s
   fb_coord_t yres;                  /* Vertical resolution in pixel rows */
   fb_coord_t stride;                /* Width of a row in bytes */
   uint8_t display;                  /* Display number */
+
+#ifdef CONFIG_LCD_FRAMEBUFFER_DAMAGE
+  /* The damaged areas not written to the LCD yet */
+
+  struct fb_area_s damage[CONFIG_LCD_FRAMEBUFFER_NDAMAGE];
+  uint8_t ndamage;                  /* Number of damaged areas */
+  mutex_t lock;                     /* Protects the damaged areas */
+  struct work_s work;               /* Writes the damaged areas */
+#endif
 };
 
 /****************************************************************************
@@ -152,17 +177,17 @@ static FAR struct lcdfb_dev_s *lcdfb_find(int display)
 }
 
 /****************************************************************************
- * Name: lcdfb_updateearea
+ * Name: lcdfb_putarea
  *
  * Description:
- * Update the LCD when there is a change to the framebuffer.
+ *   Write an area of the framebuffer to the LCD, or all of it if 'area' is
+ *   NULL.
  *
  ****************************************************************************/
 
-static int lcdfb_updateearea(FAR struct fb_vtable_s *vtable,
-                             FAR const struct fb_area_s *area)
+static int lcdfb_putarea(FAR struct lcdfb_dev_s *priv,
+                         FAR const struct fb_area_s *area)
 {
-  FAR struct lcdfb_dev_s *priv = (FAR struct lcdfb_dev_s *)vtable;
   FAR struct lcd_planeinfo_s *pinfo = &priv->pinfo;
   FAR uint8_t *run = priv->fbmem;
   fb_coord_t row;
@@ -263,6 +288,179 @@ static int lcdfb_updateearea(FAR struct fb_vtable_s *vtable,
   return OK;
 }
 
+#ifdef CONFIG_LCD_FRAMEBUFFER_DAMAGE
+/****************************************************************************
+ * Name: lcdfb_union
+ *
+ * Description:
+ *   Return in 'dest' the smallest area that contains 'a' and 'b'.
+ *
+ ****************************************************************************/
+
+static void lcdfb_union(FAR struct fb_area_s *dest,
+                        FAR const struct fb_area_s *a,
+                        FAR const struct fb_area_s *b)
+{
+  fb_coord_t x0 = a->x < b->x ? a->x : b->x;
+  fb_coord_t y0 = a->y < b->y ? a->y : b->y;
+  fb_coord_t x1 = a->x + a->w > b->x + b->w ? a->x + a->w : b->x + b->w;
+  fb_coord_t y1 = a->y + a->h > b->y + b->h ? a->y + a->h : b->y + b->h;
+
+  dest->x = x0;
+  dest->y = y0;
+  dest->w = x1 - x0;
+  dest->h = y1 - y0;
+}
+
+/****************************************************************************
+ * Name: lcdfb_flush
+ *
+ * Description:
+ *   Write the damaged areas to the LCD, on the work queue.
+ *
+ ****************************************************************************/
+
+static void lcdfb_flush(FAR void *arg)
+{
+  FAR struct lcdfb_dev_s *priv = arg;
+  struct fb_area_s damage[CONFIG_LCD_FRAMEBUFFER_NDAMAGE];
+  int ndamage;
+  int i;
+
+  nxmutex_lock(&priv->lock);
+  ndamage = priv->ndamage;
+  memcpy(damage, priv->damage, ndamage * sizeof(struct fb_area_s));
+  priv->ndamage = 0;
+  nxmutex_unlock(&priv->lock);
+
+  for (i = 0; i < ndamage; i++)
+    {
+      lcdfb_putarea(priv, &damage[i]);
+    }
+}
+
+/****************************************************************************
+ * Name: lcdfb_damage
+ *
+ * Description:
+ *   Add an area to the damaged areas.  The area is merged with each damaged
+ *   area whose union with it costs no more than the two areas, and with the
+ *   area that grows the least if the list is full.
+ *
+ ****************************************************************************/
+
+static void lcdfb_damage(FAR struct lcdfb_dev_s *priv,
+                         FAR const struct fb_area_s *area)
+{
+  struct fb_area_s rect;
+  struct fb_area_s merged;
+  uint32_t growth;
+  uint32_t best;
+  int ibest;
+  int i;
+
+  /* Clip the area to the framebuffer */
+
+  rect.x = 0;
+  rect.y = 0;
+  rect.w = priv->xres;
+  rect.h = priv->yres;
+
+  if (area != NULL)
+    {
+      fb_coord_t x1 = area->x + area->w;
+      fb_coord_t y1 = area->y + area->h;
+
+      rect.x = area->x < 0 ? 0 : area->x;
+      rect.y = area->y < 0 ? 0 : area->y;
+      x1     = x1 > priv->xres ? priv->xres : x1;
+      y1     = y1 > priv->yres ? priv->yres : y1;
+
+      if (x1 <= rect.x || y1 <= rect.y)
+        {
+          return;
+        }
+
+      rect.w = x1 - rect.x;
+      rect.h = y1 - rect.y;
+    }
+
+  nxmutex_lock(&priv->lock);
+
+  i = 0;
+  while (i < priv->ndamage)
+    {
+      lcdfb_union(&merged, &priv->damage[i], &rect);
+      if (LCDFB_AREASIZE(&merged) > LCDFB_AREASIZE(&priv->damage[i]) +
+                                    LCDFB_AREASIZE(&rect))
+        {
+          i++;
+          continue;
+        }
+
+      /* Take the damaged area out of the list and start over, the union
+       * may now be worth merging with the areas already checked.
+       */
+
+      rect = merged;
+      priv->damage[i] = priv->damage[--priv->ndamage];
+      i = 0;
+    }
+
+  while (priv->ndamage >= CONFIG_LCD_FRAMEBUFFER_NDAMAGE)
+    {
+      best  = UINT32_MAX;
+      ibest = 0;
+
+      for (i = 0; i < priv->ndamage; i++)
+        {
+          lcdfb_union(&merged, &priv->damage[i], &rect);
+          growth = LCDFB_AREASIZE(&merged) -
+                   LCDFB_AREASIZE(&priv->damage[i]);
+          if (growth < best)
+            {
+              best  = growth;
+              ibest = i;
+            }
+        }
+
+      lcdfb_union(&rect, &priv->damage[ibest], &rect);
+      priv->damage[ibest] = priv->damage[--priv->ndamage];
+    }
+
+  priv->damage[priv->ndamage++] = rect;
+
+  if (work_available(&priv->work))
+    {
+      work_queue(LCDFB_WORK, &priv->work, lcdfb_flush, priv,
+                 MSEC2TICK(CONFIG_LCD_FRAMEBUFFER_DAMAGE_DELAY));
+    }
+
+  nxmutex_unlock(&priv->lock);
+}
+#endif /* CONFIG_LCD_FRAMEBUFFER_DAMAGE */
+
+/****************************************************************************
+ * Name: lcdfb_updateearea
+ *
+ * Description:
+ * Update the LCD when there is a change to the framebuffer.
+ *
+ ****************************************************************************/
+
+static int lcdfb_updateearea(FAR struct fb_vtable_s *vtable,
+                             FAR const struct fb_area_s *area)
+{
+  FAR struct lcdfb_dev_s *priv = (FAR struct lcdfb_dev_s *)vtable;
+
+#ifdef CONFIG_LCD_FRAMEBUFFER_DAMAGE
+  lcdfb_damage(priv, area);
+  return OK;
+#else
+  return lcdfb_putarea(priv, area);
+#endif
+}
+
 /****************************************************************************
  * Name: lcdfb_getvideoinfo
  ****************************************************************************/
@@ -705,6 +903,10 @@ int up_fbinitialize(int display)
       goto errout_with_lcd;
     }
 
+#ifdef CONFIG_LCD_FRAMEBUFFER_DAMAGE
+  nxmutex_init(&priv->lock);
+#endif
+
   /* Add the state structure to the list of framebuffer interfaces */
 
   priv->flink = g_lcdfb;
@@ -717,7 +919,7 @@ int up_fbinitialize(int display)
   area.w = priv->xres;
   area.h = priv->yres;
 
-  ret = lcdfb_updateearea(&priv->vtable, &area);
+  ret = lcdfb_putarea(priv, &area);
   if (ret < 0)
     {
       lcderr("FB update failed: %d\n", ret);
@@ -817,6 +1019,13 @@ void up_fbuninitialize(int display)
               g_lcdfb = priv->flink;
             }
 
+#ifdef CONFIG_LCD_FRAMEBUFFER_DAMAGE
+          /* Drop the damaged areas not written yet */
+
+          work_cancel_sync(LCDFB_WORK, &priv->work);
+          nxmutex_destroy(&priv->lock);
+#endif
+
 #ifndef CONFIG_LCD_EXTERNINIT
           /* Uninitialize the LCD */
 
@@ -124,7 +124,8 @@ static void lcddrv_spiif_deselect(FAR struct lcddrv_lcd_s *lcd)
  * Name: lcddrv_spiif_sendmulti
  *
  * Description:
- *   Send a number of pixel words to the lcd driver gram.
+ *   Send a number of pixel words to the lcd driver gram, as a block so that
+ *   the SPI driver may use DMA.
  *
  * Input Parameters:
  *   lcd    - Reference to the lcddrv_lcd_s driver structure
@@ -139,15 +140,10 @@ static void lcddrv_spiif_deselect(FAR struct lcddrv_lcd_s *lcd)
 static int lcddrv_spiif_sendmulti(FAR struct lcddrv_lcd_s *lcd,
                                   FAR const uint16_t *wd, uint32_t nwords)
 {
-  uint32_t t;
   FAR struct lcddrv_spiif_lcd_s *priv = (FAR struct lcddrv_spiif_lcd_s *)lcd;
 
   SPI_SETBITS(priv->spi, 16);
-  for (t = 0; t < nwords; t++)
-    {
-      SPI_SEND(priv->spi, *wd++);
-    }
-
+  SPI_SNDBLOCK(priv->spi, wd, nwords);
   SPI_SETBITS(priv->spi, 8);
 
   return OK;
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/param.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/ioctl.h>
@@ -43,8 +44,12 @@
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/fs/ioring.h>
 #include <nuttx/fs/loop.h>
 #include <nuttx/mutex.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -56,6 +61,22 @@
  * Private Types
  ****************************************************************************/
 
+#ifdef CONFIG_LOOP_ASYNC
+/* A chunk of a transfer executed by an I/O ring worker thread.  Each chunk
+ * has its own open file, so that the chunks do not share a file position.
+ */
+
+struct loop_struct_s;
+
+struct loop_chunk_s
+{
+  struct ioring_req_s       req;    /* The request (must be first) */
+  FAR struct loop_struct_s *dev;    /* The loop device */
+  struct file               file;   /* The file of the chunk */
+  ssize_t                   result; /* The result of the request */
+};
+#endif
+
 struct loop_struct_s
 {
   mutex_t      lock;         /* For safe read-modify-write operations */
@@ -65,6 +86,22 @@ struct loop_struct_s
   uint8_t      opencnt;      /* Count of open references to the loop device */
   bool         writeenabled; /* true: can write to device */
   struct file  devfile;      /* File struct of char device/file */
+#ifdef CONFIG_LOOP_PASSTHROUGH
+  bool         blkopened;    /* true: blkdriver was opened by losetup() */
+  uint16_t     blkratio;     /* Sectors of blkdriver per sector */
+  blkcnt_t     blkstart;     /* Sector of blkdriver of the first sector */
+
+  /* The block driver of the sectors, or the memory of the first sector */
+
+  FAR struct inode *blkdriver;
+  FAR const uint8_t *xipbase;
+#endif
+#ifdef CONFIG_LOOP_ASYNC
+  uint8_t      nchunks;      /* Number of chunks with an open file */
+  size_t       chunksize;    /* Size (in bytes) of a chunk */
+  sem_t        done;         /* Posted as each chunk completes */
+  struct loop_chunk_s chunks[CONFIG_LOOP_ASYNC_NREQS];
+#endif
 };
 
 /****************************************************************************
@@ -172,6 +209,196 @@ static int loop_close(FAR struct inode *inode)
   return ret;
 }
 
+#ifdef CONFIG_LOOP_ASYNC
+/****************************************************************************
+ * Name: loop_complete
+ *
+ * Description: Record the result of a chunk of an asynchronous transfer
+ *
+ ****************************************************************************/
+
+static void loop_complete(FAR struct ioring_req_s *req, ssize_t res)
+{
+  FAR struct loop_chunk_s *chunk = (FAR struct loop_chunk_s *)req;
+
+  chunk->result = res;
+  nxsem_post(&chunk->dev->done);
+}
+
+/****************************************************************************
+ * Name: loop_asyncio
+ *
+ * Description:
+ *   Split a transfer in chunks that the I/O ring worker threads execute
+ *   concurrently, each chunk with its own open file.  The data is
+ *   transferred up to the first chunk that failed or was short.
+ *
+ ****************************************************************************/
+
+static ssize_t loop_asyncio(FAR struct loop_struct_s *dev,
+                            FAR uint8_t *buffer, off_t offset,
+                            size_t nbytes, bool write)
+{
+  FAR struct loop_chunk_s *chunk;
+  FAR struct ioring_req_s *req;
+  dq_queue_t queue;
+  ssize_t ntotal = 0;
+  unsigned int nreqs;
+  unsigned int i;
+  size_t batch;
+  int prio;
+  int ret;
+
+  prio = nxsched_self()->sched_priority;
+
+  while (nbytes > 0)
+    {
+      dq_init(&queue);
+      nreqs = 0;
+      batch = 0;
+
+      while (nreqs < dev->nchunks && batch < nbytes)
+        {
+          chunk = &dev->chunks[nreqs++];
+          req   = &chunk->req;
+
+          req->ring           = NULL;
+          req->filep          = &chunk->file;
+          req->complete       = loop_complete;
+          req->pid            = nxsched_getpid();
+          req->prio           = prio;
+          req->sqe.opcode     = write ? IORING_OP_WRITE : IORING_OP_READ;
+          req->sqe.flags      = 0;
+          req->sqe.fd         = -1;
+          req->sqe.off        = offset + batch;
+          req->sqe.addr       = buffer + batch;
+          req->sqe.len        = MIN(dev->chunksize, nbytes - batch);
+          req->sqe.user_data  = chunk;
+          chunk->result       = 0;
+
+          dq_addlast(&req->node, &queue);
+          batch += req->sqe.len;
+        }
+
+      /* Nothing was queued if the worker threads could not start */
+
+      ret = ioring_queue(&queue, nreqs);
+      if (ret < 0)
+        {
+          return ntotal > 0 ? ntotal : ret;
+        }
+
+      for (i = 0; i < nreqs; i++)
+        {
+          nxsem_wait_uninterruptible(&dev->done);
+        }
+
+      for (i = 0; i < nreqs; i++)
+        {
+          chunk = &dev->chunks[i];
+          if (chunk->result < 0)
+            {
+              return ntotal > 0 ? ntotal : chunk->result;
+            }
+
+          ntotal += chunk->result;
+          if (chunk->result < chunk->req.sqe.len)
+            {
+              return ntotal;
+            }
+        }
+
+      buffer += batch;
+      offset += batch;
+      nbytes -= batch;
+    }
+
+  return ntotal;
+}
+#endif
+
+/****************************************************************************
+ * Name: loop_transfer
+ *
+ * Description:
+ *   Read or write the specified number of sectors:  Directly on the block
+ *   driver or in the memory that holds them if the passthrough was set up,
+ *   otherwise at their offset in the file.  The caller holds the lock.
+ *
+ ****************************************************************************/
+
+static ssize_t loop_transfer(FAR struct loop_struct_s *dev,
+                             FAR uint8_t *buffer, blkcnt_t start_sector,
+                             unsigned int nsectors, bool write)
+{
+  size_t nbytes = (size_t)nsectors * dev->sectsize;
+  off_t offset;
+  ssize_t ret;
+
+#ifdef CONFIG_LOOP_PASSTHROUGH
+  if (dev->xipbase != NULL)
+    {
+      if (write)
+        {
+          return -EACCES;
+        }
+
+      memcpy(buffer, dev->xipbase + start_sector * dev->sectsize, nbytes);
+      return nsectors;
+    }
+
+  if (dev->blkdriver != NULL)
+    {
+      FAR struct inode *inode = dev->blkdriver;
+      blkcnt_t sector = dev->blkstart + start_sector * dev->blkratio;
+
+      if (write)
+        {
+          ret = inode->u.i_bops->write(inode, buffer, sector,
+                                       nsectors * dev->blkratio);
+        }
+      else
+        {
+          ret = inode->u.i_bops->read(inode, buffer, sector,
+                                      nsectors * dev->blkratio);
+        }
+
+      return ret < 0 ? ret : ret / dev->blkratio;
+    }
+#endif
+
+  /* Calculate the offset of the sectors in the file */
+
+  offset = start_sector * dev->sectsize + dev->offset;
+
+#ifdef CONFIG_LOOP_ASYNC
+  if (dev->nchunks > 1 && nbytes > dev->chunksize)
+    {
+      ret = loop_asyncio(dev, buffer, offset, nbytes, write);
+      return ret < 0 ? ret : ret / dev->sectsize;
+    }
+#endif
+
+  /* Then transfer the requested number of sectors at that position */
+
+  do
+    {
+      if (write)
+        {
+          ret = file_pwrite(&dev->devfile, buffer, nbytes, offset);
+        }
+      else
+        {
+          ret = file_pread(&dev->devfile, buffer, nbytes, offset);
+        }
+    }
+  while (ret == -EINTR);
+
+  /* Return the number of sectors transferred */
+
+  return ret < 0 ? ret : ret / dev->sectsize;
+}
+
 /****************************************************************************
  * Name: loop_read
  *
@@ -183,9 +410,7 @@ static ssize_t loop_read(FAR struct inode *inode, FAR unsigned char *buffer,
                          blkcnt_t start_sector, unsigned int nsectors)
 {
   FAR struct loop_struct_s *dev;
-  ssize_t nbytesread;
-  off_t offset;
-  off_t ret;
+  ssize_t ret;
 
   DEBUGASSERT(inode->i_private);
   dev = inode->i_private;
@@ -196,33 +421,21 @@ static ssize_t loop_read(FAR struct inode *inode, FAR unsigned char *buffer,
       return -EIO;
     }
 
-  /* Calculate the offset to read the sectors and seek to the position */
-
-  offset = start_sector * dev->sectsize + dev->offset;
-  ret = file_seek(&dev->devfile, offset, SEEK_SET);
+  ret = nxmutex_lock(&dev->lock);
   if (ret < 0)
     {
-      ferr("ERROR: Seek failed for offset=%d: %d\n", (int)offset, (int)ret);
-      return -EIO;
+      return ret;
     }
 
-  /* Then read the requested number of sectors from that position */
+  ret = loop_transfer(dev, buffer, start_sector, nsectors, false);
+  nxmutex_unlock(&dev->lock);
 
-  do
+  if (ret < 0)
     {
-      nbytesread = file_read(&dev->devfile, buffer,
-                             nsectors * dev->sectsize);
-      if (nbytesread < 0 && nbytesread != -EINTR)
-        {
-          ferr("ERROR: Read failed: %zd\n", nbytesread);
-          return (int)nbytesread;
-        }
+      ferr("ERROR: Read failed: %zd\n", ret);
     }
-  while (nbytesread < 0);
-
-  /* Return the number of sectors read */
 
-  return nbytesread / dev->sectsize;
+  return ret;
 }
 
 /****************************************************************************
@@ -237,39 +450,33 @@ static ssize_t loop_write(FAR struct inode *inode,
                           blkcnt_t start_sector, unsigned int nsectors)
 {
   FAR struct loop_struct_s *dev;
-  ssize_t nbyteswritten;
-  off_t offset;
-  off_t ret;
+  ssize_t ret;
 
   DEBUGASSERT(inode->i_private);
   dev = inode->i_private;
 
-  /* Calculate the offset to write the sectors and seek to the position */
+  if (start_sector + nsectors > dev->nsectors)
+    {
+      ferr("ERROR: Write past end of file\n");
+      return -EIO;
+    }
 
-  offset = start_sector * dev->sectsize + dev->offset;
-  ret = file_seek(&dev->devfile, offset, SEEK_SET);
+  ret = nxmutex_lock(&dev->lock);
   if (ret < 0)
     {
-      ferr("ERROR: Seek failed for offset=%d: %d\n", (int)offset, (int)ret);
+      return ret;
     }
 
-  /* Then write the requested number of sectors to that position */
+  ret = loop_transfer(dev, (FAR uint8_t *)buffer, start_sector, nsectors,
+                      true);
+  nxmutex_unlock(&dev->lock);
 
-  do
+  if (ret < 0)
     {
-      nbyteswritten = file_write(&dev->devfile, buffer,
-                                 nsectors * dev->sectsize);
-      if (nbyteswritten < 0 && nbyteswritten != -EINTR)
-        {
-          ferr("ERROR: file_write failed: %zd\n", nbyteswritten);
-          return nbyteswritten;
-        }
+      ferr("ERROR: Write failed: %zd\n", ret);
     }
-  while (nbyteswritten < 0);
-
-  /* Return the number of sectors written */
 
-  return nbyteswritten / dev->sectsize;
+  return ret;
 }
 
 /****************************************************************************
@@ -301,6 +508,168 @@ static int loop_geometry(FAR struct inode *inode,
   return -EINVAL;
 }
 
+#ifdef CONFIG_LOOP_PASSTHROUGH
+/****************************************************************************
+ * Name: loop_passthrough
+ *
+ * Description:
+ *   Find where the sectors are when the file is a block device, a file of
+ *   an execute-in-place file system that cannot write, or a file in one
+ *   extent of the block driver of its volume:  They are then accessed
+ *   there directly, without the file system or the cache of the block to
+ *   character driver proxy.
+ *
+ ****************************************************************************/
+
+static void loop_passthrough(FAR struct loop_struct_s *dev,
+                             FAR const char *filename,
+                             FAR const struct stat *sb)
+{
+  FAR struct inode *inode = dev->devfile.f_inode;
+  struct geometry geo;
+  off_t devoffset;
+  int ret;
+
+  if (S_ISBLK(sb->st_mode))
+    {
+      ret = open_blockdriver(filename, dev->writeenabled ? 0 : MS_RDONLY,
+                             &inode);
+      if (ret < 0)
+        {
+          return;
+        }
+
+      dev->blkopened = true;
+      devoffset      = dev->offset;
+    }
+#ifndef CONFIG_DISABLE_MOUNTPOINT
+  else if (inode != NULL && INODE_IS_MOUNTPT(inode))
+    {
+      struct file_extent_s extent;
+      uintptr_t xipbase;
+
+      /* The data of such a file never moves while it is open */
+
+      if (!dev->writeenabled && inode->u.i_mops->write == NULL &&
+          file_ioctl(&dev->devfile, FIOC_XIPBASE,
+                     (unsigned long)((uintptr_t)&xipbase)) >= 0)
+        {
+          dev->xipbase = (FAR const uint8_t *)xipbase + dev->offset;
+          return;
+        }
+
+      extent.offset = dev->offset;
+      ret = file_ioctl(&dev->devfile, FIOC_EXTENT,
+                       (unsigned long)((uintptr_t)&extent));
+      if (ret < 0 || extent.blkdriver == NULL ||
+          extent.length < (off_t)dev->nsectors * dev->sectsize)
+        {
+          return;
+        }
+
+      inode     = extent.blkdriver;
+      devoffset = extent.devoffset;
+    }
+#endif
+  else
+    {
+      return;
+    }
+
+  /* The sectors must be whole sectors of the block driver */
+
+  if (inode->u.i_bops->read == NULL ||
+      (dev->writeenabled && inode->u.i_bops->write == NULL) ||
+      inode->u.i_bops->geometry == NULL ||
+      inode->u.i_bops->geometry(inode, &geo) < 0 ||
+      geo.geo_sectorsize == 0 || dev->sectsize % geo.geo_sectorsize != 0 ||
+      devoffset % geo.geo_sectorsize != 0)
+    {
+      if (dev->blkopened)
+        {
+          close_blockdriver(inode);
+          dev->blkopened = false;
+        }
+
+      return;
+    }
+
+  dev->blkdriver = inode;
+  dev->blkstart  = devoffset / geo.geo_sectorsize;
+  dev->blkratio  = dev->sectsize / geo.geo_sectorsize;
+}
+#endif
+
+#ifdef CONFIG_LOOP_ASYNC
+/****************************************************************************
+ * Name: loop_asyncsetup
+ *
+ * Description:
+ *   Open the file of each chunk of the asynchronous transfers.  The
+ *   transfers are synchronous if fewer than two files could be opened.
+ *
+ ****************************************************************************/
+
+static void loop_asyncsetup(FAR struct loop_struct_s *dev,
+                            FAR const char *filename, int oflags)
+{
+  int i;
+
+  nxsem_init(&dev->done, 0, 0);
+  dev->chunksize = MAX(CONFIG_LOOP_ASYNC_CHUNK / dev->sectsize, 1) *
+                   dev->sectsize;
+
+#ifdef CONFIG_LOOP_PASSTHROUGH
+  if (dev->blkdriver != NULL || dev->xipbase != NULL)
+    {
+      return;
+    }
+#endif
+
+  for (i = 0; i < CONFIG_LOOP_ASYNC_NREQS; i++)
+    {
+      dev->chunks[i].dev = dev;
+      if (file_open(&dev->chunks[i].file, filename, oflags) < 0)
+        {
+          break;
+        }
+
+      dev->nchunks++;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: loop_release
+ *
+ * Description: Close the files and the block driver of the device
+ *
+ ****************************************************************************/
+
+static void loop_release(FAR struct loop_struct_s *dev)
+{
+#ifdef CONFIG_LOOP_ASYNC
+  while (dev->nchunks > 0)
+    {
+      file_close(&dev->chunks[--dev->nchunks].file);
+    }
+
+  nxsem_destroy(&dev->done);
+#endif
+
+#ifdef CONFIG_LOOP_PASSTHROUGH
+  if (dev->blkopened)
+    {
+      close_blockdriver(dev->blkdriver);
+    }
+#endif
+
+  if (dev->devfile.f_inode != NULL)
+    {
+      file_close(&dev->devfile);
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -319,6 +688,7 @@ int losetup(FAR const char *devname, FAR const char *filename,
 {
   FAR struct loop_struct_s *dev;
   struct stat sb;
+  int oflags;
   int ret;
 
   /* Sanity check */
@@ -372,7 +742,8 @@ int losetup(FAR const char *devname, FAR const char *filename,
   ret = -ENOSYS;
   if (!readonly)
     {
-      ret = file_open(&dev->devfile, filename, O_RDWR | O_CLOEXEC);
+      oflags = O_RDWR | O_CLOEXEC;
+      ret = file_open(&dev->devfile, filename, oflags);
     }
 
   if (ret >= 0)
@@ -383,7 +754,8 @@ int losetup(FAR const char *devname, FAR const char *filename,
     {
       /* If that fails, then try to open the device read-only */
 
-      ret = file_open(&dev->devfile, filename, O_RDONLY | O_CLOEXEC);
+      oflags = O_RDONLY | O_CLOEXEC;
+      ret = file_open(&dev->devfile, filename, oflags);
       if (ret < 0)
         {
           ferr("ERROR: Failed to open %s: %d\n", filename, ret);
@@ -391,6 +763,14 @@ int losetup(FAR const char *devname, FAR const char *filename,
         }
     }
 
+#ifdef CONFIG_LOOP_PASSTHROUGH
+  loop_passthrough(dev, filename, &sb);
+#endif
+
+#ifdef CONFIG_LOOP_ASYNC
+  loop_asyncsetup(dev, filename, oflags);
+#endif
+
   /* Inode private data will be reference to the loop device structure */
 
   ret = register_blockdriver(devname, &g_bops, 0, dev);
@@ -403,7 +783,7 @@ int losetup(FAR const char *devname, FAR const char *filename,
   return OK;
 
 errout_with_file:
-  file_close(&dev->devfile);
+  loop_release(dev);
 
 errout_with_dev:
   nxmutex_destroy(&dev->lock);
@@ -465,11 +845,7 @@ int loteardown(FAR const char *devname)
 
   /* Release the device structure */
 
-  if (dev->devfile.f_inode != NULL)
-    {
-      file_close(&dev->devfile);
-    }
-
+  loop_release(dev);
   nxmutex_destroy(&dev->lock);
   kmm_free(dev);
   return ret;
@@ -100,8 +100,6 @@ static int     rpmsgblk_send_recv(FAR struct rpmsgblk_s *priv,
                                   uint32_t command, bool copy,
                                   FAR struct rpmsgblk_header_s *msg,
                                   int len, FAR void *data);
-static FAR void *rpmsgblk_get_tx_payload_buffer(FAR struct rpmsgblk_s *priv,
-                                                FAR uint32_t *len);
 
 /* Functions handle the responses from the remote cpu */
 
@@ -111,6 +109,9 @@ static int     rpmsgblk_default_handler(FAR struct rpmsg_endpoint *ept,
 static int     rpmsgblk_read_handler(FAR struct rpmsg_endpoint *ept,
                                      FAR void *data, size_t len,
                                      uint32_t src, FAR void *priv);
+static int     rpmsgblk_write_handler(FAR struct rpmsg_endpoint *ept,
+                                      FAR void *data, size_t len,
+                                      uint32_t src, FAR void *priv);
 static int     rpmsgblk_geometry_handler(FAR struct rpmsg_endpoint *ept,
                                          FAR void *data, size_t len,
                                          uint32_t src, FAR void *priv);
@@ -140,7 +141,7 @@ static const rpmsg_ept_cb g_rpmsgblk_handler[] =
   [RPMSGBLK_OPEN]     = rpmsgblk_default_handler,
   [RPMSGBLK_CLOSE]    = rpmsgblk_default_handler,
   [RPMSGBLK_READ]     = rpmsgblk_read_handler,
-  [RPMSGBLK_WRITE]    = rpmsgblk_default_handler,
+  [RPMSGBLK_WRITE]    = rpmsgblk_write_handler,
   [RPMSGBLK_GEOMETRY] = rpmsgblk_geometry_handler,
   [RPMSGBLK_IOCTL]    = rpmsgblk_ioctl_handler,
 };
@@ -328,10 +329,12 @@ static ssize_t rpmsgblk_write(FAR struct inode *inode,
   FAR struct rpmsgblk_s *priv = inode->i_private;
   FAR struct rpmsgblk_write_s *msg;
   struct rpmsgblk_cookie_s cookie;
+  unsigned int nfrags = 0;
   uint32_t sectorsize;
   uint32_t space;
   size_t written = 0;
   int ret;
+  int err;
 
   if (buffer == NULL)
     {
@@ -349,7 +352,11 @@ static ssize_t rpmsgblk_write(FAR struct inode *inode,
       return ret;
     }
 
-  /* Perform the rpmsg write */
+  /* Perform the rpmsg write:  The sectors are sent in as many messages as
+   * needed without waiting in between, each message is acknowledged with
+   * the number of sectors written so that the failure of any of them is
+   * reported.
+   */
 
   memset(&cookie, 0, sizeof(cookie));
   nxsem_init(&cookie.sem, 0, 0);
@@ -357,30 +364,22 @@ static ssize_t rpmsgblk_write(FAR struct inode *inode,
   sectorsize = priv->geo.geo_sectorsize;
   while (written < nsectors)
     {
-      msg = rpmsgblk_get_tx_payload_buffer(priv, &space);
+      msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
       if (msg == NULL)
         {
           ret = -ENOMEM;
-          goto out;
+          break;
         }
 
       DEBUGASSERT(sizeof(*msg) - 1 + sectorsize <= space);
 
       msg->nsectors = (space - sizeof(*msg) + 1) / sectorsize;
-      if (msg->nsectors >= nsectors - written)
+      if (msg->nsectors > nsectors - written)
         {
-          /* Send complete, set cookie is valid, need ack */
-
           msg->nsectors = nsectors - written;
-          msg->header.cookie = (uintptr_t)&cookie;
-        }
-      else
-        {
-          /* Not send complete, set cookie invalid, do not need ack */
-
-          msg->header.cookie = 0;
         }
 
+      msg->header.cookie  = (uintptr_t)&cookie;
       msg->header.command = RPMSGBLK_WRITE;
       msg->header.result  = -ENXIO;
       msg->startsector    = start_sector;
@@ -391,26 +390,38 @@ static ssize_t rpmsgblk_write(FAR struct inode *inode,
       start_sector += msg->nsectors;
       written      += msg->nsectors;
 
-      ret = rpmsg_send_nocopy(&priv->ept, msg,
-                              sizeof(*msg) - 1 + msg->nsectors * sectorsize);
+      ret = rpmsg_commit(&priv->ept, msg,
+                         sizeof(*msg) - 1 + msg->nsectors * sectorsize);
       if (ret < 0)
         {
-          rpmsg_release_tx_buffer(&priv->ept, msg);
-          goto out;
+          break;
         }
+
+      nfrags++;
     }
 
-  ret = rpmsg_wait(&priv->ept, &cookie.sem);
-  if (ret < 0)
+  /* Wait for the acknowledgement of all the messages sent, the cookie must
+   * not go away before.
+   */
+
+  while (nfrags-- > 0)
     {
-      goto out;
+      err = rpmsg_wait(&priv->ept, &cookie.sem);
+      if (err < 0)
+        {
+          ret = err;
+          goto out;
+        }
     }
 
-  ret = cookie.result;
+  if (ret >= 0)
+    {
+      ret = cookie.result;
+    }
 
 out:
   nxsem_destroy(&cookie.sem);
-  return ret < 0 ? ret : nsectors;
+  return ret;
 }
 
 /****************************************************************************
@@ -547,7 +558,7 @@ static int rpmsgblk_mmc_cmd_ioctl(FAR struct inode *inode, unsigned long arg)
     }
 
   msglen = sizeof(*msg) + arglen - 1;
-  msg = rpmsgblk_get_tx_payload_buffer(priv, &space);
+  msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
   if (msg == NULL)
     {
       return -ENOMEM;
@@ -575,7 +586,7 @@ static int rpmsgblk_mmc_cmd_ioctl(FAR struct inode *inode, unsigned long arg)
  *
  * Description:
  *   The size of MMC_IOC_MILTI_CMD's memory occupation is likely to be
- *   larger than that allocated by rpmsgblk_get_tx_payload_buffer, which
+ *   larger than that allocated by rpmsg_reserve(), which
  *   is not allowed by current implement. So split the mmc_ioc_multi_cmd
  *   into mmc_ioc_cmds to transfer.
  *
@@ -636,7 +647,7 @@ static int rpmsgblk_mmc_multi_cmd_ioctl(FAR struct inode *inode,
                    mioc->num_of_cmds * sizeof(struct mmc_ioc_cmd);
       uint32_t space;
 
-      msg = rpmsgblk_get_tx_payload_buffer(priv, &space);
+      msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
       if (msg == NULL)
         {
           return -ENOMEM;
@@ -688,7 +699,7 @@ static int rpmsgblk_default_ioctl(FAR struct inode *inode, int cmd,
 
   msglen = sizeof(*msg) + arglen - 1;
 
-  msg = rpmsgblk_get_tx_payload_buffer(priv, &space);
+  msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
   if (msg == NULL)
     {
       return -ENOMEM;
@@ -769,38 +780,6 @@ static int rpmsgblk_unlink(FAR struct inode *inode)
 }
 #endif
 
-/****************************************************************************
- * Name: rpmsgblk_get_tx_payload_buffer
- *
- * Description:
- *   Get the rpmsg blk tx payload, the buffer is from the rpmsg share memory
- *   that can be accessed by local and remote cpu.
- *
- * Parameters:
- *   priv  - The rpmsg-blk handle
- *   len   - The got memroy size
- *
- * Returned Values:
- *   NULL     - failure
- *   not NULL - success
- *
- ****************************************************************************/
-
-static FAR void *rpmsgblk_get_tx_payload_buffer(FAR struct rpmsgblk_s *priv,
-                                                FAR uint32_t *len)
-{
-  int sval;
-
-  nxsem_get_value(&priv->wait, &sval);
-  if (sval <= 0)
-    {
-      rpmsg_wait(&priv->ept, &priv->wait);
-      rpmsg_post(&priv->ept, &priv->wait);
-    }
-
-  return rpmsg_get_tx_payload_buffer(&priv->ept, len, true);
-}
-
 /****************************************************************************
  * Name: rpmsgblk_send_recv
  *
@@ -814,8 +793,7 @@ static FAR void *rpmsgblk_get_tx_payload_buffer(FAR struct rpmsgblk_s *priv,
  *   copy    - true, send a message across to the remote processor, and the
  *                   tx buffer will be alloced inside function rpmsg_send()
  *             false, send a message in tx buffer reserved by
- *                    rpmsg_get_tx_payload_buffer() across to the remote
- *                    processor.
+ *                    rpmsg_reserve() across to the remote processor.
  *   msg     - the message header
  *   len     - length of the payload
  *   data    - the data
@@ -855,16 +833,11 @@ static int rpmsgblk_send_recv(FAR struct rpmsgblk_s *priv,
     }
   else
     {
-      ret = rpmsg_send_nocopy(&priv->ept, msg, len);
+      ret = rpmsg_commit(&priv->ept, msg, len);
     }
 
   if (ret < 0)
     {
-      if (copy == false)
-        {
-          rpmsg_release_tx_buffer(&priv->ept, msg);
-        }
-
       goto fail;
     }
 
@@ -963,6 +936,43 @@ static int rpmsgblk_read_handler(FAR struct rpmsg_endpoint *ept,
   return 0;
 }
 
+/****************************************************************************
+ * Name: rpmsgblk_write_handler
+ *
+ * Description:
+ *   Rpmsg-blk block write response handler, this function will be called
+ *   to process the acknowledgement of each message of rpmsgblk_write().
+ *   The result is the total number of sectors written, or the first error.
+ *
+ * Parameters:
+ *   ept  - The rpmsg endpoint
+ *   data - The return message
+ *   len  - The return message length
+ *   src  - unknow
+ *   priv - unknow
+ *
+ * Returned Values:
+ *   Always OK
+ *
+ ****************************************************************************/
+
+static int rpmsgblk_write_handler(FAR struct rpmsg_endpoint *ept,
+                                  FAR void *data, size_t len,
+                                  uint32_t src, FAR void *priv)
+{
+  FAR struct rpmsgblk_header_s *header = data;
+  FAR struct rpmsgblk_cookie_s *cookie =
+      (FAR struct rpmsgblk_cookie_s *)(uintptr_t)header->cookie;
+
+  if (cookie->result >= 0)
+    {
+      cookie->result = header->result < 0 ? header->result :
+                       cookie->result + header->result;
+    }
+
+  return rpmsg_post(ept, &cookie->sem);
+}
+
 /****************************************************************************
  * Name: rpmsgblk_geometry_handler
  *
@@ -202,7 +202,7 @@ static int rpmsgblk_read_handler(FAR struct rpmsg_endpoint *ept,
 
   while (read < msg->nsectors)
     {
-      rsp = rpmsg_get_tx_payload_buffer(ept, &space, true);
+      rsp = rpmsg_reserve(ept, NULL, &space);
       if (rsp == NULL)
         {
           ferr("get tx payload failed or no enough space\n");
@@ -221,13 +221,10 @@ static int rpmsgblk_read_handler(FAR struct rpmsg_endpoint *ept,
 
       ret = server->bops->read(server->blknode,
                                (FAR unsigned char *)rsp->buf,
-                               msg->startsector, nsectors);
+                               msg->startsector + read, nsectors);
       rsp->header.result = ret;
-      if (rpmsg_send_nocopy(ept, rsp, (ret < 0 ? 0 : ret * msg->sectorsize) +
-                                      sizeof(*rsp) - 1) < 0)
-        {
-          rpmsg_release_tx_buffer(ept, rsp);
-        }
+      rpmsg_commit(ept, rsp, (ret < 0 ? 0 : ret * msg->sectorsize) +
+                             sizeof(*rsp) - 1);
 
       if (ret <= 0)
         {
@@ -330,7 +327,6 @@ static int rpmsgblk_mmc_cmd_handler(FAR struct rpmsg_endpoint *ept,
   size_t rsplen;
   size_t arglen;
   uint32_t space;
-  int ret;
 
   arglen = sizeof(struct mmc_ioc_cmd);
   if (!ioc->write_flag)
@@ -339,7 +335,7 @@ static int rpmsgblk_mmc_cmd_handler(FAR struct rpmsg_endpoint *ept,
     }
 
   rsplen = sizeof(*rsp) + arglen - 1;
-  rsp = rpmsg_get_tx_payload_buffer(ept, &space, true);
+  rsp = rpmsg_reserve(ept, NULL, &space);
   if (msg == NULL)
     {
       return -ENOMEM;
@@ -362,13 +358,7 @@ static int rpmsgblk_mmc_cmd_handler(FAR struct rpmsg_endpoint *ept,
 
   rsp->header.result = server->bops->ioctl(server->blknode, rsp->request,
                                            (unsigned long)rsp->buf);
-  ret = rpmsg_send_nocopy(ept, rsp, rsplen);
-  if (ret < 0)
-    {
-      rpmsg_release_tx_buffer(ept, rsp);
-    }
-
-  return ret;
+  return rpmsg_commit(ept, rsp, rsplen);
 }
 
 /****************************************************************************
@@ -389,7 +379,6 @@ static int rpmsgblk_mmc_multi_cmd_handler(FAR struct rpmsg_endpoint *ept,
   size_t rsp_off;
   uint32_t space;
   uint64_t i;
-  int ret;
 
   arglen = sizeof(struct mmc_ioc_multi_cmd) +
            mioc->num_of_cmds * sizeof(struct mmc_ioc_cmd);
@@ -402,7 +391,7 @@ static int rpmsgblk_mmc_multi_cmd_handler(FAR struct rpmsg_endpoint *ept,
     }
 
   rsplen = sizeof(*rsp) + arglen - 1;
-  rsp = rpmsg_get_tx_payload_buffer(ept, &space, true);
+  rsp = rpmsg_reserve(ept, NULL, &space);
   if (msg == NULL)
     {
       return -ENOMEM;
@@ -437,13 +426,7 @@ static int rpmsgblk_mmc_multi_cmd_handler(FAR struct rpmsg_endpoint *ept,
 
   rsp->header.result = server->bops->ioctl(server->blknode, rsp->request,
                                            (unsigned long)rsp->buf);
-  ret = rpmsg_send_nocopy(ept, rsp, rsplen);
-  if (ret < 0)
-    {
-      rpmsg_release_tx_buffer(ept, rsp);
-    }
-
-  return ret;
+  return rpmsg_commit(ept, rsp, rsplen);
 }
 
 /****************************************************************************
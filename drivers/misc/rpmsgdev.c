@@ -113,8 +113,6 @@ static int     rpmsgdev_send_recv(FAR struct rpmsgdev_s *priv,
                                   uint32_t command, bool copy,
                                   FAR struct rpmsgdev_header_s *msg,
                                   int len, FAR void *data);
-static FAR void *rpmsgdev_get_tx_payload_buffer(FAR struct rpmsgdev_s *priv,
-                                                FAR uint32_t *len);
 
 /* Functions handle the responses from the remote cpu */
 
@@ -483,7 +481,7 @@ static ssize_t rpmsgdev_write(FAR struct file *filep, const char *buffer,
 
   while (written < buflen)
     {
-      msg = rpmsgdev_get_tx_payload_buffer(dev, &space);
+      msg = rpmsg_reserve(&dev->ept, &dev->wait, &space);
       if (msg == NULL)
         {
           ret = -ENOMEM;
@@ -667,7 +665,7 @@ static int rpmsgdev_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
   msglen = sizeof(*msg) + arglen - 1;
 
-  msg = rpmsgdev_get_tx_payload_buffer(dev, &space);
+  msg = rpmsg_reserve(&dev->ept, &dev->wait, &space);
   if (msg == NULL)
     {
       return -ENOMEM;
@@ -734,38 +732,6 @@ static int rpmsgdev_poll(FAR struct file *filep, FAR struct pollfd *fds,
                             sizeof(msg), NULL);
 }
 
-/****************************************************************************
- * Name: rpmsgdev_get_tx_payload_buffer
- *
- * Description:
- *   Get the rpmsg device tx payload, the buffer is from the rpmsg
- *   share memory that can be accessed by local and remote cpu.
- *
- * Parameters:
- *   priv  - The rpmsg-device handle
- *   len   - The got memroy size
- *
- * Returned Values:
- *   NULL     - failure
- *   not NULL - success
- *
- ****************************************************************************/
-
-static FAR void *rpmsgdev_get_tx_payload_buffer(FAR struct rpmsgdev_s *priv,
-                                                FAR uint32_t *len)
-{
-  int sval;
-
-  nxsem_get_value(&priv->wait, &sval);
-  if (sval <= 0)
-    {
-      rpmsg_wait(&priv->ept, &priv->wait);
-      rpmsg_post(&priv->ept, &priv->wait);
-    }
-
-  return rpmsg_get_tx_payload_buffer(&priv->ept, len, true);
-}
-
 /****************************************************************************
  * Name: rpmsgdev_send_recv
  *
@@ -779,8 +745,7 @@ static FAR void *rpmsgdev_get_tx_payload_buffer(FAR struct rpmsgdev_s *priv,
  *   copy    - true, send a message across to the remote processor, and the
  *                   tx buffer will be alloced inside function rpmsg_send()
  *             false, send a message in tx buffer reserved by
- *                    rpmsg_get_tx_payload_buffer() across to the remote
- *                    processor.
+ *                    rpmsg_reserve() across to the remote processor.
  *   msg     - the message header
  *   len     - length of the payload
  *   data    - the data
@@ -820,16 +785,11 @@ static int rpmsgdev_send_recv(FAR struct rpmsgdev_s *priv,
     }
   else
     {
-      ret = rpmsg_send_nocopy(&priv->ept, msg, len);
+      ret = rpmsg_commit(&priv->ept, msg, len);
     }
 
   if (ret < 0)
     {
-      if (copy == false)
-        {
-          rpmsg_release_tx_buffer(&priv->ept, msg);
-        }
-
       goto fail;
     }
 
@@ -218,7 +218,7 @@ static int rpmsgdev_read_handler(FAR struct rpmsg_endpoint *ept,
 
   while (read < msg->count)
     {
-      rsp = rpmsg_get_tx_payload_buffer(ept, &space, true);
+      rsp = rpmsg_reserve(ept, NULL, &space);
       if (rsp == NULL)
         {
           return -ENOMEM;
@@ -235,7 +235,7 @@ static int rpmsgdev_read_handler(FAR struct rpmsg_endpoint *ept,
       ret = file_read(filep, rsp->buf, space);
 
       rsp->header.result = ret;
-      rpmsg_send_nocopy(ept, rsp, (ret < 0 ? 0 : ret) + sizeof(*rsp) - 1);
+      rpmsg_commit(ept, rsp, (ret < 0 ? 0 : ret) + sizeof(*rsp) - 1);
       if (ret <= 0 || msg->header.command == RPMSGDEV_READ_NOFRAG)
         {
           break;
@@ -35,6 +35,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/wqueue.h>
@@ -110,6 +111,36 @@ static inline bool rwb_overlap(off_t blockstart1, size_t nblocks1,
     }
 }
 
+/****************************************************************************
+ * Name: rwb_copyblocks
+ *
+ * Description:
+ *   Copy the blocks of the 'srcn' blocks at 'srcstart' in 'src' that are
+ *   also among the 'destn' blocks at 'deststart' in 'dest'.
+ *
+ ****************************************************************************/
+
+static void rwb_copyblocks(FAR struct rwbuffer_s *rwb,
+                           FAR uint8_t *dest, off_t deststart, size_t destn,
+                           FAR const uint8_t *src, off_t srcstart,
+                           size_t srcn)
+{
+  off_t start = deststart > srcstart ? deststart : srcstart;
+  off_t end   = deststart + (off_t)destn;
+
+  if (end > srcstart + (off_t)srcn)
+    {
+      end = srcstart + (off_t)srcn;
+    }
+
+  if (start < end)
+    {
+      memcpy(dest + (start - deststart) * rwb->blocksize,
+             src + (start - srcstart) * rwb->blocksize,
+             (end - start) * rwb->blocksize);
+    }
+}
+
 /****************************************************************************
  * Name: rwb_resetwrbuffer
  ****************************************************************************/
@@ -117,10 +148,82 @@ static inline bool rwb_overlap(off_t blockstart1, size_t nblocks1,
 #ifdef CONFIG_DRVR_WRITEBUFFER
 static inline void rwb_resetwrbuffer(FAR struct rwbuffer_s *rwb)
 {
+  int i;
+
   /* We assume that the caller holds the wrlock */
 
-  rwb->wrnblocks    = 0;
-  rwb->wrblockstart = -1;
+  for (i = 0; i < CONFIG_DRVR_NSTREAMS; i++)
+    {
+      rwb->wrstream[i].nblocks    = 0;
+      rwb->wrstream[i].blockstart = -1;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wroverlay
+ *
+ * Description:
+ *   Copy the blocks held by the write buffers other than 'except' over the
+ *   'nblocks' blocks at 'startblock' read in 'buffer'.
+ *
+ * Assumptions:
+ *   The caller holds the wrlock mutex.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static void rwb_wroverlay(FAR struct rwbuffer_s *rwb,
+                          FAR struct rwb_wrstream_s *except,
+                          off_t startblock, size_t nblocks,
+                          FAR uint8_t *buffer)
+{
+  FAR struct rwb_wrstream_s *stream;
+  int i;
+
+  for (i = 0; i < CONFIG_DRVR_NSTREAMS; i++)
+    {
+      stream = &rwb->wrstream[i];
+      if (stream != except && stream->nblocks > 0)
+        {
+          rwb_copyblocks(rwb, buffer, startblock, nblocks, stream->buffer,
+                         stream->blockstart, stream->nblocks);
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wrupdate
+ *
+ * Description:
+ *   Update the copies of the blocks written that the write buffers other
+ *   than 'except' hold:  All the copies of a block stay identical, so the
+ *   order in which the buffers are flushed does not matter.
+ *
+ * Assumptions:
+ *   The caller holds the wrlock mutex.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static void rwb_wrupdate(FAR struct rwbuffer_s *rwb,
+                         FAR struct rwb_wrstream_s *except,
+                         off_t startblock, size_t nblocks,
+                         FAR const uint8_t *wrbuffer)
+{
+  FAR struct rwb_wrstream_s *stream;
+  int i;
+
+  for (i = 0; i < CONFIG_DRVR_NSTREAMS; i++)
+    {
+      stream = &rwb->wrstream[i];
+      if (stream != except && stream->nblocks > 0)
+        {
+          rwb_copyblocks(rwb, stream->buffer, stream->blockstart,
+                         stream->nblocks, wrbuffer, startblock, nblocks);
+        }
+    }
 }
 #endif
 
@@ -133,26 +236,27 @@ static inline void rwb_resetwrbuffer(FAR struct rwbuffer_s *rwb)
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-static void rwb_wrflush(FAR struct rwbuffer_s *rwb)
+static void rwb_wrflush(FAR struct rwbuffer_s *rwb,
+                        FAR struct rwb_wrstream_s *stream)
 {
   int ret;
 
-  if (rwb->wrnblocks > 0)
+  if (stream->nblocks > 0)
     {
       size_t padblocks;
 
-      DEBUGASSERT(rwb->wrblockstart % rwb->wralignblocks == 0);
+      DEBUGASSERT(stream->blockstart % rwb->wralignblocks == 0);
 
       finfo("Flushing: blockstart=0x%08lx nblocks=%d from buffer=%p\n",
-            (long)rwb->wrblockstart, rwb->wrnblocks, rwb->wrbuffer);
+            (long)stream->blockstart, stream->nblocks, stream->buffer);
 
-      padblocks = rwb->wrnblocks % rwb->wralignblocks;
+      padblocks = stream->nblocks % rwb->wralignblocks;
       if (padblocks)
         {
           padblocks = rwb->wralignblocks - padblocks;
-          rwb_read_(rwb, rwb->wrblockstart + rwb->wrnblocks, padblocks,
-                    &rwb->wrbuffer[rwb->wrnblocks * rwb->blocksize]);
-          rwb->wrnblocks += padblocks;
+          rwb_read_(rwb, stream->blockstart + stream->nblocks, padblocks,
+                    &stream->buffer[stream->nblocks * rwb->blocksize]);
+          stream->nblocks += padblocks;
         }
 
       /* Flush cache.  On success, the flush method will return the number
@@ -160,14 +264,35 @@ static void rwb_wrflush(FAR struct rwbuffer_s *rwb)
        * an error.
        */
 
-      ret = rwb->wrflush(rwb->dev, rwb->wrbuffer, rwb->wrblockstart,
-                         rwb->wrnblocks);
-      if (ret != rwb->wrnblocks)
+      ret = rwb->wrflush(rwb->dev, stream->buffer, stream->blockstart,
+                         stream->nblocks);
+      if (ret != stream->nblocks)
         {
           ferr("ERROR: Error flushing write buffer: %d\n", ret);
         }
 
-      rwb_resetwrbuffer(rwb);
+      stream->nblocks    = 0;
+      stream->blockstart = -1;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wrflushall
+ *
+ * Assumptions:
+ *   The caller holds the wrlock mutex.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static void rwb_wrflushall(FAR struct rwbuffer_s *rwb)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_DRVR_NSTREAMS; i++)
+    {
+      rwb_wrflush(rwb, &rwb->wrstream[i]);
     }
 }
 #endif
@@ -182,17 +307,54 @@ static void rwb_wrtimeout(FAR void *arg)
   /* The following assumes that the size of a pointer is 4-bytes or less */
 
   FAR struct rwbuffer_s *rwb = (FAR struct rwbuffer_s *)arg;
+  FAR struct rwb_wrstream_s *stream;
+  clock_t delay = MSEC2TICK(CONFIG_DRVR_WRDELAY);
+  clock_t next = delay;
+  clock_t elapsed;
+  bool pending = false;
+  int i;
+
   DEBUGASSERT(rwb != NULL);
 
   finfo("Timeout!\n");
 
-  /* If a timeout elapses with write buffer activity, this watchdog
-   * handler function will be evoked on the thread of execution of the
-   * worker thread.
+  /* If a timeout elapses with write buffer activity, this work function
+   * will be evoked on the thread of execution of the worker thread.  The
+   * buffers without writes during the delay are flushed, the others are
+   * checked again when their delay elapses.
    */
 
   rwb_lock(&rwb->wrlock);
-  rwb_wrflush(rwb);
+
+  for (i = 0; i < CONFIG_DRVR_NSTREAMS; i++)
+    {
+      stream = &rwb->wrstream[i];
+      if (stream->nblocks == 0)
+        {
+          continue;
+        }
+
+      elapsed = clock_systime_ticks() - stream->stamp;
+      if (elapsed >= delay)
+        {
+          rwb_wrflush(rwb, stream);
+        }
+      else
+        {
+          if (delay - elapsed < next)
+            {
+              next = delay - elapsed;
+            }
+
+          pending = true;
+        }
+    }
+
+  if (pending)
+    {
+      work_queue(LPWORK, &rwb->work, rwb_wrtimeout, rwb, next);
+    }
+
   rwb_unlock(&rwb->wrlock);
 }
 #endif
@@ -206,11 +368,16 @@ static void rwb_wrstarttimeout(FAR struct rwbuffer_s *rwb)
 {
 #if CONFIG_DRVR_WRDELAY != 0
   /* CONFIG_DRVR_WRDELAY provides the delay period in milliseconds. CLK_TCK
-   * provides the clock tick of the system (frequency in Hz).
+   * provides the clock tick of the system (frequency in Hz).  A pending
+   * timeout is kept, it then checks the time of the last write of each
+   * buffer.
    */
 
-  int ticks = MSEC2TICK(CONFIG_DRVR_WRDELAY);
-  work_queue(LPWORK, &rwb->work, rwb_wrtimeout, rwb, ticks);
+  if (work_available(&rwb->work))
+    {
+      int ticks = MSEC2TICK(CONFIG_DRVR_WRDELAY);
+      work_queue(LPWORK, &rwb->work, rwb_wrtimeout, rwb, ticks);
+    }
 #endif
 }
 #endif
@@ -229,157 +396,166 @@ static inline void rwb_wrcanceltimeout(FAR struct rwbuffer_s *rwb)
 #endif
 
 /****************************************************************************
- * Name: rwb_writebuffer
+ * Name: rwb_wrfind
+ *
+ * Description:
+ *   Find the write buffer that holds 'startblock', or whose blocks it
+ *   directly follows, if it has room for it.
+ *
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
-                               off_t startblock, uint32_t nblocks,
-                               FAR const uint8_t *wrbuffer)
+static FAR struct rwb_wrstream_s *rwb_wrfind(FAR struct rwbuffer_s *rwb,
+                                             off_t startblock)
 {
-  uint32_t nwritten = nblocks;
+  FAR struct rwb_wrstream_s *stream;
+  int i;
 
-  /* Write writebuffer Logic */
-
-  rwb_wrcanceltimeout(rwb);
-
-  /* Is data saved in the write buffer? */
-
-  if (rwb->wrnblocks > 0)
+  for (i = 0; i < CONFIG_DRVR_NSTREAMS; i++)
     {
-      off_t wrbend;
-      off_t newend;
-
-      /* Now there are five cases:
-       *
-       * 1. We update the non-overlapping region
-       */
-
-      wrbend = rwb->wrblockstart + rwb->wrnblocks;
-      newend = startblock + nblocks;
-
-      if (wrbend < startblock || rwb->wrblockstart > newend)
+      stream = &rwb->wrstream[i];
+      if (stream->nblocks > 0 && startblock >= stream->blockstart &&
+          startblock <= stream->blockstart + stream->nblocks &&
+          startblock <  stream->blockstart + rwb->wrmaxblocks)
         {
-          /* Nothing to do */;
+          return stream;
         }
+    }
 
-      /* 2. We update the entire write buffer. */
+  return NULL;
+}
+#endif
 
-      else if (rwb->wrblockstart > startblock && wrbend < newend)
-        {
-          rwb->wrnblocks = 0;
-        }
+/****************************************************************************
+ * Name: rwb_wralloc
+ *
+ * Description:
+ *   Start a new stream of writes at 'startblock' in an empty write buffer,
+ *   or else in the buffer written the longest time ago, which is flushed.
+ *   The buffer starts at a multiple of wralignblocks, the blocks before
+ *   'startblock' are read.
+ *
+ ****************************************************************************/
 
-      /* We are going to update a subset of the write buffer.  Three
-       * more cases to consider:
-       *
-       * 3. We update a portion in the middle of the write buffer
-       */
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static FAR struct rwb_wrstream_s *rwb_wralloc(FAR struct rwbuffer_s *rwb,
+                                              off_t startblock)
+{
+  FAR struct rwb_wrstream_s *stream = NULL;
+  clock_t now = clock_systime_ticks();
+  size_t padblocks;
+  int i;
 
-      else if (rwb->wrblockstart <= startblock && wrbend >= newend)
+  for (i = 0; i < CONFIG_DRVR_NSTREAMS; i++)
+    {
+      if (rwb->wrstream[i].nblocks == 0)
         {
-          FAR uint8_t *dest;
-          size_t offset;
-
-          /* Copy the data to the middle of write buffer */
-
-          offset = startblock - rwb->wrblockstart;
-          dest   = rwb->wrbuffer + offset * rwb->blocksize;
-          memcpy(dest, wrbuffer, nblocks * rwb->blocksize);
-
-          nblocks = 0;
+          stream = &rwb->wrstream[i];
+          break;
         }
 
-      /* 4. We update a portion at the end of the write buffer */
-
-      else if (wrbend >= startblock && wrbend <= newend)
+      if (stream == NULL ||
+          now - rwb->wrstream[i].stamp > now - stream->stamp)
         {
-          FAR uint8_t *dest;
-          size_t offset;
-          size_t ncopy;
+          stream = &rwb->wrstream[i];
+        }
+    }
 
-          /* Copy the data from the updating region to the end
-           * of the write buffer.
-           */
+  rwb_wrflush(rwb, stream);
 
-          offset = rwb->wrnblocks - (wrbend - startblock);
-          ncopy  = rwb->wrmaxblocks - offset;
-          if (ncopy > nblocks)
-            {
-              ncopy = nblocks;
-            }
+  /* Get the alignment padding of startblock, and read the contents
+   * of the padding area, ensure that blockstart is aligned according to
+   * wralignblocks.
+   */
+
+  padblocks          = startblock % rwb->wralignblocks;
+  stream->blockstart = startblock - padblocks;
+  if (padblocks > 0)
+    {
+      rwb_read_(rwb, stream->blockstart, padblocks, stream->buffer);
+    }
 
-          dest = rwb->wrbuffer + offset * rwb->blocksize;
-          memcpy(dest, wrbuffer, ncopy * rwb->blocksize);
+  stream->nblocks    = padblocks;
+  return stream;
+}
+#endif
 
-          rwb->wrnblocks = offset + ncopy;
-          wrbuffer      += ncopy * rwb->blocksize;
-          startblock    += ncopy;
-          nblocks       -= ncopy;
-        }
+/****************************************************************************
+ * Name: rwb_writebuffer
+ *
+ * Assumptions:
+ *   The caller holds the wrlock mutex.
+ *
+ ****************************************************************************/
 
-      /* 5. We update a portion at the beginning of the write buffer.
-       * For writes that are ahead of the writerbuffer, we first flush and
-       * then process the write in the new writebuffer to ensure that each
-       * wrblockstart is aligned according to wralignblocks.
-       */
-    }
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
+                               off_t startblock, uint32_t nblocks,
+                               FAR const uint8_t *wrbuffer)
+{
+  FAR struct rwb_wrstream_s *stream;
+  clock_t now = clock_systime_ticks();
+  uint32_t nwritten = nblocks;
+  size_t offset;
+  size_t ncopy;
 
-  /* Use the block cache unless the buffer size is bigger than block cache */
+  /* Use the write buffers unless the write is bigger than a buffer, the
+   * copies of its blocks in the buffers are then just updated.
+   */
 
   if (nblocks > rwb->wrmaxblocks)
     {
-      ssize_t ret = rwb->wrflush(rwb->dev, wrbuffer, startblock, nblocks);
+      ssize_t ret;
+
+      rwb_wrupdate(rwb, NULL, startblock, nblocks, wrbuffer);
+      ret = rwb->wrflush(rwb->dev, wrbuffer, startblock, nblocks);
       if (ret < 0)
         {
           return ret;
         }
 
-      nblocks = 0;
+      return nwritten;
     }
 
   while (nblocks > 0)
     {
-      size_t padblocks;
-      size_t remain = nblocks;
-
-      /* Flush the write buffer */
-
-      rwb_wrflush(rwb);
-
-      /* Get the alignment padding of startblock, and read the contents
-       * of the padding area, ensure that wrblockstart is aligned
-       * according to wralignblocks.
+      /* Continue the stream of writes that the blocks belong to, or start
+       * a new one.
        */
 
-      padblocks = startblock % rwb->wralignblocks;
-      rwb->wrblockstart = startblock - padblocks;
-      rwb->wrnblocks = padblocks;
-      rwb_read_(rwb, rwb->wrblockstart, padblocks, rwb->wrbuffer);
+      stream = rwb_wrfind(rwb, startblock);
+      if (stream == NULL)
+        {
+          stream = rwb_wralloc(rwb, startblock);
+        }
 
-      if (remain > rwb->wrmaxblocks - padblocks)
+      offset = startblock - stream->blockstart;
+      ncopy  = rwb->wrmaxblocks - offset;
+      if (ncopy > nblocks)
         {
-          remain = rwb->wrmaxblocks - padblocks;
+          ncopy = nblocks;
         }
 
       /* Buffer the data in the write buffer */
 
-      memcpy(rwb->wrbuffer + padblocks * rwb->blocksize, wrbuffer,
-             remain * rwb->blocksize);
-      rwb->wrnblocks += remain;
+      memcpy(stream->buffer + offset * rwb->blocksize, wrbuffer,
+             ncopy * rwb->blocksize);
+      if (offset + ncopy > stream->nblocks)
+        {
+          stream->nblocks = offset + ncopy;
+        }
+
+      stream->stamp = now;
+      rwb_wrupdate(rwb, stream, startblock, ncopy, wrbuffer);
 
       /* Update remain state of write buffer */
 
-      nblocks -= remain;
-      startblock += remain;
-      wrbuffer += remain * rwb->blocksize;
-    }
-
-  if (rwb->wrnblocks > 0)
-    {
-      rwb_wrstarttimeout(rwb);
+      nblocks    -= ncopy;
+      startblock += ncopy;
+      wrbuffer   += ncopy * rwb->blocksize;
     }
 
+  rwb_wrstarttimeout(rwb);
   return nwritten;
 }
 #endif
@@ -391,10 +567,133 @@ static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
 #ifdef CONFIG_DRVR_READAHEAD
 static inline void rwb_resetrhbuffer(FAR struct rwbuffer_s *rwb)
 {
+  int i;
+
   /* We assume that the caller holds the readAheadBufferSemaphore */
 
-  rwb->rhnblocks    = 0;
-  rwb->rhblockstart = -1;
+  for (i = 0; i < CONFIG_DRVR_NSTREAMS; i++)
+    {
+      rwb->rhstream[i].nblocks    = 0;
+      rwb->rhstream[i].blockstart = -1;
+      rwb->rhstream[i].next       = -1;
+      rwb->rhstream[i].window     = 0;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_rhupdate
+ *
+ * Description:
+ *   Update the copies of the blocks written that the read-ahead buffers
+ *   hold, so that the data read ahead stays valid.
+ *
+ * Assumptions:
+ *   The caller holds the rhlock mutex.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_READAHEAD
+static void rwb_rhupdate(FAR struct rwbuffer_s *rwb, off_t startblock,
+                         size_t nblocks, FAR const uint8_t *wrbuffer)
+{
+  FAR struct rwb_rhstream_s *stream;
+  int i;
+
+  for (i = 0; i < CONFIG_DRVR_NSTREAMS; i++)
+    {
+      stream = &rwb->rhstream[i];
+      if (stream->nblocks > 0)
+        {
+          rwb_copyblocks(rwb, stream->buffer, stream->blockstart,
+                         stream->nblocks, wrbuffer, startblock, nblocks);
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_rhfind
+ *
+ * Description:
+ *   Find the read-ahead buffer that holds 'startblock'.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_READAHEAD
+static FAR struct rwb_rhstream_s *rwb_rhfind(FAR struct rwbuffer_s *rwb,
+                                             off_t startblock)
+{
+  FAR struct rwb_rhstream_s *stream;
+  int i;
+
+  for (i = 0; i < CONFIG_DRVR_NSTREAMS; i++)
+    {
+      stream = &rwb->rhstream[i];
+      if (stream->nblocks > 0 && startblock >= stream->blockstart &&
+          startblock < stream->blockstart + stream->nblocks)
+        {
+          return stream;
+        }
+    }
+
+  return NULL;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_rhselect
+ *
+ * Description:
+ *   Select the read-ahead buffer to reload for a miss at 'startblock' and
+ *   the number of blocks to read:  A stream that stopped just before
+ *   'startblock' is sequential and reads twice as much as the last time,
+ *   otherwise the least recently used buffer reads the 'nblocks' blocks
+ *   requested.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_READAHEAD
+static FAR struct rwb_rhstream_s *rwb_rhselect(FAR struct rwbuffer_s *rwb,
+                                               off_t startblock,
+                                               size_t nblocks)
+{
+  FAR struct rwb_rhstream_s *stream = NULL;
+  size_t window;
+  int i;
+
+  if (nblocks > rwb->rhmaxblocks)
+    {
+      nblocks = rwb->rhmaxblocks;
+    }
+
+  for (i = 0; i < CONFIG_DRVR_NSTREAMS; i++)
+    {
+      if (rwb->rhstream[i].next == startblock)
+        {
+          stream = &rwb->rhstream[i];
+          window = 2 * stream->window;
+          if (window > rwb->rhmaxblocks)
+            {
+              window = rwb->rhmaxblocks;
+            }
+
+          stream->window = window > nblocks ? window : nblocks;
+          return stream;
+        }
+    }
+
+  for (i = 0; i < CONFIG_DRVR_NSTREAMS; i++)
+    {
+      if (stream == NULL ||
+          (int32_t)(rwb->rhstream[i].stamp - stream->stamp) < 0)
+        {
+          stream = &rwb->rhstream[i];
+        }
+    }
+
+  stream->window = nblocks > 0 ? nblocks : 1;
+  return stream;
 }
 #endif
 
@@ -404,7 +703,8 @@ static inline void rwb_resetrhbuffer(FAR struct rwbuffer_s *rwb)
 
 #ifdef CONFIG_DRVR_READAHEAD
 static inline void
-rwb_bufferread(FAR struct rwbuffer_s *rwb,  off_t startblock,
+rwb_bufferread(FAR struct rwbuffer_s *rwb,
+               FAR struct rwb_rhstream_s *stream, off_t startblock,
                size_t nblocks, FAR uint8_t **rdbuffer)
 {
   FAR uint8_t *rhbuffer;
@@ -417,13 +717,13 @@ rwb_bufferread(FAR struct rwbuffer_s *rwb,  off_t startblock,
 
   /* Convert the units from blocks to bytes */
 
-  off_t  blockoffset = startblock - rwb->rhblockstart;
+  off_t  blockoffset = startblock - stream->blockstart;
   off_t  byteoffset  = rwb->blocksize * blockoffset;
   size_t nbytes      = rwb->blocksize * nblocks;
 
   /* Get the byte address in the read-ahead buffer */
 
-  rhbuffer           = rwb->rhbuffer + byteoffset;
+  rhbuffer           = stream->buffer + byteoffset;
 
   /* Copy the data from the read-ahead buffer into the IO buffer */
 
@@ -440,7 +740,8 @@ rwb_bufferread(FAR struct rwbuffer_s *rwb,  off_t startblock,
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_READAHEAD
-static int rwb_rhreload(FAR struct rwbuffer_s *rwb, off_t startblock)
+static int rwb_rhreload(FAR struct rwbuffer_s *rwb,
+                        FAR struct rwb_rhstream_s *stream, off_t startblock)
 {
   off_t  endblock;
   size_t nblocks;
@@ -453,11 +754,9 @@ static int rwb_rhreload(FAR struct rwbuffer_s *rwb, off_t startblock)
       return -ESPIPE;
     }
 
-  /* Get the block number +1 of the last block that will fit in the
-   * read-ahead buffer
-   */
+  /* Get the block number +1 of the last block to read ahead */
 
-  endblock = startblock + rwb->rhmaxblocks;
+  endblock = startblock + stream->window;
 
   /* Make sure that we don't read past the end of the device */
 
@@ -470,17 +769,27 @@ static int rwb_rhreload(FAR struct rwbuffer_s *rwb, off_t startblock)
 
   /* Reset the read buffer */
 
-  rwb_resetrhbuffer(rwb);
+  stream->nblocks    = 0;
+  stream->blockstart = -1;
 
   /* Now perform the read */
 
-  ret = rwb->rhreload(rwb->dev, rwb->rhbuffer, startblock, nblocks);
+  ret = rwb->rhreload(rwb->dev, stream->buffer, startblock, nblocks);
   if (ret == nblocks)
     {
       /* Update information about what is in the read-ahead buffer */
 
-      rwb->rhnblocks    = nblocks;
-      rwb->rhblockstart = startblock;
+      stream->nblocks    = nblocks;
+      stream->blockstart = startblock;
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+      /* The blocks still in the write buffers are newer than the media */
+
+      if (rwb->wrmaxblocks > 0)
+        {
+          rwb_wroverlay(rwb, NULL, startblock, nblocks, stream->buffer);
+        }
+#endif
 
       /* The return value is not the number of blocks we asked to be
        * loaded.
@@ -494,140 +803,172 @@ static int rwb_rhreload(FAR struct rwbuffer_s *rwb, off_t startblock)
 #endif
 
 /****************************************************************************
- * Name: rwb_invalidate_writebuffer
+ * Name: rwb_wrinvalidate
  *
  * Description:
- *   Invalidate a region of the write buffer
+ *   Invalidate a region of one write buffer
  *
  ****************************************************************************/
 
 #if defined(CONFIG_DRVR_WRITEBUFFER) && defined(CONFIG_DRVR_INVALIDATE)
-int rwb_invalidate_writebuffer(FAR struct rwbuffer_s *rwb,
-                               off_t startblock, size_t blockcount)
+static int rwb_wrinvalidate(FAR struct rwbuffer_s *rwb,
+                            FAR struct rwb_wrstream_s *stream,
+                            off_t startblock, size_t blockcount)
 {
+  off_t wrbend;
+  off_t invend;
   int ret = OK;
 
-  /* Is there a write buffer?  Is data saved in the write buffer? */
+  /* Now there are five cases:
+   *
+   * 1. We invalidate nothing
+   */
+
+  wrbend = stream->blockstart + stream->nblocks;
+  invend = startblock + blockcount;
 
-  if (rwb->wrmaxblocks > 0 && rwb->wrnblocks > 0)
+  if (wrbend <= startblock || stream->blockstart >= invend)
     {
-      off_t wrbend;
-      off_t invend;
+      ret = OK;
+    }
 
-      finfo("startblock=%" PRIdOFF " blockcount=%zu\n",
-            startblock, blockcount);
+  /* 2. We invalidate the entire write buffer. */
 
-      ret = rwb_lock(&rwb->wrlock);
-      if (ret < 0)
-        {
-          return ret;
-        }
+  else if (stream->blockstart >= startblock && wrbend <= invend)
+    {
+      stream->nblocks = 0;
+      ret = OK;
+    }
 
-      /* Now there are five cases:
-       *
-       * 1. We invalidate nothing
-       */
+  /* We are going to invalidate a subset of the write buffer.  Three
+   * more cases to consider:
+   *
+   * 3. We invalidate a portion in the middle of the write buffer
+   */
+
+  else if (stream->blockstart < startblock && wrbend > invend)
+    {
+      FAR uint8_t *src;
+      off_t block;
+      off_t offset;
+      size_t nblocks;
 
-      wrbend = rwb->wrblockstart + rwb->wrnblocks;
-      invend = startblock + blockcount;
+      /* Write the blocks at the end of the media to hardware */
 
-      if (wrbend <= startblock || rwb->wrblockstart >= invend)
+      nblocks = wrbend - invend;
+      block   = invend;
+      offset  = block - stream->blockstart;
+      src     = stream->buffer + offset * rwb->blocksize;
+
+      ret = rwb->wrflush(rwb->dev, src, block, nblocks);
+      if (ret < 0)
         {
-          ret = OK;
+          ferr("ERROR: wrflush failed: %d\n", ret);
         }
 
-      /* 2. We invalidate the entire write buffer. */
+      /* Keep the blocks at the beginning of the buffer up the
+       * start of the invalidated region.
+       */
 
-      else if (rwb->wrblockstart >= startblock && wrbend <= invend)
+      else
         {
-          rwb->wrnblocks = 0;
+          stream->nblocks = startblock - stream->blockstart;
           ret = OK;
         }
+    }
 
-      /* We are going to invalidate a subset of the write buffer.  Three
-       * more cases to consider:
-       *
-       * 3. We invalidate a portion in the middle of the write buffer
-       */
+  /* 4. We invalidate a portion at the end of the write buffer */
 
-      else if (rwb->wrblockstart < startblock && wrbend > invend)
-        {
-          FAR uint8_t *src;
-          off_t block;
-          off_t offset;
-          size_t nblocks;
+  else if (wrbend > startblock && wrbend <= invend)
+    {
+      stream->nblocks -= wrbend - startblock;
+      ret = OK;
+    }
 
-          /* Write the blocks at the end of the media to hardware */
+  /* 5. We invalidate a portion at the beginning of the write buffer */
 
-          nblocks = wrbend - invend;
-          block   = invend;
-          offset  = block - rwb->wrblockstart;
-          src     = rwb->wrbuffer + offset * rwb->blocksize;
+  else /* if (stream->blockstart >= startblock && wrbend > invend) */
+    {
+      FAR uint8_t *src;
+      size_t ninval;
+      size_t nkeep;
 
-          ret = rwb->wrflush(rwb->dev, src, block, nblocks);
-          if (ret < 0)
-            {
-              ferr("ERROR: wrflush failed: %d\n", ret);
-            }
+      DEBUGASSERT(stream->blockstart >= startblock && wrbend > invend);
 
-          /* Keep the blocks at the beginning of the buffer up the
-           * start of the invalidated region.
-           */
+      /* Copy the data from the uninvalidated region to the beginning
+       * of the write buffer.
+       *
+       * First calculate the source and destination of the transfer.
+       */
 
-          else
-            {
-              rwb->wrnblocks = startblock - rwb->wrblockstart;
-              ret = OK;
-            }
-        }
+      ninval = invend - stream->blockstart;
+      src    = stream->buffer + ninval * rwb->blocksize;
 
-      /* 4. We invalidate a portion at the end of the write buffer */
+      /* Calculate the number of blocks we are keeping.  We keep
+       * the ones that we don't invalidate.
+       */
 
-      else if (wrbend > startblock && wrbend <= invend)
-        {
-          rwb->wrnblocks -= wrbend - startblock;
-          ret = OK;
-        }
+      nkeep  = stream->nblocks - ninval;
 
-      /* 5. We invalidate a portion at the beginning of the write buffer */
+      /* Then move the data that we are keeping to the beginning
+       * the write buffer.
+       */
 
-      else /* if (rwb->wrblockstart >= startblock && wrbend > invend) */
-        {
-          FAR uint8_t *src;
-          size_t ninval;
-          size_t nkeep;
+      memmove(stream->buffer, src, nkeep * rwb->blocksize);
 
-          DEBUGASSERT(rwb->wrblockstart >= startblock && wrbend > invend);
+      /* Update the block info.  The first block is now the one just
+       * after the invalidation region and the number buffered blocks
+       * is the number that we kept.
+       */
 
-          /* Copy the data from the uninvalidated region to the beginning
-           * of the write buffer.
-           *
-           * First calculate the source and destination of the transfer.
-           */
+      stream->blockstart = invend;
+      stream->nblocks    = nkeep;
+      ret = OK;
+    }
 
-          ninval = invend - rwb->wrblockstart;
-          src    = rwb->wrbuffer + ninval * rwb->blocksize;
+  return ret;
+}
+#endif
 
-          /* Calculate the number of blocks we are keeping.  We keep
-           * the ones that we don't invalidate.
-           */
+/****************************************************************************
+ * Name: rwb_invalidate_writebuffer
+ *
+ * Description:
+ *   Invalidate a region of the write buffers
+ *
+ ****************************************************************************/
 
-          nkeep  = rwb->wrnblocks - ninval;
+#if defined(CONFIG_DRVR_WRITEBUFFER) && defined(CONFIG_DRVR_INVALIDATE)
+int rwb_invalidate_writebuffer(FAR struct rwbuffer_s *rwb,
+                               off_t startblock, size_t blockcount)
+{
+  int ret = OK;
+  int i;
 
-          /* Then move the data that we are keeping to the beginning
-           * the write buffer.
-           */
+  /* Is there a write buffer? */
 
-          memcpy(rwb->wrbuffer, src, nkeep * rwb->blocksize);
+  if (rwb->wrmaxblocks > 0)
+    {
+      finfo("startblock=%" PRIdOFF " blockcount=%zu\n",
+            startblock, blockcount);
 
-          /* Update the block info.  The first block is now the one just
-           * after the invalidation region and the number buffered blocks
-           * is the number that we kept.
-           */
+      ret = rwb_lock(&rwb->wrlock);
+      if (ret < 0)
+        {
+          return ret;
+        }
 
-          rwb->wrblockstart = invend;
-          rwb->wrnblocks    = nkeep;
-          ret = OK;
+      for (i = 0; i < CONFIG_DRVR_NSTREAMS; i++)
+        {
+          if (rwb->wrstream[i].nblocks > 0)
+            {
+              ret = rwb_wrinvalidate(rwb, &rwb->wrstream[i], startblock,
+                                     blockcount);
+              if (ret < 0)
+                {
+                  break;
+                }
+            }
         }
 
       rwb_unlock(&rwb->wrlock);
@@ -638,115 +979,137 @@ int rwb_invalidate_writebuffer(FAR struct rwbuffer_s *rwb,
 #endif
 
 /****************************************************************************
- * Name: rwb_invalidate_readahead
+ * Name: rwb_rhinvalidate
  *
  * Description:
- *   Invalidate a region of the read-ahead buffer
+ *   Invalidate a region of one read-ahead buffer
  *
  ****************************************************************************/
 
 #if defined(CONFIG_DRVR_READAHEAD)  && defined(CONFIG_DRVR_INVALIDATE)
-int rwb_invalidate_readahead(FAR struct rwbuffer_s *rwb,
+static void rwb_rhinvalidate(FAR struct rwbuffer_s *rwb,
+                             FAR struct rwb_rhstream_s *stream,
                              off_t startblock, size_t blockcount)
 {
-  int ret = OK;
+  off_t rhbend;
+  off_t invend;
+
+  /* Now there are five cases:
+   *
+   * 1. We invalidate nothing
+   */
 
-  if (rwb->rhmaxblocks > 0 && rwb->rhnblocks > 0)
+  rhbend = stream->blockstart + stream->nblocks;
+  invend = startblock + blockcount;
+
+  if (rhbend <= startblock || stream->blockstart >= invend)
     {
-      off_t rhbend;
-      off_t invend;
+    }
 
-      finfo("startblock=%" PRIdOFF " blockcount=%zu\n",
-            startblock, blockcount);
+  /* 2. We invalidate the entire read-ahead buffer. */
 
-      ret = rwb_lock(&rwb->rhlock);
-      if (ret < 0)
-        {
-          return ret;
-        }
+  else if (stream->blockstart >= startblock && rhbend <= invend)
+    {
+      stream->nblocks = 0;
+    }
 
-      /* Now there are five cases:
-       *
-       * 1. We invalidate nothing
+  /* We are going to invalidate a subset of the read-ahead buffer.
+   * Three more cases to consider:
+   *
+   * 2. We invalidate a portion in the middle of the read-ahead buffer
+   */
+
+  else if (stream->blockstart < startblock && rhbend > invend)
+    {
+      /* Keep the blocks at the beginning of the buffer up the
+       * start of the invalidated region.
        */
 
-      rhbend = rwb->rhblockstart + rwb->rhnblocks;
-      invend = startblock + blockcount;
+      stream->nblocks = startblock - stream->blockstart;
+    }
 
-      if (rhbend <= startblock || rwb->rhblockstart >= invend)
-        {
-          ret = OK;
-        }
+  /* 3. We invalidate a portion at the end of the read-ahead buffer */
 
-      /* 2. We invalidate the entire read-ahead buffer. */
+  else if (rhbend > startblock && rhbend <= invend)
+    {
+      stream->nblocks -= rhbend - startblock;
+    }
 
-      else if (rwb->rhblockstart >= startblock && rhbend <= invend)
-        {
-          rwb->rhnblocks = 0;
-          ret = OK;
-        }
+  /* 4. We invalidate a portion at the begin of the read-ahead buffer */
+
+  else /* if (stream->blockstart >= startblock && rhbend > invend) */
+    {
+      FAR uint8_t *src;
+      size_t ninval;
+      size_t nkeep;
+
+      DEBUGASSERT(stream->blockstart >= startblock && rhbend > invend);
 
-      /* We are going to invalidate a subset of the read-ahead buffer.
-       * Three more cases to consider:
+      /* Copy the data from the uninvalidated region to the beginning
+       * of the read buffer.
        *
-       * 2. We invalidate a portion in the middle of the read-ahead buffer
+       * First calculate the source and destination of the transfer.
        */
 
-      else if (rwb->rhblockstart < startblock && rhbend > invend)
-        {
-          /* Keep the blocks at the beginning of the buffer up the
-           * start of the invalidated region.
-           */
+      ninval = invend - stream->blockstart;
+      src    = stream->buffer + ninval * rwb->blocksize;
 
-          rwb->rhnblocks = startblock - rwb->rhblockstart;
-          ret = OK;
-        }
+      /* Calculate the number of blocks we are keeping.  We keep
+       * the ones that we don't invalidate.
+       */
 
-      /* 3. We invalidate a portion at the end of the read-ahead buffer */
+      nkeep  = stream->nblocks - ninval;
 
-      else if (rhbend > startblock && rhbend <= invend)
-        {
-          rwb->rhnblocks -= rhbend - startblock;
-          ret = OK;
-        }
+      /* Then move the data that we are keeping to the beginning
+       * the read buffer.
+       */
 
-      /* 4. We invalidate a portion at the begin of the read-ahead buffer */
+      memmove(stream->buffer, src, nkeep * rwb->blocksize);
 
-      else /* if (rwb->rhblockstart >= startblock && rhbend > invend) */
-        {
-          FAR uint8_t *src;
-          size_t ninval;
-          size_t nkeep;
-
-          DEBUGASSERT(rwb->rhblockstart >= startblock && rhbend > invend);
-          /* Copy the data from the uninvalidated region to the beginning
-           * of the read buffer.
-           *
-           * First calculate the source and destination of the transfer.
-           */
-
-          ninval = invend - rwb->rhblockstart;
-          src    = rwb->rhbuffer + ninval * rwb->blocksize;
+      /* Update the block info.  The first block is now the one just
+       * after the invalidation region and the number buffered blocks
+       * is the number that we kept.
+       */
 
-          /* Calculate the number of blocks we are keeping.  We keep
-           * the ones that we don't invalidate.
-           */
+      stream->blockstart = invend;
+      stream->nblocks    = nkeep;
+    }
+}
+#endif
 
-          nkeep  = rwb->rhnblocks - ninval;
+/****************************************************************************
+ * Name: rwb_invalidate_readahead
+ *
+ * Description:
+ *   Invalidate a region of the read-ahead buffers
+ *
+ ****************************************************************************/
 
-          /* Then move the data that we are keeping to the beginning
-           * the read buffer.
-           */
+#if defined(CONFIG_DRVR_READAHEAD)  && defined(CONFIG_DRVR_INVALIDATE)
+int rwb_invalidate_readahead(FAR struct rwbuffer_s *rwb,
+                             off_t startblock, size_t blockcount)
+{
+  int ret = OK;
+  int i;
 
-          memmove(rwb->rhbuffer, src, nkeep * rwb->blocksize);
+  if (rwb->rhmaxblocks > 0)
+    {
+      finfo("startblock=%" PRIdOFF " blockcount=%zu\n",
+            startblock, blockcount);
 
-          /* Update the block info.  The first block is now the one just
-           * after the invalidation region and the number buffered blocks
-           * is the number that we kept.
-           */
+      ret = rwb_lock(&rwb->rhlock);
+      if (ret < 0)
+        {
+          return ret;
+        }
 
-          rwb->rhblockstart = invend;
-          rwb->rhnblocks    = nkeep;
+      for (i = 0; i < CONFIG_DRVR_NSTREAMS; i++)
+        {
+          if (rwb->rhstream[i].nblocks > 0)
+            {
+              rwb_rhinvalidate(rwb, &rwb->rhstream[i], startblock,
+                               blockcount);
+            }
         }
 
       rwb_unlock(&rwb->rhlock);
@@ -767,6 +1130,7 @@ int rwb_invalidate_readahead(FAR struct rwbuffer_s *rwb,
 int rwb_initialize(FAR struct rwbuffer_s *rwb)
 {
   uint32_t allocsize;
+  int i;
 
   /* Sanity checking */
 
@@ -807,18 +1171,25 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
 
       rwb_resetwrbuffer(rwb);
 
-      /* Allocate the write buffer */
+      /* Allocate the write buffers */
 
       allocsize     = rwb->wrmaxblocks * rwb->blocksize;
-      rwb->wrbuffer = kmm_malloc(allocsize);
+      rwb->wrbuffer = kmm_malloc(allocsize * CONFIG_DRVR_NSTREAMS);
       if (!rwb->wrbuffer)
         {
-          ferr("Write buffer kmm_malloc(%" PRIu32 ") failed\n", allocsize);
+          ferr("Write buffer kmm_malloc(%" PRIu32 ") failed\n",
+               allocsize * CONFIG_DRVR_NSTREAMS);
           nxmutex_destroy(&rwb->wrlock);
           return -ENOMEM;
         }
 
-      finfo("Write buffer size: %" PRIu32 " bytes\n", allocsize);
+      for (i = 0; i < CONFIG_DRVR_NSTREAMS; i++)
+        {
+          rwb->wrstream[i].buffer = rwb->wrbuffer + i * allocsize;
+        }
+
+      finfo("Write buffer size: %" PRIu32 " bytes\n",
+            allocsize * CONFIG_DRVR_NSTREAMS);
     }
 #endif /* CONFIG_DRVR_WRITEBUFFER */
 
@@ -835,14 +1206,14 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
 
       rwb_resetrhbuffer(rwb);
 
-      /* Allocate the read-ahead buffer */
+      /* Allocate the read-ahead buffers */
 
       allocsize     = rwb->rhmaxblocks * rwb->blocksize;
-      rwb->rhbuffer = kmm_malloc(allocsize);
+      rwb->rhbuffer = kmm_malloc(allocsize * CONFIG_DRVR_NSTREAMS);
       if (!rwb->rhbuffer)
         {
           ferr("Read-ahead buffer kmm_malloc(%" PRIu32 ") failed\n",
-          allocsize);
+               allocsize * CONFIG_DRVR_NSTREAMS);
           nxmutex_destroy(&rwb->rhlock);
 #ifdef CONFIG_DRVR_WRITEBUFFER
           if (rwb->wrmaxblocks > 0)
@@ -859,10 +1230,19 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
           return -ENOMEM;
         }
 
-      finfo("Read-ahead buffer size: %" PRIu32 " bytes\n", allocsize);
+      for (i = 0; i < CONFIG_DRVR_NSTREAMS; i++)
+        {
+          rwb->rhstream[i].buffer = rwb->rhbuffer + i * allocsize;
+          rwb->rhstream[i].stamp  = 0;
+        }
+
+      rwb->rhstamp = 0;
+      finfo("Read-ahead buffer size: %" PRIu32 " bytes\n",
+            allocsize * CONFIG_DRVR_NSTREAMS);
     }
 #endif /* CONFIG_DRVR_READAHEAD */
 
+  UNUSED(i);
   return OK;
 }
 
@@ -876,7 +1256,7 @@ void rwb_uninitialize(FAR struct rwbuffer_s *rwb)
   if (rwb->wrmaxblocks > 0)
     {
       rwb_wrcanceltimeout(rwb);
-      rwb_wrflush(rwb);
+      rwb_wrflushall(rwb);
       nxmutex_destroy(&rwb->wrlock);
       if (rwb->wrbuffer)
         {
@@ -899,16 +1279,25 @@ void rwb_uninitialize(FAR struct rwbuffer_s *rwb)
 
 /****************************************************************************
  * Name: rwb_read_
+ *
+ * Assumptions:
+ *   The caller holds the wrlock mutex if there are write buffers.
+ *
  ****************************************************************************/
 
 static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
                          size_t nblocks, FAR uint8_t *rdbuffer)
 {
+#ifdef CONFIG_DRVR_WRITEBUFFER
+  FAR uint8_t *buffer = rdbuffer;
+  off_t block = startblock;
+#endif
   int ret = OK;
 
 #ifdef CONFIG_DRVR_READAHEAD
   if (rwb->rhmaxblocks > 0)
     {
+      FAR struct rwb_rhstream_s *stream;
       size_t remaining;
 
       ret = rwb_lock(&rwb->rhlock);
@@ -921,46 +1310,62 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
 
       for (remaining = nblocks; remaining > 0; )
         {
-          /* Is there anything in the read-ahead buffer? */
+          /* Is the next block in a read-ahead buffer? */
 
-          if (rwb->rhnblocks > 0)
+          stream = rwb_rhfind(rwb, startblock);
+          if (stream != NULL)
             {
-              off_t bufferend;
-
-              /* How many blocks are available in this buffer? */
-
-              bufferend = rwb->rhblockstart + rwb->rhnblocks;
-              if (startblock >= rwb->rhblockstart && startblock < bufferend)
+              size_t rdblocks = stream->blockstart + stream->nblocks -
+                                startblock;
+              if (rdblocks > remaining)
                 {
-                  size_t rdblocks = bufferend - startblock;
-                  if (rdblocks > remaining)
-                    {
-                      rdblocks = remaining;
-                    }
+                  rdblocks = remaining;
+                }
 
-                  /* Then read the data from the read-ahead buffer */
+              /* Then read the data from the read-ahead buffer */
 
-                  rwb_bufferread(rwb, startblock, rdblocks, &rdbuffer);
-                  startblock += rdblocks;
-                  remaining  -= rdblocks;
-                }
+              rwb_bufferread(rwb, stream, startblock, rdblocks, &rdbuffer);
+              startblock   += rdblocks;
+              remaining    -= rdblocks;
+              stream->next  = startblock;
+              stream->stamp = ++rwb->rhstamp;
+              continue;
             }
 
-          /* If we did not get all of the data from the buffer, then we have
-           * to refill the buffer and try again.
+          /* If we did not get all of the data from the buffers, then we
+           * have to refill a buffer and try again.  The reads that would
+           * fill a whole buffer are made directly to the user buffer.
            */
 
-          if (remaining > 0)
+          stream = rwb_rhselect(rwb, startblock, remaining);
+          if (remaining >= rwb->rhmaxblocks)
             {
-              ret = rwb_rhreload(rwb, startblock);
-              if (ret < 0)
+              ret = rwb->rhreload(rwb->dev, rdbuffer, startblock,
+                                  remaining);
+              if (ret != remaining)
                 {
-                  ferr("ERROR: Failed to fill the read-ahead buffer: %d\n",
-                       ret);
+                  ferr("ERROR: Failed to read directly: %d\n", ret);
 
                   rwb_unlock(&rwb->rhlock);
-                  return ret;
+                  return ret < 0 ? ret : -EIO;
                 }
+
+              startblock   += remaining;
+              rdbuffer     += remaining * rwb->blocksize;
+              remaining     = 0;
+              stream->next  = startblock;
+              stream->stamp = ++rwb->rhstamp;
+              continue;
+            }
+
+          ret = rwb_rhreload(rwb, stream, startblock);
+          if (ret < 0)
+            {
+              ferr("ERROR: Failed to fill the read-ahead buffer: %d\n",
+                   ret);
+
+              rwb_unlock(&rwb->rhlock);
+              return ret;
             }
         }
 
@@ -985,6 +1390,15 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
         }
     }
 
+#ifdef CONFIG_DRVR_WRITEBUFFER
+  /* The blocks still in the write buffers are newer than the media */
+
+  if (rwb->wrmaxblocks > 0 && ret > 0)
+    {
+      rwb_wroverlay(rwb, NULL, block, ret, buffer);
+    }
+#endif
+
   return ret;
 }
 
@@ -995,76 +1409,49 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
 ssize_t rwb_read(FAR struct rwbuffer_s *rwb, off_t startblock,
                  size_t nblocks, FAR uint8_t *rdbuffer)
 {
-  int ret = OK;
-  size_t readblocks = 0;
-
   finfo("startblock=%ld nblocks=%ld rdbuffer=%p\n",
         (long)startblock, (long)nblocks, rdbuffer);
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-  /* If the new read data overlaps any part of the write buffer, we
-   * directly copy write buffer to read buffer. This boost performance.
+  /* The data read is overlaid with the blocks of the write buffers.  If a
+   * write buffer holds all the blocks requested, we directly copy the
+   * write buffer to the read buffer.  This boosts performance.
    */
 
   if (rwb->wrmaxblocks > 0)
     {
+      FAR struct rwb_wrstream_s *stream;
+      ssize_t ret;
+      int i;
+
       ret = rwb_lock(&rwb->wrlock);
       if (ret < 0)
         {
           return ret;
         }
 
-      /* If the write buffer overlaps the block(s) requested */
-
-      if (rwb_overlap(rwb->wrblockstart, rwb->wrnblocks, startblock,
-                      nblocks))
+      for (i = 0; i < CONFIG_DRVR_NSTREAMS; i++)
         {
-          size_t rdblocks = 0;
-          size_t wrnpass  = 0;
-
-          if (rwb->wrblockstart > startblock)
+          stream = &rwb->wrstream[i];
+          if (stream->nblocks > 0 && startblock >= stream->blockstart &&
+              startblock + nblocks <= stream->blockstart + stream->nblocks)
             {
-              rdblocks = rwb->wrblockstart - startblock;
-              ret = rwb_read_(rwb, startblock, rdblocks, rdbuffer);
-              if (ret < 0)
-                {
-                  rwb_unlock(&rwb->wrlock);
-                  return ret;
-                }
-
-              startblock += ret;
-              nblocks    -= ret;
-              rdbuffer   += ret * rwb->blocksize;
-              readblocks += ret;
-            }
+              memcpy(rdbuffer, stream->buffer +
+                     (startblock - stream->blockstart) * rwb->blocksize,
+                     nblocks * rwb->blocksize);
 
-          if (rwb->wrblockstart < startblock)
-            {
-              wrnpass = startblock - rwb->wrblockstart;
+              rwb_unlock(&rwb->wrlock);
+              return nblocks;
             }
-
-          rdblocks = nblocks > (rwb->wrnblocks - wrnpass) ?
-                    (rwb->wrnblocks - wrnpass) : nblocks;
-          memcpy(rdbuffer, &rwb->wrbuffer[wrnpass * rwb->blocksize],
-                rdblocks * rwb->blocksize);
-
-          startblock += rdblocks;
-          nblocks    -= rdblocks;
-          rdbuffer   += rdblocks * rwb->blocksize;
-          readblocks += rdblocks;
         }
 
+      ret = rwb_read_(rwb, startblock, nblocks, rdbuffer);
       rwb_unlock(&rwb->wrlock);
-    }
-#endif
-
-  ret = rwb_read_(rwb, startblock, nblocks, rdbuffer);
-  if (ret < 0)
-    {
       return ret;
     }
+#endif
 
-  return readblocks + ret;
+  return rwb_read_(rwb, startblock, nblocks, rdbuffer);
 }
 
 /****************************************************************************
@@ -1076,39 +1463,39 @@ ssize_t rwb_write(FAR struct rwbuffer_s *rwb, off_t startblock,
 {
   int ret = OK;
 
+#ifdef CONFIG_DRVR_WRITEBUFFER
+  if (rwb->wrmaxblocks > 0)
+    {
+      ret = rwb_lock(&rwb->wrlock);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+#endif
+
 #ifdef CONFIG_DRVR_READAHEAD
   if (rwb->rhmaxblocks > 0)
     {
-      /* If the new write data overlaps any part of the read buffer, then
-       * flush the data from the read buffer.  We could attempt some more
-       * exotic handling -- but this simple logic is well-suited for simple
-       * streaming applications.
+      /* If the new write data overlaps any part of the read buffers, then
+       * update the copies of the blocks in the read buffers:  The data read
+       * ahead by the other streams stays valid.
        */
 
       ret = rwb_lock(&rwb->rhlock);
       if (ret < 0)
         {
-          return ret;
-        }
-
-      if (rwb_overlap(rwb->rhblockstart, rwb->rhnblocks, startblock,
-                      nblocks))
-        {
-#ifdef CONFIG_DRVR_INVALIDATE
-          /* Just invalidate the read buffer startblock + nblocks data */
-
-          ret = rwb_invalidate_readahead(rwb, startblock, nblocks);
-          if (ret < 0)
+#ifdef CONFIG_DRVR_WRITEBUFFER
+          if (rwb->wrmaxblocks > 0)
             {
-              ferr("ERROR: rwb_invalidate_readahead failed: %d\n", ret);
-              rwb_unlock(&rwb->rhlock);
-              return ret;
+              rwb_unlock(&rwb->wrlock);
             }
-#else
-          rwb_resetrhbuffer(rwb);
 #endif
+
+          return ret;
         }
 
+      rwb_rhupdate(rwb, startblock, nblocks, wrbuffer);
       rwb_unlock(&rwb->rhlock);
     }
 #endif
@@ -1118,12 +1505,6 @@ ssize_t rwb_write(FAR struct rwbuffer_s *rwb, off_t startblock,
     {
       finfo("startblock=%" PRIdOFF " wrbuffer=%p\n", startblock, wrbuffer);
 
-      ret = rwb_lock(&rwb->wrlock);
-      if (ret < 0)
-        {
-          return ret;
-        }
-
       ret = rwb_writebuffer(rwb, startblock, nblocks, wrbuffer);
       rwb_unlock(&rwb->wrlock);
 
@@ -1270,7 +1651,7 @@ int rwb_flush(FAR struct rwbuffer_s *rwb)
 
   ret = rwb_lock(&rwb->wrlock);
   rwb_wrcanceltimeout(rwb);
-  rwb_wrflush(rwb);
+  rwb_wrflushall(rwb);
   rwb_unlock(&rwb->wrlock);
 
   return ret;
@@ -96,6 +96,10 @@ struct mmcsd_state_s
   uint8_t type:4;                  /* Card type (See MMCSD_CARDTYPE_* definitions) */
   uint8_t buswidth:4;              /* Bus widths supported (SD only) */
   uint8_t cmd23support:1;          /* CMD23 supported (SD only) */
+#ifdef CONFIG_MMCSD_CMDQ
+  uint8_t cmdqon:1;                /* true: The command queue is enabled */
+  uint8_t cmdqdepth;               /* Depth of the command queue, 0 if none */
+#endif
   sdio_capset_t caps;              /* SDIO driver capabilities/limitations */
   uint32_t cid[4];                 /* CID register */
   uint32_t csd[4];                 /* CSD register */
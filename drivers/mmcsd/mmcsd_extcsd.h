@@ -43,7 +43,9 @@
 
 #define MMCSD_PART_SETTING_COMPLETED               0x1
 #define MMCSD_PART_SUPPORT_PART_EN                 0x1
+#define MMCSD_CMDQ_SUPPORTED                       0x1
 
+#define MMCSD_EXTCSD_CMDQ_MODE_EN                  15   /* R/W/E_P */
 #define MMCSD_EXTCSD_GP_SIZE_MULT                  143  /* R/W */
 #define MMCSD_EXTCSD_PARTITION_SETTING_COMPLETED   155  /* R/W */
 #define MMCSD_EXTCSD_PARTITION_SUPPORT             160  /* RO */
@@ -51,6 +53,8 @@
 #define MMCSD_EXTCSD_HC_WP_GRP_SIZE                221  /* RO */
 #define MMCSD_EXTCSD_HC_ERASE_GRP_SIZE             224  /* RO */
 #define MMCSD_EXTCSD_BOOT_SIZE_MULT                226  /* RO */
+#define MMCSD_EXTCSD_CMDQ_DEPTH                    307  /* RO */
+#define MMCSD_EXTCSD_CMDQ_SUPPORT                  308  /* RO */
 
 /****************************************************************************
  * Public Types
@@ -30,6 +30,7 @@
 
 #include <sys/types.h>
 #include <sys/ioctl.h>
+#include <sys/param.h>
 
 #include <inttypes.h>
 #include <stdint.h>
@@ -104,6 +105,21 @@
 
 #define MMCSD_CAPACITY(b, s)    ((s) >= 10 ? (b) << ((s) - 10) : (b) >> (10 - (s)))
 
+#ifdef CONFIG_MMCSD_CMDQ
+/* eMMC command queuing: The arguments of CMD44 (QUEUED_TASK_PARAMS), the
+ * SQS bit of CMD13 that returns the Queue Status Register instead of the
+ * card status, and the CMD48 operation that discards the queue.
+ */
+
+#  define MMC_CMDQ_READ         (1 << 30)
+#  define MMC_CMDQ_TASKID(n)    ((uint32_t)(n) << 16)
+#  define MMC_CMDQ_MAXBLOCKS    0xffff
+#  define MMC_CMD13_SQS         (1 << 15)
+#  define MMC_CMD48_DISCARD     1
+
+#  define MMCSD_CMDQ_BLOCKS     MIN(MMCSD_MULTIBLOCK_LIMIT, MMC_CMDQ_MAXBLOCKS)
+#endif
+
 #ifdef CONFIG_BOARD_COREDUMP_BLKDEV
 #  define MMCSD_USLEEP(usec) \
     do \
@@ -125,6 +141,16 @@
  * Private Types
  ****************************************************************************/
 
+#ifdef CONFIG_MMCSD_CMDQ
+/* A task queued to the command queue of an eMMC */
+
+struct mmcsd_cmdq_task_s
+{
+  off_t  startblock;               /* The first block of the task */
+  size_t nblocks;                  /* The number of blocks of the task */
+};
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -191,6 +217,13 @@ static ssize_t mmcsd_writemultiple(FAR struct mmcsd_part_s *part,
                                    off_t startblock,
                                    size_t nblocks);
 #endif
+#ifdef CONFIG_MMCSD_CMDQ
+static int     mmcsd_cmdq_enable(FAR struct mmcsd_state_s *priv,
+                                 bool enable);
+static ssize_t mmcsd_cmdq_transfer(FAR struct mmcsd_part_s *part,
+                                   FAR uint8_t *buffer, off_t startblock,
+                                   size_t nblocks, bool write);
+#endif
 
 /* Block driver methods *****************************************************/
 
@@ -2256,6 +2289,351 @@ static ssize_t mmcsd_writemultiple(FAR struct mmcsd_part_s *part,
 }
 #endif
 
+#ifdef CONFIG_MMCSD_CMDQ
+/****************************************************************************
+ * Name: mmcsd_cmdq_enable
+ *
+ * Description:
+ *   Enable or disable the command queue of an eMMC.  The legacy data
+ *   transfer commands are not accepted while the queue is enabled, and the
+ *   queue only serves the user data area.
+ *
+ ****************************************************************************/
+
+static int mmcsd_cmdq_enable(FAR struct mmcsd_state_s *priv, bool enable)
+{
+  int ret;
+
+  if (priv->cmdqdepth == 0 || priv->cmdqon == enable)
+    {
+      return OK;
+    }
+
+  ret = mmcsd_switch(priv, MMC_CMD6_MODE(MMC_CMD6_MODE_WRITE_BYTE) |
+                           MMC_CMD6_INDEX(MMCSD_EXTCSD_CMDQ_MODE_EN) |
+                           MMC_CMD6_VALUE(enable));
+  if (ret != OK)
+    {
+      ferr("ERROR: mmcsd_switch for CMDQ_MODE_EN failed: %d\n", ret);
+      return ret;
+    }
+
+  priv->cmdqon = enable;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mmcsd_cmdq_queue
+ *
+ * Description:
+ *   Queue a task with CMD44 (QUEUED_TASK_PARAMS) and CMD45
+ *   (QUEUED_TASK_ADDRESS).  Both are commands without data, so the card
+ *   receives the next tasks while the data of the current one transfers and
+ *   prepares them meanwhile.
+ *
+ ****************************************************************************/
+
+static int mmcsd_cmdq_queue(FAR struct mmcsd_state_s *priv, int taskid,
+                            off_t startblock, size_t nblocks, bool write)
+{
+  int ret;
+
+  mmcsd_sendcmdpoll(priv, MMC_CMD44, (write ? 0 : MMC_CMDQ_READ) |
+                                     MMC_CMDQ_TASKID(taskid) | nblocks);
+  ret = mmcsd_recv_r1(priv, MMC_CMD44);
+  if (ret != OK)
+    {
+      ferr("ERROR: mmcsd_recv_r1 for CMD44 failed: %d\n", ret);
+      return ret;
+    }
+
+  mmcsd_sendcmdpoll(priv, MMC_CMD45, startblock);
+  ret = mmcsd_recv_r1(priv, MMC_CMD45);
+  if (ret != OK)
+    {
+      ferr("ERROR: mmcsd_recv_r1 for CMD45 failed: %d\n", ret);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mmcsd_cmdq_ready
+ *
+ * Description:
+ *   Wait for one of the 'queued' tasks to be ready for execution, as
+ *   reported by the Queue Status Register.
+ *
+ ****************************************************************************/
+
+static int mmcsd_cmdq_ready(FAR struct mmcsd_state_s *priv,
+                            uint32_t queued, FAR uint32_t *ready)
+{
+  clock_t starttime;
+  uint32_t qsr;
+  int ret;
+
+  starttime = clock_systime_ticks();
+  do
+    {
+      mmcsd_sendcmdpoll(priv, MMCSD_CMD13,
+                        ((uint32_t)priv->rca << 16) | MMC_CMD13_SQS);
+      ret = SDIO_RECVR1(priv->dev, MMCSD_CMD13, &qsr);
+      if (ret != OK)
+        {
+          ferr("ERROR: SDIO_RECVR1 for the QSR failed: %d\n", ret);
+          return ret;
+        }
+
+      if ((qsr & queued) != 0)
+        {
+          *ready = qsr & queued;
+          return OK;
+        }
+
+#ifdef CONFIG_MMCSD_CHECK_READY_STATUS_WITHOUT_SLEEP
+      sched_yield();
+#else
+      MMCSD_USLEEP(100);
+#endif
+    }
+  while (clock_systime_ticks() - starttime < TICK_PER_SEC);
+
+  return -ETIMEDOUT;
+}
+
+/****************************************************************************
+ * Name: mmcsd_cmdq_execute
+ *
+ * Description:
+ *   Transfer the data of a ready task with CMD46 (EXECUTE_READ_TASK) or
+ *   CMD47 (EXECUTE_WRITE_TASK).
+ *
+ ****************************************************************************/
+
+static int mmcsd_cmdq_execute(FAR struct mmcsd_state_s *priv, int taskid,
+                              FAR uint8_t *buffer, size_t nblocks,
+                              bool write)
+{
+  size_t nbytes = nblocks << priv->blockshift;
+  uint32_t cmd = write ? MMC_CMD47 : MMC_CMD46;
+  bool early = !write || (priv->caps & SDIO_CAPS_DMABEFOREWRITE) == 0;
+  int ret;
+
+  /* A write must wait for the end of the programming of the previous one */
+
+  ret = mmcsd_transferready(priv);
+  if (ret != OK)
+    {
+      ferr("ERROR: Card not ready: %d\n", ret);
+      return ret;
+    }
+
+  if (write && early)
+    {
+      mmcsd_sendcmdpoll(priv, cmd, MMC_CMDQ_TASKID(taskid));
+      ret = mmcsd_recv_r1(priv, cmd);
+      if (ret != OK)
+        {
+          ferr("ERROR: mmcsd_recv_r1 for CMD47 failed: %d\n", ret);
+          return ret;
+        }
+    }
+
+  SDIO_BLOCKSETUP(priv->dev, priv->blocksize, nblocks);
+  SDIO_WAITENABLE(priv->dev,
+                  SDIOWAIT_TRANSFERDONE | SDIOWAIT_TIMEOUT | SDIOWAIT_ERROR,
+                  nblocks * (write ? MMCSD_BLOCK_WDATADELAY :
+                                     MMCSD_BLOCK_RDATADELAY));
+
+#ifdef CONFIG_SDIO_DMA
+  if ((priv->caps & SDIO_CAPS_DMASUPPORTED) != 0)
+    {
+      ret = write ? SDIO_DMASENDSETUP(priv->dev, buffer, nbytes) :
+                    SDIO_DMARECVSETUP(priv->dev, buffer, nbytes);
+      if (ret != OK)
+        {
+          ferr("ERROR: DMA setup failed: %d\n", ret);
+          SDIO_CANCEL(priv->dev);
+          return ret;
+        }
+    }
+  else
+#endif
+  if (write)
+    {
+      SDIO_SENDSETUP(priv->dev, buffer, nbytes);
+    }
+  else
+    {
+      SDIO_RECVSETUP(priv->dev, buffer, nbytes);
+    }
+
+  if (!write || !early)
+    {
+      mmcsd_sendcmdpoll(priv, cmd, MMC_CMDQ_TASKID(taskid));
+      ret = mmcsd_recv_r1(priv, cmd);
+      if (ret != OK)
+        {
+          ferr("ERROR: mmcsd_recv_r1 for CMD%d failed: %d\n",
+               write ? 47 : 46, ret);
+          SDIO_CANCEL(priv->dev);
+          return ret;
+        }
+    }
+
+  ret = mmcsd_eventwait(priv, SDIOWAIT_TIMEOUT | SDIOWAIT_ERROR);
+  if (ret != OK)
+    {
+      ferr("ERROR: CMD%d transfer failed: %d\n", write ? 47 : 46, ret);
+      return ret;
+    }
+
+  if (write)
+    {
+      priv->wrbusy = true;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mmcsd_cmdq_transfer
+ *
+ * Description:
+ *   Read or write the user data area of an eMMC through its command queue:
+ *   The transfer is split into tasks that are queued ahead, up to the depth
+ *   of the queue, and executed as the card reports them ready.
+ *
+ ****************************************************************************/
+
+static ssize_t mmcsd_cmdq_transfer(FAR struct mmcsd_part_s *part,
+                                   FAR uint8_t *buffer, off_t startblock,
+                                   size_t nblocks, bool write)
+{
+  FAR struct mmcsd_state_s *priv = part->priv;
+  struct mmcsd_cmdq_task_s task[CONFIG_MMCSD_CMDQ_DEPTH];
+  int depth = MIN(priv->cmdqdepth, CONFIG_MMCSD_CMDQ_DEPTH);
+  uint32_t queued = 0;
+  uint32_t ready;
+  off_t next = startblock;
+  off_t end = startblock + nblocks;
+  int taskid;
+  int ret;
+
+  if (write ? mmcsd_wrprotected(priv) : priv->locked)
+    {
+      ferr("ERROR: Card is locked or write protected\n");
+      return -EPERM;
+    }
+
+#if defined(CONFIG_SDIO_DMA) && defined(CONFIG_ARCH_HAVE_SDIO_PREFLIGHT)
+  if ((priv->caps & SDIO_CAPS_DMASUPPORTED) != 0)
+    {
+      ret = SDIO_DMAPREFLIGHT(priv->dev, buffer,
+                              nblocks << priv->blockshift);
+      if (ret != OK)
+        {
+          return ret;
+        }
+    }
+#endif
+
+  /* The queue serves the user data area only */
+
+  if (priv->partnum != 0)
+    {
+      ret = mmcsd_switch(priv, MMC_CMD6_MODE(MMC_CMD6_MODE_WRITE_BYTE) |
+                               MMC_CMD6_INDEX(EXT_CSD_PART_CONF) |
+                               MMC_CMD6_VALUE(0));
+      if (ret != OK)
+        {
+          ferr("ERROR: mmcsd_switch failed: %d\n", ret);
+          return ret;
+        }
+
+      priv->partnum = 0;
+    }
+
+  ret = mmcsd_cmdq_enable(priv, true);
+  if (ret != OK)
+    {
+      return ret;
+    }
+
+  ret = mmcsd_setblocklen(priv, priv->blocksize);
+  if (ret != OK)
+    {
+      ferr("ERROR: mmcsd_setblocklen failed: %d\n", ret);
+      return ret;
+    }
+
+  while (next < end || queued != 0)
+    {
+      /* Fill the free slots of the queue */
+
+      for (taskid = 0; taskid < depth && next < end; taskid++)
+        {
+          if ((queued & (1 << taskid)) != 0)
+            {
+              continue;
+            }
+
+          task[taskid].startblock = next;
+          task[taskid].nblocks    = MIN(end - next, MMCSD_CMDQ_BLOCKS);
+
+          ret = mmcsd_cmdq_queue(priv, taskid, next, task[taskid].nblocks,
+                                 write);
+          if (ret != OK)
+            {
+              goto errout;
+            }
+
+          queued |= 1 << taskid;
+          next   += task[taskid].nblocks;
+        }
+
+      /* Then execute one of the tasks that are ready */
+
+      ret = mmcsd_cmdq_ready(priv, queued, &ready);
+      if (ret != OK)
+        {
+          goto errout;
+        }
+
+      taskid = ffs(ready) - 1;
+      ret = mmcsd_cmdq_execute(priv, taskid,
+                               buffer + ((task[taskid].startblock -
+                                          startblock) << priv->blockshift),
+                               task[taskid].nblocks, write);
+      if (ret != OK)
+        {
+          goto errout;
+        }
+
+      queued &= ~(1 << taskid);
+    }
+
+#if defined(CONFIG_MMCSD_SDIOWAIT_WRCOMPLETE)
+  if (write)
+    {
+      SDIO_WAITENABLE(priv->dev, SDIOWAIT_WRCOMPLETE | SDIOWAIT_TIMEOUT,
+                      task[taskid].nblocks * MMCSD_BLOCK_WDATADELAY);
+    }
+#endif
+
+  return nblocks;
+
+errout:
+
+  /* Discard the tasks that are still queued */
+
+  mmcsd_sendcmdpoll(priv, MMC_CMD48, MMC_CMD48_DISCARD);
+  mmcsd_recv_r1(priv, MMC_CMD48);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: mmcsd_open
  *
@@ -2355,6 +2733,23 @@ static ssize_t mmcsd_read(FAR struct inode *inode, unsigned char *buffer,
           return ret;
         }
 
+#ifdef CONFIG_MMCSD_CMDQ
+      if (priv->cmdqdepth > 0 && part == &priv->part[0])
+        {
+          ret = mmcsd_cmdq_transfer(part, buffer, startsector, nsectors,
+                                    false);
+          mmcsd_unlock(priv);
+          return ret;
+        }
+
+      ret = mmcsd_cmdq_enable(priv, false);
+      if (ret < 0)
+        {
+          mmcsd_unlock(priv);
+          return ret;
+        }
+#endif
+
       ret = nsectors;
       endsector = startsector + nsectors;
       for (sector = startsector; sector < endsector; sector += nread)
@@ -2436,6 +2831,23 @@ static ssize_t mmcsd_write(FAR struct inode *inode,
           return ret;
         }
 
+#ifdef CONFIG_MMCSD_CMDQ
+      if (priv->cmdqdepth > 0 && part == &priv->part[0])
+        {
+          ret = mmcsd_cmdq_transfer(part, (FAR uint8_t *)buffer,
+                                    startsector, nsectors, true);
+          mmcsd_unlock(priv);
+          return ret;
+        }
+
+      ret = mmcsd_cmdq_enable(priv, false);
+      if (ret < 0)
+        {
+          mmcsd_unlock(priv);
+          return ret;
+        }
+#endif
+
       ret = nsectors;
       endsector = startsector + nsectors;
       for (sector = startsector; sector < endsector; sector += nwrite)
@@ -2903,6 +3315,16 @@ static void mmcsd_decode_extcsd(FAR struct mmcsd_state_s *priv,
   finfo("MMC ext CSD read succsesfully, number of block %" PRIuOFF "\n",
                                                 priv->part[0].nblocks);
 
+#ifdef CONFIG_MMCSD_CMDQ
+  /* The command queue of eMMC 5.1 and its depth */
+
+  if ((extcsd[MMCSD_EXTCSD_CMDQ_SUPPORT] & MMCSD_CMDQ_SUPPORTED) != 0)
+    {
+      priv->cmdqdepth = (extcsd[MMCSD_EXTCSD_CMDQ_DEPTH] & 0x1f) + 1;
+      finfo("Command queue of depth %d\n", priv->cmdqdepth);
+    }
+#endif
+
   if (extcsd[MMCSD_EXTCSD_PARTITION_SUPPORT] & MMCSD_PART_SUPPORT_PART_EN)
     {
       /* Boot partition size = 128KB byte x BOOT_SIZE_MULT */
@@ -2963,6 +3385,13 @@ static int mmcsd_mmcinitialize(FAR struct mmcsd_state_s *priv)
   uint8_t extcsd[512] aligned_data(16);
   int ret;
 
+#ifdef CONFIG_MMCSD_CMDQ
+  /* The command queue is disabled by the reset of the card */
+
+  priv->cmdqdepth = 0;
+  priv->cmdqon    = false;
+#endif
+
   /* At this point, slow, ID mode clocking has been supplied to the card
    * and CMD0 has been sent successfully. CMD1 succeeded and ACMD41 failed
    * so there is good evidence that we have an MMC card inserted into the
@@ -3520,6 +3949,16 @@ static int mmcsd_iocmd(FAR struct mmcsd_part_s *part,
 
   DEBUGASSERT(priv != NULL && ic_ptr != NULL);
 
+#ifdef CONFIG_MMCSD_CMDQ
+  /* The commands of the applications expect the legacy mode */
+
+  ret = mmcsd_cmdq_enable(priv, false);
+  if (ret != OK)
+    {
+      return ret;
+    }
+#endif
+
   opcode = ic_ptr->opcode & MMCSD_CMDIDX_MASK;
   switch (opcode)
     {
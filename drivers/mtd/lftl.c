@@ -0,0 +1,1507 @@
+/****************************************************************************
+ * drivers/mtd/lftl.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* A log-structured flash translation layer with a page-level mapping.
+ *
+ * The logical sectors are the read/write blocks (pages) of the MTD device.
+ * A write never updates a page in place:  The sector is appended to the
+ * open erase block and the map is updated, the previous copy becomes
+ * stale.  The erase blocks with the fewest valid pages are reclaimed by
+ * the garbage collection, which copies their valid pages to the open
+ * block.
+ *
+ * Each erase block holds:
+ *
+ *   - A header in its first page, with a sequence number and the erase
+ *     count of the block.
+ *   - The data pages.
+ *   - A summary in its last pages, written when the block is full, with
+ *     the logical sector of each data page.
+ *
+ * A sync writes the summary of the data pages written so far in the next
+ * pages of the open block, a checkpoint.  The map is rebuilt when the
+ * device is registered from the summaries, or the last checkpoint of the
+ * blocks without a summary, by increasing sequence number.  The data
+ * written after the last checkpoint is lost on a power failure.
+ *
+ * The erase blocks are only erased when they are reused:  A reclaimed
+ * block keeps its header, and so its erase count, until then.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/crc32.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/lib/lib.h>
+#include <nuttx/mtd/mtd.h>
+#include <nuttx/drivers/rwbuffer.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LFTL_MAGIC_HEADER   0x4c46544c      /* "LFTL" */
+#define LFTL_MAGIC_SUMMARY  0x4c465353      /* "LFSS" */
+#define LFTL_NONE           UINT32_MAX      /* Unmapped sector, no block */
+
+/* The states of the erase blocks */
+
+#define LFTL_BLOCK_FREE     0               /* May be erased and reused */
+#define LFTL_BLOCK_OPEN     1               /* Receives the new pages */
+#define LFTL_BLOCK_CLOSED   2               /* Holds valid pages */
+#define LFTL_BLOCK_STALE    3               /* No valid page, see below */
+#define LFTL_BLOCK_BAD      4               /* Never used */
+
+/* A block without valid page is only free once the map that superseded
+ * its pages is on the flash, i.e. after the next checkpoint or summary.
+ */
+
+#define LFTL_SUMMARY_SIZE(n) (offsetof(struct lftl_summary_s, entries) + \
+                              (n) * sizeof(uint32_t))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The header in the first page of an erase block */
+
+begin_packed_struct struct lftl_header_s
+{
+  uint32_t magic;                   /* LFTL_MAGIC_HEADER */
+  uint32_t crc;                     /* CRC-32 of the fields below */
+  uint32_t seq;                     /* Sequence number of the block */
+  uint32_t erasecnt;                /* Erase count of the block */
+} end_packed_struct;
+
+/* The summary of the data pages of an erase block */
+
+begin_packed_struct struct lftl_summary_s
+{
+  uint32_t magic;                   /* LFTL_MAGIC_SUMMARY */
+  uint32_t crc;                     /* CRC-32 of the fields below */
+  uint32_t seq;                     /* Sequence number of the block */
+  uint32_t nentries;                /* Number of data pages */
+  uint32_t entries[1];              /* Logical sector of each data page */
+} end_packed_struct;
+
+/* The state of an erase block */
+
+struct lftl_block_s
+{
+  uint32_t seq;                     /* Sequence number of the block */
+  uint32_t erasecnt;                /* Erase count of the block */
+  uint16_t nvalid;                  /* Number of valid data pages */
+  uint8_t  state;                   /* LFTL_BLOCK_* */
+};
+
+/* Used to sort the erase blocks by sequence number */
+
+struct lftl_order_s
+{
+  uint32_t seq;
+  uint32_t block;
+};
+
+struct lftl_dev_s
+{
+  FAR struct mtd_dev_s *mtd;        /* Contained MTD interface */
+  struct mtd_geometry_s geo;        /* Device geometry */
+#ifdef CONFIG_LFTL_WRITEBUFFER
+  struct rwbuffer_s     rwb;        /* Write buffer support */
+#endif
+#ifdef CONFIG_LFTL_BACKGROUND_GC
+  struct work_s         work;       /* Background garbage collection */
+#endif
+  mutex_t               lock;       /* Protects the fields below */
+  uint16_t              blkper;     /* R/W blocks per erase block */
+  uint16_t              ndata;      /* Data pages per erase block */
+  uint16_t              nsum;       /* Summary pages per erase block */
+  uint16_t              next;       /* Next data page of the open block */
+  uint16_t              refs;       /* Number of references */
+  bool                  unlinked;   /* The driver has been unlinked */
+  bool                  dirty;      /* Pages written since the last
+                                     * checkpoint */
+  uint32_t              nsectors;   /* Number of logical sectors */
+  uint32_t              nfree;      /* Number of free erase blocks */
+  uint32_t              nstale;     /* Number of stale erase blocks */
+  uint32_t              seq;        /* Last sequence number */
+  uint32_t              open;       /* The open erase block, or LFTL_NONE */
+  FAR uint32_t         *map;        /* Physical page of each sector */
+  FAR struct lftl_block_s *blocks;  /* State of each erase block */
+  FAR struct lftl_summary_s *sum;   /* Summary of the open block */
+  FAR uint8_t          *pagebuf;    /* Read and copy buffer */
+  FAR uint8_t          *hdrbuf;     /* Header buffer */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     lftl_open(FAR struct inode *inode);
+static int     lftl_close(FAR struct inode *inode);
+static ssize_t lftl_read(FAR struct inode *inode, FAR unsigned char *buffer,
+                         blkcnt_t start_sector, unsigned int nsectors);
+static ssize_t lftl_write(FAR struct inode *inode,
+                          FAR const unsigned char *buffer,
+                          blkcnt_t start_sector, unsigned int nsectors);
+static int     lftl_geometry(FAR struct inode *inode,
+                             FAR struct geometry *geometry);
+static int     lftl_ioctl(FAR struct inode *inode, int cmd,
+                          unsigned long arg);
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+static int     lftl_unlink(FAR struct inode *inode);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct block_operations g_lftl_bops =
+{
+  lftl_open,     /* open     */
+  lftl_close,    /* close    */
+  lftl_read,     /* read     */
+  lftl_write,    /* write    */
+  lftl_geometry, /* geometry */
+  lftl_ioctl     /* ioctl    */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , lftl_unlink  /* unlink   */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lftl_summarycrc
+ *
+ * Description:
+ *   Return the CRC of the summary in 'sum'.
+ *
+ ****************************************************************************/
+
+static uint32_t lftl_summarycrc(FAR struct lftl_dev_s *dev,
+                                FAR const struct lftl_summary_s *sum)
+{
+  return crc32((FAR const uint8_t *)&sum->seq,
+               LFTL_SUMMARY_SIZE(dev->ndata) -
+               offsetof(struct lftl_summary_s, seq));
+}
+
+/****************************************************************************
+ * Name: lftl_erased
+ *
+ * Description:
+ *   Return true if the 'len' bytes of 'buf' are erased.
+ *
+ ****************************************************************************/
+
+static bool lftl_erased(FAR const uint8_t *buf, size_t len)
+{
+  while (len-- > 0)
+    {
+      if (*buf++ != 0xff)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: lftl_bread
+ *
+ * Description:
+ *   Read pages from the MTD device, ignoring the corrected ECC errors.
+ *
+ ****************************************************************************/
+
+static ssize_t lftl_bread(FAR struct lftl_dev_s *dev, off_t page,
+                          size_t npages, FAR uint8_t *buffer)
+{
+  ssize_t ret;
+
+  ret = MTD_BREAD(dev->mtd, page, npages, buffer);
+  if (ret == -EUCLEAN)
+    {
+      ret = npages;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: lftl_sweep
+ *
+ * Description:
+ *   Free the stale erase blocks once the map is on the flash.
+ *
+ ****************************************************************************/
+
+static void lftl_sweep(FAR struct lftl_dev_s *dev)
+{
+  uint32_t i;
+
+  for (i = 0; dev->nstale > 0 && i < dev->geo.neraseblocks; i++)
+    {
+      if (dev->blocks[i].state == LFTL_BLOCK_STALE)
+        {
+          dev->blocks[i].state = LFTL_BLOCK_FREE;
+          dev->nstale--;
+          dev->nfree++;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: lftl_unmap
+ *
+ * Description:
+ *   Forget the current copy of a logical sector.
+ *
+ ****************************************************************************/
+
+static void lftl_unmap(FAR struct lftl_dev_s *dev, uint32_t sector)
+{
+  FAR struct lftl_block_s *block;
+  uint32_t page = dev->map[sector];
+
+  if (page == LFTL_NONE)
+    {
+      return;
+    }
+
+  block = &dev->blocks[page / dev->blkper];
+  DEBUGASSERT(block->nvalid > 0);
+
+  dev->map[sector] = LFTL_NONE;
+  if (--block->nvalid == 0 && block->state == LFTL_BLOCK_CLOSED)
+    {
+      block->state = LFTL_BLOCK_STALE;
+      dev->nstale++;
+    }
+}
+
+/****************************************************************************
+ * Name: lftl_closeblock
+ *
+ * Description:
+ *   Write the summary of the open block in its last pages.
+ *
+ ****************************************************************************/
+
+static int lftl_closeblock(FAR struct lftl_dev_s *dev)
+{
+  FAR struct lftl_block_s *block = &dev->blocks[dev->open];
+  ssize_t ret;
+
+  dev->sum->crc = lftl_summarycrc(dev, dev->sum);
+  ret = MTD_BWRITE(dev->mtd, (off_t)(dev->open + 1) * dev->blkper -
+                   dev->nsum, dev->nsum, (FAR const uint8_t *)dev->sum);
+  if (ret < 0)
+    {
+      ferr("ERROR: Failed to write the summary of %" PRIu32 ": %zd\n",
+           dev->open, ret);
+      return ret;
+    }
+
+  if (block->nvalid > 0)
+    {
+      block->state = LFTL_BLOCK_CLOSED;
+    }
+  else
+    {
+      block->state = LFTL_BLOCK_STALE;
+      dev->nstale++;
+    }
+
+  dev->open  = LFTL_NONE;
+  dev->dirty = false;
+  lftl_sweep(dev);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lftl_checkpoint
+ *
+ * Description:
+ *   Write the summary of the data pages of the open block written so far
+ *   in its next pages, or close the block if they do not fit.
+ *
+ ****************************************************************************/
+
+static int lftl_checkpoint(FAR struct lftl_dev_s *dev)
+{
+  ssize_t ret;
+
+  if (dev->open == LFTL_NONE || !dev->dirty)
+    {
+      return OK;
+    }
+
+  if (dev->next + dev->nsum > dev->ndata)
+    {
+      return lftl_closeblock(dev);
+    }
+
+  dev->sum->crc = lftl_summarycrc(dev, dev->sum);
+  ret = MTD_BWRITE(dev->mtd, (off_t)dev->open * dev->blkper + 1 +
+                   dev->next, dev->nsum, (FAR const uint8_t *)dev->sum);
+  if (ret < 0)
+    {
+      /* Do not program these pages again, close the block instead */
+
+      ferr("ERROR: Failed to write a checkpoint of %" PRIu32 ": %zd\n",
+           dev->open, ret);
+      dev->next = dev->ndata;
+      return lftl_closeblock(dev);
+    }
+
+  dev->next += dev->nsum;
+  dev->dirty = false;
+  lftl_sweep(dev);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lftl_allocblock
+ *
+ * Description:
+ *   Close the open block and open the free block with the lowest erase
+ *   count.
+ *
+ ****************************************************************************/
+
+static int lftl_allocblock(FAR struct lftl_dev_s *dev)
+{
+  FAR struct lftl_header_s *hdr = (FAR struct lftl_header_s *)dev->hdrbuf;
+  FAR struct lftl_block_s *block;
+  uint32_t victim;
+  uint32_t i;
+  ssize_t ret;
+
+  if (dev->open != LFTL_NONE)
+    {
+      ret = lftl_closeblock(dev);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+  else
+    {
+      lftl_sweep(dev);
+    }
+
+  for (; ; )
+    {
+      victim = LFTL_NONE;
+      for (i = 0; i < dev->geo.neraseblocks; i++)
+        {
+          if (dev->blocks[i].state == LFTL_BLOCK_FREE &&
+              (victim == LFTL_NONE ||
+               dev->blocks[i].erasecnt < dev->blocks[victim].erasecnt))
+            {
+              victim = i;
+            }
+        }
+
+      if (victim == LFTL_NONE)
+        {
+          return -ENOSPC;
+        }
+
+      block = &dev->blocks[victim];
+      dev->nfree--;
+
+      ret = MTD_ERASE(dev->mtd, victim, 1);
+      if (ret >= 0)
+        {
+          memset(dev->hdrbuf, 0xff, dev->geo.blocksize);
+          hdr->magic    = LFTL_MAGIC_HEADER;
+          hdr->seq      = dev->seq + 1;
+          hdr->erasecnt = block->erasecnt + 1;
+          hdr->crc      = crc32((FAR const uint8_t *)&hdr->seq,
+                                sizeof(*hdr) -
+                                offsetof(struct lftl_header_s, seq));
+
+          ret = MTD_BWRITE(dev->mtd, (off_t)victim * dev->blkper, 1,
+                           dev->hdrbuf);
+        }
+
+      if (ret >= 0)
+        {
+          break;
+        }
+
+      ferr("ERROR: Erase block %" PRIu32 " failed: %zd\n", victim, ret);
+      MTD_MARKBAD(dev->mtd, victim);
+      block->state = LFTL_BLOCK_BAD;
+    }
+
+  block->seq      = ++dev->seq;
+  block->erasecnt = hdr->erasecnt;
+  block->nvalid   = 0;
+  block->state    = LFTL_BLOCK_OPEN;
+
+  memset(dev->sum, 0xff, (size_t)dev->nsum * dev->geo.blocksize);
+  dev->sum->magic    = LFTL_MAGIC_SUMMARY;
+  dev->sum->seq      = block->seq;
+  dev->sum->nentries = dev->ndata;
+
+  dev->open = victim;
+  dev->next = 0;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lftl_writepage
+ *
+ * Description:
+ *   Append a logical sector to the open block.
+ *
+ ****************************************************************************/
+
+static int lftl_writepage(FAR struct lftl_dev_s *dev, uint32_t sector,
+                          FAR const uint8_t *buffer)
+{
+  uint32_t page;
+  ssize_t ret;
+
+  if (dev->open == LFTL_NONE || dev->next >= dev->ndata)
+    {
+      ret = lftl_allocblock(dev);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  page = dev->open * dev->blkper + 1 + dev->next;
+  ret  = MTD_BWRITE(dev->mtd, page, 1, buffer);
+  if (ret < 0)
+    {
+      ferr("ERROR: Write page %" PRIu32 " failed: %zd\n", page, ret);
+      dev->next++;
+      return ret;
+    }
+
+  lftl_unmap(dev, sector);
+  dev->map[sector] = page;
+  dev->sum->entries[dev->next++] = sector;
+  dev->blocks[dev->open].nvalid++;
+  dev->dirty = true;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lftl_victim
+ *
+ * Description:
+ *   Return the closed block to reclaim:  The one with the fewest valid
+ *   pages, or the one with the lowest erase count if it is much less worn
+ *   than the others and there are enough free blocks to move its pages.
+ *
+ ****************************************************************************/
+
+static uint32_t lftl_victim(FAR struct lftl_dev_s *dev)
+{
+  FAR struct lftl_block_s *block;
+  uint32_t maxerase = 0;
+  uint32_t victim = LFTL_NONE;
+  uint32_t cold = LFTL_NONE;
+  uint32_t i;
+
+  for (i = 0; i < dev->geo.neraseblocks; i++)
+    {
+      block = &dev->blocks[i];
+      if (block->state == LFTL_BLOCK_BAD)
+        {
+          continue;
+        }
+
+      if (block->erasecnt > maxerase)
+        {
+          maxerase = block->erasecnt;
+        }
+
+      if (block->state != LFTL_BLOCK_CLOSED)
+        {
+          continue;
+        }
+
+      if (victim == LFTL_NONE || block->nvalid < dev->blocks[victim].nvalid)
+        {
+          victim = i;
+        }
+
+      if (cold == LFTL_NONE ||
+          block->erasecnt < dev->blocks[cold].erasecnt)
+        {
+          cold = i;
+        }
+    }
+
+  if (cold != LFTL_NONE && dev->nfree > CONFIG_LFTL_RESERVED_BLOCKS &&
+      maxerase - dev->blocks[cold].erasecnt > CONFIG_LFTL_WEAR_THRESHOLD)
+    {
+      return cold;
+    }
+
+  /* Reclaiming a block gains nothing if its pages fill another one */
+
+  if (victim != LFTL_NONE &&
+      dev->blocks[victim].nvalid + dev->nsum >= dev->ndata)
+    {
+      return LFTL_NONE;
+    }
+
+  return victim;
+}
+
+/****************************************************************************
+ * Name: lftl_collect
+ *
+ * Description:
+ *   Reclaim one erase block:  Copy its valid pages to the open block and
+ *   write a checkpoint so that it can be reused.
+ *
+ ****************************************************************************/
+
+static int lftl_collect(FAR struct lftl_dev_s *dev)
+{
+  FAR struct lftl_block_s *block;
+  uint32_t victim;
+  uint32_t sector;
+  ssize_t ret;
+
+  victim = lftl_victim(dev);
+  if (victim == LFTL_NONE)
+    {
+      return -ENOSPC;
+    }
+
+  finfo("Collect block %" PRIu32 " nvalid %u erasecnt %" PRIu32 "\n",
+        victim, dev->blocks[victim].nvalid, dev->blocks[victim].erasecnt);
+
+  block = &dev->blocks[victim];
+  for (sector = 0; sector < dev->nsectors && block->nvalid > 0; sector++)
+    {
+      if (dev->map[sector] == LFTL_NONE ||
+          dev->map[sector] / dev->blkper != victim)
+        {
+          continue;
+        }
+
+      ret = lftl_bread(dev, dev->map[sector], 1, dev->pagebuf);
+      if (ret < 0)
+        {
+          ferr("ERROR: Read page %" PRIu32 " failed: %zd\n",
+               dev->map[sector], ret);
+          return ret;
+        }
+
+      ret = lftl_writepage(dev, sector, dev->pagebuf);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  return lftl_checkpoint(dev);
+}
+
+/****************************************************************************
+ * Name: lftl_needgc
+ *
+ * Description:
+ *   Return true if the background garbage collection should run.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LFTL_BACKGROUND_GC
+static bool lftl_needgc(FAR struct lftl_dev_s *dev)
+{
+  return dev->nfree + dev->nstale < CONFIG_LFTL_GC_THRESHOLD;
+}
+
+/****************************************************************************
+ * Name: lftl_gcworker
+ *
+ * Description:
+ *   Reclaim an erase block from the work queue, once the device has been
+ *   idle for CONFIG_LFTL_GC_DELAY milliseconds.
+ *
+ ****************************************************************************/
+
+static void lftl_gcworker(FAR void *arg)
+{
+  FAR struct lftl_dev_s *dev = arg;
+  int ret;
+
+  nxmutex_lock(&dev->lock);
+  if (lftl_needgc(dev))
+    {
+      ret = lftl_collect(dev);
+      if (ret >= 0 && lftl_needgc(dev))
+        {
+          work_queue(LPWORK, &dev->work, lftl_gcworker, dev,
+                     MSEC2TICK(CONFIG_LFTL_GC_DELAY));
+        }
+    }
+
+  nxmutex_unlock(&dev->lock);
+}
+#endif
+
+/****************************************************************************
+ * Name: lftl_reload
+ *
+ * Description:
+ *   Read the specified number of sectors.  The sectors that were never
+ *   written, or discarded, read as erased.
+ *
+ ****************************************************************************/
+
+static ssize_t lftl_reload(FAR void *priv, FAR uint8_t *buffer,
+                           off_t startblock, size_t nblocks)
+{
+  FAR struct lftl_dev_s *dev = priv;
+  size_t nread = 0;
+  size_t count;
+  ssize_t ret = 0;
+
+  if (startblock < 0 || startblock >= dev->nsectors)
+    {
+      return -EINVAL;
+    }
+
+  if (nblocks > dev->nsectors - startblock)
+    {
+      nblocks = dev->nsectors - startblock;
+    }
+
+  nxmutex_lock(&dev->lock);
+  while (nread < nblocks)
+    {
+      FAR uint32_t *map = &dev->map[startblock + nread];
+
+      /* Read the physically contiguous sectors at once */
+
+      for (count = 1; count < nblocks - nread; count++)
+        {
+          if (map[0] == LFTL_NONE ? map[count] != LFTL_NONE :
+              map[count] != map[0] + count)
+            {
+              break;
+            }
+        }
+
+      if (map[0] == LFTL_NONE)
+        {
+          memset(buffer, 0xff, count * dev->geo.blocksize);
+        }
+      else
+        {
+          ret = lftl_bread(dev, map[0], count, buffer);
+          if (ret < 0)
+            {
+              ferr("ERROR: Read page %" PRIu32 " failed: %zd\n",
+                   map[0], ret);
+              break;
+            }
+        }
+
+      nread  += count;
+      buffer += count * dev->geo.blocksize;
+    }
+
+  nxmutex_unlock(&dev->lock);
+  return nread > 0 ? nread : ret;
+}
+
+/****************************************************************************
+ * Name: lftl_flush
+ *
+ * Description:
+ *   Write the specified number of sectors, reclaiming erase blocks first
+ *   if too few are left.
+ *
+ ****************************************************************************/
+
+static ssize_t lftl_flush(FAR void *priv, FAR const uint8_t *buffer,
+                          off_t startblock, size_t nblocks)
+{
+  FAR struct lftl_dev_s *dev = priv;
+  size_t nwritten = 0;
+  int ret = OK;
+
+  if (startblock < 0 || startblock >= dev->nsectors ||
+      nblocks > dev->nsectors - startblock)
+    {
+      return -EINVAL;
+    }
+
+  nxmutex_lock(&dev->lock);
+  while (nwritten < nblocks)
+    {
+      while (dev->nfree + dev->nstale < CONFIG_LFTL_RESERVED_BLOCKS)
+        {
+          ret = lftl_collect(dev);
+          if (ret < 0)
+            {
+              break;
+            }
+        }
+
+      ret = lftl_writepage(dev, startblock + nwritten, buffer);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      nwritten++;
+      buffer += dev->geo.blocksize;
+    }
+
+#ifdef CONFIG_LFTL_BACKGROUND_GC
+  if (lftl_needgc(dev))
+    {
+      work_queue(LPWORK, &dev->work, lftl_gcworker, dev,
+                 MSEC2TICK(CONFIG_LFTL_GC_DELAY));
+    }
+#endif
+
+  nxmutex_unlock(&dev->lock);
+  return nwritten > 0 ? nwritten : ret;
+}
+
+/****************************************************************************
+ * Name: lftl_sync
+ *
+ * Description:
+ *   Write the buffered sectors and a checkpoint.
+ *
+ ****************************************************************************/
+
+static int lftl_sync(FAR struct lftl_dev_s *dev)
+{
+  int ret;
+
+#ifdef CONFIG_LFTL_WRITEBUFFER
+  ret = rwb_flush(&dev->rwb);
+  if (ret < 0)
+    {
+      return ret;
+    }
+#endif
+
+  nxmutex_lock(&dev->lock);
+  ret = lftl_checkpoint(dev);
+  nxmutex_unlock(&dev->lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: lftl_discard
+ *
+ * Description:
+ *   Unmap a range of sectors that the file system no longer uses.  The
+ *   range is not recorded on the flash:  The sectors may read their old
+ *   data again after a reboot if their blocks were not reclaimed.
+ *
+ ****************************************************************************/
+
+static int lftl_discard(FAR struct lftl_dev_s *dev,
+                        FAR const struct blk_range_s *range)
+{
+  blkcnt_t sector;
+  int ret;
+
+  if (range == NULL || range->start > dev->nsectors ||
+      range->nsectors > dev->nsectors - range->start)
+    {
+      return -EINVAL;
+    }
+
+#ifdef CONFIG_LFTL_WRITEBUFFER
+  ret = rwb_flush(&dev->rwb);
+  if (ret < 0)
+    {
+      return ret;
+    }
+#endif
+
+  ret = nxmutex_lock(&dev->lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (sector = range->start; sector < range->start + range->nsectors;
+       sector++)
+    {
+      lftl_unmap(dev, sector);
+    }
+
+  nxmutex_unlock(&dev->lock);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lftl_free
+ *
+ * Description:
+ *   Release the device once it is closed and unlinked.
+ *
+ ****************************************************************************/
+
+static void lftl_free(FAR struct lftl_dev_s *dev)
+{
+#ifdef CONFIG_LFTL_BACKGROUND_GC
+  work_cancel_sync(LPWORK, &dev->work);
+#endif
+#ifdef CONFIG_LFTL_WRITEBUFFER
+  rwb_uninitialize(&dev->rwb);
+#endif
+  nxmutex_destroy(&dev->lock);
+  kmm_free(dev->map);
+  kmm_free(dev->blocks);
+  kmm_free(dev->sum);
+  kmm_free(dev->pagebuf);
+  kmm_free(dev);
+}
+
+/****************************************************************************
+ * Name: lftl_readsummary
+ *
+ * Description:
+ *   Read the summary at 'page' into the summary buffer and check it.
+ *
+ ****************************************************************************/
+
+static int lftl_readsummary(FAR struct lftl_dev_s *dev, off_t page,
+                            uint32_t seq)
+{
+  FAR struct lftl_summary_s *sum = dev->sum;
+  ssize_t ret;
+
+  ret = lftl_bread(dev, page, dev->nsum, (FAR uint8_t *)sum);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (sum->magic != LFTL_MAGIC_SUMMARY || sum->seq != seq ||
+      sum->nentries != dev->ndata || sum->crc != lftl_summarycrc(dev, sum))
+    {
+      return -EINVAL;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lftl_loadblock
+ *
+ * Description:
+ *   Add the data pages of an erase block to the map, from its summary, or
+ *   from its last checkpoint if it was not closed.  Such a block is closed
+ *   now if its last pages are still erased.
+ *
+ ****************************************************************************/
+
+static void lftl_loadblock(FAR struct lftl_dev_s *dev, uint32_t block)
+{
+  FAR const struct lftl_summary_s *sum;
+  off_t first = (off_t)block * dev->blkper + 1;
+  off_t last = -1;
+  uint32_t seq = dev->blocks[block].seq;
+  uint16_t i;
+
+  if (lftl_readsummary(dev, first + dev->ndata, seq) < 0)
+    {
+      /* Look for the last checkpoint */
+
+      sum = (FAR const struct lftl_summary_s *)dev->pagebuf;
+      for (i = 0; i + dev->nsum <= dev->ndata; i++)
+        {
+          if (lftl_bread(dev, first + i, 1, dev->pagebuf) >= 0 &&
+              sum->magic == LFTL_MAGIC_SUMMARY && sum->seq == seq &&
+              lftl_readsummary(dev, first + i, seq) >= 0)
+            {
+              last = first + i;
+              i += dev->nsum - 1;
+            }
+        }
+
+      if (last < 0 || lftl_readsummary(dev, last, seq) < 0)
+        {
+          return;
+        }
+
+      for (i = 0; i < dev->nsum; i++)
+        {
+          if (lftl_bread(dev, first + dev->ndata + i, 1, dev->pagebuf) < 0 ||
+              !lftl_erased(dev->pagebuf, dev->geo.blocksize))
+            {
+              break;
+            }
+        }
+
+      if (i == dev->nsum)
+        {
+          MTD_BWRITE(dev->mtd, first + dev->ndata, dev->nsum,
+                     (FAR const uint8_t *)dev->sum);
+        }
+    }
+
+  for (i = 0; i < dev->ndata; i++)
+    {
+      if (dev->sum->entries[i] < dev->nsectors)
+        {
+          dev->map[dev->sum->entries[i]] = first + i;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: lftl_compare
+ ****************************************************************************/
+
+static int lftl_compare(FAR const void *a, FAR const void *b)
+{
+  FAR const struct lftl_order_s *oa = a;
+  FAR const struct lftl_order_s *ob = b;
+
+  return oa->seq < ob->seq ? -1 : oa->seq > ob->seq;
+}
+
+/****************************************************************************
+ * Name: lftl_mount
+ *
+ * Description:
+ *   Rebuild the map and the state of the erase blocks from the flash.
+ *
+ ****************************************************************************/
+
+static int lftl_mount(FAR struct lftl_dev_s *dev)
+{
+  FAR struct lftl_header_s *hdr = (FAR struct lftl_header_s *)dev->pagebuf;
+  FAR struct lftl_order_s *order;
+  FAR struct lftl_block_s *block;
+  uint32_t nused = 0;
+  uint32_t i;
+
+  order = kmm_malloc(dev->geo.neraseblocks * sizeof(*order));
+  if (order == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memset(dev->map, 0xff, dev->nsectors * sizeof(uint32_t));
+
+  for (i = 0; i < dev->geo.neraseblocks; i++)
+    {
+      block = &dev->blocks[i];
+      block->state = LFTL_BLOCK_FREE;
+      if (MTD_ISBAD(dev->mtd, i) > 0)
+        {
+          block->state = LFTL_BLOCK_BAD;
+          continue;
+        }
+
+      if (lftl_bread(dev, (off_t)i * dev->blkper, 1, dev->pagebuf) >= 0 &&
+          hdr->magic == LFTL_MAGIC_HEADER &&
+          hdr->crc == crc32((FAR const uint8_t *)&hdr->seq,
+                            sizeof(*hdr) -
+                            offsetof(struct lftl_header_s, seq)))
+        {
+          block->seq      = hdr->seq;
+          block->erasecnt = hdr->erasecnt;
+          block->state    = LFTL_BLOCK_CLOSED;
+          if (hdr->seq > dev->seq)
+            {
+              dev->seq = hdr->seq;
+            }
+
+          order[nused].seq   = hdr->seq;
+          order[nused].block = i;
+          nused++;
+        }
+    }
+
+  /* The newer copies of the sectors replace the older ones */
+
+  qsort(order, nused, sizeof(*order), lftl_compare);
+  for (i = 0; i < nused; i++)
+    {
+      lftl_loadblock(dev, order[i].block);
+    }
+
+  kmm_free(order);
+
+  for (i = 0; i < dev->nsectors; i++)
+    {
+      if (dev->map[i] != LFTL_NONE)
+        {
+          dev->blocks[dev->map[i] / dev->blkper].nvalid++;
+        }
+    }
+
+  for (i = 0; i < dev->geo.neraseblocks; i++)
+    {
+      block = &dev->blocks[i];
+      if (block->state == LFTL_BLOCK_CLOSED && block->nvalid == 0)
+        {
+          block->state = LFTL_BLOCK_FREE;
+        }
+
+      if (block->state == LFTL_BLOCK_FREE)
+        {
+          dev->nfree++;
+        }
+    }
+
+  finfo("%" PRIu32 " sectors, %" PRIu32 " free blocks, seq %" PRIu32 "\n",
+        dev->nsectors, dev->nfree, dev->seq);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lftl_open
+ *
+ * Description: Open the block device
+ *
+ ****************************************************************************/
+
+static int lftl_open(FAR struct inode *inode)
+{
+  FAR struct lftl_dev_s *dev;
+
+  DEBUGASSERT(inode->i_private);
+  dev = inode->i_private;
+  nxmutex_lock(&dev->lock);
+  dev->refs++;
+  nxmutex_unlock(&dev->lock);
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lftl_close
+ *
+ * Description: Close the block device, the last close writes a checkpoint
+ *
+ ****************************************************************************/
+
+static int lftl_close(FAR struct inode *inode)
+{
+  FAR struct lftl_dev_s *dev;
+
+  DEBUGASSERT(inode->i_private);
+  dev = inode->i_private;
+
+  nxmutex_lock(&dev->lock);
+  dev->refs--;
+  nxmutex_unlock(&dev->lock);
+
+  if (dev->refs == 0)
+    {
+      lftl_sync(dev);
+      if (dev->unlinked)
+        {
+          lftl_free(dev);
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lftl_read
+ *
+ * Description: Read the specified number of sectors
+ *
+ ****************************************************************************/
+
+static ssize_t lftl_read(FAR struct inode *inode, FAR unsigned char *buffer,
+                         blkcnt_t start_sector, unsigned int nsectors)
+{
+  FAR struct lftl_dev_s *dev;
+
+  DEBUGASSERT(inode->i_private);
+  dev = inode->i_private;
+
+#ifdef CONFIG_LFTL_WRITEBUFFER
+  return rwb_read(&dev->rwb, start_sector, nsectors, buffer);
+#else
+  return lftl_reload(dev, buffer, start_sector, nsectors);
+#endif
+}
+
+/****************************************************************************
+ * Name: lftl_write
+ *
+ * Description: Write (or buffer) the specified number of sectors
+ *
+ ****************************************************************************/
+
+static ssize_t lftl_write(FAR struct inode *inode,
+                          FAR const unsigned char *buffer,
+                          blkcnt_t start_sector, unsigned int nsectors)
+{
+  FAR struct lftl_dev_s *dev;
+
+  DEBUGASSERT(inode->i_private);
+  dev = inode->i_private;
+
+#ifdef CONFIG_LFTL_WRITEBUFFER
+  return rwb_write(&dev->rwb, start_sector, nsectors, buffer);
+#else
+  return lftl_flush(dev, buffer, start_sector, nsectors);
+#endif
+}
+
+/****************************************************************************
+ * Name: lftl_geometry
+ *
+ * Description: Return device geometry
+ *
+ ****************************************************************************/
+
+static int lftl_geometry(FAR struct inode *inode,
+                         FAR struct geometry *geometry)
+{
+  FAR struct lftl_dev_s *dev;
+
+  DEBUGASSERT(inode->i_private);
+  dev = inode->i_private;
+
+  if (geometry == NULL)
+    {
+      return -EINVAL;
+    }
+
+  memset(geometry, 0, sizeof(*geometry));
+  geometry->geo_available    = true;
+  geometry->geo_writeenabled = true;
+  geometry->geo_nsectors     = dev->nsectors;
+  geometry->geo_sectorsize   = dev->geo.blocksize;
+  strlcpy(geometry->geo_model, dev->geo.model, sizeof(geometry->geo_model));
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lftl_ioctl
+ *
+ * Description: Return device geometry
+ *
+ ****************************************************************************/
+
+static int lftl_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
+{
+  FAR struct lftl_dev_s *dev;
+  int ret;
+
+  DEBUGASSERT(inode->i_private);
+  dev = inode->i_private;
+
+  switch (cmd)
+    {
+      case BIOC_FLUSH:
+        ret = lftl_sync(dev);
+        if (ret < 0)
+          {
+            return ret;
+          }
+        break;
+
+      case BIOC_DISCARD:
+        return lftl_discard(dev, (FAR const struct blk_range_s *)
+                                 (uintptr_t)arg);
+
+      default:
+        break;
+    }
+
+  /* No other block driver ioctl commands are not recognized by this
+   * driver.  Other possible MTD driver ioctl commands are passed through
+   * to the MTD driver (unchanged).
+   */
+
+  ret = MTD_IOCTL(dev->mtd, cmd, arg);
+  if (ret < 0 && ret != -ENOTTY)
+    {
+      ferr("ERROR: MTD ioctl(%04x) failed: %d\n", cmd, ret);
+    }
+
+  if (cmd == BIOC_FLUSH && ret == -ENOTTY)
+    {
+      ret = OK;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: lftl_unlink
+ *
+ * Description: Unlink the device
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+static int lftl_unlink(FAR struct inode *inode)
+{
+  FAR struct lftl_dev_s *dev;
+
+  DEBUGASSERT(inode->i_private);
+  dev = inode->i_private;
+
+  nxmutex_lock(&dev->lock);
+  dev->unlinked = true;
+  nxmutex_unlock(&dev->lock);
+
+  if (dev->refs == 0)
+    {
+      lftl_free(dev);
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lftl_initialize_by_path
+ *
+ * Description:
+ *   Initialize to provide a log-structured block driver wrapper around an
+ *   MTD interface
+ *
+ * Input Parameters:
+ *   path - The block device path.
+ *   mtd  - The MTD device that supports the FLASH interface.
+ *
+ ****************************************************************************/
+
+int lftl_initialize_by_path(FAR const char *path, FAR struct mtd_dev_s *mtd)
+{
+  FAR struct lftl_dev_s *dev;
+  uint32_t nblocks;
+  size_t sumsize;
+  int ret;
+
+  /* Sanity check */
+
+  if (path == NULL || mtd == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* Allocate a LFTL device structure */
+
+  dev = kmm_zalloc(sizeof(struct lftl_dev_s));
+  if (dev == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  nxmutex_init(&dev->lock);
+  dev->mtd  = mtd;
+  dev->open = LFTL_NONE;
+
+  /* Get the device geometry. (casting to uintptr_t first eliminates
+   * complaints on some architectures where the sizeof long is different
+   * from the size of a pointer).
+   */
+
+  ret = MTD_IOCTL(mtd, MTDIOC_GEOMETRY,
+                  (unsigned long)((uintptr_t)&dev->geo));
+  if (ret < 0)
+    {
+      ferr("ERROR: MTD ioctl(MTDIOC_GEOMETRY) failed: %d\n", ret);
+      goto errout;
+    }
+
+  /* Get the number of R/W blocks per erase block, and the number of them
+   * needed by the summary of the others.
+   */
+
+  dev->blkper = dev->geo.erasesize / dev->geo.blocksize;
+  DEBUGASSERT(dev->blkper * dev->geo.blocksize == dev->geo.erasesize);
+
+  for (dev->nsum = 1; dev->nsum + 1 < dev->blkper; dev->nsum++)
+    {
+      sumsize = LFTL_SUMMARY_SIZE(dev->blkper - 1 - dev->nsum);
+      if (sumsize <= (size_t)dev->nsum * dev->geo.blocksize)
+        {
+          break;
+        }
+    }
+
+  dev->ndata = dev->blkper - 1 - dev->nsum;
+
+  /* One erase block is open, the reserved ones are left for the garbage
+   * collection.
+   */
+
+  nblocks = dev->geo.neraseblocks - CONFIG_LFTL_RESERVED_BLOCKS - 1;
+  if (dev->geo.blocksize < sizeof(struct lftl_header_s) ||
+      dev->ndata <= dev->nsum ||
+      dev->geo.neraseblocks <= CONFIG_LFTL_RESERVED_BLOCKS + 1)
+    {
+      ferr("ERROR: Unsupported geometry\n");
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  dev->nsectors = (uint64_t)nblocks * dev->ndata *
+                  (100 - CONFIG_LFTL_OVERPROVISION) / 100;
+
+  dev->map     = kmm_malloc(dev->nsectors * sizeof(uint32_t));
+  dev->blocks  = kmm_zalloc(dev->geo.neraseblocks *
+                            sizeof(struct lftl_block_s));
+  dev->sum     = kmm_malloc((size_t)dev->nsum * dev->geo.blocksize);
+  dev->pagebuf = kmm_malloc(2 * dev->geo.blocksize);
+  if (dev->map == NULL || dev->blocks == NULL || dev->sum == NULL ||
+      dev->pagebuf == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  dev->hdrbuf = dev->pagebuf + dev->geo.blocksize;
+
+  ret = lftl_mount(dev);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+#ifdef CONFIG_LFTL_WRITEBUFFER
+  /* Configure the write buffer */
+
+  dev->rwb.blocksize   = dev->geo.blocksize;
+  dev->rwb.nblocks     = dev->nsectors;
+  dev->rwb.dev         = (FAR void *)dev;
+  dev->rwb.wrflush     = lftl_flush;
+  dev->rwb.rhreload    = lftl_reload;
+  dev->rwb.wrmaxblocks = dev->ndata;
+
+  ret = rwb_initialize(&dev->rwb);
+  if (ret < 0)
+    {
+      ferr("ERROR: rwb_initialize failed: %d\n", ret);
+      goto errout;
+    }
+#endif
+
+  /* Inode private data is a reference to the LFTL device structure */
+
+  ret = register_blockdriver(path, &g_lftl_bops, 0666, dev);
+  if (ret < 0)
+    {
+      ferr("ERROR: register_blockdriver failed: %d\n", ret);
+#ifdef CONFIG_LFTL_WRITEBUFFER
+      rwb_uninitialize(&dev->rwb);
+#endif
+      goto errout;
+    }
+
+  return OK;
+
+errout:
+  nxmutex_destroy(&dev->lock);
+  kmm_free(dev->map);
+  kmm_free(dev->blocks);
+  kmm_free(dev->sum);
+  kmm_free(dev->pagebuf);
+  kmm_free(dev);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: lftl_initialize
+ *
+ * Description:
+ *   Initialize to provide a log-structured block driver wrapper around an
+ *   MTD interface
+ *
+ * Input Parameters:
+ *   minor - The minor device number.  The MTD block device will be
+ *           registered as as /dev/mtdblockN where N is the minor number.
+ *   mtd   - The MTD device that supports the FLASH interface.
+ *
+ ****************************************************************************/
+
+int lftl_initialize(int minor, FAR struct mtd_dev_s *mtd)
+{
+  FAR char *path;
+  int ret;
+
+#ifdef CONFIG_DEBUG_FEATURES
+  /* Sanity check */
+
+  if (minor < 0 || minor > 255)
+    {
+      return -EINVAL;
+    }
+#endif
+
+  path = lib_get_pathbuffer();
+  if (path == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  snprintf(path, PATH_MAX, "/dev/mtdblock%d", minor);
+  ret = lftl_initialize_by_path(path, mtd);
+  lib_put_pathbuffer(path);
+  return ret;
+}
@@ -38,6 +38,8 @@
 
 #include <nuttx/mtd/mtd.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/signal.h>
 #include <nuttx/fs/ioctl.h>
 #ifdef CONFIG_FS_PROCFS
 #include <nuttx/fs/procfs.h>
@@ -53,6 +55,25 @@
  * Private Types
  ****************************************************************************/
 
+/* The erase scheduler shared by the partitions of a FLASH device:  The
+ * erase blocks are erased one at a time with MTDIOC_ERASESTART without
+ * holding the lock, which the reads take to suspend the erase in
+ * progress.
+ */
+
+#ifdef CONFIG_MTD_PARTITION_ERASE_SUSPEND
+struct part_erase_s
+{
+  FAR struct part_erase_s *flink; /* The scheduler of the next device */
+  FAR struct mtd_dev_s *parent;   /* The FLASH device */
+  mutex_t lock;                   /* Serializes the accesses to the device */
+  mutex_t eraselock;              /* Serializes the erases */
+  uint16_t nsuspend;              /* Suspends of the erase in progress */
+  bool erasing;                   /* An erase is in progress */
+  bool suspended;                 /* The erase is suspended */
+};
+#endif
+
 /* This type represents the state of the MTD device.  The struct mtd_dev_s
  * must appear at the beginning of the definition so that you can freely
  * cast between pointers to struct mtd_dev_s and struct mtd_partition_s.
@@ -75,6 +96,9 @@ struct mtd_partition_s
                                  * sub-region */
   uint16_t blkpererase;         /* Number of R/W blocks in one erase block */
   struct mtd_geometry_s geo;    /* The geometry for the partition */
+#ifdef CONFIG_MTD_PARTITION_ERASE_SUSPEND
+  FAR struct part_erase_s *erase; /* The erase scheduler, or NULL */
+#endif
 
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_PROCFS_EXCLUDE_PARTITIONS)
   struct mtd_partition_s  *pnext; /* Pointer to next partition struct */
@@ -146,6 +170,11 @@ static int     part_procfs_stat(FAR const char *relpath,
  * Private Data
  ****************************************************************************/
 
+#ifdef CONFIG_MTD_PARTITION_ERASE_SUSPEND
+static FAR struct part_erase_s *g_parterase;
+static mutex_t g_parterase_lock = NXMUTEX_INITIALIZER;
+#endif
+
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_PROCFS_EXCLUDE_PARTITIONS)
 static struct mtd_partition_s *g_pfirstpartition = NULL;
 
@@ -204,6 +233,196 @@ static bool part_bytecheck(FAR struct mtd_partition_s *priv, off_t byoff)
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: part_getsched
+ *
+ * Description:
+ *   Return the erase scheduler of a FLASH device, allocating it the first
+ *   time.  NULL is returned if the device cannot start an erase without
+ *   waiting for it.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_PARTITION_ERASE_SUSPEND
+static FAR struct part_erase_s *part_getsched(FAR struct mtd_dev_s *mtd)
+{
+  FAR struct part_erase_s *sched;
+
+  if (mtd->ioctl == NULL || mtd->ioctl(mtd, MTDIOC_ERASEBUSY, 0) < 0)
+    {
+      return NULL;
+    }
+
+  nxmutex_lock(&g_parterase_lock);
+  for (sched = g_parterase; sched != NULL; sched = sched->flink)
+    {
+      if (sched->parent == mtd)
+        {
+          break;
+        }
+    }
+
+  if (sched == NULL)
+    {
+      sched = kmm_zalloc(sizeof(struct part_erase_s));
+      if (sched != NULL)
+        {
+          sched->parent = mtd;
+          nxmutex_init(&sched->lock);
+          nxmutex_init(&sched->eraselock);
+          sched->flink = g_parterase;
+          g_parterase  = sched;
+        }
+    }
+
+  nxmutex_unlock(&g_parterase_lock);
+  return sched;
+}
+
+/****************************************************************************
+ * Name: part_lock
+ *
+ * Description:
+ *   Take the exclusive access to the FLASH device for a read or a write.
+ *   An erase in progress is suspended for a read, unless it was suspended
+ *   too often, the read then waits for it in the driver.  A read of the
+ *   erase block being erased returns garbage:  The caller does not read
+ *   a block that it is erasing.
+ *
+ ****************************************************************************/
+
+static void part_lock(FAR struct mtd_partition_s *priv, bool read)
+{
+  FAR struct part_erase_s *sched = priv->erase;
+
+  if (sched == NULL)
+    {
+      return;
+    }
+
+  nxmutex_lock(&sched->lock);
+  if (read && sched->erasing &&
+      sched->nsuspend < CONFIG_MTD_PARTITION_ERASE_MAXSUSPEND &&
+      MTD_IOCTL(sched->parent, MTDIOC_ERASESUSPEND, 0) >= 0)
+    {
+      sched->suspended = true;
+      sched->nsuspend++;
+    }
+}
+
+/****************************************************************************
+ * Name: part_unlock
+ *
+ * Description:
+ *   Resume the erase suspended by part_lock() and give the FLASH device
+ *   back.
+ *
+ ****************************************************************************/
+
+static void part_unlock(FAR struct mtd_partition_s *priv)
+{
+  FAR struct part_erase_s *sched = priv->erase;
+
+  if (sched == NULL)
+    {
+      return;
+    }
+
+  if (sched->suspended)
+    {
+      MTD_IOCTL(sched->parent, MTDIOC_ERASERESUME, 0);
+      sched->suspended = false;
+    }
+
+  nxmutex_unlock(&sched->lock);
+}
+
+/****************************************************************************
+ * Name: part_erasestart
+ *
+ * Description:
+ *   Start the erase of an erase block of the FLASH device.
+ *
+ ****************************************************************************/
+
+static int part_erasestart(FAR struct part_erase_s *sched, off_t block)
+{
+  int ret;
+
+  nxmutex_lock(&sched->lock);
+  ret = MTD_IOCTL(sched->parent, MTDIOC_ERASESTART, block);
+  if (ret >= 0)
+    {
+      sched->erasing  = true;
+      sched->nsuspend = 0;
+    }
+
+  nxmutex_unlock(&sched->lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: part_erasebusy
+ *
+ * Description:
+ *   Return 1 while the started erase is in progress, 0 once it is
+ *   complete.
+ *
+ ****************************************************************************/
+
+static int part_erasebusy(FAR struct part_erase_s *sched)
+{
+  int ret;
+
+  nxmutex_lock(&sched->lock);
+  ret = MTD_IOCTL(sched->parent, MTDIOC_ERASEBUSY, 0);
+  if (ret <= 0)
+    {
+      sched->erasing = false;
+    }
+
+  nxmutex_unlock(&sched->lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: part_schederase
+ *
+ * Description:
+ *   Erase the erase blocks of the FLASH device one at a time, polling for
+ *   the completion of each without holding the device.
+ *
+ ****************************************************************************/
+
+static int part_schederase(FAR struct part_erase_s *sched, off_t block,
+                           size_t nblocks)
+{
+  size_t i;
+  int ret = OK;
+
+  nxmutex_lock(&sched->eraselock);
+  for (i = 0; i < nblocks && ret >= 0; i++)
+    {
+      ret = part_erasestart(sched, block + i);
+      while (ret >= 0)
+        {
+          nxsig_usleep(CONFIG_MTD_PARTITION_ERASE_POLL);
+          ret = part_erasebusy(sched);
+          if (ret == 0)
+            {
+              break;
+            }
+        }
+    }
+
+  nxmutex_unlock(&sched->eraselock);
+  return ret < 0 ? ret : (int)nblocks;
+}
+#else
+#  define part_lock(priv, read)
+#  define part_unlock(priv)
+#endif
+
 /****************************************************************************
  * Name: part_erase
  *
@@ -237,6 +456,13 @@ static int part_erase(FAR struct mtd_dev_s *dev, off_t startblock,
   eoffset = priv->firstblock / priv->blkpererase;
   DEBUGASSERT(eoffset * priv->blkpererase == priv->firstblock);
 
+#ifdef CONFIG_MTD_PARTITION_ERASE_SUSPEND
+  if (priv->erase != NULL)
+    {
+      return part_schederase(priv->erase, startblock + eoffset, nblocks);
+    }
+#endif
+
   return priv->parent->erase(priv->parent, startblock + eoffset, nblocks);
 }
 
@@ -252,6 +478,7 @@ static ssize_t part_bread(FAR struct mtd_dev_s *dev, off_t startblock,
                           size_t nblocks, FAR uint8_t *buf)
 {
   FAR struct mtd_partition_s *priv = (FAR struct mtd_partition_s *)dev;
+  ssize_t ret;
 
   DEBUGASSERT(priv && (buf || nblocks == 0));
 
@@ -267,8 +494,11 @@ static ssize_t part_bread(FAR struct mtd_dev_s *dev, off_t startblock,
    * underlying MTD driver perform the read.
    */
 
-  return priv->parent->bread(priv->parent, startblock + priv->firstblock,
-                             nblocks, buf);
+  part_lock(priv, true);
+  ret = priv->parent->bread(priv->parent, startblock + priv->firstblock,
+                            nblocks, buf);
+  part_unlock(priv);
+  return ret;
 }
 
 /****************************************************************************
@@ -283,6 +513,7 @@ static ssize_t part_bwrite(FAR struct mtd_dev_s *dev, off_t startblock,
                            size_t nblocks, FAR const uint8_t *buf)
 {
   FAR struct mtd_partition_s *priv = (FAR struct mtd_partition_s *)dev;
+  ssize_t ret;
 
   DEBUGASSERT(priv && (buf || nblocks == 0));
 
@@ -298,8 +529,11 @@ static ssize_t part_bwrite(FAR struct mtd_dev_s *dev, off_t startblock,
    * underlying MTD driver perform the write.
    */
 
-  return priv->parent->bwrite(priv->parent, startblock + priv->firstblock,
-                              nblocks, buf);
+  part_lock(priv, false);
+  ret = priv->parent->bwrite(priv->parent, startblock + priv->firstblock,
+                             nblocks, buf);
+  part_unlock(priv);
+  return ret;
 }
 
 /****************************************************************************
@@ -315,6 +549,7 @@ static ssize_t part_read(FAR struct mtd_dev_s *dev, off_t offset,
 {
   FAR struct mtd_partition_s *priv = (FAR struct mtd_partition_s *)dev;
   off_t newoffset;
+  ssize_t ret;
 
   DEBUGASSERT(priv && (buffer || nbytes == 0));
 
@@ -335,7 +570,10 @@ static ssize_t part_read(FAR struct mtd_dev_s *dev, off_t offset,
        */
 
       newoffset = offset + priv->firstblock * priv->geo.blocksize;
-      return priv->parent->read(priv->parent, newoffset, nbytes, buffer);
+      part_lock(priv, true);
+      ret = priv->parent->read(priv->parent, newoffset, nbytes, buffer);
+      part_unlock(priv);
+      return ret;
     }
 
   /* The underlying MTD driver does not support the read() method */
@@ -353,6 +591,7 @@ static ssize_t part_write(FAR struct mtd_dev_s *dev, off_t offset,
 {
   FAR struct mtd_partition_s *priv = (FAR struct mtd_partition_s *)dev;
   off_t newoffset;
+  ssize_t ret;
 
   DEBUGASSERT(priv && (buffer || nbytes == 0));
 
@@ -375,7 +614,10 @@ static ssize_t part_write(FAR struct mtd_dev_s *dev, off_t offset,
        */
 
       newoffset = offset + priv->firstblock * priv->geo.blocksize;
-      return priv->parent->write(priv->parent, newoffset, nbytes, buffer);
+      part_lock(priv, false);
+      ret = priv->parent->write(priv->parent, newoffset, nbytes, buffer);
+      part_unlock(priv);
+      return ret;
     }
 
   /* The underlying MTD driver does not support the write() method */
@@ -466,13 +708,46 @@ static int part_ioctl(FAR struct mtd_dev_s *dev, int cmd, unsigned long arg)
 
           FAR struct mtd_erase_s *erase = (FAR struct mtd_erase_s *)arg;
 
-          ret = priv->parent->erase(priv->parent,
-                                    priv->firstblock / priv->blkpererase +
-                                    erase->startblock,
-                                    erase->nblocks);
+          ret = part_erase(dev, erase->startblock, erase->nblocks);
+        }
+        break;
+
+      case MTDIOC_ERASESTART:
+        {
+          /* Start the erase of an erase block of the partition */
+
+          if (arg >= priv->geo.neraseblocks)
+            {
+              break;
+            }
+
+          arg += priv->firstblock / priv->blkpererase;
+#ifdef CONFIG_MTD_PARTITION_ERASE_SUSPEND
+          if (priv->erase != NULL)
+            {
+              ret = part_erasestart(priv->erase, arg);
+              break;
+            }
+#endif
+
+          ret = priv->parent->ioctl(priv->parent, cmd, arg);
         }
         break;
 
+#ifdef CONFIG_MTD_PARTITION_ERASE_SUSPEND
+      case MTDIOC_ERASEBUSY:
+        {
+          if (priv->erase != NULL)
+            {
+              ret = part_erasebusy(priv->erase);
+              break;
+            }
+
+          ret = priv->parent->ioctl(priv->parent, cmd, arg);
+        }
+        break;
+#endif
+
       default:
         {
           /* Pass any unhandled ioctl() calls to the underlying driver */
@@ -917,6 +1192,9 @@ FAR struct mtd_dev_s *mtd_partition(FAR struct mtd_dev_s *mtd,
   part->parent        = mtd;
   part->firstblock    = erasestart * part->blkpererase;
   part->geo.neraseblocks = eraseend - erasestart;
+#ifdef CONFIG_MTD_PARTITION_ERASE_SUSPEND
+  part->erase         = part_getsched(mtd);
+#endif
 
 #ifdef CONFIG_MTD_PARTITION_NAMES
   strlcpy(part->name, "(noname)", sizeof(part->name));
@@ -96,8 +96,6 @@ static int     rpmsgmtd_send_recv(FAR struct rpmsgmtd_s *priv,
                                   uint32_t command, bool copy,
                                   FAR struct rpmsgmtd_header_s *msg,
                                   int len, FAR void *data);
-static FAR void *rpmsgmtd_get_tx_payload_buffer(FAR struct rpmsgmtd_s *priv,
-                                                FAR uint32_t *len);
 
 /* Functions handle the responses from the remote cpu */
 
@@ -362,7 +360,7 @@ static ssize_t rpmsgmtd_bwrite(FAR struct mtd_dev_s *dev, off_t startblock,
   blocksize = priv->geo.blocksize;
   while (written < nblocks)
     {
-      msg = rpmsgmtd_get_tx_payload_buffer(priv, &space);
+      msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
       if (msg == NULL)
         {
           ret = -ENOMEM;
@@ -396,8 +394,8 @@ static ssize_t rpmsgmtd_bwrite(FAR struct mtd_dev_s *dev, off_t startblock,
       startblock += msg->nblocks;
       written    += msg->nblocks;
 
-      ret = rpmsg_send_nocopy(&priv->ept, msg,
-                              sizeof(*msg) - 1 + msg->nblocks * blocksize);
+      ret = rpmsg_commit(&priv->ept, msg,
+                         sizeof(*msg) - 1 + msg->nblocks * blocksize);
       if (ret < 0)
         {
           goto out;
@@ -513,7 +511,7 @@ static ssize_t rpmsgmtd_write(FAR struct mtd_dev_s *dev, off_t offset,
 
   while (written < nbytes)
     {
-      msg = rpmsgmtd_get_tx_payload_buffer(priv, &space);
+      msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
       if (msg == NULL)
         {
           ret = -ENOMEM;
@@ -541,7 +539,7 @@ static ssize_t rpmsgmtd_write(FAR struct mtd_dev_s *dev, off_t offset,
       msg->nbytes         = space;
       memcpy(msg->buf, buffer, space);
 
-      ret = rpmsg_send_nocopy(&priv->ept, msg, sizeof(*msg) - 1 + space);
+      ret = rpmsg_commit(&priv->ept, msg, sizeof(*msg) - 1 + space);
       if (ret < 0)
         {
           goto out;
@@ -637,7 +635,7 @@ static int rpmsgmtd_ioctl(FAR struct mtd_dev_s *dev, int cmd,
 
   msglen = sizeof(*msg) + arglen - 1;
 
-  msg = rpmsgmtd_get_tx_payload_buffer(priv, &space);
+  msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
   if (msg == NULL)
     {
       return -ENOMEM;
@@ -656,38 +654,6 @@ static int rpmsgmtd_ioctl(FAR struct mtd_dev_s *dev, int cmd,
                             msglen, arglen > 0 ? (FAR void *)arg : NULL);
 }
 
-/****************************************************************************
- * Name: rpmsgmtd_get_tx_payload_buffer
- *
- * Description:
- *   Get the rpmsg mtd tx payload, the buffer is from the rpmsg share memory
- *   that can be accessed by local and remote cpu.
- *
- * Parameters:
- *   priv  - The rpmsg-mtd handle
- *   len   - The got memroy size
- *
- * Returned Values:
- *   NULL     - failure
- *   not NULL - success
- *
- ****************************************************************************/
-
-static FAR void *rpmsgmtd_get_tx_payload_buffer(FAR struct rpmsgmtd_s *priv,
-                                                FAR uint32_t *len)
-{
-  int sval;
-
-  nxsem_get_value(&priv->wait, &sval);
-  if (sval <= 0)
-    {
-      rpmsg_wait(&priv->ept, &priv->wait);
-      rpmsg_post(&priv->ept, &priv->wait);
-    }
-
-  return rpmsg_get_tx_payload_buffer(&priv->ept, len, true);
-}
-
 /****************************************************************************
  * Name: rpmsgmtd_send_recv
  *
@@ -701,8 +667,7 @@ static FAR void *rpmsgmtd_get_tx_payload_buffer(FAR struct rpmsgmtd_s *priv,
  *   copy    - true, send a message across to the remote processor, and the
  *                   tx buffer will be alloced inside function rpmsg_send()
  *             false, send a message in tx buffer reserved by
- *                    rpmsg_get_tx_payload_buffer() across to the remote
- *                    processor.
+ *                    rpmsg_reserve() across to the remote processor.
  *   msg     - the message header
  *   len     - length of the payload
  *   data    - the data
@@ -742,7 +707,7 @@ static int rpmsgmtd_send_recv(FAR struct rpmsgmtd_s *priv,
     }
   else
     {
-      ret = rpmsg_send_nocopy(&priv->ept, msg, len);
+      ret = rpmsg_commit(&priv->ept, msg, len);
     }
 
   if (ret < 0)
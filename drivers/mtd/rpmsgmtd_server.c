@@ -142,7 +142,7 @@ static int rpmsgmtd_bread_handler(FAR struct rpmsg_endpoint *ept,
 
   while (read < msg->nblocks)
     {
-      rsp = rpmsg_get_tx_payload_buffer(ept, &space, true);
+      rsp = rpmsg_reserve(ept, NULL, &space);
       if (rsp == NULL)
         {
           ferr("get tx payload failed or no enough space\n");
@@ -163,11 +163,10 @@ static int rpmsgmtd_bread_handler(FAR struct rpmsg_endpoint *ept,
                       rsp->buf);
 
       rsp->header.result = ret;
-      rpmsg_send_nocopy(ept, rsp, (ret < 0 ? 0 : ret * msg->blocksize) +
-                        sizeof(*rsp) - 1);
+      rpmsg_commit(ept, rsp, (ret < 0 ? 0 : ret * msg->blocksize) +
+                   sizeof(*rsp) - 1);
       if (ret < 0)
         {
-          rpmsg_release_tx_buffer(ept, rsp);
           ferr("mtd block read failed\n");
           break;
         }
@@ -226,7 +225,7 @@ static int rpmsgmtd_read_handler(FAR struct rpmsg_endpoint *ept,
 
   while (read < msg->nbytes)
     {
-      rsp = rpmsg_get_tx_payload_buffer(ept, &space, true);
+      rsp = rpmsg_reserve(ept, NULL, &space);
       if (rsp == NULL)
         {
           ferr("get tx payload failed\n");
@@ -245,10 +244,9 @@ static int rpmsgmtd_read_handler(FAR struct rpmsg_endpoint *ept,
                      (FAR uint8_t *)rsp->buf);
 
       rsp->header.result = ret;
-      rpmsg_send_nocopy(ept, rsp, (ret < 0 ? 0 : ret) + sizeof(*rsp) - 1);
+      rpmsg_commit(ept, rsp, (ret < 0 ? 0 : ret) + sizeof(*rsp) - 1);
       if (ret < 0)
         {
-          rpmsg_release_tx_buffer(ept, rsp);
           break;
         }
 
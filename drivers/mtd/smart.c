@@ -4012,6 +4012,53 @@ retry:
   return physicalsector;
 }
 
+/****************************************************************************
+ * Name: smart_findcollectblock
+ *
+ * Description:  Returns the erase block with the most released sectors, or
+ *               0xffff if no block has released sectors.
+ *
+ ****************************************************************************/
+
+static uint16_t smart_findcollectblock(FAR struct smart_struct_s *dev)
+{
+  uint16_t collectblock = 0xffff;
+  uint16_t releasemax = 0;
+  int x;
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+  uint8_t count;
+#endif
+
+  for (x = 0; x < dev->neraseblocks; x++)
+    {
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+      /* Don't collect blocks that have been worn completely */
+
+      if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD)
+        {
+          continue;
+        }
+#endif
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+      count = smart_get_count(dev, dev->releasecount, x);
+      if (count > releasemax)
+        {
+          releasemax = count;
+          collectblock = x;
+        }
+#else
+      if (dev->releasecount[x] > releasemax)
+        {
+          releasemax = dev->releasecount[x];
+          collectblock = x;
+        }
+#endif
+    }
+
+  return collectblock;
+}
+
 /****************************************************************************
  * Name: smart_garbagecollect
  *
@@ -4024,13 +4071,8 @@ retry:
 static int smart_garbagecollect(FAR struct smart_struct_s *dev)
 {
   uint16_t collectblock;
-  uint16_t releasemax;
   bool collect = true;
-  int x;
   int ret;
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-  uint8_t count;
-#endif
 
   while (collect)
     {
@@ -4059,39 +4101,7 @@ static int smart_garbagecollect(FAR struct smart_struct_s *dev)
         {
           /* Find the block with the most released sectors */
 
-          collectblock = 0xffff;
-          releasemax = 0;
-          for (x = 0; x < dev->neraseblocks; x++)
-            {
-#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
-              /* Don't collect blocks that have been worn completely */
-
-              if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD)
-                {
-                  continue;
-                }
-#endif
-
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-              count = smart_get_count(dev, dev->releasecount, x);
-              if (count > releasemax)
-                {
-                  releasemax = count;
-                  collectblock = x;
-                }
-#else
-              if (dev->releasecount[x] > releasemax)
-                {
-                  releasemax = dev->releasecount[x];
-                  collectblock = x;
-                }
-#endif
-            }
-
-#if 0
-          releasemax = smart_get_count(dev, dev->releasecount, collectblock);
-#endif
-
+          collectblock = smart_findcollectblock(dev);
           if (collectblock == 0xffff)
             {
               /* Need to collect, but no sectors with released blocks! */
@@ -4144,6 +4154,45 @@ errout:
   return ret;
 }
 
+/****************************************************************************
+ * Name: smart_collect
+ *
+ * Description:  Reclaims the released sectors of one erase block ahead of
+ *               need if there are fewer than 'minfree' free sectors.  This
+ *               is one step of the background garbage collection of the
+ *               file system:  Returns 1 if more steps are needed, 0 if
+ *               there are enough free sectors or nothing to reclaim.
+ *
+ ****************************************************************************/
+
+static int smart_collect(FAR struct smart_struct_s *dev, uint16_t minfree)
+{
+  uint16_t collectblock;
+  int ret;
+
+  if (dev->freesectors >= minfree || dev->releasesectors == 0)
+    {
+      return 0;
+    }
+
+  collectblock = smart_findcollectblock(dev);
+  if (collectblock == 0xffff)
+    {
+      return 0;
+    }
+
+  finfo("Collecting block %d in the background, free=%d released=%d\n",
+        collectblock, dev->freesectors, dev->releasesectors);
+
+  ret = smart_relocate_block(dev, collectblock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return dev->freesectors < minfree && dev->releasesectors > 0;
+}
+
 /****************************************************************************
  * Name: smart_write_wearstatus
  *
@@ -5547,6 +5596,23 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
       ret = smart_allocsector(dev, arg);
       goto ok_out;
 
+    case BIOC_COLLECT:
+
+      /* Reclaim the released sectors of one erase block */
+
+      ret = smart_collect(dev, (uint16_t)arg);
+
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+      if (dev->wearflags & SMART_WEARFLAGS_WRITE_NEEDED)
+        {
+          /* Write new wear status bits to the device */
+
+          smart_write_wearstatus(dev);
+        }
+#endif
+
+      goto ok_out;
+
     case BIOC_FREESECT:
 
       /* Free the specified logical sector */
@@ -86,6 +86,7 @@
 #define W25_WREN                   0x06    /* Write enable                   */
 #define W25_WRDI                   0x04    /* Write Disable                  */
 #define W25_RDSR                   0x05    /* Read status register           */
+#define W25_RDSR2                  0x35    /* Read status register 2 (W25Q)  */
 #define W25_WRSR                   0x01    /* Write Status Register          */
 #define W25_RDDATA                 0x03    /* Read data bytes                */
 #define W25_FRD                    0x0b    /* Higher speed read              */
@@ -98,6 +99,8 @@
 #define W25_PURDID                 0xab    /* Release PD, Device ID          */
 #define W25_RDMFID                 0x90    /* Read Manufacturer / Device     */
 #define W25_JEDEC_ID               0x9f    /* JEDEC ID read                  */
+#define W25_SUS                    0x75    /* Erase/program suspend (W25Q)   */
+#define W25_RES                    0x7a    /* Erase/program resume (W25Q)    */
 
 /* W25 Registers ************************************************************/
 
@@ -185,6 +188,10 @@
                                              /* Bit 6: Reserved */
 #define W25_SR_SRP                 (1 << 7)  /* Bit 7: Status register write protect */
 
+/* Status register 2 bit definitions (W25Q) */
+
+#define W25_SR2_SUS                (1 << 7)  /* Bit 7: Erase/program suspended */
+
 #define W25_DUMMY                  0xa5
 
 /* Chip Geometries **********************************************************/
@@ -205,6 +212,14 @@
 
 #define W25_ERASED_STATE           0xff      /* State of FLASH when erased */
 
+/* The sector erases may be started without waiting for their completion,
+ * and suspended for reads (see MTDIOC_ERASESTART).
+ */
+
+#if !defined(CONFIG_W25_READONLY) && !defined(CONFIG_W25_SECTOR512)
+#  define W25_HAVE_ASYNCERASE      1
+#endif
+
 /* Cache flags */
 
 #define W25_CACHE_VALID            (1 << 0)  /* 1=Cache has valid data */
@@ -239,6 +254,10 @@ struct w25_dev_s
   FAR struct spi_dev_s *spi;         /* Saved SPI interface instance */
   uint16_t              nsectors;    /* Number of erase sectors */
   uint8_t               prev_instr;  /* Previous instruction given to W25 device */
+#ifdef W25_HAVE_ASYNCERASE
+  bool                  suspendable; /* The part supports erase suspend */
+  bool                  suspended;   /* A sector erase is suspended */
+#endif
 
 #if defined(CONFIG_W25_SECTOR512) && !defined(CONFIG_W25_READONLY)
   uint8_t               flags;       /* Buffered sector flags */
@@ -260,6 +279,12 @@ static inline int w25_readid(FAR struct w25_dev_s *priv);
 static void w25_unprotect(FAR struct w25_dev_s *priv);
 #endif
 static uint8_t w25_waitwritecomplete(FAR struct w25_dev_s *priv);
+#ifdef W25_HAVE_ASYNCERASE
+static uint8_t w25_readstatus(FAR struct w25_dev_s *priv, uint8_t cmd);
+static int w25_erasebusy(FAR struct w25_dev_s *priv);
+static int w25_erasesuspend(FAR struct w25_dev_s *priv);
+static int w25_eraseresume(FAR struct w25_dev_s *priv);
+#endif
 static inline void w25_wren(FAR struct w25_dev_s *priv);
 static inline void w25_wrdi(FAR struct w25_dev_s *priv);
 static bool w25_is_erased(struct w25_dev_s *priv,
@@ -421,6 +446,12 @@ static inline int w25_readid(struct w25_dev_s *priv)
        * W25Q20CL
        */
 
+#ifdef W25_HAVE_ASYNCERASE
+      /* Only the W25Q parts can suspend an erase */
+
+      priv->suspendable = memory != W25X_JEDEC_MEMORY_TYPE;
+#endif
+
       if (capacity == W25_JEDEC_CAPACITY_2MBIT)
         {
            priv->nsectors = NSECTORS_2MBIT;
@@ -586,12 +617,108 @@ static uint8_t w25_waitwritecomplete(struct w25_dev_s *priv)
   return status;
 }
 
+/****************************************************************************
+ * Name: w25_readstatus
+ ****************************************************************************/
+
+#ifdef W25_HAVE_ASYNCERASE
+static uint8_t w25_readstatus(FAR struct w25_dev_s *priv, uint8_t cmd)
+{
+  uint8_t status;
+
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(0), true);
+  SPI_SEND(priv->spi, cmd);
+  status = SPI_SEND(priv->spi, W25_DUMMY);
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(0), false);
+
+  return status;
+}
+
+/****************************************************************************
+ * Name: w25_erasebusy
+ *
+ * Description:
+ *   Return 1 while the sector erase started by MTDIOC_ERASESTART is in
+ *   progress or suspended, 0 once it is complete.
+ *
+ ****************************************************************************/
+
+static int w25_erasebusy(FAR struct w25_dev_s *priv)
+{
+  if (priv->suspended)
+    {
+      return 1;
+    }
+
+  return (w25_readstatus(priv, W25_RDSR) & W25_SR_BUSY) != 0;
+}
+
+/****************************************************************************
+ * Name: w25_erasesuspend
+ *
+ * Description:
+ *   Suspend the sector erase in progress, if any, so that the other
+ *   sectors can be read.  The erase is suspended within tSUS (20us).
+ *
+ ****************************************************************************/
+
+static int w25_erasesuspend(FAR struct w25_dev_s *priv)
+{
+  if (!priv->suspendable)
+    {
+      return -ENOSYS;
+    }
+
+  if (priv->suspended || priv->prev_instr != W25_SE ||
+      (w25_readstatus(priv, W25_RDSR) & W25_SR_BUSY) == 0)
+    {
+      return OK;
+    }
+
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(0), true);
+  SPI_SEND(priv->spi, W25_SUS);
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(0), false);
+
+  while ((w25_readstatus(priv, W25_RDSR) & W25_SR_BUSY) != 0);
+
+  /* The erase may have completed before the suspend instruction */
+
+  priv->suspended = (w25_readstatus(priv, W25_RDSR2) & W25_SR2_SUS) != 0;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: w25_eraseresume
+ ****************************************************************************/
+
+static int w25_eraseresume(FAR struct w25_dev_s *priv)
+{
+  if (priv->suspended)
+    {
+      SPI_SELECT(priv->spi, SPIDEV_FLASH(0), true);
+      SPI_SEND(priv->spi, W25_RES);
+      SPI_SELECT(priv->spi, SPIDEV_FLASH(0), false);
+
+      priv->prev_instr = W25_SE;
+      priv->suspended  = false;
+    }
+
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name:  w25_wren
  ****************************************************************************/
 
 static inline void w25_wren(struct w25_dev_s *priv)
 {
+  /* A suspended erase is resumed before any program or erase */
+
+#ifdef W25_HAVE_ASYNCERASE
+  DEBUGASSERT(!priv->suspended);
+#endif
+
   /* Select this FLASH part */
 
   SPI_SELECT(priv->spi, SPIDEV_FLASH(0), true);
@@ -768,11 +895,18 @@ static void w25_byteread(FAR struct w25_dev_s *priv, FAR uint8_t *buffer,
   /* Wait for any preceding write or erase operation to complete. */
 
   status = w25_waitwritecomplete(priv);
-  DEBUGASSERT((status & (W25_SR_WEL | W25_SR_BP_MASK)) == 0);
 
-  /* Make sure that writing is disabled */
+  /* Make sure that writing is disabled, the write enable latch stays set
+   * while an erase is suspended.
+   */
 
-  w25_wrdi(priv);
+#ifdef W25_HAVE_ASYNCERASE
+  if (!priv->suspended)
+#endif
+    {
+      DEBUGASSERT((status & (W25_SR_WEL | W25_SR_BP_MASK)) == 0);
+      w25_wrdi(priv);
+    }
 
   /* Select this FLASH part */
 
@@ -1394,6 +1528,50 @@ static int w25_ioctl(FAR struct mtd_dev_s *dev, int cmd, unsigned long arg)
         }
         break;
 
+#ifdef W25_HAVE_ASYNCERASE
+      case MTDIOC_ERASESTART:
+        {
+          /* Start the erase of a sector without waiting for it.  The
+           * sector erase only waits for the preceding operation.
+           */
+
+          if (arg >= priv->nsectors)
+            {
+              break;
+            }
+
+          w25_lock(priv->spi);
+          w25_sectorerase(priv, arg);
+          w25_unlock(priv->spi);
+          ret = OK;
+        }
+        break;
+
+      case MTDIOC_ERASEBUSY:
+        {
+          w25_lock(priv->spi);
+          ret = w25_erasebusy(priv);
+          w25_unlock(priv->spi);
+        }
+        break;
+
+      case MTDIOC_ERASESUSPEND:
+        {
+          w25_lock(priv->spi);
+          ret = w25_erasesuspend(priv);
+          w25_unlock(priv->spi);
+        }
+        break;
+
+      case MTDIOC_ERASERESUME:
+        {
+          w25_lock(priv->spi);
+          ret = w25_eraseresume(priv);
+          w25_unlock(priv->spi);
+        }
+        break;
+#endif
+
       default:
         ret = -ENOTTY; /* Bad command */
         break;
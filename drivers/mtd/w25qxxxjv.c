@@ -36,6 +36,7 @@
 #include <debug.h>
 #include <inttypes.h>
 
+#include <nuttx/cache.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/signal.h>
 #include <nuttx/fs/ioctl.h>
@@ -345,6 +346,9 @@ struct w25qxxxjv_dev_s
   uint8_t                currentdie;  /* Number of current active die */
   FAR uint8_t           *cmdbuf;      /* Allocated command buffer */
   FAR uint8_t           *readbuf;     /* Allocated status read buffer */
+#ifdef CONFIG_W25QXXXJV_MEMMAP
+  FAR uint8_t           *membase;     /* Memory-mapped window, NULL if none */
+#endif
 
 #ifdef CONFIG_W25QXXXJV_SECTOR512
   uint8_t                flags;       /* Buffered sector flags */
@@ -404,6 +408,14 @@ static int  w25qxxxjv_read_byte(FAR struct w25qxxxjv_dev_s *priv,
                                 FAR uint8_t *buffer,
                                 off_t address,
                                 size_t nbytes);
+#ifdef CONFIG_W25QXXXJV_MEMMAP
+static void w25qxxxjv_memmap(FAR struct w25qxxxjv_dev_s *priv,
+                             off_t address, size_t nbytes);
+static void w25qxxxjv_unmap(FAR struct w25qxxxjv_dev_s *priv);
+#else
+#  define w25qxxxjv_memmap(priv, address, nbytes)
+#  define w25qxxxjv_unmap(priv)
+#endif
 static int  w25qxxxjv_write_page(FAR struct w25qxxxjv_dev_s *priv,
                                  FAR const uint8_t *buffer,
                                  off_t address,
@@ -1052,6 +1064,16 @@ static int w25qxxxjv_read_byte(FAR struct w25qxxxjv_dev_s *priv,
 
   finfo("address: %08" PRIxOFF " nbytes: %d\n", address, (int)buflen);
 
+#ifdef CONFIG_W25QXXXJV_MEMMAP
+  /* The read is a copy from the window when the FLASH is memory-mapped */
+
+  if (priv->membase != NULL)
+    {
+      memcpy(buffer, priv->membase + address, buflen);
+      return OK;
+    }
+#endif
+
   meminfo.flags   = QSPIMEM_READ | QSPIMEM_QUADIO;
   meminfo.addrlen = priv->addresslen;
   meminfo.dummies = CONFIG_W25QXXXJV_DUMMIES;
@@ -1064,6 +1086,62 @@ static int w25qxxxjv_read_byte(FAR struct w25qxxxjv_dev_s *priv,
   return QSPI_MEMORY(priv->qspi, &meminfo);
 }
 
+/****************************************************************************
+ * Name: w25qxxxjv_memmap
+ *
+ * Description:
+ *   Put the QuadSPI controller in memory-mapped mode with the quad read
+ *   command, if it supports it and the FLASH has a single die.  The cached
+ *   data of the 'nbytes' at 'address', just programmed or erased, is
+ *   discarded.  The QuadSPI bus must be locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_W25QXXXJV_MEMMAP
+static void w25qxxxjv_memmap(FAR struct w25qxxxjv_dev_s *priv,
+                             off_t address, size_t nbytes)
+{
+  struct qspi_meminfo_s meminfo;
+
+  if (priv->membase == NULL && priv->numofdies == 0)
+    {
+      memset(&meminfo, 0, sizeof(meminfo));
+      meminfo.flags   = QSPIMEM_READ | QSPIMEM_QUADIO;
+      meminfo.addrlen = priv->addresslen;
+      meminfo.dummies = CONFIG_W25QXXXJV_DUMMIES;
+      meminfo.cmd     = (priv->addresslen == 4) ?
+                        W25QXXXJV_FAST_READ_QUADIO_4BT :
+                        W25QXXXJV_FAST_READ_QUADIO;
+
+      priv->membase   = QSPI_MEMMAP(priv->qspi, &meminfo);
+    }
+
+  if (priv->membase != NULL && nbytes > 0)
+    {
+      up_invalidate_dcache((uintptr_t)priv->membase + address,
+                           (uintptr_t)priv->membase + address + nbytes);
+    }
+}
+
+/****************************************************************************
+ * Name: w25qxxxjv_unmap
+ *
+ * Description:
+ *   Take the QuadSPI controller out of memory-mapped mode before a command
+ *   is sent to the FLASH.  The QuadSPI bus must be locked.
+ *
+ ****************************************************************************/
+
+static void w25qxxxjv_unmap(FAR struct w25qxxxjv_dev_s *priv)
+{
+  if (priv->membase != NULL)
+    {
+      QSPI_UNMAP(priv->qspi);
+      priv->membase = NULL;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name:  w25qxxxjv_write_page
  ****************************************************************************/
@@ -1351,7 +1429,12 @@ static int w25qxxxjv_erase(FAR struct mtd_dev_s *dev, off_t startblock,
   FAR struct w25qxxxjv_dev_s *priv = (FAR struct w25qxxxjv_dev_s *)dev;
   size_t blocksleft = nblocks;
 #ifdef CONFIG_W25QXXXJV_SECTOR512
+  off_t address = startblock << W25QXXXJV_SECTOR512_SHIFT;
+  size_t nbytes = nblocks << W25QXXXJV_SECTOR512_SHIFT;
   int ret;
+#else
+  off_t address = startblock << priv->sectorshift;
+  size_t nbytes = nblocks << priv->sectorshift;
 #endif
 
   finfo("startblock: %08" PRIxOFF " nblocks: %d\n",
@@ -1360,6 +1443,7 @@ static int w25qxxxjv_erase(FAR struct mtd_dev_s *dev, off_t startblock,
   /* Lock access to the SPI bus until we complete the erase */
 
   w25qxxxjv_lock(priv->qspi);
+  w25qxxxjv_unmap(priv);
 
   while (blocksleft-- > 0)
     {
@@ -1383,8 +1467,11 @@ static int w25qxxxjv_erase(FAR struct mtd_dev_s *dev, off_t startblock,
     }
 #endif
 
+  w25qxxxjv_memmap(priv, address, nbytes);
   w25qxxxjv_unlock(priv->qspi);
 
+  UNUSED(address);
+  UNUSED(nbytes);
   return (int)nblocks;
 }
 
@@ -1454,6 +1541,7 @@ static ssize_t w25qxxxjv_bwrite(FAR struct mtd_dev_s *dev, off_t startblock,
   /* Lock the QuadSPI bus and write all of the pages to FLASH */
 
   w25qxxxjv_lock(priv->qspi);
+  w25qxxxjv_unmap(priv);
 
 #if defined(CONFIG_W25QXXXJV_SECTOR512)
   ret = w25qxxxjv_write_cache(priv, buffer, startblock, nblocks);
@@ -1471,6 +1559,14 @@ static ssize_t w25qxxxjv_bwrite(FAR struct mtd_dev_s *dev, off_t startblock,
     }
 #endif
 
+#ifdef CONFIG_W25QXXXJV_SECTOR512
+  w25qxxxjv_memmap(priv, startblock << W25QXXXJV_SECTOR512_SHIFT,
+                   nblocks << W25QXXXJV_SECTOR512_SHIFT);
+#else
+  w25qxxxjv_memmap(priv, startblock << priv->pageshift,
+                   nblocks << priv->pageshift);
+#endif
+
   w25qxxxjv_unlock(priv->qspi);
 
   return ret < 0 ? ret : nblocks;
@@ -1491,6 +1587,7 @@ static ssize_t w25qxxxjv_read(FAR struct mtd_dev_s *dev, off_t offset,
   /* Lock the QuadSPI bus and select this FLASH part */
 
   w25qxxxjv_lock(priv->qspi);
+  w25qxxxjv_memmap(priv, 0, 0);
 
   ret = w25qxxxjv_read_byte(priv, buffer, offset, nbytes);
   w25qxxxjv_unlock(priv->qspi);
@@ -1585,7 +1682,10 @@ static int w25qxxxjv_ioctl(FAR struct mtd_dev_s *dev, int cmd,
           /* Erase the entire device */
 
           w25qxxxjv_lock(priv->qspi);
+          w25qxxxjv_unmap(priv);
           ret = w25qxxxjv_erase_chip(priv);
+          w25qxxxjv_memmap(priv, 0, (size_t)priv->nsectors <<
+                                    priv->sectorshift);
           w25qxxxjv_unlock(priv->qspi);
         }
         break;
@@ -1596,7 +1696,11 @@ static int w25qxxxjv_ioctl(FAR struct mtd_dev_s *dev, int cmd,
             (FAR const struct mtd_protect_s *)((uintptr_t)arg);
 
           DEBUGASSERT(prot);
+          w25qxxxjv_lock(priv->qspi);
+          w25qxxxjv_unmap(priv);
           ret = w25qxxxjv_protect(priv, prot->startblock, prot->nblocks);
+          w25qxxxjv_memmap(priv, 0, 0);
+          w25qxxxjv_unlock(priv->qspi);
         }
         break;
 
@@ -1606,10 +1710,40 @@ static int w25qxxxjv_ioctl(FAR struct mtd_dev_s *dev, int cmd,
             (FAR const struct mtd_protect_s *)((uintptr_t)arg);
 
           DEBUGASSERT(prot);
+          w25qxxxjv_lock(priv->qspi);
+          w25qxxxjv_unmap(priv);
           ret = w25qxxxjv_unprotect(priv, prot->startblock, prot->nblocks);
+          w25qxxxjv_memmap(priv, 0, 0);
+          w25qxxxjv_unlock(priv->qspi);
         }
         break;
 
+#ifdef CONFIG_W25QXXXJV_MEMMAP
+      case BIOC_XIPBASE:
+        {
+          FAR void **ppv = (FAR void **)((uintptr_t)arg);
+
+          /* Return the memory-mapped window of the FLASH.  It cannot be
+           * read while the FLASH is programmed or erased.
+           */
+
+          w25qxxxjv_lock(priv->qspi);
+          w25qxxxjv_memmap(priv, 0, 0);
+          if (priv->membase == NULL)
+            {
+              ret = -ENOTTY;
+            }
+          else if (ppv != NULL)
+            {
+              *ppv = priv->membase;
+              ret  = OK;
+            }
+
+          w25qxxxjv_unlock(priv->qspi);
+        }
+        break;
+#endif
+
       case MTDIOC_ERASESTATE:
         {
           FAR uint8_t *result = (FAR uint8_t *)arg;
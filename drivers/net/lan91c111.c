@@ -726,7 +726,7 @@ static void lan91c111_txdone(FAR struct net_driver_s *dev)
 #ifdef CONFIG_NETDEV_STATISTICS
       /* Revert the increment in lan91c111_transmit */
 
-      dev->d_statistics.tx_done--;
+      NETDEV_STATS(dev).tx_done--;
 #endif
       NETDEV_TXERRORS(dev);
     }
@@ -34,9 +34,14 @@
 #include <nuttx/kthread.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/can.h>
+#include <nuttx/net/ethernet.h>
+#include <nuttx/net/ip.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev_lowerhalf.h>
 #include <nuttx/net/pkt.h>
+#include <nuttx/net/rxfilter.h>
+#include <nuttx/net/tcp.h>
+#include <nuttx/net/udp.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/spinlock.h>
 
@@ -55,9 +60,25 @@
 #endif
 
 #ifdef CONFIG_NETDEV_RSS
-#  define NETDEV_THREAD_COUNT CONFIG_SMP_NCPUS
+#  define NETDEV_RSS_THREADS CONFIG_SMP_NCPUS
 #else
-#  define NETDEV_THREAD_COUNT 1
+#  define NETDEV_RSS_THREADS 1
+#endif
+
+/* A worker per CPU with RSS, a worker per queue with multi-queue devices */
+
+#if defined(CONFIG_NETDEV_MULTIQUEUE) && \
+    CONFIG_NETDEV_MAX_QUEUES > NETDEV_RSS_THREADS
+#  define NETDEV_THREAD_COUNT CONFIG_NETDEV_MAX_QUEUES
+#else
+#  define NETDEV_THREAD_COUNT NETDEV_RSS_THREADS
+#endif
+
+/* The workers are pinned to CPU (index % CONFIG_SMP_NCPUS) */
+
+#if defined(CONFIG_NETDEV_RSS) || \
+    (defined(CONFIG_NETDEV_MULTIQUEUE) && defined(CONFIG_SMP))
+#  define NETDEV_THREAD_PINNED
 #endif
 
 /****************************************************************************
@@ -85,8 +106,38 @@ struct netdev_upperhalf_s
 #if CONFIG_IOB_NCHAINS > 0
   struct iob_queue_s txq;
 #endif
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  /* The queue of the worker holding the network lock, the packets polled
+   * from the stack are transmitted on it.
+   */
+
+  unsigned int txqueue;
+#endif
 };
 
+#ifdef CONFIG_NETDEV_GRO
+/* The TCP segments of a flow merged in a receive poll batch */
+
+struct netdev_gro_s
+{
+  FAR netpkt_t *pkt;    /* The first segment, followed by the payloads of
+                         * the others, NULL if none */
+  uint32_t      seqno;  /* The sequence number of the next segment */
+  uint16_t      seglen; /* The payload length of the first segment */
+  uint16_t      nseg;   /* The number of segments merged */
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+  uint16_t      dsum;   /* The checksum of the merged payloads */
+#endif
+};
+#endif
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int netdev_upper_txavail(FAR struct net_driver_s *dev);
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -221,6 +272,110 @@ netdev_upper_alloc(FAR struct netdev_lowerhalf_s *dev)
   return upper;
 }
 
+/****************************************************************************
+ * Name: netdev_upper_nqueues
+ *
+ * Description:
+ *   Return the number of queues served by the upper half.
+ *
+ ****************************************************************************/
+
+static inline unsigned int
+netdev_upper_nqueues(FAR struct netdev_lowerhalf_s *lower)
+{
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  if (lower->nqueues > 1)
+    {
+      return lower->nqueues;
+    }
+#endif
+
+  return 1;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_receive/transmit/reclaim
+ *
+ * Description:
+ *   Call the receive, transmit or reclaim operation of the lower half on
+ *   the queue of the worker, the queued variant if the device has several
+ *   queues.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static inline FAR netpkt_t *
+netdev_upper_receive(FAR struct netdev_lowerhalf_s *lower,
+                     unsigned int queue)
+{
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  if (lower->nqueues > 1)
+    {
+      return lower->ops->receiveq(lower, queue);
+    }
+#endif
+
+  return lower->ops->receive(lower);
+}
+
+static inline int netdev_upper_transmit(FAR struct netdev_upperhalf_s *upper,
+                                        FAR netpkt_t *pkt)
+{
+  FAR struct netdev_lowerhalf_s *lower = upper->lower;
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  if (lower->nqueues > 1)
+    {
+      return lower->ops->transmitq(lower, pkt, upper->txqueue);
+    }
+#endif
+
+  return lower->ops->transmit(lower, pkt);
+}
+
+static inline void netdev_upper_reclaim(FAR struct netdev_upperhalf_s *upper)
+{
+  FAR struct netdev_lowerhalf_s *lower = upper->lower;
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  if (lower->nqueues > 1)
+    {
+      if (lower->ops->reclaimq)
+        {
+          lower->ops->reclaimq(lower, upper->txqueue);
+        }
+
+      return;
+    }
+#endif
+
+  if (lower->ops->reclaim)
+    {
+      lower->ops->reclaim(lower);
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_upper_rxint
+ *
+ * Description:
+ *   Disable or enable the RX interrupts of a queue, if the lower half can.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_NAPI
+static inline void netdev_upper_rxint(FAR struct netdev_lowerhalf_s *lower,
+                                      unsigned int queue, bool enable)
+{
+  if (lower->ops->rxint)
+    {
+      lower->ops->rxint(lower, queue, enable);
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: netdev_upper_can_tx
  *
@@ -237,15 +392,322 @@ static inline bool netdev_upper_can_tx(FAR struct netdev_upperhalf_s *upper)
   FAR struct netdev_lowerhalf_s *lower = upper->lower;
   int quota = netdev_lower_quota_load(lower, NETPKT_TX);
 
-  if (quota <= 0 && lower->ops->reclaim)
+  if (quota <= 0)
     {
-      lower->ops->reclaim(lower);
+      netdev_upper_reclaim(upper);
       quota = netdev_lower_quota_load(lower, NETPKT_TX);
     }
 
   return quota > 0;
 }
 
+/****************************************************************************
+ * Name: netdev_upper_gso_proto
+ *
+ * Description:
+ *   Return the transport protocol of the IP packet at 'ip'.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_GSO
+static uint8_t netdev_upper_gso_proto(FAR const uint8_t *ip)
+{
+#ifdef CONFIG_NET_IPv4
+  if ((*ip >> 4) == 4)
+    {
+      return ((FAR const struct ipv4_hdr_s *)ip)->proto;
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if ((*ip >> 4) == 6)
+    {
+      return ((FAR const struct ipv6_hdr_s *)ip)->proto;
+    }
+#endif
+
+  return 0;
+}
+#endif
+
+/****************************************************************************
+ * Name: netdev_upper_tso
+ *
+ * Description:
+ *   Check if the lower half segments the super-segment in d_iob itself.
+ *   The UDP super-datagrams are always segmented by the upper half.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_GSO
+static bool netdev_upper_tso(FAR struct net_driver_s *dev)
+{
+  FAR struct netdev_upperhalf_s *upper = dev->d_private;
+  uint8_t version = *IOB_DATA(dev->d_iob) >> 4;
+
+  if (netdev_upper_gso_proto(IOB_DATA(dev->d_iob)) != IP_PROTO_TCP)
+    {
+      return false;
+    }
+
+  return (version == 4 && (upper->lower->tso & NETDEV_TSO_IPv4) != 0) ||
+         (version == 6 && (upper->lower->tso & NETDEV_TSO_IPv6) != 0);
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gso_fixup
+ *
+ * Description:
+ *   Fix the headers copied from a super-segment in one of its segments:
+ *   The lengths, the sequence number, the IPv4 identification, the flags
+ *   that belong to the last segment only, and the checksums.  A segment of
+ *   a UDP super-datagram is a datagram of its own.
+ *
+ * Input Parameters:
+ *   dev      - Reference to the NuttX driver state structure
+ *   seg      - The segment
+ *   iphdrlen - The length of the IP header
+ *   proto    - The transport protocol, IP_PROTO_TCP or IP_PROTO_UDP
+ *   nseg     - The index of the segment in the super-segment
+ *   offset   - The offset of the payload of the segment
+ *   last     - True for the last segment
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_gso_fixup(FAR struct net_driver_s *dev,
+                                   FAR struct iob_s *seg,
+                                   unsigned int iphdrlen, uint8_t proto,
+                                   int nseg, unsigned int offset, bool last)
+{
+  FAR uint8_t *ip = IOB_DATA(seg);
+  FAR struct tcp_hdr_s *tcp = (FAR struct tcp_hdr_s *)(ip + iphdrlen);
+  FAR struct udp_hdr_s *udp = (FAR struct udp_hdr_s *)(ip + iphdrlen);
+  FAR struct iob_s *iob = dev->d_iob;
+  uint16_t len = seg->io_pktlen;
+  uint32_t seqno;
+
+  if (proto == IP_PROTO_UDP)
+    {
+      /* The length of the datagram */
+
+      udp->udplen    = HTONS(len - iphdrlen);
+      udp->udpchksum = 0;
+    }
+  else
+    {
+      /* The sequence number and the flags */
+
+      seqno = ((uint32_t)tcp->seqno[0] << 24) |
+              ((uint32_t)tcp->seqno[1] << 16) |
+              ((uint32_t)tcp->seqno[2] << 8) | tcp->seqno[3];
+      seqno += offset;
+
+      tcp->seqno[0] = seqno >> 24;
+      tcp->seqno[1] = seqno >> 16;
+      tcp->seqno[2] = seqno >> 8;
+      tcp->seqno[3] = seqno;
+
+      if (!last)
+        {
+          tcp->flags &= ~(TCP_FIN | TCP_PSH);
+        }
+
+      tcp->tcpchksum = 0;
+    }
+
+  /* The checksums are calculated over the segment as the packet of the
+   * device.
+   */
+
+  dev->d_iob = seg;
+
+#ifdef CONFIG_NET_IPv4
+  if ((*ip >> 4) == 4)
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)ip;
+      uint16_t ipid = ((uint16_t)ipv4->ipid[0] << 8) + ipv4->ipid[1] + nseg;
+
+      ipv4->len[0]   = len >> 8;
+      ipv4->len[1]   = len & 0xff;
+      ipv4->ipid[0]  = ipid >> 8;
+      ipv4->ipid[1]  = ipid & 0xff;
+      ipv4->ipchksum = 0;
+#ifdef CONFIG_NET_IPV4_CHECKSUMS
+      ipv4->ipchksum = ~ipv4_chksum(ipv4);
+#endif
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+      if (proto == IP_PROTO_TCP)
+        {
+          tcp->tcpchksum = ~ipv4_upperlayer_chksum(dev, IP_PROTO_TCP);
+        }
+#endif
+
+#ifdef CONFIG_NET_UDP_CHECKSUMS
+      if (proto == IP_PROTO_UDP)
+        {
+          udp->udpchksum = ~ipv4_upperlayer_chksum(dev, IP_PROTO_UDP);
+        }
+#endif
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if ((*ip >> 4) == 6)
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)ip;
+
+      len          -= IPv6_HDRLEN;
+      ipv6->len[0]  = len >> 8;
+      ipv6->len[1]  = len & 0xff;
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+      if (proto == IP_PROTO_TCP)
+        {
+          tcp->tcpchksum = ~ipv6_upperlayer_chksum(dev, IP_PROTO_TCP,
+                                                   IPv6_HDRLEN);
+        }
+#endif
+
+#ifdef CONFIG_NET_UDP_CHECKSUMS
+      if (proto == IP_PROTO_UDP)
+        {
+          udp->udpchksum = ~ipv6_upperlayer_chksum(dev, IP_PROTO_UDP,
+                                                   IPv6_HDRLEN);
+        }
+#endif
+    }
+#endif
+
+#ifdef CONFIG_NET_UDP_CHECKSUMS
+  /* A zero UDP checksum means that there is none */
+
+  if (proto == IP_PROTO_UDP && udp->udpchksum == 0)
+    {
+      udp->udpchksum = 0xffff;
+    }
+#endif
+
+  dev->d_iob = iob;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gso
+ *
+ * Description:
+ *   Segment the TCP super-segment or the UDP super-datagram in d_iob in
+ *   software:  The segments are added to the TX queue and the
+ *   super-segment is released.  A segment that cannot be allocated is
+ *   dropped with the rest of the super-segment, TCP retransmits it while
+ *   the UDP datagrams are lost.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *
+ * Returned Value:
+ *   NETDEV_TX_CONTINUE, the segments are sent from the TX queue.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static int netdev_upper_gso(FAR struct net_driver_s *dev)
+{
+  FAR struct netdev_upperhalf_s *upper = dev->d_private;
+  FAR struct iob_s *pkt = dev->d_iob;
+  FAR uint8_t *ip = IOB_DATA(pkt);
+  FAR struct tcp_hdr_s *tcp;
+  FAR struct iob_s *seg;
+  uint8_t llhdrlen = NET_LL_HDRLEN(dev);
+  unsigned int iphdrlen;
+  unsigned int hdrlen;
+  unsigned int paylen;
+  unsigned int offset = 0;
+  unsigned int seglen;
+  uint8_t proto = netdev_upper_gso_proto(ip);
+  int nseg = 0;
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if ((*ip >> 4) == 4)
+#endif
+    {
+      iphdrlen = (((FAR struct ipv4_hdr_s *)ip)->vhl & IPv4_HLMASK) << 2;
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      iphdrlen = IPv6_HDRLEN;
+    }
+#endif
+
+  /* The headers are all in the first IOB, as built by the stack */
+
+  if (proto == IP_PROTO_UDP)
+    {
+      hdrlen = iphdrlen + UDP_HDRLEN;
+    }
+  else
+    {
+      tcp    = (FAR struct tcp_hdr_s *)(ip + iphdrlen);
+      hdrlen = iphdrlen + ((tcp->tcpoffset >> 4) << 2);
+    }
+
+  paylen = pkt->io_pktlen - hdrlen;
+
+  while (offset < paylen)
+    {
+      seglen = MIN(dev->d_gsosize, paylen - offset);
+
+      seg = iob_tryalloc(false);
+      if (seg == NULL)
+        {
+          break;
+        }
+
+      iob_reserve(seg, CONFIG_NET_LL_GUARDSIZE);
+      memcpy(IOB_DATA(seg) - llhdrlen, ip - llhdrlen, llhdrlen);
+
+      if (iob_trycopyin(seg, ip, hdrlen, 0, false) != hdrlen ||
+          iob_clone_partial(pkt, seglen, hdrlen + offset, seg, hdrlen,
+                            false, false) < 0)
+        {
+          iob_free_chain(seg);
+          break;
+        }
+
+      netdev_upper_gso_fixup(dev, seg, iphdrlen, proto, nseg, offset,
+                             offset + seglen >= paylen);
+
+      if (iob_tryadd_queue(seg, &upper->txq) < 0)
+        {
+          iob_free_chain(seg);
+          break;
+        }
+
+      offset += seglen;
+      nseg++;
+    }
+
+  if (offset < paylen)
+    {
+      nwarn("WARNING: Dropped %u bytes of a super-segment\n",
+            paylen - offset);
+      NETDEV_TXERRORS(dev);
+    }
+
+  dev->d_gsosize = 0;
+  netdev_iob_release(dev);
+  return NETDEV_TX_CONTINUE;
+}
+#endif
+
 /****************************************************************************
  * Name: netdev_upper_txpoll
  *
@@ -280,6 +742,22 @@ static int netdev_upper_txpoll(FAR struct net_driver_s *dev)
 
   DEBUGASSERT(dev->d_len > 0);
 
+#ifdef CONFIG_NETDEV_GSO
+  /* A super-segment is larger than the MTU, d_gsosize may be stale if the
+   * stack replaced the packet (e.g. by an ARP request).
+   */
+
+  if (dev->d_gsosize > 0 &&
+      netpkt_getdatalen(lower, dev->d_iob) <= NETDEV_PKTSIZE(dev))
+    {
+      dev->d_gsosize = 0;
+    }
+  else if (dev->d_gsosize > 0 && !netdev_upper_tso(dev))
+    {
+      return netdev_upper_gso(dev);
+    }
+#endif
+
   NETDEV_TXPACKETS(dev);
 
 #ifdef CONFIG_NET_PKT
@@ -290,16 +768,21 @@ static int netdev_upper_txpoll(FAR struct net_driver_s *dev)
 
   pkt = netpkt_get(dev, NETPKT_TX);
 
-  if (netpkt_getdatalen(lower, pkt) > NETDEV_PKTSIZE(dev))
+  if (netpkt_getdatalen(lower, pkt) > NETDEV_PKTSIZE(dev) &&
+      netpkt_gsosize(lower, pkt) == 0)
     {
       nerr("ERROR: Packet too long to send!\n");
       ret = -EMSGSIZE;
     }
   else
     {
-      ret = lower->ops->transmit(lower, pkt);
+      ret = netdev_upper_transmit(upper, pkt);
     }
 
+#ifdef CONFIG_NETDEV_GSO
+  dev->d_gsosize = 0;
+#endif
+
   if (ret != OK)
     {
       /* Stop polling on any error
@@ -402,6 +885,19 @@ static void netdev_upper_queue_tx(FAR struct net_driver_s *dev)
   FAR struct netdev_upperhalf_s *upper = dev->d_private;
   int ret;
 
+#ifdef CONFIG_NETDEV_GSO
+  /* The segment size of a super-segment is not kept in the queue */
+
+  if (dev->d_gsosize > 0 &&
+      netpkt_getdatalen(upper->lower, dev->d_iob) > NETDEV_PKTSIZE(dev))
+    {
+      netdev_upper_gso(dev);
+      return;
+    }
+
+  dev->d_gsosize = 0;
+#endif
+
   if ((ret = iob_tryadd_queue(dev->d_iob, &upper->txq)) >= 0)
     {
       netdev_iob_clear(dev);
@@ -576,8 +1072,411 @@ static void ip_input(FAR struct net_driver_s *dev)
        * Note: RX is tried before TX, so we don't need to call txavail here.
        */
 
-      netdev_upper_queue_tx(dev);
+      netdev_upper_queue_tx(dev);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: netdev_upper_input
+ *
+ * Description:
+ *   Pass a received packet into the network stack.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   pkt   - The received packet
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_input(FAR struct netdev_upperhalf_s *upper,
+                               FAR netpkt_t *pkt)
+{
+  FAR struct net_driver_s *dev = &upper->lower->netdev;
+
+  netpkt_put(dev, pkt, NETPKT_RX);
+  NETDEV_RXPACKETS(dev);
+
+#ifdef CONFIG_NET_PKT
+  /* When packet sockets are enabled, feed the frame into the tap */
+
+  pkt_input(dev);
+#endif
+
+  switch (dev->d_lltype)
+    {
+#ifdef CONFIG_NET_LOOPBACK
+    case NET_LL_LOOPBACK:
+#endif
+#ifdef CONFIG_NET_ETHERNET
+    case NET_LL_ETHERNET:
+#endif
+#ifdef CONFIG_DRIVERS_IEEE80211
+    case NET_LL_IEEE80211:
+#endif
+#if defined(CONFIG_NET_LOOPBACK) || defined(CONFIG_NET_ETHERNET) || \
+    defined(CONFIG_DRIVERS_IEEE80211)
+      eth_input(dev);
+      break;
+#endif
+#ifdef CONFIG_NET_MBIM
+    case NET_LL_MBIM:
+      ip_input(dev);
+      break;
+#endif
+#ifdef CONFIG_NET_CAN
+    case NET_LL_CAN:
+      ninfo("CAN frame");
+      can_input(dev);
+      break;
+#endif
+    default:
+      nerr("Unknown link type %d\n", dev->d_lltype);
+      break;
+    }
+}
+
+#ifdef CONFIG_NETDEV_GRO
+
+/****************************************************************************
+ * Name: netdev_upper_gro_seglen
+ *
+ * Description:
+ *   Check if a received packet is a TCP segment that may be merged with
+ *   others:  An IPv4 packet without options nor fragmentation for this
+ *   host, with data and no other flag than ACK and PSH.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *   pkt - The received packet
+ *
+ * Returned Value:
+ *   The length of the TCP payload, zero if the packet cannot be merged.
+ *
+ ****************************************************************************/
+
+static uint16_t netdev_upper_gro_seglen(FAR struct net_driver_s *dev,
+                                        FAR netpkt_t *pkt)
+{
+  FAR struct eth_hdr_s *eth =
+    (FAR struct eth_hdr_s *)(IOB_DATA(pkt) - ETH_HDRLEN);
+  FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)IOB_DATA(pkt);
+  FAR struct tcp_hdr_s *tcp = (FAR struct tcp_hdr_s *)(ipv4 + 1);
+  unsigned int hdrlen;
+
+  if (dev->d_lltype != NET_LL_ETHERNET || eth->type != HTONS(ETHTYPE_IP) ||
+      pkt->io_len < IPv4TCP_HDRLEN || ipv4->vhl != 0x45 ||
+      ipv4->proto != IP_PROTO_TCP ||
+      (ipv4->ipoffset[0] & 0x3f) != 0 || ipv4->ipoffset[1] != 0 ||
+      ((ipv4->len[0] << 8) | ipv4->len[1]) != pkt->io_pktlen ||
+      !net_ipv4addr_cmp(net_ip4addr_conv32(ipv4->destipaddr),
+                        dev->d_ipaddr))
+    {
+      return 0;
+    }
+
+  hdrlen = IPv4_HDRLEN + ((tcp->tcpoffset >> 4) << 2);
+  if ((tcp->flags & ~TCP_PSH) != TCP_ACK || hdrlen < IPv4TCP_HDRLEN ||
+      hdrlen > pkt->io_len || hdrlen >= pkt->io_pktlen)
+    {
+      return 0;
+    }
+
+#ifdef CONFIG_NET_IPV4_CHECKSUMS
+  /* The headers of the segments merged into another one are lost, they
+   * must be sound.
+   */
+
+  if (ipv4_chksum(ipv4) != 0xffff)
+    {
+      return 0;
+    }
+#endif
+
+  return pkt->io_pktlen - hdrlen;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_hsum
+ *
+ * Description:
+ *   Calculate the TCP checksum of a segment over its pseudo-header and its
+ *   TCP header only.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+static uint16_t netdev_upper_gro_hsum(FAR netpkt_t *pkt)
+{
+  FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)IOB_DATA(pkt);
+  FAR struct tcp_hdr_s *tcp = (FAR struct tcp_hdr_s *)(ipv4 + 1);
+  uint16_t sum;
+
+  sum = pkt->io_pktlen - IPv4_HDRLEN + IP_PROTO_TCP;
+  sum = chksum(sum, (FAR uint8_t *)&ipv4->srcipaddr, 2 * sizeof(in_addr_t));
+  return chksum(sum, (FAR uint8_t *)tcp, (tcp->tcpoffset >> 4) << 2);
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_csum
+ *
+ * Description:
+ *   Add a segment to the checksum of the merged payloads:  The checksum of
+ *   the payload of a sound segment is the complement of the checksum of its
+ *   headers, so the payload is never read here.  A damaged segment makes
+ *   the checksum of the merged packet wrong and TCP drops all of it, as it
+ *   would have dropped the damaged segment alone.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_gro_csum(FAR struct netdev_gro_s *gro,
+                                  FAR netpkt_t *pkt)
+{
+  uint16_t dsum = ~netdev_upper_gro_hsum(pkt);
+
+  gro->dsum += dsum;
+  if (gro->dsum < dsum)
+    {
+      gro->dsum++;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: netdev_upper_gro_flush
+ *
+ * Description:
+ *   Pass the segments merged so far into the network stack as a single
+ *   packet, fixing the length and the checksums of its headers.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   gro   - The merged segments
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_gro_flush(FAR struct netdev_upperhalf_s *upper,
+                                   FAR struct netdev_gro_s *gro)
+{
+  FAR netpkt_t *pkt = gro->pkt;
+  FAR struct ipv4_hdr_s *ipv4;
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+  FAR struct tcp_hdr_s *tcp;
+  uint16_t sum;
+#endif
+
+  if (pkt == NULL)
+    {
+      return;
+    }
+
+  gro->pkt = NULL;
+  if (gro->nseg > 1)
+    {
+      ipv4           = (FAR struct ipv4_hdr_s *)IOB_DATA(pkt);
+      ipv4->len[0]   = pkt->io_pktlen >> 8;
+      ipv4->len[1]   = pkt->io_pktlen & 0xff;
+      ipv4->ipchksum = 0;
+#ifdef CONFIG_NET_IPV4_CHECKSUMS
+      ipv4->ipchksum = ~ipv4_chksum(ipv4);
+#endif
+
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+      tcp            = (FAR struct tcp_hdr_s *)(ipv4 + 1);
+      tcp->tcpchksum = 0;
+      sum            = netdev_upper_gro_hsum(pkt) + gro->dsum;
+      if (sum < gro->dsum)
+        {
+          sum++;
+        }
+
+      tcp->tcpchksum = ~((sum == 0) ? 0xffff : HTONS(sum));
+#endif
+    }
+
+  netdev_upper_input(upper, pkt);
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_input
+ *
+ * Description:
+ *   Merge a received packet with the previous ones if it is the next TCP
+ *   segment of the same flow, otherwise pass the previous ones into the
+ *   network stack first.  The segments are merged while they have the
+ *   same length as the first one, so that the payloads stay aligned on
+ *   16 bits for the checksum:  A shorter segment or a segment with PSH
+ *   ends the merge.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   gro   - The merged segments
+ *   pkt   - The received packet
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_gro_input(FAR struct netdev_upperhalf_s *upper,
+                                   FAR struct netdev_gro_s *gro,
+                                   FAR netpkt_t *pkt)
+{
+  FAR struct net_driver_s *dev = &upper->lower->netdev;
+  FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)IOB_DATA(pkt);
+  FAR struct tcp_hdr_s *tcp = (FAR struct tcp_hdr_s *)(ipv4 + 1);
+  FAR struct ipv4_hdr_s *gipv4;
+  FAR struct tcp_hdr_s *gtcp;
+  uint16_t seglen;
+  uint32_t seqno;
+  uint8_t flags;
+
+  seglen = netdev_upper_gro_seglen(dev, pkt);
+  if (seglen == 0)
+    {
+      netdev_upper_gro_flush(upper, gro);
+      netdev_upper_input(upper, pkt);
+      return;
+    }
+
+  seqno = ((uint32_t)tcp->seqno[0] << 24) | ((uint32_t)tcp->seqno[1] << 16) |
+          ((uint32_t)tcp->seqno[2] << 8) | tcp->seqno[3];
+  flags = tcp->flags;
+
+  if (gro->pkt != NULL)
+    {
+      gipv4 = (FAR struct ipv4_hdr_s *)IOB_DATA(gro->pkt);
+      gtcp  = (FAR struct tcp_hdr_s *)(gipv4 + 1);
+
+      if (seqno == gro->seqno && seglen <= gro->seglen &&
+          gro->pkt->io_pktlen + seglen <= CONFIG_NETDEV_GRO_MAXSIZE &&
+          ipv4->tos == gipv4->tos && ipv4->ttl == gipv4->ttl &&
+          memcmp(ipv4->srcipaddr, gipv4->srcipaddr,
+                 2 * sizeof(in_addr_t)) == 0 &&
+          tcp->srcport == gtcp->srcport && tcp->destport == gtcp->destport &&
+          memcmp(tcp->ackno, gtcp->ackno, 5) == 0 &&
+          memcmp(tcp->wnd, gtcp->wnd, 2) == 0 &&
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+          pkt->io_csumflags == gro->pkt->io_csumflags &&
+#endif
+          memcmp(tcp->optdata, gtcp->optdata,
+                 ((tcp->tcpoffset >> 4) << 2) - TCP_HDRLEN) == 0)
+        {
+          /* Append the payload of the segment to the merged segments */
+
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+          netdev_upper_gro_csum(gro, pkt);
+#endif
+          gtcp->flags |= flags;
+          gro->seqno  += seglen;
+          gro->nseg++;
+
+          NETDEV_RXPACKETS(dev);
+          atomic_fetch_add(&upper->lower->quota[NETPKT_RX], 1);
+          iob_concat(gro->pkt,
+                     iob_trimhead(pkt, pkt->io_pktlen - seglen));
+
+          if (seglen < gro->seglen || (flags & TCP_PSH) != 0)
+            {
+              netdev_upper_gro_flush(upper, gro);
+            }
+
+          return;
+        }
+
+      netdev_upper_gro_flush(upper, gro);
+    }
+
+  if ((seglen & 1) != 0 || (flags & TCP_PSH) != 0)
+    {
+      netdev_upper_input(upper, pkt);
+      return;
+    }
+
+  /* Keep the segment, the next ones may follow in the same batch */
+
+  gro->pkt    = pkt;
+  gro->seqno  = seqno + seglen;
+  gro->seglen = seglen;
+  gro->nseg   = 1;
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+  gro->dsum   = 0;
+  netdev_upper_gro_csum(gro, pkt);
+#endif
+}
+#endif /* CONFIG_NETDEV_GRO */
+
+/****************************************************************************
+ * Name: netdev_upper_rxfilter
+ *
+ * Description:
+ *   Apply the receive filter rules of the device to a received frame,
+ *   before any work of the network stack.  A redirected frame is queued
+ *   for transmission on the output device as is, the output device must be
+ *   up, based on the upper half and of the same link type.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   pkt   - The received packet
+ *
+ * Returned Value:
+ *   True if the packet was consumed by the filter.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_RXFILTER
+static bool netdev_upper_rxfilter(FAR struct netdev_upperhalf_s *upper,
+                                  FAR netpkt_t *pkt)
+{
+  FAR struct netdev_lowerhalf_s *lower = upper->lower;
+  FAR struct net_driver_s *dev = &lower->netdev;
+  FAR struct net_driver_s *target = NULL;
+  unsigned int len;
+
+  /* The rules only look into the first buffer of the frame */
+
+  len = MIN(pkt->io_len + NET_LL_HDRLEN(dev),
+            netpkt_getdatalen(lower, pkt));
+
+  switch (netdev_rxfilter(dev, netpkt_getdata(lower, pkt), len, &target))
+    {
+      case RXFILTER_PASS:
+        return false;
+
+#if CONFIG_IOB_NCHAINS > 0
+      case RXFILTER_REDIRECT:
+        if (target != NULL && target->d_txavail == netdev_upper_txavail &&
+            target->d_lltype == dev->d_lltype &&
+            IFF_IS_UP(target->d_flags) &&
+            iob_tryadd_queue(pkt, &((FAR struct netdev_upperhalf_s *)
+                                    target->d_private)->txq) >= 0)
+          {
+            atomic_fetch_add(&lower->quota[NETPKT_RX], 1);
+            target->d_txavail(target);
+            return true;
+          }
+
+        /* Drop the frames that cannot be redirected */
+
+        break;
+#endif
+
+      default:
+        break;
     }
+
+  NETDEV_RXDROPPED(dev);
+  netpkt_free(lower, pkt, NETPKT_RX);
+  return true;
 }
 #endif
 
@@ -587,24 +1486,47 @@ static void ip_input(FAR struct net_driver_s *dev)
  * Description:
  *   Try to receive packets from device and pass packets into IP
  *   stack and send packets which is from IP stack if necessary.
+ *   With CONFIG_NETDEV_GRO, the consecutive TCP segments of a flow
+ *   received in the same batch are merged into a single packet first.
+ *   With CONFIG_NETDEV_NAPI, at most CONFIG_NETDEV_NAPI_BUDGET frames are
+ *   received, the RX interrupts are enabled again if the queue is drained.
  *
  * Input Parameters:
  *   upper - Reference to the upper half driver structure
+ *   queue - The RX queue to receive from
+ *
+ * Returned Value:
+ *   True if the budget is exhausted and the queue must be polled again.
  *
  * Assumptions:
  *   Called with the network locked.
  *
  ****************************************************************************/
 
-static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
+static bool netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper,
+                                     unsigned int queue)
 {
   FAR struct netdev_lowerhalf_s *lower = upper->lower;
   FAR struct net_driver_s       *dev   = &lower->netdev;
   FAR netpkt_t                  *pkt;
+#ifdef CONFIG_NETDEV_NAPI
+  int                            budget = CONFIG_NETDEV_NAPI_BUDGET;
+#endif
+#ifdef CONFIG_NETDEV_GRO
+  struct netdev_gro_s            gro;
+
+  gro.pkt = NULL;
+#endif
+
+  NETDEV_RXPOLLS(dev);
 
   /* Loop while receive() successfully retrieves valid Ethernet frames. */
 
-  while ((pkt = lower->ops->receive(lower)) != NULL)
+  while (
+#ifdef CONFIG_NETDEV_NAPI
+         budget-- > 0 &&
+#endif
+         (pkt = netdev_upper_receive(lower, queue)) != NULL)
     {
       if (!IFF_IS_UP(dev->d_flags))
         {
@@ -615,71 +1537,131 @@ static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
           continue;
         }
 
-      netpkt_put(dev, pkt, NETPKT_RX);
-      NETDEV_RXPACKETS(dev);
-
-#ifdef CONFIG_NET_PKT
-      /* When packet sockets are enabled, feed the frame into the tap */
-
-      pkt_input(dev);
-#endif
-
-      switch (dev->d_lltype)
+#ifdef CONFIG_NETDEV_RXFILTER
+      if (dev->d_rxfilter != NULL && netdev_upper_rxfilter(upper, pkt))
         {
-#ifdef CONFIG_NET_LOOPBACK
-        case NET_LL_LOOPBACK:
-#endif
-#ifdef CONFIG_NET_ETHERNET
-        case NET_LL_ETHERNET:
+          continue;
+        }
 #endif
-#ifdef CONFIG_DRIVERS_IEEE80211
-        case NET_LL_IEEE80211:
+
+#ifdef CONFIG_NETDEV_GRO
+      netdev_upper_gro_input(upper, &gro, pkt);
+#else
+      netdev_upper_input(upper, pkt);
 #endif
-#if defined(CONFIG_NET_LOOPBACK) || defined(CONFIG_NET_ETHERNET) || \
-    defined(CONFIG_DRIVERS_IEEE80211)
-          eth_input(dev);
-          break;
+    }
+
+#ifdef CONFIG_NETDEV_GRO
+  netdev_upper_gro_flush(upper, &gro);
 #endif
-#ifdef CONFIG_NET_MBIM
-        case NET_LL_MBIM:
-          ip_input(dev);
-          break;
+
+#ifdef CONFIG_NETDEV_NAPI
+  if (budget < 0)
+    {
+      /* Keep the interrupts disabled, frames are left */
+
+      NETDEV_RXBUDGETS(dev);
+      return true;
+    }
+
+  netdev_upper_rxint(lower, queue, true);
 #endif
-#ifdef CONFIG_NET_CAN
-        case NET_LL_CAN:
-          ninfo("CAN frame");
-          can_input(dev);
-          break;
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_work_queue
+ *
+ * Description:
+ *   Perform an out-of-cycle poll of a queue of the device.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   queue - The queue of the worker
+ *
+ * Returned Value:
+ *   True if the queue must be polled again.
+ *
+ ****************************************************************************/
+
+static bool netdev_upper_work_queue(FAR struct netdev_upperhalf_s *upper,
+                                    unsigned int queue)
+{
+  bool more;
+
+  /* RX may release quota and driver buffer, so do RX first. */
+
+  net_lock();
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  upper->txqueue = queue;
 #endif
-        default:
-          nerr("Unknown link type %d\n", dev->d_lltype);
-          break;
-        }
-    }
+  more = netdev_upper_rxpoll_work(upper, queue);
+  netdev_upper_txavail_work(upper);
+  net_unlock();
+
+  return more;
 }
 
 /****************************************************************************
  * Name: netdev_upper_work
  *
  * Description:
- *   Perform an out-of-cycle poll on a dedicated thread or the worker thread.
+ *   Perform an out-of-cycle poll on the worker thread.
  *
  * Input Parameters:
  *   arg - Reference to the upper half driver structure (cast to void *)
  *
  ****************************************************************************/
 
+#ifndef CONFIG_NETDEV_WORK_THREAD
 static void netdev_upper_work(FAR void *arg)
 {
   FAR struct netdev_upperhalf_s *upper = arg;
 
-  /* RX may release quota and driver buffer, so do RX first. */
+  if (netdev_upper_work_queue(upper, 0))
+    {
+      /* Poll again after the other work of the queue */
 
-  net_lock();
-  netdev_upper_rxpoll_work(upper);
-  netdev_upper_txavail_work(upper);
-  net_unlock();
+      work_queue_on(NETDEV_WORK, this_cpu(), &upper->work,
+                    netdev_upper_work, upper, 0);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: netdev_upper_nthreads
+ *
+ * Description:
+ *   Return the number of dedicated threads of a device:  One per queue of
+ *   a device with several queues, one per CPU with RSS, else one.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_WORK_THREAD
+static inline int netdev_upper_nthreads(FAR struct netdev_upperhalf_s *upper)
+{
+  unsigned int nqueues = netdev_upper_nqueues(upper->lower);
+
+  return nqueues > 1 ? nqueues : NETDEV_RSS_THREADS;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_cputhread
+ *
+ * Description:
+ *   Return the dedicated thread serving a CPU:  The thread of the queue of
+ *   the CPU for a device with several queues (XPS), the thread of the CPU
+ *   with RSS.
+ *
+ ****************************************************************************/
+
+static inline int
+netdev_upper_cputhread(FAR struct netdev_upperhalf_s *upper, int cpu)
+{
+  return cpu % netdev_upper_nthreads(upper);
 }
+#endif
 
 /****************************************************************************
  * Name: netdev_upper_wait
@@ -702,6 +1684,26 @@ static int netdev_upper_wait(FAR sem_t *sem)
 #endif
 }
 
+/****************************************************************************
+ * Name: netdev_upper_post
+ *
+ * Description:
+ *   Wake up a dedicated thread if it is not already.
+ *
+ ****************************************************************************/
+
+static inline void netdev_upper_post(FAR struct netdev_upperhalf_s *upper,
+                                     int index)
+{
+  int semcount;
+
+  if (nxsem_get_value(&upper->sem[index], &semcount) == OK &&
+      semcount <= 0)
+    {
+      nxsem_post(&upper->sem[index]);
+    }
+}
+
 /****************************************************************************
  * Name: netdev_upper_loop
  *
@@ -714,24 +1716,30 @@ static int netdev_upper_loop(int argc, FAR char *argv[])
 {
   FAR struct netdev_upperhalf_s *upper =
     (FAR struct netdev_upperhalf_s *)((uintptr_t)strtoul(argv[1], NULL, 16));
-  int cpu = atoi(argv[2]);
+  int index = atoi(argv[2]);
+  unsigned int queue = index % netdev_upper_nqueues(upper->lower);
 
-#ifdef CONFIG_NETDEV_RSS
+#ifdef NETDEV_THREAD_PINNED
   cpu_set_t cpuset;
 
+  /* The thread pins itself, upper->tid[] may not be set yet */
+
   CPU_ZERO(&cpuset);
-  CPU_SET(cpu, &cpuset);
-  sched_setaffinity(upper->tid[cpu], sizeof(cpu_set_t), &cpuset);
+  CPU_SET(index % CONFIG_SMP_NCPUS, &cpuset);
+  sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
 #endif
 
-  while (netdev_upper_wait(&upper->sem[cpu]) == OK &&
-         upper->tid[cpu] != INVALID_PROCESS_ID)
+  while (netdev_upper_wait(&upper->sem[index]) == OK &&
+         upper->tid[index] != INVALID_PROCESS_ID)
     {
-      netdev_upper_work(upper);
+      if (netdev_upper_work_queue(upper, queue))
+        {
+          netdev_upper_post(upper, index);
+        }
     }
 
   nwarn("WARNING: Netdev work thread quitting.");
-  nxsem_post(&upper->sem_exit[cpu]);
+  nxsem_post(&upper->sem_exit[index]);
   return 0;
 }
 #endif
@@ -752,20 +1760,16 @@ static inline void netdev_upper_queue_work(FAR struct net_driver_s *dev)
   FAR struct netdev_upperhalf_s *upper = dev->d_private;
 
 #ifdef CONFIG_NETDEV_WORK_THREAD
-  int cpu = this_cpu();
-  int semcount;
-
-  if (nxsem_get_value(&upper->sem[cpu], &semcount) == OK &&
-      semcount <= 0)
-    {
-      nxsem_post(&upper->sem[cpu]);
-    }
+  netdev_upper_post(upper, netdev_upper_cputhread(upper, this_cpu()));
 #else
   if (work_available(&upper->work))
     {
-      /* Schedule to serialize the poll on the worker thread. */
+      /* Schedule to serialize the poll on the worker thread.  Prefer the
+       * worker of this CPU, the frames were just touched by the driver.
+       */
 
-      work_queue(NETDEV_WORK, &upper->work, netdev_upper_work, upper, 0);
+      work_queue_on(NETDEV_WORK, this_cpu(), &upper->work,
+                    netdev_upper_work, upper, 0);
     }
 #endif
 }
@@ -787,6 +1791,45 @@ static int netdev_upper_txavail(FAR struct net_driver_s *dev)
   return OK;
 }
 
+/****************************************************************************
+ * Name: netdev_upper_rxpoll
+ *
+ * Description:
+ *   Called by a socket that busy polls:  Receive the pending frames of all
+ *   the queues in the context of the caller, the frames beyond the budget
+ *   are left to the workers.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_BUSYPOLL
+static int netdev_upper_rxpoll(FAR struct net_driver_s *dev)
+{
+  FAR struct netdev_upperhalf_s *upper = dev->d_private;
+  unsigned int nqueues = netdev_upper_nqueues(upper->lower);
+  unsigned int queue;
+
+  for (queue = 0; queue < nqueues; queue++)
+    {
+      if (netdev_upper_work_queue(upper, queue))
+        {
+#ifdef CONFIG_NETDEV_WORK_THREAD
+          netdev_upper_post(upper, queue);
+#else
+          netdev_upper_queue_work(dev);
+#endif
+        }
+    }
+
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: netdev_upper_wireless_ioctl
  *
@@ -1045,9 +2088,9 @@ static int netdev_upper_ifup(FAR struct net_driver_s *dev)
 #ifdef CONFIG_NETDEV_WORK_THREAD
   int i;
 
-  /* Try to bring up a dedicated thread for work. */
+  /* Try to bring up the dedicated threads for work. */
 
-  for (i = 0; i < NETDEV_THREAD_COUNT; i++)
+  for (i = 0; i < netdev_upper_nthreads(upper); i++)
     {
       if (upper->tid[i] <= 0)
         {
@@ -1139,6 +2182,20 @@ static int netdev_upper_ioctl(FAR struct net_driver_s *dev, int cmd,
   FAR struct netdev_upperhalf_s *upper = dev->d_private;
   FAR struct netdev_lowerhalf_s *lower = upper->lower;
 
+#if defined(CONFIG_NETDEV_MULTIQUEUE) && defined(CONFIG_NETDEV_RSS)
+  /* Steer the flow to the queue of the consuming CPU, whose worker runs
+   * on that CPU.
+   */
+
+  if (cmd == SIOCNOTIFYRECVCPU && lower->nqueues > 1 && lower->ops->steer)
+    {
+      FAR struct netdev_rss_s *rss = (FAR struct netdev_rss_s *)arg;
+
+      return lower->ops->steer(lower, rss->hash,
+                               rss->cpu % lower->nqueues);
+    }
+#endif
+
 #ifdef CONFIG_NETDEV_WIRELESS_HANDLER
   if (lower->iw_ops)
     {
@@ -1189,8 +2246,23 @@ int netdev_lower_register(FAR struct netdev_lowerhalf_s *dev,
   int i;
 #endif
 
-  if (dev == NULL || quota_is_valid(dev) == false || dev->ops == NULL ||
-      dev->ops->transmit == NULL || dev->ops->receive == NULL)
+  if (dev == NULL || quota_is_valid(dev) == false || dev->ops == NULL)
+    {
+      return -EINVAL;
+    }
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  if (dev->nqueues > 1)
+    {
+      if (dev->nqueues > CONFIG_NETDEV_MAX_QUEUES ||
+          dev->ops->transmitq == NULL || dev->ops->receiveq == NULL)
+        {
+          return -EINVAL;
+        }
+    }
+  else
+#endif
+  if (dev->ops->transmit == NULL || dev->ops->receive == NULL)
     {
       return -EINVAL;
     }
@@ -1209,8 +2281,14 @@ int netdev_lower_register(FAR struct netdev_lowerhalf_s *dev,
 #endif
 #ifdef CONFIG_NETDEV_IOCTL
   dev->netdev.d_ioctl   = netdev_upper_ioctl;
+#endif
+#ifdef CONFIG_NET_BUSYPOLL
+  dev->netdev.d_rxpoll  = netdev_upper_rxpoll;
 #endif
   dev->netdev.d_private = upper;
+#ifdef CONFIG_NETDEV_GSO
+  dev->netdev.d_gsomax  = CONFIG_NETDEV_GSO_MAXSIZE;
+#endif
 
   ret = netdev_register(&dev->netdev, lltype);
   if (ret < 0)
@@ -1340,6 +2418,14 @@ void netdev_lower_carrier_off(FAR struct netdev_lowerhalf_s *dev)
 void netdev_lower_rxready(FAR struct netdev_lowerhalf_s *dev)
 {
 #if CONFIG_NETDEV_WORK_THREAD_POLLING_PERIOD == 0
+  NETDEV_RXIRQS(&dev->netdev);
+
+#ifdef CONFIG_NETDEV_NAPI
+  /* Poll until the queue is drained, without interrupts */
+
+  netdev_upper_rxint(dev, 0, false);
+#endif
+
   netdev_upper_queue_work(&dev->netdev);
 #endif
 }
@@ -1363,6 +2449,44 @@ void netdev_lower_txdone(FAR struct netdev_lowerhalf_s *dev)
 #endif
 }
 
+/****************************************************************************
+ * Name: netdev_lower_rxready_queue/netdev_lower_txdone_queue
+ *
+ * Description:
+ *   Notifies the networking layer about an RX packet is ready to read, or
+ *   a TX packet is sent, on a queue of a device with several queues.
+ *
+ * Input Parameters:
+ *   dev   - The lower half device driver structure
+ *   queue - The queue, below nqueues
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+void netdev_lower_rxready_queue(FAR struct netdev_lowerhalf_s *dev,
+                                unsigned int queue)
+{
+  DEBUGASSERT(queue < netdev_upper_nqueues(dev));
+#if CONFIG_NETDEV_WORK_THREAD_POLLING_PERIOD == 0
+  NETDEV_RXIRQS(&dev->netdev);
+#ifdef CONFIG_NETDEV_NAPI
+  netdev_upper_rxint(dev, queue, false);
+#endif
+  netdev_upper_post(dev->netdev.d_private, queue);
+#endif
+}
+
+void netdev_lower_txdone_queue(FAR struct netdev_lowerhalf_s *dev,
+                               unsigned int queue)
+{
+  DEBUGASSERT(queue < netdev_upper_nqueues(dev));
+  NETDEV_TXDONE(&dev->netdev);
+#if CONFIG_NETDEV_WORK_THREAD_POLLING_PERIOD == 0
+  netdev_upper_post(dev->netdev.d_private, queue);
+#endif
+}
+#endif
+
 /****************************************************************************
  * Name: netdev_lower_quota_load
  *
@@ -1438,6 +2562,41 @@ void netpkt_free(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt,
   iob_free_chain(pkt);
 }
 
+/****************************************************************************
+ * Name: netpkt_concat
+ *
+ * Description:
+ *   Append the data of a netpkt to another one.
+ *
+ * Input Parameters:
+ *   dev  - The lower half device driver structure
+ *   pkt  - The packet to extend
+ *   next - The packet appended to 'pkt'
+ *   type - Whether used for TX or RX
+ *
+ ****************************************************************************/
+
+void netpkt_concat(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt,
+                   FAR netpkt_t *next, enum netpkt_type_e type)
+{
+  uint8_t llhdrlen = NET_LL_HDRLEN(&dev->netdev);
+
+  /* The data of a netpkt starts at the link layer header, before the IOB
+   * data that only the first IOB of a chain has.
+   */
+
+  DEBUGASSERT(next->io_offset >= llhdrlen);
+  next->io_offset -= llhdrlen;
+  next->io_len    += llhdrlen;
+  next->io_pktlen += llhdrlen;
+
+  iob_concat(pkt, next);
+
+  /* 'next' is freed with 'pkt', give back its quota now */
+
+  atomic_fetch_add(&dev->quota[type], 1);
+}
+
 /****************************************************************************
  * Name: netpkt_copyin
  *
@@ -1582,6 +2741,76 @@ void netpkt_reset_reserved(FAR struct netdev_lowerhalf_s *dev,
   iob_reserve(pkt, len + NET_LL_HDRLEN(&dev->netdev));
 }
 
+/****************************************************************************
+ * Name: netpkt_gsosize
+ *
+ * Description:
+ *   Get the size of the segments of a TCP super-segment in transmit.
+ *
+ * Input Parameters:
+ *   dev    - The lower half device driver structure
+ *   pkt    - The net packet being transmitted
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_GSO
+uint16_t netpkt_gsosize(FAR struct netdev_lowerhalf_s *dev,
+                        FAR netpkt_t *pkt)
+{
+  UNUSED(pkt);
+  return dev->netdev.d_gsosize;
+}
+#endif
+
+/****************************************************************************
+ * Name: netpkt_txcsum
+ *
+ * Description:
+ *   Get the TCP or UDP checksum to be completed by the device.
+ *
+ * Input Parameters:
+ *   dev    - The lower half device driver structure
+ *   pkt    - The net packet being transmitted
+ *   start  - The offset of the data from netpkt_getdata()
+ *   offset - The offset of the checksum field from 'start'
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+bool netpkt_txcsum(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt,
+                   FAR uint16_t *start, FAR uint16_t *offset)
+{
+  if ((pkt->io_csumflags & IOB_CSUM_PARTIAL) == 0)
+    {
+      return false;
+    }
+
+  *start  = NET_LL_HDRLEN(&dev->netdev) + pkt->io_csumstart;
+  *offset = pkt->io_csumoff;
+  return true;
+}
+
+/****************************************************************************
+ * Name: netpkt_rxcsum_verified
+ *
+ * Description:
+ *   Tell that the device verified the TCP or UDP checksum of a received
+ *   packet.
+ *
+ * Input Parameters:
+ *   dev    - The lower half device driver structure
+ *   pkt    - The net packet received
+ *
+ ****************************************************************************/
+
+void netpkt_rxcsum_verified(FAR struct netdev_lowerhalf_s *dev,
+                            FAR netpkt_t *pkt)
+{
+  UNUSED(dev);
+  pkt->io_csumflags |= IOB_CSUM_VERIFIED;
+}
+#endif
+
 /****************************************************************************
  * Name: netpkt_is_fragmented
  *
@@ -24,6 +24,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/param.h>
 #include <sys/types.h>
 #include <sched.h>
 #include <fcntl.h>
@@ -70,20 +71,59 @@
 #define get_task_state(s)                                                    \
   ((s) == 0 ? 'X' : ((s) <= LAST_READY_TO_RUN_STATE ? 'R' : 'S'))
 
+/* With CONFIG_DRIVERS_NOTERAM_PERCPU, the buffer is divided in a circular
+ * buffer per CPU, written only by its CPU with the interrupts disabled.
+ * Otherwise all the CPUs write a single circular buffer under the lock of
+ * the driver.
+ */
+
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+#  define NRINGS                     NCPUS
+#  define NOTERAM_INDEX()            this_cpu()
+#  define NOTERAM_LOCK(drv)          up_irq_save()
+#  define NOTERAM_UNLOCK(drv, flags) up_irq_restore(flags)
+#else
+#  define NRINGS                     1
+#  define NOTERAM_INDEX()            0
+#  define NOTERAM_LOCK(drv)          spin_lock_irqsave_wo_note(&(drv)->lock)
+#  define NOTERAM_UNLOCK(drv, flags) \
+     spin_unlock_irqrestore_wo_note(&(drv)->lock, flags)
+#endif
+
+#define NOTERAM_RINGSIZE(drv)        ((drv)->ni_bufsize / NRINGS)
+#define NOTERAM_BUFFER(drv, i)       \
+  ((drv)->ni_buffer + (i) * NOTERAM_RINGSIZE(drv))
+
+/* Compare the free running positions of a circular buffer */
+
+#define NOTERAM_BEFORE(a, b)         ((ssize_t)((a) - (b)) < 0)
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* A circular buffer.  The positions are free running, the index in the
+ * buffer is the position modulo the size of the buffer.
+ */
+
+struct noteram_ring_s
+{
+  volatile size_t head;     /* End of the newest note, set by the writer */
+  volatile size_t tail;     /* Start of the oldest note, set by the writer */
+  volatile size_t clear;    /* The notes before are cleared */
+  size_t read;              /* The next note to read */
+};
+
 struct noteram_driver_s
 {
   struct note_driver_s driver;
   FAR uint8_t *ni_buffer;
   size_t ni_bufsize;
   unsigned int ni_overwrite;
-  volatile unsigned int ni_head;
-  volatile unsigned int ni_tail;
-  volatile unsigned int ni_read;
-  spinlock_t lock;
+  struct noteram_ring_s ni_ring[NRINGS];
+  struct noteram_stats_s ni_stats[NCPUS];
+  spinlock_t lock;          /* Serializes the readers, and the writers of
+                             * the single circular buffer */
   FAR struct pollfd *pfd;
 };
 
@@ -189,7 +229,8 @@ struct noteram_driver_s g_noteram_driver =
  * Name: noteram_buffer_clear
  *
  * Description:
- *   Clear all contents of the circular buffer.
+ *   Clear all contents of the circular buffers.  The cleared notes are
+ *   freed by the writers when they need the space.
  *
  * Input Parameters:
  *   None.
@@ -201,148 +242,135 @@ struct noteram_driver_s g_noteram_driver =
 
 static void noteram_buffer_clear(FAR struct noteram_driver_s *drv)
 {
-  drv->ni_tail = drv->ni_head;
-  drv->ni_read = drv->ni_head;
+  FAR struct noteram_ring_s *ring;
+  int i;
 
-  if (drv->ni_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
+  for (i = 0; i < NRINGS; i++)
     {
-      drv->ni_overwrite = NOTERAM_MODE_OVERWRITE_DISABLE;
+      ring        = &drv->ni_ring[i];
+      ring->clear = ring->head;
+      ring->read  = ring->clear;
     }
-}
 
-/****************************************************************************
- * Name: noteram_next
- *
- * Description:
- *   Return the circular buffer index at offset from the specified index
- *   value, handling wraparound
- *
- * Input Parameters:
- *   ndx - Old circular buffer index
- *
- * Returned Value:
- *   New circular buffer index
- *
- ****************************************************************************/
+  memset(drv->ni_stats, 0, sizeof(drv->ni_stats));
 
-static inline unsigned int noteram_next(FAR struct noteram_driver_s *drv,
-                                        unsigned int ndx,
-                                        unsigned int offset)
-{
-  ndx += offset;
-  if (ndx >= drv->ni_bufsize)
+  if (drv->ni_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
     {
-      ndx -= drv->ni_bufsize;
+      drv->ni_overwrite = NOTERAM_MODE_OVERWRITE_DISABLE;
     }
-
-  return ndx;
 }
 
 /****************************************************************************
- * Name: noteram_length
+ * Name: noteram_copyout
  *
  * Description:
- *   Length of data currently in circular buffer.
- *
- * Input Parameters:
- *   None
- *
- * Returned Value:
- *   Length of data currently in circular buffer.
+ *   Copy 'len' bytes at the free running position 'pos' of a circular
+ *   buffer, handling wraparound.
  *
  ****************************************************************************/
 
-static unsigned int noteram_length(FAR struct noteram_driver_s *drv)
+static void noteram_copyout(FAR struct noteram_driver_s *drv, int index,
+                            size_t pos, FAR void *dest, size_t len)
 {
-  unsigned int head = drv->ni_head;
-  unsigned int tail = drv->ni_tail;
-
-  if (tail > head)
-    {
-      head += drv->ni_bufsize;
-    }
+  FAR uint8_t *buffer = NOTERAM_BUFFER(drv, index);
+  size_t ndx = pos % NOTERAM_RINGSIZE(drv);
+  size_t space = MIN(len, NOTERAM_RINGSIZE(drv) - ndx);
 
-  return head - tail;
+  memcpy(dest, buffer + ndx, space);
+  memcpy((FAR uint8_t *)dest + space, buffer, len - space);
 }
 
 /****************************************************************************
  * Name: noteram_unread_length
  *
  * Description:
- *   Length of unread data currently in circular buffer.
+ *   Length of unread data currently in the circular buffers.
  *
  * Input Parameters:
  *   None
  *
  * Returned Value:
- *   Length of unread data currently in circular buffer.
+ *   Length of unread data currently in the circular buffers.
  *
  ****************************************************************************/
 
-static unsigned int noteram_unread_length(FAR struct noteram_driver_s *drv)
+static size_t noteram_unread_length(FAR struct noteram_driver_s *drv)
 {
-  unsigned int head = drv->ni_head;
-  unsigned int read = drv->ni_read;
+  FAR struct noteram_ring_s *ring;
+  size_t length = 0;
+  size_t read;
+  int i;
 
-  if (read > head)
+  for (i = 0; i < NRINGS; i++)
     {
-      head += drv->ni_bufsize;
+      ring = &drv->ni_ring[i];
+      read = ring->read;
+      if (NOTERAM_BEFORE(read, ring->tail))
+        {
+          read = ring->tail;
+        }
+
+      length += ring->head - read;
     }
 
-  return head - read;
+  return length;
 }
 
 /****************************************************************************
- * Name: noteram_remove
+ * Name: noteram_peek
  *
  * Description:
- *   Remove the variable length note from the tail of the circular buffer
- *
- * Input Parameters:
- *   None
+ *   Get the header of the next note to read from a circular buffer.  The
+ *   writer of the buffer may overwrite the oldest notes meanwhile:  The
+ *   header is valid only if the tail of the buffer did not move past it
+ *   while it was copied.
  *
  * Returned Value:
- *   None
- *
- * Assumptions:
- *   We are within a critical section.
+ *   The length of the note, zero if the buffer is empty.
  *
  ****************************************************************************/
 
-static void noteram_remove(FAR struct noteram_driver_s *drv)
+static size_t noteram_peek(FAR struct noteram_driver_s *drv, int index,
+                           FAR struct note_common_s *note)
 {
-  unsigned int tail;
-  unsigned int length;
-
-  /* Get the tail index of the circular buffer */
+  FAR struct noteram_ring_s *ring = &drv->ni_ring[index];
+  size_t head;
 
-  tail = drv->ni_tail;
-  DEBUGASSERT(tail < drv->ni_bufsize);
+  for (; ; )
+    {
+      if (NOTERAM_BEFORE(ring->read, ring->tail))
+        {
+          /* The unread notes were overwritten */
 
-  /* Get the length of the note at the tail index */
+          ring->read = ring->tail;
+        }
 
-  length = NOTE_ALIGN(drv->ni_buffer[tail]);
-  DEBUGASSERT(length <= noteram_length(drv));
+      head = ring->head;
+      if (ring->read == head)
+        {
+          return 0;
+        }
 
-  /* Increment the tail index to remove the entire note from the circular
-   * buffer.
-   */
+      /* Read the note only after the head that publishes it */
 
-  if (drv->ni_read == drv->ni_tail)
-    {
-      /* The read index also needs increment. */
+      SP_DMB();
+      noteram_copyout(drv, index, ring->read, note, sizeof(*note));
+      SP_DMB();
 
-      drv->ni_read = noteram_next(drv, tail, length);
+      if (!NOTERAM_BEFORE(ring->read, ring->tail))
+        {
+          DEBUGASSERT(note->nc_length <= head - ring->read);
+          return note->nc_length;
+        }
     }
-
-  drv->ni_tail = noteram_next(drv, tail, length);
 }
 
 /****************************************************************************
  * Name: noteram_get
  *
  * Description:
- *   Get the next note from the read index of the circular buffer.
+ *   Get the next note from the read index of the circular buffers:  The
+ *   oldest of the next notes of all the buffers by time stamp.
  *
  * Input Parameters:
  *   buffer - Location to return the next note
@@ -350,72 +378,75 @@ static void noteram_remove(FAR struct noteram_driver_s *drv)
  *
  * Returned Value:
  *   On success, the positive, non-zero length of the return note is
- *   provided.  Zero is returned only if the circular buffer is empty.  A
+ *   provided.  Zero is returned only if the circular buffers are empty.  A
  *   negated errno value is returned in the event of any failure.
  *
+ * Assumptions:
+ *   The readers are serialized by the lock of the driver.
+ *
  ****************************************************************************/
 
 static ssize_t noteram_get(FAR struct noteram_driver_s *drv,
                            FAR uint8_t *buffer, size_t buflen)
 {
-  FAR struct note_common_s *note;
-  unsigned int remaining;
-  unsigned int read;
-  ssize_t notelen;
-  size_t circlen;
+  struct note_common_s note;
+  FAR struct noteram_ring_s *ring;
+  clock_t systime = 0;
+  size_t notelen = 0;
+  size_t len;
+  int index = -1;
+  int i;
 
   DEBUGASSERT(buffer != NULL);
 
-  /* Verify that the circular buffer is not empty */
-
-  circlen = noteram_unread_length(drv);
-  if (circlen <= 0)
+  for (; ; )
     {
-      return 0;
-    }
-
-  /* Get the read index of the circular buffer */
-
-  read = drv->ni_read;
-  DEBUGASSERT(read < drv->ni_bufsize);
+      /* Find the oldest note */
 
-  /* Get the length of the note at the read index */
+      for (i = 0; i < NRINGS; i++)
+        {
+          len = noteram_peek(drv, i, &note);
+          if (len > 0 && (index < 0 || note.nc_systime < systime))
+            {
+              systime = note.nc_systime;
+              notelen = len;
+              index   = i;
+            }
+        }
 
-  note = (FAR struct note_common_s *)&drv->ni_buffer[read];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
+      if (index < 0)
+        {
+          return 0;
+        }
 
-  /* Is the user buffer large enough to hold the note? */
+      ring = &drv->ni_ring[index];
 
-  if (buflen < notelen)
-    {
-      /* Skip the large note so that we do not get constipated. */
+      /* Is the user buffer large enough to hold the note? */
 
-      drv->ni_read = noteram_next(drv, read, NOTE_ALIGN(notelen));
+      if (buflen < notelen)
+        {
+          /* Skip the large note so that we do not get constipated. */
 
-      /* and return an error */
+          ring->read += NOTE_ALIGN(notelen);
 
-      return -EFBIG;
-    }
+          /* and return an error */
 
-  /* Loop until the note has been transferred to the user buffer */
+          return -EFBIG;
+        }
 
-  remaining = (unsigned int)notelen;
-  while (remaining > 0)
-    {
-      /* Copy the next byte at the read index */
+      noteram_copyout(drv, index, ring->read, buffer, notelen);
+      SP_DMB();
 
-      *buffer++ = drv->ni_buffer[read];
+      if (!NOTERAM_BEFORE(ring->read, ring->tail))
+        {
+          ring->read += NOTE_ALIGN(notelen);
+          return notelen;
+        }
 
-      /* Adjust indices and counts */
+      /* The note was overwritten while it was copied */
 
-      read = noteram_next(drv, read, 1);
-      remaining--;
+      index = -1;
     }
-
-  drv->ni_read = noteram_next(drv, drv->ni_read, NOTE_ALIGN(notelen));
-
-  return notelen;
 }
 
 /****************************************************************************
@@ -427,10 +458,22 @@ static int noteram_open(FAR struct file *filep)
   FAR struct noteram_dump_context_s *ctx;
   FAR struct noteram_driver_s *drv = (FAR struct noteram_driver_s *)
                                      filep->f_inode->i_private;
+  FAR struct noteram_ring_s *ring;
+  irqstate_t flags;
+  int i;
+
+  /* Reset the read index of the circular buffers */
+
+  flags = spin_lock_irqsave_wo_note(&drv->lock);
+  for (i = 0; i < NRINGS; i++)
+    {
+      ring       = &drv->ni_ring[i];
+      ring->read = NOTERAM_BEFORE(ring->tail, ring->clear) ?
+                   ring->clear : ring->tail;
+    }
 
-  /* Reset the read index of the circular buffer */
+  spin_unlock_irqrestore_wo_note(&drv->lock, flags);
 
-  drv->ni_read = drv->ni_tail;
   ctx = kmm_zalloc(sizeof(*ctx));
   if (ctx == NULL)
     {
@@ -594,6 +637,24 @@ static int noteram_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
           }
         break;
 
+      /* NOTERAM_GETSTATS
+       *      - Get the lost notes of each CPU
+       *        Argument: A writable pointer to an array of
+       *                  CONFIG_SMP_NCPUS struct noteram_stats_s
+       */
+
+      case NOTERAM_GETSTATS:
+        if (arg == 0)
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            memcpy((FAR void *)arg, drv->ni_stats, sizeof(drv->ni_stats));
+            ret = OK;
+          }
+        break;
+
       default:
           break;
     }
@@ -672,7 +733,10 @@ errout:
  * Name: noteram_add
  *
  * Description:
- *   Add the variable length note to the transport layer
+ *   Add the variable length note to the transport layer.  With
+ *   CONFIG_DRIVERS_NOTERAM_PERCPU, each CPU writes its own circular buffer
+ *   without any lock:  The readers check that the notes they copied were
+ *   not overwritten meanwhile.
  *
  * Input Parameters:
  *   note    - The note buffer
@@ -691,51 +755,77 @@ static void noteram_add(FAR struct note_driver_s *driver,
 {
   FAR const char *buf = note;
   FAR struct noteram_driver_s *drv = (FAR struct noteram_driver_s *)driver;
-  unsigned int head;
-  unsigned int remain;
-  unsigned int space;
+  FAR struct noteram_stats_s *stats;
+  FAR struct noteram_ring_s *ring;
+  FAR uint8_t *buffer;
+  size_t ringsize = NOTERAM_RINGSIZE(drv);
+  size_t head;
+  size_t tail;
+  size_t ndx;
+  size_t space;
+  uint8_t length;
   irqstate_t flags;
+  int index;
 
-  flags = spin_lock_irqsave_wo_note(&drv->lock);
+  flags = NOTERAM_LOCK(drv);
+  index = NOTERAM_INDEX();
+  ring  = &drv->ni_ring[index];
+  stats = &drv->ni_stats[this_cpu()];
 
   if (drv->ni_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
     {
-      spin_unlock_irqrestore_wo_note(&drv->lock, flags);
+      stats->ns_dropped++;
+      NOTERAM_UNLOCK(drv, flags);
       return;
     }
 
-  DEBUGASSERT(note != NULL && notelen < drv->ni_bufsize);
-  remain = drv->ni_bufsize - noteram_length(drv);
+  DEBUGASSERT(note != NULL && notelen < ringsize);
+  head = ring->head;
+  tail = ring->tail;
 
-  if (remain <= NOTE_ALIGN(notelen))
+  while (ringsize - (head - tail) <= NOTE_ALIGN(notelen))
     {
-      if (drv->ni_overwrite == NOTERAM_MODE_OVERWRITE_DISABLE)
+      /* The cleared notes are freed first */
+
+      if (!NOTERAM_BEFORE(tail, ring->clear))
         {
-          /* Stop recording if not in overwrite mode */
+          if (drv->ni_overwrite == NOTERAM_MODE_OVERWRITE_DISABLE)
+            {
+              /* Stop recording if not in overwrite mode */
 
-          drv->ni_overwrite = NOTERAM_MODE_OVERWRITE_OVERFLOW;
-          spin_unlock_irqrestore_wo_note(&drv->lock, flags);
-          return;
+              drv->ni_overwrite = NOTERAM_MODE_OVERWRITE_OVERFLOW;
+              stats->ns_dropped++;
+              NOTERAM_UNLOCK(drv, flags);
+              return;
+            }
+
+          stats->ns_overwritten++;
         }
 
-      /* Remove the note at the tail index , make sure there is enough space
+      /* Remove the note at the tail index, make sure there is enough
+       * space.
        */
 
-      do
-        {
-          noteram_remove(drv);
-          remain = drv->ni_bufsize - noteram_length(drv);
-        }
-      while (remain <= NOTE_ALIGN(notelen));
+      noteram_copyout(drv, index, tail, &length, sizeof(length));
+      tail += NOTE_ALIGN(length);
     }
 
-  head = drv->ni_head;
-  space = drv->ni_bufsize - head;
-  space = space < notelen ? space : notelen;
-  memcpy(drv->ni_buffer + head, note, space);
-  memcpy(drv->ni_buffer, buf + space, notelen - space);
-  drv->ni_head = noteram_next(drv, head, NOTE_ALIGN(notelen));
-  spin_unlock_irqrestore_wo_note(&drv->lock, flags);
+  /* Publish the removal of the old notes before they are overwritten */
+
+  ring->tail = tail;
+  SP_DMB();
+
+  buffer = NOTERAM_BUFFER(drv, index);
+  ndx    = head % ringsize;
+  space  = MIN(notelen, ringsize - ndx);
+  memcpy(buffer + ndx, note, space);
+  memcpy(buffer, buf + space, notelen - space);
+
+  /* Publish the note */
+
+  SP_DMB();
+  ring->head = head + NOTE_ALIGN(notelen);
+  NOTERAM_UNLOCK(drv, flags);
   poll_notify(&drv->pfd, 1, POLLIN);
 }
 
@@ -1368,9 +1458,9 @@ noteram_initialize(FAR const char *devpath, size_t bufsize, bool overwrite)
   drv->ni_bufsize = bufsize;
   drv->ni_buffer = (FAR uint8_t *)(drv + 1) + len;
   drv->ni_overwrite = overwrite;
-  drv->ni_head = 0;
-  drv->ni_tail = 0;
-  drv->ni_read = 0;
+  memset(drv->ni_ring, 0, sizeof(drv->ni_ring));
+  memset(drv->ni_stats, 0, sizeof(drv->ni_stats));
+  spin_lock_init(&drv->lock);
   drv->pfd = NULL;
 
   ret = note_driver_register(&drv->driver);
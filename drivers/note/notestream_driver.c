@@ -23,11 +23,22 @@
  ****************************************************************************/
 
 #include <stdint.h>
+#include <string.h>
 #include <fcntl.h>
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/note/notestream_driver.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The type, flags, time stamp delta, cpu, pid, priority and length of a
+ * compact record, or the header of a sync or string record.
+ */
+
+#define NOTESTREAM_COMPACT_HEADER 32
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -86,11 +97,222 @@ struct notestream_driver_s g_notestream_lowerout =
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_DRIVERS_NOTESTREAM_COMPACT
+/****************************************************************************
+ * Name: notestream_varint
+ *
+ * Description:
+ *   Encode an unsigned LEB128 varint, return its length.
+ *
+ ****************************************************************************/
+
+static size_t notestream_varint(FAR uint8_t *buf, uint64_t value)
+{
+  size_t len = 0;
+
+  while (value >= 0x80)
+    {
+      buf[len++] = (uint8_t)value | 0x80;
+      value >>= 7;
+    }
+
+  buf[len++] = (uint8_t)value;
+  return len;
+}
+
+/****************************************************************************
+ * Name: notestream_sync
+ *
+ * Description:
+ *   Emit a sync record and reset the state of the compact encoding.
+ *
+ ****************************************************************************/
+
+static void notestream_sync(FAR struct notestream_driver_s *drv,
+                            clock_t systime)
+{
+  FAR struct notestream_compact_s *compact = &drv->compact;
+  uint8_t buf[NOTESTREAM_COMPACT_HEADER];
+  size_t len = 0;
+
+  buf[len++] = NOTESTREAM_COMPACT_SYNC;
+  memcpy(&buf[len], NOTESTREAM_COMPACT_MAGIC, 4);
+  len += 4;
+  buf[len++] = NOTESTREAM_COMPACT_VERSION;
+  buf[len++] = sizeof(uintptr_t);
+  len += notestream_varint(&buf[len], perf_getfreq());
+  len += notestream_varint(&buf[len], systime);
+  lib_stream_puts(drv->stream, buf, len);
+
+  compact->systime = systime;
+#  if CONFIG_TASK_NAME_SIZE > 0
+  memset(compact->names, 0, sizeof(compact->names));
+#  endif
+}
+
+#  if CONFIG_TASK_NAME_SIZE > 0
+/****************************************************************************
+ * Name: notestream_intern
+ *
+ * Description:
+ *   Return the identifier of a task name, emitting a string record first
+ *   if the name is not in the table of the stream.
+ *
+ ****************************************************************************/
+
+static uint32_t notestream_intern(FAR struct notestream_driver_s *drv,
+                                  FAR const char *name, size_t namelen)
+{
+  FAR struct notestream_name_s *entry;
+  uint8_t buf[NOTESTREAM_COMPACT_HEADER];
+  uint32_t hash = 2166136261u;
+  uint32_t id;
+  size_t len = 0;
+  size_t i;
+
+  for (i = 0; i < namelen; i++)
+    {
+      hash = (hash ^ (uint8_t)name[i]) * 16777619u;
+    }
+
+  if (hash == 0)
+    {
+      hash = 1;
+    }
+
+  id    = hash % CONFIG_DRIVERS_NOTESTREAM_COMPACT_NAMES;
+  entry = &drv->compact.names[id];
+  if (entry->hash == hash && strncmp(entry->name, name, namelen) == 0 &&
+      entry->name[namelen] == '\0')
+    {
+      return id;
+    }
+
+  entry->hash = hash;
+  memcpy(entry->name, name, namelen);
+  entry->name[namelen] = '\0';
+
+  buf[len++] = NOTESTREAM_COMPACT_STRING;
+  len += notestream_varint(&buf[len], id);
+  len += notestream_varint(&buf[len], namelen);
+  lib_stream_puts(drv->stream, buf, len);
+  lib_stream_puts(drv->stream, name, namelen);
+  return id;
+}
+#  endif
+
+/****************************************************************************
+ * Name: notestream_compact
+ *
+ * Description:
+ *   Emit a note as a compact record:  The fields of the common header are
+ *   only emitted if they changed, the time stamp as a delta, and the task
+ *   names are interned.  A record is about half the size of the note in
+ *   the common case of a context switch, so much less time is spent in
+ *   the stream, usually a slow serial port.
+ *
+ ****************************************************************************/
+
+static void notestream_compact(FAR struct notestream_driver_s *drv,
+                               FAR const struct note_common_s *note,
+                               size_t len)
+{
+  FAR struct notestream_compact_s *compact = &drv->compact;
+  FAR const uint8_t *payload = (FAR const uint8_t *)(note + 1);
+  size_t paylen = len - sizeof(struct note_common_s);
+  uint8_t buf[NOTESTREAM_COMPACT_HEADER];
+  irqstate_t flags;
+  sclock_t delta;
+  size_t hlen = 2;
+  bool first;
+
+  flags = spin_lock_irqsave_wo_note(&compact->lock);
+
+  first = compact->nrecords == 0;
+  if (first)
+    {
+      notestream_sync(drv, note->nc_systime);
+    }
+
+  if (++compact->nrecords >= CONFIG_DRIVERS_NOTESTREAM_COMPACT_SYNC)
+    {
+      compact->nrecords = 0;
+    }
+
+  buf[0] = note->nc_type;
+  buf[1] = 0;
+
+  /* Zigzag encode the delta, the notes of the other CPUs may be older */
+
+  delta = (sclock_t)(note->nc_systime - compact->systime);
+  hlen += notestream_varint(&buf[hlen],
+                            ((uint64_t)delta << 1) ^
+                            (uint64_t)(delta < 0 ? -1 : 0));
+  compact->systime = note->nc_systime;
+
+  if (first || note->nc_cpu != compact->cpu)
+    {
+      buf[1] |= NOTESTREAM_COMPACT_CPU;
+      buf[hlen++] = note->nc_cpu;
+      compact->cpu = note->nc_cpu;
+    }
+
+  if (first || note->nc_pid != compact->pid)
+    {
+      buf[1] |= NOTESTREAM_COMPACT_PID;
+      hlen += notestream_varint(&buf[hlen], (uint32_t)note->nc_pid);
+      compact->pid = note->nc_pid;
+    }
+
+  if (first || note->nc_priority != compact->priority)
+    {
+      buf[1] |= NOTESTREAM_COMPACT_PRIO;
+      buf[hlen++] = note->nc_priority;
+      compact->priority = note->nc_priority;
+    }
+
+#  if CONFIG_TASK_NAME_SIZE > 0
+  if (note->nc_type == NOTE_START && paylen > 0)
+    {
+      uint8_t id[5];
+      size_t idlen;
+
+      idlen = notestream_varint(id, notestream_intern(drv,
+                                (FAR const char *)payload,
+                                strnlen((FAR const char *)payload, paylen)));
+      hlen += notestream_varint(&buf[hlen], idlen);
+      lib_stream_puts(drv->stream, buf, hlen);
+      lib_stream_puts(drv->stream, id, idlen);
+      spin_unlock_irqrestore_wo_note(&compact->lock, flags);
+      return;
+    }
+#  endif
+
+  hlen += notestream_varint(&buf[hlen], paylen);
+  lib_stream_puts(drv->stream, buf, hlen);
+  if (paylen > 0)
+    {
+      lib_stream_puts(drv->stream, payload, paylen);
+    }
+
+  spin_unlock_irqrestore_wo_note(&compact->lock, flags);
+}
+#endif
+
 static void notestream_add(FAR struct note_driver_s *drv,
                            FAR const void *note, size_t len)
 {
   FAR struct notestream_driver_s *drivers =
       (FAR struct notestream_driver_s *)drv;
+
+#ifdef CONFIG_DRIVERS_NOTESTREAM_COMPACT
+  if (len >= sizeof(struct note_common_s))
+    {
+      notestream_compact(drivers, note, len);
+      return;
+    }
+#endif
+
   lib_stream_puts(drivers->stream, note, len);
 }
 
@@ -181,6 +181,7 @@ static int armpmu_start(FAR struct perf_event_s *event, int flags)
   FAR struct hw_perf_event_s *hwc = &event->hw;
 
   hwc->state = 0;
+  armpmu_event_set_period(event);
   armpmu->enable(event);
 
   return 0;
@@ -393,13 +394,40 @@ uint64_t armpmu_event_update(FAR struct perf_event_s *event)
 
   new_raw_count = armpmu->read_counter(event);
 
-  delta = (new_raw_count) & max_period;
+  delta = (new_raw_count - event->hw.prev_count) & max_period;
+  event->hw.prev_count = new_raw_count;
 
   atomic_fetch_add(&event->count, delta);
 
   return new_raw_count;
 }
 
+/****************************************************************************
+ * Name: armpmu_event_set_period
+ *
+ * Description:
+ *   Program the counter of an event:  A sampling event starts 'period'
+ *   events before the overflow, so that the overflow interrupt comes once
+ *   per period; a counting event starts from zero and only interrupts
+ *   when the counter wraps.
+ *
+ ****************************************************************************/
+
+void armpmu_event_set_period(FAR struct perf_event_s *event)
+{
+  FAR struct arm_pmu_s *armpmu = to_arm_pmu(event->pmu);
+  uint64_t max_period = armpmu_event_max_period(event);
+  uint64_t value = 0;
+
+  if (!event->attr.freq && event->attr.sample_period != 0)
+    {
+      value = (0 - event->attr.sample_period) & max_period;
+    }
+
+  event->hw.prev_count = value;
+  armpmu->write_counter(event, value);
+}
+
 int armpmu_driver_init(FAR void *fn)
 {
   FAR armpmu_init_fn init_fn = (armpmu_init_fn)fn;
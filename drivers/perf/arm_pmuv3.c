@@ -258,25 +258,10 @@ static inline uint32_t pmuv3_getreset_flags(void)
 
 static void pmuv3_enable_user_access(FAR struct arm_pmu_s *cpu_pmu)
 {
-  int i;
-  FAR struct pmu_hw_events_s *cpuc = this_cpu_ptr(cpu_pmu->hw_events);
-
-  for (i = 0; i < cpu_pmu->num_events; i++)
-    {
-      if (!test_bit(i, &cpuc->used_mask))
-        {
-          continue;
-        }
-
-      if (i == PMU_IDX_CYCLE_COUNTER)
-        {
-          write_pmccntr(0);
-        }
-      else
-        {
-          write_pmevcntrn(PMU_IDX_TO_COUNTER(i), 0);
-        }
-    }
+  /* The counters are programmed by armpmu_event_set_period(), they are
+   * not cleared here so the PMU can be restarted after an interrupt
+   * without losing the counts.
+   */
 
   write_pmuserenr(0);
   write_pmuserenr(PMU_USERENR_ER | PMU_USERENR_CR);
@@ -369,9 +354,10 @@ static int pmuv3_handle_irq(FAR struct arm_pmu_s *cpu_pmu)
           continue;
         }
 
-      /* Update data */
+      /* Update data and reload the counter with the next period */
 
       armpmu_event_update(event);
+      armpmu_event_set_period(event);
 
       if (perf_event_overflow(event))
         {
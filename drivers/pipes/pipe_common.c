@@ -80,6 +80,251 @@ static void pipecommon_wakeup(FAR sem_t *sem)
     }
 }
 
+/****************************************************************************
+ * Name: pipecommon_spliceout
+ *
+ * Description:
+ *   Write up to 'splice->len' bytes of the pipe to 'splice->filep' straight
+ *   from the buffer of the pipe, consuming them unless 'peek' is set.  The
+ *   pipe stays locked while the file is written.
+ *
+ ****************************************************************************/
+
+static ssize_t pipecommon_spliceout(FAR struct file *filep,
+                                    FAR struct pipe_splice_s *splice,
+                                    bool peek)
+{
+  FAR struct inode      *inode    = filep->f_inode;
+  FAR struct pipe_dev_s *dev      = inode->i_private;
+  FAR struct circbuf_s  *circ     = &dev->d_buffer;
+  ssize_t                nspliced = 0;
+  ssize_t                ret;
+  size_t                 len;
+  size_t                 off;
+  size_t                 n;
+
+  ret = nxrmutex_lock(&dev->d_bflock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* If the pipe is empty, then wait for something to be written to it */
+
+  while (circbuf_is_empty(circ))
+    {
+      if (dev->d_nwriters <= 0 && PIPE_IS_POLICY_0(dev->d_flags))
+        {
+          nxrmutex_unlock(&dev->d_bflock);
+          return 0;
+        }
+
+      if ((filep->f_oflags & O_NONBLOCK) ||
+          (splice->flags & SPLICE_F_NONBLOCK))
+        {
+          nxrmutex_unlock(&dev->d_bflock);
+          return -EAGAIN;
+        }
+
+      nxrmutex_unlock(&dev->d_bflock);
+      ret = nxsem_wait(&dev->d_rdsem);
+      if (ret < 0 || (ret = nxrmutex_lock(&dev->d_bflock)) < 0)
+        {
+          return ret;
+        }
+    }
+
+  /* Write the data in at most two pieces, before and after the end of the
+   * circular buffer.
+   */
+
+  len = MIN(splice->len, circbuf_used(circ));
+  while ((size_t)nspliced < len)
+    {
+      off = (circ->tail + nspliced) % circ->size;
+      n   = MIN(len - nspliced, circ->size - off);
+
+      if (splice->offset != NULL)
+        {
+          ret = file_pwrite(splice->filep, (FAR char *)circ->base + off, n,
+                            *splice->offset);
+          if (ret > 0)
+            {
+              *splice->offset += ret;
+            }
+        }
+      else
+        {
+          ret = file_write(splice->filep, (FAR char *)circ->base + off, n);
+        }
+
+      if (ret <= 0)
+        {
+          if (nspliced == 0)
+            {
+              nspliced = ret;
+            }
+
+          break;
+        }
+
+      pipe_dumpbuffer("From PIPE:", (FAR char *)circ->base + off, ret);
+      nspliced += ret;
+      if ((size_t)ret < n)
+        {
+          break;
+        }
+    }
+
+  if (nspliced > 0 && !peek)
+    {
+      circbuf_readcommit(circ, nspliced);
+
+      if (circbuf_used(circ) <= (dev->d_bufsize - dev->d_polloutthrd))
+        {
+          poll_notify(dev->d_fds, CONFIG_DEV_PIPE_NPOLLWAITERS, POLLOUT);
+        }
+
+      pipecommon_wakeup(&dev->d_wrsem);
+    }
+
+  nxrmutex_unlock(&dev->d_bflock);
+  return nspliced;
+}
+
+/****************************************************************************
+ * Name: pipecommon_splicein
+ *
+ * Description:
+ *   Read up to 'splice->len' bytes of 'splice->filep' straight into the
+ *   buffer of the pipe.  The pipe stays locked while the file is read, so
+ *   that a file that reports the number of bytes it has for reading
+ *   (FIONREAD), like a socket or another pipe, is not read when it would
+ *   block:  -ENODATA is returned instead, and the caller waits for the data
+ *   without the lock of the pipe.
+ *
+ ****************************************************************************/
+
+static ssize_t pipecommon_splicein(FAR struct file *filep,
+                                   FAR struct pipe_splice_s *splice)
+{
+  FAR struct inode      *inode    = filep->f_inode;
+  FAR struct pipe_dev_s *dev      = inode->i_private;
+  FAR struct circbuf_s  *circ     = &dev->d_buffer;
+  ssize_t                nspliced = 0;
+  ssize_t                ret;
+  FAR void              *ptr;
+  size_t                 len;
+  size_t                 n;
+  int                    navail;
+
+  ret = nxrmutex_lock(&dev->d_bflock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Wait for room in the pipe */
+
+  for (; ; )
+    {
+      if (dev->d_nreaders <= 0 && PIPE_IS_POLICY_0(dev->d_flags))
+        {
+          nxrmutex_unlock(&dev->d_bflock);
+          return -EPIPE;
+        }
+
+      if (!circbuf_is_full(circ))
+        {
+          break;
+        }
+
+      if ((filep->f_oflags & O_NONBLOCK) ||
+          (splice->flags & SPLICE_F_NONBLOCK))
+        {
+          nxrmutex_unlock(&dev->d_bflock);
+          return -EAGAIN;
+        }
+
+      nxrmutex_unlock(&dev->d_bflock);
+      ret = nxsem_wait(&dev->d_wrsem);
+      if (ret < 0 || (ret = nxrmutex_lock(&dev->d_bflock)) < 0)
+        {
+          return ret;
+        }
+    }
+
+  len = splice->len;
+  if (file_ioctl(splice->filep, FIONREAD, (unsigned long)&navail) >= 0)
+    {
+      if (navail <= 0)
+        {
+          nxrmutex_unlock(&dev->d_bflock);
+          return -ENODATA;
+        }
+
+      len = MIN(len, (size_t)navail);
+    }
+
+  /* Read the data in at most two pieces, before and after the end of the
+   * circular buffer.
+   */
+
+  while ((size_t)nspliced < len)
+    {
+      ptr = circbuf_get_writeptr(circ, &n);
+      if (n == 0)
+        {
+          break;
+        }
+
+      n = MIN(n, len - nspliced);
+      if (splice->offset != NULL)
+        {
+          ret = file_pread(splice->filep, ptr, n, *splice->offset);
+          if (ret > 0)
+            {
+              *splice->offset += ret;
+            }
+        }
+      else
+        {
+          ret = file_read(splice->filep, ptr, n);
+        }
+
+      if (ret <= 0)
+        {
+          if (nspliced == 0)
+            {
+              nspliced = ret;
+            }
+
+          break;
+        }
+
+      pipe_dumpbuffer("To PIPE:", ptr, ret);
+      circbuf_writecommit(circ, ret);
+      nspliced += ret;
+      if ((size_t)ret < n)
+        {
+          break;
+        }
+    }
+
+  if (nspliced > 0)
+    {
+      if (circbuf_used(circ) > dev->d_pollinthrd)
+        {
+          poll_notify(dev->d_fds, CONFIG_DEV_PIPE_NPOLLWAITERS, POLLIN);
+        }
+
+      pipecommon_wakeup(&dev->d_rdsem);
+    }
+
+  nxrmutex_unlock(&dev->d_bflock);
+  return nspliced;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -408,14 +653,35 @@ int pipecommon_close(FAR struct file *filep)
  ****************************************************************************/
 
 ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
+{
+  struct iovec iov;
+
+  iov.iov_base = buffer;
+  iov.iov_len  = len;
+  return pipecommon_readv(filep, &iov, 1);
+}
+
+/****************************************************************************
+ * Name: pipecommon_readv
+ ****************************************************************************/
+
+ssize_t pipecommon_readv(FAR struct file *filep,
+                         FAR const struct iovec *iov, int iovcnt)
 {
   FAR struct inode      *inode = filep->f_inode;
   FAR struct pipe_dev_s *dev   = inode->i_private;
   ssize_t                nread = 0;
+  size_t                 len   = 0;
   int                    ret;
+  int                    i;
 
   DEBUGASSERT(dev);
 
+  for (i = 0; i < iovcnt; i++)
+    {
+      len += iov[i].iov_len;
+    }
+
   if (len == 0)
     {
       return 0;
@@ -469,10 +735,16 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
     }
 
   /* Then return whatever is available in the pipe (which is at least one
-   * byte).
+   * byte), filling the buffers in order.
    */
 
-  nread = circbuf_read(&dev->d_buffer, buffer, len);
+  for (i = 0; i < iovcnt && !circbuf_is_empty(&dev->d_buffer); i++)
+    {
+      len    = circbuf_read(&dev->d_buffer, iov[i].iov_base,
+                            iov[i].iov_len);
+      pipe_dumpbuffer("From PIPE:", iov[i].iov_base, len);
+      nread += len;
+    }
 
   /* Notify all poll/select waiters that they can write to the
    * FIFO when buffer can accept more than d_polloutthrd bytes.
@@ -490,7 +762,6 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
   pipecommon_wakeup(&dev->d_wrsem);
 
   nxrmutex_unlock(&dev->d_bflock);
-  pipe_dumpbuffer("From PIPE:", buffer, nread);
   return nread;
 }
 
@@ -500,15 +771,37 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
 
 ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
                          size_t len)
+{
+  struct iovec iov;
+
+  iov.iov_base = (FAR void *)buffer;
+  iov.iov_len  = len;
+  return pipecommon_writev(filep, &iov, 1);
+}
+
+/****************************************************************************
+ * Name: pipecommon_writev
+ ****************************************************************************/
+
+ssize_t pipecommon_writev(FAR struct file *filep,
+                          FAR const struct iovec *iov, int iovcnt)
 {
   FAR struct inode      *inode    = filep->f_inode;
   FAR struct pipe_dev_s *dev      = inode->i_private;
   ssize_t                nwritten = 0;
   ssize_t                last;
+  size_t                 offset   = 0;
+  size_t                 len      = 0;
   int                    ret;
+  int                    i;
 
   DEBUGASSERT(dev);
-  pipe_dumpbuffer("To PIPE:", (FAR uint8_t *)buffer, len);
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      pipe_dumpbuffer("To PIPE:", iov[i].iov_base, iov[i].iov_len);
+      len += iov[i].iov_len;
+    }
 
   /* Handle zero-length writes */
 
@@ -544,9 +837,12 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
       return ret;
     }
 
-  /* Loop until all of the bytes have been written */
+  /* Loop until all of the bytes have been written.  'i' and 'offset' are
+   * the position of the next byte in the buffers.
+   */
 
   last = 0;
+  i    = 0;
   for (; ; )
     {
       /* REVISIT:  "If all file descriptors referring to the read end of a
@@ -567,8 +863,22 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
         {
           /* Loop until all of the bytes have been written */
 
-          nwritten += circbuf_write(&dev->d_buffer,
-                                    buffer + nwritten, len - nwritten);
+          while (i < iovcnt)
+            {
+              ssize_t n = circbuf_write(&dev->d_buffer,
+                                        (FAR uint8_t *)iov[i].iov_base +
+                                        offset, iov[i].iov_len - offset);
+
+              nwritten += n;
+              offset   += n;
+              if (offset < iov[i].iov_len)
+                {
+                  break;
+                }
+
+              offset = 0;
+              i++;
+            }
 
           if ((size_t)nwritten == len)
             {
@@ -788,6 +1098,27 @@ int pipecommon_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
     }
 #endif
 
+  /* The transfers with other files wait for the pipe, they take the lock
+   * of the pipe themselves.
+   */
+
+  switch (cmd)
+    {
+      case PIPEIOC_SPLICEOUT:
+        return pipecommon_spliceout(filep,
+                                    (FAR struct pipe_splice_s *)arg, false);
+
+      case PIPEIOC_SPLICEIN:
+        return pipecommon_splicein(filep, (FAR struct pipe_splice_s *)arg);
+
+      case PIPEIOC_TEE:
+        return pipecommon_spliceout(filep,
+                                    (FAR struct pipe_splice_s *)arg, true);
+
+      default:
+        break;
+    }
+
   ret = nxrmutex_lock(&dev->d_bflock);
   if (ret < 0)
     {
@@ -0,0 +1,417 @@
+/****************************************************************************
+ * drivers/power/pm/latency_governor.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/hrtimer.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/power/pm.h>
+#include <nuttx/wdog.h>
+
+#include <nuttx/irq.h>
+
+#include "pm.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LATENCY_HISTORY   CONFIG_PM_GOVERNOR_LATENCY_HISTORY
+
+/* The durations of the last idle periods are averaged once the outliers
+ * are dropped:  The average is trusted when the standard deviation is not
+ * more than a sixth of it, or 20us.  At most a quarter of the history is
+ * dropped.
+ */
+
+#define LATENCY_DEVIATION 36
+#define LATENCY_VARIANCE  400
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct pm_latency_governor_domain_s
+{
+  /* The QoS constraints of this domain */
+
+  dq_queue_t qos;
+
+  /* The time when the last idle period has begun (us) */
+
+  uint64_t start;
+
+  /* The durations of the last idle periods (us) */
+
+  uint32_t history[LATENCY_HISTORY];
+  uint8_t nhistory;
+  uint8_t index;
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* PM governor methods */
+
+static void latency_governor_statechanged(int domain,
+                                          enum pm_state_e newstate);
+static enum pm_state_e latency_governor_checkstate(int domain);
+static void latency_governor_activity(int domain, int count);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct pm_governor_s g_latency_governor_ops =
+{
+  NULL,                          /* initialize */
+  NULL,                          /* deinitialize */
+  latency_governor_statechanged, /* statechanged */
+  latency_governor_checkstate,   /* checkstate */
+  latency_governor_activity,     /* activity */
+  NULL                           /* priv */
+};
+
+/* The time needed to resume from each state (us) */
+
+static const uint32_t g_latency_governor_exit[PM_COUNT] =
+{
+  0,
+  CONFIG_PM_GOVERNOR_LATENCY_IDLE_EXIT,
+  CONFIG_PM_GOVERNOR_LATENCY_STANDBY_EXIT,
+  CONFIG_PM_GOVERNOR_LATENCY_SLEEP_EXIT,
+};
+
+/* The shortest idle period for which each state saves energy (us) */
+
+static const uint32_t g_latency_governor_residency[PM_COUNT] =
+{
+  0,
+  CONFIG_PM_GOVERNOR_LATENCY_IDLE_RESIDENCY,
+  CONFIG_PM_GOVERNOR_LATENCY_STANDBY_RESIDENCY,
+  CONFIG_PM_GOVERNOR_LATENCY_SLEEP_RESIDENCY,
+};
+
+static struct pm_latency_governor_domain_s
+g_latency_governor[CONFIG_PM_NDOMAINS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: latency_governor_now
+ ****************************************************************************/
+
+static uint64_t latency_governor_now(void)
+{
+  struct timespec ts;
+
+  clock_systime_timespec(&ts);
+  return clock_time2usec(&ts);
+}
+
+/****************************************************************************
+ * Name: latency_governor_typical
+ *
+ * Description:
+ *   Return the typical duration of the idle periods of a domain (us), or
+ *   UINT32_MAX if there is no typical duration.
+ *
+ ****************************************************************************/
+
+static uint32_t
+latency_governor_typical(FAR struct pm_latency_governor_domain_s *gdom)
+{
+  uint32_t thresh = UINT32_MAX;
+  uint64_t variance;
+  uint64_t avg;
+  uint32_t max;
+  int count;
+  int i;
+
+  while (gdom->nhistory > 0)
+    {
+      avg   = 0;
+      max   = 0;
+      count = 0;
+
+      for (i = 0; i < gdom->nhistory; i++)
+        {
+          if (gdom->history[i] <= thresh)
+            {
+              avg += gdom->history[i];
+              max  = MAX(max, gdom->history[i]);
+              count++;
+            }
+        }
+
+      if (count * 4 < gdom->nhistory * 3)
+        {
+          break;
+        }
+
+      avg /= count;
+
+      variance = 0;
+      for (i = 0; i < gdom->nhistory; i++)
+        {
+          if (gdom->history[i] <= thresh)
+            {
+              int64_t diff = (int64_t)gdom->history[i] - avg;
+              variance += diff * diff;
+            }
+        }
+
+      variance /= count;
+
+      if (variance * LATENCY_DEVIATION <= avg * avg ||
+          variance <= LATENCY_VARIANCE)
+        {
+          return avg;
+        }
+
+      /* Drop the longest idle period and try again */
+
+      if (max == 0)
+        {
+          break;
+        }
+
+      thresh = max - 1;
+    }
+
+  return UINT32_MAX;
+}
+
+/****************************************************************************
+ * Name: latency_governor_predict
+ *
+ * Description:
+ *   Predict how long the coming idle period will last (us):  It ends at the
+ *   latest when the next timer expires.
+ *
+ ****************************************************************************/
+
+static uint32_t
+latency_governor_predict(FAR struct pm_latency_governor_domain_s *gdom)
+{
+  uint32_t predict = latency_governor_typical(gdom);
+  sclock_t ticks;
+#ifdef CONFIG_HRTIMER
+  uint64_t nsec;
+#endif
+
+  ticks = wd_getnext();
+  if (ticks >= 0 && (uint64_t)TICK2USEC((uint64_t)ticks) < predict)
+    {
+      predict = TICK2USEC((uint64_t)ticks);
+    }
+
+#ifdef CONFIG_HRTIMER
+  nsec = hrtimer_getnext();
+  if (nsec / NSEC_PER_USEC < predict)
+    {
+      predict = nsec / NSEC_PER_USEC;
+    }
+#endif
+
+  return predict;
+}
+
+/****************************************************************************
+ * Name: latency_governor_statechanged
+ ****************************************************************************/
+
+static void latency_governor_statechanged(int domain,
+                                          enum pm_state_e newstate)
+{
+  FAR struct pm_latency_governor_domain_s *gdom;
+  uint64_t elapsed;
+
+  /* Called with the domain locked:  Measure the idle period from entering
+   * the state chosen by the idle loop to PM_RESTORE on wakeup.
+   */
+
+  gdom = &g_latency_governor[domain];
+
+  if (newstate != PM_RESTORE)
+    {
+      gdom->start = latency_governor_now();
+      return;
+    }
+
+  if (gdom->start == 0)
+    {
+      return;
+    }
+
+  elapsed = latency_governor_now() - gdom->start;
+  gdom->start = 0;
+
+  gdom->history[gdom->index] = MIN(elapsed, UINT32_MAX);
+  gdom->index = (gdom->index + 1) % LATENCY_HISTORY;
+  if (gdom->nhistory < LATENCY_HISTORY)
+    {
+      gdom->nhistory++;
+    }
+}
+
+/****************************************************************************
+ * Name: latency_governor_checkstate
+ ****************************************************************************/
+
+static enum pm_state_e latency_governor_checkstate(int domain)
+{
+  FAR struct pm_latency_governor_domain_s *gdom;
+  FAR struct pm_domain_s *pdom;
+  FAR struct pm_qos_s *qos;
+  FAR dq_entry_t *entry;
+  uint32_t latency = UINT32_MAX;
+  uint32_t predict;
+  irqstate_t flags;
+  int state;
+
+  pdom = &g_pmdomains[domain];
+  gdom = &g_latency_governor[domain];
+  state = PM_NORMAL;
+
+  flags = spin_lock_irqsave(&pdom->lock);
+
+  /* The tightest QoS constraint limits the exit latency */
+
+  for (entry = dq_peek(&gdom->qos); entry; entry = dq_next(entry))
+    {
+      qos = container_of(entry, struct pm_qos_s, node);
+      latency = MIN(latency, qos->latency);
+    }
+
+  predict = latency_governor_predict(gdom);
+
+  /* Find the lowest power-level which is not locked, pays off over the
+   * predicted idle period and resumes in time.
+   */
+
+  while (dq_empty(&pdom->wakelock[state]) && state < (PM_COUNT - 1) &&
+         g_latency_governor_residency[state + 1] <= predict &&
+         g_latency_governor_exit[state + 1] <= latency)
+    {
+      state++;
+    }
+
+  spin_unlock_irqrestore(&pdom->lock, flags);
+
+  return state;
+}
+
+/****************************************************************************
+ * Name: latency_governor_activity
+ ****************************************************************************/
+
+static void latency_governor_activity(int domain, int count)
+{
+  pm_staytimeout(domain, PM_NORMAL, (count ? count : 1) * 1000);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pm_latency_governor_initialize
+ *
+ * Description:
+ *   Return the latency governor instance.
+ *
+ ****************************************************************************/
+
+FAR const struct pm_governor_s *pm_latency_governor_initialize(void)
+{
+  return &g_latency_governor_ops;
+}
+
+/****************************************************************************
+ * Name: pm_qos_add
+ *
+ * Description:
+ *   Add a QoS constraint on the exit latency of its domain.
+ *
+ ****************************************************************************/
+
+void pm_qos_add(FAR struct pm_qos_s *qos)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(qos->domain >= 0 && qos->domain < CONFIG_PM_NDOMAINS);
+
+  flags = pm_domain_lock(qos->domain);
+  dq_addlast(&qos->node, &g_latency_governor[qos->domain].qos);
+  pm_domain_unlock(qos->domain, flags);
+}
+
+/****************************************************************************
+ * Name: pm_qos_update
+ *
+ * Description:
+ *   Change the exit latency allowed by a QoS constraint.
+ *
+ ****************************************************************************/
+
+void pm_qos_update(FAR struct pm_qos_s *qos, uint32_t latency)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(qos->domain >= 0 && qos->domain < CONFIG_PM_NDOMAINS);
+
+  flags = pm_domain_lock(qos->domain);
+  qos->latency = latency;
+  pm_domain_unlock(qos->domain, flags);
+}
+
+/****************************************************************************
+ * Name: pm_qos_remove
+ *
+ * Description:
+ *   Remove a QoS constraint.
+ *
+ ****************************************************************************/
+
+void pm_qos_remove(FAR struct pm_qos_s *qos)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(qos->domain >= 0 && qos->domain < CONFIG_PM_NDOMAINS);
+
+  flags = pm_domain_lock(qos->domain);
+  dq_rem(&qos->node, &g_latency_governor[qos->domain].qos);
+  pm_domain_unlock(qos->domain, flags);
+}
@@ -39,6 +39,44 @@
 typedef CODE void (*regmap_lock_t)(FAR void *);
 typedef CODE void (*regmap_unlock_t)(FAR void *);
 
+struct regmap_s;
+
+/* A block of consecutive registers of the register cache.  Registers are
+ * indexed by their address divided by the register stride.
+ */
+
+struct regcache_block_s
+{
+  unsigned int base;            /* The index of the first register */
+  unsigned int count;           /* The number of registers */
+  FAR unsigned int *values;     /* The cached values */
+  FAR unsigned long *valid;     /* Bitmap of the registers that are cached */
+  FAR unsigned long *dirty;     /* Bitmap of the registers to write back */
+};
+
+typedef CODE int (*regcache_foreach_t)(FAR struct regmap_s *map,
+                                       FAR struct regcache_block_s *block);
+
+/* The operations of a register cache type */
+
+struct regcache_ops_s
+{
+  CODE int (*init)(FAR struct regmap_s *map);
+  CODE void (*exit)(FAR struct regmap_s *map);
+
+  /* Return the block of the register 'index', allocated if 'create' is
+   * true, or NULL.
+   */
+
+  CODE FAR struct regcache_block_s *(*lookup)(FAR struct regmap_s *map,
+                                              unsigned int index,
+                                              bool create);
+
+  /* Call 'cb' for each block in increasing register order until it fails */
+
+  CODE int (*foreach)(FAR struct regmap_s *map, regcache_foreach_t cb);
+};
+
 /* Configuration for the register map of a device.
  * This structure is only used inside regmap.
  */
@@ -79,9 +117,55 @@ struct regmap_s
 
   int reg_stride;
 
+  /* The register cache, from regmap_config_s.  'cache' is private to the
+   * cache type.
+   */
+
+  FAR const struct regcache_ops_s *cache_ops;
+  FAR void *cache;
+  unsigned int max_register;
+  FAR const struct regmap_range_s *volatile_table;
+  unsigned int num_volatile;
+  FAR const struct reg_default_s *reg_defaults;
+  unsigned int num_reg_defaults;
+
+  bool cache_only;              /* Don't access the device */
+  bool cache_dirty;             /* Registers are only written to the cache */
+  bool cache_reset;             /* The device was reset since the last sync */
+
   /* Prevent fragmentation */
 
   mutex_t mutex[0];
 };
 
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* Register cache types */
+
+extern const struct regcache_ops_s g_regcache_flat_ops;
+extern const struct regcache_ops_s g_regcache_rbtree_ops;
+
+/* Register cache, called with the regmap locked */
+
+int regcache_init(FAR struct regmap_s *map,
+                  FAR const struct regmap_config_s *config);
+void regcache_exit(FAR struct regmap_s *map);
+FAR struct regcache_block_s *regcache_block_alloc(unsigned int base,
+                                                  unsigned int count);
+bool regcache_volatile(FAR struct regmap_s *map, unsigned int reg);
+int regcache_read(FAR struct regmap_s *map, unsigned int reg,
+                  FAR unsigned int *val);
+int regcache_write(FAR struct regmap_s *map, unsigned int reg,
+                   unsigned int val, bool dirty);
+int regcache_sync_dirty(FAR struct regmap_s *map);
+
+/* Write 'count' consecutive registers from 'vals' to the device in one
+ * bus transfer if possible, called with the regmap locked.
+ */
+
+int regmap_write_block(FAR struct regmap_s *map, unsigned int reg,
+                       FAR const unsigned int *vals, unsigned int count);
+
 #endif /* __DRIVERS_REGMAP_INTERNAL_H */
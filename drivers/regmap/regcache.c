@@ -0,0 +1,430 @@
+/****************************************************************************
+ * drivers/regmap/regcache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/bits.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/regmap/regmap.h>
+
+#include <errno.h>
+#include <limits.h>
+
+#include "internal.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: regcache_default
+ *
+ * Description:
+ *   Get the reset value of a register, if it has one.
+ *
+ ****************************************************************************/
+
+static bool regcache_default(FAR struct regmap_s *map, unsigned int reg,
+                             FAR unsigned int *def)
+{
+  unsigned int i;
+
+  for (i = 0; i < map->num_reg_defaults; i++)
+    {
+      if (map->reg_defaults[i].reg == reg)
+        {
+          *def = map->reg_defaults[i].def;
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: regcache_sync_block
+ *
+ * Description:
+ *   Write back the dirty registers of a block, each run of consecutive
+ *   registers at once.  After a reset, the registers that have their reset
+ *   value are skipped.
+ *
+ ****************************************************************************/
+
+static int regcache_sync_block(FAR struct regmap_s *map,
+                               FAR struct regcache_block_s *block)
+{
+  unsigned int start = 0;
+  unsigned int count = 0;
+  unsigned int def;
+  unsigned int reg;
+  unsigned int i;
+  int ret;
+
+  for (i = 0; i <= block->count; i++)
+    {
+      if (i < block->count && test_bit(i, block->dirty))
+        {
+          reg = (block->base + i) * map->reg_stride;
+          if (!map->cache_reset || !regcache_default(map, reg, &def) ||
+              def != block->values[i])
+            {
+              if (count++ == 0)
+                {
+                  start = i;
+                }
+
+              continue;
+            }
+
+          clear_bit(i, block->dirty);
+        }
+
+      if (count > 0)
+        {
+          ret = regmap_write_block(map,
+                                   (block->base + start) * map->reg_stride,
+                                   &block->values[start], count);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          for (; count > 0; count--, start++)
+            {
+              clear_bit(start, block->dirty);
+            }
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: regcache_mark_block
+ ****************************************************************************/
+
+static int regcache_mark_block(FAR struct regmap_s *map,
+                               FAR struct regcache_block_s *block)
+{
+  unsigned int i;
+
+  for (i = 0; i < BITS_TO_LONGS(block->count); i++)
+    {
+      block->dirty[i] = block->valid[i];
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: regcache_init
+ *
+ * Description:
+ *   Create the register cache of a regmap and fill it with the reset
+ *   values of the registers.
+ *
+ ****************************************************************************/
+
+int regcache_init(FAR struct regmap_s *map,
+                  FAR const struct regmap_config_s *config)
+{
+  unsigned int i;
+  int ret;
+
+  switch (config->cache_type)
+    {
+      case REGCACHE_NONE:
+        return OK;
+
+      case REGCACHE_FLAT:
+        if (config->max_register == 0)
+          {
+            return -EINVAL;
+          }
+
+        map->cache_ops = &g_regcache_flat_ops;
+        break;
+
+      case REGCACHE_RBTREE:
+        map->cache_ops = &g_regcache_rbtree_ops;
+        break;
+
+      default:
+        return -EINVAL;
+    }
+
+  map->max_register     = config->max_register != 0 ?
+                          config->max_register : UINT_MAX;
+  map->volatile_table   = config->volatile_table;
+  map->num_volatile     = config->num_volatile;
+  map->reg_defaults     = config->reg_defaults;
+  map->num_reg_defaults = config->num_reg_defaults;
+
+  ret = map->cache_ops->init(map);
+  if (ret < 0)
+    {
+      map->cache_ops = NULL;
+      return ret;
+    }
+
+  for (i = 0; i < map->num_reg_defaults; i++)
+    {
+      if (!regcache_volatile(map, map->reg_defaults[i].reg))
+        {
+          ret = regcache_write(map, map->reg_defaults[i].reg,
+                               map->reg_defaults[i].def, false);
+          if (ret < 0)
+            {
+              regcache_exit(map);
+              return ret;
+            }
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: regcache_exit
+ ****************************************************************************/
+
+void regcache_exit(FAR struct regmap_s *map)
+{
+  if (map->cache_ops != NULL)
+    {
+      map->cache_ops->exit(map);
+      map->cache_ops = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: regcache_block_alloc
+ *
+ * Description:
+ *   Allocate an empty block of 'count' registers starting at index 'base'.
+ *
+ ****************************************************************************/
+
+FAR struct regcache_block_s *regcache_block_alloc(unsigned int base,
+                                                  unsigned int count)
+{
+  FAR struct regcache_block_s *block;
+  size_t nlongs = BITS_TO_LONGS(count);
+
+  block = kmm_zalloc(sizeof(*block) + 2 * nlongs * sizeof(unsigned long) +
+                     count * sizeof(unsigned int));
+  if (block == NULL)
+    {
+      return NULL;
+    }
+
+  block->base   = base;
+  block->count  = count;
+  block->valid  = (FAR unsigned long *)(block + 1);
+  block->dirty  = block->valid + nlongs;
+  block->values = (FAR unsigned int *)(block->dirty + nlongs);
+  return block;
+}
+
+/****************************************************************************
+ * Name: regcache_volatile
+ *
+ * Description:
+ *   Return true if a register is not cached.
+ *
+ ****************************************************************************/
+
+bool regcache_volatile(FAR struct regmap_s *map, unsigned int reg)
+{
+  unsigned int i;
+
+  if (map->cache_ops == NULL || reg > map->max_register)
+    {
+      return true;
+    }
+
+  for (i = 0; i < map->num_volatile; i++)
+    {
+      if (reg >= map->volatile_table[i].range_min &&
+          reg <= map->volatile_table[i].range_max)
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: regcache_read
+ *
+ * Description:
+ *   Read a register from the cache, -ENOENT if it is not cached yet.
+ *
+ ****************************************************************************/
+
+int regcache_read(FAR struct regmap_s *map, unsigned int reg,
+                  FAR unsigned int *val)
+{
+  FAR struct regcache_block_s *block;
+  unsigned int index = reg / map->reg_stride;
+
+  block = map->cache_ops->lookup(map, index, false);
+  if (block == NULL || !test_bit(index - block->base, block->valid))
+    {
+      return -ENOENT;
+    }
+
+  *val = block->values[index - block->base];
+  return OK;
+}
+
+/****************************************************************************
+ * Name: regcache_write
+ *
+ * Description:
+ *   Write a register to the cache.  'dirty' is true if the value is not
+ *   written to the device yet.
+ *
+ ****************************************************************************/
+
+int regcache_write(FAR struct regmap_s *map, unsigned int reg,
+                   unsigned int val, bool dirty)
+{
+  FAR struct regcache_block_s *block;
+  unsigned int index = reg / map->reg_stride;
+
+  block = map->cache_ops->lookup(map, index, true);
+  if (block == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  index -= block->base;
+  block->values[index] = val;
+  set_bit(index, block->valid);
+
+  if (dirty)
+    {
+      set_bit(index, block->dirty);
+      map->cache_dirty = true;
+    }
+  else
+    {
+      clear_bit(index, block->dirty);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: regcache_sync_dirty
+ *
+ * Description:
+ *   Write back all dirty registers.
+ *
+ ****************************************************************************/
+
+int regcache_sync_dirty(FAR struct regmap_s *map)
+{
+  int ret;
+
+  if (map->cache_ops == NULL || !map->cache_dirty)
+    {
+      return OK;
+    }
+
+  if (map->cache_only)
+    {
+      return -EBUSY;
+    }
+
+  ret = map->cache_ops->foreach(map, regcache_sync_block);
+  if (ret >= 0)
+    {
+      map->cache_dirty = false;
+      map->cache_reset = false;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: regcache_cache_only
+ *
+ * Description:
+ *   Enable or disable the cache only mode.
+ *
+ ****************************************************************************/
+
+void regcache_cache_only(FAR struct regmap_s *map, bool enable)
+{
+  map->lock(map);
+  map->cache_only = enable;
+  map->unlock(map);
+}
+
+/****************************************************************************
+ * Name: regcache_mark_dirty
+ *
+ * Description:
+ *   Tell the cache that the device was reset.
+ *
+ ****************************************************************************/
+
+void regcache_mark_dirty(FAR struct regmap_s *map)
+{
+  map->lock(map);
+
+  if (map->cache_ops != NULL)
+    {
+      map->cache_ops->foreach(map, regcache_mark_block);
+      map->cache_dirty = true;
+      map->cache_reset = true;
+    }
+
+  map->unlock(map);
+}
+
+/****************************************************************************
+ * Name: regcache_sync
+ *
+ * Description:
+ *   Write back the registers that were only written to the cache.
+ *
+ ****************************************************************************/
+
+int regcache_sync(FAR struct regmap_s *map)
+{
+  int ret;
+
+  map->lock(map);
+  ret = regcache_sync_dirty(map);
+  map->unlock(map);
+
+  return ret;
+}
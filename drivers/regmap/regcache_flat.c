@@ -0,0 +1,87 @@
+/****************************************************************************
+ * drivers/regmap/regcache_flat.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/kmalloc.h>
+
+#include <errno.h>
+
+#include "internal.h"
+
+/* The flat cache is one block of all registers up to max_register */
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int regcache_flat_init(FAR struct regmap_s *map);
+static void regcache_flat_exit(FAR struct regmap_s *map);
+static FAR struct regcache_block_s *
+regcache_flat_lookup(FAR struct regmap_s *map, unsigned int index,
+                     bool create);
+static int regcache_flat_foreach(FAR struct regmap_s *map,
+                                 regcache_foreach_t cb);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct regcache_ops_s g_regcache_flat_ops =
+{
+  regcache_flat_init,           /* init */
+  regcache_flat_exit,           /* exit */
+  regcache_flat_lookup,         /* lookup */
+  regcache_flat_foreach         /* foreach */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int regcache_flat_init(FAR struct regmap_s *map)
+{
+  map->cache = regcache_block_alloc(0, map->max_register /
+                                       map->reg_stride + 1);
+  return map->cache != NULL ? OK : -ENOMEM;
+}
+
+static void regcache_flat_exit(FAR struct regmap_s *map)
+{
+  kmm_free(map->cache);
+  map->cache = NULL;
+}
+
+static FAR struct regcache_block_s *
+regcache_flat_lookup(FAR struct regmap_s *map, unsigned int index,
+                     bool create)
+{
+  FAR struct regcache_block_s *block = map->cache;
+
+  return index < block->count ? block : NULL;
+}
+
+static int regcache_flat_foreach(FAR struct regmap_s *map,
+                                 regcache_foreach_t cb)
+{
+  return cb(map, map->cache);
+}
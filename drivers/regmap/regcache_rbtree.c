@@ -0,0 +1,186 @@
+/****************************************************************************
+ * drivers/regmap/regcache_rbtree.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/kmalloc.h>
+#include <sys/tree.h>
+
+#include <errno.h>
+
+#include "internal.h"
+
+/* The rbtree cache holds blocks of REGCACHE_RBTREE_BLOCK registers in a
+ * red-black tree sorted by address:  Blocks are only allocated once one of
+ * their registers is cached, which suits sparse register maps.
+ */
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define REGCACHE_RBTREE_BLOCK 16
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct regcache_rbtree_node_s
+{
+  RB_ENTRY(regcache_rbtree_node_s) entry;
+  FAR struct regcache_block_s *block;
+};
+
+RB_HEAD(regcache_rbtree_s, regcache_rbtree_node_s);
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int regcache_rbtree_init(FAR struct regmap_s *map);
+static void regcache_rbtree_exit(FAR struct regmap_s *map);
+static FAR struct regcache_block_s *
+regcache_rbtree_lookup(FAR struct regmap_s *map, unsigned int index,
+                       bool create);
+static int regcache_rbtree_foreach(FAR struct regmap_s *map,
+                                   regcache_foreach_t cb);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct regcache_ops_s g_regcache_rbtree_ops =
+{
+  regcache_rbtree_init,         /* init */
+  regcache_rbtree_exit,         /* exit */
+  regcache_rbtree_lookup,       /* lookup */
+  regcache_rbtree_foreach       /* foreach */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int regcache_rbtree_compare(FAR struct regcache_rbtree_node_s *a,
+                                   FAR struct regcache_rbtree_node_s *b)
+{
+  if (a->block->base < b->block->base)
+    {
+      return -1;
+    }
+
+  return a->block->base > b->block->base;
+}
+
+RB_GENERATE_STATIC(regcache_rbtree_s, regcache_rbtree_node_s, entry,
+                   regcache_rbtree_compare)
+
+static int regcache_rbtree_init(FAR struct regmap_s *map)
+{
+  FAR struct regcache_rbtree_s *tree;
+
+  tree = kmm_malloc(sizeof(*tree));
+  if (tree == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  RB_INIT(tree);
+  map->cache = tree;
+  return OK;
+}
+
+static void regcache_rbtree_exit(FAR struct regmap_s *map)
+{
+  FAR struct regcache_rbtree_s *tree = map->cache;
+  FAR struct regcache_rbtree_node_s *node;
+  FAR struct regcache_rbtree_node_s *next;
+
+  RB_FOREACH_SAFE(node, regcache_rbtree_s, tree, next)
+    {
+      RB_REMOVE(regcache_rbtree_s, tree, node);
+      kmm_free(node->block);
+      kmm_free(node);
+    }
+
+  kmm_free(tree);
+  map->cache = NULL;
+}
+
+static FAR struct regcache_block_s *
+regcache_rbtree_lookup(FAR struct regmap_s *map, unsigned int index,
+                       bool create)
+{
+  FAR struct regcache_rbtree_s *tree = map->cache;
+  FAR struct regcache_rbtree_node_s *node;
+  struct regcache_rbtree_node_s key;
+  struct regcache_block_s keyblock;
+
+  keyblock.base = index - index % REGCACHE_RBTREE_BLOCK;
+  key.block = &keyblock;
+
+  node = RB_FIND(regcache_rbtree_s, tree, &key);
+  if (node != NULL)
+    {
+      return node->block;
+    }
+
+  if (!create)
+    {
+      return NULL;
+    }
+
+  node = kmm_malloc(sizeof(*node));
+  if (node == NULL)
+    {
+      return NULL;
+    }
+
+  node->block = regcache_block_alloc(keyblock.base, REGCACHE_RBTREE_BLOCK);
+  if (node->block == NULL)
+    {
+      kmm_free(node);
+      return NULL;
+    }
+
+  RB_INSERT(regcache_rbtree_s, tree, node);
+  return node->block;
+}
+
+static int regcache_rbtree_foreach(FAR struct regmap_s *map,
+                                   regcache_foreach_t cb)
+{
+  FAR struct regcache_rbtree_s *tree = map->cache;
+  FAR struct regcache_rbtree_node_s *node;
+  int ret;
+
+  RB_FOREACH(node, regcache_rbtree_s, tree)
+    {
+      ret = cb(map, node->block);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  return OK;
+}
@@ -27,6 +27,8 @@
 #include <nuttx/kmalloc.h>
 
 #include <debug.h>
+#include <string.h>
+#include <sys/param.h>
 
 #include "internal.h"
 
@@ -39,6 +41,10 @@
 
 #define REGMAP_DEFAULT_BIT 8
 
+/* The largest bus transfer that is built on the stack */
+
+#define REGMAP_BUFSIZE     32
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -59,6 +65,218 @@ static void regmap_unlock_mutex(FAR void *context)
   nxmutex_unlock(&map->mutex[0]);
 }
 
+/* Register addresses are sent least significant byte first and values in
+ * the format of the buffers of the caller.
+ */
+
+static void regmap_format_reg(FAR struct regmap_s *map, FAR uint8_t *buf,
+                              unsigned int reg)
+{
+  int i;
+
+  for (i = 0; i < map->reg_bytes; i++)
+    {
+      buf[i] = reg >> (8 * i);
+    }
+}
+
+static int regmap_format_val(FAR struct regmap_s *map, FAR void *buf,
+                             unsigned int val)
+{
+  switch (map->val_bytes)
+    {
+      case 1:
+        *(FAR uint8_t *)buf = val;
+        break;
+      case 2:
+        *(FAR uint16_t *)buf = val;
+        break;
+      case 4:
+        *(FAR uint32_t *)buf = val;
+        break;
+      default:
+        return -EINVAL;
+    }
+
+  return OK;
+}
+
+static int regmap_parse_val(FAR struct regmap_s *map, FAR const void *buf,
+                            FAR unsigned int *val)
+{
+  switch (map->val_bytes)
+    {
+      case 1:
+        *val = *(FAR const uint8_t *)buf;
+        break;
+      case 2:
+        *val = *(FAR const uint16_t *)buf;
+        break;
+      case 4:
+        *val = *(FAR const uint32_t *)buf;
+        break;
+      default:
+        return -EINVAL;
+    }
+
+  return OK;
+}
+
+/* Write 'count' consecutive registers from a buffer of values in one bus
+ * transfer if the bus supports it, with the regmap locked.
+ */
+
+static int regmap_raw_write(FAR struct regmap_s *map, unsigned int reg,
+                            FAR const void *val, unsigned int val_count)
+{
+  uint8_t stackbuf[REGMAP_BUFSIZE + sizeof(unsigned int)];
+  size_t size = map->reg_bytes + val_count * map->val_bytes;
+  FAR uint8_t *buf = stackbuf;
+  unsigned int ival;
+  unsigned int i;
+  int ret = OK;
+
+  if (map->write == NULL || val_count == 1)
+    {
+      for (i = 0; i < val_count; i++)
+        {
+          ret = regmap_parse_val(map, (FAR const uint8_t *)val +
+                                      i * map->val_bytes, &ival);
+          if (ret < 0)
+            {
+              break;
+            }
+
+          ret = map->reg_write(map->bus, reg + i * map->reg_stride, ival);
+          if (ret < 0)
+            {
+              break;
+            }
+        }
+
+      return ret;
+    }
+
+  if (size > sizeof(stackbuf))
+    {
+      buf = kmm_malloc(size);
+      if (buf == NULL)
+        {
+          return -ENOMEM;
+        }
+    }
+
+  regmap_format_reg(map, buf, reg);
+  memcpy(buf + map->reg_bytes, val, val_count * map->val_bytes);
+
+  ret = map->write(map->bus, buf, size);
+
+  if (buf != stackbuf)
+    {
+      kmm_free(buf);
+    }
+
+  return ret;
+}
+
+/* Read a register from the cache or the device, with the regmap locked */
+
+static int regmap_read_locked(FAR struct regmap_s *map, unsigned int reg,
+                              FAR unsigned int *val)
+{
+  bool cached = !regcache_volatile(map, reg);
+  unsigned int ival = 0;
+  int ret;
+
+  if (cached && regcache_read(map, reg, val) >= 0)
+    {
+      return OK;
+    }
+
+  if (map->cache_only)
+    {
+      return -EBUSY;
+    }
+
+  ret = map->reg_read(map->bus, reg, &ival);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  regmap_parse_val(map, &ival, val);
+  if (cached)
+    {
+      regcache_write(map, reg, *val, false);
+    }
+
+  return ret;
+}
+
+/* Write a register to the device and the cache, with the regmap locked */
+
+static int regmap_write_locked(FAR struct regmap_s *map, unsigned int reg,
+                               unsigned int val)
+{
+  bool cached = !regcache_volatile(map, reg);
+  int ret;
+
+  if (map->cache_only)
+    {
+      return cached ? regcache_write(map, reg, val, true) : -EBUSY;
+    }
+
+  ret = map->reg_write(map->bus, reg, val);
+  if (ret >= 0 && cached)
+    {
+      regcache_write(map, reg, val, false);
+    }
+
+  return ret;
+}
+
+/* Write consecutive registers to the device and the cache, with the regmap
+ * locked.
+ */
+
+static int regmap_write_run(FAR struct regmap_s *map, unsigned int reg,
+                            FAR const unsigned int *vals,
+                            unsigned int count)
+{
+  unsigned int i;
+  int ret;
+
+  if (map->cache_only)
+    {
+      for (i = 0; i < count; i++)
+        {
+          if (regcache_volatile(map, reg + i * map->reg_stride))
+            {
+              return -EBUSY;
+            }
+        }
+    }
+  else
+    {
+      ret = regmap_write_block(map, reg, vals, count);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  for (i = 0; i < count; i++)
+    {
+      if (!regcache_volatile(map, reg + i * map->reg_stride))
+        {
+          regcache_write(map, reg + i * map->reg_stride, vals[i],
+                         map->cache_only);
+        }
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -104,6 +322,7 @@ FAR struct regmap_s *regmap_init(FAR struct regmap_bus_s *bus,
           return NULL;
         }
 
+      map->disable_locking = true;
       map->lock   = regmap_lock_unlock_none;
       map->unlock = regmap_lock_unlock_none;
     }
@@ -138,9 +357,65 @@ FAR struct regmap_s *regmap_init(FAR struct regmap_bus_s *bus,
   map->read  = bus->read;
   map->write = bus->write;
 
+  if (regcache_init(map, config) < 0)
+    {
+      if (!map->disable_locking)
+        {
+          nxmutex_destroy(&map->mutex[0]);
+        }
+
+      kmm_free(map);
+      return NULL;
+    }
+
   return map;
 }
 
+/****************************************************************************
+ * Name: regmap_write_block
+ *
+ * Description:
+ *   Write 'count' consecutive registers from 'vals' to the device, in one
+ *   bus transfer per REGMAP_BUFSIZE bytes if the bus supports bulk writes.
+ *   Called with the regmap locked.
+ *
+ ****************************************************************************/
+
+int regmap_write_block(FAR struct regmap_s *map, unsigned int reg,
+                       FAR const unsigned int *vals, unsigned int count)
+{
+  uint8_t buf[REGMAP_BUFSIZE];
+  unsigned int chunk = REGMAP_BUFSIZE / map->val_bytes;
+  unsigned int n;
+  unsigned int i;
+  int ret;
+
+  while (count > 0)
+    {
+      n = MIN(count, chunk);
+      for (i = 0; i < n; i++)
+        {
+          ret = regmap_format_val(map, buf + i * map->val_bytes, vals[i]);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+
+      ret = regmap_raw_write(map, reg, buf, n);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      reg   += n * map->reg_stride;
+      vals  += n;
+      count -= n;
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Name: regmap_write
  *
@@ -171,7 +446,7 @@ int regmap_write(FAR struct regmap_s *map, unsigned int reg,
 
   map->lock(map);
 
-  ret = map->reg_write(map->bus, reg, val);
+  ret = regmap_write_locked(map, reg, val);
 
   map->unlock(map);
 
@@ -204,43 +479,44 @@ int regmap_bulk_write(FAR struct regmap_s *map, unsigned int reg,
                       FAR const void *val, unsigned int val_count)
 {
   size_t val_bytes = map->val_bytes;
-  int ret = -ENOSYS;
   unsigned int ival;
-  FAR uint8_t *ptr;
-  int i;
+  unsigned int i;
+  int ret = OK;
 
   DEBUGASSERT(REGMAP_ALIGNED(reg, map->reg_stride));
 
   map->lock(map);
-  if (map->write != NULL)
-    {
-      ret = map->write(map->bus, val, val_bytes * val_count);
-      goto out;
-    }
 
-  for (i = 0; i < val_count; i++)
+  if (map->cache_only)
     {
-      ptr = (FAR uint8_t *)val + (i * val_bytes);
-      switch (val_bytes)
+      for (i = 0; i < val_count; i++)
         {
-          case 1:
-            ival = *(FAR uint8_t *)ptr;
-            break;
-          case 2:
-            ival = *(FAR uint16_t *)ptr;
-            break;
-          case 4:
-            ival = *(FAR uint32_t *)ptr;
-            break;
-          default:
-            ret = -EINVAL;
-            goto out;
+          if (regcache_volatile(map, reg + i * map->reg_stride))
+            {
+              ret = -EBUSY;
+              goto out;
+            }
         }
+    }
+  else
+    {
+      /* The register address and the values go in one transfer */
 
-      ret = map->reg_write(map->bus, reg + (i * map->reg_stride), ival);
+      ret = regmap_raw_write(map, reg, val, val_count);
       if (ret < 0)
         {
-          break;
+          goto out;
+        }
+    }
+
+  for (i = 0; i < val_count; i++)
+    {
+      if (!regcache_volatile(map, reg + i * map->reg_stride) &&
+          regmap_parse_val(map, (FAR const uint8_t *)val + i * val_bytes,
+                           &ival) >= 0)
+        {
+          regcache_write(map, reg + i * map->reg_stride, ival,
+                         map->cache_only);
         }
     }
 
@@ -272,13 +548,18 @@ out:
 
 int regmap_read(FAR struct regmap_s *map, unsigned int reg, FAR void *val)
 {
+  unsigned int ival;
   int ret;
 
   DEBUGASSERT(REGMAP_ALIGNED(reg, map->reg_stride));
 
   map->lock(map);
 
-  ret = map->reg_read(map->bus, reg, val);
+  ret = regmap_read_locked(map, reg, &ival);
+  if (ret >= 0)
+    {
+      regmap_format_val(map, val, ival);
+    }
 
   map->unlock(map);
   return ret;
@@ -309,54 +590,248 @@ int regmap_read(FAR struct regmap_s *map, unsigned int reg, FAR void *val)
 int regmap_bulk_read(FAR struct regmap_s *map, unsigned int reg,
                      FAR void *val, unsigned int val_count)
 {
-  FAR uint32_t *u32 = val;
-  FAR uint16_t *u16 = val;
-  FAR uint8_t  *u8  = val;
+  FAR uint8_t *ptr = val;
+  uint8_t regbuf[sizeof(unsigned int)];
   unsigned int ival;
-  int ret = -ENOSYS;
+  int ret = OK;
   int i;
 
   DEBUGASSERT(REGMAP_ALIGNED(reg, map->reg_stride));
 
   map->lock(map);
 
+  /* Serve the read from the cache if all registers are cached */
+
+  for (i = 0; i < val_count; i++)
+    {
+      if (regcache_volatile(map, reg + i * map->reg_stride) ||
+          regcache_read(map, reg + i * map->reg_stride, &ival) < 0)
+        {
+          break;
+        }
+
+      regmap_format_val(map, ptr + i * map->val_bytes, ival);
+    }
+
+  if (i == val_count)
+    {
+      goto out;
+    }
+
+  if (map->cache_only)
+    {
+      ret = -EBUSY;
+      goto out;
+    }
+
   if (map->read != NULL)
     {
-      ret = map->read(map->bus, &reg, map->reg_bytes, val, val_count);
+      regmap_format_reg(map, regbuf, reg);
+      ret = map->read(map->bus, regbuf, map->reg_bytes, val,
+                      val_count * map->val_bytes);
+      if (ret < 0)
+        {
+          goto out;
+        }
+
+      for (i = 0; i < val_count; i++)
+        {
+          if (!regcache_volatile(map, reg + i * map->reg_stride) &&
+              regmap_parse_val(map, ptr + i * map->val_bytes, &ival) >= 0)
+            {
+              regcache_write(map, reg + i * map->reg_stride, ival, false);
+            }
+        }
     }
   else
     {
       for (i = 0; i < val_count; i++)
         {
-          ret = map->reg_read(map->bus, reg + (i * map->reg_stride), &ival);
+          ret = regmap_read_locked(map, reg + (i * map->reg_stride), &ival);
           if (ret < 0)
             {
               break;
             }
 
-          switch (map->val_bytes)
+          ret = regmap_format_val(map, ptr + i * map->val_bytes, ival);
+          if (ret < 0)
             {
-              case 4:
-                u32[i] = ival;
-                break;
-              case 2:
-                u16[i] = ival;
-                break;
-              case 1:
-                u8[i] = ival;
-                break;
-              default:
-                map->unlock(map);
-                return -EINVAL;
+              break;
             }
         }
     }
 
+out:
   map->unlock(map);
 
   return ret;
 }
 
+/****************************************************************************
+ * Name: regmap_update_bits
+ *
+ * Description:
+ *   Read-modify-write of the bits 'mask' of a register, without accessing
+ *   the bus for the read of a cached register nor for a write that does
+ *   not change the register.
+ *
+ * Input Parameters:
+ *   map  - regmap handler, from regmap bus init function return.
+ *   reg  - register address to be updated.
+ *   mask - the bits to update.
+ *   val  - the new value of the bits.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int regmap_update_bits(FAR struct regmap_s *map, unsigned int reg,
+                       unsigned int mask, unsigned int val)
+{
+  unsigned int orig;
+  unsigned int tmp;
+  int ret;
+
+  DEBUGASSERT(REGMAP_ALIGNED(reg, map->reg_stride));
+
+  map->lock(map);
+
+  ret = regmap_read_locked(map, reg, &orig);
+  if (ret >= 0)
+    {
+      tmp = (orig & ~mask) | (val & mask);
+      if (tmp != orig || regcache_volatile(map, reg))
+        {
+          ret = regmap_write_locked(map, reg, tmp);
+        }
+    }
+
+  map->unlock(map);
+  return ret < 0 ? ret : OK;
+}
+
+/****************************************************************************
+ * Name: regmap_multi_reg_write
+ *
+ * Description:
+ *   Write a sequence of registers, each run of consecutive registers in
+ *   one bus transfer.
+ *
+ * Input Parameters:
+ *   map      - regmap handler, from regmap bus init function return.
+ *   regs     - the registers and values to be written, in order.
+ *   num_regs - the number of registers.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int regmap_multi_reg_write(FAR struct regmap_s *map,
+                           FAR const struct reg_sequence_s *regs,
+                           unsigned int num_regs)
+{
+  unsigned int vals[REGMAP_BUFSIZE];
+  unsigned int start = 0;
+  unsigned int count = 0;
+  unsigned int i;
+  int ret = OK;
+
+  map->lock(map);
+
+  for (i = 0; i < num_regs; i++)
+    {
+      DEBUGASSERT(REGMAP_ALIGNED(regs[i].reg, map->reg_stride));
+
+      if (count > 0 && (count == REGMAP_BUFSIZE ||
+          regs[i].reg != regs[start].reg + count * map->reg_stride))
+        {
+          ret = regmap_write_run(map, regs[start].reg, vals, count);
+          if (ret < 0)
+            {
+              goto out;
+            }
+
+          count = 0;
+        }
+
+      if (count == 0)
+        {
+          start = i;
+        }
+
+      vals[count++] = regs[i].def;
+    }
+
+  if (count > 0)
+    {
+      ret = regmap_write_run(map, regs[start].reg, vals, count);
+    }
+
+out:
+  map->unlock(map);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: regmap_write_async
+ *
+ * Description:
+ *   Write a register without waiting for the bus if it is cached, until
+ *   regmap_async_complete().
+ *
+ * Input Parameters:
+ *   map - regmap handler, from regmap bus init function return.
+ *   reg - register address to be write.
+ *   val - write data.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int regmap_write_async(FAR struct regmap_s *map, unsigned int reg,
+                       unsigned int val)
+{
+  int ret;
+
+  DEBUGASSERT(REGMAP_ALIGNED(reg, map->reg_stride));
+
+  map->lock(map);
+
+  if (!regcache_volatile(map, reg))
+    {
+      ret = regcache_write(map, reg, val, true);
+    }
+  else
+    {
+      ret = regmap_write_locked(map, reg, val);
+    }
+
+  map->unlock(map);
+  return ret < 0 ? ret : OK;
+}
+
+/****************************************************************************
+ * Name: regmap_async_complete
+ *
+ * Description:
+ *   Write to the device all registers written with regmap_write_async().
+ *
+ * Input Parameters:
+ *   map - regmap handler, from regmap bus init function return.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int regmap_async_complete(FAR struct regmap_s *map)
+{
+  return regcache_sync(map);
+}
+
 /****************************************************************************
  * Name: regmap_exit
  *
@@ -372,6 +847,8 @@ int regmap_bulk_read(FAR struct regmap_s *map, unsigned int reg,
 
 void regmap_exit(FAR struct regmap_s *map)
 {
+  regcache_exit(map);
+
   if (!map->disable_locking)
     {
       nxmutex_destroy(&map->mutex[0]);
@@ -183,6 +183,40 @@ int rpmsg_post(FAR struct rpmsg_endpoint *ept, FAR sem_t *sem)
   return rpmsg->ops->post(rpmsg, sem);
 }
 
+FAR void *rpmsg_reserve(FAR struct rpmsg_endpoint *ept, FAR sem_t *ready,
+                        FAR uint32_t *len)
+{
+  int sval;
+
+  /* 'ready' stays posted once the endpoint is bound */
+
+  if (ready != NULL)
+    {
+      nxsem_get_value(ready, &sval);
+      if (sval <= 0)
+        {
+          rpmsg_wait(ept, ready);
+          rpmsg_post(ept, ready);
+        }
+    }
+
+  return rpmsg_get_tx_payload_buffer(ept, len, true);
+}
+
+int rpmsg_commit(FAR struct rpmsg_endpoint *ept, FAR void *msg,
+                 uint32_t len)
+{
+  int ret;
+
+  ret = rpmsg_send_nocopy(ept, msg, len);
+  if (ret < 0)
+    {
+      rpmsg_release_tx_buffer(ept, msg);
+    }
+
+  return ret;
+}
+
 FAR const char *rpmsg_get_local_cpuname(FAR struct rpmsg_device *rdev)
 {
   FAR struct rpmsg_s *rpmsg = rpmsg_get_by_rdev(rdev);
@@ -26,6 +26,7 @@
 
 #include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/nuttx.h>
 
 #include <metal/mutex.h>
 #include <metal/sys.h>
@@ -41,6 +42,10 @@
 #define RPMSG_PORT_BUF_TO_NODE(q,b) ((q)->node + ((FAR void *)(b) - (q)->buf) / (q)->len)
 #define RPMSG_PORT_NODE_TO_BUF(q,n) ((q)->buf + (((n) - (q)->node)) * (q)->len)
 
+/* The messages aggregated in a frame start at 8 bytes boundaries */
+
+#define RPMSG_PORT_AGGREGATE_ALIGN  8
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -120,6 +125,51 @@ rpmsg_port_remove_node(FAR struct rpmsg_port_list_s *list)
   return node;
 }
 
+/****************************************************************************
+ * Name: rpmsg_port_merge_buffer
+ *
+ * Description:
+ *   Append the message of 'hdr' to the last frame of the ready list of the
+ *   queue if it has room:  The frame is not taken by the driver as long as
+ *   it is in the list.
+ *
+ ****************************************************************************/
+
+#if CONFIG_RPMSG_PORT_AGGREGATE > 0
+static bool rpmsg_port_merge_buffer(FAR struct rpmsg_port_queue_s *queue,
+                                    FAR struct rpmsg_port_header_s *hdr)
+{
+  uint16_t len = hdr->len - sizeof(struct rpmsg_port_header_s);
+  FAR struct rpmsg_port_header_s *tail;
+  FAR struct list_node *node;
+  bool merged = false;
+  irqstate_t flags;
+  uint16_t off;
+
+  if (len > CONFIG_RPMSG_PORT_AGGREGATE)
+    {
+      return false;
+    }
+
+  flags = spin_lock_irqsave(&queue->ready.lock);
+  node = list_peek_tail(&queue->ready.head);
+  if (node != NULL)
+    {
+      tail = RPMSG_PORT_NODE_TO_BUF(queue, node);
+      off  = ALIGN_UP(tail->len, RPMSG_PORT_AGGREGATE_ALIGN);
+      if (off + len <= queue->len)
+        {
+          memcpy((FAR uint8_t *)tail + off, hdr->buf, len);
+          tail->len = off + len;
+          merged = true;
+        }
+    }
+
+  spin_unlock_irqrestore(&queue->ready.lock, flags);
+  return merged;
+}
+#endif
+
 /****************************************************************************
  * Name: rpmsg_port_destroy_queue
  *
@@ -281,6 +331,16 @@ static int rpmsg_port_send_offchannel_nocopy(FAR struct rpmsg_device *rdev,
   hdr->len = sizeof(struct rpmsg_port_header_s) +
              sizeof(struct rpmsg_hdr) + len;
 
+#if CONFIG_RPMSG_PORT_AGGREGATE > 0
+  /* The driver is already notified of the frame the message joins */
+
+  if (rpmsg_port_merge_buffer(&port->txq, hdr))
+    {
+      rpmsg_port_queue_return_buffer(&port->txq, hdr);
+      return len;
+    }
+#endif
+
   rpmsg_port_queue_add_buffer(&port->txq, hdr);
   if (port->ops->notify_tx_ready)
     {
@@ -336,13 +396,28 @@ static void rpmsg_port_release_rx_buffer(FAR struct rpmsg_device *rdev,
   FAR struct rpmsg_port_s *port =
     metal_container_of(rdev, struct rpmsg_port_s, rdev);
   FAR struct rpmsg_hdr *rphdr = RPMSG_LOCATE_HDR(rxbuf);
-  FAR struct rpmsg_port_header_s *hdr =
-    metal_container_of(rphdr, struct rpmsg_port_header_s, buf);
+  FAR struct rpmsg_port_header_s *hdr;
   uint32_t reserved =
     atomic_fetch_sub(&rphdr->reserved, 1 << RPMSG_BUF_HELD_SHIFT);
 
   if ((reserved & RPMSG_BUF_HELD_MASK) == (1 << RPMSG_BUF_HELD_SHIFT))
     {
+#if CONFIG_RPMSG_PORT_AGGREGATE > 0
+      /* The flags of a received message hold its offset in the frame, and
+       * the low bits of the first message's reserved the number of
+       * messages of the frame not released:  The frame goes back to the
+       * rx queue with its last message.
+       */
+
+      rphdr = (FAR struct rpmsg_hdr *)((FAR uint8_t *)rphdr - rphdr->flags);
+      reserved = atomic_fetch_sub(&rphdr->reserved, 1);
+      if ((reserved & ~RPMSG_BUF_HELD_MASK) != 1)
+        {
+          return;
+        }
+#endif
+
+      hdr = metal_container_of(rphdr, struct rpmsg_port_header_s, buf);
       rpmsg_port_queue_return_buffer(&port->rxq, hdr);
       if (port->ops->notify_rx_free)
         {
@@ -395,14 +470,13 @@ static int rpmsg_port_get_rx_buffer_size(FAR struct rpmsg_device *rdev)
 }
 
 /****************************************************************************
- * Name: rpmsg_port_rx_callback
+ * Name: rpmsg_port_rx_message
  ****************************************************************************/
 
-static void rpmsg_port_rx_callback(FAR struct rpmsg_port_s *port,
-                                   FAR struct rpmsg_port_header_s *hdr)
+static void rpmsg_port_rx_message(FAR struct rpmsg_port_s *port,
+                                  FAR struct rpmsg_hdr *rphdr)
 {
   FAR struct rpmsg_device *rdev = &port->rdev;
-  FAR struct rpmsg_hdr *rphdr = (FAR struct rpmsg_hdr *)hdr->buf;
   FAR void *data = RPMSG_LOCATE_DATA(rphdr);
   FAR struct rpmsg_endpoint *ept;
   int status;
@@ -433,6 +507,60 @@ static void rpmsg_port_rx_callback(FAR struct rpmsg_port_s *port,
   metal_mutex_release(&rdev->lock);
 }
 
+/****************************************************************************
+ * Name: rpmsg_port_rx_callback
+ ****************************************************************************/
+
+static void rpmsg_port_rx_callback(FAR struct rpmsg_port_s *port,
+                                   FAR struct rpmsg_port_header_s *hdr)
+{
+#if CONFIG_RPMSG_PORT_AGGREGATE > 0
+  FAR struct rpmsg_hdr *first = (FAR struct rpmsg_hdr *)hdr->buf;
+  FAR struct rpmsg_hdr *rphdr;
+  uint16_t count = 0;
+  uint16_t next;
+  uint16_t off;
+
+  /* Index the messages of the frame before any of them is released */
+
+  for (off = sizeof(*hdr); off + sizeof(*rphdr) <= hdr->len; off = next)
+    {
+      rphdr = (FAR struct rpmsg_hdr *)((FAR uint8_t *)hdr + off);
+      next  = off + sizeof(*rphdr) + rphdr->len;
+      if (next > hdr->len)
+        {
+          break;
+        }
+
+      rphdr->flags = off - sizeof(*hdr);
+      next = ALIGN_UP(next, RPMSG_PORT_AGGREGATE_ALIGN);
+      count++;
+    }
+
+  if (count == 0)
+    {
+      rpmsg_port_queue_return_buffer(&port->rxq, hdr);
+      if (port->ops->notify_rx_free)
+        {
+          port->ops->notify_rx_free(port);
+        }
+
+      return;
+    }
+
+  first->reserved = count;
+  for (off = sizeof(*hdr); count-- > 0; off = next)
+    {
+      rphdr = (FAR struct rpmsg_hdr *)((FAR uint8_t *)hdr + off);
+      next  = ALIGN_UP(off + sizeof(*rphdr) + rphdr->len,
+                       RPMSG_PORT_AGGREGATE_ALIGN);
+      rpmsg_port_rx_message(port, rphdr);
+    }
+#else
+  rpmsg_port_rx_message(port, (FAR struct rpmsg_hdr *)hdr->buf);
+#endif
+}
+
 /****************************************************************************
  * Name: rpmsg_port_ns_callback
  ****************************************************************************/
@@ -25,14 +25,19 @@
 #include <nuttx/config.h>
 
 #include <debug.h>
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
 #include <stdbool.h>
 #include <sys/param.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/mutex.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/queue.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wqueue.h>
 #include <rpmsg/rpmsg_internal.h>
 
 #include "rpmsg_router.h"
@@ -50,21 +55,357 @@
  *
  ****************************************************************************/
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if defined(CONFIG_RPMSG_ROUTER_HUB_BULK_HOLD) && \
+    CONFIG_RPMSG_ROUTER_HUB_BULK_HOLD > 0
+#  define RPMSG_ROUTER_HUB_BULK
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+struct rpmsg_router_hub_s;
+
+/* An endpoint (r:cpu:name) forwarding the messages of an edge core to the
+ * paired endpoint on the other edge core, with its forwarding statistics.
+ * The latency is the time from the reception of a message to the end of
+ * its transmission to the other edge core.
+ */
+
+struct rpmsg_router_hub_ept_s
+{
+  struct rpmsg_endpoint         ept;
+  FAR struct rpmsg_router_hub_s *hub;
+  bool                          bulk;     /* The endpoint is low priority */
+  uint32_t                      count;    /* Messages forwarded */
+  uint32_t                      deferred; /* Messages forwarded by worker */
+  clock_t                       maxlat;   /* The largest latency */
+  uint64_t                      sumlat;   /* The sum of the latencies */
+};
+
+#ifdef RPMSG_ROUTER_HUB_BULK
+
+/* A message of a bulk endpoint waiting for a tx buffer of the other edge
+ * core.  The rx buffer of the message is held until it is forwarded.
+ */
+
+struct rpmsg_router_hub_fwd_s
+{
+  sq_entry_t                        node;
+  FAR struct rpmsg_router_hub_ept_s *ept;
+  FAR void                          *data;
+  size_t                            len;
+  clock_t                           stamp;
+};
+#endif
+
 struct rpmsg_router_hub_s
 {
   struct rpmsg_endpoint ept[2];
   char                  cpuname[2][RPMSG_ROUTER_CPUNAME_LEN];
   mutex_t               lock;
+#ifdef RPMSG_ROUTER_HUB_BULK
+  mutex_t               fwdlock;  /* Held while forwarding the pending */
+  spinlock_t            qlock;    /* Protects pending and freefwd */
+  sq_queue_t            pending;  /* Bulk messages waiting for a buffer */
+  sq_queue_t            freefwd;
+  struct work_s         work;
+  struct rpmsg_router_hub_fwd_s fwd[CONFIG_RPMSG_ROUTER_HUB_BULK_HOLD];
+#endif
 };
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: rpmsg_router_hub_send
+ *
+ * Description:
+ *   Forward a message received by a hub endpoint to the paired endpoint,
+ *   and account for the latency of the message.
+ *
+ ****************************************************************************/
+
+static int rpmsg_router_hub_send(FAR struct rpmsg_router_hub_ept_s *hept,
+                                 FAR void *data, size_t len, clock_t stamp,
+                                 bool wait)
+{
+  FAR struct rpmsg_endpoint *dst_ept = hept->ept.priv;
+  clock_t elapsed;
+  int ret;
+
+  if (wait)
+    {
+      ret = rpmsg_send(dst_ept, data, len);
+    }
+  else
+    {
+      ret = rpmsg_trysend(dst_ept, data, len);
+    }
+
+  if (ret >= 0)
+    {
+      elapsed = perf_gettime() - stamp;
+      hept->maxlat = MAX(hept->maxlat, elapsed);
+      hept->sumlat += elapsed;
+      hept->count++;
+    }
+
+  return ret;
+}
+
+#ifdef RPMSG_ROUTER_HUB_BULK
+
+/****************************************************************************
+ * Name: rpmsg_router_hub_isbulk
+ *
+ * Description:
+ *   Check if the user part of an endpoint name (r:cpu:name) starts with
+ *   one of the prefixes of CONFIG_RPMSG_ROUTER_HUB_BULK_NAMES.
+ *
+ ****************************************************************************/
+
+static bool rpmsg_router_hub_isbulk(FAR const char *name)
+{
+  FAR const char *prefix = CONFIG_RPMSG_ROUTER_HUB_BULK_NAMES;
+  size_t len;
+
+  name = strchr(name + RPMSG_ROUTER_NAME_PREFIX_LEN, ':');
+  if (name == NULL)
+    {
+      return false;
+    }
+
+  name++;
+  while (*prefix != '\0')
+    {
+      len = strcspn(prefix, " ");
+      if (len > 0 && strncmp(name, prefix, len) == 0)
+        {
+          return true;
+        }
+
+      prefix += len;
+      prefix += strspn(prefix, " ");
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: rpmsg_router_hub_forward
+ *
+ * Description:
+ *   Forward the pending bulk messages in order, waiting for the tx buffers.
+ *   A message leaves the pending queue once it is sent, so a new message
+ *   never overtakes it.  The caller holds fwdlock.
+ *
+ ****************************************************************************/
+
+static void rpmsg_router_hub_forward(FAR struct rpmsg_router_hub_s *hub)
+{
+  FAR struct rpmsg_router_hub_fwd_s *fwd;
+  irqstate_t flags;
+  int ret;
+
+  for (; ; )
+    {
+      flags = spin_lock_irqsave(&hub->qlock);
+      fwd = (FAR struct rpmsg_router_hub_fwd_s *)sq_peek(&hub->pending);
+      spin_unlock_irqrestore(&hub->qlock, flags);
+
+      if (fwd == NULL)
+        {
+          break;
+        }
+
+      ret = rpmsg_router_hub_send(fwd->ept, fwd->data, fwd->len,
+                                  fwd->stamp, true);
+      if (ret < 0)
+        {
+          rpmsgerr("Forward %s failed: %d\n", fwd->ept->ept.name, ret);
+        }
+
+      rpmsg_release_rx_buffer(&fwd->ept->ept, fwd->data);
+
+      flags = spin_lock_irqsave(&hub->qlock);
+      sq_remfirst(&hub->pending);
+      sq_addlast(&fwd->node, &hub->freefwd);
+      spin_unlock_irqrestore(&hub->qlock, flags);
+    }
+}
+
+/****************************************************************************
+ * Name: rpmsg_router_hub_worker
+ ****************************************************************************/
+
+static void rpmsg_router_hub_worker(FAR void *arg)
+{
+  FAR struct rpmsg_router_hub_s *hub = arg;
+
+  nxmutex_lock(&hub->fwdlock);
+  rpmsg_router_hub_forward(hub);
+  nxmutex_unlock(&hub->fwdlock);
+}
+
+/****************************************************************************
+ * Name: rpmsg_router_hub_defer
+ *
+ * Description:
+ *   Forward a message of a bulk endpoint without blocking the reception of
+ *   the other endpoints:  If no tx buffer is free, the rx buffer is held
+ *   and the message is forwarded later by the low priority worker, so the
+ *   messages received meanwhile by the other endpoints are forwarded first.
+ *   Only CONFIG_RPMSG_ROUTER_HUB_BULK_HOLD rx buffers are held, beyond that
+ *   the bulk endpoint waits as the other endpoints do.
+ *
+ ****************************************************************************/
+
+static int rpmsg_router_hub_defer(FAR struct rpmsg_router_hub_ept_s *hept,
+                                  FAR void *data, size_t len, clock_t stamp)
+{
+  FAR struct rpmsg_router_hub_s *hub = hept->hub;
+  FAR struct rpmsg_router_hub_fwd_s *fwd;
+  irqstate_t flags;
+  int ret;
+
+  flags = spin_lock_irqsave(&hub->qlock);
+  if (sq_empty(&hub->pending))
+    {
+      spin_unlock_irqrestore(&hub->qlock, flags);
+
+      ret = rpmsg_router_hub_send(hept, data, len, stamp, false);
+      if (ret != RPMSG_ERR_NO_BUFF)
+        {
+          return ret;
+        }
+
+      flags = spin_lock_irqsave(&hub->qlock);
+    }
+
+  fwd = (FAR struct rpmsg_router_hub_fwd_s *)sq_remfirst(&hub->freefwd);
+  spin_unlock_irqrestore(&hub->qlock, flags);
+
+  if (fwd == NULL)
+    {
+      /* Forward the pending messages first to keep the order */
+
+      nxmutex_lock(&hub->fwdlock);
+      rpmsg_router_hub_forward(hub);
+      ret = rpmsg_router_hub_send(hept, data, len, stamp, true);
+      nxmutex_unlock(&hub->fwdlock);
+      return ret;
+    }
+
+  fwd->ept   = hept;
+  fwd->data  = data;
+  fwd->len   = len;
+  fwd->stamp = stamp;
+  rpmsg_hold_rx_buffer(&hept->ept, data);
+
+  flags = spin_lock_irqsave(&hub->qlock);
+  sq_addlast(&fwd->node, &hub->pending);
+  spin_unlock_irqrestore(&hub->qlock, flags);
+
+  hept->deferred++;
+  work_queue(LPWORK, &hub->work, rpmsg_router_hub_worker, hub, 0);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: rpmsg_router_hub_flush
+ *
+ * Description:
+ *   Drop the pending messages of a pair of endpoints before they are
+ *   destroyed, and give their rx buffers back.
+ *
+ ****************************************************************************/
+
+static void rpmsg_router_hub_flush(FAR struct rpmsg_router_hub_s *hub,
+                                   FAR struct rpmsg_endpoint *ept)
+{
+  FAR struct rpmsg_router_hub_fwd_s *fwd;
+  FAR sq_entry_t *prev = NULL;
+  FAR sq_entry_t *node;
+  FAR sq_entry_t *next;
+  sq_queue_t dropped;
+  irqstate_t flags;
+
+  sq_init(&dropped);
+
+  nxmutex_lock(&hub->fwdlock);
+  flags = spin_lock_irqsave(&hub->qlock);
+  for (node = sq_peek(&hub->pending); node != NULL; node = next)
+    {
+      fwd  = (FAR struct rpmsg_router_hub_fwd_s *)node;
+      next = sq_next(node);
+
+      if (&fwd->ept->ept == ept || &fwd->ept->ept == ept->priv)
+        {
+          if (prev == NULL)
+            {
+              sq_remfirst(&hub->pending);
+            }
+          else
+            {
+              sq_remafter(prev, &hub->pending);
+            }
+
+          sq_addlast(node, &dropped);
+        }
+      else
+        {
+          prev = node;
+        }
+    }
+
+  spin_unlock_irqrestore(&hub->qlock, flags);
+
+  while ((fwd = (FAR struct rpmsg_router_hub_fwd_s *)
+                sq_remfirst(&dropped)) != NULL)
+    {
+      rpmsg_release_rx_buffer(&fwd->ept->ept, fwd->data);
+
+      flags = spin_lock_irqsave(&hub->qlock);
+      sq_addlast(&fwd->node, &hub->freefwd);
+      spin_unlock_irqrestore(&hub->qlock, flags);
+    }
+
+  nxmutex_unlock(&hub->fwdlock);
+}
+#endif
+
+/****************************************************************************
+ * Name: rpmsg_router_hub_dump
+ *
+ * Description:
+ *   Print the forwarding statistics of an endpoint.
+ *
+ ****************************************************************************/
+
+static void rpmsg_router_hub_dump(FAR struct rpmsg_router_hub_ept_s *hept)
+{
+  struct timespec max;
+  struct timespec avg;
+
+  perf_convert(hept->maxlat, &max);
+  perf_convert(hept->count ? hept->sumlat / hept->count : 0, &avg);
+
+  rpmsginfo("%s%s: %" PRIu32 " messages, %" PRIu32 " deferred, "
+            "latency avg %lu us max %lu us\n",
+            hept->ept.name, hept->bulk ? " (bulk)" : "", hept->count,
+            hept->deferred,
+            (unsigned long)(avg.tv_sec * USEC_PER_SEC +
+                            avg.tv_nsec / NSEC_PER_USEC),
+            (unsigned long)(max.tv_sec * USEC_PER_SEC +
+                            max.tv_nsec / NSEC_PER_USEC));
+}
+
 /****************************************************************************
  * Name: rpmsg_router_hub_cb
  *
@@ -89,16 +430,25 @@ static int rpmsg_router_hub_cb(FAR struct rpmsg_endpoint *ept,
                                FAR void *data, size_t len,
                                uint32_t src, FAR void *priv)
 {
-  FAR struct rpmsg_endpoint *dst_ept = priv;
+  FAR struct rpmsg_router_hub_ept_s *hept =
+    (FAR struct rpmsg_router_hub_ept_s *)ept;
+  clock_t stamp = perf_gettime();
 
   /* Retransmit data to dest edge core */
 
-  if (!dst_ept)
+  if (!priv)
     {
       return -EINVAL;
     }
 
-  return rpmsg_send(dst_ept, data, len);
+#ifdef RPMSG_ROUTER_HUB_BULK
+  if (hept->bulk)
+    {
+      return rpmsg_router_hub_defer(hept, data, len, stamp);
+    }
+#endif
+
+  return rpmsg_router_hub_send(hept, data, len, stamp, true);
 }
 
 /****************************************************************************
@@ -114,12 +464,21 @@ static int rpmsg_router_hub_cb(FAR struct rpmsg_endpoint *ept,
 
 static void rpmsg_router_hub_unbind(FAR struct rpmsg_endpoint *ept)
 {
+  FAR struct rpmsg_router_hub_ept_s *hept =
+    (FAR struct rpmsg_router_hub_ept_s *)ept;
   FAR struct rpmsg_endpoint *dst_ept = ept->priv;
 
+#ifdef RPMSG_ROUTER_HUB_BULK
+  rpmsg_router_hub_flush(hept->hub, ept);
+#endif
+
+  rpmsg_router_hub_dump(hept);
+
   /* Destroy dest edge ept firstly */
 
   if (dst_ept)
     {
+      rpmsg_router_hub_dump((FAR struct rpmsg_router_hub_ept_s *)dst_ept);
       rpmsg_destroy_ept(dst_ept);
       kmm_free(dst_ept);
     }
@@ -229,6 +588,8 @@ static void rpmsg_router_hub_bind(FAR struct rpmsg_device *rdev,
                                   uint32_t dest)
 {
   FAR struct rpmsg_router_hub_s *hub = priv;
+  FAR struct rpmsg_router_hub_ept_s *src_hept;
+  FAR struct rpmsg_router_hub_ept_s *dst_hept;
   FAR struct rpmsg_endpoint *src_ept;
   FAR struct rpmsg_endpoint *dst_ept;
   FAR struct rpmsg_device *dst_rdev;
@@ -265,10 +626,22 @@ static void rpmsg_router_hub_bind(FAR struct rpmsg_device *rdev,
            name + RPMSG_ROUTER_NAME_PREFIX_LEN +
            strlen(hub->cpuname[1 - i]));
 
-  src_ept = kmm_zalloc(sizeof(*src_ept));
-  dst_ept = kmm_zalloc(sizeof(*dst_ept));
+  src_hept = kmm_zalloc(sizeof(*src_hept));
+  dst_hept = kmm_zalloc(sizeof(*dst_hept));
+
+  DEBUGASSERT(src_hept && dst_hept);
+
+  src_ept = &src_hept->ept;
+  dst_ept = &dst_hept->ept;
+  src_hept->hub = hub;
+  dst_hept->hub = hub;
+
+#ifdef RPMSG_ROUTER_HUB_BULK
+  /* Both directions of a bulk endpoint are low priority */
 
-  DEBUGASSERT(src_ept && dst_ept);
+  src_hept->bulk = rpmsg_router_hub_isbulk(name);
+  dst_hept->bulk = src_hept->bulk;
+#endif
 
   /* Save information for the ept(r:dst_cpu:name) of the source cpu */
 
@@ -287,8 +660,8 @@ static void rpmsg_router_hub_bind(FAR struct rpmsg_device *rdev,
                          rpmsg_router_hub_unbind);
   if (ret < 0)
     {
-      kmm_free(dst_ept);
-      kmm_free(src_ept);
+      kmm_free(dst_hept);
+      kmm_free(src_hept);
     }
 
   nxmutex_unlock(&hub->lock);
@@ -455,6 +828,15 @@ int rpmsg_router_hub_init(FAR const char *edge0,
     }
 
   nxmutex_init(&hub->lock);
+#ifdef RPMSG_ROUTER_HUB_BULK
+  nxmutex_init(&hub->fwdlock);
+  spin_lock_init(&hub->qlock);
+  for (ret = 0; ret < CONFIG_RPMSG_ROUTER_HUB_BULK_HOLD; ret++)
+    {
+      sq_addlast(&hub->fwd[ret].node, &hub->freefwd);
+    }
+#endif
+
   strlcpy(hub->cpuname[0], edge0, sizeof(hub->cpuname[0]));
   strlcpy(hub->cpuname[1], edge1, sizeof(hub->cpuname[1]));
 
@@ -469,6 +851,9 @@ int rpmsg_router_hub_init(FAR const char *edge0,
     {
       rpmsgerr("Register rpmsg callback failed: %d\n", ret);
       nxmutex_destroy(&hub->lock);
+#ifdef RPMSG_ROUTER_HUB_BULK
+      nxmutex_destroy(&hub->fwdlock);
+#endif
       kmm_free(hub);
       return ret;
     }
@@ -101,6 +101,7 @@ struct sensor_user_s
   bool             flushing;   /* The is used to indicate user is flushing */
   sem_t            buffersem;  /* Wakeup user waiting for data in circular buffer */
   size_t           bufferpos;  /* The index of user generation in buffer */
+  uint32_t         watermark;  /* The new samples that wake up the user */
 
   /* The subscriber info
    * Support multi advertisers to subscribe their own data when they
@@ -118,6 +119,9 @@ struct sensor_upperhalf_s
   struct sensor_state_s          state;  /* The state of sensor device */
   struct circbuf_s   timing;             /* The circular buffer of generation */
   struct circbuf_s   buffer;             /* The circular buffer of data */
+#ifdef CONFIG_SENSORS_RING
+  FAR struct sensor_ring_s *ring;        /* The mapped ring of the buffer */
+#endif
   rmutex_t           lock;               /* Manages exclusive access to file operations */
   struct list_node   userlist;           /* List of users */
 };
@@ -136,6 +140,10 @@ static ssize_t sensor_write(FAR struct file *filep, FAR const char *buffer,
                             size_t buflen);
 static int     sensor_ioctl(FAR struct file *filep, int cmd,
                             unsigned long arg);
+#ifdef CONFIG_SENSORS_RING
+static int     sensor_mmap(FAR struct file *filep,
+                           FAR struct mm_map_entry_s *map);
+#endif
 static int     sensor_poll(FAR struct file *filep, FAR struct pollfd *fds,
                            bool setup);
 static ssize_t sensor_push_event(FAR void *priv, FAR const void *data,
@@ -222,7 +230,11 @@ static const struct file_operations g_sensor_fops =
   sensor_write,   /* write */
   NULL,           /* seek  */
   sensor_ioctl,   /* ioctl */
+#ifdef CONFIG_SENSORS_RING
+  sensor_mmap,    /* mmap */
+#else
   NULL,           /* mmap */
+#endif
   NULL,           /* truncate */
   sensor_poll     /* poll  */
 };
@@ -384,6 +396,57 @@ update:
   return ret;
 }
 
+static int sensor_buffer_init(FAR struct sensor_upperhalf_s *upper)
+{
+  FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  FAR void *base = NULL;
+  int ret;
+
+  if (circbuf_is_init(&upper->buffer))
+    {
+      return 0;
+    }
+
+#ifdef CONFIG_SENSORS_RING
+  /* The samples follow the header of the ring that may be mapped */
+
+  upper->ring = kumm_zalloc(sizeof(*upper->ring) +
+                            lower->nbuffer * upper->state.esize);
+  if (upper->ring == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  upper->ring->esize   = upper->state.esize;
+  upper->ring->nbuffer = lower->nbuffer;
+  base = upper->ring + 1;
+#endif
+
+  ret = circbuf_init(&upper->buffer, base, lower->nbuffer *
+                     upper->state.esize);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  ret = circbuf_init(&upper->timing, NULL, lower->nbuffer *
+                     TIMING_BUF_ESIZE);
+  if (ret < 0)
+    {
+      circbuf_uninit(&upper->buffer);
+      goto errout;
+    }
+
+  return 0;
+
+errout:
+#ifdef CONFIG_SENSORS_RING
+  kumm_free(upper->ring);
+  upper->ring = NULL;
+#endif
+  return ret;
+}
+
 static void sensor_generate_timing(FAR struct sensor_upperhalf_s *upper,
                                    unsigned long nums)
 {
@@ -425,6 +488,32 @@ static bool sensor_is_updated(FAR struct sensor_upperhalf_s *upper,
     }
 }
 
+static bool sensor_is_ready(FAR struct sensor_upperhalf_s *upper,
+                            FAR struct sensor_user_s *user)
+{
+  uint32_t interval;
+  long delta;
+
+  if (!sensor_is_updated(upper, user))
+    {
+      return false;
+    }
+  else if (user->watermark <= 1)
+    {
+      return true;
+    }
+
+  /* Each sample advances the generation by min_interval, the user takes
+   * one sample per interval.
+   */
+
+  interval = user->state.interval != UINT32_MAX ? user->state.interval :
+             upper->state.min_interval != UINT32_MAX ?
+             upper->state.min_interval : 1;
+  delta = (long long)upper->state.generation - user->state.generation;
+  return delta / interval >= user->watermark;
+}
+
 static void sensor_catch_up(FAR struct sensor_upperhalf_s *upper,
                             FAR struct sensor_user_s *user)
 {
@@ -960,6 +1049,22 @@ static int sensor_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+     case SNIOC_SET_WATERMARK:
+        {
+          nxrmutex_lock(&upper->lock);
+          if (arg1 > 1 && arg1 > lower->nbuffer)
+            {
+              ret = -EINVAL;
+            }
+          else
+            {
+              user->watermark = arg1;
+            }
+
+          nxrmutex_unlock(&upper->lock);
+        }
+        break;
+
      case SNIOC_FLUSH:
         {
           nxrmutex_lock(&upper->lock);
@@ -1057,7 +1162,7 @@ static int sensor_poll(FAR struct file *filep,
                 }
             }
         }
-      else if (sensor_is_updated(upper, user))
+      else if (sensor_is_ready(upper, user))
         {
           eventset |= POLLIN;
         }
@@ -1080,11 +1185,48 @@ errout:
   return ret;
 }
 
+#ifdef CONFIG_SENSORS_RING
+static int sensor_mmap(FAR struct file *filep,
+                       FAR struct mm_map_entry_s *map)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct sensor_upperhalf_s *upper = inode->i_private;
+  FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  size_t size;
+  int ret;
+
+  /* The samples of a fetch device are not buffered */
+
+  if (lower->ops->fetch)
+    {
+      return -ENOTSUP;
+    }
+
+  nxrmutex_lock(&upper->lock);
+  ret = sensor_buffer_init(upper);
+  if (ret >= 0)
+    {
+      size = sizeof(*upper->ring) + upper->ring->nbuffer *
+             upper->ring->esize;
+      if (map->offset == 0 && map->length > 0 && map->length <= size)
+        {
+          map->vaddr = upper->ring;
+        }
+      else
+        {
+          ret = -EINVAL;
+        }
+    }
+
+  nxrmutex_unlock(&upper->lock);
+  return ret;
+}
+#endif
+
 static ssize_t sensor_push_event(FAR void *priv, FAR const void *data,
                                  size_t bytes)
 {
   FAR struct sensor_upperhalf_s *upper = priv;
-  FAR struct sensor_lowerhalf_s *lower = upper->lower;
   FAR struct sensor_user_s *user;
   unsigned long envcount;
   int semcount;
@@ -1101,6 +1243,13 @@ static ssize_t sensor_push_event(FAR void *priv, FAR const void *data,
               user->flushing = false;
               user->event |= SENSOR_EVENT_FLUSH_COMPLETE;
               sensor_pollnotify_one(user, POLLPRI, user->role);
+
+              /* Hand the samples below the watermark over as well */
+
+              if (sensor_is_updated(upper, user))
+                {
+                  sensor_pollnotify_one(user, POLLIN, SENSOR_ROLE_RD);
+                }
             }
         }
 
@@ -1115,33 +1264,33 @@ static ssize_t sensor_push_event(FAR void *priv, FAR const void *data,
       return -EINVAL;
     }
 
-  if (!circbuf_is_init(&upper->buffer))
+  /* Initialize sensor buffer when data is first generated */
+
+  ret = sensor_buffer_init(upper);
+  if (ret < 0)
     {
-      /* Initialize sensor buffer when data is first generated */
+      nxrmutex_unlock(&upper->lock);
+      return ret;
+    }
 
-      ret = circbuf_init(&upper->buffer, NULL, lower->nbuffer *
-                         upper->state.esize);
-      if (ret < 0)
-        {
-          nxrmutex_unlock(&upper->lock);
-          return ret;
-        }
+#ifdef CONFIG_SENSORS_RING
+  /* Tell the readers of the ring which samples are overwritten */
 
-      ret = circbuf_init(&upper->timing, NULL, lower->nbuffer *
-                         TIMING_BUF_ESIZE);
-      if (ret < 0)
-        {
-          circbuf_uninit(&upper->buffer);
-          nxrmutex_unlock(&upper->lock);
-          return ret;
-        }
-    }
+  upper->ring->wpos = upper->ring->head + envcount;
+  SP_DMB();
+#endif
 
   circbuf_overwrite(&upper->buffer, data, bytes);
+
+#ifdef CONFIG_SENSORS_RING
+  SP_DMB();
+  upper->ring->head = upper->ring->wpos;
+#endif
+
   sensor_generate_timing(upper, envcount);
   list_for_every_entry(&upper->userlist, user, struct sensor_user_s, node)
     {
-      if (sensor_is_updated(upper, user))
+      if (sensor_is_ready(upper, user))
         {
           nxsem_get_value(&user->buffersem, &semcount);
           if (semcount < 1)
@@ -1212,6 +1361,34 @@ void sensor_remap_vector_raw16(FAR const int16_t *in, FAR int16_t *out,
   memcpy(out, tmp, sizeof(tmp));
 }
 
+/****************************************************************************
+ * Name: sensor_push_batch
+ *
+ * Description:
+ *   Push the 'nums' samples read at once from a hardware FIFO:  The
+ *   timestamps of the samples are derived from the timestamp of the newest
+ *   one and the sampling interval, then all the samples are copied and the
+ *   subscribers woken up once.
+ *
+ ****************************************************************************/
+
+ssize_t sensor_push_batch(FAR struct sensor_lowerhalf_s *lower,
+                          FAR void *data, size_t esize, size_t nums,
+                          uint64_t timestamp, uint32_t interval)
+{
+  FAR uint8_t *event = data;
+  size_t i;
+
+  for (i = 0; i < nums; i++)
+    {
+      uint64_t ts = timestamp - (uint64_t)(nums - 1 - i) * interval;
+
+      memcpy(event + i * esize, &ts, sizeof(ts));
+    }
+
+  return lower->push_event(lower->priv, data, esize * nums);
+}
+
 /****************************************************************************
  * Name: sensor_register
  *
@@ -1441,6 +1618,9 @@ void sensor_custom_unregister(FAR struct sensor_lowerhalf_s *lower,
     {
       circbuf_uninit(&upper->buffer);
       circbuf_uninit(&upper->timing);
+#ifdef CONFIG_SENSORS_RING
+      kumm_free(upper->ring);
+#endif
     }
 
   kmm_free(upper);
@@ -525,7 +525,7 @@ void sensor_rpmsg_push_event_persist(FAR struct sensor_rpmsg_dev_s *dev,
   int ret;
 
   sre = container_of(stub->ept, struct sensor_rpmsg_ept_s, ept);
-  msg = rpmsg_get_tx_payload_buffer(&sre->ept, &space, true);
+  msg = rpmsg_reserve(&sre->ept, NULL, &space);
   if (!msg)
     {
       snerr("ERROR: push event persist get buffer failed:%s\n",
@@ -542,8 +542,8 @@ void sensor_rpmsg_push_event_persist(FAR struct sensor_rpmsg_dev_s *dev,
       cell->len     = ret;
       cell->cookie  = stub->cookie;
       cell->nbuffer = dev->lower.nbuffer;
-      rpmsg_send_nocopy(&sre->ept, msg, sizeof(*msg) +
-                        ((sizeof(*cell) + ret + 0x7) & ~0x7));
+      rpmsg_commit(&sre->ept, msg, sizeof(*msg) +
+                   ((sizeof(*cell) + ret + 0x7) & ~0x7));
     }
   else
     {
@@ -810,10 +810,9 @@ static void sensor_rpmsg_data_worker(FAR void *arg)
   nxrmutex_lock(&sre->lock);
   if (sre->buffer)
     {
-      ret = rpmsg_send_nocopy(&sre->ept, sre->buffer, sre->written);
+      ret = rpmsg_commit(&sre->ept, sre->buffer, sre->written);
       if (ret < 0)
         {
-          rpmsg_release_tx_buffer(&sre->ept, sre->buffer);
           snerr("ERROR: push event rpmsg send failed:%d, %s\n",
                 ret, rpmsg_get_cpuname(sre->ept.rdev));
         }
@@ -832,6 +831,7 @@ static void sensor_rpmsg_push_event_one(FAR struct sensor_rpmsg_dev_s *dev,
   FAR struct sensor_rpmsg_ept_s *sre;
   FAR struct sensor_rpmsg_data_s *msg;
   struct sensor_ustate_s state;
+  uint32_t delay;
   uint64_t now;
   bool updated;
   int ret;
@@ -849,6 +849,20 @@ static void sensor_rpmsg_push_event_one(FAR struct sensor_rpmsg_dev_s *dev,
       state.interval = 0;
     }
 
+  /* The samples of all the topics of the endpoint are coalesced in one
+   * buffer:  It waits for more samples up to the batch latency of the
+   * remote subscriber, or half of its interval if it doesn't batch.
+   */
+
+  delay = state.latency != 0 && state.latency != UINT32_MAX ?
+          state.latency : state.interval / 2;
+#if CONFIG_SENSORS_RPMSG_MAX_LATENCY > 0
+  if (delay > CONFIG_SENSORS_RPMSG_MAX_LATENCY)
+    {
+      delay = CONFIG_SENSORS_RPMSG_MAX_LATENCY;
+    }
+#endif
+
   sre = container_of(stub->ept, struct sensor_rpmsg_ept_s, ept);
   nxrmutex_lock(&sre->lock);
 
@@ -876,11 +890,17 @@ static void sensor_rpmsg_push_event_one(FAR struct sensor_rpmsg_dev_s *dev,
         {
           if (sre->buffer)
             {
-              rpmsg_send_nocopy(&sre->ept, sre->buffer, sre->written);
+              ret = rpmsg_commit(&sre->ept, sre->buffer, sre->written);
+              if (ret < 0)
+                {
+                  snerr("ERROR: push event rpmsg send failed:%d, %s\n",
+                        ret, rpmsg_get_cpuname(sre->ept.rdev));
+                }
+
               sre->buffer = NULL;
             }
 
-          msg = rpmsg_get_tx_payload_buffer(&sre->ept, &sre->space, true);
+          msg = rpmsg_reserve(&sre->ept, NULL, &sre->space);
           sre->buffer = msg;
           if (!msg)
             {
@@ -898,8 +918,11 @@ static void sensor_rpmsg_push_event_one(FAR struct sensor_rpmsg_dev_s *dev,
       cell = sre->buffer + sre->written;
       if (flushed)
         {
+          /* The flush completion is not delayed */
+
           flushed = false;
           stub->flushing = false;
+          sre->expire = 0;
         }
       else
         {
@@ -925,10 +948,9 @@ static void sensor_rpmsg_push_event_one(FAR struct sensor_rpmsg_dev_s *dev,
   now = sensor_get_timestamp();
   if (sre->expire <= now && sre->buffer)
     {
-      ret = rpmsg_send_nocopy(&sre->ept, sre->buffer, sre->written);
+      ret = rpmsg_commit(&sre->ept, sre->buffer, sre->written);
       if (ret < 0)
         {
-          rpmsg_release_tx_buffer(&sre->ept, sre->buffer);
           snerr("ERROR: push event rpmsg send failed:%d, %s\n",
                 ret, rpmsg_get_cpuname(sre->ept.rdev));
         }
@@ -937,10 +959,9 @@ static void sensor_rpmsg_push_event_one(FAR struct sensor_rpmsg_dev_s *dev,
     }
   else
     {
-      if (sre->expire == UINT64_MAX ||
-          sre->expire - now > state.interval / 2)
+      if (sre->expire == UINT64_MAX || sre->expire - now > delay)
         {
-          sre->expire = now + state.interval / 2;
+          sre->expire = now + delay;
         }
 
       work_queue(HPWORK, &sre->work, sensor_rpmsg_data_worker, sre,
@@ -117,6 +117,10 @@ static int     uart_ioctl(FAR struct file *filep,
                           int cmd, unsigned long arg);
 static int     uart_poll(FAR struct file *filep,
                          FAR struct pollfd *fds, bool setup);
+#ifdef CONFIG_SERIAL_RXINPLACE
+static int     uart_mmap(FAR struct file *filep,
+                         FAR struct mm_map_entry_s *map);
+#endif
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
 static int     uart_unlink(FAR struct inode *inode);
 #endif
@@ -143,7 +147,11 @@ static const struct file_operations g_serialops =
   uart_write,   /* write */
   NULL,         /* seek */
   uart_ioctl,   /* ioctl */
+#ifdef CONFIG_SERIAL_RXINPLACE
+  uart_mmap,    /* mmap */
+#else
   NULL,         /* mmap */
+#endif
   NULL,         /* truncate */
   uart_poll     /* poll */
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
@@ -1600,6 +1608,130 @@ static int uart_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
             }
             break;
 
+#ifdef CONFIG_SERIAL_RXINPLACE
+          /* Get where the received data is in the mapping of the receive
+           * buffer
+           */
+
+          case TIOCRXPEEK:
+            {
+              FAR struct serial_rxwindow_s *window =
+                (FAR struct serial_rxwindow_s *)((uintptr_t)arg);
+              irqstate_t flags;
+
+              if (window == NULL)
+                {
+                  ret = -EINVAL;
+                  break;
+                }
+
+              flags = enter_critical_section();
+
+              window->offset = dev->recv.tail;
+              if (dev->recv.tail <= dev->recv.head)
+                {
+                  window->length    = dev->recv.head - dev->recv.tail;
+                  window->nbuffered = window->length;
+                }
+              else
+                {
+                  window->length    = dev->recv.size - dev->recv.tail;
+                  window->nbuffered = window->length + dev->recv.head;
+                }
+
+              window->size = dev->recv.size;
+              leave_critical_section(flags);
+              ret = 0;
+            }
+            break;
+
+          /* Release the received data read in the mapping */
+
+          case TIOCRXCONSUME:
+            {
+              size_t nbytes = (size_t)arg;
+              size_t nbuffered;
+              irqstate_t flags;
+
+              ret = nxmutex_lock(&dev->recv.lock);
+              if (ret < 0)
+                {
+                  break;
+                }
+
+              flags = enter_critical_section();
+
+              if (dev->recv.tail <= dev->recv.head)
+                {
+                  nbuffered = dev->recv.head - dev->recv.tail;
+                }
+              else
+                {
+                  nbuffered = dev->recv.size - dev->recv.tail +
+                              dev->recv.head;
+                }
+
+              if (nbytes > nbuffered)
+                {
+                  leave_critical_section(flags);
+                  nxmutex_unlock(&dev->recv.lock);
+                  ret = -EINVAL;
+                  break;
+                }
+
+              dev->recv.tail = (dev->recv.tail + nbytes) % dev->recv.size;
+              nbuffered -= nbytes;
+
+              /* Notify DMA that there is free space in the RX buffer */
+
+              uart_dmarxfree(dev);
+              leave_critical_section(flags);
+
+              /* RX interrupt could be disabled by RX buffer overflow */
+
+              uart_enablerxint(dev);
+
+#ifdef CONFIG_SERIAL_IFLOWCONTROL
+#  ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
+              if (nbuffered <= (CONFIG_SERIAL_IFLOWCONTROL_LOWER_WATERMARK *
+                                dev->recv.size) / 100)
+#  else
+              if (nbuffered == 0)
+#  endif
+                {
+                  uart_rxflowcontrol(dev, nbuffered, false);
+                }
+#endif
+
+              nxmutex_unlock(&dev->recv.lock);
+            }
+            break;
+
+          /* Set and get the number of received bytes that wake up the
+           * readers, zero to wake them up at each DMA transfer
+           */
+
+          case TIOCSRXWATERMARK:
+            {
+              if ((int)arg < 0 || (int)arg >= dev->recv.size)
+                {
+                  ret = -EINVAL;
+                  break;
+                }
+
+              dev->rxwatermark = (int)arg;
+              ret = 0;
+            }
+            break;
+
+          case TIOCGRXWATERMARK:
+            {
+              *(FAR int *)((uintptr_t)arg) = dev->rxwatermark;
+              ret = 0;
+            }
+            break;
+#endif
+
           case TCFLSH:
             {
               /* Empty the tx/rx buffers */
@@ -1737,6 +1869,31 @@ static int uart_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
   return ret;
 }
 
+/****************************************************************************
+ * Name: uart_mmap
+ *
+ * Description:
+ *   Map the receive buffer, for TIOCRXPEEK and TIOCRXCONSUME.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SERIAL_RXINPLACE
+static int uart_mmap(FAR struct file *filep, FAR struct mm_map_entry_s *map)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR uart_dev_t   *dev   = inode->i_private;
+
+  if (map->offset >= 0 && map->offset < dev->recv.size &&
+      map->length && map->offset + map->length <= dev->recv.size)
+    {
+      map->vaddr = dev->recv.buffer + map->offset;
+      return OK;
+    }
+
+  return -EINVAL;
+}
+#endif
+
 /****************************************************************************
  * Name: uart_poll
  ****************************************************************************/
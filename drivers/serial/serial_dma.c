@@ -307,6 +307,10 @@ void uart_recvchars_done(FAR uart_dev_t *dev)
   FAR struct uart_dmaxfer_s *xfer = &dev->dmarx;
   FAR struct uart_buffer_s *rxbuf = &dev->recv;
   size_t nbytes = xfer->nbytes;
+  bool wakeup;
+#ifdef CONFIG_SERIAL_RXINPLACE
+  bool idle = nbytes < xfer->length + xfer->nlength;
+#endif
 #if defined(CONFIG_TTY_SIGINT) || defined(CONFIG_TTY_SIGTSTP) || \
     defined(CONFIG_TTY_FORCE_PANIC) || defined(CONFIG_TTY_LAUNCH)
   int signo = 0;
@@ -337,11 +341,26 @@ void uart_recvchars_done(FAR uart_dev_t *dev)
       nbytes = rxbuf->size - rxbuf->tail + rxbuf->head;
     }
 
+#ifdef CONFIG_SERIAL_RXINPLACE
+  if (dev->rxwatermark > 0)
+    {
+      /* Wake up at the high-water mark or at the end of a burst:  The
+       * transfer stopped short on an idle line.
+       */
+
+      wakeup = nbytes >= dev->rxwatermark || (idle && nbytes > 0);
+    }
+  else
+#endif
+    {
 #ifdef CONFIG_SERIAL_TERMIOS
-  if (nbytes >= dev->minrecv)
+      wakeup = nbytes >= dev->minrecv;
 #else
-  if (nbytes)
+      wakeup = nbytes > 0;
 #endif
+    }
+
+  if (wakeup)
     {
       uart_datareceived(dev);
     }
@@ -27,7 +27,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/mutex.h>
 #include <nuttx/semaphore.h>
-#include <nuttx/circbuf.h>
+#include <nuttx/lfcircbuf.h>
 
 #include <fcntl.h>
 #include <string.h>
@@ -53,9 +53,10 @@ struct uart_bth4_s
 {
   FAR struct bt_driver_s *drv;
 
-  FAR struct circbuf_s    circbuf;
+  struct lfcircbuf_s      circbuf;
 
   sem_t                   recvsem;
+  mutex_t                 recvlock;
 
   uint8_t                 sendbuf[CONFIG_UART_BTH4_TXBUFSIZE];
   size_t                  sendlen;
@@ -129,46 +130,53 @@ static int uart_bth4_receive(FAR struct bt_driver_s *drv,
                              FAR void *buffer, size_t buflen)
 {
   FAR struct uart_bth4_s *dev = drv->priv;
-  int ret = buflen;
+  unsigned int pos;
   irqstate_t flags;
   uint8_t htype;
+  int ret;
 
-  flags = enter_critical_section();
-
-  if (circbuf_space(&dev->circbuf) >=
-      buflen + H4_HEADER_SIZE)
+  if (type == BT_EVT)
     {
-      if (type == BT_EVT)
-        {
-          htype = H4_EVT;
-        }
-      else if (type == BT_ACL_IN)
-        {
-          htype = H4_ACL;
-        }
-      else if (type == BT_ISO_IN)
-        {
-          htype = H4_ISO;
-        }
-      else
-        {
-          ret = -EINVAL;
-        }
-
-      if (ret >= 0)
-        {
-          circbuf_write(&dev->circbuf, &htype, H4_HEADER_SIZE);
-          circbuf_write(&dev->circbuf, buffer, buflen);
-          uart_bth4_pollnotify(dev, POLLIN);
-        }
+      htype = H4_EVT;
+    }
+  else if (type == BT_ACL_IN)
+    {
+      htype = H4_ACL;
+    }
+  else if (type == BT_ISO_IN)
+    {
+      htype = H4_ISO;
     }
   else
     {
-      ret = -ENOMEM;
+      return -EINVAL;
     }
 
+  /* The header and the packet are committed together so that a reader
+   * never sees a partial packet.  Only the local interrupts are disabled:
+   * this keeps another producer on this CPU from waiting for our commit.
+   */
+
+  flags = up_irq_save();
+  ret = lfcircbuf_reserve(&dev->circbuf, buflen + H4_HEADER_SIZE, &pos);
+  if (ret >= 0)
+    {
+      lfcircbuf_copyin(&dev->circbuf, pos, 0, &htype, H4_HEADER_SIZE);
+      lfcircbuf_copyin(&dev->circbuf, pos, H4_HEADER_SIZE, buffer, buflen);
+      lfcircbuf_commit(&dev->circbuf, pos, buflen + H4_HEADER_SIZE);
+    }
+
+  up_irq_restore(flags);
+
+  if (ret < 0)
+    {
+      return -ENOMEM;
+    }
+
+  flags = enter_critical_section();
+  uart_bth4_pollnotify(dev, POLLIN);
   leave_critical_section(flags);
-  return ret;
+  return buflen;
 }
 
 static int uart_bth4_open(FAR struct file *filep)
@@ -236,26 +244,32 @@ static ssize_t uart_bth4_read(FAR struct file *filep,
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct uart_bth4_s *dev = inode->i_private;
-  irqstate_t flags;
   ssize_t nread;
 
-  flags = enter_critical_section();
+  /* The receive buffer has a single consumer, serialize the readers */
+
+  nread = nxmutex_lock(&dev->recvlock);
+  if (nread < 0)
+    {
+      return nread;
+    }
 
   for (; ; )
     {
-      nread = circbuf_read(&dev->circbuf, buffer, buflen);
+      nread = lfcircbuf_read(&dev->circbuf, buffer, buflen);
       if (nread != 0 || (filep->f_oflags & O_NONBLOCK))
         {
           break;
         }
 
-      while (circbuf_is_empty(&dev->circbuf))
-        {
-          nxsem_wait_uninterruptible(&dev->recvsem);
-        }
+      /* The producer posts after each commit, so a packet that arrives
+       * after the buffer was found empty is not missed.
+       */
+
+      nxsem_wait_uninterruptible(&dev->recvsem);
     }
 
-  leave_critical_section(flags);
+  nxmutex_unlock(&dev->recvlock);
   return nread;
 }
 
@@ -415,7 +429,7 @@ static int uart_bth4_poll(FAR struct file *filep, FAR struct pollfd *fds,
           ret = -EBUSY;
         }
 
-      if (!circbuf_is_empty(&dev->circbuf))
+      if (!lfcircbuf_is_empty(&dev->circbuf))
         {
           eventset |= POLLIN;
         }
@@ -457,8 +471,8 @@ int uart_bth4_register(FAR const char *path, FAR struct bt_driver_s *drv)
       return -ENOMEM;
     }
 
-  ret = circbuf_init(&dev->circbuf, NULL,
-                     CONFIG_UART_BTH4_RXBUFSIZE);
+  ret = lfcircbuf_init(&dev->circbuf, NULL,
+                       CONFIG_UART_BTH4_RXBUFSIZE);
   if (ret < 0)
     {
       kmm_free(dev);
@@ -471,6 +485,7 @@ int uart_bth4_register(FAR const char *path, FAR struct bt_driver_s *drv)
 
   nxmutex_init(&dev->sendlock);
   nxmutex_init(&dev->openlock);
+  nxmutex_init(&dev->recvlock);
   nxsem_init(&dev->recvsem, 0, 0);
 
   ret = register_driver(path, &g_uart_bth4_ops, 0666, dev);
@@ -478,8 +493,9 @@ int uart_bth4_register(FAR const char *path, FAR struct bt_driver_s *drv)
     {
       nxmutex_destroy(&dev->sendlock);
       nxmutex_destroy(&dev->openlock);
+      nxmutex_destroy(&dev->recvlock);
       nxsem_destroy(&dev->recvsem);
-      circbuf_uninit(&dev->circbuf);
+      lfcircbuf_uninit(&dev->circbuf);
       kmm_free(dev);
     }
 
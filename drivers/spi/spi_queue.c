@@ -0,0 +1,366 @@
+/****************************************************************************
+ * drivers/spi/spi_queue.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <nuttx/kthread.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spi/spi.h>
+#include <nuttx/spi/spi_queue.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The states of a message */
+
+#define SPI_MSG_IDLE     0
+#define SPI_MSG_PENDING  1
+#define SPI_MSG_RUNNING  2
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of spi_queue_transfer() */
+
+struct spi_queue_wait_s
+{
+  struct spi_msg_s msg;
+  sem_t            done;
+  int              result;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spi_queue_next
+ *
+ * Description:
+ *   Take the next message to perform:  The first pending message for the
+ *   device held selected, if any, or else the message of the highest
+ *   priority.
+ *
+ ****************************************************************************/
+
+static FAR struct spi_msg_s *spi_queue_next(FAR struct spi_queue_s *queue)
+{
+  FAR struct spi_msg_s *msg;
+  FAR dq_entry_t *entry;
+
+  for (entry = dq_peek(&queue->pending); entry != NULL;
+       entry = dq_next(entry))
+    {
+      msg = container_of(entry, struct spi_msg_s, node);
+      if (!queue->cshold || msg->seq->dev == queue->csdev)
+        {
+          dq_rem(entry, &queue->pending);
+          msg->state = SPI_MSG_RUNNING;
+          return msg;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: spi_queue_thread
+ *
+ * Description:
+ *   Perform the messages of a queue.  The bus is locked once for all the
+ *   messages that are pending, and while a device is held selected.
+ *
+ ****************************************************************************/
+
+static int spi_queue_thread(int argc, FAR char *argv[])
+{
+  FAR struct spi_queue_s *queue =
+    (FAR struct spi_queue_s *)((uintptr_t)strtoul(argv[1], NULL, 16));
+  FAR struct spi_dev_s *spi = queue->spi;
+  FAR struct spi_msg_s *msg;
+  irqstate_t flags;
+  bool locked = false;
+  int ret;
+
+  for (; ; )
+    {
+      flags = spin_lock_irqsave(&queue->lock);
+      msg = spi_queue_next(queue);
+      if (msg == NULL)
+        {
+          bool stop = queue->stop;
+
+          spin_unlock_irqrestore(&queue->lock, flags);
+
+          if (stop)
+            {
+              break;
+            }
+
+          /* Let the other users of the bus in while the queue is empty */
+
+          if (locked && !queue->cshold)
+            {
+              SPI_LOCK(spi, false);
+              locked = false;
+            }
+
+          nxsem_wait_uninterruptible(&queue->wake);
+          continue;
+        }
+
+      spin_unlock_irqrestore(&queue->lock, flags);
+
+      if (!locked)
+        {
+          SPI_LOCK(spi, true);
+          locked = true;
+        }
+
+      ret = spi_transfer_locked(spi, msg->seq,
+                                (msg->flags & SPI_MSG_KEEPCS) != 0);
+
+      queue->csdev  = msg->seq->dev;
+      queue->cshold = ret >= 0 && (msg->flags & SPI_MSG_KEEPCS) != 0;
+      msg->state    = SPI_MSG_IDLE;
+
+      if (msg->complete != NULL)
+        {
+          msg->complete(msg, ret);
+        }
+    }
+
+  if (queue->cshold)
+    {
+      SPI_SELECT(spi, queue->csdev, false);
+      queue->cshold = false;
+    }
+
+  if (locked)
+    {
+      SPI_LOCK(spi, false);
+    }
+
+  nxsem_post(&queue->exit);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: spi_queue_wakeup
+ ****************************************************************************/
+
+static void spi_queue_wakeup(FAR struct spi_msg_s *msg, int result)
+{
+  FAR struct spi_queue_wait_s *wait = msg->arg;
+
+  wait->result = result;
+  nxsem_post(&wait->done);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spi_queue_initialize
+ ****************************************************************************/
+
+int spi_queue_initialize(FAR struct spi_queue_s *queue,
+                         FAR struct spi_dev_s *spi)
+{
+  FAR char *argv[2];
+  char arg1[32];
+  int ret;
+
+  DEBUGASSERT(queue != NULL && spi != NULL);
+
+  queue->spi    = spi;
+  queue->cshold = false;
+  queue->stop   = false;
+  spin_lock_init(&queue->lock);
+  dq_init(&queue->pending);
+  nxsem_init(&queue->wake, 0, 0);
+  nxsem_init(&queue->exit, 0, 0);
+
+  snprintf(arg1, sizeof(arg1), "%p", queue);
+  argv[0] = arg1;
+  argv[1] = NULL;
+
+  ret = kthread_create("spiq", CONFIG_SPI_QUEUE_PRIORITY,
+                       CONFIG_SPI_QUEUE_STACKSIZE, spi_queue_thread, argv);
+  if (ret < 0)
+    {
+      spierr("ERROR: Failed to start the SPI queue: %d\n", ret);
+      nxsem_destroy(&queue->wake);
+      nxsem_destroy(&queue->exit);
+      return ret;
+    }
+
+  queue->pid = ret;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: spi_queue_uninitialize
+ ****************************************************************************/
+
+int spi_queue_uninitialize(FAR struct spi_queue_s *queue)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&queue->lock);
+  if (!dq_empty(&queue->pending))
+    {
+      spin_unlock_irqrestore(&queue->lock, flags);
+      return -EBUSY;
+    }
+
+  queue->stop = true;
+  spin_unlock_irqrestore(&queue->lock, flags);
+
+  nxsem_post(&queue->wake);
+  nxsem_wait_uninterruptible(&queue->exit);
+
+  nxsem_destroy(&queue->wake);
+  nxsem_destroy(&queue->exit);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: spi_queue_submit
+ ****************************************************************************/
+
+int spi_queue_submit(FAR struct spi_queue_s *queue,
+                     FAR struct spi_msg_s *msg)
+{
+  FAR dq_entry_t *entry;
+  irqstate_t flags;
+
+  DEBUGASSERT(queue != NULL && msg != NULL && msg->seq != NULL);
+
+  if (msg->state != SPI_MSG_IDLE)
+    {
+      return -EBUSY;
+    }
+
+  flags = spin_lock_irqsave(&queue->lock);
+
+  if (queue->stop)
+    {
+      spin_unlock_irqrestore(&queue->lock, flags);
+      return -ESHUTDOWN;
+    }
+
+  /* Insert the message after those of the same or a higher priority */
+
+  for (entry = dq_tail(&queue->pending); entry != NULL;
+       entry = dq_prev(entry))
+    {
+      if (container_of(entry, struct spi_msg_s, node)->priority >=
+          msg->priority)
+        {
+          break;
+        }
+    }
+
+  if (entry != NULL)
+    {
+      dq_addafter(entry, &msg->node, &queue->pending);
+    }
+  else
+    {
+      dq_addfirst(&msg->node, &queue->pending);
+    }
+
+  msg->state = SPI_MSG_PENDING;
+  spin_unlock_irqrestore(&queue->lock, flags);
+
+  nxsem_post(&queue->wake);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: spi_queue_cancel
+ ****************************************************************************/
+
+int spi_queue_cancel(FAR struct spi_queue_s *queue,
+                     FAR struct spi_msg_s *msg)
+{
+  irqstate_t flags;
+  int ret = OK;
+
+  flags = spin_lock_irqsave(&queue->lock);
+  if (msg->state == SPI_MSG_PENDING)
+    {
+      dq_rem(&msg->node, &queue->pending);
+      msg->state = SPI_MSG_IDLE;
+    }
+  else if (msg->state == SPI_MSG_RUNNING)
+    {
+      ret = -EBUSY;
+    }
+
+  spin_unlock_irqrestore(&queue->lock, flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: spi_queue_transfer
+ ****************************************************************************/
+
+int spi_queue_transfer(FAR struct spi_queue_s *queue,
+                       FAR struct spi_sequence_s *seq, uint8_t priority)
+{
+  struct spi_queue_wait_s wait;
+  int ret;
+
+  wait.msg.seq      = seq;
+  wait.msg.complete = spi_queue_wakeup;
+  wait.msg.arg      = &wait;
+  wait.msg.priority = priority;
+  wait.msg.flags    = 0;
+  wait.msg.state    = SPI_MSG_IDLE;
+  nxsem_init(&wait.done, 0, 0);
+
+  ret = spi_queue_submit(queue, &wait.msg);
+  if (ret >= 0)
+    {
+      nxsem_wait_uninterruptible(&wait.done);
+      ret = wait.result;
+    }
+
+  nxsem_destroy(&wait.done);
+  return ret;
+}
@@ -33,39 +33,93 @@
 #include <nuttx/spi/spi.h>
 #include <nuttx/spi/spi_transfer.h>
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spi_contiguous
+ *
+ * Description:
+ *   Return true if 'next' continues in memory the 'nwords' words of the
+ *   transfers from 'first' to 'last' with the same attributes, so that all
+ *   are performed by a single exchange (a single DMA transfer for the lower
+ *   halves that use DMA).
+ *
+ ****************************************************************************/
+
+static bool spi_contiguous(FAR const struct spi_trans_s *first,
+                           FAR const struct spi_trans_s *last,
+                           FAR const struct spi_trans_s *next,
+                           size_t nwords, size_t width)
+{
+  if (last->deselect || last->delay > 0)
+    {
+      return false;
+    }
+
+#ifdef CONFIG_SPI_CMDDATA
+  if (first->cmd != next->cmd)
+    {
+      return false;
+    }
+#endif
+
+#ifdef CONFIG_SPI_HWFEATURES
+  if (first->hwfeat != next->hwfeat)
+    {
+      return false;
+    }
+#endif
+
+  if ((first->txbuffer == NULL) != (next->txbuffer == NULL) ||
+      (first->rxbuffer == NULL) != (next->rxbuffer == NULL))
+    {
+      return false;
+    }
+
+  return (first->txbuffer == NULL ||
+          (FAR const uint8_t *)first->txbuffer + nwords * width ==
+          next->txbuffer) &&
+         (first->rxbuffer == NULL ||
+          (FAR uint8_t *)first->rxbuffer + nwords * width ==
+          next->rxbuffer);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: spi_transfer
+ * Name: spi_transfer_locked
  *
  * Description:
- *   This is a helper function that can be used to encapsulate and manage
- *   a sequence of SPI transfers.  The SPI bus will be locked and the
- *   SPI device selected for the duration of the transfers.
+ *   Perform a sequence of SPI transfers on a bus that the caller locked.
+ *   The transfers that continue each other in memory are coalesced into a
+ *   single exchange.
  *
  * Input Parameters:
- *   spi - An instance of the SPI device to use for the transfer
- *   seq - Describes the sequence of transfers.
+ *   spi    - An instance of the SPI device to use for the transfer
+ *   seq    - Describes the sequence of transfers.
+ *   keepcs - Leave the device selected at the end of the sequence.
  *
  * Returned Value:
  *   Zero (OK) on success; a negated errno value on failure.
  *
  ****************************************************************************/
 
-int spi_transfer(FAR struct spi_dev_s *spi, FAR struct spi_sequence_s *seq)
+int spi_transfer_locked(FAR struct spi_dev_s *spi,
+                        FAR struct spi_sequence_s *seq, bool keepcs)
 {
   FAR struct spi_trans_s *trans;
+  FAR struct spi_trans_s *first;
+  size_t nwords;
+  size_t width;
   int ret = OK;
   int i;
 
   DEBUGASSERT(spi != NULL && seq != NULL && seq->trans != NULL);
 
-  /* Get exclusive access to the SPI bus */
-
-  SPI_LOCK(spi, true);
-
   /* Establish the fixed SPI attributes for all transfers in the sequence */
 
   SPI_SETFREQUENCY(spi, seq->frequency);
@@ -75,7 +129,6 @@ int spi_transfer(FAR struct spi_dev_s *spi, FAR struct spi_sequence_s *seq)
   if (ret < 0)
     {
       spierr("ERROR: SPI_SETDELAY failed: %d\n", ret);
-      SPI_LOCK(spi, false);
       return ret;
     }
 #endif
@@ -83,6 +136,8 @@ int spi_transfer(FAR struct spi_dev_s *spi, FAR struct spi_sequence_s *seq)
   SPI_SETMODE(spi, (enum spi_mode_e)seq->mode);
   SPI_SETBITS(spi, seq->nbits);
 
+  width = seq->nbits <= 8 ? 1 : seq->nbits <= 16 ? 2 : 4;
+
   /* Select the SPI device in preparation for the transfer.
    * REVISIT: This is redundant.
    */
@@ -113,13 +168,25 @@ int spi_transfer(FAR struct spi_dev_s *spi, FAR struct spi_sequence_s *seq)
         }
 #endif
 
+      /* Extend the transfer with the following ones that continue it */
+
+      first  = trans;
+      nwords = trans->nwords;
+      while (i + 1 < (int)seq->ntrans &&
+             spi_contiguous(first, trans, trans + 1, nwords, width))
+        {
+          trans++;
+          i++;
+          nwords += trans->nwords;
+        }
+
       /* [Re-]select the SPI device in preparation for the transfer */
 
       SPI_SELECT(spi, seq->dev, true);
 
       /* Perform the transfer */
 
-      SPI_EXCHANGE(spi, trans->txbuffer, trans->rxbuffer, trans->nwords);
+      SPI_EXCHANGE(spi, first->txbuffer, first->rxbuffer, nwords);
 
       /* Possibly de-select the SPI device after the transfer */
 
@@ -136,8 +203,41 @@ int spi_transfer(FAR struct spi_dev_s *spi, FAR struct spi_sequence_s *seq)
         }
     }
 
-  SPI_SELECT(spi, seq->dev, false);
-  SPI_LOCK(spi, false);
+  if (!keepcs || ret < 0)
+    {
+      SPI_SELECT(spi, seq->dev, false);
+    }
+
   return ret;
 }
 
+/****************************************************************************
+ * Name: spi_transfer
+ *
+ * Description:
+ *   This is a helper function that can be used to encapsulate and manage
+ *   a sequence of SPI transfers.  The SPI bus will be locked and the
+ *   SPI device selected for the duration of the transfers.
+ *
+ * Input Parameters:
+ *   spi - An instance of the SPI device to use for the transfer
+ *   seq - Describes the sequence of transfers.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int spi_transfer(FAR struct spi_dev_s *spi, FAR struct spi_sequence_s *seq)
+{
+  int ret;
+
+  DEBUGASSERT(spi != NULL && seq != NULL && seq->trans != NULL);
+
+  /* Get exclusive access to the SPI bus */
+
+  SPI_LOCK(spi, true);
+  ret = spi_transfer_locked(spi, seq, false);
+  SPI_LOCK(spi, false);
+  return ret;
+}
@@ -27,14 +27,33 @@
 
 #include <nuttx/config.h>
 
+#include <sys/types.h>
+#include <stdarg.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
 
 /****************************************************************************
- * Public Data
+ * Public Types
  ****************************************************************************/
 
 #ifndef __ASSEMBLY__
 
+/* When, on which CPU and by which thread a message was logged */
+
+struct syslog_origin_s
+{
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+  struct timespec ts;
+#endif
+  pid_t           pid;
+  uint8_t         cpu;
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
 #ifdef __cplusplus
 #define EXTERN extern "C"
 extern "C"
@@ -182,6 +201,71 @@ FAR syslog_channel_t *syslog_console_channel(void);
 void syslog_register(void);
 #endif
 
+/****************************************************************************
+ * Name: syslog_origin
+ *
+ * Description:
+ *   Record when, on which CPU and by which thread a message is logged.
+ *
+ ****************************************************************************/
+
+void syslog_origin(FAR struct syslog_origin_s *origin);
+
+/****************************************************************************
+ * Name: syslog_vformat
+ *
+ * Description:
+ *   Format a message with the prefix of its origin to the SYSLOG channels.
+ *
+ * Input Parameters:
+ *   priority - The priority of the message
+ *   origin   - Where and when the message was logged
+ *   fmt      - The format of the message
+ *   ap       - The arguments, if 'args' is NULL
+ *   args     - The arguments packed by lib_vbspack(), or NULL
+ *
+ * Returned Value:
+ *   The number of characters written.
+ *
+ ****************************************************************************/
+
+int syslog_vformat(int priority, FAR const struct syslog_origin_s *origin,
+                   FAR const IPTR char *fmt, FAR va_list *ap,
+                   FAR const void *args);
+
+/****************************************************************************
+ * Name: syslog_add_deferred
+ *
+ * Description:
+ *   Record a message in the deferred buffer of the CPU, with its format
+ *   and its packed arguments:  It is formatted later by the low priority
+ *   work queue.  'ap' is unchanged.
+ *
+ * Returned Value:
+ *   Zero (OK) if the message is recorded.  A negated errno value if it
+ *   must be formatted now:  -EAGAIN if the buffer is full, -E2BIG if the
+ *   arguments are too large and -EPERM if messages cannot be deferred, in
+ *   the initialization or after a crash.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+int syslog_add_deferred(int priority, FAR const IPTR char *fmt,
+                        FAR va_list *ap);
+#endif
+
+/****************************************************************************
+ * Name: syslog_flush_deferred
+ *
+ * Description:
+ *   Format now the messages of the deferred buffers of all the CPUs.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+void syslog_flush_deferred(void);
+#endif
+
 /****************************************************************************
  * Name: syslog_add_intbuffer
  *
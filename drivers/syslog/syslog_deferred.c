@@ -0,0 +1,274 @@
+/****************************************************************************
+ * drivers/syslog/syslog_deferred.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/init.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/streams.h>
+#include <nuttx/syslog/syslog.h>
+#include <nuttx/wqueue.h>
+
+#include "syslog.h"
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The records are aligned for their origin */
+
+#define SYSLOG_DEFERRED_ALIGN   8
+#define SYSLOG_DEFERRED_BUFSIZE (CONFIG_SYSLOG_DEFERRED_BUFSIZE & \
+                                 ~(SYSLOG_DEFERRED_ALIGN - 1))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A message waiting to be formatted, followed by its packed arguments.  A
+ * record of zero length fills the end of the buffer.
+ */
+
+struct syslog_record_s
+{
+  uint16_t               length;   /* Of the record and its arguments */
+  uint8_t                priority;
+  struct syslog_origin_s origin;
+  FAR const IPTR char   *fmt;
+};
+
+/* The deferred buffer of a CPU.  The CPU is the only producer, with its
+ * interrupts disabled, and the formatting work the only consumer:  No lock
+ * is shared by the CPUs.  The indexes are free running.
+ */
+
+struct syslog_deferred_s
+{
+  volatile size_t head;            /* Written by the CPU */
+  volatile size_t tail;            /* Written by the formatting work */
+  aligned_data(SYSLOG_DEFERRED_ALIGN)
+  uint8_t buffer[SYSLOG_DEFERRED_BUFSIZE];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct syslog_deferred_s g_syslog_deferred[CONFIG_SMP_NCPUS];
+static struct work_s g_syslog_deferred_work;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_deferred_drain
+ *
+ * Description:
+ *   Format the messages of the deferred buffer of a CPU.
+ *
+ ****************************************************************************/
+
+static void syslog_deferred_drain(FAR struct syslog_deferred_s *deferred)
+{
+  FAR struct syslog_record_s *record;
+  size_t index;
+  size_t tail = deferred->tail;
+
+  while (tail != deferred->head)
+    {
+      /* Read the record only after the head */
+
+      SP_DMB();
+
+      index  = tail % SYSLOG_DEFERRED_BUFSIZE;
+      record = (FAR struct syslog_record_s *)&deferred->buffer[index];
+      if (record->length == 0)
+        {
+          tail += SYSLOG_DEFERRED_BUFSIZE - index;
+        }
+      else
+        {
+          syslog_vformat(record->priority, &record->origin, record->fmt,
+                         NULL, record + 1);
+          tail += record->length;
+        }
+
+      /* Release the record only once it is formatted */
+
+      SP_DMB();
+      deferred->tail = tail;
+    }
+}
+
+/****************************************************************************
+ * Name: syslog_deferred_work
+ *
+ * Description:
+ *   Format the deferred messages of all the CPUs on the low priority work
+ *   queue.
+ *
+ ****************************************************************************/
+
+static void syslog_deferred_work(FAR void *arg)
+{
+  syslog_flush_deferred();
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_add_deferred
+ *
+ * Description:
+ *   Record a message in the deferred buffer of the CPU, with its format
+ *   and its packed arguments:  It is formatted later by the low priority
+ *   work queue.  'ap' is unchanged.
+ *
+ * Returned Value:
+ *   Zero (OK) if the message is recorded.  A negated errno value if it
+ *   must be formatted now:  -EAGAIN if the buffer is full, -E2BIG if the
+ *   arguments are too large and -EPERM if messages cannot be deferred, in
+ *   the initialization or after a crash.
+ *
+ ****************************************************************************/
+
+int syslog_add_deferred(int priority, FAR const IPTR char *fmt,
+                        FAR va_list *ap)
+{
+  FAR struct syslog_deferred_s *deferred;
+  FAR struct syslog_record_s *record;
+  uint8_t args[CONFIG_SYSLOG_DEFERRED_ARGSIZE];
+  struct syslog_origin_s origin;
+  irqstate_t flags;
+  size_t length;
+  size_t index;
+  size_t space;
+  size_t head;
+  va_list copy;
+  int nargs;
+
+  if (!OSINIT_OS_READY() || g_nx_initstate == OSINIT_PANIC)
+    {
+      return -EPERM;
+    }
+
+  /* Pack the arguments before disabling the interrupts */
+
+  va_copy(copy, *ap);
+  nargs = lib_vbspack(args, sizeof(args), fmt, copy);
+  va_end(copy);
+
+  if (nargs < 0)
+    {
+      return nargs;
+    }
+
+  length = ALIGN_UP(sizeof(struct syslog_record_s) + nargs,
+                    SYSLOG_DEFERRED_ALIGN);
+
+  /* Only this CPU writes its buffer */
+
+  flags = up_irq_save();
+  syslog_origin(&origin);
+
+  deferred = &g_syslog_deferred[origin.cpu];
+  head     = deferred->head;
+  index    = head % SYSLOG_DEFERRED_BUFSIZE;
+  space    = SYSLOG_DEFERRED_BUFSIZE - (head - deferred->tail);
+
+  /* Fill the end of the buffer if the record does not fit there */
+
+  if (length > SYSLOG_DEFERRED_BUFSIZE - index)
+    {
+      if (length + SYSLOG_DEFERRED_BUFSIZE - index > space)
+        {
+          up_irq_restore(flags);
+          return -EAGAIN;
+        }
+
+      record = (FAR struct syslog_record_s *)&deferred->buffer[index];
+      record->length = 0;
+      head  += SYSLOG_DEFERRED_BUFSIZE - index;
+      index  = 0;
+    }
+  else if (length > space)
+    {
+      up_irq_restore(flags);
+      return -EAGAIN;
+    }
+
+  record = (FAR struct syslog_record_s *)&deferred->buffer[index];
+  record->length   = length;
+  record->priority = priority;
+  record->origin   = origin;
+  record->fmt      = fmt;
+  memcpy(record + 1, args, nargs);
+
+  /* Publish the record only once it is written */
+
+  SP_DMB();
+  deferred->head = head + length;
+  up_irq_restore(flags);
+
+  if (work_available(&g_syslog_deferred_work))
+    {
+      work_queue(LPWORK, &g_syslog_deferred_work, syslog_deferred_work,
+                 NULL, 0);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: syslog_flush_deferred
+ *
+ * Description:
+ *   Format now the messages of the deferred buffers of all the CPUs.
+ *
+ ****************************************************************************/
+
+void syslog_flush_deferred(void)
+{
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      syslog_deferred_drain(&g_syslog_deferred[cpu]);
+    }
+}
+
+#endif /* CONFIG_SYSLOG_DEFERRED */
@@ -168,10 +168,7 @@ static bool syslog_rpmsg_transfer(FAR struct syslog_rpmsg_s *priv, bool wait)
       msg->count          = len;
       priv->tail         += len;
       msg->header.command = SYSLOG_RPMSG_TRANSFER;
-      if (rpmsg_send_nocopy(&priv->ept, msg, sizeof(*msg) + len) < 0)
-        {
-          rpmsg_release_tx_buffer(&priv->ept, msg);
-        }
+      rpmsg_commit(&priv->ept, msg, sizeof(*msg) + len);
 
       len                 = SYSLOG_RPMSG_COUNT(priv);
 
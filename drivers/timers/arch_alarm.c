@@ -26,6 +26,7 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/timers/arch_alarm.h>
 
 /****************************************************************************
@@ -46,6 +47,20 @@ static FAR struct oneshot_lowerhalf_s *g_oneshot_lower;
 static clock_t g_current_tick;
 #endif
 
+#ifdef CONFIG_HRTIMER
+/* The oneshot is shared by the OS tick (or alarm) and the hrtimers.  It is
+ * always programmed for whichever of the two comes first.
+ */
+
+static spinlock_t g_alarm_lock = SP_UNLOCKED;
+static uint64_t g_hrtimer_expired = UINT64_MAX;
+
+#  ifdef CONFIG_SCHED_TICKLESS
+static clock_t g_alarm_tick;
+static bool g_alarm_active;
+#  endif
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -97,6 +112,124 @@ static void udelay_coarse(useconds_t microseconds)
     }
 }
 
+#ifdef CONFIG_HRTIMER
+static void oneshot_callback(FAR struct oneshot_lowerhalf_s *lower,
+                             FAR void *arg);
+
+/****************************************************************************
+ * Name: oneshot_reprogram
+ *
+ * Description:
+ *   Start the oneshot for the earliest of the next OS tick (or alarm) and
+ *   the next hrtimer.  The caller must hold g_alarm_lock.
+ *
+ ****************************************************************************/
+
+static void oneshot_reprogram(void)
+{
+  struct timespec ts;
+  uint64_t expired = g_hrtimer_expired;
+  uint64_t nsec;
+  sclock_t delta;
+  clock_t now;
+  bool tick;
+
+  ONESHOT_CURRENT(g_oneshot_lower, &ts);
+  ONESHOT_TICK_CURRENT(g_oneshot_lower, &now);
+  nsec = clock_time2nsec(&ts);
+
+  /* Express the tick deadline relative to the current tick so that a
+   * wrapping clock_t does not matter.
+   */
+
+#ifdef CONFIG_SCHED_TICKLESS
+  tick  = g_alarm_active;
+  delta = g_alarm_tick - now;
+#else
+  tick  = true;
+  delta = g_current_tick + 1 - now;
+#endif
+
+  if (tick)
+    {
+      uint64_t next = nsec;
+
+      if (delta > 0)
+        {
+          next += (uint64_t)delta * NSEC_PER_TICK;
+        }
+
+      if (next < expired)
+        {
+          expired = next;
+        }
+    }
+
+  if (expired == UINT64_MAX)
+    {
+      ONESHOT_CANCEL(g_oneshot_lower, &ts);
+    }
+  else
+    {
+      clock_nsec2time(&ts, expired > nsec ? expired - nsec : 0);
+      ONESHOT_START(g_oneshot_lower, oneshot_callback, NULL, &ts);
+    }
+}
+
+static void oneshot_callback(FAR struct oneshot_lowerhalf_s *lower,
+                             FAR void *arg)
+{
+  struct timespec ts;
+  irqstate_t flags;
+  uint64_t expired;
+  uint64_t nsec;
+  clock_t now;
+#ifdef CONFIG_SCHED_TICKLESS
+  bool due;
+#endif
+
+  ONESHOT_CURRENT(g_oneshot_lower, &ts);
+  ONESHOT_TICK_CURRENT(g_oneshot_lower, &now);
+  nsec = clock_time2nsec(&ts);
+
+  /* Run the hrtimers first, they are why the oneshot fires off-tick */
+
+  flags = spin_lock_irqsave(&g_alarm_lock);
+  expired = g_hrtimer_expired;
+  spin_unlock_irqrestore(&g_alarm_lock, flags);
+
+  if (expired <= nsec)
+    {
+      nxsched_hrtimer_expiration(nsec);
+    }
+
+#ifdef CONFIG_SCHED_TICKLESS
+  flags = spin_lock_irqsave(&g_alarm_lock);
+  due = g_alarm_active && clock_compare(g_alarm_tick, now);
+  if (due)
+    {
+      g_alarm_active = false;
+    }
+
+  spin_unlock_irqrestore(&g_alarm_lock, flags);
+
+  if (due)
+    {
+      nxsched_alarm_tick_expiration(now);
+    }
+#else
+  while (now - g_current_tick > 0)
+    {
+      g_current_tick++;
+      nxsched_process_timer();
+    }
+#endif
+
+  flags = spin_lock_irqsave(&g_alarm_lock);
+  oneshot_reprogram();
+  spin_unlock_irqrestore(&g_alarm_lock, flags);
+}
+#else
 static void oneshot_callback(FAR struct oneshot_lowerhalf_s *lower,
                              FAR void *arg)
 {
@@ -130,6 +263,7 @@ static void oneshot_callback(FAR struct oneshot_lowerhalf_s *lower,
     }
 #endif
 }
+#endif /* CONFIG_HRTIMER */
 
 /****************************************************************************
  * Public Functions
@@ -140,6 +274,9 @@ void up_alarm_set_lowerhalf(FAR struct oneshot_lowerhalf_s *lower)
 #ifdef CONFIG_SCHED_TICKLESS
   clock_t ticks;
 #endif
+#ifdef CONFIG_HRTIMER
+  irqstate_t flags;
+#endif
 
   g_oneshot_lower = lower;
 
@@ -148,6 +285,15 @@ void up_alarm_set_lowerhalf(FAR struct oneshot_lowerhalf_s *lower)
   g_oneshot_maxticks = ticks < UINT32_MAX ? ticks : UINT32_MAX;
 #else
   ONESHOT_TICK_CURRENT(g_oneshot_lower, &g_current_tick);
+#endif
+
+#ifdef CONFIG_HRTIMER
+  /* Honor any hrtimer started before the lower half was available */
+
+  flags = spin_lock_irqsave(&g_alarm_lock);
+  oneshot_reprogram();
+  spin_unlock_irqrestore(&g_alarm_lock, flags);
+#elif !defined(CONFIG_SCHED_TICKLESS)
   ONESHOT_TICK_START(g_oneshot_lower, oneshot_callback, NULL, 1);
 #endif
 }
@@ -210,7 +356,8 @@ void weak_function up_timer_getmask(FAR clock_t *mask)
 }
 #endif
 
-#if defined(CONFIG_SCHED_TICKLESS) || defined(CONFIG_CLOCK_TIMEKEEPING)
+#if defined(CONFIG_SCHED_TICKLESS) || defined(CONFIG_CLOCK_TIMEKEEPING) || \
+    defined(CONFIG_HRTIMER)
 int weak_function up_timer_gettick(FAR clock_t *ticks)
 {
   int ret = -EAGAIN;
@@ -277,7 +424,17 @@ int weak_function up_alarm_tick_cancel(FAR clock_t *ticks)
 
   if (g_oneshot_lower != NULL)
     {
+#ifdef CONFIG_HRTIMER
+      /* Keep the oneshot running for the hrtimers */
+
+      irqstate_t flags = spin_lock_irqsave(&g_alarm_lock);
+      g_alarm_active = false;
+      oneshot_reprogram();
+      spin_unlock_irqrestore(&g_alarm_lock, flags);
+      ret = OK;
+#else
       ret = ONESHOT_TICK_CANCEL(g_oneshot_lower, ticks);
+#endif
       ONESHOT_TICK_CURRENT(g_oneshot_lower, ticks);
     }
 
@@ -316,6 +473,14 @@ int weak_function up_alarm_tick_start(clock_t ticks)
 
   if (g_oneshot_lower != NULL)
     {
+#ifdef CONFIG_HRTIMER
+      irqstate_t flags = spin_lock_irqsave(&g_alarm_lock);
+      g_alarm_tick   = ticks;
+      g_alarm_active = true;
+      oneshot_reprogram();
+      spin_unlock_irqrestore(&g_alarm_lock, flags);
+      ret = OK;
+#else
       clock_t now;
       clock_t delta;
 
@@ -328,8 +493,42 @@ int weak_function up_alarm_tick_start(clock_t ticks)
 
       ret = ONESHOT_TICK_START(g_oneshot_lower, oneshot_callback,
                                NULL, delta);
+#endif
+    }
+
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: up_hrtimer_start
+ *
+ * Description:
+ *   Program the oneshot so that nxsched_hrtimer_expiration() is called
+ *   when CLOCK_MONOTONIC reaches 'expired' (in nanoseconds).  UINT64_MAX
+ *   means that no hrtimer is active.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER
+int weak_function up_hrtimer_start(uint64_t expired)
+{
+  irqstate_t flags;
+  int ret = -EAGAIN;
+
+  /* Record the time even without a lower half, it will be honored once
+   * up_alarm_set_lowerhalf() is called.
+   */
+
+  flags = spin_lock_irqsave(&g_alarm_lock);
+  g_hrtimer_expired = expired;
+  if (g_oneshot_lower != NULL)
+    {
+      oneshot_reprogram();
+      ret = OK;
     }
 
+  spin_unlock_irqrestore(&g_alarm_lock, flags);
   return ret;
 }
 #endif
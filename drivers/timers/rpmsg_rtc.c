@@ -304,13 +304,14 @@ static int rpmsg_rtc_ept_cb(FAR struct rpmsg_endpoint *ept, FAR void *data,
     case RPMSG_RTC_SYNC:
         {
           struct rpmsg_rtc_set_s *msg = data;
+          struct timespec tp;
 
 #ifdef CONFIG_RTC_RPMSG_SYNC_BASETIME
-          g_basetime.tv_sec  = msg->base_sec;
-          g_basetime.tv_nsec = msg->base_nsec;
-#else
-          struct timespec tp;
+          tp.tv_sec  = msg->base_sec;
+          tp.tv_nsec = msg->base_nsec;
 
+          clock_set_basetime(&tp);
+#else
           tp.tv_sec  = msg->sec;
           tp.tv_nsec = msg->nsec;
 
@@ -478,6 +479,7 @@ static int rpmsg_rtc_server_settime(FAR struct rtc_lowerhalf_s *lower,
   FAR struct rpmsg_rtc_client_s *client;
   FAR struct list_node *node;
   struct rpmsg_rtc_set_s msg;
+  struct timespec base;
   int ret;
 
   ret = server->lower->ops->settime(server->lower, rtctime);
@@ -498,8 +500,9 @@ static int rpmsg_rtc_server_settime(FAR struct rtc_lowerhalf_s *lower,
           ret = 1; /* Request the upper half skip clock synchronize */
         }
 
-      msg.base_sec = g_basetime.tv_sec;
-      msg.base_nsec = g_basetime.tv_nsec;
+      clock_get_basetime(&base);
+      msg.base_sec = base.tv_sec;
+      msg.base_nsec = base.tv_nsec;
 
       nxmutex_lock(&server->lock);
 
@@ -36,7 +36,9 @@
 #include <stdbool.h>
 #include <sys/poll.h>
 
+#include <nuttx/mutex.h>
 #include <nuttx/net/netdev_lowerhalf.h>
+#include <nuttx/queue.h>
 #include <nuttx/usb/usbdev.h>
 #include <nuttx/usb/cdc.h>
 #include <nuttx/usb/cdcncm.h>
@@ -73,7 +75,18 @@
 /* TX timeout = 1 minute */
 
 #define CDCNCM_TXTIMEOUT             (60*CLK_TCK)
-#define CDCNCM_DGRAM_COMBINE_PERIOD   1
+
+#ifndef CONFIG_CDCNCM_NWRREQS
+#  define CONFIG_CDCNCM_NWRREQS       2
+#endif
+
+#ifndef CONFIG_CDCNCM_NRDREQS
+#  define CONFIG_CDCNCM_NRDREQS       2
+#endif
+
+#ifndef CONFIG_CDCNCM_COMBINE_PERIOD
+#  define CONFIG_CDCNCM_COMBINE_PERIOD 1000
+#endif
 
 #define NTB_DEFAULT_IN_SIZE           16384
 #define NTB_OUT_SIZE                  16384
@@ -288,6 +301,30 @@ begin_packed_struct struct usb_cdc_ncm_ntb_parameters_s
   uint16_t ntboutmaxdatagrams;
 } end_packed_struct;
 
+/* A read or write request of the bulk endpoints, in the list of the free
+ * write requests or of the read requests to parse
+ */
+
+struct cdcncm_req_s
+{
+  sq_entry_t                  node;        /* In txfree or rxdone */
+  FAR struct usbdev_req_s    *req;         /* The USB device request */
+};
+
+/* The aggregation statistics, shown when the configuration is reset */
+
+struct cdcncm_stats_s
+{
+  uint32_t                    ntbtx;       /* NTBs sent */
+  uint32_t                    dgramtx;     /* Datagrams sent */
+  uint32_t                    maxdgramtx;  /* Most datagrams in a sent NTB */
+  uint32_t                    timedtx;     /* NTBs sent by the timer */
+  uint32_t                    ntbrx;       /* NTBs received */
+  uint32_t                    dgramrx;     /* Datagrams received */
+  uint32_t                    maxdgramrx;  /* Most datagrams in an NTB */
+  uint32_t                    droprx;      /* Datagrams dropped */
+};
+
 /* The cdcncm_driver_s encapsulates all state information for a single
  * hardware interface
  */
@@ -305,11 +342,14 @@ struct cdcncm_driver_s
   FAR struct usbdev_ep_s     *epbulkout;   /* Bulk OUT endpoint */
   uint8_t                     config;      /* Selected configuration number */
 
-  FAR struct usbdev_req_s    *rdreq;       /* Single read request */
-  bool                        rxpending;   /* Packet available in rdreq */
+  struct cdcncm_req_s         rdreqs[CONFIG_CDCNCM_NRDREQS];
+  sq_queue_t                  rxdone;      /* Read requests to parse */
 
-  FAR struct usbdev_req_s    *wrreq;       /* Single write request */
-  sem_t                       wrreq_idle;  /* Is the wrreq available? */
+  struct cdcncm_req_s         wrreqs[CONFIG_CDCNCM_NWRREQS];
+  sq_queue_t                  txfree;      /* Free write requests */
+  sem_t                       wrreq_idle;  /* Counts the txfree entries */
+  mutex_t                     txlock;      /* Protects the NTB in wrreq */
+  FAR struct usbdev_req_s    *wrreq;       /* The NTB being filled */
   bool                        txdone;      /* Did a write request complete? */
   enum ncm_notify_state_e     notify;      /* State of notify */
   FAR const struct ndp_parser_opts_s
@@ -318,6 +358,7 @@ struct cdcncm_driver_s
   int                         dgramcount;  /* The current tx cache dgram count */
   FAR uint8_t                *dgramaddr;   /* The next tx cache dgram address */
   bool                        isncm;       /* true:NCM false:MBIM */
+  struct cdcncm_stats_s       stats;       /* Aggregation statistics */
 
   /* Network device */
 
@@ -369,7 +410,8 @@ static int     cdcmbim_poll(FAR struct file *filep, FAR struct pollfd *fds,
 
 /* Interrupt handling */
 
-static void cdcncm_receive(FAR struct cdcncm_driver_s *priv);
+static void cdcncm_receive(FAR struct cdcncm_driver_s *priv,
+                           FAR struct usbdev_req_s *req);
 static void cdcncm_txdone(FAR struct cdcncm_driver_s *priv);
 
 static void cdcncm_interrupt_work(FAR void *arg);
@@ -818,6 +860,73 @@ errout:
 }
 #endif
 
+/****************************************************************************
+ * Name: cdcncm_allocwrreq
+ *
+ * Description:
+ *   Take a free write request for the next NTB, waiting until one of the
+ *   NTBs in flight is sent if there is none.
+ *
+ * Input Parameters:
+ *   self - Reference to the driver state structure
+ *
+ * Returned Value:
+ *   The write request
+ *
+ ****************************************************************************/
+
+static FAR struct usbdev_req_s *
+cdcncm_allocwrreq(FAR struct cdcncm_driver_s *self)
+{
+  FAR struct cdcncm_req_s *container;
+  irqstate_t flags;
+
+  while (nxsem_wait(&self->wrreq_idle) != OK)
+    {
+    }
+
+  flags     = enter_critical_section();
+  container = (FAR struct cdcncm_req_s *)sq_remfirst(&self->txfree);
+  leave_critical_section(flags);
+
+  DEBUGASSERT(container != NULL);
+  return container->req;
+}
+
+/****************************************************************************
+ * Name: cdcncm_freewrreq
+ *
+ * Description:
+ *   Give back a write request once its NTB is sent.  May be called from an
+ *   interrupt handler.
+ *
+ * Input Parameters:
+ *   self - Reference to the driver state structure
+ *   req  - The write request
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void cdcncm_freewrreq(FAR struct cdcncm_driver_s *self,
+                             FAR struct usbdev_req_s *req)
+{
+  FAR struct cdcncm_req_s *container = req->priv;
+  irqstate_t flags;
+  int rc;
+
+  flags = enter_critical_section();
+  sq_addlast(&container->node, &self->txfree);
+  leave_critical_section(flags);
+
+  rc = nxsem_post(&self->wrreq_idle);
+  if (rc != OK)
+    {
+      nerr("nxsem_post failed! rc: %d\n", rc);
+    }
+}
+
 /****************************************************************************
  * Name: cdcncm_transmit_format
  *
@@ -892,36 +1001,39 @@ static void cdcncm_transmit_format(FAR struct cdcncm_driver_s *self,
 }
 
 /****************************************************************************
- * Name: cdcncm_transmit_work
+ * Name: cdcncm_transmit
  *
  * Description:
- *   Send NTB to the USB device for ethernet frame transmission
+ *   Send the NTB being filled to the USB device for ethernet frame
+ *   transmission.  The next datagram starts a new NTB in another write
+ *   request, while this one is in flight.
  *
  * Input Parameters:
- *   arg - Reference to the driver state structure
+ *   self - Reference to the driver state structure
  *
  * Returned Value:
  *   None
  *
+ * Assumptions:
+ *   The caller holds txlock.
+ *
  ****************************************************************************/
 
-static void cdcncm_transmit_work(FAR void *arg)
+static void cdcncm_transmit(FAR struct cdcncm_driver_s *self)
 {
-  FAR struct cdcncm_driver_s *self = arg;
   FAR const struct ndp_parser_opts_s *opts = self->parseropts;
+  FAR struct usbdev_req_s *req = self->wrreq;
   FAR uint8_t *tmp;
   const int dgramidxlen = 2 * opts->dgramitemlen;
   const int ndpalign = g_ntbparameters.ndpinalignment;
   int ncblen;
   int ndpindex;
   int totallen;
+  int ret;
 
-  /* Wait until the USB device request for Ethernet frame transmissions
-   * becomes available.
-   */
-
-  while (nxsem_wait(&self->wrreq_idle) != OK)
+  if (req == NULL || self->dgramcount == 0)
     {
+      return;
     }
 
   ncblen   = opts->nthsize;
@@ -929,25 +1041,67 @@ static void cdcncm_transmit_work(FAR void *arg)
 
   /* Fill NCB */
 
-  tmp      = self->wrreq->buf + 8; /* Offset to block length */
-  totallen = self->dgramaddr - self->wrreq->buf;
+  tmp      = req->buf + 8; /* Offset to block length */
+  totallen = self->dgramaddr - req->buf;
   cdcncm_put(&tmp, opts->blocklen, totallen);
 
   /* Fill NDP */
 
-  tmp = self->wrreq->buf + ndpindex + 4; /* Offset to ndp length */
+  tmp = req->buf + ndpindex + 4; /* Offset to ndp length */
   cdcncm_put(&tmp, 2, opts->ndpsize + (self->dgramcount + 1) * dgramidxlen);
 
   tmp += opts->reserved1 + opts->nextndpindex + opts->reserved2 +
          self->dgramcount * dgramidxlen;
-  self->dgramcount = 0;
 
   cdcncm_put(&tmp, opts->dgramitemlen, 0);
   cdcncm_put(&tmp, opts->dgramitemlen, 0);
 
-  self->wrreq->len = totallen;
+  self->stats.ntbtx++;
+  self->stats.dgramtx += self->dgramcount;
+  if (self->stats.maxdgramtx < self->dgramcount)
+    {
+      self->stats.maxdgramtx = self->dgramcount;
+    }
+
+  self->dgramcount = 0;
+  self->wrreq      = NULL;
+  req->len         = totallen;
+
+  ret = EP_SUBMIT(self->epbulkin, req);
+  if (ret < 0)
+    {
+      uerr("EP_SUBMIT failed. ret %d\n", ret);
+      cdcncm_freewrreq(self, req);
+    }
+}
+
+/****************************************************************************
+ * Name: cdcncm_transmit_work
+ *
+ * Description:
+ *   Send the NTB being filled once the combine period of its first
+ *   datagram is over.
+ *
+ * Input Parameters:
+ *   arg - Reference to the driver state structure
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void cdcncm_transmit_work(FAR void *arg)
+{
+  FAR struct cdcncm_driver_s *self = arg;
 
-  EP_SUBMIT(self->epbulkin, self->wrreq);
+  nxmutex_lock(&self->txlock);
+  if (self->dgramcount > 0)
+    {
+      self->stats.timedtx++;
+      cdcncm_transmit(self);
+    }
+
+  nxmutex_unlock(&self->txlock);
 }
 
 /****************************************************************************
@@ -999,19 +1153,22 @@ static int cdcncm_packet_handler(FAR struct cdcncm_driver_s *self,
  *
  * Input Parameters:
  *   self - Reference to the driver state structure
+ *   req  - The completed read request holding the NTB
  *
  * Returned Value:
  *   None
  *
  ****************************************************************************/
 
-static void cdcncm_receive(FAR struct cdcncm_driver_s *self)
+static void cdcncm_receive(FAR struct cdcncm_driver_s *self,
+                           FAR struct usbdev_req_s *req)
 {
   FAR const struct ndp_parser_opts_s *opts = self->parseropts;
-  FAR uint8_t *tmp = self->rdreq->buf;
+  FAR uint8_t *tmp = req->buf;
   uint32_t ntbmax = g_ntbparameters.ntboutmaxsize;
   uint32_t blocklen;
   uint32_t ndplen;
+  uint32_t ndgrams = 0;
   int ndpindex;
   int dgramcounter;
 
@@ -1019,7 +1176,7 @@ static void cdcncm_receive(FAR struct cdcncm_driver_s *self)
 
   if (GETUINT32(tmp) != opts->nthsign)
     {
-      uerr("Wrong NTH SIGN, skblen %zu\n", self->rdreq->xfrd);
+      uerr("Wrong NTH SIGN, skblen %zu\n", req->xfrd);
       return;
     }
 
@@ -1059,7 +1216,7 @@ static void cdcncm_receive(FAR struct cdcncm_driver_s *self)
           return;
         }
 
-      tmp = self->rdreq->buf + ndpindex;
+      tmp = req->buf + ndpindex;
 
       if (GETUINT32(tmp) != self->ndpsign)
         {
@@ -1103,13 +1260,25 @@ static void cdcncm_receive(FAR struct cdcncm_driver_s *self)
 
           /* Copy the data from the hardware to self->rx_queue. */
 
-          cdcncm_packet_handler(self, self->rdreq->buf + index, dglen);
+          if (cdcncm_packet_handler(self, req->buf + index, dglen) < 0)
+            {
+              self->stats.droprx++;
+            }
 
           ndplen -= 2 * (opts->dgramitemlen);
         }
       while (ndplen > 2 * (opts->dgramitemlen));
+
+      ndgrams += dgramcounter;
     }
   while (ndpindex);
+
+  self->stats.ntbrx++;
+  self->stats.dgramrx += ndgrams;
+  if (self->stats.maxdgramrx < ndgrams)
+    {
+      self->stats.maxdgramrx = ndgrams;
+    }
 }
 
 /****************************************************************************
@@ -1153,19 +1322,29 @@ static void cdcncm_txdone(FAR struct cdcncm_driver_s *priv)
 static void cdcncm_interrupt_work(FAR void *arg)
 {
   FAR struct cdcncm_driver_s *self = (FAR struct cdcncm_driver_s *)arg;
+  FAR struct cdcncm_req_s *container;
   irqstate_t flags;
 
-  /* Check if we received an incoming packet, if so, call cdcncm_receive() */
+  /* Parse the received NTBs in order with cdcncm_receive(), each read
+   * request is queued again once parsed while the others are still
+   * filled by the host.
+   */
 
-  if (self->rxpending)
+  for (; ; )
     {
-      cdcncm_receive(self);
+      flags     = enter_critical_section();
+      container = (FAR struct cdcncm_req_s *)sq_remfirst(&self->rxdone);
+      leave_critical_section(flags);
+
+      if (container == NULL)
+        {
+          break;
+        }
+
+      cdcncm_receive(self, container->req);
       netdev_lower_rxready(&self->dev);
 
-      flags = enter_critical_section();
-      self->rxpending = false;
-      EP_SUBMIT(self->epbulkout, self->rdreq);
-      leave_critical_section(flags);
+      EP_SUBMIT(self->epbulkout, container->req);
     }
 
   /* Check if a packet transmission just completed.  If so, call
@@ -1289,6 +1468,13 @@ static int cdcncm_send(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt)
   FAR struct cdcncm_driver_s *self;
 
   self = container_of(dev, struct cdcncm_driver_s, dev);
+
+  nxmutex_lock(&self->txlock);
+  if (self->wrreq == NULL)
+    {
+      self->wrreq = cdcncm_allocwrreq(self);
+    }
+
   cdcncm_transmit_format(self, pkt);
   netpkt_free(dev, pkt, NETPKT_TX);
 
@@ -1296,14 +1482,19 @@ static int cdcncm_send(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt)
        self->dev.netdev.d_pktsize) || self->dgramcount >= TX_MAX_NUM_DPE)
     {
       work_cancel(ETHWORK, &self->delaywork);
-      cdcncm_transmit_work(self);
+      cdcncm_transmit(self);
     }
-  else
+  else if (self->dgramcount == 1)
     {
+      /* The timer starts with the first datagram of the NTB, so that a
+       * steady flow of datagrams does not hold it back longer.
+       */
+
       work_queue(ETHWORK, &self->delaywork, cdcncm_transmit_work, self,
-                 MSEC2TICK(CDCNCM_DGRAM_COMBINE_PERIOD));
+                 USEC2TICK(CONFIG_CDCNCM_COMBINE_PERIOD));
     }
 
+  nxmutex_unlock(&self->txlock);
   return OK;
 }
 
@@ -1480,8 +1671,13 @@ static void cdcncm_rdcomplete(FAR struct usbdev_ep_s *ep,
     {
       case 0:  /* Normal completion */
         {
-          DEBUGASSERT(!self->rxpending);
-          self->rxpending = true;
+          FAR struct cdcncm_req_s *container = req->priv;
+          irqstate_t flags;
+
+          flags = enter_critical_section();
+          sq_addlast(&container->node, &self->rxdone);
+          leave_critical_section(flags);
+
           work_queue(ETHWORK, &self->irqwork,
                      cdcncm_interrupt_work, self, 0);
         }
@@ -1493,7 +1689,7 @@ static void cdcncm_rdcomplete(FAR struct usbdev_ep_s *ep,
       default: /* Some other error occurred */
         {
           uerr("req->result: %hd\n", req->result);
-          EP_SUBMIT(self->epbulkout, self->rdreq);
+          EP_SUBMIT(self->epbulkout, req);
         }
         break;
     }
@@ -1512,21 +1708,13 @@ static void cdcncm_wrcomplete(FAR struct usbdev_ep_s *ep,
                               FAR struct usbdev_req_s *req)
 {
   FAR struct cdcncm_driver_s *self = (FAR struct cdcncm_driver_s *)ep->priv;
-  int rc;
 
   uinfo("buf: %p, flags 0x%hhx, len %zu, xfrd %zu, result %hd\n",
         req->buf, req->flags, req->len, req->xfrd, req->result);
 
-  /* The single USB device write request is available for upcoming
-   * transmissions again.
-   */
+  /* The USB device write request is available for upcoming NTBs again */
 
-  rc = nxsem_post(&self->wrreq_idle);
-
-  if (rc != OK)
-    {
-      nerr("nxsem_post failed! rc: %d\n", rc);
-    }
+  cdcncm_freewrreq(self, req);
 
   /* Inform the network layer that an Ethernet frame was transmitted. */
 
@@ -1564,6 +1752,18 @@ static void cdcncm_resetconfig(FAR struct cdcncm_driver_s *self)
       EP_DISABLE(self->epbulkin);
       EP_DISABLE(self->epbulkout);
       self->notify = NCM_NOTIFY_SPEED;
+
+      /* Show how well the datagrams were aggregated */
+
+      uinfo("TX: %" PRIu32 " NTBs, %" PRIu32 " datagrams (max %" PRIu32
+            "), %" PRIu32 " timed out\n", self->stats.ntbtx,
+            self->stats.dgramtx, self->stats.maxdgramtx,
+            self->stats.timedtx);
+      uinfo("RX: %" PRIu32 " NTBs, %" PRIu32 " datagrams (max %" PRIu32
+            "), %" PRIu32 " dropped\n", self->stats.ntbrx,
+            self->stats.dgramrx, self->stats.maxdgramrx,
+            self->stats.droprx);
+      memset(&self->stats, 0, sizeof(self->stats));
     }
 
   self->parseropts = &g_ndp16_opts;
@@ -1583,6 +1783,7 @@ static int cdcncm_setconfig(FAR struct cdcncm_driver_s *self, uint8_t config)
 {
   struct usb_ss_epdesc_s epdesc;
   int ret;
+  int i;
 
   if (config == self->config)
     {
@@ -1635,14 +1836,16 @@ static int cdcncm_setconfig(FAR struct cdcncm_driver_s *self, uint8_t config)
 
   /* Queue read requests in the bulk OUT endpoint */
 
-  DEBUGASSERT(!self->rxpending);
+  DEBUGASSERT(sq_empty(&self->rxdone));
 
-  self->rdreq->callback = cdcncm_rdcomplete,
-  ret = EP_SUBMIT(self->epbulkout, self->rdreq);
-  if (ret != OK)
+  for (i = 0; i < CONFIG_CDCNCM_NRDREQS; i++)
     {
-      uerr("EP_SUBMIT failed. ret %d\n", ret);
-      goto error;
+      ret = EP_SUBMIT(self->epbulkout, self->rdreqs[i].req);
+      if (ret != OK)
+        {
+          uerr("EP_SUBMIT failed. ret %d\n", ret);
+          goto error;
+        }
     }
 
   /* We are successfully configured */
@@ -2477,7 +2680,9 @@ static int cdcncm_bind(FAR struct usbdevclass_driver_s *driver,
                        FAR struct usbdev_s *dev)
 {
   FAR struct cdcncm_driver_s *self = (FAR struct cdcncm_driver_s *)driver;
+  FAR struct usbdev_req_s *req;
   int ret = OK;
+  int i;
 
   uinfo("\n");
 
@@ -2535,31 +2740,48 @@ static int cdcncm_bind(FAR struct usbdevclass_driver_s *driver,
 
   /* Pre-allocate read requests. The buffer size is NTB_DEFAULT_IN_SIZE. */
 
-  self->rdreq = usbdev_allocreq(self->epbulkout, NTB_DEFAULT_IN_SIZE);
-  if (self->rdreq == NULL)
+  sq_init(&self->rxdone);
+  for (i = 0; i < CONFIG_CDCNCM_NRDREQS; i++)
     {
-      uerr("Out of memory\n");
-      ret = -ENOMEM;
-      goto error;
-    }
+      req = usbdev_allocreq(self->epbulkout, NTB_DEFAULT_IN_SIZE);
+      if (req == NULL)
+        {
+          uerr("Out of memory\n");
+          ret = -ENOMEM;
+          goto error;
+        }
 
-  self->rdreq->callback = cdcncm_rdcomplete;
+      req->callback       = cdcncm_rdcomplete;
+      req->priv           = &self->rdreqs[i];
+      self->rdreqs[i].req = req;
+    }
 
-  /* Pre-allocate a single write request. Buffer size is NTB_OUT_SIZE */
+  /* Pre-allocate the write requests. Buffer size is NTB_OUT_SIZE */
 
-  self->wrreq = usbdev_allocreq(self->epbulkin, NTB_OUT_SIZE);
-  if (self->wrreq == NULL)
+  sq_init(&self->txfree);
+  for (i = 0; i < CONFIG_CDCNCM_NWRREQS; i++)
     {
-      uerr("Out of memory\n");
-      ret = -ENOMEM;
-      goto error;
+      req = usbdev_allocreq(self->epbulkin, NTB_OUT_SIZE);
+      if (req == NULL)
+        {
+          uerr("Out of memory\n");
+          ret = -ENOMEM;
+          goto error;
+        }
+
+      req->callback       = cdcncm_wrcomplete;
+      req->priv           = &self->wrreqs[i];
+      self->wrreqs[i].req = req;
+      sq_addlast(&self->wrreqs[i].node, &self->txfree);
     }
 
-  self->wrreq->callback = cdcncm_wrcomplete;
+  self->wrreq      = NULL;
+  self->dgramcount = 0;
+  nxmutex_init(&self->txlock);
 
-  /* The single write request just allocated is available now. */
+  /* The write requests just allocated are available now. */
 
-  ret = nxsem_init(&self->wrreq_idle, 0, 1);
+  ret = nxsem_init(&self->wrreq_idle, 0, CONFIG_CDCNCM_NWRREQS);
 
   if (ret != OK)
     {
@@ -2592,6 +2814,7 @@ static void cdcncm_unbind(FAR struct usbdevclass_driver_s *driver,
                           FAR struct usbdev_s *dev)
 {
   FAR struct cdcncm_driver_s *self = (FAR struct cdcncm_driver_s *)driver;
+  int i;
 
 #ifdef CONFIG_DEBUG_FEATURES
   if (!driver || !dev)
@@ -2631,12 +2854,17 @@ static void cdcncm_unbind(FAR struct usbdevclass_driver_s *driver,
    * been returned to the free list at this time -- we don't check)
    */
 
-  if (self->rdreq != NULL)
+  for (i = 0; i < CONFIG_CDCNCM_NRDREQS; i++)
     {
-      usbdev_freereq(self->epbulkout, self->rdreq);
-      self->rdreq = NULL;
+      if (self->rdreqs[i].req != NULL)
+        {
+          usbdev_freereq(self->epbulkout, self->rdreqs[i].req);
+          self->rdreqs[i].req = NULL;
+        }
     }
 
+  sq_init(&self->rxdone);
+
   /* Free the bulk OUT endpoint */
 
   if (self->epbulkout)
@@ -2649,12 +2877,21 @@ static void cdcncm_unbind(FAR struct usbdevclass_driver_s *driver,
    * of them)
    */
 
-  if (self->wrreq != NULL)
+  work_cancel(ETHWORK, &self->delaywork);
+  self->wrreq      = NULL;
+  self->dgramcount = 0;
+
+  for (i = 0; i < CONFIG_CDCNCM_NWRREQS; i++)
     {
-      usbdev_freereq(self->epbulkin, self->wrreq);
-      self->wrreq = NULL;
+      if (self->wrreqs[i].req != NULL)
+        {
+          usbdev_freereq(self->epbulkin, self->wrreqs[i].req);
+          self->wrreqs[i].req = NULL;
+        }
     }
 
+  sq_init(&self->txfree);
+
   /* Free the bulk IN endpoint */
 
   if (self->epbulkin)
@@ -28,6 +28,7 @@
 #include <fcntl.h>
 #include <poll.h>
 #include <stdio.h>
+#include <sys/uio.h>
 
 #include <nuttx/irq.h>
 #include <nuttx/nuttx.h>
@@ -53,7 +54,7 @@ struct usbdev_fs_req_s
 {
   sq_entry_t               node;    /* Implements a singly linked list */
   FAR struct usbdev_req_s *req;     /* The contained request */
-  uint16_t                 offset;  /* Offset to valid data in the RX request */
+  size_t                   offset;  /* Offset to valid data in the RX request */
 };
 
 struct usbdev_ctrlreq_s
@@ -76,6 +77,7 @@ struct usbdev_fs_ep_s
 {
   uint8_t                     crefs;      /* Count of opened instances */
   bool                        unlinked;   /* Indicates if the driver has been unlinked */
+  bool                        bulk;       /* Bulk endpoint with large requests */
   mutex_t                     lock;       /* Enforces device exclusive access */
   FAR struct usbdev_ep_s     *ep;         /* EP entry */
   FAR struct usbdev_fs_dev_s *dev;        /* USB device */
@@ -139,6 +141,10 @@ static ssize_t usbdev_fs_write(FAR struct file *filep,
                                FAR const char *buffer, size_t len);
 static int usbdev_fs_poll(FAR struct file *filep, FAR struct pollfd *fds,
                           bool setup);
+static ssize_t usbdev_fs_readv(FAR struct file *filep,
+                               FAR const struct iovec *iov, int iovcnt);
+static ssize_t usbdev_fs_writev(FAR struct file *filep,
+                                FAR const struct iovec *iov, int iovcnt);
 
 /****************************************************************************
  * Private Data
@@ -168,7 +174,12 @@ static const struct file_operations g_usbdev_fs_fops =
   NULL,            /* ioctl */
   NULL,            /* mmap */
   NULL,            /* truncate */
-  usbdev_fs_poll   /* poll */
+  usbdev_fs_poll,  /* poll */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  NULL,            /* unlink */
+#endif
+  usbdev_fs_readv, /* readv */
+  usbdev_fs_writev /* writev */
 };
 
 /****************************************************************************
@@ -203,6 +214,68 @@ static void usbdev_fs_notify(FAR struct usbdev_fs_ep_s *fs_ep,
   poll_notify(fs_ep->fds, CONFIG_USBDEV_FS_NPOLLWAITERS, eventset);
 }
 
+/****************************************************************************
+ * Name: usbdev_fs_reqlen
+ *
+ * Description:
+ *   Return the amount of data transferred by one request of an endpoint.
+ *
+ ****************************************************************************/
+
+static size_t usbdev_fs_reqlen(FAR struct usbdev_fs_ep_s *fs_ep)
+{
+  if (fs_ep->bulk)
+    {
+      return fs_ep->ep->maxpacket * CONFIG_USBDEV_FS_BULK_NPACKETS;
+    }
+
+  return fs_ep->ep->maxpacket;
+}
+
+/****************************************************************************
+ * Name: usbdev_fs_iovcopy
+ *
+ * Description:
+ *   Copy 'len' bytes between 'buf' and the buffers of 'iov', from 'offset'
+ *   bytes into the buffers.  Buffers without a base are skipped over.
+ *
+ ****************************************************************************/
+
+static void usbdev_fs_iovcopy(FAR const struct iovec *iov, int iovcnt,
+                              size_t offset, FAR void *buf, size_t len,
+                              bool toiov)
+{
+  FAR uint8_t *ptr = buf;
+  size_t ncopy;
+  int i;
+
+  for (i = 0; i < iovcnt && len > 0; i++)
+    {
+      if (offset >= iov[i].iov_len)
+        {
+          offset -= iov[i].iov_len;
+          continue;
+        }
+
+      ncopy = MIN(iov[i].iov_len - offset, len);
+      if (iov[i].iov_base != NULL)
+        {
+          if (toiov)
+            {
+              memcpy((FAR uint8_t *)iov[i].iov_base + offset, ptr, ncopy);
+            }
+          else
+            {
+              memcpy(ptr, (FAR uint8_t *)iov[i].iov_base + offset, ncopy);
+            }
+        }
+
+      ptr   += ncopy;
+      len   -= ncopy;
+      offset = 0;
+    }
+}
+
 /****************************************************************************
  * Name: usbdev_fs_submit_wrreq
  *
@@ -213,7 +286,7 @@ static void usbdev_fs_notify(FAR struct usbdev_fs_ep_s *fs_ep,
 
 static int usbdev_fs_submit_wrreq(FAR struct usbdev_ep_s *ep,
                                   FAR struct usbdev_fs_req_s *container,
-                                  uint16_t len)
+                                  size_t len)
 {
   FAR struct usbdev_req_s *req = container->req;
 
@@ -236,7 +309,7 @@ static int usbdev_fs_submit_rdreq(FAR struct usbdev_ep_s *ep,
 {
   FAR struct usbdev_req_s *req = container->req;
 
-  req->len = ep->maxpacket;
+  req->len = usbdev_fs_reqlen(ep->fs);
   return EP_SUBMIT(ep, req);
 }
 
@@ -564,14 +637,40 @@ static int usbdev_fs_close(FAR struct file *filep)
 
 static ssize_t usbdev_fs_read(FAR struct file *filep, FAR char *buffer,
                               size_t len)
+{
+  struct iovec iov;
+
+  iov.iov_base = buffer;
+  iov.iov_len  = len;
+  return usbdev_fs_readv(filep, &iov, 1);
+}
+
+/****************************************************************************
+ * Name: usbdev_fs_readv
+ *
+ * Description:
+ *   Read usbdev fs device into the buffers of 'iov', as if they were a
+ *   single buffer.
+ *
+ ****************************************************************************/
+
+static ssize_t usbdev_fs_readv(FAR struct file *filep,
+                               FAR const struct iovec *iov, int iovcnt)
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct usbdev_fs_ep_s *fs_ep = inode->i_private;
   FAR struct sq_queue_s *queue;
   bool is_ep0 = false;
   size_t retlen = 0;
+  size_t len = 0;
   irqstate_t flags;
   int ret;
+  int i;
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      len += iov[i].iov_len;
+    }
 
   ret = nxmutex_lock(&fs_ep->lock);
   if (ret < 0)
@@ -623,7 +722,7 @@ static ssize_t usbdev_fs_read(FAR struct file *filep, FAR char *buffer,
   while (!sq_empty(queue))
     {
       FAR struct usbdev_fs_req_s *container;
-      uint16_t reqlen;
+      size_t reqlen;
 
       if (is_ep0)
         {
@@ -638,10 +737,8 @@ static ssize_t usbdev_fs_read(FAR struct file *filep, FAR char *buffer,
 
           /* Output buffer full */
 
-          if (buffer != NULL)
-            {
-              memcpy(buffer, &ctrl_container->req, retlen);
-            }
+          usbdev_fs_iovcopy(iov, iovcnt, 0, &ctrl_container->req, retlen,
+                            true);
 
           flags = enter_critical_section();
           sq_remfirst(queue);
@@ -662,23 +759,18 @@ static ssize_t usbdev_fs_read(FAR struct file *filep, FAR char *buffer,
         {
           /* Output buffer full */
 
-          if (buffer != NULL)
-            {
-              memcpy(&buffer[retlen],
-                     &container->req->buf[container->offset],
-                     len);
-            }
+          usbdev_fs_iovcopy(iov, iovcnt, retlen,
+                            &container->req->buf[container->offset],
+                            len, true);
 
           container->offset += len;
           retlen += len;
           break;
         }
 
-      if (buffer != NULL)
-        {
-          memcpy(&buffer[retlen],
-                 &container->req->buf[container->offset], reqlen);
-        }
+      usbdev_fs_iovcopy(iov, iovcnt, retlen,
+                        &container->req->buf[container->offset], reqlen,
+                        true);
 
       retlen += reqlen;
       len -= reqlen;
@@ -706,7 +798,7 @@ static ssize_t usbdev_fs_read(FAR struct file *filep, FAR char *buffer,
        * returned directly.
        */
 
-      if (reqlen < fs_ep->ep->maxpacket)
+      if (reqlen < container->req->len)
         {
           break;
         }
@@ -726,14 +818,42 @@ static ssize_t usbdev_fs_read(FAR struct file *filep, FAR char *buffer,
 
 static ssize_t usbdev_fs_write(FAR struct file *filep,
                                FAR const char *buffer, size_t len)
+{
+  struct iovec iov;
+
+  iov.iov_base = (FAR void *)buffer;
+  iov.iov_len  = len;
+  return usbdev_fs_writev(filep, &iov, 1);
+}
+
+/****************************************************************************
+ * Name: usbdev_fs_writev
+ *
+ * Description:
+ *   Write the buffers of 'iov' to usbdev fs device as a single transfer:
+ *   The data of the buffers is packed in the requests, so that only the
+ *   end of the transfer may be a short packet.
+ *
+ ****************************************************************************/
+
+static ssize_t usbdev_fs_writev(FAR struct file *filep,
+                                FAR const struct iovec *iov, int iovcnt)
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct usbdev_fs_ep_s *fs_ep = inode->i_private;
   FAR struct usbdev_fs_req_s *container;
   FAR struct usbdev_req_s *req;
   irqstate_t flags;
-  int wlen = 0;
+  ssize_t wlen = 0;
+  size_t reqlen;
+  size_t len = 0;
   int ret;
+  int i;
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      len += iov[i].iov_len;
+    }
 
   ret = nxmutex_lock(&fs_ep->lock);
   if (ret < 0)
@@ -775,9 +895,10 @@ static ssize_t usbdev_fs_write(FAR struct file *filep,
 
   /* Device ready for write */
 
+  reqlen = usbdev_fs_reqlen(fs_ep);
   while (!sq_empty(&fs_ep->reqq))
     {
-      uint16_t cur_len;
+      size_t cur_len;
 
       /* Get available TX request slot */
 
@@ -792,16 +913,16 @@ static ssize_t usbdev_fs_write(FAR struct file *filep,
 
       /* Fill the request with data */
 
-      if (len > fs_ep->ep->maxpacket)
+      if (len > reqlen)
         {
-          cur_len = fs_ep->ep->maxpacket;
+          cur_len = reqlen;
         }
       else
         {
           cur_len = len;
         }
 
-      memcpy(req->buf, &buffer[wlen], cur_len);
+      usbdev_fs_iovcopy(iov, iovcnt, wlen, req->buf, cur_len, false);
 
       /* Then submit the request to the endpoint */
 
@@ -1059,6 +1180,15 @@ static int usbdev_fs_ep_bind(FAR struct usbdev_s *dev, uint8_t epno,
     }
 #endif
 
+  /* The requests of the bulk endpoints hold several packets */
+
+  fs_ep->bulk = epno != 0 && (epinfo->desc.attr & USB_EP_ATTR_XFERTYPE_MASK)
+                == USB_EP_ATTR_XFER_BULK;
+  if (fs_ep->bulk)
+    {
+      reqsize *= CONFIG_USBDEV_FS_BULK_NPACKETS;
+    }
+
   fs_ep->ep->fs = fs_ep;
 
   /* Initialize request buffer */
@@ -2208,6 +2208,47 @@ static int usbmsc_cmdparsestate(FAR struct usbmsc_dev_s *priv)
   return ret;
 }
 
+/****************************************************************************
+ * Name: usbmsc_rdsectors
+ *
+ * Description:
+ *   Return the number of sectors that the next read of the block driver
+ *   may place directly in a write request, zero if the sectors must be
+ *   copied through iobuffer[].  The host ends the data phase on the first
+ *   short packet, so only the last request of the transfer may be shorter
+ *   than a multiple of the bulk IN packet size.
+ *
+ ****************************************************************************/
+
+static uint32_t usbmsc_rdsectors(FAR struct usbmsc_dev_s *priv)
+{
+  uint16_t sectorsize = priv->lun->sectorsize;
+  uint16_t maxpacket = priv->epbulkin->maxpacket;
+  uint32_t unit;
+  uint32_t nsect;
+
+  if (sectorsize % maxpacket == 0)
+    {
+      unit = 1;
+    }
+  else if (maxpacket % sectorsize == 0)
+    {
+      unit = maxpacket / sectorsize;
+    }
+  else
+    {
+      return 0;
+    }
+
+  nsect = MIN(priv->u.xfrlen, CONFIG_USBMSC_BULKINREQLEN / sectorsize);
+  if (nsect < priv->u.xfrlen)
+    {
+      nsect -= nsect % unit;
+    }
+
+  return nsect;
+}
+
 /****************************************************************************
  * Name: usbmsc_cmdreadstate
  *
@@ -2232,6 +2273,11 @@ static int usbmsc_cmdparsestate(FAR struct usbmsc_dev_s *priv)
  *   nreqbytes  - holds the number of bytes currently buffered in the request
  *                at the head of the wrreqlist.
  *
+ *   Whenever both buffers are empty, as many sectors as fit in a write
+ *   request are read into it at once and it is submitted as is:  The block
+ *   driver then fills each request while the ones submitted before are
+ *   sent to the host.
+ *
  ****************************************************************************/
 
 static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
@@ -2243,6 +2289,7 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
   ssize_t nread;
   FAR uint8_t *src;
   FAR uint8_t *dest;
+  uint32_t nsect;
   int nbytes;
   int ret;
 
@@ -2255,6 +2302,59 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
     {
       usbtrace(TRACE_CLASSSTATE(USBMSC_CLASSSTATE_CMDREAD), priv->u.xfrlen);
 
+      /* Can the next sectors be read directly into a request? */
+
+      nsect = 0;
+      if (priv->nsectbytes <= 0 && priv->nreqbytes <= 0)
+        {
+          nsect = usbmsc_rdsectors(priv);
+        }
+
+      if (nsect > 0)
+        {
+          privreq = (FAR struct usbmsc_req_s *)sq_peek(&priv->wrreqlist);
+          if (!privreq)
+            {
+              usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_CMDREADWRRQEMPTY), 0);
+              return -ENOMEM;
+            }
+
+          req   = privreq->req;
+          nread = USBMSC_DRVR_READ(lun, req->buf, priv->sector, nsect);
+          if (nread != (ssize_t)nsect)
+            {
+              usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_CMDREADREADFAIL),
+                       nread < 0 ? -nread : EIO);
+              lun->sd     = SCSI_KCQME_UNRRE1;
+              lun->sdinfo = priv->sector;
+              break;
+            }
+
+          flags = enter_critical_section();
+          privreq = (FAR struct usbmsc_req_s *)sq_remfirst(&priv->wrreqlist);
+          leave_critical_section(flags);
+
+          req->len      = nsect * lun->sectorsize;
+          req->priv     = privreq;
+          req->callback = usbmsc_wrcomplete;
+          req->flags    = 0;
+
+          ret           = EP_SUBMIT(priv->epbulkin, req);
+          if (ret != OK)
+            {
+              usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_CMDREADSUBMIT),
+                       (uint16_t)-ret);
+              lun->sd     = SCSI_KCQME_UNRRE1;
+              lun->sdinfo = priv->sector;
+              break;
+            }
+
+          priv->u.xfrlen -= nsect;
+          priv->sector   += nsect;
+          priv->residue  -= req->len;
+          continue;
+        }
+
       /* Is the I/O buffer empty? */
 
       if (priv->nsectbytes <= 0)
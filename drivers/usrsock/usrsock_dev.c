@@ -56,16 +56,23 @@
  * Private Types
  ****************************************************************************/
 
+struct usrsockdev_req_s
+{
+  FAR const struct iovec *iov;    /* Pending request buffers */
+  int                     iovcnt; /* Number of request buffers */
+  size_t                  pos;    /* Reader position on request buffer */
+  uint32_t                xid;    /* Exchange id of the request */
+};
+
 struct usrsockdev_s
 {
   mutex_t devlock; /* Lock for device node */
   uint8_t ocount;  /* The number of times the device has been opened */
-  struct
-  {
-    FAR const struct iovec *iov;    /* Pending request buffers */
-    int                     iovcnt; /* Number of request buffers */
-    size_t                  pos;    /* Reader position on request buffer */
-  } req;
+  uint8_t nreqs;   /* The number of queued requests */
+
+  /* The queued requests, in order.  The first one is read by the daemon */
+
+  struct usrsockdev_req_s req[CONFIG_NET_USRSOCK_NREQUESTS];
   FAR struct pollfd *pollfds[CONFIG_NET_USRSOCKDEV_NPOLLWAITERS];
 };
 
@@ -128,6 +135,35 @@ static bool usrsockdev_is_opened(FAR struct usrsockdev_s *dev)
   return ret;
 }
 
+/****************************************************************************
+ * Name: usrsockdev_is_read
+ *
+ * Description:
+ *   Return true if the daemon read a request up to its end.
+ *
+ ****************************************************************************/
+
+static bool usrsockdev_is_read(FAR struct usrsockdev_req_s *req)
+{
+  return usrsock_iovec_get(NULL, 0, req->iov, req->iovcnt, req->pos,
+                           NULL) < 0;
+}
+
+/****************************************************************************
+ * Name: usrsockdev_remove
+ *
+ * Description:
+ *   Remove a request from the queue.
+ *
+ ****************************************************************************/
+
+static void usrsockdev_remove(FAR struct usrsockdev_s *dev, int index)
+{
+  dev->nreqs--;
+  memmove(&dev->req[index], &dev->req[index + 1],
+          (dev->nreqs - index) * sizeof(struct usrsockdev_req_s));
+}
+
 /****************************************************************************
  * Name: usrsockdev_read
  ****************************************************************************/
@@ -159,16 +195,26 @@ static ssize_t usrsockdev_read(FAR struct file *filep, FAR char *buffer,
       return ret;
     }
 
+  /* Go on with the next request once the current one is read up to its
+   * end.  The last request stays until it is answered.
+   */
+
+  if (dev->nreqs > 1 && usrsockdev_is_read(&dev->req[0]))
+    {
+      usrsockdev_remove(dev, 0);
+    }
+
   /* Is request available? */
 
-  if (dev->req.iov)
+  if (dev->nreqs > 0)
     {
+      FAR struct usrsockdev_req_s *req = &dev->req[0];
       ssize_t rlen;
 
       /* Copy request to user-space. */
 
-      rlen = usrsock_iovec_get(buffer, len, dev->req.iov, dev->req.iovcnt,
-                               dev->req.pos, NULL);
+      rlen = usrsock_iovec_get(buffer, len, req->iov, req->iovcnt,
+                               req->pos, NULL);
       if (rlen < 0)
         {
           /* Tried reading beyond buffer. */
@@ -177,7 +223,7 @@ static ssize_t usrsockdev_read(FAR struct file *filep, FAR char *buffer,
         }
       else
         {
-          dev->req.pos += rlen;
+          req->pos += rlen;
           len = rlen;
         }
     }
@@ -219,13 +265,14 @@ static off_t usrsockdev_seek(FAR struct file *filep, off_t offset,
 
   /* Is request available? */
 
-  if (dev->req.iov)
+  if (dev->nreqs > 0)
     {
+      FAR struct usrsockdev_req_s *req = &dev->req[0];
       ssize_t rlen;
 
       if (whence == SEEK_CUR)
         {
-          pos = dev->req.pos + offset;
+          pos = req->pos + offset;
         }
       else
         {
@@ -234,8 +281,7 @@ static off_t usrsockdev_seek(FAR struct file *filep, off_t offset,
 
       /* Copy request to user-space. */
 
-      rlen = usrsock_iovec_get(NULL, 0, dev->req.iov, dev->req.iovcnt,
-                               pos, NULL);
+      rlen = usrsock_iovec_get(NULL, 0, req->iov, req->iovcnt, pos, NULL);
       if (rlen < 0)
         {
           /* Tried seek beyond buffer. */
@@ -244,7 +290,7 @@ static off_t usrsockdev_seek(FAR struct file *filep, off_t offset,
         }
       else
         {
-          dev->req.pos = pos;
+          req->pos = pos;
         }
     }
   else
@@ -265,8 +311,9 @@ static ssize_t usrsockdev_write(FAR struct file *filep,
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct usrsockdev_s *dev;
-  bool req_done = false;
+  ssize_t total = 0;
   ssize_t ret = 0;
+  int i;
 
   if (len == 0)
     {
@@ -288,16 +335,44 @@ static ssize_t usrsockdev_write(FAR struct file *filep,
       return ret;
     }
 
-  ret = usrsock_response(buffer, len, &req_done);
-  if (req_done && dev->req.iov)
+  /* The daemon may write several responses and events at once */
+
+  while (len > 0)
     {
-      dev->req.iov = NULL;
-      dev->req.pos = 0;
-      dev->req.iovcnt = 0;
+      bool req_done = false;
+
+      ret = usrsock_response(buffer, len, &req_done);
+      if (ret <= 0)
+        {
+          break;
+        }
+
+      /* The answered request is at the start of the message, remove it
+       * from the queue if the daemon did not read it up to its end.
+       */
+
+      if (req_done)
+        {
+          FAR const struct usrsock_message_req_ack_s *hdr =
+            (FAR const struct usrsock_message_req_ack_s *)buffer;
+
+          for (i = 0; i < dev->nreqs; i++)
+            {
+              if (dev->req[i].xid == hdr->xid)
+                {
+                  usrsockdev_remove(dev, i);
+                  break;
+                }
+            }
+        }
+
+      buffer += ret;
+      len    -= ret;
+      total  += ret;
     }
 
   nxmutex_unlock(&dev->devlock);
-  return ret;
+  return total > 0 ? total : ret;
 }
 
 /****************************************************************************
@@ -371,9 +446,7 @@ static int usrsockdev_close(FAR struct file *filep)
   dev->ocount--;
   DEBUGASSERT(dev->ocount == 0);
   ret = OK;
-  dev->req.iov = NULL;
-  dev->req.iovcnt = 0;
-  dev->req.pos = 0;
+  dev->nreqs = 0;
 
   nxmutex_unlock(&dev->devlock);
   usrsock_abort();
@@ -443,9 +516,8 @@ static int usrsockdev_poll(FAR struct file *filep, FAR struct pollfd *fds,
 
       /* Notify the POLLIN event if pending request. */
 
-      if (dev->req.iov != NULL &&
-          !(usrsock_iovec_get(NULL, 0, dev->req.iov,
-                              dev->req.iovcnt, dev->req.pos, NULL) < 0))
+      if (dev->nreqs > 1 ||
+          (dev->nreqs == 1 && !usrsockdev_is_read(&dev->req[0])))
         {
           poll_notify(&fds, 1, POLLIN);
         }
@@ -492,10 +564,14 @@ int usrsock_request(FAR struct iovec *iov, unsigned int iovcnt)
 
   if (usrsockdev_is_opened(dev))
     {
-      DEBUGASSERT(dev->req.iov == NULL);
-      dev->req.iov = iov;
-      dev->req.pos = 0;
-      dev->req.iovcnt = iovcnt;
+      FAR struct usrsockdev_req_s *req = &dev->req[dev->nreqs++];
+
+      DEBUGASSERT(dev->nreqs <= CONFIG_NET_USRSOCK_NREQUESTS);
+      req->iov    = iov;
+      req->pos    = 0;
+      req->iovcnt = iovcnt;
+      req->xid    = ((FAR struct usrsock_request_common_s *)
+                     iov[0].iov_base)->xid;
 
       /* Notify daemon of new request. */
 
@@ -86,7 +86,7 @@ static int usrsock_rpmsg_send_dns_request(FAR void *arg,
   uint32_t len;
   int ret;
 
-  dns = rpmsg_get_tx_payload_buffer(ept, &len, true);
+  dns = rpmsg_reserve(ept, NULL, &len);
   if (dns == NULL)
     {
       return -ENOMEM;
@@ -98,12 +98,8 @@ static int usrsock_rpmsg_send_dns_request(FAR void *arg,
   memcpy(dns + 1, addr, addrlen);
 
   net_lock();
-  ret = rpmsg_send_nocopy(ept, dns, sizeof(*dns) + addrlen);
+  ret = rpmsg_commit(ept, dns, sizeof(*dns) + addrlen);
   net_unlock();
-  if (ret < 0)
-    {
-      rpmsg_release_tx_buffer(ept, dns);
-    }
 
   return ret;
 }
@@ -212,7 +208,7 @@ int usrsock_request(FAR struct iovec *iov, unsigned int iovcnt)
       uint32_t len;
       bool done;
 
-      buf = rpmsg_get_tx_payload_buffer(&priv->ept, &len, true);
+      buf = rpmsg_reserve(&priv->ept, NULL, &len);
       if (buf == NULL)
         {
           ret = -ENOMEM;
@@ -226,10 +222,9 @@ int usrsock_request(FAR struct iovec *iov, unsigned int iovcnt)
         }
 
       pos += ret;
-      ret = rpmsg_send_nocopy(&priv->ept, buf, ret);
+      ret = rpmsg_commit(&priv->ept, buf, ret);
       if (ret < 0)
         {
-          rpmsg_release_tx_buffer(&priv->ept, buf);
           break;
         }
 
@@ -227,8 +227,6 @@ static int usrsock_rpmsg_send_data_ack(FAR struct rpmsg_endpoint *ept,
                               uint16_t valuelen_nontrunc,
                               int32_t datalen)
 {
-  int ret;
-
   ack->reqack.head.msgid  = USRSOCK_MESSAGE_RESPONSE_DATA_ACK;
   ack->reqack.head.flags  = 0;
   ack->reqack.head.events = events;
@@ -250,13 +248,7 @@ static int usrsock_rpmsg_send_data_ack(FAR struct rpmsg_endpoint *ept,
   ack->valuelen          = valuelen;
   ack->valuelen_nontrunc = valuelen_nontrunc;
 
-  ret = rpmsg_send_nocopy(ept, ack, sizeof(*ack) + valuelen + datalen);
-  if (ret < 0)
-    {
-      rpmsg_release_tx_buffer(ept, ack);
-    }
-
-  return ret;
+  return rpmsg_commit(ept, ack, sizeof(*ack) + valuelen + datalen);
 }
 
 static int usrsock_rpmsg_send_frag_ack(FAR struct rpmsg_endpoint *ept,
@@ -272,7 +264,7 @@ static int usrsock_rpmsg_send_frag_ack(FAR struct rpmsg_endpoint *ept,
   ack->reqack.result      = result;
   ack->datalen            = datalen;
 
-  return rpmsg_send_nocopy(ept, ack, sizeof(*ack) + datalen);
+  return rpmsg_commit(ept, ack, sizeof(*ack) + datalen);
 }
 
 static int usrsock_rpmsg_send_event(FAR struct rpmsg_endpoint *ept,
@@ -572,7 +564,7 @@ static int usrsock_rpmsg_recvfrom_handler(FAR struct rpmsg_endpoint *ept,
   uint8_t i = 0;
   int retr;
 
-  ack = rpmsg_get_tx_payload_buffer(ept, &len, true);
+  ack = rpmsg_reserve(ept, NULL, &len);
   if (sizeof(*ack) + inaddrlen + buflen < len)
     {
       len = sizeof(*ack) + inaddrlen + buflen;
@@ -725,7 +717,7 @@ static int usrsock_rpmsg_getsockopt_handler(FAR struct rpmsg_endpoint *ept,
   int ret = -EBADF;
   uint32_t len;
 
-  ack = rpmsg_get_tx_payload_buffer(ept, &len, true);
+  ack = rpmsg_reserve(ept, NULL, &len);
   if (req->usockid >= 0 &&
       req->usockid < CONFIG_NET_USRSOCK_RPMSG_SERVER_NSOCKS)
     {
@@ -749,7 +741,7 @@ static int usrsock_rpmsg_getsockname_handler(FAR struct rpmsg_endpoint *ept,
   int ret = -EBADF;
   uint32_t len;
 
-  ack = rpmsg_get_tx_payload_buffer(ept, &len, true);
+  ack = rpmsg_reserve(ept, NULL, &len);
   if (req->usockid >= 0 &&
       req->usockid < CONFIG_NET_USRSOCK_RPMSG_SERVER_NSOCKS)
     {
@@ -773,7 +765,7 @@ static int usrsock_rpmsg_getpeername_handler(FAR struct rpmsg_endpoint *ept,
   int ret = -EBADF;
   uint32_t len;
 
-  ack = rpmsg_get_tx_payload_buffer(ept, &len, true);
+  ack = rpmsg_reserve(ept, NULL, &len);
   if (req->usockid >= 0 &&
       req->usockid < CONFIG_NET_USRSOCK_RPMSG_SERVER_NSOCKS)
     {
@@ -841,7 +833,7 @@ static int usrsock_rpmsg_accept_handler(FAR struct rpmsg_endpoint *ept,
   int i = 0;
   int retr;
 
-  ack = rpmsg_get_tx_payload_buffer(ept, &len, true);
+  ack = rpmsg_reserve(ept, NULL, &len);
   if (req->usockid >= 0 &&
       req->usockid < CONFIG_NET_USRSOCK_RPMSG_SERVER_NSOCKS)
     {
@@ -915,7 +907,7 @@ static int usrsock_rpmsg_ioctl_handler(FAR struct rpmsg_endpoint *ept,
   int ret = -EBADF;
   uint32_t len;
 
-  ack = rpmsg_get_tx_payload_buffer(ept, &len, true);
+  ack = rpmsg_reserve(ept, NULL, &len);
   if (req->usockid >= 0 &&
       req->usockid < CONFIG_NET_USRSOCK_RPMSG_SERVER_NSOCKS)
     {
@@ -987,9 +979,8 @@ static int usrsock_rpmsg_send_dns_event(FAR void *arg,
   FAR struct rpmsg_endpoint *ept = arg;
   FAR struct usrsock_rpmsg_dns_event_s *dns;
   uint32_t len;
-  int ret;
 
-  dns = rpmsg_get_tx_payload_buffer(ept, &len, true);
+  dns = rpmsg_reserve(ept, NULL, &len);
   if (dns == NULL)
     {
       return -ENOMEM;
@@ -1001,13 +992,7 @@ static int usrsock_rpmsg_send_dns_event(FAR void *arg,
   dns->addrlen = addrlen;
   memcpy(dns + 1, addr, addrlen);
 
-  ret = rpmsg_send_nocopy(ept, dns, sizeof(*dns) + addrlen);
-  if (ret < 0)
-    {
-      rpmsg_release_tx_buffer(ept, dns);
-    }
-
-  return ret;
+  return rpmsg_commit(ept, dns, sizeof(*dns) + addrlen);
 }
 #endif
 
@@ -33,6 +33,7 @@
 #include <assert.h>
 #include <debug.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <poll.h>
 
 #include <nuttx/irq.h>
@@ -67,6 +68,10 @@ struct fb_priv_s
 #ifdef CONFIG_FB_SYNC
   sem_t wait;
 #endif
+
+#ifdef CONFIG_VIDEO_FB_SWAPCHAIN
+  uint32_t acquired;              /* Buffers acquired by this open */
+#endif
 };
 
 struct fb_paninfo_s
@@ -76,6 +81,19 @@ struct fb_paninfo_s
   struct wdog_s wdog;             /* VSync offset timer */
 
   FAR struct fb_chardev_s *dev;
+
+#ifdef CONFIG_VIDEO_FB_SWAPCHAIN
+  /* The swap chain of the screens of the virtual resolution */
+
+  sem_t swapwait;                 /* Waits for a buffer or a fence */
+  uint32_t yres;                  /* Height of a buffer in rows */
+  uint32_t acquired;              /* Buffers being rendered */
+  uint32_t queued;                /* Buffers waiting for the vsync */
+  uint32_t nqueued;               /* Pans queued, the last fence */
+  uint32_t nflips;                /* Pans displayed, the signalled fence */
+  uint8_t nbuffers;               /* Buffers of the swap chain */
+  uint8_t front;                  /* Buffer being displayed */
+#endif
 };
 
 /* This structure defines one framebuffer device.  Note that which is
@@ -100,6 +118,7 @@ struct fb_panelinfo_s
   size_t fblen;                   /* Size of the framebuffer */
   uint8_t fbcount;                /* Count of frame buffer */
   uint8_t bpp;                    /* Bits per pixel */
+  uint32_t yres;                  /* Height of a frame buffer */
 };
 
 /****************************************************************************
@@ -137,6 +156,20 @@ static int     fb_sem_wait(FAR struct fb_chardev_s *fb,
                            int overlay);
 static void    fb_sem_post(FAR struct fb_chardev_s *fb, int overlay);
 #endif
+#ifdef CONFIG_VIDEO_FB_SWAPCHAIN
+static void    fb_swap_wakeup(FAR struct fb_paninfo_s *paninfo);
+static int     fb_swap_acquire(FAR struct fb_chardev_s *fb,
+                               FAR struct fb_priv_s *priv, bool nonblock,
+                               FAR struct fb_swapbuf_s *buf);
+static int     fb_swap_present(FAR struct fb_chardev_s *fb,
+                               FAR struct fb_priv_s *priv,
+                               FAR struct fb_swapbuf_s *buf);
+static int     fb_swap_release(FAR struct fb_chardev_s *fb,
+                               FAR struct fb_priv_s *priv, uint32_t mask);
+static int     fb_swap_waitfence(FAR struct fb_chardev_s *fb,
+                                 FAR struct fb_priv_s *priv, bool nonblock,
+                                 uint32_t fence);
+#endif
 
 #ifdef CONFIG_BUILD_KERNEL
 static int     fb_munmap(FAR struct task_group_s *group,
@@ -213,6 +246,12 @@ static int fb_add_paninfo(FAR struct fb_chardev_s *fb,
     {
       gwarn("WARNING: circbuf_write(panbuf) failed\n");
     }
+#ifdef CONFIG_VIDEO_FB_SWAPCHAIN
+  else
+    {
+      fb->paninfo[overlay + 1].nqueued++;
+    }
+#endif
 
   /* Re-enable interrupts */
 
@@ -247,6 +286,14 @@ static int fb_clear_paninfo(FAR struct fb_chardev_s *fb,
 
   circbuf_reset(panbuf);
 
+#ifdef CONFIG_VIDEO_FB_SWAPCHAIN
+  /* The queued buffers are free again, and their fences signalled */
+
+  fb->paninfo[overlay + 1].queued = 0;
+  fb->paninfo[overlay + 1].nflips = fb->paninfo[overlay + 1].nqueued;
+  fb_swap_wakeup(&fb->paninfo[overlay + 1]);
+#endif
+
   /* Re-enable interrupts */
 
   leave_critical_section(flags);
@@ -354,6 +401,12 @@ static int fb_close(FAR struct file *filep)
 
   DEBUGASSERT(curr);
 
+#ifdef CONFIG_VIDEO_FB_SWAPCHAIN
+  /* Give back the buffers acquired and not presented */
+
+  fb_swap_release(fb, priv, priv->acquired);
+#endif
+
   /* Remove the structure from the device */
 
   if (prev)
@@ -741,6 +794,16 @@ static int fb_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
               break;
             }
 
+#ifdef CONFIG_VIDEO_FB_SWAPCHAIN
+          /* The acquired buffers belong to the overlay selected */
+
+          if (priv->acquired != 0)
+            {
+              ret = -EBUSY;
+              break;
+            }
+#endif
+
           if (arg != FB_NO_OVERLAY)
             {
               memset(&oinfo, 0, sizeof(oinfo));
@@ -1004,6 +1067,53 @@ static int fb_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+#ifdef CONFIG_VIDEO_FB_SWAPCHAIN
+      case FBIO_ACQUIRE:
+        {
+          FAR struct fb_swapbuf_s *buf =
+            (FAR struct fb_swapbuf_s *)((uintptr_t)arg);
+
+          DEBUGASSERT(buf != NULL);
+          ret = fb_swap_acquire(fb, filep->f_priv,
+                                (filep->f_oflags & O_NONBLOCK) != 0, buf);
+        }
+        break;
+
+      case FBIO_PRESENT:
+        {
+          FAR struct fb_swapbuf_s *buf =
+            (FAR struct fb_swapbuf_s *)((uintptr_t)arg);
+
+          DEBUGASSERT(buf != NULL);
+          ret = fb_swap_present(fb, filep->f_priv, buf);
+        }
+        break;
+
+      case FBIO_RELEASE:
+        {
+          FAR struct fb_swapbuf_s *buf =
+            (FAR struct fb_swapbuf_s *)((uintptr_t)arg);
+
+          DEBUGASSERT(buf != NULL);
+          if (buf->index >= 32)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          ret = fb_swap_release(fb, filep->f_priv, 1u << buf->index);
+        }
+        break;
+
+      case FBIO_WAITFENCE:
+        {
+          ret = fb_swap_waitfence(fb, filep->f_priv,
+                                  (filep->f_oflags & O_NONBLOCK) != 0,
+                                  (uint32_t)arg);
+        }
+        break;
+#endif
+
       case FBIOGET_VSCREENINFO:
         {
           struct fb_videoinfo_s vinfo;
@@ -1320,6 +1430,7 @@ static int fb_get_panelinfo(FAR struct fb_chardev_s *fb,
       panelinfo->fbcount = oinfo.yres_virtual == 0 ?
                            1 : (oinfo.yres_virtual / oinfo.yres);
       panelinfo->bpp     = oinfo.bpp;
+      panelinfo->yres    = oinfo.yres;
       return OK;
     }
 #endif
@@ -1342,6 +1453,7 @@ static int fb_get_panelinfo(FAR struct fb_chardev_s *fb,
   panelinfo->fbcount = pinfo.yres_virtual == 0 ?
                        1 : (pinfo.yres_virtual / vinfo.yres);
   panelinfo->bpp     = pinfo.bpp;
+  panelinfo->yres    = vinfo.yres;
 
   return OK;
 }
@@ -1472,6 +1584,289 @@ static void fb_sem_post(FAR struct fb_chardev_s *fb, int overlay)
 }
 #endif
 
+#ifdef CONFIG_VIDEO_FB_SWAPCHAIN
+/****************************************************************************
+ * Name: fb_get_swapchain
+ *
+ * Description:
+ *   Return the swap chain of an overlay, NULL if it has a single buffer.
+ *
+ ****************************************************************************/
+
+static FAR struct fb_paninfo_s *
+fb_get_swapchain(FAR struct fb_chardev_s *fb, int overlay)
+{
+  int id = overlay + 1;
+
+  if (id < 0 || id >= fb->paninfo_count || fb->paninfo[id].nbuffers < 2)
+    {
+      return NULL;
+    }
+
+  return &fb->paninfo[id];
+}
+
+/****************************************************************************
+ * Name: fb_swap_wakeup
+ *
+ * Description:
+ *   Wake up the threads waiting for a buffer or a fence of a swap chain.
+ *   Called in a critical section.
+ *
+ ****************************************************************************/
+
+static void fb_swap_wakeup(FAR struct fb_paninfo_s *paninfo)
+{
+  int semcount;
+
+  for (; ; )
+    {
+      semcount = 0;
+      sem_getvalue(&paninfo->swapwait, &semcount);
+      if (semcount >= 0)
+        {
+          break;
+        }
+
+      nxsem_post(&paninfo->swapwait);
+    }
+}
+
+/****************************************************************************
+ * Name: fb_swap_acquire
+ *
+ * Description:
+ *   Acquire a buffer that is neither displayed, queued nor acquired,
+ *   waiting for the vertical sync to free one if necessary.  The buffers
+ *   are handed out in turn after the one displayed.
+ *
+ ****************************************************************************/
+
+static int fb_swap_acquire(FAR struct fb_chardev_s *fb,
+                           FAR struct fb_priv_s *priv, bool nonblock,
+                           FAR struct fb_swapbuf_s *buf)
+{
+  FAR struct fb_paninfo_s *paninfo;
+  irqstate_t flags;
+  uint32_t avail;
+  uint8_t index;
+  int ret = OK;
+  int i;
+
+  paninfo = fb_get_swapchain(fb, priv->overlay);
+  if (paninfo == NULL)
+    {
+      return -ENOTTY;
+    }
+
+  flags = enter_critical_section();
+
+  for (; ; )
+    {
+      avail = (UINT32_MAX >> (32 - paninfo->nbuffers)) &
+              ~(paninfo->acquired | paninfo->queued |
+                (1u << paninfo->front));
+      if (avail != 0)
+        {
+          break;
+        }
+
+      if (nonblock)
+        {
+          ret = -EAGAIN;
+          goto errout;
+        }
+
+      ret = nxsem_wait(&paninfo->swapwait);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+    }
+
+  for (i = 1; ; i++)
+    {
+      index = (paninfo->front + i) % paninfo->nbuffers;
+      if ((avail & (1u << index)) != 0)
+        {
+          break;
+        }
+    }
+
+  paninfo->acquired |= 1u << index;
+  priv->acquired    |= 1u << index;
+
+  buf->index   = index;
+  buf->yoffset = index * paninfo->yres;
+  buf->fence   = paninfo->nflips;
+
+errout:
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: fb_swap_present
+ *
+ * Description:
+ *   Queue an acquired buffer to be displayed at the next vertical sync, and
+ *   return its fence.
+ *
+ ****************************************************************************/
+
+static int fb_swap_present(FAR struct fb_chardev_s *fb,
+                           FAR struct fb_priv_s *priv,
+                           FAR struct fb_swapbuf_s *buf)
+{
+  FAR struct fb_paninfo_s *paninfo;
+  union fb_paninfo_u info;
+  irqstate_t flags;
+  uint32_t bit;
+  int ret;
+
+  paninfo = fb_get_swapchain(fb, priv->overlay);
+  if (paninfo == NULL)
+    {
+      return -ENOTTY;
+    }
+
+  bit = 1u << buf->index;
+  if (buf->index >= paninfo->nbuffers || (priv->acquired & bit) == 0)
+    {
+      return -EINVAL;
+    }
+
+  memset(&info, 0, sizeof(info));
+
+#ifdef CONFIG_FB_OVERLAY
+  if (priv->overlay != FB_NO_OVERLAY)
+    {
+      ret = fb->vtable->getoverlayinfo(fb->vtable, priv->overlay,
+                                       &info.overlayinfo);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      info.overlayinfo.yoffset = buf->index * paninfo->yres;
+      if (fb->vtable->panoverlay != NULL)
+        {
+          fb->vtable->panoverlay(fb->vtable, &info.overlayinfo);
+        }
+    }
+  else
+#endif
+    {
+      ret = fb_get_planeinfo(fb, &info.planeinfo, 0);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      info.planeinfo.yoffset = buf->index * paninfo->yres;
+      if (fb->vtable->pandisplay != NULL)
+        {
+          fb->vtable->pandisplay(fb->vtable, &info.planeinfo);
+        }
+    }
+
+  flags = enter_critical_section();
+
+  ret = fb_add_paninfo(fb, &info, priv->overlay);
+  if (ret >= 0)
+    {
+      paninfo->acquired &= ~bit;
+      priv->acquired    &= ~bit;
+      paninfo->queued   |= bit;
+      buf->fence         = paninfo->nqueued;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: fb_swap_release
+ *
+ * Description:
+ *   Give back acquired buffers without displaying them.
+ *
+ ****************************************************************************/
+
+static int fb_swap_release(FAR struct fb_chardev_s *fb,
+                           FAR struct fb_priv_s *priv, uint32_t mask)
+{
+  FAR struct fb_paninfo_s *paninfo;
+  irqstate_t flags;
+
+  if ((priv->acquired & mask) != mask)
+    {
+      return -EINVAL;
+    }
+
+  paninfo = fb_get_swapchain(fb, priv->overlay);
+  if (paninfo == NULL || mask == 0)
+    {
+      return OK;
+    }
+
+  flags = enter_critical_section();
+
+  paninfo->acquired &= ~mask;
+  priv->acquired    &= ~mask;
+  fb_swap_wakeup(paninfo);
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fb_swap_waitfence
+ *
+ * Description:
+ *   Wait until the buffer presented with a fence is displayed.
+ *
+ ****************************************************************************/
+
+static int fb_swap_waitfence(FAR struct fb_chardev_s *fb,
+                             FAR struct fb_priv_s *priv, bool nonblock,
+                             uint32_t fence)
+{
+  FAR struct fb_paninfo_s *paninfo;
+  irqstate_t flags;
+  int ret = OK;
+
+  paninfo = fb_get_swapchain(fb, priv->overlay);
+  if (paninfo == NULL)
+    {
+      return -ENOTTY;
+    }
+
+  flags = enter_critical_section();
+
+  if ((int32_t)(paninfo->nqueued - fence) < 0)
+    {
+      /* Not presented yet */
+
+      ret = -EINVAL;
+    }
+
+  while (ret >= 0 && (int32_t)(paninfo->nflips - fence) < 0)
+    {
+      if (nonblock)
+        {
+          ret = -EAGAIN;
+          break;
+        }
+
+      ret = nxsem_wait(&paninfo->swapwait);
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+#endif /* CONFIG_VIDEO_FB_SWAPCHAIN */
+
 /****************************************************************************
  * Name: fb_pollnotify
  *
@@ -1606,6 +2001,11 @@ int fb_remove_paninfo(FAR struct fb_vtable_s *vtable, int overlay)
 {
   FAR struct circbuf_s *panbuf;
   FAR struct fb_chardev_s *fb;
+#ifdef CONFIG_VIDEO_FB_SWAPCHAIN
+  FAR struct fb_paninfo_s *paninfo;
+  union fb_paninfo_u info;
+  uint32_t index;
+#endif
   irqstate_t flags;
   ssize_t ret;
   bool full;
@@ -1628,8 +2028,41 @@ int fb_remove_paninfo(FAR struct fb_vtable_s *vtable, int overlay)
 
   /* Attempt to take a frame from the pan info. */
 
+#ifdef CONFIG_VIDEO_FB_SWAPCHAIN
+  ret = circbuf_read(panbuf, &info, sizeof(union fb_paninfo_u));
+  DEBUGASSERT(ret <= 0 || ret == sizeof(union fb_paninfo_u));
+
+  /* The buffer panned to is now displayed, and the one displayed before
+   * free again.
+   */
+
+  paninfo = &fb->paninfo[overlay + 1];
+  if (ret == sizeof(union fb_paninfo_u) && paninfo->yres > 0)
+    {
+#ifdef CONFIG_FB_OVERLAY
+      if (overlay != FB_NO_OVERLAY)
+        {
+          index = info.overlayinfo.yoffset / paninfo->yres;
+        }
+      else
+#endif
+        {
+          index = info.planeinfo.yoffset / paninfo->yres;
+        }
+
+      if (index < paninfo->nbuffers)
+        {
+          paninfo->queued &= ~(1u << index);
+          paninfo->front   = index;
+        }
+
+      paninfo->nflips++;
+      fb_swap_wakeup(paninfo);
+    }
+#else
   ret = circbuf_skip(panbuf, sizeof(union fb_paninfo_u));
   DEBUGASSERT(ret <= 0 || ret == sizeof(union fb_paninfo_u));
+#endif
 
   /* Re-enable interrupts */
 
@@ -1784,6 +2217,13 @@ int fb_register_device(int display, int plane,
 
       fb->paninfo[i].dev = fb;
 
+#ifdef CONFIG_VIDEO_FB_SWAPCHAIN
+      nxsem_init(&fb->paninfo[i].swapwait, 0, 0);
+      fb->paninfo[i].yres     = panelinfo.yres;
+      fb->paninfo[i].nbuffers = panelinfo.fbcount > 32 ?
+                                32 : panelinfo.fbcount;
+#endif
+
       /* Clear the framebuffer memory */
 
       memset(panelinfo.fbmem, 0, panelinfo.fblen);
@@ -1815,6 +2255,9 @@ errout_with_paninfo:
   while (i-- > 0)
     {
       circbuf_uninit(&(fb->paninfo[i].buf));
+#ifdef CONFIG_VIDEO_FB_SWAPCHAIN
+      nxsem_destroy(&fb->paninfo[i].swapwait);
+#endif
     }
 
   kmm_free(fb->paninfo);
@@ -21,13 +21,14 @@
 /****************************************************************************
  * Included Files
  ****************************************************************************/
-
 #include <debug.h>
 #include <errno.h>
 #include <stdio.h>
+#include <sys/param.h>
 
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
+#include <nuttx/sched.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/virtio/virtio.h>
@@ -43,15 +44,26 @@
 
 /* Block feature bits */
 
+#define VIRTIO_BLK_F_SIZE_MAX       1  /* Maximum size of any segment */
+#define VIRTIO_BLK_F_SEG_MAX        2  /* Maximum segments in a request */
 #define VIRTIO_BLK_F_RO             5  /* Disk is read-only */
 #define VIRTIO_BLK_F_BLK_SIZE       6  /* Block size of disk is available */
 #define VIRTIO_BLK_F_FLUSH          9  /* Cache flush command support */
+#define VIRTIO_BLK_F_MQ             12 /* Several request queues */
+#define VIRTIO_BLK_F_DISCARD        13 /* Discard command support */
+#define VIRTIO_BLK_F_WRITE_ZEROES   14 /* Write zeroes command support */
 
 /* Block request type */
 
 #define VIRTIO_BLK_T_IN             0  /* READ */
 #define VIRTIO_BLK_T_OUT            1  /* WRITE */
 #define VIRTIO_BLK_T_FLUSH          4  /* FLUSH */
+#define VIRTIO_BLK_T_DISCARD        11 /* DISCARD */
+#define VIRTIO_BLK_T_WRITE_ZEROES   13 /* WRITE ZEROES */
+
+/* Write zeroes flags */
+
+#define VIRTIO_BLK_WRITE_ZEROES_FLAG_UNMAP (1 << 0)
 
 /* Block request return status */
 
@@ -64,6 +76,15 @@
 #define VIRTIO_BLK_SECTOR_BITS      9
 #define VIRTIO_BLK_SECTOR_SIZE      (1UL << VIRTIO_BLK_SECTOR_BITS)
 
+/* The data segments of a request, and the requests submitted at once
+ * before waiting for their completion
+ */
+
+#define VIRTIO_BLK_MAX_SEGS         16
+#define VIRTIO_BLK_MAX_BATCH        8
+
+#define VIRTIO_BLK_MAX_QUEUES       CONFIG_DRIVERS_VIRTIO_BLK_MAX_QUEUES
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -84,6 +105,15 @@ begin_packed_struct struct virtio_blk_resp_s
   uint8_t status;
 } end_packed_struct;
 
+/* Data segment of the discard and write zeroes requests */
+
+begin_packed_struct struct virtio_blk_discard_s
+{
+  uint64_t sector;
+  uint32_t num_sectors;
+  uint32_t flags;
+} end_packed_struct;
+
 begin_packed_struct struct virtio_blk_config_s
 {
   uint64_t capacity;
@@ -112,13 +142,36 @@ begin_packed_struct struct virtio_blk_config_s
   uint32_t secure_erase_sector_alignment;
 } end_packed_struct;
 
+/* A request in flight, the cookie of the virtqueue.  The submitter waits
+ * for the completion of all its requests on 'sem'.
+ */
+
+struct virtio_blk_xfer_s
+{
+  struct virtio_blk_req_s       req;            /* Out header */
+  struct virtio_blk_resp_s      resp;           /* In header */
+  FAR sem_t                    *sem;            /* Posted on completion */
+};
+
+struct virtio_blk_queue_s
+{
+  FAR struct virtqueue         *vq;             /* Request virtqueue */
+  spinlock_t                    lock;           /* Lock of the virtqueue */
+};
+
 struct virtio_blk_priv_s
 {
   FAR struct virtio_device     *vdev;           /* Virtio deivce */
-  spinlock_t                    lock;           /* Lock */
   uint64_t                      nsectors;       /* Sectore numbers */
   uint32_t                      block_size;     /* Block size */
+  uint32_t                      size_max;       /* Max segment size */
+  uint32_t                      seg_max;        /* Max data segments */
+  uint32_t                      max_discard;    /* Max discard sectors */
+  uint32_t                      max_zeroes;     /* Max zeroed sectors */
+  bool                          zeroes_unmap;   /* Zeroes may unmap */
+  int                           nqueues;        /* Request queues */
   char                          name[NAME_MAX]; /* Device name */
+  struct virtio_blk_queue_s     queue[VIRTIO_BLK_MAX_QUEUES];
 };
 
 /****************************************************************************
@@ -143,11 +196,15 @@ static int     virtio_blk_geometry(FAR struct inode *inode,
 static int     virtio_blk_ioctl(FAR struct inode *inode, int cmd,
                                 unsigned long arg);
 static int     virtio_blk_flush(FAR struct virtio_blk_priv_s *priv);
+static int     virtio_blk_discard(FAR struct virtio_blk_priv_s *priv,
+                                  FAR const struct blk_range_s *range,
+                                  uint32_t type);
 
 /* Other functions */
 
 static int  virtio_blk_init(FAR struct virtio_blk_priv_s *priv,
                             FAR struct virtio_device *vdev);
+static void virtio_blk_config(FAR struct virtio_blk_priv_s *priv);
 static void virtio_blk_uninit(FAR struct virtio_blk_priv_s *priv);
 static void virtio_blk_done(FAR struct virtqueue *vq);
 static int  virtio_blk_probe(FAR struct virtio_device *vdev);
@@ -181,46 +238,87 @@ static int g_virtio_blk_idx = 0;
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: virtio_blk_getqueue
+ *
+ * Description:
+ *   Return the request queue of the current CPU.
+ *
+ ****************************************************************************/
+
+static inline FAR struct virtio_blk_queue_s *
+virtio_blk_getqueue(FAR struct virtio_blk_priv_s *priv)
+{
+#if VIRTIO_BLK_MAX_QUEUES > 1
+  return &priv->queue[this_cpu() % priv->nqueues];
+#else
+  return &priv->queue[0];
+#endif
+}
+
 /****************************************************************************
  * Name: virtio_blk_wait_complete
  *
  * Description:
- *   Wait the virtio block request complete
+ *   Wait the completion of 'nreq' virtio block requests submitted together
+ *   and return their status.
  *
  ****************************************************************************/
 
-static void virtio_blk_wait_complete(FAR struct virtqueue *vq,
-                                     FAR sem_t *respsem)
+static int virtio_blk_wait_complete(FAR struct virtio_blk_queue_s *q,
+                                    FAR struct virtio_blk_xfer_s *xfers,
+                                    int nreq)
 {
-  FAR struct virtio_blk_priv_s *priv = vq->vq_dev->priv;
-  FAR sem_t *sem;
+  FAR sem_t *respsem = xfers[0].sem;
+  FAR struct virtio_blk_xfer_s *xfer;
+  int ret = OK;
+  int i;
 
   if (up_interrupt_context())
     {
-      for (; ; )
+      for (i = nreq; i > 0; )
         {
-          sem = virtqueue_get_buffer_lock(vq, NULL, NULL, &priv->lock);
-          if (sem == respsem)
+          xfer = virtqueue_get_buffer_lock(q->vq, NULL, NULL, &q->lock);
+          if (xfer != NULL && xfer->sem == respsem)
             {
-              break;
+              i--;
             }
-          else if (sem != NULL)
+          else if (xfer != NULL)
             {
-              nxsem_post(sem);
+              nxsem_post(xfer->sem);
             }
         }
     }
   else
     {
-      nxsem_wait_uninterruptible(respsem);
+      for (i = 0; i < nreq; i++)
+        {
+          nxsem_wait_uninterruptible(respsem);
+        }
+    }
+
+  for (i = 0; i < nreq; i++)
+    {
+      if (xfers[i].resp.status == VIRTIO_BLK_S_UNSUPP)
+        {
+          ret = -ENOTSUP;
+        }
+      else if (xfers[i].resp.status != VIRTIO_BLK_S_OK)
+        {
+          ret = -EIO;
+        }
     }
+
+  return ret;
 }
 
 /****************************************************************************
  * Name: virtio_blk_rdwr
  *
  * Description:
- *   Common function for read and write
+ *   Common function for read and write:  The transfer is split in
+ *   requests of up to seg_max segments of size_max bytes, and up to
+ *   VIRTIO_BLK_MAX_BATCH requests are submitted with a single kick.
  *
  ****************************************************************************/
 
@@ -228,70 +326,103 @@ static ssize_t virtio_blk_rdwr(FAR struct virtio_blk_priv_s *priv,
                                FAR void *buffer, blkcnt_t startsector,
                                unsigned int nsectors, bool write)
 {
-  FAR struct virtio_device *vdev = priv->vdev;
-  FAR struct virtqueue *vq = vdev->vrings_info[0].vq;
-  FAR struct virtqueue_buf vb[3];
-  struct virtio_blk_resp_s resp;
-  struct virtio_blk_req_s req;
+  FAR struct virtio_blk_queue_s *q = virtio_blk_getqueue(priv);
+  struct virtio_blk_xfer_s xfers[VIRTIO_BLK_MAX_BATCH];
+  struct virtqueue_buf vb[VIRTIO_BLK_MAX_SEGS + 2];
+  FAR struct virtio_blk_xfer_s *xfer;
+  FAR uint8_t *data = buffer;
+  size_t remaining = (size_t)nsectors * priv->block_size;
+  uint64_t sector;
   irqstate_t flags;
   sem_t respsem;
-  ssize_t ret;
-  int readnum;
+  ssize_t ret = OK;
+  size_t reqlen;
+  size_t len;
+  int nreq;
+  int nseg;
 
   nxsem_init(&respsem, 0, 0);
-
-  /* Build the block request */
-
-  req.type     = write ? VIRTIO_BLK_T_OUT : VIRTIO_BLK_T_IN;
-  req.reserved = 0;
-  req.sector   = startsector * priv->block_size >> VIRTIO_BLK_SECTOR_BITS;
-  resp.status  = VIRTIO_BLK_S_IOERR;
-
-  /* Fill the virtqueue buffer:
-   * Buffer 0: the block out header;
-   * Buffer 1: the read/write buffer;
-   * Buffer 2: the block in header, return the status.
-   */
-
-  vb[0].buf = &req;
-  vb[0].len = VIRTIO_BLK_REQ_HEADER_SIZE;
-  vb[1].buf = buffer;
-  vb[1].len = nsectors * priv->block_size;
-  vb[2].buf = &resp;
-  vb[2].len = VIRTIO_BLK_RESP_HEADER_SIZE;
-  readnum = write ? 2 : 1;
+  sector = startsector * priv->block_size >> VIRTIO_BLK_SECTOR_BITS;
 
   if (up_interrupt_context())
     {
-      virtqueue_disable_cb_lock(vq, &priv->lock);
+      virtqueue_disable_cb_lock(q->vq, &q->lock);
     }
 
-  flags = spin_lock_irqsave(&priv->lock);
-  ret = virtqueue_add_buffer(vq, vb, readnum, 3 - readnum, &respsem);
-  if (ret < 0)
+  while (remaining > 0 && ret >= 0)
     {
-      spin_unlock_irqrestore(&priv->lock, flags);
-      vrterr("virtqueue_add_buffer failed, ret=%zd\n", ret);
-      goto err;
-    }
+      /* Fill the virtqueue buffers of each request:
+       * Buffer 0: the block out header;
+       * Buffer 1 to nseg - 1: the segments of the read/write buffer;
+       * Buffer nseg: the block in header, return the status.
+       */
+
+      flags = spin_lock_irqsave(&q->lock);
+      for (nreq = 0; remaining > 0 && nreq < VIRTIO_BLK_MAX_BATCH; nreq++)
+        {
+          xfer = &xfers[nreq];
+          xfer->req.type     = write ? VIRTIO_BLK_T_OUT : VIRTIO_BLK_T_IN;
+          xfer->req.reserved = 0;
+          xfer->req.sector   = sector;
+          xfer->resp.status  = VIRTIO_BLK_S_IOERR;
+          xfer->sem          = &respsem;
+
+          vb[0].buf = &xfer->req;
+          vb[0].len = VIRTIO_BLK_REQ_HEADER_SIZE;
+
+          for (reqlen = 0, nseg = 1;
+               reqlen < remaining && nseg <= priv->seg_max; nseg++)
+            {
+              len = MIN(remaining - reqlen, priv->size_max);
+              vb[nseg].buf = data + reqlen;
+              vb[nseg].len = len;
+              reqlen += len;
+            }
 
-  virtqueue_kick(vq);
-  spin_unlock_irqrestore(&priv->lock, flags);
+          vb[nseg].buf = &xfer->resp;
+          vb[nseg].len = VIRTIO_BLK_RESP_HEADER_SIZE;
 
-  /* Wait for the request completion */
+          ret = virtqueue_add_buffer(q->vq, vb, write ? nseg : 1,
+                                     write ? 1 : nseg, xfer);
+          if (ret < 0)
+            {
+              break;
+            }
 
-  virtio_blk_wait_complete(vq, &respsem);
+          data      += reqlen;
+          remaining -= reqlen;
+          sector    += reqlen >> VIRTIO_BLK_SECTOR_BITS;
+        }
 
-  if (resp.status != VIRTIO_BLK_S_OK)
-    {
-      vrterr("%s Error\n", write ? "Write" : "Read");
-      ret = -EIO;
+      if (nreq > 0)
+        {
+          virtqueue_kick(q->vq);
+        }
+
+      spin_unlock_irqrestore(&q->lock, flags);
+
+      /* A full virtqueue only ends the batch early */
+
+      if (nreq == 0)
+        {
+          vrterr("virtqueue_add_buffer failed, ret=%zd\n", ret);
+          break;
+        }
+
+      /* Wait for the requests completion */
+
+      ret = virtio_blk_wait_complete(q, xfers, nreq);
+      if (ret < 0)
+        {
+          vrterr("%s Error\n", write ? "Write" : "Read");
+        }
     }
 
-err:
+  nxsem_destroy(&respsem);
+
   if (up_interrupt_context())
     {
-      virtqueue_enable_cb_lock(vq, &priv->lock);
+      virtqueue_enable_cb_lock(q->vq, &q->lock);
     }
 
   return ret >= 0 ? nsectors : ret;
@@ -399,16 +530,14 @@ static int virtio_blk_geometry(FAR struct inode *inode,
 }
 
 /****************************************************************************
- * Name: virtio_blk_ioctl
+ * Name: virtio_blk_flush
  ****************************************************************************/
 
 static int virtio_blk_flush(FAR struct virtio_blk_priv_s *priv)
 {
-  FAR struct virtio_device *vdev = priv->vdev;
-  FAR struct virtqueue *vq = vdev->vrings_info[0].vq;
+  FAR struct virtio_blk_queue_s *q = virtio_blk_getqueue(priv);
+  struct virtio_blk_xfer_s xfer;
   FAR struct virtqueue_buf vb[2];
-  struct virtio_blk_resp_s resp;
-  struct virtio_blk_req_s req;
   irqstate_t flags;
   sem_t respsem;
   int ret;
@@ -417,36 +546,151 @@ static int virtio_blk_flush(FAR struct virtio_blk_priv_s *priv)
 
   /* Build the block request */
 
-  req.type     = VIRTIO_BLK_T_FLUSH;
-  req.reserved = 0;
-  req.sector   = 0;
-  resp.status  = VIRTIO_BLK_S_IOERR;
+  xfer.req.type     = VIRTIO_BLK_T_FLUSH;
+  xfer.req.reserved = 0;
+  xfer.req.sector   = 0;
+  xfer.resp.status  = VIRTIO_BLK_S_IOERR;
+  xfer.sem          = &respsem;
 
-  vb[0].buf = &req;
+  vb[0].buf = &xfer.req;
   vb[0].len = VIRTIO_BLK_REQ_HEADER_SIZE;
-  vb[1].buf = &resp;
+  vb[1].buf = &xfer.resp;
   vb[1].len = VIRTIO_BLK_RESP_HEADER_SIZE;
 
-  flags = spin_lock_irqsave(&priv->lock);
-  ret = virtqueue_add_buffer(vq, vb, 1, 1, &respsem);
+  flags = spin_lock_irqsave(&q->lock);
+  ret = virtqueue_add_buffer(q->vq, vb, 1, 1, &xfer);
   if (ret < 0)
     {
-      spin_unlock_irqrestore(&priv->lock, flags);
+      spin_unlock_irqrestore(&q->lock, flags);
+      nxsem_destroy(&respsem);
       return ret;
     }
 
-  virtqueue_kick(vq);
-  spin_unlock_irqrestore(&priv->lock, flags);
+  virtqueue_kick(q->vq);
+  spin_unlock_irqrestore(&q->lock, flags);
 
   /* Wait for the request completion */
 
-  nxsem_wait_uninterruptible(&respsem);
-  if (resp.status != VIRTIO_BLK_S_OK)
+  ret = virtio_blk_wait_complete(q, &xfer, 1);
+  if (ret < 0)
     {
       vrterr("Flush Error\n");
-      ret = -EIO;
     }
 
+  nxsem_destroy(&respsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: virtio_blk_discard
+ *
+ * Description:
+ *   Discard or write zeroes to a range of sectors, in requests of up to
+ *   the maximum number of sectors of the device submitted by batches.
+ *
+ ****************************************************************************/
+
+static int virtio_blk_discard(FAR struct virtio_blk_priv_s *priv,
+                              FAR const struct blk_range_s *range,
+                              uint32_t type)
+{
+  FAR struct virtio_blk_queue_s *q = virtio_blk_getqueue(priv);
+  struct virtio_blk_xfer_s xfers[VIRTIO_BLK_MAX_BATCH];
+  struct virtio_blk_discard_s segs[VIRTIO_BLK_MAX_BATCH];
+  struct virtqueue_buf vb[3];
+  FAR struct virtio_blk_discard_s *seg;
+  FAR struct virtio_blk_xfer_s *xfer;
+  uint32_t maxsectors;
+  uint64_t remaining;
+  uint64_t sector;
+  irqstate_t flags;
+  sem_t respsem;
+  int ret = OK;
+  int nreq;
+
+  if (virtio_has_feature(priv->vdev, VIRTIO_BLK_F_RO))
+    {
+      return -EPERM;
+    }
+
+  if (range == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* The virtio sectors are 512 bytes, whatever the block size */
+
+  sector    = (uint64_t)range->start * priv->block_size >>
+              VIRTIO_BLK_SECTOR_BITS;
+  remaining = (uint64_t)range->nsectors * priv->block_size >>
+              VIRTIO_BLK_SECTOR_BITS;
+  if (sector + remaining > priv->nsectors)
+    {
+      return -EINVAL;
+    }
+
+  maxsectors = type == VIRTIO_BLK_T_DISCARD ? priv->max_discard :
+                                              priv->max_zeroes;
+
+  nxsem_init(&respsem, 0, 0);
+
+  while (remaining > 0 && ret >= 0)
+    {
+      /* Buffer 0: the block out header;
+       * Buffer 1: the range;
+       * Buffer 2: the block in header, return the status.
+       */
+
+      flags = spin_lock_irqsave(&q->lock);
+      for (nreq = 0; remaining > 0 && nreq < VIRTIO_BLK_MAX_BATCH; nreq++)
+        {
+          xfer = &xfers[nreq];
+          xfer->req.type     = type;
+          xfer->req.reserved = 0;
+          xfer->req.sector   = 0;
+          xfer->resp.status  = VIRTIO_BLK_S_IOERR;
+          xfer->sem          = &respsem;
+
+          seg = &segs[nreq];
+          seg->sector      = sector;
+          seg->num_sectors = MIN(remaining, maxsectors);
+          seg->flags       = type == VIRTIO_BLK_T_WRITE_ZEROES &&
+                             priv->zeroes_unmap ?
+                             VIRTIO_BLK_WRITE_ZEROES_FLAG_UNMAP : 0;
+
+          vb[0].buf = &xfer->req;
+          vb[0].len = VIRTIO_BLK_REQ_HEADER_SIZE;
+          vb[1].buf = seg;
+          vb[1].len = sizeof(*seg);
+          vb[2].buf = &xfer->resp;
+          vb[2].len = VIRTIO_BLK_RESP_HEADER_SIZE;
+
+          if (virtqueue_add_buffer(q->vq, vb, 2, 1, xfer) < 0)
+            {
+              break;
+            }
+
+          sector    += seg->num_sectors;
+          remaining -= seg->num_sectors;
+        }
+
+      if (nreq > 0)
+        {
+          virtqueue_kick(q->vq);
+        }
+
+      spin_unlock_irqrestore(&q->lock, flags);
+
+      if (nreq == 0)
+        {
+          ret = -EBUSY;
+          break;
+        }
+
+      ret = virtio_blk_wait_complete(q, xfers, nreq);
+    }
+
+  nxsem_destroy(&respsem);
   return ret;
 }
 
@@ -471,6 +715,24 @@ static int virtio_blk_ioctl(FAR struct inode *inode, int cmd,
             ret = virtio_blk_flush(priv);
           }
         break;
+
+      case BIOC_DISCARD:
+        if (virtio_has_feature(priv->vdev, VIRTIO_BLK_F_DISCARD))
+          {
+            ret = virtio_blk_discard(priv,
+                    (FAR const struct blk_range_s *)(uintptr_t)arg,
+                    VIRTIO_BLK_T_DISCARD);
+          }
+        break;
+
+      case BIOC_ZEROOUT:
+        if (virtio_has_feature(priv->vdev, VIRTIO_BLK_F_WRITE_ZEROES))
+          {
+            ret = virtio_blk_discard(priv,
+                    (FAR const struct blk_range_s *)(uintptr_t)arg,
+                    VIRTIO_BLK_T_WRITE_ZEROES);
+          }
+        break;
     }
 
   return ret;
@@ -483,17 +745,18 @@ static int virtio_blk_ioctl(FAR struct inode *inode, int cmd,
 static void virtio_blk_done(FAR struct virtqueue *vq)
 {
   FAR struct virtio_blk_priv_s *priv = vq->vq_dev->priv;
-  FAR sem_t *respsem;
+  FAR struct virtio_blk_queue_s *q = &priv->queue[vq->vq_queue_index];
+  FAR struct virtio_blk_xfer_s *xfer;
 
   for (; ; )
     {
-      respsem = virtqueue_get_buffer_lock(vq, NULL, NULL, &priv->lock);
-      if (respsem == NULL)
+      xfer = virtqueue_get_buffer_lock(vq, NULL, NULL, &q->lock);
+      if (xfer == NULL)
         {
           break;
         }
 
-      nxsem_post(respsem);
+      nxsem_post(xfer->sem);
     }
 }
 
@@ -504,25 +767,49 @@ static void virtio_blk_done(FAR struct virtqueue *vq)
 static int virtio_blk_init(FAR struct virtio_blk_priv_s *priv,
                            FAR struct virtio_device *vdev)
 {
-  FAR const char *vqname[1];
-  vq_callback callback[1];
+  FAR const char *vqname[VIRTIO_BLK_MAX_QUEUES];
+  vq_callback callback[VIRTIO_BLK_MAX_QUEUES];
+  uint16_t nqueues = 1;
   int ret;
+  int i;
 
   priv->vdev = vdev;
   vdev->priv = priv;
-  spin_lock_init(&priv->lock);
 
   /* Initialize the virtio device */
 
   virtio_set_status(vdev, VIRTIO_CONFIG_STATUS_DRIVER);
-  virtio_negotiate_features(vdev, (1UL << VIRTIO_BLK_F_RO) |
+  virtio_negotiate_features(vdev, (1UL << VIRTIO_BLK_F_SIZE_MAX) |
+                                  (1UL << VIRTIO_BLK_F_SEG_MAX) |
+                                  (1UL << VIRTIO_BLK_F_RO) |
                                   (1UL << VIRTIO_BLK_F_BLK_SIZE) |
-                                  (1UL << VIRTIO_BLK_F_FLUSH), NULL);
+                                  (1UL << VIRTIO_BLK_F_FLUSH) |
+#if VIRTIO_BLK_MAX_QUEUES > 1
+                                  (1UL << VIRTIO_BLK_F_MQ) |
+#endif
+                                  (1UL << VIRTIO_BLK_F_DISCARD) |
+                                  (1UL << VIRTIO_BLK_F_WRITE_ZEROES), NULL);
   virtio_set_status(vdev, VIRTIO_CONFIG_FEATURES_OK);
 
-  vqname[0]   = "virtio_blk_vq";
-  callback[0] = virtio_blk_done;
-  ret = virtio_create_virtqueues(vdev, 0, 1, vqname, callback, NULL);
+  /* Use up to a request queue per CPU */
+
+  if (virtio_has_feature(vdev, VIRTIO_BLK_F_MQ))
+    {
+      virtio_read_config_member(vdev, struct virtio_blk_config_s,
+                                num_queues, &nqueues);
+    }
+
+  priv->nqueues = MAX(MIN(nqueues, VIRTIO_BLK_MAX_QUEUES), 1);
+
+  for (i = 0; i < priv->nqueues; i++)
+    {
+      spin_lock_init(&priv->queue[i].lock);
+      vqname[i]   = "virtio_blk_vq";
+      callback[i] = virtio_blk_done;
+    }
+
+  ret = virtio_create_virtqueues(vdev, 0, priv->nqueues, vqname, callback,
+                                 NULL);
   if (ret < 0)
     {
       vrterr("virtio_device_create_virtqueue failed, ret=%d\n", ret);
@@ -530,10 +817,88 @@ static int virtio_blk_init(FAR struct virtio_blk_priv_s *priv,
     }
 
   virtio_set_status(vdev, VIRTIO_CONFIG_STATUS_DRIVER_OK);
-  virtqueue_enable_cb(vdev->vrings_info[0].vq);
+
+  for (i = 0; i < priv->nqueues; i++)
+    {
+      priv->queue[i].vq = vdev->vrings_info[i].vq;
+      virtqueue_enable_cb(priv->queue[i].vq);
+    }
+
   return ret;
 }
 
+/****************************************************************************
+ * Name: virtio_blk_config
+ *
+ * Description:
+ *   Read the limits of the requests from the block config.
+ *
+ ****************************************************************************/
+
+static void virtio_blk_config(FAR struct virtio_blk_priv_s *priv)
+{
+  FAR struct virtio_device *vdev = priv->vdev;
+  uint32_t value;
+  uint8_t unmap;
+
+  /* The segments end at sector boundaries, so do the requests */
+
+  priv->size_max = INT32_MAX & ~(VIRTIO_BLK_SECTOR_SIZE - 1);
+  if (virtio_has_feature(vdev, VIRTIO_BLK_F_SIZE_MAX))
+    {
+      virtio_read_config_member(vdev, struct virtio_blk_config_s,
+                                size_max, &value);
+      value &= ~(VIRTIO_BLK_SECTOR_SIZE - 1);
+      if (value > 0)
+        {
+          priv->size_max = MIN(value, priv->size_max);
+        }
+    }
+
+  /* The header and the status take two descriptors */
+
+  priv->seg_max = MIN(VIRTIO_BLK_MAX_SEGS,
+                      vdev->vrings_info[0].info.num_descs - 2);
+  if (virtio_has_feature(vdev, VIRTIO_BLK_F_SEG_MAX))
+    {
+      virtio_read_config_member(vdev, struct virtio_blk_config_s,
+                                seg_max, &value);
+      if (value > 0)
+        {
+          priv->seg_max = MIN(value, priv->seg_max);
+        }
+    }
+
+  priv->max_discard = UINT32_MAX;
+  if (virtio_has_feature(vdev, VIRTIO_BLK_F_DISCARD))
+    {
+      virtio_read_config_member(vdev, struct virtio_blk_config_s,
+                                max_discard_sectors, &value);
+      if (value > 0)
+        {
+          priv->max_discard = value;
+        }
+    }
+
+  priv->max_zeroes = UINT32_MAX;
+  if (virtio_has_feature(vdev, VIRTIO_BLK_F_WRITE_ZEROES))
+    {
+      virtio_read_config_member(vdev, struct virtio_blk_config_s,
+                                max_write_zeroes_sectors, &value);
+      if (value > 0)
+        {
+          priv->max_zeroes = value;
+        }
+
+      virtio_read_config_member(vdev, struct virtio_blk_config_s,
+                                write_zeroes_may_unmap, &unmap);
+      priv->zeroes_unmap = unmap != 0;
+    }
+
+  vrtinfo("Virio blk size_max=%" PRIu32 " seg_max=%" PRIu32
+          " queues=%d\n", priv->size_max, priv->seg_max, priv->nqueues);
+}
+
 /****************************************************************************
  * Name: virtio_blk_uninit
  ****************************************************************************/
@@ -590,6 +955,10 @@ static int virtio_blk_probe(FAR struct virtio_device *vdev)
       priv->block_size = VIRTIO_BLK_SECTOR_SIZE;
     }
 
+  /* Read the limits of the requests */
+
+  virtio_blk_config(priv);
+
   /* Register block driver */
 
   snprintf(priv->name, NAME_MAX, "/dev/virtblk%d", g_virtio_blk_idx);
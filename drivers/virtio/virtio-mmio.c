@@ -701,7 +701,8 @@ static void virtio_mmio_set_features(FAR struct virtio_device *vdev,
 static uint64_t virtio_mmio_negotiate_features(struct virtio_device *vdev,
                                                uint64_t features)
 {
-  features = features & virtio_mmio_get_features(vdev);
+  features = (features | VIRTIO_TRANSPORT_FEATURES) &
+             virtio_mmio_get_features(vdev);
   virtio_mmio_set_features(vdev, features);
   return features;
 }
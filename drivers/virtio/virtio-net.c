@@ -21,16 +21,17 @@
 /****************************************************************************
  * Included Files
  ****************************************************************************/
-
 #include <debug.h>
 #include <errno.h>
 #include <stdint.h>
 #include <string.h>
+#include <sys/param.h>
 
 #include <nuttx/compiler.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/netdev_lowerhalf.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/virtio/virtio.h>
 #include <nuttx/net/wifi_sim.h>
 
@@ -42,31 +43,89 @@
 
 /* Virtio net feature bits */
 
-#define VIRTIO_NET_F_MAC      5
+#define VIRTIO_NET_F_CSUM       0
+#define VIRTIO_NET_F_GUEST_CSUM 1
+#define VIRTIO_NET_F_MAC        5
+#define VIRTIO_NET_F_HOST_TSO4  11
+#define VIRTIO_NET_F_HOST_TSO6  12
+#define VIRTIO_NET_F_MRG_RXBUF  15
+#define VIRTIO_NET_F_CTRL_VQ    17
+#define VIRTIO_NET_F_MQ         22
+
+/* Virtio net header flags and GSO types */
+
+#define VIRTIO_NET_HDR_F_NEEDS_CSUM 1
+#define VIRTIO_NET_HDR_F_DATA_VALID 2
+
+#define VIRTIO_NET_HDR_GSO_TCPV4    1
+#define VIRTIO_NET_HDR_GSO_TCPV6    4
+
+/* Virtio net control virtqueue commands */
 
-/* Virtio net header size and packet buffer size */
+#define VIRTIO_NET_CTRL_MQ              4
+#define VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET 0
+
+#define VIRTIO_NET_OK                   0
+
+/* Virtio net header size (the largest one, with VIRTIO_NET_F_MRG_RXBUF)
+ * and packet buffer size
+ */
 
 #define VIRTIO_NET_HDRSIZE    (sizeof(struct virtio_net_hdr_s))
-#define VIRTIO_NET_LLHDRSIZE  (sizeof(struct virtio_net_llhdr_s))
 #define VIRTIO_NET_BUFSIZE    (CONFIG_NET_ETH_PKTSIZE + CONFIG_NET_GUARDSIZE)
 
-/* Virtio net virtqueue index and number */
+/* Virtio net virtqueue index and number in a RX/TX queue pair.  The queue
+ * pairs are followed by the control virtqueue.
+ */
 
 #define VIRTIO_NET_RX         0
 #define VIRTIO_NET_TX         1
 #define VIRTIO_NET_NUM        2
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+#  define VIRTIO_NET_MAX_PAIRS CONFIG_NETDEV_MAX_QUEUES
+#else
+#  define VIRTIO_NET_MAX_PAIRS 1
+#endif
+
+#define VIRTIO_NET_MAX_VQS    (VIRTIO_NET_MAX_PAIRS * VIRTIO_NET_NUM + 1)
+
+#define VIRTIO_NET_RXQ(q)     ((q) * VIRTIO_NET_NUM + VIRTIO_NET_RX)
+#define VIRTIO_NET_TXQ(q)     ((q) * VIRTIO_NET_NUM + VIRTIO_NET_TX)
+#define VIRTIO_NET_QUEUE(vq)  ((vq)->vq_queue_index / VIRTIO_NET_NUM)
+
 #define VIRTIO_NET_MAX_PKT_SIZE \
     ((CONFIG_NET_LL_GUARDSIZE - ETH_HDRLEN) + VIRTIO_NET_BUFSIZE)
 #define VIRTIO_NET_MAX_NIOB \
     ((VIRTIO_NET_MAX_PKT_SIZE + CONFIG_IOB_BUFSIZE - 1) / CONFIG_IOB_BUFSIZE)
 
+/* The TCP super-segments sent with VIRTIO_NET_F_HOST_TSO4/6 take more IOBs
+ * than a frame
+ */
+
+#ifdef CONFIG_NETDEV_GSO
+#  define VIRTIO_NET_MAX_TXNIOB \
+    MAX(VIRTIO_NET_MAX_NIOB, \
+        (CONFIG_NET_LL_GUARDSIZE + CONFIG_NETDEV_GSO_MAXSIZE + \
+         CONFIG_IOB_BUFSIZE - 1) / CONFIG_IOB_BUFSIZE)
+#else
+#  define VIRTIO_NET_MAX_TXNIOB VIRTIO_NET_MAX_NIOB
+#endif
+
+/* With VIRTIO_NET_F_MRG_RXBUF, a RX buffer is a single IOB and the device
+ * spreads the larger frames over several buffers
+ */
+
+#define VIRTIO_NET_MRG_BUFSIZE \
+    MIN(VIRTIO_NET_BUFSIZE, \
+        CONFIG_IOB_BUFSIZE - (CONFIG_NET_LL_GUARDSIZE - ETH_HDRLEN))
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
-/* Virtio net header, just define it here for further, now only use it
- * to calculate the virto net header size, see marco VIRTIO_NET_HDRSIZE
+/* Virtio net header, in the headroom of the packets, see the layout below.
+ * num_buffers is only present with VIRTIO_NET_F_MRG_RXBUF.
  */
 
 begin_packed_struct struct virtio_net_hdr_s
@@ -77,6 +136,7 @@ begin_packed_struct struct virtio_net_hdr_s
   uint16_t gso_size;
   uint16_t csum_start;
   uint16_t csum_offset;
+  uint16_t num_buffers;
 } end_packed_struct;
 
 /* The definition of the struct virtio_net_config refers to the link
@@ -97,6 +157,28 @@ begin_packed_struct struct virtio_net_config_s
   uint32_t supported_hash_types;
 } end_packed_struct;
 
+/* A command of the control virtqueue, with its single data member */
+
+begin_packed_struct struct virtio_net_ctrl_s
+{
+  uint8_t  class;
+  uint8_t  cmd;
+  uint16_t data;
+  uint8_t  ack;
+} end_packed_struct;
+
+/* The state of a RX/TX queue pair, only used by the context that serves
+ * the pair.  The buffer lists of the TX packets are too large for the
+ * stack with the TCP super-segments.
+ */
+
+struct virtio_net_queue_s
+{
+  int                       rxcount;   /* Buffers in the RX virtqueue */
+  struct virtqueue_buf      vb[VIRTIO_NET_MAX_TXNIOB + 1];
+  struct iovec              iov[VIRTIO_NET_MAX_TXNIOB];
+};
+
 struct virtio_net_priv_s
 {
 #ifdef CONFIG_DRIVERS_WIFI_SIM
@@ -110,38 +192,40 @@ struct virtio_net_priv_s
   struct netdev_lowerhalf_s lower;     /* The netdev lowerhalf */
 #endif
 
-  spinlock_t                lock[VIRTIO_NET_NUM];
+  spinlock_t                lock[VIRTIO_NET_MAX_VQS];
 
   /* Virtio device information */
 
   FAR struct virtio_device *vdev;      /* Virtio device pointer */
   int                       bufnum;    /* TX and RX Buffer number */
+  int                       rxbufnum;  /* RX Buffer number per queue */
+  int                       nvqs;      /* Virtqueues created */
+  uint8_t                   npairs;    /* RX/TX queue pairs in use */
+  uint8_t                   hdrlen;    /* Virtio net header length */
+  uint16_t                  rxbuflen;  /* Data length of a RX buffer */
+
+  struct virtio_net_queue_s queue[VIRTIO_NET_MAX_PAIRS];
 };
 
-/* Virtio Link Layer Header, follow shows the iob buffer layout:
+/* Virtio net buffer layout, the virtio net header is in the headroom of
+ * the netpkt, right before the data.  The buffers are the cookies of the
+ * virtqueues.
  *
- * |<-- CONFIG_NET_LL_GUARDSIZE -->|
- * +---------------+---------------+------------+------+     +-------------+
- * | Virtio Header |  ETH Header   |    data    | free | --> | next netpkt |
- * +---------------+---------------+------------+------+     +-------------+
- * |               |<--------- datalen -------->|
- * ^base           ^data
+ * |<----- CONFIG_NET_LL_GUARDSIZE ---->|
+ * +------+---------------+-------------+------------+------+     +--------+
+ * | free | Virtio Header | ETH Header  |    data    | free | --> |  next  |
+ * +------+---------------+-------------+------------+------+     +--------+
+ * |      |<-- hdrlen --->|<--------- datalen ------>|
+ * ^base                  ^data
  *
- * CONFIG_NET_LL_GUARDSIZE >= VIRTIO_NET_LLHDRSIZE + ETH_HDR_SIZE
- *                          = sizeof(uintptr) + 10 + 14
- *                          = 32 (64-Bit)
- *                          = 28 (32-Bit)
+ * CONFIG_NET_LL_GUARDSIZE >= VIRTIO_NET_HDRSIZE + ETH_HDR_SIZE
+ *                          = 12 + 14
+ *                          = 26
  */
 
-begin_packed_struct struct virtio_net_llhdr_s
-{
-  FAR netpkt_t           *pkt;         /* Netpaket pointer */
-  struct virtio_net_hdr_s vhdr;        /* Virtio net header */
-} end_packed_struct;
-
-static_assert(CONFIG_NET_LL_GUARDSIZE >= VIRTIO_NET_LLHDRSIZE + ETH_HDRLEN,
+static_assert(CONFIG_NET_LL_GUARDSIZE >= VIRTIO_NET_HDRSIZE + ETH_HDRLEN,
               "CONFIG_NET_LL_GUARDSIZE cannot be less than ETH_HDRLEN"
-              " + VIRTIO_NET_LLHDRSIZE");
+              " + VIRTIO_NET_HDRSIZE");
 
 /****************************************************************************
  * Private Function Prototypes
@@ -162,7 +246,13 @@ static int virtio_net_rmmac(FAR struct netdev_lowerhalf_s *dev,
 static int virtio_net_ioctl(FAR struct netdev_lowerhalf_s *dev,
                             int cmd, unsigned long arg);
 #endif
-static void virtio_net_txfree(FAR struct netdev_lowerhalf_s *dev);
+static void virtio_net_reclaim(FAR struct netdev_lowerhalf_s *dev);
+static int virtio_net_sendq(FAR struct netdev_lowerhalf_s *dev,
+                            FAR netpkt_t *pkt, unsigned int queue);
+static netpkt_t *virtio_net_recvq(FAR struct netdev_lowerhalf_s *dev,
+                                  unsigned int queue);
+static void virtio_net_txfree(FAR struct netdev_lowerhalf_s *dev,
+                              unsigned int queue);
 
 static int  virtio_net_probe(FAR struct virtio_device *vdev);
 static void virtio_net_remove(FAR struct virtio_device *vdev);
@@ -192,7 +282,16 @@ static const struct netdev_ops_s g_virtio_net_ops =
 #ifdef CONFIG_NETDEV_IOCTL
   virtio_net_ioctl,
 #endif
-  virtio_net_txfree
+  virtio_net_reclaim,
+#ifdef CONFIG_NETDEV_NAPI
+  NULL,                 /* rxint */
+#endif
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  virtio_net_sendq,
+  virtio_net_recvq,
+  virtio_net_txfree,
+  NULL                  /* steer */
+#endif
 };
 
 #ifdef CONFIG_DRIVERS_WIFI_SIM
@@ -203,32 +302,102 @@ static uint8_t g_netdev_num = 0;
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: virtio_net_gethdr
+ *
+ * Description:
+ *   Return the virtio net header in the headroom of a netpkt.
+ *
+ ****************************************************************************/
+
+static inline FAR struct virtio_net_hdr_s *
+virtio_net_gethdr(FAR struct virtio_net_priv_s *priv, FAR uint8_t *data)
+{
+  return (FAR struct virtio_net_hdr_s *)(data - priv->hdrlen);
+}
+
+/****************************************************************************
+ * Name: virtio_net_txhdr
+ *
+ * Description:
+ *   Fill the offloads of a TX packet in its virtio net header:  The device
+ *   completes the checksum left by the network stack, and segments the TCP
+ *   super-segments.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+static void virtio_net_txhdr(FAR struct netdev_lowerhalf_s *dev,
+                             FAR netpkt_t *pkt,
+                             FAR struct virtio_net_hdr_s *hdr)
+{
+  uint16_t start;
+  uint16_t offset;
+#ifdef CONFIG_NETDEV_GSO
+  uint16_t gsosize;
+  uint8_t vhl;
+  uint8_t doff;
+#endif
+
+  if (!netpkt_txcsum(dev, pkt, &start, &offset))
+    {
+      return;
+    }
+
+  hdr->flags       = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+  hdr->csum_start  = start;
+  hdr->csum_offset = offset;
+
+#ifdef CONFIG_NETDEV_GSO
+  gsosize = netpkt_gsosize(dev, pkt);
+  if (gsosize > 0 &&
+      netpkt_copyout(dev, &vhl, pkt, 1, NET_LL_HDRLEN(&dev->netdev)) >= 0 &&
+      netpkt_copyout(dev, &doff, pkt, 1, start + 12) >= 0)
+    {
+      /* hdr_len tells the device the length of the headers copied to each
+       * segment, up to the end of the TCP header.
+       */
+
+      hdr->gso_type = (vhl >> 4) == 4 ? VIRTIO_NET_HDR_GSO_TCPV4 :
+                                        VIRTIO_NET_HDR_GSO_TCPV6;
+      hdr->gso_size = gsosize;
+      hdr->hdr_len  = start + ((doff >> 4) << 2);
+    }
+#endif
+}
+#endif
+
 /****************************************************************************
  * Name: virtio_net_addbuffer
  ****************************************************************************/
 
 static int virtio_net_addbuffer(FAR struct netdev_lowerhalf_s *dev,
                                 FAR struct virtqueue *vq, FAR netpkt_t *pkt,
-                                unsigned int vq_id)
+                                FAR struct virtqueue_buf *vb,
+                                FAR struct iovec *iov, int niov)
 {
   FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
-  FAR struct virtio_net_llhdr_s *hdr;
-  struct virtqueue_buf vb[VIRTIO_NET_MAX_NIOB + 1];
-  struct iovec iov[VIRTIO_NET_MAX_NIOB];
+  FAR struct virtio_net_hdr_s *hdr;
+  bool rx = (vq->vq_queue_index % VIRTIO_NET_NUM) == VIRTIO_NET_RX;
   int iov_cnt;
   int i;
 
   /* Convert netpkt to virtqueue_buf */
 
-  iov_cnt = netpkt_to_iov(dev, pkt, iov, VIRTIO_NET_MAX_NIOB);
+  iov_cnt = netpkt_to_iov(dev, pkt, iov, niov);
 
-  /* Alloc cookie and net header from transport layer */
+  /* The net header is in the headroom of the netpkt */
 
-  hdr = (FAR struct virtio_net_llhdr_s *)
-          ((FAR uint8_t *)iov[0].iov_base - VIRTIO_NET_LLHDRSIZE);
+  hdr = virtio_net_gethdr(priv, iov[0].iov_base);
   DEBUGASSERT((FAR uint8_t *)hdr >= netpkt_getbase(pkt));
-  memset(&hdr->vhdr, 0, sizeof(hdr->vhdr));
-  hdr->pkt = pkt;
+  memset(hdr, 0, priv->hdrlen);
+
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+  if (!rx)
+    {
+      virtio_net_txhdr(dev, pkt, hdr);
+    }
+#endif
 
   /* Prepare buffers depends on the feature VIRTIO_F_ANY_LAYOUT */
 
@@ -236,23 +405,21 @@ static int virtio_net_addbuffer(FAR struct netdev_lowerhalf_s *dev,
     {
       /* Append the virtio net header to the first buffer */
 
-      vb[0].buf = &hdr->vhdr;
-      vb[0].len = iov[0].iov_len + VIRTIO_NET_HDRSIZE;
+      vb[0].buf = hdr;
+      vb[0].len = iov[0].iov_len + priv->hdrlen;
 
-#if VIRTIO_NET_MAX_NIOB > 1
       for (i = 1; i < iov_cnt; i++)
         {
           vb[i].buf = iov[i].iov_base;
           vb[i].len = iov[i].iov_len;
         }
-#endif
     }
   else
     {
       /* Buffer 0 is only for virtio net header */
 
-      vb[0].buf = &hdr->vhdr;
-      vb[0].len = VIRTIO_NET_HDRSIZE;
+      vb[0].buf = hdr;
+      vb[0].len = priv->hdrlen;
 
       for (i = 0; i < iov_cnt; i++)
         {
@@ -263,16 +430,17 @@ static int virtio_net_addbuffer(FAR struct netdev_lowerhalf_s *dev,
       iov_cnt++;
     }
 
-  vrtinfo("Fill vq=%u, hdr=%p, count=%d\n", vq_id, hdr, iov_cnt);
-  if (vq_id == VIRTIO_NET_RX)
+  vrtinfo("Fill vq=%u, pkt=%p, count=%d\n", vq->vq_queue_index, pkt,
+          iov_cnt);
+  if (rx)
     {
-      return virtqueue_add_buffer_lock(vq, vb, 0, iov_cnt, hdr,
-                                       &priv->lock[vq_id]);
+      return virtqueue_add_buffer_lock(vq, vb, 0, iov_cnt, pkt,
+                                       &priv->lock[vq->vq_queue_index]);
     }
   else
     {
-      return virtqueue_add_buffer_lock(vq, vb, iov_cnt, 0, hdr,
-                                       &priv->lock[vq_id]);
+      return virtqueue_add_buffer_lock(vq, vb, iov_cnt, 0, pkt,
+                                       &priv->lock[vq->vq_queue_index]);
     }
 }
 
@@ -280,14 +448,19 @@ static int virtio_net_addbuffer(FAR struct netdev_lowerhalf_s *dev,
  * Name: virtio_net_rxfill
  ****************************************************************************/
 
-static void virtio_net_rxfill(FAR struct netdev_lowerhalf_s *dev)
+static void virtio_net_rxfill(FAR struct netdev_lowerhalf_s *dev,
+                              unsigned int queue)
 {
   FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
-  FAR struct virtqueue *vq = priv->vdev->vrings_info[VIRTIO_NET_RX].vq;
+  FAR struct virtio_net_queue_s *q = &priv->queue[queue];
+  FAR struct virtqueue *vq =
+    priv->vdev->vrings_info[VIRTIO_NET_RXQ(queue)].vq;
+  struct virtqueue_buf vb[VIRTIO_NET_MAX_NIOB + 1];
+  struct iovec iov[VIRTIO_NET_MAX_NIOB];
   FAR netpkt_t *pkt;
   int i;
 
-  for (i = 0; i < priv->bufnum; i++)
+  for (i = 0; q->rxcount < priv->rxbufnum; i++)
     {
       /* IOB Offload, Alloc buffer from RX netpkt */
 
@@ -300,8 +473,7 @@ static void virtio_net_rxfill(FAR struct netdev_lowerhalf_s *dev)
 
       /* Preserve data length */
 
-      if (netpkt_setdatalen(dev, pkt, VIRTIO_NET_BUFSIZE) <
-          VIRTIO_NET_BUFSIZE)
+      if (netpkt_setdatalen(dev, pkt, priv->rxbuflen) < priv->rxbuflen)
         {
           vrtwarn("No enough buffer to prepare RX buffer, i=%d\n", i);
           netpkt_free(dev, pkt, NETPKT_RX);
@@ -310,12 +482,19 @@ static void virtio_net_rxfill(FAR struct netdev_lowerhalf_s *dev)
 
       /* Add buffer to RX virtqueue */
 
-      virtio_net_addbuffer(dev, vq, pkt, VIRTIO_NET_RX);
+      if (virtio_net_addbuffer(dev, vq, pkt, vb, iov,
+                               VIRTIO_NET_MAX_NIOB) < 0)
+        {
+          netpkt_free(dev, pkt, NETPKT_RX);
+          break;
+        }
+
+      q->rxcount++;
     }
 
   if (i > 0)
     {
-      virtqueue_kick_lock(vq, &priv->lock[VIRTIO_NET_RX]);
+      virtqueue_kick_lock(vq, &priv->lock[VIRTIO_NET_RXQ(queue)]);
     }
 }
 
@@ -323,25 +502,27 @@ static void virtio_net_rxfill(FAR struct netdev_lowerhalf_s *dev)
  * Name: virtio_net_txfree
  ****************************************************************************/
 
-static void virtio_net_txfree(FAR struct netdev_lowerhalf_s *dev)
+static void virtio_net_txfree(FAR struct netdev_lowerhalf_s *dev,
+                              unsigned int queue)
 {
   FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
-  FAR struct virtqueue *vq = priv->vdev->vrings_info[VIRTIO_NET_TX].vq;
-  FAR struct virtio_net_llhdr_s *hdr;
+  FAR struct virtqueue *vq =
+    priv->vdev->vrings_info[VIRTIO_NET_TXQ(queue)].vq;
+  FAR netpkt_t *pkt;
 
   while (1)
     {
       /* Get buffer from tx virtqueue */
 
-      hdr = virtqueue_get_buffer_lock(vq, NULL, NULL,
-                                      &priv->lock[VIRTIO_NET_TX]);
-      if (hdr == NULL)
+      pkt = virtqueue_get_buffer_lock(vq, NULL, NULL,
+                                      &priv->lock[VIRTIO_NET_TXQ(queue)]);
+      if (pkt == NULL)
         {
           break;
         }
 
-      netpkt_free(dev, hdr->pkt, NETPKT_TX);
-      vrtinfo("Free, hdr: %p, pkt: %p\n", hdr, hdr->pkt);
+      netpkt_free(dev, pkt, NETPKT_TX);
+      vrtinfo("Free, pkt: %p\n", pkt);
     }
 }
 
@@ -352,6 +533,7 @@ static void virtio_net_txfree(FAR struct netdev_lowerhalf_s *dev)
 static int virtio_net_ifup(FAR struct netdev_lowerhalf_s *dev)
 {
   FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
+  unsigned int queue;
 
 #ifdef CONFIG_NET_IPv4
   vrtinfo("Bringing up: %u.%u.%u.%u\n",
@@ -368,9 +550,13 @@ static int virtio_net_ifup(FAR struct netdev_lowerhalf_s *dev)
 
   /* Prepare interrupt and packets for receiving */
 
-  virtqueue_enable_cb_lock(priv->vdev->vrings_info[VIRTIO_NET_RX].vq,
-                           &priv->lock[VIRTIO_NET_RX]);
-  virtio_net_rxfill(dev);
+  for (queue = 0; queue < priv->npairs; queue++)
+    {
+      virtqueue_enable_cb_lock(
+        priv->vdev->vrings_info[VIRTIO_NET_RXQ(queue)].vq,
+        &priv->lock[VIRTIO_NET_RXQ(queue)]);
+      virtio_net_rxfill(dev, queue);
+    }
 
 #ifdef CONFIG_DRIVERS_WIFI_SIM
   if (priv->lower.wifi == NULL)
@@ -393,7 +579,7 @@ static int virtio_net_ifdown(FAR struct netdev_lowerhalf_s *dev)
 
   /* Disable the Ethernet interrupt */
 
-  for (i = 0; i < VIRTIO_NET_NUM; i++)
+  for (i = 0; i < priv->npairs * VIRTIO_NET_NUM; i++)
     {
       virtqueue_disable_cb_lock(priv->vdev->vrings_info[i].vq,
                                 &priv->lock[i]);
@@ -413,82 +599,201 @@ static int virtio_net_ifdown(FAR struct netdev_lowerhalf_s *dev)
 }
 
 /****************************************************************************
- * Name: virtio_net_send
+ * Name: virtio_net_sendq
  ****************************************************************************/
 
-static int virtio_net_send(FAR struct netdev_lowerhalf_s *dev,
-                           FAR netpkt_t *pkt)
+static int virtio_net_sendq(FAR struct netdev_lowerhalf_s *dev,
+                            FAR netpkt_t *pkt, unsigned int queue)
 {
   FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
-  FAR struct virtqueue *vq = priv->vdev->vrings_info[VIRTIO_NET_TX].vq;
+  FAR struct virtio_net_queue_s *q = &priv->queue[queue];
+  FAR struct virtqueue *vq =
+    priv->vdev->vrings_info[VIRTIO_NET_TXQ(queue)].vq;
+  int ret;
 
-  /* Check the send length */
+  /* Check the send length, the TCP super-segments are larger */
 
-  if (netpkt_getdatalen(dev, pkt) > VIRTIO_NET_BUFSIZE)
+  if (netpkt_getdatalen(dev, pkt) > VIRTIO_NET_BUFSIZE &&
+      netpkt_gsosize(dev, pkt) == 0)
     {
       vrterr("net send buffer too large\n");
       return -EINVAL;
     }
 
-  /* Add buffer to vq and notify the other side */
+  /* Add buffer to vq and notify the other side, a super-segment may need
+   * the descriptors of the packets already sent.
+   */
+
+  ret = virtio_net_addbuffer(dev, vq, pkt, q->vb, q->iov,
+                             VIRTIO_NET_MAX_TXNIOB);
+  if (ret < 0)
+    {
+      virtio_net_txfree(dev, queue);
+      ret = virtio_net_addbuffer(dev, vq, pkt, q->vb, q->iov,
+                                 VIRTIO_NET_MAX_TXNIOB);
+      if (ret < 0)
+        {
+          vrterr("No descriptor to send, ret=%d\n", ret);
+          return -ENOBUFS;
+        }
+    }
 
-  virtio_net_addbuffer(dev, vq, pkt, VIRTIO_NET_TX);
-  virtqueue_kick_lock(vq, &priv->lock[VIRTIO_NET_TX]);
+  virtqueue_kick_lock(vq, &priv->lock[VIRTIO_NET_TXQ(queue)]);
 
   /* Try return Netpkt TX buffer to upper-half. */
 
-  virtio_net_txfree(dev);
+  virtio_net_txfree(dev, queue);
 
   /* If we have no buffer left, enable TX done callback. */
 
   if (netdev_lower_quota_load(dev, NETPKT_TX) <= 0)
     {
-      virtqueue_enable_cb_lock(vq, &priv->lock[VIRTIO_NET_TX]);
+      virtqueue_enable_cb_lock(vq, &priv->lock[VIRTIO_NET_TXQ(queue)]);
     }
 
   return OK;
 }
 
 /****************************************************************************
- * Name: virtio_net_recv
+ * Name: virtio_net_send
  ****************************************************************************/
 
-static netpkt_t *virtio_net_recv(FAR struct netdev_lowerhalf_s *dev)
+static int virtio_net_send(FAR struct netdev_lowerhalf_s *dev,
+                           FAR netpkt_t *pkt)
 {
-  FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
-  FAR struct virtqueue *vq = priv->vdev->vrings_info[VIRTIO_NET_RX].vq;
-  FAR struct virtio_net_llhdr_s *hdr;
+  return virtio_net_sendq(dev, pkt, 0);
+}
+
+/****************************************************************************
+ * Name: virtio_net_getbuffer
+ *
+ * Description:
+ *   Get a received buffer from the RX virtqueue of a queue pair, or enable
+ *   the RX callback if there is none.
+ *
+ ****************************************************************************/
+
+static FAR netpkt_t *virtio_net_getbuffer(FAR struct virtio_net_priv_s *priv,
+                                          unsigned int queue,
+                                          FAR uint32_t *len)
+{
+  FAR struct virtqueue *vq =
+    priv->vdev->vrings_info[VIRTIO_NET_RXQ(queue)].vq;
+  FAR spinlock_t *lock = &priv->lock[VIRTIO_NET_RXQ(queue)];
+  FAR netpkt_t *pkt;
   irqstate_t flags;
+
+  flags = spin_lock_irqsave(lock);
+  pkt = virtqueue_get_buffer(vq, len, NULL);
+  if (pkt == NULL && virtqueue_enable_cb(vq) != 0)
+    {
+      /* If we have no buffer left, enable RX callback.  A buffer used in
+       * the meantime is not notified, the callback stays disabled and the
+       * buffer is returned.
+       */
+
+      virtqueue_disable_cb(vq);
+      pkt = virtqueue_get_buffer(vq, len, NULL);
+    }
+
+  spin_unlock_irqrestore(lock, flags);
+
+  if (pkt != NULL)
+    {
+      priv->queue[queue].rxcount--;
+    }
+
+  return pkt;
+}
+
+/****************************************************************************
+ * Name: virtio_net_recvq
+ ****************************************************************************/
+
+static netpkt_t *virtio_net_recvq(FAR struct netdev_lowerhalf_s *dev,
+                                  unsigned int queue)
+{
+  FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
+  FAR struct virtio_net_hdr_s *hdr;
+  FAR netpkt_t *pkt;
+  FAR netpkt_t *next;
+  uint16_t nbufs = 1;
   uint32_t len;
 
   /* Fill the free Netpkt RX buffer to the RX virtqueue */
 
-  virtio_net_rxfill(dev);
+  virtio_net_rxfill(dev, queue);
 
   /* Get received buffer form RX virtqueue */
 
-  flags = spin_lock_irqsave(&priv->lock[VIRTIO_NET_RX]);
-  hdr = virtqueue_get_buffer(vq, &len, NULL);
-  if (hdr == NULL)
+  pkt = virtio_net_getbuffer(priv, queue, &len);
+  if (pkt == NULL)
     {
-      /* If we have no buffer left, enable RX callback. */
-
-      virtqueue_enable_cb(vq);
-      spin_unlock_irqrestore(&priv->lock[VIRTIO_NET_RX], flags);
-
       vrtinfo("get NULL buffer\n");
       return NULL;
     }
-  else
+
+  hdr = virtio_net_gethdr(priv, netpkt_getdata(dev, pkt));
+
+  /* Set the received pkt length */
+
+  netpkt_setdatalen(dev, pkt, len - priv->hdrlen);
+
+  /* Chain the other buffers of a frame spread over several ones, they all
+   * start at the place of the header.
+   */
+
+  if (virtio_has_feature(priv->vdev, VIRTIO_NET_F_MRG_RXBUF))
     {
-      spin_unlock_irqrestore(&priv->lock[VIRTIO_NET_RX], flags);
+      nbufs = hdr->num_buffers;
     }
 
-  /* Set the received pkt length */
+  while (nbufs-- > 1)
+    {
+      next = virtio_net_getbuffer(priv, queue, &len);
+      if (next == NULL)
+        {
+          vrterr("Missing %u buffers of a frame\n", nbufs);
+          netpkt_free(dev, pkt, NETPKT_RX);
+          return NULL;
+        }
+
+      netpkt_reset_reserved(dev, next, CONFIG_NET_LL_GUARDSIZE -
+                            NET_LL_HDRLEN(&dev->netdev) - priv->hdrlen);
+      netpkt_setdatalen(dev, next, len);
+      netpkt_concat(dev, pkt, next, NETPKT_RX);
+    }
+
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+  /* A packet with a partial checksum comes from the host itself */
 
-  netpkt_setdatalen(dev, hdr->pkt, len - VIRTIO_NET_HDRSIZE);
-  vrtinfo("Recv, hdr=%p, pkt=%p, len=%" PRIu32 "\n", hdr, hdr->pkt, len);
-  return hdr->pkt;
+  if ((hdr->flags & (VIRTIO_NET_HDR_F_NEEDS_CSUM |
+                     VIRTIO_NET_HDR_F_DATA_VALID)) != 0)
+    {
+      netpkt_rxcsum_verified(dev, pkt);
+    }
+#endif
+
+  vrtinfo("Recv, pkt=%p, len=%u\n", pkt, netpkt_getdatalen(dev, pkt));
+  return pkt;
+}
+
+/****************************************************************************
+ * Name: virtio_net_recv
+ ****************************************************************************/
+
+static netpkt_t *virtio_net_recv(FAR struct netdev_lowerhalf_s *dev)
+{
+  return virtio_net_recvq(dev, 0);
+}
+
+/****************************************************************************
+ * Name: virtio_net_reclaim
+ ****************************************************************************/
+
+static void virtio_net_reclaim(FAR struct netdev_lowerhalf_s *dev)
+{
+  virtio_net_txfree(dev, 0);
 }
 
 #ifdef CONFIG_NET_MCASTGROUP
@@ -533,7 +838,17 @@ static void virtio_net_rxready(FAR struct virtqueue *vq)
 {
   FAR struct virtio_net_priv_s *priv = vq->vq_dev->priv;
 
-  virtqueue_disable_cb_lock(vq, &priv->lock[VIRTIO_NET_RX]);
+  virtqueue_disable_cb_lock(vq, &priv->lock[vq->vq_queue_index]);
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  if (priv->npairs > 1)
+    {
+      netdev_lower_rxready_queue((FAR struct netdev_lowerhalf_s *)priv,
+                                 VIRTIO_NET_QUEUE(vq));
+      return;
+    }
+#endif
+
   netdev_lower_rxready((FAR struct netdev_lowerhalf_s *)priv);
 }
 
@@ -545,10 +860,89 @@ static void virtio_net_txdone(FAR struct virtqueue *vq)
 {
   FAR struct virtio_net_priv_s *priv = vq->vq_dev->priv;
 
-  virtqueue_disable_cb_lock(vq, &priv->lock[VIRTIO_NET_TX]);
+  virtqueue_disable_cb_lock(vq, &priv->lock[vq->vq_queue_index]);
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  if (priv->npairs > 1)
+    {
+      netdev_lower_txdone_queue((FAR struct netdev_lowerhalf_s *)priv,
+                                VIRTIO_NET_QUEUE(vq));
+      return;
+    }
+#endif
+
   netdev_lower_txdone((FAR struct netdev_lowerhalf_s *)priv);
 }
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+/****************************************************************************
+ * Name: virtio_net_ctrldone
+ ****************************************************************************/
+
+static void virtio_net_ctrldone(FAR struct virtqueue *vq)
+{
+  FAR struct virtio_net_priv_s *priv = vq->vq_dev->priv;
+  FAR sem_t *sem;
+
+  sem = virtqueue_get_buffer_lock(vq, NULL, NULL,
+                                  &priv->lock[vq->vq_queue_index]);
+  if (sem != NULL)
+    {
+      nxsem_post(sem);
+    }
+}
+
+/****************************************************************************
+ * Name: virtio_net_ctrl
+ *
+ * Description:
+ *   Send a command with a 16-bit data member on the control virtqueue and
+ *   wait for its acknowledgement.
+ *
+ ****************************************************************************/
+
+static int virtio_net_ctrl(FAR struct virtio_net_priv_s *priv,
+                           uint8_t class, uint8_t cmd, uint16_t data)
+{
+  int vqid = priv->nvqs - 1;
+  FAR struct virtqueue *vq = priv->vdev->vrings_info[vqid].vq;
+  struct virtio_net_ctrl_s ctrl;
+  struct virtqueue_buf vb[3];
+  sem_t sem;
+  int ret;
+
+  ctrl.class = class;
+  ctrl.cmd   = cmd;
+  ctrl.data  = data;
+  ctrl.ack   = ~VIRTIO_NET_OK;
+
+  /* The header, the data and the acknowledgement are separate buffers */
+
+  vb[0].buf = &ctrl.class;
+  vb[0].len = 2;
+  vb[1].buf = &ctrl.data;
+  vb[1].len = sizeof(ctrl.data);
+  vb[2].buf = &ctrl.ack;
+  vb[2].len = sizeof(ctrl.ack);
+
+  nxsem_init(&sem, 0, 0);
+  ret = virtqueue_add_buffer_lock(vq, vb, 2, 1, &sem, &priv->lock[vqid]);
+  if (ret >= 0)
+    {
+      virtqueue_kick_lock(vq, &priv->lock[vqid]);
+      ret = nxsem_wait_uninterruptible(&sem);
+    }
+
+  nxsem_destroy(&sem);
+  if (ret >= 0 && ctrl.ack != VIRTIO_NET_OK)
+    {
+      ret = -EIO;
+    }
+
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: virtio_net_init
  ****************************************************************************/
@@ -556,12 +950,15 @@ static void virtio_net_txdone(FAR struct virtqueue *vq)
 static int virtio_net_init(FAR struct virtio_net_priv_s *priv,
                            FAR struct virtio_device *vdev)
 {
-  FAR const char *vqnames[VIRTIO_NET_NUM];
-  vq_callback callbacks[VIRTIO_NET_NUM];
+  FAR const char *vqnames[VIRTIO_NET_MAX_VQS];
+  vq_callback callbacks[VIRTIO_NET_MAX_VQS];
+  int rxniob;
   int ret;
+  int i;
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  uint16_t maxpairs;
+#endif
 
-  spin_lock_init(&priv->lock[VIRTIO_NET_RX]);
-  spin_lock_init(&priv->lock[VIRTIO_NET_TX]);
   priv->vdev = vdev;
   vdev->priv = priv;
 
@@ -569,14 +966,71 @@ static int virtio_net_init(FAR struct virtio_net_priv_s *priv,
 
   virtio_set_status(vdev, VIRTIO_CONFIG_STATUS_DRIVER);
   virtio_negotiate_features(vdev, (1UL << VIRTIO_NET_F_MAC) |
+                                  (1UL << VIRTIO_NET_F_MRG_RXBUF) |
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+                                  (1UL << VIRTIO_NET_F_CSUM) |
+                                  (1UL << VIRTIO_NET_F_GUEST_CSUM) |
+#  ifdef CONFIG_NETDEV_GSO
+                                  (1UL << VIRTIO_NET_F_HOST_TSO4) |
+                                  (1UL << VIRTIO_NET_F_HOST_TSO6) |
+#  endif
+#endif
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+                                  (1UL << VIRTIO_NET_F_CTRL_VQ) |
+                                  (1UL << VIRTIO_NET_F_MQ) |
+#endif
                                   (1UL << VIRTIO_F_ANY_LAYOUT), NULL);
   virtio_set_status(vdev, VIRTIO_CONFIG_FEATURES_OK);
 
-  vqnames[VIRTIO_NET_RX]   = "virtio_net_rx";
-  vqnames[VIRTIO_NET_TX]   = "virtio_net_tx";
-  callbacks[VIRTIO_NET_RX] = virtio_net_rxready;
-  callbacks[VIRTIO_NET_TX] = virtio_net_txdone;
-  ret = virtio_create_virtqueues(vdev, 0, VIRTIO_NET_NUM, vqnames,
+  /* The control virtqueue follows all the queue pairs of the device, they
+   * are only used if they fit in CONFIG_NETDEV_MAX_QUEUES.
+   */
+
+  priv->npairs = 1;
+  priv->nvqs   = VIRTIO_NET_NUM;
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  if (virtio_has_feature(vdev, VIRTIO_NET_F_CTRL_VQ) &&
+      virtio_has_feature(vdev, VIRTIO_NET_F_MQ))
+    {
+      virtio_read_config_member(vdev, struct virtio_net_config_s,
+                                max_virtqueue_pairs, &maxpairs);
+      if (maxpairs > 1 && maxpairs <= VIRTIO_NET_MAX_PAIRS)
+        {
+          priv->npairs = maxpairs;
+          priv->nvqs   = maxpairs * VIRTIO_NET_NUM + 1;
+        }
+      else if (maxpairs > VIRTIO_NET_MAX_PAIRS)
+        {
+          vrtwarn("%u queue pairs, only one used\n", maxpairs);
+        }
+    }
+#endif
+
+  for (i = 0; i < priv->nvqs; i++)
+    {
+      spin_lock_init(&priv->lock[i]);
+      if (i % VIRTIO_NET_NUM == VIRTIO_NET_RX)
+        {
+          vqnames[i]   = "virtio_net_rx";
+          callbacks[i] = virtio_net_rxready;
+        }
+      else
+        {
+          vqnames[i]   = "virtio_net_tx";
+          callbacks[i] = virtio_net_txdone;
+        }
+    }
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  if (priv->npairs > 1)
+    {
+      vqnames[priv->nvqs - 1]   = "virtio_net_ctrl";
+      callbacks[priv->nvqs - 1] = virtio_net_ctrldone;
+    }
+#endif
+
+  ret = virtio_create_virtqueues(vdev, 0, priv->nvqs, vqnames,
                                  callbacks, NULL);
   if (ret < 0)
     {
@@ -586,18 +1040,52 @@ static int virtio_net_init(FAR struct virtio_net_priv_s *priv,
 
   virtio_set_status(vdev, VIRTIO_CONFIG_STATUS_DRIVER_OK);
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  /* The device only uses the first queue pair until told otherwise */
+
+  if (priv->npairs > 1)
+    {
+      ret = virtio_net_ctrl(priv, VIRTIO_NET_CTRL_MQ,
+                            VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET, priv->npairs);
+      if (ret < 0)
+        {
+          vrterr("Set %u queue pairs failed, ret=%d\n", priv->npairs, ret);
+          priv->npairs = 1;
+        }
+    }
+#endif
+
+  /* With the mergeable RX buffers, the header is longer and a RX buffer
+   * is a single IOB.
+   */
+
+  if (virtio_has_feature(vdev, VIRTIO_NET_F_MRG_RXBUF))
+    {
+      priv->hdrlen   = sizeof(struct virtio_net_hdr_s);
+      priv->rxbuflen = VIRTIO_NET_MRG_BUFSIZE;
+      rxniob         = 1;
+    }
+  else
+    {
+      priv->hdrlen   = offsetof(struct virtio_net_hdr_s, num_buffers);
+      priv->rxbuflen = VIRTIO_NET_BUFSIZE;
+      rxniob         = VIRTIO_NET_MAX_NIOB;
+    }
+
 #if CONFIG_DRIVERS_VIRTIO_NET_BUFNUM > 0
-  priv->bufnum = CONFIG_DRIVERS_VIRTIO_NET_BUFNUM;
+  priv->bufnum   = CONFIG_DRIVERS_VIRTIO_NET_BUFNUM;
+  priv->rxbufnum = CONFIG_DRIVERS_VIRTIO_NET_BUFNUM;
 #else
   /* Calculate the virtio network buffer number:
-   * 1/4 for the TX netpkts, 1/4 for the RX netpkts.
+   * 1/4 for the TX netpkts, 1/4 for the RX netpkts, shared by the queues.
    */
 
-  priv->bufnum = CONFIG_IOB_NBUFFERS / VIRTIO_NET_MAX_NIOB / 4;
+  priv->bufnum   = CONFIG_IOB_NBUFFERS / VIRTIO_NET_MAX_NIOB / 4;
+  priv->rxbufnum = MAX(CONFIG_IOB_NBUFFERS / rxniob / 4 / priv->npairs, 1);
 #endif
-  priv->bufnum = MIN(vdev->vrings_info[VIRTIO_NET_RX].info.num_descs /
-                     (VIRTIO_NET_MAX_NIOB + 1), priv->bufnum);
-  priv->bufnum = MIN(vdev->vrings_info[VIRTIO_NET_TX].info.num_descs /
+  priv->rxbufnum = MIN(vdev->vrings_info[VIRTIO_NET_RXQ(0)].info.num_descs /
+                       (rxniob + 1), priv->rxbufnum);
+  priv->bufnum = MIN(vdev->vrings_info[VIRTIO_NET_TXQ(0)].info.num_descs /
                      (VIRTIO_NET_MAX_NIOB + 1), priv->bufnum);
   return OK;
 }
@@ -666,10 +1154,37 @@ static int virtio_net_probe(FAR struct virtio_device *vdev)
   /* Initialize the netdev lower half */
 
   netdev = (FAR struct netdev_lowerhalf_s *)priv;
-  netdev->quota[NETPKT_RX] = priv->bufnum;
+  netdev->quota[NETPKT_RX] = priv->rxbufnum * priv->npairs;
   netdev->quota[NETPKT_TX] = priv->bufnum;
   netdev->ops = &g_virtio_net_ops;
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  netdev->nqueues = priv->npairs;
+#endif
+
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+  if (virtio_has_feature(vdev, VIRTIO_NET_F_CSUM))
+    {
+      netdev->netdev.d_csumcaps = NETDEV_CSUM_IPv4 | NETDEV_CSUM_IPv6;
+
+      /* The device segments the TCP super-segments of which it completes
+       * the checksums
+       */
+
+#  ifdef CONFIG_NETDEV_GSO
+      if (virtio_has_feature(vdev, VIRTIO_NET_F_HOST_TSO4))
+        {
+          netdev->tso |= NETDEV_TSO_IPv4;
+        }
+
+      if (virtio_has_feature(vdev, VIRTIO_NET_F_HOST_TSO6))
+        {
+          netdev->tso |= NETDEV_TSO_IPv6;
+        }
+#  endif
+    }
+#endif
+
 #ifdef CONFIG_DRIVERS_WIFI_SIM
   /* If the WiFi interfaces has reached the setting value,
    * no more WiFi interfaces will be created.
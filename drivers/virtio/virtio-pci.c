@@ -484,7 +484,8 @@ uint64_t
 virtio_pci_negotiate_features(FAR struct virtio_device *vdev,
                               uint64_t features)
 {
-  features = features & vdev->func->get_features(vdev);
+  features = (features | VIRTIO_TRANSPORT_FEATURES) &
+             vdev->func->get_features(vdev);
   vdev->func->set_features(vdev, features);
   return features;
 }
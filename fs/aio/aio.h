@@ -31,8 +31,8 @@
 #include <string.h>
 #include <aio.h>
 
+#include <nuttx/fs/ioring.h>
 #include <nuttx/queue.h>
-#include <nuttx/wqueue.h>
 
 #ifdef CONFIG_FS_AIO
 
@@ -53,8 +53,9 @@
  ****************************************************************************/
 
 /* This structure contains one AIO control block and appends information
- * needed by the logic running on the worker thread.  These structures are
- * pre-allocated, the number pre-allocated controlled by CONFIG_FS_NAIOC.
+ * needed by the logic running on the I/O ring worker threads.  These
+ * structures are pre-allocated, the number pre-allocated controlled by
+ * CONFIG_FS_NAIOC.
  */
 
 struct file;
@@ -63,11 +64,8 @@ struct aio_container_s
   dq_entry_t aioc_link;            /* Supports a doubly linked list */
   FAR struct aiocb *aioc_aiocbp;   /* The contained AIO control block */
   FAR struct file *aioc_filep;     /* File structure to use with the I/O */
-  struct work_s aioc_work;         /* Used to defer I/O to the work thread */
+  struct ioring_req_s aioc_req;    /* The I/O ring request of the I/O */
   pid_t aioc_pid;                  /* ID of the waiting task */
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  uint8_t aioc_prio;               /* Priority of the waiting task */
-#endif
 };
 
 /****************************************************************************
@@ -206,11 +204,13 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Queue the asynchronous I/O to the I/O ring worker threads
  *
  * Input Parameters:
- *   arg - Worker argument.  In this case, a pointer to an instance of
- *     struct aiocb cast to void *.
+ *   aioc   - The AIO control block container
+ *   opcode - The I/O ring operation, IORING_OP_READ, IORING_OP_WRITE or
+ *            IORING_OP_FSYNC
+ *   offset - The file offset, -1 for the current file position
  *
  * Returned Value:
  *   Zero (OK) on success.  Otherwise, -1 is returned and the errno is set
@@ -218,7 +218,8 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
  *
  ****************************************************************************/
 
-int aio_queue(FAR struct aio_container_s *aioc, worker_t worker);
+int aio_queue(FAR struct aio_container_s *aioc, uint8_t opcode,
+              off_t offset);
 
 /****************************************************************************
  * Name: aio_signal
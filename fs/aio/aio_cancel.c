@@ -29,7 +29,7 @@
 #include <assert.h>
 #include <errno.h>
 
-#include <nuttx/wqueue.h>
+#include <nuttx/fs/ioring.h>
 
 #include "aio/aio.h"
 
@@ -124,12 +124,12 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
               /* Yes... attempt to cancel the I/O.  There are two
                * possibilities:* (1) the work has already been started and
                * is no longer queued, or (2) the work has not been started
-               * and is still in the work queue.  Only the second case can
-               * be canceled.  work_cancel() will return -ENOENT in the
-               * first case.
+               * and is still in the I/O ring queue.  Only the second case
+               * can be canceled.  ioring_cancel() will return -EBUSY in
+               * the first case.
                */
 
-              status = work_cancel(LPWORK, &aioc->aioc_work);
+              status = ioring_cancel(&aioc->aioc_req);
               if (status >= 0)
                 {
                   /* Remove the container from the list of pending
@@ -181,12 +181,12 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
               /* Yes... attempt to cancel the I/O.  There are two
                * possibilities:* (1) the work has already been started and
                * is no longer queued, or (2) the work has not been started
-               * and is still in the work queue.  Only the second case can
-               * be canceled.  work_cancel() will return -ENOENT in the
-               * first case.
+               * and is still in the I/O ring queue.  Only the second case
+               * can be canceled.  ioring_cancel() will return -EBUSY in
+               * the first case.
                */
 
-              status = work_cancel(LPWORK, &aioc->aioc_work);
+              status = ioring_cancel(&aioc->aioc_req);
               if (status >= 0)
                 {
                   /* Remove the container from the list of pending
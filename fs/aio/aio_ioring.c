@@ -0,0 +1,989 @@
+/****************************************************************************
+ * fs/aio/aio_ioring.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <sys/socket.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioring.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/mutex.h>
+#include <nuttx/net/net.h>
+#include <nuttx/sched.h>
+
+#include "fs_heap.h"
+
+#ifdef CONFIG_FS_AIO
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The states of a request */
+
+#define IORING_REQ_FREE      0     /* In the pool of its ring */
+#define IORING_REQ_QUEUED    1     /* Waiting for a worker thread */
+#define IORING_REQ_RUNNING   2     /* Executed by a worker thread */
+#define IORING_REQ_POLLSETUP 3     /* The poll is being set up */
+#define IORING_REQ_POLLFIRED 4     /* The poll fired during its setup */
+#define IORING_REQ_POLLING   5     /* Waiting for the poll events */
+#define IORING_REQ_POLLED    6     /* The poll fired, queued for teardown */
+
+/* The largest number of submission queue entries of a ring */
+
+#define IORING_MAX_ENTRIES   4096
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The requests queued for the worker threads, by decreasing priority and
+ * in order within a priority.  The poll callbacks may add requests from
+ * interrupt handlers, so the queue is protected by a spin lock.
+ */
+
+static dq_queue_t g_ioring_pending;
+static spinlock_t g_ioring_lock = SP_UNLOCKED;
+
+/* The file of the IOSQE_ORDERED request each worker thread executes:  The
+ * ordered requests of a file run one after the other, those of different
+ * files in parallel.
+ */
+
+static FAR struct file *g_ioring_busy[CONFIG_FS_IORING_NTHREADS];
+
+/* The statistics, protected by g_ioring_lock */
+
+static struct ioring_stats_s g_ioring_stats;
+
+/* The worker threads wait on g_ioring_sem while idle.  It is posted once
+ * per idle worker thread needed, not once per request, so that a batch of
+ * requests costs at most one wakeup per worker thread.
+ */
+
+static sem_t g_ioring_sem = SEM_INITIALIZER(0);
+static unsigned int g_ioring_idle;
+
+/* The worker threads are started with the first request */
+
+static mutex_t g_ioring_startlock = NXMUTEX_INITIALIZER;
+static bool g_ioring_started;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ioring_wakeup
+ *
+ * Description:
+ *   Wake up to 'nreqs' idle worker threads.  The caller holds
+ *   g_ioring_lock, it posts g_ioring_sem the returned number of times
+ *   after releasing it.
+ *
+ ****************************************************************************/
+
+static unsigned int ioring_wakeup(unsigned int nreqs)
+{
+  unsigned int nwake = MIN(nreqs, g_ioring_idle);
+
+  g_ioring_idle -= nwake;
+  return nwake;
+}
+
+/****************************************************************************
+ * Name: ioring_insert
+ *
+ * Description:
+ *   Insert a request in g_ioring_pending after the requests of a higher or
+ *   equal priority, and never before an ordered request of the same file.
+ *   The caller holds g_ioring_lock.
+ *
+ ****************************************************************************/
+
+static void ioring_insert(FAR struct ioring_req_s *req)
+{
+  FAR struct ioring_req_s *curr;
+  FAR dq_entry_t *prev = NULL;
+  FAR dq_entry_t *node;
+  bool ordered = (req->sqe.flags & IOSQE_ORDERED) != 0;
+
+  for (node = dq_peek(&g_ioring_pending); node != NULL; node = dq_next(node))
+    {
+      curr = (FAR struct ioring_req_s *)node;
+      if (curr->prio >= req->prio ||
+          (ordered && curr->filep == req->filep &&
+           (curr->sqe.flags & IOSQE_ORDERED) != 0))
+        {
+          prev = node;
+        }
+    }
+
+  if (prev == NULL)
+    {
+      dq_addfirst(&req->node, &g_ioring_pending);
+    }
+  else
+    {
+      dq_addafter(prev, &req->node, &g_ioring_pending);
+    }
+
+  g_ioring_stats.nqueued++;
+  g_ioring_stats.npending++;
+  if (g_ioring_stats.npending > g_ioring_stats.maxpending)
+    {
+      g_ioring_stats.maxpending = g_ioring_stats.npending;
+    }
+}
+
+/****************************************************************************
+ * Name: ioring_next
+ *
+ * Description:
+ *   Remove the first pending request that may start:  An ordered request
+ *   waits while another worker thread executes an ordered request of the
+ *   same file.  The caller holds g_ioring_lock.
+ *
+ ****************************************************************************/
+
+static FAR struct ioring_req_s *ioring_next(void)
+{
+  FAR struct ioring_req_s *req;
+  FAR dq_entry_t *node;
+  int i;
+
+  for (node = dq_peek(&g_ioring_pending); node != NULL; node = dq_next(node))
+    {
+      req = (FAR struct ioring_req_s *)node;
+      if (req->state == IORING_REQ_QUEUED && req->filep != NULL &&
+          (req->sqe.flags & IOSQE_ORDERED) != 0)
+        {
+          for (i = 0; i < CONFIG_FS_IORING_NTHREADS; i++)
+            {
+              if (g_ioring_busy[i] == req->filep)
+                {
+                  break;
+                }
+            }
+
+          if (i < CONFIG_FS_IORING_NTHREADS)
+            {
+              continue;
+            }
+        }
+
+      dq_rem(node, &g_ioring_pending);
+      g_ioring_stats.npending--;
+      return req;
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: ioring_complete
+ *
+ * Description:
+ *   Complete a request:  Call its completion callback, or release its file
+ *   and post its result to the completion queue of its ring.
+ *
+ ****************************************************************************/
+
+static void ioring_complete(FAR struct ioring_req_s *req, ssize_t res)
+{
+  FAR struct ioring_s *ring = req->ring;
+  FAR struct ioring_cqe_s *cqe;
+  irqstate_t flags;
+  bool wake;
+
+  if (req->complete != NULL)
+    {
+      req->state = IORING_REQ_FREE;
+      req->complete(req, res);
+      return;
+    }
+
+  if (req->filep != NULL)
+    {
+      fs_putfilep(req->filep);
+      req->filep = NULL;
+    }
+
+  flags = spin_lock_irqsave(&ring->lock);
+
+  /* The completion queue can not overflow:  ioring_submit() keeps fewer
+   * requests in flight than the queue has entries.
+   */
+
+  cqe = &ring->cqes[ring->cq_tail & ring->cq_mask];
+  cqe->user_data = req->sqe.user_data;
+  cqe->res       = res;
+
+  /* Publish the entry before its index */
+
+  SP_DMB();
+  ring->cq_tail++;
+  ring->inflight--;
+
+  req->state = IORING_REQ_FREE;
+  dq_addlast(&req->node, &ring->freereqs);
+
+  wake = ring->cqwaiters > 0 && (ring->flags & IORING_SETUP_CQPOLL) == 0;
+  if (wake)
+    {
+      ring->cqwaiters--;
+    }
+
+  spin_unlock_irqrestore(&ring->lock, flags);
+
+  if (wake)
+    {
+      nxsem_post(&ring->cqsem);
+    }
+}
+
+/****************************************************************************
+ * Name: ioring_pollnotify
+ *
+ * Description:
+ *   The poll callback of IORING_OP_POLL, possibly called from an interrupt
+ *   handler:  Queue the request again so that a worker thread tears the
+ *   poll down and completes it.
+ *
+ ****************************************************************************/
+
+static void ioring_pollnotify(FAR struct pollfd *fds)
+{
+  FAR struct ioring_req_s *req = fds->arg;
+  unsigned int nwake = 0;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_ioring_lock);
+  if (req->state == IORING_REQ_POLLSETUP)
+    {
+      /* The worker thread setting the poll up completes it */
+
+      req->state = IORING_REQ_POLLFIRED;
+    }
+  else if (req->state == IORING_REQ_POLLING)
+    {
+      /* The teardown is short, do it before the other requests */
+
+      req->state = IORING_REQ_POLLED;
+      dq_addfirst(&req->node, &g_ioring_pending);
+      g_ioring_stats.npending++;
+      nwake = ioring_wakeup(1);
+    }
+
+  spin_unlock_irqrestore(&g_ioring_lock, flags);
+
+  if (nwake > 0)
+    {
+      nxsem_post(&g_ioring_sem);
+    }
+}
+
+/****************************************************************************
+ * Name: ioring_poll
+ *
+ * Description:
+ *   Set the poll of an IORING_OP_POLL request up, or tear it down once it
+ *   fired.
+ *
+ * Returned Value:
+ *   true if the request is complete with the result in '*res', false if
+ *   it waits for the poll events.
+ *
+ ****************************************************************************/
+
+static bool ioring_poll(FAR struct ioring_req_s *req, FAR ssize_t *res)
+{
+  irqstate_t flags;
+  bool fired;
+  int ret;
+
+  if (req->state != IORING_REQ_POLLED)
+    {
+      req->fds.fd      = req->sqe.fd;
+      req->fds.events  = req->sqe.op_flags;
+      req->fds.revents = 0;
+      req->fds.arg     = req;
+      req->fds.cb      = ioring_pollnotify;
+      req->fds.priv    = NULL;
+
+      flags = spin_lock_irqsave(&g_ioring_lock);
+      req->state = IORING_REQ_POLLSETUP;
+      spin_unlock_irqrestore(&g_ioring_lock, flags);
+
+      ret = file_poll(req->filep, &req->fds, true);
+      if (ret < 0)
+        {
+          *res = ret;
+          return true;
+        }
+
+      /* The events may already be there */
+
+      flags = spin_lock_irqsave(&g_ioring_lock);
+      fired = req->state == IORING_REQ_POLLFIRED;
+      if (!fired)
+        {
+          req->state = IORING_REQ_POLLING;
+        }
+
+      spin_unlock_irqrestore(&g_ioring_lock, flags);
+
+      if (!fired)
+        {
+          return false;
+        }
+    }
+
+  file_poll(req->filep, &req->fds, false);
+  *res = req->fds.revents;
+  return true;
+}
+
+#ifdef CONFIG_NET
+/****************************************************************************
+ * Name: ioring_accept
+ *
+ * Description:
+ *   Accept a connection for IORING_OP_ACCEPT.  The descriptor of the new
+ *   socket is allocated in the task that submitted the request.
+ *
+ ****************************************************************************/
+
+static ssize_t ioring_accept(FAR struct ioring_req_s *req)
+{
+  FAR struct socket *psock = file_socket(req->filep);
+  FAR struct socket *newsock;
+  FAR struct tcb_s *tcb;
+  int oflags = O_RDWR;
+  int ret;
+
+  if (psock == NULL)
+    {
+      return -ENOTSOCK;
+    }
+
+  if ((req->sqe.op_flags & ~(SOCK_NONBLOCK | SOCK_CLOEXEC)) != 0)
+    {
+      return -EINVAL;
+    }
+
+  newsock = fs_heap_zalloc(sizeof(*newsock));
+  if (newsock == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ret = psock_accept(psock, req->sqe.addr, req->sqe.addr2, newsock,
+                     req->sqe.op_flags);
+  if (ret < 0)
+    {
+      goto errout_with_alloc;
+    }
+
+  if ((req->sqe.op_flags & SOCK_CLOEXEC) != 0)
+    {
+      oflags |= O_CLOEXEC;
+    }
+
+  if ((req->sqe.op_flags & SOCK_NONBLOCK) != 0)
+    {
+      oflags |= O_NONBLOCK;
+    }
+
+  tcb = nxsched_get_tcb(req->pid);
+  if (tcb == NULL)
+    {
+      ret = -ESRCH;
+      goto errout_with_psock;
+    }
+
+  ret = sockfd_allocate_from_tcb(tcb, newsock, oflags);
+  if (ret < 0)
+    {
+      goto errout_with_psock;
+    }
+
+  return ret;
+
+errout_with_psock:
+  psock_close(newsock);
+
+errout_with_alloc:
+  fs_heap_free(newsock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ioring_socket
+ *
+ * Description:
+ *   Perform IORING_OP_SEND or IORING_OP_RECV.
+ *
+ ****************************************************************************/
+
+static ssize_t ioring_socket(FAR struct ioring_req_s *req)
+{
+  FAR struct socket *psock = file_socket(req->filep);
+
+  if (psock == NULL)
+    {
+      return -ENOTSOCK;
+    }
+
+  if (req->sqe.opcode == IORING_OP_SEND)
+    {
+      return psock_send(psock, req->sqe.addr, req->sqe.len,
+                        req->sqe.op_flags);
+    }
+
+  return psock_recv(psock, req->sqe.addr, req->sqe.len, req->sqe.op_flags);
+}
+#endif
+
+/****************************************************************************
+ * Name: ioring_execute
+ *
+ * Description:
+ *   Execute a request on a worker thread, and complete it unless it waits
+ *   for poll events.
+ *
+ ****************************************************************************/
+
+static void ioring_execute(FAR struct ioring_req_s *req)
+{
+  FAR struct ioring_sqe_s *sqe = &req->sqe;
+  ssize_t res;
+
+  switch (sqe->opcode)
+    {
+      case IORING_OP_NOP:
+        res = 0;
+        break;
+
+      case IORING_OP_READ:
+        if (sqe->off < 0)
+          {
+            res = file_read(req->filep, sqe->addr, sqe->len);
+          }
+        else
+          {
+            res = file_pread(req->filep, sqe->addr, sqe->len, sqe->off);
+          }
+        break;
+
+      case IORING_OP_WRITE:
+        if (sqe->off < 0)
+          {
+            res = file_write(req->filep, sqe->addr, sqe->len);
+          }
+        else
+          {
+            res = file_pwrite(req->filep, sqe->addr, sqe->len, sqe->off);
+          }
+        break;
+
+      case IORING_OP_FSYNC:
+        res = file_fsync(req->filep);
+        break;
+
+      case IORING_OP_POLL:
+        if (!ioring_poll(req, &res))
+          {
+            return;
+          }
+        break;
+
+#ifdef CONFIG_NET
+      case IORING_OP_ACCEPT:
+        res = ioring_accept(req);
+        break;
+
+      case IORING_OP_SEND:
+      case IORING_OP_RECV:
+        res = ioring_socket(req);
+        break;
+#endif
+
+      default:
+        res = -ENOSYS;
+        break;
+    }
+
+  if (res < 0)
+    {
+      finfo("Operation %d failed: %zd\n", sqe->opcode, res);
+    }
+
+  ioring_complete(req, res);
+}
+
+/****************************************************************************
+ * Name: ioring_worker
+ *
+ * Description:
+ *   The worker threads execute the queued requests by priority, each at
+ *   the priority of the request.
+ *
+ ****************************************************************************/
+
+static int ioring_worker(int argc, FAR char *argv[])
+{
+  FAR struct ioring_req_s *req;
+  struct sched_param param;
+  irqstate_t flags;
+  int prio = CONFIG_FS_IORING_PRIORITY;
+  int id;
+
+  flags = spin_lock_irqsave(&g_ioring_lock);
+  id = g_ioring_stats.nthreads++;
+  spin_unlock_irqrestore(&g_ioring_lock, flags);
+
+  DEBUGASSERT(id < CONFIG_FS_IORING_NTHREADS);
+
+  for (; ; )
+    {
+      flags = spin_lock_irqsave(&g_ioring_lock);
+      req = ioring_next();
+      if (req == NULL)
+        {
+          g_ioring_idle++;
+          g_ioring_stats.nidle++;
+          spin_unlock_irqrestore(&g_ioring_lock, flags);
+          nxsem_wait_uninterruptible(&g_ioring_sem);
+
+          flags = spin_lock_irqsave(&g_ioring_lock);
+          g_ioring_stats.nidle--;
+          spin_unlock_irqrestore(&g_ioring_lock, flags);
+          continue;
+        }
+
+      if (req->state == IORING_REQ_QUEUED)
+        {
+          req->state = IORING_REQ_RUNNING;
+          if ((req->sqe.flags & IOSQE_ORDERED) != 0)
+            {
+              g_ioring_busy[id] = req->filep;
+            }
+        }
+
+      g_ioring_stats.nrunning++;
+      spin_unlock_irqrestore(&g_ioring_lock, flags);
+
+      if (req->prio != prio)
+        {
+          prio = req->prio;
+          param.sched_priority = prio;
+          nxsched_set_param(0, &param);
+        }
+
+      ioring_execute(req);
+
+      /* The request may be reused already, only its file was recorded */
+
+      flags = spin_lock_irqsave(&g_ioring_lock);
+      g_ioring_busy[id] = NULL;
+      g_ioring_stats.nrunning--;
+      spin_unlock_irqrestore(&g_ioring_lock, flags);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ioring_start
+ *
+ * Description:
+ *   Start the worker threads if they are not running yet.
+ *
+ ****************************************************************************/
+
+static int ioring_start(void)
+{
+  int ret = OK;
+  int i;
+
+  if (g_ioring_started)
+    {
+      return OK;
+    }
+
+  nxmutex_lock(&g_ioring_startlock);
+
+  for (i = 0; !g_ioring_started && i < CONFIG_FS_IORING_NTHREADS; i++)
+    {
+      ret = kthread_create("ioring", CONFIG_FS_IORING_PRIORITY,
+                           CONFIG_FS_IORING_STACKSIZE, ioring_worker, NULL);
+      if (ret < 0)
+        {
+          ferr("ERROR: Failed to start a worker thread: %d\n", ret);
+          break;
+        }
+    }
+
+  /* Run with fewer threads rather than none */
+
+  if (i > 0)
+    {
+      g_ioring_started = true;
+      ret = OK;
+    }
+
+  nxmutex_unlock(&g_ioring_startlock);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ioring_setup
+ *
+ * Description:
+ *   Allocate the queues of a ring.  'entries' is rounded up to a power of
+ *   two.
+ *
+ ****************************************************************************/
+
+int ioring_setup(FAR struct ioring_s *ring, unsigned int entries,
+                 uint32_t flags)
+{
+  unsigned int nentries = 1;
+  unsigned int i;
+
+  if (ring == NULL || entries == 0 || entries > IORING_MAX_ENTRIES ||
+      (flags & ~IORING_SETUP_CQPOLL) != 0)
+    {
+      return -EINVAL;
+    }
+
+  while (nentries < entries)
+    {
+      nentries <<= 1;
+    }
+
+  memset(ring, 0, sizeof(*ring));
+
+  /* The queues are shared with the application, the requests are private
+   * to the kernel.
+   */
+
+  ring->sqes = kumm_zalloc(nentries * sizeof(struct ioring_sqe_s) +
+                           2 * nentries * sizeof(struct ioring_cqe_s));
+  if (ring->sqes == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ring->reqs = fs_heap_zalloc(2 * nentries * sizeof(struct ioring_req_s));
+  if (ring->reqs == NULL)
+    {
+      kumm_free(ring->sqes);
+      ring->sqes = NULL;
+      return -ENOMEM;
+    }
+
+  ring->cqes    = (FAR struct ioring_cqe_s *)(ring->sqes + nentries);
+  ring->sq_mask = nentries - 1;
+  ring->cq_mask = 2 * nentries - 1;
+  ring->flags   = flags;
+
+  spin_lock_init(&ring->lock);
+  nxsem_init(&ring->cqsem, 0, 0);
+
+  for (i = 0; i < 2 * nentries; i++)
+    {
+      dq_addlast(&ring->reqs[i].node, &ring->freereqs);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ioring_teardown
+ *
+ * Description:
+ *   Release the queues of a ring.
+ *
+ ****************************************************************************/
+
+int ioring_teardown(FAR struct ioring_s *ring)
+{
+  irqstate_t flags;
+  uint32_t inflight;
+
+  DEBUGASSERT(ring != NULL);
+
+  flags    = spin_lock_irqsave(&ring->lock);
+  inflight = ring->inflight;
+  spin_unlock_irqrestore(&ring->lock, flags);
+
+  if (inflight > 0)
+    {
+      return -EBUSY;
+    }
+
+  nxsem_destroy(&ring->cqsem);
+  fs_heap_free(ring->reqs);
+  kumm_free(ring->sqes);
+  memset(ring, 0, sizeof(*ring));
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ioring_submit
+ *
+ * Description:
+ *   Submit all the entries added to the submission queue since the last
+ *   call, in a single batch.
+ *
+ ****************************************************************************/
+
+int ioring_submit(FAR struct ioring_s *ring)
+{
+  FAR struct ioring_req_s *req;
+  dq_queue_t queue;
+  unsigned int nreqs = 0;
+  irqstate_t flags;
+  pid_t pid = nxsched_getpid();
+  uint8_t prio = nxsched_self()->sched_priority;
+  int nsubmitted = 0;
+  int ret;
+
+  DEBUGASSERT(ring != NULL && ring->reqs != NULL);
+
+  dq_init(&queue);
+
+  while (ring->sq_head != ring->sq_tail)
+    {
+      /* Keep fewer requests in flight than the completion queue holds */
+
+      flags = spin_lock_irqsave(&ring->lock);
+      if (ring->inflight > ring->cq_mask)
+        {
+          spin_unlock_irqrestore(&ring->lock, flags);
+          break;
+        }
+
+      ring->inflight++;
+      req = (FAR struct ioring_req_s *)dq_remfirst(&ring->freereqs);
+      spin_unlock_irqrestore(&ring->lock, flags);
+
+      DEBUGASSERT(req != NULL);
+
+      req->sqe      = ring->sqes[ring->sq_head & ring->sq_mask];
+      req->ring     = ring;
+      req->filep    = NULL;
+      req->complete = NULL;
+      req->pid      = pid;
+      req->prio     = prio;
+      ring->sq_head++;
+      nsubmitted++;
+
+      if ((req->sqe.flags & ~IOSQE_ORDERED) != 0)
+        {
+          ioring_complete(req, -EINVAL);
+          continue;
+        }
+
+      /* The descriptor belongs to the caller, not to the worker threads */
+
+      if (req->sqe.opcode != IORING_OP_NOP)
+        {
+          ret = fs_getfilep(req->sqe.fd, &req->filep);
+          if (ret < 0)
+            {
+              req->filep = NULL;
+              ioring_complete(req, ret);
+              continue;
+            }
+        }
+
+      dq_addlast(&req->node, &queue);
+      nreqs++;
+    }
+
+  if (nreqs > 0)
+    {
+      ret = ioring_queue(&queue, nreqs);
+      if (ret < 0)
+        {
+          while ((req = (FAR struct ioring_req_s *)dq_remfirst(&queue)))
+            {
+              ioring_complete(req, ret);
+            }
+        }
+    }
+
+  return nsubmitted;
+}
+
+/****************************************************************************
+ * Name: ioring_wait_cqe
+ *
+ * Description:
+ *   Wait for an entry in the completion queue of a ring and return the
+ *   oldest one.
+ *
+ ****************************************************************************/
+
+int ioring_wait_cqe(FAR struct ioring_s *ring,
+                    FAR struct ioring_cqe_s **cqe)
+{
+  irqstate_t flags;
+  int ret;
+
+  DEBUGASSERT(ring != NULL && cqe != NULL);
+
+  if ((ring->flags & IORING_SETUP_CQPOLL) != 0)
+    {
+      return -EINVAL;
+    }
+
+  for (; ; )
+    {
+      flags = spin_lock_irqsave(&ring->lock);
+      if (ring->cq_head != ring->cq_tail)
+        {
+          spin_unlock_irqrestore(&ring->lock, flags);
+          *cqe = ioring_peek_cqe(ring);
+          return OK;
+        }
+
+      /* A waiter interrupted by a signal leaves its count behind:  The next
+       * completion then wakes up the next waiter once for nothing.
+       */
+
+      ring->cqwaiters++;
+      spin_unlock_irqrestore(&ring->lock, flags);
+
+      ret = nxsem_wait(&ring->cqsem);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: ioring_queue
+ *
+ * Description:
+ *   Queue the 'nreqs' requests of 'reqs' to the worker threads at once.
+ *
+ ****************************************************************************/
+
+int ioring_queue(FAR dq_queue_t *reqs, unsigned int nreqs)
+{
+  FAR struct ioring_req_s *req;
+  unsigned int nwake;
+  irqstate_t flags;
+  int ret;
+
+  ret = ioring_start();
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  flags = spin_lock_irqsave(&g_ioring_lock);
+  while ((req = (FAR struct ioring_req_s *)dq_remfirst(reqs)) != NULL)
+    {
+      req->state = IORING_REQ_QUEUED;
+      ioring_insert(req);
+    }
+
+  nwake = ioring_wakeup(nreqs);
+  spin_unlock_irqrestore(&g_ioring_lock, flags);
+
+  while (nwake-- > 0)
+    {
+      nxsem_post(&g_ioring_sem);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ioring_cancel
+ *
+ * Description:
+ *   Cancel a queued request that did not start.
+ *
+ ****************************************************************************/
+
+int ioring_cancel(FAR struct ioring_req_s *req)
+{
+  irqstate_t flags;
+  int ret = -EBUSY;
+
+  flags = spin_lock_irqsave(&g_ioring_lock);
+  if (req->state == IORING_REQ_QUEUED)
+    {
+      dq_rem(&req->node, &g_ioring_pending);
+      g_ioring_stats.npending--;
+      req->state = IORING_REQ_FREE;
+      ret = OK;
+    }
+
+  spin_unlock_irqrestore(&g_ioring_lock, flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ioring_getstats
+ *
+ * Description:
+ *   Return the statistics of the worker threads.
+ *
+ ****************************************************************************/
+
+void ioring_getstats(FAR struct ioring_stats_s *stats)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(stats != NULL);
+
+  flags = spin_lock_irqsave(&g_ioring_lock);
+  *stats = g_ioring_stats;
+  spin_unlock_irqrestore(&g_ioring_lock, flags);
+}
+
+#endif /* CONFIG_FS_AIO */
@@ -30,7 +30,9 @@
 #include <errno.h>
 #include <debug.h>
 
-#include <nuttx/wqueue.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/fs/ioring.h>
+#include <nuttx/sched.h>
 
 #include "aio/aio.h"
 
@@ -40,15 +42,65 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: aio_complete
+ *
+ * Description:
+ *   This function executes on an I/O ring worker thread once the
+ *   asynchronous I/O operation completed.
+ *
+ * Input Parameters:
+ *   req - The I/O ring request of an AIO control block container
+ *   res - The result of the operation
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void aio_complete(FAR struct ioring_req_s *req, ssize_t res)
+{
+  FAR struct aio_container_s *aioc =
+    container_of(req, struct aio_container_s, aioc_req);
+  FAR struct aiocb *aiocbp;
+  pid_t pid;
+
+  /* Get the information from the container, decant the AIO control block,
+   * and free the container before signalling the client.
+   */
+
+  DEBUGASSERT(aioc->aioc_aiocbp);
+  pid    = aioc->aioc_pid;
+  aiocbp = aioc_decant(aioc);
+
+#ifdef CONFIG_DEBUG_FS_ERROR
+  if (res < 0)
+    {
+      ferr("ERROR: operation %d failed: %zd\n", req->sqe.opcode, res);
+    }
+#endif
+
+  /* Set the result of the operation and signal the client */
+
+  aiocbp->aio_result = res;
+  aio_signal(pid, aiocbp);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
 /****************************************************************************
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Queue the asynchronous I/O to the I/O ring worker threads
  *
  * Input Parameters:
- *   arg - Worker argument.  In this case, a pointer to an instance of
- *     struct aiocb cast to void *.
+ *   aioc   - The AIO control block container
+ *   opcode - The I/O ring operation, IORING_OP_READ, IORING_OP_WRITE or
+ *            IORING_OP_FSYNC
+ *   offset - The file offset, -1 for the current file position
  *
  * Returned Value:
  *   Zero (OK) on success.  Otherwise, -1 is returned and the errno is set
@@ -56,43 +108,53 @@
  *
  ****************************************************************************/
 
-int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
+int aio_queue(FAR struct aio_container_s *aioc, uint8_t opcode,
+              off_t offset)
 {
+  FAR struct aiocb *aiocbp = aioc->aioc_aiocbp;
+  FAR struct ioring_req_s *req = &aioc->aioc_req;
+  dq_queue_t queue;
+  int prio;
   int ret;
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Prohibit context switches until we complete the queuing */
-
-  sched_lock();
+  DEBUGASSERT(aiocbp);
 
-  /* Make sure that the low-priority worker thread is running at at least
-   * the priority specified for this action.
+  /* The operation runs at the priority of the caller minus aio_reqprio.
+   * The operations of a file start in the order they are queued.
    */
 
-  lpwork_boostpriority(aioc->aioc_prio);
-#endif
-
-  /* Schedule the work on the low priority worker thread */
+  prio = nxsched_self()->sched_priority - aiocbp->aio_reqprio;
+  if (prio < SCHED_PRIORITY_MIN)
+    {
+      prio = SCHED_PRIORITY_MIN;
+    }
 
-  ret = work_queue(LPWORK, &aioc->aioc_work, worker, aioc, 0);
+  /* The container keeps the reference to the file until it is decanted */
+
+  req->ring           = NULL;
+  req->filep          = aioc->aioc_filep;
+  req->complete       = aio_complete;
+  req->pid            = aioc->aioc_pid;
+  req->prio           = prio;
+  req->sqe.opcode     = opcode;
+  req->sqe.flags      = IOSQE_ORDERED;
+  req->sqe.fd         = aiocbp->aio_fildes;
+  req->sqe.off        = offset;
+  req->sqe.addr       = (FAR void *)aiocbp->aio_buf;
+  req->sqe.len        = aiocbp->aio_nbytes;
+  req->sqe.user_data  = aioc;
+
+  dq_init(&queue);
+  dq_addlast(&req->node, &queue);
+
+  ret = ioring_queue(&queue, 1);
   if (ret < 0)
     {
-      FAR struct aiocb *aiocbp = aioc->aioc_aiocbp;
-      DEBUGASSERT(aiocbp);
-
-#ifdef CONFIG_PRIORITY_INHERITANCE
-      lpwork_restorepriority(aioc->aioc_prio);
-#endif
       aiocbp->aio_result = ret;
       set_errno(-ret);
       ret = ERROR;
     }
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Now the low-priority work queue might run at its new priority */
-
-  sched_unlock();
-#endif
   return ret;
 }
 
@@ -37,81 +37,6 @@
 
 #ifdef CONFIG_FS_AIO
 
-/****************************************************************************
- * Private Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: aio_read_worker
- *
- * Description:
- *   This function executes on the worker thread and performs the
- *   asynchronous I/O operation.
- *
- * Input Parameters:
- *   arg - Worker argument.  In this case, a pointer to an instance of
- *     struct aiocb cast to void *.
- *
- * Returned Value:
- *   None
- *
- ****************************************************************************/
-
-static void aio_read_worker(FAR void *arg)
-{
-  FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
-  FAR struct aiocb *aiocbp;
-  pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  uint8_t prio;
-#endif
-  ssize_t nread = 0;
-
-  /* Get the information from the container, decant the AIO control block,
-   * and free the container before starting any I/O.  That will minimize
-   * the delays by any other threads waiting for a pre-allocated container.
-   */
-
-  DEBUGASSERT(aioc && aioc->aioc_aiocbp);
-  pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  prio   = aioc->aioc_prio;
-#endif
-  aiocbp = aioc_decant(aioc);
-
-  /* Perform the file read using:
-   *
-   *   aioc_filep   - File structure pointer
-   *   aio_buf      - Location of buffer
-   *   aio_nbytes   - Length of transfer
-   *   aio_offset   - File offset
-   */
-
-  nread = file_pread(aioc->aioc_filep, (FAR void *)aiocbp->aio_buf,
-                     aiocbp->aio_nbytes, aiocbp->aio_offset);
-
-  /* Set the result of the read operation. */
-
-#ifdef CONFIG_DEBUG_FS_ERROR
-  if (nread < 0)
-    {
-      ferr("ERROR: read failed: %d\n", (int)nread);
-    }
-#endif
-
-  aiocbp->aio_result = nread;
-
-  /* Signal the client */
-
-  aio_signal(pid, aiocbp);
-
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Restore the low priority worker thread default priority */
-
-  lpwork_restorepriority(prio);
-#endif
-}
-
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -266,9 +191,9 @@ int aio_read(FAR struct aiocb *aiocbp)
       return ERROR;
     }
 
-  /* Defer the work to the worker thread */
+  /* Queue the work to the I/O ring worker threads */
 
-  ret = aio_queue(aioc, aio_read_worker);
+  ret = aio_queue(aioc, IORING_OP_READ, aiocbp->aio_offset);
   if (ret < 0)
     {
       /* The result and the errno have already been set */
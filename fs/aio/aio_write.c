@@ -39,107 +39,6 @@
 
 #ifdef CONFIG_FS_AIO
 
-/****************************************************************************
- * Private Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: aio_write_worker
- *
- * Description:
- *   This function executes on the worker thread and performs the
- *   asynchronous I/O operation.
- *
- * Input Parameters:
- *   arg - Worker argument.  In this case, a pointer to an instance of
- *     struct aiocb cast to void *.
- *
- * Returned Value:
- *   None
- *
- ****************************************************************************/
-
-static void aio_write_worker(FAR void *arg)
-{
-  FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
-  FAR struct aiocb *aiocbp;
-  pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  uint8_t prio;
-#endif
-  ssize_t nwritten = 0;
-  int oflags;
-
-  /* Get the information from the container, decant the AIO control block,
-   * and free the container before starting any I/O.  That will minimize
-   * the delays by any other threads waiting for a pre-allocated container.
-   */
-
-  DEBUGASSERT(aioc && aioc->aioc_aiocbp);
-  pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  prio   = aioc->aioc_prio;
-#endif
-  aiocbp = aioc_decant(aioc);
-
-  /* Call fcntl(F_GETFL) to get the file open mode. */
-
-  oflags = file_fcntl(aioc->aioc_filep, F_GETFL);
-  if (oflags < 0)
-    {
-      ferr("ERROR: file_fcntl failed: %d\n", oflags);
-      aiocbp->aio_result = oflags;
-      goto errout;
-    }
-
-  /* Perform the write using:
-   *
-   *   aioc_filep   - File structure pointer
-   *   aio_buf      - Location of buffer
-   *   aio_nbytes   - Length of transfer
-   *   aio_offset   - File offset
-   */
-
-  /* Check if O_APPEND is set in the file open flags */
-
-  if ((oflags & O_APPEND) != 0)
-    {
-      /* Append to the current file position */
-
-      nwritten = file_write(aioc->aioc_filep,
-                            (FAR const void *)aiocbp->aio_buf,
-                            aiocbp->aio_nbytes);
-    }
-  else
-    {
-      nwritten = file_pwrite(aioc->aioc_filep,
-                             (FAR const void *)aiocbp->aio_buf,
-                             aiocbp->aio_nbytes,
-                             aiocbp->aio_offset);
-    }
-
-  if (nwritten < 0)
-    {
-      ferr("ERROR: write/pwrite/send failed: %zd\n", nwritten);
-    }
-
-  /* Save the result of the write */
-
-  aiocbp->aio_result = nwritten;
-
-errout:
-
-  /* Signal the client */
-
-  aio_signal(pid, aiocbp);
-
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Restore the low priority worker thread default priority */
-
-  lpwork_restorepriority(prio);
-#endif
-}
-
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -303,9 +202,24 @@ int aio_write(FAR struct aiocb *aiocbp)
       return ERROR;
     }
 
-  /* Defer the work to the worker thread */
+  /* Append to the current file position if O_APPEND is set in the file
+   * open flags.
+   */
+
+  flags = file_fcntl(aioc->aioc_filep, F_GETFL);
+  if (flags < 0)
+    {
+      ferr("ERROR: file_fcntl failed: %d\n", flags);
+      aiocbp->aio_result = flags;
+      aioc_decant(aioc);
+      set_errno(-flags);
+      return ERROR;
+    }
+
+  /* Queue the work to the I/O ring worker threads */
 
-  ret = aio_queue(aioc, aio_write_worker);
+  ret = aio_queue(aioc, IORING_OP_WRITE,
+                  (flags & O_APPEND) != 0 ? -1 : aiocbp->aio_offset);
   if (ret < 0)
     {
       /* The result and the errno have already been set */
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/mman.h>
 #include <sys/statfs.h>
 #include <sys/stat.h>
 
@@ -72,6 +73,8 @@ struct cromfs_file_s
   uint32_t ff_offset;                       /* Cached block offset (zero means none) */
   uint16_t ff_ulen;                         /* Length of decompressed data in cache */
   FAR uint8_t *ff_buffer;                   /* Cached, decompressed data */
+  uint32_t ff_hdroffs;                      /* Header of the last block read (zero means none) */
+  uint32_t ff_blkoffs;                      /* File offset of the last block read */
 };
 
 /* This is the form of the callback from cromfs_foreach_node(): */
@@ -135,6 +138,9 @@ static int      cromfs_find_node(FAR const struct cromfs_volume_s *fs,
                                  FAR const char *relpath,
                                  FAR struct cromfs_nodeinfo_s *info,
                                  FAR uint32_t *offset);
+static FAR void *cromfs_xipaddr(FAR const struct cromfs_volume_s *fs,
+                                FAR const struct cromfs_node_s *node,
+                                off_t offset, size_t length);
 
 /* Common file system methods */
 
@@ -145,6 +151,8 @@ static ssize_t  cromfs_read(FAR struct file *filep,
                             FAR char *buffer, size_t buflen);
 static int      cromfs_ioctl(FAR struct file *filep,
                              int cmd, unsigned long arg);
+static int      cromfs_mmap(FAR struct file *filep,
+                            FAR struct mm_map_entry_s *map);
 
 static int      cromfs_dup(FAR const struct file *oldp,
                            FAR struct file *newp);
@@ -189,7 +197,7 @@ const struct mountpt_operations g_cromfs_operations =
   NULL,              /* write */
   NULL,              /* seek */
   cromfs_ioctl,      /* ioctl */
-  NULL,              /* mmap */
+  cromfs_mmap,       /* mmap */
   NULL,              /* truncate */
   NULL,              /* poll */
 
@@ -724,6 +732,71 @@ static int cromfs_find_node(FAR const struct cromfs_volume_s *fs,
     }
 }
 
+/****************************************************************************
+ * Name: cromfs_xipaddr
+ *
+ * Description:
+ *   Return the address in the image of 'length' bytes of a file at
+ *   'offset', or NULL if they are not stored uncompressed in one block.
+ *
+ ****************************************************************************/
+
+static FAR void *cromfs_xipaddr(FAR const struct cromfs_volume_s *fs,
+                                FAR const struct cromfs_node_s *node,
+                                off_t offset, size_t length)
+{
+  FAR struct lzf_header_s *hdr;
+  off_t blkoffs = 0;
+  uint32_t blksize;
+  uint16_t ulen;
+
+  if (offset < 0 || length == 0 || offset + length > node->cn_size)
+    {
+      return NULL;
+    }
+
+  hdr = (FAR struct lzf_header_s *)
+        cromfs_offset2addr(fs, node->u.cn_blocks);
+
+  for (; ; )
+    {
+      if (hdr->lzf_type == LZF_TYPE0_HDR)
+        {
+          FAR struct lzf_type0_header_s *hdr0 =
+            (FAR struct lzf_type0_header_s *)hdr;
+
+          ulen    = (uint16_t)hdr0->lzf_len[0] << 8 |
+                    (uint16_t)hdr0->lzf_len[1];
+          blksize = (uint32_t)ulen + LZF_TYPE0_HDR_SIZE;
+        }
+      else
+        {
+          FAR struct lzf_type1_header_s *hdr1 =
+            (FAR struct lzf_type1_header_s *)hdr;
+
+          ulen    = (uint16_t)hdr1->lzf_ulen[0] << 8 |
+                    (uint16_t)hdr1->lzf_ulen[1];
+          blksize = ((uint32_t)hdr1->lzf_clen[0] << 8 |
+                     (uint32_t)hdr1->lzf_clen[1]) + LZF_TYPE1_HDR_SIZE;
+        }
+
+      if (offset < blkoffs + ulen)
+        {
+          if (hdr->lzf_type != LZF_TYPE0_HDR ||
+              offset + length > blkoffs + ulen)
+            {
+              return NULL;
+            }
+
+          return (FAR uint8_t *)hdr + LZF_TYPE0_HDR_SIZE +
+                 (offset - blkoffs);
+        }
+
+      blkoffs += ulen;
+      hdr      = (FAR struct lzf_header_s *)((FAR uint8_t *)hdr + blksize);
+    }
+}
+
 /****************************************************************************
  * Name: cromfs_open
  ****************************************************************************/
@@ -903,6 +976,15 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
   nexthdr   = (FAR struct lzf_header_s *)
                cromfs_offset2addr(fs, ff->ff_node->u.cn_blocks);
 
+  /* The sequential reads resume the search at the last block read */
+
+  if (ff->ff_hdroffs != 0 && fpos >= ff->ff_blkoffs)
+    {
+      blkoffs = ff->ff_blkoffs;
+      nexthdr = (FAR struct lzf_header_s *)
+                 cromfs_offset2addr(fs, ff->ff_hdroffs);
+    }
+
   /* Look until we find the compressed block containing the start of the
    * requested data.
    */
@@ -950,6 +1032,9 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
         }
       while (fpos >= (blkoffs + ulen));
 
+      ff->ff_hdroffs = cromfs_addr2offset(fs, currhdr);
+      ff->ff_blkoffs = blkoffs;
+
       /* Check if we need to decompress the next block into the user
        * buffer.
        */
@@ -998,20 +1083,21 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
 
               src     = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
               voloffs = cromfs_addr2offset(fs, src);
-              if (voloffs != ff->ff_offset)
+              if (voloffs == ff->ff_offset)
                 {
-                  unsigned int decomplen;
-
-                  decomplen = lzf_decompress(src, clen, dest, fs->cv_bsize);
+                  DEBUGASSERT(ff->ff_ulen >= copysize);
+                  memcpy(dest, ff->ff_buffer, copysize);
+                }
+              else
+                {
+                  /* The block is not kept in the cache buffer */
 
-                  ff->ff_offset = voloffs;
-                  ff->ff_ulen   = decomplen;
+                  lzf_decompress(src, clen, dest, fs->cv_bsize);
                 }
 
               finfo("voloffs=%" PRIu32 " blkoffs=%" PRIu32
                     " ulen=%" PRIu16 " ff_offset=%" PRIu32 " copysize=%u\n",
                     voloffs, blkoffs, ulen, ff->ff_offset, copysize);
-              DEBUGASSERT(ff->ff_ulen >= copysize);
             }
           else
             {
@@ -1080,13 +1166,69 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
 
 static int cromfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 {
+  FAR const struct cromfs_volume_s *fs;
+  FAR struct cromfs_file_s *ff;
+  FAR void *addr;
+
   finfo("cmd: %d arg: %08lx\n", cmd, arg);
+  DEBUGASSERT(filep->f_priv != NULL);
+
+  fs = filep->f_inode->i_private;
+  ff = filep->f_priv;
+
+  /* A file stored uncompressed in a single block is executed in place */
 
-  /* No IOCTL commands yet supported */
+  if (cmd == FIOC_XIPBASE)
+    {
+      addr = cromfs_xipaddr(fs, ff->ff_node, 0, ff->ff_node->cn_size);
+      if (addr == NULL)
+        {
+          return -ENXIO;
+        }
+
+      *(FAR uintptr_t *)arg = (uintptr_t)addr;
+      return OK;
+    }
 
   return -ENOTTY;
 }
 
+/****************************************************************************
+ * Name: cromfs_mmap
+ *
+ * Description:
+ *   Map the data of a file in place if it is stored uncompressed in a
+ *   single block.  The other data is copied to memory by the caller.
+ *
+ ****************************************************************************/
+
+static int cromfs_mmap(FAR struct file *filep,
+                       FAR struct mm_map_entry_s *map)
+{
+  FAR const struct cromfs_volume_s *fs;
+  FAR struct cromfs_file_s *ff;
+  FAR void *addr;
+
+  DEBUGASSERT(filep->f_priv != NULL);
+
+  fs = filep->f_inode->i_private;
+  ff = filep->f_priv;
+
+  if ((map->prot & PROT_WRITE) != 0)
+    {
+      return -ENOTTY;
+    }
+
+  addr = cromfs_xipaddr(fs, ff->ff_node, map->offset, map->length);
+  if (addr == NULL)
+    {
+      return -ENOTTY;
+    }
+
+  map->vaddr = addr;
+  return OK;
+}
+
 /****************************************************************************
  * Name: cromfs_dup
  *
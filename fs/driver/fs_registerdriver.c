@@ -27,6 +27,7 @@
 #include <sys/types.h>
 #include <errno.h>
 
+#include <nuttx/boottrace.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/sched_note.h>
 
@@ -68,6 +69,7 @@ int register_driver(FAR const char *path,
   int ret;
 
   sched_note_mark(NOTE_TAG_DRIVERS, path);
+  boottrace_mark("drv %s", path);
 
   /* Insert a dummy node -- we need to hold the inode semaphore because we
    * will have a momentarily bad structure.
@@ -27,6 +27,7 @@
 #include <sys/types.h>
 #include <errno.h>
 
+#include <nuttx/boottrace.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/mtd/mtd.h>
 
@@ -68,6 +69,8 @@ int register_mtddriver(FAR const char *path, FAR struct mtd_dev_s *mtd,
   FAR struct inode *node;
   int ret;
 
+  boottrace_mark("drv %s", path);
+
   /* Insert an inode for the device driver -- we need to hold the inode
    * semaphore to prevent access to the tree while we this.  This is because
    * we will have a momentarily bad true until we populate the inode with
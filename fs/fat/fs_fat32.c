@@ -28,6 +28,8 @@
 #include <sys/stat.h>
 #include <sys/statfs.h>
 #include <sys/mount.h>
+#include <sys/param.h>
+#include <sys/uio.h>
 
 #include <stdlib.h>
 #include <unistd.h>
@@ -69,6 +71,10 @@ static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
                  size_t buflen);
 static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
                  size_t buflen);
+static ssize_t fat_readv(FAR struct file *filep,
+                 FAR const struct iovec *iov, int iovcnt);
+static ssize_t fat_writev(FAR struct file *filep,
+                 FAR const struct iovec *iov, int iovcnt);
 static off_t   fat_seek(FAR struct file *filep, off_t offset, int whence);
 static int     fat_ioctl(FAR struct file *filep, int cmd,
                  unsigned long arg);
@@ -151,7 +157,11 @@ const struct mountpt_operations g_fat_operations =
   fat_rmdir,         /* rmdir */
   fat_rename,        /* rename */
   fat_stat,          /* stat */
-  NULL               /* chstat */
+  NULL,              /* chstat */
+  NULL,              /* syncfs */
+  NULL,              /* fileid */
+  fat_readv,         /* readv */
+  fat_writev         /* writev */
 };
 
 /****************************************************************************
@@ -617,6 +627,23 @@ static int fat_get_sectors(FAR struct file *filep, bool read)
 
   /* Traverse the existing chain */
 
+#if CONFIG_FAT_NEXTENTS > 0
+  /* The runs of clusters cached for the file avoid most of the walk */
+
+  i = MIN(num_clu, new_num_clu);
+  if (num_traversed < i)
+    {
+      cluster = fat_ffcluster(fs, ff, i - 1, num_traversed - 1, cluster);
+      if (cluster < 0)
+        {
+          return cluster;
+        }
+    }
+  else
+    {
+      i = num_traversed;
+    }
+#else
   for (i = num_traversed; i < num_clu && i < new_num_clu; i++)
     {
       cluster = fat_getcluster(fs, cluster);
@@ -628,6 +655,7 @@ static int fat_get_sectors(FAR struct file *filep, bool read)
           return -EIO;
         }
     }
+#endif
 
   if (read)
     {
@@ -740,11 +768,102 @@ out:
 }
 
 /****************************************************************************
- * Name: fat_read
+ * Name: fat_contiguous_sectors
+ *
+ * Description:
+ *   Extend a direct transfer of up to 'nsectors' sectors from the current
+ *   sector over the clusters that follow the current cluster contiguously
+ *   on the media, so that a single block driver request covers them all.
+ *
+ * Returned Value:
+ *   The number of sectors to transfer, a negated errno value on failure.
+ *   '*nclusters' returns the number of clusters after the current one that
+ *   the transfer reaches.
+ *
  ****************************************************************************/
 
-static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
-                        size_t buflen)
+#ifndef CONFIG_FAT_FORCE_INDIRECT
+static int fat_contiguous_sectors(FAR struct fat_mountpt_s *fs,
+                                  FAR struct fat_file_s *ff,
+                                  unsigned int nsectors,
+                                  FAR unsigned int *nclusters)
+{
+  uint32_t cluster = ff->ff_currentcluster;
+  unsigned int count = ff->ff_sectorsincluster;
+  off_t next;
+
+  *nclusters = 0;
+  while (count < nsectors)
+    {
+      next = fat_getcluster(fs, cluster);
+      if (next < 0)
+        {
+          return next;
+        }
+
+      /* Stop at the end of the chain or at the first discontinuity */
+
+      if (next != cluster + 1)
+        {
+          break;
+        }
+
+      cluster = next;
+      count  += fs->fs_fatsecperclus;
+      (*nclusters)++;
+    }
+
+  return MIN(count, nsectors);
+}
+
+/****************************************************************************
+ * Name: fat_advance_sectors
+ *
+ * Description:
+ *   Update the position in the cluster chain of a file after a direct
+ *   transfer of 'nsectors' sectors that reached 'nclusters' clusters after
+ *   the current one.
+ *
+ ****************************************************************************/
+
+static void fat_advance_sectors(FAR struct fat_mountpt_s *fs,
+                                FAR struct fat_file_s *ff,
+                                unsigned int nsectors,
+                                unsigned int nclusters)
+{
+  unsigned int remaining;
+
+  remaining = ff->ff_sectorsincluster +
+              nclusters * fs->fs_fatsecperclus - nsectors;
+
+  if (nclusters > 0)
+    {
+      ff->ff_currentcluster += nclusters;
+      ff->ff_pos            += (off_t)nclusters * fs->fs_fatsecperclus *
+                               fs->fs_hwsectorsize;
+      ff->ff_currentsector   = fat_cluster2sector(fs,
+                                                ff->ff_currentcluster) +
+                               fs->fs_fatsecperclus - remaining;
+    }
+  else
+    {
+      ff->ff_currentsector  += nsectors;
+    }
+
+  ff->ff_sectorsincluster = remaining;
+}
+#endif
+
+/****************************************************************************
+ * Name: fat_read_locked
+ *
+ * Description:
+ *   Read at the file position with the file system locked.
+ *
+ ****************************************************************************/
+
+static ssize_t fat_read_locked(FAR struct file *filep, FAR char *buffer,
+                               size_t buflen)
 {
   FAR struct inode *inode;
   FAR struct fat_mountpt_s *fs;
@@ -757,6 +876,7 @@ static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
   int ret;
 
 #ifndef CONFIG_FAT_FORCE_INDIRECT
+  unsigned int nclusters;
   unsigned int nsectors;
   bool force_indirect = false;
 #endif
@@ -765,42 +885,16 @@ static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
 
   DEBUGASSERT(filep->f_priv != NULL);
 
-  /* Recover our private data from the struct file instance */
-
-  ff = filep->f_priv;
-
-  /* Check for the forced mount condition */
-
-  if ((ff->ff_bflags & UMOUNT_FORCED) != 0)
-    {
-      return -EPIPE;
-    }
-
+  ff    = filep->f_priv;
   inode = filep->f_inode;
   fs    = inode->i_private;
 
-  DEBUGASSERT(fs != NULL);
-
-  /* Make sure that the mount is still healthy */
-
-  ret = nxmutex_lock(&fs->fs_lock);
-  if (ret < 0)
-    {
-      return ret;
-    }
-
-  ret = fat_checkmount(fs);
-  if (ret != OK)
-    {
-      goto errout_with_lock;
-    }
-
   /* Check if the file was opened with read access */
 
   if ((ff->ff_oflags & O_RDOK) == 0)
     {
       ret = -EACCES;
-      goto errout_with_lock;
+      goto errout;
     }
 
   /* Check that the file position is not past the end of the file */
@@ -810,7 +904,7 @@ static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
       /* Return EOF */
 
       ret = 0;
-      goto errout_with_lock;
+      goto errout;
     }
   else
     {
@@ -843,7 +937,7 @@ static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
       ret = fat_get_sectors(filep, true);
       if (ret < 0)
         {
-          goto errout_with_lock;
+          goto errout;
         }
 
 #ifdef CONFIG_FAT_DIRECT_RETRY /* Warning avoidance */
@@ -864,14 +958,17 @@ fat_read_restart:
            *
            * Limit the number of sectors that we read on this time
            * through the loop to the remaining contiguous sectors
-           * in this cluster
+           * in this cluster and the clusters that follow it on the media.
            */
 
-          if (nsectors > ff->ff_sectorsincluster)
+          ret = fat_contiguous_sectors(fs, ff, nsectors, &nclusters);
+          if (ret < 0)
             {
-              nsectors = ff->ff_sectorsincluster;
+              goto errout;
             }
 
+          nsectors = ret;
+
           /* We are not sure of the state of the file buffer so
            * the safest thing to do is just invalidate it
            */
@@ -901,12 +998,11 @@ fat_read_restart:
                 }
 #endif /* CONFIG_FAT_DIRECT_RETRY */
 
-              goto errout_with_lock;
+              goto errout;
             }
 
-          ff->ff_sectorsincluster -= nsectors;
-          ff->ff_currentsector    += nsectors;
-          bytesread                = nsectors * fs->fs_hwsectorsize;
+          fat_advance_sectors(fs, ff, nsectors, nclusters);
+          bytesread = nsectors * fs->fs_hwsectorsize;
         }
       else
 #endif /* CONFIG_FAT_FORCE_INDIRECT */
@@ -920,7 +1016,7 @@ fat_read_restart:
           ret = fat_ffcacheread(fs, ff, ff->ff_currentsector);
           if (ret < 0)
             {
-              goto errout_with_lock;
+              goto errout;
             }
 
           /* Copy the requested part of the sector into the user buffer */
@@ -952,20 +1048,22 @@ fat_read_restart:
       sectorindex   = filep->f_pos & SEC_NDXMASK(fs);
     }
 
-  nxmutex_unlock(&fs->fs_lock);
   return readsize;
 
-errout_with_lock:
-  nxmutex_unlock(&fs->fs_lock);
+errout:
   return ret;
 }
 
 /****************************************************************************
- * Name: fat_write
+ * Name: fat_write_locked
+ *
+ * Description:
+ *   Write at the file position with the file system locked.
+ *
  ****************************************************************************/
 
-static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
-                         size_t buflen)
+static ssize_t fat_write_locked(FAR struct file *filep,
+                                FAR const char *buffer, size_t buflen)
 {
   FAR struct inode *inode;
   FAR struct fat_mountpt_s *fs;
@@ -977,48 +1075,23 @@ static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
   int ret;
 
 #ifndef CONFIG_FAT_FORCE_INDIRECT
+  unsigned int nclusters;
   unsigned int nsectors;
   bool force_indirect = false;
 #endif
 
   DEBUGASSERT(filep->f_priv != NULL);
 
-  /* Recover our private data from the struct file instance */
-
-  ff = filep->f_priv;
-
-  /* Check for the forced mount condition */
-
-  if ((ff->ff_bflags & UMOUNT_FORCED) != 0)
-    {
-      return -EPIPE;
-    }
-
+  ff    = filep->f_priv;
   inode = filep->f_inode;
   fs    = inode->i_private;
 
-  DEBUGASSERT(fs != NULL);
-
-  /* Make sure that the mount is still healthy */
-
-  ret = nxmutex_lock(&fs->fs_lock);
-  if (ret < 0)
-    {
-      return ret;
-    }
-
-  ret = fat_checkmount(fs);
-  if (ret != OK)
-    {
-      goto errout_with_lock;
-    }
-
   /* Check if the file was opened for write access */
 
   if ((ff->ff_oflags & O_WROK) == 0)
     {
       ret = -EACCES;
-      goto errout_with_lock;
+      goto errout;
     }
 
   /* Check if the file size would exceed the range of off_t */
@@ -1026,7 +1099,7 @@ static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
   if (buflen > OFF_MAX || ff->ff_size > OFF_MAX - (off_t)buflen)
     {
       ret = -EFBIG;
-      goto errout_with_lock;
+      goto errout;
     }
 
   /* Loop until either (1) all data has been transferred, or (2) an
@@ -1042,7 +1115,7 @@ static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
       ret = fat_get_sectors(filep, false);
       if (ret < 0)
         {
-          goto errout_with_lock;
+          goto errout;
         }
 
 #ifdef CONFIG_FAT_DIRECT_RETRY /* Warning avoidance */
@@ -1062,14 +1135,18 @@ fat_write_restart:
            *
            * Limit the number of sectors that we write on this time
            * through the loop to the remaining contiguous sectors
-           * in this cluster
+           * in this cluster and the clusters already allocated after it
+           * on the media.
            */
 
-          if (nsectors > ff->ff_sectorsincluster)
+          ret = fat_contiguous_sectors(fs, ff, nsectors, &nclusters);
+          if (ret < 0)
             {
-              nsectors = ff->ff_sectorsincluster;
+              goto errout;
             }
 
+          nsectors = ret;
+
           /* We are not sure of the state of the sector cache so the
            * safest thing to do is write back any dirty, cached sector
            * and invalidate the current cache content.
@@ -1100,13 +1177,12 @@ fat_write_restart:
                 }
 #endif /* CONFIG_FAT_DIRECT_RETRY */
 
-              goto errout_with_lock;
+              goto errout;
             }
 
-          ff->ff_sectorsincluster -= nsectors;
-          ff->ff_currentsector    += nsectors;
-          writesize                = nsectors * fs->fs_hwsectorsize;
-          ff->ff_bflags           |= FFBUFF_MODIFIED;
+          fat_advance_sectors(fs, ff, nsectors, nclusters);
+          writesize      = nsectors * fs->fs_hwsectorsize;
+          ff->ff_bflags |= FFBUFF_MODIFIED;
         }
       else
 #endif /* CONFIG_FAT_FORCE_INDIRECT */
@@ -1134,7 +1210,7 @@ fat_write_restart:
               ret = fat_ffcacheflush(fs, ff);
               if (ret < 0)
                 {
-                  goto errout_with_lock;
+                  goto errout;
                 }
 
               /* Now mark the clean cache buffer as the current sector. */
@@ -1150,7 +1226,7 @@ fat_write_restart:
               ret = fat_ffcacheread(fs, ff, ff->ff_currentsector);
               if (ret < 0)
                 {
-                  goto errout_with_lock;
+                  goto errout;
                 }
             }
 
@@ -1200,14 +1276,178 @@ fat_write_restart:
         }
     }
 
-  nxmutex_unlock(&fs->fs_lock);
   return byteswritten;
 
-errout_with_lock:
-  nxmutex_unlock(&fs->fs_lock);
+errout:
+  return ret;
+}
+
+/****************************************************************************
+ * Name: fat_lock
+ *
+ * Description:
+ *   Lock the file system of an open file and check its health.
+ *
+ ****************************************************************************/
+
+static int fat_lock(FAR struct file *filep)
+{
+  FAR struct fat_file_s *ff;
+  FAR struct fat_mountpt_s *fs;
+  int ret;
+
+  DEBUGASSERT(filep->f_priv != NULL);
+
+  /* Recover our private data from the struct file instance */
+
+  ff = filep->f_priv;
+
+  /* Check for the forced mount condition */
+
+  if ((ff->ff_bflags & UMOUNT_FORCED) != 0)
+    {
+      return -EPIPE;
+    }
+
+  fs = filep->f_inode->i_private;
+  DEBUGASSERT(fs != NULL);
+
+  /* Make sure that the mount is still healthy */
+
+  ret = nxmutex_lock(&fs->fs_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = fat_checkmount(fs);
+  if (ret != OK)
+    {
+      nxmutex_unlock(&fs->fs_lock);
+    }
+
   return ret;
 }
 
+/****************************************************************************
+ * Name: fat_readv
+ *
+ * Description:
+ *   Read into several buffers with a single lock of the file system, so
+ *   that the contiguous clusters of the buffers are transferred directly.
+ *
+ ****************************************************************************/
+
+static ssize_t fat_readv(FAR struct file *filep,
+                         FAR const struct iovec *iov, int iovcnt)
+{
+  FAR struct fat_mountpt_s *fs;
+  ssize_t nread = 0;
+  ssize_t ret;
+  int i;
+
+  ret = fat_lock(filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  fs = filep->f_inode->i_private;
+  for (i = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len == 0)
+        {
+          continue;
+        }
+
+      ret = fat_read_locked(filep, iov[i].iov_base, iov[i].iov_len);
+      if (ret <= 0)
+        {
+          break;
+        }
+
+      nread += ret;
+      if ((size_t)ret < iov[i].iov_len)
+        {
+          break;
+        }
+    }
+
+  nxmutex_unlock(&fs->fs_lock);
+  return nread > 0 ? nread : ret;
+}
+
+/****************************************************************************
+ * Name: fat_writev
+ ****************************************************************************/
+
+static ssize_t fat_writev(FAR struct file *filep,
+                          FAR const struct iovec *iov, int iovcnt)
+{
+  FAR struct fat_mountpt_s *fs;
+  ssize_t nwritten = 0;
+  ssize_t ret;
+  int i;
+
+  ret = fat_lock(filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  fs = filep->f_inode->i_private;
+  for (i = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len == 0)
+        {
+          continue;
+        }
+
+      ret = fat_write_locked(filep, iov[i].iov_base, iov[i].iov_len);
+      if (ret <= 0)
+        {
+          break;
+        }
+
+      nwritten += ret;
+      if ((size_t)ret < iov[i].iov_len)
+        {
+          break;
+        }
+    }
+
+  nxmutex_unlock(&fs->fs_lock);
+  return nwritten > 0 ? nwritten : ret;
+}
+
+/****************************************************************************
+ * Name: fat_read
+ ****************************************************************************/
+
+static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
+                        size_t buflen)
+{
+  struct iovec iov;
+
+  iov.iov_base = buffer;
+  iov.iov_len  = buflen;
+  return fat_readv(filep, &iov, 1);
+}
+
+/****************************************************************************
+ * Name: fat_write
+ ****************************************************************************/
+
+static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
+                         size_t buflen)
+{
+  struct iovec iov;
+
+  iov.iov_base = (FAR void *)buffer;
+  iov.iov_len  = buflen;
+  return fat_writev(filep, &iov, 1);
+}
+
 /****************************************************************************
  * Name: fat_seek
  ****************************************************************************/
@@ -1594,6 +1834,9 @@ static int fat_dup(FAR const struct file *oldp, FAR struct file *newp)
   newff->ff_startcluster     = oldff->ff_startcluster;     /* Start cluster of file on media */
   newff->ff_currentsector    = oldff->ff_currentsector;    /* Current sector */
   newff->ff_cachesector      = 0;                          /* Sector in file buffer */
+#if CONFIG_FAT_NEXTENTS > 0
+  newff->ff_nextents         = 0;                          /* No cached cluster runs */
+#endif
 
   /* Attach the private date to the struct file instance */
 
@@ -2321,6 +2564,12 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
         }
     }
 
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  /* Write back the cached FAT sectors */
+
+  fat_fatcacheflush(fs);
+#endif
+
   /* Unmount ... close the block driver */
 
   if (fs->fs_blkdriver)
@@ -2353,6 +2602,21 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
       fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
     }
 
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  if (fs->fs_fatbuffer)
+    {
+      fat_io_free(fs->fs_fatbuffer,
+                  CONFIG_FAT_FATCACHE_NSECTORS * fs->fs_hwsectorsize);
+    }
+#endif
+
+#ifdef CONFIG_FAT_FREEMAP
+  if (fs->fs_freemap)
+    {
+      fs_heap_free(fs->fs_freemap);
+    }
+#endif
+
   nxmutex_destroy(&fs->fs_lock);
   fs_heap_free(fs);
   return OK;
@@ -889,7 +889,30 @@ struct fat_mountpt_s
   uint8_t  fs_fatsecperclus;       /* MBR: Sectors per allocation unit: 2**n, n=0..7 */
   uint8_t *fs_buffer;              /* This is an allocated buffer to hold one
                                     * sector from the device */
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  /* The FAT sectors held in fs_fatbuffer, and the time of their last use */
+
+  off_t    fs_fatsectors[CONFIG_FAT_FATCACHE_NSECTORS];
+  uint32_t fs_fatage[CONFIG_FAT_FATCACHE_NSECTORS];
+  uint32_t fs_fatclock;            /* Incremented on each FAT sector access */
+  uint32_t fs_fatdirty;            /* One bit per dirty FAT sector */
+  uint8_t *fs_fatbuffer;           /* Holds the cached FAT sectors */
+#endif
+#ifdef CONFIG_FAT_FREEMAP
+  uint32_t *fs_freemap;            /* One bit per cluster, set if in use */
+#endif
+};
+
+#if CONFIG_FAT_NEXTENTS > 0
+/* This structure describes a run of contiguous clusters of a file */
+
+struct fat_extent_s
+{
+  uint32_t fe_index;               /* Index of the first cluster in the file */
+  uint32_t fe_cluster;             /* The first cluster of the run */
+  uint32_t fe_count;               /* The number of clusters in the run */
 };
+#endif
 
 /* This structure represents on open file under the mountpoint.  An instance
  * of this structure is retained as struct file specific information on each
@@ -911,6 +934,13 @@ struct fat_file_s
   off_t    ff_cachesector;         /* Current sector in the file buffer */
   off_t    ff_pos;                 /* Current position in the file */
   uint8_t *ff_buffer;              /* File buffer (for partial sector accesses) */
+#if CONFIG_FAT_NEXTENTS > 0
+  uint8_t  ff_nextents;            /* The number of cached runs */
+
+  /* The first runs of contiguous clusters of the file */
+
+  struct fat_extent_s ff_extents[CONFIG_FAT_NEXTENTS];
+#endif
 };
 
 /* This structure holds the sequence of directory entries used by one
@@ -1053,6 +1083,14 @@ EXTERN int32_t fat_extendchain(FAR struct fat_mountpt_s *fs,
 
 #define fat_createchain(fs) fat_extendchain(fs, 0)
 
+#if CONFIG_FAT_NEXTENTS > 0
+EXTERN int32_t fat_ffcluster(FAR struct fat_mountpt_s *fs,
+                             FAR struct fat_file_s *ff, uint32_t index,
+                             uint32_t hintindex, uint32_t hintcluster);
+EXTERN void   fat_ffextentsinvalidate(FAR struct fat_mountpt_s *fs,
+                                      uint32_t startcluster);
+#endif
+
 /* Help for traversing directory trees and accessing directory entries */
 
 EXTERN int    fat_nextdirentry(FAR struct fat_mountpt_s *fs,
@@ -1098,6 +1136,14 @@ EXTERN int    fat_ffcacheread(FAR struct fat_mountpt_s *fs,
 EXTERN int    fat_ffcacheinvalidate(FAR struct fat_mountpt_s *fs,
                                     FAR struct fat_file_s *ff);
 
+/* FAT sector cache */
+
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+EXTERN int    fat_fatcacheflush(FAR struct fat_mountpt_s *fs);
+#else
+#  define fat_fatcacheflush(fs) OK
+#endif
+
 /* FSINFO sector support */
 
 EXTERN int    fat_updatefsinfo(FAR struct fat_mountpt_s *fs);
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/param.h>
 #include <inttypes.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -41,6 +42,7 @@
 
 #include "inode/inode.h"
 #include "fs_fat32.h"
+#include "fs_heap.h"
 
 /****************************************************************************
  * Private Functions
@@ -263,6 +265,231 @@ static int fat_checkbootrecord(struct fat_mountpt_s *fs)
   return OK;
 }
 
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+/****************************************************************************
+ * Name: fat_fatcachewrite
+ *
+ * Description:
+ *   Write a dirty sector of the FAT cache to all the copies of the FAT.
+ *
+ ****************************************************************************/
+
+static int fat_fatcachewrite(FAR struct fat_mountpt_s *fs, int index)
+{
+  FAR uint8_t *buffer = fs->fs_fatbuffer + index * fs->fs_hwsectorsize;
+  off_t sector = fs->fs_fatsectors[index];
+  int ret;
+  int i;
+
+  for (i = 0; i < fs->fs_fatnumfats; i++)
+    {
+      ret = fat_hwwrite(fs, buffer, sector, 1);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      sector += fs->fs_nfatsects;
+    }
+
+  fs->fs_fatdirty &= ~(1u << index);
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: fat_fatsector
+ *
+ * Description:
+ *   Return the buffer that holds a sector of the FAT, reading the sector
+ *   if necessary.  The sector will be written back if 'dirty' is true.
+ *   This is fs_buffer unless the FAT sectors have a cache of their own.
+ *
+ * Returned Value:
+ *   The buffer that holds the sector, NULL on a read error.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *fat_fatsector(FAR struct fat_mountpt_s *fs,
+                                  off_t sector, bool dirty)
+{
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  int victim = 0;
+  int i;
+
+  if (fs->fs_fatbuffer != NULL)
+    {
+      for (i = 0; i < CONFIG_FAT_FATCACHE_NSECTORS; i++)
+        {
+          if (fs->fs_fatsectors[i] == sector)
+            {
+              victim = i;
+              goto out;
+            }
+
+          if (fs->fs_fatage[i] < fs->fs_fatage[victim])
+            {
+              victim = i;
+            }
+        }
+
+      /* Replace the least recently used sector */
+
+      if ((fs->fs_fatdirty & (1u << victim)) != 0 &&
+          fat_fatcachewrite(fs, victim) < 0)
+        {
+          return NULL;
+        }
+
+      fs->fs_fatsectors[victim] = -1;
+      if (fat_hwread(fs, fs->fs_fatbuffer + victim * fs->fs_hwsectorsize,
+                     sector, 1) < 0)
+        {
+          return NULL;
+        }
+
+      fs->fs_fatsectors[victim] = sector;
+
+out:
+      fs->fs_fatage[victim] = ++fs->fs_fatclock;
+      if (dirty)
+        {
+          fs->fs_fatdirty |= 1u << victim;
+        }
+
+      return fs->fs_fatbuffer + victim * fs->fs_hwsectorsize;
+    }
+#endif
+
+  if (fat_fscacheread(fs, sector) < 0)
+    {
+      return NULL;
+    }
+
+  if (dirty)
+    {
+      fs->fs_dirty = true;
+    }
+
+  return fs->fs_buffer;
+}
+
+#ifdef CONFIG_FAT_FREEMAP
+/****************************************************************************
+ * Name: fat_buildfreemap
+ *
+ * Description:
+ *   Build the bitmap of the clusters in use from the FAT, and count the
+ *   free clusters on the way.
+ *
+ ****************************************************************************/
+
+static int fat_buildfreemap(FAR struct fat_mountpt_s *fs)
+{
+  uint32_t nwords = (fs->fs_nclusters + 2 + 31) / 32;
+  uint32_t nfreeclusters = 0;
+  uint32_t cluster;
+  off_t next;
+
+  fs->fs_freemap = fs_heap_malloc(nwords * sizeof(uint32_t));
+  if (fs->fs_freemap == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* The reserved clusters 0 and 1, and those beyond the end of the volume,
+   * are never free.
+   */
+
+  memset(fs->fs_freemap, 0xff, nwords * sizeof(uint32_t));
+
+  for (cluster = 2; cluster < fs->fs_nclusters + 2; cluster++)
+    {
+      next = fat_getcluster(fs, cluster);
+      if (next < 0)
+        {
+          fs_heap_free(fs->fs_freemap);
+          fs->fs_freemap = NULL;
+          return next;
+        }
+      else if (next == 0)
+        {
+          fs->fs_freemap[cluster / 32] &= ~(1u << (cluster & 31));
+          nfreeclusters++;
+        }
+    }
+
+  fs->fs_fsifreecount = nfreeclusters;
+  if (fs->fs_type == FSTYPE_FAT32)
+    {
+      fs->fs_fsidirty = true;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_scanfreemap
+ *
+ * Description:
+ *   Search the bitmap for the first free cluster in [cluster, end).
+ *
+ ****************************************************************************/
+
+static uint32_t fat_scanfreemap(FAR struct fat_mountpt_s *fs,
+                                uint32_t cluster, uint32_t end)
+{
+  while (cluster < end)
+    {
+      uint32_t word = fs->fs_freemap[cluster / 32];
+
+      if (word == UINT32_MAX)
+        {
+          /* Skip 32 clusters in use at a time */
+
+          cluster = (cluster | 31) + 1;
+        }
+      else if ((word & (1u << (cluster & 31))) == 0)
+        {
+          return cluster;
+        }
+      else
+        {
+          cluster++;
+        }
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: fat_findfreecluster
+ *
+ * Description:
+ *   Search the bitmap for the first free cluster after 'startcluster',
+ *   wrapping back to the beginning of the volume.
+ *
+ * Returned Value:
+ *   The free cluster, or zero if there is none.
+ *
+ ****************************************************************************/
+
+static uint32_t fat_findfreecluster(FAR struct fat_mountpt_s *fs,
+                                    uint32_t startcluster)
+{
+  uint32_t end = fs->fs_nclusters + 2;
+  uint32_t cluster;
+
+  cluster = fat_scanfreemap(fs, startcluster + 1, end);
+  if (cluster == 0)
+    {
+      cluster = fat_scanfreemap(fs, 2, MIN(startcluster + 1, end));
+    }
+
+  return cluster;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -473,6 +700,9 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
 {
   FAR struct inode *inode;
   struct geometry geo;
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  int slot;
+#endif
   int ret;
 
   /* Assume that the mount is successful */
@@ -513,6 +743,23 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
       goto errout;
     }
 
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  /* Allocate the FAT sector cache.  The FAT sectors simply share fs_buffer
+   * with the other sectors if there is not enough memory.
+   */
+
+  fs->fs_fatbuffer = (FAR uint8_t *)
+    fat_io_alloc(CONFIG_FAT_FATCACHE_NSECTORS * fs->fs_hwsectorsize);
+  for (slot = 0; slot < CONFIG_FAT_FATCACHE_NSECTORS; slot++)
+    {
+      fs->fs_fatsectors[slot] = -1;
+      fs->fs_fatage[slot]     = 0;
+    }
+
+  fs->fs_fatclock = 0;
+  fs->fs_fatdirty = 0;
+#endif
+
   /* Search FAT boot record on the drive.  First check the MBR at sector
    * zero.  This could be either the boot record or a partition that refers
    * to the boot record.
@@ -651,6 +898,23 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
   return OK;
 
 errout_with_buffer:
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  if (fs->fs_fatbuffer != NULL)
+    {
+      fat_io_free(fs->fs_fatbuffer,
+                  CONFIG_FAT_FATCACHE_NSECTORS * fs->fs_hwsectorsize);
+      fs->fs_fatbuffer = NULL;
+    }
+#endif
+
+#ifdef CONFIG_FAT_FREEMAP
+  if (fs->fs_freemap != NULL)
+    {
+      fs_heap_free(fs->fs_freemap);
+      fs->fs_freemap = NULL;
+    }
+#endif
+
   fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
   fs->fs_buffer = NULL;
 
@@ -803,6 +1067,8 @@ off_t fat_cluster2sector(FAR struct fat_mountpt_s *fs,  uint32_t cluster)
 
 off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
 {
+  FAR uint8_t *buffer;
+
   /* Verify that the cluster number is within range */
 
   if (clusterno >= 2 && clusterno < fs->fs_nclusters + 2)
@@ -829,7 +1095,8 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
 
               /* Read the sector at this offset */
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              buffer = fat_fatsector(fs, fatsector, false);
+              if (buffer == NULL)
                 {
                   /* Read error */
 
@@ -839,7 +1106,7 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
               /* Get the first, LS byte of the cluster from the FAT */
 
               fatindex = fatoffset & SEC_NDXMASK(fs);
-              cluster  = fs->fs_buffer[fatindex];
+              cluster  = buffer[fatindex];
 
               /* With FAT12, the second byte of the cluster number may lie in
                * a different sector than the first byte.
@@ -851,7 +1118,8 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
                   fatsector++;
                   fatindex = 0;
 
-                  if (fat_fscacheread(fs, fatsector) < 0)
+                  buffer = fat_fatsector(fs, fatsector, false);
+                  if (buffer == NULL)
                     {
                       /* Read error */
 
@@ -864,7 +1132,7 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
                * on the fact that the byte stream is little-endian.
                */
 
-              cluster |= (unsigned int)fs->fs_buffer[fatindex] << 8;
+              cluster |= (unsigned int)buffer[fatindex] << 8;
 
               /* Now, pick out the correct 12 bit cluster start sector
                * value.
@@ -895,14 +1163,15 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
                                        SEC_NSECTORS(fs, fatoffset);
               unsigned int fatindex  = fatoffset & SEC_NDXMASK(fs);
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              buffer = fat_fatsector(fs, fatsector, false);
+              if (buffer == NULL)
                 {
                   /* Read error */
 
                   break;
                 }
 
-              return FAT_GETFAT16(fs->fs_buffer, fatindex);
+              return FAT_GETFAT16(buffer, fatindex);
             }
 
           case FSTYPE_FAT32 :
@@ -914,14 +1183,15 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
                                        SEC_NSECTORS(fs, fatoffset);
               unsigned int fatindex  = fatoffset & SEC_NDXMASK(fs);
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              buffer = fat_fatsector(fs, fatsector, false);
+              if (buffer == NULL)
                 {
                   /* Read error */
 
                   break;
                 }
 
-              return FAT_GETFAT32(fs->fs_buffer, fatindex) & 0x0fffffff;
+              return FAT_GETFAT32(buffer, fatindex) & 0x0fffffff;
             }
 
           default:
@@ -945,6 +1215,8 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
 int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                    off_t nextcluster)
 {
+  FAR uint8_t *buffer;
+
   /* Verify that the cluster number is within range.  Zero erases the
    * cluster.
    */
@@ -973,11 +1245,12 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
 
               /* Make sure that the sector at this offset is in the cache */
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              buffer = fat_fatsector(fs, fatsector, true);
+              if (buffer == NULL)
                 {
                   /* Read error */
 
-                  break;
+                  return -EIO;
                 }
 
               /* Get the LS byte first handling the 12-bit alignment within
@@ -989,7 +1262,7 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                 {
                   /* Save the LS four bits of the next cluster */
 
-                  value = (fs->fs_buffer[fatindex] & 0x0f) |
+                  value = (buffer[fatindex] & 0x0f) |
                            (uint8_t)nextcluster << 4;
                 }
               else
@@ -999,7 +1272,7 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                   value = (uint8_t)nextcluster;
                 }
 
-              fs->fs_buffer[fatindex] = value;
+              buffer[fatindex] = value;
 
               /* With FAT12, the second byte of the cluster number may lie in
                * a different sector than the first byte.
@@ -1013,16 +1286,12 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                   fatsector++;
                   fatindex = 0;
 
-                  /* Set the dirty flag to make sure the sector that we
-                   * just modified is written out.
-                   */
-
-                  fs->fs_dirty = true;
-                  if (fat_fscacheread(fs, fatsector) < 0)
+                  buffer = fat_fatsector(fs, fatsector, true);
+                  if (buffer == NULL)
                     {
                       /* Read error */
 
-                      break;
+                      return -EIO;
                     }
                 }
 
@@ -1040,11 +1309,11 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                 {
                   /* Save the MS four bits of the next cluster */
 
-                  value = (fs->fs_buffer[fatindex] & 0xf0) |
+                  value = (buffer[fatindex] & 0xf0) |
                           ((nextcluster >> 8) & 0x0f);
                 }
 
-              fs->fs_buffer[fatindex] = value;
+              buffer[fatindex] = value;
             }
           break;
 
@@ -1055,14 +1324,15 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                                        SEC_NSECTORS(fs, fatoffset);
               unsigned int fatindex  = fatoffset & SEC_NDXMASK(fs);
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              buffer = fat_fatsector(fs, fatsector, true);
+              if (buffer == NULL)
                 {
                   /* Read error */
 
-                  break;
+                  return -EIO;
                 }
 
-              FAT_PUTFAT16(fs->fs_buffer, fatindex, nextcluster & 0xffff);
+              FAT_PUTFAT16(buffer, fatindex, nextcluster & 0xffff);
             }
           break;
 
@@ -1074,17 +1344,18 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
               unsigned int fatindex  = fatoffset & SEC_NDXMASK(fs);
               uint32_t     val;
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              buffer = fat_fatsector(fs, fatsector, true);
+              if (buffer == NULL)
                 {
                   /* Read error */
 
-                  break;
+                  return -EIO;
                 }
 
               /* Keep the top 4 bits */
 
-              val = FAT_GETFAT32(fs->fs_buffer, fatindex) & 0xf0000000;
-              FAT_PUTFAT32(fs->fs_buffer, fatindex,
+              val = FAT_GETFAT32(buffer, fatindex) & 0xf0000000;
+              FAT_PUTFAT32(buffer, fatindex,
                            val | (nextcluster & 0x0fffffff));
             }
           break;
@@ -1093,9 +1364,24 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
             return -EINVAL;
         }
 
-      /* Mark the modified sector as "dirty" and return success */
+#ifdef CONFIG_FAT_FREEMAP
+      /* Keep the bitmap of the clusters in use up to date */
+
+      if (fs->fs_freemap != NULL && clusterno >= 2)
+        {
+          if (nextcluster != 0)
+            {
+              fs->fs_freemap[clusterno / 32] |= 1u << (clusterno & 31);
+            }
+          else
+            {
+              fs->fs_freemap[clusterno / 32] &= ~(1u << (clusterno & 31));
+            }
+        }
+#endif
+
+      /* The modified sector was marked "dirty" when read */
 
-      fs->fs_dirty = true;
       return OK;
     }
 
@@ -1219,6 +1505,24 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
       startcluster = cluster;
     }
 
+#ifdef CONFIG_FAT_FREEMAP
+  /* Search the bitmap of the clusters in use instead of the FAT */
+
+  if (fs->fs_freemap == NULL)
+    {
+      ret = fat_buildfreemap(fs);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  newcluster = fat_findfreecluster(fs, startcluster);
+  if (newcluster == 0)
+    {
+      return 0;
+    }
+#else
   /* Loop until (1) we discover that there are not free clusters
    * (return 0), an errors occurs (return -errno), or (3) we find
    * the next cluster (return the new cluster number).
@@ -1276,6 +1580,7 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
           return 0;
         }
     }
+#endif
 
   /* We get here only if we break out with an available cluster
    * number in 'newcluster'  Now mark that cluster as in-use.
@@ -1316,6 +1621,132 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
   return newcluster;
 }
 
+#if CONFIG_FAT_NEXTENTS > 0
+/****************************************************************************
+ * Name: fat_ffcluster
+ *
+ * Description:
+ *   Return the cluster at position 'index' in the chain of a file.  The
+ *   first runs of contiguous clusters of the file are cached, so that the
+ *   FAT is only walked beyond them.  'hintcluster' is the cluster at
+ *   position 'hintindex', where the walk may start if it is past the runs.
+ *
+ * Returned Value:
+ *   The cluster number, or a negated errno value if the chain is broken.
+ *
+ ****************************************************************************/
+
+int32_t fat_ffcluster(FAR struct fat_mountpt_s *fs,
+                      FAR struct fat_file_s *ff, uint32_t index,
+                      uint32_t hintindex, uint32_t hintcluster)
+{
+  FAR struct fat_extent_s *fe;
+  uint32_t position;
+  uint32_t cluster;
+  off_t next;
+  bool record = true;
+  int i;
+
+  /* The first run starts with the first cluster of the file */
+
+  if (ff->ff_nextents == 0)
+    {
+      ff->ff_extents[0].fe_index   = 0;
+      ff->ff_extents[0].fe_cluster = ff->ff_startcluster;
+      ff->ff_extents[0].fe_count   = 1;
+      ff->ff_nextents              = 1;
+    }
+
+  for (i = 0; i < ff->ff_nextents; i++)
+    {
+      fe = &ff->ff_extents[i];
+      if (index >= fe->fe_index && index - fe->fe_index < fe->fe_count)
+        {
+          return fe->fe_cluster + (index - fe->fe_index);
+        }
+    }
+
+  /* Walk the FAT from the end of the last run, or from the hint if it is
+   * nearer.  The runs are only recorded while they stay contiguous with
+   * the cached prefix of the chain.
+   */
+
+  fe       = &ff->ff_extents[ff->ff_nextents - 1];
+  position = fe->fe_index + fe->fe_count - 1;
+  cluster  = fe->fe_cluster + fe->fe_count - 1;
+
+  if (hintindex > position && hintindex <= index)
+    {
+      position = hintindex;
+      cluster  = hintcluster;
+      record   = false;
+    }
+
+  while (position < index)
+    {
+      next = fat_getcluster(fs, cluster);
+      if (next < 0)
+        {
+          return next;
+        }
+
+      /* The chain is broken */
+
+      if (next < 2 || next >= fs->fs_nclusters + 2)
+        {
+          return -EIO;
+        }
+
+      position++;
+      if (record)
+        {
+          if (next == cluster + 1)
+            {
+              fe->fe_count++;
+            }
+          else if (ff->ff_nextents < CONFIG_FAT_NEXTENTS)
+            {
+              fe = &ff->ff_extents[ff->ff_nextents++];
+              fe->fe_index   = position;
+              fe->fe_cluster = next;
+              fe->fe_count   = 1;
+            }
+          else
+            {
+              record = false;
+            }
+        }
+
+      cluster = next;
+    }
+
+  return cluster;
+}
+
+/****************************************************************************
+ * Name: fat_ffextentsinvalidate
+ *
+ * Description:
+ *   Forget the cached runs of clusters of the open files whose chain starts
+ *   with 'startcluster', once the chain has been shortened or removed.
+ *
+ ****************************************************************************/
+
+void fat_ffextentsinvalidate(FAR struct fat_mountpt_s *fs,
+                             uint32_t startcluster)
+{
+  FAR struct fat_file_s *ff;
+
+  for (ff = fs->fs_head; ff != NULL; ff = ff->ff_next)
+    {
+      if (ff->ff_startcluster == startcluster)
+        {
+          ff->ff_nextents = 0;
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: fat_nextdirentry
  *
@@ -1461,6 +1892,9 @@ int fat_dirtruncate(struct fat_mountpt_s *fs, FAR uint8_t *direntry)
 
   /* Now remove the entire cluster chain comprising the file */
 
+#if CONFIG_FAT_NEXTENTS > 0
+  fat_ffextentsinvalidate(fs, startcluster);
+#endif
   savesector = fs->fs_currentsector;
   ret = fat_removechain(fs, startcluster);
   if (ret < 0)
@@ -1520,6 +1954,10 @@ int fat_dirshrink(struct fat_mountpt_s *fs, FAR uint8_t *direntry,
 
   fs->fs_dirty = true;
 
+#if CONFIG_FAT_NEXTENTS > 0
+  fat_ffextentsinvalidate(fs, lastcluster);
+#endif
+
   /* Now find the cluster change to be removed.  Start with the cluster
    * after the current one (which we know contains data).
    */
@@ -1968,6 +2406,36 @@ int fat_ffcacheinvalidate(struct fat_mountpt_s *fs, struct fat_file_s *ff)
   return OK;
 }
 
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+/****************************************************************************
+ * Name: fat_fatcacheflush
+ *
+ * Description:
+ *   Write back the dirty sectors of the FAT sector cache.
+ *
+ ****************************************************************************/
+
+int fat_fatcacheflush(FAR struct fat_mountpt_s *fs)
+{
+  int ret;
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_FATCACHE_NSECTORS; i++)
+    {
+      if ((fs->fs_fatdirty & (1u << i)) != 0)
+        {
+          ret = fat_fatcachewrite(fs, i);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: fat_updatefsinfo
  *
@@ -1981,9 +2449,14 @@ int fat_updatefsinfo(struct fat_mountpt_s *fs)
 {
   int ret;
 
-  /* Flush the fs_buffer if it is dirty */
+  /* Flush the FAT sector cache and the fs_buffer if they are dirty */
+
+  ret = fat_fatcacheflush(fs);
+  if (ret == OK)
+    {
+      ret = fat_fscacheflush(fs);
+    }
 
-  ret = fat_fscacheflush(fs);
   if (ret == OK)
     {
       /* The FSINFO sector only has to be update for the case of a FAT32 file
@@ -2031,6 +2504,16 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
   /* We have to count the number of free clusters */
 
   uint32_t nfreeclusters = 0;
+
+#ifdef CONFIG_FAT_FREEMAP
+  /* Building the bitmap of the clusters in use counts them too */
+
+  if (fs->fs_freemap == NULL)
+    {
+      return fat_buildfreemap(fs);
+    }
+#endif
+
   if (fs->fs_type == FSTYPE_FAT12)
     {
       off_t sector;
@@ -2051,10 +2534,10 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
     }
   else
     {
+      FAR uint8_t  *buffer = NULL;
       unsigned int cluster;
       off_t        fatsector;
       unsigned int offset;
-      int          ret;
 
       fatsector    = fs->fs_fatbase;
       offset       = fs->fs_hwsectorsize;
@@ -2063,16 +2546,14 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
 
       for (cluster = fs->fs_nclusters; cluster > 0; cluster--)
         {
-          /* If we are starting a new sector, then read the new sector in
-           * fs_buffer
-           */
+          /* If we are starting a new sector, then read the new sector */
 
           if (offset >= fs->fs_hwsectorsize)
             {
-              ret = fat_fscacheread(fs, fatsector);
-              if (ret < 0)
+              buffer = fat_fatsector(fs, fatsector, false);
+              if (buffer == NULL)
                 {
-                  return ret;
+                  return -EIO;
                 }
 
               /* Reset the offset to the next FAT entry.
@@ -2089,7 +2570,7 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
 
           if (fs->fs_type == FSTYPE_FAT16)
             {
-              if (FAT_GETFAT16(fs->fs_buffer, offset) == 0)
+              if (FAT_GETFAT16(buffer, offset) == 0)
                 {
                   nfreeclusters++;
                 }
@@ -2098,7 +2579,7 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
             }
           else
             {
-              if (FAT_GETFAT32(fs->fs_buffer, offset) == 0)
+              if (FAT_GETFAT32(buffer, offset) == 0)
                 {
                   nfreeclusters++;
                 }
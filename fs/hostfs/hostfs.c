@@ -36,6 +36,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/lib/lib.h>
 #include <nuttx/mutex.h>
 #include <nuttx/fs/fs.h>
@@ -53,6 +54,13 @@
 
 #define HOSTFS_RETRY_DELAY_MS       10
 
+#if CONFIG_FS_HOSTFS_ATTRCACHE > 0
+#  define hostfs_stat_path(fs, path, buf) hostfs_attr_stat(fs, path, buf)
+#else
+#  define hostfs_stat_path(fs, path, buf) host_stat(path, buf)
+#  define hostfs_attr_drop(fs, relpath)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -67,6 +75,22 @@ struct hostfs_dir_s
  * Private Function Prototypes
  ****************************************************************************/
 
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+static ssize_t hostfs_readahead(FAR struct hostfs_ofile_s *hf,
+                                FAR char *buffer, size_t buflen);
+static int     hostfs_dropahead(FAR const struct file *filep,
+                                FAR struct hostfs_ofile_s *hf);
+#endif
+#if CONFIG_FS_HOSTFS_ATTRCACHE > 0
+static FAR struct hostfs_attr_s *
+               hostfs_attr_get(FAR struct hostfs_mountpt_s *fs,
+                               FAR const char *path);
+static int     hostfs_attr_stat(FAR struct hostfs_mountpt_s *fs,
+                                FAR const char *path, FAR struct stat *buf);
+static void    hostfs_attr_drop(FAR struct hostfs_mountpt_s *fs,
+                                FAR const char *relpath);
+#endif
+
 static int     hostfs_open(FAR struct file *filep, FAR const char *relpath,
                            int oflags, mode_t mode);
 static int     hostfs_close(FAR struct file *filep);
@@ -236,6 +260,206 @@ static void hostfs_mkpath(FAR struct hostfs_mountpt_s  *fs,
     }
 }
 
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+/****************************************************************************
+ * Name: hostfs_readahead
+ *
+ * Description:
+ *   Serve a small read from the data read ahead, refilled with a single
+ *   host call of CONFIG_FS_HOSTFS_READAHEAD bytes:  Each host call costs a
+ *   switch to the host (a semihosting trap, or a host system call of the
+ *   simulator), so a sequence of small reads costs one call per refill.
+ *   Only regular files are read ahead, the data of the others cannot be
+ *   given back.
+ *
+ ****************************************************************************/
+
+static ssize_t hostfs_readahead(FAR struct hostfs_ofile_s *hf,
+                                FAR char *buffer, size_t buflen)
+{
+  struct stat buf;
+  ssize_t ret;
+
+  if (hf->rapos >= hf->ralen)
+    {
+      if (hf->rabuf == NULL && !hf->ranone)
+        {
+          ret = host_fstat(hf->fd, &buf);
+          if (ret >= 0 && S_ISREG(buf.st_mode))
+            {
+              hf->rabuf = fs_heap_malloc(CONFIG_FS_HOSTFS_READAHEAD);
+            }
+
+          hf->ranone = hf->rabuf == NULL;
+        }
+
+      if (hf->rabuf == NULL)
+        {
+          return host_read(hf->fd, buffer, buflen);
+        }
+
+      ret = host_read(hf->fd, hf->rabuf, CONFIG_FS_HOSTFS_READAHEAD);
+      if (ret <= 0)
+        {
+          return ret;
+        }
+
+      hf->rapos = 0;
+      hf->ralen = ret;
+    }
+
+  if (buflen > hf->ralen - hf->rapos)
+    {
+      buflen = hf->ralen - hf->rapos;
+    }
+
+  memcpy(buffer, hf->rabuf + hf->rapos, buflen);
+  hf->rapos += buflen;
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: hostfs_dropahead
+ *
+ * Description:
+ *   Drop the data read ahead before any other operation on the file:  The
+ *   host file position is moved back to the local one, with an absolute
+ *   seek that all the host interfaces support.
+ *
+ ****************************************************************************/
+
+static int hostfs_dropahead(FAR const struct file *filep,
+                            FAR struct hostfs_ofile_s *hf)
+{
+  off_t ret = OK;
+
+  if (hf->rapos < hf->ralen)
+    {
+      ret = host_lseek(hf->fd, filep->f_pos, filep->f_pos, SEEK_SET);
+    }
+
+  hf->rapos = 0;
+  hf->ralen = 0;
+  return ret < 0 ? ret : OK;
+}
+#endif
+
+#if CONFIG_FS_HOSTFS_ATTRCACHE > 0
+/****************************************************************************
+ * Name: hostfs_attr_get
+ *
+ * Description:
+ *   Return the attribute cache entry of a host path:  The cache is direct
+ *   mapped by a FNV-1a hash of the path.
+ *
+ ****************************************************************************/
+
+static FAR struct hostfs_attr_s *
+hostfs_attr_get(FAR struct hostfs_mountpt_s *fs, FAR const char *path)
+{
+  uint32_t hash = 2166136261u;
+
+  while (*path != '\0')
+    {
+      hash = (hash ^ (uint8_t)*path++) * 16777619u;
+    }
+
+  return &fs->fs_attrs[hash % CONFIG_FS_HOSTFS_ATTRCACHE];
+}
+
+/****************************************************************************
+ * Name: hostfs_attr_stat
+ *
+ * Description:
+ *   Return the attributes of a host path from the cache, or from the host
+ *   if they are not cached or expired.  The missing paths are cached too,
+ *   the other errors are not.
+ *
+ ****************************************************************************/
+
+static int hostfs_attr_stat(FAR struct hostfs_mountpt_s *fs,
+                            FAR const char *path, FAR struct stat *buf)
+{
+  FAR struct hostfs_attr_s *attr = hostfs_attr_get(fs, path);
+  clock_t now = clock_systime_ticks();
+  int ret;
+
+  if (attr->path != NULL && strcmp(attr->path, path) == 0 &&
+      !clock_compare(attr->expiry, now))
+    {
+      if (attr->result >= 0)
+        {
+          memcpy(buf, &attr->buf, sizeof(*buf));
+        }
+
+      return attr->result;
+    }
+
+  ret = host_stat(path, buf);
+  if (ret < 0 && ret != -ENOENT && ret != -ENOTDIR)
+    {
+      return ret;
+    }
+
+  if (attr->path == NULL || strcmp(attr->path, path) != 0)
+    {
+      fs_heap_free(attr->path);
+      attr->path = fs_heap_strdup(path);
+      if (attr->path == NULL)
+        {
+          return ret;
+        }
+    }
+
+  attr->expiry = now + MSEC2TICK(CONFIG_FS_HOSTFS_ATTRCACHE_TTL);
+  attr->result = ret;
+  if (ret >= 0)
+    {
+      memcpy(&attr->buf, buf, sizeof(*buf));
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: hostfs_attr_drop
+ *
+ * Description:
+ *   Drop the cached attributes of a path changed by the file system, or
+ *   of all the paths of the volume if 'relpath' is NULL:  Creating,
+ *   removing or renaming an entry may change the result of the lookups of
+ *   any path below it.
+ *
+ ****************************************************************************/
+
+static void hostfs_attr_drop(FAR struct hostfs_mountpt_s *fs,
+                             FAR const char *relpath)
+{
+  FAR struct hostfs_attr_s *attr;
+  char path[HOSTFS_MAX_PATH];
+  int i;
+
+  if (relpath == NULL)
+    {
+      for (i = 0; i < CONFIG_FS_HOSTFS_ATTRCACHE; i++)
+        {
+          fs_heap_free(fs->fs_attrs[i].path);
+          fs->fs_attrs[i].path = NULL;
+        }
+
+      return;
+    }
+
+  hostfs_mkpath(fs, relpath, path, sizeof(path));
+  attr = hostfs_attr_get(fs, path);
+  if (attr->path != NULL && strcmp(attr->path, path) == 0)
+    {
+      fs_heap_free(attr->path);
+      attr->path = NULL;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: hostfs_open
  ****************************************************************************/
@@ -296,6 +520,17 @@ static int hostfs_open(FAR struct file *filep, FAR const char *relpath,
       goto errout_with_buffer;
     }
 
+  /* The file may have been created or truncated */
+
+  if ((oflags & O_CREAT) != 0)
+    {
+      hostfs_attr_drop(fs, NULL);
+    }
+  else if ((oflags & O_TRUNC) != 0)
+    {
+      hostfs_attr_drop(fs, relpath);
+    }
+
   /* In write/append mode, we need to set the file pointer to the end of the
    * file.
    */
@@ -326,6 +561,12 @@ static int hostfs_open(FAR struct file *filep, FAR const char *relpath,
   hf->fnext = fs->fs_head;
   hf->crefs = 1;
   hf->oflags = oflags;
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+  hf->rabuf  = NULL;
+  hf->rapos  = 0;
+  hf->ralen  = 0;
+  hf->ranone = false;
+#endif
   memcpy(hf->relpath, relpath, len + 1);
   fs->fs_head = hf;
 
@@ -427,6 +668,9 @@ static int hostfs_close(FAR struct file *filep)
   /* Now free the pointer */
 
   filep->f_priv = NULL;
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+  fs_heap_free(hf->rabuf);
+#endif
   fs_heap_free(hf);
 
 okout:
@@ -468,7 +712,17 @@ static ssize_t hostfs_read(FAR struct file *filep, FAR char *buffer,
 
   /* Call the host to perform the read */
 
-  ret = host_read(hf->fd, buffer, buflen);
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+  if (buflen < CONFIG_FS_HOSTFS_READAHEAD || hf->rapos < hf->ralen)
+    {
+      ret = hostfs_readahead(hf, buffer, buflen);
+    }
+  else
+#endif
+    {
+      ret = host_read(hf->fd, buffer, buflen);
+    }
+
   if (ret > 0)
     {
       filep->f_pos += ret;
@@ -520,6 +774,15 @@ static ssize_t hostfs_write(FAR struct file *filep, const char *buffer,
 
   /* Call the host to perform the write */
 
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+  ret = hostfs_dropahead(filep, hf);
+  if (ret < 0)
+    {
+      goto errout_with_lock;
+    }
+#endif
+
+  hostfs_attr_drop(fs, hf->relpath);
   ret = host_write(hf->fd, buffer, buflen);
   if (ret > 0)
     {
@@ -562,7 +825,20 @@ static off_t hostfs_seek(FAR struct file *filep, off_t offset, int whence)
       return ret;
     }
 
-  /* Call our internal routine to perform the seek */
+  /* Call our internal routine to perform the seek.  The host position is
+   * past the data read ahead, that is dropped.
+   */
+
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+  if (whence == SEEK_CUR && hf->rapos < hf->ralen)
+    {
+      offset += filep->f_pos;
+      whence  = SEEK_SET;
+    }
+
+  hf->rapos = 0;
+  hf->ralen = 0;
+#endif
 
   ret = host_lseek(hf->fd, filep->f_pos, offset, whence);
   if (ret >= 0)
@@ -607,6 +883,10 @@ static int hostfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
   /* Call our internal routine to perform the ioctl */
 
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+  hostfs_dropahead(filep, hf);
+#endif
+
   ret = host_ioctl(hf->fd, cmd, arg);
   if (ret < 0)
     {
@@ -667,6 +947,10 @@ static int hostfs_sync(FAR struct file *filep)
       return ret;
     }
 
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+  hostfs_dropahead(filep, hf);
+#endif
+
   host_sync(hf->fd);
 
   nxmutex_unlock(&g_lock);
@@ -789,6 +1073,11 @@ static int hostfs_fchstat(FAR const struct file *filep,
 
   /* Call the host to perform the change */
 
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+  hostfs_dropahead(filep, hf);
+#endif
+
+  hostfs_attr_drop(fs, hf->relpath);
   ret = host_fchstat(hf->fd, buf, flags);
 
   nxmutex_unlock(&g_lock);
@@ -830,6 +1119,11 @@ static int hostfs_ftruncate(FAR struct file *filep, off_t length)
 
   /* Call the host to perform the truncate */
 
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+  hostfs_dropahead(filep, hf);
+#endif
+
+  hostfs_attr_drop(fs, hf->relpath);
   ret = host_ftruncate(hf->fd, length);
 
   nxmutex_unlock(&g_lock);
@@ -1150,6 +1444,7 @@ static int hostfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
       return (flags != 0) ? -ENOSYS : -EBUSY;
     }
 
+  hostfs_attr_drop(fs, NULL);
   nxmutex_unlock(&g_lock);
   fs_heap_free(fs);
   return ret;
@@ -1224,6 +1519,7 @@ static int hostfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
   /* Call the host fs to perform the unlink */
 
   ret = host_unlink(path);
+  hostfs_attr_drop(fs, NULL);
 
   nxmutex_unlock(&g_lock);
   return ret;
@@ -1264,6 +1560,7 @@ static int hostfs_mkdir(FAR struct inode *mountpt, FAR const char *relpath,
   /* Call the host FS to do the mkdir */
 
   ret = host_mkdir(path, mode);
+  hostfs_attr_drop(fs, NULL);
 
   nxmutex_unlock(&g_lock);
   return ret;
@@ -1305,6 +1602,7 @@ int hostfs_rmdir(FAR struct inode *mountpt, FAR const char *relpath)
   /* Call the host FS to do the mkdir */
 
   ret = host_rmdir(path);
+  hostfs_attr_drop(fs, NULL);
 
   nxmutex_unlock(&g_lock);
   return ret;
@@ -1349,6 +1647,7 @@ int hostfs_rename(FAR struct inode *mountpt, FAR const char *oldrelpath,
   /* Call the host FS to do the mkdir */
 
   ret = host_rename(oldpath, newpath);
+  hostfs_attr_drop(fs, NULL);
 
   nxmutex_unlock(&g_lock);
   return ret;
@@ -1388,7 +1687,7 @@ static int hostfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
 
   /* Call the host FS to do the stat operation */
 
-  ret = host_stat(path, buf);
+  ret = hostfs_stat_path(fs, path, buf);
 
   nxmutex_unlock(&g_lock);
   return ret;
@@ -1428,6 +1727,7 @@ static int hostfs_chstat(FAR struct inode *mountpt, FAR const char *relpath,
 
   /* Call the host FS to do the chstat operation */
 
+  hostfs_attr_drop(fs, relpath);
   ret = host_chstat(path, buf, flags);
 
   nxmutex_unlock(&g_lock);
@@ -28,6 +28,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -51,9 +52,30 @@ struct hostfs_ofile_s
   int16_t                   crefs;   /* Reference count */
   mode_t                    oflags;  /* Open mode */
   int                       fd;
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+  FAR char                 *rabuf;   /* Data read ahead, NULL if none */
+  size_t                    rapos;   /* Offset of the next byte to read */
+  size_t                    ralen;   /* Bytes of data in rabuf */
+  bool                      ranone;  /* Not a regular file, no read-ahead */
+#endif
   char                      relpath[1];
 };
 
+/* The attributes of a path, as last returned by the host.  The negative
+ * results are cached too, so that the lookups of missing files do not go
+ * to the host either.
+ */
+
+#if CONFIG_FS_HOSTFS_ATTRCACHE > 0
+struct hostfs_attr_s
+{
+  FAR char                 *path;    /* The host path, NULL if unused */
+  clock_t                   expiry;  /* When to ask the host again */
+  int                       result;  /* The result of host_stat() */
+  struct stat               buf;     /* The attributes if result is OK */
+};
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of
  * this structure is retained as inode private data on each mountpoint that
  * is mounted with a hostfs filesystem.
@@ -63,6 +85,9 @@ struct hostfs_mountpt_s
 {
   FAR struct hostfs_ofile_s *fs_head;      /* A singly-linked list of open files */
   char                       fs_root[HOSTFS_MAX_PATH];
+#if CONFIG_FS_HOSTFS_ATTRCACHE > 0
+  struct hostfs_attr_s       fs_attrs[CONFIG_FS_HOSTFS_ATTRCACHE];
+#endif
 };
 
 /****************************************************************************
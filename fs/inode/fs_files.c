@@ -36,6 +36,7 @@
 
 #include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/lockstat.h>
 #include <nuttx/cancelpt.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/mutex.h>
@@ -56,12 +57,72 @@
 #include "inode/inode.h"
 #include "fs_heap.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define files_lock()    lockstat_spin_lock_irqsave(&g_files_lock, \
+                                                   &g_files_lockstat)
+#define files_unlock(f) spin_unlock_irqrestore(&g_files_lock, f)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* This spinlock serializes the changes of the rows of the file lists, the
+ * allocation of the descriptors and their reservation by dup2().  The
+ * lookups take no lock.
+ */
+
+static spinlock_t g_files_lock = SP_UNLOCKED;
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+static struct lockstat_s g_files_lockstat = LOCKSTAT_INITIALIZER("files");
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: files_tryref
+ *
+ * Description:
+ *   Take a reference to a file, unless its last one is already gone and
+ *   the file is being closed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_REFCOUNT
+static bool files_tryref(FAR struct file *filep)
+{
+  int refs = atomic_load(&filep->f_refs);
+
+  do
+    {
+      if (refs <= 0)
+        {
+          return false;
+        }
+    }
+  while (!atomic_compare_exchange_weak_explicit(&filep->f_refs, &refs,
+                                                refs + 1,
+                                                memory_order_acquire,
+                                                memory_order_relaxed));
+
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Name: files_fget_by_index
+ *
+ * Description:
+ *   Get the file of a descriptor.  The lookup takes no lock:  The rows of
+ *   a list and the row tables it replaced are only freed with the list,
+ *   and the reference is taken atomically.  If 'new' is not NULL, a free
+ *   descriptor is reserved for dup2(), with the lock of the file lists.
+ *
  ****************************************************************************/
 
 static FAR struct file *files_fget_by_index(FAR struct filelist *list,
@@ -70,9 +131,38 @@ static FAR struct file *files_fget_by_index(FAR struct filelist *list,
   FAR struct file *filep;
   irqstate_t flags;
 
-  flags = spin_lock_irqsave(NULL);
+  /* Read the table after the number of rows checked by the caller */
 
+  SP_DMB();
   filep = &list->fl_files[l1][l2];
+
+  if (new == NULL)
+    {
+#ifdef CONFIG_FS_REFCOUNT
+      if (!files_tryref(filep))
+        {
+          return NULL;
+        }
+
+      /* The descriptor may be reserved by dup2() and not used yet */
+
+      if (filep->f_inode == NULL)
+        {
+          fs_putfilep(filep);
+          return NULL;
+        }
+#else
+      if (filep->f_inode == NULL)
+        {
+          return NULL;
+        }
+#endif
+
+      return filep;
+    }
+
+  flags = files_lock();
+
 #ifdef CONFIG_FS_REFCOUNT
   if (filep->f_inode != NULL)
     {
@@ -80,36 +170,21 @@ static FAR struct file *files_fget_by_index(FAR struct filelist *list,
        * released, At this point we should return a null pointer
        */
 
-      if (filep->f_refs == 0)
+      if (!files_tryref(filep))
         {
           filep = NULL;
         }
-      else
-        {
-          filep->f_refs++;
-        }
-    }
-  else if (new == NULL)
-    {
-      filep = NULL;
     }
-  else if (filep->f_refs)
+  else if (!files_tryref(filep))
     {
-      filep->f_refs++;
-    }
-  else
-    {
-      filep->f_refs = 2;
+      /* The lookups never take a reference from zero */
+
+      atomic_store(&filep->f_refs, 2);
       *new = true;
     }
-#else
-  if (filep->f_inode == NULL && new == NULL)
-    {
-      filep = NULL;
-    }
 #endif
 
-  spin_unlock_irqrestore(NULL, flags);
+  files_unlock(flags);
   return filep;
 }
 
@@ -120,8 +195,8 @@ static FAR struct file *files_fget_by_index(FAR struct filelist *list,
 static int files_extend(FAR struct filelist *list, size_t row)
 {
   FAR struct file **files;
+  FAR struct file **tmp;
   uint8_t orig_rows;
-  FAR void *tmp;
   int flags;
   int i;
   int j;
@@ -138,13 +213,19 @@ static int files_extend(FAR struct filelist *list, size_t row)
       return -EMFILE;
     }
 
-  files = fs_heap_malloc(sizeof(FAR struct file *) * row);
+  /* The slot before the table links it to the retired tables once it is
+   * replaced in turn.
+   */
+
+  files = fs_heap_malloc(sizeof(FAR struct file *) * (row + 1));
   DEBUGASSERT(files);
   if (files == NULL)
     {
       return -ENFILE;
     }
 
+  files++;
+
   i = orig_rows;
   do
     {
@@ -157,13 +238,13 @@ static int files_extend(FAR struct filelist *list, size_t row)
               fs_heap_free(files[i]);
             }
 
-          fs_heap_free(files);
+          fs_heap_free(files - 1);
           return -ENFILE;
         }
     }
   while (++i < row);
 
-  flags = spin_lock_irqsave(NULL);
+  flags = files_lock();
 
   /* To avoid race condition, if the file list is updated by other threads
    * and list rows is greater or equal than temp list,
@@ -172,14 +253,14 @@ static int files_extend(FAR struct filelist *list, size_t row)
 
   if (orig_rows != list->fl_rows && list->fl_rows >= row)
     {
-      spin_unlock_irqrestore(NULL, flags);
+      files_unlock(flags);
 
       for (j = orig_rows; j < i; j++)
         {
           fs_heap_free(files[j]);
         }
 
-      fs_heap_free(files);
+      fs_heap_free(files - 1);
 
       return OK;
     }
@@ -190,17 +271,23 @@ static int files_extend(FAR struct filelist *list, size_t row)
              list->fl_rows * sizeof(FAR struct file *));
     }
 
+  /* Publish the table before its number of rows.  The lookups may still
+   * read the table it replaces, which is freed with the list only.
+   */
+
   tmp = list->fl_files;
   list->fl_files = files;
+  SP_DMB();
   list->fl_rows = row;
 
-  spin_unlock_irqrestore(NULL, flags);
-
   if (tmp != NULL && tmp != &list->fl_prefile)
     {
-      fs_heap_free(tmp);
+      tmp--;
+      tmp[0] = (FAR struct file *)list->fl_retired;
+      list->fl_retired = tmp;
     }
 
+  files_unlock(flags);
   return OK;
 }
 
@@ -318,6 +405,10 @@ static int nx_dup3_from_tcb(FAR struct tcb_s *tcb, int fd1, int fd2,
   f_tag_fdcheck = filep->f_tag_fdcheck;
 #endif
 
+#ifdef CONFIG_FS_POLL_CACHE
+  poll_cache_forget(filep);
+#endif
+
   /* Perform the dup3 operation */
 
   ret = file_dup3(filep1, filep, flags);
@@ -368,6 +459,7 @@ void files_initlist(FAR struct filelist *list)
   list->fl_rows = 1;
   list->fl_crefs = 1;
   list->fl_files = &list->fl_prefile;
+  list->fl_retired = NULL;
   list->fl_prefile = list->fl_prefiles;
 }
 
@@ -504,7 +596,15 @@ void files_putlist(FAR struct filelist *list)
 
   if (list->fl_files != &list->fl_prefile)
     {
-      fs_heap_free(list->fl_files);
+      fs_heap_free(list->fl_files - 1);
+    }
+
+  while (list->fl_retired != NULL)
+    {
+      FAR struct file **retired = list->fl_retired;
+
+      list->fl_retired = (FAR struct file **)retired[0];
+      fs_heap_free(retired);
     }
 }
 
@@ -578,13 +678,13 @@ int file_allocate_from_tcb(FAR struct tcb_s *tcb, FAR struct inode *inode,
 
   /* Find free file */
 
-  flags = spin_lock_irqsave(NULL);
+  flags = files_lock();
 
   for (; ; i++, j = 0)
     {
       if (i >= list->fl_rows)
         {
-          spin_unlock_irqrestore(NULL, flags);
+          files_unlock(flags);
 
           ret = files_extend(list, i + 1);
           if (ret < 0)
@@ -592,7 +692,7 @@ int file_allocate_from_tcb(FAR struct tcb_s *tcb, FAR struct inode *inode,
               return ret;
             }
 
-          flags = spin_lock_irqsave(NULL);
+          flags = files_lock();
         }
 
       do
@@ -604,15 +704,18 @@ int file_allocate_from_tcb(FAR struct tcb_s *tcb, FAR struct inode *inode,
               filep->f_pos         = pos;
               filep->f_inode       = inode;
               filep->f_priv        = priv;
-#ifdef CONFIG_FS_REFCOUNT
-              filep->f_refs        = 1;
-#endif
 #ifdef CONFIG_FDSAN
               filep->f_tag_fdsan   = 0;
 #endif
 #ifdef CONFIG_FDCHECK
               filep->f_tag_fdcheck = 0;
 #endif
+#ifdef CONFIG_FS_REFCOUNT
+
+              /* The lookups may use the file from now on */
+
+              atomic_store(&filep->f_refs, 1);
+#endif
 
               goto found;
             }
@@ -621,7 +724,7 @@ int file_allocate_from_tcb(FAR struct tcb_s *tcb, FAR struct inode *inode,
     }
 
 found:
-  spin_unlock_irqrestore(NULL, flags);
+  files_unlock(flags);
 
   if (addref)
     {
@@ -835,12 +938,8 @@ void fs_reffilep(FAR struct file *filep)
 {
   /* This interface is used to increase the reference count of filep */
 
-  irqstate_t flags;
-
   DEBUGASSERT(filep);
-  flags = spin_lock_irqsave(NULL);
-  filep->f_refs++;
-  spin_unlock_irqrestore(NULL, flags);
+  atomic_fetch_add(&filep->f_refs, 1);
 }
 
 /****************************************************************************
@@ -857,16 +956,11 @@ void fs_reffilep(FAR struct file *filep)
 
 int fs_putfilep(FAR struct file *filep)
 {
-  irqstate_t flags;
   int ret = 0;
   int refs;
 
   DEBUGASSERT(filep);
-  flags = spin_lock_irqsave(NULL);
-
-  refs = --filep->f_refs;
-
-  spin_unlock_irqrestore(NULL, flags);
+  refs = atomic_fetch_sub(&filep->f_refs, 1) - 1;
 
   /* If refs is zero, the close() had called, closing it now. */
 
@@ -1026,6 +1120,12 @@ int nx_close_from_tcb(FAR struct tcb_s *tcb, int fd)
       return -EBADF;
     }
 
+#ifdef CONFIG_FS_POLL_CACHE
+  /* Drop the references of the cached polls first */
+
+  poll_cache_forget(filep);
+#endif
+
 #ifdef CONFIG_FS_REFCOUNT
 
   /* files_fget will increase the reference count, there call fs_putfilep
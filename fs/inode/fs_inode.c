@@ -24,6 +24,7 @@
 
 #include <nuttx/fs/fs.h>
 #include <nuttx/rwsem.h>
+#include <nuttx/spinlock.h>
 
 #include "inode/inode.h"
 
@@ -41,6 +42,12 @@
 
 static rw_semaphore_t g_inode_lock = RWSEM_INITIALIZER;
 
+#ifdef CONFIG_RCU
+/* Incremented when the outermost writer takes and releases g_inode_lock */
+
+static volatile unsigned int g_inode_seq;
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -72,6 +79,21 @@ void inode_initialize(void)
 void inode_lock(void)
 {
   down_write(&g_inode_lock);
+
+#ifdef CONFIG_FS_INODE_CACHE
+  if (g_inode_lock.writer == 1)
+    {
+      inode_cache_invalidate();
+    }
+#endif
+
+#ifdef CONFIG_RCU
+  if (g_inode_lock.writer == 1)
+    {
+      g_inode_seq++;
+      SP_DMB();
+    }
+#endif
 }
 
 /****************************************************************************
@@ -97,6 +119,21 @@ void inode_rlock(void)
 
 void inode_unlock(void)
 {
+#ifdef CONFIG_RCU
+  if (g_inode_lock.writer == 1)
+    {
+      SP_DMB();
+      g_inode_seq++;
+    }
+#endif
+
+#ifdef CONFIG_FS_INODE_CACHE
+  if (g_inode_lock.writer == 1)
+    {
+      inode_cache_invalidate();
+    }
+#endif
+
   up_write(&g_inode_lock);
 }
 
@@ -112,3 +149,21 @@ void inode_runlock(void)
 {
   up_read(&g_inode_lock);
 }
+
+/****************************************************************************
+ * Name: inode_seqcount
+ *
+ * Description:
+ *   Return the modification count of the in-memory inode tree.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RCU
+unsigned int inode_seqcount(void)
+{
+  unsigned int seq = g_inode_seq;
+
+  SP_DMB();
+  return seq;
+}
+#endif
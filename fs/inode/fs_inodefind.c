@@ -28,9 +28,75 @@
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/rcu.h>
 
 #include "inode/inode.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Resolving soft links allocates memory and cannot be done by a lock-free
+ * reader.
+ */
+
+#if defined(CONFIG_RCU) && !defined(CONFIG_PSEUDOFS_SOFTLINKS)
+#  define HAVE_INODE_FASTFIND 1
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_fastfind
+ *
+ * Description:
+ *   Look up an absolute path without taking the inode lock.  The result is
+ *   discarded if a writer held or modified the inode tree meanwhile:  the
+ *   writer may not have finished initializing the inode yet.
+ *
+ * Returned Value:
+ *   The inode_search() result or -EAGAIN if the caller has to search
+ *   again with the inode tree locked.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_INODE_FASTFIND
+static int inode_fastfind(FAR struct inode_search_s *desc)
+{
+  unsigned int seq;
+  int ret;
+
+  seq = inode_seqcount();
+  if ((seq & 1) != 0)
+    {
+      return -EAGAIN;
+    }
+
+  rcu_read_lock();
+  ret = inode_search(desc);
+  if (ret >= 0)
+    {
+      atomic_fetch_add(&desc->node->i_crefs, 1);
+    }
+
+  rcu_read_unlock();
+
+  if (inode_seqcount() != seq)
+    {
+      if (ret >= 0)
+        {
+          inode_release(desc->node);
+        }
+
+      return -EAGAIN;
+    }
+
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -51,6 +117,21 @@ int inode_find(FAR struct inode_search_s *desc)
 {
   int ret;
 
+#ifdef HAVE_INODE_FASTFIND
+  /* Most lookups are of absolute paths in a tree that is not being
+   * modified.  Try those without the inode lock first.
+   */
+
+  if (*desc->path == '/')
+    {
+      ret = inode_fastfind(desc);
+      if (ret != -EAGAIN)
+        {
+          return ret;
+        }
+    }
+#endif
+
   /* Find the node matching the path.  If found, increment the count of
    * references on the node.
    */
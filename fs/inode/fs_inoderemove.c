@@ -29,6 +29,7 @@
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/rcu.h>
 
 #include "inode/inode.h"
 
@@ -94,6 +95,10 @@ static FAR struct inode *inode_unlink(FAR const char *path)
           desc.parent->i_child = inode->i_peer;
         }
 
+      /* Lock-free readers may still be walking through the inode */
+
+      synchronize_rcu();
+
       inode->i_peer   = NULL;
       inode->i_parent = NULL;
       atomic_fetch_sub(&inode->i_crefs, 1);
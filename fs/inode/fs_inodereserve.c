@@ -29,6 +29,7 @@
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/rcu.h>
 
 #include "inode/inode.h"
 #include "fs_heap.h"
@@ -115,7 +116,7 @@ static void inode_insert(FAR struct inode *inode,
     {
       inode->i_peer   = peer->i_peer;
       inode->i_parent = parent;
-      peer->i_peer    = inode;
+      rcu_assign_pointer(peer->i_peer, inode);
     }
 
   /* Then it must go at the head of parent's list of children. */
@@ -125,7 +126,7 @@ static void inode_insert(FAR struct inode *inode,
       DEBUGASSERT(parent != NULL);
       inode->i_peer   = parent->i_child;
       inode->i_parent = parent;
-      parent->i_child = inode;
+      rcu_assign_pointer(parent->i_child, inode);
     }
 }
 
@@ -32,10 +32,37 @@
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/spinlock.h>
 
 #include "inode/inode.h"
 #include "fs_heap.h"
 
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_CACHE
+/* A cached result of inode_search().  A search that ends in a mounted file
+ * system caches the mountpoint and the offset of the relative path, and a
+ * search of a path that does not exist caches the -ENOENT result and the
+ * insertion point.  The entry only holds while its generation is current.
+ */
+
+struct inode_cache_s
+{
+  uint32_t          hash;      /* Hash of the path */
+  unsigned int      gen;       /* Generation of the inode tree */
+  FAR struct inode *node;      /* desc->node */
+  FAR struct inode *peer;      /* desc->peer */
+  FAR struct inode *parent;    /* desc->parent */
+  int16_t           ret;       /* The result of the search */
+  uint16_t          pathoff;   /* Offset of desc->path in the path */
+  int16_t           reloff;    /* Offset of desc->relpath, -1 if NULL */
+  bool              nofollow;  /* desc->nofollow */
+  char              path[CONFIG_FS_INODE_CACHE_PATHLEN];
+};
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -54,6 +81,21 @@ static FAR const char *_inode_getcwd(void);
 
 FAR struct inode *g_root_inode = NULL;
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_CACHE
+static struct inode_cache_s g_inode_cache[CONFIG_FS_INODE_CACHE_SIZE];
+static spinlock_t g_inode_cache_lock = SP_UNLOCKED;
+
+/* Incremented when a writer takes and releases the inode lock:  It is odd
+ * while the tree may be modified, then nothing is cached.
+ */
+
+static volatile unsigned int g_inode_cache_gen;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -187,6 +229,9 @@ static int _inode_linktarget(FAR struct inode *inode,
     }
 
   desc->nofollow = save;
+#ifdef CONFIG_FS_INODE_CACHE
+  desc->linked   = true;
+#endif
   return ret;
 }
 #endif
@@ -413,6 +458,115 @@ static int _inode_search(FAR struct inode_search_s *desc)
   return ret;
 }
 
+/****************************************************************************
+ * Name: inode_cache_hash
+ *
+ * Description:
+ *   Return the hash and the length of a path.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_CACHE
+static uint32_t inode_cache_hash(FAR const char *path, FAR size_t *len)
+{
+  FAR const char *ptr = path;
+  uint32_t hash = 2166136261u;
+
+  /* FNV-1a */
+
+  while (*ptr != '\0')
+    {
+      hash = (hash ^ (uint8_t)*ptr++) * 16777619u;
+    }
+
+  *len = ptr - path;
+  return hash;
+}
+
+/****************************************************************************
+ * Name: inode_cache_lookup
+ *
+ * Description:
+ *   Return the cached result of the search of desc->path.
+ *
+ * Returned Value:
+ *   The result of inode_search(), -EAGAIN if it is not cached.
+ *
+ ****************************************************************************/
+
+static int inode_cache_lookup(FAR struct inode_search_s *desc,
+                              uint32_t hash, size_t len)
+{
+  FAR struct inode_cache_s *entry;
+  FAR const char *path = desc->path;
+  irqstate_t flags;
+  int ret = -EAGAIN;
+
+  entry = &g_inode_cache[hash % CONFIG_FS_INODE_CACHE_SIZE];
+
+  flags = spin_lock_irqsave(&g_inode_cache_lock);
+  if (entry->gen == g_inode_cache_gen && (entry->gen & 1) == 0 &&
+      entry->hash == hash && entry->nofollow == desc->nofollow &&
+      memcmp(entry->path, path, len + 1) == 0)
+    {
+      desc->path    = path + entry->pathoff;
+      desc->node    = entry->node;
+      desc->peer    = entry->peer;
+      desc->parent  = entry->parent;
+      desc->relpath = entry->reloff < 0 ? NULL : path + entry->reloff;
+      ret           = entry->ret;
+    }
+
+  spin_unlock_irqrestore(&g_inode_cache_lock, flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: inode_cache_insert
+ *
+ * Description:
+ *   Cache the result of the search of 'path' if the inode tree was not
+ *   modified since the generation 'gen'.  The searches through soft links
+ *   are not cached:  Their results do not lie in 'path'.
+ *
+ ****************************************************************************/
+
+static void inode_cache_insert(FAR struct inode_search_s *desc,
+                               FAR const char *path, uint32_t hash,
+                               size_t len, unsigned int gen, int ret)
+{
+  FAR struct inode_cache_s *entry;
+  irqstate_t flags;
+
+  if ((ret != OK && ret != -ENOENT) || desc->linked ||
+      desc->path < path || desc->path > path + len ||
+      (desc->relpath != NULL &&
+       (desc->relpath < path || desc->relpath > path + len)))
+    {
+      return;
+    }
+
+  entry = &g_inode_cache[hash % CONFIG_FS_INODE_CACHE_SIZE];
+
+  flags = spin_lock_irqsave(&g_inode_cache_lock);
+  if (gen == g_inode_cache_gen && (gen & 1) == 0)
+    {
+      entry->hash     = hash;
+      entry->gen      = gen;
+      entry->node     = desc->node;
+      entry->peer     = desc->peer;
+      entry->parent   = desc->parent;
+      entry->ret      = ret;
+      entry->pathoff  = desc->path - path;
+      entry->reloff   = desc->relpath != NULL ? desc->relpath - path : -1;
+      entry->nofollow = desc->nofollow;
+      memcpy(entry->path, path, len + 1);
+    }
+
+  spin_unlock_irqrestore(&g_inode_cache_lock, flags);
+}
+#endif
+
 /****************************************************************************
  * Name: _inode_getcwd
  *
@@ -466,6 +620,12 @@ static FAR const char *_inode_getcwd(void)
 
 int inode_search(FAR struct inode_search_s *desc)
 {
+#ifdef CONFIG_FS_INODE_CACHE
+  FAR const char *path;
+  unsigned int gen;
+  uint32_t hash;
+  size_t len;
+#endif
   int ret;
 
   /* Perform the common _inode_search() logic.  This does everything except
@@ -489,6 +649,24 @@ int inode_search(FAR struct inode_search_s *desc)
       desc->path = desc->buffer;
     }
 
+#ifdef CONFIG_FS_INODE_CACHE
+  /* Paths are looked up again and again, try the cache first */
+
+  gen  = g_inode_cache_gen;
+  path = desc->path;
+  hash = inode_cache_hash(path, &len);
+  if (len < CONFIG_FS_INODE_CACHE_PATHLEN)
+    {
+      ret = inode_cache_lookup(desc, hash, len);
+      if (ret != -EAGAIN)
+        {
+          return ret;
+        }
+    }
+
+  desc->linked = false;
+#endif
+
   ret = _inode_search(desc);
 
 #ifdef CONFIG_PSEUDOFS_SOFTLINKS
@@ -524,9 +702,36 @@ int inode_search(FAR struct inode_search_s *desc)
     }
 #endif
 
+#ifdef CONFIG_FS_INODE_CACHE
+  if (len < CONFIG_FS_INODE_CACHE_PATHLEN)
+    {
+      inode_cache_insert(desc, path, hash, len, gen, ret);
+    }
+#endif
+
   return ret;
 }
 
+/****************************************************************************
+ * Name: inode_cache_invalidate
+ *
+ * Description:
+ *   Drop the cached inode_search() results.  Called when a writer takes
+ *   the inode lock and again when it releases it.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_CACHE
+void inode_cache_invalidate(void)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_inode_cache_lock);
+  g_inode_cache_gen++;
+  spin_unlock_irqrestore(&g_inode_cache_lock, flags);
+}
+#endif
+
 /****************************************************************************
  * Name: inode_nextname
  *
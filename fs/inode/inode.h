@@ -118,6 +118,8 @@
  *           - OUTPUT: May hold an allocated intermediate path which is
  *                     probably of no interest to the caller unless it holds
  *                     the relpath.
+ *  linked   - INPUT:  (not used)
+ *           - OUTPUT: (internal) A soft link was followed.
  */
 
 struct inode_search_s
@@ -129,6 +131,9 @@ struct inode_search_s
   FAR const char *relpath;   /* Relative path into the mountpoint */
   FAR char *buffer;          /* Path expansion buffer */
   bool nofollow;             /* true: Don't follow terminal soft link */
+#ifdef CONFIG_FS_INODE_CACHE
+  bool linked;               /* true: A soft link was followed */
+#endif
 };
 
 /* Callback used by foreach_inode to traverse all inodes in the pseudo-
@@ -209,6 +214,20 @@ void inode_unlock(void);
 
 void inode_runlock(void);
 
+/****************************************************************************
+ * Name: inode_seqcount
+ *
+ * Description:
+ *   Return the modification count of the in-memory inode tree.  The count
+ *   is odd while a writer holds the tree and changes whenever a writer
+ *   releases it.  Lock-free readers use it to validate their result.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RCU
+unsigned int inode_seqcount(void);
+#endif
+
 /****************************************************************************
  * Name: inode_search
  *
@@ -235,6 +254,20 @@ void inode_runlock(void);
 
 int inode_search(FAR struct inode_search_s *desc);
 
+/****************************************************************************
+ * Name: inode_cache_invalidate
+ *
+ * Description:
+ *   Drop the cached inode_search() results.  It is called when a writer
+ *   takes the inode lock and when it releases the lock, so that nothing is
+ *   cached while the tree is modified.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_CACHE
+void inode_cache_invalidate(void);
+#endif
+
 /****************************************************************************
  * Name: inode_find
  *
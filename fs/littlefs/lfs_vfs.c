@@ -26,6 +26,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <nuttx/fs/fs.h>
@@ -66,6 +67,18 @@ struct littlefs_file_s
   int                   refs;
 };
 
+/* An entry of the metadata cache:  The cache_size bytes of a block at the
+ * offset 'off', aligned on cache_size.
+ */
+
+struct littlefs_mcache_s
+{
+  lfs_block_t           block;    /* LFS_BLOCK_NULL if the entry is free */
+  lfs_off_t             off;      /* Offset of the data in the block */
+  uint32_t              stamp;    /* Time of the last use */
+  FAR uint8_t          *data;
+};
+
 /* This structure represents the overall mountpoint state. An instance of
  * this structure is retained as inode private data on each mountpoint that
  * is mounted with a littlefs filesystem.
@@ -78,6 +91,12 @@ struct littlefs_mountpt_s
   struct mtd_geometry_s geo;
   struct lfs_config     cfg;
   struct lfs            lfs;
+
+  /* The metadata cache, NULL if disabled */
+
+  FAR struct littlefs_mcache_s *mcache;
+  int                   nmcache;
+  uint32_t              mstamp;
 };
 
 struct littlefs_attr_s
@@ -1083,16 +1102,15 @@ static int littlefs_rewinddir(FAR struct inode *mountpt,
  *
  ****************************************************************************/
 
-static int littlefs_read_block(FAR const struct lfs_config *c,
-                               lfs_block_t block, lfs_off_t off,
-                               FAR void *buffer, lfs_size_t size)
+static int littlefs_read_device(FAR struct littlefs_mountpt_s *fs,
+                                lfs_block_t block, lfs_off_t off,
+                                FAR void *buffer, lfs_size_t size)
 {
-  FAR struct littlefs_mountpt_s *fs = c->context;
   FAR struct mtd_geometry_s *geo = &fs->geo;
   FAR struct inode *drv = fs->drv;
   int ret;
 
-  block = (block * c->block_size + off) / geo->blocksize;
+  block = (block * fs->cfg.block_size + off) / geo->blocksize;
   size  = size / geo->blocksize;
 
   if (INODE_IS_MTD(drv))
@@ -1107,6 +1125,122 @@ static int littlefs_read_block(FAR const struct lfs_config *c,
   return ret >= 0 ? OK : ret;
 }
 
+/****************************************************************************
+ * Name: littlefs_mcache_read
+ *
+ * Description:
+ *   Read through the metadata cache:  The small reads of littlefs are for
+ *   the metadata pairs mostly, the path lookups and the directory
+ *   traversals read the same ones again and again.
+ *
+ ****************************************************************************/
+
+static int littlefs_mcache_read(FAR struct littlefs_mountpt_s *fs,
+                                lfs_block_t block, lfs_off_t off,
+                                FAR void *buffer, lfs_size_t size)
+{
+  FAR struct littlefs_mcache_s *victim = fs->mcache;
+  FAR struct littlefs_mcache_s *entry;
+  lfs_off_t base = off - off % fs->cfg.cache_size;
+  int ret;
+  int i;
+
+  for (i = 0; i < fs->nmcache; i++)
+    {
+      entry = &fs->mcache[i];
+      if (entry->block == block && entry->off == base)
+        {
+          goto found;
+        }
+
+      if (entry->stamp < victim->stamp)
+        {
+          victim = entry;
+        }
+    }
+
+  entry = victim;
+  entry->block = LFS_BLOCK_NULL;
+  entry->stamp = 0;
+
+  ret = littlefs_read_device(fs, block, base, entry->data,
+                             fs->cfg.cache_size);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  entry->block = block;
+  entry->off   = base;
+
+found:
+  entry->stamp = ++fs->mstamp;
+  memcpy(buffer, entry->data + off - base, size);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: littlefs_mcache_update
+ *
+ * Description:
+ *   Update the cached data of a block after a program, or drop it if the
+ *   program failed or the block is erased ('buffer' NULL).
+ *
+ ****************************************************************************/
+
+static void littlefs_mcache_update(FAR struct littlefs_mountpt_s *fs,
+                                   lfs_block_t block, lfs_off_t off,
+                                   FAR const void *buffer, lfs_size_t size)
+{
+  FAR struct littlefs_mcache_s *entry;
+  lfs_off_t start;
+  lfs_off_t end;
+  int i;
+
+  for (i = 0; i < fs->nmcache; i++)
+    {
+      entry = &fs->mcache[i];
+      if (entry->block != block)
+        {
+          continue;
+        }
+
+      if (buffer == NULL)
+        {
+          entry->block = LFS_BLOCK_NULL;
+          entry->stamp = 0;
+          continue;
+        }
+
+      start = lfs_max(off, entry->off);
+      end   = lfs_min(off + size, entry->off + fs->cfg.cache_size);
+      if (start < end)
+        {
+          memcpy(entry->data + start - entry->off,
+                 (FAR const uint8_t *)buffer + start - off, end - start);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: littlefs_read_block
+ ****************************************************************************/
+
+static int littlefs_read_block(FAR const struct lfs_config *c,
+                               lfs_block_t block, lfs_off_t off,
+                               FAR void *buffer, lfs_size_t size)
+{
+  FAR struct littlefs_mountpt_s *fs = c->context;
+
+  if (fs->nmcache > 0 && size <= c->cache_size &&
+      off / c->cache_size == (off + size - 1) / c->cache_size)
+    {
+      return littlefs_mcache_read(fs, block, off, buffer, size);
+    }
+
+  return littlefs_read_device(fs, block, off, buffer, size);
+}
+
 /****************************************************************************
  * Name: littlefs_write_block
  ****************************************************************************/
@@ -1118,20 +1252,25 @@ static int littlefs_write_block(FAR const struct lfs_config *c,
   FAR struct littlefs_mountpt_s *fs = c->context;
   FAR struct mtd_geometry_s *geo = &fs->geo;
   FAR struct inode *drv = fs->drv;
+  lfs_block_t sector;
+  lfs_size_t nsectors;
   int ret;
 
-  block = (block * c->block_size + off) / geo->blocksize;
-  size  = size / geo->blocksize;
+  /* A program of the whole cache goes to the device in a single write */
+
+  sector   = (block * c->block_size + off) / geo->blocksize;
+  nsectors = size / geo->blocksize;
 
   if (INODE_IS_MTD(drv))
     {
-      ret = MTD_BWRITE(drv->u.i_mtd, block, size, buffer);
+      ret = MTD_BWRITE(drv->u.i_mtd, sector, nsectors, buffer);
     }
   else
     {
-      ret = drv->u.i_bops->write(drv, buffer, block, size);
+      ret = drv->u.i_bops->write(drv, buffer, sector, nsectors);
     }
 
+  littlefs_mcache_update(fs, block, off, ret >= 0 ? buffer : NULL, size);
   return ret >= 0 ? OK : ret;
 }
 
@@ -1146,6 +1285,7 @@ static int littlefs_erase_block(FAR const struct lfs_config *c,
   FAR struct inode *drv = fs->drv;
   int ret = OK;
 
+  littlefs_mcache_update(fs, block, 0, NULL, 0);
   if (INODE_IS_MTD(drv))
     {
       FAR struct mtd_geometry_s *geo = &fs->geo;
@@ -1187,6 +1327,128 @@ static int littlefs_sync_block(FAR const struct lfs_config *c)
   return ret == -ENOTTY ? OK : ret;
 }
 
+/****************************************************************************
+ * Name: littlefs_parse_options
+ *
+ * Description:
+ *   Parse the comma separated mount options:
+ *     "forceformat", "autoformat"
+ *     "cache_size=N", "lookahead_size=N", "block_cycles=N" override the
+ *       values derived from the geometry and the configuration.
+ *     "metadata_cache=N", the number of entries of the metadata cache.
+ *
+ ****************************************************************************/
+
+static int littlefs_parse_options(FAR struct littlefs_mountpt_s *fs,
+                                  FAR const char *data,
+                                  FAR bool *forceformat,
+                                  FAR bool *autoformat)
+{
+  FAR struct lfs_config *cfg = &fs->cfg;
+  FAR char *options;
+  FAR char *saveptr;
+  FAR char *ptr;
+  int ret = OK;
+
+  if (data == NULL)
+    {
+      return OK;
+    }
+
+  options = fs_heap_strdup(data);
+  if (options == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ptr = strtok_r(options, ",", &saveptr);
+  while (ptr != NULL)
+    {
+      if (strcmp(ptr, "forceformat") == 0)
+        {
+          *forceformat = true;
+        }
+      else if (strcmp(ptr, "autoformat") == 0)
+        {
+          *autoformat = true;
+        }
+      else if (strncmp(ptr, "cache_size=", 11) == 0)
+        {
+          cfg->cache_size = atoi(&ptr[11]);
+          if (cfg->cache_size == 0 ||
+              cfg->cache_size % cfg->read_size != 0 ||
+              cfg->cache_size % cfg->prog_size != 0 ||
+              cfg->block_size % cfg->cache_size != 0)
+            {
+              ret = -EINVAL;
+              break;
+            }
+        }
+      else if (strncmp(ptr, "lookahead_size=", 15) == 0)
+        {
+          cfg->lookahead_size = atoi(&ptr[15]);
+          if (cfg->lookahead_size == 0 || cfg->lookahead_size % 8 != 0)
+            {
+              ret = -EINVAL;
+              break;
+            }
+        }
+      else if (strncmp(ptr, "block_cycles=", 13) == 0)
+        {
+          cfg->block_cycles = atoi(&ptr[13]);
+        }
+      else if (strncmp(ptr, "metadata_cache=", 15) == 0)
+        {
+          fs->nmcache = atoi(&ptr[15]);
+          if (fs->nmcache < 0)
+            {
+              ret = -EINVAL;
+              break;
+            }
+        }
+
+      ptr = strtok_r(NULL, ",", &saveptr);
+    }
+
+  fs_heap_free(options);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: littlefs_mcache_alloc
+ ****************************************************************************/
+
+static int littlefs_mcache_alloc(FAR struct littlefs_mountpt_s *fs)
+{
+  FAR uint8_t *data;
+  int i;
+
+  if (fs->nmcache == 0)
+    {
+      return OK;
+    }
+
+  /* The entries and their data in a single allocation */
+
+  fs->mcache = fs_heap_malloc(fs->nmcache *
+                              (sizeof(*fs->mcache) + fs->cfg.cache_size));
+  if (fs->mcache == NULL)
+    {
+      fs->nmcache = 0;
+      return -ENOMEM;
+    }
+
+  data = (FAR uint8_t *)&fs->mcache[fs->nmcache];
+  for (i = 0; i < fs->nmcache; i++)
+    {
+      fs->mcache[i].block = LFS_BLOCK_NULL;
+      fs->mcache[i].stamp = 0;
+      fs->mcache[i].data  = data + i * fs->cfg.cache_size;
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Name: littlefs_bind
  ****************************************************************************/
@@ -1195,6 +1457,8 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
                          FAR void **handle)
 {
   FAR struct littlefs_mountpt_s *fs;
+  bool forceformat = false;
+  bool autoformat = false;
   int ret;
 
   /* Open the block driver */
@@ -1295,13 +1559,27 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
   fs->cfg.lookahead_size = CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE;
 #endif
 
+  fs->nmcache = CONFIG_FS_LITTLEFS_METADATA_CACHE;
+
+  ret = littlefs_parse_options(fs, data, &forceformat, &autoformat);
+  if (ret < 0)
+    {
+      goto errout_with_fs;
+    }
+
+  ret = littlefs_mcache_alloc(fs);
+  if (ret < 0)
+    {
+      goto errout_with_fs;
+    }
+
   /* Then get information about the littlefs filesystem on the devices
    * managed by this driver.
    */
 
   /* Force format the device if -o forceformat */
 
-  if (data && strcmp(data, "forceformat") == 0)
+  if (forceformat)
     {
       ret = littlefs_convert_result(lfs_format(&fs->lfs, &fs->cfg));
       if (ret < 0)
@@ -1315,7 +1593,7 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
     {
       /* Auto format the device if -o autoformat */
 
-      if (ret != -EFAULT || !data || strcmp(data, "autoformat"))
+      if (ret != -EFAULT || !autoformat)
         {
           goto errout_with_fs;
         }
@@ -1340,6 +1618,7 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
 
 errout_with_fs:
   nxmutex_destroy(&fs->lock);
+  fs_heap_free(fs->mcache);
   fs_heap_free(fs);
 errout_with_block:
   if (INODE_IS_BLOCK(driver) && driver->u.i_bops->close)
@@ -1399,6 +1678,7 @@ static int littlefs_unbind(FAR void *handle, FAR struct inode **driver,
       /* Release the mountpoint private data */
 
       nxmutex_destroy(&fs->lock);
+      fs_heap_free(fs->mcache);
       fs_heap_free(fs);
     }
 
@@ -35,6 +35,7 @@
 #include <nuttx/kmalloc.h>
 
 #include "inode/inode.h"
+#include "vfs/pagecache.h"
 #include "fs_rammap.h"
 #include "fs_anonmap.h"
 
@@ -59,7 +60,8 @@ static int file_mmap_(FAR struct file *filep, FAR void *start,
 
   struct mm_map_entry_s entry =
     {
-     NULL,     /* sq_entry_t */
+     { NULL }, /* node */
+     0,        /* end_max */
      start,
      length,
      offset,
@@ -151,6 +153,17 @@ static int file_mmap_(FAR struct file *filep, FAR void *start,
       ret = filep->f_inode->u.i_ops->mmap(filep, &entry);
     }
 
+  if (ret == -ENOTTY && (flags & MAP_SHARED) != 0)
+    {
+      /* The shared mappings of a cached file hold its cached pages */
+
+      ret = pagecache_mmap(filep, &entry, type);
+      if (ret == -ENOSYS)
+        {
+          ret = -ENOTTY;
+        }
+    }
+
   if (ret == -ENOTTY)
     {
       /* Caller request the private mapping. Or not directly mappable,
@@ -31,6 +31,7 @@
 #include <assert.h>
 #include <debug.h>
 
+#include <nuttx/boottrace.h>
 #include <nuttx/fs/fs.h>
 
 #include "driver/driver.h"
@@ -313,6 +314,8 @@ int nx_mount(FAR const char *source, FAR const char *target,
 
   DEBUGASSERT(target && filesystemtype);
 
+  boottrace_begin("mount %s", target);
+
   /* Find the specified filesystem. Try the block driver filesystems first */
 
   if (source != NULL && source[0] != '\0' &&
@@ -522,6 +525,7 @@ int nx_mount(FAR const char *source, FAR const char *target,
 #ifdef CONFIG_FS_NOTIFY
   notify_create(target);
 #endif
+  boottrace_end("mount %s", target);
   return OK;
 
   /* A lot of goto's!  But they make the error handling much simpler */
@@ -547,6 +551,7 @@ errout_with_inode:
 #endif
 
 errout:
+  boottrace_end("mount %s", target);
   return ret;
 
 #else
@@ -33,6 +33,7 @@
 
 #include "inode/inode.h"
 #include "notify/notify.h"
+#include "vfs/pagecache.h"
 
 /****************************************************************************
  * Public Functions
@@ -108,6 +109,10 @@ int nx_umount2(FAR const char *target, unsigned int flags)
    * performed, or a negated error code on a failure.
    */
 
+  /* Drop the pages of the volume from the page cache */
+
+  pagecache_invalidate(mountpt_inode);
+
   /* Hold the semaphore through the unbind logic */
 
   inode_lock();
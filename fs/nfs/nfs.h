@@ -77,6 +77,12 @@
 #  define nfs_statistics(n)
 #endif
 
+/* Drop the cached look-ups of a mount after a change */
+
+#ifndef CONFIG_NFS_ATTRCACHE
+#  define nfs_attrcache_invalidate(nmp)
+#endif
+
 /****************************************************************************
  *  Public Data
  ****************************************************************************/
@@ -112,6 +118,11 @@ extern "C"
 EXTERN int nfs_request(FAR struct nfsmount *nmp, int procnum,
                 FAR void *request, size_t reqlen,
                 FAR void *response, size_t resplen);
+EXTERN int nfs_sendrequest(FAR struct nfsmount *nmp, int procnum,
+                FAR void *request, size_t reqlen, FAR uint32_t *xid);
+EXTERN int nfs_recvreply(FAR struct nfsmount *nmp, FAR uint32_t *xid,
+                FAR void *response, size_t resplen);
+EXTERN int nfs_checkreply(FAR void *response);
 EXTERN int  nfs_lookup(FAR struct nfsmount *nmp, FAR const char *filename,
               FAR struct file_handle *fhandle,
               FAR struct nfs_fattr *obj_attributes,
@@ -125,6 +136,9 @@ EXTERN int nfs_finddir(FAR struct nfsmount *nmp, FAR const char *relpath,
               FAR struct nfs_fattr *attributes, FAR char *filename);
 EXTERN void nfs_attrupdate(FAR struct nfsnode *np,
               FAR struct nfs_fattr *attributes);
+#ifdef CONFIG_NFS_ATTRCACHE
+EXTERN void nfs_attrcache_invalidate(FAR struct nfsmount *nmp);
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -61,6 +61,18 @@
  * Public Types
  ****************************************************************************/
 
+/* An entry of the attribute cache: The result of the look-up of a path */
+
+#ifdef CONFIG_NFS_ATTRCACHE
+struct nfs_attrcache_s
+{
+  FAR char                 *ac_path;          /* The relative path, NULL if unused */
+  clock_t                   ac_time;          /* When the path was looked up */
+  struct file_handle        ac_fhandle;       /* The file handle of the path */
+  struct nfs_fattr          ac_fattr;         /* The attributes of the file */
+};
+#endif
+
 /* Mount structure. One mount structure is allocated for each NFS mount. This
  * structure holds NFS specific information for mount.
  */
@@ -79,6 +91,9 @@ struct nfsmount
   uint16_t                  nm_wsize;         /* Max size of write RPC */
   uint16_t                  nm_readdirsize;   /* Size of a readdir RPC */
   uint16_t                  nm_buflen;        /* Size of I/O buffer */
+#ifdef CONFIG_NFS_ATTRCACHE
+  struct nfs_attrcache_s    nm_attrcache[CONFIG_NFS_ATTRCACHE_NENTRIES];
+#endif
 
   /* Set aside memory on the stack to hold the largest call message.
    * NOTE that for the case of the write call message, it is the reply
@@ -98,6 +113,7 @@ struct nfsmount
     struct rpc_call_fs      fsstat;
     struct rpc_call_setattr setattr;
     struct rpc_call_fs      fsinfo;
+    struct rpc_call_commit  commit;
     struct rpc_reply_write  write;
   } nm_msgbuffer;
 
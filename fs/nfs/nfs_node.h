@@ -50,6 +50,17 @@
 
 #include "nfs_proto.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Values of n_cflags */
+
+#define NFSNODE_DIRTY       (1 << 0) /* n_cbuffer holds data not written */
+#define NFSNODE_UNCOMMITTED (1 << 1) /* Unstable writes not committed */
+#define NFSNODE_VERF        (1 << 2) /* n_verf is the verifier of them */
+#define NFSNODE_LOST        (1 << 3) /* The server lost unstable writes */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -70,6 +81,14 @@ struct nfsnode
   struct timespec     n_ctime;      /* File creation time */
   nfsfh_t             n_fhandle;    /* NFS File Handle */
   uint64_t            n_size;       /* Current size of file */
+#ifdef CONFIG_NFS_CACHE
+  FAR uint8_t        *n_cbuffer;    /* Read-ahead or write-behind data */
+  uint64_t            n_coffset;    /* File offset of the data */
+  uint64_t            n_cnext;      /* Offset of a sequential read */
+  uint32_t            n_clen;       /* Bytes of data in n_cbuffer */
+  uint8_t             n_cflags;     /* See NFSNODE_* definitions */
+  uint8_t             n_verf[NFSX_V3WRITEVERF];
+#endif
 };
 
 #endif /* __FS_NFS_NFS_NODE_H */
@@ -36,6 +36,9 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
+
+#include "fs_heap.h"
 #include "rpc.h"
 #include "nfs.h"
 #include "nfs_proto.h"
@@ -99,6 +102,104 @@ static inline int nfs_pathsegment(FAR const char **path, FAR char *buffer,
     }
 }
 
+/****************************************************************************
+ * Name: nfs_attrcache_find
+ *
+ * Description:
+ *   Look up a path in the attribute cache of a mount.  The entries older
+ *   than CONFIG_NFS_ACTIMEO seconds are dropped.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NFS_ATTRCACHE
+static bool nfs_attrcache_find(FAR struct nfsmount *nmp,
+                               FAR const char *relpath,
+                               FAR struct file_handle *fhandle,
+                               FAR struct nfs_fattr *obj_attributes)
+{
+  FAR struct nfs_attrcache_s *entry;
+  clock_t now = clock_systime_ticks();
+  int i;
+
+  for (i = 0; i < CONFIG_NFS_ATTRCACHE_NENTRIES; i++)
+    {
+      entry = &nmp->nm_attrcache[i];
+      if (entry->ac_path == NULL)
+        {
+          continue;
+        }
+
+      if (now - entry->ac_time >= SEC2TICK(CONFIG_NFS_ACTIMEO))
+        {
+          fs_heap_free(entry->ac_path);
+          entry->ac_path = NULL;
+          continue;
+        }
+
+      if (strcmp(entry->ac_path, relpath) == 0)
+        {
+          memcpy(fhandle, &entry->ac_fhandle, sizeof(struct file_handle));
+          if (obj_attributes != NULL)
+            {
+              memcpy(obj_attributes, &entry->ac_fattr,
+                     sizeof(struct nfs_fattr));
+            }
+
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: nfs_attrcache_add
+ *
+ * Description:
+ *   Add the result of a successful path look-up to the attribute cache,
+ *   replacing the oldest entry if the cache is full.
+ *
+ ****************************************************************************/
+
+static void nfs_attrcache_add(FAR struct nfsmount *nmp,
+                              FAR const char *relpath,
+                              FAR struct file_handle *fhandle,
+                              FAR struct nfs_fattr *obj_attributes)
+{
+  FAR struct nfs_attrcache_s *entry = NULL;
+  clock_t now = clock_systime_ticks();
+  int i;
+
+  for (i = 0; i < CONFIG_NFS_ATTRCACHE_NENTRIES; i++)
+    {
+      if (nmp->nm_attrcache[i].ac_path == NULL)
+        {
+          entry = &nmp->nm_attrcache[i];
+          break;
+        }
+
+      if (entry == NULL ||
+          now - nmp->nm_attrcache[i].ac_time > now - entry->ac_time)
+        {
+          entry = &nmp->nm_attrcache[i];
+        }
+    }
+
+  if (entry->ac_path != NULL)
+    {
+      fs_heap_free(entry->ac_path);
+    }
+
+  entry->ac_path = fs_heap_strdup(relpath);
+  if (entry->ac_path != NULL)
+    {
+      entry->ac_time = now;
+      memcpy(&entry->ac_fhandle, fhandle, sizeof(struct file_handle));
+      memcpy(&entry->ac_fattr, obj_attributes, sizeof(struct nfs_fattr));
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -120,7 +221,6 @@ int nfs_request(FAR struct nfsmount *nmp, int procnum,
                 FAR void *response, size_t resplen)
 {
   FAR struct rpcclnt *clnt = nmp->nm_rpcclnt;
-  struct nfs_reply_header replyh;
   int error;
 
   error = rpcclnt_request(clnt, procnum, NFS_PROG, NFS_VER3,
@@ -156,6 +256,86 @@ int nfs_request(FAR struct nfsmount *nmp, int procnum,
         }
     }
 
+  return nfs_checkreply(response);
+}
+
+/****************************************************************************
+ * Name: nfs_sendrequest
+ *
+ * Description:
+ *   Send an NFS request without waiting for its reply, so that several
+ *   requests can be outstanding.  The replies are received with
+ *   nfs_recvreply().
+ *
+ * Returned Value:
+ *   Zero on success; a negative errno value on failure.
+ *
+ ****************************************************************************/
+
+int nfs_sendrequest(FAR struct nfsmount *nmp, int procnum,
+                    FAR void *request, size_t reqlen, FAR uint32_t *xid)
+{
+  FAR struct rpcclnt *clnt = nmp->nm_rpcclnt;
+  int error;
+
+  error = rpcclnt_sendrequest(clnt, procnum, NFS_PROG, NFS_VER3,
+                              request, reqlen, xid);
+  if (error == -ENOTCONN)
+    {
+      finfo("Reconnect\n");
+
+      error = rpcclnt_connect(clnt);
+      if (error == 0)
+        {
+          error = rpcclnt_sendrequest(clnt, procnum, NFS_PROG, NFS_VER3,
+                                      request, reqlen, xid);
+        }
+    }
+
+  return error;
+}
+
+/****************************************************************************
+ * Name: nfs_recvreply
+ *
+ * Description:
+ *   Receive the reply to any of the requests sent with nfs_sendrequest()
+ *   and return its transaction ID.  The reply is then verified with
+ *   nfs_checkreply().
+ *
+ * Returned Value:
+ *   Zero on success; a negative errno value if no reply was received.
+ *
+ ****************************************************************************/
+
+int nfs_recvreply(FAR struct nfsmount *nmp, FAR uint32_t *xid,
+                  FAR void *response, size_t resplen)
+{
+  return rpcclnt_recvreply(nmp->nm_rpcclnt, xid, response, resplen);
+}
+
+/****************************************************************************
+ * Name: nfs_checkreply
+ *
+ * Description:
+ *   Verify the RPC and the NFS level of a reply.
+ *
+ * Returned Value:
+ *   Zero on success; a negative errno value on failure.
+ *
+ ****************************************************************************/
+
+int nfs_checkreply(FAR void *response)
+{
+  struct nfs_reply_header replyh;
+  int error;
+
+  error = rpcclnt_checkreply(response);
+  if (error != 0)
+    {
+      return error;
+    }
+
   memcpy(&replyh, response, sizeof(struct nfs_reply_header));
 
   if (replyh.nfs_status != 0)
@@ -349,6 +529,18 @@ int nfs_findnode(FAR struct nfsmount *nmp, FAR const char *relpath,
       return OK;
     }
 
+#ifdef CONFIG_NFS_ATTRCACHE
+  /* Use the attribute cache, the attributes of the directory are not
+   * cached.
+   */
+
+  if (dir_attributes == NULL &&
+      nfs_attrcache_find(nmp, relpath, fhandle, obj_attributes))
+    {
+      return OK;
+    }
+#endif
+
   /* This is not the root directory. Loop until the directory entry
    * corresponding to the path is found.
    */
@@ -390,6 +582,13 @@ int nfs_findnode(FAR struct nfsmount *nmp, FAR const char *relpath,
            * dir_attributes.
            */
 
+#ifdef CONFIG_NFS_ATTRCACHE
+          if (dir_attributes == NULL && obj_attributes != NULL)
+            {
+              nfs_attrcache_add(nmp, relpath, fhandle, obj_attributes);
+            }
+#endif
+
           return OK;
         }
 
@@ -526,3 +725,28 @@ void nfs_attrupdate(FAR struct nfsnode *np, FAR struct nfs_fattr *attributes)
   fxdr_nfsv3time(&attributes->fa_mtime, &np->n_mtime);
   fxdr_nfsv3time(&attributes->fa_ctime, &np->n_ctime);
 }
+
+/****************************************************************************
+ * Name: nfs_attrcache_invalidate
+ *
+ * Description:
+ *   Drop all the entries of the attribute cache of a mount, after a file
+ *   or directory of the mount was changed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NFS_ATTRCACHE
+void nfs_attrcache_invalidate(FAR struct nfsmount *nmp)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_NFS_ATTRCACHE_NENTRIES; i++)
+    {
+      if (nmp->nm_attrcache[i].ac_path != NULL)
+        {
+          fs_heap_free(nmp->nm_attrcache[i].ac_path);
+          nmp->nm_attrcache[i].ac_path = NULL;
+        }
+    }
+}
+#endif
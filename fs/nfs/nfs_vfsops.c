@@ -136,6 +136,46 @@ static int     nfs_fileopen(FAR struct nfsmount *nmp,
                    FAR struct nfsnode *np, FAR const char *relpath,
                    int oflags, mode_t mode);
 
+static size_t  nfs_rdsize(FAR struct nfsmount *nmp);
+static size_t  nfs_wrsize(FAR struct nfsmount *nmp);
+static size_t  nfs_fmtread(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                           uint64_t offset, size_t count);
+static ssize_t nfs_parseread(FAR struct nfsnode *np, FAR void *reply,
+                             FAR uint8_t *buffer, size_t count,
+                             FAR bool *eof);
+static ssize_t nfs_fileread(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                            uint64_t offset, FAR uint8_t *buffer,
+                            size_t count, FAR bool *eof);
+static size_t  nfs_fmtwrite(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                            uint64_t offset, FAR const uint8_t *buffer,
+                            size_t count, int stable);
+static ssize_t nfs_parsewrite(FAR struct nfsnode *np, FAR void *reply,
+                              size_t count, FAR int *committed,
+                              FAR uint8_t *verf);
+static ssize_t nfs_filewrite(FAR struct nfsmount *nmp,
+                             FAR struct nfsnode *np, uint64_t offset,
+                             FAR const uint8_t *buffer, size_t count,
+                             int stable, FAR int *committed,
+                             FAR uint8_t *verf);
+#ifdef CONFIG_NFS_CACHE
+static int     nfs_cachealloc(FAR struct nfsmount *nmp,
+                              FAR struct nfsnode *np);
+static void    nfs_cachedrain(FAR struct nfsmount *nmp);
+static void    nfs_cacheverf(FAR struct nfsnode *np,
+                             FAR const uint8_t *verf);
+static int     nfs_cachefill(FAR struct nfsmount *nmp,
+                             FAR struct nfsnode *np, uint64_t offset);
+static int     nfs_cacheflush(FAR struct nfsmount *nmp,
+                              FAR struct nfsnode *np);
+static int     nfs_cachecommit(FAR struct nfsmount *nmp,
+                               FAR struct nfsnode *np);
+static ssize_t nfs_cacheread(FAR struct nfsmount *nmp,
+                             FAR struct nfsnode *np, uint64_t offset,
+                             FAR char *buffer, size_t buflen);
+static ssize_t nfs_cachewrite(FAR struct nfsmount *nmp,
+                              FAR struct nfsnode *np, uint64_t offset,
+                              FAR const char *buffer, size_t buflen);
+#endif
 static int     nfs_open(FAR struct file *filep, FAR const char *relpath,
                    int oflags, mode_t mode);
 static int     nfs_close(FAR struct file *filep);
@@ -332,6 +372,8 @@ static int nfs_filecreate(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
   *ptr++  = HTONL(NFSV3SATTRTIME_DONTCHANGE); /* Don't change mtime */
   reqlen += 2*sizeof(uint32_t);
 
+  nfs_attrcache_invalidate(nmp);
+
   /* Send the NFS request. */
 
   nfs_statistics(NFSPROC_CREATE);
@@ -499,6 +541,8 @@ static int nfs_filechstat(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
   *ptr++  = nfs_false; /* No guard value */
   reqlen += sizeof(uint32_t);
 
+  nfs_attrcache_invalidate(nmp);
+
   /* Perform the SETATTR RPC */
 
   nfs_statistics(NFSPROC_SETATTR);
@@ -525,117 +569,1029 @@ static int nfs_filechstat(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
       ptr += uint32_increment(sizeof(struct wcc_attr));
     }
 
-  /* Check if normal file attributes follow */
+  /* Check if normal file attributes follow */
+
+  if (*ptr++ != 0)
+    {
+      /* Yes.. Update the cached file status in the file structure. */
+
+      nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nfs_fileopen
+ *
+ * Description:
+ *   Open a file.  This is part of the file open logic that attempts to open
+ *   an existing file.
+ *
+ * Returned Value:
+ *   0 on success; a negative errno value on failure.
+ *
+ ****************************************************************************/
+
+static int nfs_fileopen(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                        FAR const char *relpath, int oflags, mode_t mode)
+{
+  struct file_handle fhandle;
+  struct nfs_fattr   fattr;
+  uint32_t           tmp;
+  int                ret = 0;
+
+  /* Find the NFS node associate with the path */
+
+  ret = nfs_findnode(nmp, relpath, &fhandle, &fattr, NULL);
+  if (ret != OK)
+    {
+      ferr("ERROR: nfs_findnode returned: %d\n", ret);
+      return ret;
+    }
+
+  /* Check if the object is a directory */
+
+  tmp = fxdr_unsigned(uint32_t, fattr.fa_type);
+  if (tmp == NFDIR)
+    {
+      /* Exit with EISDIR if we attempt to open a directory */
+
+      ferr("ERROR: Path is a directory\n");
+      return -EISDIR;
+    }
+
+  /* Check if the caller has sufficient privileges to open the file */
+
+  if ((oflags & O_WRONLY) != 0)
+    {
+      /* Check if anyone has privileges to write to the file -- owner,
+       * group, or other (we are probably "other" and may still not be
+       * able to write).
+       */
+
+      tmp = fxdr_unsigned(uint32_t, fattr.fa_mode);
+      if ((tmp & (NFSMODE_IWOTH | NFSMODE_IWGRP | NFSMODE_IWUSR)) == 0)
+        {
+          ferr("ERROR: File is read-only: %08" PRIx32 "\n", tmp);
+          return -EACCES;
+        }
+    }
+
+  /* It would be an ret if we are asked to create the file exclusively */
+
+  if ((oflags & (O_CREAT | O_EXCL)) == (O_CREAT | O_EXCL))
+    {
+      /* Already exists -- can't create it exclusively */
+
+      ferr("ERROR: File exists\n");
+      return -EEXIST;
+    }
+
+  /* Initialize the file private data.
+   *
+   * Copy the file handle.
+   */
+
+  np->n_fhsize      = (uint8_t)fhandle.length;
+  memcpy(&np->n_fhandle, &fhandle.handle, fhandle.length);
+
+  /* Save the file attributes */
+
+  nfs_attrupdate(np, &fattr);
+
+  /* If O_TRUNC is specified and the file is opened for writing,
+   * then truncate the file.  This operation requires that the file is
+   * writable, but we have already checked that. O_TRUNC without write
+   * access is ignored.
+   */
+
+  if ((oflags & (O_TRUNC | O_WRONLY)) == (O_TRUNC | O_WRONLY))
+    {
+      struct stat buf;
+
+      /* Truncate the file to zero length.  I think we can do this with
+       * the SETATTR call by setting the length to zero.
+       */
+
+      buf.st_size = 0;
+      return nfs_filechstat(nmp, np, &buf, CH_STAT_SIZE);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nfs_rdsize
+ *
+ * Description:
+ *   Return the largest data size of a READ request:  The reply must fit in
+ *   the I/O buffer.
+ *
+ ****************************************************************************/
+
+static size_t nfs_rdsize(FAR struct nfsmount *nmp)
+{
+  size_t readsize = nmp->nm_rsize;
+  size_t tmp;
+
+  tmp = SIZEOF_rpc_reply_read(readsize);
+  if (tmp > nmp->nm_buflen)
+    {
+      readsize -= tmp - nmp->nm_buflen;
+    }
+
+  return readsize;
+}
+
+/****************************************************************************
+ * Name: nfs_wrsize
+ *
+ * Description:
+ *   Return the largest data size of a WRITE request:  The request must fit
+ *   in the I/O buffer.
+ *
+ ****************************************************************************/
+
+static size_t nfs_wrsize(FAR struct nfsmount *nmp)
+{
+  size_t writesize = nmp->nm_wsize;
+  size_t tmp;
+
+  tmp = SIZEOF_rpc_call_write(writesize);
+  if (tmp > nmp->nm_buflen)
+    {
+      writesize -= tmp - nmp->nm_buflen;
+    }
+
+  return writesize;
+}
+
+/****************************************************************************
+ * Name: nfs_fmtread
+ *
+ * Description:
+ *   Format a READ request of 'count' bytes at 'offset' in the message
+ *   buffer.
+ *
+ * Returned Value:
+ *   The length of the request.
+ *
+ ****************************************************************************/
+
+static size_t nfs_fmtread(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                          uint64_t offset, size_t count)
+{
+  FAR uint32_t *ptr;
+  size_t reqlen;
+
+  ptr     = (FAR uint32_t *)&nmp->nm_msgbuffer.read.read;
+  reqlen  = 0;
+
+  /* Copy the variable length, file handle */
+
+  *ptr++  = txdr_unsigned((uint32_t)np->n_fhsize);
+  reqlen += sizeof(uint32_t);
+
+  memcpy(ptr, &np->n_fhandle, np->n_fhsize);
+  reqlen += uint32_alignup(np->n_fhsize);
+  ptr    += uint32_increment(np->n_fhsize);
+
+  /* Copy the file offset */
+
+  txdr_hyper(offset, ptr);
+  ptr += 2;
+  reqlen += 2*sizeof(uint32_t);
+
+  /* Set the readsize */
+
+  *ptr = txdr_unsigned(count);
+  reqlen += sizeof(uint32_t);
+
+  return reqlen;
+}
+
+/****************************************************************************
+ * Name: nfs_parseread
+ *
+ * Description:
+ *   Copy the data of the READ reply 'reply' of at most 'count' bytes to
+ *   'buffer'.
+ *
+ * Returned Value:
+ *   The number of bytes read, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static ssize_t nfs_parseread(FAR struct nfsnode *np, FAR void *reply,
+                             FAR uint8_t *buffer, size_t count,
+                             FAR bool *eof)
+{
+  FAR uint32_t *ptr;
+  uint32_t readsize;
+  uint32_t tmp;
+
+  /* Get a pointer to the beginning of the NFS response data */
+
+  ptr = (FAR uint32_t *)&((FAR struct rpc_reply_read *)reply)->read;
+
+  /* Check if attributes are included in the responses */
+
+  tmp = *ptr++;
+  if (tmp != 0)
+    {
+      /* Yes.. Update the cached file status in the file structure. */
+
+      nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
+      ptr += uint32_increment(sizeof(struct nfs_fattr));
+    }
+
+  /* This is followed by the count of data read.  Isn't this
+   * the same as the length that is included in the read data?
+   *
+   * Just skip over if for now.
+   */
+
+  ptr++;
+
+  /* Next comes an EOF indication */
+
+  *eof = *ptr++ != 0;
+
+  /* Then the length of the read data followed by the read data itself */
+
+  readsize = fxdr_unsigned(uint32_t, *ptr);
+  ptr++;
+
+  if (readsize > count)
+    {
+      return -EIO;
+    }
+
+  memcpy(buffer, ptr, readsize);
+  return readsize;
+}
+
+/****************************************************************************
+ * Name: nfs_fileread
+ *
+ * Description:
+ *   Read up to 'count' bytes at 'offset' of a file with a READ request.
+ *
+ * Returned Value:
+ *   The number of bytes read, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static ssize_t nfs_fileread(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                            uint64_t offset, FAR uint8_t *buffer,
+                            size_t count, FAR bool *eof)
+{
+  size_t reqlen;
+  int ret;
+
+  reqlen = nfs_fmtread(nmp, np, offset, count);
+
+  finfo("Reading %zu bytes\n", count);
+  nfs_statistics(NFSPROC_READ);
+  ret = nfs_request(nmp, NFSPROC_READ,
+                    &nmp->nm_msgbuffer.read, reqlen,
+                    nmp->nm_iobuffer, nmp->nm_buflen);
+  if (ret)
+    {
+      ferr("ERROR: nfs_request failed: %d\n", ret);
+      return ret;
+    }
+
+  return nfs_parseread(np, nmp->nm_iobuffer, buffer, count, eof);
+}
+
+/****************************************************************************
+ * Name: nfs_fmtwrite
+ *
+ * Description:
+ *   Format a WRITE request of the 'count' bytes of 'buffer' at 'offset' in
+ *   the I/O buffer:  Write is unique among the RPC calls in that the call
+ *   message lies in the I/O buffer.
+ *
+ * Returned Value:
+ *   The length of the request.
+ *
+ ****************************************************************************/
+
+static size_t nfs_fmtwrite(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                           uint64_t offset, FAR const uint8_t *buffer,
+                           size_t count, int stable)
+{
+  FAR uint32_t *ptr;
+  size_t reqlen;
+
+  /* Here we need an offset pointer to the write arguments, skipping over
+   * the RPC header.
+   */
+
+  ptr     = (FAR uint32_t *)&((FAR struct rpc_call_write *)
+              nmp->nm_iobuffer)->write;
+  reqlen  = 0;
+
+  /* Copy the variable length, file handle */
+
+  *ptr++  = txdr_unsigned((uint32_t)np->n_fhsize);
+  reqlen += sizeof(uint32_t);
+
+  memcpy(ptr, &np->n_fhandle, np->n_fhsize);
+  reqlen += uint32_alignup(np->n_fhsize);
+  ptr    += uint32_increment(np->n_fhsize);
+
+  /* Copy the file offset */
+
+  txdr_hyper(offset, ptr);
+  ptr    += 2;
+  reqlen += 2*sizeof(uint32_t);
+
+  /* Copy the count and stable values */
+
+  *ptr++  = txdr_unsigned(count);
+  *ptr++  = txdr_unsigned(stable);
+  reqlen += 2*sizeof(uint32_t);
+
+  /* Copy the data into the I/O buffer */
+
+  *ptr++  = txdr_unsigned(count);
+  reqlen += sizeof(uint32_t);
+  memcpy(ptr, buffer, count);
+  reqlen += uint32_alignup(count);
+
+  return reqlen;
+}
+
+/****************************************************************************
+ * Name: nfs_parsewrite
+ *
+ * Description:
+ *   Parse the reply 'reply' to a WRITE request of 'count' bytes and return
+ *   the commitment level and the verifier of the write.
+ *
+ * Returned Value:
+ *   The number of bytes written, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static ssize_t nfs_parsewrite(FAR struct nfsnode *np, FAR void *reply,
+                              size_t count, FAR int *committed,
+                              FAR uint8_t *verf)
+{
+  FAR uint32_t *ptr;
+  uint32_t tmp;
+
+  /* Get a pointer to the WRITE reply data */
+
+  ptr = (FAR uint32_t *)&((FAR struct rpc_reply_write *)reply)->write;
+
+  /* Parse file_wcc.  First, check if WCC attributes follow. */
+
+  tmp = *ptr++;
+  if (tmp != 0)
+    {
+      /* Yes.. WCC attributes follow.  But we just skip over them. */
+
+      ptr += uint32_increment(sizeof(struct wcc_attr));
+    }
+
+  /* Check if normal file attributes follow */
+
+  tmp = *ptr++;
+  if (tmp != 0)
+    {
+      /* Yes.. Update the cached file status in the file structure. */
+
+      nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
+      ptr += uint32_increment(sizeof(struct nfs_fattr));
+    }
+
+  /* Get the count of bytes actually written */
+
+  tmp = fxdr_unsigned(uint32_t, *ptr);
+  ptr++;
+
+  if (tmp < 1 || tmp > count)
+    {
+      return -EIO;
+    }
+
+  /* Then the commitment level and the verifier */
+
+  *committed = fxdr_unsigned(int, *ptr);
+  ptr++;
+
+  memcpy(verf, ptr, NFSX_V3WRITEVERF);
+  return tmp;
+}
+
+/****************************************************************************
+ * Name: nfs_filewrite
+ *
+ * Description:
+ *   Write up to 'count' bytes of 'buffer' at 'offset' of a file with a
+ *   WRITE request.
+ *
+ * Returned Value:
+ *   The number of bytes written, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static ssize_t nfs_filewrite(FAR struct nfsmount *nmp,
+                             FAR struct nfsnode *np, uint64_t offset,
+                             FAR const uint8_t *buffer, size_t count,
+                             int stable, FAR int *committed,
+                             FAR uint8_t *verf)
+{
+  size_t reqlen;
+  int ret;
+
+  reqlen = nfs_fmtwrite(nmp, np, offset, buffer, count, stable);
+
+  nfs_statistics(NFSPROC_WRITE);
+  ret = nfs_request(nmp, NFSPROC_WRITE,
+                    nmp->nm_iobuffer, reqlen,
+                    &nmp->nm_msgbuffer.write,
+                    sizeof(struct rpc_reply_write));
+  if (ret)
+    {
+      ferr("ERROR: nfs_request failed: %d\n", ret);
+      return ret;
+    }
+
+  return nfs_parsewrite(np, &nmp->nm_msgbuffer.write, count, committed,
+                        verf);
+}
+
+#ifdef CONFIG_NFS_CACHE
+/****************************************************************************
+ * Name: nfs_cachealloc
+ *
+ * Description:
+ *   Allocate the data buffer of a file on its first read or write:  It
+ *   holds CONFIG_NFS_RPC_WINDOW READ or WRITE requests.
+ *
+ ****************************************************************************/
+
+static int nfs_cachealloc(FAR struct nfsmount *nmp, FAR struct nfsnode *np)
+{
+  size_t readsize;
+  size_t writesize;
+
+  if (np->n_cbuffer == NULL)
+    {
+      readsize  = nfs_rdsize(nmp);
+      writesize = nfs_wrsize(nmp);
+
+      np->n_cbuffer = fs_heap_malloc(CONFIG_NFS_RPC_WINDOW *
+                                     (readsize > writesize ?
+                                      readsize : writesize));
+      if (np->n_cbuffer == NULL)
+        {
+          return -ENOMEM;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nfs_cachedrain
+ *
+ * Description:
+ *   Give up the replies still outstanding after an error.  The late
+ *   datagrams are discarded by their transaction ID, but a stream is
+ *   re-connected:  A late reply could be too large for the buffer of the
+ *   next request.
+ *
+ ****************************************************************************/
+
+static void nfs_cachedrain(FAR struct nfsmount *nmp)
+{
+  if (nmp->nm_rpcclnt->rc_sotype == SOCK_STREAM)
+    {
+      rpcclnt_connect(nmp->nm_rpcclnt);
+    }
+}
+
+/****************************************************************************
+ * Name: nfs_cacheverf
+ *
+ * Description:
+ *   Record the verifier of an unstable write.  A new verifier means that
+ *   the server restarted and may have lost the earlier unstable writes.
+ *
+ ****************************************************************************/
+
+static void nfs_cacheverf(FAR struct nfsnode *np, FAR const uint8_t *verf)
+{
+  if ((np->n_cflags & NFSNODE_VERF) == 0)
+    {
+      memcpy(np->n_verf, verf, NFSX_V3WRITEVERF);
+      np->n_cflags |= NFSNODE_VERF;
+    }
+  else if (memcmp(np->n_verf, verf, NFSX_V3WRITEVERF) != 0)
+    {
+      memcpy(np->n_verf, verf, NFSX_V3WRITEVERF);
+      np->n_cflags |= NFSNODE_LOST;
+    }
+
+  np->n_cflags |= NFSNODE_UNCOMMITTED;
+}
+
+/****************************************************************************
+ * Name: nfs_cachefill
+ *
+ * Description:
+ *   Read the data of a file at 'offset' into its buffer.  A sequential read
+ *   reads ahead the whole buffer, with all the READ requests outstanding at
+ *   once, other reads read a single request.  The data is kept up to the
+ *   first request that failed or was short;  If the first one failed, the
+ *   data is read again with a single, re-sent request.
+ *
+ ****************************************************************************/
+
+static int nfs_cachefill(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                         uint64_t offset)
+{
+  ssize_t nread[CONFIG_NFS_RPC_WINDOW];
+  size_t count[CONFIG_NFS_RPC_WINDOW];
+  size_t readsize = nfs_rdsize(nmp);
+  uint64_t remaining;
+  uint32_t first = 0;
+  uint32_t xid;
+  size_t reqlen;
+  bool eof;
+  int nreqs;
+  int pending;
+  int ret;
+  int i;
+
+  ret = nfs_cachealloc(nmp, np);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  nreqs = offset == np->n_cnext ? CONFIG_NFS_RPC_WINDOW : 1;
+  remaining = np->n_size - offset;
+  if (remaining < nreqs * readsize)
+    {
+      nreqs = (remaining + readsize - 1) / readsize;
+    }
+
+  np->n_coffset = offset;
+  np->n_clen    = 0;
+
+  /* Send all the requests */
+
+  for (i = 0; i < nreqs; i++)
+    {
+      count[i] = remaining - i * readsize;
+      if (count[i] > readsize)
+        {
+          count[i] = readsize;
+        }
+
+      reqlen = nfs_fmtread(nmp, np, offset + i * readsize, count[i]);
+
+      nfs_statistics(NFSPROC_READ);
+      ret = nfs_sendrequest(nmp, NFSPROC_READ, &nmp->nm_msgbuffer.read,
+                            reqlen, &xid);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      if (i == 0)
+        {
+          first = xid;
+        }
+
+      nread[i] = -EINPROGRESS;
+    }
+
+  /* Then receive the replies, in any order */
+
+  nreqs   = i;
+  pending = i;
+
+  while (pending > 0)
+    {
+      ret = nfs_recvreply(nmp, &xid, nmp->nm_iobuffer, nmp->nm_buflen);
+      if (ret < 0)
+        {
+          nfs_cachedrain(nmp);
+          break;
+        }
+
+      /* Skip the late replies to older requests */
+
+      i = xid - first;
+      if ((uint32_t)(xid - first) >= (uint32_t)nreqs ||
+          nread[i] != -EINPROGRESS)
+        {
+          continue;
+        }
+
+      pending--;
+
+      ret = nfs_checkreply(nmp->nm_iobuffer);
+      if (ret >= 0)
+        {
+          ret = nfs_parseread(np, nmp->nm_iobuffer,
+                              np->n_cbuffer + i * readsize, count[i], &eof);
+        }
+
+      nread[i] = ret;
+    }
+
+  for (i = 0; i < nreqs && nread[i] >= 0; i++)
+    {
+      np->n_clen += nread[i];
+      if (nread[i] < (ssize_t)count[i])
+        {
+          break;
+        }
+    }
+
+  if (np->n_clen == 0 && remaining > 0)
+    {
+      ret = nfs_fileread(nmp, np, offset, np->n_cbuffer,
+                         remaining < readsize ? remaining : readsize, &eof);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      np->n_clen = ret;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nfs_cacheflush
+ *
+ * Description:
+ *   Write the data buffered by the writes of a file, with all the WRITE
+ *   requests outstanding at once.  The requests are UNSTABLE:  The data is
+ *   committed by nfs_cachecommit().  What could not be written that way is
+ *   written again with FILE_SYNC requests.
+ *
+ ****************************************************************************/
+
+static int nfs_cacheflush(FAR struct nfsmount *nmp, FAR struct nfsnode *np)
+{
+  ssize_t nwritten[CONFIG_NFS_RPC_WINDOW];
+  size_t count[CONFIG_NFS_RPC_WINDOW];
+  uint8_t verf[NFSX_V3WRITEVERF];
+  size_t writesize = nfs_wrsize(nmp);
+  uint64_t size = np->n_size;
+  uint32_t first = 0;
+  uint32_t xid;
+  size_t reqlen;
+  size_t done;
+  int committed;
+  int nreqs;
+  int nsent;
+  int pending;
+  int ret;
+  int i;
+
+  if ((np->n_cflags & NFSNODE_DIRTY) == 0)
+    {
+      return OK;
+    }
+
+  nfs_attrcache_invalidate(nmp);
+
+  /* Send all the requests */
+
+  nreqs = (np->n_clen + writesize - 1) / writesize;
+  for (i = 0; i < nreqs; i++)
+    {
+      count[i] = np->n_clen - i * writesize;
+      if (count[i] > writesize)
+        {
+          count[i] = writesize;
+        }
+
+      nwritten[i] = -EINPROGRESS;
+    }
+
+  for (nsent = 0; nsent < nreqs; nsent++)
+    {
+      reqlen = nfs_fmtwrite(nmp, np, np->n_coffset + nsent * writesize,
+                            np->n_cbuffer + nsent * writesize, count[nsent],
+                            NFSV3WRITE_UNSTABLE);
+
+      nfs_statistics(NFSPROC_WRITE);
+      ret = nfs_sendrequest(nmp, NFSPROC_WRITE, nmp->nm_iobuffer, reqlen,
+                            &xid);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      if (nsent == 0)
+        {
+          first = xid;
+        }
+    }
+
+  /* Then receive the replies, in any order */
+
+  pending = nsent;
+  while (pending > 0)
+    {
+      ret = nfs_recvreply(nmp, &xid, nmp->nm_iobuffer, nmp->nm_buflen);
+      if (ret < 0)
+        {
+          nfs_cachedrain(nmp);
+          break;
+        }
+
+      /* Skip the late replies to older requests */
+
+      i = xid - first;
+      if ((uint32_t)(xid - first) >= (uint32_t)nsent ||
+          nwritten[i] != -EINPROGRESS)
+        {
+          continue;
+        }
+
+      pending--;
+
+      ret = nfs_checkreply(nmp->nm_iobuffer);
+      if (ret >= 0)
+        {
+          ret = nfs_parsewrite(np, nmp->nm_iobuffer, count[i], &committed,
+                               verf);
+        }
+
+      if (ret >= 0 && committed != NFSV3WRITE_FILESYNC)
+        {
+          nfs_cacheverf(np, verf);
+        }
+
+      nwritten[i] = ret;
+    }
+
+  /* Write again what could not be written */
+
+  for (i = 0; i < nreqs; i++)
+    {
+      while (nwritten[i] < (ssize_t)count[i])
+        {
+          done = nwritten[i] > 0 ? nwritten[i] : 0;
+          ret  = nfs_filewrite(nmp, np,
+                               np->n_coffset + i * writesize + done,
+                               np->n_cbuffer + i * writesize + done,
+                               count[i] - done, NFSV3WRITE_FILESYNC,
+                               &committed, verf);
+          if (ret < 0)
+            {
+              np->n_size = size;
+              return ret;
+            }
+
+          nwritten[i] = done + ret;
+        }
+    }
+
+  /* The size in the replies may be older than the last write */
+
+  if (np->n_size < size)
+    {
+      np->n_size = size;
+    }
+
+  np->n_cflags &= ~NFSNODE_DIRTY;
+  np->n_clen    = 0;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nfs_cachecommit
+ *
+ * Description:
+ *   Write the buffered data of a file, then commit its unstable writes to
+ *   the storage of the server.
+ *
+ * Returned Value:
+ *   0 on success; a negated errno value on failure.  -EIO is returned if
+ *   the server restarted and may have lost unstable writes.
+ *
+ ****************************************************************************/
+
+static int nfs_cachecommit(FAR struct nfsmount *nmp, FAR struct nfsnode *np)
+{
+  FAR uint32_t *ptr;
+  size_t reqlen;
+  uint32_t tmp;
+  int ret;
+
+  ret = nfs_cacheflush(nmp, np);
+  if (ret < 0 || (np->n_cflags & NFSNODE_UNCOMMITTED) == 0)
+    {
+      return ret;
+    }
+
+  ptr     = (FAR uint32_t *)&nmp->nm_msgbuffer.commit.commit;
+  reqlen  = 0;
+
+  /* Copy the variable length, file handle */
+
+  *ptr++  = txdr_unsigned((uint32_t)np->n_fhsize);
+  reqlen += sizeof(uint32_t);
+
+  memcpy(ptr, &np->n_fhandle, np->n_fhsize);
+  reqlen += uint32_alignup(np->n_fhsize);
+  ptr    += uint32_increment(np->n_fhsize);
+
+  /* Commit the whole file: A zero offset and count */
+
+  txdr_hyper((uint64_t)0, ptr);
+  ptr    += 2;
+  reqlen += 2*sizeof(uint32_t);
+
+  *ptr    = 0;
+  reqlen += sizeof(uint32_t);
+
+  nfs_statistics(NFSPROC_COMMIT);
+  ret = nfs_request(nmp, NFSPROC_COMMIT,
+                    &nmp->nm_msgbuffer.commit, reqlen,
+                    nmp->nm_iobuffer, nmp->nm_buflen);
+  if (ret)
+    {
+      ferr("ERROR: nfs_request failed: %d\n", ret);
+      return ret;
+    }
+
+  /* Parse file_wcc, then check the verifier */
+
+  ptr = (FAR uint32_t *)
+    &((FAR struct rpc_reply_commit *)nmp->nm_iobuffer)->commit;
+
+  tmp = *ptr++;
+  if (tmp != 0)
+    {
+      ptr += uint32_increment(sizeof(struct wcc_attr));
+    }
+
+  tmp = *ptr++;
+  if (tmp != 0)
+    {
+      nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
+      ptr += uint32_increment(sizeof(struct nfs_fattr));
+    }
+
+  if ((np->n_cflags & NFSNODE_LOST) != 0 ||
+      memcmp(ptr, np->n_verf, NFSX_V3WRITEVERF) != 0)
+    {
+      ferr("ERROR: The server lost unstable writes\n");
+      ret = -EIO;
+    }
+
+  np->n_cflags &= ~(NFSNODE_UNCOMMITTED | NFSNODE_VERF | NFSNODE_LOST);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nfs_cacheread
+ *
+ * Description:
+ *   Read from a file through its buffer.  'buflen' does not go beyond the
+ *   end of the file.
+ *
+ * Returned Value:
+ *   The number of bytes read, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static ssize_t nfs_cacheread(FAR struct nfsmount *nmp,
+                             FAR struct nfsnode *np, uint64_t offset,
+                             FAR char *buffer, size_t buflen)
+{
+  ssize_t nread = 0;
+  size_t nbytes;
+  int ret;
+
+  ret = nfs_cacheflush(nmp, np);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  while (buflen > 0)
+    {
+      if (offset < np->n_coffset || offset >= np->n_coffset + np->n_clen)
+        {
+          ret = nfs_cachefill(nmp, np, offset);
+          if (ret < 0)
+            {
+              return nread > 0 ? nread : ret;
+            }
+          else if (np->n_clen == 0)
+            {
+              break;
+            }
+        }
+
+      nbytes = np->n_coffset + np->n_clen - offset;
+      if (nbytes > buflen)
+        {
+          nbytes = buflen;
+        }
 
-  if (*ptr++ != 0)
-    {
-      /* Yes.. Update the cached file status in the file structure. */
+      memcpy(buffer, np->n_cbuffer + (offset - np->n_coffset), nbytes);
 
-      nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
+      offset      += nbytes;
+      buffer      += nbytes;
+      buflen      -= nbytes;
+      nread       += nbytes;
+      np->n_cnext  = offset;
     }
 
-  return OK;
+  return nread;
 }
 
 /****************************************************************************
- * Name: nfs_fileopen
+ * Name: nfs_cachewrite
  *
  * Description:
- *   Open a file.  This is part of the file open logic that attempts to open
- *   an existing file.
+ *   Write to a file through its buffer:  The contiguous writes are buffered
+ *   until the buffer is full, the data is then written by
+ *   nfs_cacheflush().
  *
  * Returned Value:
- *   0 on success; a negative errno value on failure.
+ *   The number of bytes written, a negated errno value on failure.
  *
  ****************************************************************************/
 
-static int nfs_fileopen(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
-                        FAR const char *relpath, int oflags, mode_t mode)
+static ssize_t nfs_cachewrite(FAR struct nfsmount *nmp,
+                              FAR struct nfsnode *np, uint64_t offset,
+                              FAR const char *buffer, size_t buflen)
 {
-  struct file_handle fhandle;
-  struct nfs_fattr   fattr;
-  uint32_t           tmp;
-  int                ret = 0;
-
-  /* Find the NFS node associate with the path */
+  size_t size = CONFIG_NFS_RPC_WINDOW * nfs_wrsize(nmp);
+  ssize_t nwritten = 0;
+  size_t nbytes;
+  int ret;
 
-  ret = nfs_findnode(nmp, relpath, &fhandle, &fattr, NULL);
-  if (ret != OK)
+  ret = nfs_cachealloc(nmp, np);
+  if (ret < 0)
     {
-      ferr("ERROR: nfs_findnode returned: %d\n", ret);
       return ret;
     }
 
-  /* Check if the object is a directory */
-
-  tmp = fxdr_unsigned(uint32_t, fattr.fa_type);
-  if (tmp == NFDIR)
-    {
-      /* Exit with EISDIR if we attempt to open a directory */
-
-      ferr("ERROR: Path is a directory\n");
-      return -EISDIR;
-    }
-
-  /* Check if the caller has sufficient privileges to open the file */
-
-  if ((oflags & O_WRONLY) != 0)
+  while (buflen > 0)
     {
-      /* Check if anyone has privileges to write to the file -- owner,
-       * group, or other (we are probably "other" and may still not be
-       * able to write).
-       */
-
-      tmp = fxdr_unsigned(uint32_t, fattr.fa_mode);
-      if ((tmp & (NFSMODE_IWOTH | NFSMODE_IWGRP | NFSMODE_IWUSR)) == 0)
+      if ((np->n_cflags & NFSNODE_DIRTY) != 0 &&
+          (offset != np->n_coffset + np->n_clen || np->n_clen >= size))
         {
-          ferr("ERROR: File is read-only: %08" PRIx32 "\n", tmp);
-          return -EACCES;
+          ret = nfs_cacheflush(nmp, np);
+          if (ret < 0)
+            {
+              return nwritten > 0 ? nwritten : ret;
+            }
         }
-    }
-
-  /* It would be an ret if we are asked to create the file exclusively */
-
-  if ((oflags & (O_CREAT | O_EXCL)) == (O_CREAT | O_EXCL))
-    {
-      /* Already exists -- can't create it exclusively */
-
-      ferr("ERROR: File exists\n");
-      return -EEXIST;
-    }
-
-  /* Initialize the file private data.
-   *
-   * Copy the file handle.
-   */
 
-  np->n_fhsize      = (uint8_t)fhandle.length;
-  memcpy(&np->n_fhandle, &fhandle.handle, fhandle.length);
-
-  /* Save the file attributes */
+      /* Drop the data read ahead */
 
-  nfs_attrupdate(np, &fattr);
+      if ((np->n_cflags & NFSNODE_DIRTY) == 0)
+        {
+          np->n_coffset = offset;
+          np->n_clen    = 0;
+          np->n_cflags |= NFSNODE_DIRTY;
+        }
 
-  /* If O_TRUNC is specified and the file is opened for writing,
-   * then truncate the file.  This operation requires that the file is
-   * writable, but we have already checked that. O_TRUNC without write
-   * access is ignored.
-   */
+      nbytes = size - np->n_clen;
+      if (nbytes > buflen)
+        {
+          nbytes = buflen;
+        }
 
-  if ((oflags & (O_TRUNC | O_WRONLY)) == (O_TRUNC | O_WRONLY))
-    {
-      struct stat buf;
+      memcpy(np->n_cbuffer + np->n_clen, buffer, nbytes);
 
-      /* Truncate the file to zero length.  I think we can do this with
-       * the SETATTR call by setting the length to zero.
-       */
+      np->n_clen += nbytes;
+      offset     += nbytes;
+      buffer     += nbytes;
+      buflen     -= nbytes;
+      nwritten   += nbytes;
 
-      buf.st_size = 0;
-      return nfs_filechstat(nmp, np, &buf, CH_STAT_SIZE);
+      if (np->n_size < offset)
+        {
+          np->n_size = offset;
+        }
     }
 
-  return OK;
+  return nwritten;
 }
+#endif /* CONFIG_NFS_CACHE */
 
 /****************************************************************************
  * Name: nfs_open
@@ -779,6 +1735,7 @@ static int nfs_close(FAR struct file *filep)
   FAR struct nfsnode  *np;
   FAR struct nfsnode  *prev;
   FAR struct nfsnode  *curr;
+  int commit = OK;
   int ret;
 
   /* Sanity checks */
@@ -819,6 +1776,12 @@ static int nfs_close(FAR struct file *filep)
 
   else
     {
+#ifdef CONFIG_NFS_CACHE
+      /* Write the buffered data and commit the unstable writes */
+
+      commit = nfs_cachecommit(nmp, np);
+#endif
+
       /* Assume file structure won't be found. This should never happen. */
 
       ret = -EINVAL;
@@ -848,8 +1811,11 @@ static int nfs_close(FAR struct file *filep)
 
               /* Then deallocate the file structure and return success */
 
+#ifdef CONFIG_NFS_CACHE
+              fs_heap_free(np->n_cbuffer);
+#endif
               fs_heap_free(np);
-              ret = OK;
+              ret = commit;
               break;
             }
         }
@@ -874,11 +1840,14 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
 {
   FAR struct nfsmount       *nmp;
   FAR struct nfsnode        *np;
+#ifndef CONFIG_NFS_CACHE
   ssize_t                    readsize;
+#endif
   ssize_t                    tmp;
   ssize_t                    bytesread;
-  size_t                     reqlen;
-  FAR uint32_t              *ptr;
+#ifndef CONFIG_NFS_CACHE
+  bool                       eof;
+#endif
   int                        ret = 0;
 
   finfo("Read %zu bytes from offset %jd\n",
@@ -912,6 +1881,18 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
       finfo("Read size truncated to %zu\n", buflen);
     }
 
+#ifdef CONFIG_NFS_CACHE
+  bytesread = nfs_cacheread(nmp, np, filep->f_pos, buffer, buflen);
+  if (bytesread < 0)
+    {
+      ret       = bytesread;
+      bytesread = 0;
+    }
+  else
+    {
+      filep->f_pos += bytesread;
+    }
+#else
   /* Now loop until we fill the user buffer (or hit the end of the file) */
 
   for (bytesread = 0; bytesread < buflen; )
@@ -921,98 +1902,21 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
        */
 
       readsize = buflen - bytesread;
-      if (readsize > nmp->nm_rsize)
+      if (readsize > nfs_rdsize(nmp))
         {
-          readsize = nmp->nm_rsize;
+          readsize = nfs_rdsize(nmp);
         }
 
-      /* Make sure that the attempted read size does not exceed the IO buffer
-       * size
-       */
-
-      tmp = SIZEOF_rpc_reply_read(readsize);
-      if (tmp > nmp->nm_buflen)
-        {
-          readsize -= (tmp - nmp->nm_buflen);
-        }
-
-      /* Initialize the request */
-
-      ptr     = (FAR uint32_t *)&nmp->nm_msgbuffer.read.read;
-      reqlen  = 0;
-
-      /* Copy the variable length, file handle */
-
-      *ptr++  = txdr_unsigned((uint32_t)np->n_fhsize);
-      reqlen += sizeof(uint32_t);
-
-      memcpy(ptr, &np->n_fhandle, np->n_fhsize);
-      reqlen += uint32_alignup(np->n_fhsize);
-      ptr    += uint32_increment(np->n_fhsize);
-
-      /* Copy the file offset */
-
-      txdr_hyper((uint64_t)filep->f_pos, ptr);
-      ptr += 2;
-      reqlen += 2*sizeof(uint32_t);
-
-      /* Set the readsize */
-
-      *ptr = txdr_unsigned(readsize);
-      reqlen += sizeof(uint32_t);
-
       /* Perform the read */
 
-      finfo("Reading %zu bytes\n", readsize);
-      nfs_statistics(NFSPROC_READ);
-      ret = nfs_request(nmp, NFSPROC_READ,
-                        &nmp->nm_msgbuffer.read, reqlen,
-                        nmp->nm_iobuffer, nmp->nm_buflen);
-      if (ret)
+      readsize = nfs_fileread(nmp, np, filep->f_pos, (FAR uint8_t *)buffer,
+                              readsize, &eof);
+      if (readsize < 0)
         {
-          ferr("ERROR: nfs_request failed: %d\n", ret);
+          ret = readsize;
           goto errout_with_lock;
         }
 
-      /* The read was successful.  Get a pointer to the beginning of the NFS
-       * response data.
-       */
-
-      ptr = (FAR uint32_t *)
-        &((FAR struct rpc_reply_read *)nmp->nm_iobuffer)->read;
-
-      /* Check if attributes are included in the responses */
-
-      tmp = *ptr++;
-      if (tmp != 0)
-        {
-          /* Yes.. Update the cached file status in the file structure. */
-
-          nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
-          ptr += uint32_increment(sizeof(struct nfs_fattr));
-        }
-
-      /* This is followed by the count of data read.  Isn't this
-       * the same as the length that is included in the read data?
-       *
-       * Just skip over if for now.
-       */
-
-      ptr++;
-
-      /* Next comes an EOF indication.  Save that in tmp for now. */
-
-      tmp = *ptr++;
-
-      /* Then the length of the read data followed by the read data itself */
-
-      readsize = fxdr_unsigned(uint32_t, *ptr);
-      ptr++;
-
-      /* Copy the read data into the user buffer */
-
-      memcpy(buffer, ptr, readsize);
-
       /* Update the read state data */
 
       filep->f_pos += readsize;
@@ -1021,13 +1925,14 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
 
       /* Check if we hit the end of file */
 
-      if (tmp != 0)
+      if (eof || readsize == 0)
         {
           break;
         }
     }
 
 errout_with_lock:
+#endif
   nxmutex_unlock(&nmp->nm_lock);
   return bytesread > 0 ? bytesread : ret;
 }
@@ -1046,14 +1951,12 @@ static ssize_t nfs_write(FAR struct file *filep, FAR const char *buffer,
 {
   FAR struct nfsmount *nmp;
   FAR struct nfsnode  *np;
+#ifndef CONFIG_NFS_CACHE
   ssize_t              writesize;
-  ssize_t              bufsize;
+  uint8_t              verf[NFSX_V3WRITEVERF];
+  int                  committed;
+#endif
   ssize_t              byteswritten = 0;
-  size_t               reqlen;
-  FAR uint32_t        *ptr;
-  uint32_t             tmp;
-  int                  commit = 0;
-  int                  committed = NFSV3WRITE_FILESYNC;
   int                  ret;
 
   finfo("Write %zu bytes to offset %jd\n",
@@ -1084,6 +1987,24 @@ static ssize_t nfs_write(FAR struct file *filep, FAR const char *buffer,
       goto errout_with_lock;
     }
 
+#ifdef CONFIG_NFS_CACHE
+  /* Buffer the data, it is written by a later write, read, fsync() or
+   * close().
+   */
+
+  byteswritten = nfs_cachewrite(nmp, np, filep->f_pos, buffer, buflen);
+  if (byteswritten < 0)
+    {
+      ret          = byteswritten;
+      byteswritten = 0;
+    }
+  else
+    {
+      filep->f_pos += byteswritten;
+    }
+#else
+  nfs_attrcache_invalidate(nmp);
+
   /* Now loop until we send the entire user buffer */
 
   for (byteswritten = 0; byteswritten < buflen; )
@@ -1093,128 +2014,29 @@ static ssize_t nfs_write(FAR struct file *filep, FAR const char *buffer,
        */
 
       writesize = buflen - byteswritten;
-      if (writesize > nmp->nm_wsize)
-        {
-          writesize = nmp->nm_wsize;
-        }
-
-      /* Make sure that the attempted read size does not exceed the IO
-       * buffer size.
-       */
-
-      bufsize = SIZEOF_rpc_call_write(writesize);
-      if (bufsize > nmp->nm_buflen)
+      if (writesize > nfs_wrsize(nmp))
         {
-          writesize -= (bufsize - nmp->nm_buflen);
+          writesize = nfs_wrsize(nmp);
         }
 
-      /* Initialize the request.  Here we need an offset pointer to the write
-       * arguments, skipping over the RPC header.  Write is unique among the
-       * RPC calls in that the entry RPC calls message lies in the I/O buffer
-       */
-
-      ptr     = (FAR uint32_t *)&((FAR struct rpc_call_write *)
-                  nmp->nm_iobuffer)->write;
-      reqlen  = 0;
-
-      /* Copy the variable length, file handle */
-
-      *ptr++  = txdr_unsigned((uint32_t)np->n_fhsize);
-      reqlen += sizeof(uint32_t);
-
-      memcpy(ptr, &np->n_fhandle, np->n_fhsize);
-      reqlen += uint32_alignup(np->n_fhsize);
-      ptr    += uint32_increment(np->n_fhsize);
-
-      /* Copy the file offset */
-
-      txdr_hyper((uint64_t)filep->f_pos, ptr);
-      ptr    += 2;
-      reqlen += 2*sizeof(uint32_t);
-
-      /* Copy the count and stable values */
-
-      *ptr++  = txdr_unsigned(writesize);
-      *ptr++  = txdr_unsigned(committed);
-      reqlen += 2*sizeof(uint32_t);
-
-      /* Copy a chunk of the user data into the I/O buffer */
-
-      *ptr++  = txdr_unsigned(writesize);
-      reqlen += sizeof(uint32_t);
-      memcpy(ptr, buffer, writesize);
-      reqlen += uint32_alignup(writesize);
-
       /* Perform the write */
 
-      nfs_statistics(NFSPROC_WRITE);
-      ret = nfs_request(nmp, NFSPROC_WRITE,
-                        nmp->nm_iobuffer, reqlen,
-                        &nmp->nm_msgbuffer.write,
-                        sizeof(struct rpc_reply_write));
-      if (ret)
-        {
-          ferr("ERROR: nfs_request failed: %d\n", ret);
-          goto errout_with_lock;
-        }
-
-      /* Get a pointer to the WRITE reply data */
-
-      ptr = (FAR uint32_t *)&nmp->nm_msgbuffer.write.write;
-
-      /* Parse file_wcc.  First, check if WCC attributes follow. */
-
-      tmp = *ptr++;
-      if (tmp != 0)
-        {
-          /* Yes.. WCC attributes follow.  But we just skip over them. */
-
-          ptr += uint32_increment(sizeof(struct wcc_attr));
-        }
-
-      /* Check if normal file attributes follow */
-
-      tmp = *ptr++;
-      if (tmp != 0)
-        {
-          /* Yes.. Update the cached file status in the file structure. */
-
-          nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
-          ptr += uint32_increment(sizeof(struct nfs_fattr));
-        }
-
-      /* Get the count of bytes actually written */
-
-      tmp = fxdr_unsigned(uint32_t, *ptr);
-      ptr++;
-
-      if (tmp < 1 || tmp > writesize)
+      writesize = nfs_filewrite(nmp, np, filep->f_pos,
+                                (FAR const uint8_t *)buffer, writesize,
+                                NFSV3WRITE_FILESYNC, &committed, verf);
+      if (writesize < 0)
         {
-          ret = -EIO;
+          ret = writesize;
           goto errout_with_lock;
         }
 
-      writesize = tmp;
-
-      /* Determine the lowest commitment level obtained by any of the RPCs. */
-
-      commit = *ptr++;
-      if (committed == NFSV3WRITE_FILESYNC)
-        {
-          committed = commit;
-        }
-      else if (committed == NFSV3WRITE_DATASYNC &&
-               commit == NFSV3WRITE_UNSTABLE)
-        {
-          committed = commit;
-        }
-
-      /* Update the read state data */
+      /* Update the write state data */
 
       filep->f_pos += writesize;
       byteswritten += writesize;
       buffer       += writesize;
     }
+#endif
 
 errout_with_lock:
   nxmutex_unlock(&nmp->nm_lock);
@@ -1296,7 +2118,35 @@ static off_t nfs_seek(FAR struct file *filep, off_t offset, int whence)
 
 static int nfs_sync(FAR struct file *filep)
 {
+#ifdef CONFIG_NFS_CACHE
+  FAR struct nfsmount *nmp;
+  FAR struct nfsnode  *np;
+  int                  ret;
+
+  DEBUGASSERT(filep->f_priv != NULL);
+
+  /* Recover our private data from the struct file instance */
+
+  nmp = filep->f_inode->i_private;
+  np  = (FAR struct nfsnode *)filep->f_priv;
+
+  DEBUGASSERT(nmp != NULL);
+
+  ret = nxmutex_lock(&nmp->nm_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Write the buffered data and commit the unstable writes */
+
+  ret = nfs_cachecommit(nmp, np);
+
+  nxmutex_unlock(&nmp->nm_lock);
+  return ret;
+#else
   return 0;
+#endif
 }
 
 /****************************************************************************
@@ -1429,6 +2279,21 @@ static int nfs_fchstat(FAR const struct file *filep,
       return ret;
     }
 
+#ifdef CONFIG_NFS_CACHE
+  /* Write the buffered data first, it would change the size and the time
+   * again, and drop what was read ahead.
+   */
+
+  ret = nfs_cacheflush(nmp, np);
+  if (ret < 0)
+    {
+      nxmutex_unlock(&nmp->nm_lock);
+      return ret;
+    }
+
+  np->n_clen = 0;
+#endif
+
   /* Change the file mode, owner, group and time. */
 
   ret = nfs_filechstat(nmp, np, buf, flags);
@@ -1467,6 +2332,19 @@ static int nfs_truncate(FAR struct file *filep, off_t length)
     {
       struct stat buf;
 
+#ifdef CONFIG_NFS_CACHE
+      /* Write the buffered data and drop what was read ahead */
+
+      ret = nfs_cacheflush(nmp, np);
+      if (ret < 0)
+        {
+          nxmutex_unlock(&nmp->nm_lock);
+          return ret;
+        }
+
+      np->n_clen = 0;
+#endif
+
       /* Then perform the SETATTR RPC to set the new file size */
 
       buf.st_size = length;
@@ -2243,6 +3121,7 @@ static int nfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
 
   /* And free any allocated resources */
 
+  nfs_attrcache_invalidate(nmp);
   nxmutex_destroy(&nmp->nm_lock);
   fs_heap_free(nmp->nm_rpcclnt);
   fs_heap_free(nmp);
@@ -2503,6 +3382,8 @@ static int nfs_remove(FAR struct inode *mountpt, FAR const char *relpath)
   memcpy(ptr, filename, namelen);
   reqlen += uint32_alignup(namelen);
 
+  nfs_attrcache_invalidate(nmp);
+
   /* Perform the REMOVE RPC call */
 
   nfs_statistics(NFSPROC_REMOVE);
@@ -2626,6 +3507,8 @@ static int nfs_mkdir(FAR struct inode *mountpt, FAR const char *relpath,
   *ptr++  = HTONL(NFSV3SATTRTIME_DONTCHANGE); /* Don't change mtime */
   reqlen += 2*sizeof(uint32_t);
 
+  nfs_attrcache_invalidate(nmp);
+
   /* Perform the MKDIR RPC */
 
   nfs_statistics(NFSPROC_MKDIR);
@@ -2713,6 +3596,8 @@ static int nfs_rmdir(FAR struct inode *mountpt, FAR const char *relpath)
   memcpy(ptr, dirname, namelen);
   reqlen += uint32_alignup(namelen);
 
+  nfs_attrcache_invalidate(nmp);
+
   /* Perform the RMDIR RPC */
 
   nfs_statistics(NFSPROC_RMDIR);
@@ -2826,6 +3711,8 @@ static int nfs_rename(FAR struct inode *mountpt, FAR const char *oldrelpath,
   memcpy(ptr, to_name, namelen);
   reqlen += uint32_alignup(namelen);
 
+  nfs_attrcache_invalidate(nmp);
+
   /* Perform the RENAME RPC */
 
   nfs_statistics(NFSPROC_RENAME);
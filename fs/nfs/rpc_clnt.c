@@ -763,8 +763,6 @@ int rpcclnt_request(FAR struct rpcclnt *rpc, int procnum, int prog,
                     int version, FAR void *request, size_t reqlen,
                     FAR void *response, size_t resplen)
 {
-  FAR struct rpc_reply_header *replymsg;
-  uint32_t tmp;
   uint32_t xid;
   int retries = 0;
   int error = 0;
@@ -840,6 +838,86 @@ int rpcclnt_request(FAR struct rpcclnt *rpc, int procnum, int prog,
 
   /* Break down the RPC header and check if it is OK */
 
+  return rpcclnt_checkreply(response);
+}
+
+/****************************************************************************
+ * Name: rpcclnt_sendrequest
+ *
+ * Description:
+ *   Format and send an RPC CALL message without waiting for the reply, so
+ *   that several calls can be outstanding.  The reply is received with
+ *   rpcclnt_recvreply(), the message buffer can be reused at once.  The
+ *   call is not re-sent on timeouts.
+ *
+ ****************************************************************************/
+
+int rpcclnt_sendrequest(FAR struct rpcclnt *rpc, int procnum, int prog,
+                        int version, FAR void *request, size_t reqlen,
+                        FAR uint32_t *xid)
+{
+  *xid = ++rpc->rc_xid;
+
+  rpcclnt_fmtheader((FAR struct rpc_call_header *)request,
+                    *xid, prog, version, procnum);
+
+  rpc_statistics(rpcrequests);
+  return rpcclnt_send(rpc, request, reqlen + sizeof(struct rpc_call_header));
+}
+
+/****************************************************************************
+ * Name: rpcclnt_recvreply
+ *
+ * Description:
+ *   Receive the next RPC reply, of any of the calls sent with
+ *   rpcclnt_sendrequest(), and return its transaction in '*xid'.  The
+ *   caller checks the reply with rpcclnt_checkreply() once it knows the
+ *   call, a reply to an older call may still arrive.
+ *
+ ****************************************************************************/
+
+int rpcclnt_recvreply(FAR struct rpcclnt *rpc, FAR uint32_t *xid,
+                      FAR void *response, size_t resplen)
+{
+  FAR struct rpc_reply_header *replyheader;
+  int error;
+
+  error = rpcclnt_receive(rpc, response, resplen);
+  if (error != OK)
+    {
+      if (error == -EAGAIN || error == -ETIMEDOUT)
+        {
+          rpc_statistics(rpctimeouts);
+        }
+
+      return error;
+    }
+
+  replyheader = (FAR struct rpc_reply_header *)response;
+  if (replyheader->rp_direction != rpc_reply)
+    {
+      ferr("ERROR: Different RPC REPLY returned\n");
+      rpc_statistics(rpcinvalid);
+      return -EPROTO;
+    }
+
+  *xid = fxdr_unsigned(uint32_t, replyheader->rp_xid);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rpcclnt_checkreply
+ *
+ * Description:
+ *   Verify the RPC level of a reply received with rpcclnt_recvreply().
+ *
+ ****************************************************************************/
+
+int rpcclnt_checkreply(FAR void *response)
+{
+  FAR struct rpc_reply_header *replymsg;
+  uint32_t tmp;
+
   replymsg = (FAR struct rpc_reply_header *)response;
 
   tmp = fxdr_unsigned(uint32_t, replymsg->type);
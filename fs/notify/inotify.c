@@ -37,9 +37,11 @@
 #include <poll.h>
 #include <string.h>
 #include <search.h>
+#include <strings.h>
 #include <libgen.h>
 
 #include "inode/inode.h"
+#include "notify/notify.h"
 #include "sched/sched.h"
 #include "fs_heap.h"
 
@@ -49,6 +51,10 @@
 
  #define ROUND_UP(x, y) (((x) + (y) - 1) / (y) * (y))
 
+/* The number of event bits in IN_ALL_EVENTS */
+
+#define INOTIFY_NEVENTS 12
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -67,8 +73,9 @@ struct inotify_device_s
 
 struct inotify_event_s
 {
-  struct list_node     node;     /* Entry in inotify_device's list */
-  struct inotify_event event;    /* The user-space event */
+  struct list_node            node;  /* Entry in inotify_device's list */
+  FAR struct inotify_watch_s *watch; /* The watch, if its pending IN_MODIFY */
+  struct inotify_event        event; /* The user-space event */
 };
 
 struct inotify_watch_list_s
@@ -85,16 +92,41 @@ struct inotify_watch_s
   uint32_t                         mask;    /* Event mask for this watch */
   FAR struct inotify_device_s     *dev;     /* Associated device */
   FAR struct inotify_watch_list_s *list;    /* Associated watch list */
+  FAR struct inotify_event_s      *modify;  /* Its IN_MODIFY not yet read */
+};
+
+/* The watch lists of an open file, so that the reads and the writes do not
+ * look up its path:  A file of a mounted volume has no inode of its own, so
+ * the entries are keyed by the open file.  An entry is valid while the
+ * watch lists and the paths do not change.
+ */
+
+#if CONFIG_FS_NOTIFY_FILE_CACHE > 0
+struct inotify_file_s
+{
+  FAR struct file                 *filep;   /* The open file, NULL if none */
+  uint32_t                         gen;     /* g_inotify.gen when cached */
+  FAR struct inotify_watch_list_s *list;    /* The watches of the file */
+  FAR struct inotify_watch_list_s *parent;  /* The watches of its directory */
+  FAR char                        *name;    /* Its name in the directory */
 };
+#endif
 
 struct inotify_global_s
 {
   mutex_t  lock;               /* Enforces global exclusive access */
   int      event_cookie;       /* Event cookie */
   int      watch_cookie;       /* Watch cookie */
-  uint32_t read_count;         /* Number of read events */
-  uint32_t write_count;        /* Number of write events */
+  uint32_t events;             /* The events of all the watches */
+  uint32_t gen;                /* Changes with the watch lists and paths */
   struct   hsearch_data hash;  /* Hash table for watch lists */
+
+  /* The number of watches of each event */
+
+  uint16_t counts[INOTIFY_NEVENTS];
+#if CONFIG_FS_NOTIFY_FILE_CACHE > 0
+  struct inotify_file_s files[CONFIG_FS_NOTIFY_FILE_CACHE];
+#endif
 };
 
 /****************************************************************************
@@ -149,46 +181,49 @@ static struct inotify_global_s g_inotify =
  ****************************************************************************/
 
 /****************************************************************************
- * Name: notify_add_count
+ * Name: inotify_add_count
  *
  * Description:
- *   Add the count.
+ *   Count a watch of the events of 'mask'.
  *
  ****************************************************************************/
 
 static void inotify_add_count(uint32_t mask)
 {
-  g_inotify.read_count += (mask & IN_ACCESS) ? 1 : 0;
-  g_inotify.write_count += (mask & IN_MODIFY) ? 1 : 0;
+  int i;
+
+  mask &= IN_ALL_EVENTS;
+  while (mask != 0)
+    {
+      i = ffs(mask) - 1;
+      mask &= mask - 1;
+      g_inotify.counts[i]++;
+      g_inotify.events |= 1 << i;
+    }
 }
 
 /****************************************************************************
  * Name: inotify_sub_count
  *
  * Description:
- *   Reduce the count.
+ *   Uncount a watch of the events of 'mask'.
  *
  ****************************************************************************/
 
 static void inotify_sub_count(uint32_t mask)
 {
-  g_inotify.read_count -= (mask & IN_ACCESS) ? 1 : 0;
-  g_inotify.write_count -= (mask & IN_MODIFY) ? 1 : 0;
-}
-
-/****************************************************************************
- * Name: notify_check_mask
- *
- * Description:
- *   Check if the count is valid.
- *
- ****************************************************************************/
+  int i;
 
-static int notify_check_mask(uint32_t mask)
-{
-  return (((mask & IN_ACCESS) && g_inotify.read_count == 0) ||
-          ((mask & IN_MODIFY) && g_inotify.write_count == 0)) ?
-          -EBADF : OK;
+  mask &= IN_ALL_EVENTS;
+  while (mask != 0)
+    {
+      i = ffs(mask) - 1;
+      mask &= mask - 1;
+      if (--g_inotify.counts[i] == 0)
+        {
+          g_inotify.events &= ~(1 << i);
+        }
+    }
 }
 
 /****************************************************************************
@@ -230,20 +265,41 @@ inotify_alloc_event(int wd, uint32_t mask, uint32_t cookie,
   return event;
 }
 
+/****************************************************************************
+ * Name: inotify_same_event
+ *
+ * Description:
+ *   Check if a queued event is the same as a new one.
+ *
+ ****************************************************************************/
+
+static bool inotify_same_event(FAR struct inotify_event_s *event, int wd,
+                               uint32_t mask, uint32_t cookie,
+                               FAR const char *name)
+{
+  return event->event.mask == mask && event->event.wd == wd &&
+         event->event.cookie == cookie &&
+         ((name == NULL && event->event.len == 0) ||
+          (name && event->event.len && !strcmp(name, event->event.name)));
+}
+
 /****************************************************************************
  * Name: inotify_queue_event
  *
  * Description:
- *   Queue an event to the inotify device.
+ *   Queue an event of a watch to the inotify device.  Repeated IN_MODIFY
+ *   events of a watch are coalesced until the first one is read.
  *
  ****************************************************************************/
 
-static void inotify_queue_event(FAR struct inotify_device_s *dev, int wd,
+static void inotify_queue_event(FAR struct inotify_device_s *dev,
+                                FAR struct inotify_watch_s *watch,
                                 uint32_t mask, uint32_t cookie,
                                 FAR const char *name)
 {
   FAR struct inotify_event_s *event;
   FAR struct inotify_event_s *last;
+  int wd = watch->wd;
   int semcnt;
 
   if (!list_is_empty(&dev->events))
@@ -252,15 +308,18 @@ static void inotify_queue_event(FAR struct inotify_device_s *dev, int wd,
 
       last = list_last_entry(&dev->events,
                              struct inotify_event_s, node);
-      if (last->event.mask == mask && last->event.wd == wd &&
-          last->event.cookie == cookie &&
-          ((name == NULL && last->event.len == 0) ||
-           (name && last->event.len && !strcmp(name, last->event.name))))
+      if (inotify_same_event(last, wd, mask, cookie, name))
         {
           return;
         }
     }
 
+  if (watch->modify != NULL &&
+      inotify_same_event(watch->modify, wd, mask, cookie, name))
+    {
+      return;
+    }
+
   if (dev->event_count > CONFIG_FS_NOTIFY_MAX_EVENTS)
     {
       finfo("Too many events queued\n");
@@ -281,6 +340,18 @@ static void inotify_queue_event(FAR struct inotify_device_s *dev, int wd,
       return;
     }
 
+  event->watch = NULL;
+  if ((mask & IN_MODIFY) != 0 && event->event.wd == wd)
+    {
+      if (watch->modify != NULL)
+        {
+          watch->modify->watch = NULL;
+        }
+
+      watch->modify = event;
+      event->watch  = watch;
+    }
+
   dev->event_count++;
   dev->event_size += sizeof(struct inotify_event) + event->event.len;
   list_add_tail(&dev->events, &event->node);
@@ -306,6 +377,11 @@ inotify_remove_watch_no_event(FAR struct inotify_watch_s *watch)
 {
   FAR struct inotify_watch_list_s *list = watch->list;
 
+  if (watch->modify != NULL)
+    {
+      watch->modify->watch = NULL;
+    }
+
   list_delete(&watch->d_node);
   list_delete(&watch->l_node);
   inotify_sub_count(watch->mask);
@@ -316,6 +392,7 @@ inotify_remove_watch_no_event(FAR struct inotify_watch_s *watch)
       ENTRY item;
       item.key = list->path;
       hsearch_r(item, DELETE, NULL, &g_inotify.hash);
+      g_inotify.gen++;
     }
 }
 
@@ -330,7 +407,7 @@ inotify_remove_watch_no_event(FAR struct inotify_watch_s *watch)
 static void inotify_remove_watch(FAR struct inotify_device_s *dev,
                                  FAR struct inotify_watch_s *watch)
 {
-  inotify_queue_event(dev, watch->wd, IN_IGNORED, 0, NULL);
+  inotify_queue_event(dev, watch, IN_IGNORED, 0, NULL);
   inotify_remove_watch_no_event(watch);
 }
 
@@ -345,6 +422,11 @@ static void inotify_remove_watch(FAR struct inotify_device_s *dev,
 static void inotify_remove_event(FAR struct inotify_device_s *dev,
                                  FAR struct inotify_event_s *event)
 {
+  if (event->watch != NULL)
+    {
+      event->watch->modify = NULL;
+    }
+
   list_delete(&event->node);
   dev->event_size -= sizeof(struct inotify_event) + event->event.len;
   dev->event_count--;
@@ -762,6 +844,7 @@ inotify_alloc_watch_list(FAR const char *path)
       return NULL;
     }
 
+  g_inotify.gen++;
   return list;
 }
 
@@ -815,7 +898,7 @@ inotify_queue_watch_list_event(FAR struct inotify_watch_list_s *list,
           bool last_iteration = list_is_singular(&list->watches);
 
           nxmutex_lock(&dev->lock);
-          inotify_queue_event(dev, watch->wd, mask, cookie, name);
+          inotify_queue_event(dev, watch, mask, cookie, name);
           if (watch_mask & IN_ONESHOT)
             {
               inotify_remove_watch(dev, watch);
@@ -837,31 +920,83 @@ inotify_queue_watch_list_event(FAR struct inotify_watch_list_s *list,
 }
 
 /****************************************************************************
- * Name: inotify_queue_parent_event
+ * Name: inotify_queue_file_event
  *
  * Description:
- *   Queue an event to the inotify inode.
+ *   Queue an event to the watches of a file and of its directory.
  *
  ****************************************************************************/
 
-static void inotify_queue_parent_event(FAR char *path, uint32_t mask,
-                                       uint32_t cookie)
+static void
+inotify_queue_file_event(FAR struct inotify_watch_list_s *list,
+                         FAR struct inotify_watch_list_s *parent,
+                         FAR const char *name, uint32_t mask,
+                         uint32_t cookie)
 {
-  FAR struct inotify_watch_list_s *list;
-  FAR char *name;
+  if (parent != NULL)
+    {
+      inotify_queue_watch_list_event(parent, mask | IN_ISDIR, cookie, name);
+    }
 
-  name = basename(path);
-  if (name == NULL || name == path)
+  if (list == NULL)
     {
       return;
     }
 
-  *(name - 1) = '\0';
-  list = inotify_get_watch_list(path);
-  if (list != NULL)
+  if (mask & IN_MOVED_FROM)
+    {
+      mask ^= IN_MOVED_FROM;
+      mask |= IN_MOVE_SELF;
+    }
+
+  if (mask & IN_MOVED_TO)
+    {
+      mask ^= IN_MOVED_TO;
+    }
+
+  if (mask & IN_DELETE)
+    {
+      mask ^= IN_DELETE;
+      mask |= IN_DELETE_SELF;
+    }
+
+  if (mask != 0)
+    {
+      inotify_queue_watch_list_event(list, mask, cookie, NULL);
+    }
+}
+
+/****************************************************************************
+ * Name: notify_get_watch_lists
+ *
+ * Description:
+ *   Resolve a path into 'abspath' and get the watch lists of the file and
+ *   of its directory.  '*name' points to the name of the file in 'abspath'.
+ *
+ ****************************************************************************/
+
+static int notify_get_watch_lists(FAR const char *path, FAR char *abspath,
+                                  FAR struct inotify_watch_list_s **list,
+                                  FAR struct inotify_watch_list_s **parent,
+                                  FAR char **name)
+{
+  if (lib_realpath(path, abspath, true) == NULL)
+    {
+      return -ENOENT;
+    }
+
+  *list   = inotify_get_watch_list(abspath);
+  *parent = NULL;
+  *name   = basename(abspath);
+  if (*name == NULL || *name == abspath)
     {
-      inotify_queue_watch_list_event(list, mask | IN_ISDIR, cookie, name);
+      *name = NULL;
+      return OK;
     }
+
+  *(*name - 1) = '\0';
+  *parent = inotify_get_watch_list(abspath);
+  return OK;
 }
 
 /****************************************************************************
@@ -874,9 +1009,10 @@ static void inotify_queue_parent_event(FAR char *path, uint32_t mask,
 
 static void notify_queue_path_event(FAR const char *path, uint32_t mask)
 {
+  FAR struct inotify_watch_list_s *parent;
   FAR struct inotify_watch_list_s *list;
-  FAR char *abspath;
   FAR char *pathbuffer;
+  FAR char *name;
   uint32_t cookie = 0;
 
   pathbuffer = lib_get_pathbuffer();
@@ -885,8 +1021,7 @@ static void notify_queue_path_event(FAR const char *path, uint32_t mask)
       return;
     }
 
-  abspath = lib_realpath(path, pathbuffer, true);
-  if (abspath == NULL)
+  if (notify_get_watch_lists(path, pathbuffer, &list, &parent, &name) < 0)
     {
       lib_put_pathbuffer(pathbuffer);
       return;
@@ -902,36 +1037,59 @@ static void notify_queue_path_event(FAR const char *path, uint32_t mask)
       cookie = g_inotify.event_cookie;
     }
 
-  list = inotify_get_watch_list(abspath);
-  inotify_queue_parent_event(abspath, mask, cookie);
+  inotify_queue_file_event(list, parent, name, mask, cookie);
   lib_put_pathbuffer(pathbuffer);
-  if (list == NULL)
-    {
-      return;
-    }
+}
 
-  if (mask & IN_MOVED_FROM)
-    {
-      mask ^= IN_MOVED_FROM;
-      mask |= IN_MOVE_SELF;
-    }
+/****************************************************************************
+ * Name: inotify_get_file
+ *
+ * Description:
+ *   Return the entry of the watch list cache for an open file.
+ *
+ ****************************************************************************/
 
-  if (mask & IN_MOVED_TO)
-    {
-      mask ^= IN_MOVED_TO;
-    }
+#if CONFIG_FS_NOTIFY_FILE_CACHE > 0
+static FAR struct inotify_file_s *inotify_get_file(FAR struct file *filep)
+{
+  uintptr_t index = (uintptr_t)filep / sizeof(struct file);
 
-  if (mask & IN_DELETE)
-    {
-      mask ^= IN_DELETE;
-      mask |= IN_DELETE_SELF;
-    }
+  return &g_inotify.files[index % CONFIG_FS_NOTIFY_FILE_CACHE];
+}
 
-  if (mask != 0)
+/****************************************************************************
+ * Name: inotify_set_file
+ *
+ * Description:
+ *   Cache the watch lists of an open file.
+ *
+ ****************************************************************************/
+
+static void inotify_set_file(FAR struct inotify_file_s *file,
+                             FAR struct file *filep,
+                             FAR struct inotify_watch_list_s *list,
+                             FAR struct inotify_watch_list_s *parent,
+                             FAR const char *name)
+{
+  fs_heap_free(file->name);
+  file->name  = NULL;
+  file->filep = NULL;
+
+  if (name != NULL)
     {
-      inotify_queue_watch_list_event(list, mask, cookie, NULL);
+      file->name = fs_heap_strdup(name);
+      if (file->name == NULL)
+        {
+          return;
+        }
     }
+
+  file->filep  = filep;
+  file->gen    = g_inotify.gen;
+  file->list   = list;
+  file->parent = parent;
 }
+#endif
 
 /****************************************************************************
  * Name: notify_check_inode
@@ -969,45 +1127,90 @@ static int notify_check_inode(FAR struct file *filep)
 static inline void notify_queue_filep_event(FAR struct file *filep,
                                             uint32_t mask)
 {
+  FAR struct inotify_watch_list_s *parent;
+  FAR struct inotify_watch_list_s *list;
+#if CONFIG_FS_NOTIFY_FILE_CACHE > 0
+  FAR struct inotify_file_s *file;
+  uint32_t gen;
+#endif
   FAR char *pathbuffer;
+  FAR char *abspath;
+  FAR char *name;
   int ret;
 
+  if (!notify_watched(mask))
+    {
+      return;
+    }
+
   ret = notify_check_inode(filep);
   if (ret < 0)
     {
       return;
     }
 
+  if (filep->f_oflags & O_DIRECTORY)
+    {
+      mask |= IN_ISDIR;
+    }
+
+#if CONFIG_FS_NOTIFY_FILE_CACHE > 0
+  /* Use the watch lists cached for the file if they are still valid */
+
   nxmutex_lock(&g_inotify.lock);
-  ret = notify_check_mask(mask);
-  nxmutex_unlock(&g_inotify.lock);
-  if (ret < 0)
+  file = inotify_get_file(filep);
+  if (file->filep == filep && file->gen == g_inotify.gen)
     {
+      inotify_queue_file_event(file->list, file->parent, file->name,
+                               mask, 0);
+      nxmutex_unlock(&g_inotify.lock);
       return;
     }
 
+  gen = g_inotify.gen;
+  nxmutex_unlock(&g_inotify.lock);
+#endif
+
   pathbuffer = lib_get_pathbuffer();
   if (pathbuffer == NULL)
     {
       return;
     }
 
-  ret = file_fcntl(filep, F_GETPATH, pathbuffer);
-  if (ret < 0)
+  abspath = lib_get_pathbuffer();
+  if (abspath == NULL)
     {
       lib_put_pathbuffer(pathbuffer);
       return;
     }
 
-  if (filep->f_oflags & O_DIRECTORY)
+  ret = file_fcntl(filep, F_GETPATH, pathbuffer);
+  if (ret >= 0)
     {
-      mask |= IN_ISDIR;
+      nxmutex_lock(&g_inotify.lock);
+      ret = notify_get_watch_lists(pathbuffer, abspath, &list, &parent,
+                                   &name);
+      if (ret >= 0)
+        {
+          inotify_queue_file_event(list, parent, name, mask, 0);
+
+#if CONFIG_FS_NOTIFY_FILE_CACHE > 0
+          /* Cache the watch lists unless they or the paths changed since
+           * the path of the file was taken.
+           */
+
+          if (gen == g_inotify.gen)
+            {
+              inotify_set_file(file, filep, list, parent, name);
+            }
+#endif
+        }
+
+      nxmutex_unlock(&g_inotify.lock);
     }
 
-  nxmutex_lock(&g_inotify.lock);
-  notify_queue_path_event(pathbuffer, mask);
+  lib_put_pathbuffer(abspath);
   lib_put_pathbuffer(pathbuffer);
-  nxmutex_unlock(&g_inotify.lock);
 }
 
 /****************************************************************************
@@ -1126,16 +1329,22 @@ int inotify_add_watch(int fd, FAR const char *pathname, uint32_t mask)
         }
 
       ret = old->wd;
-      inotify_add_count(tmpmask ^ old->mask);
+      inotify_sub_count(tmpmask);
+      inotify_add_count(old->mask);
     }
   else
     {
       watch = inotify_alloc_watch(dev, list, mask);
-      if (watch == NULL && list_is_empty(&list->watches))
+      if (watch == NULL)
         {
-          ENTRY item;
-          item.key = list->path;
-          hsearch_r(item, DELETE, NULL, &g_inotify.hash);
+          if (list_is_empty(&list->watches))
+            {
+              ENTRY item;
+              item.key = list->path;
+              hsearch_r(item, DELETE, NULL, &g_inotify.hash);
+              g_inotify.gen++;
+            }
+
           ret = -ENOMEM;
           goto out;
         }
@@ -1307,6 +1516,61 @@ void notify_initialize(void)
     }
 }
 
+/****************************************************************************
+ * Name: notify_watched
+ *
+ * Description:
+ *   Check without locking if a watch may want the events of 'mask', so that
+ *   the hooks do not look up the paths of the files in vain.
+ *
+ ****************************************************************************/
+
+bool notify_watched(uint32_t mask)
+{
+  /* The deletion of a watched path always removes its watches */
+
+  if (mask & IN_DELETE)
+    {
+      return g_inotify.events != 0;
+    }
+
+  if (mask & IN_MOVED_FROM)
+    {
+      mask |= IN_MOVE_SELF;
+    }
+
+  return (g_inotify.events & mask) != 0;
+}
+
+/****************************************************************************
+ * Name: notify_forget
+ *
+ * Description:
+ *   The hook is called when a file is closed, before its struct file is
+ *   reused.
+ *
+ ****************************************************************************/
+
+void notify_forget(FAR struct file *filep)
+{
+#if CONFIG_FS_NOTIFY_FILE_CACHE > 0
+  FAR struct inotify_file_s *file = inotify_get_file(filep);
+
+  if (file->filep == filep)
+    {
+      nxmutex_lock(&g_inotify.lock);
+      if (file->filep == filep)
+        {
+          fs_heap_free(file->name);
+          file->name  = NULL;
+          file->filep = NULL;
+        }
+
+      nxmutex_unlock(&g_inotify.lock);
+    }
+#endif
+}
+
 /****************************************************************************
  * Name: notify_open
  *
@@ -1329,6 +1593,11 @@ void notify_open(FAR const char *path, int oflags)
       mask |= IN_CREATE;
     }
 
+  if (!notify_watched(mask))
+    {
+      return;
+    }
+
   nxmutex_lock(&g_inotify.lock);
   notify_queue_path_event(path, mask);
   nxmutex_unlock(&g_inotify.lock);
@@ -1344,14 +1613,16 @@ void notify_open(FAR const char *path, int oflags)
 
 void notify_close(FAR const char *path, int oflags)
 {
-  if (oflags & O_WROK)
-    {
-      notify_queue_path_event(path, IN_CLOSE_WRITE);
-    }
-  else
+  uint32_t mask = (oflags & O_WROK) ? IN_CLOSE_WRITE : IN_CLOSE_NOWRITE;
+
+  if (!notify_watched(mask))
     {
-      notify_queue_path_event(path, IN_CLOSE_NOWRITE);
+      return;
     }
+
+  nxmutex_lock(&g_inotify.lock);
+  notify_queue_path_event(path, mask);
+  nxmutex_unlock(&g_inotify.lock);
 }
 
 /****************************************************************************
@@ -1366,6 +1637,11 @@ void notify_close2(FAR struct inode *inode)
 {
   FAR char *pathbuffer;
 
+  if (!notify_watched(IN_CLOSE_WRITE))
+    {
+      return;
+    }
+
   pathbuffer = lib_get_pathbuffer();
   if (pathbuffer == NULL)
     {
@@ -1431,7 +1707,15 @@ void notify_chstat(FAR struct file *filep)
 
 void notify_unlink(FAR const char *path)
 {
+  if (!notify_watched(IN_DELETE))
+    {
+      return;
+    }
+
+  /* The path of an open file may change */
+
   nxmutex_lock(&g_inotify.lock);
+  g_inotify.gen++;
   notify_queue_path_event(path, IN_DELETE);
   nxmutex_unlock(&g_inotify.lock);
 }
@@ -1446,7 +1730,15 @@ void notify_unlink(FAR const char *path)
 
 void notify_unmount(FAR const char *path)
 {
+  if (!notify_watched(IN_DELETE | IN_UNMOUNT))
+    {
+      return;
+    }
+
+  /* The path of an open file may change */
+
   nxmutex_lock(&g_inotify.lock);
+  g_inotify.gen++;
   notify_queue_path_event(path, IN_DELETE | IN_UNMOUNT);
   nxmutex_unlock(&g_inotify.lock);
 }
@@ -1461,6 +1753,11 @@ void notify_unmount(FAR const char *path)
 
 void notify_mkdir(FAR const char *path)
 {
+  if (!notify_watched(IN_CREATE | IN_ISDIR))
+    {
+      return;
+    }
+
   nxmutex_lock(&g_inotify.lock);
   notify_queue_path_event(path, IN_CREATE | IN_ISDIR);
   nxmutex_unlock(&g_inotify.lock);
@@ -1476,6 +1773,11 @@ void notify_mkdir(FAR const char *path)
 
 void notify_create(FAR const char *path)
 {
+  if (!notify_watched(IN_CREATE))
+    {
+      return;
+    }
+
   nxmutex_lock(&g_inotify.lock);
   notify_queue_path_event(path, IN_CREATE);
   nxmutex_unlock(&g_inotify.lock);
@@ -1505,7 +1807,17 @@ void notify_rename(FAR const char *oldpath, bool oldisdir,
       oldmask |= IN_ISDIR;
     }
 
+  /* Without watches, no cached watch list may become stale */
+
+  if (g_inotify.events == 0)
+    {
+      return;
+    }
+
+  /* The paths of the open files may change */
+
   nxmutex_lock(&g_inotify.lock);
+  g_inotify.gen++;
   notify_queue_path_event(oldpath, oldmask);
   notify_queue_path_event(newpath, newmask);
   nxmutex_unlock(&g_inotify.lock);
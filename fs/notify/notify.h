@@ -41,6 +41,8 @@
 
 /* These are internal OS interface and are not available to applications */
 
+bool notify_watched(uint32_t mask);
+void notify_forget(FAR struct file *filep);
 void notify_open(FAR const char *path, int oflags);
 void notify_close(FAR const char *path, int oflags);
 void notify_close2(FAR struct inode *inode);
@@ -36,6 +36,7 @@
 #include <nuttx/fs/nxffs.h>
 #include <nuttx/mutex.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -279,6 +280,9 @@ struct nxffs_volume_s
   FAR struct nxffs_ofile_s *ofiles;    /* A singly-linked list of open files */
   FAR uint8_t              *cache;     /* On cached erase block for general I/O */
   FAR uint8_t              *pack;      /* A full erase block to support packing */
+#ifdef CONFIG_NXFFS_BGPACK
+  struct work_s             packwork;  /* Packs the idle volume in the background */
+#endif
 };
 
 /* This structure describes the state of the blocks on the NXFFS volume */
@@ -1060,6 +1064,30 @@ int nxffs_rminode(FAR struct nxffs_volume_s *volume, FAR const char *name);
 
 int nxffs_pack(FAR struct nxffs_volume_s *volume);
 
+/****************************************************************************
+ * Name: nxffs_bgpack
+ *
+ * Description:
+ *   Schedule the packing of a volume on the low priority work queue, once
+ *   the volume has had no open file for CONFIG_NXFFS_BGPACK_DELAY
+ *   milliseconds, if its free FLASH has fallen below the watermark.  The
+ *   writes then seldom have to pack the volume themselves.  Called with
+ *   the volume locked after a file is closed or removed.
+ *
+ * Input Parameters:
+ *   volume - The volume to be packed.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_BGPACK
+void nxffs_bgpack(FAR struct nxffs_volume_s *volume);
+#else
+#  define nxffs_bgpack(volume)
+#endif
+
 /****************************************************************************
  * Standard mountpoint operation methods
  *
@@ -1170,6 +1170,7 @@ int nxffs_close(FAR struct file *filep)
       ofile->crefs--;
     }
 
+  nxffs_bgpack(volume);
   filep->f_priv = NULL;
   nxmutex_unlock(&volume->lock);
 
@@ -1244,6 +1244,43 @@ static inline int nxffs_packwriter(FAR struct nxffs_volume_s *volume,
   return -ENOSYS;
 }
 
+/****************************************************************************
+ * Name: nxffs_packworker
+ *
+ * Description:
+ *   Pack a volume on the low priority work queue, unless a file was opened
+ *   meanwhile:  Closing that file will schedule the work again.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_BGPACK
+static void nxffs_packworker(FAR void *arg)
+{
+  FAR struct nxffs_volume_s *volume = arg;
+  int ret;
+
+  ret = nxmutex_lock(&volume->lock);
+  if (ret < 0)
+    {
+      return;
+    }
+
+  if (volume->ofiles == NULL)
+    {
+      finfo("Packing the idle volume, froffset: %jd\n",
+            (intmax_t)volume->froffset);
+
+      ret = nxffs_pack(volume);
+      if (ret < 0)
+        {
+          ferr("ERROR: Failed to pack the volume: %d\n", -ret);
+        }
+    }
+
+  nxmutex_unlock(&volume->lock);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -1611,3 +1648,29 @@ errout_with_pack:
   nxffs_freeentry(&pack.dest.entry);
   return ret;
 }
+
+/****************************************************************************
+ * Name: nxffs_bgpack
+ *
+ * Description:
+ *   Schedule the packing of a volume on the low priority work queue, once
+ *   the volume has had no open file for CONFIG_NXFFS_BGPACK_DELAY
+ *   milliseconds, if its free FLASH has fallen below the watermark.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_BGPACK
+void nxffs_bgpack(FAR struct nxffs_volume_s *volume)
+{
+  off_t size = volume->nblocks * volume->geo.blocksize;
+
+  /* Each new close or removal delays the packing again */
+
+  if (volume->ofiles == NULL &&
+      size - volume->froffset < size / 100 * CONFIG_NXFFS_BGPACK_WATERMARK)
+    {
+      work_queue(LPWORK, &volume->packwork, nxffs_packworker, volume,
+                 MSEC2TICK(CONFIG_NXFFS_BGPACK_DELAY));
+    }
+}
+#endif
@@ -150,6 +150,10 @@ int nxffs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
   /* Then remove the NXFFS inode */
 
   ret = nxffs_rminode(volume, relpath);
+  if (ret == OK)
+    {
+      nxffs_bgpack(volume);
+    }
 
   nxmutex_unlock(&volume->lock);
 
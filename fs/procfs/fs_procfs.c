@@ -54,20 +54,30 @@
  * External Definitions
  ****************************************************************************/
 
+extern const struct procfs_operations g_bchcache_operations;
+extern const struct procfs_operations g_boottrace_operations;
 extern const struct procfs_operations g_clk_operations;
 extern const struct procfs_operations g_cpuinfo_operations;
 extern const struct procfs_operations g_cpuload_operations;
 extern const struct procfs_operations g_cpufreq_operations;
+extern const struct procfs_operations g_cpuprof_operations;
 extern const struct procfs_operations g_critmon_operations;
+extern const struct procfs_operations g_crithist_operations;
 extern const struct procfs_operations g_fdt_operations;
+extern const struct procfs_operations g_heapprof_operations;
+extern const struct procfs_operations g_idlepoll_operations;
 extern const struct procfs_operations g_iobinfo_operations;
 extern const struct procfs_operations g_irq_operations;
+extern const struct procfs_operations g_lockstat_operations;
 extern const struct procfs_operations g_meminfo_operations;
 extern const struct procfs_operations g_memdump_operations;
 extern const struct procfs_operations g_mempool_operations;
 extern const struct procfs_operations g_module_operations;
 extern const struct procfs_operations g_pm_operations;
+extern const struct procfs_operations g_smpcall_operations;
 extern const struct procfs_operations g_proc_operations;
+extern const struct procfs_operations g_schedbench_operations;
+extern const struct procfs_operations g_schedlat_operations;
 extern const struct procfs_operations g_tcbinfo_operations;
 extern const struct procfs_operations g_thermal_operations;
 extern const struct procfs_operations g_uptime_operations;
@@ -103,6 +113,14 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "[0-9]*",       &g_proc_operations,     PROCFS_DIR_TYPE    },
 #endif
 
+#ifdef CONFIG_BCH_CACHE
+  { "bchcache",     &g_bchcache_operations, PROCFS_FILE_TYPE   },
+#endif
+
+#ifdef CONFIG_SCHED_BOOTTRACE
+  { "boottrace",    &g_boottrace_operations, PROCFS_FILE_TYPE  },
+#endif
+
 #if defined(CONFIG_CLK) && !defined(CONFIG_FS_PROCFS_EXCLUDE_CLK)
   { "clk",          &g_clk_operations,      PROCFS_FILE_TYPE   },
 #endif
@@ -120,10 +138,18 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "cpufreq",      &g_cpufreq_operations,  PROCFS_FILE_TYPE   },
 #endif
 
+#ifdef CONFIG_SCHED_CPUPROF
+  { "cpuprof",      &g_cpuprof_operations,  PROCFS_FILE_TYPE   },
+#endif
+
 #ifdef CONFIG_SCHED_CRITMONITOR
   { "critmon",      &g_critmon_operations,  PROCFS_FILE_TYPE   },
 #endif
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  { "crithist",     &g_crithist_operations, PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_DEVICE_TREE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_FDT)
   { "fdt",          &g_fdt_operations,      PROCFS_FILE_TYPE   },
 #endif
@@ -144,6 +170,14 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "fs/usage",     &g_mount_operations,    PROCFS_FILE_TYPE   },
 #endif
 
+#ifdef CONFIG_MM_HEAPPROF
+  { "heapprof",     &g_heapprof_operations, PROCFS_FILE_TYPE   },
+#endif
+
+#ifdef CONFIG_SCHED_IDLE_POLL
+  { "idlepoll",     &g_idlepoll_operations, PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
   { "iobinfo",      &g_iobinfo_operations,  PROCFS_FILE_TYPE   },
 #endif
@@ -152,6 +186,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "irqs",         &g_irq_operations,      PROCFS_FILE_TYPE   },
 #endif
 
+#ifdef CONFIG_SCHED_LOCKSTAT
+  { "lockstat",     &g_lockstat_operations, PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMINFO
 #  ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMDUMP
   { "memdump",      &g_memdump_operations,  PROCFS_FILE_TYPE   },
@@ -190,11 +228,23 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "pressure/**",  &g_pressure_operations, PROCFS_FILE_TYPE   },
 #endif
 
+#ifdef CONFIG_SCHED_BENCHMARK
+  { "schedbench",   &g_schedbench_operations, PROCFS_FILE_TYPE },
+#endif
+
+#ifdef CONFIG_SCHED_LATENCY
+  { "schedlat",     &g_schedlat_operations, PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_PROCESS
   { "self",         &g_proc_operations,     PROCFS_DIR_TYPE    },
   { "self/**",      &g_proc_operations,     PROCFS_UNKOWN_TYPE },
 #endif
 
+#ifdef CONFIG_SCHED_SMPCALL_STATS
+  { "smpcall",      &g_smpcall_operations,  PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_ARCH_HAVE_TCBINFO) && !defined(CONFIG_FS_PROCFS_EXCLUDE_TCBINFO)
   { "tcbinfo",      &g_tcbinfo_operations,  PROCFS_FILE_TYPE   },
 #endif
@@ -0,0 +1,390 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsboottrace.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/boottrace.h>
+#include <nuttx/clock.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#include "fs_heap.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+     defined(CONFIG_SCHED_BOOTTRACE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The records are shown in the order they were added, with their time in
+ * microseconds since the first record.  The end of a phase shows the time
+ * since its beginning, the records dropped are counted on the last line:
+ *
+ *   TIME(us) CPU EVENT NAME                     DURATION(us)
+ *          0   0 MARK  nx_start
+ *         12   0 BEGIN heap
+ *        141   0 END   heap                              129
+ *   ...
+ *   [dropped] 3
+ */
+
+#define BOOTTRACE_LINELEN  (CONFIG_SCHED_BOOTTRACE_NAMELEN + 48)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct boottrace_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  struct boottrace_s first;       /* The first record */
+  struct boottrace_s record;      /* The record being formatted */
+  struct boottrace_s begin;       /* The beginning of its phase */
+  char line[BOOTTRACE_LINELEN];   /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     boottrace_open(FAR struct file *filep,
+                 FAR const char *relpath, int oflags, mode_t mode);
+static int     boottrace_close(FAR struct file *filep);
+static ssize_t boottrace_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     boottrace_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     boottrace_stat(FAR const char *relpath,
+                 FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_boottrace_operations =
+{
+  boottrace_open,     /* open */
+  boottrace_close,    /* close */
+  boottrace_read,     /* read */
+  NULL,               /* write */
+  NULL,               /* poll */
+
+  boottrace_dup,      /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  boottrace_stat      /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: boottrace_open
+ ****************************************************************************/
+
+static int boottrace_open(FAR struct file *filep, FAR const char *relpath,
+                          int oflags, mode_t mode)
+{
+  FAR struct boottrace_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* This PROCFS file is read-only.  Any attempt to open with write access
+   * is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = fs_heap_zalloc(sizeof(struct boottrace_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: boottrace_close
+ ****************************************************************************/
+
+static int boottrace_close(FAR struct file *filep)
+{
+  FAR struct boottrace_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct boottrace_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  fs_heap_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: boottrace_usec
+ *
+ * Description:
+ *   Convert the time elapsed from 'start' to 'end' to microseconds.
+ *
+ ****************************************************************************/
+
+static unsigned long boottrace_usec(clock_t start, clock_t end)
+{
+  struct timespec ts;
+
+  up_perf_convert(end - start, &ts);
+  return ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+}
+
+/****************************************************************************
+ * Name: boottrace_format
+ *
+ * Description:
+ *   Format line 'index' into the line buffer:  The header, then the
+ *   records and the dropped records.  Zero is returned after the last
+ *   line.
+ *
+ ****************************************************************************/
+
+static size_t boottrace_format(FAR struct boottrace_file_s *attr,
+                               int index)
+{
+  static FAR const char * const types[] =
+  {
+    "BEGIN", "END", "MARK"
+  };
+
+  FAR struct boottrace_s *record = &attr->record;
+  size_t linesize;
+  uint32_t dropped;
+  int i;
+
+  if (index == 0)
+    {
+      return procfs_snprintf(attr->line, BOOTTRACE_LINELEN,
+                             "%10s %3s %-5s %-*s %s\n",
+                             "TIME(us)", "CPU", "EVENT",
+                             CONFIG_SCHED_BOOTTRACE_NAMELEN, "NAME",
+                             "DURATION(us)");
+    }
+
+  if (boottrace_get(index - 1, record) < 0)
+    {
+      /* The line after the last record shows the dropped records, if
+       * any.
+       */
+
+      dropped = boottrace_dropped();
+      if (boottrace_get(index - 2, record) < 0 || dropped == 0)
+        {
+          return 0;
+        }
+
+      return procfs_snprintf(attr->line, BOOTTRACE_LINELEN,
+                             "[dropped] %" PRIu32 "\n", dropped);
+    }
+
+  if (index == 1)
+    {
+      attr->first = *record;
+    }
+
+  linesize = procfs_snprintf(attr->line, BOOTTRACE_LINELEN,
+                             "%10lu %3d %-5s %-*s",
+                             boottrace_usec(attr->first.time, record->time),
+                             record->cpu, types[record->type],
+                             CONFIG_SCHED_BOOTTRACE_NAMELEN, record->name);
+
+  /* The end of a phase shows the time since the last beginning of the
+   * same name.
+   */
+
+  if (record->type == BOOTTRACE_END)
+    {
+      for (i = index - 2; i >= 0; i--)
+        {
+          if (boottrace_get(i, &attr->begin) == OK &&
+              attr->begin.type == BOOTTRACE_BEGIN &&
+              strcmp(attr->begin.name, record->name) == 0)
+            {
+              linesize += procfs_snprintf(attr->line + linesize,
+                                          BOOTTRACE_LINELEN - linesize,
+                                          " %12lu",
+                                          boottrace_usec(attr->begin.time,
+                                                         record->time));
+              break;
+            }
+        }
+    }
+
+  linesize += procfs_snprintf(attr->line + linesize,
+                              BOOTTRACE_LINELEN - linesize, "\n");
+  return linesize;
+}
+
+/****************************************************************************
+ * Name: boottrace_read
+ ****************************************************************************/
+
+static ssize_t boottrace_read(FAR struct file *filep, FAR char *buffer,
+                              size_t buflen)
+{
+  FAR struct boottrace_file_s *attr;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct boottrace_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset    = filep->f_pos;
+  totalsize = 0;
+
+  for (i = 0; totalsize < buflen; i++)
+    {
+      linesize = boottrace_format(attr, i);
+      if (linesize == 0)
+        {
+          break;
+        }
+
+      copysize = procfs_memcpy(attr->line, linesize, buffer + totalsize,
+                               buflen - totalsize, &offset);
+
+      totalsize += copysize;
+    }
+
+  /* Update the file position */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: boottrace_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int boottrace_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct boottrace_file_s *oldattr;
+  FAR struct boottrace_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct boottrace_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = fs_heap_malloc(sizeof(struct boottrace_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct boottrace_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: boottrace_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int boottrace_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "boottrace" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS && CONFIG_SCHED_BOOTTRACE */
@@ -0,0 +1,404 @@
+/****************************************************************************
+ * fs/procfs/fs_procfscpuprof.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+#include <nuttx/cpuprof.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+
+#include "fs_heap.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+     defined(CONFIG_SCHED_CPUPROF)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The profile is shown as the folded stacks of flamegraph.pl, with the
+ * name of the sampled thread, its call stack from the outer caller by name
+ * and the number of samples.  There is one line per call stack and CPU,
+ * the samples dropped on a CPU are counted on a line of their own:
+ *
+ *   nsh_main;nsh_main;nsh_parse;sleep 12
+ *   Idle_Task;nx_start;up_idle 4913
+ *   [dropped] 7
+ *   ...
+ *
+ * Writing "start [rate]" starts the profiler, "stop" stops it and "reset"
+ * clears the profile.
+ */
+
+#define CPUPROF_LINELEN  (64 * (CONFIG_SCHED_CPUPROF_DEPTH + 1))
+
+/* One line per call stack, then the dropped samples, for each CPU */
+
+#define CPUPROF_NLINES   (CONFIG_SCHED_CPUPROF_NSTACKS + 1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct cpuprof_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  struct cpuprof_stack_s stack;   /* The call stack being formatted */
+  char line[CPUPROF_LINELEN];     /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     cpuprof_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     cpuprof_close(FAR struct file *filep);
+static ssize_t cpuprof_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static ssize_t cpuprof_write(FAR struct file *filep, FAR const char *buffer,
+                 size_t buflen);
+static int     cpuprof_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     cpuprof_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_cpuprof_operations =
+{
+  cpuprof_open,       /* open */
+  cpuprof_close,      /* close */
+  cpuprof_read,       /* read */
+  cpuprof_write,      /* write */
+  NULL,               /* poll */
+
+  cpuprof_dup,        /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  cpuprof_stat        /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cpuprof_open
+ ****************************************************************************/
+
+static int cpuprof_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct cpuprof_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = fs_heap_zalloc(sizeof(struct cpuprof_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: cpuprof_close
+ ****************************************************************************/
+
+static int cpuprof_close(FAR struct file *filep)
+{
+  FAR struct cpuprof_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct cpuprof_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  fs_heap_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: cpuprof_format
+ *
+ * Description:
+ *   Format line 'index' of 'cpu' into the line buffer.  Nothing is
+ *   formatted for a call stack that is not used, or without dropped
+ *   samples.
+ *
+ ****************************************************************************/
+
+static size_t cpuprof_format(FAR struct cpuprof_file_s *attr, int cpu,
+                             int index)
+{
+  FAR struct cpuprof_stack_s *stack = &attr->stack;
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  size_t linesize;
+  uint32_t dropped;
+  int i;
+
+  if (index == CONFIG_SCHED_CPUPROF_NSTACKS)
+    {
+      dropped = cpuprof_dropped(cpu);
+      if (dropped == 0)
+        {
+          return 0;
+        }
+
+      return procfs_snprintf(attr->line, CPUPROF_LINELEN,
+                             "[dropped] %" PRIu32 "\n", dropped);
+    }
+
+  if (cpuprof_getstack(cpu, index, stack) < 0)
+    {
+      return 0;
+    }
+
+  /* The root frame is the name of the thread if it still exists */
+
+  flags = enter_critical_section();
+  tcb   = nxsched_get_tcb(stack->pid);
+  if (tcb != NULL)
+    {
+      linesize = procfs_snprintf(attr->line, CPUPROF_LINELEN, "%s",
+                                 get_task_name(tcb));
+    }
+  else
+    {
+      linesize = procfs_snprintf(attr->line, CPUPROF_LINELEN, "%d",
+                                 (int)stack->pid);
+    }
+
+  leave_critical_section(flags);
+
+  /* The outer caller comes first, the frames are symbolized if
+   * CONFIG_ALLSYMS is enabled.
+   */
+
+  for (i = stack->nframes - 1; i >= 0; i--)
+    {
+      linesize += procfs_snprintf(attr->line + linesize,
+                                  CPUPROF_LINELEN - linesize,
+                                  ";%ps", stack->frames[i]);
+    }
+
+  linesize += procfs_snprintf(attr->line + linesize,
+                              CPUPROF_LINELEN - linesize,
+                              " %" PRIu32 "\n", stack->count);
+  return linesize;
+}
+
+/****************************************************************************
+ * Name: cpuprof_read
+ ****************************************************************************/
+
+static ssize_t cpuprof_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct cpuprof_file_s *attr;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int cpu;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct cpuprof_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset    = filep->f_pos;
+  totalsize = 0;
+
+  /* The call stacks are counted while they are read:  Each line is
+   * consistent, but the lines are not a snapshot of the profile.
+   */
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS && totalsize < buflen; cpu++)
+    {
+      for (i = 0; i < CPUPROF_NLINES && totalsize < buflen; i++)
+        {
+          linesize = cpuprof_format(attr, cpu, i);
+          if (linesize > 0)
+            {
+              copysize = procfs_memcpy(attr->line, linesize,
+                                       buffer + totalsize,
+                                       buflen - totalsize, &offset);
+
+              totalsize += copysize;
+            }
+        }
+    }
+
+  /* Update the file position */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: cpuprof_write
+ ****************************************************************************/
+
+static ssize_t cpuprof_write(FAR struct file *filep, FAR const char *buffer,
+                             size_t buflen)
+{
+  char cmd[16];
+  int ret;
+
+  if (buflen >= sizeof(cmd))
+    {
+      return -EINVAL;
+    }
+
+  memcpy(cmd, buffer, buflen);
+  cmd[buflen] = '\0';
+
+  if (strncmp(cmd, "start", 5) == 0)
+    {
+      ret = cpuprof_start(strtoul(cmd + 5, NULL, 10));
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+  else if (strncmp(cmd, "stop", 4) == 0)
+    {
+      cpuprof_stop();
+    }
+  else if (strncmp(cmd, "reset", 5) == 0)
+    {
+      cpuprof_reset();
+    }
+  else
+    {
+      return -EINVAL;
+    }
+
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: cpuprof_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int cpuprof_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct cpuprof_file_s *oldattr;
+  FAR struct cpuprof_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct cpuprof_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = fs_heap_malloc(sizeof(struct cpuprof_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct cpuprof_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: cpuprof_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int cpuprof_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "cpuprof" is the name for a read/write file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS && CONFIG_SCHED_CPUPROF */
@@ -0,0 +1,488 @@
+/****************************************************************************
+ * fs/procfs/fs_procfscrithist.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/critmon.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#include "fs_heap.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+     defined(CONFIG_SCHED_CRITMONITOR_HISTOGRAM)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The call sites are shown with the longest total time first, one line per
+ * kind of duration, CPU and call site.  The non-empty bins follow as
+ * "n:count", where bin n counts the durations from 2^n up to 2^(n+1) perf
+ * counts.  The durations dropped on a CPU are counted on lines of their
+ * own:
+ *
+ *   # TYPE CPU COUNT TOTAL(us) MAX(us) CALLER BINS, 2^n/1000000000 s
+ *   csection 0 1024 5210 61 nxsem_post+0x20 9:1000 10:20 15:4
+ *   preemption 1 12 802 90 work_thread+0x3c 12:10 16:2
+ *   irq 0 40961 3882 8 up_timerisr+0x0 6:40961
+ *   [dropped] csection 0 7
+ *   ...
+ *
+ * The ranking is taken when the file is opened.  Writing "reset" forgets
+ * all call sites.
+ */
+
+#define CRITHIST_LINELEN  (64 + 64 + 16 * CRITMON_NBINS)
+
+#define CRITHIST_NSITES   (CONFIG_SMP_NCPUS * CRITMON_NTYPES * \
+                           CONFIG_SCHED_CRITMONITOR_HISTOGRAM_NSITES)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One call site in the ranking */
+
+struct crithist_rank_s
+{
+  uint64_t total;                 /* The total time when opened */
+  uint16_t index;                 /* The index of the call site */
+  uint8_t  cpu;                   /* The CPU that counted it */
+  uint8_t  type;                  /* The kind of duration */
+};
+
+/* This structure describes one open "file" */
+
+struct crithist_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  struct critmon_site_s site;     /* The call site being formatted */
+  int nranks;                     /* Number of call sites in ranks[] */
+  struct crithist_rank_s ranks[CRITHIST_NSITES];
+  char line[CRITHIST_LINELEN];    /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     crithist_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     crithist_close(FAR struct file *filep);
+static ssize_t crithist_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static ssize_t crithist_write(FAR struct file *filep, FAR const char *buffer,
+                 size_t buflen);
+static int     crithist_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     crithist_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR const char * const g_crithist_types[CRITMON_NTYPES] =
+{
+  "preemption",
+  "csection",
+  "irq"
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_crithist_operations =
+{
+  crithist_open,      /* open */
+  crithist_close,     /* close */
+  crithist_read,      /* read */
+  crithist_write,     /* write */
+  NULL,               /* poll */
+
+  crithist_dup,       /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  crithist_stat       /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: crithist_compare
+ *
+ * Description:
+ *   qsort() callback that puts the longest total time first.
+ *
+ ****************************************************************************/
+
+static int crithist_compare(FAR const void *a, FAR const void *b)
+{
+  FAR const struct crithist_rank_s *ra = a;
+  FAR const struct crithist_rank_s *rb = b;
+
+  if (ra->total != rb->total)
+    {
+      return ra->total < rb->total ? 1 : -1;
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: crithist_rank
+ *
+ * Description:
+ *   Rank the call sites of all CPUs by their total time.
+ *
+ ****************************************************************************/
+
+static void crithist_rank(FAR struct crithist_file_s *attr)
+{
+  FAR struct crithist_rank_s *rank;
+  int cpu;
+  int type;
+  int i;
+
+  attr->nranks = 0;
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      for (type = 0; type < CRITMON_NTYPES; type++)
+        {
+          for (i = 0; i < CONFIG_SCHED_CRITMONITOR_HISTOGRAM_NSITES; i++)
+            {
+              if (critmon_getsite(cpu, type, i, &attr->site) < 0)
+                {
+                  continue;
+                }
+
+              rank        = &attr->ranks[attr->nranks++];
+              rank->total = attr->site.total;
+              rank->index = i;
+              rank->cpu   = cpu;
+              rank->type  = type;
+            }
+        }
+    }
+
+  qsort(attr->ranks, attr->nranks, sizeof(struct crithist_rank_s),
+        crithist_compare);
+}
+
+/****************************************************************************
+ * Name: crithist_usec
+ *
+ * Description:
+ *   Convert perf counts to microseconds without overflow.
+ *
+ ****************************************************************************/
+
+static uint64_t crithist_usec(uint64_t counts)
+{
+  uint64_t freq = perf_getfreq();
+
+  if (freq == 0)
+    {
+      return 0;
+    }
+
+  return counts / freq * USEC_PER_SEC + counts % freq * USEC_PER_SEC / freq;
+}
+
+/****************************************************************************
+ * Name: crithist_open
+ ****************************************************************************/
+
+static int crithist_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct crithist_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = fs_heap_zalloc(sizeof(struct crithist_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  crithist_rank(attr);
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: crithist_close
+ ****************************************************************************/
+
+static int crithist_close(FAR struct file *filep)
+{
+  FAR struct crithist_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct crithist_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  fs_heap_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: crithist_format
+ *
+ * Description:
+ *   Format line 'index' into the line buffer:  The header, the ranked call
+ *   sites and then the dropped durations of each CPU and kind.  Nothing is
+ *   formatted for a call site that was reset meanwhile, or without dropped
+ *   durations.
+ *
+ ****************************************************************************/
+
+static size_t crithist_format(FAR struct crithist_file_s *attr, int index)
+{
+  FAR struct critmon_site_s *site = &attr->site;
+  FAR struct crithist_rank_s *rank;
+  size_t linesize;
+  uint32_t dropped;
+  int cpu;
+  int type;
+  int i;
+
+  if (index == 0)
+    {
+      return procfs_snprintf(attr->line, CRITHIST_LINELEN,
+                             "# TYPE CPU COUNT TOTAL(us) MAX(us) CALLER "
+                             "BINS, 2^n/%lu s\n", perf_getfreq());
+    }
+
+  index--;
+  if (index >= attr->nranks)
+    {
+      index -= attr->nranks;
+      cpu    = index / CRITMON_NTYPES;
+      type   = index % CRITMON_NTYPES;
+
+      dropped = critmon_dropped(cpu, type);
+      if (dropped == 0)
+        {
+          return 0;
+        }
+
+      return procfs_snprintf(attr->line, CRITHIST_LINELEN,
+                             "[dropped] %s %d %" PRIu32 "\n",
+                             g_crithist_types[type], cpu, dropped);
+    }
+
+  rank = &attr->ranks[index];
+  if (critmon_getsite(rank->cpu, rank->type, rank->index, site) < 0)
+    {
+      return 0;
+    }
+
+  linesize = procfs_snprintf(attr->line, CRITHIST_LINELEN,
+                             "%s %d %" PRIu32 " %" PRIu64 " %" PRIu64
+                             " %ps",
+                             g_crithist_types[rank->type], rank->cpu,
+                             site->count, crithist_usec(site->total),
+                             crithist_usec(site->max), site->caller);
+
+  for (i = 0; i < CRITMON_NBINS; i++)
+    {
+      if (site->bins[i] != 0)
+        {
+          linesize += procfs_snprintf(attr->line + linesize,
+                                      CRITHIST_LINELEN - linesize,
+                                      " %d:%" PRIu32, i, site->bins[i]);
+        }
+    }
+
+  linesize += procfs_snprintf(attr->line + linesize,
+                              CRITHIST_LINELEN - linesize, "\n");
+  return linesize;
+}
+
+/****************************************************************************
+ * Name: crithist_read
+ ****************************************************************************/
+
+static ssize_t crithist_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR struct crithist_file_s *attr;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int nlines;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct crithist_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset    = filep->f_pos;
+  totalsize = 0;
+
+  /* The header, the ranked call sites and the dropped durations.  The call
+   * sites are counted while they are read:  Each line is consistent, but
+   * the lines are not a snapshot.
+   */
+
+  nlines = 1 + attr->nranks + CONFIG_SMP_NCPUS * CRITMON_NTYPES;
+  for (i = 0; i < nlines && totalsize < buflen; i++)
+    {
+      linesize = crithist_format(attr, i);
+      if (linesize > 0)
+        {
+          copysize = procfs_memcpy(attr->line, linesize, buffer + totalsize,
+                                   buflen - totalsize, &offset);
+
+          totalsize += copysize;
+        }
+    }
+
+  /* Update the file position */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: crithist_write
+ ****************************************************************************/
+
+static ssize_t crithist_write(FAR struct file *filep, FAR const char *buffer,
+                              size_t buflen)
+{
+  if (buflen < 5 || strncmp(buffer, "reset", 5) != 0)
+    {
+      return -EINVAL;
+    }
+
+  critmon_reset();
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: crithist_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int crithist_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct crithist_file_s *oldattr;
+  FAR struct crithist_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct crithist_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = fs_heap_malloc(sizeof(struct crithist_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct crithist_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: crithist_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int crithist_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "crithist" is the name for a read/write file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+        */
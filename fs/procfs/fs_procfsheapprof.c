@@ -0,0 +1,431 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsheapprof.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+#include <nuttx/mm/heapprof.h>
+
+#include "fs_heap.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+     defined(CONFIG_MM_HEAPPROF)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The profile is shown in one of two formats, selected by writing "pprof"
+ * or "folded" to the file;  Writing "reset" clears the profile.
+ *
+ * The legacy heap profile format of pprof, with the estimated allocations
+ * and bytes in use and in total, then the call stack by address:
+ *
+ *   heap profile: 12: 6291456 [40: 20971520] @ heapprofile
+ *   3: 1572864 [9: 4718592] @ 0x4012ab 0x40aa10 0x400f20
+ *   ...
+ *
+ * The folded stacks of flamegraph.pl, with the call stack from the outer
+ * caller by name and the bytes in use:
+ *
+ *   nsh_main;nsh_parse;lib_malloc 1572864
+ *   ...
+ */
+
+#define HEAPPROF_LINELEN  (64 * (CONFIG_MM_HEAPPROF_DEPTH + 1))
+
+#define HEAPPROF_PPROF    0
+#define HEAPPROF_FOLDED   1
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct heapprof_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  struct heapprof_site_s site;    /* The call site being formatted */
+  char line[HEAPPROF_LINELEN];    /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     heapprof_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     heapprof_close(FAR struct file *filep);
+static ssize_t heapprof_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static ssize_t heapprof_write(FAR struct file *filep, FAR const char *buffer,
+                 size_t buflen);
+static int     heapprof_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     heapprof_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static int g_heapprof_format = HEAPPROF_PPROF;
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_heapprof_operations =
+{
+  heapprof_open,      /* open */
+  heapprof_close,     /* close */
+  heapprof_read,      /* read */
+  heapprof_write,     /* write */
+  NULL,               /* poll */
+
+  heapprof_dup,       /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  heapprof_stat       /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: heapprof_open
+ ****************************************************************************/
+
+static int heapprof_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct heapprof_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = fs_heap_zalloc(sizeof(struct heapprof_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: heapprof_close
+ ****************************************************************************/
+
+static int heapprof_close(FAR struct file *filep)
+{
+  FAR struct heapprof_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct heapprof_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  fs_heap_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: heapprof_header
+ *
+ * Description:
+ *   Format the header line of the pprof format, with the totals of all
+ *   call sites.
+ *
+ ****************************************************************************/
+
+static size_t heapprof_header(FAR struct heapprof_file_s *attr)
+{
+  FAR struct heapprof_site_s *site = &attr->site;
+  size_t inuse_objs = 0;
+  size_t inuse_bytes = 0;
+  size_t alloc_objs = 0;
+  size_t alloc_bytes = 0;
+  int i;
+
+  for (i = 0; i < CONFIG_MM_HEAPPROF_NSITES; i++)
+    {
+      if (heapprof_getsite(i, site) == OK)
+        {
+          inuse_objs  += site->inuse_objs;
+          inuse_bytes += site->inuse_bytes;
+          alloc_objs  += site->alloc_objs;
+          alloc_bytes += site->alloc_bytes;
+        }
+    }
+
+  return procfs_snprintf(attr->line, HEAPPROF_LINELEN,
+                         "heap profile: %zu: %zu [%zu: %zu] @ heapprofile\n",
+                         inuse_objs, inuse_bytes, alloc_objs, alloc_bytes);
+}
+
+/****************************************************************************
+ * Name: heapprof_format
+ *
+ * Description:
+ *   Format call site 'index' into the line buffer.  Nothing is formatted
+ *   for a call site that is not used, or without memory in use in the
+ *   folded format.
+ *
+ ****************************************************************************/
+
+static size_t heapprof_format(FAR struct heapprof_file_s *attr, int index)
+{
+  FAR struct heapprof_site_s *site = &attr->site;
+  size_t linesize;
+  int i;
+
+  if (heapprof_getsite(index, site) < 0)
+    {
+      return 0;
+    }
+
+  if (g_heapprof_format == HEAPPROF_PPROF)
+    {
+      linesize = procfs_snprintf(attr->line, HEAPPROF_LINELEN,
+                                 "%zu: %zu [%zu: %zu] @",
+                                 site->inuse_objs, site->inuse_bytes,
+                                 site->alloc_objs, site->alloc_bytes);
+
+      for (i = 0; i < site->nframes; i++)
+        {
+          linesize += procfs_snprintf(attr->line + linesize,
+                                      HEAPPROF_LINELEN - linesize,
+                                      " 0x%" PRIxPTR,
+                                      (uintptr_t)site->frames[i]);
+        }
+    }
+  else
+    {
+      if (site->inuse_bytes == 0)
+        {
+          return 0;
+        }
+
+      /* The outer caller comes first, the frames are symbolized if
+       * CONFIG_ALLSYMS is enabled.
+       */
+
+      linesize = 0;
+      for (i = site->nframes - 1; i >= 0; i--)
+        {
+          linesize += procfs_snprintf(attr->line + linesize,
+                                      HEAPPROF_LINELEN - linesize,
+                                      i > 0 ? "%ps;" : "%ps",
+                                      site->frames[i]);
+        }
+
+      linesize += procfs_snprintf(attr->line + linesize,
+                                  HEAPPROF_LINELEN - linesize,
+                                  " %zu", site->inuse_bytes);
+    }
+
+  linesize += procfs_snprintf(attr->line + linesize,
+                              HEAPPROF_LINELEN - linesize, "\n");
+  return linesize;
+}
+
+/****************************************************************************
+ * Name: heapprof_read
+ ****************************************************************************/
+
+static ssize_t heapprof_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR struct heapprof_file_s *attr;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct heapprof_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset    = filep->f_pos;
+  totalsize = 0;
+
+  if (g_heapprof_format == HEAPPROF_PPROF)
+    {
+      linesize  = heapprof_header(attr);
+      totalsize = procfs_memcpy(attr->line, linesize, buffer, buflen,
+                                &offset);
+    }
+
+  /* The call sites change while they are read:  Each line is consistent,
+   * but the lines may not add up to the header.
+   */
+
+  for (i = 0; i < CONFIG_MM_HEAPPROF_NSITES && totalsize < buflen; i++)
+    {
+      linesize = heapprof_format(attr, i);
+      if (linesize > 0)
+        {
+          copysize = procfs_memcpy(attr->line, linesize,
+                                   buffer + totalsize,
+                                   buflen - totalsize, &offset);
+
+          totalsize += copysize;
+        }
+    }
+
+  /* Update the file position */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: heapprof_write
+ *
+ * Description:
+ *   Select the format with "pprof" or "folded", or clear the profile with
+ *   "reset".
+ *
+ ****************************************************************************/
+
+static ssize_t heapprof_write(FAR struct file *filep, FAR const char *buffer,
+                              size_t buflen)
+{
+  if (buflen >= 5 && strncmp(buffer, "pprof", 5) == 0)
+    {
+      g_heapprof_format = HEAPPROF_PPROF;
+    }
+  else if (buflen >= 6 && strncmp(buffer, "folded", 6) == 0)
+    {
+      g_heapprof_format = HEAPPROF_FOLDED;
+    }
+  else if (buflen >= 5 && strncmp(buffer, "reset", 5) == 0)
+    {
+      heapprof_reset();
+    }
+  else
+    {
+      return -EINVAL;
+    }
+
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: heapprof_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int heapprof_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct heapprof_file_s *oldattr;
+  FAR struct heapprof_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct heapprof_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = fs_heap_malloc(sizeof(struct heapprof_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct heapprof_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: heapprof_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int heapprof_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "heapprof" is the name for a read/write file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS && CONFIG_MM_HEAPPROF */
@@ -0,0 +1,333 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsidlepoll.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+#include <nuttx/sched.h>
+
+#include "fs_heap.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+     defined(CONFIG_SCHED_IDLE_POLL)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Output format, one column per CPU:
+ *
+ *     IDLE POLL       CPU0       CPU1
+ *         POLLS       1021        733
+ *          HITS        204        117
+ *    MAXLAT(us)          3          2
+ *      SPIN(us)      41650      30207
+ */
+
+#define IDLEPOLL_COLUMN   11
+#define IDLEPOLL_LINELEN  (IDLEPOLL_COLUMN * (CONFIG_SMP_NCPUS + 1) + 2)
+#define IDLEPOLL_NLINES   5
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct idlepoll_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  char line[IDLEPOLL_LINELEN];    /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     idlepoll_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     idlepoll_close(FAR struct file *filep);
+static ssize_t idlepoll_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     idlepoll_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     idlepoll_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_idlepoll_operations =
+{
+  idlepoll_open,      /* open */
+  idlepoll_close,     /* close */
+  idlepoll_read,      /* read */
+  NULL,               /* write */
+  NULL,               /* poll */
+
+  idlepoll_dup,       /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  idlepoll_stat       /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: idlepoll_open
+ ****************************************************************************/
+
+static int idlepoll_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct idlepoll_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = fs_heap_zalloc(sizeof(struct idlepoll_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: idlepoll_close
+ ****************************************************************************/
+
+static int idlepoll_close(FAR struct file *filep)
+{
+  FAR struct idlepoll_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct idlepoll_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  fs_heap_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: idlepoll_format
+ *
+ * Description:
+ *   Format line 'index' of the output into the line buffer.
+ *
+ ****************************************************************************/
+
+static size_t idlepoll_format(FAR struct idlepoll_file_s *attr, int index)
+{
+  static FAR const char * const labels[IDLEPOLL_NLINES] =
+  {
+    "IDLE POLL", "POLLS", "HITS", "MAXLAT(us)", "SPIN(us)"
+  };
+
+  FAR struct idle_poll_s *poll;
+  char name[IDLEPOLL_COLUMN];
+  size_t linesize;
+  uint64_t value;
+  int cpu;
+
+  linesize = procfs_snprintf(attr->line, IDLEPOLL_LINELEN, "%*s",
+                             IDLEPOLL_COLUMN, labels[index]);
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      poll = &g_idle_poll[cpu];
+
+      if (index == 0)
+        {
+          snprintf(name, sizeof(name), "CPU%d", cpu);
+          linesize += procfs_snprintf(attr->line + linesize,
+                                      IDLEPOLL_LINELEN - linesize,
+                                      " %*s", IDLEPOLL_COLUMN - 1, name);
+        }
+      else
+        {
+          value = index == 1 ? poll->polls :
+                  index == 2 ? poll->hits :
+                  index == 3 ? poll->maxlat : poll->spin;
+
+          linesize += procfs_snprintf(attr->line + linesize,
+                                      IDLEPOLL_LINELEN - linesize,
+                                      " %*" PRIu64, IDLEPOLL_COLUMN - 1,
+                                      value);
+        }
+    }
+
+  linesize += procfs_snprintf(attr->line + linesize,
+                              IDLEPOLL_LINELEN - linesize, "\n");
+  return linesize;
+}
+
+/****************************************************************************
+ * Name: idlepoll_read
+ ****************************************************************************/
+
+static ssize_t idlepoll_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR struct idlepoll_file_s *attr;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct idlepoll_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset    = filep->f_pos;
+  totalsize = 0;
+
+  /* The statistics are sampled without a lock:  The IDLE tasks may update
+   * them while they are formatted.
+   */
+
+  for (i = 0; i < IDLEPOLL_NLINES && totalsize < buflen; i++)
+    {
+      linesize = idlepoll_format(attr, i);
+      copysize = procfs_memcpy(attr->line, linesize, buffer + totalsize,
+                               buflen - totalsize, &offset);
+
+      totalsize += copysize;
+    }
+
+  /* Update the file position */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: idlepoll_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int idlepoll_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct idlepoll_file_s *oldattr;
+  FAR struct idlepoll_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct idlepoll_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = fs_heap_malloc(sizeof(struct idlepoll_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct idlepoll_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: idlepoll_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int idlepoll_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "idlepoll" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS && CONFIG_SCHED_IDLE_POLL */
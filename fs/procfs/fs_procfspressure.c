@@ -31,6 +31,8 @@
 
 #include <nuttx/fs/procfs.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/nuttx.h>
 #include <nuttx/queue.h>
@@ -60,6 +62,10 @@ static dq_queue_t g_pressure_memory_queue;
 static spinlock_t g_pressure_lock;
 static size_t g_remaining;
 static size_t g_largest;
+#if defined(CONFIG_MM_HEAP_MEMPOOL_RECLAIM) && \
+    CONFIG_MM_HEAP_MEMPOOL_RECLAIM_THRESHOLD > 0
+static clock_t g_reclaimtick;
+#endif
 
 /****************************************************************************
  * Private Function Prototypes
@@ -423,6 +429,35 @@ void mm_notify_pressure(size_t remaining, size_t largest)
   FAR dq_entry_t *tmp;
   uint32_t flags;
 
+#if defined(CONFIG_MM_HEAP_MEMPOOL_RECLAIM) && \
+    CONFIG_MM_HEAP_MEMPOOL_RECLAIM_THRESHOLD > 0
+  /* The heap runs short of large chunks: give the free expansions of its
+   * memory pools back before the listeners are told.
+   */
+
+  if (largest < CONFIG_MM_HEAP_MEMPOOL_RECLAIM_THRESHOLD &&
+      !up_interrupt_context())
+    {
+      bool reclaim = false;
+
+      flags = spin_lock_irqsave(&g_pressure_lock);
+      if (current - g_reclaimtick >=
+          MSEC2TICK(CONFIG_MM_HEAP_MEMPOOL_RECLAIM_INTERVAL))
+        {
+          g_reclaimtick = current;
+          reclaim = true;
+        }
+
+      spin_unlock_irqrestore(&g_pressure_lock, flags);
+
+      if (reclaim && mm_reclaim(USR_HEAP) > 0)
+        {
+          remaining = mm_heapfree(USR_HEAP);
+          largest   = mm_heapfree_largest(USR_HEAP);
+        }
+    }
+#endif
+
   flags       = spin_lock_irqsave(&g_pressure_lock);
   g_remaining = remaining;
   g_largest   = largest;
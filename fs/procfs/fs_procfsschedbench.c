@@ -0,0 +1,320 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsschedbench.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+#include <nuttx/sched.h>
+
+#include "fs_heap.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+     defined(CONFIG_SCHED_BENCHMARK)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Output format, one line per benchmark:
+ *
+ *   NAME       SAMPLES    MIN(ns)    AVG(ns)    MAX(ns)
+ *   ctxswitch     1000       1830       1912      10580
+ *   ...
+ */
+
+#define SCHEDBENCH_COLUMN    11
+#define SCHEDBENCH_LINELEN   (5 * SCHEDBENCH_COLUMN + 2)
+#define SCHEDBENCH_NRESULTS  8
+#define SCHEDBENCH_BUFSIZE   ((SCHEDBENCH_NRESULTS + 1) * SCHEDBENCH_LINELEN)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct schedbench_file_s
+{
+  struct procfs_file_s base;       /* Base open file structure */
+  size_t size;                     /* Size of the formatted results */
+  char buffer[SCHEDBENCH_BUFSIZE]; /* Formatted results */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     schedbench_open(FAR struct file *filep,
+                 FAR const char *relpath, int oflags, mode_t mode);
+static int     schedbench_close(FAR struct file *filep);
+static ssize_t schedbench_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     schedbench_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     schedbench_stat(FAR const char *relpath,
+                 FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_schedbench_operations =
+{
+  schedbench_open,      /* open */
+  schedbench_close,     /* close */
+  schedbench_read,      /* read */
+  NULL,                 /* write */
+  NULL,                 /* poll */
+
+  schedbench_dup,       /* dup */
+
+  NULL,                 /* opendir */
+  NULL,                 /* closedir */
+  NULL,                 /* readdir */
+  NULL,                 /* rewinddir */
+
+  schedbench_stat       /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: schedbench_open
+ ****************************************************************************/
+
+static int schedbench_open(FAR struct file *filep, FAR const char *relpath,
+                           int oflags, mode_t mode)
+{
+  FAR struct schedbench_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = fs_heap_zalloc(sizeof(struct schedbench_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: schedbench_close
+ ****************************************************************************/
+
+static int schedbench_close(FAR struct file *filep)
+{
+  FAR struct schedbench_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct schedbench_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  fs_heap_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: schedbench_format
+ *
+ * Description:
+ *   Run the benchmarks and format the results into the buffer.
+ *
+ ****************************************************************************/
+
+static size_t schedbench_format(FAR struct schedbench_file_s *attr)
+{
+  struct sched_benchmark_s results[SCHEDBENCH_NRESULTS];
+  size_t size;
+  int nresults;
+  int i;
+
+  size = procfs_snprintf(attr->buffer, SCHEDBENCH_BUFSIZE,
+                         "%-*s%*s%*s%*s%*s\n",
+                         SCHEDBENCH_COLUMN - 1, "NAME",
+                         SCHEDBENCH_COLUMN, "SAMPLES",
+                         SCHEDBENCH_COLUMN, "MIN(ns)",
+                         SCHEDBENCH_COLUMN, "AVG(ns)",
+                         SCHEDBENCH_COLUMN, "MAX(ns)");
+
+  nresults = nxsched_benchmark(results, SCHEDBENCH_NRESULTS);
+  for (i = 0; i < nresults; i++)
+    {
+      size += procfs_snprintf(attr->buffer + size,
+                              SCHEDBENCH_BUFSIZE - size,
+                              "%-*s%*" PRIu32 "%*" PRIu32 "%*" PRIu32
+                              "%*" PRIu32 "\n",
+                              SCHEDBENCH_COLUMN - 1, results[i].name,
+                              SCHEDBENCH_COLUMN, results[i].samples,
+                              SCHEDBENCH_COLUMN, results[i].min,
+                              SCHEDBENCH_COLUMN, results[i].avg,
+                              SCHEDBENCH_COLUMN, results[i].max);
+    }
+
+  return size;
+}
+
+/****************************************************************************
+ * Name: schedbench_read
+ ****************************************************************************/
+
+static ssize_t schedbench_read(FAR struct file *filep, FAR char *buffer,
+                               size_t buflen)
+{
+  FAR struct schedbench_file_s *attr;
+  off_t offset;
+  ssize_t ret;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct schedbench_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* The benchmarks are run when the file is read from the beginning.  The
+   * results are kept for the reads of the rest of the file.
+   */
+
+  if (filep->f_pos == 0)
+    {
+      attr->size = schedbench_format(attr);
+    }
+
+  offset = filep->f_pos;
+  ret = procfs_memcpy(attr->buffer, attr->size, buffer, buflen, &offset);
+
+  /* Update the file position */
+
+  if (ret > 0)
+    {
+      filep->f_pos += ret;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: schedbench_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int schedbench_dup(FAR const struct file *oldp,
+                          FAR struct file *newp)
+{
+  FAR struct schedbench_file_s *oldattr;
+  FAR struct schedbench_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct schedbench_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = fs_heap_malloc(sizeof(struct schedbench_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct schedbench_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: schedbench_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int schedbench_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "schedbench" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_SCHED_BENCHMARK */
@@ -0,0 +1,353 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsschedlat.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+#include <nuttx/sched.h>
+
+#include "fs_heap.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+     defined(CONFIG_SCHED_LATENCY)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Output format, one column per CPU:
+ *
+ *   LATENCY(us)       CPU0       CPU1
+ *       WAKEUPS        204        117
+ *       MAX(us)         61         48
+ *             0         93         40
+ *             2         71         52
+ *           ...
+ *
+ * The bucket lines are labeled with the lower bound of the bucket.
+ */
+
+#define SCHEDLAT_COLUMN   11
+#define SCHEDLAT_LINELEN  (SCHEDLAT_COLUMN * (CONFIG_SMP_NCPUS + 1) + 2)
+
+/* The header line, the wakeups, the maximum and then the buckets */
+
+#define SCHEDLAT_NLINES   (CONFIG_SCHED_LATENCY_NBUCKETS + 3)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct schedlat_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  char line[SCHEDLAT_LINELEN];    /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     schedlat_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     schedlat_close(FAR struct file *filep);
+static ssize_t schedlat_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     schedlat_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     schedlat_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_schedlat_operations =
+{
+  schedlat_open,      /* open */
+  schedlat_close,     /* close */
+  schedlat_read,      /* read */
+  NULL,               /* write */
+  NULL,               /* poll */
+
+  schedlat_dup,       /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  schedlat_stat       /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: schedlat_open
+ ****************************************************************************/
+
+static int schedlat_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct schedlat_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = fs_heap_zalloc(sizeof(struct schedlat_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: schedlat_close
+ ****************************************************************************/
+
+static int schedlat_close(FAR struct file *filep)
+{
+  FAR struct schedlat_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct schedlat_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  fs_heap_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: schedlat_format
+ *
+ * Description:
+ *   Format line 'index' of the output into the line buffer.
+ *
+ ****************************************************************************/
+
+static size_t schedlat_format(FAR struct schedlat_file_s *attr, int index)
+{
+  FAR struct sched_latency_s *latency;
+  char name[SCHEDLAT_COLUMN];
+  size_t linesize;
+  int bucket;
+  int cpu;
+
+  bucket = index - 3;
+
+  if (index == 0)
+    {
+      linesize = procfs_snprintf(attr->line, SCHEDLAT_LINELEN, "%*s",
+                                 SCHEDLAT_COLUMN, "LATENCY(us)");
+    }
+  else if (index == 1)
+    {
+      linesize = procfs_snprintf(attr->line, SCHEDLAT_LINELEN, "%*s",
+                                 SCHEDLAT_COLUMN, "WAKEUPS");
+    }
+  else if (index == 2)
+    {
+      linesize = procfs_snprintf(attr->line, SCHEDLAT_LINELEN, "%*s",
+                                 SCHEDLAT_COLUMN, "MAX(us)");
+    }
+  else
+    {
+      linesize = procfs_snprintf(attr->line, SCHEDLAT_LINELEN, "%*lu",
+                                 SCHEDLAT_COLUMN,
+                                 bucket > 0 ? 1ul << bucket : 0ul);
+    }
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      latency = &g_sched_latency[cpu];
+
+      if (index == 0)
+        {
+          snprintf(name, sizeof(name), "CPU%d", cpu);
+          linesize += procfs_snprintf(attr->line + linesize,
+                                      SCHEDLAT_LINELEN - linesize,
+                                      " %*s", SCHEDLAT_COLUMN - 1, name);
+        }
+      else
+        {
+          linesize += procfs_snprintf(attr->line + linesize,
+                                      SCHEDLAT_LINELEN - linesize,
+                                      " %*" PRIu32, SCHEDLAT_COLUMN - 1,
+                                      index == 1 ? latency->count :
+                                      index == 2 ? latency->max :
+                                      latency->hist[bucket]);
+        }
+    }
+
+  linesize += procfs_snprintf(attr->line + linesize,
+                              SCHEDLAT_LINELEN - linesize, "\n");
+  return linesize;
+}
+
+/****************************************************************************
+ * Name: schedlat_read
+ ****************************************************************************/
+
+static ssize_t schedlat_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR struct schedlat_file_s *attr;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct schedlat_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset    = filep->f_pos;
+  totalsize = 0;
+
+  /* The histograms are sampled without a lock:  A line may be off by the
+   * wakeups that happen while it is formatted.
+   */
+
+  for (i = 0; i < SCHEDLAT_NLINES && totalsize < buflen; i++)
+    {
+      linesize = schedlat_format(attr, i);
+      copysize = procfs_memcpy(attr->line, linesize, buffer + totalsize,
+                               buflen - totalsize, &offset);
+
+      totalsize += copysize;
+    }
+
+  /* Update the file position */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: schedlat_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int schedlat_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct schedlat_file_s *oldattr;
+  FAR struct schedlat_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct schedlat_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = fs_heap_malloc(sizeof(struct schedlat_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct schedlat_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: schedlat_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int schedlat_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "schedlat" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS && CONFIG_SCHED_LATENCY */
@@ -81,6 +81,7 @@ static int     romfs_dup(FAR const struct file *oldp,
                          FAR struct file *newp);
 static int     romfs_fstat(FAR const struct file *filep,
                            FAR struct stat *buf);
+static int     romfs_fileid(FAR struct file *filep, FAR ino_t *id);
 
 static int     romfs_opendir(FAR struct inode *mountpt,
                              FAR const char *relpath,
@@ -145,7 +146,9 @@ const struct mountpt_operations g_romfs_operations =
   NULL,            /* rmdir */
   NULL,            /* rename */
   romfs_stat,      /* stat */
-  NULL             /* chstat */
+  NULL,            /* chstat */
+  NULL,            /* syncfs */
+  romfs_fileid     /* fileid */
 };
 
 /****************************************************************************
@@ -618,6 +621,25 @@ static int romfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
           return -ENXIO;
         }
     }
+  else if (cmd == FIOC_EXTENT)
+    {
+      FAR struct romfs_mountpt_s *rm = filep->f_inode->i_private;
+      FAR struct file_extent_s *extent =
+        (FAR struct file_extent_s *)((uintptr_t)arg);
+
+      /* The data of a file is contiguous on the media and never changes */
+
+      if (extent == NULL || extent->offset < 0 ||
+          extent->offset > rf->rf_size)
+        {
+          return -EINVAL;
+        }
+
+      extent->blkdriver = rm->rm_blkdriver;
+      extent->devoffset = rf->rf_startoffset + extent->offset;
+      extent->length    = rf->rf_size - extent->offset;
+      return 0;
+    }
 
   return -ENOTTY;
 }
@@ -786,6 +808,24 @@ static int romfs_fstat(FAR const struct file *filep, FAR struct stat *buf)
   return ret;
 }
 
+/****************************************************************************
+ * Name: romfs_fileid
+ *
+ * Description
+ *   Return the offset of the data of an open file as its identifier.
+ *
+ ****************************************************************************/
+
+static int romfs_fileid(FAR struct file *filep, FAR ino_t *id)
+{
+  FAR struct romfs_file_s *rf = filep->f_priv;
+
+  DEBUGASSERT(rf != NULL);
+
+  *id = rf->rf_startoffset;
+  return OK;
+}
+
 /****************************************************************************
  * Name: romfs_opendir
  *
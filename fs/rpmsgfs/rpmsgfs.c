@@ -61,8 +61,9 @@ struct rpmsgfs_dir_s
   FAR void *dir;
 };
 
-/* This structure describes the state of one open file.  This structure
- * is protected by the volume semaphore.
+/* This structure describes the state of one open file.  The list and the
+ * reference count are protected by the volume lock, the rest by the lock of
+ * the file:  The operations on different files do not wait for each other.
  */
 
 struct rpmsgfs_ofile_s
@@ -71,6 +72,13 @@ struct rpmsgfs_ofile_s
   int16_t                    crefs;    /* Reference count */
   mode_t                     oflags;   /* Open mode */
   int                        fd;
+  mutex_t                    lock;     /* Serializes the file operations */
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  FAR char                   *rabuf;   /* Data read ahead, NULL if none */
+  size_t                     rapos;    /* Offset of the next byte to read */
+  size_t                     ralen;    /* Bytes of data in rabuf */
+  bool                       ranone;   /* Not a regular file, no read-ahead */
+#endif
 };
 
 /* This structure represents the overall mountpoint state.  An instance of
@@ -91,6 +99,14 @@ struct rpmsgfs_mountpt_s
  * Private Function Prototypes
  ****************************************************************************/
 
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+static ssize_t rpmsgfs_readahead(FAR struct rpmsgfs_mountpt_s *fs,
+                                 FAR struct rpmsgfs_ofile_s *hf,
+                                 FAR char *buffer, size_t buflen);
+static int     rpmsgfs_dropahead(FAR struct rpmsgfs_mountpt_s *fs,
+                                 FAR struct rpmsgfs_ofile_s *hf);
+#endif
+
 static int     rpmsgfs_open(FAR struct file *filep, FAR const char *relpath,
                             int oflags, mode_t mode);
 static int     rpmsgfs_close(FAR struct file *filep);
@@ -268,6 +284,92 @@ static void rpmsgfs_mkpath(FAR struct rpmsgfs_mountpt_s *fs,
     }
 }
 
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+/****************************************************************************
+ * Name: rpmsgfs_readahead
+ *
+ * Description:
+ *   Serve a small read from the data read ahead, refilled with a single
+ *   read of CONFIG_FS_RPMSGFS_READAHEAD bytes:  The server streams the
+ *   data in as many RPMSG buffers as needed, so a sequence of small reads
+ *   costs one round trip per buffer refill.  Only regular files are read
+ *   ahead, the data of the others cannot be given back.
+ *
+ ****************************************************************************/
+
+static ssize_t rpmsgfs_readahead(FAR struct rpmsgfs_mountpt_s *fs,
+                                 FAR struct rpmsgfs_ofile_s *hf,
+                                 FAR char *buffer, size_t buflen)
+{
+  struct stat buf;
+  ssize_t ret;
+
+  if (hf->rapos >= hf->ralen)
+    {
+      if (hf->rabuf == NULL && !hf->ranone)
+        {
+          ret = rpmsgfs_client_fstat(fs->handle, hf->fd, &buf);
+          if (ret >= 0 && S_ISREG(buf.st_mode))
+            {
+              hf->rabuf = fs_heap_malloc(CONFIG_FS_RPMSGFS_READAHEAD);
+            }
+
+          hf->ranone = hf->rabuf == NULL;
+        }
+
+      if (hf->rabuf == NULL)
+        {
+          return rpmsgfs_client_read(fs->handle, hf->fd, buffer, buflen);
+        }
+
+      ret = rpmsgfs_client_read(fs->handle, hf->fd, hf->rabuf,
+                                CONFIG_FS_RPMSGFS_READAHEAD);
+      if (ret <= 0)
+        {
+          return ret;
+        }
+
+      hf->rapos = 0;
+      hf->ralen = ret;
+    }
+
+  if (buflen > hf->ralen - hf->rapos)
+    {
+      buflen = hf->ralen - hf->rapos;
+    }
+
+  memcpy(buffer, hf->rabuf + hf->rapos, buflen);
+  hf->rapos += buflen;
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: rpmsgfs_dropahead
+ *
+ * Description:
+ *   Drop the data read ahead before any other operation on the file:  The
+ *   remote file position is moved back to the local one, and the next read
+ *   gets the data as changed meanwhile by the server.
+ *
+ ****************************************************************************/
+
+static int rpmsgfs_dropahead(FAR struct rpmsgfs_mountpt_s *fs,
+                             FAR struct rpmsgfs_ofile_s *hf)
+{
+  off_t ret = OK;
+
+  if (hf->rapos < hf->ralen)
+    {
+      ret = rpmsgfs_client_lseek(fs->handle, hf->fd,
+                                 -(off_t)(hf->ralen - hf->rapos), SEEK_CUR);
+    }
+
+  hf->rapos = 0;
+  hf->ralen = 0;
+  return ret < 0 ? ret : OK;
+}
+#endif
+
 /****************************************************************************
  * Name: rpmsgfs_open
  ****************************************************************************/
@@ -363,6 +465,13 @@ static int rpmsgfs_open(FAR struct file *filep, FAR const char *relpath,
   hf->fnext = fs->fs_head;
   hf->crefs = 1;
   hf->oflags = oflags;
+  nxmutex_init(&hf->lock);
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  hf->rabuf  = NULL;
+  hf->rapos  = 0;
+  hf->ralen  = 0;
+  hf->ranone = false;
+#endif
   fs->fs_head = hf;
 
   ret = OK;
@@ -464,6 +573,10 @@ static int rpmsgfs_close(FAR struct file *filep)
   /* Now free the pointer */
 
   filep->f_priv = NULL;
+  nxmutex_destroy(&hf->lock);
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  fs_heap_free(hf->rabuf);
+#endif
   fs_heap_free(hf);
 
 okout:
@@ -497,7 +610,7 @@ static ssize_t rpmsgfs_read(FAR struct file *filep, FAR char *buffer,
 
   /* Take the lock */
 
-  ret = nxmutex_lock(&fs->fs_lock);
+  ret = nxmutex_lock(&hf->lock);
   if (ret < 0)
     {
       return ret;
@@ -505,13 +618,23 @@ static ssize_t rpmsgfs_read(FAR struct file *filep, FAR char *buffer,
 
   /* Call the host to perform the read */
 
-  ret = rpmsgfs_client_read(fs->handle, hf->fd, buffer, buflen);
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  if (buflen < CONFIG_FS_RPMSGFS_READAHEAD || hf->rapos < hf->ralen)
+    {
+      ret = rpmsgfs_readahead(fs, hf, buffer, buflen);
+    }
+  else
+#endif
+    {
+      ret = rpmsgfs_client_read(fs->handle, hf->fd, buffer, buflen);
+    }
+
   if (ret > 0)
     {
       filep->f_pos += ret;
     }
 
-  nxmutex_unlock(&fs->fs_lock);
+  nxmutex_unlock(&hf->lock);
   return ret;
 }
 
@@ -539,7 +662,7 @@ static ssize_t rpmsgfs_write(FAR struct file *filep, const char *buffer,
 
   /* Take the lock */
 
-  ret = nxmutex_lock(&fs->fs_lock);
+  ret = nxmutex_lock(&hf->lock);
   if (ret < 0)
     {
       return ret;
@@ -557,6 +680,14 @@ static ssize_t rpmsgfs_write(FAR struct file *filep, const char *buffer,
 
   /* Call the host to perform the write */
 
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  ret = rpmsgfs_dropahead(fs, hf);
+  if (ret < 0)
+    {
+      goto errout_with_lock;
+    }
+#endif
+
   ret = rpmsgfs_client_write(fs->handle, hf->fd, buffer, buflen);
   if (ret > 0)
     {
@@ -564,7 +695,7 @@ static ssize_t rpmsgfs_write(FAR struct file *filep, const char *buffer,
     }
 
 errout_with_lock:
-  nxmutex_unlock(&fs->fs_lock);
+  nxmutex_unlock(&hf->lock);
   return ret;
 }
 
@@ -593,13 +724,25 @@ static off_t rpmsgfs_seek(FAR struct file *filep, off_t offset, int whence)
 
   /* Take the lock */
 
-  ret = nxmutex_lock(&fs->fs_lock);
+  ret = nxmutex_lock(&hf->lock);
   if (ret < 0)
     {
       return ret;
     }
 
-  /* Call our internal routine to perform the seek */
+  /* Call our internal routine to perform the seek.  The remote position
+   * is past the data read ahead, that is dropped.
+   */
+
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  if (whence == SEEK_CUR)
+    {
+      offset -= hf->ralen - hf->rapos;
+    }
+
+  hf->rapos = 0;
+  hf->ralen = 0;
+#endif
 
   ret = rpmsgfs_client_lseek(fs->handle, hf->fd, offset, whence);
   if (ret >= 0)
@@ -607,7 +750,7 @@ static off_t rpmsgfs_seek(FAR struct file *filep, off_t offset, int whence)
       filep->f_pos = ret;
     }
 
-  nxmutex_unlock(&fs->fs_lock);
+  nxmutex_unlock(&hf->lock);
   return ret;
 }
 
@@ -636,7 +779,7 @@ static int rpmsgfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
   /* Take the lock */
 
-  ret = nxmutex_lock(&fs->fs_lock);
+  ret = nxmutex_lock(&hf->lock);
   if (ret < 0)
     {
       return ret;
@@ -644,13 +787,17 @@ static int rpmsgfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
   /* Call our internal routine to perform the ioctl */
 
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  rpmsgfs_dropahead(fs, hf);
+#endif
+
   ret = rpmsgfs_client_ioctl(fs->handle, hf->fd, cmd, arg);
   if (ret == 0 && (cmd == FIONBIO || cmd == FIOCLEX || cmd == FIONCLEX))
     {
       ret = -ENOTTY;
     }
 
-  nxmutex_unlock(&fs->fs_lock);
+  nxmutex_unlock(&hf->lock);
   return ret;
 }
 
@@ -683,15 +830,19 @@ static int rpmsgfs_sync(FAR struct file *filep)
 
   /* Take the lock */
 
-  ret = nxmutex_lock(&fs->fs_lock);
+  ret = nxmutex_lock(&hf->lock);
   if (ret < 0)
     {
       return ret;
     }
 
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  rpmsgfs_dropahead(fs, hf);
+#endif
+
   rpmsgfs_client_sync(fs->handle, hf->fd);
 
-  nxmutex_unlock(&fs->fs_lock);
+  nxmutex_unlock(&hf->lock);
   return OK;
 }
 
@@ -757,7 +908,7 @@ static int rpmsgfs_fstat(FAR const struct file *filep, FAR struct stat *buf)
 
   /* Take the lock */
 
-  ret = nxmutex_lock(&fs->fs_lock);
+  ret = nxmutex_lock(&hf->lock);
   if (ret < 0)
     {
       return ret;
@@ -767,7 +918,7 @@ static int rpmsgfs_fstat(FAR const struct file *filep, FAR struct stat *buf)
 
   ret = rpmsgfs_client_fstat(fs->handle, hf->fd, buf);
 
-  nxmutex_unlock(&fs->fs_lock);
+  nxmutex_unlock(&hf->lock);
   return ret;
 }
 
@@ -803,7 +954,7 @@ static int rpmsgfs_fchstat(FAR const struct file *filep,
 
   /* Take the lock */
 
-  ret = nxmutex_lock(&fs->fs_lock);
+  ret = nxmutex_lock(&hf->lock);
   if (ret < 0)
     {
       return ret;
@@ -811,9 +962,13 @@ static int rpmsgfs_fchstat(FAR const struct file *filep,
 
   /* Call the host to perform the change */
 
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  rpmsgfs_dropahead(fs, hf);
+#endif
+
   ret = rpmsgfs_client_fchstat(fs->handle, hf->fd, buf, flags);
 
-  nxmutex_unlock(&fs->fs_lock);
+  nxmutex_unlock(&hf->lock);
   return ret;
 }
 
@@ -844,7 +999,7 @@ static int rpmsgfs_truncate(FAR struct file *filep, off_t length)
 
   /* Take the lock */
 
-  ret = nxmutex_lock(&fs->fs_lock);
+  ret = nxmutex_lock(&hf->lock);
   if (ret < 0)
     {
       return ret;
@@ -852,9 +1007,13 @@ static int rpmsgfs_truncate(FAR struct file *filep, off_t length)
 
   /* Call the host to perform the truncate */
 
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  rpmsgfs_dropahead(fs, hf);
+#endif
+
   ret = rpmsgfs_client_ftruncate(fs->handle, hf->fd, length);
 
-  nxmutex_unlock(&fs->fs_lock);
+  nxmutex_unlock(&hf->lock);
   return ret;
 }
 
@@ -274,21 +274,6 @@ static int rpmsgfs_stat_handler(FAR struct rpmsg_endpoint *ept,
   return 0;
 }
 
-static FAR void *rpmsgfs_get_tx_payload_buffer(FAR struct rpmsgfs_s *priv,
-                                               FAR uint32_t *len)
-{
-  int sval;
-
-  nxsem_get_value(&priv->wait, &sval);
-  if (sval <= 0)
-    {
-      rpmsg_wait(&priv->ept, &priv->wait);
-      rpmsg_post(&priv->ept, &priv->wait);
-    }
-
-  return rpmsg_get_tx_payload_buffer(&priv->ept, len, true);
-}
-
 static void rpmsgfs_ns_bound(struct rpmsg_endpoint *ept)
 {
   FAR struct rpmsgfs_s *priv = ept->priv;
@@ -368,16 +353,11 @@ static int rpmsgfs_send_recv(FAR struct rpmsgfs_s *priv,
     }
   else
     {
-      ret = rpmsg_send_nocopy(&priv->ept, msg, len);
+      ret = rpmsg_commit(&priv->ept, msg, len);
     }
 
   if (ret < 0)
     {
-      if (copy == false)
-        {
-          rpmsg_release_tx_buffer(&priv->ept, msg);
-        }
-
       goto fail;
     }
 
@@ -431,7 +411,7 @@ int rpmsgfs_client_open(FAR void *handle, FAR const char *pathname,
 
   len = sizeof(*msg) + strlen(pathname) + 1;
 
-  msg = rpmsgfs_get_tx_payload_buffer(priv, &space);
+  msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
   if (!msg)
     {
       return -ENOMEM;
@@ -528,7 +508,7 @@ ssize_t rpmsgfs_client_write(FAR void *handle, int fd,
       FAR struct rpmsgfs_write_s *msg;
       uint32_t space;
 
-      msg = rpmsgfs_get_tx_payload_buffer(priv, &space);
+      msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
       if (!msg)
         {
           ret = -ENOMEM;
@@ -552,10 +532,9 @@ ssize_t rpmsgfs_client_write(FAR void *handle, int fd,
       msg->count          = space;
       memcpy(msg->buf, buf + written, space);
 
-      ret = rpmsg_send_nocopy(&priv->ept, msg, sizeof(*msg) + space);
+      ret = rpmsg_commit(&priv->ept, msg, sizeof(*msg) + space);
       if (ret < 0)
         {
-          rpmsg_release_tx_buffer(&priv->ept, msg);
           goto out;
         }
 
@@ -608,7 +587,7 @@ int rpmsgfs_client_ioctl(FAR void *handle, int fd,
 
   while (1)
     {
-      msg = rpmsgfs_get_tx_payload_buffer(priv, &space);
+      msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
       if (msg == NULL)
         {
           return -ENOMEM;
@@ -695,7 +674,7 @@ FAR void *rpmsgfs_client_opendir(FAR void *handle, FAR const char *name)
 
   len = sizeof(*msg) + strlen(name) + 1;
 
-  msg = rpmsgfs_get_tx_payload_buffer(priv, &space);
+  msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
   if (!msg)
     {
       return NULL;
@@ -805,7 +784,7 @@ int rpmsgfs_client_statfs(FAR void *handle, FAR const char *path,
 
   len = sizeof(*msg) + strlen(path) + 1;
 
-  msg = rpmsgfs_get_tx_payload_buffer(priv, &space);
+  msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
   if (!msg)
     {
       return -ENOMEM;
@@ -828,7 +807,7 @@ int rpmsgfs_client_unlink(FAR void *handle, FAR const char *pathname)
 
   len = sizeof(*msg) + strlen(pathname) + 1;
 
-  msg = rpmsgfs_get_tx_payload_buffer(priv, &space);
+  msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
   if (!msg)
     {
       return -ENOMEM;
@@ -852,7 +831,7 @@ int rpmsgfs_client_mkdir(FAR void *handle, FAR const char *pathname,
 
   len = sizeof(*msg) + strlen(pathname) + 1;
 
-  msg = rpmsgfs_get_tx_payload_buffer(priv, &space);
+  msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
   if (!msg)
     {
       return -ENOMEM;
@@ -874,7 +853,7 @@ int rpmsgfs_client_rmdir(FAR void *handle, FAR const char *pathname)
 
   len = sizeof(*msg) + strlen(pathname) + 1;
 
-  msg = rpmsgfs_get_tx_payload_buffer(priv, &space);
+  msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
   if (!msg)
     {
       return -ENOMEM;
@@ -904,7 +883,7 @@ int rpmsgfs_client_rename(FAR void *handle, FAR const char *oldpath,
   newlen   = strlen(newpath) + 1;
   len      = sizeof(*msg) + alignlen + newlen;
 
-  msg = rpmsgfs_get_tx_payload_buffer(priv, &space);
+  msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
   if (!msg)
     {
       return -ENOMEM;
@@ -929,7 +908,7 @@ int rpmsgfs_client_stat(FAR void *handle, FAR const char *path,
 
   len = sizeof(*msg) + strlen(path) + 1;
 
-  msg = rpmsgfs_get_tx_payload_buffer(priv, &space);
+  msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
   if (!msg)
     {
       return -ENOMEM;
@@ -982,7 +961,7 @@ int rpmsgfs_client_chstat(FAR void *handle, FAR const char *path,
 
   len = sizeof(*msg) + strlen(path) + 1;
 
-  msg = rpmsgfs_get_tx_payload_buffer(priv, &space);
+  msg = rpmsg_reserve(&priv->ept, &priv->wait, &space);
   if (!msg)
     {
       return -ENOMEM;
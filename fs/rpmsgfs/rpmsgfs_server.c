@@ -370,7 +370,7 @@ static int rpmsgfs_read_handler(FAR struct rpmsg_endpoint *ept,
 
   while (read < msg->count)
     {
-      rsp = rpmsg_get_tx_payload_buffer(ept, &space, true);
+      rsp = rpmsg_reserve(ept, NULL, &space);
       if (rsp == NULL)
         {
           return -ENOMEM;
@@ -390,11 +390,7 @@ static int rpmsgfs_read_handler(FAR struct rpmsg_endpoint *ept,
         }
 
       rsp->header.result = ret;
-      if (rpmsg_send_nocopy(ept, rsp, (ret < 0 ? 0 : ret) + sizeof(*rsp))
-          < 0)
-        {
-          rpmsg_release_tx_buffer(ept, rsp);
-        }
+      rpmsg_commit(ept, rsp, (ret < 0 ? 0 : ret) + sizeof(*rsp));
 
       if (ret <= 0)
         {
@@ -23,6 +23,7 @@
  ****************************************************************************/
 
 #include <assert.h>
+#include <sys/mman.h>
 
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/mm/map.h>
@@ -223,7 +224,8 @@ static int shmfs_truncate(FAR struct file *filep, off_t length)
   object = filep->f_inode->i_private;
   if (!object)
     {
-      filep->f_inode->i_private = shmfs_alloc_object(length);
+      filep->f_inode->i_private =
+        shmfs_alloc_object(length, (filep->f_oflags & MFD_HUGETLB) != 0);
       if (!filep->f_inode->i_private)
         {
           filep->f_inode->i_size = 0;
@@ -262,6 +264,67 @@ static int shmfs_unlink(FAR struct inode *inode)
 }
 #endif
 
+/****************************************************************************
+ * Name: shmfs_map_huge
+ *
+ * Description:
+ *   Map the huge pages of the shm object at a virtual address aligned to
+ *   the huge pages, so that each huge page takes a single translation
+ *   table entry.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_BUILD_KERNEL) && defined(CONFIG_MM_HUGEPAGE)
+static int shmfs_map_huge(FAR struct shmfs_object_s *object,
+                          FAR void **vaddr)
+{
+  FAR struct mm_map_s *mm = get_current_mm();
+  FAR uintptr_t *pages = (FAR uintptr_t *)&object->paddr;
+  unsigned int nhuge = MM_NHUGEPAGES(object->length);
+  size_t size = (size_t)nhuge << MM_HUGEPGSHIFT;
+  size_t extra = MM_HUGEPGSIZE - MM_PGSIZE;
+  uintptr_t region;
+  uintptr_t mapaddr;
+  int ret;
+
+  /* Find a free vaddr space with room to align it, then give back the
+   * pages before and after the aligned area.
+   */
+
+  region = (uintptr_t)vm_alloc_region(mm, 0, size + extra);
+  if (region == 0)
+    {
+      return -ENOMEM;
+    }
+
+  mapaddr = MM_HUGEPGALIGNUP(region);
+  if (mapaddr > region)
+    {
+      vm_release_region(mm, (FAR void *)region, mapaddr - region);
+    }
+
+  if (region + extra > mapaddr)
+    {
+      vm_release_region(mm, (FAR void *)(mapaddr + size),
+                        region + extra - mapaddr);
+    }
+
+  /* Map the memory to user virtual address space */
+
+  ret = up_shmat_huge(pages, nhuge, mapaddr);
+  if (ret < 0)
+    {
+      vm_release_region(mm, (FAR void *)mapaddr, size);
+    }
+  else
+    {
+      *vaddr = (FAR void *)mapaddr;
+    }
+
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: shmfs_map_object
  ****************************************************************************/
@@ -272,6 +335,13 @@ static int shmfs_map_object(FAR struct shmfs_object_s *object,
   int ret = OK;
 
 #ifdef CONFIG_BUILD_KERNEL
+#  ifdef CONFIG_MM_HUGEPAGE
+  if (object->hugepage)
+    {
+      return shmfs_map_huge(object, vaddr);
+    }
+#  endif
+
   /* Map the physical pages of the shm object with MMU. */
 
   FAR struct tcb_s *tcb = this_task();
@@ -368,6 +438,7 @@ static int shmfs_mmap(FAR struct file *filep,
  ****************************************************************************/
 
 static int shmfs_unmap_area(FAR struct task_group_s *group,
+                            FAR struct shmfs_object_s *object,
                             FAR void *vaddr, size_t length)
 {
   int ret = OK;
@@ -375,6 +446,24 @@ static int shmfs_unmap_area(FAR struct task_group_s *group,
 #ifdef CONFIG_BUILD_KERNEL
   unsigned int npages;
 
+#  ifdef CONFIG_MM_HUGEPAGE
+  if (group && object->hugepage)
+    {
+      npages = MM_NHUGEPAGES(length);
+
+      /* Unmap the huge pages and free their aligned virtual address space */
+
+      ret = up_shmdt_huge((uintptr_t)vaddr, npages);
+      if (ret == OK)
+        {
+          vm_release_region(get_group_mm(group), vaddr,
+                            (size_t)npages << MM_HUGEPGSHIFT);
+        }
+
+      return ret;
+    }
+#  endif
+
   /* Convert the region size to pages */
 
   if (group)
@@ -425,7 +514,8 @@ static int shmfs_munmap(FAR struct task_group_s *group,
 
   /* Unmap the virtual memory area from the user's address space */
 
-  ret = shmfs_unmap_area(group, entry->vaddr, entry->length);
+  ret = shmfs_unmap_area(group, inode->i_private, entry->vaddr,
+                         entry->length);
 
   /* Release the shmfs object. The object gets deleted if no-one has
    * reference to it (either mmap or open file) and the object has been
@@ -43,6 +43,14 @@ struct shmfs_object_s
 
   size_t length;
 
+#if defined(CONFIG_BUILD_KERNEL) && defined(CONFIG_MM_HUGEPAGE)
+  /* The vector holds huge pages of MM_HUGEPGSIZE bytes, and the length of
+   * the vector is MM_NHUGEPAGES(length).
+   */
+
+  bool hugepage;
+#endif
+
   /* Vector of allocations from physical memory.
    *
    * - In flat and protected builds this is a pointer to the
@@ -63,7 +71,7 @@ struct shmfs_object_s
  * Public Function Prototypes
  ****************************************************************************/
 
-FAR struct shmfs_object_s *shmfs_alloc_object(size_t length);
+FAR struct shmfs_object_s *shmfs_alloc_object(size_t length, bool hugepage);
 
 void shmfs_free_object(FAR struct shmfs_object_s *object);
 
@@ -35,11 +35,65 @@
 #include "shm/shmfs.h"
 #include "fs_heap.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#if defined(CONFIG_BUILD_KERNEL) && defined(CONFIG_MM_HUGEPAGE)
+static FAR struct shmfs_object_s *shmfs_alloc_huge(size_t length)
+{
+  FAR struct shmfs_object_s *object;
+  FAR void **pages;
+  size_t n_pages = MM_NHUGEPAGES(length);
+  size_t i;
+  size_t j;
+
+  object = fs_heap_zalloc(sizeof(struct shmfs_object_s) +
+                          (n_pages - 1) * sizeof(object->paddr));
+  if (object == NULL)
+    {
+      return NULL;
+    }
+
+  pages = &object->paddr;
+  for (i = 0; i < n_pages; i++)
+    {
+      pages[i] = (FAR void *)mm_pgalloc_huge();
+      if (!pages[i])
+        {
+          break;
+        }
+
+      /* Clear the page memory (requirement for truncate) */
+
+      for (j = 0; j < MM_HUGEPGPAGES; j++)
+        {
+          up_addrenv_page_wipe((uintptr_t)pages[i] + j * MM_PGSIZE);
+        }
+    }
+
+  if (i < n_pages)
+    {
+      while (i-- > 0)
+        {
+          mm_pgfree_huge((uintptr_t)pages[i]);
+        }
+
+      fs_heap_free(object);
+      return NULL;
+    }
+
+  object->hugepage = true;
+  object->length   = length;
+  return object;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
-FAR struct shmfs_object_s *shmfs_alloc_object(size_t length)
+FAR struct shmfs_object_s *shmfs_alloc_object(size_t length, bool hugepage)
 {
   FAR struct shmfs_object_s *object;
   bool allocated = false;
@@ -103,6 +157,19 @@ FAR struct shmfs_object_s *shmfs_alloc_object(size_t length)
   FAR void **pages;
   size_t n_pages = MM_NPAGES(length);
 
+#  ifdef CONFIG_MM_HUGEPAGE
+  if (hugepage)
+    {
+      object = shmfs_alloc_huge(length);
+      if (object != NULL)
+        {
+          return object;
+        }
+
+      /* The pool of huge pages is exhausted, use small pages */
+    }
+#  endif
+
   object = fs_heap_zalloc(sizeof(struct shmfs_object_s) +
                       (n_pages - 1) * sizeof(object->paddr));
 
@@ -158,6 +225,20 @@ void shmfs_free_object(FAR struct shmfs_object_s *object)
       size_t i;
       size_t n_pages = MM_NPAGES(object->length);
       FAR void **pages = &object->paddr;
+
+#  ifdef CONFIG_MM_HUGEPAGE
+      if (object->hugepage)
+        {
+          for (i = 0; i < MM_NHUGEPAGES(object->length); i++)
+            {
+              mm_pgfree_huge((uintptr_t)pages[i]);
+            }
+
+          fs_heap_free(object);
+          return;
+        }
+#  endif
+
       for (i = 0; i < n_pages; i++)
         {
           if (pages[i])
@@ -33,6 +33,7 @@
 
 #include <nuttx/mtd/mtd.h>
 #include <nuttx/fs/smart.h>
+#include <nuttx/wqueue.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -327,6 +328,10 @@ struct smartfs_mountpt_s
   FAR char                     *fs_rwbuffer;   /* Read/Write working buffer */
   FAR char                     *fs_workbuffer; /* Working buffer */
   uint8_t                       fs_rootsector; /* Root directory sector num */
+#ifdef CONFIG_SMARTFS_BGCOLLECT
+  struct work_s                 fs_collect;    /* Background garbage collection */
+  bool                          fs_collecting; /* Below the free watermark */
+#endif
 };
 
 /****************************************************************************
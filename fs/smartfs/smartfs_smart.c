@@ -119,6 +119,13 @@ static int     smartfs_stat(FAR struct inode *mountpt,
                         FAR const char *relpath,
                         FAR struct stat *buf);
 
+#ifdef CONFIG_SMARTFS_BGCOLLECT
+static void    smartfs_collect_worker(FAR void *arg);
+static void    smartfs_collect(FAR struct smartfs_mountpt_s *fs);
+#else
+#  define smartfs_collect(fs)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -172,6 +179,75 @@ const struct mountpt_operations g_smartfs_operations =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: smartfs_collect_worker
+ *
+ * Description: Reclaim the released sectors of one erase block on the low
+ *   priority work queue, and queue the next step at once while the volume
+ *   has fewer free sectors than the watermark.  The foreground operations
+ *   take the lock between the steps.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMARTFS_BGCOLLECT
+static void smartfs_collect_worker(FAR void *arg)
+{
+  FAR struct smartfs_mountpt_s *fs = arg;
+  unsigned long minfree;
+  int ret;
+
+  /* Do not wait for the foreground operations:  The next write or unlink
+   * queues the work again.  smartfs_unbind() cancels the work with the lock
+   * held, so the work is never queued again behind its back.
+   */
+
+  if (nxmutex_trylock(&g_lock) < 0)
+    {
+      return;
+    }
+
+  minfree = (unsigned long)fs->fs_llformat.nsectors *
+            CONFIG_SMARTFS_BGCOLLECT_WATERMARK / 100;
+
+  ret = FS_IOCTL(fs, BIOC_COLLECT, minfree);
+  if (ret < 0)
+    {
+      ferr("ERROR: Background garbage collection failed: %d\n", ret);
+    }
+
+  fs->fs_collecting = ret > 0;
+  if (fs->fs_collecting)
+    {
+      work_queue(LPWORK, &fs->fs_collect, smartfs_collect_worker, fs, 0);
+    }
+
+  nxmutex_unlock(&g_lock);
+}
+
+/****************************************************************************
+ * Name: smartfs_collect
+ *
+ * Description: Queue the background garbage collection once a volume has
+ *   been idle for CONFIG_SMARTFS_BGCOLLECT_DELAY milliseconds.  While the
+ *   volume is below the watermark, the collection is not delayed by the
+ *   new writes.  The caller holds the lock.
+ *
+ ****************************************************************************/
+
+static void smartfs_collect(FAR struct smartfs_mountpt_s *fs)
+{
+  if (!fs->fs_collecting)
+    {
+      work_queue(LPWORK, &fs->fs_collect, smartfs_collect_worker, fs,
+                 MSEC2TICK(CONFIG_SMARTFS_BGCOLLECT_DELAY));
+    }
+  else if (work_available(&fs->fs_collect))
+    {
+      work_queue(LPWORK, &fs->fs_collect, smartfs_collect_worker, fs, 0);
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: smartfs_open
  ****************************************************************************/
@@ -952,6 +1028,7 @@ static ssize_t smartfs_write(FAR struct file *filep, FAR const char *buffer,
     }
 
   ret = byteswritten;
+  smartfs_collect(fs);
 
 errout_with_lock:
   nxmutex_unlock(&g_lock);
@@ -1615,6 +1692,9 @@ static int smartfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
     {
       /* Unmount ... close the block driver */
 
+#ifdef CONFIG_SMARTFS_BGCOLLECT
+      work_cancel_sync(LPWORK, &fs->fs_collect);
+#endif
       ret = smartfs_unmount(fs);
     }
 
@@ -1726,6 +1806,7 @@ static int smartfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
        */
 
       smartfs_deleteentry(fs, &entry);
+      smartfs_collect(fs);
     }
   else
     {
@@ -29,8 +29,11 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/mm/mm.h>
 
+#include <sys/param.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <assert.h>
+#include <string.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <debug.h>
@@ -52,7 +55,13 @@ static int sock_file_ioctl(FAR struct file *filep, int cmd,
                            unsigned long arg);
 static int sock_file_poll(FAR struct file *filep, struct pollfd *fds,
                           bool setup);
+static int sock_file_mmap(FAR struct file *filep,
+                          FAR struct mm_map_entry_s *map);
 static int sock_file_truncate(FAR struct file *filep, off_t length);
+static ssize_t sock_file_readv(FAR struct file *filep,
+                               FAR const struct iovec *iov, int iovcnt);
+static ssize_t sock_file_writev(FAR struct file *filep,
+                                FAR const struct iovec *iov, int iovcnt);
 
 /****************************************************************************
  * Private Data
@@ -66,9 +75,14 @@ static const struct file_operations g_sock_fileops =
   sock_file_write,    /* write */
   NULL,               /* seek */
   sock_file_ioctl,    /* ioctl */
-  NULL,               /* mmap */
+  sock_file_mmap,     /* mmap */
   sock_file_truncate, /* truncate */
-  sock_file_poll      /* poll */
+  sock_file_poll,     /* poll */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  NULL,               /* unlink */
+#endif
+  sock_file_readv,    /* readv */
+  sock_file_writev    /* writev */
 };
 
 static struct inode g_sock_inode =
@@ -142,11 +156,110 @@ static int sock_file_poll(FAR struct file *filep, FAR struct pollfd *fds,
   return psock_poll(filep->f_priv, fds, setup);
 }
 
+static int sock_file_mmap(FAR struct file *filep,
+                          FAR struct mm_map_entry_s *map)
+{
+  FAR struct socket *psock = filep->f_priv;
+
+  /* A socket is never copied to memory by rammap() */
+
+  if (psock->s_sockif == NULL || psock->s_sockif->si_mmap == NULL)
+    {
+      return -ENODEV;
+    }
+
+  return psock->s_sockif->si_mmap(psock, map);
+}
+
 static int sock_file_truncate(FAR struct file *filep, off_t length)
 {
   return -EINVAL;
 }
 
+static ssize_t sock_file_readv(FAR struct file *filep,
+                               FAR const struct iovec *iov, int iovcnt)
+{
+  FAR struct socket *psock = filep->f_priv;
+  FAR uint8_t *buffer;
+  ssize_t nread = 0;
+  ssize_t ret;
+  size_t len = 0;
+  int i;
+
+  if (psock->s_type == SOCK_STREAM || iovcnt == 1)
+    {
+      /* Only the first buffer waits for data, the next ones take the data
+       * already received.
+       */
+
+      for (i = 0; i < iovcnt; i++)
+        {
+          if (iov[i].iov_len == 0)
+            {
+              continue;
+            }
+
+          ret = psock_recv(psock, iov[i].iov_base, iov[i].iov_len,
+                           nread > 0 ? MSG_DONTWAIT : 0);
+          if (ret <= 0)
+            {
+              return nread > 0 ? nread : ret;
+            }
+
+          nread += ret;
+          if ((size_t)ret < iov[i].iov_len)
+            {
+              break;
+            }
+        }
+
+      return nread;
+    }
+
+  /* A message is received at once, then scattered over the buffers */
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      len += iov[i].iov_len;
+    }
+
+  buffer = fs_heap_malloc(len > 0 ? len : 1);
+  if (buffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ret = psock_recv(psock, buffer, len, 0);
+  for (i = 0; i < iovcnt && nread < ret; i++)
+    {
+      len = MIN(iov[i].iov_len, (size_t)(ret - nread));
+      memcpy(iov[i].iov_base, buffer + nread, len);
+      nread += len;
+    }
+
+  fs_heap_free(buffer);
+  return ret;
+}
+
+static ssize_t sock_file_writev(FAR struct file *filep,
+                                FAR const struct iovec *iov, int iovcnt)
+{
+  struct msghdr msg;
+
+  if (iovcnt == 0)
+    {
+      return 0;
+    }
+
+  /* The socket gathers the buffers in a single send */
+
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov    = (FAR struct iovec *)iov;
+  msg.msg_iovlen = iovcnt;
+
+  return psock_sendmsg(filep->f_priv, &msg, 0);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -172,6 +285,29 @@ int sockfd_allocate(FAR struct socket *psock, int oflags)
   return file_allocate(&g_sock_inode, oflags, 0, psock, 0, true);
 }
 
+/****************************************************************************
+ * Name: sockfd_allocate_from_tcb
+ *
+ * Description:
+ *   Allocate a socket descriptor in the descriptor table of another task.
+ *
+ * Input Parameters:
+ *   tcb      The task that owns the new descriptor.
+ *   psock    A pointer to socket structure.
+ *   oflags   Open mode flags.
+ *
+ * Returned Value:
+ *   The new socket descriptor, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int sockfd_allocate_from_tcb(FAR struct tcb_s *tcb,
+                             FAR struct socket *psock, int oflags)
+{
+  return file_allocate_from_tcb(tcb, &g_sock_inode, oflags, 0, psock, 0,
+                                true);
+}
+
 /****************************************************************************
  * Name: sockfd_socket
  *
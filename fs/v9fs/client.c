@@ -535,6 +535,49 @@ static void v9fs_fid_destroy(FAR struct v9fs_client_s *client,
   fs_heap_free(fidp);
 }
 
+/****************************************************************************
+ * v9fs_client_send
+ ****************************************************************************/
+
+static int v9fs_client_send(FAR struct v9fs_transport_s *transport,
+                            FAR struct v9fs_payload_s *payload,
+                            FAR struct iovec *wiov, size_t wcount,
+                            FAR struct iovec *riov, size_t rcount,
+                            uint16_t tag)
+{
+  int ret;
+
+  nxsem_init(&payload->resp, 0, 0);
+  payload->wiov = wiov;
+  payload->riov = riov;
+  payload->wcount = wcount;
+  payload->rcount = rcount;
+  payload->tag = tag;
+  payload->ret = -EIO;
+
+  ret = v9fs_transport_request(transport, payload);
+  if (ret < 0)
+    {
+      nxsem_destroy(&payload->resp);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * v9fs_client_wait
+ ****************************************************************************/
+
+static int v9fs_client_wait(FAR struct v9fs_payload_s *payload)
+{
+  /* The buffers of the request stay in use until the server answers */
+
+  nxsem_wait_uninterruptible(&payload->resp);
+  nxsem_destroy(&payload->resp);
+
+  return payload->ret;
+}
+
 /****************************************************************************
  * v9fs_client_rpc
  ****************************************************************************/
@@ -547,25 +590,14 @@ static int v9fs_client_rpc(FAR struct v9fs_transport_s *transport,
   struct v9fs_payload_s payload;
   int ret;
 
-  nxsem_init(&payload.resp, 0, 0);
-  payload.wiov = wiov;
-  payload.riov = riov;
-  payload.wcount = wcount;
-  payload.rcount = rcount;
-  payload.tag = tag;
-  payload.ret = -EIO;
-
-  ret = v9fs_transport_request(transport, &payload);
+  ret = v9fs_client_send(transport, &payload, wiov, wcount, riov, rcount,
+                         tag);
   if (ret < 0)
     {
-      nxsem_destroy(&payload.resp);
       return ret;
     }
 
-  nxsem_wait(&payload.resp);
-  nxsem_destroy(&payload.resp);
-
-  return payload.ret;
+  return v9fs_client_wait(&payload);
 }
 
 /****************************************************************************
@@ -895,18 +927,30 @@ int v9fs_client_chstat(FAR struct v9fs_client_s *client, uint32_t fid,
 
 /****************************************************************************
  * v9fs_client_read
+ *
+ * Description:
+ *   Read in chunks of the I/O unit of the fid:  Up to
+ *   CONFIG_V9FS_MAX_INFLIGHT requests of consecutive chunks are sent before
+ *   waiting for the first response, the data is received directly in the
+ *   buffer of the caller.  A short chunk ends the read.
+ *
  ****************************************************************************/
 
 ssize_t v9fs_client_read(FAR struct v9fs_client_s *client, uint32_t fid,
                          FAR void *buffer, off_t offset, size_t buflen)
 {
   FAR struct v9fs_fid_s *fidp;
-  struct v9fs_read_s request;
-  struct v9fs_rread_s response;
-  struct iovec wiov[1];
-  struct iovec riov[2];
+  struct v9fs_payload_s payload[CONFIG_V9FS_MAX_INFLIGHT];
+  struct v9fs_read_s request[CONFIG_V9FS_MAX_INFLIGHT];
+  struct v9fs_rread_s response[CONFIG_V9FS_MAX_INFLIGHT];
+  struct iovec wiov[CONFIG_V9FS_MAX_INFLIGHT][1];
+  struct iovec riov[CONFIG_V9FS_MAX_INFLIGHT][2];
+  bool done = false;
   size_t nread = 0;
+  int nsent;
   int ret = 0;
+  int res;
+  int i;
 
   /* size[4] Tread tag[2] fid[4] offset[8] count[4]
    * size[4] Rread tag[2] count[4] data[count]
@@ -918,40 +962,67 @@ ssize_t v9fs_client_read(FAR struct v9fs_client_s *client, uint32_t fid,
       return -ENOENT;
     }
 
-  while (buflen > 0)
+  while (buflen > 0 && !done)
     {
-      request.header.size = V9FS_HDRSZ + V9FS_BIT32SZ + V9FS_BIT64SZ +
-                            V9FS_BIT32SZ;
-      request.header.type = V9FS_TREAD;
-      request.header.tag = v9fs_get_tagid(client);
-      request.fid = fid;
-      request.offset = offset;
-      request.count = buflen > fidp->iounit ? fidp->iounit : buflen;
-
-      wiov[0].iov_base = &request;
-      wiov[0].iov_len = V9FS_HDRSZ + V9FS_BIT32SZ + V9FS_BIT64SZ +
-                        V9FS_BIT32SZ;
-      riov[0].iov_base = &response;
-      riov[0].iov_len = V9FS_HDRSZ + V9FS_BIT32SZ;
-      riov[1].iov_base = (FAR void *)buffer;
-      riov[1].iov_len = request.count;
-
-      ret = v9fs_client_rpc(client->transport, wiov, 1, riov, 2,
-                            request.header.tag);
-      if (ret < 0)
+      for (nsent = 0; nsent < CONFIG_V9FS_MAX_INFLIGHT && buflen > 0;
+           nsent++)
         {
-          break;
+          request[nsent].header.size = V9FS_HDRSZ + V9FS_BIT32SZ +
+                                       V9FS_BIT64SZ + V9FS_BIT32SZ;
+          request[nsent].header.type = V9FS_TREAD;
+          request[nsent].header.tag = v9fs_get_tagid(client);
+          request[nsent].fid = fid;
+          request[nsent].offset = offset;
+          request[nsent].count = buflen > fidp->iounit ?
+                                 fidp->iounit : buflen;
+
+          wiov[nsent][0].iov_base = &request[nsent];
+          wiov[nsent][0].iov_len = V9FS_HDRSZ + V9FS_BIT32SZ +
+                                   V9FS_BIT64SZ + V9FS_BIT32SZ;
+          riov[nsent][0].iov_base = &response[nsent];
+          riov[nsent][0].iov_len = V9FS_HDRSZ + V9FS_BIT32SZ;
+          riov[nsent][1].iov_base = buffer;
+          riov[nsent][1].iov_len = request[nsent].count;
+
+          ret = v9fs_client_send(client->transport, &payload[nsent],
+                                 wiov[nsent], 1, riov[nsent], 2,
+                                 request[nsent].header.tag);
+          if (ret < 0)
+            {
+              done = true;
+              break;
+            }
+
+          offset += request[nsent].count;
+          buffer += request[nsent].count;
+          buflen -= request[nsent].count;
         }
 
-      if (response.count == 0)
+      /* Collect the responses in order, the data after a short chunk or a
+       * failure is not part of the result.
+       */
+
+      for (i = 0; i < nsent; i++)
         {
-          break;
-        }
+          res = v9fs_client_wait(&payload[i]);
+          if (done)
+            {
+              continue;
+            }
 
-      nread += response.count;
-      offset += response.count;
-      buffer += response.count;
-      buflen -= response.count;
+          if (res < 0)
+            {
+              ret = res;
+              done = true;
+              continue;
+            }
+
+          nread += response[i].count;
+          if (response[i].count < request[i].count)
+            {
+              done = true;
+            }
+        }
     }
 
   return nread ? nread : ret;
@@ -1070,6 +1141,11 @@ ssize_t v9fs_client_convertdir(FAR const uint8_t *buffer, size_t bufsize,
 
 /****************************************************************************
  * v9fs_client_write
+ *
+ * Description:
+ *   Write in chunks of the I/O unit of the fid, with up to
+ *   CONFIG_V9FS_MAX_INFLIGHT requests in flight as v9fs_client_read().
+ *
  ****************************************************************************/
 
 ssize_t v9fs_client_write(FAR struct v9fs_client_s *client, uint32_t fid,
@@ -1077,12 +1153,17 @@ ssize_t v9fs_client_write(FAR struct v9fs_client_s *client, uint32_t fid,
                           size_t buflen)
 {
   FAR struct v9fs_fid_s *fidp;
-  struct v9fs_write_s request;
-  struct v9fs_rwrite_s response;
-  struct iovec wiov[2];
-  struct iovec riov[1];
+  struct v9fs_payload_s payload[CONFIG_V9FS_MAX_INFLIGHT];
+  struct v9fs_write_s request[CONFIG_V9FS_MAX_INFLIGHT];
+  struct v9fs_rwrite_s response[CONFIG_V9FS_MAX_INFLIGHT];
+  struct iovec wiov[CONFIG_V9FS_MAX_INFLIGHT][2];
+  struct iovec riov[CONFIG_V9FS_MAX_INFLIGHT][1];
+  bool done = false;
   size_t nwrite = 0;
+  int nsent;
   int ret = 0;
+  int res;
+  int i;
 
   /* size[4] Twrite tag[2] fid[4] offset[8] count[4] data[count]
    * size[4] Rwrite tag[2] count[4]
@@ -1094,35 +1175,64 @@ ssize_t v9fs_client_write(FAR struct v9fs_client_s *client, uint32_t fid,
       return -ENOENT;
     }
 
-  while (buflen > 0)
+  while (buflen > 0 && !done)
     {
-      request.header.size = V9FS_HDRSZ + V9FS_BIT32SZ + V9FS_BIT64SZ +
-                            V9FS_BIT32SZ + request.count;
-      request.header.type = V9FS_TWRITE;
-      request.header.tag = v9fs_get_tagid(client);
-      request.fid = fid;
-      request.offset = offset;
-      request.count = buflen > fidp->iounit ? fidp->iounit : buflen;
-
-      wiov[0].iov_base = &request;
-      wiov[0].iov_len = V9FS_HDRSZ + V9FS_BIT32SZ + V9FS_BIT64SZ +
-                        V9FS_BIT32SZ;
-      wiov[1].iov_base = (FAR void *)buffer;
-      wiov[1].iov_len = request.count;
-      riov[0].iov_base = &response;
-      riov[0].iov_len = V9FS_HDRSZ + V9FS_BIT32SZ;
-
-      ret = v9fs_client_rpc(client->transport, wiov, 2, riov, 1,
-                            request.header.tag);
-      if (ret < 0)
+      for (nsent = 0; nsent < CONFIG_V9FS_MAX_INFLIGHT && buflen > 0;
+           nsent++)
         {
-          break;
+          request[nsent].count = buflen > fidp->iounit ?
+                                 fidp->iounit : buflen;
+          request[nsent].header.size = V9FS_HDRSZ + V9FS_BIT32SZ +
+                                       V9FS_BIT64SZ + V9FS_BIT32SZ +
+                                       request[nsent].count;
+          request[nsent].header.type = V9FS_TWRITE;
+          request[nsent].header.tag = v9fs_get_tagid(client);
+          request[nsent].fid = fid;
+          request[nsent].offset = offset;
+
+          wiov[nsent][0].iov_base = &request[nsent];
+          wiov[nsent][0].iov_len = V9FS_HDRSZ + V9FS_BIT32SZ +
+                                   V9FS_BIT64SZ + V9FS_BIT32SZ;
+          wiov[nsent][1].iov_base = (FAR void *)buffer;
+          wiov[nsent][1].iov_len = request[nsent].count;
+          riov[nsent][0].iov_base = &response[nsent];
+          riov[nsent][0].iov_len = V9FS_HDRSZ + V9FS_BIT32SZ;
+
+          ret = v9fs_client_send(client->transport, &payload[nsent],
+                                 wiov[nsent], 2, riov[nsent], 1,
+                                 request[nsent].header.tag);
+          if (ret < 0)
+            {
+              done = true;
+              break;
+            }
+
+          offset += request[nsent].count;
+          buffer += request[nsent].count;
+          buflen -= request[nsent].count;
         }
 
-      nwrite += response.count;
-      offset += response.count;
-      buffer += response.count;
-      buflen -= response.count;
+      for (i = 0; i < nsent; i++)
+        {
+          res = v9fs_client_wait(&payload[i]);
+          if (done)
+            {
+              continue;
+            }
+
+          if (res < 0)
+            {
+              ret = res;
+              done = true;
+              continue;
+            }
+
+          nwrite += response[i].count;
+          if (response[i].count < request[i].count)
+            {
+              done = true;
+            }
+        }
     }
 
   return nwrite ? nwrite : ret;
@@ -26,6 +26,7 @@
 #include <errno.h>
 
 #include <nuttx/nuttx.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/virtio/virtio.h>
 
@@ -38,6 +39,10 @@
 
 #define VIRTIO_9P_MOUNT_TAG 0
 
+/* The largest number of descriptors of a request (Twalk) */
+
+#define VIRTIO_9P_MAX_DESCS 4
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -54,6 +59,7 @@ struct virtio_9p_priv_s
   struct v9fs_transport_s   transport;
   struct virtio_driver      vdrv;
   spinlock_t                lock;
+  sem_t                     slots;   /* Requests that fit in the queue */
   char                      tag[0];
 };
 
@@ -160,6 +166,12 @@ static int virtio_9p_request(FAR struct v9fs_transport_s *transport,
   size_t i;
   int ret;
 
+  /* Many requests may be in flight at once, wait until the queue has room
+   * for one more.
+   */
+
+  nxsem_wait_uninterruptible(&priv->slots);
+
   for (i = 0; i < payload->wcount; i++)
     {
       vb[i].buf = payload->wiov[i].iov_base;
@@ -177,12 +189,13 @@ static int virtio_9p_request(FAR struct v9fs_transport_s *transport,
                              payload);
   if (ret < 0)
     {
+      spin_unlock_irqrestore(&priv->lock, flags);
       vrterr("virtqueue_add_buffer failed, ret=%d\n", ret);
-      goto out;
+      nxsem_post(&priv->slots);
+      return ret;
     }
 
   virtqueue_kick(vq);
-out:
   spin_unlock_irqrestore(&priv->lock, flags);
   return ret;
 }
@@ -204,6 +217,7 @@ static void virtio_9p_done(FAR struct virtqueue *vq)
           break;
         }
 
+      nxsem_post(&priv->slots);
       v9fs_transport_done(payload, 0);
     }
 }
@@ -254,6 +268,8 @@ static int virtio_9p_probe(FAR struct virtio_device *vdev)
 
   priv->vdev = vdev;
   vdev->priv = priv;
+  nxsem_init(&priv->slots, 0,
+             vdev->vrings_info[0].vq->vq_nentries / VIRTIO_9P_MAX_DESCS);
   virtio_set_status(vdev, VIRTIO_CONFIG_STATUS_DRIVER_OK);
   virtqueue_enable_cb(vdev->vrings_info[0].vq);
   return OK;
@@ -265,6 +281,9 @@ static int virtio_9p_probe(FAR struct virtio_device *vdev)
 
 static void virtio_9p_remove(FAR struct virtio_device *vdev)
 {
+  FAR struct virtio_9p_priv_s *priv = vdev->priv;
+
   virtio_delete_virtqueues(vdev);
   virtio_reset_device(vdev);
+  nxsem_destroy(&priv->slots);
 }
@@ -24,6 +24,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/inotify.h>
 #include <unistd.h>
 #include <sched.h>
 #include <assert.h>
@@ -35,6 +36,7 @@
 #include "notify/notify.h"
 #include "inode/inode.h"
 #include "vfs/lock.h"
+#include "vfs/pagecache.h"
 
 /****************************************************************************
  * Private Functions
@@ -100,7 +102,13 @@ int file_close_without_clear(FAR struct file *filep)
    * in advance. Then we pass it to notify_close function.
    */
 
-  path = file_get_path(filep);
+  path = NULL;
+  if (notify_watched(IN_CLOSE))
+    {
+      path = file_get_path(filep);
+    }
+
+  notify_forget(filep);
 #endif
 
   /* Check if the struct file is open (i.e., assigned an inode) */
@@ -109,6 +117,10 @@ int file_close_without_clear(FAR struct file *filep)
     {
       file_closelk(filep);
 
+      /* Write back the data that the page cache holds for this file */
+
+      pagecache_close(filep);
+
       /* Close the file, driver, or mountpoint. */
 
       if (inode->u.i_ops && inode->u.i_ops->close)
@@ -40,6 +40,7 @@
 #include <nuttx/list.h>
 #include <nuttx/mutex.h>
 #include <nuttx/signal.h>
+#include <nuttx/spinlock.h>
 
 #include "inode/inode.h"
 #include "fs_heap.h"
@@ -51,8 +52,11 @@
 struct epoll_node_s
 {
   struct list_node         node;
+  struct list_node         rnode;   /* In the ready list */
   epoll_data_t             data;
-  bool                     notified;
+  bool                     ready;   /* In the ready list */
+  pollevent_t              revents; /* The events reported since the last
+                                     * epoll_wait */
   struct pollfd            pfd;
   FAR struct epoll_head_s *eph;
 };
@@ -65,13 +69,24 @@ struct epoll_head_s
   int                   crefs;
   mutex_t               lock;
   sem_t                 sem;
+  spinlock_t            rlock;    /* Protects the ready list and the ready
+                                   * and revents fields of the nodes, the
+                                   * poll callbacks may run from interrupt
+                                   * handlers.
+                                   */
+  struct list_node      ready;    /* The ready list, store the epoll nodes
+                                   * whose poll callback reported events
+                                   * not yet returned by epoll_wait.
+                                   */
   struct list_node      setup;    /* The setup list, store all the setuped
-                                   * epoll node.
+                                   * epoll node.  The polls stay set up
+                                   * across epoll_wait calls.
                                    */
-  struct list_node      teardown; /* The teardown list, store all the epoll
-                                   * node notified after epoll_wait finish,
-                                   * these epoll node should be setup again
-                                   * to check the pending poll notification.
+  struct list_node      teardown; /* The teardown list, store the level
+                                   * triggered epoll nodes returned by the
+                                   * last epoll_wait, these epoll node should
+                                   * be setup again at the next epoll_wait
+                                   * to check if they are still ready.
                                    */
   struct list_node      oneshot;  /* The oneshot list, store all the epoll
                                    * node notified after epoll_wait and with
@@ -101,6 +116,7 @@ static int epoll_do_poll(FAR struct file *filep,
 static int epoll_setup(FAR epoll_head_t *eph);
 static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
                           int maxevents);
+static void epoll_unready(FAR epoll_node_t *epn);
 
 /****************************************************************************
  * Private Data
@@ -235,11 +251,13 @@ static int epoll_do_create(int size, int flags)
   eph->size = size;
   nxmutex_init(&eph->lock);
   nxsem_init(&eph->sem, 0, 0);
+  spin_lock_init(&eph->rlock);
 
   /* List initialize */
 
   epn = (FAR epoll_node_t *)(eph + 1);
 
+  list_initialize(&eph->ready);
   list_initialize(&eph->setup);
   list_initialize(&eph->teardown);
   list_initialize(&eph->oneshot);
@@ -270,7 +288,9 @@ static int epoll_do_create(int size, int flags)
  * Name: epoll_setup
  *
  * Description:
- *   Setup all the fd.
+ *   Setup again the level triggered fd returned by the last epoll_wait, the
+ *   poll callback puts them back in the ready list if they are still ready.
+ *   The other fd stay set up.
  *
  * Input Parameters:
  *   eph       - The epoll head pointer
@@ -298,7 +318,6 @@ static int epoll_setup(FAR epoll_head_t *eph)
        * cover the situation several poll event pending on one fd.
        */
 
-      epn->notified    = false;
       epn->pfd.revents = 0;
       ret = poll_fdsetup(epn->pfd.fd, &epn->pfd, true);
       if (ret < 0)
@@ -320,8 +339,10 @@ static int epoll_setup(FAR epoll_head_t *eph)
  * Name: epoll_teardown
  *
  * Description:
- *   Teardown all the notifed fd and check the notified fd's event with user
- *   expected event.
+ *   Return the events of the fd in the ready list.  The cost depends on the
+ *   number of ready fd, not on the number of registered fd:  An edge
+ *   triggered fd stays set up, a level triggered fd is torn down until the
+ *   next epoll_wait, and an EPOLLONESHOT fd until it is modified.
  *
  * Input Parameters:
  *   eph       - The epoll head pointer
@@ -337,41 +358,44 @@ static int epoll_setup(FAR epoll_head_t *eph)
 static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
                           int maxevents)
 {
-  FAR epoll_node_t *tepn;
   FAR epoll_node_t *epn;
+  pollevent_t revents;
+  irqstate_t flags;
   int i = 0;
 
   nxmutex_lock(&eph->lock);
 
-  list_for_every_entry_safe(&eph->setup, epn, tepn, epoll_node_t, node)
+  while (i < maxevents)
     {
-      /* Only check the notifed fd */
-
-      if (!epn->notified)
+      flags = spin_lock_irqsave(&eph->rlock);
+      if (list_is_empty(&eph->ready))
         {
-          continue;
+          spin_unlock_irqrestore(&eph->rlock, flags);
+          break;
         }
 
-      /* Teradown all the notified fd */
+      epn = container_of(list_remove_head(&eph->ready), epoll_node_t,
+                         rnode);
+      epn->ready   = false;
+      revents      = epn->revents;
+      epn->revents = 0;
+      spin_unlock_irqrestore(&eph->rlock, flags);
 
-      poll_fdsetup(epn->pfd.fd, &epn->pfd, false);
-      list_delete(&epn->node);
+      evs[i].data     = epn->data;
+      evs[i++].events = revents;
 
-      if (epn->pfd.revents != 0 && i < maxevents)
+      if ((epn->pfd.events & EPOLLONESHOT) != 0)
         {
-          evs[i].data     = epn->data;
-          evs[i++].events = epn->pfd.revents;
-          if ((epn->pfd.events & EPOLLONESHOT) != 0)
-            {
-              list_add_tail(&eph->oneshot, &epn->node);
-            }
-          else
-            {
-              list_add_tail(&eph->teardown, &epn->node);
-            }
+          poll_fdsetup(epn->pfd.fd, &epn->pfd, false);
+          epoll_unready(epn);
+          list_delete(&epn->node);
+          list_add_tail(&eph->oneshot, &epn->node);
         }
-      else
+      else if ((epn->pfd.events & EPOLLET) == 0)
         {
+          poll_fdsetup(epn->pfd.fd, &epn->pfd, false);
+          epoll_unready(epn);
+          list_delete(&epn->node);
           list_add_tail(&eph->teardown, &epn->node);
         }
     }
@@ -380,6 +404,105 @@ static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
   return i;
 }
 
+/****************************************************************************
+ * Name: epoll_unready
+ *
+ * Description:
+ *   Remove an epoll node from the ready list once its poll is torn down,
+ *   the poll callback may have run in between.
+ *
+ ****************************************************************************/
+
+static void epoll_unready(FAR epoll_node_t *epn)
+{
+  FAR epoll_head_t *eph = epn->eph;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&eph->rlock);
+  if (epn->ready)
+    {
+      list_delete(&epn->rnode);
+      epn->ready = false;
+    }
+
+  epn->revents = 0;
+  spin_unlock_irqrestore(&eph->rlock, flags);
+}
+
+/****************************************************************************
+ * Name: epoll_wait_ready
+ *
+ * Description:
+ *   Wait until fd are ready or the timeout expires, and return their
+ *   events.
+ *
+ * Input Parameters:
+ *   eph       - The epoll head pointer
+ *   evs       - The epoll events array
+ *   maxevents - The epoll events array size
+ *   timeout   - The timeout in milliseconds, negative to wait forever
+ *
+ * Returned Value:
+ *   The number of events returned, zero on timeout, a negated errno value
+ *   on failure.
+ *
+ ****************************************************************************/
+
+static int epoll_wait_ready(FAR epoll_head_t *eph,
+                            FAR struct epoll_event *evs,
+                            int maxevents, int timeout)
+{
+  clock_t deadline = 0;
+  clock_t now;
+  int ret;
+
+  ret = epoll_setup(eph);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (timeout > 0)
+    {
+      deadline = clock_systime_ticks() + MSEC2TICK(timeout);
+    }
+
+  for (; ; )
+    {
+      ret = epoll_teardown(eph, evs, maxevents);
+      if (ret > 0 || timeout == 0)
+        {
+          return ret;
+        }
+
+      /* Wait the poll ready */
+
+      if (timeout > 0)
+        {
+          now = clock_systime_ticks();
+          if (!clock_compare(now, deadline))
+            {
+              return epoll_teardown(eph, evs, maxevents);
+            }
+
+          ret = nxsem_tickwait(&eph->sem, deadline - now);
+        }
+      else
+        {
+          ret = nxsem_wait(&eph->sem);
+        }
+
+      if (ret == -ETIMEDOUT)
+        {
+          return epoll_teardown(eph, evs, maxevents);
+        }
+      else if (ret < 0)
+        {
+          return ret;
+        }
+    }
+}
+
 /****************************************************************************
  * Name: epoll_default_cb
  *
@@ -398,15 +521,33 @@ static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
 static void epoll_default_cb(FAR struct pollfd *fds)
 {
   FAR epoll_node_t *epn = fds->arg;
+  FAR epoll_head_t *eph = epn->eph;
+  irqstate_t flags;
+  bool wake = false;
   int semcount = 0;
 
-  epn->notified = true;
-  if (fds->revents != 0)
+  /* Move the events to the node and queue it to the ready list, the poll
+   * stays set up and reports the next events the same way.
+   */
+
+  flags = spin_lock_irqsave(&eph->rlock);
+  epn->revents |= fds->revents;
+  fds->revents = 0;
+  if (!epn->ready && epn->revents != 0)
+    {
+      epn->ready = true;
+      list_add_tail(&eph->ready, &epn->rnode);
+      wake = true;
+    }
+
+  spin_unlock_irqrestore(&eph->rlock, flags);
+
+  if (wake)
     {
-      nxsem_get_value(&epn->eph->sem, &semcount);
+      nxsem_get_value(&eph->sem, &semcount);
       if (semcount < 1)
         {
-          nxsem_post(&epn->eph->sem);
+          nxsem_post(&eph->sem);
         }
     }
 }
@@ -556,8 +697,9 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
         epn = container_of(list_remove_head(&eph->free), epoll_node_t, node);
         epn->eph         = eph;
         epn->data        = ev->data;
-        epn->notified    = false;
-        epn->pfd.events  = ev->events | POLLALWAYS;
+        epn->ready       = false;
+        epn->revents     = 0;
+        epn->pfd.events  = ev->events;
         epn->pfd.fd      = fd;
         epn->pfd.arg     = epn;
         epn->pfd.cb      = epoll_default_cb;
@@ -566,6 +708,7 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
         ret = poll_fdsetup(fd, &epn->pfd, true);
         if (ret < 0)
           {
+            epoll_unready(epn);
             list_add_tail(&eph->free, &epn->node);
             goto err;
           }
@@ -580,6 +723,7 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
             if (epn->pfd.fd == fd)
               {
                 poll_fdsetup(fd, &epn->pfd, false);
+                epoll_unready(epn);
                 list_delete(&epn->node);
                 list_add_tail(&eph->free, &epn->node);
                 goto out;
@@ -614,13 +758,13 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
           {
             if (epn->pfd.fd == fd)
               {
-                if (epn->pfd.events != (ev->events | POLLALWAYS))
+                epn->data = ev->data;
+                if (epn->pfd.events != ev->events)
                   {
                     poll_fdsetup(fd, &epn->pfd, false);
+                    epoll_unready(epn);
 
-                    epn->notified    = false;
-                    epn->data        = ev->data;
-                    epn->pfd.events  = ev->events | POLLALWAYS;
+                    epn->pfd.events  = ev->events;
                     epn->pfd.fd      = fd;
                     epn->pfd.revents = 0;
 
@@ -639,11 +783,10 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
           {
             if (epn->pfd.fd == fd)
               {
-                if (epn->pfd.events != (ev->events | POLLALWAYS))
+                epn->data = ev->data;
+                if (epn->pfd.events != ev->events)
                   {
-                    epn->notified    = false;
-                    epn->data        = ev->data;
-                    epn->pfd.events  = ev->events | POLLALWAYS;
+                    epn->pfd.events  = ev->events;
                     epn->pfd.fd      = fd;
                     epn->pfd.revents = 0;
 
@@ -665,9 +808,8 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
           {
             if (epn->pfd.fd == fd)
               {
-                epn->notified    = false;
                 epn->data        = ev->data;
-                epn->pfd.events  = ev->events | POLLALWAYS;
+                epn->pfd.events  = ev->events;
                 epn->pfd.fd      = fd;
                 epn->pfd.revents = 0;
 
@@ -720,45 +862,13 @@ int epoll_pwait(int epfd, FAR struct epoll_event *evs,
       goto out;
     }
 
-retry:
-  ret = epoll_setup(eph);
-  if (ret < 0)
-    {
-      goto err;
-    }
-
-  /* Wait the poll ready */
-
   nxsig_procmask(SIG_SETMASK, sigmask, &oldsigmask);
-
-  if (timeout == 0)
-    {
-      ret = -ETIMEDOUT;
-    }
-  else if (timeout > 0)
-    {
-      ret = nxsem_tickwait(&eph->sem, MSEC2TICK(timeout));
-    }
-  else
-    {
-      ret = nxsem_wait(&eph->sem);
-    }
-
+  ret = epoll_wait_ready(eph, evs, maxevents, timeout);
   nxsig_procmask(SIG_SETMASK, &oldsigmask, NULL);
-  if (ret < 0 && ret != -ETIMEDOUT)
+  if (ret < 0)
     {
       goto err;
     }
-  else /* ret >= 0 or ret == -ETIMEDOUT */
-    {
-      int num = epoll_teardown(eph, evs, maxevents);
-      if (num == 0 && ret >= 0)
-        {
-          goto retry;
-        }
-
-      ret = num;
-    }
 
   fs_putfilep(filep);
   return ret;
@@ -795,43 +905,12 @@ int epoll_wait(int epfd, FAR struct epoll_event *evs,
       goto out;
     }
 
-retry:
-  ret = epoll_setup(eph);
+  ret = epoll_wait_ready(eph, evs, maxevents, timeout);
   if (ret < 0)
     {
       goto err;
     }
 
-  /* Wait the poll ready */
-
-  if (timeout == 0)
-    {
-      ret = -ETIMEDOUT;
-    }
-  else if (timeout > 0)
-    {
-      ret = nxsem_tickwait(&eph->sem, MSEC2TICK(timeout));
-    }
-  else
-    {
-      ret = nxsem_wait(&eph->sem);
-    }
-
-  if (ret < 0 && ret != -ETIMEDOUT)
-    {
-      goto err;
-    }
-  else /* ret >= 0 or ret == -ETIMEDOUT */
-    {
-      int num = epoll_teardown(eph, evs, maxevents);
-      if (num == 0 && ret >= 0)
-        {
-          goto retry;
-        }
-
-      ret = num;
-    }
-
   fs_putfilep(filep);
   return ret;
 
@@ -57,6 +57,10 @@ struct eventfd_priv_s
   eventfd_t                 counter; /* eventfd counter */
   uint8_t                   crefs;   /* References counts on eventfd (max: 255) */
 
+  /* The counter is readable from the threshold on, see FIOC_SETTHRESHOLD */
+
+  eventfd_t                 threshold;
+
   /* The following is a list if poll structures of threads waiting for
    * driver events.
    */
@@ -77,6 +81,8 @@ static ssize_t eventfd_do_read(FAR struct file *filep, FAR char *buffer,
                                size_t len);
 static ssize_t eventfd_do_write(FAR struct file *filep,
                                 FAR const char *buffer, size_t len);
+static int eventfd_do_ioctl(FAR struct file *filep, int cmd,
+                            unsigned long arg);
 #ifdef CONFIG_EVENT_FD_POLL
 static int eventfd_do_poll(FAR struct file *filep, FAR struct pollfd *fds,
                            bool setup);
@@ -100,7 +106,7 @@ static const struct file_operations g_eventfd_fops =
   eventfd_do_read,  /* read */
   eventfd_do_write, /* write */
   NULL,             /* seek */
-  NULL,             /* ioctl */
+  eventfd_do_ioctl, /* ioctl */
   NULL,             /* mmap */
   NULL,             /* truncate */
 #ifdef CONFIG_EVENT_FD_POLL
@@ -214,6 +220,38 @@ static int eventfd_do_close(FAR struct file *filep)
   return OK;
 }
 
+/* Wake up the readers and the poll waiters once the counter reaches the
+ * threshold, they are not woken up again until it is read below it.
+ */
+
+static void eventfd_notify_readers(FAR struct eventfd_priv_s *dev,
+                                   bool readable)
+{
+  FAR eventfd_waiter_sem_t *cur_sem;
+
+  if (readable || dev->counter < dev->threshold)
+    {
+      return;
+    }
+
+#ifdef CONFIG_EVENT_FD_POLL
+  /* Notify all poll/select waiters */
+
+  poll_notify(dev->fds, CONFIG_EVENT_FD_NPOLLWAITERS, POLLIN);
+#endif
+
+  /* Notify all of the waiting readers */
+
+  cur_sem = dev->rdsems;
+  while (cur_sem != NULL)
+    {
+      nxsem_post(&cur_sem->sem);
+      cur_sem = cur_sem->next;
+    }
+
+  dev->rdsems = NULL;
+}
+
 static int eventfd_blocking_io(FAR struct eventfd_priv_s *dev,
                                FAR eventfd_waiter_sem_t  *sem,
                                FAR eventfd_waiter_sem_t **slist)
@@ -268,6 +306,9 @@ static ssize_t eventfd_do_read(FAR struct file *filep, FAR char *buffer,
 {
   FAR struct eventfd_priv_s *dev = filep->f_priv;
   FAR eventfd_waiter_sem_t *cur_sem;
+#ifdef CONFIG_EVENT_FD_POLL
+  eventfd_t old_counter;
+#endif
   ssize_t ret;
 
   if (len < sizeof(eventfd_t) || buffer == NULL)
@@ -283,7 +324,7 @@ static ssize_t eventfd_do_read(FAR struct file *filep, FAR char *buffer,
 
   /* Wait for an incoming event */
 
-  if (dev->counter == 0)
+  if (dev->counter < dev->threshold)
     {
       eventfd_waiter_sem_t sem;
 
@@ -303,13 +344,17 @@ static ssize_t eventfd_do_read(FAR struct file *filep, FAR char *buffer,
               return ret;
             }
         }
-      while (dev->counter == 0);
+      while (dev->counter < dev->threshold);
 
       nxsem_destroy(&sem.sem);
     }
 
   /* Device ready for read */
 
+#ifdef CONFIG_EVENT_FD_POLL
+  old_counter = dev->counter;
+#endif
+
   if ((filep->f_oflags & EFD_SEMAPHORE) != 0)
     {
       *(FAR eventfd_t *)buffer = 1;
@@ -322,9 +367,12 @@ static ssize_t eventfd_do_read(FAR struct file *filep, FAR char *buffer,
     }
 
 #ifdef CONFIG_EVENT_FD_POLL
-  /* Notify all poll/select waiters */
+  /* Notify all poll/select waiters, if the counter was full */
 
-  poll_notify(dev->fds, CONFIG_EVENT_FD_NPOLLWAITERS, POLLOUT);
+  if (old_counter == (eventfd_t)-1)
+    {
+      poll_notify(dev->fds, CONFIG_EVENT_FD_NPOLLWAITERS, POLLOUT);
+    }
 #endif
 
   /* Notify all waiting writers that counter have been decremented */
@@ -346,8 +394,8 @@ static ssize_t eventfd_do_write(FAR struct file *filep,
                                 FAR const char *buffer, size_t len)
 {
   FAR struct eventfd_priv_s *dev = filep->f_priv;
-  FAR eventfd_waiter_sem_t *cur_sem;
   eventfd_t new_counter;
+  bool readable;
   ssize_t ret;
 
   if (len < sizeof(eventfd_t) || buffer == NULL ||
@@ -395,27 +443,47 @@ static ssize_t eventfd_do_write(FAR struct file *filep,
 
   /* Ready to write, update counter */
 
+  readable     = dev->counter >= dev->threshold;
   dev->counter = new_counter;
+  eventfd_notify_readers(dev, readable);
 
-#ifdef CONFIG_EVENT_FD_POLL
-  /* Notify all poll/select waiters */
+  nxmutex_unlock(&dev->lock);
+  return sizeof(eventfd_t);
+}
 
-  poll_notify(dev->fds, CONFIG_EVENT_FD_NPOLLWAITERS, POLLIN);
-#endif
+static int eventfd_do_ioctl(FAR struct file *filep, int cmd,
+                            unsigned long arg)
+{
+  FAR struct eventfd_priv_s *dev = filep->f_priv;
+  FAR const eventfd_t *threshold = (FAR const eventfd_t *)(uintptr_t)arg;
+  bool readable;
+  int ret;
 
-  /* Notify all of the waiting readers */
+  if (cmd != FIOC_SETTHRESHOLD)
+    {
+      return -ENOTTY;
+    }
 
-  cur_sem = dev->rdsems;
-  while (cur_sem != NULL)
+  if (threshold == NULL || *threshold == 0 ||
+      *threshold == (eventfd_t)-1)
     {
-      nxsem_post(&cur_sem->sem);
-      cur_sem = cur_sem->next;
+      return -EINVAL;
     }
 
-  dev->rdsems = NULL;
+  ret = nxmutex_lock(&dev->lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* A lower threshold may make the counter readable */
+
+  readable       = dev->counter >= dev->threshold;
+  dev->threshold = *threshold;
+  eventfd_notify_readers(dev, readable);
 
   nxmutex_unlock(&dev->lock);
-  return sizeof(eventfd_t);
+  return OK;
 }
 
 #ifdef CONFIG_EVENT_FD_POLL
@@ -483,9 +551,9 @@ static int eventfd_do_poll(FAR struct file *filep, FAR struct pollfd *fds,
       eventset |= POLLOUT;
     }
 
-  /* Notify the POLLIN event if the pipe is not empty */
+  /* Notify the POLLIN event if the counter reached the threshold */
 
-  if (dev->counter > 0)
+  if (dev->counter >= dev->threshold)
     {
       eventset |= POLLIN;
     }
@@ -525,7 +593,8 @@ int eventfd(unsigned int count, int flags)
       goto exit_set_errno;
     }
 
-  new_dev->counter = count;
+  new_dev->counter   = count;
+  new_dev->threshold = 1;
   new_fd = file_allocate(&g_eventfd_inode, O_RDWR | flags,
                          0, new_dev, 0, true);
   if (new_fd < 0)
@@ -34,6 +34,7 @@
 #include <nuttx/mtd/mtd.h>
 #include <nuttx/net/net.h>
 #include "inode/inode.h"
+#include "vfs/pagecache.h"
 
 /****************************************************************************
  * Private Functions
@@ -195,6 +196,12 @@ int file_fstat(FAR struct file *filep, FAR struct stat *buf)
           /* Perform the fstat() operation */
 
           ret = inode->u.i_mops->fstat(filep, buf);
+          if (ret >= 0)
+            {
+              /* The size includes the data not written back yet */
+
+              pagecache_fstat(filep, buf);
+            }
         }
     }
   else
@@ -35,6 +35,7 @@
 #include <nuttx/fs/ioctl.h>
 
 #include "inode/inode.h"
+#include "vfs/pagecache.h"
 
 /****************************************************************************
  * Public Functions
@@ -66,12 +67,25 @@ int file_fsync(FAR struct file *filep)
 #ifndef CONFIG_DISABLE_MOUNTPOINT
       if (INODE_IS_MOUNTPT(inode))
         {
+          /* Write back the data of the file in the page cache first */
+
+          ret = pagecache_sync(filep);
+          if (ret < 0 && ret != -ENOSYS)
+            {
+              return ret;
+            }
+
           if (inode->u.i_mops && inode->u.i_mops->sync)
             {
               /* Yes, then tell the mountpoint to sync this file */
 
               return inode->u.i_mops->sync(filep);
             }
+
+          if (ret >= 0)
+            {
+              return OK;
+            }
         }
       else
 #endif
@@ -0,0 +1,157 @@
+/****************************************************************************
+ * fs/vfs/fs_getdata.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <sys/stat.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+
+#include "inode/inode.h"
+#include "vfs/pagecache.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_putxip
+ *
+ * Description:
+ *   The data of an execute-in-place file is never released.
+ *
+ ****************************************************************************/
+
+static void file_putxip(FAR void *base)
+{
+}
+
+/****************************************************************************
+ * Name: file_getxip
+ *
+ * Description:
+ *   Lend the data of a file of an execute-in-place file system that cannot
+ *   write:  Its data never moves while the volume is mounted.
+ *
+ ****************************************************************************/
+
+static ssize_t file_getxip(FAR struct file *filep, off_t offset,
+                           size_t nbytes, FAR void **base)
+{
+#ifndef CONFIG_DISABLE_MOUNTPOINT
+  FAR struct inode *inode = filep->f_inode;
+  uintptr_t xipbase;
+  struct stat buf;
+  int ret;
+
+  if (inode == NULL || !INODE_IS_MOUNTPT(inode) ||
+      inode->u.i_mops->write != NULL)
+    {
+      return -ENOSYS;
+    }
+
+  ret = file_ioctl(filep, FIOC_XIPBASE,
+                   (unsigned long)((uintptr_t)&xipbase));
+  if (ret < 0)
+    {
+      return -ENOSYS;
+    }
+
+  ret = file_fstat(filep, &buf);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (offset >= buf.st_size)
+    {
+      return 0;
+    }
+
+  *base = (FAR void *)(xipbase + offset);
+  return MIN(nbytes, (size_t)(buf.st_size - offset));
+#else
+  return -ENOSYS;
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_getdata
+ ****************************************************************************/
+
+ssize_t file_getdata(FAR struct file *filep, off_t offset, size_t nbytes,
+                     FAR void **base, FAR size_t *skip,
+                     FAR file_putdata_t *putdata)
+{
+  ssize_t ret;
+
+  DEBUGASSERT(filep != NULL && base != NULL && skip != NULL &&
+              putdata != NULL);
+
+  if ((filep->f_oflags & O_RDOK) == 0)
+    {
+      return -EACCES;
+    }
+
+  if (offset < 0)
+    {
+      return -EINVAL;
+    }
+
+  /* An execute-in-place file is lent from its memory before its pages */
+
+  ret = file_getxip(filep, offset, nbytes, base);
+  if (ret >= 0)
+    {
+      *skip    = 0;
+      *putdata = file_putxip;
+      return ret;
+    }
+  else if (ret != -ENOSYS)
+    {
+      return ret;
+    }
+
+#ifdef CONFIG_FS_PAGECACHE
+  ret = pagecache_getdata(filep, offset, nbytes, base, skip);
+  if (ret >= 0)
+    {
+      *putdata = pagecache_putdata;
+    }
+#endif
+
+  return ret;
+}
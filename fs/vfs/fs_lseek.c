@@ -31,6 +31,7 @@
 #include <assert.h>
 
 #include "inode/inode.h"
+#include "vfs/pagecache.h"
 
 /****************************************************************************
  * Public Functions
@@ -62,6 +63,14 @@ off_t file_seek(FAR struct file *filep, off_t offset, int whence)
   DEBUGASSERT(filep);
   inode =  filep->f_inode;
 
+  /* The page cache knows the size of the cached files */
+
+  ret = pagecache_seek(filep, offset, whence);
+  if (ret != -ENOSYS)
+    {
+      return ret;
+    }
+
   /* Invoke the file seek method if available */
 
   if (inode && inode->u.i_ops && inode->u.i_ops->seek)
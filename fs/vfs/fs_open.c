@@ -41,6 +41,7 @@
 #include "inode/inode.h"
 #include "driver/driver.h"
 #include "notify/notify.h"
+#include "vfs/pagecache.h"
 
 /****************************************************************************
  * Private Functions
@@ -244,6 +245,12 @@ static int file_vopen(FAR struct file *filep, FAR const char *path,
       if (inode->u.i_mops->open != NULL)
         {
           ret = inode->u.i_mops->open(filep, desc.relpath, oflags, mode);
+          if (ret >= 0 && (oflags & O_TRUNC) != 0)
+            {
+              /* The file system has truncated the file */
+
+              pagecache_truncate(filep, 0);
+            }
         }
     }
 #endif
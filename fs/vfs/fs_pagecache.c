@@ -0,0 +1,1462 @@
+/****************************************************************************
+ * fs/vfs/fs_pagecache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/mman.h>
+#include <sys/param.h>
+#include <sys/stat.h>
+
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/queue.h>
+#include <nuttx/sched.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wqueue.h>
+
+#include "inode/inode.h"
+#include "mmap/fs_rammap.h"
+#include "vfs/pagecache.h"
+#include "fs_heap.h"
+
+#ifdef CONFIG_FS_PAGECACHE
+
+/* A file is cached if its file system implements the fileid method.  The
+ * data of the file is then kept in pages of CONFIG_FS_PAGECACHE_PAGESIZE
+ * bytes, identified by the mountpoint, the file identifier and the offset
+ * of the page, so that all the struct file of a file share the same data.
+ *
+ * The pages of a file that is mapped with MAP_SHARED are the memory of the
+ * mapping itself (struct pagecache_map_s):  read() and write() access the
+ * memory of the mapping, and every mapping of the same range shares it.
+ *
+ * The file system is only used to fill the pages that are not cached and
+ * to write back the dirty ones.  Both positions the file system at the
+ * offset of the page first, so its own position is meaningless for a
+ * cached file and the position of the file is kept in f_pos only.
+ *
+ * The dirty pages are written through the last struct file that wrote
+ * them (wfilep) by the low priority work queue, or when that struct file
+ * is synchronized or closed, or when a dirty page has to be evicted.  A
+ * file with dirty data always has a wfilep.
+ *
+ * pagecache_getdata() lends the data of a page, to be transmitted by the
+ * network without a copy.  A page that is lent is not reused, it is only
+ * removed from the cache and freed by the last pagecache_putdata(), which
+ * may run in the interrupt handler that completed the transmission.
+ */
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PAGECACHE_PAGESIZE   CONFIG_FS_PAGECACHE_PAGESIZE
+#define PAGECACHE_PAGEMASK   (PAGECACHE_PAGESIZE - 1)
+#define PAGECACHE_NHASH      CONFIG_FS_PAGECACHE_NPAGES
+
+#define PAGECACHE_HASH(f, o) \
+  ((((uintptr_t)(f) / sizeof(struct pagecache_file_s)) + \
+    (uintptr_t)((o) / PAGECACHE_PAGESIZE)) % PAGECACHE_NHASH)
+
+#if (PAGECACHE_PAGESIZE & PAGECACHE_PAGEMASK) != 0
+#  error CONFIG_FS_PAGECACHE_PAGESIZE must be a power of two
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A cached file */
+
+struct pagecache_file_s
+{
+  dq_entry_t             node;     /* Entry in g_pagecache_files */
+  FAR struct inode      *mountpt;  /* The mountpoint of the file */
+  ino_t                  id;       /* The identifier of the file */
+  off_t                  size;     /* The size, with the cached data */
+  FAR struct file       *wfilep;   /* Writes back the dirty data */
+  dq_queue_t             pages;    /* The pages, sorted by offset */
+  dq_queue_t             maps;     /* The shared mappings */
+};
+
+/* A page of a cached file */
+
+struct pagecache_page_s
+{
+  dq_entry_t                   lru;    /* Entry in g_pagecache_lru */
+  dq_entry_t                   node;   /* Entry in the pages of the file */
+  FAR struct pagecache_page_s *hnext;  /* Next page in the hash bucket */
+  FAR struct pagecache_file_s *file;   /* The file of the page */
+  off_t                        offset; /* The offset of the page */
+  unsigned int                 refs;   /* From pagecache_getdata() */
+  bool                         dirty;  /* The page must be written back */
+  uint8_t                      data[PAGECACHE_PAGESIZE];
+};
+
+/* A range of a file mapped with MAP_SHARED */
+
+struct pagecache_map_s
+{
+  dq_entry_t                   node;     /* Entry in the maps of the file */
+  FAR struct pagecache_file_s *file;     /* The mapped file */
+  FAR struct file             *filep;    /* The file descriptor mapped */
+  FAR uint8_t                 *vaddr;    /* The memory of the mapping */
+  off_t                        offset;   /* The offset of the range */
+  size_t                       size;     /* The size, page aligned */
+  int                          type;     /* The memory: MAP_USER/KERNEL */
+  unsigned int                 refs;     /* The mm_map_entry_s using it */
+  bool                         writable; /* Mapped with PROT_WRITE */
+  bool                         dirty;    /* Written with write() */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static rmutex_t g_pagecache_lock = NXRMUTEX_INITIALIZER;
+static dq_queue_t g_pagecache_files;
+static dq_queue_t g_pagecache_lru;
+static FAR struct pagecache_page_s *g_pagecache_hash[PAGECACHE_NHASH];
+static unsigned int g_pagecache_npages;
+static struct work_s g_pagecache_work;
+static spinlock_t g_pagecache_reflock = SP_UNLOCKED;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pagecache_fileid
+ *
+ * Description:
+ *   Get the identifier of an open file, if its file system supports the
+ *   page cache.
+ *
+ ****************************************************************************/
+
+static bool pagecache_fileid(FAR struct file *filep, FAR ino_t *id)
+{
+  FAR struct inode *inode = filep->f_inode;
+
+  return inode != NULL && INODE_IS_MOUNTPT(inode) &&
+         inode->u.i_mops != NULL && inode->u.i_mops->fileid != NULL &&
+         inode->u.i_mops->seek != NULL && inode->u.i_mops->read != NULL &&
+         inode->u.i_mops->fstat != NULL &&
+         inode->u.i_mops->fileid(filep, id) >= 0;
+}
+
+/****************************************************************************
+ * Name: pagecache_io
+ *
+ * Description:
+ *   Read or write data of a file at 'offset' with its file system,
+ *   leaving the position of the file unchanged.
+ *
+ ****************************************************************************/
+
+static ssize_t pagecache_io(FAR struct file *filep, off_t offset,
+                            FAR void *buf, size_t len, bool write)
+{
+  FAR const struct mountpt_operations *mops = filep->f_inode->u.i_mops;
+  off_t fpos = filep->f_pos;
+  int oflags = filep->f_oflags;
+  size_t done = 0;
+  ssize_t ret;
+
+  /* The file system would write at its end of file in append mode */
+
+  filep->f_oflags &= ~O_APPEND;
+
+  ret = mops->seek(filep, offset, SEEK_SET);
+  while (ret >= 0 && done < len)
+    {
+      if (write)
+        {
+          ret = mops->write(filep, (FAR const char *)buf + done,
+                            len - done);
+        }
+      else
+        {
+          ret = mops->read(filep, (FAR char *)buf + done, len - done);
+        }
+
+      if (ret == -EINTR)
+        {
+          ret = 0;
+          continue;
+        }
+      else if (ret <= 0)
+        {
+          break;
+        }
+
+      done += ret;
+    }
+
+  filep->f_oflags = oflags;
+  filep->f_pos    = fpos;
+
+  if (ret < 0)
+    {
+      ferr("ERROR: %s at %" PRIdOFF " failed: %zd\n",
+           write ? "Write" : "Read", offset, ret);
+      return ret;
+    }
+
+  return write && done < len ? -ENOSPC : (ssize_t)done;
+}
+
+/****************************************************************************
+ * Name: pagecache_findfile
+ ****************************************************************************/
+
+static FAR struct pagecache_file_s *
+pagecache_findfile(FAR struct inode *mountpt, ino_t id)
+{
+  FAR dq_entry_t *node;
+
+  dq_for_every(&g_pagecache_files, node)
+    {
+      FAR struct pagecache_file_s *file =
+        (FAR struct pagecache_file_s *)node;
+
+      if (file->mountpt == mountpt && file->id == id)
+        {
+          return file;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: pagecache_getfile
+ *
+ * Description:
+ *   Find the cached file of an open file, or create it.  Only the regular
+ *   files are cached.
+ *
+ ****************************************************************************/
+
+static FAR struct pagecache_file_s *
+pagecache_getfile(FAR struct file *filep, ino_t id)
+{
+  FAR struct pagecache_file_s *file;
+  struct stat buf;
+
+  file = pagecache_findfile(filep->f_inode, id);
+  if (file != NULL)
+    {
+      return file;
+    }
+
+  if (filep->f_inode->u.i_mops->fstat(filep, &buf) < 0 ||
+      !S_ISREG(buf.st_mode))
+    {
+      return NULL;
+    }
+
+  file = fs_heap_zalloc(sizeof(struct pagecache_file_s));
+  if (file != NULL)
+    {
+      file->mountpt = filep->f_inode;
+      file->id      = id;
+      file->size    = buf.st_size;
+      dq_addfirst(&file->node, &g_pagecache_files);
+    }
+
+  return file;
+}
+
+/****************************************************************************
+ * Name: pagecache_putfile
+ *
+ * Description:
+ *   Free a cached file that holds no data any more.
+ *
+ ****************************************************************************/
+
+static void pagecache_putfile(FAR struct pagecache_file_s *file)
+{
+  if (file->wfilep == NULL && dq_empty(&file->pages) &&
+      dq_empty(&file->maps))
+    {
+      dq_rem(&file->node, &g_pagecache_files);
+      fs_heap_free(file);
+    }
+}
+
+/****************************************************************************
+ * Name: pagecache_unlinkpage
+ *
+ * Description:
+ *   Remove a page from the cache, without freeing it.
+ *
+ ****************************************************************************/
+
+static void pagecache_unlinkpage(FAR struct pagecache_page_s *page)
+{
+  FAR struct pagecache_page_s **prev;
+
+  prev = &g_pagecache_hash[PAGECACHE_HASH(page->file, page->offset)];
+  while (*prev != page)
+    {
+      prev = &(*prev)->hnext;
+    }
+
+  *prev = page->hnext;
+  dq_rem(&page->lru, &g_pagecache_lru);
+  dq_rem(&page->node, &page->file->pages);
+  g_pagecache_npages--;
+}
+
+/****************************************************************************
+ * Name: pagecache_orphan
+ *
+ * Description:
+ *   Leave a page removed from the cache to pagecache_putdata() if its data
+ *   is still lent.
+ *
+ * Returned Value:
+ *   true if the page is lent and must not be freed or reused.
+ *
+ ****************************************************************************/
+
+static bool pagecache_orphan(FAR struct pagecache_page_s *page)
+{
+  irqstate_t flags;
+  bool lent;
+
+  flags = spin_lock_irqsave(&g_pagecache_reflock);
+  lent  = page->refs > 0;
+  if (lent)
+    {
+      page->file = NULL;
+    }
+
+  spin_unlock_irqrestore(&g_pagecache_reflock, flags);
+  return lent;
+}
+
+/****************************************************************************
+ * Name: pagecache_freepage
+ ****************************************************************************/
+
+static void pagecache_freepage(FAR struct pagecache_page_s *page)
+{
+  pagecache_unlinkpage(page);
+  if (!pagecache_orphan(page))
+    {
+      fs_heap_free(page);
+    }
+}
+
+/****************************************************************************
+ * Name: pagecache_writemap
+ *
+ * Description:
+ *   Write a part of a shared mapping to the file, up to the end of file.
+ *
+ ****************************************************************************/
+
+static int pagecache_writemap(FAR struct pagecache_map_s *map,
+                              FAR struct file *filep, off_t offset,
+                              size_t length)
+{
+  off_t size = map->file->size - map->offset;
+  ssize_t ret;
+
+  if (filep == NULL || (filep->f_oflags & O_WROK) == 0 ||
+      offset >= size)
+    {
+      return OK;
+    }
+
+  length = MIN(length, size - offset);
+  ret = pagecache_io(filep, map->offset + offset, map->vaddr + offset,
+                     length, true);
+  return ret < 0 ? ret : OK;
+}
+
+/****************************************************************************
+ * Name: pagecache_flush
+ *
+ * Description:
+ *   Write back the dirty data of a file through its wfilep.  The data that
+ *   can not be written is dropped, so that a failing file system does not
+ *   fill the cache with pages that can not be evicted.
+ *
+ ****************************************************************************/
+
+static int pagecache_flush(FAR struct pagecache_file_s *file)
+{
+  FAR struct file *filep = file->wfilep;
+  FAR dq_entry_t *node;
+  int ret = OK;
+  int err;
+
+  if (filep == NULL)
+    {
+      return OK;
+    }
+
+  /* The pages are written in the order of the offsets, so that the file
+   * system grows the file without holes.
+   */
+
+  dq_for_every(&file->pages, node)
+    {
+      FAR struct pagecache_page_s *page =
+        container_of(node, struct pagecache_page_s, node);
+
+      if (page->dirty)
+        {
+          page->dirty = false;
+          if (page->offset < file->size)
+            {
+              err = pagecache_io(filep, page->offset, page->data,
+                                 MIN(PAGECACHE_PAGESIZE,
+                                     file->size - page->offset), true);
+              if (err < 0)
+                {
+                  ret = err;
+                }
+            }
+        }
+    }
+
+  dq_for_every(&file->maps, node)
+    {
+      FAR struct pagecache_map_s *map = (FAR struct pagecache_map_s *)node;
+
+      if (map->dirty)
+        {
+          map->dirty = false;
+          err = pagecache_writemap(map, filep, 0, map->size);
+          if (err < 0)
+            {
+              ret = err;
+            }
+        }
+    }
+
+  file->wfilep = NULL;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pagecache_worker
+ *
+ * Description:
+ *   Write back the dirty data of all the files.
+ *
+ ****************************************************************************/
+
+static void pagecache_worker(FAR void *arg)
+{
+  FAR dq_entry_t *node;
+  FAR dq_entry_t *tmp;
+
+  nxrmutex_lock(&g_pagecache_lock);
+  dq_for_every_safe(&g_pagecache_files, node, tmp)
+    {
+      FAR struct pagecache_file_s *file =
+        (FAR struct pagecache_file_s *)node;
+
+      pagecache_flush(file);
+      pagecache_putfile(file);
+    }
+
+  nxrmutex_unlock(&g_pagecache_lock);
+}
+
+/****************************************************************************
+ * Name: pagecache_finddata
+ *
+ * Description:
+ *   Find the cached data of the page of a file at 'offset'.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *pagecache_finddata(FAR struct pagecache_file_s *file,
+                                       off_t offset, FAR bool **dirty)
+{
+  FAR struct pagecache_page_s *page;
+  FAR dq_entry_t *node;
+
+  dq_for_every(&file->maps, node)
+    {
+      FAR struct pagecache_map_s *map = (FAR struct pagecache_map_s *)node;
+
+      if (offset >= map->offset && offset - map->offset < map->size)
+        {
+          *dirty = &map->dirty;
+          return map->vaddr + (offset - map->offset);
+        }
+    }
+
+  page = g_pagecache_hash[PAGECACHE_HASH(file, offset)];
+  for (; page != NULL; page = page->hnext)
+    {
+      if (page->file == file && page->offset == offset)
+        {
+          dq_rem(&page->lru, &g_pagecache_lru);
+          dq_addfirst(&page->lru, &g_pagecache_lru);
+          *dirty = &page->dirty;
+          return page->data;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: pagecache_newpage
+ *
+ * Description:
+ *   Add the page of a file at 'offset' to the cache, evicting the least
+ *   recently used page if the cache is full, and read its data with
+ *   'filep' if 'fill' is true.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *pagecache_newpage(FAR struct pagecache_file_s *file,
+                                      FAR struct file *filep, off_t offset,
+                                      bool fill, FAR bool **dirty,
+                                      FAR int *err)
+{
+  FAR struct pagecache_page_s *page = NULL;
+  FAR struct pagecache_file_s *victim;
+  FAR dq_entry_t *node;
+  ssize_t nread = 0;
+
+  /* Reuse the least recently used page if the cache is full */
+
+  if (g_pagecache_npages >= CONFIG_FS_PAGECACHE_NPAGES)
+    {
+      page   = container_of(dq_tail(&g_pagecache_lru),
+                            struct pagecache_page_s, lru);
+      victim = page->file;
+      if (page->dirty)
+        {
+          pagecache_flush(victim);
+        }
+
+      pagecache_unlinkpage(page);
+      if (victim != file)
+        {
+          pagecache_putfile(victim);
+        }
+
+      if (pagecache_orphan(page))
+        {
+          page = NULL;
+        }
+    }
+
+  if (page == NULL)
+    {
+      page = fs_heap_malloc(sizeof(struct pagecache_page_s));
+      if (page == NULL)
+        {
+          *err = -ENOMEM;
+          return NULL;
+        }
+    }
+
+  if (fill && offset < file->size)
+    {
+      nread = pagecache_io(filep, offset, page->data,
+                           MIN(PAGECACHE_PAGESIZE, file->size - offset),
+                           false);
+      if (nread < 0)
+        {
+          fs_heap_free(page);
+          *err = nread;
+          return NULL;
+        }
+    }
+
+  memset(page->data + nread, 0, PAGECACHE_PAGESIZE - nread);
+
+  page->file   = file;
+  page->offset = offset;
+  page->refs   = 0;
+  page->dirty  = false;
+  page->hnext  = g_pagecache_hash[PAGECACHE_HASH(file, offset)];
+  g_pagecache_hash[PAGECACHE_HASH(file, offset)] = page;
+  dq_addfirst(&page->lru, &g_pagecache_lru);
+  g_pagecache_npages++;
+
+  /* Keep the pages of the file sorted by offset */
+
+  for (node = dq_tail(&file->pages); node != NULL; node = dq_prev(node))
+    {
+      if (container_of(node, struct pagecache_page_s, node)->offset <
+          offset)
+        {
+          break;
+        }
+    }
+
+  if (node != NULL)
+    {
+      dq_addafter(node, &page->node, &file->pages);
+    }
+  else
+    {
+      dq_addfirst(&page->node, &file->pages);
+    }
+
+  *dirty = &page->dirty;
+  return page->data;
+}
+
+/****************************************************************************
+ * Name: pagecache_releasemap
+ *
+ * Description:
+ *   Write back and free a shared mapping that is not used any more.
+ *
+ ****************************************************************************/
+
+static int pagecache_releasemap(FAR struct pagecache_map_s *map)
+{
+  FAR struct pagecache_file_s *file = map->file;
+  int ret = OK;
+
+  if (map->writable)
+    {
+      ret = pagecache_writemap(map, map->filep, 0, map->size);
+    }
+  else if (map->dirty)
+    {
+      ret = pagecache_writemap(map, file->wfilep, 0, map->size);
+    }
+
+  dq_rem(&map->node, &file->maps);
+
+  if (map->type == MAP_KERNEL)
+    {
+      fs_heap_free(map->vaddr);
+    }
+  else
+    {
+      kumm_free(map->vaddr);
+    }
+
+  if (map->filep != NULL)
+    {
+      fs_putfilep(map->filep);
+    }
+
+  fs_heap_free(map);
+  pagecache_putfile(file);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pagecache_msync
+ ****************************************************************************/
+
+static int pagecache_msync(FAR struct mm_map_entry_s *entry,
+                           FAR void *start, size_t length, int flags)
+{
+  FAR struct pagecache_map_s *map = entry->priv.p;
+  off_t offset;
+  int ret;
+
+  offset = (uintptr_t)start - (uintptr_t)entry->vaddr;
+  length = MIN(length, entry->length - offset);
+  offset += (uintptr_t)entry->vaddr - (uintptr_t)map->vaddr;
+
+  nxrmutex_lock(&g_pagecache_lock);
+  ret = pagecache_writemap(map, map->writable ? map->filep :
+                           map->file->wfilep, offset, length);
+  nxrmutex_unlock(&g_pagecache_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pagecache_munmap
+ ****************************************************************************/
+
+static int pagecache_munmap(FAR struct task_group_s *group,
+                            FAR struct mm_map_entry_s *entry,
+                            FAR void *start, size_t length)
+{
+  FAR struct pagecache_map_s *map = entry->priv.p;
+  off_t offset;
+  int ret = OK;
+  int err;
+
+  /* As with rammap(), a mapping can only be unmapped up to its end */
+
+  offset = (uintptr_t)start - (uintptr_t)entry->vaddr;
+  if (offset + length < entry->length)
+    {
+      ferr("ERROR: Cannot umap without unmapping to the end\n");
+      return -ENOSYS;
+    }
+
+  if (offset > 0)
+    {
+      entry->length = offset;
+      return OK;
+    }
+
+  nxrmutex_lock(&g_pagecache_lock);
+  if (--map->refs == 0)
+    {
+      ret = pagecache_releasemap(map);
+    }
+
+  nxrmutex_unlock(&g_pagecache_lock);
+
+  err = mm_map_remove(get_group_mm(group), entry);
+  return ret < 0 ? ret : err;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pagecache_read
+ ****************************************************************************/
+
+ssize_t pagecache_read(FAR struct file *filep, FAR void *buf,
+                       size_t nbytes)
+{
+  FAR struct pagecache_file_s *file;
+  FAR uint8_t *data;
+  FAR bool *dirty;
+  size_t done = 0;
+  off_t pos;
+  ino_t id;
+  int ret = OK;
+
+  if (!pagecache_fileid(filep, &id))
+    {
+      return -ENOSYS;
+    }
+
+  nxrmutex_lock(&g_pagecache_lock);
+  file = pagecache_getfile(filep, id);
+  if (file == NULL)
+    {
+      nxrmutex_unlock(&g_pagecache_lock);
+      return -ENOSYS;
+    }
+
+  pos = filep->f_pos;
+  if (pos < file->size)
+    {
+      nbytes = MIN(nbytes, file->size - pos);
+    }
+  else
+    {
+      nbytes = 0;
+    }
+
+  while (done < nbytes)
+    {
+      off_t offset = pos & ~(off_t)PAGECACHE_PAGEMASK;
+      size_t inpage = pos - offset;
+      size_t chunk = MIN(PAGECACHE_PAGESIZE - inpage, nbytes - done);
+
+      data = pagecache_finddata(file, offset, &dirty);
+      if (data == NULL)
+        {
+          data = pagecache_newpage(file, filep, offset, true, &dirty, &ret);
+          if (data == NULL)
+            {
+              break;
+            }
+        }
+
+      memcpy((FAR uint8_t *)buf + done, data + inpage, chunk);
+      done += chunk;
+      pos  += chunk;
+    }
+
+  filep->f_pos = pos;
+  pagecache_putfile(file);
+  nxrmutex_unlock(&g_pagecache_lock);
+  return done > 0 ? (ssize_t)done : ret;
+}
+
+/****************************************************************************
+ * Name: pagecache_write
+ ****************************************************************************/
+
+ssize_t pagecache_write(FAR struct file *filep, FAR const void *buf,
+                        size_t nbytes)
+{
+  FAR struct pagecache_file_s *file;
+  FAR uint8_t *data;
+  FAR bool *dirty;
+  size_t done = 0;
+  off_t pos;
+  ino_t id;
+  int ret = OK;
+
+  if (!pagecache_fileid(filep, &id) ||
+      filep->f_inode->u.i_mops->write == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  nxrmutex_lock(&g_pagecache_lock);
+  file = pagecache_getfile(filep, id);
+  if (file == NULL)
+    {
+      nxrmutex_unlock(&g_pagecache_lock);
+      return -ENOSYS;
+    }
+
+  pos = (filep->f_oflags & O_APPEND) != 0 ? file->size : filep->f_pos;
+  while (done < nbytes)
+    {
+      off_t offset = pos & ~(off_t)PAGECACHE_PAGEMASK;
+      size_t inpage = pos - offset;
+      size_t chunk = MIN(PAGECACHE_PAGESIZE - inpage, nbytes - done);
+      bool fill;
+
+      /* The page has to be read first unless the write replaces all of
+       * its data.
+       */
+
+      fill = offset < file->size &&
+             (inpage > 0 ||
+              chunk < MIN(PAGECACHE_PAGESIZE, file->size - offset));
+
+      data = pagecache_finddata(file, offset, &dirty);
+      if (data == NULL && fill && (filep->f_oflags & O_RDOK) == 0)
+        {
+          /* A write only file can not fill the page, write it through */
+
+          ret = pagecache_io(filep, pos, (FAR uint8_t *)buf + done, chunk,
+                             true);
+          if (ret < 0)
+            {
+              break;
+            }
+        }
+      else
+        {
+          if (data == NULL)
+            {
+              data = pagecache_newpage(file, filep, offset, fill, &dirty,
+                                       &ret);
+              if (data == NULL)
+                {
+                  break;
+                }
+            }
+
+          memcpy(data + inpage, (FAR const uint8_t *)buf + done, chunk);
+          *dirty       = true;
+          file->wfilep = filep;
+        }
+
+      done += chunk;
+      pos  += chunk;
+      if (pos > file->size)
+        {
+          file->size = pos;
+        }
+    }
+
+  filep->f_pos = pos;
+
+  if (file->wfilep != NULL && work_available(&g_pagecache_work))
+    {
+      work_queue(LPWORK, &g_pagecache_work, pagecache_worker, NULL,
+                 MSEC2TICK(CONFIG_FS_PAGECACHE_WRITEBACK_DELAY));
+    }
+
+  pagecache_putfile(file);
+  nxrmutex_unlock(&g_pagecache_lock);
+  return done > 0 ? (ssize_t)done : ret;
+}
+
+/****************************************************************************
+ * Name: pagecache_getdata
+ ****************************************************************************/
+
+ssize_t pagecache_getdata(FAR struct file *filep, off_t offset,
+                          size_t nbytes, FAR void **base, FAR size_t *skip)
+{
+  FAR struct pagecache_file_s *file;
+  FAR struct pagecache_page_s *page;
+  FAR dq_entry_t *node;
+  FAR uint8_t *data;
+  FAR bool *dirty;
+  irqstate_t flags;
+  size_t inpage;
+  ssize_t ret;
+  ino_t id;
+  int err = OK;
+
+  if (!pagecache_fileid(filep, &id))
+    {
+      return -ENOSYS;
+    }
+
+  nxrmutex_lock(&g_pagecache_lock);
+  file = pagecache_getfile(filep, id);
+  if (file == NULL)
+    {
+      nxrmutex_unlock(&g_pagecache_lock);
+      return -ENOSYS;
+    }
+
+  if (offset >= file->size)
+    {
+      ret = 0;
+      goto out;
+    }
+
+  /* The data of a shared mapping is not in pages */
+
+  inpage = offset & PAGECACHE_PAGEMASK;
+  offset -= inpage;
+  ret = -ENOSYS;
+
+  dq_for_every(&file->maps, node)
+    {
+      FAR struct pagecache_map_s *map = (FAR struct pagecache_map_s *)node;
+
+      if (offset >= map->offset && offset - map->offset < map->size)
+        {
+          goto out;
+        }
+    }
+
+  data = pagecache_finddata(file, offset, &dirty);
+  if (data == NULL)
+    {
+      data = pagecache_newpage(file, filep, offset, true, &dirty, &err);
+      if (data == NULL)
+        {
+          ret = err;
+          goto out;
+        }
+    }
+
+  page = container_of(data, struct pagecache_page_s, data);
+
+  flags = spin_lock_irqsave(&g_pagecache_reflock);
+  page->refs++;
+  spin_unlock_irqrestore(&g_pagecache_reflock, flags);
+
+  *base = page->data;
+  *skip = inpage;
+  ret   = MIN(PAGECACHE_PAGESIZE - inpage, nbytes);
+  if (ret > file->size - (offset + inpage))
+    {
+      ret = file->size - (offset + inpage);
+    }
+
+out:
+  pagecache_putfile(file);
+  nxrmutex_unlock(&g_pagecache_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pagecache_putdata
+ ****************************************************************************/
+
+void pagecache_putdata(FAR void *base)
+{
+  FAR struct pagecache_page_s *page;
+  irqstate_t flags;
+  bool orphan;
+
+  page = container_of(base, struct pagecache_page_s, data);
+
+  flags = spin_lock_irqsave(&g_pagecache_reflock);
+  DEBUGASSERT(page->refs > 0);
+  orphan = --page->refs == 0 && page->file == NULL;
+  spin_unlock_irqrestore(&g_pagecache_reflock, flags);
+
+  if (orphan)
+    {
+      fs_heap_free(page);
+    }
+}
+
+/****************************************************************************
+ * Name: pagecache_seek
+ ****************************************************************************/
+
+off_t pagecache_seek(FAR struct file *filep, off_t offset, int whence)
+{
+  FAR struct pagecache_file_s *file;
+  off_t pos;
+  ino_t id;
+
+  if (!pagecache_fileid(filep, &id))
+    {
+      return -ENOSYS;
+    }
+
+  nxrmutex_lock(&g_pagecache_lock);
+  file = pagecache_getfile(filep, id);
+  if (file == NULL)
+    {
+      nxrmutex_unlock(&g_pagecache_lock);
+      return -ENOSYS;
+    }
+
+  switch (whence)
+    {
+      case SEEK_SET:
+        pos = offset;
+        break;
+
+      case SEEK_CUR:
+        pos = filep->f_pos + offset;
+        break;
+
+      case SEEK_END:
+        pos = file->size + offset;
+        break;
+
+      default:
+        pos = -EINVAL;
+        break;
+    }
+
+  if (pos >= 0)
+    {
+      filep->f_pos = pos;
+    }
+  else
+    {
+      pos = -EINVAL;
+    }
+
+  pagecache_putfile(file);
+  nxrmutex_unlock(&g_pagecache_lock);
+  return pos;
+}
+
+/****************************************************************************
+ * Name: pagecache_close
+ ****************************************************************************/
+
+void pagecache_close(FAR struct file *filep)
+{
+  FAR dq_entry_t *node;
+  FAR dq_entry_t *tmp;
+  ino_t id;
+
+  if (!pagecache_fileid(filep, &id))
+    {
+      return;
+    }
+
+  nxrmutex_lock(&g_pagecache_lock);
+  dq_for_every_safe(&g_pagecache_files, node, tmp)
+    {
+      FAR struct pagecache_file_s *file =
+        (FAR struct pagecache_file_s *)node;
+      FAR dq_entry_t *mnode;
+
+      if (file->wfilep == filep)
+        {
+          pagecache_flush(file);
+        }
+
+      /* The mappings normally hold a reference to their file, but not
+       * without CONFIG_FS_REFCOUNT.
+       */
+
+      dq_for_every(&file->maps, mnode)
+        {
+          FAR struct pagecache_map_s *map =
+            (FAR struct pagecache_map_s *)mnode;
+
+          if (map->filep == filep)
+            {
+              if (map->writable)
+                {
+                  pagecache_writemap(map, filep, 0, map->size);
+                }
+
+              map->filep    = NULL;
+              map->writable = false;
+            }
+        }
+
+      pagecache_putfile(file);
+    }
+
+  nxrmutex_unlock(&g_pagecache_lock);
+}
+
+/****************************************************************************
+ * Name: pagecache_sync
+ ****************************************************************************/
+
+int pagecache_sync(FAR struct file *filep)
+{
+  FAR struct pagecache_file_s *file;
+  FAR dq_entry_t *node;
+  int ret = OK;
+  int err;
+  ino_t id;
+
+  if (!pagecache_fileid(filep, &id))
+    {
+      return -ENOSYS;
+    }
+
+  nxrmutex_lock(&g_pagecache_lock);
+  file = pagecache_findfile(filep->f_inode, id);
+  if (file != NULL)
+    {
+      ret = pagecache_flush(file);
+
+      dq_for_every(&file->maps, node)
+        {
+          FAR struct pagecache_map_s *map =
+            (FAR struct pagecache_map_s *)node;
+
+          if (map->writable)
+            {
+              err = pagecache_writemap(map, map->filep, 0, map->size);
+              if (err < 0)
+                {
+                  ret = err;
+                }
+            }
+        }
+
+      pagecache_putfile(file);
+    }
+
+  nxrmutex_unlock(&g_pagecache_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pagecache_truncate
+ ****************************************************************************/
+
+void pagecache_truncate(FAR struct file *filep, off_t length)
+{
+  FAR struct pagecache_file_s *file;
+  FAR dq_entry_t *node;
+  FAR dq_entry_t *tmp;
+  ino_t id;
+
+  if (!pagecache_fileid(filep, &id))
+    {
+      return;
+    }
+
+  nxrmutex_lock(&g_pagecache_lock);
+  file = pagecache_findfile(filep->f_inode, id);
+  if (file == NULL)
+    {
+      nxrmutex_unlock(&g_pagecache_lock);
+      return;
+    }
+
+  /* Drop the pages beyond the new end of file and clear the rest of the
+   * last one, so that the file reads back zeros if it grows again.
+   */
+
+  dq_for_every_safe(&file->pages, node, tmp)
+    {
+      FAR struct pagecache_page_s *page =
+        container_of(node, struct pagecache_page_s, node);
+
+      if (page->offset >= length)
+        {
+          pagecache_freepage(page);
+        }
+      else if (length - page->offset < PAGECACHE_PAGESIZE)
+        {
+          memset(page->data + (length - page->offset), 0,
+                 PAGECACHE_PAGESIZE - (length - page->offset));
+        }
+    }
+
+  dq_for_every(&file->maps, node)
+    {
+      FAR struct pagecache_map_s *map = (FAR struct pagecache_map_s *)node;
+
+      if (length < map->offset + (off_t)map->size)
+        {
+          off_t start = MAX(length - map->offset, 0);
+
+          memset(map->vaddr + start, 0, map->size - start);
+        }
+    }
+
+  file->size = length;
+  pagecache_putfile(file);
+  nxrmutex_unlock(&g_pagecache_lock);
+}
+
+/****************************************************************************
+ * Name: pagecache_fstat
+ ****************************************************************************/
+
+void pagecache_fstat(FAR struct file *filep, FAR struct stat *buf)
+{
+  FAR struct pagecache_file_s *file;
+  ino_t id;
+
+  if (!pagecache_fileid(filep, &id))
+    {
+      return;
+    }
+
+  nxrmutex_lock(&g_pagecache_lock);
+  file = pagecache_findfile(filep->f_inode, id);
+  if (file != NULL)
+    {
+      buf->st_size = file->size;
+    }
+
+  nxrmutex_unlock(&g_pagecache_lock);
+}
+
+/****************************************************************************
+ * Name: pagecache_mmap
+ ****************************************************************************/
+
+int pagecache_mmap(FAR struct file *filep, FAR struct mm_map_entry_s *entry,
+                   int type)
+{
+  FAR struct pagecache_map_s *map = NULL;
+  FAR struct pagecache_file_s *file;
+  FAR dq_entry_t *node;
+  FAR dq_entry_t *tmp;
+  off_t end;
+  ino_t id;
+  int ret;
+
+  if ((entry->offset & PAGECACHE_PAGEMASK) != 0 || type == MAP_XIP ||
+      !pagecache_fileid(filep, &id))
+    {
+      return -ENOSYS;
+    }
+
+  nxrmutex_lock(&g_pagecache_lock);
+  file = pagecache_getfile(filep, id);
+  if (file == NULL)
+    {
+      nxrmutex_unlock(&g_pagecache_lock);
+      return -ENOSYS;
+    }
+
+  /* Share the mapping that covers the range.  A range that overlaps other
+   * mappings partly is left to rammap(), it would cache the data twice.
+   */
+
+  end = entry->offset + entry->length;
+  ret = -ENOSYS;
+
+  dq_for_every(&file->maps, node)
+    {
+      FAR struct pagecache_map_s *tmpmap =
+        (FAR struct pagecache_map_s *)node;
+
+      if (tmpmap->type == type && entry->offset >= tmpmap->offset &&
+          end <= tmpmap->offset + (off_t)tmpmap->size)
+        {
+          map = tmpmap;
+          break;
+        }
+      else if (entry->offset < tmpmap->offset + (off_t)tmpmap->size &&
+               end > tmpmap->offset)
+        {
+          goto errout_with_lock;
+        }
+    }
+
+  if (map == NULL)
+    {
+      ssize_t nread = 0;
+      size_t size;
+
+      size = (entry->length + PAGECACHE_PAGEMASK) &
+             ~(size_t)PAGECACHE_PAGEMASK;
+
+      ret = -ENOMEM;
+      map = fs_heap_zalloc(sizeof(struct pagecache_map_s));
+      if (map == NULL)
+        {
+          goto errout_with_lock;
+        }
+
+      map->vaddr = type == MAP_KERNEL ? fs_heap_malloc(size) :
+                                        kumm_malloc(size);
+      if (map->vaddr == NULL)
+        {
+          goto errout_with_map;
+        }
+
+      /* Read the range, then take the cached pages that are more recent */
+
+      if (entry->offset < file->size)
+        {
+          nread = pagecache_io(filep, entry->offset, map->vaddr,
+                               MIN(size, file->size - entry->offset),
+                               false);
+          if (nread < 0)
+            {
+              ret = nread;
+              goto errout_with_vaddr;
+            }
+        }
+
+      memset(map->vaddr + nread, 0, size - nread);
+
+      map->file   = file;
+      map->filep  = filep;
+      map->offset = entry->offset;
+      map->size   = size;
+      map->type   = type;
+
+      dq_for_every_safe(&file->pages, node, tmp)
+        {
+          FAR struct pagecache_page_s *page =
+            container_of(node, struct pagecache_page_s, node);
+
+          if (page->offset >= map->offset &&
+              page->offset - map->offset < size)
+            {
+              memcpy(map->vaddr + (page->offset - map->offset),
+                     page->data, PAGECACHE_PAGESIZE);
+              map->dirty |= page->dirty;
+              pagecache_freepage(page);
+            }
+        }
+
+      fs_reffilep(filep);
+      dq_addlast(&map->node, &file->maps);
+    }
+
+  map->refs++;
+  if ((entry->prot & PROT_WRITE) != 0)
+    {
+      map->writable = true;
+    }
+
+  entry->vaddr  = map->vaddr + (entry->offset - map->offset);
+  entry->priv.p = map;
+  entry->munmap = pagecache_munmap;
+  entry->msync  = pagecache_msync;
+  nxrmutex_unlock(&g_pagecache_lock);
+
+  /* munmap() takes the lock of the mappings before the lock of the cache,
+   * so the mapping is added without the latter.
+   */
+
+  ret = mm_map_add(get_current_mm(), entry);
+  if (ret < 0)
+    {
+      nxrmutex_lock(&g_pagecache_lock);
+      if (--map->refs == 0)
+        {
+          pagecache_releasemap(map);
+        }
+
+      nxrmutex_unlock(&g_pagecache_lock);
+    }
+
+  return ret;
+
+errout_with_vaddr:
+  if (type == MAP_KERNEL)
+    {
+      fs_heap_free(map->vaddr);
+    }
+  else
+    {
+      kumm_free(map->vaddr);
+    }
+
+errout_with_map:
+  fs_heap_free(map);
+
+errout_with_lock:
+  pagecache_putfile(file);
+  nxrmutex_unlock(&g_pagecache_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pagecache_invalidate
+ ****************************************************************************/
+
+void pagecache_invalidate(FAR struct inode *mountpt)
+{
+  FAR dq_entry_t *node;
+  FAR dq_entry_t *tmp;
+
+  nxrmutex_lock(&g_pagecache_lock);
+  dq_for_every_safe(&g_pagecache_files, node, tmp)
+    {
+      FAR struct pagecache_file_s *file =
+        (FAR struct pagecache_file_s *)node;
+
+      if (file->mountpt == mountpt && file->wfilep == NULL &&
+          dq_empty(&file->maps))
+        {
+          while (!dq_empty(&file->pages))
+            {
+              pagecache_freepage(container_of(dq_peek(&file->pages),
+                                              struct pagecache_page_s,
+                                              node));
+            }
+
+          pagecache_putfile(file);
+        }
+    }
+
+  nxrmutex_unlock(&g_pagecache_lock);
+}
+
+#endif /* CONFIG_FS_PAGECACHE */
@@ -430,6 +430,19 @@ int poll(FAR struct pollfd *fds, nfds_t nfds, int timeout)
 
   enter_cancellation_point();
 
+#ifdef CONFIG_FS_POLL_CACHE
+  /* Reuse the polls of the last call of the thread if it can */
+
+  ret = poll_cache_wait(fds, nfds, timeout);
+  if (ret != -ENOSYS)
+    {
+      count = ret;
+      goto out_with_cache;
+    }
+
+  ret = OK;
+#endif
+
 #ifdef CONFIG_BUILD_KERNEL
   /* Allocate kernel memory for the fds */
 
@@ -545,6 +558,9 @@ int poll(FAR struct pollfd *fds, nfds_t nfds, int timeout)
 out_with_cancelpt:
 #endif
 
+#ifdef CONFIG_FS_POLL_CACHE
+out_with_cache:
+#endif
   leave_cancellation_point();
 
   if (ret < 0)
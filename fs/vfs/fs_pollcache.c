@@ -0,0 +1,497 @@
+/****************************************************************************
+ * fs/vfs/fs_pollcache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <poll.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/list.h>
+#include <nuttx/mutex.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+
+#include "sched/sched.h"
+#include "fs_heap.h"
+
+/* Each thread keeps the polls of its last poll() call set up:  They stay
+ * valid as long as the thread polls the same descriptors and events again,
+ * so a call only sets up again the descriptors that reported events, to
+ * check if they are still ready, like the level triggered descriptors of
+ * epoll.  A cached poll holds a reference to its file:  close() and dup2()
+ * tear down the cached polls of the file first, in all threads.
+ */
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct poll_cache_entry_s
+{
+  struct pollfd pfd;             /* The poll, set up if filep is not NULL */
+  FAR struct file *filep;        /* The polled file, referenced */
+};
+
+struct poll_cache_s
+{
+  struct list_node node;         /* In g_poll_caches */
+  mutex_t lock;                  /* Protects the entries */
+  sem_t sem;                     /* Posted by the poll callbacks */
+  FAR struct tcb_s *tcb;         /* The thread of the cache */
+  bool busy;                     /* In poll_cache_wait() */
+  bool flush;                    /* Tear down all at the end of the call */
+  nfds_t nalloc;                 /* The size of entries */
+  nfds_t nentries;               /* The number of entries in use */
+  FAR struct poll_cache_entry_s *entries;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct list_node g_poll_caches = LIST_INITIAL_VALUE(g_poll_caches);
+static mutex_t g_poll_caches_lock = NXMUTEX_INITIALIZER;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: poll_cache_teardown
+ *
+ * Description:
+ *   Tear down the poll of an entry and drop its reference.
+ *
+ ****************************************************************************/
+
+static void poll_cache_teardown(FAR struct poll_cache_entry_s *entry)
+{
+  if (entry->filep != NULL)
+    {
+      file_poll(entry->filep, &entry->pfd, false);
+      fs_putfilep(entry->filep);
+      entry->filep = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: poll_cache_flush
+ *
+ * Description:
+ *   Tear down the entries from 'first' on.
+ *
+ ****************************************************************************/
+
+static void poll_cache_flush(FAR struct poll_cache_s *cache, nfds_t first)
+{
+  nfds_t i;
+
+  for (i = first; i < cache->nentries; i++)
+    {
+      poll_cache_teardown(&cache->entries[i]);
+    }
+
+  cache->nentries = first;
+}
+
+/****************************************************************************
+ * Name: poll_cache_setup
+ *
+ * Description:
+ *   Set up the poll of an entry, or report POLLERR if it fails.
+ *
+ ****************************************************************************/
+
+static void poll_cache_setup(FAR struct poll_cache_s *cache,
+                             FAR struct poll_cache_entry_s *entry,
+                             FAR const struct pollfd *fds)
+{
+  FAR struct file *filep;
+
+  entry->pfd.fd      = fds->fd;
+  entry->pfd.events  = fds->events;
+  entry->pfd.revents = 0;
+  entry->pfd.arg     = &cache->sem;
+  entry->pfd.cb      = poll_default_cb;
+  entry->pfd.priv    = NULL;
+
+  /* "If the value of fd is less than 0, events shall be ignored" */
+
+  if (fds->fd < 0)
+    {
+      return;
+    }
+
+  if (fs_getfilep(fds->fd, &filep) < 0)
+    {
+      entry->pfd.revents = POLLERR;
+    }
+  else if (file_poll(filep, &entry->pfd, true) < 0)
+    {
+      entry->pfd.revents |= POLLERR;
+      fs_putfilep(filep);
+    }
+  else
+    {
+      entry->filep = filep;
+    }
+}
+
+/****************************************************************************
+ * Name: poll_cache_valid
+ *
+ * Description:
+ *   Check that a cached poll is still the poll asked for by 'fds'.
+ *
+ ****************************************************************************/
+
+static bool poll_cache_valid(FAR struct poll_cache_entry_s *entry,
+                             FAR const struct pollfd *fds)
+{
+  FAR struct file *filep;
+
+  if (entry->pfd.fd != fds->fd || entry->pfd.events != fds->events ||
+      fs_getfilep(fds->fd, &filep) < 0)
+    {
+      return false;
+    }
+
+  fs_putfilep(filep);
+  return filep == entry->filep;
+}
+
+/****************************************************************************
+ * Name: poll_cache_prepare
+ *
+ * Description:
+ *   Make the entries match 'fds' and return the number of descriptors that
+ *   have events.
+ *
+ ****************************************************************************/
+
+static int poll_cache_prepare(FAR struct poll_cache_s *cache,
+                              FAR struct pollfd *fds, nfds_t nfds)
+{
+  FAR struct poll_cache_entry_s *entry;
+  int count = 0;
+  nfds_t i;
+
+  if (nfds > cache->nalloc)
+    {
+      /* The polls point to the entries, tear them all down to move them */
+
+      poll_cache_flush(cache, 0);
+      fs_heap_free(cache->entries);
+
+      cache->nalloc  = 0;
+      cache->entries = fs_heap_zalloc(nfds * sizeof(*cache->entries));
+      if (cache->entries == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      cache->nalloc = nfds;
+    }
+
+  if (nfds < cache->nentries)
+    {
+      poll_cache_flush(cache, nfds);
+    }
+
+  /* Skip the semaphore counts of the events that are already recorded in
+   * the entries.
+   */
+
+  while (nxsem_trywait(&cache->sem) == OK)
+    {
+    }
+
+  for (i = 0; i < nfds; i++)
+    {
+      entry = &cache->entries[i];
+
+      if (i >= cache->nentries || entry->filep == NULL ||
+          !poll_cache_valid(entry, &fds[i]))
+        {
+          poll_cache_teardown(entry);
+          poll_cache_setup(cache, entry, &fds[i]);
+        }
+      else if (entry->pfd.revents != 0)
+        {
+          /* Set up again the descriptors that reported events, the set up
+           * reports them again if they are still ready.
+           */
+
+          file_poll(entry->filep, &entry->pfd, false);
+          entry->pfd.revents = 0;
+          if (file_poll(entry->filep, &entry->pfd, true) < 0)
+            {
+              fs_putfilep(entry->filep);
+              entry->filep = NULL;
+              entry->pfd.revents |= POLLERR;
+            }
+        }
+
+      if (entry->pfd.revents != 0)
+        {
+          count++;
+        }
+    }
+
+  cache->nentries = nfds;
+  return count;
+}
+
+/****************************************************************************
+ * Name: poll_cache_collect
+ *
+ * Description:
+ *   Return the events of the entries in 'fds' and count the descriptors
+ *   that have events.
+ *
+ ****************************************************************************/
+
+static int poll_cache_collect(FAR struct poll_cache_s *cache,
+                              FAR struct pollfd *fds, nfds_t nfds)
+{
+  int count = 0;
+  nfds_t i;
+
+  for (i = 0; i < nfds; i++)
+    {
+      fds[i].revents = cache->entries[i].pfd.revents;
+      if (fds[i].revents != 0)
+        {
+          count++;
+        }
+    }
+
+  return count;
+}
+
+/****************************************************************************
+ * Name: poll_cache_get
+ *
+ * Description:
+ *   Get the cache of the running thread, allocate it on the first use.
+ *
+ ****************************************************************************/
+
+static FAR struct poll_cache_s *poll_cache_get(void)
+{
+  FAR struct tcb_s *tcb = this_task();
+  FAR struct poll_cache_s *cache = tcb->pollcache;
+
+  if (cache == NULL)
+    {
+      cache = fs_heap_zalloc(sizeof(struct poll_cache_s));
+      if (cache == NULL)
+        {
+          return NULL;
+        }
+
+      nxmutex_init(&cache->lock);
+      nxsem_init(&cache->sem, 0, 0);
+      cache->tcb = tcb;
+
+      nxmutex_lock(&g_poll_caches_lock);
+      list_add_tail(&g_poll_caches, &cache->node);
+      nxmutex_unlock(&g_poll_caches_lock);
+
+      tcb->pollcache = cache;
+    }
+
+  return cache;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: poll_cache_wait
+ *
+ * Description:
+ *   poll() with the interest set of the running thread:  Set up the polls
+ *   that changed or reported events since the last call, wait for events
+ *   and leave the polls set up.
+ *
+ * Input Parameters:
+ *   fds     - List of structures describing file descriptors to be
+ *             monitored
+ *   nfds    - The number of entries in the list
+ *   timeout - The timeout in milliseconds, negative to wait for ever
+ *
+ * Returned Value:
+ *   The number of descriptors with events, zero on timeout or a negated
+ *   errno value.  -ENOSYS if the cache cannot be used, e.g. poll() is
+ *   called from a signal handler interrupting poll(), and the caller should
+ *   set up and tear down the polls itself.
+ *
+ ****************************************************************************/
+
+int poll_cache_wait(FAR struct pollfd *fds, nfds_t nfds, int timeout)
+{
+  FAR struct poll_cache_s *cache;
+  int count;
+  int ret = OK;
+
+  if (nfds == 0 || nfds > CONFIG_FS_POLL_CACHE_MAXFDS)
+    {
+      return -ENOSYS;
+    }
+
+  cache = poll_cache_get();
+  if (cache == NULL || cache->busy)
+    {
+      return -ENOSYS;
+    }
+
+  cache->busy = true;
+
+  nxmutex_lock(&cache->lock);
+  count = poll_cache_prepare(cache, fds, nfds);
+  nxmutex_unlock(&cache->lock);
+
+  if (count < 0)
+    {
+      cache->busy = false;
+      return -ENOSYS;
+    }
+
+  if (count == 0 && timeout != 0)
+    {
+      /* The callbacks of the polls post the semaphore, see poll() for the
+       * rounding of the timeout.
+       */
+
+      if (timeout > 0)
+        {
+          ret = nxsem_tickwait(&cache->sem, MSEC2TICK((clock_t)timeout));
+          if (ret == -ETIMEDOUT)
+            {
+              ret = OK;
+            }
+        }
+      else
+        {
+          ret = nxsem_wait(&cache->sem);
+        }
+    }
+
+  nxmutex_lock(&cache->lock);
+  count = poll_cache_collect(cache, fds, nfds);
+
+  /* A file of the cache was closed from a signal handler during the call */
+
+  if (cache->flush)
+    {
+      poll_cache_flush(cache, 0);
+      cache->flush = false;
+    }
+
+  nxmutex_unlock(&cache->lock);
+
+  cache->busy = false;
+  return ret < 0 ? ret : count;
+}
+
+/****************************************************************************
+ * Name: poll_cache_forget
+ *
+ * Description:
+ *   Tear down the cached polls of a file and drop their references, before
+ *   its descriptor is closed or replaced.
+ *
+ ****************************************************************************/
+
+void poll_cache_forget(FAR struct file *filep)
+{
+  FAR struct poll_cache_s *cache;
+  FAR struct tcb_s *rtcb = this_task();
+  nfds_t i;
+
+  nxmutex_lock(&g_poll_caches_lock);
+
+  list_for_every_entry(&g_poll_caches, cache, struct poll_cache_s, node)
+    {
+      /* The thread of a busy cache closes a file from a signal handler
+       * interrupting poll(), maybe with the lock of the cache held:  Tear
+       * down the cache at the end of the call instead.
+       */
+
+      if (cache->tcb == rtcb && cache->busy)
+        {
+          cache->flush = true;
+          continue;
+        }
+
+      nxmutex_lock(&cache->lock);
+
+      for (i = 0; i < cache->nentries; i++)
+        {
+          if (cache->entries[i].filep == filep)
+            {
+              poll_cache_teardown(&cache->entries[i]);
+            }
+        }
+
+      nxmutex_unlock(&cache->lock);
+    }
+
+  nxmutex_unlock(&g_poll_caches_lock);
+}
+
+/****************************************************************************
+ * Name: poll_cache_release
+ *
+ * Description:
+ *   Tear down and free the poll cache of an exiting thread.
+ *
+ ****************************************************************************/
+
+void poll_cache_release(FAR struct tcb_s *tcb)
+{
+  FAR struct poll_cache_s *cache = tcb->pollcache;
+
+  if (cache == NULL)
+    {
+      return;
+    }
+
+  nxmutex_lock(&g_poll_caches_lock);
+  list_delete(&cache->node);
+  nxmutex_unlock(&g_poll_caches_lock);
+
+  tcb->pollcache = NULL;
+
+  poll_cache_flush(cache, 0);
+  fs_heap_free(cache->entries);
+  nxsem_destroy(&cache->sem);
+  nxmutex_destroy(&cache->lock);
+  fs_heap_free(cache);
+}
@@ -35,6 +35,7 @@
 
 #include "notify/notify.h"
 #include "inode/inode.h"
+#include "vfs/pagecache.h"
 
 /****************************************************************************
  * Public Functions
@@ -87,12 +88,17 @@ ssize_t file_read(FAR struct file *filep, FAR void *buf, size_t nbytes)
     {
       /* Yes.. then let it perform the read.  NOTE that for the case of the
        * mountpoint, we depend on the read methods being identical in
-       * signature and position in the operations vtable.
+       * signature and position in the operations vtable.  The data of
+       * the cached files comes from the page cache.
        */
 
-      ret = inode->u.i_ops->read(filep,
-                                 (FAR char *)buf,
-                                 (size_t)nbytes);
+      ret = pagecache_read(filep, buf, nbytes);
+      if (ret == -ENOSYS)
+        {
+          ret = inode->u.i_ops->read(filep,
+                                     (FAR char *)buf,
+                                     (size_t)nbytes);
+        }
     }
 
   /* Return the number of bytes read (or possibly an error code) */
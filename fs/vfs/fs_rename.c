@@ -37,6 +37,7 @@
 
 #include "notify/notify.h"
 #include "inode/inode.h"
+#include "vfs/pagecache.h"
 #include "fs_heap.h"
 
 /****************************************************************************
@@ -464,6 +465,12 @@ next_subdir:
    */
 
   ret = oldinode->u.i_mops->rename(oldinode, oldrelpath, newrelpath);
+  if (ret >= 0)
+    {
+      /* The renamed file may have replaced another one */
+
+      pagecache_invalidate(oldinode);
+    }
 
 #ifdef CONFIG_FS_NOTIFY
   if (ret >= 0)
@@ -24,6 +24,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/param.h>
 #include <sys/sendfile.h>
 #include <stdbool.h>
 #include <errno.h>
@@ -38,11 +39,61 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: copyfile_read
+ *
+ * Description:
+ *   Read up to 'nbytes' from the current position of the infile.  The data
+ *   that the file system can lend (see file_getdata()) is written from its
+ *   own memory, '*putdata' then gives it back.  The rest is read into the
+ *   I/O buffer.  '*rdbuffer' is set to the data read.
+ *
+ ****************************************************************************/
+
+static ssize_t copyfile_read(FAR struct file *infile, FAR uint8_t *iobuffer,
+                             size_t nbytes, FAR uint8_t **rdbuffer,
+                             FAR void **base, FAR file_putdata_t *putdata)
+{
+  ssize_t nread;
+  size_t skip;
+  off_t pos;
+
+  *putdata = NULL;
+
+  pos = file_seek(infile, 0, SEEK_CUR);
+  if (pos >= 0)
+    {
+      nread = file_getdata(infile, pos, nbytes, base, &skip, putdata);
+      if (nread > 0)
+        {
+          pos = file_seek(infile, pos + nread, SEEK_SET);
+          if (pos < 0)
+            {
+              (*putdata)(*base);
+              *putdata = NULL;
+              return pos;
+            }
+
+          *rdbuffer = (FAR uint8_t *)*base + skip;
+          return nread;
+        }
+      else if (nread != -ENOSYS)
+        {
+          return nread;
+        }
+    }
+
+  *rdbuffer = iobuffer;
+  return file_read(infile, iobuffer, MIN(nbytes, CONFIG_SENDFILE_BUFSIZE));
+}
+
 static ssize_t copyfile(FAR struct file *outfile, FAR struct file *infile,
                         FAR off_t *offset, size_t count)
 {
+  file_putdata_t putdata = NULL;
   FAR uint8_t *iobuffer;
   FAR uint8_t *wrbuffer;
+  FAR void *base;
   off_t startpos = 0;
   ssize_t nbytesread;
   ssize_t nbyteswritten;
@@ -90,13 +141,8 @@ static ssize_t copyfile(FAR struct file *outfile, FAR struct file *infile,
         {
           /* Read a buffer of data from the infile */
 
-          nbytesread = count - ntransferred;
-          if (nbytesread > CONFIG_SENDFILE_BUFSIZE)
-            {
-              nbytesread = CONFIG_SENDFILE_BUFSIZE;
-            }
-
-          nbytesread = file_read(infile, iobuffer, nbytesread);
+          nbytesread = copyfile_read(infile, iobuffer, count - ntransferred,
+                                     &wrbuffer, &base, &putdata);
 
           /* Check for end of file */
 
@@ -140,7 +186,6 @@ static ssize_t copyfile(FAR struct file *outfile, FAR struct file *infile,
            * conclusion.
            */
 
-          wrbuffer = iobuffer;
           do
             {
               /* Write the buffer of data to the outfile */
@@ -192,6 +237,13 @@ static ssize_t copyfile(FAR struct file *outfile, FAR struct file *infile,
                 }
             }
           while (nbytesread > 0);
+
+          /* Give back the data lent by the infile */
+
+          if (putdata != NULL)
+            {
+              putdata(base);
+            }
         }
     }
 
@@ -0,0 +1,318 @@
+/****************************************************************************
+ * fs/vfs/fs_splice.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <sys/sendfile.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+
+#include "fs_heap.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: splice_wait
+ *
+ * Description:
+ *   The input of a pipe has no data yet:  Wait for it without the lock of
+ *   the pipe, reading up to CONFIG_SENDFILE_BUFSIZE bytes into an I/O buffer
+ *   that is then written to the pipe.
+ *
+ ****************************************************************************/
+
+static ssize_t splice_wait(FAR struct file *infile, FAR off_t *inoffset,
+                           FAR struct file *outfile, size_t len)
+{
+  FAR uint8_t *iobuffer;
+  ssize_t nread;
+  ssize_t ret;
+
+  iobuffer = fs_heap_malloc(CONFIG_SENDFILE_BUFSIZE);
+  if (iobuffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  len = MIN(len, CONFIG_SENDFILE_BUFSIZE);
+  if (inoffset != NULL)
+    {
+      nread = file_pread(infile, iobuffer, len, *inoffset);
+    }
+  else
+    {
+      nread = file_read(infile, iobuffer, len);
+    }
+
+  ret = nread;
+  if (nread > 0)
+    {
+      ret = file_write(outfile, iobuffer, nread);
+      if (ret > 0 && inoffset != NULL)
+        {
+          *inoffset += ret;
+        }
+    }
+
+  fs_heap_free(iobuffer);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_splice
+ *
+ * Description:
+ *   Equivalent to the standard splice function except that is accepts
+ *   struct file instances instead of file descriptors.
+ *
+ ****************************************************************************/
+
+ssize_t file_splice(FAR struct file *infile, FAR off_t *inoffset,
+                    FAR struct file *outfile, FAR off_t *outoffset,
+                    size_t len, unsigned int flags)
+{
+  struct pipe_splice_s splice;
+  ssize_t ret;
+
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  if (infile->f_inode == outfile->f_inode)
+    {
+      return -EINVAL;
+    }
+
+  splice.len   = len;
+  splice.flags = flags;
+
+  /* The pipe writes its data straight from its buffer, or reads the data
+   * of the other file straight into its buffer.
+   */
+
+  if (INODE_IS_PIPE(infile->f_inode))
+    {
+      if (inoffset != NULL)
+        {
+          return -ESPIPE;
+        }
+
+      splice.filep  = outfile;
+      splice.offset = outoffset;
+      return file_ioctl(infile, PIPEIOC_SPLICEOUT, (unsigned long)&splice);
+    }
+
+  if (INODE_IS_PIPE(outfile->f_inode))
+    {
+      if (outoffset != NULL)
+        {
+          return -ESPIPE;
+        }
+
+      splice.filep  = infile;
+      splice.offset = inoffset;
+      ret = file_ioctl(outfile, PIPEIOC_SPLICEIN, (unsigned long)&splice);
+      if (ret == -ENODATA)
+        {
+          ret = splice_wait(infile, inoffset, outfile, len);
+        }
+
+      return ret;
+    }
+
+  /* One of the files must be a pipe */
+
+  return -EINVAL;
+}
+
+/****************************************************************************
+ * Name: file_tee
+ *
+ * Description:
+ *   Equivalent to the standard tee function except that is accepts struct
+ *   file instances instead of file descriptors.
+ *
+ ****************************************************************************/
+
+ssize_t file_tee(FAR struct file *infile, FAR struct file *outfile,
+                 size_t len, unsigned int flags)
+{
+  struct pipe_splice_s splice;
+
+  if (!INODE_IS_PIPE(infile->f_inode) || !INODE_IS_PIPE(outfile->f_inode) ||
+      infile->f_inode == outfile->f_inode)
+    {
+      return -EINVAL;
+    }
+
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  splice.filep  = outfile;
+  splice.offset = NULL;
+  splice.len    = len;
+  splice.flags  = flags;
+  return file_ioctl(infile, PIPEIOC_TEE, (unsigned long)&splice);
+}
+
+/****************************************************************************
+ * Name: splice
+ *
+ * Description:
+ *   splice() moves up to 'len' bytes between two file descriptors, one of
+ *   which must be a pipe, without copying them through the user memory:
+ *   The pipe writes the data straight from its buffer to the other file,
+ *   or reads the data of the other file straight into its buffer, so no
+ *   more than one copy is made.
+ *
+ *   NOTE: This interface is *not* specified in POSIX.  The implementation
+ *   here is similar to the Linux splice interface, except that the data is
+ *   always copied into or out of the buffer of the pipe.
+ *
+ * Input Parameters:
+ *   fdin   - A descriptor opened for reading.
+ *   offin  - The offset in 'fdin' from which the data is read, updated on
+ *            return, or NULL to read from the current file offset.  Must
+ *            be NULL if 'fdin' is a pipe.
+ *   fdout  - A descriptor opened for writing.
+ *   offout - The offset in 'fdout' to which the data is written, as
+ *            'offin'.
+ *   len    - The maximum number of bytes to move.
+ *   flags  - SPLICE_F_NONBLOCK not to wait for the pipe.  The other flags
+ *            are accepted and ignored.
+ *
+ * Returned Value:
+ *   The number of bytes moved, zero at the end of the input.  On error,
+ *   -1 is returned, and errno is set appropriately:
+ *
+ *   EINVAL - Neither descriptor is a pipe, or both are the same pipe.
+ *   ESPIPE - An offset was given for a pipe.
+ *   EAGAIN - SPLICE_F_NONBLOCK was given and the pipe would block.
+ *
+ ****************************************************************************/
+
+ssize_t splice(int fdin, FAR off_t *offin, int fdout, FAR off_t *offout,
+               size_t len, unsigned int flags)
+{
+  FAR struct file *infile;
+  FAR struct file *outfile;
+  ssize_t ret;
+
+  ret = fs_getfilep(fdin, &infile);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  ret = fs_getfilep(fdout, &outfile);
+  if (ret < 0)
+    {
+      fs_putfilep(infile);
+      goto errout;
+    }
+
+  ret = file_splice(infile, offin, outfile, offout, len, flags);
+  fs_putfilep(outfile);
+  fs_putfilep(infile);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  return ret;
+
+errout:
+  set_errno(-ret);
+  return ERROR;
+}
+
+/****************************************************************************
+ * Name: tee
+ *
+ * Description:
+ *   tee() copies up to 'len' bytes from the pipe 'fdin' to the pipe 'fdout'
+ *   without consuming them, so that they can still be spliced or read from
+ *   'fdin'.
+ *
+ * Input Parameters:
+ *   fdin  - A pipe opened for reading.
+ *   fdout - Another pipe opened for writing.
+ *   len   - The maximum number of bytes to copy.
+ *   flags - SPLICE_F_NONBLOCK not to wait for 'fdin'.
+ *
+ * Returned Value:
+ *   The number of bytes copied, zero if 'fdin' has no writers left.  On
+ *   error, -1 is returned, and errno is set appropriately:
+ *
+ *   EINVAL - A descriptor is not a pipe, or both are the same pipe.
+ *   EAGAIN - SPLICE_F_NONBLOCK was given and 'fdin' is empty.
+ *
+ ****************************************************************************/
+
+ssize_t tee(int fdin, int fdout, size_t len, unsigned int flags)
+{
+  FAR struct file *infile;
+  FAR struct file *outfile;
+  ssize_t ret;
+
+  ret = fs_getfilep(fdin, &infile);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  ret = fs_getfilep(fdout, &outfile);
+  if (ret < 0)
+    {
+      fs_putfilep(infile);
+      goto errout;
+    }
+
+  ret = file_tee(infile, outfile, len, flags);
+  fs_putfilep(outfile);
+  fs_putfilep(infile);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  return ret;
+
+errout:
+  set_errno(-ret);
+  return ERROR;
+}
@@ -32,6 +32,7 @@
 #include <debug.h>
 
 #include <nuttx/irq.h>
+#include <nuttx/hrtimer.h>
 #include <nuttx/wdog.h>
 #include <nuttx/mutex.h>
 
@@ -46,6 +47,25 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* The expirations are rounded up to a multiple of the slack, so that the
+ * timers expiring within the same slack are handled by the same timer
+ * interrupt.
+ */
+
+#ifdef CONFIG_TIMER_FD_HRTIMER
+#  define TIMERFD_SLACK   ((uint64_t)CONFIG_TIMER_FD_SLACK * NSEC_PER_USEC)
+#else
+#  define TIMERFD_SLACK   USEC2TICK(CONFIG_TIMER_FD_SLACK)
+#endif
+
+#if CONFIG_TIMER_FD_SLACK > 0
+#  define timerfd_slack(t) \
+     (TIMERFD_SLACK > 1 ? ((t) + TIMERFD_SLACK - 1) / TIMERFD_SLACK * \
+                          TIMERFD_SLACK : (t))
+#else
+#  define timerfd_slack(t) (t)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -63,9 +83,19 @@ struct timerfd_priv_s
   mutex_t                   lock;    /* Enforces device exclusive access */
   FAR timerfd_waiter_sem_t *rdsems;  /* List of blocking readers */
   int                       clock;   /* Clock to use as the timing base */
+#ifdef CONFIG_TIMER_FD_HRTIMER
+  uint64_t                  period;  /* If non-zero, the period of
+                                      * repetitive timers (ns) */
+  uint64_t                  next;    /* The next expiration, before the
+                                      * slack (ns) */
+  struct hrtimer_s          hrtimer; /* The hrtimer that provides the timing */
+#else
   int                       delay;   /* If non-zero, used to reset repetitive
                                       * timers */
+  clock_t                   next;    /* The next expiration, before the
+                                      * slack (ticks) */
   struct wdog_s             wdog;    /* The watchdog that provides the timing */
+#endif
   timerfd_t                 counter; /* timerfd counter */
   uint8_t                   crefs;   /* References counts on timerfd (max: 255) */
 
@@ -99,7 +129,14 @@ static int timerfd_blocking_io(FAR struct timerfd_priv_s *dev,
 static FAR struct timerfd_priv_s *timerfd_allocdev(void);
 static void timerfd_destroy(FAR struct timerfd_priv_s *dev);
 
+static void timerfd_expire(FAR struct timerfd_priv_s *dev,
+                           timerfd_t count);
+#ifdef CONFIG_TIMER_FD_HRTIMER
+static uint64_t timerfd_hrtimeout(FAR struct hrtimer_s *hrtimer,
+                                  uint64_t expired);
+#else
 static void timerfd_timeout(wdparm_t arg);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -156,7 +193,11 @@ static FAR struct timerfd_priv_s *timerfd_allocdev(void)
 
 static void timerfd_destroy(FAR struct timerfd_priv_s *dev)
 {
+#ifdef CONFIG_TIMER_FD_HRTIMER
+  hrtimer_cancel(&dev->hrtimer);
+#else
   wd_cancel(&dev->wdog);
+#endif
   nxmutex_unlock(&dev->lock);
   nxmutex_destroy(&dev->lock);
   fs_heap_free(dev);
@@ -382,27 +423,19 @@ out:
 }
 #endif
 
-static void timerfd_timeout(wdparm_t arg)
+static void timerfd_expire(FAR struct timerfd_priv_s *dev,
+                           timerfd_t count)
 {
-  FAR struct timerfd_priv_s *dev = (FAR struct timerfd_priv_s *)arg;
   FAR timerfd_waiter_sem_t *cur_sem;
-  irqstate_t intflags;
 
-  /* Disable interrupts to ensure that expiration counter is accessed
-   * atomically
+  /* Increment timer expiration counter.  The waiters were already woken
+   * up if it was not zero.
    */
 
-  intflags = enter_critical_section();
-
-  /* Increment timer expiration counter */
-
-  dev->counter++;
-
-  /* If this is a repetitive timer, then restart the watchdog */
-
-  if (dev->delay > 0)
+  dev->counter += count;
+  if (dev->counter != count)
     {
-      wd_start(&dev->wdog, dev->delay, timerfd_timeout, arg);
+      return;
     }
 
 #ifdef CONFIG_TIMER_FD_POLL
@@ -421,9 +454,88 @@ static void timerfd_timeout(wdparm_t arg)
     }
 
   dev->rdsems = NULL;
+}
 
+#ifdef CONFIG_TIMER_FD_HRTIMER
+static uint64_t timerfd_hrtimeout(FAR struct hrtimer_s *hrtimer,
+                                  uint64_t expired)
+{
+  FAR struct timerfd_priv_s *dev = hrtimer->arg;
+  irqstate_t intflags;
+  timerfd_t count = 1;
+  uint64_t period;
+  uint64_t now;
+  uint64_t n;
+
+  /* Disable interrupts to ensure that expiration counter is accessed
+   * atomically
+   */
+
+  intflags = enter_critical_section();
+
+  /* Count the periods missed by a late expiration at once */
+
+  period = dev->period;
+  if (period != 0)
+    {
+      now = hrtimer_now();
+      dev->next += period;
+      if (dev->next <= now)
+        {
+          n          = (now - dev->next) / period + 1;
+          count     += n;
+          dev->next += n * period;
+        }
+    }
+
+  timerfd_expire(dev, count);
   leave_critical_section(intflags);
+
+  /* A repetitive timer is restarted by returning the delay to its next
+   * expiration.
+   */
+
+  return period != 0 ? timerfd_slack(dev->next) - expired : 0;
 }
+#else
+static void timerfd_timeout(wdparm_t arg)
+{
+  FAR struct timerfd_priv_s *dev = (FAR struct timerfd_priv_s *)arg;
+  irqstate_t intflags;
+  timerfd_t count = 1;
+  clock_t now;
+  clock_t n;
+
+  /* Disable interrupts to ensure that expiration counter is accessed
+   * atomically
+   */
+
+  intflags = enter_critical_section();
+
+  /* If this is a repetitive timer, then restart the watchdog from its
+   * previous expiration, not to drift, and count the periods missed by a
+   * late expiration at once.
+   */
+
+  if (dev->delay > 0)
+    {
+      now = clock_systime_ticks();
+      dev->next += dev->delay;
+      if ((sclock_t)(now - dev->next) >= 0)
+        {
+          n          = (now - dev->next) / dev->delay + 1;
+          count     += n;
+          dev->next += n * dev->delay;
+        }
+
+      wd_start_abstick(&dev->wdog, timerfd_slack(dev->next),
+                       timerfd_timeout, arg);
+    }
+
+  timerfd_expire(dev, count);
+  leave_critical_section(intflags);
+}
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -488,7 +600,11 @@ int timerfd_settime(int fd, int flags,
   FAR struct timerfd_priv_s *dev;
   FAR struct file *filep;
   irqstate_t intflags;
+#ifdef CONFIG_TIMER_FD_HRTIMER
+  struct timespec reltime;
+#else
   sclock_t delay;
+#endif
   int ret;
 
   /* Some sanity checks */
@@ -528,6 +644,11 @@ int timerfd_settime(int fd, int flags,
 
   if (old_value)
     {
+#ifdef CONFIG_TIMER_FD_HRTIMER
+      clock_nsec2time(&old_value->it_value,
+                      hrtimer_gettime(&dev->hrtimer));
+      clock_nsec2time(&old_value->it_interval, dev->period);
+#else
       /* Get the number of ticks before the underlying watchdog expires */
 
       delay = wd_gettime(&dev->wdog);
@@ -536,13 +657,18 @@ int timerfd_settime(int fd, int flags,
 
       clock_ticks2time(&old_value->it_value, delay);
       clock_ticks2time(&old_value->it_interval, dev->delay);
+#endif
     }
 
   /* Disarm the timer (in case the timer was already armed when
    * timerfd_settime() is called).
    */
 
+#ifdef CONFIG_TIMER_FD_HRTIMER
+  hrtimer_cancel(&dev->hrtimer);
+#else
   wd_cancel(&dev->wdog);
+#endif
 
   /* Clear expiration counter */
 
@@ -559,6 +685,29 @@ int timerfd_settime(int fd, int flags,
       return OK;
     }
 
+#ifdef CONFIG_TIMER_FD_HRTIMER
+  /* Setup up any repetitive timer */
+
+  dev->period = clock_time2nsec(&new_value->it_interval);
+
+  /* An absolute time in the past expires immediately */
+
+  if ((flags & TFD_TIMER_ABSTIME) != 0)
+    {
+      nxclock_gettime(dev->clock, &reltime);
+      clock_timespec_subtract(&new_value->it_value, &reltime, &reltime);
+    }
+  else
+    {
+      reltime = new_value->it_value;
+    }
+
+  /* Then start the hrtimer */
+
+  dev->next = hrtimer_now() + clock_time2nsec(&reltime);
+  ret = hrtimer_start(&dev->hrtimer, timerfd_hrtimeout, dev,
+                      timerfd_slack(dev->next), HRTIMER_MODE_ABS);
+#else
   /* Setup up any repetitive timer */
 
   delay = clock_time2ticks(&new_value->it_interval);
@@ -597,7 +746,10 @@ int timerfd_settime(int fd, int flags,
 
   /* Then start the watchdog */
 
-  ret = wd_start(&dev->wdog, delay, timerfd_timeout, (wdparm_t)dev);
+  dev->next = clock_systime_ticks() + delay;
+  ret = wd_start_abstick(&dev->wdog, timerfd_slack(dev->next),
+                         timerfd_timeout, (wdparm_t)dev);
+#endif
   if (ret < 0)
     {
       leave_critical_section(intflags);
@@ -619,7 +771,9 @@ int timerfd_gettime(int fd, FAR struct itimerspec *curr_value)
 {
   FAR struct timerfd_priv_s *dev;
   FAR struct file *filep;
+#ifndef CONFIG_TIMER_FD_HRTIMER
   sclock_t ticks;
+#endif
   int ret;
 
   /* Some sanity checks */
@@ -646,6 +800,10 @@ int timerfd_gettime(int fd, FAR struct itimerspec *curr_value)
 
   dev = (FAR struct timerfd_priv_s *)filep->f_priv;
 
+#ifdef CONFIG_TIMER_FD_HRTIMER
+  clock_nsec2time(&curr_value->it_value, hrtimer_gettime(&dev->hrtimer));
+  clock_nsec2time(&curr_value->it_interval, dev->period);
+#else
   /* Get the number of ticks before the underlying watchdog expires */
 
   ticks = wd_gettime(&dev->wdog);
@@ -654,6 +812,7 @@ int timerfd_gettime(int fd, FAR struct itimerspec *curr_value)
 
   clock_ticks2time(&curr_value->it_value, ticks);
   clock_ticks2time(&curr_value->it_interval, dev->delay);
+#endif
   fs_putfilep(filep);
   return OK;
 
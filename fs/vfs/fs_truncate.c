@@ -34,6 +34,7 @@
 
 #include "notify/notify.h"
 #include "inode/inode.h"
+#include "vfs/pagecache.h"
 
 /****************************************************************************
  * Public Functions
@@ -52,6 +53,7 @@
 int file_truncate(FAR struct file *filep, off_t length)
 {
   struct inode *inode;
+  int ret;
 
   /* Was this file opened for write access? */
 
@@ -98,9 +100,17 @@ int file_truncate(FAR struct file *filep, off_t length)
       return -ENOSYS;
     }
 
-  /* Yes, then tell the file system to truncate this file */
+  /* Yes, then tell the file system to truncate this file, and drop the
+   * data beyond the new end of file from the page cache.
+   */
+
+  ret = inode->u.i_ops->truncate(filep, length);
+  if (ret >= 0)
+    {
+      pagecache_truncate(filep, length);
+    }
 
-  return inode->u.i_ops->truncate(filep, length);
+  return ret;
 }
 
 /****************************************************************************
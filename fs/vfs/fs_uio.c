@@ -0,0 +1,493 @@
+/****************************************************************************
+ * fs/vfs/fs_uio.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <limits.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/fs/fs.h>
+
+#include "notify/notify.h"
+#include "inode/inode.h"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+typedef CODE ssize_t (*uio_method_t)(FAR struct file *filep,
+                                     FAR const struct iovec *iov,
+                                     int iovcnt);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: uio_check
+ *
+ * Description:
+ *   Check the element count and that the total length fits in a ssize_t.
+ *
+ ****************************************************************************/
+
+static int uio_check(FAR const struct iovec *iov, int iovcnt)
+{
+  size_t total = 0;
+  int i;
+
+  if (iovcnt < 0 || iovcnt > IOV_MAX || (iovcnt > 0 && iov == NULL))
+    {
+      return -EINVAL;
+    }
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len > SSIZE_MAX - total)
+        {
+          return -EINVAL;
+        }
+
+      total += iov[i].iov_len;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: uio_method
+ *
+ * Description:
+ *   Return the readv or writev method of the driver or file system of a
+ *   file, NULL if it has none.  The files of the file systems with a fileid
+ *   method may be in the page cache, their data then goes through
+ *   file_read() and file_write().
+ *
+ ****************************************************************************/
+
+static uio_method_t uio_method(FAR struct file *filep, bool write)
+{
+  FAR struct inode *inode = filep->f_inode;
+
+  if (inode == NULL || inode->u.i_ops == NULL)
+    {
+      return NULL;
+    }
+
+#ifndef CONFIG_DISABLE_MOUNTPOINT
+  if (INODE_IS_MOUNTPT(inode))
+    {
+#ifdef CONFIG_FS_PAGECACHE
+      if (inode->u.i_mops->fileid != NULL)
+        {
+          return NULL;
+        }
+#endif
+
+      return write ? inode->u.i_mops->writev : inode->u.i_mops->readv;
+    }
+#endif
+
+  return write ? inode->u.i_ops->writev : inode->u.i_ops->readv;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_readv
+ *
+ * Description:
+ *   Read into the 'iovcnt' buffers of 'iov' from the current position of a
+ *   file, with the readv method of its driver if it has one.  Otherwise
+ *   each buffer is filled with file_read() before the next one, until the
+ *   end of the file.
+ *
+ ****************************************************************************/
+
+ssize_t file_readv(FAR struct file *filep, FAR const struct iovec *iov,
+                   int iovcnt)
+{
+  uio_method_t readv;
+  FAR uint8_t *buffer;
+  size_t remaining;
+  ssize_t ntotal = 0;
+  ssize_t nread;
+  int i;
+
+  DEBUGASSERT(filep != NULL);
+
+  if ((filep->f_oflags & O_RDOK) == 0)
+    {
+      return -EACCES;
+    }
+
+  nread = uio_check(iov, iovcnt);
+  if (nread < 0)
+    {
+      return nread;
+    }
+
+  readv = uio_method(filep, false);
+  if (readv != NULL)
+    {
+      ntotal = readv(filep, iov, iovcnt);
+
+#ifdef CONFIG_FS_NOTIFY
+      if (ntotal > 0)
+        {
+          notify_read(filep);
+        }
+#endif
+
+      return ntotal;
+    }
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      buffer    = iov[i].iov_base;
+      remaining = iov[i].iov_len;
+
+      /* Read repeatedly as necessary to fill the buffer */
+
+      while (remaining > 0)
+        {
+          nread = file_read(filep, buffer, remaining);
+          if (nread < 0)
+            {
+              return ntotal > 0 ? ntotal : nread;
+            }
+          else if (nread == 0)
+            {
+              return ntotal;
+            }
+
+          buffer    += nread;
+          remaining -= nread;
+          ntotal    += nread;
+        }
+    }
+
+  return ntotal;
+}
+
+/****************************************************************************
+ * Name: file_writev
+ *
+ * Description:
+ *   Write the 'iovcnt' buffers of 'iov' at the current position of a file,
+ *   with the writev method of its driver if it has one.  Otherwise each
+ *   buffer is written completely with file_write() before the next one.
+ *
+ ****************************************************************************/
+
+ssize_t file_writev(FAR struct file *filep, FAR const struct iovec *iov,
+                    int iovcnt)
+{
+  uio_method_t writev;
+  FAR const uint8_t *buffer;
+  size_t remaining;
+  ssize_t ntotal = 0;
+  ssize_t nwritten;
+  int i;
+
+  DEBUGASSERT(filep != NULL);
+
+  if ((filep->f_oflags & O_WROK) == 0)
+    {
+      return -EACCES;
+    }
+
+  nwritten = uio_check(iov, iovcnt);
+  if (nwritten < 0)
+    {
+      return nwritten;
+    }
+
+  writev = uio_method(filep, true);
+  if (writev != NULL)
+    {
+      ntotal = writev(filep, iov, iovcnt);
+
+#ifdef CONFIG_FS_NOTIFY
+      if (ntotal > 0)
+        {
+          notify_write(filep);
+        }
+#endif
+
+      return ntotal;
+    }
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      buffer    = iov[i].iov_base;
+      remaining = iov[i].iov_len;
+
+      while (remaining > 0)
+        {
+          nwritten = file_write(filep, buffer, remaining);
+          if (nwritten < 0)
+            {
+              return ntotal > 0 ? ntotal : nwritten;
+            }
+
+          buffer    += nwritten;
+          remaining -= nwritten;
+          ntotal    += nwritten;
+        }
+    }
+
+  return ntotal;
+}
+
+/****************************************************************************
+ * Name: file_preadv
+ *
+ * Description:
+ *   Equivalent to file_readv() at 'offset', leaving the file position
+ *   unchanged.
+ *
+ ****************************************************************************/
+
+ssize_t file_preadv(FAR struct file *filep, FAR const struct iovec *iov,
+                    int iovcnt, off_t offset)
+{
+  off_t savepos;
+  off_t pos;
+  ssize_t ret;
+
+  savepos = file_seek(filep, 0, SEEK_CUR);
+  if (savepos < 0)
+    {
+      return (ssize_t)savepos;
+    }
+
+  pos = file_seek(filep, offset, SEEK_SET);
+  if (pos < 0)
+    {
+      return (ssize_t)pos;
+    }
+
+  ret = file_readv(filep, iov, iovcnt);
+
+  pos = file_seek(filep, savepos, SEEK_SET);
+  if (pos < 0 && ret >= 0)
+    {
+      ret = (ssize_t)pos;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: file_pwritev
+ *
+ * Description:
+ *   Equivalent to file_writev() at 'offset', leaving the file position
+ *   unchanged.
+ *
+ ****************************************************************************/
+
+ssize_t file_pwritev(FAR struct file *filep, FAR const struct iovec *iov,
+                     int iovcnt, off_t offset)
+{
+  off_t savepos;
+  off_t pos;
+  ssize_t ret;
+
+  savepos = file_seek(filep, 0, SEEK_CUR);
+  if (savepos < 0)
+    {
+      return (ssize_t)savepos;
+    }
+
+  pos = file_seek(filep, offset, SEEK_SET);
+  if (pos < 0)
+    {
+      return (ssize_t)pos;
+    }
+
+  ret = file_writev(filep, iov, iovcnt);
+
+  pos = file_seek(filep, savepos, SEEK_SET);
+  if (pos < 0 && ret >= 0)
+    {
+      ret = (ssize_t)pos;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: readv
+ *
+ * Description:
+ *   The standard, POSIX readv interface:  The data is read into the
+ *   'iovcnt' buffers of 'iov' in order, each buffer is filled completely
+ *   before proceeding to the next.  See sys/uio.h.
+ *
+ ****************************************************************************/
+
+ssize_t readv(int fd, FAR const struct iovec *iov, int iovcnt)
+{
+  FAR struct file *filep;
+  ssize_t ret;
+
+  /* readv() is a cancellation point */
+
+  enter_cancellation_point();
+
+  ret = (ssize_t)fs_getfilep(fd, &filep);
+  if (ret >= 0)
+    {
+      ret = file_readv(filep, iov, iovcnt);
+      fs_putfilep(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: writev
+ *
+ * Description:
+ *   The standard, POSIX writev interface:  The data of the 'iovcnt'
+ *   buffers of 'iov' is written in order.  See sys/uio.h.
+ *
+ ****************************************************************************/
+
+ssize_t writev(int fd, FAR const struct iovec *iov, int iovcnt)
+{
+  FAR struct file *filep;
+  ssize_t ret;
+
+  /* writev() is a cancellation point */
+
+  enter_cancellation_point();
+
+  ret = (ssize_t)fs_getfilep(fd, &filep);
+  if (ret >= 0)
+    {
+      ret = file_writev(filep, iov, iovcnt);
+      fs_putfilep(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: preadv
+ *
+ * Description:
+ *   The preadv() function is equivalent to pread(), except it takes an iov
+ *   array.
+ *
+ ****************************************************************************/
+
+ssize_t preadv(int fd, FAR const struct iovec *iov, int iovcnt,
+               off_t offset)
+{
+  FAR struct file *filep;
+  ssize_t ret;
+
+  /* preadv() is a cancellation point */
+
+  enter_cancellation_point();
+
+  ret = (ssize_t)fs_getfilep(fd, &filep);
+  if (ret >= 0)
+    {
+      ret = file_preadv(filep, iov, iovcnt, offset);
+      fs_putfilep(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pwritev
+ *
+ * Description:
+ *   The pwritev() function is equivalent to pwrite(), except it takes an
+ *   iov array.
+ *
+ ****************************************************************************/
+
+ssize_t pwritev(int fd, FAR const struct iovec *iov, int iovcnt,
+                off_t offset)
+{
+  FAR struct file *filep;
+  ssize_t ret;
+
+  /* pwritev() is a cancellation point */
+
+  enter_cancellation_point();
+
+  ret = (ssize_t)fs_getfilep(fd, &filep);
+  if (ret >= 0)
+    {
+      ret = file_pwritev(filep, iov, iovcnt, offset);
+      fs_putfilep(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
@@ -33,6 +33,7 @@
 
 #include "notify/notify.h"
 #include "inode/inode.h"
+#include "vfs/pagecache.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -97,6 +98,10 @@ int nx_unlink(FAR const char *pathname)
             {
               goto errout_with_inode;
             }
+
+          /* A new file may reuse the identifier of the removed one */
+
+          pagecache_invalidate(inode);
         }
       else
         {
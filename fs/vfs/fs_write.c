@@ -35,6 +35,7 @@
 
 #include "notify/notify.h"
 #include "inode/inode.h"
+#include "vfs/pagecache.h"
 
 /****************************************************************************
  * Public Functions
@@ -86,9 +87,16 @@ ssize_t file_write(FAR struct file *filep, FAR const void *buf,
       return -EBADF;
     }
 
-  /* Yes, then let the driver perform the write */
+  /* Yes, then let the driver perform the write, or the page cache for the
+   * cached files.
+   */
+
+  ret = pagecache_write(filep, buf, nbytes);
+  if (ret == -ENOSYS)
+    {
+      ret = inode->u.i_ops->write(filep, buf, nbytes);
+    }
 
-  ret = inode->u.i_ops->write(filep, buf, nbytes);
 #ifdef CONFIG_FS_NOTIFY
   if (ret > 0)
     {
@@ -0,0 +1,204 @@
+/****************************************************************************
+ * fs/vfs/pagecache.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __FS_VFS_PAGECACHE_H
+#define __FS_VFS_PAGECACHE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/mm/map.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The page cache holds the data of the regular files of the file systems
+ * that implement the fileid method of struct mountpt_operations.  The
+ * functions that take a struct file return -ENOSYS if the file is not
+ * cached, the caller then uses the file system directly.
+ */
+
+#ifndef CONFIG_FS_PAGECACHE
+#  define pagecache_read(filep, buf, nbytes)  (-ENOSYS)
+#  define pagecache_write(filep, buf, nbytes) (-ENOSYS)
+#  define pagecache_seek(filep, off, whence)  (-ENOSYS)
+#  define pagecache_sync(filep)               (-ENOSYS)
+#  define pagecache_mmap(filep, entry, type)  (-ENOSYS)
+#  define pagecache_close(filep)
+#  define pagecache_truncate(filep, length)
+#  define pagecache_fstat(filep, buf)
+#  define pagecache_invalidate(mountpt)
+#else
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pagecache_read
+ *
+ * Description:
+ *   Read from the current position of a file through the page cache.
+ *
+ * Returned Value:
+ *   The number of bytes read, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t pagecache_read(FAR struct file *filep, FAR void *buf,
+                       size_t nbytes);
+
+/****************************************************************************
+ * Name: pagecache_write
+ *
+ * Description:
+ *   Write at the current position of a file to the page cache.  The dirty
+ *   pages are written to the file system later by the low priority work
+ *   queue, or when the file is synchronized or closed.
+ *
+ * Returned Value:
+ *   The number of bytes written, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t pagecache_write(FAR struct file *filep, FAR const void *buf,
+                        size_t nbytes);
+
+/****************************************************************************
+ * Name: pagecache_getdata
+ *
+ * Description:
+ *   Lend the cached data of a file at 'offset', reading it first if it is
+ *   not cached:  The data is at 'skip' bytes from '*base' and stays valid
+ *   until '*base' is given back with pagecache_putdata(), even if the page
+ *   is evicted or the file truncated meanwhile.  The data of a file that
+ *   is mapped with MAP_SHARED is not lent.
+ *
+ * Returned Value:
+ *   The number of bytes lent, up to the end of the page, zero at the end of
+ *   the file, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t pagecache_getdata(FAR struct file *filep, off_t offset,
+                          size_t nbytes, FAR void **base, FAR size_t *skip);
+
+/****************************************************************************
+ * Name: pagecache_putdata
+ *
+ * Description:
+ *   Give back the data lent by pagecache_getdata().  May be called from an
+ *   interrupt handler.
+ *
+ ****************************************************************************/
+
+void pagecache_putdata(FAR void *base);
+
+/****************************************************************************
+ * Name: pagecache_seek
+ *
+ * Description:
+ *   Set the position of a cached file:  The file system does not know the
+ *   size of the data still in the cache, nor the position after the reads
+ *   served by the cache.
+ *
+ ****************************************************************************/
+
+off_t pagecache_seek(FAR struct file *filep, off_t offset, int whence);
+
+/****************************************************************************
+ * Name: pagecache_close
+ *
+ * Description:
+ *   Write the dirty pages of a file before 'filep' is closed.
+ *
+ ****************************************************************************/
+
+void pagecache_close(FAR struct file *filep);
+
+/****************************************************************************
+ * Name: pagecache_sync
+ *
+ * Description:
+ *   Write the dirty pages of a file to the file system.
+ *
+ ****************************************************************************/
+
+int pagecache_sync(FAR struct file *filep);
+
+/****************************************************************************
+ * Name: pagecache_truncate
+ *
+ * Description:
+ *   Drop the cached data beyond 'length' once a file has been truncated.
+ *
+ ****************************************************************************/
+
+void pagecache_truncate(FAR struct file *filep, off_t length);
+
+/****************************************************************************
+ * Name: pagecache_fstat
+ *
+ * Description:
+ *   Correct the size returned by fstat() for the data still in the cache.
+ *
+ ****************************************************************************/
+
+void pagecache_fstat(FAR struct file *filep, FAR struct stat *buf);
+
+/****************************************************************************
+ * Name: pagecache_mmap
+ *
+ * Description:
+ *   Map a file with MAP_SHARED:  The memory of the mapping holds the cached
+ *   pages of the mapped range, so the data is neither copied twice nor
+ *   incoherent with read() and write(), and all the mappings of a range
+ *   share the memory.
+ *
+ ****************************************************************************/
+
+int pagecache_mmap(FAR struct file *filep, FAR struct mm_map_entry_s *entry,
+                   int type);
+
+/****************************************************************************
+ * Name: pagecache_invalidate
+ *
+ * Description:
+ *   Drop the clean pages of the files that are not mapped in a mounted
+ *   volume, after a file of the volume was removed or renamed or the
+ *   volume is unmounted:  A new file may take the identifier of an old
+ *   one.
+ *
+ ****************************************************************************/
+
+void pagecache_invalidate(FAR struct inode *mountpt);
+
+#endif /* CONFIG_FS_PAGECACHE */
+#endif /* __FS_VFS_PAGECACHE_H */
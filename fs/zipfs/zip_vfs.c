@@ -26,6 +26,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <string.h>
+#include <sys/param.h>
 #include <sys/stat.h>
 #include <sys/statfs.h>
 #include <nuttx/mutex.h>
@@ -37,6 +38,12 @@
 
 #include "fs_heap.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define ZIPFS_WINSIZE 32768 /* The history window of deflate */
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -54,11 +61,39 @@ struct zipfs_mountpt_s
   char abspath[1];
 };
 
+#if CONFIG_ZIPFS_INDEX_SPAN > 0
+/* A point where the inflation of a deflated entry may restart:  The start
+ * of a deflate block and the data before it.
+ */
+
+struct zipfs_point_s
+{
+  off_t out;                      /* Offset in the uncompressed data */
+  off_t in;                       /* Offset in the compressed data */
+  int bits;                       /* Bits of the byte before 'in' to use */
+  uint8_t window[ZIPFS_WINSIZE];  /* The uncompressed data before 'out' */
+};
+#endif
+
 struct zipfs_file_s
 {
   unzFile uf;
   mutex_t lock;
   FAR char *seekbuf;
+#if CONFIG_ZIPFS_INDEX_SPAN > 0
+  int method;                     /* Z_DEFLATED, 0 (stored) or -1 if the
+                                   * data is read through minizip */
+  struct file zfile;              /* The zip file, to read the data */
+  off_t zstart;                   /* Offset of the data in the zip file */
+  off_t zsize;                    /* Size of the compressed data */
+  off_t usize;                    /* Size of the uncompressed data */
+  z_stream strm;                  /* The state of the inflation */
+  off_t zpos;                     /* Compressed data read so far */
+  off_t out;                      /* Uncompressed data inflated so far */
+  FAR uint8_t *window;            /* The last data inflated, circular */
+  int npoints;                    /* Number of restart points */
+  FAR struct zipfs_point_s **points;
+#endif
   char relpath[1];
 };
 
@@ -239,6 +274,334 @@ static int zipfs_convert_result(int ziperr)
     }
 }
 
+#if CONFIG_ZIPFS_INDEX_SPAN > 0
+static void zipfs_window_get(FAR const uint8_t *window, off_t pos,
+                             FAR uint8_t *buf, size_t len)
+{
+  size_t head = pos % ZIPFS_WINSIZE;
+  size_t part = MIN(len, ZIPFS_WINSIZE - head);
+
+  memcpy(buf, window + head, part);
+  memcpy(buf + part, window, len - part);
+}
+
+static void zipfs_window_put(FAR uint8_t *window, off_t pos,
+                             FAR const uint8_t *buf, size_t len)
+{
+  size_t head = pos % ZIPFS_WINSIZE;
+  size_t part = MIN(len, ZIPFS_WINSIZE - head);
+
+  memcpy(window + head, buf, part);
+  memcpy(window, buf + part, len - part);
+}
+
+/* Read the stored and the deflated entries that are not encrypted directly
+ * from the zip file:  A stored entry is then read at any offset, and the
+ * inflation of a deflated entry restarts at the last recorded point before
+ * the offset instead of the start of the entry.  The points are recorded
+ * every CONFIG_ZIPFS_INDEX_SPAN bytes of uncompressed data the first time
+ * the data is inflated.
+ */
+
+static int zipfs_index_open(FAR struct zipfs_mountpt_s *fs,
+                            FAR struct zipfs_file_s *fp)
+{
+  unz_file_info64 file_info;
+  int ret;
+
+  fp->method = -1;
+  fp->window = NULL;
+  fp->points = NULL;
+  fp->npoints = 0;
+
+  ret = unzGetCurrentFileInfo64(fp->uf, &file_info,
+                                NULL, 0, NULL, 0, NULL, 0);
+  ret = zipfs_convert_result(ret);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if ((file_info.flag & 1) != 0 || (file_info.compression_method != 0 &&
+      file_info.compression_method != Z_DEFLATED))
+    {
+      return OK;
+    }
+
+  ret = file_open(&fp->zfile, fs->abspath, O_RDONLY);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (file_info.compression_method == Z_DEFLATED)
+    {
+      fp->window = fs_heap_malloc(ZIPFS_WINSIZE);
+      if (fp->window == NULL)
+        {
+          file_close(&fp->zfile);
+          return -ENOMEM;
+        }
+
+      memset(&fp->strm, 0, sizeof(fp->strm));
+      if (inflateInit2(&fp->strm, -MAX_WBITS) != Z_OK)
+        {
+          fs_heap_free(fp->window);
+          file_close(&fp->zfile);
+          return -ENOMEM;
+        }
+    }
+
+  fp->zstart = unzGetCurrentFileZStreamPos64(fp->uf);
+  fp->zsize = file_info.compressed_size;
+  fp->usize = file_info.uncompressed_size;
+  fp->zpos = 0;
+  fp->out = 0;
+  fp->method = file_info.compression_method;
+  return OK;
+}
+
+static void zipfs_index_close(FAR struct zipfs_file_s *fp)
+{
+  int i;
+
+  if (fp->method == Z_DEFLATED)
+    {
+      inflateEnd(&fp->strm);
+      for (i = 0; i < fp->npoints; i++)
+        {
+          fs_heap_free(fp->points[i]);
+        }
+
+      fs_heap_free(fp->points);
+      fs_heap_free(fp->window);
+    }
+
+  if (fp->method >= 0)
+    {
+      file_close(&fp->zfile);
+    }
+}
+
+static void zipfs_index_point(FAR struct zipfs_file_s *fp, off_t out)
+{
+  FAR struct zipfs_point_s **points;
+  FAR struct zipfs_point_s *point;
+  off_t last = 0;
+  size_t len;
+
+  if (fp->npoints > 0)
+    {
+      last = fp->points[fp->npoints - 1]->out;
+    }
+
+  if (out - last < CONFIG_ZIPFS_INDEX_SPAN || out >= fp->usize)
+    {
+      return;
+    }
+
+  /* The index is only a shortcut, the data is read without it if there is
+   * no memory for it.
+   */
+
+  points = fs_heap_realloc(fp->points,
+                           (fp->npoints + 1) * sizeof(*points));
+  if (points == NULL)
+    {
+      return;
+    }
+
+  fp->points = points;
+  point = fs_heap_malloc(sizeof(*point));
+  if (point == NULL)
+    {
+      return;
+    }
+
+  len = MIN(out, ZIPFS_WINSIZE);
+  point->out = out;
+  point->in = fp->zpos - fp->strm.avail_in;
+  point->bits = fp->strm.data_type & 7;
+  zipfs_window_get(fp->window, out - len, point->window, len);
+  fp->points[fp->npoints++] = point;
+}
+
+static int zipfs_index_reset(FAR struct zipfs_file_s *fp,
+                             FAR struct zipfs_point_s *point)
+{
+  uint8_t byte;
+  ssize_t ret;
+  size_t len;
+
+  inflateReset(&fp->strm);
+  fp->strm.avail_in = 0;
+  fp->zpos = 0;
+  fp->out = 0;
+
+  if (point == NULL)
+    {
+      return OK;
+    }
+
+  /* A deflate block may start in the middle of a byte */
+
+  if (point->bits != 0)
+    {
+      ret = file_pread(&fp->zfile, &byte, 1, fp->zstart + point->in - 1);
+      if (ret != 1)
+        {
+          return ret < 0 ? ret : -EIO;
+        }
+
+      inflatePrime(&fp->strm, point->bits, byte >> (8 - point->bits));
+    }
+
+  len = MIN(point->out, ZIPFS_WINSIZE);
+  inflateSetDictionary(&fp->strm, point->window, len);
+  zipfs_window_put(fp->window, point->out - len, point->window, len);
+  fp->zpos = point->in;
+  fp->out = point->out;
+  return OK;
+}
+
+static ssize_t zipfs_index_inflate(FAR struct zipfs_file_s *fp)
+{
+  FAR z_stream *strm = &fp->strm;
+  size_t head = fp->out % ZIPFS_WINSIZE;
+  ssize_t nread;
+  size_t len;
+  int ret;
+
+  if (fp->out >= fp->usize)
+    {
+      return 0;
+    }
+
+  strm->next_out = fp->window + head;
+  strm->avail_out = ZIPFS_WINSIZE - head;
+
+  do
+    {
+      if (strm->avail_in == 0)
+        {
+          nread = MIN(fp->zsize - fp->zpos, CONFIG_ZIPFS_SEEK_BUFSIZE);
+          if (nread > 0)
+            {
+              nread = file_pread(&fp->zfile, fp->seekbuf, nread,
+                                 fp->zstart + fp->zpos);
+            }
+
+          if (nread <= 0)
+            {
+              return nread < 0 ? nread : -EIO;
+            }
+
+          fp->zpos += nread;
+          strm->next_in = (FAR Bytef *)fp->seekbuf;
+          strm->avail_in = nread;
+        }
+
+      ret = inflate(strm, Z_BLOCK);
+      if (ret == Z_MEM_ERROR)
+        {
+          return -ENOMEM;
+        }
+      else if (ret == Z_NEED_DICT || ret == Z_DATA_ERROR)
+        {
+          return -EIO;
+        }
+
+      /* The end of a block which is not the last one */
+
+      if ((strm->data_type & 128) != 0 && (strm->data_type & 64) == 0)
+        {
+          len = ZIPFS_WINSIZE - head - strm->avail_out;
+          zipfs_index_point(fp, fp->out + len);
+        }
+    }
+  while (strm->avail_out > 0 && ret != Z_STREAM_END);
+
+  len = ZIPFS_WINSIZE - head - strm->avail_out;
+  fp->out += len;
+  return len;
+}
+
+static ssize_t zipfs_index_read(FAR struct zipfs_file_s *fp, off_t pos,
+                                FAR char *buffer, size_t buflen)
+{
+  FAR struct zipfs_point_s *point = NULL;
+  ssize_t nread = 0;
+  ssize_t ret;
+  size_t len;
+  int i;
+
+  if (pos >= fp->usize)
+    {
+      return 0;
+    }
+
+  buflen = MIN(buflen, fp->usize - pos);
+  if (fp->method == 0)
+    {
+      return file_pread(&fp->zfile, buffer, buflen, fp->zstart + pos);
+    }
+
+  if (fp->seekbuf == NULL)
+    {
+      fp->seekbuf = fs_heap_malloc(CONFIG_ZIPFS_SEEK_BUFSIZE);
+      if (fp->seekbuf == NULL)
+        {
+          return -ENOMEM;
+        }
+    }
+
+  /* Restart at the last point before 'pos' if the data is no longer in
+   * the window, or if the point is ahead of the inflation.
+   */
+
+  for (i = fp->npoints; i > 0; i--)
+    {
+      if (fp->points[i - 1]->out <= pos)
+        {
+          point = fp->points[i - 1];
+          break;
+        }
+    }
+
+  if (pos < fp->out - MIN(fp->out, ZIPFS_WINSIZE) ||
+      (point != NULL && point->out > fp->out))
+    {
+      ret = zipfs_index_reset(fp, point);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  while (buflen > 0)
+    {
+      if (pos < fp->out)
+        {
+          len = MIN(fp->out - pos, buflen);
+          zipfs_window_get(fp->window, pos, (FAR uint8_t *)buffer, len);
+          pos    += len;
+          buffer += len;
+          buflen -= len;
+          nread  += len;
+          continue;
+        }
+
+      ret = zipfs_index_inflate(fp);
+      if (ret <= 0)
+        {
+          return nread ? nread : ret;
+        }
+    }
+
+  return nread;
+}
+#endif
+
 static int zipfs_open(FAR struct file *filep, FAR const char *relpath,
                       int oflags, mode_t mode)
 {
@@ -279,6 +642,14 @@ static int zipfs_open(FAR struct file *filep, FAR const char *relpath,
       goto err_with_zip;
     }
 
+#if CONFIG_ZIPFS_INDEX_SPAN > 0
+  ret = zipfs_index_open(fs, fp);
+  if (ret < 0)
+    {
+      goto err_with_zip;
+    }
+#endif
+
   if (ret == OK)
     {
       fp->seekbuf = NULL;
@@ -303,6 +674,10 @@ static int zipfs_close(FAR struct file *filep)
   FAR struct zipfs_file_s *fp = filep->f_priv;
   int ret;
 
+#if CONFIG_ZIPFS_INDEX_SPAN > 0
+  zipfs_index_close(fp);
+#endif
+
   ret = zipfs_convert_result(unzClose(fp->uf));
   nxmutex_destroy(&fp->lock);
   fs_heap_free(fp->seekbuf);
@@ -317,7 +692,18 @@ static ssize_t zipfs_read(FAR struct file *filep, FAR char *buffer,
   ssize_t ret;
 
   nxmutex_lock(&fp->lock);
-  ret = zipfs_convert_result(unzReadCurrentFile(fp->uf, buffer, buflen));
+#if CONFIG_ZIPFS_INDEX_SPAN > 0
+  if (fp->method >= 0)
+    {
+      ret = zipfs_index_read(fp, filep->f_pos, buffer, buflen);
+    }
+  else
+#endif
+    {
+      ret = unzReadCurrentFile(fp->uf, buffer, buflen);
+      ret = zipfs_convert_result(ret);
+    }
+
   if (ret > 0)
     {
       filep->f_pos += ret;
@@ -394,6 +780,24 @@ static off_t zipfs_seek(FAR struct file *filep, off_t offset,
         goto err_with_lock;
     }
 
+#if CONFIG_ZIPFS_INDEX_SPAN > 0
+  /* The data at the new position is found by the next read */
+
+  if (fp->method >= 0)
+    {
+      if (offset < 0)
+        {
+          ret = -EINVAL;
+        }
+      else
+        {
+          filep->f_pos = MIN(offset, fp->usize);
+        }
+
+      goto err_with_lock;
+    }
+#endif
+
   if (filep->f_pos == offset)
     {
       goto err_with_lock;
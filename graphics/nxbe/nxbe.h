@@ -66,6 +66,19 @@
 #define NXBE_STATE_CLRMODAL(nxbe) \
   do { (nxbe)->flags &= ~NXBE_STATE_MODAL; } while (0)
 
+/* Discard the cached visible regions of all windows.  This must be done
+ * whenever the stacking order, the geometry or the visibility of a window
+ * changes.  Zero is never a valid generation:  It is the generation of a
+ * new window.
+ */
+
+#ifdef CONFIG_NX_CLIPCACHE
+#  define nxbe_clipinvalidate(be) \
+  do { if (++(be)->clipgen == 0) (be)->clipgen = 1; } while (0)
+#else
+#  define nxbe_clipinvalidate(be)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -228,6 +241,10 @@ struct nxbe_state_s
 {
   uint8_t flags;                     /* NXBE_STATE_* flags */
 
+#ifdef CONFIG_NX_CLIPCACHE
+  uint32_t clipgen;                  /* Generation of the window clip lists */
+#endif
+
 #if defined(CONFIG_NX_SWCURSOR) || defined(CONFIG_NX_HWCURSOR)
   /* Cursor support */
 
@@ -808,6 +825,31 @@ void nxbe_clipper(FAR struct nxbe_window_s *wnd,
                   FAR struct nxbe_clipops_s *cops,
                   FAR struct nxbe_plane_s *plane);
 
+/****************************************************************************
+ * Name: nxbe_clipwindow
+ *
+ * Description:
+ *   Execute the visible callback for each part of a rectangle of the window
+ *   that is not obscured by the windows above it.  With
+ *   CONFIG_NX_CLIPCACHE, the cached visible regions of the window are used
+ *   instead of clipping against every window above.
+ *
+ * Input Parameters:
+ *   wnd   - The window that is drawn into.
+ *   dest  - The region of concern within the window (absolute coordinates).
+ *   cops  - The callbacks.  The obscured callback is not used.
+ *   plane - The raster operations to be used by the callback functions.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxbe_clipwindow(FAR struct nxbe_window_s *wnd,
+                     FAR const struct nxgl_rect_s *dest,
+                     FAR struct nxbe_clipops_s *cops,
+                     FAR struct nxbe_plane_s *plane);
+
 /****************************************************************************
  * Name: nxbe_clipnull
  *
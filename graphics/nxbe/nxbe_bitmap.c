@@ -63,11 +63,33 @@ static void bitmap_clipcopy(FAR struct nxbe_clipops_s *cops,
                             FAR const struct nxgl_rect_s *rect)
 {
   struct nx_bitmap_s *bminfo = (struct nx_bitmap_s *)cops;
+#if defined(CONFIG_FB_HWBLIT) && !defined(CONFIG_NX_LCDDRIVER)
+  FAR const uint8_t *src;
+  struct fb_area_s area;
 
-  /* Copy the rectangular region to the graphics device. */
+  /* Let the blitter of the video hardware copy the rectangle of the
+   * images of whole bytes per pixel.
+   */
+
+  area.x = rect->pt1.x;
+  area.y = rect->pt1.y;
+  area.w = rect->pt2.x - rect->pt1.x + 1;
+  area.h = rect->pt2.y - rect->pt1.y + 1;
 
-  plane->dev.copyrectangle(&plane->pinfo, rect, bminfo->src,
-                           &bminfo->origin, bminfo->stride);
+  src = (FAR const uint8_t *)bminfo->src +
+        (rect->pt1.y - bminfo->origin.y) * bminfo->stride +
+        (rect->pt1.x - bminfo->origin.x) * (plane->pinfo.bpp >> 3);
+
+  if (plane->pinfo.bpp < 8 || plane->driver->copyarea == NULL ||
+      plane->driver->copyarea(plane->driver, &plane->pinfo, &area, src,
+                              bminfo->stride) < 0)
+#endif
+    {
+      /* Copy the rectangular region to the graphics device. */
+
+      plane->dev.copyrectangle(&plane->pinfo, rect, bminfo->src,
+                               &bminfo->origin, bminfo->stride);
+    }
 
 #ifdef CONFIG_NX_UPDATE
   /* Notify external logic that the display has been updated */
@@ -268,8 +290,7 @@ void nxbe_bitmap_dev(FAR struct nxbe_window_s *wnd,
       info.origin.y      = offset.y;
       info.stride        = stride;
 
-      nxbe_clipper(wnd->above, &remaining, NX_CLIPORDER_DEFAULT,
-                   &info.cops, &wnd->be->plane[i]);
+      nxbe_clipwindow(wnd, &remaining, &info.cops, &wnd->be->plane[i]);
     }
 }
 
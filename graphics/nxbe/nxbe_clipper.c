@@ -41,6 +41,7 @@
  ****************************************************************************/
 
 #define NX_INITIAL_STACKSIZE (32)
+#define NX_INITIAL_CLIPSIZE  (8)
 
 /****************************************************************************
  * Private Types
@@ -65,6 +66,17 @@ struct nxbe_clipstack_s
   struct nxbe_cliprect_s   *stack; /* The stack of deferred rectangles */
 };
 
+#ifdef CONFIG_NX_CLIPCACHE
+/* This collects the visible rectangles of a window into its clip list */
+
+struct nxbe_clipcache_s
+{
+  struct nxbe_clipops_s     cops;
+  FAR struct nxbe_window_s *wnd;
+  bool                      failed; /* A reallocation failed */
+};
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -137,6 +149,94 @@ static inline bool nxbe_poprectangle(struct nxbe_clipstack_s *stack,
   return false;
 }
 
+/****************************************************************************
+ * Name: nxbe_clipcollect
+ *
+ * Description:
+ *   Called from nxbe_clipper() to add a visible rectangle to the clip list
+ *   of the window.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_CLIPCACHE
+static void nxbe_clipcollect(FAR struct nxbe_clipops_s *cops,
+                             FAR struct nxbe_plane_s *plane,
+                             FAR const struct nxgl_rect_s *rect)
+{
+  FAR struct nxbe_clipcache_s *info = (FAR struct nxbe_clipcache_s *)cops;
+  FAR struct nxbe_window_s *wnd = info->wnd;
+
+  if (info->failed)
+    {
+      return;
+    }
+
+  if (wnd->nclip >= wnd->mxclip)
+    {
+      int mxclip = wnd->mxclip ? 2 * wnd->mxclip : NX_INITIAL_CLIPSIZE;
+      FAR struct nxgl_rect_s *newclip;
+
+      newclip = kmm_realloc(wnd->clip, sizeof(struct nxgl_rect_s) * mxclip);
+      if (newclip == NULL)
+        {
+          gerr("ERROR: Failed to reallocate clip list\n");
+          info->failed = true;
+          return;
+        }
+
+      wnd->clip   = newclip;
+      wnd->mxclip = mxclip;
+    }
+
+  nxgl_rectcopy(&wnd->clip[wnd->nclip], rect);
+  wnd->nclip++;
+}
+
+/****************************************************************************
+ * Name: nxbe_clipcache
+ *
+ * Description:
+ *   Compute the visible regions of a window.
+ *
+ * Returned Value:
+ *   True if the clip list of the window is valid.
+ *
+ ****************************************************************************/
+
+static bool nxbe_clipcache(FAR struct nxbe_window_s *wnd)
+{
+  FAR struct nxbe_state_s *be = wnd->be;
+  struct nxbe_clipcache_s info;
+  struct nxgl_rect_s bounds;
+
+  if (wnd->clipgen == be->clipgen)
+    {
+      return true;
+    }
+
+  info.cops.visible  = nxbe_clipcollect;
+  info.cops.obscured = nxbe_clipnull;
+  info.wnd           = wnd;
+  info.failed        = false;
+
+  wnd->nclip = 0;
+  nxgl_rectintersect(&bounds, &wnd->bounds, &be->bkgd.bounds);
+  if (!nxgl_nullrect(&bounds))
+    {
+      nxbe_clipper(wnd->above, &bounds, NX_CLIPORDER_DEFAULT,
+                   &info.cops, NULL);
+    }
+
+  if (info.failed)
+    {
+      return false;
+    }
+
+  wnd->clipgen = be->clipgen;
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -251,6 +351,57 @@ void nxbe_clipper(FAR struct nxbe_window_s *wnd,
     }
 }
 
+/****************************************************************************
+ * Name: nxbe_clipwindow
+ *
+ * Description:
+ *   Execute the visible callback for each part of a rectangle of the window
+ *   that is not obscured by the windows above it.
+ *
+ * Input Parameters:
+ *   wnd   - The window that is drawn into.
+ *   dest  - The region of concern within the window (absolute coordinates).
+ *   cops  - The callbacks.  The obscured callback is not used.
+ *   plane - The raster operations to be used by the callback functions.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxbe_clipwindow(FAR struct nxbe_window_s *wnd,
+                     FAR const struct nxgl_rect_s *dest,
+                     FAR struct nxbe_clipops_s *cops,
+                     FAR struct nxbe_plane_s *plane)
+{
+#ifdef CONFIG_NX_CLIPCACHE
+  struct nxgl_rect_s rect;
+  int i;
+
+  /* Use the visible regions of the window, computing them again if a
+   * window changed since they were cached.
+   */
+
+  if (nxbe_clipcache(wnd))
+    {
+      for (i = 0; i < wnd->nclip; i++)
+        {
+          nxgl_rectintersect(&rect, dest, &wnd->clip[i]);
+          if (!nxgl_nullrect(&rect))
+            {
+              cops->visible(cops, plane, &rect);
+            }
+        }
+
+      return;
+    }
+
+  /* Out of memory:  Clip against the windows above */
+#endif
+
+  nxbe_clipper(wnd->above, dest, NX_CLIPORDER_DEFAULT, cops, plane);
+}
+
 /****************************************************************************
  * Name: nxbe_clipnull
  *
@@ -114,6 +114,7 @@ void nxbe_closewindow(FAR struct nxbe_window_s *wnd)
        */
 
       wnd->below->above = wnd->above;
+      nxbe_clipinvalidate(be);
 
       /* Redraw the windows that were below us (and may now be exposed) */
 
@@ -139,6 +140,15 @@ void nxbe_closewindow(FAR struct nxbe_window_s *wnd)
     }
 #endif
 
+#ifdef CONFIG_NX_CLIPCACHE
+  /* Free the cached visible regions */
+
+  if (wnd->clip != NULL)
+    {
+      kmm_free(wnd->clip);
+    }
+#endif
+
   /* Then discard the window structure.  Here we assume that the user-space
    * allocator was used.
    */
@@ -61,10 +61,25 @@ static void nxbe_clipfill(FAR struct nxbe_clipops_s *cops,
                           FAR const struct nxgl_rect_s *rect)
 {
   struct nxbe_fill_s *fillinfo = (struct nxbe_fill_s *)cops;
+#if defined(CONFIG_FB_HWBLIT) && !defined(CONFIG_NX_LCDDRIVER)
+  struct fb_area_s area;
 
-  /* Draw the rectangle to the graphics device. */
+  /* Let the blitter of the video hardware draw the rectangle */
 
-  plane->dev.fillrectangle(&plane->pinfo, rect, fillinfo->color);
+  area.x = rect->pt1.x;
+  area.y = rect->pt1.y;
+  area.w = rect->pt2.x - rect->pt1.x + 1;
+  area.h = rect->pt2.y - rect->pt1.y + 1;
+
+  if (plane->driver->fillarea == NULL ||
+      plane->driver->fillarea(plane->driver, &plane->pinfo, &area,
+                              fillinfo->color) < 0)
+#endif
+    {
+      /* Draw the rectangle to the graphics device. */
+
+      plane->dev.fillrectangle(&plane->pinfo, rect, fillinfo->color);
+    }
 
 #ifdef CONFIG_NX_UPDATE
   /* Notify external logic that the display has been updated */
@@ -111,8 +126,7 @@ static inline void nxbe_fill_dev(FAR struct nxbe_window_s *wnd,
       info.cops.obscured = nxbe_clipnull;
       info.color         = color[i];
 
-      nxbe_clipper(wnd->above, rect, NX_CLIPORDER_DEFAULT,
-                   &info.cops, &wnd->be->plane[i]);
+      nxbe_clipwindow(wnd, rect, &info.cops, &wnd->be->plane[i]);
 
 #ifdef CONFIG_NX_SWCURSOR
       /* Backup and redraw the cursor in the affected region.
@@ -131,8 +131,7 @@ nxbe_filltrapezoid_dev(FAR struct nxbe_window_s *wnd,
        */
 
       info.color = color[i];
-      nxbe_clipper(wnd->above, bounds, NX_CLIPORDER_DEFAULT,
-                   &info.cops, &wnd->be->plane[i]);
+      nxbe_clipwindow(wnd, bounds, &info.cops, &wnd->be->plane[i]);
 
 #ifdef CONFIG_NX_SWCURSOR
       /* Backup and redraw the cursor in the modified region.
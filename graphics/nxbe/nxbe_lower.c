@@ -93,6 +93,10 @@ void nxbe_lower(FAR struct nxbe_window_s *wnd)
   wnd->above     = be->bkgd.above;
   be->bkgd.above = wnd;
 
+  /* The visible regions of the windows change with the stacking order */
+
+  nxbe_clipinvalidate(be);
+
   /* Redraw the windows that were below us (but now are above) */
 
   nxbe_redrawbelow(be, below, &wnd->bounds);
@@ -91,6 +91,10 @@ void nxbe_raise(FAR struct nxbe_window_s *wnd)
   wnd->above->below  = wnd->below;
   wnd->below->above  = wnd->above;
 
+  /* The visible regions of the windows change with the stacking order */
+
+  nxbe_clipinvalidate(be);
+
   /* Then put it back in the list. If the top window is a modal window, then
    * only raise it to second highest.
    */
@@ -51,9 +51,21 @@ void nxbe_redrawbelow(FAR struct nxbe_state_s *be,
                       FAR const struct nxgl_rect_s *rect)
 {
   FAR struct nxbe_window_s *currwnd;
+  struct nxgl_rect_s remaining;
 
+  nxgl_rectintersect(&remaining, rect, &be->bkgd.bounds);
   for (currwnd = wnd; currwnd; currwnd = currwnd->below)
     {
-      nxbe_redraw(be, currwnd, rect);
+      nxbe_redraw(be, currwnd, &remaining);
+
+      /* The windows further below are hidden by this one if the region
+       * lies entirely within it.
+       */
+
+      if (nxgl_rectinside(&currwnd->bounds, &remaining.pt1) &&
+          nxgl_rectinside(&currwnd->bounds, &remaining.pt2))
+        {
+          break;
+        }
     }
 }
@@ -130,8 +130,7 @@ static void nxbe_setpixel_dev(FAR struct nxbe_window_s *wnd,
 
       /* Draw the point (if it is visible) */
 
-      nxbe_clipper(wnd->above, &rect, NX_CLIPORDER_DEFAULT,
-                   &info.cops, &wnd->be->plane[i]);
+      nxbe_clipwindow(wnd, &rect, &info.cops, &wnd->be->plane[i]);
 
 #ifdef CONFIG_NX_SWCURSOR
       /* Update cursor backup memory and redraw the cursor in the modified
@@ -265,6 +265,7 @@ void nxbe_setsize(FAR struct nxbe_window_s *wnd,
   /* Clip the new bounding box so that lies within the background screen */
 
   nxgl_rectintersect(&wnd->bounds, &wnd->bounds, &wnd->be->bkgd.bounds);
+  nxbe_clipinvalidate(wnd->be);
 
   /* Report the new size/position.  The application needs to know the new
    * size before getting redraw requests.
@@ -58,6 +58,7 @@ void nxbe_show_window(FAR struct nxbe_window_s *wnd)
   /* Mark the window no longer hidden */
 
   NXBE_CLRHIDDEN(wnd);
+  nxbe_clipinvalidate(be);
 
   /* Restore the window to the top of the hierarchy.  Exception:  If the top
    * window is a modal window, then only raise it to second highest.
@@ -147,6 +148,7 @@ void nxbe_hide_window(FAR struct nxbe_window_s *wnd)
    */
 
   wnd->below->above = wnd->above;
+  nxbe_clipinvalidate(be);
 
   /* Redraw the windows that were below us (and may now be exposed) */
 
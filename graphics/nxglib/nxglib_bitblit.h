@@ -30,6 +30,8 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <string.h>
+#include <sys/param.h>
 
 #include <nuttx/nx/nxglib.h>
 
@@ -171,28 +173,18 @@
    }
 
 #endif /* CONFIG_NX_ANTIALIASING */
-#else /* NXGLIB_BITSPERPIXEL == 16 || NXGLIB_BITSPERPIXEL == 32 */
+#else /* NXGLIB_BITSPERPIXEL == 8, 16 or 32 */
+
+/* The runs are filled with the widest stores of the CPU, and copied with
+ * memmove():  The optimized memcpy() of the architecture, and the rows
+ * of nxgl_moverectangle() overlap when a rectangle moves horizontally.
+ */
 
 #  define NXGL_MEMSET(dest,value,width) \
-   { \
-     FAR NXGL_PIXEL_T *_ptr = (FAR NXGL_PIXEL_T*)(dest); \
-     nxgl_coord_t     _npix = (width); \
-     while (_npix--) \
-       { \
-         *_ptr++ = (value); \
-       } \
-   }
+     nxgl_memset_wide((FAR NXGL_PIXEL_T *)(dest), (value), (width))
 
 #  define NXGL_MEMCPY(dest,src,width) \
-   { \
-     FAR NXGL_PIXEL_T *_dptr = (FAR NXGL_PIXEL_T*)(dest); \
-     FAR NXGL_PIXEL_T *_sptr = (FAR NXGL_PIXEL_T*)(src); \
-     nxgl_coord_t      _npix = (width); \
-     while (_npix--) \
-       { \
-         *_dptr++ = *_sptr++; \
-       } \
-   }
+     memmove((dest), (src), (size_t)(width) * sizeof(NXGL_PIXEL_T))
 
 #ifdef CONFIG_NX_ANTIALIASING
 
@@ -228,6 +220,72 @@ extern "C"
  * Public Functions Definitions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: nxgl_memset_wide
+ *
+ * Description:
+ *   Fill a run of 8, 16 or 32 bits per pixel, a vector of the CPU (NEON,
+ *   Helium or SSE2) or a word at a time.
+ *
+ ****************************************************************************/
+
+#if NXGLIB_BITSPERPIXEL == 8 || NXGLIB_BITSPERPIXEL == 16 || \
+    NXGLIB_BITSPERPIXEL == 32
+static inline void nxgl_memset_wide(FAR NXGL_PIXEL_T *dest,
+                                    NXGL_PIXEL_T value, size_t npixels)
+{
+#if defined(__GNUC__) || defined(__clang__)
+#  if defined(__ARM_NEON) || defined(__ARM_FEATURE_MVE) || \
+      defined(__SSE2__)
+  typedef uint32_t nxgl_wide_t
+    __attribute__((vector_size(16), may_alias));
+#  else
+  typedef uint32_t nxgl_wide_t __attribute__((may_alias));
+#  endif
+
+  union
+  {
+    nxgl_wide_t wide;
+    NXGL_PIXEL_T pixel[sizeof(nxgl_wide_t) / sizeof(NXGL_PIXEL_T)];
+  } u;
+
+  FAR nxgl_wide_t *wptr;
+  size_t i;
+
+  /* Single pixels up to an aligned address */
+
+  while (npixels > 0 && ((uintptr_t)dest & (sizeof(nxgl_wide_t) - 1)) != 0)
+    {
+      *dest++ = value;
+      npixels--;
+    }
+
+  /* Then whole vectors or words */
+
+  if (npixels >= nitems(u.pixel))
+    {
+      for (i = 0; i < nitems(u.pixel); i++)
+        {
+          u.pixel[i] = value;
+        }
+
+      for (wptr = (FAR nxgl_wide_t *)dest; npixels >= nitems(u.pixel);
+           npixels -= nitems(u.pixel))
+        {
+          *wptr++ = u.wide;
+        }
+
+      dest = (FAR NXGL_PIXEL_T *)wptr;
+    }
+#endif
+
+  while (npixels-- > 0)
+    {
+      *dest++ = value;
+    }
+}
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
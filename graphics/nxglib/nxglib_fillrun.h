@@ -148,10 +148,7 @@ static inline void nxgl_fillrun_16bpp(FAR uint16_t *run,
    * the end
    */
 
-  while (npixels-- > 0)
-    {
-      *run++ = (uint16_t)color;
-    }
+  nxgl_memset_wide(run, (uint16_t)color, npixels);
 }
 
 #elif NXGLIB_BITSPERPIXEL == 24
@@ -178,10 +175,7 @@ static inline void nxgl_fillrun_32bpp(FAR uint32_t *run,
    * the end
    */
 
-  while (npixels-- > 0)
-    {
-      *run++ = (uint32_t)color;
-    }
+  nxgl_memset_wide(run, (uint32_t)color, npixels);
 }
 #else
 #  error "Unsupported value of NXGLIB_BITSPERPIXEL"
@@ -180,6 +180,8 @@ void nxmu_openwindow(FAR struct nxbe_state_s *be,
           be->topwnd->above = wnd;
           be->topwnd        = wnd;
         }
+
+      nxbe_clipinvalidate(be);
     }
 
   /* Report the initial size/position of the window to the client */
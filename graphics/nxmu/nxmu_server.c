@@ -234,6 +234,7 @@ static inline int nxmu_setup(FAR const char *mqname, FAR NX_DRIVERTYPE *dev,
    */
 
   nxmu->be.topwnd = &nxmu->be.bkgd;
+  nxbe_clipinvalidate(&nxmu->be);
 
   /* Initialize the mouse position */
 
@@ -35,6 +35,7 @@ struct chacha20_ctx
 int chacha20_setkey(FAR void *, FAR uint8_t *, int);
 void chacha20_reinit(caddr_t, FAR uint8_t *);
 void chacha20_crypt(caddr_t, FAR uint8_t *);
+void chacha20_stream(caddr_t, FAR uint8_t *, size_t);
 
 #define POLY1305_KEYLEN 32
 #define POLY1305_TAGLEN 16
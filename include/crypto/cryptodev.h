@@ -355,6 +355,13 @@ struct crypt_op
 /* Indicates that this operation processes aad
  * (Additional Authenticated Data), which is only used
  * in the authentication algorithm.
+ */
+#define COP_FLAG_ASYNC (1 << 2)
+/* Queue this operation of CIOCNCRYPTM instead of doing it in the call:
+ * it is done in order with the other queued operations of the
+ * descriptor and its result is fetched with CIOCNCRYPTRET once poll()
+ * reports POLLIN.  Its buffers must stay valid until then.  Without
+ * CONFIG_CRYPTO_CRYPTODEV_ASYNC, the operation is done in the call.
  */
 
   uint16_t flags;
@@ -366,6 +373,38 @@ struct crypt_op
   caddr_t aad;
 };
 
+/* ioctl parameter to do several operations in one call */
+
+struct crypt_n_op
+{
+  struct crypt_op cop;
+  uint32_t reqid;     /* Returned with the result */
+  int status;         /* returns: result, -EINPROGRESS if queued */
+  FAR void *opaque;   /* Returned with the result */
+};
+
+struct crypt_mop
+{
+  uint32_t count;               /* Number of operations */
+  FAR struct crypt_n_op *reqs;  /* Operations */
+};
+
+/* ioctl parameter to fetch the results of the queued operations */
+
+struct crypt_result
+{
+  uint32_t reqid;
+  int status;
+  FAR void *opaque;
+};
+
+struct cryptret
+{
+  uint32_t count;                   /* Size of results,
+                                     * returns: results fetched */
+  FAR struct crypt_result *results;
+};
+
 /* hamc buffer, software & hardware need it */
 
 extern const uint8_t hmac_ipad_buffer[HMAC_MAX_BLOCK_LEN];
@@ -387,6 +426,8 @@ extern const uint8_t hmac_opad_buffer[HMAC_MAX_BLOCK_LEN];
 #define CIOCKEY                 104
 #define CIOCKEYRET              105
 #define CIOCASYMFEAT            106
+#define CIOCNCRYPTM             107
+#define CIOCNCRYPTRET           108
 
 int crypto_newsession(FAR uint64_t *, FAR struct cryptoini *, int);
 int crypto_freesession(uint64_t);
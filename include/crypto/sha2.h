@@ -86,4 +86,14 @@ void sha512init(FAR SHA2_CTX *);
 void sha512update(FAR SHA2_CTX *, FAR const void *, size_t);
 void sha512final(FAR uint8_t *, FAR SHA2_CTX *);
 
+/* Hash n independent messages in one call, digests[i] is the hash of the
+ * len[i] bytes at data[i]:  The messages are hashed in the lanes of the
+ * SIMD unit when there is one.
+ */
+
+void sha256multi(FAR uint8_t (*)[SHA256_DIGEST_LENGTH],
+                 FAR const void *const *, FAR const size_t *, size_t);
+void sha512multi(FAR uint8_t (*)[SHA512_DIGEST_LENGTH],
+                 FAR const void *const *, FAR const size_t *, size_t);
+
 #endif /* __INCLUDE_CRYPTO_SHA2_H */
@@ -76,6 +76,12 @@ struct enc_xform
   CODE void (*decrypt)(caddr_t, FAR uint8_t *);
   CODE int  (*setkey)(FAR void *, FAR uint8_t *, int len);
   CODE void (*reinit)(caddr_t, FAR uint8_t *);
+
+  /* Optional, counter modes: XOR data with the next len bytes of the key
+   * stream, several blocks per call of the cipher.
+   */
+
+  CODE void (*stream)(caddr_t, FAR uint8_t *, size_t);
 };
 
 struct comp_algo
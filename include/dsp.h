@@ -459,6 +459,71 @@ struct avg_filter_data_s
   float k;             /* k counter */
 };
 
+#ifdef CONFIG_LIBDSP_BATCH
+
+/* Frames of several instances for the batched functions, laid out as
+ * structures of arrays:  Each member points to the array of the values of
+ * the instances.
+ */
+
+struct abc_frames_f32_s
+{
+  FAR float *a;                /* A components */
+  FAR float *b;                /* B components */
+  FAR float *c;                /* C components */
+};
+
+struct ab_frames_f32_s
+{
+  FAR float *a;                /* Alpha components */
+  FAR float *b;                /* Beta components */
+};
+
+struct dq_frames_f32_s
+{
+  FAR float *d;                /* Direct components */
+  FAR float *q;                /* Quadrature components */
+};
+
+struct phase_angles_f32_s
+{
+  FAR float *sin;              /* Phase angle sines */
+  FAR float *cos;              /* Phase angle cosines */
+};
+
+struct svm3_states_f32_s
+{
+  FAR uint8_t *sector;         /* Current space vector sectors */
+  FAR float   *d_u;            /* Duty cycles for phase U */
+  FAR float   *d_v;            /* Duty cycles for phase V */
+  FAR float   *d_w;            /* Duty cycles for phase W */
+};
+
+/* FOC current controllers of several instances:  The PI controllers are
+ * those of foc_init(), with the anti-windup protection and the output
+ * saturated to the base voltage.  The arrays must not overlap.
+ */
+
+struct foc_batch_f32_s
+{
+  size_t                    n;        /* Number of instances */
+  struct phase_angles_f32_s angle;    /* Phase angles */
+  struct dq_frames_f32_s    i_dq;     /* Current in dq frame */
+  struct dq_frames_f32_s    i_dq_ref; /* Requested current */
+  struct dq_frames_f32_s    v_dq;     /* Requested voltage in dq frame */
+  struct ab_frames_f32_s    v_ab_mod; /* Modulation voltage normalized to
+                                       * magnitude (0.0, 1.0)
+                                       */
+
+  struct dq_frames_f32_s    kp;       /* KP of the d and q controllers */
+  struct dq_frames_f32_s    ki;       /* KI of the d and q controllers */
+  struct dq_frames_f32_s    part;     /* Integral parts */
+  struct dq_frames_f32_s    aw;       /* Integral anti-windup decay parts */
+  FAR float                *vbase;    /* Base voltage, positive */
+  float                     kc;       /* Anti-windup decay coefficient */
+};
+#endif
+
 /****************************************************************************
  * Public Functions Prototypes
  ****************************************************************************/
@@ -619,6 +684,30 @@ void avg_filter_data_init(FAR struct avg_filter_data_s *data,
                           float prev_avg, float k);
 float avg_filter(FAR struct avg_filter_data_s *data, float x);
 
+#ifdef CONFIG_LIBDSP_BATCH
+
+/* Batched functions of several instances */
+
+void clarke_transform_batch(FAR struct abc_frames_f32_s *abc,
+                            FAR struct ab_frames_f32_s *ab, size_t n);
+void inv_clarke_transform_batch(FAR struct ab_frames_f32_s *ab,
+                                FAR struct abc_frames_f32_s *abc,
+                                size_t n);
+void park_transform_batch(FAR struct phase_angles_f32_s *angle,
+                          FAR struct ab_frames_f32_s *ab,
+                          FAR struct dq_frames_f32_s *dq, size_t n);
+void inv_park_transform_batch(FAR struct phase_angles_f32_s *angle,
+                              FAR struct dq_frames_f32_s *dq,
+                              FAR struct ab_frames_f32_s *ab, size_t n);
+void svm3_batch(FAR struct svm3_states_f32_s *s,
+                FAR struct ab_frames_f32_s *v_ab, size_t n);
+void foc_iabc_update_batch(FAR struct foc_batch_f32_s *foc,
+                           FAR struct abc_frames_f32_s *i_abc);
+void foc_current_control_batch(FAR struct foc_batch_f32_s *foc,
+                               FAR struct dq_frames_f32_s *vdq_comp);
+void foc_voltage_control_batch(FAR struct foc_batch_f32_s *foc);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
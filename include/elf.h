@@ -248,6 +248,9 @@
                                        * semantics.
                                        */
 #define PF_REGISTER        0x00100000 /* Register, need pointer aligned access */
+#define PF_PRIO_SHIFT      21         /* Order of a region in the core dump */
+#define PF_PRIO_MASK       0x00600000 /* From 0, dumped first, to 3, dumped last */
+#define PF_PRIO(n)         (((n) << PF_PRIO_SHIFT) & PF_PRIO_MASK)
 
 #define PF_MASKPROC        0xf0000000 /* Unspecified */
 
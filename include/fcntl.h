@@ -154,6 +154,13 @@
 #define F_SEAL_WRITE        0x0008 /* Prevent writes */
 #define F_SEAL_FUTURE_WRITE 0x0010 /* Prevent future writes while mapped */
 
+/* Flags for splice() and tee() (linux) */
+
+#define SPLICE_F_MOVE       0x0001 /* Hint only, the data is always moved */
+#define SPLICE_F_NONBLOCK   0x0002 /* Don't wait for the pipes */
+#define SPLICE_F_MORE       0x0004 /* Hint only, more data will follow */
+#define SPLICE_F_GIFT       0x0008 /* Unused */
+
 /* int creat(const char *path, mode_t mode);
  *
  * is equivalent to open with O_WRONLY|O_CREAT|O_TRUNC.
@@ -215,6 +222,10 @@ int fcntl(int fd, int cmd, ...);
 
 int posix_fallocate(int fd, off_t offset, off_t len);
 
+ssize_t splice(int fdin, FAR off_t *offin, int fdout, FAR off_t *offout,
+               size_t len, unsigned int flags);
+ssize_t tee(int fdin, int fdout, size_t len, unsigned int flags);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
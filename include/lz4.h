@@ -0,0 +1,119 @@
+/****************************************************************************
+ * include/lz4.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_LZ4_H
+#define __INCLUDE_LZ4_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sys/types.h>
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_LZ4
+
+#define LZ4_HLOG             CONFIG_LIBC_LZ4_HLOG
+
+/* The largest block that lz4_compress() accepts */
+
+#define LZ4_MAX_BLOCKSIZE    65536
+
+/* The size of the output that lz4_compress() needs in the worst case */
+
+#define LZ4_COMPRESSBOUND(n) ((n) + (n) / 255 + 16)
+
+/* LZ4 frame format:  Header of a frame of independent blocks of up to
+ * 64 KiB, without content size nor checksums, that is the magic number,
+ * the FLG and BD descriptor bytes and their checksum.  Each block is then
+ * preceded by its size (little endian), followed by the block data, and
+ * the frame ends with a zero size.
+ */
+
+#define LZ4_FRAME_MAGIC        0x184d2204
+#define LZ4_FRAME_FLG          0x60       /* Version 1, independent blocks */
+#define LZ4_FRAME_BD           0x40       /* Blocks of up to 64 KiB */
+#define LZ4_FRAME_HC           0x82       /* (XXH32(FLG, BD) >> 8) & 0xff */
+#define LZ4_FRAME_HDR_SIZE     7
+#define LZ4_FRAME_BLKHDR_SIZE  4
+#define LZ4_FRAME_UNCOMPRESSED 0x80000000 /* Block size flag */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* LZ4 hash table:  Positions of the last occurrence of each hash in the
+ * block being compressed.  It needs no initialization.
+ */
+
+typedef uint16_t lz4_state_t[1 << LZ4_HLOG];
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_compress
+ *
+ * Description:
+ *   Compress in_len bytes, at most LZ4_MAX_BLOCKSIZE, stored at in_data
+ *   into an LZ4 block at out_data, up to a maximum length of out_len
+ *   bytes.  With out_len at least LZ4_COMPRESSBOUND(in_len), the
+ *   compression cannot fail.
+ *
+ *   The block format is that of the LZ4 library, so the data can be
+ *   decompressed with lz4_decompress() or with any other LZ4 decoder.  The
+ *   buffers must not be overlapping.
+ *
+ * Returned Value:
+ *   The number of bytes used, 0 if the output buffer is not large enough
+ *   or in_len is too large.
+ *
+ ****************************************************************************/
+
+size_t lz4_compress(FAR const void *in_data, size_t in_len,
+                    FAR void *out_data, size_t out_len, lz4_state_t htab);
+
+/****************************************************************************
+ * Name: lz4_decompress
+ *
+ * Description:
+ *   Decompress the LZ4 block of in_len bytes stored at in_data.  The
+ *   result is stored at out_data, up to a maximum of out_len bytes.
+ *
+ * Returned Value:
+ *   The number of decompressed bytes.  If the output buffer is not large
+ *   enough to hold the decompressed data, a 0 is returned and errno is set
+ *   to E2BIG.  If an error in the compressed data is detected, a zero is
+ *   returned and errno is set to EINVAL.
+ *
+ ****************************************************************************/
+
+size_t lz4_decompress(FAR const void *in_data, size_t in_len,
+                      FAR void *out_data, size_t out_len);
+
+#endif /* CONFIG_LIBC_LZ4 */
+#endif /* __INCLUDE_LZ4_H */
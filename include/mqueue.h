@@ -87,6 +87,18 @@ int     mq_setattr(mqd_t mqdes, FAR const struct mq_attr *mq_stat,
                    FAR struct mq_attr *oldstat);
 int     mq_getattr(mqd_t mqdes, FAR struct mq_attr *mq_stat);
 
+#ifdef CONFIG_MQ_ZEROCOPY
+/* Non-standard zero-copy extensions: The message is built or consumed in
+ * place in a message buffer of the queue.
+ */
+
+FAR void *mq_reserve(mqd_t mqdes, size_t msglen);
+int     mq_commit(mqd_t mqdes, FAR void *buf, size_t msglen,
+                  unsigned int prio);
+ssize_t mq_peek(mqd_t mqdes, FAR void **buf, FAR unsigned int *prio);
+int     mq_release(mqd_t mqdes, FAR void *buf);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
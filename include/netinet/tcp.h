@@ -58,4 +58,8 @@
                                            * Argument: max retry count */
 #define TCP_MAXSEG    (__SO_PROTOCOL + 4) /* The maximum segment size */
 
+/* The congestion control algorithm.  Argument: The name, a string */
+
+#define TCP_CONGESTION (__SO_PROTOCOL + 5)
+
 #endif /* __INCLUDE_NETINET_TCP_H */
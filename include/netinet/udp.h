@@ -33,6 +33,14 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* UDP protocol (SOL_UDP) socket options */
+
+#define UDP_SEGMENT     103     /* int: Segment size of the datagrams sent
+                                 * by one send, 0 to disable */
+#define UDP_GRO         104     /* int: Receive the datagrams of the same
+                                 * sender and size at once, the size is in
+                                 * a UDP_GRO control message (int) */
+
 /* UDP header as specified by RFC 768, August 1980. */
 
 struct udphdr
@@ -30,6 +30,43 @@
 #include <nuttx/config.h>
 #include <stdint.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* SOL_PACKET protocol-level socket options */
+
+#define PACKET_RX_RING          5  /* Map a ring of received frames
+                                    * (struct tpacket_req) */
+#define PACKET_STATISTICS       6  /* Frames received and dropped since the
+                                    * last call (struct tpacket_stats) */
+#define PACKET_TX_RING          13 /* Map a ring of frames to send
+                                    * (struct tpacket_req) */
+
+/* The tp_status of the frames of the receive ring */
+
+#define TP_STATUS_KERNEL        0        /* Owned by the kernel */
+#define TP_STATUS_USER          (1 << 0) /* Holds a frame for the user */
+#define TP_STATUS_LOSING        (1 << 2) /* Frames were dropped before */
+
+/* The tp_status of the frames of the transmit ring */
+
+#define TP_STATUS_AVAILABLE     0        /* Owned by the user */
+#define TP_STATUS_SEND_REQUEST  (1 << 0) /* Holds a frame to send */
+#define TP_STATUS_SENDING       (1 << 1) /* Being sent */
+#define TP_STATUS_WRONG_FORMAT  (1 << 2) /* Too long, not sent */
+
+/* A frame starts with a struct tpacket_hdr and a struct sockaddr_ll, the
+ * data of a received frame is at tp_mac bytes from the start and the data
+ * of a frame to send at TPACKET_HDRLEN - sizeof(struct sockaddr_ll).
+ */
+
+#define TPACKET_ALIGNMENT       16
+#define TPACKET_ALIGN(x)        (((x) + TPACKET_ALIGNMENT - 1) & \
+                                 ~(TPACKET_ALIGNMENT - 1))
+#define TPACKET_HDRLEN          (TPACKET_ALIGN(sizeof(struct tpacket_hdr)) + \
+                                 sizeof(struct sockaddr_ll))
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -45,4 +82,36 @@ struct sockaddr_ll
   unsigned char  sll_addr[8];
 };
 
+/* The geometry of a ring:  tp_block_nr blocks of tp_block_size bytes, each
+ * holding tp_block_size / tp_frame_size frames.  mmap() maps the receive
+ * ring followed by the transmit ring.
+ */
+
+struct tpacket_req
+{
+  unsigned int   tp_block_size;
+  unsigned int   tp_block_nr;
+  unsigned int   tp_frame_size;
+  unsigned int   tp_frame_nr;
+};
+
+/* The header of a frame of a ring */
+
+struct tpacket_hdr
+{
+  unsigned long  tp_status;
+  unsigned int   tp_len;
+  unsigned int   tp_snaplen;
+  unsigned short tp_mac;
+  unsigned short tp_net;
+  unsigned int   tp_sec;
+  unsigned int   tp_usec;
+};
+
+struct tpacket_stats
+{
+  unsigned int   tp_packets;
+  unsigned int   tp_drops;
+};
+
 #endif /* __INCLUDE_NETPACKET_PACKET_H */
@@ -1718,6 +1718,54 @@ int up_shmat(FAR uintptr_t *pages, unsigned int npages, uintptr_t vaddr);
 int up_shmdt(uintptr_t vaddr, unsigned int npages);
 #endif
 
+/****************************************************************************
+ * Name: up_shmat_huge
+ *
+ * Description:
+ *   Attach, i.e, map, a shared memory region of huge pages to a user
+ *   virtual address, each huge page with a single translation table entry
+ *   where possible.
+ *
+ * Input Parameters:
+ *   pages - A pointer to the first element in a array of physical address,
+ *     each corresponding to one huge page of MM_HUGEPGSIZE bytes.
+ *   nhuge - The number of huge pages in the list to be mapped.
+ *   vaddr - The virtual address corresponding to the beginning of the
+ *     (contiguous) virtual address region, aligned to MM_HUGEPGSIZE.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_ARCH_VMA_MAPPING) && defined(CONFIG_MM_HUGEPAGE)
+int up_shmat_huge(FAR uintptr_t *pages, unsigned int nhuge,
+                  uintptr_t vaddr);
+#endif
+
+/****************************************************************************
+ * Name: up_shmdt_huge
+ *
+ * Description:
+ *   Detach, i.e, unmap, a shared memory region of huge pages attached by
+ *   up_shmat_huge().
+ *
+ * Input Parameters:
+ *   vaddr - The virtual address corresponding to the beginning of the
+ *     (contiguous) virtual address region, aligned to MM_HUGEPGSIZE.
+ *   nhuge - The number of huge pages to be unmapped
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_ARCH_VMA_MAPPING) && defined(CONFIG_MM_HUGEPAGE)
+int up_shmdt_huge(uintptr_t vaddr, unsigned int nhuge);
+#endif
+
 /****************************************************************************
  * Interfaces required for ELF module support
  *
@@ -1947,7 +1995,8 @@ void up_timer_initialize(void);
  *
  ****************************************************************************/
 
-#if defined(CONFIG_SCHED_TICKLESS) && !defined(CONFIG_SCHED_TICKLESS_TICK_ARGUMENT)
+#if (defined(CONFIG_SCHED_TICKLESS) && \
+     !defined(CONFIG_SCHED_TICKLESS_TICK_ARGUMENT)) || defined(CONFIG_HRTIMER)
 int up_timer_gettime(FAR struct timespec *ts);
 #endif
 
@@ -2034,6 +2083,35 @@ int up_alarm_tick_start(clock_t ticks);
 #  endif
 #endif
 
+/****************************************************************************
+ * Name: up_hrtimer_start
+ *
+ * Description:
+ *   Program the timer hardware so that nxsched_hrtimer_expiration() is
+ *   called when CLOCK_MONOTONIC reaches 'expired'.  This replaces any
+ *   previous hrtimer expiration time.  The hardware timer is shared with
+ *   the OS tick or alarm, whichever comes first is honored.
+ *
+ *   Provided by platform-specific code and called from the RTOS base code.
+ *
+ * Input Parameters:
+ *   expired - Absolute time in nanoseconds, or UINT64_MAX if no hrtimer is
+ *             active.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ * Assumptions:
+ *   May be called from interrupt level handling or from the normal tasking
+ *   level.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER
+int up_hrtimer_start(uint64_t expired);
+#endif
+
 /****************************************************************************
  * Name: up_timer_cancel
  *
@@ -2516,6 +2594,30 @@ void nxsched_alarm_expiration(FAR const struct timespec *ts);
 void nxsched_alarm_tick_expiration(clock_t ticks);
 #endif
 
+/****************************************************************************
+ * Name:  nxsched_hrtimer_expiration
+ *
+ * Description:
+ *   if CONFIG_HRTIMER is defined, then this function is provided by the
+ *   RTOS base code and called from platform-specific code when the time
+ *   programmed with up_hrtimer_start() is reached.
+ *
+ * Input Parameters:
+ *   now - The current time of CLOCK_MONOTONIC in nanoseconds
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions/Limitations:
+ *   Base code implementation assumes that this function is called from
+ *   interrupt handling logic with interrupts disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER
+void nxsched_hrtimer_expiration(uint64_t now);
+#endif
+
 /****************************************************************************
  * Name:  nxsched_get_next_expired
  *
@@ -94,6 +94,17 @@
  * AUDIOIOC_STOP - Stop Audio streaming
  *
  *   ioctl argument:  None
+ *
+ * AUDIOIOC_SETUPRING - Set up the shared ring of the low-latency mode
+ *
+ *   ioctl argument:  Pointer to the audio_ring_desc_s structure with the
+ *                    number and size of the periods, zero periods to free
+ *                    the ring.  The ring is then mapped with mmap().
+ *
+ * AUDIOIOC_COMMITRING - Release periods of the ring to the driver
+ *
+ *   ioctl argument:  The number of periods filled (output) or consumed
+ *                    (input) by the application.
  */
 
 #define AUDIOIOC_GETCAPS            _AUDIOIOC(1)
@@ -117,6 +128,8 @@
 #define AUDIOIOC_GETLATENCY         _AUDIOIOC(19)
 #define AUDIOIOC_FLUSH              _AUDIOIOC(20)
 #define AUDIOIOC_GETPOSITION        _AUDIOIOC(21)
+#define AUDIOIOC_SETUPRING          _AUDIOIOC(22)
+#define AUDIOIOC_COMMITRING         _AUDIOIOC(23)
 
 /* Audio Device Types *******************************************************/
 
@@ -370,6 +383,7 @@
 #define AUDIO_APB_OUTPUT_PROCESS    (1 << 1)
 #define AUDIO_APB_DEQUEUED          (1 << 2)
 #define AUDIO_APB_FINAL             (1 << 3) /* Last buffer in the stream */
+#define AUDIO_APB_RING              (1 << 4) /* Period of the shared ring */
 
 /* Audio channels range wrapper macro */
 
@@ -526,6 +540,43 @@ struct audio_buf_desc_s
   } u;
 };
 
+/* Structure for setting up the shared ring of the low-latency mode via the
+ * AUDIOIOC_SETUPRING ioctl.
+ */
+
+struct audio_ring_desc_s
+{
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+  FAR void            *session;           /* Associated channel */
+#endif
+  uint8_t             type;               /* AUDIO_TYPE_OUTPUT or
+                                           * AUDIO_TYPE_INPUT */
+  apb_samp_t          nperiods;           /* Number of periods */
+  apb_samp_t          period_bytes;       /* Size of each period */
+};
+
+/* The shared ring of the low-latency mode, mapped by the application with
+ * mmap().  The periods are Audio Pipeline Buffers that the lower-half
+ * driver transfers in place, period 'n' of the stream being
+ * period[n % nperiods].  The counts are free running:  The driver has
+ * completed 'hw' periods and the application has released 'appl' of them,
+ * either filled for an output or consumed for an input (an input starts
+ * with all the periods released).  'appl - hw' never exceeds 'nperiods'.
+ * The application waits for the periods with poll(), no message is sent
+ * as each period completes.
+ */
+
+struct audio_ring_s
+{
+  uint32_t            nperiods;           /* Number of periods */
+  uint32_t            period_bytes;       /* Size of each period */
+  volatile uint32_t   hw;                 /* Periods completed by the driver */
+  volatile uint32_t   appl;               /* Periods released by the
+                                           * application */
+  volatile uint32_t   xruns;              /* Number of underruns */
+  FAR uint8_t         *period[1];         /* The samples of each period */
+};
+
 /* Typedef for lower-level to upper-level callback for buffer dequeuing */
 
 #ifdef CONFIG_AUDIO_MULTI_SESSION
@@ -0,0 +1,128 @@
+/****************************************************************************
+ * include/nuttx/boottrace.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_BOOTTRACE_H
+#define __INCLUDE_NUTTX_BOOTTRACE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
+#include <time.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The types of the records */
+
+#define BOOTTRACE_BEGIN  0  /* A phase of the boot begins */
+#define BOOTTRACE_END    1  /* The phase of the same name ends */
+#define BOOTTRACE_MARK   2  /* An event of the boot */
+
+#ifdef CONFIG_SCHED_BOOTTRACE
+#  define boottrace_begin(...) boottrace_record(BOOTTRACE_BEGIN, __VA_ARGS__)
+#  define boottrace_end(...)   boottrace_record(BOOTTRACE_END, __VA_ARGS__)
+#  define boottrace_mark(...)  boottrace_record(BOOTTRACE_MARK, __VA_ARGS__)
+#else
+#  define boottrace_begin(...)
+#  define boottrace_end(...)
+#  define boottrace_mark(...)
+#endif
+
+#ifdef CONFIG_SCHED_BOOTTRACE
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* A record of the boot trace */
+
+struct boottrace_s
+{
+  clock_t time;                              /* up_perf_gettime() */
+  uint8_t type;                              /* BOOTTRACE_* */
+  uint8_t cpu;                               /* The CPU that recorded */
+  char    name[CONFIG_SCHED_BOOTTRACE_NAMELEN];
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: boottrace_record
+ *
+ * Description:
+ *   Add a record of 'type' named by the format 'fmt'.  This may be called
+ *   from the entry of nx_start() on, and from interrupt handlers.  The
+ *   name is truncated to CONFIG_SCHED_BOOTTRACE_NAMELEN - 1 characters.
+ *
+ ****************************************************************************/
+
+void boottrace_record(int type, FAR const IPTR char *fmt, ...)
+     printf_like(2, 3);
+
+/****************************************************************************
+ * Name: boottrace_get
+ *
+ * Description:
+ *   Get a copy of record 'index', in the order they were added.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOENT if there is no record at
+ *   'index'.
+ *
+ ****************************************************************************/
+
+int boottrace_get(int index, FAR struct boottrace_s *record);
+
+/****************************************************************************
+ * Name: boottrace_dropped
+ *
+ * Description:
+ *   Return the number of records that were dropped because the buffer was
+ *   full.
+ *
+ ****************************************************************************/
+
+uint32_t boottrace_dropped(void);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_SCHED_BOOTTRACE */
+#endif /* __INCLUDE_NUTTX_BOOTTRACE_H */
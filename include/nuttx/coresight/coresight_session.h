@@ -0,0 +1,127 @@
+/****************************************************************************
+ * include/nuttx/coresight/coresight_session.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_CORESIGHT_CORESIGHT_SESSION_H
+#define __INCLUDE_NUTTX_CORESIGHT_CORESIGHT_SESSION_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <stdint.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/coresight/coresight_tmc.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* A trace session keeps the trace of its sources in the circular buffer of
+ * a TMC-ETR until a trigger freezes it:  A panic, a call to
+ * coresight_session_freeze() from a tracepoint, or a hot path that takes
+ * longer than the latency threshold of the session.  The triggers may be
+ * left in the code without the session manager.
+ */
+
+#ifndef CONFIG_CORESIGHT_SESSION
+#  define coresight_session_freeze(reason)  (-ENOSYS)
+#  define coresight_session_latency(start)
+#else
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: coresight_session_start
+ *
+ * Description:
+ *   Start a trace session:  Enable the trace path from each source, through
+ *   the links, to the TMC-ETR sink that captures the trace in its circular
+ *   buffer.  There is one session at a time.
+ *
+ * Input Parameters:
+ *   srcdevs   - The source devices, ETM or STM.
+ *   nsrc      - The number of the source devices.
+ *   sink      - The TMC-ETR device that captures the trace.
+ *   threshold - The latency threshold in nanoseconds of
+ *               coresight_session_latency(), zero to disable it.
+ *
+ * Returned Value:
+ *   Zero on success; a negative value on failure.
+ *
+ ****************************************************************************/
+
+int coresight_session_start(FAR struct coresight_dev_s **srcdevs, int nsrc,
+                            FAR struct coresight_tmc_dev_s *sink,
+                            uint32_t threshold);
+
+/****************************************************************************
+ * Name: coresight_session_stop
+ *
+ * Description:
+ *   Stop the trace session and disable its trace paths.  A frozen trace is
+ *   kept in the sink until it is read.
+ *
+ ****************************************************************************/
+
+void coresight_session_stop(void);
+
+/****************************************************************************
+ * Name: coresight_session_freeze
+ *
+ * Description:
+ *   Freeze the trace of the session:  The sink is flushed and stopped, and
+ *   its buffer holds the trace up to this call until it is read from the
+ *   device node of the sink; The capture restarts after the read.  May be
+ *   called from an interrupt handler.
+ *
+ * Input Parameters:
+ *   reason - The reason of the freeze, logged with the location of the
+ *            trace.
+ *
+ * Returned Value:
+ *   Zero on success; -ENODEV without session and -EALREADY if the trace is
+ *   already frozen.
+ *
+ ****************************************************************************/
+
+int coresight_session_freeze(FAR const char *reason);
+
+/****************************************************************************
+ * Name: coresight_session_latency
+ *
+ * Description:
+ *   Freeze the trace if more than the latency threshold of the session
+ *   elapsed since 'start', taken with perf_gettime() at the start of the
+ *   hot path.
+ *
+ ****************************************************************************/
+
+void coresight_session_latency(clock_t start);
+
+#endif /* CONFIG_CORESIGHT_SESSION */
+#endif /* __INCLUDE_NUTTX_CORESIGHT_CORESIGHT_SESSION_H */
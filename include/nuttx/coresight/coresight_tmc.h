@@ -27,6 +27,8 @@
  * Included Files
  ****************************************************************************/
 
+#include <stdbool.h>
+
 #include <nuttx/mutex.h>
 #include <nuttx/coresight/coresight.h>
 
@@ -98,6 +100,7 @@ struct coresight_tmc_dev_s
   enum tmc_etr_mode_e mode;             /* ETR buffer mode. */
   uint32_t offset;                      /* Data offset in ETR buffer. */
   uint8_t opencnt;                      /* TMC device's open count. */
+  bool frozen;                          /* Capture stopped by a freeze. */
 };
 
 /****************************************************************************
@@ -134,4 +137,25 @@ tmc_register(FAR const struct coresight_desc_s *desc);
 
 void tmc_unregister(FAR struct coresight_tmc_dev_s *tmcdev);
 
+/****************************************************************************
+ * Name: tmc_etr_freeze
+ *
+ * Description:
+ *   Flush and stop the capture of an enabled TMC-ETR device, keeping the
+ *   trace in its circular buffer until the device is read:  The buffer is
+ *   read from the device node, and the capture restarts when the last
+ *   reader closes it.  May be called from an interrupt handler or from a
+ *   panic notifier.
+ *
+ * Input Parameters:
+ *   tmcdev  - Pointer to the TMC-ETR device.
+ *
+ * Returned Value:
+ *   Zero on success; -EACCES if the device is not enabled and -EALREADY if
+ *   the capture is already stopped.
+ *
+ ****************************************************************************/
+
+int tmc_etr_freeze(FAR struct coresight_tmc_dev_s *tmcdev);
+
 #endif  //__INCLUDE_NUTTX_CORESIGHT_CORESIGHT_TMC_H
@@ -0,0 +1,287 @@
+/****************************************************************************
+ * include/nuttx/coroutine.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_COROUTINE_H
+#define __INCLUDE_NUTTX_COROUTINE_H
+
+/* Stackless cooperative coroutines.
+ *
+ * A coroutine is a function that is called again and again by a scheduler
+ * (struct cosched_s) until it ends.  Between the calls it is suspended at
+ * a CO_YIELD() or at a CO_AWAIT() until its descriptor is ready, and the
+ * next call resumes it after that point.  The coroutines of a scheduler
+ * all run in the thread that calls cosched_run(), so they need no locking
+ * among them, and a coroutine takes no stack while suspended:  Thousands
+ * of sessions can be served by a few worker threads, each with its own
+ * scheduler.
+ *
+ * Because the stack of a coroutine is not preserved, its local variables
+ * do not keep their values across CO_YIELD() and CO_AWAIT().  State that
+ * must persist is kept in a structure that embeds the struct coroutine_s,
+ * and the body must not use switch statements around these points:
+ *
+ *   struct session_s
+ *   {
+ *     struct coroutine_s co;
+ *     int fd;
+ *     ...
+ *   };
+ *
+ *   static int session(FAR struct coroutine_s *co)
+ *   {
+ *     FAR struct session_s *s = (FAR struct session_s *)co;
+ *
+ *     CO_BEGIN(co);
+ *     for (; ; )
+ *       {
+ *         CO_AWAIT(co, s->fd, EPOLLIN);
+ *         ...
+ *       }
+ *
+ *     CO_END(co);
+ *   }
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <sys/epoll.h>
+
+#include <nuttx/queue.h>
+
+#ifdef CONFIG_LIBC_COROUTINE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The values returned by the body of a coroutine to the scheduler */
+
+#define COROUTINE_EXIT   0  /* The coroutine has ended */
+#define COROUTINE_YIELD  1  /* The coroutine is ready to run again */
+#define COROUTINE_WAIT   2  /* The coroutine waits for its descriptor */
+
+/* These macros build the body of a coroutine.  CO_BEGIN() and CO_END()
+ * enclose the body.  CO_YIELD() lets the other coroutines of the
+ * scheduler run.  CO_AWAIT() suspends the coroutine until one of 'events'
+ * (EPOLLIN, EPOLLOUT, ...) occurs on 'fd' and stores the events that ended
+ * the wait in co->revents; EPOLLERR is stored if 'fd' can not be watched.
+ * CO_EXIT() ends the coroutine early.
+ */
+
+#define CO_BEGIN(co) \
+  switch ((co)->state) \
+    { \
+      case 0:
+
+#define CO_END(co) \
+    } \
+  (co)->state = 0; \
+  return COROUTINE_EXIT
+
+#define CO_YIELD(co) \
+  do \
+    { \
+      (co)->state = __LINE__; \
+      return COROUTINE_YIELD; \
+      case __LINE__:; \
+    } \
+  while (0)
+
+#define CO_AWAIT(co, fd, events) \
+  do \
+    { \
+      if (coroutine_watch(co, fd, events) >= 0) \
+        { \
+          (co)->state = __LINE__; \
+          return COROUTINE_WAIT; \
+          case __LINE__:; \
+        } \
+    } \
+  while (0)
+
+#define CO_EXIT(co) \
+  do \
+    { \
+      (co)->state = 0; \
+      return COROUTINE_EXIT; \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct coroutine_s;
+
+/* The body of a coroutine returns COROUTINE_EXIT, COROUTINE_YIELD or
+ * COROUTINE_WAIT; it is normally written with the CO_xxx() macros.
+ */
+
+typedef CODE int (*coroutine_entry_t)(FAR struct coroutine_s *co);
+
+/* Called once the coroutine has ended, e.g. to free its memory */
+
+typedef CODE void (*coroutine_release_t)(FAR struct coroutine_s *co);
+
+/* This structure describes one coroutine */
+
+struct coroutine_s
+{
+  sq_entry_t            node;     /* Entry in the ready queue */
+  FAR struct cosched_s *sched;    /* The scheduler of the coroutine */
+  coroutine_entry_t     entry;    /* The body of the coroutine */
+  coroutine_release_t   release;  /* Called when the coroutine ends */
+  FAR void             *arg;      /* The argument of the coroutine */
+  int                   state;    /* Where to resume, 0 at the start */
+  int                   fd;       /* The descriptor watched, or -1 */
+  uint32_t              revents;  /* The events that ended the wait */
+};
+
+/* This structure describes a scheduler of coroutines */
+
+struct cosched_s
+{
+  int          epfd;          /* The epoll instance of the descriptors */
+  sq_queue_t   ready;         /* The coroutines ready to run */
+  unsigned int nwaiting;      /* The number of waiting coroutines */
+  unsigned int ncoroutines;   /* The number of coroutines not ended */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: cosched_init
+ *
+ * Description:
+ *   Initialize a scheduler of coroutines.
+ *
+ * Input Parameters:
+ *   sched - The scheduler to initialize.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+int cosched_init(FAR struct cosched_s *sched);
+
+/****************************************************************************
+ * Name: cosched_uninit
+ *
+ * Description:
+ *   Release the resources of a scheduler.  All of its coroutines must have
+ *   ended.
+ *
+ ****************************************************************************/
+
+void cosched_uninit(FAR struct cosched_s *sched);
+
+/****************************************************************************
+ * Name: cosched_spawn
+ *
+ * Description:
+ *   Add a coroutine to a scheduler.  It runs from the start at the next
+ *   cosched_run().  The coroutines of a scheduler, and the thread that
+ *   calls cosched_run(), are the only ones that may add coroutines to it.
+ *
+ * Input Parameters:
+ *   sched   - The scheduler that runs the coroutine.
+ *   co      - The coroutine, usually embedded in the session state.
+ *   entry   - The body of the coroutine.
+ *   release - Called when the coroutine has ended, may be NULL.
+ *   arg     - The argument of the coroutine, available in co->arg.
+ *
+ ****************************************************************************/
+
+void cosched_spawn(FAR struct cosched_s *sched, FAR struct coroutine_s *co,
+                   coroutine_entry_t entry, coroutine_release_t release,
+                   FAR void *arg);
+
+/****************************************************************************
+ * Name: cosched_run
+ *
+ * Description:
+ *   Run each ready coroutine of the scheduler once, then wait up to
+ *   'timeout' milliseconds for the descriptors of the waiting coroutines
+ *   if no coroutine is ready any more.  A worker thread calls it in a loop.
+ *
+ * Input Parameters:
+ *   sched   - The scheduler to run.
+ *   timeout - The time to wait for events in milliseconds, -1 to wait
+ *             forever.
+ *
+ * Returned Value:
+ *   The number of coroutines that have not ended, zero when all ended; A
+ *   negated errno value is returned if the wait failed.
+ *
+ ****************************************************************************/
+
+int cosched_run(FAR struct cosched_s *sched, int timeout);
+
+/****************************************************************************
+ * Name: coroutine_watch
+ *
+ * Description:
+ *   Watch the descriptor 'fd' of a coroutine for 'events', used by
+ *   CO_AWAIT().  A coroutine watches one descriptor at a time.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+int coroutine_watch(FAR struct coroutine_s *co, int fd, uint32_t events);
+
+/****************************************************************************
+ * Name: coroutine_unwatch
+ *
+ * Description:
+ *   Stop watching the descriptor of a coroutine.  This must be done before
+ *   the descriptor is closed; it is done when the coroutine ends.
+ *
+ ****************************************************************************/
+
+void coroutine_unwatch(FAR struct coroutine_s *co);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_LIBC_COROUTINE */
+#endif /* __INCLUDE_NUTTX_COROUTINE_H */
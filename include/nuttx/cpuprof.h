@@ -0,0 +1,130 @@
+/****************************************************************************
+ * include/nuttx/cpuprof.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_CPUPROF_H
+#define __INCLUDE_NUTTX_CPUPROF_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef CONFIG_SCHED_CPUPROF
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The samples of one call stack of one thread on one CPU */
+
+struct cpuprof_stack_s
+{
+  FAR void *frames[CONFIG_SCHED_CPUPROF_DEPTH]; /* The call stack, innermost first */
+  int       nframes;                            /* The depth of the call stack */
+  pid_t     pid;                                /* The sampled thread */
+  uint32_t  count;                              /* The number of samples */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: cpuprof_start
+ *
+ * Description:
+ *   Start sampling all CPUs 'rate' times per second, or
+ *   CONFIG_SCHED_CPUPROF_RATE times if 'rate' is zero.  The samples are
+ *   added to the profile that is already collected.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -EINVAL if 'rate' is out of range.
+ *
+ ****************************************************************************/
+
+int cpuprof_start(unsigned int rate);
+
+/****************************************************************************
+ * Name: cpuprof_stop
+ *
+ * Description:
+ *   Stop sampling.  The profile is kept until cpuprof_reset().
+ *
+ ****************************************************************************/
+
+void cpuprof_stop(void);
+
+/****************************************************************************
+ * Name: cpuprof_getstack
+ *
+ * Description:
+ *   Get a copy of call stack 'index', from 0 to CONFIG_SCHED_CPUPROF_NSTACKS
+ *   - 1, of CPU 'cpu'.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOENT if there is no call stack at
+ *   'index' and -EINVAL if 'cpu' or 'index' is out of range.
+ *
+ ****************************************************************************/
+
+int cpuprof_getstack(int cpu, int index, FAR struct cpuprof_stack_s *stack);
+
+/****************************************************************************
+ * Name: cpuprof_dropped
+ *
+ * Description:
+ *   Return the number of samples of CPU 'cpu' that were dropped because
+ *   its table of call stacks was full.
+ *
+ ****************************************************************************/
+
+uint32_t cpuprof_dropped(int cpu);
+
+/****************************************************************************
+ * Name: cpuprof_reset
+ *
+ * Description:
+ *   Forget all call stacks.
+ *
+ ****************************************************************************/
+
+void cpuprof_reset(void);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_SCHED_CPUPROF */
+#endif /* __INCLUDE_NUTTX_CPUPROF_H */
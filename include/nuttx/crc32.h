@@ -37,6 +37,24 @@
 /* Append full suffix to avoid the penitential symbol collision */
 
 #define crc32   crc32full
+#define crc32c  crc32cfull
+
+/* CRC32C_CHECK is the CRC-32C of the string "123456789" without the null
+ * byte.
+ *
+ *   const uint8_t checkbuf[] =
+ *   {
+ *     '1', '2', '3', '4', '5', '6', '7', '8', '9'
+ *   };
+ *
+ *   assert(crc32c(checkbuf, sizeof(checkbuf)) == CRC32C_CHECK);
+ */
+
+/* CRC-32C (Castagnoli), as used by iSCSI, SCTP, ext4 and btrfs */
+
+#define CRC32C_INIT   ((uint32_t)0xffffffff)
+#define CRC32C_XOROUT ((uint32_t)0xffffffff)
+#define CRC32C_CHECK  ((uint32_t)0xe3069283)
 
 /****************************************************************************
  * Public Function Prototypes
@@ -70,6 +88,26 @@ uint32_t crc32part(FAR const uint8_t *src, size_t len, uint32_t crc32val);
 
 uint32_t crc32(FAR const uint8_t *src, size_t len);
 
+/****************************************************************************
+ * Name: crc32cpart
+ *
+ * Description:
+ *   Continue CRC-32C calculation on a part of the buffer.
+ *
+ ****************************************************************************/
+
+uint32_t crc32cpart(FAR const uint8_t *src, size_t len, uint32_t crc32val);
+
+/****************************************************************************
+ * Name: crc32c
+ *
+ * Description:
+ *   Return the CRC-32C of the contents of the 'src' buffer, length 'len'.
+ *
+ ****************************************************************************/
+
+uint32_t crc32c(FAR const uint8_t *src, size_t len);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
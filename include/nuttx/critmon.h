@@ -0,0 +1,127 @@
+/****************************************************************************
+ * include/nuttx/critmon.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_CRITMON_H
+#define __INCLUDE_NUTTX_CRITMON_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <time.h>
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Bin n counts the durations from 2^n up to 2^(n+1) perf counts, bin 0
+ * also counts the shorter ones and the last bin all the longer ones.
+ */
+
+#define CRITMON_NBINS        32
+
+/* The kinds of durations that are measured */
+
+#define CRITMON_PREEMPTION   0  /* sched_lock() until sched_unlock() */
+#define CRITMON_CSECTION     1  /* enter_critical_section() until leave */
+#define CRITMON_IRQ          2  /* Interrupt handler, needs SCHED_IRQMONITOR */
+#define CRITMON_NTYPES       3
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The durations of one kind measured for one call site on one CPU */
+
+struct critmon_site_s
+{
+  FAR void *caller;                /* Caller of sched_lock() or
+                                    * enter_critical_section(), or the
+                                    * interrupt handler */
+  uint32_t  count;                 /* The number of durations */
+  clock_t   max;                   /* The longest duration */
+  uint64_t  total;                 /* The sum of the durations */
+  uint32_t  bins[CRITMON_NBINS];   /* log2 histogram of the durations */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: critmon_getsite
+ *
+ * Description:
+ *   Get a copy of call site 'index', from 0 to
+ *   CONFIG_SCHED_CRITMONITOR_HISTOGRAM_NSITES - 1, of kind 'type' on CPU
+ *   'cpu'.  The durations are in perf counts (see up_perf_gettime()).
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOENT if there is no call site at
+ *   'index' and -EINVAL if an argument is out of range.
+ *
+ ****************************************************************************/
+
+int critmon_getsite(int cpu, int type, int index,
+                    FAR struct critmon_site_s *site);
+
+/****************************************************************************
+ * Name: critmon_dropped
+ *
+ * Description:
+ *   Return the number of durations of kind 'type' on CPU 'cpu' that were
+ *   dropped because the table of call sites was full.
+ *
+ ****************************************************************************/
+
+uint32_t critmon_dropped(int cpu, int type);
+
+/****************************************************************************
+ * Name: critmon_reset
+ *
+ * Description:
+ *   Forget all call sites.
+ *
+ ****************************************************************************/
+
+void critmon_reset(void);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_SCHED_CRITMONITOR_HISTOGRAM */
+#endif /* __INCLUDE_NUTTX_CRITMON_H */
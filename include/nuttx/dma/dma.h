@@ -194,6 +194,21 @@
 
 #define DMA_RESIDUAL(chan) (chan)->ops->residual(chan)
 
+/****************************************************************************
+ * Name: DMA_START_SG
+ *
+ * Description:
+ *   Start a scatter-gather transfer of 'nsg' segments.  Optional, use
+ *   dma_start_sg() instead:  It chains the segments in software if the
+ *   controller cannot.
+ *
+ * Note: callback get called once the last segment is transferred.
+ *
+ ****************************************************************************/
+
+#define DMA_START_SG(chan, callback, arg, sg, nsg) \
+    (chan)->ops->start_sg(chan, callback, arg, sg, nsg)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -219,6 +234,29 @@ struct dma_chan_s;
 typedef CODE void (*dma_callback_t)(FAR struct dma_chan_s *chan,
                                     FAR void *arg, ssize_t len);
 
+/* A segment of a scatter-gather transfer */
+
+struct dma_sg_s
+{
+  uintptr_t dst;                      /* The destination address */
+  uintptr_t src;                      /* The source address */
+  size_t    len;                      /* The length to transfer */
+};
+
+/* The state of a scatter-gather transfer chained in software by
+ * dma_start_sg(), owned by the client until the transfer completes.
+ */
+
+struct dma_sgxfer_s
+{
+  FAR const struct dma_sg_s *sg;      /* The segments */
+  unsigned int              nsg;      /* The number of segments */
+  unsigned int              next;     /* The next segment to start */
+  size_t                    total;    /* The bytes transferred so far */
+  dma_callback_t            callback; /* Called at the end of the transfer */
+  FAR void                 *arg;      /* The argument of the callback */
+};
+
 /* This struct is passed in as configuration data to a DMA engine
  * in order to set up a certain channel for DMA transport at runtime.
  *
@@ -305,6 +343,12 @@ struct dma_ops_s
   CODE int (*pause)(FAR struct dma_chan_s *chan);
   CODE int (*resume)(FAR struct dma_chan_s *chan);
   CODE size_t (*residual)(FAR struct dma_chan_s *chan);
+
+  /* Optional, may be NULL */
+
+  CODE int (*start_sg)(FAR struct dma_chan_s *chan,
+                       dma_callback_t callback, FAR void *arg,
+                       FAR const struct dma_sg_s *sg, unsigned int nsg);
 };
 
 /* This structure only defines the initial fields of the structure
@@ -325,4 +369,109 @@ struct dma_dev_s
                         FAR struct dma_chan_s *chan);
 };
 
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+#ifdef CONFIG_DMA
+
+/****************************************************************************
+ * Name: dma_register
+ *
+ * Description:
+ *   Register a DMA controller under a name, so that the generic drivers
+ *   find it with dma_lookup() instead of an architecture specific API.
+ *
+ * Returned Value:
+ *   Zero (OK) on success, -EEXIST if the name is taken and -ENOSPC if
+ *   CONFIG_DMA_NDEVICES controllers are registered.
+ *
+ ****************************************************************************/
+
+int dma_register(FAR const char *name, FAR struct dma_dev_s *dev);
+
+/****************************************************************************
+ * Name: dma_unregister
+ *
+ * Description:
+ *   Unregister a DMA controller.
+ *
+ ****************************************************************************/
+
+int dma_unregister(FAR struct dma_dev_s *dev);
+
+/****************************************************************************
+ * Name: dma_lookup
+ *
+ * Description:
+ *   Return the DMA controller registered under a name, NULL if there is
+ *   none.  Its channels are requested with DMA_GET_CHAN() and released
+ *   with DMA_PUT_CHAN().
+ *
+ ****************************************************************************/
+
+FAR struct dma_dev_s *dma_lookup(FAR const char *name);
+
+/****************************************************************************
+ * Name: dma_start_sg
+ *
+ * Description:
+ *   Start a scatter-gather transfer of a configured channel.  The segments
+ *   are chained in software, one transfer at a time, if the controller
+ *   does not implement start_sg().  'xfer' and 'sg' must then stay valid
+ *   until the callback, that gets the total length or the error of the
+ *   first failed segment.
+ *
+ ****************************************************************************/
+
+int dma_start_sg(FAR struct dma_chan_s *chan, FAR struct dma_sgxfer_s *xfer,
+                 FAR const struct dma_sg_s *sg, unsigned int nsg,
+                 dma_callback_t callback, FAR void *arg);
+
+/****************************************************************************
+ * Name: dma_memcpy_async
+ *
+ * Description:
+ *   Offload a copy from memory to memory to a DMA channel.  The channel is
+ *   configured for it, the source is cleaned from the data cache and the
+ *   destination is flushed:  The callback must invalidate the destination
+ *   before the data is read.
+ *
+ ****************************************************************************/
+
+int dma_memcpy_async(FAR struct dma_chan_s *chan, FAR void *dst,
+                     FAR const void *src, size_t len,
+                     dma_callback_t callback, FAR void *arg);
+
+/****************************************************************************
+ * Name: dma_memcpy
+ *
+ * Description:
+ *   Copy from memory to memory with a DMA channel and wait for the end of
+ *   the copy.
+ *
+ * Returned Value:
+ *   The number of bytes copied, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t dma_memcpy(FAR struct dma_chan_s *chan, FAR void *dst,
+                   FAR const void *src, size_t len);
+
+#endif /* CONFIG_DMA */
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
 #endif /* __INCLUDE_NUTTX_DMA_DMA_H */
@@ -0,0 +1,160 @@
+/****************************************************************************
+ * include/nuttx/drivers/drivers_async.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_DRIVERS_DRIVERS_ASYNC_H
+#define __INCLUDE_NUTTX_DRIVERS_DRIVERS_ASYNC_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Initializer of a struct drivers_probe_s:  'n' is the name in the boot
+ * timeline, 'p' and 'a' the probe function and its argument, and 'd' the
+ * probe that must complete before, or NULL.
+ */
+
+#define DRIVERS_PROBE_INITIALIZER(n, p, a, d) \
+  { \
+    NULL, (n), (p), (a), (d) \
+  }
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* A probe of a device that may run on the threads of asynchronous probes,
+ * or when the device is first opened.  The storage of the probe must stay
+ * valid, it is kept for the boot timeline.
+ */
+
+struct drivers_probe_s
+{
+  FAR struct drivers_probe_s *flink;  /* Internal list link */
+  FAR const char             *name;   /* Name in the boot timeline */
+  CODE int                  (*probe)(FAR void *arg);
+  FAR void                   *arg;    /* Argument of probe() */
+  FAR struct drivers_probe_s *after;  /* Probe to complete before, or NULL */
+  unsigned long               start;  /* Time since boot in microseconds */
+  unsigned long               end;    /* Time since boot in microseconds */
+  int                         result; /* The value returned by probe() */
+  uint8_t                     state;  /* Internal state */
+  uint8_t                     cpu;    /* The CPU that ran probe() */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+#ifdef CONFIG_DRIVERS_ASYNC_INIT
+
+/****************************************************************************
+ * Name: drivers_async_probe
+ *
+ * Description:
+ *   Queue a probe to run on the threads of asynchronous probes, once the
+ *   probe that it depends on has completed.  The probes can be queued from
+ *   drivers_initialize(), board_early_initialize() and
+ *   board_late_initialize(); once the init task was started, the probe
+ *   runs before drivers_async_probe() returns.
+ *
+ *   The dependencies of the probes must not form a cycle.  A dependency
+ *   that is never queued is ignored.
+ *
+ ****************************************************************************/
+
+void drivers_async_probe(FAR struct drivers_probe_s *probe);
+
+/****************************************************************************
+ * Name: drivers_async_start
+ *
+ * Description:
+ *   Start the threads of asynchronous probes.  Called by nx_bringup().
+ *
+ ****************************************************************************/
+
+void drivers_async_start(void);
+
+/****************************************************************************
+ * Name: drivers_async_wait
+ *
+ * Description:
+ *   Wait for all queued probes to complete and print the boot timeline.
+ *   Called before the init task is started.
+ *
+ ****************************************************************************/
+
+void drivers_async_wait(void);
+
+/****************************************************************************
+ * Name: register_deferred_driver
+ *
+ * Description:
+ *   Register a character driver, like register_driver(), whose probe only
+ *   runs when the driver is first opened.  The driver is opened once the
+ *   probe succeeds; a failed probe fails the open and runs again at the
+ *   next open.
+ *
+ ****************************************************************************/
+
+int register_deferred_driver(FAR const char *path,
+                             FAR const struct file_operations *fops,
+                             mode_t mode, FAR void *priv,
+                             FAR struct drivers_probe_s *probe);
+
+#else
+
+#  define drivers_async_probe(p)  ((void)(p)->probe((p)->arg))
+#  define drivers_async_start()
+#  define drivers_async_wait()
+#  define register_deferred_driver(path, fops, mode, priv, p) \
+     ((p)->probe((p)->arg) < 0 ? -ENODEV : \
+      register_driver(path, fops, mode, priv))
+
+#endif /* CONFIG_DRIVERS_ASYNC_INIT */
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_DRIVERS_DRIVERS_ASYNC_H */
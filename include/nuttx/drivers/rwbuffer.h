@@ -31,6 +31,7 @@
 
 #include <sys/types.h>
 #include <stdint.h>
+#include <time.h>
 
 #include <nuttx/mutex.h>
 #include <nuttx/wqueue.h>
@@ -41,6 +42,12 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* The number of independent write and read-ahead buffers of a device */
+
+#ifndef CONFIG_DRVR_NSTREAMS
+#  define CONFIG_DRVR_NSTREAMS 1
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -55,6 +62,39 @@ typedef CODE ssize_t (*rwbreload_t)(FAR void *dev, FAR uint8_t *buffer,
 typedef CODE ssize_t (*rwbflush_t)(FAR void *dev, FAR const uint8_t *buffer,
                                    off_t startblock, size_t nblocks);
 
+/* The state of one write buffer.  Each sequential stream of writes fills
+ * its own buffer, the buffer written the longest time ago is flushed when
+ * a new stream needs one.
+ */
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+struct rwb_wrstream_s
+{
+  FAR uint8_t  *buffer;          /* The blocks of the buffer */
+  off_t         blockstart;      /* First block in the buffer */
+  uint16_t      nblocks;         /* Number of blocks in the buffer */
+  clock_t       stamp;           /* Time of the last write to the buffer */
+};
+#endif
+
+/* The state of one read-ahead buffer.  A read that continues where a
+ * stream stopped doubles the read-ahead of the stream, up to rhmaxblocks,
+ * any other miss reloads the least recently used buffer with just the
+ * blocks read.
+ */
+
+#ifdef CONFIG_DRVR_READAHEAD
+struct rwb_rhstream_s
+{
+  FAR uint8_t  *buffer;          /* The blocks of the buffer */
+  off_t         blockstart;      /* First block in the buffer */
+  off_t         next;            /* The block after the last one read */
+  uint16_t      nblocks;         /* Number of blocks in the buffer */
+  uint16_t      window;          /* Number of blocks of the last reload */
+  uint32_t      stamp;           /* Order of the last read from the buffer */
+};
+#endif
+
 /* This structure holds the state of the buffers.  In typical usage,
  * an instance of this structure is declared within each block driver
  * status structure like:
@@ -99,13 +139,13 @@ struct rwbuffer_s
    */
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-  uint16_t      wrmaxblocks;     /* The number of blocks to buffer in memory */
+  uint16_t      wrmaxblocks;     /* The number of blocks of each write buffer */
   uint16_t      wralignblocks;   /* The buffer to be flash is always multiplied by this
                                   * number. It must be 0 or divisible by wrmaxblocks.
                                   */
 #endif
 #ifdef CONFIG_DRVR_READAHEAD
-  uint16_t      rhmaxblocks;     /* The number of blocks to buffer in memory */
+  uint16_t      rhmaxblocks;     /* The number of blocks of each read-ahead buffer */
 #endif
 
   /* Callback functions.
@@ -129,20 +169,19 @@ struct rwbuffer_s
   /* This is the state of the write buffering */
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-  mutex_t       wrlock;          /* Enforces exclusive access to the write buffer */
-  struct work_s work;            /* Delayed work to flush buffer after a delay with no activity */
-  FAR uint8_t  *wrbuffer;        /* Allocated write buffer */
-  uint16_t      wrnblocks;       /* Number of blocks in write buffer */
-  off_t         wrblockstart;    /* First block in write buffer */
+  mutex_t       wrlock;          /* Enforces exclusive access to the write buffers */
+  struct work_s work;            /* Delayed work to flush the buffers with no activity */
+  FAR uint8_t  *wrbuffer;        /* Allocated write buffers */
+  struct rwb_wrstream_s wrstream[CONFIG_DRVR_NSTREAMS];
 #endif
 
   /* This is the state of the read-ahead buffering */
 
 #ifdef CONFIG_DRVR_READAHEAD
-  mutex_t       rhlock;          /* Enforces exclusive access to the read-ahead buffer */
-  FAR uint8_t  *rhbuffer;        /* Allocated read-ahead buffer */
-  uint16_t      rhnblocks;       /* Number of blocks in read-ahead buffer */
-  off_t         rhblockstart;    /* First block in read-ahead buffer */
+  mutex_t       rhlock;          /* Enforces exclusive access to the read-ahead buffers */
+  FAR uint8_t  *rhbuffer;        /* Allocated read-ahead buffers */
+  uint32_t      rhstamp;         /* Counter of the reads from the buffers */
+  struct rwb_rhstream_s rhstream[CONFIG_DRVR_NSTREAMS];
 #endif
 };
 
@@ -181,6 +181,7 @@ struct inode;
 struct stat;
 struct statfs;
 struct pollfd;
+struct iovec;
 struct mtd_dev_s;
 struct tcb_s;
 
@@ -239,6 +240,16 @@ struct file_operations
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   CODE int     (*unlink)(FAR struct inode *inode);
 #endif
+
+  /* Vectored I/O at the file position, so that a scatter-gather request
+   * reaches the driver at once.  Without them, the VFS reads or writes the
+   * elements one after the other.
+   */
+
+  CODE ssize_t (*readv)(FAR struct file *filep, FAR const struct iovec *iov,
+                        int iovcnt);
+  CODE ssize_t (*writev)(FAR struct file *filep,
+                         FAR const struct iovec *iov, int iovcnt);
 };
 
 /* This structure provides information about the state of a block driver */
@@ -271,6 +282,30 @@ struct partition_info_s
   char      parent[NAME_MAX + 1];
 };
 
+/* A range of sectors of a block device, the argument of the BIOC_DISCARD
+ * and BIOC_ZEROOUT ioctl commands.
+ */
+
+struct blk_range_s
+{
+  blkcnt_t  start;        /* The first sector of the range */
+  blkcnt_t  nsectors;     /* Number of sectors in the range */
+};
+
+/* The extent of the data of a file on the block driver of its volume, the
+ * argument of the FIOC_EXTENT ioctl command.  The file system does not
+ * cache the data of the extent, which may then be accessed on the driver
+ * directly while the file is open:  The driver stays open with the volume.
+ */
+
+struct file_extent_s
+{
+  off_t             offset;     /* IN:  The offset in the file */
+  FAR struct inode *blkdriver;  /* OUT: The block driver of the volume */
+  off_t             devoffset;  /* OUT: The offset (in bytes) on the driver */
+  off_t             length;     /* OUT: The contiguous length (in bytes) */
+};
+
 /* This structure is provided by block devices when they register with the
  * system.  It is used by file systems to perform filesystem transfers.  It
  * differs from the normal driver vtable in several ways -- most notably in
@@ -376,6 +411,20 @@ struct mountpt_operations
   CODE int     (*chstat)(FAR struct inode *mountpt, FAR const char *relpath,
                          FAR const struct stat *buf, int flags);
   CODE int     (*syncfs)(FAR struct inode *mountpt);
+
+  /* Return an identifier of an open file, unique in the volume.  The file
+   * system must keep the file position in f_pos only.  The page cache then
+   * caches the regular files of the volume.
+   */
+
+  CODE int     (*fileid)(FAR struct file *filep, FAR ino_t *id);
+
+  /* Vectored I/O at the file position, as for struct file_operations */
+
+  CODE ssize_t (*readv)(FAR struct file *filep, FAR const struct iovec *iov,
+                        int iovcnt);
+  CODE ssize_t (*writev)(FAR struct file *filep,
+                         FAR const struct iovec *iov, int iovcnt);
 };
 #endif /* CONFIG_DISABLE_MOUNTPOINT */
 
@@ -467,6 +516,10 @@ typedef struct cookie_io_functions_t
   FAR cookie_close_function_t *close;
 } cookie_io_functions_t;
 
+/* Gives back the data of a file lent by file_getdata() */
+
+typedef CODE void (*file_putdata_t)(FAR void *base);
+
 /* This is the underlying representation of an open file.  A file
  * descriptor is an index into an array of such types. The type associates
  * the file descriptor to the file state and to a set of inode operations.
@@ -476,7 +529,7 @@ struct file
 {
   int               f_oflags;   /* Open mode flags */
 #ifdef CONFIG_FS_REFCOUNT
-  int               f_refs;     /* Reference count */
+  atomic_int        f_refs;     /* Reference count */
 #endif
   off_t             f_pos;      /* File position */
   FAR struct inode *f_inode;    /* Driver or file system interface */
@@ -503,6 +556,10 @@ struct file
  * You can get file instance in filelist by the follow methods:
  * (file descriptor / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK) as row index and
  * (file descriptor % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK) as column index.
+ *
+ * The descriptors are looked up without a lock:  The rows are never freed
+ * while the list is used, nor the tables of rows replaced when the list
+ * grows (fl_retired).
  */
 
 struct filelist
@@ -510,6 +567,7 @@ struct filelist
   uint8_t           fl_rows;    /* The number of rows of fl_files array */
   uint8_t           fl_crefs;   /* The references to filelist */
   FAR struct file **fl_files;   /* The pointer of two layer file descriptors array */
+  FAR struct file **fl_retired; /* The replaced tables, freed with the list */
 
   /* Pre-allocated files to avoid allocator access during thread creation
    * phase, For functional safety requirements, increase
@@ -1522,6 +1580,51 @@ ssize_t file_pread(FAR struct file *filep, FAR void *buf, size_t nbytes,
 ssize_t file_pwrite(FAR struct file *filep, FAR const void *buf,
                     size_t nbytes, off_t offset);
 
+/****************************************************************************
+ * Name: file_readv, file_writev, file_preadv and file_pwritev
+ *
+ * Description:
+ *   Equivalent to the standard readv, writev, preadv and pwritev functions
+ *   except that they accept a struct file instance instead of a file
+ *   descriptor, do not modify the errno variable and are not cancellation
+ *   points.
+ *
+ * Returned Value:
+ *   The number of bytes transferred, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t file_readv(FAR struct file *filep, FAR const struct iovec *iov,
+                   int iovcnt);
+ssize_t file_writev(FAR struct file *filep, FAR const struct iovec *iov,
+                    int iovcnt);
+ssize_t file_preadv(FAR struct file *filep, FAR const struct iovec *iov,
+                    int iovcnt, off_t offset);
+ssize_t file_pwritev(FAR struct file *filep, FAR const struct iovec *iov,
+                     int iovcnt, off_t offset);
+
+/****************************************************************************
+ * Name: file_getdata
+ *
+ * Description:
+ *   Lend the data of a file at 'offset' without copying it, if the data is
+ *   in the memory of an execute-in-place file system that cannot modify it
+ *   (romfs in flash), or in the page cache.  The data is at 'skip' bytes
+ *   from '*base' and stays valid until 'putdata' is called with '*base';
+ *   'putdata' may be called from an interrupt handler.  The position of
+ *   the file is not changed.
+ *
+ * Returned Value:
+ *   The number of bytes lent, possibly less than 'nbytes', zero at the end
+ *   of the file, -ENOSYS if the data of the file cannot be lent, or another
+ *   negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t file_getdata(FAR struct file *filep, off_t offset, size_t nbytes,
+                     FAR void **base, FAR size_t *skip,
+                     FAR file_putdata_t *putdata);
+
 /****************************************************************************
  * Name: file_sendfile
  *
@@ -1534,6 +1637,31 @@ ssize_t file_pwrite(FAR struct file *filep, FAR const void *buf,
 ssize_t file_sendfile(FAR struct file *outfile, FAR struct file *infile,
                       FAR off_t *offset, size_t count);
 
+/****************************************************************************
+ * Name: file_splice
+ *
+ * Description:
+ *   Equivalent to the standard splice function except that is accepts
+ *   struct file instances instead of file descriptors.
+ *
+ ****************************************************************************/
+
+ssize_t file_splice(FAR struct file *infile, FAR off_t *inoffset,
+                    FAR struct file *outfile, FAR off_t *outoffset,
+                    size_t len, unsigned int flags);
+
+/****************************************************************************
+ * Name: file_tee
+ *
+ * Description:
+ *   Equivalent to the standard tee function except that is accepts struct
+ *   file instances instead of file descriptors.
+ *
+ ****************************************************************************/
+
+ssize_t file_tee(FAR struct file *infile, FAR struct file *outfile,
+                 size_t len, unsigned int flags);
+
 /****************************************************************************
  * Name: file_seek
  *
@@ -1684,6 +1812,31 @@ int file_fcntl(FAR struct file *filep, int cmd, ...);
 
 int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup);
 
+/****************************************************************************
+ * Name: poll_cache_forget
+ *
+ * Description:
+ *   Tear down the cached polls of a file and drop their references, before
+ *   its descriptor is closed or replaced.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_POLL_CACHE
+void poll_cache_forget(FAR struct file *filep);
+#endif
+
+/****************************************************************************
+ * Name: poll_cache_release
+ *
+ * Description:
+ *   Tear down and free the poll cache of an exiting thread.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_POLL_CACHE
+void poll_cache_release(FAR struct tcb_s *tcb);
+#endif
+
 /****************************************************************************
  * Name: file_fstat
  *
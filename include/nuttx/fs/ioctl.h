@@ -107,6 +107,7 @@
 #define _PINCTRLBASE    (0x4000) /* Pinctrl driver ioctl commands */
 #define _PCIBASE        (0x4100) /* Pci ioctl commands */
 #define _I3CBASE        (0x4200) /* I3C driver ioctl commands */
+#define _PERFBASE       (0x4300) /* Perf event ioctl commands */
 #define _WLIOCBASE      (0x8b00) /* Wireless modules ioctl network commands */
 
 /* boardctl() commands share the same number space */
@@ -232,6 +233,18 @@
 #define FIOC_XIPBASE        _FIOC(0x0015) /* IN:  uinptr_t *
                                            * OUT: Current file xip base address
                                            */
+#define FIOC_EXTENT         _FIOC(0x0016) /* IN:  Pointer to struct
+                                           *      file_extent_s with the
+                                           *      file offset
+                                           * OUT: The extent of the data at
+                                           *      that offset on the block
+                                           *      driver of the volume
+                                           */
+#define FIOC_SETTHRESHOLD   _FIOC(0x0017) /* IN:  FAR const eventfd_t *, the
+                                           *      counter an eventfd must
+                                           *      reach to be readable
+                                           * OUT: None
+                                           */
 
 /* NuttX file system ioctl definitions **************************************/
 
@@ -346,6 +359,29 @@
                                            *      to return sector numbers.
                                            * OUT: Data return in user-provided
                                            *      buffer. */
+#define BIOC_COLLECT    _BIOC(0x0011)     /* Reclaim the released sectors of one
+                                           * erase block of a SMART flash device
+                                           * ahead of need.
+                                           * IN:  The number of free sectors
+                                           *      wanted.
+                                           * OUT: 1 if more sectors are to be
+                                           *      reclaimed, 0 if not, or error */
+#define BIOC_DISCARD    _BIOC(0x0012)     /* Tell the device that the data of a
+                                           * range of sectors is not used
+                                           * anymore (TRIM/UNMAP).
+                                           * IN:  Pointer to a struct
+                                           *      blk_range_s.
+                                           * OUT: None (ioctl return value
+                                           *      provides success/failure
+                                           *      indication). */
+#define BIOC_ZEROOUT    _BIOC(0x0013)     /* Write zeroes to a range of
+                                           * sectors without transferring
+                                           * them.
+                                           * IN:  Pointer to a struct
+                                           *      blk_range_s.
+                                           * OUT: None (ioctl return value
+                                           *      provides success/failure
+                                           *      indication). */
 
 /* NuttX MTD driver ioctl definitions ***************************************/
 
@@ -501,6 +537,25 @@
                                                * IN: None
                                                * OUT: int */
 
+#define PIPEIOC_SPLICEOUT   _PIPEIOC(0x0007)  /* Move data from the pipe
+                                               * to another file.  Kernel
+                                               * only, see file_splice()
+                                               * IN: pipe_splice_s
+                                               * OUT: Length of data */
+
+#define PIPEIOC_SPLICEIN    _PIPEIOC(0x0008)  /* Move data from another
+                                               * file to the pipe.  Kernel
+                                               * only, see file_splice()
+                                               * IN: pipe_splice_s
+                                               * OUT: Length of data */
+
+#define PIPEIOC_TEE         _PIPEIOC(0x0009)  /* Copy data from the pipe
+                                               * to another pipe without
+                                               * consuming it.  Kernel
+                                               * only, see file_tee()
+                                               * IN: pipe_splice_s
+                                               * OUT: Length of data */
+
 /* RTC driver ioctl definitions *********************************************/
 
 /* (see nuttx/include/rtc.h */
@@ -740,6 +795,13 @@
 #define _I3CIOCVALID(c)   (_IOC_TYPE(c)==_I3CBASE)
 #define _I3CIOC(nr)       _IOC(_I3CBASE,nr)
 
+/* Perf event ioctl definitions *********************************************/
+
+/* see nuttx/include/nuttx/perf.h */
+
+#define _PERFIOCVALID(c)  (_IOC_TYPE(c)==_PERFBASE)
+#define _PERFIOC(nr)      _IOC(_PERFBASE,nr)
+
 /* Force Feedback driver command definitions ********************************/
 
 /* see nuttx/include/input/ff.h */
@@ -765,6 +827,15 @@ struct pipe_peek_s
   size_t size;
 };
 
+struct file;
+struct pipe_splice_s
+{
+  FAR struct file *filep;   /* The other side of the transfer */
+  FAR off_t *offset;        /* Its offset, NULL for its file position */
+  size_t len;               /* The maximum length of data */
+  unsigned int flags;       /* SPLICE_F_* flags */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -0,0 +1,358 @@
+/****************************************************************************
+ * include/nuttx/fs/ioring.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_FS_IORING_H
+#define __INCLUDE_NUTTX_FS_IORING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <nuttx/queue.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+
+#ifdef CONFIG_FS_AIO
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Operation codes of the submission queue entries */
+
+#define IORING_OP_NOP       0  /* Complete with 0 */
+#define IORING_OP_READ      1  /* read(), or pread() if off >= 0 */
+#define IORING_OP_WRITE     2  /* write(), or pwrite() if off >= 0 */
+#define IORING_OP_FSYNC     3  /* fsync() */
+#define IORING_OP_POLL      4  /* Wait for the poll events in op_flags */
+#define IORING_OP_ACCEPT    5  /* accept4(), addr2 is the socklen_t * */
+#define IORING_OP_SEND      6  /* send() with the flags in op_flags */
+#define IORING_OP_RECV      7  /* recv() with the flags in op_flags */
+
+/* Flags of the submission queue entries */
+
+#define IOSQE_ORDERED       (1 << 0) /* Start only once the earlier ordered
+                                      * requests of the same file are
+                                      * complete */
+
+/* Flags of ioring_setup() */
+
+#define IORING_SETUP_CQPOLL (1 << 0) /* The completions are polled with
+                                      * ioring_peek_cqe(): Nobody is woken
+                                      * up when a request completes. */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* A request submitted by the application */
+
+struct ioring_sqe_s
+{
+  uint8_t   opcode;                /* IORING_OP_* */
+  uint8_t   flags;                 /* IOSQE_* */
+  int       fd;                    /* The file or socket descriptor */
+  off_t     off;                   /* The file offset, -1 for the current
+                                    * file position */
+  FAR void *addr;                  /* The buffer, struct sockaddr * for
+                                    * IORING_OP_ACCEPT */
+  FAR void *addr2;                 /* socklen_t * for IORING_OP_ACCEPT */
+  size_t    len;                   /* The length of the buffer */
+  uint32_t  op_flags;              /* Poll events, or socket flags */
+  FAR void *user_data;             /* Returned in the completion entry */
+};
+
+/* The completion of a request */
+
+struct ioring_cqe_s
+{
+  FAR void *user_data;             /* user_data of the request */
+  ssize_t   res;                   /* The result, as returned by the
+                                    * kernel interface of the operation */
+};
+
+/* A request in progress.  The requests of a ring come from a pool of the
+ * ring;  Kernel users may instead embed a request in their own structures
+ * and queue it with ioring_queue(), with a completion callback that then
+ * owns the reference to the file.  The worker threads take the requests by
+ * decreasing priority and run each at its priority.
+ */
+
+struct ioring_s;
+struct ioring_req_s;
+struct file;
+
+typedef CODE void (*ioring_complete_t)(FAR struct ioring_req_s *req,
+                                       ssize_t res);
+
+struct ioring_req_s
+{
+  dq_entry_t          node;        /* In the pending or free queue */
+  FAR struct ioring_s *ring;       /* The ring of the request, or NULL */
+  FAR struct file    *filep;       /* The file of the operation */
+  ioring_complete_t   complete;    /* Called instead of posting a CQE */
+  struct ioring_sqe_s sqe;         /* A copy of the submitted entry */
+  struct pollfd       fds;         /* For IORING_OP_POLL */
+  pid_t               pid;         /* The submitter (for accept) */
+  uint8_t             prio;        /* The priority of the operation */
+  uint8_t             state;       /* Private to fs/aio/aio_ioring.c */
+};
+
+/* A submission and a completion ring in the memory shared by the
+ * application and the kernel.  The application produces the entries of
+ * the submission queue and consumes those of the completion queue:  It
+ * owns sq_tail and cq_head, the kernel owns sq_head and cq_tail.  The
+ * indexes are free running and wrap with the masks.
+ */
+
+struct ioring_s
+{
+  /* Submission queue */
+
+  volatile uint32_t   sq_head;
+  volatile uint32_t   sq_tail;
+  uint32_t            sq_mask;
+  FAR struct ioring_sqe_s *sqes;
+
+  /* Completion queue, twice as large as the submission queue */
+
+  volatile uint32_t   cq_head;
+  volatile uint32_t   cq_tail;
+  uint32_t            cq_mask;
+  FAR struct ioring_cqe_s *cqes;
+
+  uint32_t            flags;       /* IORING_SETUP_* */
+
+  /* Private to the kernel */
+
+  spinlock_t          lock;        /* Protects the fields below */
+  sem_t               cqsem;       /* Waiters for a completion */
+  uint16_t            cqwaiters;   /* Number of waiters on cqsem */
+  uint32_t            inflight;    /* Requests not yet completed */
+  dq_queue_t          freereqs;    /* The unused requests of the pool */
+  FAR struct ioring_req_s *reqs;   /* The pool of requests */
+};
+
+/* The statistics of the worker threads, returned by ioring_getstats() */
+
+struct ioring_stats_s
+{
+  uint32_t            nthreads;    /* Worker threads started */
+  uint32_t            nidle;       /* Worker threads waiting for requests */
+  uint32_t            npending;    /* Requests waiting for a worker thread */
+  uint32_t            maxpending;  /* The largest npending so far */
+  uint32_t            nrunning;    /* Requests executed at the moment */
+  uint32_t            nqueued;     /* Requests queued so far */
+};
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ioring_get_sqe
+ *
+ * Description:
+ *   Return the next free entry of the submission queue, NULL if the queue
+ *   is full.  The entry is submitted by the next ioring_submit().
+ *
+ ****************************************************************************/
+
+static inline_function FAR struct ioring_sqe_s *
+ioring_get_sqe(FAR struct ioring_s *ring)
+{
+  FAR struct ioring_sqe_s *sqe;
+
+  if (ring->sq_tail - ring->sq_head > ring->sq_mask)
+    {
+      return NULL;
+    }
+
+  sqe = &ring->sqes[ring->sq_tail & ring->sq_mask];
+  ring->sq_tail++;
+  return sqe;
+}
+
+/****************************************************************************
+ * Name: ioring_peek_cqe
+ *
+ * Description:
+ *   Return the oldest entry of the completion queue without waiting, NULL
+ *   if there is none.  The entry must be released with ioring_cqe_seen().
+ *
+ ****************************************************************************/
+
+static inline_function FAR struct ioring_cqe_s *
+ioring_peek_cqe(FAR struct ioring_s *ring)
+{
+  if (ring->cq_head == ring->cq_tail)
+    {
+      return NULL;
+    }
+
+  /* Read the entry only after its index */
+
+  SP_DMB();
+  return &ring->cqes[ring->cq_head & ring->cq_mask];
+}
+
+/****************************************************************************
+ * Name: ioring_cqe_seen
+ *
+ * Description:
+ *   Release the oldest entry of the completion queue.
+ *
+ ****************************************************************************/
+
+static inline_function void ioring_cqe_seen(FAR struct ioring_s *ring)
+{
+  SP_DMB();
+  ring->cq_head++;
+}
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: ioring_setup
+ *
+ * Description:
+ *   Allocate the queues of a ring.  'entries' is rounded up to a power of
+ *   two.
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int ioring_setup(FAR struct ioring_s *ring, unsigned int entries,
+                 uint32_t flags);
+
+/****************************************************************************
+ * Name: ioring_teardown
+ *
+ * Description:
+ *   Release the queues of a ring.
+ *
+ * Returned Value:
+ *   Zero (OK) on success, -EBUSY if requests are still in progress.
+ *
+ ****************************************************************************/
+
+int ioring_teardown(FAR struct ioring_s *ring);
+
+/****************************************************************************
+ * Name: ioring_submit
+ *
+ * Description:
+ *   Submit all the entries added to the submission queue since the last
+ *   call, in a single batch.  The descriptors are resolved in the context
+ *   of the caller.  An entry with a bad descriptor completes at once.
+ *
+ * Returned Value:
+ *   The number of entries consumed, a negated errno value on failure.
+ *   Fewer entries than queued are consumed if the completion queue could
+ *   overflow.
+ *
+ ****************************************************************************/
+
+int ioring_submit(FAR struct ioring_s *ring);
+
+/****************************************************************************
+ * Name: ioring_wait_cqe
+ *
+ * Description:
+ *   Wait for an entry in the completion queue of a ring and return the
+ *   oldest one.  The entry must be released with ioring_cqe_seen().
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.  -EINVAL is
+ *   returned if the completions of the ring are polled.
+ *
+ ****************************************************************************/
+
+int ioring_wait_cqe(FAR struct ioring_s *ring,
+                    FAR struct ioring_cqe_s **cqe);
+
+/****************************************************************************
+ * Name: ioring_queue
+ *
+ * Description:
+ *   Queue the 'nreqs' requests of 'reqs' to the worker threads at once.
+ *   A request queued by the kernel has no ring and a completion callback.
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value if no worker thread could
+ *   be started.  The requests are not queued on failure.
+ *
+ ****************************************************************************/
+
+int ioring_queue(FAR dq_queue_t *reqs, unsigned int nreqs);
+
+/****************************************************************************
+ * Name: ioring_cancel
+ *
+ * Description:
+ *   Cancel a queued request that did not start.  The request is not
+ *   completed and the caller owns it again.
+ *
+ * Returned Value:
+ *   Zero (OK) if the request is canceled, -EBUSY if it is in progress.
+ *
+ ****************************************************************************/
+
+int ioring_cancel(FAR struct ioring_req_s *req);
+
+/****************************************************************************
+ * Name: ioring_getstats
+ *
+ * Description:
+ *   Return the statistics of the worker threads.
+ *
+ ****************************************************************************/
+
+void ioring_getstats(FAR struct ioring_stats_s *stats);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_FS_AIO */
+#endif /* __INCLUDE_NUTTX_FS_IORING_H */
@@ -0,0 +1,113 @@
+/****************************************************************************
+ * include/nuttx/futex.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_FUTEX_H
+#define __INCLUDE_NUTTX_FUTEX_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <time.h>
+
+#ifdef CONFIG_FUTEX
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: nxfutex_wait
+ *
+ * Description:
+ *   Block the calling thread until the 32-bit word at 'addr' is signalled
+ *   by nxfutex_wake().  The thread is only blocked if the word still holds
+ *   the value 'val'.  The check and the blocking are atomic with respect
+ *   to nxfutex_wake() so a wake up between the caller's last check of the
+ *   word and the call cannot be lost.
+ *
+ *   In builds with address environments the word is identified by its
+ *   virtual address in the address environment of the caller.  Otherwise
+ *   the same word may be shared by any tasks.
+ *
+ * Input Parameters:
+ *   addr    - The address of the futex word.  Must be 32-bit aligned.
+ *   val     - The value that the futex word is expected to hold.
+ *   clockid - The clock to be used as the time base of abstime
+ *   abstime - The absolute time to wait until, or NULL to wait forever.
+ *
+ * Returned Value:
+ *   This is an internal OS interface and should not be used by applications.
+ *   It follows the NuttX internal error return policy:  Zero (OK) is
+ *   returned when the thread was woken up.  A negated errno value is
+ *   returned on failure:
+ *
+ *     EINVAL    - addr is NULL or not aligned.
+ *     EAGAIN    - The futex word did not hold val.
+ *     ETIMEDOUT - abstime has passed before the thread was woken up.
+ *     EINTR     - The wait was interrupted by the receipt of a signal.
+ *
+ ****************************************************************************/
+
+int nxfutex_wait(FAR volatile uint32_t *addr, uint32_t val,
+                 clockid_t clockid, FAR const struct timespec *abstime);
+
+/****************************************************************************
+ * Name: nxfutex_wake
+ *
+ * Description:
+ *   Wake up at most 'nwake' of the threads that are waiting in
+ *   nxfutex_wait() on the futex word at 'addr'.  Threads are woken up in
+ *   the order of their priority.
+ *
+ * Input Parameters:
+ *   addr  - The address of the futex word.
+ *   nwake - The maximum number of threads to wake up.
+ *
+ * Returned Value:
+ *   The number of threads that were woken up or a negated errno value on
+ *   failure:
+ *
+ *     EINVAL - addr is NULL or not aligned or nwake is negative.
+ *
+ ****************************************************************************/
+
+int nxfutex_wake(FAR volatile uint32_t *addr, int nwake);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_FUTEX */
+#endif /* __INCLUDE_NUTTX_FUTEX_H */
@@ -82,6 +82,11 @@
 #define hashtable_for_every_possible_safe(table, item, temp, key) \
   sq_for_every_safe(&table[HASH(key, hashtable_bits(table))], item, temp)
 
+/* Return the bucket of a key, to resume an iteration from an item. */
+
+#define hashtable_bucket(table, key) \
+  (&(table)[HASH(key, hashtable_bits(table))])
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
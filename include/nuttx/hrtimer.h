@@ -0,0 +1,191 @@
+/****************************************************************************
+ * include/nuttx/hrtimer.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_HRTIMER_H
+#define __INCLUDE_NUTTX_HRTIMER_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <nuttx/compiler.h>
+#include <sys/tree.h>
+#include <stdint.h>
+
+#ifdef CONFIG_HRTIMER
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define HRTIMER_ISACTIVE(h)  ((h)->func != NULL)
+
+/****************************************************************************
+ * Public Type Declarations
+ ****************************************************************************/
+
+struct hrtimer_s;
+
+/* This is the form of the function that is called when the hrtimer
+ * expires.  'expired' is the time at which the timer was due, in
+ * nanoseconds of CLOCK_MONOTONIC.  If the function returns a non-zero
+ * value, the timer is restarted to expire that many nanoseconds after
+ * 'expired'.  Returning zero stops the timer.
+ */
+
+typedef CODE uint64_t (*hrtimer_entry_t)(FAR struct hrtimer_s *hrtimer,
+                                         uint64_t expired);
+
+/* Interpretation of the time passed to hrtimer_start() */
+
+enum hrtimer_mode_e
+{
+  HRTIMER_MODE_ABS = 0,          /* Absolute time of CLOCK_MONOTONIC */
+  HRTIMER_MODE_REL               /* Relative to the current time */
+};
+
+/* This is the internal representation of the hrtimer structure.  It is
+ * allocated by the caller and must remain valid as long as the timer may
+ * be active.
+ */
+
+struct hrtimer_s
+{
+  RB_ENTRY(hrtimer_s) node;      /* Supports the red-black tree */
+  hrtimer_entry_t     func;      /* Function to execute when time expires */
+  FAR void           *arg;       /* Callback argument */
+  uint64_t            expired;   /* Absolute expiration time (ns) */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: hrtimer_start
+ *
+ * Description:
+ *   Start (or restart) an hrtimer.  The function 'func' will be called from
+ *   the interrupt context of the oneshot timer once CLOCK_MONOTONIC reaches
+ *   the expiration time.  A time in the past makes the timer expire as
+ *   soon as possible.
+ *
+ * Input Parameters:
+ *   hrtimer - The hrtimer to start
+ *   func    - The function to call on expiration
+ *   arg     - Argument available to 'func' through hrtimer->arg
+ *   ns      - The expiration time in nanoseconds
+ *   mode    - HRTIMER_MODE_ABS if 'ns' is an absolute time of
+ *             CLOCK_MONOTONIC, HRTIMER_MODE_REL if 'ns' is relative to
+ *             the current time.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   failure.
+ *
+ * Assumptions:
+ *   May be called from interrupt level handling or from the normal tasking
+ *   level.
+ *
+ ****************************************************************************/
+
+int hrtimer_start(FAR struct hrtimer_s *hrtimer, hrtimer_entry_t func,
+                  FAR void *arg, uint64_t ns, enum hrtimer_mode_e mode);
+
+/****************************************************************************
+ * Name: hrtimer_cancel
+ *
+ * Description:
+ *   Stop an hrtimer.  A periodic timer whose callback is running on
+ *   another CPU is not restarted once that callback returns.
+ *
+ * Input Parameters:
+ *   hrtimer - The hrtimer to cancel
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -EINVAL is returned if the timer was
+ *   not active.
+ *
+ ****************************************************************************/
+
+int hrtimer_cancel(FAR struct hrtimer_s *hrtimer);
+
+/****************************************************************************
+ * Name: hrtimer_gettime
+ *
+ * Description:
+ *   Return the time remaining before an hrtimer expires.
+ *
+ * Input Parameters:
+ *   hrtimer - The hrtimer to query
+ *
+ * Returned Value:
+ *   The remaining time in nanoseconds.  Zero is returned if the timer is
+ *   not active or is already due.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_gettime(FAR struct hrtimer_s *hrtimer);
+
+/****************************************************************************
+ * Name: hrtimer_getnext
+ *
+ * Description:
+ *   Return the time remaining before the next hrtimer expires, for example
+ *   to choose how deep to sleep when idle.
+ *
+ * Returned Value:
+ *   The remaining time in nanoseconds.  Zero is returned if an hrtimer is
+ *   already due, UINT64_MAX if no hrtimer is active.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_getnext(void);
+
+/****************************************************************************
+ * Name: hrtimer_now
+ *
+ * Description:
+ *   Return the current time of CLOCK_MONOTONIC in nanoseconds, as seen by
+ *   the hrtimer subsystem.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_now(void);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_HRTIMER */
+#endif /* __INCLUDE_NUTTX_HRTIMER_H */
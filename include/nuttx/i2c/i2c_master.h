@@ -205,6 +205,36 @@
 
 #define I2C_SHUTDOWN(d) ((d)->ops->shutdown(d))
 
+/****************************************************************************
+ * Name: I2C_TRANSFER_ASYNC
+ *
+ * Description:
+ *   Start a sequence of I2C transfers like I2C_TRANSFER() without waiting
+ *   for its completion:  The lower half calls 'callback' with the result of
+ *   the transfers when they complete, typically from its interrupt handler
+ *   once the DMA or interrupt driven transfer is done.  The messages must
+ *   stay valid until then.  This method is optional.
+ *
+ * Input Parameters:
+ *   dev      - Device-specific state data
+ *   msgs     - A pointer to a set of message descriptors
+ *   count    - The number of transfers to perform
+ *   callback - The completion callback
+ *   arg      - The argument of the callback
+ *
+ * Returned Value:
+ *   Zero (OK) if the transfers are started; -EBUSY if the bus is busy with
+ *   a synchronous transfer, or another negated errno value on failure.
+ *   The callback is only called if the transfers are started.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_I2C_ASYNC
+#  define I2C_TRANSFER_ASYNC(d,m,c,cb,a) \
+     ((d)->ops->transfer_async ? \
+      (d)->ops->transfer_async(d,m,c,cb,a) : -ENOSYS)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -213,6 +243,11 @@
 
 struct i2c_master_s;
 struct i2c_msg_s;
+
+#ifdef CONFIG_I2C_ASYNC
+typedef CODE void (*i2c_callback_t)(FAR void *arg, int result);
+#endif
+
 struct i2c_ops_s
 {
   CODE int (*transfer)(FAR struct i2c_master_s *dev,
@@ -222,6 +257,11 @@ struct i2c_ops_s
 #endif
   CODE int (*setup)(FAR struct i2c_master_s *dev);
   CODE int (*shutdown)(FAR struct i2c_master_s *dev);
+#ifdef CONFIG_I2C_ASYNC
+  CODE int (*transfer_async)(FAR struct i2c_master_s *dev,
+                             FAR struct i2c_msg_s *msgs, int count,
+                             i2c_callback_t callback, FAR void *arg);
+#endif
 };
 
 /* This structure contains the full state of I2C as needed for a specific
@@ -0,0 +1,176 @@
+/****************************************************************************
+ * include/nuttx/i2c/i2c_queue.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_I2C_I2C_QUEUE_H
+#define __INCLUDE_NUTTX_I2C_I2C_QUEUE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <nuttx/i2c/i2c_master.h>
+#include <nuttx/queue.h>
+
+#ifdef CONFIG_I2C_ASYNC
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The priority classes of the requests:  The pending requests of a higher
+ * class run first, those of the same class in order of submission.
+ */
+
+enum i2c_prio_e
+{
+  I2C_PRIO_HIGH = 0,
+  I2C_PRIO_NORMAL,
+  I2C_PRIO_LOW,
+  I2C_PRIO_NCLASSES
+};
+
+struct i2c_queue_s;
+struct i2c_request_s;
+
+/* The completion callback of a request.  It may be called from the
+ * interrupt handler of the lower half, so it must not block.  It may
+ * submit the request again.
+ */
+
+typedef CODE void (*i2c_request_cb_t)(FAR struct i2c_request_s *req,
+                                      int result);
+
+/* A request of the I2C transfer queue, owned by the queue from
+ * i2c_queue_submit() until its callback is called.
+ */
+
+struct i2c_request_s
+{
+  sq_entry_t node;                /* Used internally by the queue */
+  FAR struct i2c_msg_s *msgs;     /* The messages of the transfer */
+  int count;                      /* The number of messages */
+  uint8_t prio;                   /* See enum i2c_prio_e */
+  i2c_request_cb_t callback;      /* The completion callback */
+  FAR void *arg;                  /* For the use of the callback */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: i2c_queue_initialize
+ *
+ * Description:
+ *   Create the transfer queue of an I2C bus.  Transfers use the
+ *   transfer_async method of the lower half if it has one and I2C_TRANSFER
+ *   from the low priority work queue otherwise.
+ *
+ * Input Parameters:
+ *   i2c - An instance of the lower half I2C driver
+ *
+ * Returned Value:
+ *   The queue on success; NULL on failure.
+ *
+ ****************************************************************************/
+
+FAR struct i2c_queue_s *i2c_queue_initialize(FAR struct i2c_master_s *i2c);
+
+/****************************************************************************
+ * Name: i2c_queue_uninitialize
+ *
+ * Description:
+ *   Free a transfer queue.  The queue must be idle.
+ *
+ ****************************************************************************/
+
+void i2c_queue_uninitialize(FAR struct i2c_queue_s *queue);
+
+/****************************************************************************
+ * Name: i2c_queue_submit
+ *
+ * Description:
+ *   Queue a request.  It starts at once if the queue is idle, otherwise
+ *   right after the completion of the requests before it.
+ *
+ * Input Parameters:
+ *   queue - The transfer queue
+ *   req   - The request
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if the request is invalid.
+ *
+ ****************************************************************************/
+
+int i2c_queue_submit(FAR struct i2c_queue_s *queue,
+                     FAR struct i2c_request_s *req);
+
+/****************************************************************************
+ * Name: i2c_queue_cancel
+ *
+ * Description:
+ *   Remove a request that has not started yet.  Its callback is not called.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EBUSY if the request is running and -ENOENT if
+ *   it is not queued.
+ *
+ ****************************************************************************/
+
+int i2c_queue_cancel(FAR struct i2c_queue_s *queue,
+                     FAR struct i2c_request_s *req);
+
+/****************************************************************************
+ * Name: i2c_queue_transfer
+ *
+ * Description:
+ *   Queue a transfer and wait for its completion, like I2C_TRANSFER().
+ *
+ * Returned Value:
+ *   Zero (OK) or positive on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int i2c_queue_transfer(FAR struct i2c_queue_s *queue,
+                       FAR struct i2c_msg_s *msgs, int count,
+                       enum i2c_prio_e prio);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_I2C_ASYNC */
+#endif /* __INCLUDE_NUTTX_I2C_I2C_QUEUE_H */
@@ -42,6 +42,7 @@
 #include <nuttx/semaphore.h>
 #include <time.h>
 #include <inttypes.h>
+#include <stdbool.h>
 #include <fixedmath.h>
 
 /****************************************************************************
@@ -94,9 +95,12 @@
 #define TSIOC_GRAB           _TSIOC(0x000e) /* arg: Pointer to
                                              * int for enable grab
                                              */
+#define TSIOC_SETBATCH       _TSIOC(0x000f) /* arg: Pointer to
+                                             * struct touch_batch_s
+                                             */
 
 #define TSC_FIRST            0x0001          /* First common command */
-#define TSC_NCMDS            14              /* Fourteen common commands */
+#define TSC_NCMDS            15              /* Fifteen common commands */
 
 /* Backward compatible IOCTL */
 
@@ -227,6 +231,20 @@ struct touch_sample_s
 #define SIZEOF_TOUCH_SAMPLE_S(n) \
   (sizeof(struct touch_sample_s) + ((n) - 1) * sizeof(struct touch_point_s))
 
+/* The wakeup policy of a reader, see TSIOC_SETBATCH:  The reader is woken
+ * up once 'threshold' samples are queued, 'timeout' microseconds after the
+ * first one if 'timeout' is not zero, or at once for a sample that starts
+ * or ends a contact.  With 'coalesce', a queued sample that only moves the
+ * contacts is replaced by the next one that moves the same contacts.
+ */
+
+struct touch_batch_s
+{
+  uint16_t threshold; /* Samples per wakeup, 1 for a wakeup per sample */
+  uint32_t timeout;   /* Wakeup timeout in microseconds, 0 for none */
+  bool     coalesce;  /* Keep the last of consecutive moves only */
+};
+
 #ifdef CONFIG_INPUT_TOUCHSCREEN
 
 /* This structure is for touchscreen lower half driver */
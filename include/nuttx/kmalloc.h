@@ -113,6 +113,19 @@ extern "C"
 
 #endif
 
+/* Without several memory nodes, the node allocators are the kernel heap
+ * allocators.
+ */
+
+#if !defined(CONFIG_MM_KERNEL_HEAP) || CONFIG_MM_KERNEL_HEAP_NODES < 2
+#  define kmm_cpunode(c)             0
+#  define kmm_addregion_node(n,h,s)  kmm_addregion(h,s)
+#  define kmm_malloc_node(n,s)       kmm_malloc(s)
+#  define kmm_zalloc_node(n,s)       kmm_zalloc(s)
+#  define kmm_memalign_node(n,a,s)   kmm_memalign(a,s)
+#  define kmm_mallinfo_node(n)       kmm_mallinfo()
+#endif
+
 #ifdef CONFIG_MM_KERNEL_HEAP
 /****************************************************************************
  * Group memory management
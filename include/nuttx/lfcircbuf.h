@@ -0,0 +1,290 @@
+/****************************************************************************
+ * include/nuttx/lfcircbuf.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_LFCIRCBUF_H
+#define __INCLUDE_NUTTX_LFCIRCBUF_H
+
+/* Note about locking: This is a variant of the circular buffer of
+ * nuttx/circbuf.h whose indexes are updated atomically, so that a producer
+ * and the consumer never need a lock, e.g. to pass data from an interrupt
+ * handler to a thread.
+ *
+ * - lfcircbuf_write() may be used by a single producer.
+ * - lfcircbuf_reserve()/lfcircbuf_commit() and lfcircbuf_write_mp() may be
+ *   used by several producers concurrently.  The producers complete in the
+ *   order of their reservations, so a producer must not be interrupted by
+ *   another producer of the same buffer on its own CPU between the
+ *   reservation and the commit:  A thread must disable the local interrupts
+ *   if an interrupt handler is a producer too.
+ * - The reading functions may be used by a single consumer.  Several
+ *   consumers need to be serialized by the caller.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <sys/types.h>
+
+#include <nuttx/atomic.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_LIBC_LFCIRCBUF_LINESIZE
+#  define CONFIG_LIBC_LFCIRCBUF_LINESIZE 64
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This structure describes a lock-free circular buffer.  The indexes run
+ * from 0 to twice the size of the buffer, so that a full buffer can be told
+ * from an empty one for any size.  The producer and consumer indexes are
+ * kept on separate cache lines so that the two sides do not invalidate each
+ * other's cache line on every access.
+ */
+
+struct lfcircbuf_s
+{
+  FAR void    *base;      /* The pointer to buffer space */
+  size_t       size;      /* The size of buffer space */
+  bool         external;  /* The flag for external buffer */
+
+  atomic_uint  reserve;   /* The index up to which producers reserved */
+  atomic_uint  head;      /* The index up to which data is committed */
+  char         pad[CONFIG_LIBC_LFCIRCBUF_LINESIZE];
+  atomic_uint  tail;      /* The index up to which data is consumed */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: lfcircbuf_init
+ *
+ * Description:
+ *   Initialize a lock-free circular buffer.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   base  - A pointer to circular buffer's internal buffer.  If NULL, a
+ *           buffer of the given size will be allocated.
+ *   bytes - The size of the internal buffer.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+int lfcircbuf_init(FAR struct lfcircbuf_s *circ,
+                   FAR void *base, size_t bytes);
+
+/****************************************************************************
+ * Name: lfcircbuf_uninit
+ *
+ * Description:
+ *   Free the circular buffer.
+ *
+ ****************************************************************************/
+
+void lfcircbuf_uninit(FAR struct lfcircbuf_s *circ);
+
+/****************************************************************************
+ * Name: lfcircbuf_reset
+ *
+ * Description:
+ *   Remove the entire circular buffer content.  No producer or consumer
+ *   may use the buffer meanwhile.
+ *
+ ****************************************************************************/
+
+void lfcircbuf_reset(FAR struct lfcircbuf_s *circ);
+
+/****************************************************************************
+ * Name: lfcircbuf_used
+ *
+ * Description:
+ *   Return the used bytes of the circular buffer, i.e. the committed data
+ *   that has not been read yet.
+ *
+ ****************************************************************************/
+
+size_t lfcircbuf_used(FAR struct lfcircbuf_s *circ);
+
+/****************************************************************************
+ * Name: lfcircbuf_space
+ *
+ * Description:
+ *   Return the remaining space of the circular buffer.
+ *
+ ****************************************************************************/
+
+size_t lfcircbuf_space(FAR struct lfcircbuf_s *circ);
+
+/****************************************************************************
+ * Name: lfcircbuf_is_empty
+ *
+ * Description:
+ *   Return true if the circular buffer holds no committed data.
+ *
+ ****************************************************************************/
+
+bool lfcircbuf_is_empty(FAR struct lfcircbuf_s *circ);
+
+/****************************************************************************
+ * Name: lfcircbuf_read
+ *
+ * Description:
+ *   Get data from the circular buffer.  Consumer side.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   dst   - Address where to store the data.
+ *   bytes - Number of bytes to get.
+ *
+ * Returned Value:
+ *   The number of bytes read.
+ *
+ ****************************************************************************/
+
+ssize_t lfcircbuf_read(FAR struct lfcircbuf_s *circ,
+                       FAR void *dst, size_t bytes);
+
+/****************************************************************************
+ * Name: lfcircbuf_write
+ *
+ * Description:
+ *   Write as much data as fits to the circular buffer.  Single producer
+ *   side.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   src   - The data to be added.
+ *   bytes - Number of bytes to be added.
+ *
+ * Returned Value:
+ *   The number of bytes written.
+ *
+ ****************************************************************************/
+
+ssize_t lfcircbuf_write(FAR struct lfcircbuf_s *circ,
+                        FAR const void *src, size_t bytes);
+
+/****************************************************************************
+ * Name: lfcircbuf_reserve
+ *
+ * Description:
+ *   Reserve space for 'bytes' bytes in the circular buffer.  Multiple
+ *   producer side.  The data is filled in with lfcircbuf_copyin() and made
+ *   visible to the consumer with lfcircbuf_commit().
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   bytes - Number of bytes to reserve.
+ *   pos   - The location to return the index of the reserved space.
+ *
+ * Returned Value:
+ *   Zero on success; -ENOSPC if there is not enough space.
+ *
+ ****************************************************************************/
+
+int lfcircbuf_reserve(FAR struct lfcircbuf_s *circ, size_t bytes,
+                      FAR unsigned int *pos);
+
+/****************************************************************************
+ * Name: lfcircbuf_copyin
+ *
+ * Description:
+ *   Copy data into space reserved with lfcircbuf_reserve().
+ *
+ * Input Parameters:
+ *   circ   - Address of the circular buffer to be used.
+ *   pos    - The index returned by lfcircbuf_reserve().
+ *   offset - The offset of the data in the reserved space.
+ *   src    - The data to be added.
+ *   bytes  - Number of bytes to be added.
+ *
+ ****************************************************************************/
+
+void lfcircbuf_copyin(FAR struct lfcircbuf_s *circ, unsigned int pos,
+                      size_t offset, FAR const void *src, size_t bytes);
+
+/****************************************************************************
+ * Name: lfcircbuf_commit
+ *
+ * Description:
+ *   Make reserved space visible to the consumer.  If an earlier reservation
+ *   is still being filled in by another producer, wait for it to be
+ *   committed first.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   pos   - The index returned by lfcircbuf_reserve().
+ *   bytes - The number of bytes that were reserved.
+ *
+ ****************************************************************************/
+
+void lfcircbuf_commit(FAR struct lfcircbuf_s *circ, unsigned int pos,
+                      size_t bytes);
+
+/****************************************************************************
+ * Name: lfcircbuf_write_mp
+ *
+ * Description:
+ *   Write all of the data to the circular buffer or nothing.  Multiple
+ *   producer side.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   src   - The data to be added.
+ *   bytes - Number of bytes to be added.
+ *
+ * Returned Value:
+ *   The number of bytes written; -ENOSPC if there is not enough space.
+ *
+ ****************************************************************************/
+
+ssize_t lfcircbuf_write_mp(FAR struct lfcircbuf_s *circ,
+                           FAR const void *src, size_t bytes);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_LFCIRCBUF_H */
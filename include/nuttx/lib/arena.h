@@ -0,0 +1,125 @@
+/****************************************************************************
+ * include/nuttx/lib/arena.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_LIB_ARENA_H
+#define __INCLUDE_NUTTX_LIB_ARENA_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <obstack.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* An arena is an obstack that only hands out aligned objects and returns
+ * NULL instead of aborting when it cannot grow:  It suits the bursts of
+ * short-lived objects that are needed for one operation and all freed
+ * together, with a single lib_arena_release().  Its chunks come from
+ * lib_malloc(), so from the kernel heap in kernel code.
+ */
+
+/* The alignment of all objects of an arena */
+
+#define LIB_ARENA_ALIGN         (2 * sizeof(uintptr_t))
+
+/* The chunk size that holds 'n' bytes of objects of that alignment */
+
+#define LIB_ARENA_SIZE(n)       (((n) + LIB_ARENA_ALIGN - 1) & \
+                                 ~(LIB_ARENA_ALIGN - 1))
+
+/* Free all objects of an arena, and all its chunks */
+
+#define lib_arena_release(a)    obstack_free(a, NULL)
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: lib_arena_init
+ *
+ * Description:
+ *   Initialize an arena that allocates chunks of at least 'chunksize'
+ *   bytes of objects, or exactly the size of each object if it is zero.
+ *   An arena that is cleared to zero is valid, with a chunk size of zero.
+ *
+ ****************************************************************************/
+
+void lib_arena_init(FAR struct obstack *arena, size_t chunksize);
+
+/****************************************************************************
+ * Name: lib_arena_alloc
+ *
+ * Description:
+ *   Allocate 'size' bytes aligned to LIB_ARENA_ALIGN from an arena.  The
+ *   memory is only freed by lib_arena_release().
+ *
+ * Returned Value:
+ *   The allocated memory, or NULL if a new chunk could not be allocated.
+ *
+ ****************************************************************************/
+
+FAR void *lib_arena_alloc(FAR struct obstack *arena, size_t size);
+
+/****************************************************************************
+ * Name: lib_arena_zalloc
+ *
+ * Description:
+ *   Allocate 'size' bytes from an arena, like lib_arena_alloc(), and clear
+ *   them.
+ *
+ ****************************************************************************/
+
+FAR void *lib_arena_zalloc(FAR struct obstack *arena, size_t size);
+
+/****************************************************************************
+ * Name: lib_arena_strdup
+ *
+ * Description:
+ *   Allocate a copy of the string 's' from an arena.
+ *
+ ****************************************************************************/
+
+FAR char *lib_arena_strdup(FAR struct obstack *arena, FAR const char *s);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_LIB_ARENA_H */
@@ -30,9 +30,12 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <time.h>
 #include <elf.h>
 
 #include <nuttx/addrenv.h>
+#include <nuttx/lib/arena.h>
+#include <nuttx/symtab.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -158,6 +161,10 @@ struct module_s
   char modname[MODLIB_NAMEMAX];        /* Module name */
 #endif
   struct mod_info_s modinfo;           /* Module information */
+  struct obstack symarena;             /* Arena of modinfo.exports */
+#ifdef CONFIG_SYMTAB_HASH
+  struct symtab_hash_s exphash;        /* Hash index of modinfo.exports */
+#endif
   FAR void *textalloc;                 /* Allocated kernel text memory */
   FAR void *dataalloc;                 /* Allocated kernel memory */
   uintptr_t xipbase;                   /* if elf is position independent, and use
@@ -219,6 +226,7 @@ struct mod_loadinfo_s
   Elf_Ehdr      ehdr;        /* Buffered module file header */
   FAR Elf_Phdr *phdr;        /* Buffered module program headers */
   FAR Elf_Shdr *shdr;        /* Buffered module section headers */
+  struct obstack hdrarena;   /* Arena of phdr[] and shdr[] */
   FAR void     *exported;    /* Module exports */
   FAR uint8_t  *iobuffer;    /* File I/O buffer */
   uintptr_t     datasec;     /* ET_DYN - data area start from Phdr */
@@ -240,6 +248,18 @@ struct mod_loadinfo_s
                               * romfs/tmps, we can try get xipbase,
                               * skip the copy.
                               */
+  uintptr_t     filebase;    /* Address of the file if it is in memory */
+  off_t         filepos;     /* Current position in the file */
+#if CONFIG_MODLIB_READAHEAD > 0
+  FAR uint8_t  *readbuf;     /* Read-ahead buffer */
+  off_t         readpos;     /* Position of readbuf[] in the file */
+  size_t        readlen;     /* Number of bytes in readbuf[] */
+#endif
+#ifdef CONFIG_MODLIB_SHARED_TEXT
+  FAR const char *filename;  /* Path of the file being loaded */
+  ino_t         fileino;     /* Serial number of the file */
+  struct timespec filemtime; /* Time of last modification of the file */
+#endif
 
   /* Address environment.
    *
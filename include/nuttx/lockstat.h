@@ -0,0 +1,124 @@
+/****************************************************************************
+ * include/nuttx/lockstat.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_LOCKSTAT_H
+#define __INCLUDE_NUTTX_LOCKSTAT_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LOCKSTAT_INITIALIZER(n) { (n), NULL, false, 0, 0, 0, 0 }
+
+#ifndef CONFIG_SCHED_LOCKSTAT
+#  define lockstat_spin_lock(l, s)          spin_lock(l)
+#  define lockstat_spin_lock_irqsave(l, s)  spin_lock_irqsave(l)
+#endif
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+/* Contention statistics of one spinlock.  The counters are only modified
+ * by the holder of the lock so no further serialization is needed.  The
+ * structure is added to the /proc/lockstat report the first time that the
+ * lock is taken.
+ */
+
+struct lockstat_s
+{
+  FAR const char *name;          /* Name in the report */
+  FAR struct lockstat_s *flink;  /* Next lock in the report */
+  bool     registered;           /* True: Linked in the report */
+  uint32_t acquired;             /* Times the lock was taken */
+  uint32_t contended;            /* Times the lock was busy */
+  clock_t  spintime;             /* Total time spent waiting (perf ticks) */
+  clock_t  maxspin;              /* Longest wait (perf ticks) */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+
+/****************************************************************************
+ * Name: lockstat_spin_lock
+ *
+ * Description:
+ *   Take a spinlock like spin_lock() and account for the time spent
+ *   waiting for it.
+ *
+ * Input Parameters:
+ *   lock - The spinlock to take
+ *   stat - The statistics of that spinlock
+ *
+ * Assumptions:
+ *   Interrupts are disabled on the local CPU.
+ *
+ ****************************************************************************/
+
+void lockstat_spin_lock(FAR volatile spinlock_t *lock,
+                        FAR struct lockstat_s *stat);
+
+/****************************************************************************
+ * Name: lockstat_spin_lock_irqsave
+ *
+ * Description:
+ *   Equivalent to spin_lock_irqsave() for a non-NULL lock, with the same
+ *   accounting as lockstat_spin_lock().  Release the lock with
+ *   spin_unlock_irqrestore().
+ *
+ ****************************************************************************/
+
+irqstate_t lockstat_spin_lock_irqsave(FAR volatile spinlock_t *lock,
+                                      FAR struct lockstat_s *stat);
+
+#endif /* CONFIG_SCHED_LOCKSTAT */
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_LOCKSTAT_H */
@@ -0,0 +1,127 @@
+/****************************************************************************
+ * include/nuttx/mm/heapprof.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_MM_HEAPPROF_H
+#define __INCLUDE_NUTTX_MM_HEAPPROF_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stddef.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_MM_HEAPPROF
+#  define heapprof_alloc(mem, size)
+#  define heapprof_free(mem)
+#else
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The allocations made from one call site.  The counts are estimates:
+ * Each sampled allocation stands for CONFIG_MM_HEAPPROF_RATE bytes, or for
+ * its own size if it is larger.
+ */
+
+struct heapprof_site_s
+{
+  FAR void *frames[CONFIG_MM_HEAPPROF_DEPTH]; /* The call stack, innermost first */
+  int       nframes;                          /* The depth of the call stack */
+  size_t    inuse_objs;                       /* Allocations not freed yet */
+  size_t    inuse_bytes;                      /* Bytes not freed yet */
+  size_t    alloc_objs;                       /* Allocations in total */
+  size_t    alloc_bytes;                      /* Bytes allocated in total */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: heapprof_alloc
+ *
+ * Description:
+ *   Account an allocation of 'size' bytes at 'mem'.  One allocation every
+ *   CONFIG_MM_HEAPPROF_RATE bytes on average is sampled:  Its call stack is
+ *   recorded and the allocation is added to the call site.
+ *
+ ****************************************************************************/
+
+void heapprof_alloc(FAR void *mem, size_t size);
+
+/****************************************************************************
+ * Name: heapprof_free
+ *
+ * Description:
+ *   Account the free of the allocation at 'mem', removing it from its call
+ *   site if it was sampled.
+ *
+ ****************************************************************************/
+
+void heapprof_free(FAR void *mem);
+
+/****************************************************************************
+ * Name: heapprof_getsite
+ *
+ * Description:
+ *   Get a copy of call site 'index', from 0 to CONFIG_MM_HEAPPROF_NSITES-1.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOENT if there is no call site at
+ *   'index' and -EINVAL if 'index' is out of range.
+ *
+ ****************************************************************************/
+
+int heapprof_getsite(int index, FAR struct heapprof_site_s *site);
+
+/****************************************************************************
+ * Name: heapprof_reset
+ *
+ * Description:
+ *   Forget all call sites and the sampled allocations.
+ *
+ ****************************************************************************/
+
+void heapprof_reset(void);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_MM_HEAPPROF */
+#endif /* __INCLUDE_NUTTX_MM_HEAPPROF_H */
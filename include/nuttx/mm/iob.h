@@ -81,7 +81,7 @@
 /* IOB helpers */
 
 #define IOB_DATA(p)      (&(p)->io_data[(p)->io_offset])
-#define IOB_FREESPACE(p) (CONFIG_IOB_BUFSIZE - (p)->io_len - (p)->io_offset)
+#define IOB_FREESPACE(p) (IOB_BUFSIZE(p) - (p)->io_len - (p)->io_offset)
 
 #if CONFIG_IOB_NCHAINS > 0
 /* Queue helpers */
@@ -96,6 +96,11 @@
 #  define IOB_BUFSIZE(p) CONFIG_IOB_BUFSIZE
 #endif
 
+/* Checksum offload state of a packet, see io_csumflags */
+
+#define IOB_CSUM_PARTIAL  (1 << 0) /* The device completes the checksum */
+#define IOB_CSUM_VERIFIED (1 << 1) /* The device verified the checksum */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -127,9 +132,27 @@ struct iob_s
 #endif
   unsigned int io_pktlen; /* Total length of the packet */
 
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+  /* Checksum offload, significant in the head of a chain only:  The TCP or
+   * UDP checksum covers the data from io_csumstart to the end of the
+   * packet, it is stored at io_csumoff in this data.
+   */
+
+  uint8_t  io_csumflags;  /* IOB_CSUM_* flags */
+  uint8_t  io_csumoff;    /* Offset of the checksum field */
+  uint16_t io_csumstart;  /* Offset of the data covered by the checksum */
+#endif
+
 #ifdef CONFIG_IOB_ALLOC
   iob_free_cb_t io_free;  /* Custom free callback */
   FAR uint8_t  *io_data;
+#  ifdef CONFIG_IOB_SHARE
+  unsigned int  io_refs;  /* References to this I/O buffer */
+
+  /* The I/O buffer that owns io_data, NULL if it is its own */
+
+  FAR struct iob_s *io_owner;
+#  endif
 #else
   uint8_t       io_data[CONFIG_IOB_BUFSIZE];
 #endif
@@ -221,6 +244,39 @@ FAR struct iob_s *iob_alloc(bool throttled);
 
 FAR struct iob_s *iob_tryalloc(bool throttled);
 
+/****************************************************************************
+ * Name: iob_alloc_size
+ *
+ * Description:
+ *   Allocate an I/O buffer of the size that fits 'size' bytes best:  A
+ *   large I/O buffer if the data does not fit in an I/O buffer of
+ *   CONFIG_IOB_BUFSIZE and a large one is free, or else an I/O buffer of
+ *   CONFIG_IOB_BUFSIZE, waiting for one if there is none.  The caller
+ *   chains more buffers if IOB_BUFSIZE() of the buffer is still too small.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_LARGE
+FAR struct iob_s *iob_alloc_size(unsigned int size, bool throttled);
+#else
+#  define iob_alloc_size(size, throttled) iob_alloc(throttled)
+#endif
+
+/****************************************************************************
+ * Name: iob_tryalloc_size
+ *
+ * Description:
+ *   Allocate an I/O buffer of the size that fits 'size' bytes best, like
+ *   iob_alloc_size(), without waiting for a buffer to become free.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_LARGE
+FAR struct iob_s *iob_tryalloc_size(unsigned int size, bool throttled);
+#else
+#  define iob_tryalloc_size(size, throttled) iob_tryalloc(throttled)
+#endif
+
 #ifdef CONFIG_IOB_ALLOC
 /****************************************************************************
  * Name: iob_alloc_dynamic
@@ -268,6 +324,55 @@ FAR struct iob_s *iob_alloc_with_data(FAR void *data, uint16_t size,
                                       iob_free_cb_t free_cb);
 #endif
 
+#ifdef CONFIG_IOB_SHARE
+/****************************************************************************
+ * Name: iob_share
+ *
+ * Description:
+ *   Clone an I/O buffer chain without copying its data.  Each buffer of
+ *   the clone is a header from the heap that refers to the data of the
+ *   buffer it clones:
+ *
+ *             +---------+  io_owner  +---------+
+ *             |   IOB   |<-----------|  clone  |
+ *             | io_data |--+         | io_data |--+
+ *             | buffer  |<-+---------------------+
+ *             +---------+
+ *
+ *   The data is freed with its last reference, and each side of the
+ *   sharing gets a copy of the buffer on its first write (iob_unshare)
+ *   through the IOB functions.  Code that writes IOB_DATA() directly
+ *   has to call iob_unshare() first.
+ *
+ * Input Parameters:
+ *   iob - The head of the I/O buffer chain to clone.
+ *
+ * Returned Value:
+ *   The head of the clone, or NULL if the headers can not be allocated.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_share(FAR struct iob_s *iob);
+
+/****************************************************************************
+ * Name: iob_unshare
+ *
+ * Description:
+ *   Give an I/O buffer a data buffer of its own if it shares its data with
+ *   other I/O buffers.  The data and the room ahead of it are copied.
+ *
+ * Input Parameters:
+ *   iob       - The I/O buffer that is about to be written.
+ *   throttled - An indication of the IOB allocation is "throttled"
+ *
+ * Returned Value:
+ *   Zero on success; -ENOMEM if there is no I/O buffer for the copy.
+ *
+ ****************************************************************************/
+
+int iob_unshare(FAR struct iob_s *iob, bool throttled);
+#endif
+
 /****************************************************************************
  * Name: iob_navail
  *
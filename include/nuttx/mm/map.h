@@ -28,10 +28,11 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
-#include <nuttx/queue.h>
 #include <nuttx/mutex.h>
 #include <nuttx/mm/gran.h>
 
+#include <sys/tree.h>
+
 /****************************************************************************
  * Forward declarations
  ****************************************************************************/
@@ -42,11 +43,14 @@ struct task_group_s;
  * Public Types
  ****************************************************************************/
 
-/* A memory mapping list item */
+/* A memory mapping, in the tree of mappings sorted by address.  The tree is
+ * an interval tree:  Each node has the end of the mappings in its subtree.
+ */
 
 struct mm_map_entry_s
 {
-  FAR struct mm_map_entry_s *flink;  /* this is used as sq_entry_t */
+  RB_ENTRY(mm_map_entry_s) node;     /* Node of the tree of mappings */
+  uintptr_t end_max;                 /* Highest end of the subtree */
   FAR void *vaddr;
   size_t length;
   off_t offset;
@@ -74,12 +78,18 @@ struct mm_map_entry_s
                 size_t length);
 };
 
+RB_HEAD(mm_map_tree_s, mm_map_entry_s);
+
 /* memory mapping structure for the task group */
 
 struct mm_map_s
 {
-  sq_queue_t mm_map_sq;         /* mappings list */
-  size_t map_count;             /* mappings list length */
+  struct mm_map_tree_s mm_map_tree; /* mappings tree */
+  size_t map_count;                 /* number of mappings */
+
+  /* The last mapping found, checked first by mm_map_find() */
+
+  FAR struct mm_map_entry_s *mm_map_hint;
 
 #ifdef CONFIG_ARCH_VMA_MAPPING
   GRAN_HANDLE mm_map_vpages;    /* SHM virtual zone allocator */
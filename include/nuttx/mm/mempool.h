@@ -93,6 +93,19 @@ struct mempool_procfs_entry_s
 };
 #endif
 
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+
+/* This structure describes the cache of free blocks of a pool on one CPU.
+ * It is a LIFO, so the most recently freed block is reused first.
+ */
+
+struct mempool_magazine_s
+{
+  size_t    count;                               /* The number of blocks */
+  FAR void *blocks[CONFIG_MM_MEMPOOL_MAGAZINE];  /* The cached blocks */
+};
+#endif
+
 /* This structure describes memory buffer pool */
 
 struct mempool_s
@@ -116,6 +129,9 @@ struct mempool_s
   size_t     nalloc;  /* The number of used block in mempool */
   spinlock_t lock;    /* The protect lock to mempool */
   sem_t      waitsem; /* The semaphore of waiter get free block */
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+  FAR struct mempool_magazine_s *magazine; /* The per-CPU caches, or NULL */
+#endif
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL)
   struct mempool_procfs_entry_s procfs; /* The entry of procfs */
 #endif
@@ -143,6 +159,9 @@ struct mempoolinfo_s
   unsigned long aordblks; /* This is the number of used blocks */
   unsigned long sizeblks; /* This is the size of a mempool blocks */
   unsigned long nwaiter;  /* This is the number of waiter for mempool */
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+  unsigned long cordblks; /* This is the number of blocks cached per CPU */
+#endif
 };
 
 /****************************************************************************
@@ -177,6 +196,31 @@ extern "C"
 
 int mempool_init(FAR struct mempool_s *pool, FAR const char *name);
 
+/****************************************************************************
+ * Name: mempool_magazine_init
+ *
+ * Description:
+ *   Enable the per-CPU caches of free blocks of an initialized memory pool.
+ *   Each CPU then allocates and releases blocks in its own cache without
+ *   taking the lock of the pool, and refills or drains the cache in batches
+ *   of half its size.  The pool must neither wait for free blocks nor have
+ *   an interrupt reserve.
+ *
+ * Input Parameters:
+ *   pool     - Address of the memory pool to be used.
+ *   magazine - The storage of the caches, an array of CONFIG_SMP_NCPUS
+ *              entries that must stay valid until mempool_deinit().
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+int mempool_magazine_init(FAR struct mempool_s *pool,
+                          FAR struct mempool_magazine_s *magazine);
+#endif
+
 /****************************************************************************
  * Name: mempool_allocate
  *
@@ -209,6 +253,25 @@ FAR void *mempool_allocate(FAR struct mempool_s *pool);
 
 void mempool_release(FAR struct mempool_s *pool, FAR void *blk);
 
+/****************************************************************************
+ * Name: mempool_reclaim
+ *
+ * Description:
+ *   Give the expansions of a memory pool whose blocks are all free back to
+ *   the allocator of the pool.  The initial memory and the interrupt
+ *   reserve are kept, and so are the expansions with blocks in the per-CPU
+ *   caches.  The calls for a pool must be serialized by the caller.
+ *
+ * Input Parameters:
+ *   pool - Address of the memory pool to be used.
+ *
+ * Returned Value:
+ *   The number of bytes given back.
+ *
+ ****************************************************************************/
+
+size_t mempool_reclaim(FAR struct mempool_s *pool);
+
 /****************************************************************************
  * Name: mempool_info
  *
@@ -458,6 +521,23 @@ ssize_t mempool_multiple_alloc_size(FAR struct mempool_multiple_s *mpool,
 FAR void *mempool_multiple_memalign(FAR struct mempool_multiple_s *mpool,
                                     size_t alignment, size_t size);
 
+/****************************************************************************
+ * Name: mempool_multiple_reclaim
+ *
+ * Description:
+ *   Give the free expansions of all pools of a multiple memory pool back to
+ *   its allocator.
+ *
+ * Input Parameters:
+ *   mpool - The handle of multiple memory pool to be used.
+ *
+ * Returned Value:
+ *   The number of bytes given back by the pools.
+ *
+ ****************************************************************************/
+
+size_t mempool_multiple_reclaim(FAR struct mempool_multiple_s *mpool);
+
 /****************************************************************************
  * Name: mempool_multiple_memdump
  *
@@ -160,6 +160,10 @@
 #define MM_ALLOC_MAGIC   0xaa
 #define MM_FREE_MAGIC    0x55
 
+/* The number of size classes of struct mm_fraginfo_s */
+
+#define MM_FRAGINFO_NCLASSES 32
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -176,6 +180,23 @@ struct mempool_init_s
   size_t            dict_expendsize;
 };
 
+/* The free memory of a heap, returned by mm_fraginfo() without walking the
+ * heap.  The size class i counts the free chunks of 2^i bytes up to
+ * 2^(i+1) - 1 bytes; The chunks larger than the biggest class of the heap
+ * are counted in that class.  The fragmentation index is 0 when the free
+ * memory is one chunk and tends to 1000 as it is split in small chunks.
+ */
+
+struct mm_fraginfo_s
+{
+  size_t       freesize;                      /* Total size of free chunks */
+  size_t       nfree;                         /* Number of free chunks */
+  size_t       largest;                       /* Largest free chunk */
+  unsigned int fragindex;                     /* Fragmentation in permille */
+  size_t       count[MM_FRAGINFO_NCLASSES];   /* Free chunks by size class */
+  size_t       bytes[MM_FRAGINFO_NCLASSES];   /* Free bytes by size class */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -277,6 +298,7 @@ void kmm_addregion(FAR void *heapstart, size_t heapsize);
 FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size) malloc_like1(2);
 
 void mm_free_delaylist(FAR struct mm_heap_s *heap);
+size_t mm_reclaim(FAR struct mm_heap_s *heap);
 
 /* Functions contained in kmm_malloc.c **************************************/
 
@@ -404,16 +426,33 @@ struct mallinfo_task mm_mallinfo_task(FAR struct mm_heap_s *heap,
 
 size_t mm_heapfree(FAR struct mm_heap_s *heap);
 size_t mm_heapfree_largest(FAR struct mm_heap_s *heap);
+int mm_fraginfo(FAR struct mm_heap_s *heap,
+                FAR struct mm_fraginfo_s *info);
 
 /* Functions contained in kmm_mallinfo.c ************************************/
 
 #ifdef CONFIG_MM_KERNEL_HEAP
 struct mallinfo kmm_mallinfo(void);
+int kmm_fraginfo(FAR struct mm_fraginfo_s *info);
 #  if CONFIG_MM_BACKTRACE >= 0
 struct mallinfo_task kmm_mallinfo_task(FAR const struct malltask *task);
 #  endif
 #endif
 
+/* Functions contained in kmm_node.c ****************************************/
+
+#if defined(CONFIG_MM_KERNEL_HEAP) && CONFIG_MM_KERNEL_HEAP_NODES > 1
+int kmm_cpunode(int cpu);
+void kmm_addregion_node(int node, FAR void *heapstart, size_t heapsize);
+FAR struct mm_heap_s *kmm_nodeheap(int node);
+FAR struct mm_heap_s *kmm_memheap(FAR void *mem);
+FAR void *kmm_malloc_node(int node, size_t size) malloc_like1(2);
+FAR void *kmm_zalloc_node(int node, size_t size) malloc_like1(2);
+FAR void *kmm_memalign_node(int node, size_t alignment, size_t size)
+  malloc_like1(3);
+struct mallinfo kmm_mallinfo_node(int node);
+#endif
+
 /* Functions contained in mm_memdump.c **************************************/
 
 void mm_memdump(FAR struct mm_heap_s *heap,
@@ -77,6 +77,23 @@
                                              *      erased state of the MTD cell */
 #define MTDIOC_ERASESECTORS _MTDIOC(0x000c) /* IN: Pointer to mtd_erase_s structure
                                              * OUT: None */
+#define MTDIOC_ERASESTART   _MTDIOC(0x000d) /* IN:  Erase block number
+                                             * OUT: None.  Starts the erase
+                                             *      and returns without
+                                             *      waiting for it */
+#define MTDIOC_ERASEBUSY    _MTDIOC(0x000e) /* IN:  None
+                                             * OUT: Returns 1 while the
+                                             *      started erase is in
+                                             *      progress or suspended,
+                                             *      0 once complete */
+#define MTDIOC_ERASESUSPEND _MTDIOC(0x000f) /* IN:  None
+                                             * OUT: None.  Suspends the
+                                             *      erase in progress so that
+                                             *      the other erase blocks
+                                             *      can be read */
+#define MTDIOC_ERASERESUME  _MTDIOC(0x0010) /* IN:  None
+                                             * OUT: None.  Resumes the
+                                             *      suspended erase */
 
 /* Macros to hide implementation */
 
@@ -781,6 +798,42 @@ int dhara_initialize_by_path(FAR const char *path,
                              FAR struct mtd_dev_s *mtd);
 #endif
 
+/****************************************************************************
+ * Name: lftl_initialize
+ *
+ * Description:
+ *   Initialize to provide a log-structured block driver wrapper around an
+ *   MTD interface
+ *
+ * Input Parameters:
+ *   minor - The minor device number.  The MTD block device will be
+ *           registered as as /dev/mtdblockN where N is the minor number.
+ *   mtd   - The MTD device that supports the FLASH interface.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_LFTL
+int lftl_initialize(int minor, FAR struct mtd_dev_s *mtd);
+#endif
+
+/****************************************************************************
+ * Name: lftl_initialize_by_path
+ *
+ * Description:
+ *   Initialize to provide a log-structured block driver wrapper around an
+ *   MTD interface
+ *
+ * Input Parameters:
+ *   path - The block device path.
+ *   mtd  - The MTD device that supports the FLASH interface.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_LFTL
+int lftl_initialize_by_path(FAR const char *path,
+                            FAR struct mtd_dev_s *mtd);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -154,6 +154,12 @@
 
 #define SIOCNOTIFYRECVCPU  _SIOC(0x003F)  /* RSS notify recv cpu */
 
+/* Receive filter calls *****************************************************/
+
+#define SIOCSIFRXFILTER    _SIOC(0x0043)  /* Set the receive filter rules.
+                                           * See include/nuttx/net/rxfilter.h */
+#define SIOCGIFRXFILTER    _SIOC(0x0044)  /* Get the receive filter rules */
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -137,10 +137,11 @@ typedef uint8_t sockcaps_t;
  * a given address family.
  */
 
-struct file;    /* Forward reference */
-struct stat;    /* Forward reference */
-struct socket;  /* Forward reference */
-struct pollfd;  /* Forward reference */
+struct file;           /* Forward reference */
+struct stat;           /* Forward reference */
+struct socket;         /* Forward reference */
+struct pollfd;         /* Forward reference */
+struct mm_map_entry_s; /* Forward reference */
 
 struct sock_intf_s
 {
@@ -181,6 +182,8 @@ struct sock_intf_s
                     FAR struct file *infile, FAR off_t *offset,
                     size_t count);
 #endif
+  CODE int        (*si_mmap)(FAR struct socket *psock,
+                    FAR struct mm_map_entry_s *map);
 };
 
 /* Each socket refers to a connection structure of type FAR void *.  Each
@@ -220,6 +223,9 @@ struct socket_conn_s
   uint8_t       s_boundto;   /* Index of the interface we are bound to.
                               * Unbound: 0, Bound: 1-MAX_IFINDEX */
 #  endif
+#  ifdef CONFIG_NET_BUSYPOLL
+  uint32_t      s_busypoll;  /* Busy poll time (in microseconds) */
+#  endif
 #endif
 
   /* Definitions of 8-bit socket flags */
@@ -579,6 +585,26 @@ FAR struct iob_s *net_ioballoc(bool throttled);
 
 int sockfd_allocate(FAR struct socket *psock, int oflags);
 
+/****************************************************************************
+ * Name: sockfd_allocate_from_tcb
+ *
+ * Description:
+ *   Allocate a socket descriptor in the descriptor table of another task.
+ *
+ * Input Parameters:
+ *   tcb      The task that owns the new descriptor.
+ *   psock    A pointer to socket structure.
+ *   oflags   Open mode flags.
+ *
+ * Returned Value:
+ *   The new socket descriptor, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+struct tcb_s;
+int sockfd_allocate_from_tcb(FAR struct tcb_s *tcb,
+                             FAR struct socket *psock, int oflags);
+
 /****************************************************************************
  * Name: sockfd_socket
  *
@@ -928,6 +954,43 @@ ssize_t psock_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
 ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                       int flags);
 
+/****************************************************************************
+ * Name: psock_sendmmsg
+ *
+ * Description:
+ *   psock_sendmmsg() sends up to 'vlen' messages to a socket with a single
+ *   hold of the network lock.  It is functionally equivalent to sendmmsg()
+ *   except that it is not a cancellation point, it does not modify the
+ *   errno variable, and it accepts the internal socket structure.
+ *
+ * Returned Value:
+ *   The number of messages sent, or a negated errno value if none was.
+ *
+ ****************************************************************************/
+
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags);
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives up to 'vlen' messages from a socket with a
+ *   single hold of the network lock.  It is functionally equivalent to
+ *   recvmmsg() except that it is not a cancellation point, it does not
+ *   modify the errno variable, and it accepts the internal socket
+ *   structure.
+ *
+ * Returned Value:
+ *   The number of messages received, or a negated errno value if none
+ *   was.
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout);
+
 /****************************************************************************
  * Name: psock_send
  *
@@ -218,6 +218,14 @@
 #define NET_LL_HDRLEN(d)       ((d)->d_llhdrlen)
 #define NETDEV_PKTSIZE(d)      ((d)->d_pktsize)
 
+/* True while a TCP super-segment larger than the MTU is built in d_iob */
+
+#ifdef CONFIG_NETDEV_GSO
+#  define NETDEV_GSO_PENDING(d) ((d)->d_gsosize > 0)
+#else
+#  define NETDEV_GSO_PENDING(d) false
+#endif
+
 #ifdef CONFIG_NET_ETHERNET
 #  define _MIN_ETH_PKTSIZE     CONFIG_NET_ETH_PKTSIZE
 #  define _MAX_ETH_PKTSIZE     CONFIG_NET_ETH_PKTSIZE
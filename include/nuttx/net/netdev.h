@@ -75,6 +75,10 @@
 #  include <nuttx/wqueue.h>
 #endif
 
+#if defined(CONFIG_NETDEV_STATISTICS) && defined(CONFIG_NET_STATISTICS_PERCPU)
+#  include <nuttx/sched.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -102,21 +106,34 @@
 /* Helper macros for network device statistics */
 
 #ifdef CONFIG_NETDEV_STATISTICS
+/* NETDEV_STATS() is the statistics of a device updated by the current CPU,
+ * see netdev_statistics_fold().
+ */
+
+#  ifdef CONFIG_NET_STATISTICS_PERCPU
+#    define NETDEV_STATS(dev) ((dev)->d_statistics[this_cpu()])
+#    define NETDEV_STATS_ALIGNED \
+       aligned_data(CONFIG_NET_STATISTICS_PERCPU_ALIGN)
+#  else
+#    define NETDEV_STATS(dev) ((dev)->d_statistics)
+#    define NETDEV_STATS_ALIGNED
+#  endif
+
 #  define NETDEV_RESET_STATISTICS(dev) \
-     memset(&(dev)->d_statistics, 0, sizeof(struct netdev_statistics_s))
+     memset(&(dev)->d_statistics, 0, sizeof((dev)->d_statistics))
 
-#  define _NETDEV_STATISTIC(dev,name) ((dev)->d_statistics.name++)
+#  define _NETDEV_STATISTIC(dev,name) (NETDEV_STATS(dev).name++)
 #  define _NETDEV_ERROR(dev,name) \
      do \
        { \
-         (dev)->d_statistics.name++; \
-         (dev)->d_statistics.errors++; \
+         NETDEV_STATS(dev).name++; \
+         NETDEV_STATS(dev).errors++; \
        } \
      while (0)
 
 #define _NETDEV_BYTES(dev,name) \
     do { \
-        (dev)->d_statistics.name += (dev)->d_len; \
+        NETDEV_STATS(dev).name += (dev)->d_len; \
     } while (0)
 
 #  if CONFIG_NETDEV_STATISTICS_LOG_PERIOD > 0
@@ -125,10 +142,10 @@
        do \
          { \
            _NETDEV_STATISTIC(dev,name); \
-           if (work_available(&(dev)->d_statistics.logwork)) \
+           if (work_available(&(dev)->d_statlogwork)) \
              { \
                work_queue(NETDEV_STATISTICS_WORK, \
-                          &(dev)->d_statistics.logwork, \
+                          &(dev)->d_statlogwork, \
                           netdev_statistics_log, (dev), \
                           SEC2TICK(CONFIG_NETDEV_STATISTICS_LOG_PERIOD)); \
              } \
@@ -162,6 +179,15 @@
 #    define NETDEV_RXARP(dev)
 #  endif
 #  define NETDEV_RXDROPPED(dev)   _NETDEV_STATISTIC(dev,rx_dropped)
+#  ifdef CONFIG_NETDEV_NAPI
+#    define NETDEV_RXIRQS(dev)    _NETDEV_STATISTIC(dev,rx_irqs)
+#    define NETDEV_RXPOLLS(dev)   _NETDEV_STATISTIC(dev,rx_polls)
+#    define NETDEV_RXBUDGETS(dev) _NETDEV_STATISTIC(dev,rx_budgets)
+#  else
+#    define NETDEV_RXIRQS(dev)
+#    define NETDEV_RXPOLLS(dev)
+#    define NETDEV_RXBUDGETS(dev)
+#  endif
 
 #  define NETDEV_TXPACKETS(dev) \
     do { \
@@ -183,6 +209,9 @@
 #  define NETDEV_RXIPV6(dev)
 #  define NETDEV_RXARP(dev)
 #  define NETDEV_RXDROPPED(dev)
+#  define NETDEV_RXIRQS(dev)
+#  define NETDEV_RXPOLLS(dev)
+#  define NETDEV_RXBUDGETS(dev)
 
 #  define NETDEV_TXPACKETS(dev)
 #  define NETDEV_TXDONE(dev)
@@ -216,6 +245,13 @@
      (netdev_ipv6_lookup(dev, addr, true) != NULL)
 #endif
 
+/* The TCP and UDP checksum offloads of the transmitted packets, see the
+ * d_csumcaps field
+ */
+
+#define NETDEV_CSUM_IPv4 (1 << 0)
+#define NETDEV_CSUM_IPv6 (1 << 1)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -244,6 +280,11 @@ struct netdev_statistics_s
 #endif
   uint32_t rx_dropped;     /* Unsupported Rx packets received */
   uint64_t rx_bytes;       /* Number of bytes received */
+#ifdef CONFIG_NETDEV_NAPI
+  uint32_t rx_irqs;        /* Number of Rx notifications */
+  uint32_t rx_polls;       /* Number of Rx poll iterations */
+  uint32_t rx_budgets;     /* Number of polls that exhausted the budget */
+#endif
 
   /* Tx Status */
 
@@ -256,11 +297,7 @@ struct netdev_statistics_s
   /* Other status */
 
   uint32_t errors;         /* Total number of errors */
-
-#if CONFIG_NETDEV_STATISTICS_LOG_PERIOD > 0
-  struct work_s logwork;   /* For periodic log work */
-#endif
-};
+} NETDEV_STATS_ALIGNED;
 #endif
 
 #if defined(CONFIG_NET_6LOWPAN) || defined(CONFIG_NET_BLUETOOTH) || \
@@ -303,7 +340,8 @@ struct netdev_rss_s
  * instance of this structure.
  */
 
-struct devif_callback_s; /* Forward reference */
+struct devif_callback_s;  /* Forward reference */
+struct netdev_rxfilter_s; /* Forward reference */
 
 struct net_driver_s
 {
@@ -339,6 +377,25 @@ struct net_driver_s
 
   uint16_t d_pktsize;           /* Maximum packet size */
 
+#ifdef CONFIG_NETDEV_GSO
+  /* TCP generic segmentation offload:  Before a TCP super-segment larger
+   * than the MTU is sent, d_gsosize is set to the size of the segments it
+   * is made of.  d_gsomax is the size of the largest super-segment that
+   * the driver accepts, zero if the driver does not support GSO.
+   */
+
+  uint16_t d_gsomax;            /* Largest IP packet of a super-segment */
+  uint16_t d_gsosize;           /* Segment size of the packet in d_iob */
+#endif
+
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+  /* Checksum offload:  The driver sets the NETDEV_CSUM_* flags of the
+   * packets whose TCP and UDP checksums it completes, see io_csumflags.
+   */
+
+  uint8_t d_csumcaps;           /* Checksum offloads of the driver */
+#endif
+
   /* Link layer address */
 
 #if defined(CONFIG_NET_ETHERNET) || defined(CONFIG_NET_6LOWPAN) || \
@@ -474,6 +531,14 @@ struct net_driver_s
 
   uint16_t d_sndlen;
 
+#ifdef CONFIG_NET_CHKSUM_SIMD
+  /* The sum of the d_sndlen bytes of data copied by devif_send_chksum(),
+   * as chksum(), or -1 if the data was not summed.
+   */
+
+  int32_t d_sndsum;
+#endif
+
   /* Multicast group support */
 
 #ifdef CONFIG_NET_IGMP
@@ -486,10 +551,18 @@ struct net_driver_s
 #ifdef CONFIG_NETDEV_STATISTICS
   /* If CONFIG_NETDEV_STATISTICS is enabled and if the driver supports
    * statistics, then this structure holds the counts of network driver
-   * events.
+   * events.  With CONFIG_NET_STATISTICS_PERCPU, each CPU counts in its
+   * own copy.
    */
 
+#  ifdef CONFIG_NET_STATISTICS_PERCPU
+  struct netdev_statistics_s d_statistics[CONFIG_SMP_NCPUS];
+#  else
   struct netdev_statistics_s d_statistics;
+#  endif
+#  if CONFIG_NETDEV_STATISTICS_LOG_PERIOD > 0
+  struct work_s d_statlogwork;  /* For periodic log work */
+#  endif
 #endif
 
 #if defined(CONFIG_NET_TIMESTAMP)
@@ -504,6 +577,12 @@ struct net_driver_s
   struct timespec d_rxtime;
 #endif
 
+#ifdef CONFIG_NETDEV_RXFILTER
+  /* The receive filter rules, set with SIOCSIFRXFILTER */
+
+  FAR struct netdev_rxfilter_s *d_rxfilter;
+#endif
+
   /* Application callbacks:
    *
    * Network device event handlers are retained in a 'list' and are called
@@ -541,6 +620,13 @@ struct net_driver_s
   CODE int (*d_ioctl)(FAR struct net_driver_s *dev, int cmd,
                       unsigned long arg);
 #endif
+#ifdef CONFIG_NET_BUSYPOLL
+  /* Receive the pending frames now, called with the network locked by a
+   * socket that busy polls (SO_BUSY_POLL).
+   */
+
+  CODE int (*d_rxpoll)(FAR struct net_driver_s *dev);
+#endif
 
   /* Drivers may attached device-specific, private information */
 
@@ -1347,4 +1433,50 @@ int netdev_ipv6_foreach(FAR struct net_driver_s *dev,
 void netdev_statistics_log(FAR void *arg);
 #endif
 
+/****************************************************************************
+ * Name: netdev_statistics_fold
+ *
+ * Description:
+ *   Return the statistics of a network device summed over all the CPUs.
+ *
+ * Input Parameters:
+ *   dev   - The network device
+ *   stats - The location to return the statistics
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_STATISTICS
+void netdev_statistics_fold(FAR struct net_driver_s *dev,
+                            FAR struct netdev_statistics_s *stats);
+#endif
+
+/****************************************************************************
+ * Name: netdev_rxfilter
+ *
+ * Description:
+ *   Apply the receive filter rules of a device to a received frame, before
+ *   it is given to the network stack.  Called by the drivers when
+ *   d_rxfilter is not NULL.
+ *
+ * Input Parameters:
+ *   dev    - The receiving device
+ *   data   - The frame, from the start of its link layer header
+ *   len    - The length of the frame available at 'data'
+ *   target - The location to return the output device of
+ *            RXFILTER_REDIRECT
+ *
+ * Returned Value:
+ *   The action of the rule that applies to the frame, RXFILTER_PASS if
+ *   none does.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_RXFILTER
+int netdev_rxfilter(FAR struct net_driver_s *dev, FAR const uint8_t *data,
+                    unsigned int len, FAR struct net_driver_s **target);
+#endif
+
 #endif /* __INCLUDE_NUTTX_NET_NETDEV_H */
@@ -72,6 +72,11 @@
 #define NETPKT_BUFLEN   CONFIG_IOB_BUFSIZE
 #define NETPKT_BUFNUM   CONFIG_IOB_NBUFFERS
 
+/* The TCP segmentation offloads of the lower half, see the tso field */
+
+#define NETDEV_TSO_IPv4 (1 << 0)
+#define NETDEV_TSO_IPv6 (1 << 1)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -119,6 +124,24 @@ struct netdev_lowerhalf_s
 
   atomic_int quota[NETPKT_TYPENUM];
 
+#ifdef CONFIG_NETDEV_GSO
+  /* The TCP super-segments that the hardware segments itself (NETDEV_TSO_*
+   * flags), set before the registration.  These super-segments are passed
+   * to transmit, see netpkt_gsosize().  The upper half segments the others.
+   */
+
+  uint8_t tso;
+#endif
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  /* The number of RX/TX queue pairs, up to CONFIG_NETDEV_MAX_QUEUES, set
+   * before the registration.  The queues of a device with more than one
+   * are served with the transmitq and receiveq operations.
+   */
+
+  uint8_t nqueues;
+#endif
+
   /* The structure used by net stack.
    * Note: Do not change its fields unless you know what you are doing.
    *
@@ -172,6 +195,40 @@ struct netdev_ops_s
   /* reclaim - try to reclaim packets sent by netdev. */
 
   CODE void (*reclaim)(FAR struct netdev_lowerhalf_s *dev);
+
+#ifdef CONFIG_NETDEV_NAPI
+  /* rxint - Disable or enable the RX interrupts of a queue (0 for the
+   *   devices with a single queue).  Optional.  The interrupt must be
+   *   raised when it is enabled while frames are pending.  May be called
+   *   from the interrupt handler that calls netdev_lower_rxready().
+   */
+
+  CODE void (*rxint)(FAR struct netdev_lowerhalf_s *dev,
+                     unsigned int queue, bool enable);
+#endif
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  /* transmitq/receiveq/reclaimq - The same as transmit, receive and
+   *   reclaim on the queue 'queue' of a device with several queues, where
+   *   they replace them.  reclaimq is optional.
+   */
+
+  CODE int (*transmitq)(FAR struct netdev_lowerhalf_s *dev,
+                        FAR netpkt_t *pkt, unsigned int queue);
+  CODE FAR netpkt_t *(*receiveq)(FAR struct netdev_lowerhalf_s *dev,
+                                 unsigned int queue);
+  CODE void (*reclaimq)(FAR struct netdev_lowerhalf_s *dev,
+                        unsigned int queue);
+
+  /* steer - Steer the flow of the RSS hash 'hash' to the RX queue 'queue'
+   *   (program the indirection table of the hardware).  Optional, called
+   *   instead of ioctl(SIOCNOTIFYRECVCPU) for the devices with several
+   *   queues.
+   */
+
+  CODE int (*steer)(FAR struct netdev_lowerhalf_s *dev, uint32_t hash,
+                    unsigned int queue);
+#endif
 };
 
 /* This structure is a set of wireless handlers, leave unsupported operations
@@ -308,6 +365,27 @@ void netdev_lower_rxready(FAR struct netdev_lowerhalf_s *dev);
 
 void netdev_lower_txdone(FAR struct netdev_lowerhalf_s *dev);
 
+/****************************************************************************
+ * Name: netdev_lower_rxready_queue/netdev_lower_txdone_queue
+ *
+ * Description:
+ *   The same as netdev_lower_rxready() and netdev_lower_txdone() for the
+ *   queue 'queue' of a device with several queues:  Only the worker of the
+ *   queue is woken up.
+ *
+ * Input Parameters:
+ *   dev   - The lower half device driver structure
+ *   queue - The queue, below nqueues
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+void netdev_lower_rxready_queue(FAR struct netdev_lowerhalf_s *dev,
+                                unsigned int queue);
+void netdev_lower_txdone_queue(FAR struct netdev_lowerhalf_s *dev,
+                               unsigned int queue);
+#endif
+
 /****************************************************************************
  * Name: netdev_lower_quota_load
  *
@@ -357,6 +435,25 @@ FAR netpkt_t *netpkt_alloc(FAR struct netdev_lowerhalf_s *dev,
 void netpkt_free(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt,
                  enum netpkt_type_e type);
 
+/****************************************************************************
+ * Name: netpkt_concat
+ *
+ * Description:
+ *   Append the data of a netpkt to another one, for the frames that the
+ *   device spreads over several buffers.  'next' is then part of 'pkt' and
+ *   is released with it.
+ *
+ * Input Parameters:
+ *   dev  - The lower half device driver structure
+ *   pkt  - The packet to extend
+ *   next - The packet appended to 'pkt'
+ *   type - Whether used for TX or RX
+ *
+ ****************************************************************************/
+
+void netpkt_concat(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt,
+                   FAR netpkt_t *next, enum netpkt_type_e type);
+
 /****************************************************************************
  * Name: netpkt_copyin
  *
@@ -476,6 +573,81 @@ unsigned int netpkt_getdatalen(FAR struct netdev_lowerhalf_s *dev,
 void netpkt_reset_reserved(FAR struct netdev_lowerhalf_s *dev,
                            FAR netpkt_t *pkt, unsigned int len);
 
+/****************************************************************************
+ * Name: netpkt_gsosize
+ *
+ * Description:
+ *   Get the size of the segments of a TCP super-segment, to be used in the
+ *   transmit method of a lower half that supports TSO.  The IP and TCP
+ *   headers of the super-segment are those of its first segment, with the
+ *   length and the checksums of the whole super-segment.
+ *
+ * Input Parameters:
+ *   dev    - The lower half device driver structure
+ *   pkt    - The net packet being transmitted
+ *
+ * Returned Value:
+ *   The segment size, zero if the packet is not a super-segment.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_GSO
+uint16_t netpkt_gsosize(FAR struct netdev_lowerhalf_s *dev,
+                        FAR netpkt_t *pkt);
+#else
+#  define netpkt_gsosize(dev, pkt) 0
+#endif
+
+/****************************************************************************
+ * Name: netpkt_txcsum
+ *
+ * Description:
+ *   Get the TCP or UDP checksum to be completed by a lower half that
+ *   advertises checksum offloads in the d_csumcaps field of its netdev:
+ *   The device sums the data from 'start' to the end of the packet, the
+ *   checksum field holding the sum of the pseudo-header included, and
+ *   stores the complement of the result at 'offset' in this data, 0xffff
+ *   instead of zero.
+ *
+ * Input Parameters:
+ *   dev    - The lower half device driver structure
+ *   pkt    - The net packet being transmitted
+ *   start  - The offset of the data from netpkt_getdata()
+ *   offset - The offset of the checksum field from 'start'
+ *
+ * Returned Value:
+ *   True if the checksum is to be completed, false if the packet is sent
+ *   as it is.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+bool netpkt_txcsum(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt,
+                   FAR uint16_t *start, FAR uint16_t *offset);
+#else
+#  define netpkt_txcsum(dev, pkt, start, offset) false
+#endif
+
+/****************************************************************************
+ * Name: netpkt_rxcsum_verified
+ *
+ * Description:
+ *   Tell that the device verified the TCP or UDP checksum of a received
+ *   packet, TCP and UDP do not verify it again.
+ *
+ * Input Parameters:
+ *   dev    - The lower half device driver structure
+ *   pkt    - The net packet received
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+void netpkt_rxcsum_verified(FAR struct netdev_lowerhalf_s *dev,
+                            FAR netpkt_t *pkt);
+#else
+#  define netpkt_rxcsum_verified(dev, pkt)
+#endif
+
 /****************************************************************************
  * Name: netpkt_is_fragmented
  *
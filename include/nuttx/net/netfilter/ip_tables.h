@@ -84,6 +84,15 @@
        (entry) = (FAR struct ipt_entry *) \
                      ((FAR uint8_t *)(entry) + (entry)->next_offset))
 
+/* Iterate the matches of an entry, up to its target. */
+
+#define ipt_match_for_every(match, entry) \
+  for ((match) = IPT_MATCH(entry); \
+       (FAR uint8_t *)(match) + sizeof(struct xt_entry_match) <= \
+       (FAR uint8_t *)IPT_TARGET(entry) && (match)->u.match_size > 0; \
+       (match) = (FAR struct xt_entry_match *) \
+                     ((FAR uint8_t *)(match) + (match)->u.match_size))
+
 /* Get pointer to match / target from an entry pointer. */
 
 #define IPT_MATCH(e) \
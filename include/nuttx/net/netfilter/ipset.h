@@ -0,0 +1,153 @@
+/****************************************************************************
+ * include/nuttx/net/netfilter/ipset.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_NET_NETFILTER_IPSET_H
+#define __INCLUDE_NUTTX_NET_NETFILTER_IPSET_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <netinet/in.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The IPPROTO_IP socket option of the sets, as Linux.  The requests of the
+ * option start with the operation and the protocol version.
+ */
+
+#define SO_IP_SET              83
+
+#define IPSET_PROTOCOL         6
+#define IPSET_MAXNAMELEN       32
+#define IPSET_INVALID_ID       65535
+
+/* Operations of getsockopt(SO_IP_SET), as Linux */
+
+#define IP_SET_OP_GET_BYNAME   0x00000006 /* Get the index of a set by name */
+#define IP_SET_OP_GET_BYINDEX  0x00000007 /* Get the name of a set by index */
+#define IP_SET_OP_VERSION      0x00000100 /* Get the protocol version */
+
+/* Operations that Linux does through nfnetlink:  The requests of these
+ * operations are given to setsockopt(SO_IP_SET), except IP_SET_OP_TEST
+ * that is given to getsockopt(SO_IP_SET) and fails with ENOENT if the
+ * element is not in the set.
+ */
+
+#define IP_SET_OP_CREATE       0x00001000 /* struct ip_set_req_create */
+#define IP_SET_OP_DESTROY      0x00001001 /* struct ip_set_req_get_set */
+#define IP_SET_OP_FLUSH        0x00001002 /* struct ip_set_req_get_set */
+#define IP_SET_OP_ADD          0x00001003 /* struct ip_set_req_elem */
+#define IP_SET_OP_DEL          0x00001004 /* struct ip_set_req_elem */
+#define IP_SET_OP_TEST         0x00001005 /* struct ip_set_req_elem */
+
+/* The types of the sets */
+
+#define IPSET_TYPE_HASH_IP     1 /* hash:ip, IPv4 addresses */
+#define IPSET_TYPE_HASH_IPPORT 2 /* hash:ip,port, addresses and ports */
+#define IPSET_TYPE_HASH_NET    3 /* hash:net, networks of any prefix */
+#define IPSET_TYPE_RANGE_IP    4 /* Ranges of addresses, as intervals */
+
+/* The flags of struct xt_set_info, as Linux:  Bit 0 inverts the match, bit
+ * n selects the source (or else destination) address or port for the n-th
+ * dimension of the set.
+ */
+
+#define IPSET_INV_MATCH        (1 << 0)
+#define IPSET_DIM_ONE_SRC      (1 << 1)
+#define IPSET_DIM_TWO_SRC      (1 << 2)
+
+#define IPSET_DIM_MAX          6
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+typedef uint16_t ip_set_id_t;
+
+/* The data of the "set" match of iptables (revision 1), as Linux */
+
+struct xt_set_info
+{
+  ip_set_id_t index;  /* The set */
+  uint8_t     dim;    /* The dimensions to match, 1 or 2 */
+  uint8_t     flags;  /* IPSET_INV_MATCH and IPSET_DIM_*_SRC */
+};
+
+struct xt_set_info_match_v1
+{
+  struct xt_set_info match_set;
+};
+
+/* The requests of SO_IP_SET */
+
+struct ip_set_req_version
+{
+  unsigned int op;
+  unsigned int version;
+};
+
+union ip_set_name_index
+{
+  char        name[IPSET_MAXNAMELEN];
+  ip_set_id_t index;
+};
+
+struct ip_set_req_get_set
+{
+  unsigned int op;
+  unsigned int version;
+  union ip_set_name_index set;
+};
+
+struct ip_set_req_create
+{
+  unsigned int op;
+  unsigned int version;
+  char         name[IPSET_MAXNAMELEN];
+  uint8_t      type;                  /* IPSET_TYPE_* */
+};
+
+/* An element of a set: 'ip' for all the types, 'ip' to 'ip_to' for the
+ * ranges (or 'ip' alone if 'ip_to' is zero), 'ip' and 'cidr' for the
+ * networks (/32 if 'cidr' is zero), and 'ip', 'proto' and 'port' for the
+ * addresses and ports (IPPROTO_TCP if 'proto' is zero).  The addresses and
+ * the port are in network order.
+ */
+
+struct ip_set_req_elem
+{
+  unsigned int op;
+  unsigned int version;
+  ip_set_id_t  index;
+  in_addr_t    ip;
+  in_addr_t    ip_to;
+  uint16_t     port;
+  uint8_t      proto;
+  uint8_t      cidr;
+};
+
+#endif /* __INCLUDE_NUTTX_NET_NETFILTER_IPSET_H */
@@ -68,6 +68,7 @@
 #define XT_MATCH_NAME_UDP       "udp"
 #define XT_MATCH_NAME_ICMP      "icmp"
 #define XT_MATCH_NAME_ICMP6     "icmp6"
+#define XT_MATCH_NAME_SET       "set"
 
 /* Table name to simplify our code */
 
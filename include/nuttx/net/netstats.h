@@ -45,6 +45,7 @@
 
 #include <stdint.h>
 
+#include <nuttx/compiler.h>
 #include <nuttx/net/netconfig.h>
 
 #include <nuttx/net/ip.h>
@@ -69,10 +70,29 @@
 
 #ifdef CONFIG_NET_STATISTICS
 
+#ifdef CONFIG_NET_STATISTICS_PERCPU
+#  include <nuttx/sched.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* NET_STATS() is a counter of the statistics, e.g. NET_STATS(tcp.drop).
+ * With CONFIG_NET_STATISTICS_PERCPU each CPU updates its own copy of the
+ * statistics, in its own cache lines, and the copies are summed by
+ * net_stats_fold() when they are read.  NET_STATS() is then the counter of
+ * the current CPU.
+ */
+
+#ifdef CONFIG_NET_STATISTICS_PERCPU
+#  define NET_STATS(f)      (g_netstats_percpu[this_cpu()].f)
+#  define NET_STATS_ALIGNED aligned_data(CONFIG_NET_STATISTICS_PERCPU_ALIGN)
+#else
+#  define NET_STATS(f)      (g_netstats.f)
+#  define NET_STATS_ALIGNED
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -114,7 +134,7 @@ struct net_stats_s
 #ifdef CONFIG_NET_UDP
   struct udp_stats_s  udp;      /* UDP statistics */
 #endif
-};
+} NET_STATS_ALIGNED;
 
 /****************************************************************************
  * Public Data
@@ -122,11 +142,29 @@ struct net_stats_s
 
 /* This is the structure in which the statistics are gathered. */
 
+#ifdef CONFIG_NET_STATISTICS_PERCPU
+extern struct net_stats_s g_netstats_percpu[CONFIG_SMP_NCPUS];
+#else
 extern struct net_stats_s g_netstats;
+#endif
 
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: net_stats_fold
+ *
+ * Description:
+ *   Return the statistics summed over all the CPUs.  The counters are not
+ *   read atomically with respect to each other.
+ *
+ * Input Parameters:
+ *   stats - The location to return the statistics
+ *
+ ****************************************************************************/
+
+void net_stats_fold(FAR struct net_stats_s *stats);
+
 #endif /* CONFIG_NET_STATISTICS */
 #endif /* __INCLUDE_NUTTX_NET_NETSTATS_H */
@@ -0,0 +1,92 @@
+/****************************************************************************
+ * include/nuttx/net/rxfilter.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_NET_RXFILTER_H
+#define __INCLUDE_NUTTX_NET_RXFILTER_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The actions of the rules */
+
+#define RXFILTER_PASS       0  /* Give the frame to the network stack */
+#define RXFILTER_DROP       1  /* Free the frame */
+#define RXFILTER_REDIRECT   2  /* Transmit the frame on rr_ifindex */
+
+/* The maximum number of matches of a rule */
+
+#define RXFILTER_MAXMATCH   4
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* A match compares the 32-bit word at rm_offset bytes from the start of
+ * the link layer header of a frame, in network order, masked with rm_mask,
+ * to rm_value.  The frames too short for the word do not match.
+ */
+
+struct rxfilter_match_s
+{
+  uint16_t rm_offset;              /* The offset of the word in the frame */
+  uint32_t rm_mask;                /* The bits compared */
+  uint32_t rm_value;               /* The value of the compared bits */
+};
+
+/* A rule applies its action to the frames that pass all its matches.  The
+ * rules of a device are tried in order, until one applies; The frames that
+ * no rule applies to are given to the network stack.
+ */
+
+struct rxfilter_rule_s
+{
+  uint8_t  rr_nmatch;              /* The number of matches in rr_match */
+  uint8_t  rr_action;              /* RXFILTER_* */
+  uint16_t rr_ifindex;             /* The output device of
+                                    * RXFILTER_REDIRECT */
+  uint32_t rr_hits;                /* The frames the rule applied to,
+                                    * returned by SIOCGIFRXFILTER */
+  struct rxfilter_match_s rr_match[RXFILTER_MAXMATCH];
+};
+
+/* The argument of SIOCSIFRXFILTER and SIOCGIFRXFILTER, in ifr_data.
+ * SIOCSIFRXFILTER replaces the rules of the device, no rule removes the
+ * filter.  SIOCGIFRXFILTER returns up to rf_nrules rules in rf_rules and
+ * sets rf_nrules to the number of rules of the device.
+ */
+
+struct rxfilter_s
+{
+  uint16_t rf_nrules;              /* The number of rules in rf_rules */
+  FAR struct rxfilter_rule_s *rf_rules;
+};
+
+#endif /* __INCLUDE_NUTTX_NET_RXFILTER_H */
@@ -31,6 +31,7 @@
 #include <nuttx/fs/ioctl.h>
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <sys/types.h>
 
 /****************************************************************************
@@ -54,6 +55,10 @@
  * NOTERAM_SETREADMODE
  *              - Set read mode
  *                Argument: A read-only pointer to unsigned int
+ * NOTERAM_GETSTATS
+ *              - Get the lost notes of each CPU
+ *                Argument: A writable pointer to an array of
+ *                          CONFIG_SMP_NCPUS struct noteram_stats_s
  */
 
 #ifdef CONFIG_DRIVERS_NOTERAM
@@ -62,6 +67,7 @@
 #define NOTERAM_SETMODE         _NOTERAMIOC(0x03)
 #define NOTERAM_GETREADMODE     _NOTERAMIOC(0x04)
 #define NOTERAM_SETREADMODE     _NOTERAMIOC(0x05)
+#define NOTERAM_GETSTATS        _NOTERAMIOC(0x06)
 #endif
 
 /* Overwrite mode definitions */
@@ -81,6 +87,14 @@
 
 struct noteram_driver_s;
 
+/* The notes lost by a CPU since the buffer was last cleared */
+
+struct noteram_stats_s
+{
+  uint32_t ns_dropped;          /* Notes not recorded, the buffer is full */
+  uint32_t ns_overwritten;      /* Old notes overwritten by new ones */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
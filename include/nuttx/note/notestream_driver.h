@@ -26,20 +26,82 @@
  ****************************************************************************/
 
 #include <nuttx/note/note_driver.h>
+#include <nuttx/sched.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/streams.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* The compact encoding of the notes (CONFIG_DRIVERS_NOTESTREAM_COMPACT).
+ * The integers are LEB128 varints, the signed ones zigzag encoded.  Each
+ * record starts with a type byte:
+ *
+ *   NOTESTREAM_COMPACT_SYNC
+ *     The magic "NXTC", the version byte, the size of a pointer byte, the
+ *     varint frequency of the time stamps and the varint time stamp of
+ *     the stream.  The decoder state is reset:  The records that follow
+ *     do not depend on those before, a host may start decoding there.
+ *   NOTESTREAM_COMPACT_STRING
+ *     The varint identifier and the varint length of a task name, then
+ *     the name.  It replaces the name of a previous identifier.
+ *   Any other type is the nc_type of a note, followed by
+ *     A flags byte, NOTESTREAM_COMPACT_* for the fields that changed
+ *     The signed varint time stamp delta from the previous record
+ *     The cpu byte, the varint pid and the priority byte if they changed
+ *     The varint length of the payload, then the payload:  The note
+ *     after its common header, in the layout of the target, but the name
+ *     of NOTE_START that is replaced by the varint identifier of the
+ *     name.
+ */
+
+#define NOTESTREAM_COMPACT_MAGIC   "NXTC"
+#define NOTESTREAM_COMPACT_VERSION 1
+
+#define NOTESTREAM_COMPACT_SYNC    0xff /* Record types */
+#define NOTESTREAM_COMPACT_STRING  0xfe
+
+#define NOTESTREAM_COMPACT_CPU     (1 << 0) /* Record flags */
+#define NOTESTREAM_COMPACT_PID     (1 << 1)
+#define NOTESTREAM_COMPACT_PRIO    (1 << 2)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+#ifdef CONFIG_DRIVERS_NOTESTREAM_COMPACT
+/* A task name interned in the compact stream */
+
+struct notestream_name_s
+{
+  uint32_t hash;                          /* Zero if the entry is unused */
+  char     name[CONFIG_TASK_NAME_SIZE + 1];
+};
+
+/* The state of the compact encoding of a stream */
+
+struct notestream_compact_s
+{
+  spinlock_t lock;
+  uint32_t   nrecords;                    /* Records since the last sync */
+  clock_t    systime;                     /* Of the previous record */
+  pid_t      pid;
+  uint8_t    cpu;
+  uint8_t    priority;
+#  if CONFIG_TASK_NAME_SIZE > 0
+  struct notestream_name_s names[CONFIG_DRIVERS_NOTESTREAM_COMPACT_NAMES];
+#  endif
+};
+#endif
+
 struct notestream_driver_s
 {
   struct note_driver_s driver;
   struct lib_outstream_s *stream;
+#ifdef CONFIG_DRIVERS_NOTESTREAM_COMPACT
+  struct notestream_compact_s compact;
+#endif
 };
 
 #if defined(__cplusplus)
@@ -165,6 +165,17 @@ struct nxbe_window_s
 
   uint8_t flags;
 
+#ifdef CONFIG_NX_CLIPCACHE
+  /* The parts of the window that are not obscured by the windows above,
+   * valid while clipgen matches the clipgen of the back-end state.
+   */
+
+  uint16_t nclip;                     /* Number of rectangles in clip[] */
+  uint16_t mxclip;                    /* The capacity of clip[] */
+  uint32_t clipgen;                   /* Generation of clip[] */
+  FAR struct nxgl_rect_s *clip;       /* The visible rectangles */
+#endif
+
 #ifdef CONFIG_NX_RAMBACKED
   /* Per-window framebuffer support */
 
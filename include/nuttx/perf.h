@@ -704,6 +704,15 @@ enum perf_event_type_e
   PERF_RECORD_MAX,      /* non-ABI */
 };
 
+#if defined(CONFIG_SCHED_PERF_EVENTS_CALLCHAIN) && \
+    CONFIG_SCHED_PERF_EVENTS_CALLCHAIN > 0
+struct perf_callchain_entry
+{
+  uint64_t nr;                                 /* Number of the addresses */
+  uint64_t ip[CONFIG_SCHED_PERF_EVENTS_CALLCHAIN];
+};
+#endif
+
 struct perf_sample_data_s
 {
 /* Fields set by perf_sample_data_init() unconditionally,
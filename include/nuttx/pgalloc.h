@@ -79,6 +79,18 @@
 #define MM_NPAGES(s)      (((uintptr_t)(s) + MM_PGMASK) >> MM_PGSHIFT)
 #define MM_ISALIGNED(a)   (((uintptr_t)(a) & MM_PGMASK) == 0)
 
+/* Huge pages */
+
+#ifdef CONFIG_MM_HUGEPAGE
+#  define MM_HUGEPGSHIFT        21
+#  define MM_HUGEPGSIZE         (1 << MM_HUGEPGSHIFT)
+#  define MM_HUGEPGMASK         (MM_HUGEPGSIZE - 1)
+#  define MM_HUGEPGPAGES        (1 << (MM_HUGEPGSHIFT - MM_PGSHIFT))
+#  define MM_HUGEPGALIGNDOWN(a) ((uintptr_t)(a) & ~MM_HUGEPGMASK)
+#  define MM_HUGEPGALIGNUP(a)   (((uintptr_t)(a) + MM_HUGEPGMASK) & ~MM_HUGEPGMASK)
+#  define MM_NHUGEPAGES(s)      (((uintptr_t)(s) + MM_HUGEPGMASK) >> MM_HUGEPGSHIFT)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -166,6 +178,27 @@ void mm_pgreserve(uintptr_t start, size_t size);
 
 uintptr_t mm_pgalloc(unsigned int npages);
 
+/****************************************************************************
+ * Name: mm_pgalloc_contig
+ *
+ * Description:
+ *   Allocate a large physically contiguous buffer, e.g. for the DMA of a
+ *   camera or video driver.  With CONFIG_MM_PGALLOC_CMA_NPAGES, the pages
+ *   set aside for these buffers are used first, so that they can still be
+ *   allocated when the other pages are fragmented.  The buffer is freed
+ *   with mm_pgfree().
+ *
+ * Input Parameters:
+ *   npages - The number of pages to allocate, each of size CONFIG_MM_PGSIZE.
+ *
+ * Returned Value:
+ *   On success, a non-zero, physical address of the allocated page memory
+ *   is returned.  Zero is returned on failure.
+ *
+ ****************************************************************************/
+
+uintptr_t mm_pgalloc_contig(unsigned int npages);
+
 /****************************************************************************
  * Name: mm_pgfree
  *
@@ -203,6 +236,56 @@ void mm_pgfree(uintptr_t paddr, unsigned int npages);
 
 void mm_pginfo(FAR struct pginfo_s *info);
 
+#ifdef CONFIG_MM_HUGEPAGE
+
+/****************************************************************************
+ * Name: mm_pgalloc_huge
+ *
+ * Description:
+ *   Allocate a huge page of MM_HUGEPGSIZE bytes, aligned to its size, from
+ *   the pool of CONFIG_MM_HUGEPAGE_NPAGES huge pages.
+ *
+ * Returned Value:
+ *   On success, a non-zero, physical address of the huge page is returned.
+ *   Zero is returned if the pool is empty.
+ *
+ ****************************************************************************/
+
+uintptr_t mm_pgalloc_huge(void);
+
+/****************************************************************************
+ * Name: mm_pgfree_huge
+ *
+ * Description:
+ *   Return a huge page allocated by mm_pgalloc_huge() to its pool.
+ *
+ * Input Parameters:
+ *   paddr - The physical address of the huge page.
+ *
+ ****************************************************************************/
+
+void mm_pgfree_huge(uintptr_t paddr);
+
+/****************************************************************************
+ * Name: mm_pghuge_initialize
+ *
+ * Description:
+ *   Set aside the pool of huge pages at the end of the region of the page
+ *   allocator, called by mm_pginitialize().
+ *
+ * Input Parameters:
+ *   start - The physical address of the start of the region
+ *   end   - The physical address of the end of the region
+ *
+ * Returned Value:
+ *   The new end of the region, below the pool of huge pages.
+ *
+ ****************************************************************************/
+
+uintptr_t mm_pghuge_initialize(uintptr_t start, uintptr_t end);
+
+#endif /* CONFIG_MM_HUGEPAGE */
+
 #undef EXTERN
 #ifdef __cplusplus
 }
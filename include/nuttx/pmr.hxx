@@ -0,0 +1,244 @@
+//***************************************************************************
+// include/nuttx/pmr.hxx
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed to the Apache Software Foundation (ASF) under one or more
+// contributor license agreements.  See the NOTICE file distributed with
+// this work for additional information regarding copyright ownership.  The
+// ASF licenses this file to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance with the
+// License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//***************************************************************************
+
+#ifndef __INCLUDE_NUTTX_PMR_HXX
+#define __INCLUDE_NUTTX_PMR_HXX
+
+//***************************************************************************
+// Included Files
+//***************************************************************************
+
+#include <nuttx/config.h>
+
+#include <cstddef>
+#include <memory_resource>
+
+#include <nuttx/compiler.h>
+#include <nuttx/mm/mempool.h>
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_LIBXX_PMR
+
+//***************************************************************************
+// Public Types
+//***************************************************************************
+
+// Memory resources for the std::pmr containers, backed by the allocators
+// of NuttX:
+//
+//   mempool_resource          - Blocks of one size from a mempool, for the
+//                               nodes of lists, maps and sets.
+//   heap_resource             - A private mm heap, for the data of one
+//                               subsystem or one thread.
+//   thread_heap_resource()    - The heap_resource of the calling thread.
+//   static_monotonic_resource - A monotonic buffer in a static array, that
+//                               can be located in a chosen RAM section.
+//
+// All of them return memory to the global heap through lib_malloc and
+// lib_free only, so they can be used in any build mode.
+
+namespace nuttx
+{
+namespace pmr
+{
+
+//***************************************************************************
+// Name: mempool_resource
+//
+// Description:
+//   Allocate the requests of up to 'blocksize' bytes from a mempool, that
+//   starts with 'initialsize' bytes of blocks and grows by 'expandsize'
+//   bytes when it is empty (or not at all if 'expandsize' is zero).  The
+//   larger requests, and those that need a stronger alignment than the
+//   blocks have, are passed to 'upstream'.  The pool is safe to share
+//   between threads.
+//
+//***************************************************************************
+
+class mempool_resource : public std::pmr::memory_resource
+{
+public:
+  mempool_resource(std::size_t blocksize, std::size_t initialsize,
+                   std::size_t expandsize,
+                   std::pmr::memory_resource *upstream =
+                     std::pmr::get_default_resource());
+  ~mempool_resource() override;
+
+  mempool_resource(const mempool_resource &) = delete;
+  mempool_resource &operator=(const mempool_resource &) = delete;
+
+  std::size_t blocksize() const noexcept
+  {
+    return m_pool.blocksize;
+  }
+
+  std::pmr::memory_resource *upstream_resource() const noexcept
+  {
+    return m_upstream;
+  }
+
+protected:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void *p, std::size_t bytes,
+                     std::size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource &other)
+    const noexcept override;
+
+private:
+  bool fits(std::size_t bytes, std::size_t alignment) const noexcept
+  {
+    return bytes <= m_pool.blocksize && alignment <= m_align;
+  }
+
+  struct mempool_s m_pool;
+  std::size_t m_align;
+  std::pmr::memory_resource *m_upstream;
+};
+
+//***************************************************************************
+// Name: heap_resource
+//
+// Description:
+//   Allocate from a private mm heap, named 'name', in 'size' bytes from the
+//   global heap, or in the region ['start', 'start' + 'size') that the
+//   caller provides and that outlives the resource.  The memory is not
+//   given back to the global heap before the resource is destroyed, and all
+//   allocations must be released before then.
+//
+//***************************************************************************
+
+class heap_resource : public std::pmr::memory_resource
+{
+public:
+  heap_resource(const char *name, std::size_t size);
+  heap_resource(const char *name, void *start, std::size_t size);
+  ~heap_resource() override;
+
+  heap_resource(const heap_resource &) = delete;
+  heap_resource &operator=(const heap_resource &) = delete;
+
+  struct mm_heap_s *heap() const noexcept
+  {
+    return m_heap;
+  }
+
+protected:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void *p, std::size_t bytes,
+                     std::size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource &other)
+    const noexcept override;
+
+private:
+  struct mm_heap_s *m_heap;
+  void *m_region;
+};
+
+//***************************************************************************
+// Name: static_monotonic_resource
+//
+// Description:
+//   A std::pmr::monotonic_buffer_resource in an array of 'Size' bytes of
+//   its own, that falls back to 'upstream' when the array is used up.
+//   Declare it with locate_data() to place the array in a RAM section of
+//   the board, for example:
+//
+//     static nuttx::pmr::static_monotonic_resource<4096>
+//       g_msgbuf locate_data(".sram2");
+//
+//***************************************************************************
+
+template <std::size_t Size>
+class static_monotonic_resource
+  : public std::pmr::monotonic_buffer_resource
+{
+public:
+  explicit static_monotonic_resource(std::pmr::memory_resource *upstream =
+                                       std::pmr::null_memory_resource())
+    : std::pmr::monotonic_buffer_resource(m_buffer, Size, upstream)
+  {
+  }
+
+  static_monotonic_resource(const static_monotonic_resource &) = delete;
+  static_monotonic_resource &
+  operator=(const static_monotonic_resource &) = delete;
+
+private:
+  alignas(std::max_align_t) unsigned char m_buffer[Size];
+};
+
+//***************************************************************************
+// Public Function Prototypes
+//***************************************************************************
+
+//***************************************************************************
+// Name: thread_heap_resource
+//
+// Description:
+//   Return the heap_resource of the calling thread, created with
+//   CONFIG_LIBXX_PMR_THREAD_HEAPSIZE bytes on the first call.  The heap is
+//   destroyed when the thread exits, so the memory must not be passed to
+//   other threads that may outlive it.
+//
+// Returned Value:
+//   The resource, or NULL if it could not be created.
+//
+//***************************************************************************
+
+heap_resource *thread_heap_resource() noexcept;
+
+#ifdef CONFIG_LIBXX_PMR_NEW
+//***************************************************************************
+// Name: set_new_resource
+//
+// Description:
+//   Allocate the objects of the global operator new from 'r' from now on,
+//   or from the global heap if 'r' is NULL.  The objects are given back by
+//   operator delete to the resource they were allocated from, so 'r' must
+//   outlive them.  'r' must not allocate through operator new itself, as
+//   std::pmr::new_delete_resource() does.
+//
+// Returned Value:
+//   The previous resource.
+//
+//***************************************************************************
+
+std::pmr::memory_resource *set_new_resource(std::pmr::memory_resource *r)
+  noexcept;
+
+//***************************************************************************
+// Name: get_new_resource
+//
+// Description:
+//   Return the resource of the global operator new, NULL for the global
+//   heap.
+//
+//***************************************************************************
+
+std::pmr::memory_resource *get_new_resource() noexcept;
+#endif
+
+} // namespace pmr
+} // namespace nuttx
+
+#endif // CONFIG_LIBXX_PMR
+#endif // __INCLUDE_NUTTX_PMR_HXX
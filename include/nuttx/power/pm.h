@@ -98,6 +98,12 @@
 #define PM_WAKELOCK_DECLARE_STATIC(var, name, domain, state) \
 static struct pm_wakelock_s var = {name, domain, state}
 
+#define PM_QOS_DECLARE(var, name, domain, latency) \
+      struct pm_qos_s var = {name, domain, latency}
+
+#define PM_QOS_DECLARE_STATIC(var, name, domain, latency) \
+static struct pm_qos_s var = {name, domain, latency}
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -386,6 +392,18 @@ struct pm_wakelock_s
 #endif
 };
 
+/* A QoS constraint of a driver or a task on the time that the latency
+ * governor may need to resume its domain from a low power state.
+ */
+
+struct pm_qos_s
+{
+  FAR const char *name;
+  int domain;
+  uint32_t latency;            /* The maximum exit latency (us) */
+  struct dq_entry_s node;
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -463,6 +481,74 @@ FAR const struct pm_governor_s *pm_greedy_governor_initialize(void);
 
 FAR const struct pm_governor_s *pm_activity_governor_initialize(void);
 
+/****************************************************************************
+ * Name: pm_latency_governor_initialize
+ *
+ * Description:
+ *   Return the latency governor instance.
+ *
+ * Returned Value:
+ *   A pointer to the governor struct. Otherwise NULL is returned on error.
+ *
+ ****************************************************************************/
+
+FAR const struct pm_governor_s *pm_latency_governor_initialize(void);
+
+#ifdef CONFIG_PM_GOVERNOR_LATENCY
+
+/****************************************************************************
+ * Name: pm_qos_add
+ *
+ * Description:
+ *   Add a QoS constraint on the exit latency of the domain qos->domain:
+ *   Until it is removed, the latency governor only chooses the states that
+ *   resume within qos->latency microseconds.
+ *
+ * Input Parameters:
+ *   qos - The QoS constraint, e.g. declared with PM_QOS_DECLARE()
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void pm_qos_add(FAR struct pm_qos_s *qos);
+
+/****************************************************************************
+ * Name: pm_qos_update
+ *
+ * Description:
+ *   Change the exit latency allowed by a QoS constraint.
+ *
+ * Input Parameters:
+ *   qos     - The QoS constraint, added with pm_qos_add()
+ *   latency - The maximum exit latency in microseconds
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void pm_qos_update(FAR struct pm_qos_s *qos, uint32_t latency);
+
+/****************************************************************************
+ * Name: pm_qos_remove
+ *
+ * Description:
+ *   Remove a QoS constraint added with pm_qos_add().
+ *
+ * Input Parameters:
+ *   qos - The QoS constraint
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void pm_qos_remove(FAR struct pm_qos_s *qos);
+
+#endif /* CONFIG_PM_GOVERNOR_LATENCY */
+
 /****************************************************************************
  * Name: pm_set_governor
  *
@@ -0,0 +1,166 @@
+/****************************************************************************
+ * include/nuttx/rcu.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_RCU_H
+#define __INCLUDE_NUTTX_RCU_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <nuttx/spinlock.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Publish a pointer to an RCU protected object.  All initialization of the
+ * object is visible to readers before the pointer itself.
+ */
+
+#define rcu_assign_pointer(p, v) \
+  do \
+    { \
+      SP_DMB(); \
+      (p) = (v); \
+    } \
+  while (0)
+
+/* Fetch a pointer to an RCU protected object inside of a read-side
+ * critical section.  Dependent loads are ordered on all supported
+ * architectures so no barrier is needed.
+ */
+
+#define rcu_dereference(p) (p)
+
+#ifndef CONFIG_RCU
+/* Without RCU there are no lock-free readers that writers have to wait
+ * for.
+ */
+
+#  define synchronize_rcu()
+#endif
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_RCU
+/* Deferred callback of call_rcu().  Usually embedded in the object that is
+ * freed by the callback.
+ */
+
+struct rcu_head;
+typedef CODE void (*rcu_callback_t)(FAR struct rcu_head *head);
+
+struct rcu_head
+{
+  FAR struct rcu_head *next;     /* Next pending callback */
+  rcu_callback_t func;           /* Function to call after a grace period */
+};
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+#ifdef CONFIG_RCU
+
+/****************************************************************************
+ * Name: rcu_read_lock
+ *
+ * Description:
+ *   Enter an RCU read-side critical section.  Objects reached through
+ *   rcu_dereference() inside of the section are not freed before the
+ *   section is left.  Read-side critical sections may nest and may be used
+ *   from interrupt handlers, but must not block:  pre-emption is disabled
+ *   on the local CPU until rcu_read_unlock() is called.
+ *
+ ****************************************************************************/
+
+void rcu_read_lock(void);
+
+/****************************************************************************
+ * Name: rcu_read_unlock
+ *
+ * Description:
+ *   Leave an RCU read-side critical section.
+ *
+ ****************************************************************************/
+
+void rcu_read_unlock(void);
+
+/****************************************************************************
+ * Name: synchronize_rcu
+ *
+ * Description:
+ *   Wait for a grace period:  return when all RCU read-side critical
+ *   sections that were entered before the call have been left.  After
+ *   unpublishing an object, the caller may then free it.
+ *
+ * Assumptions:
+ *   Called from a task, not from an interrupt handler or from within a
+ *   read-side critical section.  The caller may sleep.
+ *
+ ****************************************************************************/
+
+void synchronize_rcu(void);
+
+/****************************************************************************
+ * Name: call_rcu
+ *
+ * Description:
+ *   Call 'func' with 'head' after a grace period.  This is the non-blocking
+ *   version of synchronize_rcu() and the callback runs on the low priority
+ *   work queue.
+ *
+ * Input Parameters:
+ *   head - Storage for the pending callback, usually part of the object
+ *   func - The function to call, usually frees the object
+ *
+ * Assumptions:
+ *   May be called from interrupt handlers.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+void call_rcu(FAR struct rcu_head *head, rcu_callback_t func);
+#endif
+
+#endif /* CONFIG_RCU */
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_RCU_H */
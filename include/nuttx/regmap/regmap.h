@@ -41,6 +41,39 @@
 
 struct regmap_bus_s;
 
+/* The type of the register cache of a regmap */
+
+enum regcache_type_e
+{
+  REGCACHE_NONE,                /* No cache, all accesses hit the bus */
+  REGCACHE_FLAT,                /* Array of all registers up to max_register */
+  REGCACHE_RBTREE               /* Sparse blocks of registers in a tree */
+};
+
+/* A range of registers, from range_min to range_max included */
+
+struct regmap_range_s
+{
+  unsigned int range_min;
+  unsigned int range_max;
+};
+
+/* The value of a register after reset */
+
+struct reg_default_s
+{
+  unsigned int reg;
+  unsigned int def;
+};
+
+/* One register write of regmap_multi_reg_write() */
+
+struct reg_sequence_s
+{
+  unsigned int reg;
+  unsigned int def;
+};
+
 /* Single byte register read/write. */
 
 typedef CODE int (*reg_read_t)(FAR struct regmap_bus_s *bus,
@@ -100,6 +133,33 @@ struct regmap_config_s
    */
 
   bool disable_locking;
+
+  /* The register cache, REGCACHE_NONE if unset.  Reads of cached
+   * registers and writes that don't change them don't access the bus.
+   */
+
+  enum regcache_type_e cache_type;
+
+  /* The highest register address, mandatory for REGCACHE_FLAT.  Registers
+   * above it are not cached.  Zero means no limit for REGCACHE_RBTREE.
+   */
+
+  unsigned int max_register;
+
+  /* The registers that the device changes by itself (status, interrupt
+   * flags, FIFOs...) and that must not be cached.
+   */
+
+  FAR const struct regmap_range_s *volatile_table;
+  unsigned int num_volatile;
+
+  /* The register values after reset, to fill the cache initially and to
+   * skip the registers that still have them in regcache_sync() after
+   * regcache_mark_dirty().
+   */
+
+  FAR const struct reg_default_s *reg_defaults;
+  unsigned int num_reg_defaults;
 };
 
 struct regmap_s;
@@ -312,6 +372,136 @@ int regmap_read(FAR struct regmap_s *map, unsigned int reg,
 int regmap_bulk_read(FAR struct regmap_s *map, unsigned int reg,
                      FAR void *val, unsigned int val_count);
 
+/****************************************************************************
+ * Name: regmap_update_bits
+ *
+ * Description:
+ *   Read-modify-write of the bits 'mask' of a register.  The register is
+ *   read from the cache if it is cached, and not written if it does not
+ *   change.
+ *
+ * Input Parameters:
+ *   map  - regmap handler, from regmap bus init function return.
+ *   reg  - register address to be updated.
+ *   mask - the bits to update.
+ *   val  - the new value of the bits.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int regmap_update_bits(FAR struct regmap_s *map, unsigned int reg,
+                       unsigned int mask, unsigned int val);
+
+/****************************************************************************
+ * Name: regmap_multi_reg_write
+ *
+ * Description:
+ *   Write a sequence of registers.  Writes to consecutive registers are
+ *   coalesced into one bus transfer if the bus supports bulk writes.
+ *
+ * Input Parameters:
+ *   map      - regmap handler, from regmap bus init function return.
+ *   regs     - the registers and values to be written, in order.
+ *   num_regs - the number of registers.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int regmap_multi_reg_write(FAR struct regmap_s *map,
+                           FAR const struct reg_sequence_s *regs,
+                           unsigned int num_regs);
+
+/****************************************************************************
+ * Name: regmap_write_async
+ *
+ * Description:
+ *   Write a register without waiting for the bus:  A cached register is
+ *   only written to the cache and its writes are coalesced with those of
+ *   the other registers written asynchronously in regmap_async_complete().
+ *   Other registers are written immediately.
+ *
+ * Input Parameters:
+ *   map - regmap handler, from regmap bus init function return.
+ *   reg - register address to be write.
+ *   val - write data.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int regmap_write_async(FAR struct regmap_s *map, unsigned int reg,
+                       unsigned int val);
+
+/****************************************************************************
+ * Name: regmap_async_complete
+ *
+ * Description:
+ *   Write to the device all registers written with regmap_write_async().
+ *
+ * Input Parameters:
+ *   map - regmap handler, from regmap bus init function return.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int regmap_async_complete(FAR struct regmap_s *map);
+
+/****************************************************************************
+ * Name: regcache_cache_only
+ *
+ * Description:
+ *   Enable or disable the cache only mode, e.g. while the device is
+ *   suspended:  Writes to cached registers only update the cache, and
+ *   accesses to volatile registers fail with -EBUSY.
+ *
+ * Input Parameters:
+ *   map    - regmap handler, from regmap bus init function return.
+ *   enable - true to enable the cache only mode.
+ *
+ ****************************************************************************/
+
+void regcache_cache_only(FAR struct regmap_s *map, bool enable);
+
+/****************************************************************************
+ * Name: regcache_mark_dirty
+ *
+ * Description:
+ *   Tell the cache that the device was reset, e.g. because it lost power
+ *   while suspended:  regcache_sync() then writes back all cached
+ *   registers that differ from their reset value.
+ *
+ * Input Parameters:
+ *   map - regmap handler, from regmap bus init function return.
+ *
+ ****************************************************************************/
+
+void regcache_mark_dirty(FAR struct regmap_s *map);
+
+/****************************************************************************
+ * Name: regcache_sync
+ *
+ * Description:
+ *   Write back to the device the cached registers that were only written
+ *   to the cache, e.g. after resume.  Consecutive registers are coalesced
+ *   into one bus transfer if the bus supports bulk writes.
+ *
+ * Input Parameters:
+ *   map - regmap handler, from regmap bus init function return.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int regcache_sync(FAR struct regmap_s *map);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
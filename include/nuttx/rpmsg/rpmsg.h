@@ -102,6 +102,19 @@ extern "C"
 int rpmsg_wait(FAR struct rpmsg_endpoint *ept, FAR sem_t *sem);
 int rpmsg_post(FAR struct rpmsg_endpoint *ept, FAR sem_t *sem);
 
+/* Zero-copy messages:  rpmsg_reserve() returns a tx buffer of the shared
+ * memory, its size in *len, once the 'ready' semaphore (if any) posted at
+ * the endpoint binding is available.  The message is built in place and
+ * sent with rpmsg_commit(), which gives the buffer back on failure.  A
+ * received buffer is kept beyond the endpoint callback with
+ * rpmsg_hold_rx_buffer() and given back by rpmsg_release_rx_buffer().
+ */
+
+FAR void *rpmsg_reserve(FAR struct rpmsg_endpoint *ept, FAR sem_t *ready,
+                        FAR uint32_t *len);
+int rpmsg_commit(FAR struct rpmsg_endpoint *ept, FAR void *msg,
+                 uint32_t len);
+
 FAR const char *rpmsg_get_local_cpuname(FAR struct rpmsg_device *rdev);
 FAR const char *rpmsg_get_cpuname(FAR struct rpmsg_device *rdev);
 
@@ -29,6 +29,10 @@
 
 #include <nuttx/mutex.h>
 
+#ifdef CONFIG_RWSEM_PERCPU
+#  include <nuttx/atomic.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -41,6 +45,18 @@
  * Public Type Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_RWSEM_PERCPU
+/* The readers that entered on one CPU.  A reader may leave on another CPU,
+ * so only the sum over all CPUs is meaningful.
+ */
+
+union rwsem_percpu_u
+{
+  atomic_int count;
+  char       pad[CONFIG_RWSEM_PERCPU_LINESIZE];
+};
+#endif
+
 typedef struct
 {
   mutex_t protected;    /* Protecting Locks for Read/Write Locked Tables */
@@ -52,6 +68,13 @@ typedef struct
   int     waiter;       /* Waiter Count */
   int     writer;       /* Writer Count */
   int     reader;       /* Reader Count */
+#ifdef CONFIG_RWSEM_PERCPU
+  atomic_int writing;   /* Writers waiting for or holding the lock.  The
+                         * readers are counted in 'percpu' instead of
+                         * 'reader'.
+                         */
+  union rwsem_percpu_u percpu[CONFIG_SMP_NCPUS];
+#endif
 } rw_semaphore_t;
 
 /****************************************************************************
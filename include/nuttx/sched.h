@@ -39,6 +39,7 @@
 
 #include <nuttx/addrenv.h>
 #include <nuttx/clock.h>
+#include <nuttx/hrtimer.h>
 #include <nuttx/irq.h>
 #include <nuttx/mutex.h>
 #include <nuttx/semaphore.h>
@@ -123,6 +124,7 @@
 #  define TCB_FLAG_SCHED_FIFO      (0 << TCB_FLAG_POLICY_SHIFT)  /* FIFO scheding policy */
 #  define TCB_FLAG_SCHED_RR        (1 << TCB_FLAG_POLICY_SHIFT)  /* Round robin scheding policy */
 #  define TCB_FLAG_SCHED_SPORADIC  (2 << TCB_FLAG_POLICY_SHIFT)  /* Sporadic scheding policy */
+#  define TCB_FLAG_SCHED_DEADLINE  (3 << TCB_FLAG_POLICY_SHIFT)  /* Deadline scheding policy */
 #define TCB_FLAG_CPU_LOCKED        (1 << 5)                      /* Bit 5: Locked to this CPU */
 #define TCB_FLAG_SIGNAL_ACTION     (1 << 6)                      /* Bit 6: In a signal handler */
 #define TCB_FLAG_SYSCALL           (1 << 7)                      /* Bit 7: In a system call */
@@ -134,6 +136,8 @@
 #define TCB_FLAG_FORCED_CANCEL     (1 << 13)                     /* Bit 13: Pthread cancel is forced */
 #define TCB_FLAG_JOIN_COMPLETED    (1 << 14)                     /* Bit 14: Pthread join completed */
 #define TCB_FLAG_FREE_TCB          (1 << 15)                     /* Bit 15: Free tcb after exit */
+#define TCB_FLAG_POOL_TCB          (1 << 16)                     /* Bit 16: TCB from the TCB pool */
+#define TCB_FLAG_POOL_STACK        (1 << 17)                     /* Bit 17: Stack from a stack pool */
 
 /* Values for struct task_group tg_flags */
 
@@ -367,6 +371,23 @@ struct sporadic_s
 
 #endif /* CONFIG_SCHED_SPORADIC */
 
+#ifdef CONFIG_SCHED_DEADLINE
+/* This structure holds the parameters of a thread with the deadline
+ * scheduling policy.  All times are in system clock ticks.  The remaining
+ * runtime of the current period is kept in tcb_s::timeslice.
+ */
+
+struct deadline_s
+{
+  bool      blocked;                /* Thread blocked since it last ran      */
+  clock_t   runtime;                /* Execution budget per period           */
+  clock_t   deadline;               /* Relative deadline                     */
+  clock_t   period;                 /* Replenishment period                  */
+  clock_t   absdeadline;            /* Absolute deadline of current period   */
+  uint32_t  bandwidth;              /* Reserved fraction of one CPU          */
+};
+#endif /* CONFIG_SCHED_DEADLINE */
+
 /* struct child_status_s ****************************************************/
 
 /* This structure is used to maintain information about child tasks.
@@ -537,6 +558,11 @@ struct task_group_s
 
   sq_queue_t tg_sigactionq;         /* List of actions for signals              */
   sq_queue_t tg_sigpendingq;        /* List of pending signals                  */
+#if CONFIG_SIG_PREALLOC_GROUP > 0
+  FAR void  *tg_sigpool;            /* Pre-allocated signal structures          */
+  sq_queue_t tg_sigfreeaction;      /* Free pending signal actions of the pool  */
+  sq_queue_t tg_sigfreepending;     /* Free pending signals of the pool         */
+#endif
 #ifdef CONFIG_SIG_DEFAULT
   sigset_t tg_sigdefault;           /* Set of signals set to the default action */
 #endif
@@ -571,6 +597,56 @@ struct task_group_s
   struct mm_map_s tg_mm_map;        /* Task group virtual memory mappings   */
 };
 
+/* struct sched_latency_s ***************************************************/
+
+/* Histogram of the time from when a thread is made ready-to-run until it
+ * runs.  Bucket n counts the latencies from 2^n up to 2^(n+1)
+ * microseconds, bucket 0 also counts the shorter ones.
+ */
+
+#ifdef CONFIG_SCHED_LATENCY
+struct sched_latency_s
+{
+  uint32_t count;                        /* Number of measured wakeups      */
+  uint32_t max;                          /* Maximum latency in microseconds */
+  uint32_t hist[CONFIG_SCHED_LATENCY_NBUCKETS];
+};
+#endif
+
+/* struct idle_poll_s *******************************************************/
+
+/* The polling state of an IDLE task (see CONFIG_SCHED_IDLE_POLL).  The
+ * wakeup request is a perf_gettime() time stamp, zero if there is none.
+ */
+
+#ifdef CONFIG_SCHED_IDLE_POLL
+struct idle_poll_s
+{
+  volatile clock_t wakeup;               /* Pending wakeup request          */
+  uint32_t polls;                        /* Number of polling periods       */
+  uint32_t hits;                         /* Periods ended by a wakeup       */
+  uint32_t maxlat;                       /* Maximum wakeup latency (us)     */
+  uint64_t spin;                         /* Total polling time (us)         */
+};
+#endif
+
+/* struct sched_benchmark_s *************************************************/
+
+/* The result of one benchmark of nxsched_benchmark().  All times are in
+ * nanoseconds.
+ */
+
+#ifdef CONFIG_SCHED_BENCHMARK
+struct sched_benchmark_s
+{
+  FAR const char *name;                  /* Name of the benchmark           */
+  uint32_t samples;                      /* Number of samples               */
+  uint32_t min;                          /* Minimum time                    */
+  uint32_t avg;                          /* Average time                    */
+  uint32_t max;                          /* Maximum time                    */
+};
+#endif
+
 /* struct tcb_s *************************************************************/
 
 /* This is the common part of the task control block (TCB).
@@ -629,6 +705,10 @@ struct tcb_s
   FAR struct semholder_s *holdsem;       /* List of held semaphores         */
 #endif
 
+#ifdef CONFIG_RWSEM_PERCPU
+  int16_t  rdlocks;                      /* Number of rwsem read locks held */
+#endif
+
 #ifdef CONFIG_SMP
   uint8_t  cpu;                          /* CPU index if running/assigned   */
   cpu_set_t affinity;                    /* Bit set of permitted CPUs       */
@@ -640,15 +720,22 @@ struct tcb_s
 #endif
   int16_t  errcode;                      /* Used to pass error information  */
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
   int32_t  timeslice;                    /* RR timeslice OR Sporadic budget */
                                          /* interval remaining              */
 #endif
 #ifdef CONFIG_SCHED_SPORADIC
   FAR struct sporadic_s *sporadic;       /* Sporadic scheduling parameters  */
 #endif
+#ifdef CONFIG_SCHED_DEADLINE
+  struct deadline_s deadline;            /* Deadline scheduling parameters  */
+#endif
 
   struct wdog_s waitdog;                 /* All timed waits use this timer  */
+#ifdef CONFIG_HRTIMER_CLOCKWAIT
+  struct hrtimer_s waithrtimer;          /* Timer of nxsig_clockwait()      */
+#endif
 
   /* Stack-Related Fields ***************************************************/
 
@@ -691,6 +778,13 @@ struct tcb_s
   clock_t ticks;                         /* Number of ticks on this thread  */
 #endif
 
+  /* Wakeup latency support *************************************************/
+
+#ifdef CONFIG_SCHED_LATENCY
+  clock_t ready_start;                   /* Time made ready-to-run, or 0    */
+  struct sched_latency_s latency;        /* Wakeup latency histogram        */
+#endif
+
   /* Pre-emption monitor support ********************************************/
 
 #if CONFIG_SCHED_CRITMONITOR_MAXTIME_THREAD >= 0
@@ -713,6 +807,19 @@ struct tcb_s
   void   *crit_max_caller;               /* Caller of max critical section  */
 #endif
 
+  /* poll() interest set cache *********************************************/
+
+#ifdef CONFIG_FS_POLL_CACHE
+  FAR struct poll_cache_s *pollcache;    /* The polls kept set up, or NULL  */
+#endif
+
+  /* Performance event support ********************************************/
+
+#ifdef CONFIG_SCHED_PERF_EVENTS
+  FAR struct perf_event_context_s *perf_event_ctx; /* Per-task events     */
+  mutex_t perf_event_mutex;              /* Protects perf_event_ctx         */
+#endif
+
   /* State save areas *******************************************************/
 
   /* The form and content of these fields are platform-specific.            */
@@ -831,6 +938,17 @@ begin_packed_struct struct tcbinfo_s
 
 typedef CODE void (*nxsched_foreach_t)(FAR struct tcb_s *tcb, FAR void *arg);
 
+/* This is the callback type used by nxsched_util_register().  The
+ * utilization ranges from 0, idle, to SCHED_UTIL_SCALE, fully busy.
+ */
+
+#ifdef CONFIG_SCHED_UTIL
+#define SCHED_UTIL_SCALE 1024
+
+typedef CODE void (*nxsched_util_t)(int cpu, unsigned int util,
+                                    FAR void *arg);
+#endif
+
 /* This is the callback type used by nxsched_smp_call() */
 
 #ifdef CONFIG_SMP
@@ -872,6 +990,18 @@ EXTERN clock_t g_premp_max[CONFIG_SMP_NCPUS];
 EXTERN clock_t g_crit_max[CONFIG_SMP_NCPUS];
 #endif /* CONFIG_SCHED_CRITMONITOR_MAXTIME_CSECTION >= 0 */
 
+/* Wakeup latency histogram of each CPU. */
+
+#ifdef CONFIG_SCHED_LATENCY
+EXTERN struct sched_latency_s g_sched_latency[CONFIG_SMP_NCPUS];
+#endif
+
+#ifdef CONFIG_SCHED_IDLE_POLL
+/* IDLE polling state and statistics of each CPU */
+
+EXTERN struct idle_poll_s g_idle_poll[CONFIG_SMP_NCPUS];
+#endif
+
 EXTERN const struct tcbinfo_s g_tcbinfo;
 
 /****************************************************************************
@@ -1803,6 +1933,68 @@ int nxsched_smp_call_async(cpu_set_t cpuset,
                            FAR struct smp_call_data_s *data);
 #endif
 
+/****************************************************************************
+ * Name: nxsched_benchmark
+ *
+ * Description:
+ *   Run the benchmarks of the scheduler primitives (see
+ *   CONFIG_SCHED_BENCHMARK).  The benchmarks take a few seconds, during
+ *   which threads of a priority lower than CONFIG_SCHED_BENCHMARK_PRIORITY
+ *   do not run.  Concurrent calls are serialized.
+ *
+ * Input Parameters:
+ *   results  - The location to return the results
+ *   nresults - The maximum number of results to return
+ *
+ * Returned Value:
+ *   The number of results on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_BENCHMARK
+int nxsched_benchmark(FAR struct sched_benchmark_s *results, int nresults);
+#endif
+
+#ifdef CONFIG_SCHED_UTIL
+
+/****************************************************************************
+ * Name: nxsched_get_util
+ *
+ * Description:
+ *   Return the current utilization of a CPU (see CONFIG_SCHED_UTIL).
+ *
+ * Input Parameters:
+ *   cpu - The CPU of interest
+ *
+ * Returned Value:
+ *   The utilization, from 0 to SCHED_UTIL_SCALE.
+ *
+ ****************************************************************************/
+
+unsigned int nxsched_get_util(int cpu);
+
+/****************************************************************************
+ * Name: nxsched_util_register
+ *
+ * Description:
+ *   Register the callback that receives the utilization of the CPU at each
+ *   context switch, or remove it if 'hook' is NULL.  The callback runs in
+ *   the middle of the context switch with interrupts disabled:  It must
+ *   not block nor wake up threads, but it may start a watchdog.
+ *
+ * Input Parameters:
+ *   hook - The callback
+ *   arg  - The argument of the callback
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxsched_util_register(nxsched_util_t hook, FAR void *arg);
+
+#endif /* CONFIG_SCHED_UTIL */
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -31,9 +31,15 @@
 
 #include <errno.h>
 #include <semaphore.h>
+#include <stdbool.h>
 
 #include <nuttx/clock.h>
 
+#ifdef CONFIG_SEM_FASTPATH
+#  include <limits.h>
+#  include <nuttx/atomic.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -87,6 +93,102 @@ struct nsem_inode_s
 
 #ifndef __ASSEMBLY__
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_SEM_FASTPATH
+
+/****************************************************************************
+ * Name: nxsem_fastwait
+ *
+ * Description:
+ *   Take one count of an available semaphore with a single atomic
+ *   operation and without entering the OS.  The semaphore count is the
+ *   word that the OS waits on:  a negative value means that there are
+ *   waiters, which must be handled by nxsem_wait().  Semaphores with
+ *   priority inheritance or priority protection always use the OS because
+ *   it has to track the holders.
+ *
+ * Input Parameters:
+ *   sem - Semaphore descriptor.
+ *
+ * Returned Value:
+ *   True if a count was taken.  False if the caller has to use the OS
+ *   interface.
+ *
+ ****************************************************************************/
+
+static inline_function bool nxsem_fastwait(FAR sem_t *sem)
+{
+  FAR atomic_short *count = (FAR atomic_short *)&sem->semcount;
+  short old;
+
+  if ((sem->flags & SEM_PRIO_MASK) != SEM_PRIO_NONE)
+    {
+      return false;
+    }
+
+  old = atomic_load_explicit(count, memory_order_relaxed);
+  while (old > 0)
+    {
+      if (atomic_compare_exchange_weak_explicit(count, &old, old - 1,
+                                                memory_order_acquire,
+                                                memory_order_relaxed))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: nxsem_fastpost
+ *
+ * Description:
+ *   Release one count of a semaphore that has no waiters with a single
+ *   atomic operation and without entering the OS.  See nxsem_fastwait().
+ *
+ * Input Parameters:
+ *   sem - Semaphore descriptor.
+ *
+ * Returned Value:
+ *   True if the count was released.  False if the caller has to use the OS
+ *   interface, because there are waiters to wake up, the semaphore
+ *   would overflow or the OS tracks the holders of the semaphore.
+ *
+ ****************************************************************************/
+
+static inline_function bool nxsem_fastpost(FAR sem_t *sem)
+{
+  FAR atomic_short *count = (FAR atomic_short *)&sem->semcount;
+  short old;
+
+  if ((sem->flags & SEM_PRIO_MASK) != SEM_PRIO_NONE)
+    {
+      return false;
+    }
+
+  old = atomic_load_explicit(count, memory_order_relaxed);
+  while (old >= 0 && old < SEM_VALUE_MAX)
+    {
+      if (atomic_compare_exchange_weak_explicit(count, &old, old + 1,
+                                                memory_order_release,
+                                                memory_order_relaxed))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+#else
+#  define nxsem_fastwait(sem) false
+#  define nxsem_fastpost(sem) false
+#endif /* CONFIG_SEM_FASTPATH */
+
 #ifdef __cplusplus
 #define EXTERN extern "C"
 extern "C"
@@ -466,4 +466,13 @@
 
 #define SNIOC_GET_EVENTS              _SNIOC(0x009E)
 
+/* Command:      SNIOC_SET_WATERMARK
+ * Description:  Set the number of new samples that wakes up the subscriber,
+ *               0 or 1 wakes it up for every push.  A flush completion
+ *               wakes it up whatever the number of samples.
+ * Argument:     The number of samples, not larger than the buffer number.
+ */
+
+#define SNIOC_SET_WATERMARK           _SNIOC(0x009F)
+
 #endif /* __INCLUDE_NUTTX_SENSORS_IOCTL_H */
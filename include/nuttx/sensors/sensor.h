@@ -636,6 +636,34 @@ extern "C"
 void sensor_remap_vector_raw16(FAR const int16_t *in, FAR int16_t *out,
                                int place);
 
+/****************************************************************************
+ * Name: sensor_push_batch
+ *
+ * Description:
+ *   Lower half driver pushes the samples read at once from a hardware FIFO
+ *   by calling this function, instead of push_event.  The samples share a
+ *   timestamp base:  Their timestamps are set from the timestamp of the
+ *   newest sample and the sampling interval.  The events must start with
+ *   the uint64_t timestamp, as all the events of uorb.h do.
+ *
+ * Input Parameters:
+ *   lower     - The instance of lower half sensor driver.
+ *   data      - The array of the samples, the oldest first.
+ *   esize     - The size of a sample.
+ *   nums      - The number of samples.
+ *   timestamp - The timestamp of the newest sample, in us.
+ *   interval  - The sampling interval, in us.
+ *
+ * Returned Value:
+ *   The bytes of push is returned when success;
+ *   A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+ssize_t sensor_push_batch(FAR struct sensor_lowerhalf_s *lower,
+                          FAR void *data, size_t esize, size_t nums,
+                          uint64_t timestamp, uint32_t interval);
+
 /****************************************************************************
  * "Upper Half" Sensor Driver Interfaces
  ****************************************************************************/
@@ -0,0 +1,185 @@
+/****************************************************************************
+ * include/nuttx/seqlock.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_SEQLOCK_H
+#define __INCLUDE_NUTTX_SEQLOCK_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <nuttx/compiler.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define SEQLOCK_INITIALIZER  {0, SP_UNLOCKED}
+
+/* Order the accesses to the protected data against the accesses to the
+ * sequence count.  SP_DMB() is empty without SMP, but the compiler must
+ * still not move the accesses across an interrupted reader.
+ */
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define SEQ_DMB()          do { __asm__ __volatile__("" ::: "memory"); \
+                                  SP_DMB(); } while (0)
+#else
+#  define SEQ_DMB()          SP_DMB()
+#endif
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+/* A sequence lock protects data that is read much more often than it is
+ * written.  Readers do not take the lock and do not disable interrupts:
+ * they sample the sequence count, copy the data and retry if a writer was
+ * active meanwhile.  Writers are serialized by the spinlock and make the
+ * sequence count odd while they modify the data.
+ *
+ * The protected data must be safe to read while it is being modified
+ * (i.e. no pointers that may be followed) and readers must not have side
+ * effects before they know that the copy is consistent.
+ */
+
+typedef struct
+{
+  volatile uint32_t sequence;  /* Odd while a writer is active */
+  spinlock_t lock;             /* Serializes the writers */
+} seqlock_t;
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: seqlock_init
+ *
+ * Description:
+ *   Initialize a sequence lock.
+ *
+ ****************************************************************************/
+
+static inline_function void seqlock_init(FAR seqlock_t *sl)
+{
+  sl->sequence = 0;
+  spin_lock_init(&sl->lock);
+}
+
+/****************************************************************************
+ * Name: read_seqbegin
+ *
+ * Description:
+ *   Begin a lock-free read of the data protected by 'sl'.
+ *
+ * Returned Value:
+ *   The sequence count to be passed to read_seqretry().
+ *
+ ****************************************************************************/
+
+static inline_function uint32_t read_seqbegin(FAR const seqlock_t *sl)
+{
+  uint32_t seq;
+
+  /* Writers disable interrupts, so a writer holding the lock is always
+   * running on another CPU and will finish soon.
+   */
+
+  while (((seq = sl->sequence) & 1) != 0)
+    {
+    }
+
+  SEQ_DMB();
+  return seq;
+}
+
+/****************************************************************************
+ * Name: read_seqretry
+ *
+ * Description:
+ *   End a lock-free read of the data protected by 'sl'.
+ *
+ * Input Parameters:
+ *   sl    - The sequence lock
+ *   start - The value returned by read_seqbegin()
+ *
+ * Returned Value:
+ *   True if a writer has modified the data meanwhile:  the copy may be
+ *   inconsistent and the read must be repeated.
+ *
+ ****************************************************************************/
+
+static inline_function bool read_seqretry(FAR const seqlock_t *sl,
+                                          uint32_t start)
+{
+  SEQ_DMB();
+  return sl->sequence != start;
+}
+
+/****************************************************************************
+ * Name: write_seqlock_irqsave
+ *
+ * Description:
+ *   Disable local interrupts and get exclusive write access to the data
+ *   protected by 'sl'.  No instrumentation is performed so the timestamps
+ *   of the instrumentation itself may be protected by a sequence lock.
+ *
+ * Returned Value:
+ *   The interrupt state to be passed to write_sequnlock_irqrestore().
+ *
+ ****************************************************************************/
+
+static inline_function irqstate_t write_seqlock_irqsave(FAR seqlock_t *sl)
+{
+  irqstate_t flags = spin_lock_irqsave_wo_note(&sl->lock);
+
+  sl->sequence++;
+  SEQ_DMB();
+  return flags;
+}
+
+/****************************************************************************
+ * Name: write_sequnlock_irqrestore
+ *
+ * Description:
+ *   Relinquish the write access taken by write_seqlock_irqsave() and
+ *   restore the interrupt state.
+ *
+ ****************************************************************************/
+
+static inline_function void write_sequnlock_irqrestore(FAR seqlock_t *sl,
+                                                       irqstate_t flags)
+{
+  SEQ_DMB();
+  sl->sequence++;
+  spin_unlock_irqrestore_wo_note(&sl->lock, flags);
+}
+
+#endif /* __INCLUDE_NUTTX_SEQLOCK_H */
@@ -356,6 +356,10 @@ struct uart_dev_s
   uint8_t timeout;                   /* c_cc[VTIME] */
 #endif
 
+#ifdef CONFIG_SERIAL_RXINPLACE
+  int16_t rxwatermark;               /* Received bytes to wake up readers */
+#endif
+
   FAR struct pollfd *fds[CONFIG_SERIAL_NPOLLWAITERS];
 };
 
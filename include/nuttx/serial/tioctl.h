@@ -32,6 +32,7 @@
  ****************************************************************************/
 
 #include <nuttx/fs/ioctl.h>
+#include <sys/types.h>
 #include <stdint.h>
 
 /****************************************************************************
@@ -200,6 +201,15 @@
 
 #define SER_SWAP_ENABLED   (1 << 0) /* Enable/disable RX/TX swap */
 
+/* In place reception (CONFIG_SERIAL_RXINPLACE):  The receive buffer is
+ * mapped with mmap(), the received data is read there and then released.
+ */
+
+#define TIOCRXPEEK       _TIOC(0x0037)  /* Get the received data: FAR struct serial_rxwindow_s* */
+#define TIOCRXCONSUME    _TIOC(0x0038)  /* Release received data: size_t */
+#define TIOCSRXWATERMARK _TIOC(0x0039)  /* Set the RX wakeup level: int */
+#define TIOCGRXWATERMARK _TIOC(0x003a)  /* Get the RX wakeup level: FAR int* */
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -224,6 +234,16 @@ struct serial_rs485
   uint32_t delay_rts_after_send;   /* Delay after send (milliseconds) */
 };
 
+/* Structure used with TIOCRXPEEK */
+
+struct serial_rxwindow_s
+{
+  off_t  offset;                   /* Of the oldest byte in the mapping */
+  size_t length;                   /* Contiguous bytes from offset */
+  size_t nbuffered;                /* All the bytes, wrapped ones included */
+  size_t size;                     /* Size of the mapping */
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -264,6 +264,47 @@
 
 #define QSPI_FREE(d,b) (d)->ops->free(d,b)
 
+/****************************************************************************
+ * Name: QSPI_MEMMAP
+ *
+ * Description:
+ *   Put the controller in memory-mapped mode:  The memory is then read by
+ *   the CPU at the window returned, the controller issuing the read command
+ *   described by 'meminfo' (the address, length and buffer fields are not
+ *   used) and prefetching the data.  The controller leaves memory-mapped
+ *   mode with QSPI_UNMAP, which must be called before any other command or
+ *   memory transfer.  The QSPI bus must be locked.
+ *
+ * Input Parameters:
+ *   dev     - Device-specific state data
+ *   meminfo - Describes the read command
+ *
+ * Returned Value:
+ *   The base address of the memory-mapped window; NULL if the controller
+ *   does not support memory-mapped mode.
+ *
+ ****************************************************************************/
+
+#define QSPI_MEMMAP(d,m) \
+  (((d)->ops->memmap) ? (d)->ops->memmap(d,m) : NULL)
+
+/****************************************************************************
+ * Name: QSPI_UNMAP
+ *
+ * Description:
+ *   Leave the memory-mapped mode entered with QSPI_MEMMAP.
+ *
+ * Input Parameters:
+ *   dev    - Device-specific state data
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#define QSPI_UNMAP(d) \
+  (((d)->ops->unmap) ? (d)->ops->unmap(d) : (void)0)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -331,6 +372,9 @@ struct qspi_ops_s
                     FAR struct qspi_meminfo_s *meminfo);
   CODE FAR void *(*alloc)(FAR struct qspi_dev_s *dev, size_t buflen);
   CODE void      (*free)(FAR struct qspi_dev_s *dev, FAR void *buffer);
+  CODE FAR void *(*memmap)(FAR struct qspi_dev_s *dev,
+                    FAR const struct qspi_meminfo_s *meminfo);
+  CODE void      (*unmap)(FAR struct qspi_dev_s *dev);
 };
 
 /* QSPI private data.  This structure only defines the initial fields of the
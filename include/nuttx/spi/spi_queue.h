@@ -0,0 +1,189 @@
+/****************************************************************************
+ * include/nuttx/spi/spi_queue.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_SPI_SPI_QUEUE_H
+#define __INCLUDE_NUTTX_SPI_SPI_QUEUE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/queue.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/spi/spi_transfer.h>
+
+#ifdef CONFIG_SPI_QUEUE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Flags of the messages */
+
+#define SPI_MSG_KEEPCS   (1 << 0)  /* Leave the device selected: The next
+                                    * message for the same device continues
+                                    * the transaction, before any other */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* A message queued to a bus:  A sequence of transfers performed with the
+ * bus locked and the device selected, and the completion called once it is
+ * done, from the thread of the queue.  The message and its sequence belong
+ * to the queue until the completion.  The state is zeroed before the first
+ * submission.
+ */
+
+struct spi_msg_s;
+typedef CODE void (*spi_msg_complete_t)(FAR struct spi_msg_s *msg,
+                                        int result);
+
+struct spi_msg_s
+{
+  dq_entry_t                 node;     /* In the pending queue */
+  FAR struct spi_sequence_s *seq;      /* The transfers of the message */
+  spi_msg_complete_t         complete; /* Called at the end of the message */
+  FAR void                  *arg;      /* For the completion */
+  uint8_t                    priority; /* The highest is performed first */
+  uint8_t                    flags;    /* SPI_MSG_* */
+  uint8_t                    state;    /* Private to drivers/spi */
+};
+
+/* The queue of a bus, with the thread that performs its messages */
+
+struct spi_queue_s
+{
+  FAR struct spi_dev_s *spi;           /* The lower half of the bus */
+  spinlock_t            lock;          /* Protects the fields below */
+  dq_queue_t            pending;       /* The messages by priority */
+  sem_t                 wake;          /* Posted for each message */
+  sem_t                 exit;          /* Posted when the thread exits */
+  pid_t                 pid;           /* The thread of the queue */
+  uint32_t              csdev;         /* The device held selected */
+  bool                  cshold;        /* True if csdev is selected */
+  bool                  stop;          /* Ask the thread to exit */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: spi_queue_initialize
+ *
+ * Description:
+ *   Start the thread of the message queue of a bus.  The thread keeps the
+ *   bus locked as long as messages are pending, so that the messages of
+ *   all the devices of the bus follow each other without gaps.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int spi_queue_initialize(FAR struct spi_queue_s *queue,
+                         FAR struct spi_dev_s *spi);
+
+/****************************************************************************
+ * Name: spi_queue_uninitialize
+ *
+ * Description:
+ *   Stop the thread of a message queue.
+ *
+ * Returned Value:
+ *   Zero (OK) on success, -EBUSY if messages are pending.
+ *
+ ****************************************************************************/
+
+int spi_queue_uninitialize(FAR struct spi_queue_s *queue);
+
+/****************************************************************************
+ * Name: spi_queue_submit
+ *
+ * Description:
+ *   Queue a message, after the pending messages of the same or a higher
+ *   priority.  May be called from an interrupt handler, or from a
+ *   completion to chain the messages.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int spi_queue_submit(FAR struct spi_queue_s *queue,
+                     FAR struct spi_msg_s *msg);
+
+/****************************************************************************
+ * Name: spi_queue_cancel
+ *
+ * Description:
+ *   Remove a message that did not start from the queue.  The message is
+ *   not completed and the caller owns it again.
+ *
+ * Returned Value:
+ *   Zero (OK) if the message is canceled, -EBUSY if it started.
+ *
+ ****************************************************************************/
+
+int spi_queue_cancel(FAR struct spi_queue_s *queue,
+                     FAR struct spi_msg_s *msg);
+
+/****************************************************************************
+ * Name: spi_queue_transfer
+ *
+ * Description:
+ *   Perform a sequence of transfers through the queue at a priority, and
+ *   wait for its end:  The equivalent of spi_transfer() for the drivers of
+ *   the devices that share a queued bus.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int spi_queue_transfer(FAR struct spi_queue_s *queue,
+                       FAR struct spi_sequence_s *seq, uint8_t priority);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_SPI_QUEUE */
+#endif /* __INCLUDE_NUTTX_SPI_SPI_QUEUE_H */
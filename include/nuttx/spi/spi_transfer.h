@@ -137,6 +137,27 @@ struct spi_sequence_s
 
 int spi_transfer(FAR struct spi_dev_s *spi, FAR struct spi_sequence_s *seq);
 
+/****************************************************************************
+ * Name: spi_transfer_locked
+ *
+ * Description:
+ *   Perform a sequence of SPI transfers like spi_transfer(), on a bus that
+ *   the caller locked.  The transfers that continue each other in memory
+ *   are coalesced into a single exchange.
+ *
+ * Input Parameters:
+ *   spi    - An instance of the SPI device to use for the transfer
+ *   seq    - Describes the sequence of transfers.
+ *   keepcs - Leave the device selected at the end of the sequence.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int spi_transfer_locked(FAR struct spi_dev_s *spi,
+                        FAR struct spi_sequence_s *seq, bool keepcs);
+
 /****************************************************************************
  * Name: spi_register
  *
@@ -29,9 +29,13 @@
 
 #include <nuttx/compiler.h>
 
+#include <stdbool.h>
 #ifdef CONFIG_LIBC_LZF
 #include <lzf.h>
 #endif
+#ifdef CONFIG_LIBC_LZ4
+#include <lz4.h>
+#endif
 #include <stdio.h>
 #ifndef CONFIG_DISABLE_MOUNTPOINT
 #include <nuttx/fs/fs.h>
@@ -67,6 +71,10 @@
 #define LZF_STREAM_BLOCKSIZE  ((1 << CONFIG_STREAM_LZF_BLOG) - 1)
 #endif
 
+#ifdef CONFIG_LIBC_LZ4
+#define LZ4_STREAM_BLOCKSIZE  (1 << CONFIG_STREAM_LZ4_BLOG)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -288,6 +296,23 @@ struct lib_lzfoutstream_s
 };
 #endif
 
+/* LZ4 compressed stream pipeline */
+
+#ifdef CONFIG_LIBC_LZ4
+struct lib_lz4outstream_s
+{
+  struct lib_outstream_s      common;
+  FAR struct lib_outstream_s *backend;
+  lz4_state_t                 state;
+  size_t                      offset;
+  bool                        started; /* The frame header is written */
+  uint8_t                     in[LZ4_STREAM_BLOCKSIZE];
+  uint8_t                     out[LZ4_FRAME_HDR_SIZE +
+                                  LZ4_FRAME_BLKHDR_SIZE +
+                                  LZ4_STREAM_BLOCKSIZE];
+};
+#endif
+
 #ifndef CONFIG_DISABLE_MOUNTPOINT
 struct lib_blkoutstream_s
 {
@@ -604,6 +629,27 @@ void lib_lzfoutstream(FAR struct lib_lzfoutstream_s *stream,
                       FAR struct lib_outstream_s *backend);
 #endif
 
+/****************************************************************************
+ * Name: lib_lz4outstream
+ *
+ * Description:
+ *  LZ4 compressed pipeline stream, in the LZ4 frame format
+ *
+ * Input Parameters:
+ *   stream  - User allocated, uninitialized instance of struct
+ *                lib_lz4outstream_s to be initialized.
+ *   backend - Stream backend port.
+ *
+ * Returned Value:
+ *   None (User allocated instance initialized).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_LZ4
+void lib_lz4outstream(FAR struct lib_lz4outstream_s *stream,
+                      FAR struct lib_outstream_s *backend);
+#endif
+
 /****************************************************************************
  * Name: lib_blkoutstream_open
  *
@@ -736,6 +782,21 @@ int lib_sprintf(FAR struct lib_outstream_s *stream,
 int lib_bsprintf(FAR struct lib_outstream_s *s, FAR const IPTR char *fmt,
                  FAR const void *buf);
 
+/****************************************************************************
+ * Name: lib_vbspack
+ *
+ * Description:
+ *  Pack the arguments of a format in 'buf' for lib_bsprintf(), so that the
+ *  message can be formatted later.  The strings are copied.
+ *
+ * Returned Value:
+ *   The number of bytes packed, -E2BIG if they do not fit in 'size' bytes.
+ *
+ ****************************************************************************/
+
+int lib_vbspack(FAR void *buf, size_t size, FAR const IPTR char *fmt,
+                va_list ap);
+
 /****************************************************************************
  * Name: lib_sprintf_internal
  *
@@ -29,6 +29,8 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -57,6 +59,21 @@ struct symtab_s
   FAR const void *sym_value; /* The value associated with the string */
 };
 
+/* struct symtab_hash_s is the hash index of a symbol table built by
+ * symtab_hashinit(), for the lookups in constant time of
+ * symtab_findbyhash().
+ */
+
+struct symtab_hash_s
+{
+  FAR const struct symtab_s *symtab; /* The indexed symbol table */
+  int nsyms;                         /* Number of symbols in the table */
+  uint32_t nbuckets;                 /* Number of buckets, a power of 2 */
+  FAR uint32_t *buckets;             /* Start of each bucket in chain[] */
+  FAR uint32_t *chain;               /* Hashes grouped by bucket */
+  FAR uint32_t *index;               /* Position in symtab[] of each */
+};
+
 /****************************************************************************
  * Public Functions Definitions
  ****************************************************************************/
@@ -121,6 +138,64 @@ symtab_findbyvalue(FAR const struct symtab_s *symtab,
 
 void symtab_sortbyname(FAR struct symtab_s *symtab, int nsyms);
 
+#ifdef CONFIG_SYMTAB_HASH
+
+/****************************************************************************
+ * Name: symtab_hash
+ *
+ * Description:
+ *   Return the hash of a symbol name, that of the GNU hash sections of ELF.
+ *
+ ****************************************************************************/
+
+uint32_t symtab_hash(FAR const char *name);
+
+/****************************************************************************
+ * Name: symtab_hashinit
+ *
+ * Description:
+ *   Build the hash index of a symbol table.  The symbol table must not be
+ *   changed while the index is used.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if the index cannot be allocated.
+ *
+ ****************************************************************************/
+
+int symtab_hashinit(FAR struct symtab_hash_s *hash,
+                    FAR const struct symtab_s *symtab, int nsyms);
+
+/****************************************************************************
+ * Name: symtab_hashfree
+ *
+ * Description:
+ *   Free the hash index built by symtab_hashinit().
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void symtab_hashfree(FAR struct symtab_hash_s *hash);
+
+/****************************************************************************
+ * Name: symtab_findbyhash
+ *
+ * Description:
+ *   Find the symbol with the matching name through the hash index of the
+ *   symbol table, the same entry as symtab_findbyname().
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if an entry with the matching
+ *   name is found; NULL is returned if the entry is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *
+symtab_findbyhash(FAR const struct symtab_hash_s *hash,
+                  FAR const char *name);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -91,6 +91,10 @@ extern "C"
 
 typedef CODE void (*tls_dtor_t)(FAR void *);
 
+#ifdef CONFIG_SCHED_VDSO
+struct vdso_data_s;
+#endif
+
 /* This structure encapsulates all variables associated with getopt(). */
 
 struct getopt_s
@@ -149,6 +153,10 @@ struct task_info_s
 #ifdef CONFIG_PTHREAD_ATFORK
   struct list_node ta_atfork; /* Holds the pthread_atfork_s list */
 #endif
+
+#ifdef CONFIG_SCHED_VDSO
+  FAR struct vdso_data_s *ta_vdso; /* Time data shared by the kernel */
+#endif
 };
 
 /* struct tls_cleanup_s *****************************************************/
@@ -223,6 +231,18 @@ struct tls_info_s
 
   uint16_t tl_size;                    /* Actual size with alignments */
   int tl_errno;                        /* Per-thread error number */
+
+#ifdef CONFIG_SCHED_VDSO
+  /* Maintained by the kernel so that getpid(), gettid() and sched_getcpu()
+   * do not need a system call.
+   */
+
+  pid_t tl_pid;                        /* ID of the task group */
+  pid_t tl_tid;                        /* ID of the thread */
+#  ifdef CONFIG_SMP
+  int tl_cpu;                          /* CPU the thread is running on */
+#  endif
+#endif
 };
 
 /****************************************************************************
@@ -33,8 +33,10 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <limits.h>
+#include <string.h>
 
 #include <nuttx/sensors/ioctl.h>
+#include <nuttx/spinlock.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -1128,6 +1130,22 @@ struct sensor_ustate_s
   uint64_t generation;         /* The recent generation of circular buffer */
 };
 
+/* This structure describes the ring of the samples of a sensor, returned by
+ * mmap() when CONFIG_SENSORS_RING is enabled.  The nbuffer samples follow
+ * the structure.  The counters are free running numbers of samples:  The
+ * publisher sets wpos before it overwrites the samples and head once they
+ * are published, so a subscriber reads the ring without any system call
+ * with sensor_ring_read().
+ */
+
+struct sensor_ring_s
+{
+  uint32_t          esize;     /* The element size of the ring */
+  uint32_t          nbuffer;   /* The number of samples of the ring */
+  volatile uint32_t head;      /* The samples published */
+  volatile uint32_t wpos;      /* The samples being published */
+};
+
 /* This structure describes the register info for the user sensor */
 
 #ifdef CONFIG_USENSOR
@@ -1219,4 +1237,79 @@ struct sensor_device_info_s
   char          vendor[SENSOR_INFO_NAME_SIZE];
 };
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sensor_ring_read
+ *
+ * Description:
+ *   Copy up to 'max' samples of a mapped ring, from the sample '*pos' on
+ *   or from the oldest sample still in the ring if the subscriber fell
+ *   behind, and advance '*pos'.  The samples overwritten by the publisher
+ *   during the copy are dropped.  '*pos' starts at the head of the ring.
+ *
+ * Returned Value:
+ *   The number of samples copied, zero if there is no new sample.
+ *
+ ****************************************************************************/
+
+static inline_function size_t
+sensor_ring_read(FAR const struct sensor_ring_s *ring, FAR uint32_t *pos,
+                 FAR void *buf, size_t max)
+{
+  FAR const uint8_t *data = (FAR const uint8_t *)(ring + 1);
+  FAR uint8_t *out = (FAR uint8_t *)buf;
+  uint32_t head;
+  uint32_t skip;
+  size_t nums;
+  size_t i;
+
+  for (; ; )
+    {
+      head = ring->head;
+      SP_DMB();
+
+      if (head - *pos > ring->nbuffer)
+        {
+          *pos = head - ring->nbuffer;
+        }
+
+      nums = head - *pos;
+      if (nums > max)
+        {
+          nums = max;
+        }
+
+      for (i = 0; i < nums; i++)
+        {
+          memcpy(out + i * ring->esize,
+                 data + ((*pos + i) % ring->nbuffer) * ring->esize,
+                 ring->esize);
+        }
+
+      /* The samples before wpos - nbuffer were overwritten meanwhile */
+
+      SP_DMB();
+      skip = ring->wpos - ring->nbuffer - *pos;
+      if ((int32_t)skip <= 0)
+        {
+          break;
+        }
+      else if (skip < nums)
+        {
+          nums -= skip;
+          memmove(out, out + skip * ring->esize, nums * ring->esize);
+          *pos += skip;
+          break;
+        }
+
+      *pos += skip;
+    }
+
+  *pos += nums;
+  return nums;
+}
+
 #endif /* __INCLUDE_NUTTX_SENSORS_SENSOR_H */
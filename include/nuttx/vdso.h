@@ -0,0 +1,58 @@
+/****************************************************************************
+ * include/nuttx/vdso.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_VDSO_H
+#define __INCLUDE_NUTTX_VDSO_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <time.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/seqlock.h>
+
+#ifdef CONFIG_SCHED_VDSO
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The time data that the kernel shares with user space.  It is allocated
+ * from the user heap once by clock_initialize() and is reachable from all
+ * task groups through task_info_s::ta_vdso.  The kernel updates it on each
+ * timer tick and when the time-of-day is set; user space only reads it,
+ * retrying while the sequence lock is held.
+ */
+
+struct vdso_data_s
+{
+  seqlock_t       vd_lock;     /* Readers retry while the data changes */
+  clock_t         vd_ticks;    /* The system timer at the last update */
+  struct timespec vd_basetime; /* The time-of-day at power up */
+};
+
+#endif /* CONFIG_SCHED_VDSO */
+#endif /* __INCLUDE_NUTTX_VDSO_H */
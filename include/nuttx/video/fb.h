@@ -319,6 +319,24 @@
                                               /* Argument: writable struct
                                                *           fb_fix_screeninfo */
 
+/* Swap chain ***************************************************************/
+
+#ifdef CONFIG_VIDEO_FB_SWAPCHAIN
+#  define FBIO_ACQUIRE        _FBIOC(0x001d)  /* Acquire a buffer to render
+                                               * Argument: writable struct
+                                               *           fb_swapbuf_s */
+#  define FBIO_PRESENT        _FBIOC(0x001e)  /* Queue an acquired buffer
+                                               * for display
+                                               * Argument: read/write struct
+                                               *           fb_swapbuf_s */
+#  define FBIO_RELEASE        _FBIOC(0x001f)  /* Release an acquired buffer
+                                               * without displaying it
+                                               * Argument: read-only struct
+                                               *           fb_swapbuf_s */
+#  define FBIO_WAITFENCE      _FBIOC(0x0020)  /* Wait for a fence
+                                               * Argument:        uint32_t */
+#endif
+
 #define FB_TYPE_PACKED_PIXELS        0      /* Packed Pixels */
 #define FB_TYPE_PLANES               1      /* Non interleaved planes */
 #define FB_TYPE_INTERLEAVED_PLANES   2      /* Interleaved planes */
@@ -527,6 +545,21 @@ struct fb_planeinfo_s
   uint32_t   yoffset;      /* Offset from virtual to visible resolution */
 };
 
+#ifdef CONFIG_VIDEO_FB_SWAPCHAIN
+/* This structure describes a buffer of the swap chain of the selected
+ * plane or overlay:  The buffers are the screens of the virtual resolution,
+ * buffer 'index' starts at row 'yoffset'.  FBIO_PRESENT returns in 'fence'
+ * the value that FBIO_WAITFENCE waits for until the buffer is displayed.
+ */
+
+struct fb_swapbuf_s
+{
+  uint8_t    index;        /* Index of the buffer */
+  uint32_t   yoffset;      /* First row of the buffer */
+  uint32_t   fence;        /* Signalled once the buffer is displayed */
+};
+#endif
+
 /* This structure describes an area. */
 
 struct fb_area_s
@@ -751,6 +784,24 @@ struct fb_vtable_s
   int (*waitforvsync)(FAR struct fb_vtable_s *vtable);
 #endif
 
+#ifdef CONFIG_FB_HWBLIT
+  /* The following are provided only if the video hardware has a 2D
+   * blitter.  They draw into the plane memory described by 'pinfo' and
+   * return when the area is drawn, or return -ENOTSUP for an area or a
+   * pixel format the blitter does not handle:  The caller then draws it.
+   * The color is in the pixel format of the plane, 'src' points to the
+   * first pixel of the area in the source image.
+   */
+
+  int (*fillarea)(FAR struct fb_vtable_s *vtable,
+                  FAR const struct fb_planeinfo_s *pinfo,
+                  FAR const struct fb_area_s *area, uint32_t color);
+  int (*copyarea)(FAR struct fb_vtable_s *vtable,
+                  FAR const struct fb_planeinfo_s *pinfo,
+                  FAR const struct fb_area_s *area,
+                  FAR const void *src, size_t srcstride);
+#endif
+
 #ifdef CONFIG_FB_OVERLAY
   /* Get information about the video controller configuration and the
    * configuration of each overlay.
@@ -44,6 +44,17 @@
 /* Virtio common feature bits */
 
 #define VIRTIO_F_ANY_LAYOUT   27
+#define VIRTIO_F_RING_EVENT_IDX 29
+
+/* The ring features negotiated by the transports for all the drivers, the
+ * rings are handled by the OpenAMP virtqueue.
+ */
+
+#ifdef CONFIG_DRIVERS_VIRTIO_EVENT_IDX
+#  define VIRTIO_TRANSPORT_FEATURES (1ULL << VIRTIO_F_RING_EVENT_IDX)
+#else
+#  define VIRTIO_TRANSPORT_FEATURES 0
+#endif
 
 /* Virtio helper functions */
 
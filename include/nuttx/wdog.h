@@ -334,6 +334,24 @@ int wd_cancel_irq(FAR struct wdog_s *wdog);
 
 sclock_t wd_gettime(FAR struct wdog_s *wdog);
 
+/****************************************************************************
+ * Name: wd_getnext
+ *
+ * Description:
+ *   This function returns the time remaining before the next watchdog
+ *   timer expires, for example to choose how deep to sleep when idle.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The time in system ticks remaining until the next watchdog expires,
+ *   zero if it has already expired, or -1 if no watchdog is active.
+ *
+ ****************************************************************************/
+
+sclock_t wd_getnext(void);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
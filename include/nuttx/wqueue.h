@@ -415,6 +415,51 @@ int work_queue_wq(FAR struct kwork_wqueue_s *wqueue,
                   FAR struct work_s *work, worker_t worker,
                   FAR void *arg, clock_t delay);
 
+/****************************************************************************
+ * Name: work_queue_on
+ *
+ * Description:
+ *   Queue work like work_queue(), but to the worker thread bound to 'cpu'.
+ *   Without CONFIG_SCHED_WORKQUEUE_PERCPU, or if 'cpu' is out of range,
+ *   this is the same as work_queue().  The work may still run on another
+ *   CPU if it is cancelled and queued again with work_queue().
+ *
+ * Input Parameters:
+ *   qid    - The work queue ID (must be HPWORK or LPWORK)
+ *   cpu    - The CPU to perform the work on, usually this_cpu()
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.
+ *   arg    - The argument that will be passed to the worker callback.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+int work_queue_on(int qid, int cpu, FAR struct work_s *work,
+                  worker_t worker, FAR void *arg, clock_t delay);
+
+/****************************************************************************
+ * Name: work_queue_bind_wq
+ *
+ * Description:
+ *   Bind all worker threads of a work queue to one CPU.
+ *
+ * Input Parameters:
+ *   wqueue - The work queue handle
+ *   cpu    - The CPU to run the worker threads on
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+int work_queue_bind_wq(FAR struct kwork_wqueue_s *wqueue, int cpu);
+#endif
+
 /****************************************************************************
  * Name: work_queue_pri
  *
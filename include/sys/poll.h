@@ -158,6 +158,10 @@ int poll_fdsetup(int fd, FAR struct pollfd *fds, bool setup);
 void poll_default_cb(FAR struct pollfd *fds);
 void poll_notify(FAR struct pollfd **afds, int nfds, pollevent_t eventset);
 
+#ifdef CONFIG_FS_POLL_CACHE
+int poll_cache_wait(FAR struct pollfd *fds, nfds_t nfds, int timeout);
+#endif
+
 #if CONFIG_FORTIFY_SOURCE > 0
 fortify_function(poll) int poll(FAR struct pollfd *fds,
                                 nfds_t nfds, int timeout)
@@ -136,9 +136,13 @@
 #define MSG_ERRQUEUE     0x002000 /* Fetch message from error queue.  */
 #define MSG_NOSIGNAL     0x004000 /* Do not generate SIGPIPE.  */
 #define MSG_MORE         0x008000 /* Sender will send more.  */
+#define MSG_WAITFORONE   0x010000 /* recvmmsg(): Block for the first
+                                   * message only.  */
 #define MSG_CMSG_CLOEXEC 0x100000 /* Set close_on_exit for file
                                    * descriptor received through SCM_RIGHTS.
                                    */
+#define MSG_ZEROCOPY    0x4000000 /* Send without copying the data, see
+                                   * SO_ZEROCOPY.  */
 
 /* Protocol levels supported by get/setsockopt(): */
 
@@ -220,6 +224,15 @@
 #define SO_PEERCRED     18 /* Return the credentials of the peer process
                             * connected to this socket.
                             */
+#define SO_BUSY_POLL    19 /* Busy poll the network devices before blocking
+                            * in a receive or poll (get/set).
+                            * arg: integer value, in microseconds
+                            */
+#define SO_ZEROCOPY     20 /* Let the MSG_ZEROCOPY sends refer to the data of
+                            * the caller until it is acknowledged (get/set).
+                            * arg: pointer to integer containing a boolean
+                            * value
+                            */
 
 /* The options are unsupported but included for compatibility
  * and portability
@@ -242,6 +255,14 @@
 #define SOL_SCO         17 /* See options in include/netpacket/bluetooth.h */
 #define SOL_RFCOMM      18 /* See options in include/netpacket/bluetooth.h */
 
+/* Packet socket operations. */
+
+#define SOL_PACKET      263 /* See options in include/netpacket/packet.h */
+
+/* Unix domain socket operations. */
+
+#define SOL_LOCAL       264 /* See options in include/sys/un.h */
+
 /* Protocol-level socket options may begin with this value */
 
 #define __SO_PROTOCOL  16
@@ -370,6 +391,14 @@ struct msghdr
   unsigned int msg_flags;
 };
 
+/* A message of recvmmsg() and sendmmsg() */
+
+struct mmsghdr
+{
+  struct msghdr msg_hdr;        /* The message */
+  unsigned int msg_len;         /* Number of bytes received or sent */
+};
+
 struct cmsghdr
 {
   unsigned long cmsg_len;       /* Data byte count, including hdr */
@@ -384,6 +413,26 @@ struct ucred
   gid_t gid;
 };
 
+/* An error queue notification (MSG_ERRQUEUE), in a IP_RECVERR or an
+ * IPV6_RECVERR control message.  The completion of the MSG_ZEROCOPY sends
+ * numbered from ee_info to ee_data, counted from zero, is notified with
+ * the SO_EE_ORIGIN_ZEROCOPY origin.
+ */
+
+#define SO_EE_ORIGIN_NONE          0
+#define SO_EE_ORIGIN_ZEROCOPY      5
+
+struct sock_extended_err
+{
+  uint32_t ee_errno;            /* The error number, zero for a completion */
+  uint8_t  ee_origin;           /* SO_EE_ORIGIN_* */
+  uint8_t  ee_type;
+  uint8_t  ee_code;
+  uint8_t  ee_pad;
+  uint32_t ee_info;
+  uint32_t ee_data;
+};
+
 /****************************************************************************
  * Inline Functions
  ****************************************************************************/
@@ -457,6 +506,23 @@ int getpeername(int sockfd, FAR struct sockaddr *addr,
 ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags);
 ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags);
 
+struct timespec;
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout);
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags);
+
+#ifdef CONFIG_NET_TCP_RECV_IOB
+/* Non-standard zero-copy extensions: The data received by a TCP socket is
+ * handed over in the IOBs that hold it.
+ */
+
+struct iob_s;
+ssize_t recv_iob(int sockfd, FAR struct iob_s **iob, size_t len,
+                 int flags);
+void recv_iob_release(int sockfd, FAR struct iob_s *iob);
+#endif
+
 #if CONFIG_FORTIFY_SOURCE > 0
 fortify_function(send) ssize_t send(int sockfd, FAR const void *buf,
                                     size_t len, int flags)
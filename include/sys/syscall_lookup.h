@@ -28,15 +28,22 @@
 
 SYSCALL_LOOKUP1(_exit,                     1)
 SYSCALL_LOOKUP(_assert,                    4)
-SYSCALL_LOOKUP(getpid,                     0)
-SYSCALL_LOOKUP(gettid,                     0)
 SYSCALL_LOOKUP(prctl,                      2)
 
+/* getpid(), gettid() and sched_getcpu() are answered from the TLS in user
+ * space if CONFIG_SCHED_VDSO is selected.
+ */
+
+#ifndef CONFIG_SCHED_VDSO
+  SYSCALL_LOOKUP(getpid,                   0)
+  SYSCALL_LOOKUP(gettid,                   0)
+  SYSCALL_LOOKUP(sched_getcpu,             0)
+#endif
+
 #ifdef CONFIG_SCHED_HAVE_PARENT
   SYSCALL_LOOKUP(getppid,                  0)
 #endif
 
-SYSCALL_LOOKUP(sched_getcpu,               0)
 SYSCALL_LOOKUP(sched_getparam,             2)
 SYSCALL_LOOKUP(sched_getscheduler,         1)
 SYSCALL_LOOKUP(sched_lock,                 0)
@@ -57,6 +64,11 @@ SYSCALL_LOOKUP(nxsched_get_stackinfo,      2)
   SYSCALL_LOOKUP(sched_setaffinity,        3)
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+  SYSCALL_LOOKUP(sched_getattr,            4)
+  SYSCALL_LOOKUP(sched_setattr,            3)
+#endif
+
 SYSCALL_LOOKUP(sysinfo,                    1)
 
 SYSCALL_LOOKUP(gethostname,                2)
@@ -93,6 +105,11 @@ SYSCALL_LOOKUP(nxsem_wait,                 1)
   SYSCALL_LOOKUP(nxsem_getprioceiling,     2)
 #endif
 
+#ifdef CONFIG_FUTEX
+  SYSCALL_LOOKUP(nxfutex_wait,             4)
+  SYSCALL_LOOKUP(nxfutex_wake,             2)
+#endif
+
 /* Named semaphores */
 
 #ifdef CONFIG_FS_NAMED_SEMAPHORES
@@ -168,7 +185,11 @@ SYSCALL_LOOKUP(clock_nanosleep,            4)
  */
 
 SYSCALL_LOOKUP(clock,                      0)
-SYSCALL_LOOKUP(clock_gettime,              2)
+#ifdef CONFIG_SCHED_VDSO
+  SYSCALL_LOOKUP(nxclock_gettime,          2)
+#else
+  SYSCALL_LOOKUP(clock_gettime,            2)
+#endif
 SYSCALL_LOOKUP(clock_settime,              2)
 #ifdef CONFIG_CLOCK_TIMEKEEPING
   SYSCALL_LOOKUP(adjtime,                  2)
@@ -202,6 +223,10 @@ SYSCALL_LOOKUP(read,                       3)
 SYSCALL_LOOKUP(write,                      3)
 SYSCALL_LOOKUP(pread,                      4)
 SYSCALL_LOOKUP(pwrite,                     4)
+SYSCALL_LOOKUP(readv,                      3)
+SYSCALL_LOOKUP(writev,                     3)
+SYSCALL_LOOKUP(preadv,                     4)
+SYSCALL_LOOKUP(pwritev,                    4)
 #ifdef CONFIG_FS_AIO
   SYSCALL_LOOKUP(aio_read,                 1)
   SYSCALL_LOOKUP(aio_write,                1)
@@ -246,6 +271,8 @@ SYSCALL_LOOKUP(fstat,                      2)
 SYSCALL_LOOKUP(statfs,                     2)
 SYSCALL_LOOKUP(fstatfs,                    2)
 SYSCALL_LOOKUP(sendfile,                   4)
+SYSCALL_LOOKUP(splice,                     6)
+SYSCALL_LOOKUP(tee,                        4)
 SYSCALL_LOOKUP(sync,                       0)
 SYSCALL_LOOKUP(fsync,                      1)
 SYSCALL_LOOKUP(chmod,                      2)
@@ -375,9 +402,11 @@ SYSCALL_LOOKUP(munmap,                     2)
   SYSCALL_LOOKUP(recv,                     4)
   SYSCALL_LOOKUP(recvfrom,                 6)
   SYSCALL_LOOKUP(recvmsg,                  3)
+  SYSCALL_LOOKUP(recvmmsg,                 5)
   SYSCALL_LOOKUP(send,                     4)
   SYSCALL_LOOKUP(sendto,                   6)
   SYSCALL_LOOKUP(sendmsg,                  3)
+  SYSCALL_LOOKUP(sendmmsg,                 4)
   SYSCALL_LOOKUP(setsockopt,               5)
   SYSCALL_LOOKUP(shutdown,                 2)
   SYSCALL_LOOKUP(socket,                   3)
@@ -28,6 +28,7 @@
  ****************************************************************************/
 
 #include <sys/socket.h>
+#include <stdint.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -43,10 +44,51 @@
 
 #define UNIX_PATH_MAX  108
 
+/* SOL_LOCAL protocol-level socket options of a connected SOCK_STREAM
+ * socket.
+ *
+ * LOCAL_RING
+ *   Exchange the data of the connection through two rings in memory that
+ *   the peers may map with mmap(), instead of the FIFOs.  Set with the size
+ *   of each ring (int), rounded up to a power of two;  Get returns a
+ *   struct local_ringinfo.  The data still in the FIFOs is received first.
+ *
+ * A peer that mapped the rings may produce data directly in its transmit
+ * ring and then call send() with no data to wake up the other peer, or
+ * consume data directly from its receive ring and then call recv() with
+ * no buffer to give the space back.  send() and recv() otherwise copy the
+ * data to and from the rings.
+ */
+
+#define LOCAL_RING     1
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
 
+/* The header of a ring, followed by lr_size bytes of data.  The indexes
+ * are free running and wrap with lr_size - 1:  The producer owns lr_head,
+ * the consumer owns lr_tail.  The data must be written before lr_head is
+ * advanced and read before lr_tail is advanced.
+ */
+
+struct local_ring
+{
+  volatile uint32_t lr_head;     /* Advanced by the producer */
+  volatile uint32_t lr_tail;     /* Advanced by the consumer */
+  uint32_t lr_size;              /* The size of the data, a power of two */
+  uint32_t lr_reserved;
+};
+
+/* The layout of the mapping of the rings, returned by LOCAL_RING */
+
+struct local_ringinfo
+{
+  uint32_t ri_mapsize;           /* The length to map from offset zero */
+  uint32_t ri_txoff;             /* The offset of the transmit ring */
+  uint32_t ri_rxoff;             /* The offset of the receive ring */
+};
+
 /* A UNIX domain socket address is represented in the following structure.
  * This structure must be cast compatible with struct sockaddr.
  */
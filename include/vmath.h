@@ -0,0 +1,68 @@
+/****************************************************************************
+ * include/vmath.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_VMATH_H
+#define __INCLUDE_VMATH_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stddef.h>
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/* The array versions of the single precision functions of math.h:  Each
+ * function computes the 'n' floats of 'x' to 'y', 'x' and 'y' may be the
+ * same array.  The results are those of the scalar functions for the
+ * special arguments:  Infinity, NaN, the arguments out of the range of the
+ * reduction, and the arguments of vlogf() that are not normal and
+ * positive.  The errors of the other results are at most 1.9 ULP for
+ * vsinf() and vcosf() with FMA and 2.5 ULP without, 2.0 ULP for vexpf()
+ * and 3.5 ULP for vlogf().
+ */
+
+void vsinf(FAR const float *x, FAR float *y, size_t n);
+void vcosf(FAR const float *x, FAR float *y, size_t n);
+void vexpf(FAR const float *x, FAR float *y, size_t n);
+void vlogf(FAR const float *x, FAR float *y, size_t n);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* __INCLUDE_VMATH_H */
@@ -32,6 +32,8 @@
 #ifndef __ASSEMBLY__
 #  include <sys/types.h>
 #  include <stdbool.h>
+#  include <stdint.h>
+#  include <float.h>
 #  include <stdio.h>
 #  include <stdlib.h>
 #  include <limits.h>
@@ -155,6 +157,13 @@
 #  define LIBC_BUILD_STRRCHR
 #endif
 
+/* The Ryu conversions need the IEEE 754 binary64 doubles */
+
+#if defined(CONFIG_LIBC_RYU) && defined(CONFIG_HAVE_DOUBLE) && \
+    defined(DBL_MANT_DIG) && DBL_MANT_DIG == 53
+#  define LIBC_HAVE_RYU
+#endif
+
 #ifdef CONFIG_MM_KASAN
 #  define ARCH_LIBCFUN(x)  arch_##x
 #else
@@ -263,6 +272,14 @@ ssize_t lib_parse_hostfile(FAR FILE *stream, FAR struct hostent *host,
 int lib_restoredir(void);
 #endif
 
+/* Defined in lib_ryu.c */
+
+#ifdef LIBC_HAVE_RYU
+uint64_t lib_ryu_d2s(double x, FAR int *e10);
+int lib_ryu_cmp(double x, uint64_t m10, int e10);
+double lib_ryu_s2d(uint64_t m10, int e10);
+#endif
+
 /* Defined in lib_cxx_initialize.c */
 
 void lib_cxx_initialize(void);
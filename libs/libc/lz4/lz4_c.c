@@ -0,0 +1,243 @@
+/****************************************************************************
+ * libs/libc/lz4/lz4_c.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <lz4.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LZ4_MINMATCH     4   /* Shortest match */
+#define LZ4_LASTLITERALS 5   /* The last bytes of a block are literals */
+#define LZ4_MFLIMIT      12  /* No match starts in the last bytes */
+#define LZ4_MAX_DISTANCE 65535
+#define LZ4_SKIPTRIGGER  6   /* Step up the search after 1 << 6 misses */
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline uint32_t lz4_read32(FAR const uint8_t *p)
+{
+  uint32_t v;
+
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline uint32_t lz4_hash(uint32_t v)
+{
+  return (v * 2654435761u) >> (32 - LZ4_HLOG);
+}
+
+/****************************************************************************
+ * Name: lz4_putlen
+ *
+ * Description:
+ *   Write the bytes that extend a length beyond the 15 of its token.
+ *
+ ****************************************************************************/
+
+static inline FAR uint8_t *lz4_putlen(FAR uint8_t *op, size_t len)
+{
+  for (; len >= 255; len -= 255)
+    {
+      *op++ = 255;
+    }
+
+  *op++ = (uint8_t)len;
+  return op;
+}
+
+/****************************************************************************
+ * Name: lz4_putseq
+ *
+ * Description:
+ *   Write a sequence, the literals from 'anchor' then a match of 'mlen'
+ *   bytes at 'offset' (no match if 'mlen' is zero).
+ *
+ * Returned Value:
+ *   The end of the sequence, NULL if the output buffer is too small.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *lz4_putseq(FAR uint8_t *op, FAR uint8_t *oend,
+                               FAR const uint8_t *anchor, size_t llen,
+                               size_t offset, size_t mlen)
+{
+  FAR uint8_t *token = op++;
+
+  if ((size_t)(oend - op) < llen + llen / 255 + 1 + 2 + mlen / 255 + 1)
+    {
+      return NULL;
+    }
+
+  if (llen >= 15)
+    {
+      *token = 15 << 4;
+      op = lz4_putlen(op, llen - 15);
+    }
+  else
+    {
+      *token = llen << 4;
+    }
+
+  memcpy(op, anchor, llen);
+  op += llen;
+
+  if (mlen == 0)
+    {
+      return op;
+    }
+
+  *op++ = (uint8_t)offset;
+  *op++ = (uint8_t)(offset >> 8);
+
+  mlen -= LZ4_MINMATCH;
+  if (mlen >= 15)
+    {
+      *token |= 15;
+      op = lz4_putlen(op, mlen - 15);
+    }
+  else
+    {
+      *token |= mlen;
+    }
+
+  return op;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_compress
+ *
+ * Description:
+ *   Compress in_len bytes, at most LZ4_MAX_BLOCKSIZE, stored at in_data
+ *   into an LZ4 block at out_data, up to a maximum length of out_len
+ *   bytes.
+ *
+ *   The matches are searched greedily through a hash table of the last
+ *   position of each 4 bytes sequence, stepping faster over the data that
+ *   does not compress.  The positions in the table are only candidates,
+ *   checked against the data, so that the table needs no initialization
+ *   and may hold the positions of a previous block.
+ *
+ * Returned Value:
+ *   The number of bytes used, 0 if the output buffer is not large enough
+ *   or in_len is too large.
+ *
+ ****************************************************************************/
+
+size_t lz4_compress(FAR const void *in_data, size_t in_len,
+                    FAR void *out_data, size_t out_len, lz4_state_t htab)
+{
+  FAR const uint8_t *in = in_data;
+  FAR const uint8_t *ip = in;
+  FAR const uint8_t *anchor = in;
+  FAR const uint8_t *iend = in + in_len;
+  FAR uint8_t *op = out_data;
+  FAR uint8_t *oend = op + out_len;
+
+  if (in_len > LZ4_MAX_BLOCKSIZE)
+    {
+      return 0;
+    }
+
+  if (in_len > LZ4_MFLIMIT)
+    {
+      FAR const uint8_t *mflimit = iend - LZ4_MFLIMIT;
+      FAR const uint8_t *matchlimit = iend - LZ4_LASTLITERALS;
+      unsigned int misses = 1 << LZ4_SKIPTRIGGER;
+
+      while (ip < mflimit)
+        {
+          FAR const uint8_t *ref;
+          uint32_t seq = lz4_read32(ip);
+          uint32_t h = lz4_hash(seq);
+          size_t mlen;
+
+          ref = in + htab[h];
+          htab[h] = (uint16_t)(ip - in);
+
+          if (ref >= ip || ip - ref > LZ4_MAX_DISTANCE ||
+              lz4_read32(ref) != seq)
+            {
+              ip += misses++ >> LZ4_SKIPTRIGGER;
+              continue;
+            }
+
+          misses = 1 << LZ4_SKIPTRIGGER;
+
+          /* Extend the match backwards over the pending literals, then
+           * forwards up to the last literals.
+           */
+
+          while (ip > anchor && ref > in && *(ip - 1) == *(ref - 1))
+            {
+              ip--;
+              ref--;
+            }
+
+          mlen = LZ4_MINMATCH;
+          while (ip + mlen < matchlimit && ip[mlen] == ref[mlen])
+            {
+              mlen++;
+            }
+
+          op = lz4_putseq(op, oend, anchor, ip - anchor, ip - ref, mlen);
+          if (op == NULL)
+            {
+              return 0;
+            }
+
+          ip    += mlen;
+          anchor = ip;
+
+          /* Index a position inside of the match, for the next ones */
+
+          if (ip < mflimit)
+            {
+              htab[lz4_hash(lz4_read32(ip - 2))] = (uint16_t)(ip - 2 - in);
+            }
+        }
+    }
+
+  /* The last literals */
+
+  op = lz4_putseq(op, oend, anchor, iend - anchor, 0, 0);
+  if (op == NULL)
+    {
+      return 0;
+    }
+
+  return op - (FAR uint8_t *)out_data;
+}
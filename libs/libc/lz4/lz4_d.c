@@ -0,0 +1,182 @@
+/****************************************************************************
+ * libs/libc/lz4/lz4_d.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <errno.h>
+#include <lz4.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_getlen
+ *
+ * Description:
+ *   Add the bytes that extend a length beyond the 15 of its token.
+ *
+ ****************************************************************************/
+
+static FAR const uint8_t *lz4_getlen(FAR const uint8_t *ip,
+                                     FAR const uint8_t *iend,
+                                     FAR size_t *len)
+{
+  uint8_t s;
+
+  do
+    {
+      if (ip >= iend)
+        {
+          return NULL;
+        }
+
+      s     = *ip++;
+      *len += s;
+    }
+  while (s == 255);
+
+  return ip;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_decompress
+ *
+ * Description:
+ *   Decompress the LZ4 block of in_len bytes stored at in_data.  The
+ *   result is stored at out_data, up to a maximum of out_len bytes.
+ *
+ * Returned Value:
+ *   The number of decompressed bytes.  If the output buffer is not large
+ *   enough to hold the decompressed data, a 0 is returned and errno is set
+ *   to E2BIG.  If an error in the compressed data is detected, a zero is
+ *   returned and errno is set to EINVAL.
+ *
+ ****************************************************************************/
+
+size_t lz4_decompress(FAR const void *in_data, size_t in_len,
+                      FAR void *out_data, size_t out_len)
+{
+  FAR const uint8_t *ip = in_data;
+  FAR const uint8_t *iend = ip + in_len;
+  FAR uint8_t *out = out_data;
+  FAR uint8_t *op = out;
+  FAR uint8_t *oend = op + out_len;
+
+  while (ip < iend)
+    {
+      FAR const uint8_t *ref;
+      uint8_t token = *ip++;
+      size_t offset;
+      size_t len;
+
+      /* Literals */
+
+      len = token >> 4;
+      if (len == 15 && (ip = lz4_getlen(ip, iend, &len)) == NULL)
+        {
+          goto errout_inval;
+        }
+
+      if (len > (size_t)(iend - ip))
+        {
+          goto errout_inval;
+        }
+
+      if (len > (size_t)(oend - op))
+        {
+          goto errout_2big;
+        }
+
+      memcpy(op, ip, len);
+      op += len;
+      ip += len;
+
+      /* The last sequence has no match */
+
+      if (ip == iend)
+        {
+          break;
+        }
+
+      /* Match */
+
+      if (iend - ip < 2)
+        {
+          goto errout_inval;
+        }
+
+      offset = ip[0] | (ip[1] << 8);
+      ip    += 2;
+      if (offset == 0 || offset > (size_t)(op - out))
+        {
+          goto errout_inval;
+        }
+
+      len = token & 15;
+      if (len == 15 && (ip = lz4_getlen(ip, iend, &len)) == NULL)
+        {
+          goto errout_inval;
+        }
+
+      len += 4;
+      if (len > (size_t)(oend - op))
+        {
+          goto errout_2big;
+        }
+
+      ref = op - offset;
+      if (offset >= len)
+        {
+          memcpy(op, ref, len);
+          op += len;
+        }
+      else
+        {
+          /* Overlapping copy, that repeats the last 'offset' bytes */
+
+          while (len-- > 0)
+            {
+              *op++ = *ref++;
+            }
+        }
+    }
+
+  return op - out;
+
+errout_inval:
+  set_errno(EINVAL);
+  return 0;
+
+errout_2big:
+  set_errno(E2BIG);
+  return 0;
+}
@@ -0,0 +1,261 @@
+/****************************************************************************
+ * libs/libc/misc/lib_coroutine.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+#include <nuttx/coroutine.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: coroutine_step
+ *
+ * Description:
+ *   Run a coroutine until it yields, waits or ends.
+ *
+ ****************************************************************************/
+
+static void coroutine_step(FAR struct coroutine_s *co)
+{
+  FAR struct cosched_s *sched = co->sched;
+
+  switch (co->entry(co))
+    {
+      case COROUTINE_YIELD:
+        sq_addlast(&co->node, &sched->ready);
+        break;
+
+      case COROUTINE_WAIT:
+        sched->nwaiting++;
+        break;
+
+      default:
+        coroutine_unwatch(co);
+        sched->ncoroutines--;
+        if (co->release != NULL)
+          {
+            co->release(co);
+          }
+        break;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cosched_init
+ *
+ * Description:
+ *   Initialize a scheduler of coroutines.
+ *
+ ****************************************************************************/
+
+int cosched_init(FAR struct cosched_s *sched)
+{
+  DEBUGASSERT(sched);
+
+  sched->epfd = epoll_create1(EPOLL_CLOEXEC);
+  if (sched->epfd < 0)
+    {
+      return -get_errno();
+    }
+
+  sq_init(&sched->ready);
+  sched->nwaiting    = 0;
+  sched->ncoroutines = 0;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: cosched_uninit
+ *
+ * Description:
+ *   Release the resources of a scheduler.
+ *
+ ****************************************************************************/
+
+void cosched_uninit(FAR struct cosched_s *sched)
+{
+  DEBUGASSERT(sched && sched->ncoroutines == 0);
+
+  close(sched->epfd);
+  sched->epfd = -1;
+}
+
+/****************************************************************************
+ * Name: cosched_spawn
+ *
+ * Description:
+ *   Add a coroutine to a scheduler.
+ *
+ ****************************************************************************/
+
+void cosched_spawn(FAR struct cosched_s *sched, FAR struct coroutine_s *co,
+                   coroutine_entry_t entry, coroutine_release_t release,
+                   FAR void *arg)
+{
+  DEBUGASSERT(sched && co && entry);
+
+  co->sched   = sched;
+  co->entry   = entry;
+  co->release = release;
+  co->arg     = arg;
+  co->state   = 0;
+  co->fd      = -1;
+  co->revents = 0;
+
+  sched->ncoroutines++;
+  sq_addlast(&co->node, &sched->ready);
+}
+
+/****************************************************************************
+ * Name: cosched_run
+ *
+ * Description:
+ *   Run each ready coroutine once, then wait for the descriptors of the
+ *   waiting coroutines.
+ *
+ ****************************************************************************/
+
+int cosched_run(FAR struct cosched_s *sched, int timeout)
+{
+  struct epoll_event evs[CONFIG_LIBC_COROUTINE_NEVENTS];
+  FAR struct coroutine_s *co;
+  sq_queue_t ready;
+  int nevents;
+  int i;
+
+  DEBUGASSERT(sched);
+
+  /* The coroutines that yield now run in the next pass, after those woken
+   * up by the events below, so that a busy coroutine can not starve the
+   * others.
+   */
+
+  ready = sched->ready;
+  sq_init(&sched->ready);
+
+  while ((co = (FAR struct coroutine_s *)sq_remfirst(&ready)) != NULL)
+    {
+      coroutine_step(co);
+    }
+
+  if (sched->nwaiting == 0)
+    {
+      return sched->ncoroutines;
+    }
+
+  /* Only block if there is nothing else to do */
+
+  nevents = epoll_wait(sched->epfd, evs, CONFIG_LIBC_COROUTINE_NEVENTS,
+                       sq_empty(&sched->ready) ? timeout : 0);
+  if (nevents < 0)
+    {
+      return -get_errno();
+    }
+
+  /* The descriptors are watched with EPOLLONESHOT:  Each event wakes up
+   * its coroutine exactly once.
+   */
+
+  for (i = 0; i < nevents; i++)
+    {
+      co = evs[i].data.ptr;
+      co->revents = evs[i].events;
+
+      DEBUGASSERT(sched->nwaiting > 0);
+      sched->nwaiting--;
+      sq_addlast(&co->node, &sched->ready);
+    }
+
+  return sched->ncoroutines;
+}
+
+/****************************************************************************
+ * Name: coroutine_watch
+ *
+ * Description:
+ *   Watch the descriptor 'fd' of a coroutine for 'events'.
+ *
+ ****************************************************************************/
+
+int coroutine_watch(FAR struct coroutine_s *co, int fd, uint32_t events)
+{
+  struct epoll_event ev;
+  int op = EPOLL_CTL_MOD;
+
+  DEBUGASSERT(co && co->sched);
+
+  /* The descriptor stays registered between the waits, so re-arming it
+   * is a single modification.
+   */
+
+  if (co->fd != fd)
+    {
+      coroutine_unwatch(co);
+      op = EPOLL_CTL_ADD;
+    }
+
+  ev.events   = events | EPOLLONESHOT;
+  ev.data.ptr = co;
+
+  if (epoll_ctl(co->sched->epfd, op, fd, &ev) < 0)
+    {
+      co->revents = EPOLLERR;
+      return -get_errno();
+    }
+
+  co->fd = fd;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: coroutine_unwatch
+ *
+ * Description:
+ *   Stop watching the descriptor of a coroutine.
+ *
+ ****************************************************************************/
+
+void coroutine_unwatch(FAR struct coroutine_s *co)
+{
+  DEBUGASSERT(co && co->sched);
+
+  if (co->fd >= 0)
+    {
+      epoll_ctl(co->sched->epfd, EPOLL_CTL_DEL, co->fd, NULL);
+      co->fd = -1;
+    }
+}
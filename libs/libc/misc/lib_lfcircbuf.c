@@ -0,0 +1,412 @@
+/****************************************************************************
+ * libs/libc/misc/lib_lfcircbuf.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+
+#include <nuttx/lfcircbuf.h>
+#include <nuttx/lib/lib.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lfcircbuf_advance
+ *
+ * Description:
+ *   Return the index 'bytes' bytes after 'idx'.
+ *
+ ****************************************************************************/
+
+static unsigned int lfcircbuf_advance(FAR struct lfcircbuf_s *circ,
+                                      unsigned int idx, size_t bytes)
+{
+  idx += bytes;
+  if (idx >= 2 * circ->size)
+    {
+      idx -= 2 * circ->size;
+    }
+
+  return idx;
+}
+
+/****************************************************************************
+ * Name: lfcircbuf_distance
+ *
+ * Description:
+ *   Return the number of bytes from index 'from' to index 'to'.
+ *
+ ****************************************************************************/
+
+static size_t lfcircbuf_distance(FAR struct lfcircbuf_s *circ,
+                                 unsigned int from, unsigned int to)
+{
+  return to >= from ? to - from : to + 2 * circ->size - from;
+}
+
+/****************************************************************************
+ * Name: lfcircbuf_offset
+ *
+ * Description:
+ *   Return the offset in the buffer of index 'idx'.
+ *
+ ****************************************************************************/
+
+static size_t lfcircbuf_offset(FAR struct lfcircbuf_s *circ,
+                               unsigned int idx)
+{
+  return idx >= circ->size ? idx - circ->size : idx;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lfcircbuf_init
+ *
+ * Description:
+ *   Initialize a lock-free circular buffer.
+ *
+ ****************************************************************************/
+
+int lfcircbuf_init(FAR struct lfcircbuf_s *circ,
+                   FAR void *base, size_t bytes)
+{
+  DEBUGASSERT(circ);
+  DEBUGASSERT(!base || bytes);
+
+  if (bytes > UINT_MAX / 2)
+    {
+      return -EINVAL;
+    }
+
+  circ->external = !!base;
+
+  if (!base && bytes)
+    {
+      base = lib_malloc(bytes);
+      if (!base)
+        {
+          return -ENOMEM;
+        }
+    }
+
+  circ->base = base;
+  circ->size = bytes;
+  lfcircbuf_reset(circ);
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: lfcircbuf_uninit
+ *
+ * Description:
+ *   Free the circular buffer.
+ *
+ ****************************************************************************/
+
+void lfcircbuf_uninit(FAR struct lfcircbuf_s *circ)
+{
+  DEBUGASSERT(circ);
+
+  if (!circ->external)
+    {
+      lib_free(circ->base);
+    }
+
+  memset(circ, 0, sizeof(*circ));
+}
+
+/****************************************************************************
+ * Name: lfcircbuf_reset
+ *
+ * Description:
+ *   Remove the entire circular buffer content.
+ *
+ ****************************************************************************/
+
+void lfcircbuf_reset(FAR struct lfcircbuf_s *circ)
+{
+  DEBUGASSERT(circ);
+
+  atomic_store(&circ->reserve, 0);
+  atomic_store(&circ->head, 0);
+  atomic_store(&circ->tail, 0);
+}
+
+/****************************************************************************
+ * Name: lfcircbuf_used
+ *
+ * Description:
+ *   Return the used bytes of the circular buffer.
+ *
+ ****************************************************************************/
+
+size_t lfcircbuf_used(FAR struct lfcircbuf_s *circ)
+{
+  unsigned int tail;
+  unsigned int head;
+
+  DEBUGASSERT(circ);
+
+  tail = atomic_load_explicit(&circ->tail, memory_order_acquire);
+  head = atomic_load_explicit(&circ->head, memory_order_acquire);
+  return lfcircbuf_distance(circ, tail, head);
+}
+
+/****************************************************************************
+ * Name: lfcircbuf_space
+ *
+ * Description:
+ *   Return the remaining space of the circular buffer.
+ *
+ ****************************************************************************/
+
+size_t lfcircbuf_space(FAR struct lfcircbuf_s *circ)
+{
+  unsigned int reserve;
+  unsigned int tail;
+
+  DEBUGASSERT(circ);
+
+  reserve = atomic_load_explicit(&circ->reserve, memory_order_relaxed);
+  tail    = atomic_load_explicit(&circ->tail, memory_order_acquire);
+  return circ->size - lfcircbuf_distance(circ, tail, reserve);
+}
+
+/****************************************************************************
+ * Name: lfcircbuf_is_empty
+ *
+ * Description:
+ *   Return true if the circular buffer holds no committed data.
+ *
+ ****************************************************************************/
+
+bool lfcircbuf_is_empty(FAR struct lfcircbuf_s *circ)
+{
+  return lfcircbuf_used(circ) == 0;
+}
+
+/****************************************************************************
+ * Name: lfcircbuf_read
+ *
+ * Description:
+ *   Get data from the circular buffer.
+ *
+ ****************************************************************************/
+
+ssize_t lfcircbuf_read(FAR struct lfcircbuf_s *circ,
+                       FAR void *dst, size_t bytes)
+{
+  unsigned int tail;
+  unsigned int head;
+  size_t used;
+  size_t off;
+  size_t len;
+
+  DEBUGASSERT(circ);
+  DEBUGASSERT(dst || !bytes);
+
+  /* The acquire load of the head orders the reading of the data after the
+   * producer's commit.
+   */
+
+  tail = atomic_load_explicit(&circ->tail, memory_order_relaxed);
+  head = atomic_load_explicit(&circ->head, memory_order_acquire);
+
+  used = lfcircbuf_distance(circ, tail, head);
+  if (bytes > used)
+    {
+      bytes = used;
+    }
+
+  off = lfcircbuf_offset(circ, tail);
+  len = circ->size - off;
+  if (bytes < len)
+    {
+      len = bytes;
+    }
+
+  memcpy(dst, (FAR char *)circ->base + off, len);
+  memcpy((FAR char *)dst + len, circ->base, bytes - len);
+
+  /* The release store hands the space back only after it has been read */
+
+  atomic_store_explicit(&circ->tail, lfcircbuf_advance(circ, tail, bytes),
+                        memory_order_release);
+  return bytes;
+}
+
+/****************************************************************************
+ * Name: lfcircbuf_write
+ *
+ * Description:
+ *   Write as much data as fits to the circular buffer.  Single producer.
+ *
+ ****************************************************************************/
+
+ssize_t lfcircbuf_write(FAR struct lfcircbuf_s *circ,
+                        FAR const void *src, size_t bytes)
+{
+  unsigned int head;
+  size_t space;
+
+  DEBUGASSERT(circ);
+  DEBUGASSERT(src || !bytes);
+
+  space = lfcircbuf_space(circ);
+  if (bytes > space)
+    {
+      bytes = space;
+    }
+
+  head = atomic_load_explicit(&circ->head, memory_order_relaxed);
+  lfcircbuf_copyin(circ, head, 0, src, bytes);
+
+  head = lfcircbuf_advance(circ, head, bytes);
+  atomic_store_explicit(&circ->reserve, head, memory_order_relaxed);
+  atomic_store_explicit(&circ->head, head, memory_order_release);
+  return bytes;
+}
+
+/****************************************************************************
+ * Name: lfcircbuf_reserve
+ *
+ * Description:
+ *   Reserve space for 'bytes' bytes in the circular buffer.
+ *
+ ****************************************************************************/
+
+int lfcircbuf_reserve(FAR struct lfcircbuf_s *circ, size_t bytes,
+                      FAR unsigned int *pos)
+{
+  unsigned int reserve;
+  unsigned int next;
+  unsigned int tail;
+
+  DEBUGASSERT(circ && pos);
+
+  reserve = atomic_load_explicit(&circ->reserve, memory_order_relaxed);
+  do
+    {
+      tail = atomic_load_explicit(&circ->tail, memory_order_acquire);
+      if (circ->size - lfcircbuf_distance(circ, tail, reserve) < bytes)
+        {
+          return -ENOSPC;
+        }
+
+      next = lfcircbuf_advance(circ, reserve, bytes);
+    }
+  while (!atomic_compare_exchange_weak_explicit(&circ->reserve, &reserve,
+                                                next, memory_order_relaxed,
+                                                memory_order_relaxed));
+
+  *pos = reserve;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: lfcircbuf_copyin
+ *
+ * Description:
+ *   Copy data into the space reserved with lfcircbuf_reserve().
+ *
+ ****************************************************************************/
+
+void lfcircbuf_copyin(FAR struct lfcircbuf_s *circ, unsigned int pos,
+                      size_t offset, FAR const void *src, size_t bytes)
+{
+  size_t off;
+  size_t len;
+
+  off = lfcircbuf_offset(circ, lfcircbuf_advance(circ, pos, offset));
+  len = circ->size - off;
+  if (bytes < len)
+    {
+      len = bytes;
+    }
+
+  memcpy((FAR char *)circ->base + off, src, len);
+  memcpy(circ->base, (FAR const char *)src + len, bytes - len);
+}
+
+/****************************************************************************
+ * Name: lfcircbuf_commit
+ *
+ * Description:
+ *   Make reserved space visible to the consumer.
+ *
+ ****************************************************************************/
+
+void lfcircbuf_commit(FAR struct lfcircbuf_s *circ, unsigned int pos,
+                      size_t bytes)
+{
+  /* The head only moves in order of the reservations: wait for the
+   * producers that reserved earlier.
+   */
+
+  while (atomic_load_explicit(&circ->head, memory_order_acquire) != pos)
+    {
+    }
+
+  atomic_store_explicit(&circ->head, lfcircbuf_advance(circ, pos, bytes),
+                        memory_order_release);
+}
+
+/****************************************************************************
+ * Name: lfcircbuf_write_mp
+ *
+ * Description:
+ *   Write all of the data to the circular buffer or nothing.  Multiple
+ *   producers.
+ *
+ ****************************************************************************/
+
+ssize_t lfcircbuf_write_mp(FAR struct lfcircbuf_s *circ,
+                           FAR const void *src, size_t bytes)
+{
+  unsigned int pos;
+  int ret;
+
+  DEBUGASSERT(src || !bytes);
+
+  ret = lfcircbuf_reserve(circ, bytes, &pos);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  lfcircbuf_copyin(circ, pos, 0, src, bytes);
+  lfcircbuf_commit(circ, pos, bytes);
+  return bytes;
+}
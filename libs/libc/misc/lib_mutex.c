@@ -250,7 +250,7 @@ int nxmutex_lock(FAR mutex_t *mutex)
     {
       /* Take the semaphore (perhaps waiting) */
 
-      ret = nxsem_wait(&mutex->sem);
+      ret = nxsem_fastwait(&mutex->sem) ? OK : nxsem_wait(&mutex->sem);
       if (ret >= 0)
         {
           mutex->holder = _SCHED_GETTID();
@@ -291,7 +291,7 @@ int nxmutex_trylock(FAR mutex_t *mutex)
 {
   int ret;
 
-  ret = nxsem_trywait(&mutex->sem);
+  ret = nxsem_fastwait(&mutex->sem) ? OK : nxsem_trywait(&mutex->sem);
   if (ret < 0)
     {
       return ret;
@@ -337,7 +337,11 @@ int nxmutex_clocklock(FAR mutex_t *mutex, clockid_t clockid,
 
   do
     {
-      if (abstime)
+      if (nxsem_fastwait(&mutex->sem))
+        {
+          ret = OK;
+        }
+      else if (abstime)
         {
           ret = nxsem_clockwait(&mutex->sem, clockid, abstime);
         }
@@ -429,7 +433,7 @@ int nxmutex_unlock(FAR mutex_t *mutex)
 
   mutex->holder = NXMUTEX_NO_HOLDER;
 
-  ret = nxsem_post(&mutex->sem);
+  ret = nxsem_fastpost(&mutex->sem) ? OK : nxsem_post(&mutex->sem);
   if (ret < 0)
     {
       mutex->holder = _SCHED_GETTID();
@@ -30,6 +30,18 @@
 #include <nuttx/addrenv.h>
 #include <nuttx/lib/modlib.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The hash index of the symbols exported by a module */
+
+#ifdef CONFIG_SYMTAB_HASH
+#  define MODLIB_EXPHASH(modp) (&(modp)->exphash)
+#else
+#  define MODLIB_EXPHASH(modp) NULL
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -115,6 +127,32 @@ int modlib_symvalue(FAR struct module_s *modp,
                     Elf_Off sh_offset,
                     FAR const struct symtab_s *exports, int nexports);
 
+/****************************************************************************
+ * Name: modlib_findexport
+ *
+ * Description:
+ *   Find a symbol by name in a table of exported symbols.  With
+ *   CONFIG_SYMTAB_HASH, the hash index 'hash' of the table is built at the
+ *   first lookup, or rebuilt if the table changed, and used for the lookup.
+ *   The caller holds the registry lock.
+ *
+ * Input Parameters:
+ *   hash     - The hash index of the table, NULL if there is none
+ *   exports  - The table of exported symbols
+ *   nexports - The number of symbols in the exports table
+ *   name     - The name of the symbol
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if an entry with the matching
+ *   name is found; NULL is returned if the entry is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *
+modlib_findexport(FAR struct symtab_hash_s *hash,
+                  FAR const struct symtab_s *exports, int nexports,
+                  FAR const char *name);
+
 /****************************************************************************
  * Name: modlib_insertsymtab
  *
@@ -321,4 +359,35 @@ int modlib_addrenv_restore(FAR struct mod_loadinfo_s *loadinfo);
 void modlib_addrenv_free(FAR struct mod_loadinfo_s *loadinfo);
 
 #endif /* CONFIG_ARCH_ADDRENV */
+
+/****************************************************************************
+ * Name: modlib_sharetext
+ *
+ * Description:
+ *   Get the read-only sections of a module from the copy shared with the
+ *   other loaded instances of the same file.  loadinfo->xipbase is then
+ *   set to the shared copy, used as a file executed in place.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODLIB_SHARED_TEXT
+int modlib_sharetext(FAR struct mod_loadinfo_s *loadinfo);
+
+/****************************************************************************
+ * Name: modlib_unsharetext
+ *
+ * Description:
+ *   Release the text shared by modlib_sharetext().  Nothing is done if
+ *   'xipbase' is not a shared copy.
+ *
+ ****************************************************************************/
+
+void modlib_unsharetext(uintptr_t xipbase);
+#else
+#  define modlib_unsharetext(xipbase)
+#endif
 #endif /* __LIBS_LIBC_MODLIB_MODLIB_H */
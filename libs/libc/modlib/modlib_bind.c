@@ -66,9 +66,8 @@
 
 typedef struct
 {
-  dq_entry_t entry;
   Elf_Sym    sym;
-  int        idx;
+  int        idx;       /* Index of the symbol, -1 if the entry is free */
 } Elf_SymCache;
 
 struct
@@ -164,6 +163,60 @@ static inline int modlib_readrelas(FAR struct mod_loadinfo_s *loadinfo,
                      relsec->sh_offset + offset);
 }
 
+/****************************************************************************
+ * Name: modlib_symcache
+ *
+ * Description:
+ *   Get the symbol of index 'symidx' with its resolved value.  The cache is
+ *   direct mapped by symbol index, so that the symbols referenced by many
+ *   relocations are read and looked up by name only once per module.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.  On -ESRCH, the symbol has no name and '*sym' is still set.
+ *
+ ****************************************************************************/
+
+static int modlib_symcache(FAR struct module_s *modp,
+                           FAR struct mod_loadinfo_s *loadinfo,
+                           FAR Elf_SymCache *cache, int symidx,
+                           FAR const struct symtab_s *exports, int nexports,
+                           FAR Elf_Sym **sym)
+{
+  FAR Elf_SymCache *entry;
+  int ret;
+
+  entry = &cache[(unsigned int)symidx % CONFIG_MODLIB_SYMBOL_CACHECOUNT];
+  *sym  = &entry->sym;
+  if (entry->idx == symidx)
+    {
+      return entry->sym.st_shndx == SHN_UNDEF && entry->sym.st_name == 0 ?
+             -ESRCH : OK;
+    }
+
+  /* Read the symbol table entry into memory */
+
+  entry->idx = -1;
+  ret = modlib_readsym(loadinfo, symidx, &entry->sym,
+                       &loadinfo->shdr[loadinfo->symtabidx]);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Get the value of the symbol (in sym.st_value) */
+
+  ret = modlib_symvalue(modp, loadinfo, &entry->sym,
+                        loadinfo->shdr[loadinfo->strtabidx].sh_offset,
+                        exports, nexports);
+  if (ret >= 0 || ret == -ESRCH)
+    {
+      entry->idx = symidx;
+    }
+
+  return ret;
+}
+
 /****************************************************************************
  * Name: modlib_relocate and modlib_relocateadd
  *
@@ -178,21 +231,18 @@ static inline int modlib_readrelas(FAR struct mod_loadinfo_s *loadinfo,
 
 static int modlib_relocate(FAR struct module_s *modp,
                            FAR struct mod_loadinfo_s *loadinfo, int relidx,
+                           FAR Elf_SymCache *cache,
                            FAR const struct symtab_s *exports, int nexports)
 {
   FAR Elf_Shdr     *relsec = &loadinfo->shdr[relidx];
   FAR Elf_Shdr     *dstsec = &loadinfo->shdr[relsec->sh_info];
   FAR Elf_Rel      *rels;
   FAR Elf_Rel      *rel;
-  FAR Elf_SymCache *cache;
   FAR Elf_Sym      *sym;
-  FAR dq_entry_t   *e;
-  dq_queue_t        q;
   uintptr_t         addr;
   int               symidx;
   int               ret = OK;
   int               i;
-  int               j;
 
   /* Define potential architecture specific elf data container */
 
@@ -205,14 +255,12 @@ static int modlib_relocate(FAR struct module_s *modp,
       return -ENOMEM;
     }
 
-  dq_init(&q);
-
   /* Examine each relocation in the section.  'relsec' is the section
    * containing the relations.  'dstsec' is the section containing the data
    * to be relocated.
    */
 
-  for (i = j = 0; i < relsec->sh_size / sizeof(Elf_Rel); i++)
+  for (i = 0; i < relsec->sh_size / sizeof(Elf_Rel); i++)
     {
       /* Read the relocation entry into memory */
 
@@ -237,94 +285,32 @@ static int modlib_relocate(FAR struct module_s *modp,
 
       symidx = ELF_R_SYM(rel->r_info);
 
-      /* First try the cache */
+      /* Get the symbol, from the cache if it was already resolved */
 
-      sym = NULL;
-      for (e = dq_peek(&q); e; e = dq_next(e))
+      ret = modlib_symcache(modp, loadinfo, cache, symidx, exports,
+                            nexports, &sym);
+      if (ret == -ESRCH)
         {
-          cache = (FAR Elf_SymCache *)e;
-          if (cache->idx == symidx)
-            {
-              dq_rem(&cache->entry, &q);
-              dq_addfirst(&cache->entry, &q);
-              sym = &cache->sym;
-              break;
-            }
-        }
-
-      /* If the symbol was not found in the cache, we will need to read the
-       * symbol from the file.
-       */
+          /* The special error -ESRCH is returned only in one condition:
+           * The symbol has no name.
+           *
+           * There are a few relocations for a few architectures that do
+           * no depend upon a named symbol.  We don't know if that is the
+           * case here, but we will use a NULL symbol pointer to indicate
+           * that case to up_relocate().  That function can then do what
+           * is best.
+           */
 
-      if (sym == NULL)
+          berr("ERROR: Section %d reloc %d: "
+               "Undefined symbol[%d] has no name: %d\n",
+               relidx, i, symidx, ret);
+        }
+      else if (ret < 0)
         {
-          if (j < CONFIG_MODLIB_SYMBOL_CACHECOUNT)
-            {
-              cache = lib_malloc(sizeof(Elf_SymCache));
-              if (!cache)
-                {
-                  berr("Failed to allocate memory for elf symbols\n");
-                  ret = -ENOMEM;
-                  break;
-                }
-
-              j++;
-            }
-          else
-            {
-              cache = (FAR Elf_SymCache *)dq_remlast(&q);
-            }
-
-          sym = &cache->sym;
-
-          /* Read the symbol table entry into memory */
-
-          ret = modlib_readsym(loadinfo, symidx, sym,
-                               &loadinfo->shdr[loadinfo->symtabidx]);
-          if (ret < 0)
-            {
-              berr("ERROR: Section %d reloc %d: "
-                   "Failed to read symbol[%d]: %d\n",
-                   relidx, i, symidx, ret);
-              lib_free(cache);
-              break;
-            }
-
-          /* Get the value of the symbol (in sym.st_value) */
-
-          ret = modlib_symvalue(modp, loadinfo, sym,
-                  loadinfo->shdr[loadinfo->strtabidx].sh_offset,
-                  exports, nexports);
-          if (ret < 0)
-            {
-              /* The special error -ESRCH is returned only in one condition:
-               * The symbol has no name.
-               *
-               * There are a few relocations for a few architectures that do
-               * no depend upon a named symbol.  We don't know if that is the
-               * case here, but we will use a NULL symbol pointer to indicate
-               * that case to up_relocate().  That function can then do what
-               * is best.
-               */
-
-              if (ret == -ESRCH)
-                {
-                  berr("ERROR: Section %d reloc %d: "
-                       "Undefined symbol[%d] has no name: %d\n",
-                       relidx, i, symidx, ret);
-                }
-              else
-                {
-                  berr("ERROR: Section %d reloc %d: "
-                       "Failed to get value of symbol[%d]: %d\n",
-                       relidx, i, symidx, ret);
-                  lib_free(cache);
-                  break;
-                }
-            }
-
-          cache->idx = symidx;
-          dq_addfirst(&cache->entry, &q);
+          berr("ERROR: Section %d reloc %d: "
+               "Failed to get value of symbol[%d]: %d\n",
+               relidx, i, symidx, ret);
+          break;
         }
 
       if (sym->st_shndx == SHN_UNDEF && sym->st_name == 0)
@@ -416,18 +402,12 @@ static int modlib_relocate(FAR struct module_s *modp,
     }
 
   lib_free(rels);
-  while ((e = dq_peek(&q)) != NULL)
-    {
-      dq_rem(e, &q);
-      lib_free(e);
-    }
-
   return ret;
 }
 
 static int modlib_relocateadd(FAR struct module_s *modp,
                               FAR struct mod_loadinfo_s *loadinfo,
-                              int relidx,
+                              int relidx, FAR Elf_SymCache *cache,
                               FAR const struct symtab_s *exports,
                               int nexports)
 {
@@ -435,15 +415,11 @@ static int modlib_relocateadd(FAR struct module_s *modp,
   FAR Elf_Shdr     *dstsec = &loadinfo->shdr[relsec->sh_info];
   FAR Elf_Rela     *relas;
   FAR Elf_Rela     *rela;
-  FAR Elf_SymCache *cache;
   FAR Elf_Sym      *sym;
-  FAR dq_entry_t   *e;
-  dq_queue_t        q;
   uintptr_t         addr;
   int               symidx;
   int               ret = OK;
   int               i;
-  int               j;
 
   /* Define potential architecture specific elf data container */
 
@@ -457,14 +433,12 @@ static int modlib_relocateadd(FAR struct module_s *modp,
       return -ENOMEM;
     }
 
-  dq_init(&q);
-
   /* Examine each relocation in the section.  'relsec' is the section
    * containing the relations.  'dstsec' is the section containing the data
    * to be relocated.
    */
 
-  for (i = j = 0; i < relsec->sh_size / sizeof(Elf_Rela); i++)
+  for (i = 0; i < relsec->sh_size / sizeof(Elf_Rela); i++)
     {
       /* Read the relocation entry into memory */
 
@@ -489,94 +463,32 @@ static int modlib_relocateadd(FAR struct module_s *modp,
 
       symidx = ELF_R_SYM(rela->r_info);
 
-      /* First try the cache */
+      /* Get the symbol, from the cache if it was already resolved */
 
-      sym = NULL;
-      for (e = dq_peek(&q); e; e = dq_next(e))
+      ret = modlib_symcache(modp, loadinfo, cache, symidx, exports,
+                            nexports, &sym);
+      if (ret == -ESRCH)
         {
-          cache = (FAR Elf_SymCache *)e;
-          if (cache->idx == symidx)
-            {
-              dq_rem(&cache->entry, &q);
-              dq_addfirst(&cache->entry, &q);
-              sym = &cache->sym;
-              break;
-            }
-        }
-
-      /* If the symbol was not found in the cache, we will need to read the
-       * symbol from the file.
-       */
+          /* The special error -ESRCH is returned only in one condition:
+           * The symbol has no name.
+           *
+           * There are a few relocations for a few architectures that do
+           * no depend upon a named symbol.  We don't know if that is the
+           * case here, but we will use a NULL symbol pointer to indicate
+           * that case to up_relocate().  That function can then do what
+           * is best.
+           */
 
-      if (sym == NULL)
+          berr("ERROR: Section %d reloc %d: "
+               "Undefined symbol[%d] has no name: %d\n",
+               relidx, i, symidx, ret);
+        }
+      else if (ret < 0)
         {
-          if (j < CONFIG_MODLIB_SYMBOL_CACHECOUNT)
-            {
-              cache = lib_malloc(sizeof(Elf_SymCache));
-              if (!cache)
-                {
-                  berr("Failed to allocate memory for elf symbols\n");
-                  ret = -ENOMEM;
-                  break;
-                }
-
-              j++;
-            }
-          else
-            {
-              cache = (FAR Elf_SymCache *)dq_remlast(&q);
-            }
-
-          sym = &cache->sym;
-
-          /* Read the symbol table entry into memory */
-
-          ret = modlib_readsym(loadinfo, symidx, sym,
-                               &loadinfo->shdr[loadinfo->symtabidx]);
-          if (ret < 0)
-            {
-              berr("ERROR: Section %d reloc %d: "
-                   "Failed to read symbol[%d]: %d\n",
-                   relidx, i, symidx, ret);
-              lib_free(cache);
-              break;
-            }
-
-          /* Get the value of the symbol (in sym.st_value) */
-
-          ret = modlib_symvalue(modp, loadinfo, sym,
-                           loadinfo->shdr[loadinfo->strtabidx].sh_offset,
-                           exports, nexports);
-          if (ret < 0)
-            {
-              /* The special error -ESRCH is returned only in one condition:
-               * The symbol has no name.
-               *
-               * There are a few relocations for a few architectures that do
-               * no depend upon a named symbol.  We don't know if that is the
-               * case here, but we will use a NULL symbol pointer to indicate
-               * that case to up_relocate().  That function can then do what
-               * is best.
-               */
-
-              if (ret == -ESRCH)
-                {
-                  berr("ERROR: Section %d reloc %d: "
-                       "Undefined symbol[%d] has no name: %d\n",
-                       relidx, i, symidx, ret);
-                }
-              else
-                {
-                  berr("ERROR: Section %d reloc %d: "
-                       "Failed to get value of symbol[%d]: %d\n",
-                       relidx, i, symidx, ret);
-                  lib_free(cache);
-                  break;
-                }
-            }
-
-          cache->idx = symidx;
-          dq_addfirst(&cache->entry, &q);
+          berr("ERROR: Section %d reloc %d: "
+               "Failed to get value of symbol[%d]: %d\n",
+               relidx, i, symidx, ret);
+          break;
         }
 
       if (sym->st_shndx == SHN_UNDEF && sym->st_name == 0)
@@ -612,12 +524,6 @@ static int modlib_relocateadd(FAR struct module_s *modp,
     }
 
   lib_free(relas);
-  while ((e = dq_peek(&q)) != NULL)
-    {
-      dq_rem(e, &q);
-      lib_free(e);
-    }
-
   return ret;
 }
 
@@ -638,7 +544,8 @@ static int modlib_relocatedyn(FAR struct module_s *modp,
                               int relidx)
 {
   FAR Elf_Shdr *shdr = &loadinfo->shdr[relidx];
-  FAR Elf_Shdr *symhdr;
+  FAR Elf_Shdr *symhdr = &loadinfo->shdr[loadinfo->dsymtabidx];
+  struct obstack arena;
   FAR Elf_Dyn  *dyn = NULL;
   FAR Elf_Rel  *rels = NULL;
   FAR Elf_Rel  *rel;
@@ -655,7 +562,18 @@ static int modlib_relocatedyn(FAR struct module_s *modp,
 
   ARCH_ELFDATA_DEF;
 
-  dyn = lib_malloc(shdr->sh_size);
+  /* The dynamic section, the relocation buffer and the dynamic symbol
+   * table are only needed here:  Take them from one chunk of an arena and
+   * release it once on the way out.
+   */
+
+  lib_arena_init(&arena,
+                 LIB_ARENA_SIZE(shdr->sh_size) +
+                 LIB_ARENA_SIZE(CONFIG_MODLIB_RELOCATION_BUFFERCOUNT *
+                                sizeof(Elf_Rela)) +
+                 LIB_ARENA_SIZE(symhdr->sh_size));
+
+  dyn = lib_arena_alloc(&arena, shdr->sh_size);
   if (dyn == NULL)
     {
       berr("Failed to allocate memory for elf dynamic section\n");
@@ -667,17 +585,18 @@ static int modlib_relocatedyn(FAR struct module_s *modp,
   if (ret < 0)
     {
       berr("Failed to read dynamic section header");
-      lib_free(dyn);
+      lib_arena_release(&arena);
       return ret;
     }
 
   /* Assume DT_RELA to get maximum size required */
 
-  rels = lib_zalloc(CONFIG_MODLIB_RELOCATION_BUFFERCOUNT * sizeof(Elf_Rela));
+  rels = lib_arena_zalloc(&arena, CONFIG_MODLIB_RELOCATION_BUFFERCOUNT *
+                                  sizeof(Elf_Rela));
   if (!rels)
     {
       berr("Failed to allocate memory for elf relocation rels\n");
-      lib_free(dyn);
+      lib_arena_release(&arena);
       return -ENOMEM;
     }
 
@@ -724,13 +643,11 @@ static int modlib_relocatedyn(FAR struct module_s *modp,
         }
     }
 
-  symhdr = &loadinfo->shdr[loadinfo->dsymtabidx];
-  sym = lib_malloc(symhdr->sh_size);
+  sym = lib_arena_alloc(&arena, symhdr->sh_size);
   if (!sym)
     {
       berr("Error obtaining storage for dynamic symbol table");
-      lib_free(rels);
-      lib_free(dyn);
+      lib_arena_release(&arena);
       return -ENOMEM;
     }
 
@@ -739,9 +656,7 @@ static int modlib_relocatedyn(FAR struct module_s *modp,
   if (ret < 0)
     {
       berr("Error reading dynamic symbol table - %d", ret);
-      lib_free(sym);
-      lib_free(rels);
-      lib_free(dyn);
+      lib_arena_release(&arena);
       return ret;
     }
 
@@ -822,9 +737,7 @@ static int modlib_relocatedyn(FAR struct module_s *modp,
                         berr("ERROR: Unable to resolve addr of ext ref %s\n",
                              loadinfo->iobuffer);
                         ret = -EINVAL;
-                        lib_free(sym);
-                        lib_free(rels);
-                        lib_free(dyn);
+                        lib_arena_release(&arena);
                         return ret;
                       }
 
@@ -870,17 +783,13 @@ static int modlib_relocatedyn(FAR struct module_s *modp,
             {
               berr("ERROR: Section %d reloc %d: Relocation failed: %d\n",
                    relidx, i, ret);
-              lib_free(sym);
-              lib_free(rels);
-              lib_free(dyn);
+              lib_arena_release(&arena);
               return ret;
             }
         }
     }
 
-  lib_free(sym);
-  lib_free(rels);
-  lib_free(dyn);
+  lib_arena_release(&arena);
 
   return ret;
 }
@@ -913,6 +822,7 @@ int modlib_bind(FAR struct module_s *modp,
                 FAR struct mod_loadinfo_s *loadinfo,
                 FAR const struct symtab_s *exports, int nexports)
 {
+  FAR Elf_SymCache *cache = NULL;
   int ret;
   int i;
 
@@ -941,6 +851,26 @@ int modlib_bind(FAR struct module_s *modp,
       return ret;
     }
 
+  /* Allocate the cache of the resolved symbols, shared by the relocation
+   * sections of a relocatable module.
+   */
+
+  if (loadinfo->ehdr.e_type != ET_DYN)
+    {
+      cache = lib_malloc(CONFIG_MODLIB_SYMBOL_CACHECOUNT *
+                         sizeof(Elf_SymCache));
+      if (cache == NULL)
+        {
+          berr("Failed to allocate memory for elf symbols\n");
+          return -ENOMEM;
+        }
+
+      for (i = 0; i < CONFIG_MODLIB_SYMBOL_CACHECOUNT; i++)
+        {
+          cache[i].idx = -1;
+        }
+    }
+
   /* Process relocations in every allocated section */
 
   for (i = 1; i < loadinfo->ehdr.e_shnum; i++)
@@ -986,11 +916,6 @@ int modlib_bind(FAR struct module_s *modp,
                                   sizeof(uintptr_t);
                 break;
             }
-
-          if (ret < 0)
-            {
-              return ret;
-            }
         }
       else
         {
@@ -1016,7 +941,8 @@ int modlib_bind(FAR struct module_s *modp,
                     continue;
                   }
 
-                ret = modlib_relocate(modp, loadinfo, i, exports, nexports);
+                ret = modlib_relocate(modp, loadinfo, i, cache, exports,
+                                      nexports);
                 break;
               case SHT_RELA:
                 if ((loadinfo->shdr[infosec].sh_flags & SHF_ALLOC) == 0)
@@ -1024,7 +950,7 @@ int modlib_bind(FAR struct module_s *modp,
                     continue;
                   }
 
-                ret = modlib_relocateadd(modp, loadinfo, i, exports,
+                ret = modlib_relocateadd(modp, loadinfo, i, cache, exports,
                                          nexports);
                 break;
               case SHT_INIT_ARRAY:
@@ -1042,10 +968,16 @@ int modlib_bind(FAR struct module_s *modp,
 
       if (ret < 0)
         {
-          return ret;
+          break;
         }
     }
 
+  lib_free(cache);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
   modp->xipbase = loadinfo->xipbase;
 
   /* Ensure that the I and D caches are coherent before starting the newly
@@ -30,6 +30,8 @@
 #include <nuttx/lib/modlib.h>
 #include <nuttx/symtab.h>
 
+#include "modlib/modlib.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -93,8 +95,8 @@ FAR const void *modlib_getsymbol(FAR void *handle, FAR const char *name)
 
   /* Search the symbol table for the matching symbol */
 
-  symbol = symtab_findbyname(modp->modinfo.exports, name,
-                             modp->modinfo.nexports);
+  symbol = modlib_findexport(MODLIB_EXPHASH(modp), modp->modinfo.exports,
+                             modp->modinfo.nexports, name);
 
   modlib_registry_unlock();
   if (symbol == NULL)
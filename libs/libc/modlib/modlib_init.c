@@ -26,6 +26,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/ioctl.h>
 #include <sys/stat.h>
 
 #include <stdint.h>
@@ -35,6 +36,7 @@
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/lib/modlib.h>
 
 #include "modlib/modlib.h"
@@ -76,6 +78,10 @@ static inline int modlib_fileinfo(FAR struct mod_loadinfo_s *loadinfo)
   loadinfo->fileuid  = buf.st_uid;
   loadinfo->filegid  = buf.st_gid;
   loadinfo->filemode = buf.st_mode;
+#ifdef CONFIG_MODLIB_SHARED_TEXT
+  loadinfo->fileino   = buf.st_ino;
+  loadinfo->filemtime = buf.st_mtim;
+#endif
   return OK;
 }
 
@@ -106,6 +112,9 @@ int modlib_initialize(FAR const char *filename,
   /* Clear the load info structure */
 
   memset(loadinfo, 0, sizeof(struct mod_loadinfo_s));
+#ifdef CONFIG_MODLIB_SHARED_TEXT
+  loadinfo->filename = filename;
+#endif
 
   /* Open the binary file for reading (only) */
 
@@ -126,6 +135,14 @@ int modlib_initialize(FAR const char *filename,
       return ret;
     }
 
+  /* Read the file directly from memory if it can be executed in place */
+
+  if (ioctl(loadinfo->filfd, FIOC_XIPBASE,
+            (unsigned long)&loadinfo->filebase) < 0)
+    {
+      loadinfo->filebase = 0;
+    }
+
   /* Read the ELF ehdr from offset 0 */
 
   ret = modlib_read(loadinfo, (FAR uint8_t *)&loadinfo->ehdr,
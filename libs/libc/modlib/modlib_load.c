@@ -32,7 +32,6 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/ioctl.h>
 #include <unistd.h>
 #include <assert.h>
 #include <errno.h>
@@ -40,7 +39,6 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/lib/modlib.h>
-#include <nuttx/fs/ioctl.h>
 
 #include "libc.h"
 #include "modlib/modlib.h"
@@ -554,11 +552,18 @@ int modlib_load(FAR struct mod_loadinfo_s *loadinfo)
   if (loadinfo->gotindex >= 0)
     {
       binfo("GOT section found! index %d\n", loadinfo->gotindex);
-      if (ioctl(loadinfo->filfd, FIOC_XIPBASE,
-                (unsigned long)&loadinfo->xipbase) >= 0)
+      if (loadinfo->filebase != 0)
         {
+          loadinfo->xipbase = loadinfo->filebase;
           binfo("can use xipbase %zu\n", loadinfo->xipbase);
         }
+#ifdef CONFIG_MODLIB_SHARED_TEXT
+      else if (loadinfo->ehdr.e_type != ET_DYN &&
+               modlib_sharetext(loadinfo) >= 0)
+        {
+          binfo("share text at %zu\n", loadinfo->xipbase);
+        }
+#endif
     }
 
   /* Determine total size to allocate */
@@ -710,9 +715,9 @@ int modlib_load_with_addrenv(FAR struct mod_loadinfo_s *loadinfo)
   if (loadinfo->gotindex >= 0)
     {
       binfo("GOT section found! index %d\n", loadinfo->gotindex);
-      if (ioctl(loadinfo->filfd, FIOC_XIPBASE,
-                (unsigned long)&loadinfo->xipbase) >= 0)
+      if (loadinfo->filebase != 0)
         {
+          loadinfo->xipbase = loadinfo->filebase;
           binfo("can use xipbase %zu\n", loadinfo->xipbase);
         }
     }
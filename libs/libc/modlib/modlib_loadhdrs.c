@@ -82,9 +82,26 @@ int modlib_loadhdrs(FAR struct mod_loadinfo_s *loadinfo)
       return -ESPIPE;
     }
 
+  /* Get the total size of the program header table */
+
+  phdrsize = (size_t)loadinfo->ehdr.e_phentsize *
+             (size_t)loadinfo->ehdr.e_phnum;
+  if (phdrsize > 0 && loadinfo->ehdr.e_phoff + phdrsize > loadinfo->filelen)
+    {
+      berr("ERROR: Insufficent space for program header table\n");
+      return -ESPIPE;
+    }
+
+  /* Both tables are kept until modlib_freebuffers(), so they share a
+   * single chunk of the header arena.
+   */
+
+  lib_arena_init(&loadinfo->hdrarena,
+                 LIB_ARENA_SIZE(shdrsize) + LIB_ARENA_SIZE(phdrsize));
+
   /* Allocate memory to hold a working copy of the sector header table */
 
-  loadinfo->shdr = (FAR Elf_Shdr *)lib_malloc(shdrsize);
+  loadinfo->shdr = lib_arena_alloc(&loadinfo->hdrarena, shdrsize);
   if (!loadinfo->shdr)
     {
       berr("ERROR: Failed to allocate the section header table. Size: %zu\n",
@@ -103,19 +120,9 @@ int modlib_loadhdrs(FAR struct mod_loadinfo_s *loadinfo)
 
   if (loadinfo->ehdr.e_phnum > 0)
     {
-      /* Get the total size of the program header table */
-
-      phdrsize = (size_t)loadinfo->ehdr.e_phentsize *
-                 (size_t)loadinfo->ehdr.e_phnum;
-      if (loadinfo->ehdr.e_phoff + phdrsize > loadinfo->filelen)
-        {
-          berr("ERROR: Insufficent space for program header table\n");
-          return -ESPIPE;
-        }
-
       /* Allocate memory to hold a working copy of the program header table */
 
-      loadinfo->phdr = (FAR Elf_Phdr *)lib_malloc(phdrsize);
+      loadinfo->phdr = lib_arena_alloc(&loadinfo->hdrarena, phdrsize);
       if (!loadinfo->phdr)
         {
           berr("ERROR: Failed to allocate the program header table."
@@ -37,6 +37,8 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/lib/modlib.h>
 
+#include "libc.h"
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -58,45 +60,42 @@
 #endif
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: modlib_read
+ * Name: modlib_readfile
  *
  * Description:
- *   Read 'readsize' bytes from the object file at 'offset'.  The data is
- *   read into 'buffer.'
- *
- * Returned Value:
- *   0 (OK) is returned on success and a negated errno is returned on
- *   failure.
+ *   Read 'readsize' bytes from the object file at 'offset', seeking only if
+ *   the file is not already at 'offset'.
  *
  ****************************************************************************/
 
-int modlib_read(FAR struct mod_loadinfo_s *loadinfo, FAR uint8_t *buffer,
-                size_t readsize, off_t offset)
+static int modlib_readfile(FAR struct mod_loadinfo_s *loadinfo,
+                           FAR uint8_t *buffer, size_t readsize,
+                           off_t offset)
 {
   size_t  nsize = readsize;
   ssize_t nbytes;      /* Number of bytes read */
   off_t   rpos;        /* Position returned by lseek */
   int     errval;
 
-  binfo("Read %zu bytes from offset %" PRIdOFF "\n", readsize, offset);
-
-  /* Loop until all of the requested data has been read. */
-
   /* Seek to the read position */
 
-  rpos = _NX_SEEK(loadinfo->filfd, offset, SEEK_SET);
-  if (rpos != offset)
+  if (loadinfo->filepos != offset)
     {
-      errval = _NX_GETERRNO(rpos);
-      berr("ERROR: Failed to seek to position %" PRIdOFF ": %d\n",
-           offset, errval);
-      return -errval;
+      rpos = _NX_SEEK(loadinfo->filfd, offset, SEEK_SET);
+      if (rpos != offset)
+        {
+          errval = _NX_GETERRNO(rpos);
+          berr("ERROR: Failed to seek to position %" PRIdOFF ": %d\n",
+               offset, errval);
+          loadinfo->filepos = -1;
+          return -errval;
+        }
+
+      loadinfo->filepos = offset;
     }
 
+  /* Loop until all of the requested data has been read. */
+
   while (readsize > 0)
     {
       /* Read the file data at offset into the user buffer */
@@ -113,6 +112,7 @@ int modlib_read(FAR struct mod_loadinfo_s *loadinfo, FAR uint8_t *buffer,
             {
               berr("ERROR: Read from offset %" PRIdOFF " failed: %d\n",
                    (off_t)(offset + nsize - readsize), errval);
+              loadinfo->filepos = -1;
               return -errval;
             }
         }
@@ -123,10 +123,127 @@ int modlib_read(FAR struct mod_loadinfo_s *loadinfo, FAR uint8_t *buffer,
         }
       else
         {
-          readsize -= nbytes;
+          readsize          -= nbytes;
+          loadinfo->filepos += nbytes;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: modlib_readahead
+ *
+ * Description:
+ *   Read 'readsize' bytes at 'offset' from the read-ahead buffer, filling
+ *   it first with one large read at 'offset' if the data is not there:
+ *   Most of the reads of the symbols, of their names and of the headers
+ *   are then served without any access to the file.
+ *
+ ****************************************************************************/
+
+#if CONFIG_MODLIB_READAHEAD > 0
+static int modlib_readahead(FAR struct mod_loadinfo_s *loadinfo,
+                            FAR uint8_t *buffer, size_t readsize,
+                            off_t offset)
+{
+  int ret;
+
+  if (offset < loadinfo->readpos ||
+      offset + readsize > loadinfo->readpos + loadinfo->readlen)
+    {
+      size_t readlen = CONFIG_MODLIB_READAHEAD;
+
+      if (offset + readsize > loadinfo->filelen)
+        {
+          berr("ERROR: Unexpected end of file\n");
+          return -ENODATA;
+        }
+
+      if (loadinfo->readbuf == NULL)
+        {
+          loadinfo->readbuf = lib_malloc(CONFIG_MODLIB_READAHEAD);
+          if (loadinfo->readbuf == NULL)
+            {
+              return modlib_readfile(loadinfo, buffer, readsize, offset);
+            }
+        }
+
+      if (readlen > loadinfo->filelen - offset)
+        {
+          readlen = loadinfo->filelen - offset;
+        }
+
+      loadinfo->readlen = 0;
+      ret = modlib_readfile(loadinfo, loadinfo->readbuf, readlen, offset);
+      if (ret < 0)
+        {
+          return ret;
         }
+
+      loadinfo->readpos = offset;
+      loadinfo->readlen = readlen;
     }
 
-  modlib_dumpreaddata(buffer, nsize);
+  memcpy(buffer, loadinfo->readbuf + (offset - loadinfo->readpos),
+         readsize);
   return OK;
 }
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: modlib_read
+ *
+ * Description:
+ *   Read 'readsize' bytes from the object file at 'offset'.  The data is
+ *   read into 'buffer.'  The data is copied directly if the file is in
+ *   memory (see FIOC_XIPBASE), the small reads go through the read-ahead
+ *   buffer and the large ones directly to 'buffer'.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+int modlib_read(FAR struct mod_loadinfo_s *loadinfo, FAR uint8_t *buffer,
+                size_t readsize, off_t offset)
+{
+  int ret;
+
+  binfo("Read %zu bytes from offset %" PRIdOFF "\n", readsize, offset);
+
+  if (loadinfo->filebase != 0)
+    {
+      if (offset < 0 || offset + readsize > loadinfo->filelen)
+        {
+          berr("ERROR: Unexpected end of file\n");
+          return -ENODATA;
+        }
+
+      memcpy(buffer, (FAR const uint8_t *)loadinfo->filebase + offset,
+             readsize);
+      ret = OK;
+    }
+#if CONFIG_MODLIB_READAHEAD > 0
+  else if (readsize < CONFIG_MODLIB_READAHEAD)
+    {
+      ret = modlib_readahead(loadinfo, buffer, readsize, offset);
+    }
+#endif
+  else
+    {
+      ret = modlib_readfile(loadinfo, buffer, readsize, offset);
+    }
+
+  if (ret >= 0)
+    {
+      modlib_dumpreaddata(buffer, readsize);
+    }
+
+  return ret;
+}
@@ -31,6 +31,8 @@
 #include <nuttx/lib/lib.h>
 #include <nuttx/lib/modlib.h>
 
+#include "modlib/modlib.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -140,6 +142,10 @@ int modlib_uninit(FAR struct module_s *modp)
               lib_free((FAR void *)modp->textalloc);
 #  endif
             }
+          else
+            {
+              modlib_unsharetext(modp->xipbase);
+            }
 
 #  if defined(CONFIG_ARCH_USE_DATA_HEAP)
           up_dataheap_free((FAR void *)modp->dataalloc);
@@ -167,6 +173,12 @@ int modlib_uninit(FAR struct module_s *modp)
   modlib_undepend(modp);
 #endif
 
+#ifdef CONFIG_SYMTAB_HASH
+  /* Free the hash index of the exported symbols */
+
+  symtab_hashfree(&modp->exphash);
+#endif
+
   return ret;
 }
 
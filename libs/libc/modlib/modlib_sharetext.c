@@ -0,0 +1,286 @@
+/****************************************************************************
+ * libs/libc/modlib/modlib_sharetext.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/mutex.h>
+#include <nuttx/lib/modlib.h>
+
+#include "libc.h"
+#include "modlib/modlib.h"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The read-only part of a module file, shared by all its loaded instances */
+
+struct modlib_text_s
+{
+  FAR struct modlib_text_s *flink;  /* Supports a singly linked list */
+  FAR uint8_t *image;               /* The file up to the end of the text */
+  off_t filelen;                    /* Identity of the file */
+  ino_t fileino;
+  struct timespec filemtime;
+  int crefs;                        /* Number of loaded instances */
+  char filename[1];                 /* Path of the file */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static mutex_t g_modlib_textlock = NXMUTEX_INITIALIZER;
+static FAR struct modlib_text_s *g_modlib_text;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: modlib_textsize
+ *
+ * Description:
+ *   Return the size of the file up to the end of its last read-only
+ *   section, and the alignment that the sections need, or zero if the
+ *   read-only sections are relocated:  The text can be shared only if all
+ *   of its instances are identical.
+ *
+ ****************************************************************************/
+
+static size_t modlib_textsize(FAR struct mod_loadinfo_s *loadinfo,
+                              FAR size_t *align)
+{
+  size_t size = 0;
+  int i;
+
+  *align = sizeof(uintptr_t);
+  for (i = 0; i < loadinfo->ehdr.e_shnum; i++)
+    {
+      FAR Elf_Shdr *shdr = &loadinfo->shdr[i];
+
+      if (shdr->sh_type == SHT_REL || shdr->sh_type == SHT_RELA)
+        {
+          FAR Elf_Shdr *dstsec;
+
+          if (shdr->sh_info >= loadinfo->ehdr.e_shnum)
+            {
+              continue;
+            }
+
+          dstsec = &loadinfo->shdr[shdr->sh_info];
+          if ((dstsec->sh_flags & SHF_ALLOC) != 0 &&
+              (dstsec->sh_flags & SHF_WRITE) == 0 &&
+              dstsec->sh_size > 0 && shdr->sh_size > 0)
+            {
+              return 0;
+            }
+        }
+      else if ((shdr->sh_flags & SHF_ALLOC) != 0 &&
+               (shdr->sh_flags & SHF_WRITE) == 0 &&
+               shdr->sh_type != SHT_NOBITS)
+        {
+          if (size < shdr->sh_offset + shdr->sh_size)
+            {
+              size = shdr->sh_offset + shdr->sh_size;
+            }
+
+          if (*align < shdr->sh_addralign)
+            {
+              *align = shdr->sh_addralign;
+            }
+        }
+    }
+
+  return size;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: modlib_sharetext
+ *
+ * Description:
+ *   Get the read-only sections of a module from the copy shared with the
+ *   other loaded instances of the same file, reading it only if there is
+ *   none.  loadinfo->xipbase is set to the shared copy of the file, that is
+ *   then used as a file executed in place.
+ *
+ *   The file is identified by its path, size, serial number and time of
+ *   last modification.  The text is shared only if it is not relocated,
+ *   that is if the module is position independent and uses a GOT.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+int modlib_sharetext(FAR struct mod_loadinfo_s *loadinfo)
+{
+  FAR struct modlib_text_s *text;
+  size_t align;
+  size_t size;
+  int ret;
+
+  if (loadinfo->filename == NULL)
+    {
+      return -EINVAL;
+    }
+
+  size = modlib_textsize(loadinfo, &align);
+  if (size == 0)
+    {
+      return -ENOTSUP;
+    }
+
+  nxmutex_lock(&g_modlib_textlock);
+
+  for (text = g_modlib_text; text != NULL; text = text->flink)
+    {
+      if (text->filelen == loadinfo->filelen &&
+          text->fileino == loadinfo->fileino &&
+          text->filemtime.tv_sec == loadinfo->filemtime.tv_sec &&
+          text->filemtime.tv_nsec == loadinfo->filemtime.tv_nsec &&
+          strcmp(text->filename, loadinfo->filename) == 0)
+        {
+          text->crefs++;
+          loadinfo->xipbase = (uintptr_t)text->image;
+          nxmutex_unlock(&g_modlib_textlock);
+          return OK;
+        }
+    }
+
+  /* First instance of the file:  Read it up to the end of the text */
+
+  text = lib_malloc(sizeof(struct modlib_text_s) +
+                    strlen(loadinfo->filename));
+  if (text == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout_with_lock;
+    }
+
+#ifdef CONFIG_ARCH_USE_TEXT_HEAP
+  text->image = up_textheap_memalign(align, size);
+#else
+  text->image = lib_memalign(align, size);
+#endif
+  if (text->image == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout_with_text;
+    }
+
+  ret = modlib_read(loadinfo, text->image, size, 0);
+  if (ret < 0)
+    {
+      goto errout_with_image;
+    }
+
+  text->filelen   = loadinfo->filelen;
+  text->fileino   = loadinfo->fileino;
+  text->filemtime = loadinfo->filemtime;
+  text->crefs     = 1;
+  strcpy(text->filename, loadinfo->filename);
+
+  text->flink   = g_modlib_text;
+  g_modlib_text = text;
+
+  loadinfo->xipbase = (uintptr_t)text->image;
+  nxmutex_unlock(&g_modlib_textlock);
+  return OK;
+
+errout_with_image:
+#ifdef CONFIG_ARCH_USE_TEXT_HEAP
+  up_textheap_free(text->image);
+#else
+  lib_free(text->image);
+#endif
+
+errout_with_text:
+  lib_free(text);
+
+errout_with_lock:
+  nxmutex_unlock(&g_modlib_textlock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: modlib_unsharetext
+ *
+ * Description:
+ *   Release the text shared by modlib_sharetext(), freeing it with its
+ *   last instance.  Nothing is done if 'xipbase' is not a shared copy, but
+ *   a file really executed in place.
+ *
+ ****************************************************************************/
+
+void modlib_unsharetext(uintptr_t xipbase)
+{
+  FAR struct modlib_text_s *prev = NULL;
+  FAR struct modlib_text_s *text;
+
+  nxmutex_lock(&g_modlib_textlock);
+
+  for (text = g_modlib_text; text != NULL; text = text->flink)
+    {
+      if ((uintptr_t)text->image == xipbase)
+        {
+          if (--text->crefs == 0)
+            {
+              if (prev == NULL)
+                {
+                  g_modlib_text = text->flink;
+                }
+              else
+                {
+                  prev->flink = text->flink;
+                }
+
+#ifdef CONFIG_ARCH_USE_TEXT_HEAP
+              up_textheap_free(text->image);
+#else
+              lib_free(text->image);
+#endif
+              lib_free(text);
+            }
+
+          break;
+        }
+
+      prev = text;
+    }
+
+  nxmutex_unlock(&g_modlib_textlock);
+}
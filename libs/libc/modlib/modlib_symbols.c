@@ -48,6 +48,12 @@
 #define SYM_NOT_FOUND 0
 #define SYM_FOUND     1
 
+/* Room for the names of the exported symbols in the first chunk of their
+ * arena, after the table
+ */
+
+#define MODLIB_SYMNAME_CHUNK 256
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -72,6 +78,19 @@ struct eptable_s
 extern struct eptable_s global_table[];
 extern int nglobals;
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SYMTAB_HASH
+/* The hash index of the kernel symbol table */
+
+static struct symtab_hash_s g_modlib_symhash;
+#  define MODLIB_SYMHASH (&g_modlib_symhash)
+#else
+#  define MODLIB_SYMHASH NULL
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -203,9 +222,10 @@ static int modlib_symcallback(FAR struct module_s *modp, FAR void *arg)
 
   /* Check if this module exports a symbol of that name */
 
-  exportinfo->symbol = symtab_findbyname(modp->modinfo.exports,
-                                         exportinfo->name,
-                                         modp->modinfo.nexports);
+  exportinfo->symbol = modlib_findexport(MODLIB_EXPHASH(modp),
+                                         modp->modinfo.exports,
+                                         modp->modinfo.nexports,
+                                         exportinfo->name);
 
   if (exportinfo->symbol != NULL)
     {
@@ -408,8 +428,8 @@ int modlib_symvalue(FAR struct module_s *modp,
 
         if (symbol == NULL)
           {
-            symbol = symtab_findbyname(exports, exportinfo.name,
-                                       nexports);
+            symbol = modlib_findexport(MODLIB_SYMHASH, exports, nexports,
+                                       exportinfo.name);
           }
 
         /* Was the symbol found from any exporter? */
@@ -456,6 +476,54 @@ int modlib_symvalue(FAR struct module_s *modp,
   return OK;
 }
 
+/****************************************************************************
+ * Name: modlib_findexport
+ *
+ * Description:
+ *   Find a symbol by name in a table of exported symbols, through the hash
+ *   index of the table with CONFIG_SYMTAB_HASH.  The caller holds the
+ *   registry lock.
+ *
+ * Input Parameters:
+ *   hash     - The hash index of the table, NULL if there is none
+ *   exports  - The table of exported symbols
+ *   nexports - The number of symbols in the exports table
+ *   name     - The name of the symbol
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if an entry with the matching
+ *   name is found; NULL is returned if the entry is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *
+modlib_findexport(FAR struct symtab_hash_s *hash,
+                  FAR const struct symtab_s *exports, int nexports,
+                  FAR const char *name)
+{
+#ifdef CONFIG_SYMTAB_HASH
+  if (hash != NULL && exports != NULL)
+    {
+      /* Index the table at its first lookup, or again if it was replaced.
+       * Without memory for the index, the table is searched instead.
+       */
+
+      if (hash->symtab != exports || hash->nsyms != nexports)
+        {
+          symtab_hashfree(hash);
+          if (symtab_hashinit(hash, exports, nexports) < 0)
+            {
+              return symtab_findbyname(exports, name, nexports);
+            }
+        }
+
+      return symtab_findbyhash(hash, name);
+    }
+#endif
+
+  return symtab_findbyname(exports, name, nexports);
+}
+
 /****************************************************************************
  * Name: modlib_insertsymtab
  *
@@ -511,9 +579,17 @@ int modlib_insertsymtab(FAR struct module_s *modp,
 
   if (symcount > 0)
     {
+      /* The table and the names of the symbols are freed together with
+       * the module:  Allocate them from the symbol arena of the module,
+       * in chunks that fit the table and some names.
+       */
+
+      lib_arena_init(&modp->symarena,
+                     sizeof(*symbol) * symcount + MODLIB_SYMNAME_CHUNK);
       modp->modinfo.exports = symbol =
                               loadinfo->exported =
-                              lib_malloc(sizeof(*symbol) * symcount);
+                              lib_arena_alloc(&modp->symarena,
+                                              sizeof(*symbol) * symcount);
       if (modp->modinfo.exports)
         {
           /* Build out module's symbol table */
@@ -527,15 +603,25 @@ int modlib_insertsymtab(FAR struct module_s *modp,
                   ELF_ST_VISIBILITY(sym[i].st_other) == STV_DEFAULT)
                 {
                   ret = modlib_symname(loadinfo, &sym[i], strtab->sh_offset);
+                  if (ret >= 0)
+                    {
+                      symbol[j].sym_name =
+                        lib_arena_strdup(&modp->symarena,
+                                         (FAR char *)loadinfo->iobuffer);
+                      if (symbol[j].sym_name == NULL)
+                        {
+                          ret = -ENOMEM;
+                        }
+                    }
+
                   if (ret < 0)
                     {
-                      lib_free((FAR void *)modp->modinfo.exports);
+                      lib_arena_release(&modp->symarena);
                       modp->modinfo.exports = NULL;
+                      loadinfo->exported = NULL;
                       return ret;
                     }
 
-                  symbol[j].sym_name =
-                      strdup((FAR char *)loadinfo->iobuffer);
                   symbol[j].sym_value =
                       (FAR const void *)(uintptr_t)sym[i].st_value;
                   j++;
@@ -627,16 +713,9 @@ void *modlib_findglobal(FAR struct module_s *modp,
 
 void modlib_freesymtab(FAR struct module_s *modp)
 {
-  FAR const struct symtab_s *symbol;
-  int i;
-
-  if ((symbol = modp->modinfo.exports) != NULL)
-    {
-      for (i = 0; i < modp->modinfo.nexports; i++)
-        {
-          lib_free((FAR void *)symbol[i].sym_name);
-        }
+#ifdef CONFIG_SYMTAB_HASH
+  symtab_hashfree(&modp->exphash);
+#endif
 
-      lib_free((FAR void *)symbol);
-    }
+  lib_arena_release(&modp->symarena);
 }
@@ -85,17 +85,9 @@ int modlib_freebuffers(FAR struct mod_loadinfo_s *loadinfo)
 {
   /* Release all working allocations  */
 
-  if (loadinfo->shdr != NULL)
-    {
-      lib_free(loadinfo->shdr);
-      loadinfo->shdr = NULL;
-    }
-
-  if (loadinfo->phdr != NULL)
-    {
-      lib_free(loadinfo->phdr);
-      loadinfo->phdr = NULL;
-    }
+  lib_arena_release(&loadinfo->hdrarena);
+  loadinfo->shdr = NULL;
+  loadinfo->phdr = NULL;
 
   if (loadinfo->iobuffer != NULL)
     {
@@ -104,5 +96,14 @@ int modlib_freebuffers(FAR struct mod_loadinfo_s *loadinfo)
       loadinfo->buflen   = 0;
     }
 
+#if CONFIG_MODLIB_READAHEAD > 0
+  if (loadinfo->readbuf != NULL)
+    {
+      lib_free(loadinfo->readbuf);
+      loadinfo->readbuf = NULL;
+      loadinfo->readlen = 0;
+    }
+#endif
+
   return OK;
 }
@@ -108,6 +108,10 @@ int modlib_unload(FAR struct mod_loadinfo_s *loadinfo)
           lib_free((FAR void *)loadinfo->textalloc);
 #  endif
         }
+      else
+        {
+          modlib_unsharetext(loadinfo->xipbase);
+        }
 
       if (loadinfo->datastart != 0)
         {
@@ -0,0 +1,164 @@
+/****************************************************************************
+ * libs/libc/obstack/lib_arena.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/lib/arena.h>
+#include <nuttx/lib/lib.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define ARENA_HDRSIZE LIB_ARENA_SIZE(sizeof(struct _obstack_chunk))
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_arena_init
+ *
+ * Description:
+ *   Initialize an arena that allocates chunks of at least 'chunksize'
+ *   bytes of objects.
+ *
+ ****************************************************************************/
+
+void lib_arena_init(FAR struct obstack *arena, size_t chunksize)
+{
+  obstack_init(arena);
+  arena->chunk_size = LIB_ARENA_SIZE(chunksize);
+}
+
+/****************************************************************************
+ * Name: lib_arena_alloc
+ *
+ * Description:
+ *   Allocate 'size' bytes aligned to LIB_ARENA_ALIGN from an arena.
+ *
+ ****************************************************************************/
+
+FAR void *lib_arena_alloc(FAR struct obstack *arena, size_t size)
+{
+  FAR struct _obstack_chunk *chunk = arena->chunk;
+  FAR char *object;
+  size_t room = 0;
+
+  if (size > SIZE_MAX - ARENA_HDRSIZE - LIB_ARENA_ALIGN)
+    {
+      return NULL;
+    }
+
+  size = LIB_ARENA_SIZE(size);
+  if (chunk != NULL)
+    {
+      room = chunk->limit - arena->next_free;
+      if (room >= size)
+        {
+          object = arena->next_free;
+          arena->next_free  += size;
+          arena->object_base = arena->next_free;
+          return object;
+        }
+    }
+
+  chunk = lib_malloc(ARENA_HDRSIZE +
+                     (size > arena->chunk_size ? size : arena->chunk_size));
+  if (chunk == NULL)
+    {
+      return NULL;
+    }
+
+  DEBUGASSERT(((uintptr_t)chunk & (LIB_ARENA_ALIGN - 1)) == 0);
+
+  object = (FAR char *)chunk + ARENA_HDRSIZE;
+  if (size > arena->chunk_size && room > arena->chunk_size / 4)
+    {
+      /* An object larger than the chunks gets a chunk of its own, behind
+       * the current one, unless the room left there is little anyway.
+       */
+
+      chunk->limit = object + size;
+      chunk->prev  = arena->chunk->prev;
+      arena->chunk->prev = chunk;
+      return object;
+    }
+
+  chunk->limit = object + (size > arena->chunk_size ?
+                           size : arena->chunk_size);
+  chunk->prev  = arena->chunk;
+  arena->chunk = chunk;
+
+  arena->next_free   = object + size;
+  arena->object_base = arena->next_free;
+  return object;
+}
+
+/****************************************************************************
+ * Name: lib_arena_zalloc
+ *
+ * Description:
+ *   Allocate 'size' bytes from an arena and clear them.
+ *
+ ****************************************************************************/
+
+FAR void *lib_arena_zalloc(FAR struct obstack *arena, size_t size)
+{
+  FAR void *object = lib_arena_alloc(arena, size);
+
+  if (object != NULL)
+    {
+      memset(object, 0, size);
+    }
+
+  return object;
+}
+
+/****************************************************************************
+ * Name: lib_arena_strdup
+ *
+ * Description:
+ *   Allocate a copy of the string 's' from an arena.
+ *
+ ****************************************************************************/
+
+FAR char *lib_arena_strdup(FAR struct obstack *arena, FAR const char *s)
+{
+  size_t len = strlen(s) + 1;
+  FAR char *copy = lib_arena_alloc(arena, len);
+
+  if (copy != NULL)
+    {
+      memcpy(copy, s, len);
+    }
+
+  return copy;
+}
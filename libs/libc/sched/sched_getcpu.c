@@ -0,0 +1,68 @@
+/****************************************************************************
+ * libs/libc/sched/sched_getcpu.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sched.h>
+
+#include <nuttx/tls.h>
+
+/* In the kernel, sched_getcpu() is provided by the OS.  User space reads
+ * the CPU that the kernel saves in the TLS when it switches to the thread.
+ */
+
+#if defined(CONFIG_SCHED_VDSO) && !defined(__KERNEL__)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_getcpu
+ *
+ * Description:
+ *   Returns the number of the CPU on which the calling thread is currently
+ *   executing.  The thread may have migrated to another CPU by the time the
+ *   caller uses the number.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   A non-negative CPU number.
+ *
+ ****************************************************************************/
+
+int sched_getcpu(void)
+{
+#ifdef CONFIG_SMP
+  return tls_get_info()->tl_cpu;
+#else
+  return 0;
+#endif
+}
+
+#endif /* CONFIG_SCHED_VDSO && !__KERNEL__ */
@@ -92,9 +92,11 @@ int sem_clockwait(FAR sem_t *sem, clockid_t clockid,
 
   enter_cancellation_point();
 
-  /* Let nxsem_timedout() do the work */
+  /* Take an available count without entering the OS, otherwise let
+   * nxsem_clockwait() do the work.
+   */
 
-  ret = nxsem_clockwait(sem, clockid, abstime);
+  ret = nxsem_fastwait(sem) ? OK : nxsem_clockwait(sem, clockid, abstime);
   if (ret < 0)
     {
       set_errno(-ret);
@@ -75,7 +75,9 @@ int sem_post(FAR sem_t *sem)
       return ERROR;
     }
 
-  ret = nxsem_post(sem);
+  /* Release the count without entering the OS if there are no waiters */
+
+  ret = nxsem_fastpost(sem) ? OK : nxsem_post(sem);
   if (ret < 0)
     {
       set_errno(-ret);
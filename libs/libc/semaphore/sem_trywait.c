@@ -65,9 +65,11 @@ int sem_trywait(FAR sem_t *sem)
       return ERROR;
     }
 
-  /* Let nxsem_trywait do the real work */
+  /* Take an available count without entering the OS, otherwise let
+   * nxsem_trywait() do the real work.
+   */
 
-  ret = nxsem_trywait(sem);
+  ret = nxsem_fastwait(sem) ? OK : nxsem_trywait(sem);
   if (ret < 0)
     {
       set_errno(-ret);
@@ -81,9 +81,11 @@ int sem_wait(FAR sem_t *sem)
 #endif
     }
 
-  /* Let nxsem_wait() do the real work */
+  /* Take an available count without entering the OS, otherwise let
+   * nxsem_wait() do the real work.
+   */
 
-  ret = nxsem_wait(sem);
+  ret = nxsem_fastwait(sem) ? OK : nxsem_wait(sem);
   if (ret < 0)
     {
       errcode = -ret;
@@ -42,6 +42,7 @@
 #include <sys/param.h>
 
 #include "lib_dtoa_engine.h"
+#include "libc.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -72,10 +73,205 @@
 #define MIN_MANT_INT  ((uint64_t)MIN_MANT)
 #define MIN_MANT_EXP  DBL_DIG
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef LIBC_HAVE_RYU
+static const uint64_t g_dtoa_pow10[] =
+{
+  UINT64_C(1), UINT64_C(10), UINT64_C(100), UINT64_C(1000),
+  UINT64_C(10000), UINT64_C(100000), UINT64_C(1000000),
+  UINT64_C(10000000), UINT64_C(100000000), UINT64_C(1000000000),
+  UINT64_C(10000000000), UINT64_C(100000000000),
+  UINT64_C(1000000000000), UINT64_C(10000000000000),
+  UINT64_C(100000000000000), UINT64_C(1000000000000000),
+  UINT64_C(10000000000000000), UINT64_C(100000000000000000)
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: dtoa_round
+ *
+ * Description:
+ *   Round the shortest decimal m10 * 10^e10 of 'x' with 'n' digits to
+ *   'k' < n digits:  The result is the rounding of 'x' itself, the decimal
+ *   is only ambiguous if the dropped digits are exactly a half.
+ *
+ ****************************************************************************/
+
+static uint64_t dtoa_round(double x, uint64_t m10, int e10, int n, int k)
+{
+  uint64_t half = 5 * g_dtoa_pow10[n - k - 1];
+  uint64_t rem = m10 % g_dtoa_pow10[n - k];
+  int cmp;
+
+  m10 /= g_dtoa_pow10[n - k];
+  if (rem == half)
+    {
+      cmp = lib_ryu_cmp(x, m10 * 10 + 5, e10 + n - k - 1);
+      return m10 + (cmp > 0 || (cmp == 0 && (m10 & 1) != 0));
+    }
+
+  return m10 + (rem > half);
+}
+
+/****************************************************************************
+ * Name: dtoa_refine
+ *
+ * Description:
+ *   Correct the 'k' digits 'm10' of 'x' of the exponent '*exp' to the
+ *   rounding of 'x':  More than DBL_DIG digits, or the digits of the
+ *   subnormal numbers, are not exactly those of the shortest decimal
+ *   followed by zeros.
+ *
+ ****************************************************************************/
+
+static uint64_t dtoa_refine(double x, uint64_t m10, FAR int32_t *exp, int k)
+{
+  int e10 = *exp - k;
+  int cmp;
+
+  for (; ; )
+    {
+      for (; ; )
+        {
+          cmp = lib_ryu_cmp(x, m10 * 10 + 5, e10);
+          if (cmp < 0 || (cmp == 0 && (m10 & 1) == 0))
+            {
+              break;
+            }
+
+          m10++;
+        }
+
+      for (; ; )
+        {
+          cmp = lib_ryu_cmp(x, m10 * 10 - 5, e10);
+          if (cmp > 0 || (cmp == 0 && (m10 & 1) == 0))
+            {
+              break;
+            }
+
+          m10--;
+        }
+
+      if (m10 >= g_dtoa_pow10[k])
+        {
+          m10 /= 10;
+          (*exp)++;
+        }
+      else if (m10 < g_dtoa_pow10[k - 1])
+        {
+          /* The leading digit was lost, x is just below a power of 10 */
+
+          m10 = m10 * 10 + 5;
+          (*exp)--;
+          e10--;
+          continue;
+        }
+
+      return m10;
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+#ifdef LIBC_HAVE_RYU
+int __dtoa_engine(double x, FAR struct dtoa_s *dtoa, int max_digits,
+                  int max_decimals)
+{
+  int32_t exp = 0;
+  uint8_t flags = 0;
+  uint64_t m10;
+  int e10;
+  int n;
+  int i;
+
+  if (x < 0)
+    {
+      flags |= DTOA_MINUS;
+      x = -x;
+    }
+
+  if (x == 0)
+    {
+      flags |= DTOA_ZERO;
+      for (i = 0; i < max_digits; i++)
+        dtoa->digits[i] = '0';
+    }
+  else if (isnan(x))
+    {
+      flags |= DTOA_NAN;
+    }
+  else if (isinf(x))
+    {
+      flags |= DTOA_INF;
+    }
+  else
+    {
+      /* The shortest decimal that reads back as x */
+
+      m10 = lib_ryu_d2s(x, &e10);
+      for (n = 1; n < 17 && m10 >= g_dtoa_pow10[n]; n++);
+
+      exp = e10 + n - 1;
+
+      /* If limiting decimals, then limit the max digits to no more than the
+       * number of digits left of the decimal plus the number of digits right
+       * of the decimal.  No digit is left if x rounds to zero, and the digit
+       * 1 of the next exponent if x rounds to it.
+       */
+
+      if (max_decimals != 0)
+        {
+          max_digits = MIN(max_digits, max_decimals + exp + 1);
+          if (max_digits <= 0)
+            {
+              m10 = max_digits == 0 ? dtoa_round(x, m10, e10, n, 0) : 0;
+              max_digits = (int)m10;
+              exp += (int)m10;
+              n = max_digits;
+            }
+        }
+
+      if (max_digits > 0 && max_digits < n)
+        {
+          m10 = dtoa_round(x, m10, e10, n, max_digits);
+          if (m10 >= g_dtoa_pow10[max_digits])
+            {
+              m10 /= 10;
+              exp++;
+            }
+        }
+      else if (max_digits > n)
+        {
+          m10 *= g_dtoa_pow10[max_digits - n];
+          if (max_digits > DBL_DIG || x < DBL_MIN)
+            {
+              m10 = dtoa_refine(x, m10, &exp, max_digits);
+            }
+        }
+
+      for (i = max_digits - 1; i >= 0; i--)
+        {
+          dtoa->digits[i] = m10 % 10 + '0';
+          m10 /= 10;
+        }
+    }
+
+  dtoa->digits[max_digits] = '\0';
+  dtoa->flags = flags;
+  dtoa->exp = exp;
+  return max_digits;
+}
+#else
 int __dtoa_engine(double x, FAR struct dtoa_s *dtoa, int max_digits,
                   int max_decimals)
 {
@@ -181,3 +377,4 @@ int __dtoa_engine(double x, FAR struct dtoa_s *dtoa, int max_digits,
   dtoa->exp = exp;
   return max_digits;
 }
+#endif
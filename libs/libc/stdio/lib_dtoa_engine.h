@@ -49,7 +49,16 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define DTOA_MAX_DIG        DBL_DIG
+/* The Ryu conversion prints the 17 digits needed to read back the same
+ * double exactly.
+ */
+
+#if defined(CONFIG_LIBC_RYU) && defined(CONFIG_HAVE_DOUBLE) && \
+    DBL_MANT_DIG == 53
+#  define DTOA_MAX_DIG      17
+#else
+#  define DTOA_MAX_DIG      DBL_DIG
+#endif
 
 #define DTOA_MINUS          1
 #define DTOA_ZERO           2
@@ -29,6 +29,32 @@
 #include <string.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <errno.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bspack
+ *
+ * Description:
+ *   Append an unaligned value to the buffer of lib_vbspack().
+ *
+ ****************************************************************************/
+
+static int bspack(FAR char *buf, size_t size, FAR size_t *offset,
+                  FAR const void *value, size_t len)
+{
+  if (len > size - *offset)
+    {
+      return -E2BIG;
+    }
+
+  memcpy(buf + *offset, value, len);
+  *offset += len;
+  return OK;
+}
 
 /****************************************************************************
  * Public Functions
@@ -81,6 +107,7 @@ int lib_bsprintf(FAR struct lib_outstream_s *s, FAR const IPTR char *fmt,
       if (!infmt)
         {
           len = 0;
+          prec = NULL;
           infmt = true;
           memset(fmtstr, 0, sizeof(fmtstr));
         }
@@ -163,6 +190,13 @@ int lib_bsprintf(FAR struct lib_outstream_s *s, FAR const IPTR char *fmt,
         }
       else if (c == '*')
         {
+          /* A precision given as an argument is the length of its string */
+
+          if (prec != NULL)
+            {
+              prec = fmtstr + len - 1;
+            }
+
           sprintf(fmtstr + len - 1, "%d", var->i);
           len = strlen(fmtstr);
           offset += sizeof(var->i);
@@ -198,3 +232,195 @@ int lib_bsprintf(FAR struct lib_outstream_s *s, FAR const IPTR char *fmt,
 
   return ret;
 }
+
+/****************************************************************************
+ * Name: lib_vbspack
+ *
+ * Description:
+ *  Pack the arguments of a format in 'buf' as lib_bsprintf() expects them.
+ *  The strings are copied:  The whole string with its terminator, or as
+ *  many bytes as the precision.
+ *
+ ****************************************************************************/
+
+int lib_vbspack(FAR void *buf, size_t size, FAR const IPTR char *fmt,
+                va_list ap)
+{
+  begin_packed_struct union
+    {
+      char c;
+      short int si;
+      int i;
+      long l;
+#ifdef CONFIG_HAVE_LONG_LONG
+      long long ll;
+#endif
+      intmax_t im;
+      size_t sz;
+      ptrdiff_t pd;
+      uintptr_t p;
+#ifdef CONFIG_HAVE_DOUBLE
+      float f;
+      double d;
+#  ifdef CONFIG_HAVE_LONG_DOUBLE
+      long double ld;
+#  endif
+#endif
+    }
+
+  end_packed_struct var;
+  FAR char *data = buf;
+  bool infmt = false;
+  size_t offset = 0;
+  size_t vlen = 0;
+  int prec = -1;
+  bool inprec = false;
+  int ret = OK;
+  char c;
+
+  while ((c = *fmt++) != '\0')
+    {
+      if (c != '%' && !infmt)
+        {
+          continue;
+        }
+
+      if (!infmt)
+        {
+          infmt = true;
+          inprec = false;
+          prec = -1;
+        }
+
+      if (c == 'c' || c == 'd' || c == 'i' || c == 'u' ||
+          c == 'o' || c == 'x' || c == 'X')
+        {
+          if (*(fmt - 2) == 'j')
+            {
+              var.im = va_arg(ap, intmax_t);
+              vlen = sizeof(var.im);
+            }
+#ifdef CONFIG_HAVE_LONG_LONG
+          else if (*(fmt - 2) == 'l' && *(fmt - 3) == 'l')
+            {
+              var.ll = va_arg(ap, long long);
+              vlen = sizeof(var.ll);
+            }
+#endif
+          else if (*(fmt - 2) == 'l')
+            {
+              var.l = va_arg(ap, long);
+              vlen = sizeof(var.l);
+            }
+          else if (*(fmt - 2) == 'z')
+            {
+              var.sz = va_arg(ap, size_t);
+              vlen = sizeof(var.sz);
+            }
+          else if (*(fmt - 2) == 't')
+            {
+              var.pd = va_arg(ap, ptrdiff_t);
+              vlen = sizeof(var.pd);
+            }
+          else if (*(fmt - 2) == 'h' && *(fmt - 3) == 'h')
+            {
+              var.c = (char)va_arg(ap, int);
+              vlen = sizeof(var.c);
+            }
+          else if (*(fmt - 2) == 'h')
+            {
+              var.si = (short int)va_arg(ap, int);
+              vlen = sizeof(var.si);
+            }
+          else
+            {
+              var.i = va_arg(ap, int);
+              vlen = sizeof(var.i);
+            }
+
+          ret = bspack(data, size, &offset, &var, vlen);
+          infmt = false;
+        }
+      else if (c == 'e' || c == 'f' || c == 'g' || c == 'a' ||
+               c == 'A' || c == 'E' || c == 'F' || c == 'G')
+        {
+#ifdef CONFIG_HAVE_DOUBLE
+          if (*(fmt - 2) == 'h')
+            {
+              var.f = (float)va_arg(ap, double);
+              vlen = sizeof(var.f);
+            }
+#  ifdef CONFIG_HAVE_LONG_DOUBLE
+          else if (*(fmt - 2) == 'L')
+            {
+              var.ld = va_arg(ap, long double);
+              vlen = sizeof(var.ld);
+            }
+#  endif
+          else
+            {
+              var.d = va_arg(ap, double);
+              vlen = sizeof(var.d);
+            }
+
+          ret = bspack(data, size, &offset, &var, vlen);
+          infmt = false;
+#else
+          /* lib_bsprintf() cannot format the floating point values */
+
+          return -ENOTSUP;
+#endif
+        }
+      else if (c == '*')
+        {
+          var.i = va_arg(ap, int);
+          if (inprec)
+            {
+              prec = var.i;
+            }
+
+          ret = bspack(data, size, &offset, &var, sizeof(var.i));
+        }
+      else if (c == 's')
+        {
+          FAR const char *value = va_arg(ap, FAR const char *);
+
+          if (prec >= 0)
+            {
+              vlen = strnlen(value, prec);
+              if ((size_t)prec > size - offset)
+                {
+                  return -E2BIG;
+                }
+
+              memcpy(data + offset, value, vlen);
+              memset(data + offset + vlen, 0, prec - vlen);
+              offset += prec;
+            }
+          else
+            {
+              ret = bspack(data, size, &offset, value, strlen(value) + 1);
+            }
+
+          infmt = false;
+        }
+      else if (c == 'p')
+        {
+          var.p = (uintptr_t)va_arg(ap, FAR void *);
+          ret = bspack(data, size, &offset, &var, sizeof(var.p));
+          infmt = false;
+        }
+      else if (c == '.')
+        {
+          inprec = true;
+          prec = *fmt == '*' ? -1 : (int)strtol(fmt, NULL, 10);
+        }
+
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  return offset;
+}
@@ -194,6 +194,30 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
     {
       for (; ; )
         {
+#if !defined(CONFIG_ARCH_ROMGETC) && !defined(CONFIG_AVR_HAS_MEMX_PTR)
+          /* Write the run of plain characters up to the next conversion at
+           * once, unless the format may be in code space.
+           */
+
+          pnt = fmt;
+          while (*fmt != '\0' && *fmt != '%')
+            {
+              fmt++;
+            }
+
+          if (fmt != pnt)
+            {
+#ifdef CONFIG_LIBC_NUMBERED_ARGS
+              if (stream != NULL)
+                {
+                  stream_puts(pnt, fmt - pnt, stream);
+                }
+#else
+              stream_puts(pnt, fmt - pnt, stream);
+#endif
+            }
+#endif
+
           c = fmt_char(fmt);
           if (c == '\0')
             {
@@ -1313,9 +1337,19 @@ str_lpad:
           prec--;
         }
 
-      while (c)
+      if (c > 0)
         {
-          stream_putc(buf[--c], stream);
+          /* The digits are in reverse order, write them at once */
+
+          for (len = 0; len < c / 2; len++)
+            {
+              char tmp = buf[len];
+
+              buf[len] = buf[c - 1 - len];
+              buf[c - 1 - len] = tmp;
+            }
+
+          stream_puts(buf, c, stream);
         }
 
 tail:
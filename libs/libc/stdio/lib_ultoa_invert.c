@@ -39,6 +39,27 @@
 
 #include "lib_ultoa_invert.h"
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The decimal numbers are converted two digits per division */
+
+static const char g_digits2[] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+static const char g_xdigits[] = "0123456789abcdef";
+static const char g_xdigits_upper[] = "0123456789ABCDEF";
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -49,14 +70,56 @@ FAR char *__ultoa_invert(unsigned long long val, FAR char *str, int base)
 FAR char *__ultoa_invert(unsigned long val, FAR char *str, int base)
 #endif
 {
+  FAR const char *digits = g_xdigits;
   int upper = 0;
+  int shift;
 
   if (base & XTOA_UPPER)
     {
+      digits = g_xdigits_upper;
       upper = 1;
       base &= ~XTOA_UPPER;
     }
 
+  if (base == 10)
+    {
+      while (val >= 100)
+        {
+          unsigned int v = val % 100;
+
+          val /= 100;
+          *str++ = g_digits2[2 * v + 1];
+          *str++ = g_digits2[2 * v];
+        }
+
+      if (val >= 10)
+        {
+          *str++ = g_digits2[2 * val + 1];
+          *str++ = g_digits2[2 * val];
+        }
+      else
+        {
+          *str++ = '0' + val;
+        }
+
+      return str;
+    }
+
+  /* The powers of two need no division */
+
+  shift = base == 16 ? 4 : base == 8 ? 3 : base == 2 ? 1 : 0;
+  if (shift > 0)
+    {
+      do
+        {
+          *str++ = digits[val & (base - 1)];
+          val >>= shift;
+        }
+      while (val);
+
+      return str;
+    }
+
   do
     {
       int v;
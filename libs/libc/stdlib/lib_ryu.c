@@ -0,0 +1,775 @@
+/****************************************************************************
+ * libs/libc/stdlib/lib_ryu.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* The conversions implement the Ryu algorithms of Ulf Adams:  "Ryu: Fast
+ * Float-to-String Conversion" (PLDI 2018) and "Ryu Revisited: Printf
+ * Floating Point Conversion" (OOPSLA 2019).  The 125 bits approximations
+ * of the powers of 5 are computed from one power in 26 and corrected by
+ * two bits from a table, so the tables take about 900 bytes instead of
+ * 10 KiB.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libc.h"
+
+#ifdef LIBC_HAVE_RYU
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define DOUBLE_MANTISSA_BITS  52
+#define DOUBLE_EXPONENT_BITS  11
+#define DOUBLE_EXPONENT_BIAS  1023
+
+#define POW5_BITCOUNT         125
+#define POW5_INV_BITCOUNT     125
+#define POW5_TABLE_SIZE       26
+
+/* Words of the integers compared by ryu_cmp(), enough for 5^343 * 2^53 */
+
+#define BIGNUM_WORDS          36
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct bignum_s
+{
+  int      nwords;
+  uint32_t words[BIGNUM_WORDS];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* 5^(26 * i), POW5_BITCOUNT bits, low word first */
+
+static const uint64_t g_pow5_split2[][2] =
+{
+  { 0x0000000000000000ull, 0x1000000000000000ull },
+  { 0x0000000000000000ull, 0x14adf4b7320334b9ull },
+  { 0x0e549208b31adb10ull, 0x1aba4714957d300dull },
+  { 0x6dc6ad264d8f0866ull, 0x1145b7e285bf98f5ull },
+  { 0xeb1dbd923d8596caull, 0x1652efdc6018a1fcull },
+  { 0xb4c1b80b22ae923cull, 0x1cda62055b2d9d83ull },
+  { 0x5bb28b4e8f7e4c30ull, 0x12a5568b9f52f416ull },
+  { 0xf08aed437682d4fbull, 0x1819651531f9e78full },
+  { 0xb4ee134ad99bf150ull, 0x1f25c186a6f04c28ull },
+  { 0x16499ecb70c25f03ull, 0x1420eb449c8842e6ull },
+  { 0x85a56ead360865b0ull, 0x1a03fde214caf085ull },
+  { 0x093db1d57999890bull, 0x10cfeb353a97dad8ull },
+  { 0xcf38bb735e3f36acull, 0x15baaf44fa52673eull }
+};
+
+/* 2^(pow5bits(26 * i) - 1 + POW5_INV_BITCOUNT) / 5^(26 * i), rounded
+ * down
+ */
+
+static const uint64_t g_pow5_inv_split2[][2] =
+{
+  { 0x0000000000000000ull, 0x2000000000000000ull },
+  { 0x52a6c95fc0655033ull, 0x18c240c4aecb13bbull },
+  { 0x7ca8d50071dfc805ull, 0x1327fc58da0f6ff5ull },
+  { 0x6520247d3556476dull, 0x1da48ce468e7c702ull },
+  { 0x6139cdd76802e6e8ull, 0x16ef5b40c2fc7779ull },
+  { 0xf951a7ff43de8c78ull, 0x11bebdf578b2f391ull },
+  { 0x7be8bee8d6e957e7ull, 0x1b758d848fac54b0ull },
+  { 0x8bd3f9e999a423e9ull, 0x153eda614071a3b7ull },
+  { 0x0848f973cb3ee3cdull, 0x10701bd527b4978cull },
+  { 0x153285ebb9efbfa1ull, 0x196fbb9bb44db44dull },
+  { 0xadeee7f86c07b695ull, 0x13ae3591f5b4d936ull },
+  { 0x4d686a4eaf182221ull, 0x1e74404f3daada91ull },
+  { 0x98c0a106e09ebd9eull, 0x17900ea4fda7c257ull },
+  { 0x8f20e37371497d0dull, 0x123b140576d820b2ull },
+  { 0xb043138134743d84ull, 0x1c35f4275f7a29adull }
+};
+
+/* 5^i */
+
+static const uint64_t g_pow5_table[POW5_TABLE_SIZE] =
+{
+  0x0000000000000001ull, 0x0000000000000005ull, 0x0000000000000019ull,
+  0x000000000000007dull, 0x0000000000000271ull, 0x0000000000000c35ull,
+  0x0000000000003d09ull, 0x000000000001312dull, 0x000000000005f5e1ull,
+  0x00000000001dcd65ull, 0x00000000009502f9ull, 0x0000000002e90eddull,
+  0x000000000e8d4a51ull, 0x0000000048c27395ull, 0x000000016bcc41e9ull,
+  0x000000071afd498dull, 0x0000002386f26fc1ull, 0x000000b1a2bc2ec5ull,
+  0x000003782dace9d9ull, 0x00001158e460913dull, 0x000056bc75e2d631ull,
+  0x0001b1ae4d6e2ef5ull, 0x000878678326eac9ull, 0x002a5a058fc295edull,
+  0x00d3c21bcecceda1ull, 0x0422ca8b0a00a425ull
+};
+
+/* The corrections of the computed powers, two bits per power */
+
+static const uint32_t g_pow5_offsets[] =
+{
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x40000000, 0x59695995,
+  0x55545555, 0x56555515, 0x41150504, 0x40555410, 0x44555145, 0x44504540,
+  0x45555550, 0x40004000, 0x96440440, 0x55565565, 0x54454045, 0x40154151,
+  0x55559155, 0x51405555, 0x00000105
+};
+
+static const uint32_t g_pow5_inv_offsets[] =
+{
+  0xa9a99aa9, 0x595aaa9a, 0x65596555, 0x55955969, 0x95565555, 0x966aaaaa,
+  0x555559a9, 0x55565599, 0x95555555, 0x99555596, 0xa59a99a5, 0xaaaa55a9,
+  0xa6baaaa9, 0x95559555, 0x56555556, 0x55565a55, 0xa6a6a966, 0x5aaaaaa9,
+  0xa5966a55, 0x95595555, 0x5a595665, 0x00000555
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* ceil(log2(5^e)) for 0 < e <= 3528, 1 for e == 0 */
+
+static inline int32_t pow5bits(int32_t e)
+{
+  return (int32_t)(((uint32_t)e * 1217359) >> 19) + 1;
+}
+
+/* floor(log10(2^e)) for 0 <= e <= 1650 */
+
+static inline uint32_t log10pow2(int32_t e)
+{
+  return ((uint32_t)e * 78913) >> 18;
+}
+
+/* floor(log10(5^e)) for 0 <= e <= 2620 */
+
+static inline uint32_t log10pow5(int32_t e)
+{
+  return ((uint32_t)e * 732923) >> 20;
+}
+
+static inline int floor_log2(uint64_t value)
+{
+#ifdef CONFIG_HAVE_BUILTIN_CLZ
+  return 63 - __builtin_clzll(value);
+#else
+  int n = 0;
+
+  while (value >>= 1)
+    {
+      n++;
+    }
+
+  return n;
+#endif
+}
+
+static inline uint32_t pow5factor(uint64_t value)
+{
+  uint32_t count = 0;
+
+  while (value % 5 == 0)
+    {
+      value /= 5;
+      count++;
+    }
+
+  return count;
+}
+
+static inline bool multiple_of_pow5(uint64_t value, uint32_t p)
+{
+  return pow5factor(value) >= p;
+}
+
+static inline bool multiple_of_pow2(uint64_t value, uint32_t p)
+{
+  return (value & ((UINT64_C(1) << p) - 1)) == 0;
+}
+
+/* The 128 bits product of a and b */
+
+static inline uint64_t umul128(uint64_t a, uint64_t b, FAR uint64_t *hi)
+{
+#ifdef __SIZEOF_INT128__
+  unsigned __int128 p = (unsigned __int128)a * b;
+
+  *hi = (uint64_t)(p >> 64);
+  return (uint64_t)p;
+#else
+  uint64_t a_lo = (uint32_t)a;
+  uint64_t a_hi = a >> 32;
+  uint64_t b_lo = (uint32_t)b;
+  uint64_t b_hi = b >> 32;
+  uint64_t ll = a_lo * b_lo;
+  uint64_t lh = a_lo * b_hi;
+  uint64_t hl = a_hi * b_lo;
+  uint64_t hh = a_hi * b_hi;
+  uint64_t mid = (ll >> 32) + (uint32_t)lh + (uint32_t)hl;
+
+  *hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+  return (mid << 32) | (uint32_t)ll;
+#endif
+}
+
+/* lo and hi shifted right by 0 <= dist < 128, the low 64 bits */
+
+static inline uint64_t shiftright128(uint64_t lo, uint64_t hi, int dist)
+{
+  if (dist == 0)
+    {
+      return lo;
+    }
+  else if (dist < 64)
+    {
+      return (hi << (64 - dist)) | (lo >> dist);
+    }
+
+  return hi >> (dist - 64);
+}
+
+/* Compute the approximation of 5^i (inv false) or of its inverse (inv
+ * true) with the power in the table that is closest and the exact power
+ * 5^offset.
+ */
+
+static void ryu_pow5(uint32_t i, bool inv, FAR uint64_t *result)
+{
+  FAR const uint64_t *mul;
+  uint64_t b0_hi;
+  uint64_t b2_hi;
+  uint64_t w0;
+  uint64_t w1;
+  uint64_t w2;
+  uint32_t corr;
+  uint32_t base;
+  int delta;
+
+  if (inv)
+    {
+      base  = (i + POW5_TABLE_SIZE - 1) / POW5_TABLE_SIZE;
+      mul   = g_pow5_inv_split2[base];
+      w0    = g_pow5_table[base * POW5_TABLE_SIZE - i];
+      delta = pow5bits(base * POW5_TABLE_SIZE) - pow5bits(i);
+      corr  = g_pow5_inv_offsets[i / 16] >> ((i % 16) << 1);
+    }
+  else
+    {
+      base  = i / POW5_TABLE_SIZE;
+      mul   = g_pow5_split2[base];
+      w0    = g_pow5_table[i - base * POW5_TABLE_SIZE];
+      delta = pow5bits(i) - pow5bits(base * POW5_TABLE_SIZE);
+      corr  = g_pow5_offsets[i / 16] >> ((i % 16) << 1);
+    }
+
+  /* The 192 bits product of the power in the table and 5^offset */
+
+  w1  = w0;
+  w0  = umul128(w1, mul[0], &b0_hi);
+  w1  = umul128(w1, mul[1], &b2_hi);
+  w2  = b2_hi;
+  w1 += b0_hi;
+  w2 += w1 < b0_hi;
+
+  result[0] = shiftright128(w0, w1, delta);
+  result[1] = shiftright128(w1, w2, delta);
+  result[0] += corr & 3;
+  result[1] += result[0] < (corr & 3);
+}
+
+/* (m * mul) >> j, with the low 64 bits of the product dropped */
+
+static inline uint64_t mulshift64(uint64_t m, FAR const uint64_t *mul,
+                                  int32_t j)
+{
+  uint64_t b0_hi;
+  uint64_t b2_hi;
+  uint64_t lo;
+
+  umul128(m, mul[0], &b0_hi);
+  lo = umul128(m, mul[1], &b2_hi);
+  lo += b0_hi;
+  b2_hi += lo < b0_hi;
+
+  return shiftright128(lo, b2_hi, j - 64);
+}
+
+static void bignum_set(FAR struct bignum_s *n, uint64_t value)
+{
+  n->words[0] = (uint32_t)value;
+  n->words[1] = (uint32_t)(value >> 32);
+  n->nwords   = n->words[1] != 0 ? 2 : 1;
+}
+
+static void bignum_mul(FAR struct bignum_s *n, uint32_t value)
+{
+  uint64_t carry = 0;
+  int i;
+
+  for (i = 0; i < n->nwords; i++)
+    {
+      carry += (uint64_t)n->words[i] * value;
+      n->words[i] = (uint32_t)carry;
+      carry >>= 32;
+    }
+
+  if (carry != 0)
+    {
+      n->words[n->nwords++] = (uint32_t)carry;
+    }
+}
+
+static void bignum_mulpow5(FAR struct bignum_s *n, int e)
+{
+  /* 5^13 is the largest power of 5 in 32 bits */
+
+  for (; e >= 13; e -= 13)
+    {
+      bignum_mul(n, 1220703125);
+    }
+
+  bignum_mul(n, (uint32_t)g_pow5_table[e]);
+}
+
+static void bignum_shl(FAR struct bignum_s *n, int shift)
+{
+  int words = shift / 32;
+  int bits = shift % 32;
+  int i;
+
+  if (bits != 0)
+    {
+      n->words[n->nwords] = 0;
+      for (i = n->nwords; i > 0; i--)
+        {
+          n->words[i] = (n->words[i] << bits) |
+                        (n->words[i - 1] >> (32 - bits));
+        }
+
+      n->words[0] <<= bits;
+      if (n->words[n->nwords] != 0)
+        {
+          n->nwords++;
+        }
+    }
+
+  if (words != 0)
+    {
+      memmove(&n->words[words], n->words, n->nwords * sizeof(uint32_t));
+      memset(n->words, 0, words * sizeof(uint32_t));
+      n->nwords += words;
+    }
+}
+
+static int bignum_cmp(FAR const struct bignum_s *a,
+                      FAR const struct bignum_s *b)
+{
+  int i;
+
+  if (a->nwords != b->nwords)
+    {
+      return a->nwords > b->nwords ? 1 : -1;
+    }
+
+  for (i = a->nwords - 1; i >= 0; i--)
+    {
+      if (a->words[i] != b->words[i])
+        {
+          return a->words[i] > b->words[i] ? 1 : -1;
+        }
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_ryu_d2s
+ *
+ * Description:
+ *   Compute the shortest decimal m10 * 10^e10 that reads back as 'x', the
+ *   closest to 'x' if there are several.  'x' is positive and finite.
+ *
+ * Returned Value:
+ *   m10, with at most 17 digits.
+ *
+ ****************************************************************************/
+
+uint64_t lib_ryu_d2s(double x, FAR int *e10)
+{
+  uint64_t mul[2];
+  uint64_t bits;
+  uint64_t mantissa;
+  uint64_t output;
+  uint64_t m2;
+  uint64_t mv;
+  uint64_t vr;
+  uint64_t vp;
+  uint64_t vm;
+  uint32_t exponent;
+  uint32_t mmshift;
+  uint8_t lastdigit = 0;
+  bool vmzeros = false;
+  bool vrzeros = false;
+  bool even;
+  int32_t removed = 0;
+  int32_t e2;
+  int32_t q;
+  int32_t i;
+  int32_t k;
+
+  memcpy(&bits, &x, sizeof(bits));
+  mantissa = bits & ((UINT64_C(1) << DOUBLE_MANTISSA_BITS) - 1);
+  exponent = (uint32_t)(bits >> DOUBLE_MANTISSA_BITS) &
+             ((1u << DOUBLE_EXPONENT_BITS) - 1);
+
+  /* Step 1: Decode the floating point number, with the two bits of the
+   * bounds of the interval.
+   */
+
+  if (exponent == 0)
+    {
+      e2 = 1 - DOUBLE_EXPONENT_BIAS - DOUBLE_MANTISSA_BITS - 2;
+      m2 = mantissa;
+    }
+  else
+    {
+      e2 = (int32_t)exponent - DOUBLE_EXPONENT_BIAS -
+           DOUBLE_MANTISSA_BITS - 2;
+      m2 = (UINT64_C(1) << DOUBLE_MANTISSA_BITS) | mantissa;
+    }
+
+  even    = (m2 & 1) == 0;
+  mv      = 4 * m2;
+  mmshift = mantissa != 0 || exponent <= 1;
+
+  /* Step 2: Convert the interval to a decimal power base */
+
+  if (e2 >= 0)
+    {
+      q    = log10pow2(e2) - (e2 > 3);
+      *e10 = q;
+      k    = POW5_INV_BITCOUNT + pow5bits(q) - 1;
+      i    = -e2 + q + k;
+
+      ryu_pow5(q, true, mul);
+      vr = mulshift64(4 * m2, mul, i);
+      vp = mulshift64(4 * m2 + 2, mul, i);
+      vm = mulshift64(4 * m2 - 1 - mmshift, mul, i);
+
+      if (q <= 21)
+        {
+          /* Only one of mp, mv, and mm can be a multiple of 5, if any */
+
+          if (mv % 5 == 0)
+            {
+              vrzeros = multiple_of_pow5(mv, q);
+            }
+          else if (even)
+            {
+              vmzeros = multiple_of_pow5(mv - 1 - mmshift, q);
+            }
+          else
+            {
+              vp -= multiple_of_pow5(mv + 2, q);
+            }
+        }
+    }
+  else
+    {
+      q    = log10pow5(-e2) - (-e2 > 1);
+      *e10 = q + e2;
+      i    = -e2 - q;
+      k    = pow5bits(i) - POW5_BITCOUNT;
+
+      ryu_pow5(i, false, mul);
+      vr = mulshift64(4 * m2, mul, q - k);
+      vp = mulshift64(4 * m2 + 2, mul, q - k);
+      vm = mulshift64(4 * m2 - 1 - mmshift, mul, q - k);
+
+      if (q <= 1)
+        {
+          /* mv = 4 * m2 has at least two trailing 0 bits */
+
+          vrzeros = true;
+          if (even)
+            {
+              vmzeros = mmshift == 1;
+            }
+          else
+            {
+              vp--;
+            }
+        }
+      else if (q < 63)
+        {
+          vrzeros = multiple_of_pow2(mv, q);
+        }
+    }
+
+  /* Step 3: Find the shortest decimal representation in the interval */
+
+  if (vmzeros || vrzeros)
+    {
+      /* The general case, which happens rarely */
+
+      while (vp / 10 > vm / 10)
+        {
+          vmzeros &= vm % 10 == 0;
+          vrzeros &= lastdigit == 0;
+          lastdigit = vr % 10;
+          vr /= 10;
+          vp /= 10;
+          vm /= 10;
+          removed++;
+        }
+
+      if (vmzeros)
+        {
+          while (vm % 10 == 0)
+            {
+              vrzeros &= lastdigit == 0;
+              lastdigit = vr % 10;
+              vr /= 10;
+              vp /= 10;
+              vm /= 10;
+              removed++;
+            }
+        }
+
+      if (vrzeros && lastdigit == 5 && vr % 2 == 0)
+        {
+          /* Round to even if the exact number is .....50..0 */
+
+          lastdigit = 4;
+        }
+
+      output = vr + ((vr == vm && (!even || !vmzeros)) || lastdigit >= 5);
+    }
+  else
+    {
+      bool roundup = false;
+
+      /* Remove two digits at a time in the common case */
+
+      if (vp / 100 > vm / 100)
+        {
+          roundup = vr % 100 >= 50;
+          vr /= 100;
+          vp /= 100;
+          vm /= 100;
+          removed += 2;
+        }
+
+      while (vp / 10 > vm / 10)
+        {
+          roundup = vr % 10 >= 5;
+          vr /= 10;
+          vp /= 10;
+          vm /= 10;
+          removed++;
+        }
+
+      output = vr + (vr == vm || roundup);
+    }
+
+  *e10 += removed;
+  return output;
+}
+
+/****************************************************************************
+ * Name: lib_ryu_cmp
+ *
+ * Description:
+ *   Compare exactly 'x' and the decimal m10 * 10^e10.  'x' is positive and
+ *   finite, -343 <= e10 <= 308.
+ *
+ * Returned Value:
+ *   A negative value, zero or a positive value if 'x' is less than, equal
+ *   to or greater than the decimal.
+ *
+ ****************************************************************************/
+
+int lib_ryu_cmp(double x, uint64_t m10, int e10)
+{
+  struct bignum_s a;
+  struct bignum_s b;
+  uint64_t bits;
+  uint64_t m2;
+  int exponent;
+  int e2;
+
+  memcpy(&bits, &x, sizeof(bits));
+  m2 = bits & ((UINT64_C(1) << DOUBLE_MANTISSA_BITS) - 1);
+  exponent = (int)(bits >> DOUBLE_MANTISSA_BITS) &
+             ((1 << DOUBLE_EXPONENT_BITS) - 1);
+
+  if (exponent == 0)
+    {
+      e2 = 1 - DOUBLE_EXPONENT_BIAS - DOUBLE_MANTISSA_BITS;
+    }
+  else
+    {
+      e2 = exponent - DOUBLE_EXPONENT_BIAS - DOUBLE_MANTISSA_BITS;
+      m2 |= UINT64_C(1) << DOUBLE_MANTISSA_BITS;
+    }
+
+  /* Compare m2 * 2^e2 and m10 * 5^e10 * 2^e10 */
+
+  bignum_set(&a, m2);
+  bignum_set(&b, m10);
+
+  if (e10 >= 0)
+    {
+      bignum_mulpow5(&b, e10);
+    }
+  else
+    {
+      bignum_mulpow5(&a, -e10);
+    }
+
+  if (e2 > e10)
+    {
+      bignum_shl(&a, e2 - e10);
+    }
+  else
+    {
+      bignum_shl(&b, e10 - e2);
+    }
+
+  return bignum_cmp(&a, &b);
+}
+
+/****************************************************************************
+ * Name: lib_ryu_s2d
+ *
+ * Description:
+ *   Compute the double nearest to the decimal m10 * 10^e10, rounding the
+ *   ties to even.  m10 has at most 17 digits.
+ *
+ * Returned Value:
+ *   The positive double, zero or infinity on underflow or overflow.
+ *
+ ****************************************************************************/
+
+double lib_ryu_s2d(uint64_t m10, int e10)
+{
+  uint64_t mul[2];
+  uint64_t ieee_m2;
+  uint64_t m2;
+  uint64_t bits;
+  uint32_t ieee_e2;
+  bool zeros;
+  bool roundup;
+  bool lastbit;
+  int32_t e2;
+  int32_t shift;
+  int digits;
+  double x;
+
+  digits = floor_log2(m10 | 1) * 1233 / 4096 + 1;
+  if (m10 == 0 || digits + e10 <= -324)
+    {
+      return 0.0;
+    }
+  else if (digits + e10 >= 310)
+    {
+      bits = UINT64_C(0x7ff) << DOUBLE_MANTISSA_BITS;
+      memcpy(&x, &bits, sizeof(x));
+      return x;
+    }
+
+  /* Compute the DOUBLE_MANTISSA_BITS + 1 top bits of m10 * 10^e10 and if
+   * the result is exact.
+   */
+
+  if (e10 >= 0)
+    {
+      e2 = floor_log2(m10) + e10 + pow5bits(e10) - 1 -
+           (DOUBLE_MANTISSA_BITS + 1);
+      ryu_pow5(e10, false, mul);
+      m2 = mulshift64(m10, mul, e2 - e10 - pow5bits(e10) + POW5_BITCOUNT);
+      zeros = e2 < e10 ||
+              (e2 - e10 < 64 && multiple_of_pow2(m10, e2 - e10));
+    }
+  else
+    {
+      e2 = floor_log2(m10) + e10 - pow5bits(-e10) -
+           (DOUBLE_MANTISSA_BITS + 1);
+      ryu_pow5(-e10, true, mul);
+      m2 = mulshift64(m10, mul, e2 - e10 + pow5bits(-e10) - 1 +
+                      POW5_INV_BITCOUNT);
+      zeros = multiple_of_pow5(m10, -e10);
+    }
+
+  /* Compute the final exponent, zero for the subnormal numbers */
+
+  e2 += DOUBLE_EXPONENT_BIAS + floor_log2(m2);
+  ieee_e2 = e2 > 0 ? e2 : 0;
+  if (ieee_e2 > 0x7fe)
+    {
+      bits = UINT64_C(0x7ff) << DOUBLE_MANTISSA_BITS;
+      memcpy(&x, &bits, sizeof(x));
+      return x;
+    }
+
+  shift = (ieee_e2 == 0 ? 1 : ieee_e2) - e2 + floor_log2(m2) -
+          DOUBLE_MANTISSA_BITS;
+
+  /* Round up if the removed bits are more than a half, or exactly a half
+   * and the result would be odd.
+   */
+
+  if (shift > 64)
+    {
+      ieee_m2 = 0;
+      roundup = false;
+    }
+  else
+    {
+      zeros  &= (m2 & ((UINT64_C(1) << (shift - 1)) - 1)) == 0;
+      lastbit = (m2 >> (shift - 1)) & 1;
+      ieee_m2 = shift < 64 ? m2 >> shift : 0;
+      roundup = lastbit && (!zeros || (ieee_m2 & 1) != 0);
+    }
+
+  ieee_m2 += roundup;
+  ieee_m2 &= (UINT64_C(1) << DOUBLE_MANTISSA_BITS) - 1;
+  if (ieee_m2 == 0 && roundup)
+    {
+      ieee_e2++;
+    }
+
+  bits = ((uint64_t)ieee_e2 << DOUBLE_MANTISSA_BITS) | ieee_m2;
+  memcpy(&x, &bits, sizeof(x));
+  return x;
+}
+
+#endif /* LIBC_HAVE_RYU */
@@ -41,6 +41,8 @@
 #include <errno.h>
 #include <math.h>
 
+#include "libc.h"
+
 /****************************************************************************
  * Pre-processor definitions
  ****************************************************************************/
@@ -730,6 +732,159 @@ static long_double strtox(FAR const char *str, FAR char **endptr, int flag)
   return negative ? -y : y;
 }
 
+#ifdef LIBC_HAVE_RYU
+
+/****************************************************************************
+ * Name: ryu_strtod
+ *
+ * Description:
+ *   Convert a decimal string of up to 17 significant digits to a double
+ *   with the Ryu algorithm.
+ *
+ * Input Parameters:
+ *   str    - The string
+ *   endptr - If have ,the part that holds all but the numbers
+ *   result - The double number about str
+ *
+ * Returned Value:
+ *   False if the string is not such a decimal, strtox() then converts it
+ *
+ ****************************************************************************/
+
+static bool ryu_strtod(FAR const char *str, FAR char **endptr,
+                       FAR double *result)
+{
+  FAR const char *s = str;
+  FAR const char *e;
+  bool negative = false;
+  bool digits = false;
+  uint64_t m10 = 0;
+  int ndigits = 0;
+  long e10 = 0;
+  long exp = 0;
+  int dot = 0;
+
+  while (isspace(*s))
+    {
+      s++;
+    }
+
+  if (*s == '-' || *s == '+')
+    {
+      negative = *s++ == '-';
+    }
+
+  if (*s == '0' && (*(s + 1) | 32) == 'x')
+    {
+      return false;
+    }
+
+  /* Accumulate up to 19 digits, the zeros beyond only scale m10 */
+
+  for (; ; s++)
+    {
+      if (*s == '.' && dot == 0)
+        {
+          dot = 1;
+          continue;
+        }
+      else if (!isdigit(*s))
+        {
+          break;
+        }
+
+      digits = true;
+      if (m10 == 0 && *s == '0')
+        {
+          e10 -= dot;
+        }
+      else if (ndigits < 19)
+        {
+          m10 = 10 * m10 + *s - '0';
+          e10 -= dot;
+          ndigits++;
+        }
+      else if (*s == '0')
+        {
+          e10 += 1 - dot;
+        }
+      else
+        {
+          return false;
+        }
+    }
+
+  if (!digits)
+    {
+      return false;
+    }
+
+  if ((*s | 32) == 'e')
+    {
+      e = s + 1;
+      if (*e == '-' || *e == '+')
+        {
+          e++;
+        }
+
+      if (isdigit(*e))
+        {
+          for (; isdigit(*e); e++)
+            {
+              if (exp < 100000)
+                {
+                  exp = 10 * exp + *e - '0';
+                }
+            }
+
+          e10 += *(s + 1) == '-' ? -exp : exp;
+          s = e;
+        }
+    }
+
+  while (m10 != 0 && m10 % 10 == 0)
+    {
+      m10 /= 10;
+      e10++;
+    }
+
+  if (m10 >= UINT64_C(100000000000000000))
+    {
+      return false;
+    }
+
+  if (m10 == 0)
+    {
+      *result = 0.0;
+    }
+  else
+    {
+      if (e10 > 400)
+        {
+          e10 = 400;
+        }
+      else if (e10 < -400)
+        {
+          e10 = -400;
+        }
+
+      *result = lib_ryu_s2d(m10, (int)e10);
+      if (*result < DBL_MIN || isinf(*result))
+        {
+          set_errno(ERANGE);
+        }
+    }
+
+  if (negative)
+    {
+      *result = -*result;
+    }
+
+  ifexist(endptr, (FAR char *)s);
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -771,6 +926,15 @@ float strtof(FAR const char *str, FAR char **endptr)
 
 double strtod(FAR const char *str, FAR char **endptr)
 {
+#ifdef LIBC_HAVE_RYU
+  double result;
+
+  if (ryu_strtod(str, endptr, &result))
+    {
+      return result;
+    }
+#endif
+
   return strtox(str, endptr, 2);
 }
 
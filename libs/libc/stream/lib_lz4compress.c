@@ -0,0 +1,206 @@
+/****************************************************************************
+ * libs/libc/stream/lib_lz4compress.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <nuttx/streams.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4outstream_putle32
+ ****************************************************************************/
+
+static void lz4outstream_putle32(FAR uint8_t *p, uint32_t v)
+{
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+/****************************************************************************
+ * Name: lz4outstream_block
+ *
+ * Description:
+ *   Write the buffered data as one block of the frame, preceded by the
+ *   frame header at the first block.  The block is stored uncompressed if
+ *   it does not compress.
+ *
+ ****************************************************************************/
+
+static int lz4outstream_block(FAR struct lib_lz4outstream_s *stream)
+{
+  FAR uint8_t *hdr = stream->out;
+  FAR uint8_t *data;
+  size_t outlen;
+  size_t hdrlen = 0;
+
+  if (!stream->started)
+    {
+      lz4outstream_putle32(hdr, LZ4_FRAME_MAGIC);
+      hdr[4] = LZ4_FRAME_FLG;
+      hdr[5] = LZ4_FRAME_BD;
+      hdr[6] = LZ4_FRAME_HC;
+      hdrlen = LZ4_FRAME_HDR_SIZE;
+
+      stream->started = true;
+    }
+
+  data   = hdr + hdrlen + LZ4_FRAME_BLKHDR_SIZE;
+  outlen = lz4_compress(stream->in, stream->offset, data,
+                        stream->offset - 1, stream->state);
+  if (outlen > 0)
+    {
+      lz4outstream_putle32(hdr + hdrlen, outlen);
+    }
+  else
+    {
+      outlen = stream->offset;
+      memcpy(data, stream->in, outlen);
+      lz4outstream_putle32(hdr + hdrlen, outlen | LZ4_FRAME_UNCOMPRESSED);
+    }
+
+  stream->offset = 0;
+  return lib_stream_puts(stream->backend, hdr,
+                         hdrlen + LZ4_FRAME_BLKHDR_SIZE + outlen);
+}
+
+/****************************************************************************
+ * Name: lz4outstream_flush
+ *
+ * Description:
+ *   Write the buffered data and end the frame.  The data written after is
+ *   in a new frame:  The LZ4 decoders decode the concatenated frames.
+ *
+ ****************************************************************************/
+
+static int lz4outstream_flush(FAR struct lib_outstream_s *self)
+{
+  FAR struct lib_lz4outstream_s *stream =
+                                 (FAR struct lib_lz4outstream_s *)self;
+  uint8_t endmark[LZ4_FRAME_BLKHDR_SIZE];
+  int ret;
+
+  if (stream->offset > 0)
+    {
+      ret = lz4outstream_block(stream);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  if (stream->started)
+    {
+      memset(endmark, 0, sizeof(endmark));
+      ret = lib_stream_puts(stream->backend, endmark, sizeof(endmark));
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      stream->started = false;
+    }
+
+  return lib_stream_flush(stream->backend);
+}
+
+/****************************************************************************
+ * Name: lz4outstream_puts
+ ****************************************************************************/
+
+static int lz4outstream_puts(FAR struct lib_outstream_s *self,
+                             FAR const void *buf, int len)
+{
+  FAR struct lib_lz4outstream_s *stream =
+                                 (FAR struct lib_lz4outstream_s *)self;
+  FAR const char *ptr = buf;
+  size_t total = len;
+  size_t copyin;
+  int ret;
+
+  while (total > 0)
+    {
+      copyin = stream->offset + total > LZ4_STREAM_BLOCKSIZE ?
+               LZ4_STREAM_BLOCKSIZE - stream->offset : total;
+
+      memcpy(stream->in + stream->offset, ptr, copyin);
+
+      ptr            += copyin;
+      stream->offset += copyin;
+      self->nput     += copyin;
+      total          -= copyin;
+
+      if (stream->offset == LZ4_STREAM_BLOCKSIZE)
+        {
+          ret = lz4outstream_block(stream);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_lz4outstream
+ *
+ * Description:
+ *  LZ4 compressed pipeline stream, in the LZ4 frame format
+ *
+ * Input Parameters:
+ *   stream  - User allocated, uninitialized instance of struct
+ *                lib_lz4outstream_s to be initialized.
+ *   backend - Stream backend port.
+ *
+ * Returned Value:
+ *   None (User allocated instance initialized).
+ *
+ ****************************************************************************/
+
+void lib_lz4outstream(FAR struct lib_lz4outstream_s *stream,
+                      FAR struct lib_outstream_s *backend)
+{
+  if (stream == NULL || backend == NULL)
+    {
+      return;
+    }
+
+  memset(stream, 0, sizeof(*stream));
+  stream->common.puts  = lz4outstream_puts;
+  stream->common.flush = lz4outstream_flush;
+  stream->backend      = backend;
+}
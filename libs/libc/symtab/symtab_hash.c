@@ -0,0 +1,220 @@
+/****************************************************************************
+ * libs/libc/symtab/symtab_hash.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/symtab.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: symtab_hash
+ *
+ * Description:
+ *   Return the hash of a symbol name, that of the GNU hash sections of ELF
+ *   (h = h * 33 + c from 5381).
+ *
+ ****************************************************************************/
+
+uint32_t symtab_hash(FAR const char *name)
+{
+  uint32_t h = 5381;
+
+  while (*name != '\0')
+    {
+      h = (h << 5) + h + (uint8_t)*name++;
+    }
+
+  return h;
+}
+
+/****************************************************************************
+ * Name: symtab_hashinit
+ *
+ * Description:
+ *   Build the hash index of a symbol table.  The symbol table is not
+ *   modified:  The index holds the hashes of the names grouped by bucket,
+ *   as the GNU hash sections, each with the position of its symbol in the
+ *   table, that is 8 bytes per symbol and 4 bytes per bucket.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if the index cannot be allocated.
+ *
+ ****************************************************************************/
+
+int symtab_hashinit(FAR struct symtab_hash_s *hash,
+                    FAR const struct symtab_s *symtab, int nsyms)
+{
+  FAR uint32_t *buckets;
+  FAR uint32_t *chain;
+  FAR uint32_t *index;
+  uint32_t nbuckets;
+  uint32_t h;
+  int i;
+
+  DEBUGASSERT(hash != NULL && (symtab != NULL || nsyms == 0));
+
+  memset(hash, 0, sizeof(*hash));
+  if (nsyms <= 0)
+    {
+      hash->symtab = symtab;
+      return OK;
+    }
+
+  /* About two symbols per bucket, a power of two */
+
+  for (nbuckets = 1; nbuckets < (uint32_t)nsyms / 2; nbuckets <<= 1);
+
+  buckets = lib_malloc(sizeof(uint32_t) * (nbuckets + 1 + 2 * nsyms));
+  if (buckets == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  chain = buckets + nbuckets + 1;
+  index = chain + nsyms;
+
+  /* Count the symbols of each bucket, then make the counts the position of
+   * the end of each bucket in the chain.
+   */
+
+  memset(buckets, 0, sizeof(uint32_t) * (nbuckets + 1));
+  for (i = 0; i < nsyms; i++)
+    {
+      buckets[symtab_hash(symtab[i].sym_name) & (nbuckets - 1)]++;
+    }
+
+  for (h = 1; h < nbuckets; h++)
+    {
+      buckets[h] += buckets[h - 1];
+    }
+
+  buckets[nbuckets] = nsyms;
+
+  /* Fill the buckets from their ends, from the end of the table:  The
+   * symbols of a bucket stay in the order of the table, so that the first
+   * symbol of a name is found as by symtab_findbyname().  buckets[b] is
+   * then the start of bucket b and buckets[b + 1] its end.
+   */
+
+  for (i = nsyms - 1; i >= 0; i--)
+    {
+      uint32_t pos;
+
+      h   = symtab_hash(symtab[i].sym_name);
+      pos = --buckets[h & (nbuckets - 1)];
+
+      chain[pos] = h;
+      index[pos] = i;
+    }
+
+  hash->symtab   = symtab;
+  hash->nsyms    = nsyms;
+  hash->nbuckets = nbuckets;
+  hash->buckets  = buckets;
+  hash->chain    = chain;
+  hash->index    = index;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: symtab_hashfree
+ *
+ * Description:
+ *   Free the hash index built by symtab_hashinit().
+ *
+ ****************************************************************************/
+
+void symtab_hashfree(FAR struct symtab_hash_s *hash)
+{
+  DEBUGASSERT(hash != NULL);
+
+  lib_free(hash->buckets);
+  memset(hash, 0, sizeof(*hash));
+}
+
+/****************************************************************************
+ * Name: symtab_findbyhash
+ *
+ * Description:
+ *   Find the symbol with the matching name in a symbol table through its
+ *   hash index.  Only the symbols with the same hash are compared.
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if an entry with the matching
+ *   name is found; NULL is returned if the entry is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *
+symtab_findbyhash(FAR const struct symtab_hash_s *hash,
+                  FAR const char *name)
+{
+  FAR const struct symtab_s *symbol;
+  uint32_t pos;
+  uint32_t end;
+  uint32_t h;
+
+  DEBUGASSERT(hash != NULL && name != NULL);
+
+  if (hash->nsyms == 0)
+    {
+      return NULL;
+    }
+
+#ifdef CONFIG_SYMTAB_DECORATED
+  if (name[0] == '_')
+    {
+      name++;
+    }
+#endif
+
+  h   = symtab_hash(name);
+  pos = hash->buckets[h & (hash->nbuckets - 1)];
+  end = hash->buckets[(h & (hash->nbuckets - 1)) + 1];
+
+  for (; pos < end; pos++)
+    {
+      if (hash->chain[pos] == h)
+        {
+          symbol = &hash->symtab[hash->index[pos]];
+          if (strcmp(name, symbol->sym_name) == 0)
+            {
+              return symbol;
+            }
+        }
+    }
+
+  return NULL;
+}
@@ -0,0 +1,101 @@
+/****************************************************************************
+ * libs/libc/time/lib_clock_gettime.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <time.h>
+#include <errno.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/tls.h>
+#include <nuttx/vdso.h>
+
+/* In the kernel, clock_gettime() is provided by the OS.  User space reads
+ * the time data shared by the kernel for the clocks that are derived from
+ * the system timer and calls nxclock_gettime() for the others.
+ */
+
+#if defined(CONFIG_SCHED_VDSO) && !defined(__KERNEL__)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clock_gettime
+ *
+ * Description:
+ *   Get the current value of the specified time clock.
+ *
+ * Input Parameters:
+ *   clock_id - The clock to read
+ *   tp       - Location to return the time
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -1 (ERROR) with errno set to EINVAL if the clock
+ *   is not supported or tp is NULL.
+ *
+ ****************************************************************************/
+
+int clock_gettime(clockid_t clock_id, FAR struct timespec *tp)
+{
+  FAR struct vdso_data_s *vdso = tls_get_info()->tl_task->ta_vdso;
+  struct timespec base;
+  clock_t ticks;
+  uint32_t seq;
+
+  if (tp == NULL || clock_id < 0 || clock_id > CLOCK_BOOTTIME)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  if (vdso == NULL || (clock_id != CLOCK_MONOTONIC &&
+                       clock_id != CLOCK_BOOTTIME &&
+                       clock_id != CLOCK_REALTIME))
+    {
+      nxclock_gettime(clock_id, tp);
+      return OK;
+    }
+
+  do
+    {
+      seq   = read_seqbegin(&vdso->vd_lock);
+      ticks = vdso->vd_ticks;
+      base  = vdso->vd_basetime;
+    }
+  while (read_seqretry(&vdso->vd_lock, seq));
+
+  clock_ticks2time(tp, ticks);
+  if (clock_id == CLOCK_REALTIME)
+    {
+      clock_timespec_add(&base, tp, tp);
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_SCHED_VDSO && !__KERNEL__ */
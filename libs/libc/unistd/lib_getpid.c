@@ -1,5 +1,5 @@
 /****************************************************************************
- * libs/libc/uio/lib_preadv.c
+ * libs/libc/unistd/lib_getpid.c
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -24,76 +24,39 @@
  * Included Files
  ****************************************************************************/
 
-#include <sys/types.h>
-#include <sys/uio.h>
+#include <nuttx/config.h>
+
 #include <unistd.h>
 
+#include <nuttx/tls.h>
+
+/* In the kernel, getpid() is provided by the OS.  User space reads the ID
+ * that the kernel keeps in the TLS instead of calling into the kernel.
+ */
+
+#if defined(CONFIG_SCHED_VDSO) && !defined(__KERNEL__)
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: preadv()
+ * Name: getpid
  *
  * Description:
- *   The preadv() function is equivalent to pread(), except it takes
- *   an iov array.
+ *   Get the Process ID of the currently executing task.
+ *
+ * Input parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The Process ID of the task group of the calling thread.
  *
  ****************************************************************************/
 
-ssize_t preadv(int fildes, FAR const struct iovec *iov, int iovcnt,
-               off_t offset)
+pid_t getpid(void)
 {
-  ssize_t ntotal;
-  ssize_t nread;
-  size_t remaining;
-  FAR uint8_t *buffer;
-  int i;
-
-  /* Process each entry in the struct iovec array */
-
-  for (i = 0, ntotal = 0; i < iovcnt; i++)
-    {
-      /* Ignore zero-length reads */
-
-      if (iov[i].iov_len > 0)
-        {
-          buffer    = iov[i].iov_base;
-          remaining = iov[i].iov_len;
-
-          /* Read repeatedly as necessary to fill buffer */
-
-          do
-            {
-              /* NOTE: pread() is a cancellation point */
-
-              nread = pread(fildes, buffer, remaining, offset + ntotal);
-
-              /* Check for a read error */
-
-              if (nread < 0)
-                {
-                  return nread;
-                }
-
-              /* Check for an end-of-file condition */
-
-              else if (nread == 0)
-                {
-                  return ntotal;
-                }
-
-              /* Update pointers and counts in order to handle partial
-               * buffer reads.
-               */
-
-              buffer    += nread;
-              remaining -= nread;
-              ntotal    += nread;
-            }
-          while (remaining > 0);
-        }
-    }
-
-  return ntotal;
+  return tls_get_info()->tl_pid;
 }
+
+#endif /* CONFIG_SCHED_VDSO && !__KERNEL__ */
@@ -0,0 +1,62 @@
+/****************************************************************************
+ * libs/libc/unistd/lib_gettid.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <unistd.h>
+
+#include <nuttx/tls.h>
+
+/* In the kernel, gettid() is provided by the OS.  User space reads the ID
+ * that the kernel keeps in the TLS instead of calling into the kernel.
+ */
+
+#if defined(CONFIG_SCHED_VDSO) && !defined(__KERNEL__)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: gettid
+ *
+ * Description:
+ *   Get the thread ID of the currently executing thread.
+ *
+ * Input parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The thread ID of the calling thread.
+ *
+ ****************************************************************************/
+
+pid_t gettid(void)
+{
+  return tls_get_info()->tl_tid;
+}
+
+#endif /* CONFIG_SCHED_VDSO && !__KERNEL__ */
@@ -0,0 +1,198 @@
+/****************************************************************************
+ * libs/libdsp/lib_foc_batch.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: foc_pi_batch
+ *
+ * Description:
+ *   PI controllers of 'n' instances with the anti-windup protection and the
+ *   output saturated to +/- 'max', see pi_controller().  The arrays of the
+ *   FOC data do not overlap, which lets the compiler vectorize the loop.
+ *
+ ****************************************************************************/
+
+static void foc_pi_batch(FAR const float *ref, FAR const float *fb,
+                         FAR const float *kp, FAR const float *ki,
+                         FAR float *restrict part, FAR float *restrict aw,
+                         FAR const float *max, FAR const float *comp,
+                         FAR float *restrict out, float kc, size_t n)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      float err = ref[i] - fb[i];
+      float sat = max[i];
+      float tmp;
+      float y;
+
+      part[i] += ki[i] * (err - aw[i]);
+      tmp = kp[i] * err + part[i];
+
+      y = tmp > sat ? sat : tmp;
+      y = y < -sat ? -sat : y;
+
+      aw[i]  = kc * (tmp - y);
+      out[i] = y - comp[i];
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: foc_iabc_update_batch
+ *
+ * Description:
+ *   Update the FOC data of all the instances with the new phase currents,
+ *   see foc_iabc_update().  The angles must be updated before.
+ *
+ * Input Parameters:
+ *   foc   - (in/out) pointer to the FOC data
+ *   i_abc - (in) pointer to the phase currents
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void foc_iabc_update_batch(FAR struct foc_batch_f32_s *foc,
+                           FAR struct abc_frames_f32_s *i_abc)
+{
+  FAR const float *a;
+  FAR const float *b;
+  FAR const float *s;
+  FAR const float *c;
+  FAR float *d;
+  FAR float *q;
+  size_t i;
+
+  LIBDSP_DEBUGASSERT(foc != NULL);
+  LIBDSP_DEBUGASSERT(i_abc != NULL);
+
+  a = i_abc->a;
+  b = i_abc->b;
+  s = foc->angle.sin;
+  c = foc->angle.cos;
+  d = foc->i_dq.d;
+  q = foc->i_dq.q;
+
+  /* Clarke and Park transforms in one pass (current abc -> current dq) */
+
+  for (i = 0; i < foc->n; i++)
+    {
+      float alpha = a[i];
+      float beta  = ONE_BY_SQRT3_F*alpha + TWO_BY_SQRT3_F*b[i];
+
+      d[i] = c[i] * alpha + s[i] * beta;
+      q[i] = c[i] * beta - s[i] * alpha;
+    }
+}
+
+/****************************************************************************
+ * Name: foc_current_control_batch
+ *
+ * Description:
+ *   Process the FOC current control of all the instances, see
+ *   foc_current_control():  The voltage requests, minus the compensation,
+ *   are stored in foc->v_dq for foc_voltage_control_batch().
+ *
+ * Input Parameters:
+ *   foc      - (in/out) pointer to the FOC data
+ *   vdq_comp - (in) voltage dq compensation frames
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void foc_current_control_batch(FAR struct foc_batch_f32_s *foc,
+                               FAR struct dq_frames_f32_s *vdq_comp)
+{
+  LIBDSP_DEBUGASSERT(foc != NULL);
+  LIBDSP_DEBUGASSERT(vdq_comp != NULL);
+
+  foc_pi_batch(foc->i_dq_ref.d, foc->i_dq.d, foc->kp.d, foc->ki.d,
+               foc->part.d, foc->aw.d, foc->vbase, vdq_comp->d,
+               foc->v_dq.d, foc->kc, foc->n);
+  foc_pi_batch(foc->i_dq_ref.q, foc->i_dq.q, foc->kp.q, foc->ki.q,
+               foc->part.q, foc->aw.q, foc->vbase, vdq_comp->q,
+               foc->v_dq.q, foc->kc, foc->n);
+}
+
+/****************************************************************************
+ * Name: foc_voltage_control_batch
+ *
+ * Description:
+ *   Process the FOC voltage control of all the instances, see
+ *   foc_voltage_control():  The voltage requests are taken from foc->v_dq
+ *   and the modulation voltages stored in foc->v_ab_mod.
+ *
+ * Input Parameters:
+ *   foc - (in/out) pointer to the FOC data
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void foc_voltage_control_batch(FAR struct foc_batch_f32_s *foc)
+{
+  FAR const float *vbase;
+  FAR float *alpha;
+  FAR float *beta;
+  size_t i;
+
+  LIBDSP_DEBUGASSERT(foc != NULL);
+
+  /* Inverse Park transform (voltage dq -> voltage alpha-beta) */
+
+  inv_park_transform_batch(&foc->angle, &foc->v_dq, &foc->v_ab_mod,
+                           foc->n);
+
+  /* Normalize the alpha-beta voltage to get the alpha-beta modulation
+   * voltage
+   */
+
+  vbase = foc->vbase;
+  alpha = foc->v_ab_mod.a;
+  beta  = foc->v_ab_mod.b;
+
+  for (i = 0; i < foc->n; i++)
+    {
+      float scale = 1.0f / vbase[i];
+
+      alpha[i] *= scale;
+      beta[i]  *= scale;
+    }
+}
@@ -0,0 +1,116 @@
+/****************************************************************************
+ * libs/libdsp/lib_svm_batch.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Sectors indexed by the signs of the auxiliary i, j and k components:
+ * bit 0 set if i > 0, bit 1 if j > 0 and bit 2 if k > 0.  The entries of
+ * the impossible combinations are those given by svm3().
+ */
+
+static const uint8_t g_svm3_sector[8] =
+{
+  2, 6, 2, 1, 4, 5, 3, 5
+};
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: svm3_batch
+ *
+ * Description:
+ *   One step of the space vector modulation of 'n' instances, see svm3().
+ *
+ *   The duty cycles are computed without the switch on the sector:  The
+ *   alternate-reverse null vector centers the phase voltages between the
+ *   largest and the smallest of them, so that
+ *
+ *     d_x = 0.5 + (v_x - (v_max + v_min) / 2) / sqrt(3)
+ *
+ *   where v_x are the phase voltages given by the inverse Clarke transform,
+ *   which gives the duty cycles of svm3() with the loop free of branches.
+ *
+ * Input Parameters:
+ *   s    - (out) pointer to the SVM states
+ *   v_ab - (in) pointer to the modulation voltage vectors in alpha-beta
+ *          frame, normalized to magnitude (0.0 - 1.0)
+ *   n    - (in) number of instances
+ *
+ ****************************************************************************/
+
+void svm3_batch(FAR struct svm3_states_f32_s *s,
+                FAR struct ab_frames_f32_s *v_ab, size_t n)
+{
+  FAR const float *alpha;
+  FAR const float *beta;
+  size_t i;
+
+  LIBDSP_DEBUGASSERT(s != NULL);
+  LIBDSP_DEBUGASSERT(v_ab != NULL);
+
+  alpha = v_ab->a;
+  beta  = v_ab->b;
+
+  /* Duty cycles */
+
+  for (i = 0; i < n; i++)
+    {
+      float va = alpha[i];
+      float vb = -0.5f*va + SQRT3_BY_TWO_F*beta[i];
+      float vc = -va - vb;
+      float max;
+      float min;
+      float off;
+
+      max = va > vb ? va : vb;
+      max = max > vc ? max : vc;
+      min = va < vb ? va : vb;
+      min = min < vc ? min : vc;
+      off = 0.5f - 0.5f * ONE_BY_SQRT3_F * (max + min);
+
+      s->d_u[i] = ONE_BY_SQRT3_F * va + off;
+      s->d_v[i] = ONE_BY_SQRT3_F * vb + off;
+      s->d_w[i] = ONE_BY_SQRT3_F * vc + off;
+    }
+
+  /* Sectors, in a separate loop as the table lookup does not vectorize */
+
+  for (i = 0; i < n; i++)
+    {
+      float ii = -0.5f*beta[i] + SQRT3_BY_TWO_F*alpha[i];
+      float jj = beta[i];
+      float kk = -jj - ii;
+
+      s->sector[i] = g_svm3_sector[(ii > 0.0f) | (jj > 0.0f) << 1 |
+                                   (kk > 0.0f) << 2];
+    }
+}
@@ -0,0 +1,224 @@
+/****************************************************************************
+ * libs/libdsp/lib_transform_batch.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clarke_transform_batch
+ *
+ * Description:
+ *   Clarke transform (abc frame -> ab frame) of 'n' instances, see
+ *   clarke_transform().
+ *
+ * Input Parameters:
+ *   abc - (in) pointer to the abc frames
+ *   ab  - (out) pointer to the alpha-beta frames
+ *   n   - (in) number of instances
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void clarke_transform_batch(FAR struct abc_frames_f32_s *abc,
+                            FAR struct ab_frames_f32_s *ab, size_t n)
+{
+  FAR const float *a;
+  FAR const float *b;
+  FAR float *alpha;
+  FAR float *beta;
+  size_t i;
+
+  LIBDSP_DEBUGASSERT(abc != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+
+  a     = abc->a;
+  b     = abc->b;
+  alpha = ab->a;
+  beta  = ab->b;
+
+  for (i = 0; i < n; i++)
+    {
+      float x = a[i];
+
+      alpha[i] = x;
+      beta[i]  = ONE_BY_SQRT3_F*x + TWO_BY_SQRT3_F*b[i];
+    }
+}
+
+/****************************************************************************
+ * Name: inv_clarke_transform_batch
+ *
+ * Description:
+ *   Inverse Clarke transform (ab frame -> abc frame) of 'n' instances, see
+ *   inv_clarke_transform().
+ *
+ * Input Parameters:
+ *   ab  - (in) pointer to the alpha-beta frames
+ *   abc - (out) pointer to the abc frames
+ *   n   - (in) number of instances
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_clarke_transform_batch(FAR struct ab_frames_f32_s *ab,
+                                FAR struct abc_frames_f32_s *abc,
+                                size_t n)
+{
+  FAR const float *alpha;
+  FAR const float *beta;
+  FAR float *a;
+  FAR float *b;
+  FAR float *c;
+  size_t i;
+
+  LIBDSP_DEBUGASSERT(ab != NULL);
+  LIBDSP_DEBUGASSERT(abc != NULL);
+
+  alpha = ab->a;
+  beta  = ab->b;
+  a     = abc->a;
+  b     = abc->b;
+  c     = abc->c;
+
+  for (i = 0; i < n; i++)
+    {
+      float x = alpha[i];
+      float y = -0.5f*x + SQRT3_BY_TWO_F*beta[i];
+
+      a[i] = x;
+      b[i] = y;
+      c[i] = -x - y;
+    }
+}
+
+/****************************************************************************
+ * Name: park_transform_batch
+ *
+ * Description:
+ *   Park transform (ab frame -> dq frame) of 'n' instances, see
+ *   park_transform().
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angles
+ *   ab    - (in) pointer to the alpha-beta frames
+ *   dq    - (out) pointer to the direct-quadrature frames
+ *   n     - (in) number of instances
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void park_transform_batch(FAR struct phase_angles_f32_s *angle,
+                          FAR struct ab_frames_f32_s *ab,
+                          FAR struct dq_frames_f32_s *dq, size_t n)
+{
+  FAR const float *s;
+  FAR const float *c;
+  FAR const float *alpha;
+  FAR const float *beta;
+  FAR float *d;
+  FAR float *q;
+  size_t i;
+
+  LIBDSP_DEBUGASSERT(angle != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+  LIBDSP_DEBUGASSERT(dq != NULL);
+
+  s     = angle->sin;
+  c     = angle->cos;
+  alpha = ab->a;
+  beta  = ab->b;
+  d     = dq->d;
+  q     = dq->q;
+
+  for (i = 0; i < n; i++)
+    {
+      float x = alpha[i];
+      float y = beta[i];
+
+      d[i] = c[i] * x + s[i] * y;
+      q[i] = c[i] * y - s[i] * x;
+    }
+}
+
+/****************************************************************************
+ * Name: inv_park_transform_batch
+ *
+ * Description:
+ *   Inverse Park transform (dq frame -> ab frame) of 'n' instances, see
+ *   inv_park_transform().
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angles
+ *   dq    - (in) pointer to the direct-quadrature frames
+ *   ab    - (out) pointer to the alpha-beta frames
+ *   n     - (in) number of instances
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_park_transform_batch(FAR struct phase_angles_f32_s *angle,
+                              FAR struct dq_frames_f32_s *dq,
+                              FAR struct ab_frames_f32_s *ab, size_t n)
+{
+  FAR const float *s;
+  FAR const float *c;
+  FAR const float *d;
+  FAR const float *q;
+  FAR float *alpha;
+  FAR float *beta;
+  size_t i;
+
+  LIBDSP_DEBUGASSERT(angle != NULL);
+  LIBDSP_DEBUGASSERT(dq != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+
+  s     = angle->sin;
+  c     = angle->cos;
+  d     = dq->d;
+  q     = dq->q;
+  alpha = ab->a;
+  beta  = ab->b;
+
+  for (i = 0; i < n; i++)
+    {
+      float x = d[i];
+      float y = q[i];
+
+      alpha[i] = c[i] * x - s[i] * y;
+      beta[i]  = c[i] * y + s[i] * x;
+    }
+}
@@ -0,0 +1,138 @@
+/****************************************************************************
+ * libs/libm/vector/lib_vcosf.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* The polynomial and the reduction are those of the single precision
+ * vector routines of the Arm Optimized Routines.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <math.h>
+#include <vmath.h>
+
+#include "lib_vmath.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define VCOSF_C0          -0x1.555548p-3f
+#define VCOSF_C1          0x1.110df4p-7f
+#define VCOSF_C2          -0x1.9f42eap-13f
+#define VCOSF_C3          0x1.5b2e76p-19f
+
+/* pi = PI1 + PI2 + PI3, n * PI1 is exact for |x| < RANGE:  The products
+ * are fused with the subtractions with FMA, otherwise PI1 and PI2 have 12
+ * bits and the range is smaller.
+ */
+
+#ifdef __FP_FAST_FMAF
+#  define VCOSF_PI1       0x1.921fb6p+1f
+#  define VCOSF_PI2       -0x1.777a5cp-24f
+#  define VCOSF_PI3       -0x1.ee59dap-49f
+#  define VCOSF_RANGE     0x49800000 /* 2^20 */
+#else
+#  define VCOSF_PI1       0x1.922p+1f
+#  define VCOSF_PI2       -0x1.2aep-17f
+#  define VCOSF_PI3       -0x1.de973ep-30f
+#  define VCOSF_RANGE     0x45800000 /* 2^12 */
+#endif
+
+#define VCOSF_INVPI       0x1.45f306p-2f
+
+/* 1.5 * 2^23, adding it rounds to the nearest integer */
+
+#define VCOSF_SHIFT       0x1.8p+23f
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef VMATH_HAVE_VECTOR
+
+/****************************************************************************
+ * Name: vcosf_kernel
+ *
+ * Description:
+ *   cos(x) = (-1)^n * sin(r), with |x| = (n + 1/2) * pi + r and
+ *   |r| <= pi / 2, then sin(r) is approximated by an odd polynomial of
+ *   degree 9.
+ *
+ ****************************************************************************/
+
+static vmath_f32_t vcosf_kernel(vmath_f32_t x, FAR vmath_u32_t *special)
+{
+  vmath_u32_t odd;
+  vmath_f32_t z;
+  vmath_f32_t n;
+  vmath_f32_t r;
+  vmath_f32_t r2;
+  vmath_f32_t y;
+
+  r = (vmath_f32_t)((vmath_u32_t)x & 0x7fffffff);
+  *special = (vmath_u32_t)((vmath_u32_t)r >= VCOSF_RANGE);
+
+  /* n + 1/2 = rint((|x| + pi / 2) / pi) - 1/2 */
+
+  z   = (r * VCOSF_INVPI + 0.5f) + VCOSF_SHIFT;
+  odd = (vmath_u32_t)z << 31;
+  n   = (z - VCOSF_SHIFT) - 0.5f;
+
+  r = r - n * VCOSF_PI1;
+  r = r - n * VCOSF_PI2;
+  r = r - n * VCOSF_PI3;
+
+  r2 = r * r;
+  y  = VCOSF_C2 + VCOSF_C3 * r2;
+  y  = VCOSF_C1 + y * r2;
+  y  = VCOSF_C0 + y * r2;
+  y  = r + y * r2 * r;
+
+  return (vmath_f32_t)((vmath_u32_t)y ^ odd);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vcosf
+ *
+ * Description:
+ *   Compute the cosine of the 'n' floats of 'x' to 'y', within 1.9 ULP
+ *   with FMA and 2.5 ULP without.
+ *
+ ****************************************************************************/
+
+void vcosf(FAR const float *x, FAR float *y, size_t n)
+{
+#ifdef VMATH_HAVE_VECTOR
+  vmath_apply(x, y, n, vcosf_kernel, cosf, 0.0f);
+#else
+  vmath_apply(x, y, n, cosf);
+#endif
+}
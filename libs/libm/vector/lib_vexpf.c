@@ -0,0 +1,130 @@
+/****************************************************************************
+ * libs/libm/vector/lib_vexpf.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* The polynomial and the reduction are those of the single precision
+ * vector routines of the Arm Optimized Routines.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <math.h>
+#include <vmath.h>
+
+#include "lib_vmath.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define VEXPF_C0          0x1.0e4020p-7f
+#define VEXPF_C1          0x1.573e2ep-5f
+#define VEXPF_C2          0x1.555e66p-3f
+#define VEXPF_C3          0x1.fffdb6p-2f
+#define VEXPF_C4          0x1.ffffecp-1f
+
+/* ln(2) = LN2HI + LN2LO */
+
+#define VEXPF_LN2HI       0x1.62e4p-1f
+#define VEXPF_LN2LO       0x1.7f7d1cp-20f
+#define VEXPF_INVLN2      0x1.715476p+0f
+
+/* 1.5 * 2^23, adding it rounds to the nearest integer */
+
+#define VEXPF_SHIFT       0x1.8p+23f
+
+/* 87, 2^n is normal below */
+
+#define VEXPF_RANGE       0x42ae0000
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef VMATH_HAVE_VECTOR
+
+/****************************************************************************
+ * Name: vexpf_kernel
+ *
+ * Description:
+ *   exp(x) = 2^n * (1 + p(r)), with x = n * ln(2) + r and
+ *   |r| <= ln(2) / 2, then p(r) is approximated by a polynomial of
+ *   degree 5.
+ *
+ ****************************************************************************/
+
+static vmath_f32_t vexpf_kernel(vmath_f32_t x, FAR vmath_u32_t *special)
+{
+  vmath_u32_t scale;
+  vmath_f32_t z;
+  vmath_f32_t n;
+  vmath_f32_t r;
+  vmath_f32_t r2;
+  vmath_f32_t p;
+  vmath_f32_t q;
+
+  *special = (vmath_u32_t)(((vmath_u32_t)x & 0x7fffffff) >= VEXPF_RANGE);
+
+  z = x * VEXPF_INVLN2 + VEXPF_SHIFT;
+  n = z - VEXPF_SHIFT;
+  r = x - n * VEXPF_LN2HI;
+  r = r - n * VEXPF_LN2LO;
+
+  /* The low bits of z are those of n, the exponent of 2^n */
+
+  scale = ((vmath_u32_t)z << 23) + 0x3f800000;
+
+  r2 = r * r;
+  p  = VEXPF_C1 + VEXPF_C0 * r;
+  q  = VEXPF_C3 + VEXPF_C2 * r;
+  q  = q + p * r2;
+  p  = VEXPF_C4 * r;
+  p  = p + q * r2;
+
+  return (vmath_f32_t)scale + p * (vmath_f32_t)scale;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vexpf
+ *
+ * Description:
+ *   Compute the exponential of the 'n' floats of 'x' to 'y', within
+ *   2.0 ULP.
+ *
+ ****************************************************************************/
+
+void vexpf(FAR const float *x, FAR float *y, size_t n)
+{
+#ifdef VMATH_HAVE_VECTOR
+  vmath_apply(x, y, n, vexpf_kernel, expf, 0.0f);
+#else
+  vmath_apply(x, y, n, expf);
+#endif
+}
@@ -0,0 +1,129 @@
+/****************************************************************************
+ * libs/libm/vector/lib_vlogf.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* The polynomial and the reduction are those of the single precision
+ * vector routines of the Arm Optimized Routines.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <math.h>
+#include <vmath.h>
+
+#include "lib_vmath.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define VLOGF_P1          -0x1.ffffc8p-2f
+#define VLOGF_P2          0x1.555d7cp-2f
+#define VLOGF_P3          -0x1.00187cp-2f
+#define VLOGF_P4          0x1.961348p-3f
+#define VLOGF_P5          -0x1.4f9934p-3f
+#define VLOGF_P6          0x1.5a9aa2p-3f
+#define VLOGF_P7          -0x1.3e737cp-3f
+#define VLOGF_LN2         0x1.62e43p-1f
+
+/* 2/3, the reduced argument 1 + r is in [2/3, 4/3] */
+
+#define VLOGF_OFF         0x3f2aaaab
+
+/* The smallest normal number and infinity */
+
+#define VLOGF_MIN         0x00800000
+#define VLOGF_MAX         0x7f800000
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef VMATH_HAVE_VECTOR
+
+/****************************************************************************
+ * Name: vlogf_kernel
+ *
+ * Description:
+ *   log(x) = n * ln(2) + log(1 + r), with x = 2^n * (1 + r) and
+ *   2/3 <= 1 + r < 4/3, then log(1 + r) is approximated by a polynomial of
+ *   degree 8.
+ *
+ ****************************************************************************/
+
+static vmath_f32_t vlogf_kernel(vmath_f32_t x, FAR vmath_u32_t *special)
+{
+  vmath_u32_t u;
+  vmath_f32_t n;
+  vmath_f32_t r;
+  vmath_f32_t r2;
+  vmath_f32_t p;
+  vmath_f32_t q;
+  vmath_f32_t y;
+
+  /* Zero, the negative and subnormal numbers, infinity and NaN */
+
+  u = (vmath_u32_t)x;
+  *special = (vmath_u32_t)(u - VLOGF_MIN >= VLOGF_MAX - VLOGF_MIN);
+
+  u = u - VLOGF_OFF;
+  n = __builtin_convertvector((vmath_s32_t)u >> 23, vmath_f32_t);
+  u = (u & 0x007fffff) + VLOGF_OFF;
+  r = (vmath_f32_t)u - 1.0f;
+
+  r2 = r * r;
+  p  = VLOGF_P5 + VLOGF_P6 * r;
+  q  = VLOGF_P3 + VLOGF_P4 * r;
+  y  = VLOGF_P1 + VLOGF_P2 * r;
+  p  = p + VLOGF_P7 * r2;
+  q  = q + p * r2;
+  y  = y + q * r2;
+  p  = r + n * VLOGF_LN2;
+
+  return p + y * r2;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vlogf
+ *
+ * Description:
+ *   Compute the natural logarithm of the 'n' floats of 'x' to 'y', within
+ *   3.5 ULP.
+ *
+ ****************************************************************************/
+
+void vlogf(FAR const float *x, FAR float *y, size_t n)
+{
+#ifdef VMATH_HAVE_VECTOR
+  vmath_apply(x, y, n, vlogf_kernel, logf, 1.0f);
+#else
+  vmath_apply(x, y, n, logf);
+#endif
+}
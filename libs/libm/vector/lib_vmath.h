@@ -0,0 +1,164 @@
+/****************************************************************************
+ * libs/libm/vector/lib_vmath.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBM_VECTOR_LIB_VMATH_H
+#define __LIBS_LIBM_VECTOR_LIB_VMATH_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/compiler.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The kernels compute 4 floats at a time with the generic vectors of the
+ * compiler, which are the NEON registers on Arm and AArch64, the Helium
+ * registers on Armv8.1-M with MVE and the RVV registers on RISC-V with
+ * the V extension.  Without a SIMD unit, the compiler computes the lanes
+ * one after the other.
+ */
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define VMATH_HAVE_VECTOR 1
+#  define VMATH_LANES       4
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef VMATH_HAVE_VECTOR
+typedef float    vmath_f32_t __attribute__((vector_size(16)));
+typedef uint32_t vmath_u32_t __attribute__((vector_size(16)));
+typedef int32_t  vmath_s32_t __attribute__((vector_size(16)));
+
+/* The kernel of a function computes the 4 lanes of 'x' and sets the lanes
+ * of '*special' that it does not compute, these lanes are computed by the
+ * scalar function.
+ */
+
+typedef CODE vmath_f32_t (*vmath_kernel_t)(vmath_f32_t x,
+                                           FAR vmath_u32_t *special);
+#endif
+
+typedef CODE float (*vmath_scalar_t)(float x);
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+#ifdef VMATH_HAVE_VECTOR
+static inline vmath_f32_t vmath_splat(float x)
+{
+  vmath_f32_t v =
+  {
+    x, x, x, x
+  };
+
+  return v;
+}
+
+static inline vmath_u32_t vmath_splat_u32(uint32_t x)
+{
+  vmath_u32_t v =
+  {
+    x, x, x, x
+  };
+
+  return v;
+}
+
+/****************************************************************************
+ * Name: vmath_apply
+ *
+ * Description:
+ *   Apply to the 'n' floats of 'x' the kernel of a function, or its scalar
+ *   version for the lanes that the kernel does not compute, and store the
+ *   results to 'y'.  'x' and 'y' may be the same array, the floats of the
+ *   last incomplete vector are completed with 'pad'.
+ *
+ ****************************************************************************/
+
+static always_inline_function inline void
+vmath_apply(FAR const float *x, FAR float *y, size_t n,
+            vmath_kernel_t kernel, vmath_scalar_t scalar, float pad)
+{
+  vmath_u32_t special;
+  vmath_f32_t vx;
+  vmath_f32_t vy;
+  uint32_t any;
+  size_t count;
+  size_t i;
+  int j;
+
+  for (i = 0; i < n; i += VMATH_LANES)
+    {
+      count = n - i < VMATH_LANES ? n - i : VMATH_LANES;
+      if (count == VMATH_LANES)
+        {
+          memcpy(&vx, &x[i], sizeof(vx));
+        }
+      else
+        {
+          vx = vmath_splat(pad);
+          memcpy(&vx, &x[i], count * sizeof(float));
+        }
+
+      special = vmath_splat_u32(0);
+      vy = kernel(vx, &special);
+
+      any = special[0] | special[1] | special[2] | special[3];
+      if (predict_false(any != 0))
+        {
+          for (j = 0; j < VMATH_LANES; j++)
+            {
+              if (special[j] != 0)
+                {
+                  vy[j] = scalar(vx[j]);
+                }
+            }
+        }
+
+      memcpy(&y[i], &vy, count * sizeof(float));
+    }
+}
+#else
+static inline void vmath_apply(FAR const float *x, FAR float *y, size_t n,
+                               vmath_scalar_t scalar)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      y[i] = scalar(x[i]);
+    }
+}
+#endif
+
+#endif /* __LIBS_LIBM_VECTOR_LIB_VMATH_H */
@@ -0,0 +1,136 @@
+/****************************************************************************
+ * libs/libm/vector/lib_vsinf.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* The polynomial and the reduction are those of the single precision
+ * vector routines of the Arm Optimized Routines.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <math.h>
+#include <vmath.h>
+
+#include "lib_vmath.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define VSINF_C0          -0x1.555548p-3f
+#define VSINF_C1          0x1.110df4p-7f
+#define VSINF_C2          -0x1.9f42eap-13f
+#define VSINF_C3          0x1.5b2e76p-19f
+
+/* pi = PI1 + PI2 + PI3, n * PI1 is exact for |x| < RANGE:  The products
+ * are fused with the subtractions with FMA, otherwise PI1 and PI2 have 12
+ * bits and the range is smaller.
+ */
+
+#ifdef __FP_FAST_FMAF
+#  define VSINF_PI1       0x1.921fb6p+1f
+#  define VSINF_PI2       -0x1.777a5cp-24f
+#  define VSINF_PI3       -0x1.ee59dap-49f
+#  define VSINF_RANGE     0x49800000 /* 2^20 */
+#else
+#  define VSINF_PI1       0x1.922p+1f
+#  define VSINF_PI2       -0x1.2aep-17f
+#  define VSINF_PI3       -0x1.de973ep-30f
+#  define VSINF_RANGE     0x45800000 /* 2^12 */
+#endif
+
+#define VSINF_INVPI       0x1.45f306p-2f
+
+/* 1.5 * 2^23, adding it rounds to the nearest integer */
+
+#define VSINF_SHIFT       0x1.8p+23f
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef VMATH_HAVE_VECTOR
+
+/****************************************************************************
+ * Name: vsinf_kernel
+ *
+ * Description:
+ *   sin(x) = (-1)^n * sin(r), with x = n * pi + r and |r| <= pi / 2, then
+ *   sin(r) is approximated by an odd polynomial of degree 9.
+ *
+ ****************************************************************************/
+
+static vmath_f32_t vsinf_kernel(vmath_f32_t x, FAR vmath_u32_t *special)
+{
+  vmath_u32_t odd;
+  vmath_u32_t ax;
+  vmath_f32_t z;
+  vmath_f32_t n;
+  vmath_f32_t r;
+  vmath_f32_t r2;
+  vmath_f32_t y;
+
+  ax = (vmath_u32_t)x & 0x7fffffff;
+  *special = (vmath_u32_t)(ax >= VSINF_RANGE);
+
+  z   = x * VSINF_INVPI + VSINF_SHIFT;
+  odd = (vmath_u32_t)z << 31;
+  n   = z - VSINF_SHIFT;
+
+  r = x - n * VSINF_PI1;
+  r = r - n * VSINF_PI2;
+  r = r - n * VSINF_PI3;
+
+  r2 = r * r;
+  y  = VSINF_C2 + VSINF_C3 * r2;
+  y  = VSINF_C1 + y * r2;
+  y  = VSINF_C0 + y * r2;
+  y  = r + y * r2 * r;
+
+  return (vmath_f32_t)((vmath_u32_t)y ^ odd);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vsinf
+ *
+ * Description:
+ *   Compute the sine of the 'n' floats of 'x' to 'y', within 1.9 ULP
+ *   with FMA and 2.5 ULP without.
+ *
+ ****************************************************************************/
+
+void vsinf(FAR const float *x, FAR float *y, size_t n)
+{
+#ifdef VMATH_HAVE_VECTOR
+  vmath_apply(x, y, n, vsinf_kernel, sinf, 0.0f);
+#else
+  vmath_apply(x, y, n, sinf);
+#endif
+}
@@ -0,0 +1,186 @@
+//***************************************************************************
+// libs/libxx/libxxpmr/libxx_pmr_heap.cxx
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed to the Apache Software Foundation (ASF) under one or more
+// contributor license agreements.  See the NOTICE file distributed with
+// this work for additional information regarding copyright ownership.  The
+// ASF licenses this file to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance with the
+// License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//***************************************************************************
+
+//***************************************************************************
+// Included Files
+//***************************************************************************
+
+#include <nuttx/config.h>
+
+#include <new>
+
+#include <assert.h>
+#include <debug.h>
+#include <pthread.h>
+
+#include <nuttx/lib/lib.h>
+#include <nuttx/pmr.hxx>
+
+namespace nuttx
+{
+namespace pmr
+{
+
+//***************************************************************************
+// Private Data
+//***************************************************************************
+
+static pthread_once_t g_thread_heap_once = PTHREAD_ONCE_INIT;
+static pthread_key_t g_thread_heap_key;
+
+//***************************************************************************
+// Private Functions
+//***************************************************************************
+
+static void thread_heap_destroy(FAR void *arg)
+{
+  FAR heap_resource *r = static_cast<FAR heap_resource *>(arg);
+
+  // The resource was constructed at the start of its own region
+
+  r->~heap_resource();
+  lib_free(arg);
+}
+
+static void thread_heap_key_create()
+{
+  int ret = pthread_key_create(&g_thread_heap_key, thread_heap_destroy);
+
+  DEBUGASSERT(ret == 0);
+  UNUSED(ret);
+}
+
+//***************************************************************************
+// Public Functions
+//***************************************************************************
+
+heap_resource::heap_resource(const char *name, std::size_t size)
+  : m_heap(nullptr)
+{
+  m_region = lib_malloc(size);
+  if (m_region != nullptr)
+    {
+      m_heap = mm_initialize(name, m_region, size);
+    }
+
+  if (m_heap == nullptr)
+    {
+      lib_free(m_region);
+      m_region = nullptr;
+
+#ifdef CONFIG_CXX_EXCEPTION
+      throw std::bad_alloc();
+#else
+      _err("ERROR: Failed to create the heap %s\n", name);
+      PANIC();
+#endif
+    }
+}
+
+heap_resource::heap_resource(const char *name, void *start,
+                             std::size_t size)
+  : m_region(nullptr)
+{
+  m_heap = mm_initialize(name, start, size);
+  DEBUGASSERT(m_heap != nullptr);
+}
+
+heap_resource::~heap_resource()
+{
+  mm_uninitialize(m_heap);
+  lib_free(m_region);
+}
+
+void *heap_resource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+  FAR void *p = mm_memalign(m_heap, alignment, bytes);
+
+  if (p == nullptr)
+    {
+#ifdef CONFIG_CXX_EXCEPTION
+      throw std::bad_alloc();
+#else
+      _err("ERROR: Failed to allocate\n");
+#endif
+    }
+
+  return p;
+}
+
+void heap_resource::do_deallocate(void *p, std::size_t bytes,
+                                  std::size_t alignment)
+{
+  mm_free(m_heap, p);
+}
+
+bool heap_resource::do_is_equal(const std::pmr::memory_resource &other)
+  const noexcept
+{
+  return this == &other;
+}
+
+//***************************************************************************
+// Name: thread_heap_resource
+//***************************************************************************
+
+heap_resource *thread_heap_resource() noexcept
+{
+  FAR heap_resource *r;
+  FAR void *region;
+  std::size_t offset;
+
+  pthread_once(&g_thread_heap_once, thread_heap_key_create);
+
+  r = static_cast<FAR heap_resource *>(
+        pthread_getspecific(g_thread_heap_key));
+  if (r != nullptr)
+    {
+      return r;
+    }
+
+  // Put the resource at the start of the region of its heap, so that the
+  // thread costs one allocation from the global heap only.
+
+  offset = (sizeof(heap_resource) + alignof(std::max_align_t) - 1) &
+           ~(alignof(std::max_align_t) - 1);
+
+  region = lib_malloc(CONFIG_LIBXX_PMR_THREAD_HEAPSIZE);
+  if (region == nullptr)
+    {
+      return nullptr;
+    }
+
+  r = new(region) heap_resource("pmr",
+                                static_cast<FAR char *>(region) + offset,
+                                CONFIG_LIBXX_PMR_THREAD_HEAPSIZE - offset);
+
+  if (pthread_setspecific(g_thread_heap_key, r) != 0)
+    {
+      thread_heap_destroy(r);
+      return nullptr;
+    }
+
+  return r;
+}
+
+} // namespace pmr
+} // namespace nuttx
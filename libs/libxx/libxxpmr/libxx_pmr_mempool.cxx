@@ -0,0 +1,161 @@
+//***************************************************************************
+// libs/libxx/libxxpmr/libxx_pmr_mempool.cxx
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed to the Apache Software Foundation (ASF) under one or more
+// contributor license agreements.  See the NOTICE file distributed with
+// this work for additional information regarding copyright ownership.  The
+// ASF licenses this file to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance with the
+// License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//***************************************************************************
+
+//***************************************************************************
+// Included Files
+//***************************************************************************
+
+#include <nuttx/config.h>
+
+#include <cstring>
+#include <new>
+
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/lib/lib.h>
+#include <nuttx/pmr.hxx>
+
+namespace nuttx
+{
+namespace pmr
+{
+
+//***************************************************************************
+// Private Functions
+//***************************************************************************
+
+static FAR void *mempool_resource_alloc(FAR struct mempool_s *pool,
+                                        size_t size)
+{
+  return lib_memalign(alignof(std::max_align_t), size);
+}
+
+static void mempool_resource_free(FAR struct mempool_s *pool,
+                                  FAR void *addr)
+{
+  lib_free(addr);
+}
+
+//***************************************************************************
+// Public Functions
+//***************************************************************************
+
+mempool_resource::mempool_resource(std::size_t blocksize,
+                                   std::size_t initialsize,
+                                   std::size_t expandsize,
+                                   std::pmr::memory_resource *upstream)
+  : m_upstream(upstream)
+{
+  std::size_t realsize;
+
+  std::memset(&m_pool, 0, sizeof(m_pool));
+
+  // The blocks must hold the link of the free list
+
+  if (blocksize < sizeof(sq_entry_t))
+    {
+      blocksize = sizeof(sq_entry_t);
+    }
+
+  m_pool.blocksize   = blocksize;
+  m_pool.initialsize = initialsize;
+  m_pool.expandsize  = expandsize;
+  m_pool.alloc       = mempool_resource_alloc;
+  m_pool.free        = mempool_resource_free;
+
+  // The blocks follow each other from an address aligned to
+  // std::max_align_t, so they are aligned to the lowest bit of their real
+  // size as well.
+
+  realsize = MEMPOOL_REALBLOCKSIZE(&m_pool);
+  m_align  = realsize & -realsize;
+  if (m_align > alignof(std::max_align_t))
+    {
+      m_align = alignof(std::max_align_t);
+    }
+
+  if (mempool_init(&m_pool, "pmr") < 0)
+    {
+#ifdef CONFIG_CXX_EXCEPTION
+      throw std::bad_alloc();
+#else
+      _err("ERROR: Failed to initialize the pool\n");
+      PANIC();
+#endif
+    }
+}
+
+mempool_resource::~mempool_resource()
+{
+  int ret = mempool_deinit(&m_pool);
+
+  // The blocks of the pool are still in use
+
+  DEBUGASSERT(ret >= 0);
+  UNUSED(ret);
+}
+
+void *mempool_resource::do_allocate(std::size_t bytes,
+                                    std::size_t alignment)
+{
+  FAR void *p;
+
+  if (!fits(bytes, alignment))
+    {
+      return m_upstream->allocate(bytes, alignment);
+    }
+
+  p = mempool_allocate(&m_pool);
+  if (p == nullptr)
+    {
+#ifdef CONFIG_CXX_EXCEPTION
+      throw std::bad_alloc();
+#else
+      _err("ERROR: Failed to allocate\n");
+#endif
+    }
+
+  return p;
+}
+
+void mempool_resource::do_deallocate(void *p, std::size_t bytes,
+                                     std::size_t alignment)
+{
+  if (!fits(bytes, alignment))
+    {
+      m_upstream->deallocate(p, bytes, alignment);
+    }
+  else
+    {
+      mempool_release(&m_pool, p);
+    }
+}
+
+bool mempool_resource::do_is_equal(const std::pmr::memory_resource &other)
+  const noexcept
+{
+  return this == &other;
+}
+
+} // namespace pmr
+} // namespace nuttx
@@ -0,0 +1,149 @@
+//***************************************************************************
+// libs/libxx/libxxpmr/libxx_pmr_new.cxx
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed to the Apache Software Foundation (ASF) under one or more
+// contributor license agreements.  See the NOTICE file distributed with
+// this work for additional information regarding copyright ownership.  The
+// ASF licenses this file to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance with the
+// License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//***************************************************************************
+
+//***************************************************************************
+// Included Files
+//***************************************************************************
+
+#include <nuttx/config.h>
+
+#include <atomic>
+#include <new>
+
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/lib/lib.h>
+#include <nuttx/pmr.hxx>
+
+// These replace the weak operator new and operator delete of libc++, that
+// the array, nothrow and sized variants call.  The over-aligned variants
+// are left to the global heap.
+//
+// Every object is preceded by a header that keeps the resource it came
+// from, so that it is given back there even after set_new_resource():  The
+// header takes the size of std::max_align_t to keep the objects aligned.
+
+//***************************************************************************
+// Private Types
+//***************************************************************************
+
+namespace
+{
+
+struct alignas(std::max_align_t) new_header_s
+{
+  std::pmr::memory_resource *resource; // NULL for the global heap
+  std::size_t size;                    // The size given to the resource
+};
+
+//***************************************************************************
+// Private Data
+//***************************************************************************
+
+std::atomic<std::pmr::memory_resource *> g_new_resource;
+
+} // namespace
+
+//***************************************************************************
+// Public Functions
+//***************************************************************************
+
+namespace nuttx
+{
+namespace pmr
+{
+
+std::pmr::memory_resource *set_new_resource(std::pmr::memory_resource *r)
+  noexcept
+{
+  return g_new_resource.exchange(r);
+}
+
+std::pmr::memory_resource *get_new_resource() noexcept
+{
+  return g_new_resource.load();
+}
+
+} // namespace pmr
+} // namespace nuttx
+
+//***************************************************************************
+// Operators
+//***************************************************************************
+
+FAR void *operator new(std::size_t nbytes)
+{
+  std::pmr::memory_resource *r = g_new_resource.load();
+  FAR new_header_s *hdr;
+  std::size_t size = nbytes + sizeof(new_header_s);
+
+  if (r != nullptr)
+    {
+      hdr = static_cast<FAR new_header_s *>(
+              r->allocate(size, alignof(new_header_s)));
+    }
+  else
+    {
+      hdr = static_cast<FAR new_header_s *>(lib_malloc(size));
+    }
+
+  if (hdr == nullptr)
+    {
+#ifdef CONFIG_CXX_EXCEPTION
+      throw std::bad_alloc();
+#else
+      _err("ERROR: Failed to allocate\n");
+      DEBUGPANIC();
+      return nullptr;
+#endif
+    }
+
+  hdr->resource = r;
+  hdr->size     = size;
+  return hdr + 1;
+}
+
+void operator delete(FAR void *ptr) noexcept
+{
+  FAR new_header_s *hdr;
+
+  if (ptr == nullptr)
+    {
+      return;
+    }
+
+  hdr = static_cast<FAR new_header_s *>(ptr) - 1;
+  if (hdr->resource != nullptr)
+    {
+      hdr->resource->deallocate(hdr, hdr->size, alignof(new_header_s));
+    }
+  else
+    {
+      lib_free(hdr);
+    }
+}
+
+void operator delete(FAR void *ptr, std::size_t size) noexcept
+{
+  ::operator delete(ptr);
+}
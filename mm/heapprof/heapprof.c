@@ -0,0 +1,368 @@
+/****************************************************************************
+ * mm/heapprof/heapprof.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/param.h>
+
+#include <nuttx/mm/heapprof.h>
+#include <nuttx/sched.h>
+#include <nuttx/spinlock.h>
+
+/* The sampled allocations are kept in an open addressing hash table of
+ * their addresses, so that a free finds its call site without a walk;  The
+ * call sites are kept in another one, hashed by their call stacks.  The
+ * call sites are not removed until heapprof_reset(), so that the total
+ * allocations remain known after the memory is freed.
+ */
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define HEAPPROF_NSITES    CONFIG_MM_HEAPPROF_NSITES
+#define HEAPPROF_NSAMPLES  CONFIG_MM_HEAPPROF_NSAMPLES
+
+#define HEAPPROF_HASH(mem) \
+  ((((uintptr_t)(mem) >> 4) * 2654435761u) % HEAPPROF_NSAMPLES)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One sampled allocation that is not freed yet */
+
+struct heapprof_sample_s
+{
+  FAR void *mem;          /* The allocation, NULL if the slot is free */
+  size_t    bytes;        /* The bytes the sample stands for */
+  size_t    objs;         /* The allocations the sample stands for */
+  uint16_t  site;         /* The index of the call site */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct heapprof_site_s g_heapprof_sites[HEAPPROF_NSITES];
+static uint32_t g_heapprof_hashes[HEAPPROF_NSITES];
+static struct heapprof_sample_s g_heapprof_samples[HEAPPROF_NSAMPLES];
+static unsigned int g_heapprof_nsamples;
+static spinlock_t g_heapprof_lock = SP_UNLOCKED;
+
+/* The bytes to allocate until the next sample */
+
+static ssize_t g_heapprof_countdown = CONFIG_MM_HEAPPROF_RATE;
+static uint32_t g_heapprof_seed = 1;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: heapprof_interval
+ *
+ * Description:
+ *   Return the bytes until the next sample, randomized between half and
+ *   one and a half of the rate so that a periodic sequence of allocations
+ *   is not always sampled at the same allocation.
+ *
+ ****************************************************************************/
+
+static size_t heapprof_interval(void)
+{
+  uint32_t x = g_heapprof_seed;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  g_heapprof_seed = x;
+
+  return CONFIG_MM_HEAPPROF_RATE / 2 + x % CONFIG_MM_HEAPPROF_RATE;
+}
+
+/****************************************************************************
+ * Name: heapprof_findsite
+ *
+ * Description:
+ *   Return the index of the call site of a call stack, adding the call
+ *   site if it is new, or -1 if the table of call sites is full.
+ *
+ ****************************************************************************/
+
+static int heapprof_findsite(FAR void **frames, int nframes)
+{
+  FAR struct heapprof_site_s *site;
+  uint32_t hash = 2166136261u;
+  int index;
+  int i;
+
+  for (i = 0; i < nframes; i++)
+    {
+      hash = (hash ^ (uint32_t)(uintptr_t)frames[i]) * 16777619u;
+    }
+
+  index = hash % HEAPPROF_NSITES;
+  for (i = 0; i < HEAPPROF_NSITES; i++)
+    {
+      site = &g_heapprof_sites[index];
+
+      /* A call site is in use once it has an allocation */
+
+      if (site->alloc_objs == 0)
+        {
+          memcpy(site->frames, frames, nframes * sizeof(FAR void *));
+          site->nframes = nframes;
+          g_heapprof_hashes[index] = hash;
+          return index;
+        }
+
+      if (g_heapprof_hashes[index] == hash && site->nframes == nframes &&
+          memcmp(site->frames, frames, nframes * sizeof(FAR void *)) == 0)
+        {
+          return index;
+        }
+
+      index = (index + 1) % HEAPPROF_NSITES;
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Name: heapprof_remove
+ *
+ * Description:
+ *   Remove the sample in slot 'i', moving back the samples after it that
+ *   would not be found any more.
+ *
+ ****************************************************************************/
+
+static void heapprof_remove(unsigned int i)
+{
+  unsigned int j = i;
+  unsigned int k;
+
+  for (; ; )
+    {
+      g_heapprof_samples[i].mem = NULL;
+
+      do
+        {
+          j = (j + 1) % HEAPPROF_NSAMPLES;
+          if (g_heapprof_samples[j].mem == NULL)
+            {
+              return;
+            }
+
+          k = HEAPPROF_HASH(g_heapprof_samples[j].mem);
+        }
+      while (i <= j ? (i < k && k <= j) : (i < k || k <= j));
+
+      g_heapprof_samples[i] = g_heapprof_samples[j];
+      i = j;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: heapprof_alloc
+ *
+ * Description:
+ *   Account an allocation of 'size' bytes at 'mem'.
+ *
+ ****************************************************************************/
+
+void heapprof_alloc(FAR void *mem, size_t size)
+{
+  FAR struct heapprof_site_s *site;
+  FAR struct heapprof_sample_s *sample;
+  FAR void *frames[CONFIG_MM_HEAPPROF_DEPTH];
+  irqstate_t flags;
+  unsigned int i;
+  int nframes;
+  int index;
+
+  if (mem == NULL)
+    {
+      return;
+    }
+
+  /* This is the only cost of the allocations that are not sampled.  It is
+   * not locked:  A race only moves the next sample.
+   */
+
+  g_heapprof_countdown -= size;
+  if (g_heapprof_countdown > 0)
+    {
+      return;
+    }
+
+  nframes = sched_backtrace(nxsched_gettid(), frames,
+                            CONFIG_MM_HEAPPROF_DEPTH,
+                            CONFIG_MM_HEAPPROF_SKIP);
+  if (nframes < 0)
+    {
+      nframes = 0;
+    }
+
+  flags = spin_lock_irqsave(&g_heapprof_lock);
+
+  g_heapprof_countdown = heapprof_interval();
+
+  index = heapprof_findsite(frames, nframes);
+  if (index < 0 || g_heapprof_nsamples >= HEAPPROF_NSAMPLES)
+    {
+      spin_unlock_irqrestore(&g_heapprof_lock, flags);
+      return;
+    }
+
+  for (i = HEAPPROF_HASH(mem); g_heapprof_samples[i].mem != NULL; )
+    {
+      i = (i + 1) % HEAPPROF_NSAMPLES;
+    }
+
+  sample        = &g_heapprof_samples[i];
+  sample->mem   = mem;
+  sample->bytes = MAX(size, CONFIG_MM_HEAPPROF_RATE);
+  sample->objs  = sample->bytes / MAX(size, 1);
+  sample->site  = index;
+  g_heapprof_nsamples++;
+
+  site               = &g_heapprof_sites[index];
+  site->inuse_objs  += sample->objs;
+  site->inuse_bytes += sample->bytes;
+  site->alloc_objs  += sample->objs;
+  site->alloc_bytes += sample->bytes;
+
+  spin_unlock_irqrestore(&g_heapprof_lock, flags);
+}
+
+/****************************************************************************
+ * Name: heapprof_free
+ *
+ * Description:
+ *   Account the free of the allocation at 'mem'.
+ *
+ ****************************************************************************/
+
+void heapprof_free(FAR void *mem)
+{
+  FAR struct heapprof_site_s *site;
+  FAR struct heapprof_sample_s *sample;
+  irqstate_t flags;
+  unsigned int i;
+
+  /* Nothing to look up without samples;  A sample that is added meanwhile
+   * is another allocation.
+   */
+
+  if (mem == NULL || g_heapprof_nsamples == 0)
+    {
+      return;
+    }
+
+  flags = spin_lock_irqsave(&g_heapprof_lock);
+
+  for (i = HEAPPROF_HASH(mem); g_heapprof_samples[i].mem != NULL; )
+    {
+      sample = &g_heapprof_samples[i];
+      if (sample->mem == mem)
+        {
+          site               = &g_heapprof_sites[sample->site];
+          site->inuse_objs  -= sample->objs;
+          site->inuse_bytes -= sample->bytes;
+
+          heapprof_remove(i);
+          g_heapprof_nsamples--;
+          break;
+        }
+
+      i = (i + 1) % HEAPPROF_NSAMPLES;
+    }
+
+  spin_unlock_irqrestore(&g_heapprof_lock, flags);
+}
+
+/****************************************************************************
+ * Name: heapprof_getsite
+ *
+ * Description:
+ *   Get a copy of call site 'index'.
+ *
+ ****************************************************************************/
+
+int heapprof_getsite(int index, FAR struct heapprof_site_s *site)
+{
+  irqstate_t flags;
+  int ret = OK;
+
+  if (index < 0 || index >= HEAPPROF_NSITES)
+    {
+      return -EINVAL;
+    }
+
+  flags = spin_lock_irqsave(&g_heapprof_lock);
+
+  if (g_heapprof_sites[index].alloc_objs == 0)
+    {
+      ret = -ENOENT;
+    }
+  else
+    {
+      *site = g_heapprof_sites[index];
+    }
+
+  spin_unlock_irqrestore(&g_heapprof_lock, flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: heapprof_reset
+ *
+ * Description:
+ *   Forget all call sites and the sampled allocations.
+ *
+ ****************************************************************************/
+
+void heapprof_reset(void)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_heapprof_lock);
+
+  memset(g_heapprof_sites, 0, sizeof(g_heapprof_sites));
+  memset(g_heapprof_samples, 0, sizeof(g_heapprof_samples));
+  g_heapprof_nsamples = 0;
+
+  spin_unlock_irqrestore(&g_heapprof_lock, flags);
+}
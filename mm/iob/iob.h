@@ -42,6 +42,15 @@
 
 #define ROUNDUP(x, y)            (((x) + (y) - 1) / (y) * (y))
 
+/* The large I/O buffers are the pool buffers with the large payload */
+
+#ifdef CONFIG_IOB_LARGE
+#  if CONFIG_IOB_LARGE_BUFSIZE <= CONFIG_IOB_BUFSIZE
+#    error CONFIG_IOB_LARGE_BUFSIZE must be larger than CONFIG_IOB_BUFSIZE
+#  endif
+#  define IOB_ISLARGE(p)         ((p)->io_bufsize == CONFIG_IOB_LARGE_BUFSIZE)
+#endif
+
 #if defined(CONFIG_DEBUG_FEATURES) && defined(CONFIG_IOB_DEBUG)
 #  define ioberr                 _err
 #  define iobwarn                _warn
@@ -74,6 +83,12 @@ extern FAR struct iob_qentry_s *g_iob_freeqlist;
 extern FAR struct iob_qentry_s *g_iob_qcommitted;
 #endif
 
+#ifdef CONFIG_IOB_LARGE
+/* A list of all free, unallocated large I/O buffers */
+
+extern FAR struct iob_s *g_iob_largelist;
+#endif
+
 /* Counting semaphores that tracks the number of free IOBs/qentries */
 
 extern sem_t g_iob_sem;       /* Counts free I/O buffers */
@@ -147,5 +162,39 @@ FAR struct iob_qentry_s *iob_free_qentry(FAR struct iob_qentry_s *iobq);
 void iob_notifier_signal(void);
 #endif
 
+/****************************************************************************
+ * Name: iob_release
+ *
+ * Description:
+ *   Drop a reference to an I/O buffer.  The buffer is returned to the free
+ *   list, or to the heap, with the last reference.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_SHARE
+void iob_release(FAR struct iob_s *iob);
+
+/****************************************************************************
+ * Name: iob_free_shared
+ *
+ * Description:
+ *   The free callback of the headers allocated by iob_share(); The data
+ *   belongs to io_owner.
+ *
+ ****************************************************************************/
+
+void iob_free_shared(FAR void *data);
+
+/****************************************************************************
+ * Name: iob_swapdata
+ *
+ * Description:
+ *   Exchange the data buffers of two I/O buffers.
+ *
+ ****************************************************************************/
+
+void iob_swapdata(FAR struct iob_s *iob1, FAR struct iob_s *iob2);
+#endif
+
 #endif /* CONFIG_MM_IOB */
 #endif /* __MM_IOB_IOB_H */
@@ -95,6 +95,13 @@ static FAR struct iob_s *iob_alloc_committed(void)
       iob->io_len    = 0;    /* Length of the data in the entry */
       iob->io_offset = 0;    /* Offset to the beginning of data */
       iob->io_pktlen = 0;    /* Total length of the packet */
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+      iob->io_csumflags = 0; /* No checksum offload */
+#endif
+#ifdef CONFIG_IOB_SHARE
+      iob->io_owner  = NULL; /* The data is its own */
+      iob->io_refs   = 1;    /* Referenced by the caller */
+#endif
     }
 
   leave_critical_section(flags);
@@ -189,6 +196,52 @@ static void iob_free_dynamic(FAR void *data)
 }
 #endif
 
+#ifdef CONFIG_IOB_LARGE
+/****************************************************************************
+ * Name: iob_tryalloc_large
+ *
+ * Description:
+ *   Try to allocate a large I/O buffer by taking the buffer at the head of
+ *   the free list of the large buffers.
+ *
+ ****************************************************************************/
+
+static FAR struct iob_s *iob_tryalloc_large(void)
+{
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  iob = g_iob_largelist;
+  if (iob != NULL)
+    {
+      g_iob_largelist = iob->io_flink;
+    }
+
+  leave_critical_section(flags);
+
+  if (iob != NULL)
+    {
+      /* Put the I/O buffer in a known state */
+
+      iob->io_flink  = NULL; /* Not in a chain */
+      iob->io_len    = 0;    /* Length of the data in the entry */
+      iob->io_offset = 0;    /* Offset to the beginning of data */
+      iob->io_pktlen = 0;    /* Total length of the packet */
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+      iob->io_csumflags = 0; /* No checksum offload */
+#endif
+#ifdef CONFIG_IOB_SHARE
+      iob->io_owner  = NULL; /* The data is its own */
+      iob->io_refs   = 1;    /* Referenced by the caller */
+#endif
+    }
+
+  return iob;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -316,6 +369,17 @@ FAR struct iob_s *iob_tryalloc(bool throttled)
           iob->io_len    = 0;    /* Length of the data in the entry */
           iob->io_offset = 0;    /* Offset to the beginning of data */
           iob->io_pktlen = 0;    /* Total length of the packet */
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+          iob->io_csumflags = 0; /* No checksum offload */
+#endif
+#ifdef CONFIG_IOB_SHARE
+          iob->io_owner  = NULL; /* The data is its own */
+          iob->io_refs   = 1;    /* Referenced by the caller */
+#endif
+#ifdef CONFIG_IOB_SHARE
+      iob->io_owner  = NULL; /* The data is its own */
+      iob->io_refs   = 1;    /* Referenced by the caller */
+#endif
           return iob;
         }
     }
@@ -324,6 +388,50 @@ FAR struct iob_s *iob_tryalloc(bool throttled)
   return NULL;
 }
 
+#ifdef CONFIG_IOB_LARGE
+/****************************************************************************
+ * Name: iob_alloc_size
+ *
+ * Description:
+ *   Allocate an I/O buffer of the size that fits 'size' bytes best, waiting
+ *   for an I/O buffer of CONFIG_IOB_BUFSIZE if necessary.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_size(unsigned int size, bool throttled)
+{
+  FAR struct iob_s *iob = NULL;
+
+  if (size > CONFIG_IOB_BUFSIZE)
+    {
+      iob = iob_tryalloc_large();
+    }
+
+  return iob != NULL ? iob : iob_alloc(throttled);
+}
+
+/****************************************************************************
+ * Name: iob_tryalloc_size
+ *
+ * Description:
+ *   Try to allocate an I/O buffer of the size that fits 'size' bytes best
+ *   without waiting for a buffer to become free.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_size(unsigned int size, bool throttled)
+{
+  FAR struct iob_s *iob = NULL;
+
+  if (size > CONFIG_IOB_BUFSIZE)
+    {
+      iob = iob_tryalloc_large();
+    }
+
+  return iob != NULL ? iob : iob_tryalloc(throttled);
+}
+#endif
+
 #ifdef CONFIG_IOB_ALLOC
 
 /****************************************************************************
@@ -358,9 +466,16 @@ FAR struct iob_s *iob_alloc_dynamic(uint16_t size)
       iob->io_offset  = 0;                /* Offset to the beginning of data */
       iob->io_bufsize = size;             /* Total length of the iob buffer */
       iob->io_pktlen  = 0;                /* Total length of the packet */
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+      iob->io_csumflags = 0;              /* No checksum offload */
+#endif
       iob->io_free    = iob_free_dynamic; /* Customer free callback */
       iob->io_data    = (FAR uint8_t *)ROUNDUP((uintptr_t)(iob + 1),
                                                CONFIG_IOB_ALIGNMENT);
+#ifdef CONFIG_IOB_SHARE
+      iob->io_owner   = NULL;             /* The data is its own */
+      iob->io_refs    = 1;                /* Referenced by the caller */
+#endif
     }
 
   return iob;
@@ -404,8 +519,15 @@ FAR struct iob_s *iob_alloc_with_data(FAR void *data, uint16_t size,
       iob->io_offset  = 0;       /* Offset to the beginning of data */
       iob->io_bufsize = size;    /* Total length of the iob buffer */
       iob->io_pktlen  = 0;       /* Total length of the packet */
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+      iob->io_csumflags = 0;     /* No checksum offload */
+#endif
       iob->io_free    = free_cb; /* Customer free callback */
       iob->io_data    = data;
+#ifdef CONFIG_IOB_SHARE
+      iob->io_owner   = NULL;    /* The data is its own */
+      iob->io_refs    = 1;       /* Referenced by the caller */
+#endif
     }
 
   return iob;
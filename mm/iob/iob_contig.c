@@ -78,6 +78,15 @@ int iob_contig(FAR struct iob_s *iob, unsigned int len)
 
   else if (len <= iob->io_pktlen)
     {
+#ifdef CONFIG_IOB_SHARE
+      /* The head buffer is written, copy its data if it is shared */
+
+      if (iob_unshare(iob, false) < 0)
+        {
+          return -ENOMEM;
+        }
+#endif
+
       /* Yes.. First eliminate any leading offset */
 
       if (iob->io_offset > 0)
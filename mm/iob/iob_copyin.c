@@ -62,6 +62,9 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
   unsigned int ncopy;
   unsigned int avail;
   unsigned int total = len;
+#ifdef CONFIG_IOB_SHARE
+  int ret;
+#endif
 
   iobinfo("iob=%p len=%u offset=%d\n", iob, len, offset);
   DEBUGASSERT(iob && src);
@@ -98,6 +101,16 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
     {
       next = iob->io_flink;
 
+#ifdef CONFIG_IOB_SHARE
+      /* Copy the data of the buffer first if it is shared */
+
+      ret = iob_unshare(iob, throttled);
+      if (ret < 0)
+        {
+          return ret;
+        }
+#endif
+
       /* Get the destination I/O buffer address and the amount of data
        * available from that address.
        */
@@ -185,11 +198,11 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
 
           if (can_block)
             {
-              next = iob_alloc(throttled);
+              next = iob_alloc_size(len, throttled);
             }
           else
             {
-              next = iob_tryalloc(throttled);
+              next = iob_tryalloc_size(len, throttled);
             }
 
           if (next == NULL)
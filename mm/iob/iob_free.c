@@ -64,21 +64,20 @@
 #define IOB_MASK      (IOB_DIVIDER - 1)
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: iob_free
+ * Name: iob_free_buffer
  *
  * Description:
- *   Free the I/O buffer at the head of a buffer chain returning it to the
- *   free list.  The link to  the next I/O buffer in the chain is return.
+ *   Return an I/O buffer to the free list, or to the heap if it was
+ *   allocated from there.
  *
  ****************************************************************************/
 
-FAR struct iob_s *iob_free(FAR struct iob_s *iob)
+static void iob_free_buffer(FAR struct iob_s *iob)
 {
-  FAR struct iob_s *next = iob->io_flink;
   irqstate_t flags;
 #ifdef CONFIG_IOB_NOTIFIER
   int16_t navail;
@@ -87,45 +86,25 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob)
   bool committed_thottled = false;
 #endif
 
-  iobinfo("iob=%p io_pktlen=%u io_len=%u next=%p\n",
-          iob, iob->io_pktlen, iob->io_len, next);
-
-  /* Copy the data that only exists in the head of a I/O buffer chain into
-   * the next entry.
-   */
-
-  if (next != NULL)
-    {
-      /* Copy and decrement the total packet length, being careful to
-       * do nothing too crazy.
-       */
-
-      if (iob->io_pktlen > iob->io_len)
-        {
-          /* Adjust packet length and move it to the next entry */
-
-          next->io_pktlen = iob->io_pktlen - iob->io_len;
-          DEBUGASSERT(next->io_pktlen >= next->io_len);
-        }
-      else
-        {
-          /* This can only happen if the free entry isn't first entry in the
-           * chain...
-           */
-
-          next->io_pktlen = 0;
-        }
-
-      iobinfo("next=%p io_pktlen=%u io_len=%u\n",
-              next, next->io_pktlen, next->io_len);
-    }
-
 #ifdef CONFIG_IOB_ALLOC
   if (iob->io_free != NULL)
     {
       iob->io_free(iob->io_data);
       kmm_free(iob);
-      return next;
+      return;
+    }
+#endif
+
+#ifdef CONFIG_IOB_LARGE
+  /* Nobody waits for the large I/O buffers, just put them back */
+
+  if (IOB_ISLARGE(iob))
+    {
+      flags = enter_critical_section();
+      iob->io_flink   = g_iob_largelist;
+      g_iob_largelist = iob;
+      leave_critical_section(flags);
+      return;
     }
 #endif
 
@@ -234,6 +213,117 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob)
       iob_notifier_signal();
     }
 #endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_SHARE
+/****************************************************************************
+ * Name: iob_release
+ *
+ * Description:
+ *   Drop a reference to an I/O buffer.  The buffer is returned to the free
+ *   list, or to the heap, with the last reference.
+ *
+ ****************************************************************************/
+
+void iob_release(FAR struct iob_s *iob)
+{
+  FAR struct iob_s *owner;
+  irqstate_t flags;
+  unsigned int refs;
+
+  flags = enter_critical_section();
+  DEBUGASSERT(iob->io_refs > 0);
+  refs = --iob->io_refs;
+  leave_critical_section(flags);
+
+  if (refs > 0)
+    {
+      return;
+    }
+
+  /* The data of the I/O buffer belongs to another one, drop that too */
+
+  owner = iob->io_owner;
+  if (owner != NULL)
+    {
+      /* An I/O buffer that was unshared while its own data was shared has
+       * left its data buffer to its owner, take it back.
+       */
+
+      if (iob->io_free != iob_free_shared)
+        {
+          iob_swapdata(iob, owner);
+        }
+
+      iob->io_owner = NULL;
+      iob_release(owner);
+    }
+
+  iob_free_buffer(iob);
+}
+#endif
+
+/****************************************************************************
+ * Name: iob_free
+ *
+ * Description:
+ *   Free the I/O buffer at the head of a buffer chain returning it to the
+ *   free list.  The link to  the next I/O buffer in the chain is return.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_free(FAR struct iob_s *iob)
+{
+  FAR struct iob_s *next = iob->io_flink;
+
+  iobinfo("iob=%p io_pktlen=%u io_len=%u next=%p\n",
+          iob, iob->io_pktlen, iob->io_len, next);
+
+  /* Copy the data that only exists in the head of a I/O buffer chain into
+   * the next entry.
+   */
+
+  if (next != NULL)
+    {
+      /* Copy and decrement the total packet length, being careful to
+       * do nothing too crazy.
+       */
+
+      if (iob->io_pktlen > iob->io_len)
+        {
+          /* Adjust packet length and move it to the next entry */
+
+          next->io_pktlen = iob->io_pktlen - iob->io_len;
+          DEBUGASSERT(next->io_pktlen >= next->io_len);
+        }
+      else
+        {
+          /* This can only happen if the free entry isn't first entry in the
+           * chain...
+           */
+
+          next->io_pktlen = 0;
+        }
+
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+      /* The offsets of the checksum offload do not apply to the rest */
+
+      next->io_csumflags = 0;
+#endif
+
+      iobinfo("next=%p io_pktlen=%u io_len=%u\n",
+              next, next->io_pktlen, next->io_len);
+    }
+
+#ifdef CONFIG_IOB_SHARE
+  iob_release(iob);
+#else
+  iob_free_buffer(iob);
+#endif
 
   /* And return the I/O buffer after the one that was freed */
 
@@ -70,6 +70,17 @@ FAR struct iob_s *iob_pack(FAR struct iob_s *iob)
     {
       next = iob->io_flink;
 
+#ifdef CONFIG_IOB_SHARE
+      /* A shared buffer is copied before it is packed; Without a buffer
+       * for the copy, the rest of the chain is left as it is.
+       */
+
+      if (iob_unshare(iob, false) < 0)
+        {
+          break;
+        }
+#endif
+
       /* Eliminate the data offset in this entry */
 
       if (iob->io_offset > 0)
@@ -0,0 +1,229 @@
+/****************************************************************************
+ * mm/iob/iob_share.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+#ifdef CONFIG_IOB_SHARE
+
+/* The data of an I/O buffer may be referred to by the headers of its
+ * clones.  io_refs counts the user of a buffer and the clones of its data,
+ * and io_owner of a clone is the buffer that owns the data.  A buffer
+ * whose data is still shared when it is written can not give its data
+ * buffer away, so it takes the data buffer of the copy and leaves its own
+ * in the copy until the clones are gone.
+ */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_free_shared
+ *
+ * Description:
+ *   The free callback of the headers allocated by iob_share(); The data
+ *   belongs to io_owner.
+ *
+ ****************************************************************************/
+
+void iob_free_shared(FAR void *data)
+{
+  UNUSED(data);
+}
+
+/****************************************************************************
+ * Name: iob_swapdata
+ *
+ * Description:
+ *   Exchange the data buffers of two I/O buffers.
+ *
+ ****************************************************************************/
+
+void iob_swapdata(FAR struct iob_s *iob1, FAR struct iob_s *iob2)
+{
+  FAR uint8_t *data = iob1->io_data;
+  uint16_t bufsize = iob1->io_bufsize;
+
+  iob1->io_data    = iob2->io_data;
+  iob1->io_bufsize = iob2->io_bufsize;
+  iob2->io_data    = data;
+  iob2->io_bufsize = bufsize;
+}
+
+/****************************************************************************
+ * Name: iob_share
+ *
+ * Description:
+ *   Clone an I/O buffer chain without copying its data.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_share(FAR struct iob_s *iob)
+{
+  FAR struct iob_s *head = NULL;
+  FAR struct iob_s *tail = NULL;
+  FAR struct iob_s *clone;
+  FAR struct iob_s *owner;
+  irqstate_t flags;
+
+  DEBUGASSERT(iob != NULL);
+
+  for (; iob != NULL; iob = iob->io_flink)
+    {
+      clone = kmm_malloc(sizeof(struct iob_s));
+      if (clone == NULL)
+        {
+          ioberr("ERROR: Failed to allocate an I/O buffer header\n");
+          if (head != NULL)
+            {
+              iob_free_chain(head);
+            }
+
+          return NULL;
+        }
+
+      /* The clone refers to the owner of the data, which is the buffer
+       * itself unless it refers to the data of another one too.
+       */
+
+      owner = iob->io_owner != NULL ? iob->io_owner : iob;
+
+      flags = enter_critical_section();
+      owner->io_refs++;
+      leave_critical_section(flags);
+
+      clone->io_flink   = NULL;
+      clone->io_len     = iob->io_len;
+      clone->io_offset  = iob->io_offset;
+      clone->io_bufsize = iob->io_bufsize;
+      clone->io_pktlen  = 0;
+      clone->io_free    = iob_free_shared;
+      clone->io_data    = iob->io_data;
+      clone->io_owner   = owner;
+      clone->io_refs    = 1;
+
+      if (tail == NULL)
+        {
+          clone->io_pktlen = iob->io_pktlen;
+          head             = clone;
+        }
+      else
+        {
+          tail->io_flink   = clone;
+        }
+
+      tail = clone;
+    }
+
+  return head;
+}
+
+/****************************************************************************
+ * Name: iob_unshare
+ *
+ * Description:
+ *   Give an I/O buffer a data buffer of its own if it shares its data with
+ *   other I/O buffers.
+ *
+ ****************************************************************************/
+
+int iob_unshare(FAR struct iob_s *iob, bool throttled)
+{
+  FAR struct iob_s *owner;
+  FAR struct iob_s *copy;
+
+  /* Nobody else refers to the data if the owner has only one reference.
+   * The count can only drop meanwhile, which costs a useless copy.
+   */
+
+  owner = iob->io_owner != NULL ? iob->io_owner : iob;
+  if (owner->io_refs <= 1)
+    {
+      return OK;
+    }
+
+  if (IOB_BUFSIZE(iob) > CONFIG_IOB_BUFSIZE)
+    {
+      copy = iob_alloc_dynamic(IOB_BUFSIZE(iob));
+    }
+  else
+    {
+      copy = iob_tryalloc(throttled);
+    }
+
+  if (copy == NULL)
+    {
+      ioberr("ERROR: Failed to allocate an I/O buffer\n");
+      return -ENOMEM;
+    }
+
+  /* Copy the data and the room ahead of it, where headers are added */
+
+  memcpy(copy->io_data, iob->io_data, iob->io_offset + iob->io_len);
+
+  if (iob->io_free == iob_free_shared)
+    {
+      /* A clone simply refers to the copy instead */
+
+      iob->io_data    = copy->io_data;
+      iob->io_bufsize = copy->io_bufsize;
+    }
+  else
+    {
+      /* Take back a data buffer left in the owner before, then leave it in
+       * the copy.
+       */
+
+      if (iob->io_owner != NULL)
+        {
+          iob_swapdata(iob, iob->io_owner);
+        }
+
+      iob_swapdata(iob, copy);
+    }
+
+  owner         = iob->io_owner;
+  iob->io_owner = copy;
+
+  if (owner != NULL)
+    {
+      iob_release(owner);
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_IOB_SHARE */
@@ -31,6 +31,7 @@
 
 #include <assert.h>
 #include <stdint.h>
+#include <sys/param.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -70,6 +71,14 @@ static FAR struct kasan_region_s *g_region[CONFIG_MM_KASAN_REGIONS];
 static size_t g_region_count;
 static spinlock_t g_lock;
 
+/* The lowest and the highest address of all regions, so that the accesses
+ * out of the heaps (data, peripherals, ...) are not looked up one region
+ * after another.
+ */
+
+static uintptr_t g_region_begin = UINTPTR_MAX;
+static uintptr_t g_region_end;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -81,6 +90,11 @@ kasan_mem_to_shadow(FAR const void *ptr, size_t size,
   uintptr_t addr = (uintptr_t)ptr;
   size_t i;
 
+  if (addr < g_region_begin || addr >= g_region_end)
+    {
+      return NULL;
+    }
+
   for (i = 0; i < g_region_count; i++)
     {
       if (addr >= g_region[i]->begin && addr < g_region[i]->end)
@@ -200,6 +214,22 @@ static void kasan_set_poison(FAR const void *addr, size_t size,
   spin_unlock_irqrestore(&g_lock, flags);
 }
 
+/* Called with g_lock held */
+
+static void kasan_update_bounds(void)
+{
+  size_t i;
+
+  g_region_begin = UINTPTR_MAX;
+  g_region_end   = 0;
+
+  for (i = 0; i < g_region_count; i++)
+    {
+      g_region_begin = MIN(g_region_begin, g_region[i]->begin);
+      g_region_end   = MAX(g_region_end, g_region[i]->end);
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -235,6 +265,7 @@ void kasan_register(FAR void *addr, FAR size_t *size)
 
   DEBUGASSERT(g_region_count <= CONFIG_MM_KASAN_REGIONS);
   g_region[g_region_count++] = region;
+  kasan_update_bounds();
 
   spin_unlock_irqrestore(&g_lock, flags);
 
@@ -256,6 +287,7 @@ void kasan_unregister(FAR void *addr)
           g_region_count--;
           memmove(&g_region[i], &g_region[i + 1],
                   (g_region_count - i) * sizeof(g_region[0]));
+          kasan_update_bounds();
           break;
         }
     }
@@ -0,0 +1,205 @@
+/****************************************************************************
+ * mm/kasan/inline.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/nuttx.h>
+#include <nuttx/mm/kasan.h>
+#include <nuttx/compiler.h>
+#include <nuttx/spinlock.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The shadow memory has the layout that the compiler expects for its inline
+ * checks:  The shadow byte of the 8 bytes at 'addr' is at
+ * (addr >> 3) + CONFIG_MM_KASAN_SHADOW_OFFSET, always.  It is 0 if all of
+ * the 8 bytes are accessible, n if only the first n bytes are accessible,
+ * and negative if none is.  Since the shadow of the memory is found without
+ * looking up its region, the checks of the compiler read one shadow byte
+ * and only call into kasan when the access is invalid.
+ */
+
+#define KASAN_SHADOW_SCALE_SHIFT 3
+#define KASAN_SHADOW_SCALE       (1 << KASAN_SHADOW_SCALE_SHIFT)
+#define KASAN_SHADOW_MASK        (KASAN_SHADOW_SCALE - 1)
+#define KASAN_SHADOW_POISON      0xff
+
+#define kasan_mem_to_shadow(addr) \
+  ((FAR int8_t *)(((uintptr_t)(addr) >> KASAN_SHADOW_SCALE_SHIFT) + \
+                  CONFIG_MM_KASAN_SHADOW_OFFSET))
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The registered regions, whose shadow is cleared again when they are
+ * unregistered.
+ */
+
+struct kasan_region_s
+{
+  uintptr_t begin;
+  size_t    size;
+};
+
+static struct kasan_region_s g_region[CONFIG_MM_KASAN_REGIONS];
+static size_t g_region_count;
+static spinlock_t g_lock;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline_function bool kasan_byte_is_poisoned(uintptr_t addr)
+{
+  int8_t shadow = *kasan_mem_to_shadow(addr);
+
+  return shadow != 0 && (int8_t)(addr & KASAN_SHADOW_MASK) >= shadow;
+}
+
+static inline_function bool
+kasan_is_poisoned(FAR const void *addr, size_t size)
+{
+  uintptr_t begin = (uintptr_t)addr;
+  uintptr_t end = begin + size - 1;
+  FAR int8_t *first = kasan_mem_to_shadow(begin);
+  FAR int8_t *last = kasan_mem_to_shadow(end);
+
+  /* A partly accessible granule is the last one of the memory, so it can
+   * only end the access.
+   */
+
+  if (first != last)
+    {
+      if (*first != 0)
+        {
+          return true;
+        }
+
+      while (++first < last)
+        {
+          if (*first != 0)
+            {
+              return true;
+            }
+        }
+    }
+
+  return kasan_byte_is_poisoned(end);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+FAR void *kasan_reset_tag(FAR const void *addr)
+{
+  return (FAR void *)addr;
+}
+
+void kasan_poison(FAR const void *addr, size_t size)
+{
+  uintptr_t begin = ALIGN_UP((uintptr_t)addr, KASAN_SHADOW_SCALE);
+  uintptr_t end = ALIGN_DOWN((uintptr_t)addr + size, KASAN_SHADOW_SCALE);
+
+  /* The granules that are shared with the memory around are left alone */
+
+  if (begin < end)
+    {
+      memset(kasan_mem_to_shadow(begin), KASAN_SHADOW_POISON,
+             (end - begin) >> KASAN_SHADOW_SCALE_SHIFT);
+    }
+}
+
+FAR void *kasan_unpoison(FAR const void *addr, size_t size)
+{
+  uintptr_t begin = ALIGN_DOWN((uintptr_t)addr, KASAN_SHADOW_SCALE);
+  uintptr_t end = (uintptr_t)addr + size;
+  FAR int8_t *shadow = kasan_mem_to_shadow(begin);
+
+  memset(shadow, 0, (end - begin) >> KASAN_SHADOW_SCALE_SHIFT);
+  if ((end & KASAN_SHADOW_MASK) != 0)
+    {
+      shadow[(end - begin) >> KASAN_SHADOW_SCALE_SHIFT] =
+        end & KASAN_SHADOW_MASK;
+    }
+
+  return (FAR void *)addr;
+}
+
+void kasan_register(FAR void *addr, FAR size_t *size)
+{
+  irqstate_t flags;
+
+  /* The shadow memory is set aside by the board, the whole region is
+   * left to the heap.
+   */
+
+  flags = spin_lock_irqsave(&g_lock);
+
+  DEBUGASSERT(g_region_count < CONFIG_MM_KASAN_REGIONS);
+  g_region[g_region_count].begin = (uintptr_t)addr;
+  g_region[g_region_count].size  = *size;
+  g_region_count++;
+
+  spin_unlock_irqrestore(&g_lock, flags);
+
+  kasan_start();
+  kasan_poison(addr, *size);
+}
+
+void kasan_unregister(FAR void *addr)
+{
+  irqstate_t flags;
+  size_t size = 0;
+  size_t i;
+
+  flags = spin_lock_irqsave(&g_lock);
+  for (i = 0; i < g_region_count; i++)
+    {
+      if (g_region[i].begin == (uintptr_t)addr)
+        {
+          size = g_region[i].size;
+          g_region_count--;
+          memmove(&g_region[i], &g_region[i + 1],
+                  (g_region_count - i) * sizeof(g_region[0]));
+          break;
+        }
+    }
+
+  spin_unlock_irqrestore(&g_lock, flags);
+
+  /* The memory is no longer checked once the heap is gone */
+
+  if (size > 0)
+    {
+      kasan_unpoison(addr, size);
+    }
+}
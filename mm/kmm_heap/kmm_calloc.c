@@ -26,7 +26,10 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
+
 #include <nuttx/mm/mm.h>
+#include <nuttx/sched.h>
 
 #ifdef CONFIG_MM_KERNEL_HEAP
 
@@ -44,7 +47,18 @@
 
 FAR void *kmm_calloc(size_t n, size_t elem_size)
 {
+#if CONFIG_MM_KERNEL_HEAP_NODES > 1
+  /* Verify input parameters */
+
+  if (n > 0 && elem_size > SIZE_MAX / n)
+    {
+      return NULL;
+    }
+
+  return kmm_zalloc_node(kmm_cpunode(this_cpu()), n * elem_size);
+#else
   return mm_calloc(g_kmmheap, n, elem_size);
+#endif
 }
 
 #endif /* CONFIG_MM_KERNEL_HEAP */
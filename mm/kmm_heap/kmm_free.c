@@ -55,7 +55,11 @@
 void kmm_free(FAR void *mem)
 {
   DEBUGASSERT((mem == NULL) || kmm_heapmember(mem));
+#if CONFIG_MM_KERNEL_HEAP_NODES > 1
+  mm_free(kmm_memheap(mem), mem);
+#else
   mm_free(g_kmmheap, mem);
+#endif
 }
 
 #endif /* CONFIG_MM_KERNEL_HEAP */
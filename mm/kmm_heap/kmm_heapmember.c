@@ -54,7 +54,11 @@
 
 bool kmm_heapmember(FAR void *mem)
 {
+#if CONFIG_MM_KERNEL_HEAP_NODES > 1
+  return mm_heapmember(kmm_memheap(mem), mem);
+#else
   return mm_heapmember(g_kmmheap, mem);
+#endif
 }
 
 #endif /* CONFIG_MM_KERNEL_HEAP */
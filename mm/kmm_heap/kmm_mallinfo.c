@@ -45,7 +45,93 @@
 
 struct mallinfo kmm_mallinfo(void)
 {
+#if CONFIG_MM_KERNEL_HEAP_NODES > 1
+  struct mallinfo info = mm_mallinfo(g_kmmheap);
+  struct mallinfo node;
+  int i;
+
+  /* Add up the heaps of the other memory nodes */
+
+  for (i = 1; i < CONFIG_MM_KERNEL_HEAP_NODES; i++)
+    {
+      node           = kmm_mallinfo_node(i);
+      info.arena    += node.arena;
+      info.ordblks  += node.ordblks;
+      info.aordblks += node.aordblks;
+      info.uordblks += node.uordblks;
+      info.fordblks += node.fordblks;
+      info.usmblks  += node.usmblks;
+      if (node.mxordblk > info.mxordblk)
+        {
+          info.mxordblk = node.mxordblk;
+        }
+    }
+
+  return info;
+#else
   return mm_mallinfo(g_kmmheap);
+#endif
+}
+
+/****************************************************************************
+ * Name: kmm_fraginfo
+ *
+ * Description:
+ *   kmm_fraginfo returns the free memory of the kernel heap by size class,
+ *   without walking the heap.
+ *
+ ****************************************************************************/
+
+int kmm_fraginfo(FAR struct mm_fraginfo_s *info)
+{
+#if CONFIG_MM_KERNEL_HEAP_NODES > 1
+  struct mm_fraginfo_s node;
+  FAR struct mm_heap_s *heap;
+  int ret;
+  int i;
+  int j;
+
+  ret = mm_fraginfo(g_kmmheap, info);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Add up the heaps of the other memory nodes */
+
+  for (i = 1; i < CONFIG_MM_KERNEL_HEAP_NODES; i++)
+    {
+      heap = kmm_nodeheap(i);
+      if (heap == g_kmmheap || mm_fraginfo(heap, &node) < 0)
+        {
+          continue;
+        }
+
+      info->freesize += node.freesize;
+      info->nfree    += node.nfree;
+      if (node.largest > info->largest)
+        {
+          info->largest = node.largest;
+        }
+
+      for (j = 0; j < MM_FRAGINFO_NCLASSES; j++)
+        {
+          info->count[j] += node.count[j];
+          info->bytes[j] += node.bytes[j];
+        }
+    }
+
+  info->fragindex = 0;
+  if (info->freesize > 0)
+    {
+      info->fragindex = 1000 - (uint64_t)info->largest * 1000 /
+                               info->freesize;
+    }
+
+  return OK;
+#else
+  return mm_fraginfo(g_kmmheap, info);
+#endif
 }
 
 /****************************************************************************
@@ -59,6 +145,26 @@ struct mallinfo kmm_mallinfo(void)
 
 struct mallinfo_task kmm_mallinfo_task(FAR const struct malltask *task)
 {
+#if CONFIG_MM_KERNEL_HEAP_NODES > 1
+  struct mallinfo_task info = mm_mallinfo_task(g_kmmheap, task);
+  struct mallinfo_task node;
+  FAR struct mm_heap_s *heap;
+  int i;
+
+  for (i = 1; i < CONFIG_MM_KERNEL_HEAP_NODES; i++)
+    {
+      heap = kmm_nodeheap(i);
+      if (heap != g_kmmheap)
+        {
+          node           = mm_mallinfo_task(heap, task);
+          info.aordblks += node.aordblks;
+          info.uordblks += node.uordblks;
+        }
+    }
+
+  return info;
+#else
   return mm_mallinfo_task(g_kmmheap, task);
+#endif
 }
 #endif /* CONFIG_MM_KERNEL_HEAP */
@@ -27,6 +27,7 @@
 #include <nuttx/config.h>
 
 #include <nuttx/mm/mm.h>
+#include <nuttx/sched.h>
 
 #ifdef CONFIG_MM_KERNEL_HEAP
 
@@ -50,7 +51,11 @@
 
 FAR void *kmm_malloc(size_t size)
 {
+#if CONFIG_MM_KERNEL_HEAP_NODES > 1
+  return kmm_malloc_node(kmm_cpunode(this_cpu()), size);
+#else
   return mm_malloc(g_kmmheap, size);
+#endif
 }
 
 #endif /* CONFIG_MM_KERNEL_HEAP */
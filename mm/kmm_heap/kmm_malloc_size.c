@@ -36,7 +36,11 @@
 
 size_t kmm_malloc_size(FAR void *mem)
 {
+#if CONFIG_MM_KERNEL_HEAP_NODES > 1
+  return mm_malloc_size(kmm_memheap(mem), mem);
+#else
   return mm_malloc_size(g_kmmheap, mem);
+#endif
 }
 
 #endif /* CONFIG_MM_KERNEL_HEAP */
@@ -29,6 +29,7 @@
 #include <stdlib.h>
 
 #include <nuttx/mm/mm.h>
+#include <nuttx/sched.h>
 
 #ifdef CONFIG_MM_KERNEL_HEAP
 
@@ -53,7 +54,11 @@
 
 FAR void *kmm_memalign(size_t alignment, size_t size)
 {
+#if CONFIG_MM_KERNEL_HEAP_NODES > 1
+  return kmm_memalign_node(kmm_cpunode(this_cpu()), alignment, size);
+#else
   return mm_memalign(g_kmmheap, alignment, size);
+#endif
 }
 
 #endif /* CONFIG_MM_KERNEL_HEAP */
@@ -0,0 +1,265 @@
+/****************************************************************************
+ * mm/kmm_heap/kmm_node.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <nuttx/compiler.h>
+#include <nuttx/mm/mm.h>
+
+#if defined(CONFIG_MM_KERNEL_HEAP) && CONFIG_MM_KERNEL_HEAP_NODES > 1
+
+/* Each memory node has a heap of its own.  The heap of node 0 is the kernel
+ * heap g_kmmheap;  The heaps of the other nodes are created when memory is
+ * first added to them with kmm_addregion_node().  An allocation is served
+ * by the heap of the requested node, or else by the heaps of the following
+ * nodes, and a free finds the heap from the address of the memory.
+ */
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR struct mm_heap_s *g_kmmnodeheap[CONFIG_MM_KERNEL_HEAP_NODES];
+static char g_kmmnodename[CONFIG_MM_KERNEL_HEAP_NODES][8];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: kmm_node_alloc
+ *
+ * Description:
+ *   Allocate memory from the heap of a node, falling back on the heaps of
+ *   the other nodes.
+ *
+ ****************************************************************************/
+
+static FAR void *kmm_node_alloc(int node, size_t alignment, size_t size)
+{
+  FAR struct mm_heap_s *heap;
+  FAR void *ret;
+  int i;
+
+  /* A node without memory of its own uses the kernel heap */
+
+  if (node <= 0 || node >= CONFIG_MM_KERNEL_HEAP_NODES ||
+      g_kmmnodeheap[node] == NULL)
+    {
+      node = 0;
+    }
+
+  for (i = 0; i < CONFIG_MM_KERNEL_HEAP_NODES; i++)
+    {
+      int n = (node + i) % CONFIG_MM_KERNEL_HEAP_NODES;
+
+      heap = n == 0 ? g_kmmheap : g_kmmnodeheap[n];
+      if (heap == NULL)
+        {
+          continue;
+        }
+
+      ret = alignment > 0 ? mm_memalign(heap, alignment, size) :
+                            mm_malloc(heap, size);
+      if (ret != NULL)
+        {
+          return ret;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: kmm_cpunode
+ *
+ * Description:
+ *   Return the memory node closest to a CPU.  The CPUs are spread evenly
+ *   over the nodes by default; A board with another topology overrides
+ *   this function.
+ *
+ ****************************************************************************/
+
+int weak_function kmm_cpunode(int cpu)
+{
+  return cpu * CONFIG_MM_KERNEL_HEAP_NODES / CONFIG_SMP_NCPUS;
+}
+
+/****************************************************************************
+ * Name: kmm_addregion_node
+ *
+ * Description:
+ *   Add memory of a node to the heap of that node.
+ *
+ ****************************************************************************/
+
+void kmm_addregion_node(int node, FAR void *heapstart, size_t heapsize)
+{
+  DEBUGASSERT(node >= 0 && node < CONFIG_MM_KERNEL_HEAP_NODES);
+
+  if (node == 0)
+    {
+      kmm_addregion(heapstart, heapsize);
+    }
+  else if (g_kmmnodeheap[node] == NULL)
+    {
+      snprintf(g_kmmnodename[node], sizeof(g_kmmnodename[node]),
+               "Kmem%d", node);
+      g_kmmnodeheap[node] = mm_initialize_pool(g_kmmnodename[node],
+                                               heapstart, heapsize, NULL);
+    }
+  else
+    {
+      mm_addregion(g_kmmnodeheap[node], heapstart, heapsize);
+    }
+}
+
+/****************************************************************************
+ * Name: kmm_nodeheap
+ *
+ * Description:
+ *   Return the heap of a node, the kernel heap if the node has no memory
+ *   of its own.
+ *
+ ****************************************************************************/
+
+FAR struct mm_heap_s *kmm_nodeheap(int node)
+{
+  if (node > 0 && node < CONFIG_MM_KERNEL_HEAP_NODES &&
+      g_kmmnodeheap[node] != NULL)
+    {
+      return g_kmmnodeheap[node];
+    }
+
+  return g_kmmheap;
+}
+
+/****************************************************************************
+ * Name: kmm_memheap
+ *
+ * Description:
+ *   Return the heap of the node that holds the memory 'mem'.
+ *
+ ****************************************************************************/
+
+FAR struct mm_heap_s *kmm_memheap(FAR void *mem)
+{
+  int i;
+
+  for (i = 1; i < CONFIG_MM_KERNEL_HEAP_NODES; i++)
+    {
+      if (g_kmmnodeheap[i] != NULL && mm_heapmember(g_kmmnodeheap[i], mem))
+        {
+          return g_kmmnodeheap[i];
+        }
+    }
+
+  return g_kmmheap;
+}
+
+/****************************************************************************
+ * Name: kmm_malloc_node
+ *
+ * Description:
+ *   Allocate memory from the kernel heap of a node.  The heaps of the
+ *   other nodes are used if the node runs out of memory.
+ *
+ ****************************************************************************/
+
+FAR void *kmm_malloc_node(int node, size_t size)
+{
+  return kmm_node_alloc(node, 0, size);
+}
+
+/****************************************************************************
+ * Name: kmm_zalloc_node
+ *
+ * Description:
+ *   Allocate and clear memory from the kernel heap of a node.
+ *
+ ****************************************************************************/
+
+FAR void *kmm_zalloc_node(int node, size_t size)
+{
+  FAR void *ret = kmm_node_alloc(node, 0, size);
+
+  if (ret != NULL)
+    {
+      memset(ret, 0, size);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: kmm_memalign_node
+ *
+ * Description:
+ *   Allocate aligned memory from the kernel heap of a node.
+ *
+ ****************************************************************************/
+
+FAR void *kmm_memalign_node(int node, size_t alignment, size_t size)
+{
+  return kmm_node_alloc(node, alignment, size);
+}
+
+/****************************************************************************
+ * Name: kmm_mallinfo_node
+ *
+ * Description:
+ *   Return the information of the kernel heap of a node.  It is all zero
+ *   for a node without memory of its own.
+ *
+ ****************************************************************************/
+
+struct mallinfo kmm_mallinfo_node(int node)
+{
+  struct mallinfo info;
+
+  if (node == 0)
+    {
+      return mm_mallinfo(g_kmmheap);
+    }
+  else if (node > 0 && node < CONFIG_MM_KERNEL_HEAP_NODES &&
+           g_kmmnodeheap[node] != NULL)
+    {
+      return mm_mallinfo(g_kmmnodeheap[node]);
+    }
+
+  memset(&info, 0, sizeof(info));
+  return info;
+}
+
+#endif /* CONFIG_MM_KERNEL_HEAP && CONFIG_MM_KERNEL_HEAP_NODES > 1 */
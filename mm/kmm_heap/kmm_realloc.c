@@ -51,7 +51,16 @@
 
 FAR void *kmm_realloc(FAR void *oldmem, size_t newsize)
 {
+#if CONFIG_MM_KERNEL_HEAP_NODES > 1
+  if (oldmem == NULL)
+    {
+      return kmm_malloc(newsize);
+    }
+
+  return mm_realloc(kmm_memheap(oldmem), oldmem, newsize);
+#else
   return mm_realloc(g_kmmheap, oldmem, newsize);
+#endif
 }
 
 #endif /* CONFIG_MM_KERNEL_HEAP */
@@ -38,10 +38,72 @@
 
 #if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Keep the end of the subtrees up to date through the rotations */
+
+#undef  RB_AUGMENT
+#define RB_AUGMENT(x) mm_map_augment(x)
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void mm_map_augment(FAR struct mm_map_entry_s *entry);
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+static int mm_map_compare(FAR const struct mm_map_entry_s *a,
+                          FAR const struct mm_map_entry_s *b)
+{
+  /* Mappings at the same address are sorted by their entry */
+
+  if (a->vaddr != b->vaddr)
+    {
+      return (uintptr_t)a->vaddr < (uintptr_t)b->vaddr ? -1 : 1;
+    }
+
+  return a == b ? 0 : ((uintptr_t)a < (uintptr_t)b ? -1 : 1);
+}
+
+RB_GENERATE_STATIC(mm_map_tree_s, mm_map_entry_s, node, mm_map_compare)
+
+static void mm_map_augment(FAR struct mm_map_entry_s *entry)
+{
+  FAR struct mm_map_entry_s *child;
+  uintptr_t end = (uintptr_t)entry->vaddr + entry->length;
+
+  child = RB_LEFT(entry, node);
+  if (child != NULL && child->end_max > end)
+    {
+      end = child->end_max;
+    }
+
+  child = RB_RIGHT(entry, node);
+  if (child != NULL && child->end_max > end)
+    {
+      end = child->end_max;
+    }
+
+  entry->end_max = end;
+}
+
+/* The tree only updates the parent of an inserted or removed node, update
+ * the end of the subtrees up to the root.
+ */
+
+static void mm_map_augment_path(FAR struct mm_map_entry_s *entry)
+{
+  for (; entry != NULL; entry = RB_PARENT(entry, node))
+    {
+      mm_map_augment(entry);
+    }
+}
+
 static bool in_range(FAR const void *start, size_t length,
                      FAR const void *range_start, size_t range_length)
 {
@@ -54,6 +116,47 @@ static bool in_range(FAR const void *start, size_t length,
           u_end >= r_start && u_end <= r_end);     /* End is in range. */
 }
 
+/****************************************************************************
+ * Name: mm_map_search
+ *
+ * Description:
+ *   Find a mapping of the subtree containing the range:  A subtree is only
+ *   searched if its mappings end after the range, and the mappings on the
+ *   right only if they may start before the range.
+ *
+ ****************************************************************************/
+
+static FAR struct mm_map_entry_s *
+mm_map_search(FAR struct mm_map_entry_s *entry,
+              FAR const void *vaddr, size_t length)
+{
+  FAR struct mm_map_entry_s *found;
+  uintptr_t end = (uintptr_t)vaddr + length;
+
+  while (entry != NULL && entry->end_max >= end)
+    {
+      found = mm_map_search(RB_LEFT(entry, node), vaddr, length);
+      if (found != NULL)
+        {
+          return found;
+        }
+
+      if (in_range(vaddr, length, entry->vaddr, entry->length))
+        {
+          return entry;
+        }
+
+      if ((uintptr_t)entry->vaddr > (uintptr_t)vaddr)
+        {
+          break;
+        }
+
+      entry = RB_RIGHT(entry, node);
+    }
+
+  return NULL;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -111,8 +214,9 @@ void mm_map_unlock(void)
 
 void mm_map_initialize(FAR struct mm_map_s *mm, bool kernel)
 {
-  sq_init(&mm->mm_map_sq);
+  RB_INIT(&mm->mm_map_tree);
   nxrmutex_init(&mm->mm_map_mutex);
+  mm->mm_map_hint = NULL;
   mm->map_count = 0;
 
   /* Create the virtual pages allocator for user process */
@@ -146,8 +250,12 @@ void mm_map_destroy(FAR struct mm_map_s *mm)
 {
   FAR struct mm_map_entry_s *entry;
 
-  while ((entry = (FAR struct mm_map_entry_s *)sq_remfirst(&mm->mm_map_sq)))
+  mm->mm_map_hint = NULL;
+
+  while ((entry = RB_ROOT(&mm->mm_map_tree)) != NULL)
     {
+      RB_REMOVE(mm_map_tree_s, &mm->mm_map_tree, entry);
+
       /* Pass null as group argument to indicate that actual MMU mappings
        * must not be touched. The process is being deleted and we don't
        * know in which context we are. Only kernel memory allocations
@@ -191,7 +299,7 @@ void mm_map_destroy(FAR struct mm_map_s *mm)
  * Name: mm_map_add
  *
  * Description:
- *   Add a mapping to task group's mm_map list
+ *   Add a mapping to task group's mm_map tree
  *
  ****************************************************************************/
 
@@ -205,7 +313,7 @@ int mm_map_add(FAR struct mm_map_s *mm, FAR struct mm_map_entry_s *entry)
       return -EINVAL;
     }
 
-  /* Copy the provided mapping and add to the list */
+  /* Copy the provided mapping and add to the tree */
 
   new_entry = kmm_malloc(sizeof(struct mm_map_entry_s));
   if (!new_entry)
@@ -223,7 +331,9 @@ int mm_map_add(FAR struct mm_map_s *mm, FAR struct mm_map_entry_s *entry)
     }
 
   mm->map_count++;
-  sq_addfirst((sq_entry_t *)new_entry, &mm->mm_map_sq);
+  new_entry->end_max = (uintptr_t)new_entry->vaddr + new_entry->length;
+  RB_INSERT(mm_map_tree_s, &mm->mm_map_tree, new_entry);
+  mm_map_augment_path(new_entry);
   nxrmutex_unlock(&mm->mm_map_mutex);
 
   return OK;
@@ -233,7 +343,7 @@ int mm_map_add(FAR struct mm_map_s *mm, FAR struct mm_map_entry_s *entry)
  * Name: mm_map_next
  *
  * Description:
- *   Returns the next mapping in the list.
+ *   Returns the next mapping in address order.
  *
  ****************************************************************************/
 
@@ -246,12 +356,12 @@ FAR struct mm_map_entry_s *mm_map_next(FAR struct mm_map_s *mm,
     {
       if (entry == NULL)
         {
-          next_entry = (struct mm_map_entry_s *)sq_peek(&mm->mm_map_sq);
+          next_entry = RB_MIN(mm_map_tree_s, &mm->mm_map_tree);
         }
       else
         {
-          next_entry = (struct mm_map_entry_s *)
-            sq_next(((sq_entry_t *)entry));
+          next_entry = RB_NEXT(mm_map_tree_s, &mm->mm_map_tree,
+                               (FAR struct mm_map_entry_s *)entry);
         }
 
       nxrmutex_unlock(&mm->mm_map_mutex);
@@ -264,7 +374,7 @@ FAR struct mm_map_entry_s *mm_map_next(FAR struct mm_map_s *mm,
  * Name: mm_map_find
  *
  * Description:
- *   Find the first mapping containing the range from the task group's list
+ *   Find the first mapping containing the range from the task group's tree
  *
  ****************************************************************************/
 
@@ -276,14 +386,18 @@ FAR struct mm_map_entry_s *mm_map_find(FAR struct mm_map_s *mm,
 
   if (nxrmutex_lock(&mm->mm_map_mutex) == OK)
     {
-      found_entry = (struct mm_map_entry_s *)sq_peek(&mm->mm_map_sq);
+      /* The lookups of a range mostly hit the same mapping in a row */
 
-      while (found_entry && !in_range(vaddr, length,
-                                      found_entry->vaddr,
-                                      found_entry->length))
+      found_entry = mm->mm_map_hint;
+      if (found_entry == NULL ||
+          !in_range(vaddr, length, found_entry->vaddr, found_entry->length))
         {
-          found_entry = (struct mm_map_entry_s *)
-            sq_next(((sq_entry_t *)found_entry));
+          found_entry = mm_map_search(RB_ROOT(&mm->mm_map_tree),
+                                      vaddr, length);
+          if (found_entry != NULL)
+            {
+              mm->mm_map_hint = found_entry;
+            }
         }
 
       nxrmutex_unlock(&mm->mm_map_mutex);
@@ -296,15 +410,15 @@ FAR struct mm_map_entry_s *mm_map_find(FAR struct mm_map_s *mm,
  * Name: mm_map_remove
  *
  * Description:
- *   Remove a mapping from the task  group's list
+ *   Remove a mapping from the task  group's tree
  *
  ****************************************************************************/
 
 int mm_map_remove(FAR struct mm_map_s *mm,
                   FAR struct mm_map_entry_s *entry)
 {
-  FAR struct mm_map_entry_s *prev_entry;
-  FAR struct mm_map_entry_s *removed_entry = NULL;
+  FAR struct mm_map_entry_s *parent;
+  FAR struct mm_map_entry_s *removed_entry;
   int ret;
 
   if (!mm || !entry)
@@ -318,39 +432,17 @@ int mm_map_remove(FAR struct mm_map_s *mm,
       return ret;
     }
 
-  prev_entry = (struct mm_map_entry_s *)sq_peek(&mm->mm_map_sq);
-
-  /* Check if the list was empty */
-
-  if (!prev_entry)
-    {
-      nxrmutex_unlock(&mm->mm_map_mutex);
-      return -ENOENT;
-    }
-
-  /* Check if removing the first item */
-
-  if (entry == prev_entry)
+  removed_entry = RB_FIND(mm_map_tree_s, &mm->mm_map_tree, entry);
+  if (removed_entry)
     {
-      sq_remfirst(&mm->mm_map_sq);
+      parent = RB_PARENT(removed_entry, node);
+      RB_REMOVE(mm_map_tree_s, &mm->mm_map_tree, removed_entry);
+      mm_map_augment_path(parent);
       mm->map_count--;
-      removed_entry = prev_entry;
-    }
-  else
-    {
-      /* Loop through the remaining items to find the one to be removed */
 
-      while ((removed_entry = (struct mm_map_entry_s *)
-              sq_next(((sq_entry_t *)prev_entry))))
+      if (mm->mm_map_hint == removed_entry)
         {
-          if (entry == removed_entry)
-            {
-              sq_remafter((sq_entry_t *)prev_entry, &mm->mm_map_sq);
-              mm->map_count--;
-              break;
-            }
-
-          prev_entry = removed_entry;
+          mm->mm_map_hint = NULL;
         }
     }
 
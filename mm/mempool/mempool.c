@@ -28,6 +28,7 @@
 #include <execinfo.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <syslog.h>
 
 #include <nuttx/kmalloc.h>
@@ -40,6 +41,12 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* The number of blocks moved at once between a per-CPU cache and the pool */
+
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+#define MEMPOOL_MAGAZINE_BATCH ((CONFIG_MM_MEMPOOL_MAGAZINE + 1) / 2)
+#endif
+
 #if CONFIG_MM_BACKTRACE >= 0
 #define MEMPOOL_MAGIC_FREE  0xAAAAAAAA
 #define MEMPOOL_MAGIC_ALLOC 0x55555555
@@ -98,6 +105,129 @@ static inline void mempool_add_queue(FAR struct mempool_s *pool,
     }
 }
 
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+/****************************************************************************
+ * Name: mempool_magazine_drain
+ *
+ * Description:
+ *   Return the 'nblks' least recently freed blocks of a per-CPU cache to
+ *   the pool.
+ *
+ ****************************************************************************/
+
+static void mempool_magazine_drain(FAR struct mempool_s *pool,
+                                   FAR struct mempool_magazine_s *mag,
+                                   size_t nblks)
+{
+  irqstate_t flags;
+  size_t i;
+
+  flags = spin_lock_irqsave(&pool->lock);
+  for (i = 0; i < nblks; i++)
+    {
+      sq_addlast((FAR sq_entry_t *)mag->blocks[i], &pool->queue);
+    }
+
+  pool->nalloc -= nblks;
+  spin_unlock_irqrestore(&pool->lock, flags);
+
+  mag->count -= nblks;
+  memmove(mag->blocks, mag->blocks + nblks,
+          mag->count * sizeof(mag->blocks[0]));
+}
+
+/****************************************************************************
+ * Name: mempool_magazine_get
+ *
+ * Description:
+ *   Take a block from the cache of the current CPU, refilling the cache
+ *   from the pool if it is empty.  The blocks in the caches are free blocks
+ *   for the users of the pool, but they are counted in nalloc.  Called with
+ *   the local interrupts disabled.
+ *
+ ****************************************************************************/
+
+static FAR sq_entry_t *mempool_magazine_get(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_magazine_s *mag = &pool->magazine[this_cpu()];
+  FAR sq_entry_t *blk;
+  irqstate_t flags;
+
+  if (mag->count == 0)
+    {
+      flags = spin_lock_irqsave(&pool->lock);
+      while (mag->count < MEMPOOL_MAGAZINE_BATCH)
+        {
+          blk = mempool_remove_queue(pool, &pool->queue);
+          if (blk == NULL)
+            {
+              break;
+            }
+
+          mag->blocks[mag->count++] = blk;
+        }
+
+      pool->nalloc += mag->count;
+      spin_unlock_irqrestore(&pool->lock, flags);
+
+      /* If the pool is empty, the caller takes the path that expands it */
+
+      if (mag->count == 0)
+        {
+          return NULL;
+        }
+    }
+
+  return mag->blocks[--mag->count];
+}
+
+/****************************************************************************
+ * Name: mempool_magazine_put
+ *
+ * Description:
+ *   Put a free block in the cache of the current CPU, draining half of the
+ *   cache to the pool if it is full.  Called with the local interrupts
+ *   disabled.
+ *
+ ****************************************************************************/
+
+static void mempool_magazine_put(FAR struct mempool_s *pool, FAR void *blk)
+{
+  FAR struct mempool_magazine_s *mag = &pool->magazine[this_cpu()];
+
+  if (mag->count == CONFIG_MM_MEMPOOL_MAGAZINE)
+    {
+      mempool_magazine_drain(pool, mag, MEMPOOL_MAGAZINE_BATCH);
+    }
+
+  mag->blocks[mag->count++] = blk;
+}
+
+/****************************************************************************
+ * Name: mempool_magazine_count
+ *
+ * Description:
+ *   Return the number of blocks in the caches of all CPUs.
+ *
+ ****************************************************************************/
+
+static size_t mempool_magazine_count(FAR struct mempool_s *pool)
+{
+  size_t count = 0;
+  int cpu;
+
+  if (pool->magazine != NULL)
+    {
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          count += pool->magazine[cpu].count;
+        }
+    }
+
+  return count;
+}
+#endif
+
 #if CONFIG_MM_BACKTRACE >= 0
 static inline void mempool_add_backtrace(FAR struct mempool_s *pool,
                                          FAR struct mempool_backtrace_s *buf)
@@ -258,6 +388,9 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
   sq_init(&pool->iqueue);
   sq_init(&pool->equeue);
   pool->nalloc = 0;
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+  pool->magazine = NULL;
+#endif
   if (pool->interruptsize >= blocksize)
     {
       size_t ninterrupt = pool->interruptsize / blocksize;
@@ -320,6 +453,40 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
   return 0;
 }
 
+/****************************************************************************
+ * Name: mempool_magazine_init
+ *
+ * Description:
+ *   Enable the per-CPU caches of free blocks of an initialized memory pool.
+ *
+ * Input Parameters:
+ *   pool     - Address of the memory pool to be used.
+ *   magazine - The storage of the caches, one per CPU.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+int mempool_magazine_init(FAR struct mempool_s *pool,
+                          FAR struct mempool_magazine_s *magazine)
+{
+  /* A waiter would not see the blocks in the caches, and the blocks of the
+   * interrupt reserve must go back to it.
+   */
+
+  if ((pool->wait && pool->expandsize == 0) || pool->ibase != NULL)
+    {
+      return -EINVAL;
+    }
+
+  memset(magazine, 0, CONFIG_SMP_NCPUS * sizeof(*magazine));
+  pool->magazine = magazine;
+  return 0;
+}
+#endif
+
 /****************************************************************************
  * Name: mempool_allocate
  *
@@ -342,6 +509,19 @@ FAR void *mempool_allocate(FAR struct mempool_s *pool)
   FAR sq_entry_t *blk;
   irqstate_t flags;
 
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+  if (pool->magazine != NULL)
+    {
+      flags = up_irq_save();
+      blk = mempool_magazine_get(pool);
+      up_irq_restore(flags);
+      if (blk != NULL)
+        {
+          goto out;
+        }
+    }
+#endif
+
 retry:
   flags = spin_lock_irqsave(&pool->lock);
   blk = mempool_remove_queue(pool, &pool->queue);
@@ -395,6 +575,10 @@ retry:
 
   pool->nalloc++;
   spin_unlock_irqrestore(&pool->lock, flags);
+
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+out:
+#endif
   blk = kasan_unpoison(blk, pool->blocksize);
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
   memset(blk, MM_ALLOC_MAGIC, pool->blocksize);
@@ -420,11 +604,34 @@ retry:
 
 void mempool_release(FAR struct mempool_s *pool, FAR void *blk)
 {
-  irqstate_t flags = spin_lock_irqsave(&pool->lock);
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
+  irqstate_t flags;
 #if CONFIG_MM_BACKTRACE >= 0
   FAR struct mempool_backtrace_s *buf =
     (FAR struct mempool_backtrace_s *)((FAR char *)blk + pool->blocksize);
+#endif
+
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+  if (pool->magazine != NULL)
+    {
+#  if CONFIG_MM_BACKTRACE >= 0
+      DEBUGASSERT(buf->magic == MEMPOOL_MAGIC_ALLOC);
+      buf->magic = MEMPOOL_MAGIC_FREE;
+#  endif
+#  ifdef CONFIG_MM_FILL_ALLOCATIONS
+      memset(blk, MM_FREE_MAGIC, pool->blocksize);
+#  endif
+
+      kasan_poison(blk, pool->blocksize);
+      flags = up_irq_save();
+      mempool_magazine_put(pool, blk);
+      up_irq_restore(flags);
+      return;
+    }
+#endif
+
+  flags = spin_lock_irqsave(&pool->lock);
+#if CONFIG_MM_BACKTRACE >= 0
 
   /* Check double free or out of out of bounds */
 
@@ -470,6 +677,129 @@ void mempool_release(FAR struct mempool_s *pool, FAR void *blk)
     }
 }
 
+/****************************************************************************
+ * Name: mempool_reclaim
+ *
+ * Description:
+ *   Give the expansions of a memory pool whose blocks are all free back to
+ *   the allocator of the pool.
+ *
+ * Input Parameters:
+ *   pool - Address of the memory pool to be used.
+ *
+ * Returned Value:
+ *   The number of bytes given back.
+ *
+ ****************************************************************************/
+
+size_t mempool_reclaim(FAR struct mempool_s *pool)
+{
+  size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
+  FAR sq_entry_t *prev = NULL;
+  FAR sq_entry_t *entry;
+  FAR sq_entry_t *blkprev;
+  FAR sq_entry_t *blk;
+  FAR sq_entry_t *next;
+  irqstate_t flags;
+  size_t released = 0;
+  size_t nexpand;
+  size_t nfree;
+  size_t size;
+  FAR char *base;
+
+  if (pool->expandsize < blocksize + sizeof(sq_entry_t))
+    {
+      return 0;
+    }
+
+  nexpand = (pool->expandsize - sizeof(sq_entry_t)) / blocksize;
+  size    = nexpand * blocksize + sizeof(sq_entry_t);
+
+  flags = spin_lock_irqsave(&pool->lock);
+
+  /* The initial memory of the pool is kept until mempool_deinit() */
+
+  entry = sq_peek(&pool->equeue);
+  if (entry != NULL && pool->initialsize >= blocksize + sizeof(sq_entry_t))
+    {
+      prev  = entry;
+      entry = sq_next(entry);
+    }
+
+  while (entry != NULL)
+    {
+      /* The entry of an expansion follows its blocks.  The expansion can
+       * only be given back if all of its blocks are in the free queue.
+       */
+
+      base  = (FAR char *)entry - nexpand * blocksize;
+      nfree = 0;
+
+      sq_for_every(&pool->queue, blk)
+        {
+          if ((FAR char *)blk >= base && (FAR char *)blk < (FAR char *)entry)
+            {
+              nfree++;
+            }
+        }
+
+      if (nfree < nexpand)
+        {
+          prev  = entry;
+          entry = sq_next(entry);
+          continue;
+        }
+
+      /* Unlink the blocks of the expansion and the expansion itself */
+
+      blkprev = NULL;
+      for (blk = sq_peek(&pool->queue); blk != NULL; blk = next)
+        {
+          next = sq_next(blk);
+          if ((FAR char *)blk >= base && (FAR char *)blk < (FAR char *)entry)
+            {
+              if (blkprev != NULL)
+                {
+                  sq_remafter(blkprev, &pool->queue);
+                }
+              else
+                {
+                  sq_remfirst(&pool->queue);
+                }
+            }
+          else
+            {
+              blkprev = blk;
+            }
+        }
+
+      if (prev != NULL)
+        {
+          sq_remafter(prev, &pool->equeue);
+        }
+      else
+        {
+          sq_remfirst(&pool->equeue);
+        }
+
+      /* Free the memory without holding the lock.  The expansions are only
+       * appended meanwhile, so 'prev' stays valid.
+       */
+
+      spin_unlock_irqrestore(&pool->lock, flags);
+
+      base = kasan_unpoison(base, size);
+      pool->free(pool, base);
+      released += size;
+
+      flags = spin_lock_irqsave(&pool->lock);
+      entry = prev != NULL ? sq_next(prev) : sq_peek(&pool->equeue);
+    }
+
+  spin_unlock_irqrestore(&pool->lock, flags);
+  return released;
+}
+
 /****************************************************************************
  * Name: mempool_info
  *
@@ -495,8 +825,16 @@ int mempool_info(FAR struct mempool_s *pool, FAR struct mempoolinfo_s *info)
   info->ordblks = sq_count(&pool->queue);
   info->iordblks = sq_count(&pool->iqueue);
   info->aordblks = pool->nalloc;
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+  info->cordblks = mempool_magazine_count(pool);
+  info->aordblks -= info->cordblks;
+  info->arena = sq_count(&pool->equeue) * sizeof(sq_entry_t) +
+    (info->aordblks + info->ordblks + info->iordblks + info->cordblks) *
+    blocksize;
+#else
   info->arena = sq_count(&pool->equeue) * sizeof(sq_entry_t) +
     (info->aordblks + info->ordblks + info->iordblks) * blocksize;
+#endif
   spin_unlock_irqrestore(&pool->lock, flags);
   info->sizeblks = blocksize;
   if (pool->wait && pool->expandsize == 0)
@@ -535,13 +873,21 @@ mempool_info_task(FAR struct mempool_s *pool,
                      sq_count(&pool->iqueue);
 
       spin_unlock_irqrestore(&pool->lock, flags);
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+      count += mempool_magazine_count(pool);
+#endif
       info.aordblks += count;
       info.uordblks += count * blocksize;
     }
   else if (task->pid == PID_MM_ALLOC)
     {
-      info.aordblks += pool->nalloc;
-      info.uordblks += pool->nalloc * blocksize;
+      size_t count = pool->nalloc;
+
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+      count -= mempool_magazine_count(pool);
+#endif
+      info.aordblks += count;
+      info.uordblks += count * blocksize;
     }
 #if CONFIG_MM_BACKTRACE >= 0
   else
@@ -609,12 +955,30 @@ int mempool_deinit(FAR struct mempool_s *pool)
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
   FAR sq_entry_t *blk;
   size_t count = 0;
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+  int cpu;
+
+  /* Give the cached blocks back to the pool first */
+
+  if (pool->magazine != NULL)
+    {
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          mempool_magazine_drain(pool, &pool->magazine[cpu],
+                                 pool->magazine[cpu].count);
+        }
+    }
+#endif
 
   if (pool->nalloc != 0)
     {
       return -EBUSY;
     }
 
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+  pool->magazine = NULL;
+#endif
+
   if (pool->initialsize >= blocksize + sizeof(sq_entry_t))
     {
       count = (pool->initialsize - sizeof(sq_entry_t)) / blocksize;
@@ -25,6 +25,7 @@
  ****************************************************************************/
 
 #include <assert.h>
+#include <stdint.h>
 #include <strings.h>
 #include <syslog.h>
 #include <sys/param.h>
@@ -35,6 +36,19 @@
 #include <nuttx/mm/mempool.h>
 #include <nuttx/mm/kasan.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The size of the per-CPU caches of 'npools' pools */
+
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+#  define MEMPOOL_MAGAZINE_SIZE(npools) \
+     ((npools) * CONFIG_SMP_NCPUS * sizeof(struct mempool_magazine_s))
+#else
+#  define MEMPOOL_MAGAZINE_SIZE(npools) 0
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -90,6 +104,7 @@ struct mempool_multiple_s
   sq_queue_t                    chunk_queue;
   size_t                        chunk_size;
   size_t                        dict_used;
+  size_t                        dict_free;   /* The first entry given back */
   size_t                        dict_col_num_log2;
   size_t                        dict_row_num;
   FAR struct mpool_dict_s     **dict;
@@ -206,6 +221,7 @@ mempool_multiple_free_chunk(FAR struct mempool_multiple_s *mpool,
 
   if (mpool->chunk_size < mpool->expandsize)
     {
+      mpool->alloced -= mpool->alloc_size(mpool->arg, ptr);
       mpool->free(mpool->arg, ptr);
       return;
     }
@@ -219,6 +235,7 @@ mempool_multiple_free_chunk(FAR struct mempool_multiple_s *mpool,
           if (--chunk->used == 0)
             {
               sq_rem(&chunk->entry, &mpool->chunk_queue);
+              mpool->alloced -= mpool->alloc_size(mpool->arg, chunk->start);
               mpool->free(mpool->arg, chunk->start);
             }
 
@@ -234,6 +251,7 @@ static FAR void *mempool_multiple_alloc_callback(FAR struct mempool_s *pool,
 {
   FAR struct mempool_multiple_s *mpool = pool->priv;
   FAR void *ret;
+  size_t index;
   size_t row;
   size_t col;
 
@@ -246,26 +264,43 @@ static FAR void *mempool_multiple_alloc_callback(FAR struct mempool_s *pool,
       return NULL;
     }
 
-  row = mpool->dict_used >> mpool->dict_col_num_log2;
+  /* Reuse the entry of an expansion that was given back if there is one.
+   * The size of a free entry holds the index of the next free entry.
+   */
 
-  /* There is no new pointer address to store the dictionaries */
+  if (mpool->dict_free != SIZE_MAX)
+    {
+      index = mpool->dict_free;
+      row = index >> mpool->dict_col_num_log2;
+      col = index - (row << mpool->dict_col_num_log2);
+      mpool->dict_free = mpool->dict[row][col].size;
+    }
+  else
+    {
+      index = mpool->dict_used;
+      row = index >> mpool->dict_col_num_log2;
 
-  DEBUGASSERT(mpool->dict_row_num > row);
+      /* There is no new pointer address to store the dictionaries */
 
-  col = mpool->dict_used - (row << mpool->dict_col_num_log2);
+      DEBUGASSERT(mpool->dict_row_num > row);
 
-  if (mpool->dict[row] == NULL)
-    {
-      mpool->dict[row] =
-        mempool_multiple_alloc_chunk(mpool, sizeof(uintptr_t),
-                                     (1 << mpool->dict_col_num_log2)
-                                     * sizeof(struct mpool_dict_s));
+      col = index - (row << mpool->dict_col_num_log2);
+
+      if (mpool->dict[row] == NULL)
+        {
+          mpool->dict[row] =
+            mempool_multiple_alloc_chunk(mpool, sizeof(uintptr_t),
+                                         (1 << mpool->dict_col_num_log2)
+                                         * sizeof(struct mpool_dict_s));
+        }
+
+      mpool->dict_used++;
     }
 
   mpool->dict[row][col].pool = pool;
   mpool->dict[row][col].addr = ret;
   mpool->dict[row][col].size = mpool->minpoolsize + size;
-  *(FAR size_t *)ret = mpool->dict_used++;
+  *(FAR size_t *)ret = index;
   nxrmutex_unlock(&mpool->lock);
   return (FAR char *)ret + mpool->minpoolsize;
 }
@@ -274,9 +309,23 @@ static void mempool_multiple_free_callback(FAR struct mempool_s *pool,
                                            FAR void *addr)
 {
   FAR struct mempool_multiple_s *mpool = pool->priv;
+  FAR char *base = (FAR char *)addr - mpool->minpoolsize;
+  size_t index = *(FAR size_t *)base;
+  size_t row = index >> mpool->dict_col_num_log2;
+  size_t col = index - (row << mpool->dict_col_num_log2);
+
+  /* Put the dictionary entry on the free list, so that the expansion can
+   * not be found any more and the entry is reused.
+   */
 
-  mempool_multiple_free_chunk(mpool,
-                              (FAR char *)addr - mpool->minpoolsize);
+  nxrmutex_lock(&mpool->lock);
+  mpool->dict[row][col].pool = NULL;
+  mpool->dict[row][col].addr = NULL;
+  mpool->dict[row][col].size = mpool->dict_free;
+  mpool->dict_free = index;
+
+  mempool_multiple_free_chunk(mpool, base);
+  nxrmutex_unlock(&mpool->lock);
 }
 
 /****************************************************************************
@@ -430,7 +479,8 @@ mempool_multiple_init(FAR const char *name,
 
   mpool = alloc(arg, sizeof(uintptr_t),
                 sizeof(struct mempool_multiple_s) +
-                npools * sizeof(struct mempool_s));
+                npools * sizeof(struct mempool_s) +
+                MEMPOOL_MAGAZINE_SIZE(npools));
 
   if (mpool == NULL)
     {
@@ -459,6 +509,7 @@ mempool_multiple_init(FAR const char *name,
       pools[i].expandsize = expandsize - mpool->minpoolsize;
       pools[i].initialsize = 0;
       pools[i].interruptsize = 0;
+      pools[i].wait = false;
       pools[i].priv = mpool;
       pools[i].alloc = mempool_multiple_alloc_callback;
       pools[i].free = mempool_multiple_free_callback;
@@ -470,6 +521,14 @@ mempool_multiple_init(FAR const char *name,
           goto err_with_pools;
         }
 
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+      /* The magazines of the pools follow the pool array */
+
+      mempool_magazine_init(pools + i,
+                            (FAR struct mempool_magazine_s *)
+                            (pools + npools) + i * CONFIG_SMP_NCPUS);
+#endif
+
       if (i + 1 != npools)
         {
           size_t delta = poolsize[i + 1] - poolsize[i];
@@ -486,6 +545,7 @@ mempool_multiple_init(FAR const char *name,
     }
 
   mpool->dict_used = 0;
+  mpool->dict_free = SIZE_MAX;
   mpool->dict_col_num_log2 = fls(dict_expendsize /
                                  sizeof(struct mpool_dict_s));
 
@@ -724,6 +784,37 @@ FAR void *mempool_multiple_memalign(FAR struct mempool_multiple_s *mpool,
   return NULL;
 }
 
+/****************************************************************************
+ * Name: mempool_multiple_reclaim
+ *
+ * Description:
+ *   Give the free expansions of all pools of a multiple memory pool back to
+ *   its allocator.
+ *
+ ****************************************************************************/
+
+size_t mempool_multiple_reclaim(FAR struct mempool_multiple_s *mpool)
+{
+  size_t released = 0;
+  size_t i;
+
+  if (mpool == NULL)
+    {
+      return 0;
+    }
+
+  /* The lock serializes the reclaims of the pools */
+
+  nxrmutex_lock(&mpool->lock);
+  for (i = 0; i < mpool->npools; i++)
+    {
+      released += mempool_reclaim(mpool->pools + i);
+    }
+
+  nxrmutex_unlock(&mpool->lock);
+  return released;
+}
+
 /****************************************************************************
  * Name: mempool_multiple_foreach
  ****************************************************************************/
@@ -98,6 +98,14 @@ static GRAN_HANDLE g_pgalloc;
 
 void mm_pginitialize(FAR void *heap_start, size_t heap_size)
 {
+#ifdef CONFIG_MM_HUGEPAGE
+  /* The huge pages are set aside at the end of the region */
+
+  heap_size = mm_pghuge_initialize((uintptr_t)heap_start,
+                                   (uintptr_t)heap_start + heap_size) -
+              (uintptr_t)heap_start;
+#endif
+
   g_pgalloc = gran_initialize(heap_start, heap_size, MM_PGSHIFT, MM_PGSHIFT);
   DEBUGASSERT(g_pgalloc != NULL);
 }
@@ -150,6 +158,27 @@ uintptr_t mm_pgalloc(unsigned int npages)
   return (uintptr_t)gran_alloc(g_pgalloc, (size_t)npages << MM_PGSHIFT);
 }
 
+/****************************************************************************
+ * Name: mm_pgalloc_contig
+ *
+ * Description:
+ *   Allocate a large physically contiguous buffer, e.g. for DMA.  The
+ *   granule allocator always returns contiguous pages.
+ *
+ * Input Parameters:
+ *   npages - The number of pages to allocate, each of size CONFIG_MM_PGSIZE.
+ *
+ * Returned Value:
+ *   On success, a non-zero, physical address of the allocated page memory
+ *   is returned.  Zero is returned on failure.
+ *
+ ****************************************************************************/
+
+uintptr_t mm_pgalloc_contig(unsigned int npages)
+{
+  return mm_pgalloc(npages);
+}
+
 /****************************************************************************
  * Name: mm_pgfree
  *
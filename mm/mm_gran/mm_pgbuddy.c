@@ -0,0 +1,615 @@
+/****************************************************************************
+ * mm/mm_gran/mm_pgbuddy.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+#include <stdint.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/pgalloc.h>
+#include <nuttx/spinlock.h>
+
+#if defined(CONFIG_MM_PGALLOC) && defined(CONFIG_MM_PGALLOC_BUDDY)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The pages are managed in blocks of 2^order pages, each aligned to its
+ * size from the start of the zone.  The free blocks of each order are kept
+ * in a list, so an allocation splits the smallest free block that is large
+ * enough and a free merges a block with its free buddy, both in at most
+ * CONFIG_MM_PGALLOC_MAXORDER steps.
+ */
+
+#define PGBUDDY_NORDERS   (CONFIG_MM_PGALLOC_MAXORDER + 1)
+#define PGBUDDY_NONE      UINT16_MAX /* No page, ends a free list */
+#define PGBUDDY_USED      UINT8_MAX  /* The page does not begin a free block */
+
+/* Debug */
+
+#ifdef CONFIG_DEBUG_PGALLOC
+#  define pgaerr                    _err
+#  define pgawarn                   _warn
+#  define pgainfo                   _info
+#else
+#  define pgaerr                    merr
+#  define pgawarn                   mwarn
+#  define pgainfo                   minfo
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of one page.  The links are only used by the first page of a
+ * free block.
+ */
+
+struct pgbuddy_page_s
+{
+  uint16_t next;   /* The next free block of the same order */
+  uint16_t prev;   /* The previous free block of the same order */
+  uint8_t  order;  /* The order of the free block, or PGBUDDY_USED */
+};
+
+/* The state of one zone of pages */
+
+struct pgbuddy_zone_s
+{
+  uintptr_t                  start;    /* The address of the first page */
+  uint16_t                   npages;   /* The number of pages */
+  uint16_t                   nfree;    /* The number of free pages */
+  spinlock_t                 lock;     /* For exclusive access to the zone */
+  FAR struct pgbuddy_page_s *pages;    /* The state of each page */
+  uint16_t freelist[PGBUDDY_NORDERS];  /* The free blocks of each order */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The pages of the page allocator */
+
+static struct pgbuddy_zone_s g_pgzone;
+
+/* The pages that are only used by mm_pgalloc_contig(), so that the large
+ * contiguous buffers can always be allocated however fragmented the other
+ * pages are.
+ */
+
+#if CONFIG_MM_PGALLOC_CMA_NPAGES > 0
+static struct pgbuddy_zone_s g_pgcma;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pgbuddy_add
+ *
+ * Description:
+ *   Add the free block of 2^order pages at page 'ndx' to its free list.
+ *
+ ****************************************************************************/
+
+static void pgbuddy_add(FAR struct pgbuddy_zone_s *zone, unsigned int ndx,
+                        unsigned int order)
+{
+  FAR struct pgbuddy_page_s *page = &zone->pages[ndx];
+  uint16_t head = zone->freelist[order];
+
+  page->order = order;
+  page->prev  = PGBUDDY_NONE;
+  page->next  = head;
+  if (head != PGBUDDY_NONE)
+    {
+      zone->pages[head].prev = ndx;
+    }
+
+  zone->freelist[order] = ndx;
+}
+
+/****************************************************************************
+ * Name: pgbuddy_del
+ *
+ * Description:
+ *   Remove the free block at page 'ndx' from its free list.
+ *
+ ****************************************************************************/
+
+static void pgbuddy_del(FAR struct pgbuddy_zone_s *zone, unsigned int ndx)
+{
+  FAR struct pgbuddy_page_s *page = &zone->pages[ndx];
+
+  DEBUGASSERT(page->order < PGBUDDY_NORDERS);
+
+  if (page->prev != PGBUDDY_NONE)
+    {
+      zone->pages[page->prev].next = page->next;
+    }
+  else
+    {
+      zone->freelist[page->order] = page->next;
+    }
+
+  if (page->next != PGBUDDY_NONE)
+    {
+      zone->pages[page->next].prev = page->prev;
+    }
+
+  page->order = PGBUDDY_USED;
+}
+
+/****************************************************************************
+ * Name: pgbuddy_free
+ *
+ * Description:
+ *   Free the block of 2^order pages at page 'ndx', merging it with its
+ *   buddies as long as they are free.
+ *
+ ****************************************************************************/
+
+static void pgbuddy_free(FAR struct pgbuddy_zone_s *zone, unsigned int ndx,
+                         unsigned int order)
+{
+  unsigned int buddy;
+
+  while (order < CONFIG_MM_PGALLOC_MAXORDER)
+    {
+      buddy = ndx ^ (1u << order);
+      if (buddy + (1u << order) > zone->npages ||
+          zone->pages[buddy].order != order)
+        {
+          break;
+        }
+
+      pgbuddy_del(zone, buddy);
+      ndx &= ~(1u << order);
+      order++;
+    }
+
+  pgbuddy_add(zone, ndx, order);
+}
+
+/****************************************************************************
+ * Name: pgbuddy_freerange
+ *
+ * Description:
+ *   Free 'npages' pages from page 'ndx', as the largest aligned blocks that
+ *   the range holds.
+ *
+ ****************************************************************************/
+
+static void pgbuddy_freerange(FAR struct pgbuddy_zone_s *zone,
+                              unsigned int ndx, unsigned int npages)
+{
+  unsigned int order;
+
+  zone->nfree += npages;
+  while (npages > 0)
+    {
+      for (order = CONFIG_MM_PGALLOC_MAXORDER;
+           (ndx & ((1u << order) - 1)) != 0 || (1u << order) > npages;
+           order--);
+
+      pgbuddy_free(zone, ndx, order);
+      ndx    += 1u << order;
+      npages -= 1u << order;
+    }
+}
+
+/****************************************************************************
+ * Name: pgbuddy_alloc
+ *
+ * Description:
+ *   Allocate 'npages' contiguous pages from a zone.  The smallest free
+ *   block that holds them is split, and the pages beyond 'npages' are
+ *   freed again.
+ *
+ * Returned Value:
+ *   The address of the first page, or zero if there is no free block large
+ *   enough.
+ *
+ ****************************************************************************/
+
+static uintptr_t pgbuddy_alloc(FAR struct pgbuddy_zone_s *zone,
+                               unsigned int npages)
+{
+  irqstate_t flags;
+  unsigned int order;
+  unsigned int o;
+  unsigned int ndx;
+
+  if (zone->pages == NULL || npages == 0)
+    {
+      return 0;
+    }
+
+  for (order = 0; (1u << order) < npages; order++)
+    {
+      if (order == CONFIG_MM_PGALLOC_MAXORDER)
+        {
+          pgaerr("ERROR: %u pages is more than the maximum order\n",
+                 npages);
+          return 0;
+        }
+    }
+
+  flags = spin_lock_irqsave(&zone->lock);
+
+  for (o = order; o < PGBUDDY_NORDERS; o++)
+    {
+      if (zone->freelist[o] != PGBUDDY_NONE)
+        {
+          break;
+        }
+    }
+
+  if (o == PGBUDDY_NORDERS)
+    {
+      spin_unlock_irqrestore(&zone->lock, flags);
+      return 0;
+    }
+
+  ndx = zone->freelist[o];
+  pgbuddy_del(zone, ndx);
+  zone->nfree -= 1u << o;
+
+  /* Return the upper halves to the free lists until the block has the
+   * requested order, then free the pages that were not requested.
+   */
+
+  while (o > order)
+    {
+      o--;
+      pgbuddy_add(zone, ndx + (1u << o), o);
+      zone->nfree += 1u << o;
+    }
+
+  if ((1u << order) > npages)
+    {
+      pgbuddy_freerange(zone, ndx + npages, (1u << order) - npages);
+    }
+
+  spin_unlock_irqrestore(&zone->lock, flags);
+  return zone->start + ((uintptr_t)ndx << MM_PGSHIFT);
+}
+
+/****************************************************************************
+ * Name: pgbuddy_take
+ *
+ * Description:
+ *   Take the free page 'ndx' out of the free block that holds it.
+ *
+ ****************************************************************************/
+
+static void pgbuddy_take(FAR struct pgbuddy_zone_s *zone, unsigned int ndx)
+{
+  unsigned int order;
+  unsigned int head;
+
+  for (order = 0; order < PGBUDDY_NORDERS; order++)
+    {
+      head = ndx & ~((1u << order) - 1);
+      if (zone->pages[head].order == order)
+        {
+          break;
+        }
+    }
+
+  if (order == PGBUDDY_NORDERS)
+    {
+      return; /* The page is already allocated */
+    }
+
+  /* Split the block, keeping the halves without the page free */
+
+  pgbuddy_del(zone, head);
+  while (order > 0)
+    {
+      order--;
+      if (ndx & (1u << order))
+        {
+          pgbuddy_add(zone, head, order);
+          head += 1u << order;
+        }
+      else
+        {
+          pgbuddy_add(zone, head + (1u << order), order);
+        }
+    }
+
+  zone->nfree--;
+}
+
+/****************************************************************************
+ * Name: pgbuddy_initialize
+ ****************************************************************************/
+
+static void pgbuddy_initialize(FAR struct pgbuddy_zone_s *zone,
+                               uintptr_t start, size_t npages)
+{
+  unsigned int i;
+
+  DEBUGASSERT(npages > 0 && npages < PGBUDDY_NONE);
+
+  zone->pages = kmm_malloc(npages * sizeof(struct pgbuddy_page_s));
+  DEBUGASSERT(zone->pages != NULL);
+
+  zone->start  = start;
+  zone->npages = npages;
+  zone->nfree  = 0;
+  spin_lock_init(&zone->lock);
+
+  for (i = 0; i < PGBUDDY_NORDERS; i++)
+    {
+      zone->freelist[i] = PGBUDDY_NONE;
+    }
+
+  for (i = 0; i < npages; i++)
+    {
+      zone->pages[i].order = PGBUDDY_USED;
+    }
+
+  pgbuddy_freerange(zone, 0, npages);
+}
+
+/****************************************************************************
+ * Name: pgbuddy_zone
+ *
+ * Description:
+ *   Return the zone that holds the page at 'paddr'.
+ *
+ ****************************************************************************/
+
+static FAR struct pgbuddy_zone_s *pgbuddy_zone(uintptr_t paddr)
+{
+#if CONFIG_MM_PGALLOC_CMA_NPAGES > 0
+  if (paddr >= g_pgcma.start &&
+      paddr < g_pgcma.start + ((uintptr_t)g_pgcma.npages << MM_PGSHIFT))
+    {
+      return &g_pgcma;
+    }
+#endif
+
+  DEBUGASSERT(paddr >= g_pgzone.start &&
+              paddr < g_pgzone.start +
+                      ((uintptr_t)g_pgzone.npages << MM_PGSHIFT));
+  return &g_pgzone;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_pginitialize
+ *
+ * Description:
+ *   Initialize the page allocator.  The last CONFIG_MM_PGALLOC_CMA_NPAGES
+ *   pages of the region are set aside for mm_pgalloc_contig(), below the
+ *   huge pages of CONFIG_MM_HUGEPAGE.
+ *
+ * Input Parameters:
+ *   heap_start - The physical address of the start of memory region that
+ *                will be used for the page allocator heap
+ *   heap_size  - The size (in bytes) of the memory region that will be used
+ *                for the page allocator heap.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_pginitialize(FAR void *heap_start, size_t heap_size)
+{
+  uintptr_t start = MM_PGALIGNUP(heap_start);
+  uintptr_t end   = MM_PGALIGNDOWN((uintptr_t)heap_start + heap_size);
+  size_t npages;
+
+#ifdef CONFIG_MM_HUGEPAGE
+  /* The huge pages are set aside at the end of the region */
+
+  end = mm_pghuge_initialize(start, end);
+#endif
+
+  npages = (end - start) >> MM_PGSHIFT;
+
+#if CONFIG_MM_PGALLOC_CMA_NPAGES > 0
+  DEBUGASSERT(npages > CONFIG_MM_PGALLOC_CMA_NPAGES);
+
+  npages -= CONFIG_MM_PGALLOC_CMA_NPAGES;
+  pgbuddy_initialize(&g_pgcma, start + ((uintptr_t)npages << MM_PGSHIFT),
+                     CONFIG_MM_PGALLOC_CMA_NPAGES);
+#endif
+
+  pgbuddy_initialize(&g_pgzone, start, npages);
+}
+
+/****************************************************************************
+ * Name: mm_pgreserve
+ *
+ * Description:
+ *   Reserve memory in the page memory pool.  This will reserve the pages
+ *   that contain the start and end addresses plus all of the pages
+ *   in between.  This should be done early in the initialization sequence
+ *   before any other allocations are made.
+ *
+ *   Reserved memory can never be allocated (it can be freed however which
+ *   essentially unreserves the memory).
+ *
+ * Input Parameters:
+ *   start  - The address of the beginning of the region to be reserved.
+ *   size   - The size of the region to be reserved
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_pgreserve(uintptr_t start, size_t size)
+{
+  FAR struct pgbuddy_zone_s *zone;
+  uintptr_t paddr = MM_PGALIGNDOWN(start);
+  uintptr_t end   = MM_PGALIGNUP(start + size);
+  irqstate_t flags;
+
+  for (; paddr < end; paddr += MM_PGSIZE)
+    {
+      zone  = pgbuddy_zone(paddr);
+      flags = spin_lock_irqsave(&zone->lock);
+      pgbuddy_take(zone, (paddr - zone->start) >> MM_PGSHIFT);
+      spin_unlock_irqrestore(&zone->lock, flags);
+    }
+}
+
+/****************************************************************************
+ * Name: mm_pgalloc
+ *
+ * Description:
+ *   Allocate page memory from the page memory pool.
+ *
+ * Input Parameters:
+ *   npages - The number of pages to allocate, each of size CONFIG_MM_PGSIZE.
+ *
+ * Returned Value:
+ *   On success, a non-zero, physical address of the allocated page memory
+ *   is returned.  Zero is returned on failure.  NOTE:  This is an unmapped
+ *   physical address and cannot be used until it is appropriately mapped.
+ *
+ ****************************************************************************/
+
+uintptr_t mm_pgalloc(unsigned int npages)
+{
+  return pgbuddy_alloc(&g_pgzone, npages);
+}
+
+/****************************************************************************
+ * Name: mm_pgalloc_contig
+ *
+ * Description:
+ *   Allocate a large physically contiguous buffer, e.g. for DMA.  The pages
+ *   set aside for these buffers are used first.
+ *
+ * Input Parameters:
+ *   npages - The number of pages to allocate, each of size CONFIG_MM_PGSIZE.
+ *
+ * Returned Value:
+ *   On success, a non-zero, physical address of the allocated page memory
+ *   is returned.  Zero is returned on failure.
+ *
+ ****************************************************************************/
+
+uintptr_t mm_pgalloc_contig(unsigned int npages)
+{
+  uintptr_t paddr = 0;
+
+#if CONFIG_MM_PGALLOC_CMA_NPAGES > 0
+  paddr = pgbuddy_alloc(&g_pgcma, npages);
+#endif
+
+  if (paddr == 0)
+    {
+      paddr = pgbuddy_alloc(&g_pgzone, npages);
+    }
+
+  return paddr;
+}
+
+/****************************************************************************
+ * Name: mm_pgfree
+ *
+ * Description:
+ *   Return page memory to the page memory pool.
+ *
+ * Input Parameters:
+ *   paddr  - A physical address to a page in the page memory pool previously
+ *            allocated by mm_pgalloc.
+ *   npages - The number of contiguous pages to be return to the page memory
+ *            pool, beginning with the page at paddr;
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_pgfree(uintptr_t paddr, unsigned int npages)
+{
+  FAR struct pgbuddy_zone_s *zone = pgbuddy_zone(paddr);
+  irqstate_t flags;
+
+  DEBUGASSERT(MM_ISALIGNED(paddr));
+
+  flags = spin_lock_irqsave(&zone->lock);
+  pgbuddy_freerange(zone, (paddr - zone->start) >> MM_PGSHIFT, npages);
+  spin_unlock_irqrestore(&zone->lock, flags);
+}
+
+/****************************************************************************
+ * Name: mm_pginfo
+ *
+ * Description:
+ *   Return information about the page allocator.
+ *
+ * Input Parameters:
+ *   info   - Memory location to return the page allocator info.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_pginfo(FAR struct pginfo_s *info)
+{
+  FAR struct pgbuddy_zone_s *zone = &g_pgzone;
+  irqstate_t flags;
+  int order;
+
+  DEBUGASSERT(info != NULL);
+
+  flags = spin_lock_irqsave(&zone->lock);
+
+  info->ntotal = zone->npages;
+  info->nfree  = zone->nfree;
+  info->mxfree = 0;
+
+  for (order = CONFIG_MM_PGALLOC_MAXORDER; order >= 0; order--)
+    {
+      if (zone->freelist[order] != PGBUDDY_NONE)
+        {
+          info->mxfree = 1u << order;
+          break;
+        }
+    }
+
+  spin_unlock_irqrestore(&zone->lock, flags);
+}
+
+#endif /* CONFIG_MM_PGALLOC && CONFIG_MM_PGALLOC_BUDDY */
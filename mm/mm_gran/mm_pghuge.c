@@ -0,0 +1,164 @@
+/****************************************************************************
+ * mm/mm_gran/mm_pghuge.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+#include <stdint.h>
+#include <strings.h>
+
+#include <nuttx/pgalloc.h>
+#include <nuttx/spinlock.h>
+
+#ifdef CONFIG_MM_HUGEPAGE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PGHUGE_NPAGES     CONFIG_MM_HUGEPAGE_NPAGES
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The pool of huge pages.  A huge page is taken from the pool whole, so a
+ * bit for each huge page is enough.
+ */
+
+struct pghuge_pool_s
+{
+  uintptr_t  start;   /* The address of the first huge page */
+  uint32_t   free;    /* A bit for each free huge page */
+  spinlock_t lock;    /* For exclusive access to the pool */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct pghuge_pool_s g_pghuge;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_pghuge_initialize
+ *
+ * Description:
+ *   Set aside the pool of huge pages at the end of the region of the page
+ *   allocator, called by mm_pginitialize().
+ *
+ * Input Parameters:
+ *   start - The physical address of the start of the region
+ *   end   - The physical address of the end of the region
+ *
+ * Returned Value:
+ *   The new end of the region, below the pool of huge pages.
+ *
+ ****************************************************************************/
+
+uintptr_t mm_pghuge_initialize(uintptr_t start, uintptr_t end)
+{
+  uintptr_t pool = MM_HUGEPGALIGNDOWN(end) -
+                   ((uintptr_t)PGHUGE_NPAGES << MM_HUGEPGSHIFT);
+
+  if (pool <= start || pool > end)
+    {
+      merr("ERROR: No room for %d huge pages\n", PGHUGE_NPAGES);
+      return end;
+    }
+
+  spin_lock_init(&g_pghuge.lock);
+  g_pghuge.start = pool;
+  g_pghuge.free  = UINT32_MAX >> (32 - PGHUGE_NPAGES);
+  return pool;
+}
+
+/****************************************************************************
+ * Name: mm_pgalloc_huge
+ *
+ * Description:
+ *   Allocate a huge page of MM_HUGEPGSIZE bytes, aligned to its size, from
+ *   the pool of CONFIG_MM_HUGEPAGE_NPAGES huge pages.
+ *
+ * Returned Value:
+ *   On success, a non-zero, physical address of the huge page is returned.
+ *   Zero is returned if the pool is empty.
+ *
+ ****************************************************************************/
+
+uintptr_t mm_pgalloc_huge(void)
+{
+  irqstate_t flags;
+  int ndx;
+
+  flags = spin_lock_irqsave(&g_pghuge.lock);
+
+  ndx = ffs(g_pghuge.free);
+  if (ndx == 0)
+    {
+      spin_unlock_irqrestore(&g_pghuge.lock, flags);
+      return 0;
+    }
+
+  ndx--;
+  g_pghuge.free &= ~(1u << ndx);
+
+  spin_unlock_irqrestore(&g_pghuge.lock, flags);
+  return g_pghuge.start + ((uintptr_t)ndx << MM_HUGEPGSHIFT);
+}
+
+/****************************************************************************
+ * Name: mm_pgfree_huge
+ *
+ * Description:
+ *   Return a huge page allocated by mm_pgalloc_huge() to its pool.
+ *
+ * Input Parameters:
+ *   paddr - The physical address of the huge page.
+ *
+ ****************************************************************************/
+
+void mm_pgfree_huge(uintptr_t paddr)
+{
+  irqstate_t flags;
+  unsigned int ndx;
+
+  DEBUGASSERT(paddr >= g_pghuge.start && (paddr & MM_HUGEPGMASK) == 0);
+
+  ndx = (paddr - g_pghuge.start) >> MM_HUGEPGSHIFT;
+  DEBUGASSERT(ndx < PGHUGE_NPAGES);
+
+  flags = spin_lock_irqsave(&g_pghuge.lock);
+  DEBUGASSERT((g_pghuge.free & (1u << ndx)) == 0);
+  g_pghuge.free |= 1u << ndx;
+  spin_unlock_irqrestore(&g_pghuge.lock, flags);
+}
+
+#endif /* CONFIG_MM_HUGEPAGE */
@@ -149,6 +149,23 @@
 
 #define MM_ALLOCNODE_OVERHEAD (MM_SIZEOF_ALLOCNODE - sizeof(mmsize_t))
 
+/* The per-CPU cache of freed chunks holds the chunks of the allocations up
+ * to MM_TCACHE_MAXSIZE bytes, one list for each chunk size.  It needs to
+ * disable the interrupts, so it is only available to the kernel.
+ */
+
+#if CONFIG_MM_HEAP_TCACHE_SIZE > 0
+#  define MM_TCACHE_MAXSIZE  256
+#  define MM_TCACHE_MAXCHUNK MM_ALIGN_UP(MM_TCACHE_MAXSIZE + \
+                                         MM_ALLOCNODE_OVERHEAD)
+#  define MM_TCACHE_NBINS    ((MM_TCACHE_MAXCHUNK - MM_MIN_CHUNK) / \
+                              MM_ALIGN + 1)
+#  define MM_TCACHE_NDX(s)   (((s) - MM_MIN_CHUNK) / MM_ALIGN)
+#  if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+#    define MM_HAVE_TCACHE
+#  endif
+#endif
+
 /* Get the node size */
 
 #define MM_SIZEOF_NODE(node) ((node)->size & (~MM_MASK_BIT))
@@ -217,6 +234,16 @@ struct mm_delaynode_s
   FAR struct mm_delaynode_s *flink;
 };
 
+/* This describes the cache of freed chunks of one CPU */
+
+#if CONFIG_MM_HEAP_TCACHE_SIZE > 0
+struct mm_tcache_s
+{
+  FAR struct mm_delaynode_s *bins[MM_TCACHE_NBINS]; /* Chunks by size */
+  size_t size;                                      /* Total chunk size */
+};
+#endif
+
 /* This describes one heap (possibly with multiple regions) */
 
 struct mm_heap_s
@@ -253,6 +280,15 @@ struct mm_heap_s
 
   struct mm_freenode_s mm_nodelist[MM_NNODES];
 
+  /* The number and the total size of the free nodes of each nodelist, and
+   * the last free node, which is the largest one:  They are kept up to date
+   * by mm_addfreechunk() and mm_delfreechunk() for mm_fraginfo().
+   */
+
+  size_t mm_nfree[MM_NNODES];
+  size_t mm_freesize[MM_NNODES];
+  FAR struct mm_freenode_s *mm_freetail;
+
   /* Free delay list, as sometimes we can't do free immdiately. */
 
   FAR struct mm_delaynode_s *mm_delaylist[CONFIG_SMP_NCPUS];
@@ -261,6 +297,12 @@ struct mm_heap_s
   size_t mm_delaycount[CONFIG_SMP_NCPUS];
 #endif
 
+  /* Freed chunks kept for reuse without taking the heap mutex */
+
+#if CONFIG_MM_HEAP_TCACHE_SIZE > 0
+  struct mm_tcache_s mm_tcache[CONFIG_SMP_NCPUS];
+#endif
+
   /* The is a multiple mempool of the heap */
 
 #ifdef CONFIG_MM_HEAP_MEMPOOL
@@ -301,6 +343,14 @@ void mm_foreach(FAR struct mm_heap_s *heap, mm_node_handler_t handler,
 
 void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay);
 
+/* Functions contained in mm_tcache.c ***************************************/
+
+#ifdef MM_HAVE_TCACHE
+FAR void *mm_tcache_alloc(FAR struct mm_heap_s *heap, size_t size);
+bool mm_tcache_free(FAR struct mm_heap_s *heap, FAR void *mem);
+bool mm_tcache_flush(FAR struct mm_heap_s *heap);
+#endif
+
 /****************************************************************************
  * Inline Functions
  ****************************************************************************/
@@ -351,6 +401,39 @@ static inline_function void mm_addfreechunk(FAR struct mm_heap_s *heap,
 
       next->blink = node;
     }
+  else
+    {
+      heap->mm_freetail = node;
+    }
+
+  heap->mm_nfree[ndx]++;
+  heap->mm_freesize[ndx] += nodesize;
+}
+
+static inline_function void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                                            FAR struct mm_freenode_s *node)
+{
+  size_t nodesize = MM_SIZEOF_NODE(node);
+  int ndx = mm_size2ndx(nodesize);
+
+  DEBUGASSERT(MM_NODE_IS_FREE(node));
+  DEBUGASSERT(heap->mm_nfree[ndx] > 0);
+
+  /* There must be a predecessor, but there may not be a successor node */
+
+  DEBUGASSERT(node->blink);
+  node->blink->flink = node->flink;
+  if (node->flink)
+    {
+      node->flink->blink = node->blink;
+    }
+  else
+    {
+      heap->mm_freetail = node->blink;
+    }
+
+  heap->mm_nfree[ndx]--;
+  heap->mm_freesize[ndx] -= nodesize;
 }
 
 #endif /* __MM_MM_HEAP_MM_H */
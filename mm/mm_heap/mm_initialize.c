@@ -265,6 +265,8 @@ FAR struct mm_heap_s *mm_initialize(FAR const char *name,
       heap->mm_nodelist[i].blink     = &heap->mm_nodelist[i - 1];
     }
 
+  heap->mm_freetail = &heap->mm_nodelist[MM_NNODES - 1];
+
   /* Initialize the malloc mutex to one (to support one-at-
    * a-time access to private data sets).
    */
@@ -28,6 +28,8 @@
 
 #include <assert.h>
 #include <debug.h>
+#include <string.h>
+#include <sys/param.h>
 
 #include <nuttx/mm/mm.h>
 
@@ -204,8 +206,12 @@ size_t mm_heapfree(FAR struct mm_heap_s *heap)
 size_t mm_heapfree_largest(FAR struct mm_heap_s *heap)
 {
   FAR struct mm_freenode_s *node;
-  for (node = heap->mm_nodelist[MM_NNODES - 1].blink; node;
-       node = node->blink)
+
+  /* The free list is sorted by size, the last free node is the largest
+   * one unless the last nodelist is empty.
+   */
+
+  for (node = heap->mm_freetail; node; node = node->blink)
     {
       size_t nodesize = MM_SIZEOF_NODE(node);
       if (nodesize != 0)
@@ -216,3 +222,54 @@ size_t mm_heapfree_largest(FAR struct mm_heap_s *heap)
 
   return 0;
 }
+
+/****************************************************************************
+ * Name: mm_fraginfo
+ *
+ * Description:
+ *   Return the free memory of the heap by size class, with the largest free
+ *   chunk and the fragmentation index.  This is kept up to date as chunks
+ *   are freed and allocated, so unlike mm_mallinfo() the heap is not walked.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned if the heap can not
+ *   be locked.
+ *
+ ****************************************************************************/
+
+int mm_fraginfo(FAR struct mm_heap_s *heap, FAR struct mm_fraginfo_s *info)
+{
+  int ret;
+  int ndx;
+
+  DEBUGASSERT(info);
+
+  memset(info, 0, sizeof(*info));
+
+  ret = mm_lock(heap);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (ndx = 0; ndx < MM_NNODES; ndx++)
+    {
+      int i = MIN(ndx + MM_MIN_SHIFT, MM_FRAGINFO_NCLASSES - 1);
+
+      info->count[i] += heap->mm_nfree[ndx];
+      info->bytes[i] += heap->mm_freesize[ndx];
+      info->nfree        += heap->mm_nfree[ndx];
+      info->freesize     += heap->mm_freesize[ndx];
+    }
+
+  info->largest = mm_heapfree_largest(heap);
+  mm_unlock(heap);
+
+  if (info->freesize > 0)
+    {
+      info->fragindex = 1000 - (uint64_t)info->largest * 1000 /
+                               info->freesize;
+    }
+
+  return OK;
+}
@@ -32,6 +32,7 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/mm/mm.h>
+#include <nuttx/mm/heapprof.h>
 #include <nuttx/mm/kasan.h>
 #include <nuttx/sched.h>
 #include <nuttx/sched_note.h>
@@ -153,9 +154,36 @@ void mm_free_delaylist(FAR struct mm_heap_s *heap)
   if (heap)
     {
        free_delaylist(heap, true);
+#ifdef MM_HAVE_TCACHE
+       mm_tcache_flush(heap);
+#endif
     }
 }
 
+/****************************************************************************
+ * Name: mm_reclaim
+ *
+ * Description:
+ *   Give the expansions of the memory pools of this heap that have no
+ *   block in use back to the heap.
+ *
+ * Returned Value:
+ *   The number of bytes given back.
+ *
+ ****************************************************************************/
+
+size_t mm_reclaim(FAR struct mm_heap_s *heap)
+{
+#ifdef CONFIG_MM_HEAP_MEMPOOL
+  if (heap)
+    {
+      return mempool_multiple_reclaim(heap->mm_mpool);
+    }
+#endif
+
+  return 0;
+}
+
 /****************************************************************************
  * Name: mm_malloc
  *
@@ -185,6 +213,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       ret = mempool_multiple_alloc(heap->mm_mpool, size);
       if (ret != NULL)
         {
+          heapprof_alloc(ret, size);
           return ret;
         }
     }
@@ -210,6 +239,17 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
   DEBUGASSERT(alignsize >= MM_ALIGN);
 
+#ifdef MM_HAVE_TCACHE
+  /* Reuse a chunk freed on this CPU without taking the MM mutex */
+
+  ret = mm_tcache_alloc(heap, alignsize);
+  if (ret != NULL)
+    {
+      heapprof_alloc(ret, size);
+      return ret;
+    }
+#endif
+
   /* We need to hold the MM mutex while we muck with the nodelist. */
 
   DEBUGVERIFY(mm_lock(heap));
@@ -244,16 +284,9 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       FAR struct mm_freenode_s *next;
       size_t remaining;
 
-      /* Remove the node.  There must be a predecessor, but there may not be
-       * a successor node.
-       */
+      /* Remove the node from the nodelist */
 
-      DEBUGASSERT(node->blink);
-      node->blink->flink = node->flink;
-      if (node->flink)
-        {
-          node->flink->blink = node->blink;
-        }
+      mm_delfreechunk(heap, node);
 
       /* Get a pointer to the next node in physical memory */
 
@@ -334,6 +367,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
     {
       MM_ADD_BACKTRACE(heap, node);
       ret = kasan_unpoison(ret, nodesize - MM_ALLOCNODE_OVERHEAD);
+      heapprof_alloc(ret, size);
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
       memset(ret, MM_ALLOC_MAGIC, alignsize - MM_ALLOCNODE_OVERHEAD);
 #endif
@@ -351,6 +385,24 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
     }
 #endif
 
+#ifdef MM_HAVE_TCACHE
+  /* Try again after freeing the cached chunks of this CPU */
+
+  else if (mm_tcache_flush(heap))
+    {
+      return mm_malloc(heap, size);
+    }
+#endif
+
+#ifdef CONFIG_MM_HEAP_MEMPOOL_RECLAIM
+  /* Try again after giving the free pool expansions back */
+
+  else if (!up_interrupt_context() && mm_reclaim(heap) > 0)
+    {
+      return mm_malloc(heap, size);
+    }
+#endif
+
 #ifdef CONFIG_DEBUG_MM
   else if (MM_INTERNAL_HEAP(heap))
     {
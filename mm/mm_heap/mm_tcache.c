@@ -0,0 +1,213 @@
+/****************************************************************************
+ * mm/mm_heap/mm_tcache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <malloc.h>
+#include <string.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/mm/mm.h>
+#include <nuttx/mm/kasan.h>
+#include <nuttx/sched.h>
+#include <nuttx/sched_note.h>
+
+#include "mm_heap/mm.h"
+
+#ifdef MM_HAVE_TCACHE
+
+/* The cached chunks stay allocated for the heap:  They are still counted
+ * in mm_curused and their nodes keep the allocated bit, so that the heap
+ * needs no change to reuse them.  Only the CPU that owns a cache uses it,
+ * with its interrupts disabled.
+ */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_tcache_alloc
+ *
+ * Description:
+ *   Take a chunk of 'size' bytes, allocation node included, from the cache
+ *   of this CPU.
+ *
+ * Returned Value:
+ *   The memory of the chunk, or NULL if there is no chunk of this size.
+ *
+ ****************************************************************************/
+
+FAR void *mm_tcache_alloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_tcache_s *tcache;
+  FAR struct mm_delaynode_s *mem;
+  FAR struct mm_allocnode_s *node;
+  irqstate_t flags;
+
+  if (size > MM_TCACHE_MAXCHUNK)
+    {
+      return NULL;
+    }
+
+  flags  = up_irq_save();
+  tcache = &heap->mm_tcache[this_cpu()];
+  mem    = tcache->bins[MM_TCACHE_NDX(size)];
+  if (mem != NULL)
+    {
+      tcache->bins[MM_TCACHE_NDX(size)] = mem->flink;
+      tcache->size -= size;
+    }
+
+  up_irq_restore(flags);
+
+  if (mem == NULL)
+    {
+      return NULL;
+    }
+
+  node = (FAR struct mm_allocnode_s *)
+         ((FAR char *)mem - MM_SIZEOF_ALLOCNODE);
+  DEBUGASSERT(MM_NODE_IS_ALLOC(node) && MM_SIZEOF_NODE(node) == size);
+
+  MM_ADD_BACKTRACE(heap, node);
+  sched_note_heap(NOTE_HEAP_ALLOC, heap, mem, size, heap->mm_curused);
+
+  mem = kasan_unpoison(mem, size - MM_ALLOCNODE_OVERHEAD);
+#ifdef CONFIG_MM_FILL_ALLOCATIONS
+  memset(mem, MM_ALLOC_MAGIC, size - MM_ALLOCNODE_OVERHEAD);
+#endif
+
+  return mem;
+}
+
+/****************************************************************************
+ * Name: mm_tcache_free
+ *
+ * Description:
+ *   Keep a freed chunk in the cache of this CPU, if it is small enough and
+ *   the cache is not full.
+ *
+ * Returned Value:
+ *   true if the chunk is cached, false if it has to be freed to the heap.
+ *
+ ****************************************************************************/
+
+bool mm_tcache_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_tcache_s *tcache;
+  FAR struct mm_delaynode_s *tmp;
+  FAR struct mm_allocnode_s *node;
+  irqstate_t flags;
+  size_t nodesize;
+
+  tmp  = kasan_reset_tag(mem);
+  node = (FAR struct mm_allocnode_s *)
+         ((FAR char *)tmp - MM_SIZEOF_ALLOCNODE);
+  nodesize = MM_SIZEOF_NODE(node);
+  if (nodesize > MM_TCACHE_MAXCHUNK)
+    {
+      return false;
+    }
+
+  /* Sanity check against double-frees */
+
+  DEBUGASSERT(MM_NODE_IS_ALLOC(node));
+
+  flags  = up_irq_save();
+  tcache = &heap->mm_tcache[this_cpu()];
+  if (tcache->size + nodesize > CONFIG_MM_HEAP_TCACHE_SIZE)
+    {
+      up_irq_restore(flags);
+      return false;
+    }
+
+#ifdef CONFIG_MM_FILL_ALLOCATIONS
+  memset(tmp, MM_FREE_MAGIC, nodesize - MM_ALLOCNODE_OVERHEAD);
+#endif
+
+  kasan_poison(mem, nodesize - MM_ALLOCNODE_OVERHEAD);
+
+#if CONFIG_MM_BACKTRACE >= 0
+  /* The chunk belongs to the allocator until it is reused */
+
+  node->pid = PID_MM_MEMPOOL;
+#endif
+
+  tmp->flink = tcache->bins[MM_TCACHE_NDX(nodesize)];
+  tcache->bins[MM_TCACHE_NDX(nodesize)] = tmp;
+  tcache->size += nodesize;
+
+  up_irq_restore(flags);
+
+  sched_note_heap(NOTE_HEAP_FREE, heap, mem, nodesize, heap->mm_curused);
+  return true;
+}
+
+/****************************************************************************
+ * Name: mm_tcache_flush
+ *
+ * Description:
+ *   Free the chunks in the cache of this CPU to the heap.
+ *
+ * Returned Value:
+ *   true if there were chunks in the cache.
+ *
+ ****************************************************************************/
+
+bool mm_tcache_flush(FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_delaynode_s *bins[MM_TCACHE_NBINS];
+  FAR struct mm_tcache_s *tcache;
+  FAR struct mm_delaynode_s *tmp;
+  irqstate_t flags;
+  bool ret;
+  int i;
+
+  /* Move the cache to local */
+
+  flags  = up_irq_save();
+  tcache = &heap->mm_tcache[this_cpu()];
+  ret    = tcache->size > 0;
+  memcpy(bins, tcache->bins, sizeof(bins));
+  memset(tcache->bins, 0, sizeof(tcache->bins));
+  tcache->size = 0;
+  up_irq_restore(flags);
+
+  for (i = 0; ret && i < MM_TCACHE_NBINS; i++)
+    {
+      while ((tmp = bins[i]) != NULL)
+        {
+          bins[i] = tmp->flink;
+          mm_delayfree(heap, tmp, false);
+        }
+    }
+
+  return ret;
+}
+
+#endif /* MM_HAVE_TCACHE */
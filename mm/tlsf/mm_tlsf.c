@@ -40,6 +40,7 @@
 #include <nuttx/fs/procfs.h>
 #include <nuttx/mutex.h>
 #include <nuttx/mm/mm.h>
+#include <nuttx/mm/heapprof.h>
 #include <nuttx/mm/kasan.h>
 #include <nuttx/mm/mempool.h>
 #include <nuttx/sched_note.h>
@@ -875,6 +876,7 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
     }
 
   DEBUGASSERT(mm_heapmember(heap, mem));
+  heapprof_free(mem);
 
 #ifdef CONFIG_MM_HEAP_MEMPOOL
   if (heap->mm_mpool)
@@ -1317,6 +1319,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       ret = mempool_multiple_alloc(heap->mm_mpool, size);
       if (ret != NULL)
         {
+          heapprof_alloc(ret, size);
           return ret;
         }
     }
@@ -1360,6 +1363,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 #endif
 
       ret = kasan_unpoison(ret, nodesize);
+      heapprof_alloc(ret, size);
 
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
       memset(ret, MM_ALLOC_MAGIC, nodesize);
@@ -1375,6 +1379,15 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
     }
 #endif
 
+#ifdef CONFIG_MM_HEAP_MEMPOOL_RECLAIM
+  /* Try again after giving the free pool expansions back */
+
+  else if (!up_interrupt_context() && mm_reclaim(heap) > 0)
+    {
+      return mm_malloc(heap, size);
+    }
+#endif
+
   return ret;
 }
 
@@ -1403,6 +1416,7 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
       ret = mempool_multiple_memalign(heap->mm_mpool, alignment, size);
       if (ret != NULL)
         {
+          heapprof_alloc(ret, size);
           return ret;
         }
     }
@@ -1445,6 +1459,7 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
       memdump_backtrace(heap, buf);
 #endif
       ret = kasan_unpoison(ret, nodesize);
+      heapprof_alloc(ret, size);
     }
 
 #if CONFIG_MM_FREE_DELAYCOUNT_MAX > 0
@@ -1513,6 +1528,8 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
       newmem = mempool_multiple_realloc(heap->mm_mpool, oldmem, size);
       if (newmem != NULL)
         {
+          heapprof_free(oldmem);
+          heapprof_alloc(newmem, size);
           return newmem;
         }
       else if (size <= heap->mm_threshold ||
@@ -1581,6 +1598,8 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
       FAR struct memdump_backtrace_s *buf = newmem + newsize;
       memdump_backtrace(heap, buf);
 #endif
+      heapprof_free(oldmem);
+      heapprof_alloc(newmem, size);
     }
 
 #if CONFIG_MM_FREE_DELAYCOUNT_MAX > 0
@@ -1671,6 +1690,30 @@ void mm_free_delaylist(FAR struct mm_heap_s *heap)
     }
 }
 
+/****************************************************************************
+ * Name: mm_reclaim
+ *
+ * Description:
+ *   Give the expansions of the memory pools of this heap that have no
+ *   block in use back to the heap.
+ *
+ * Returned Value:
+ *   The number of bytes given back.
+ *
+ ****************************************************************************/
+
+size_t mm_reclaim(FAR struct mm_heap_s *heap)
+{
+#ifdef CONFIG_MM_HEAP_MEMPOOL
+  if (heap)
+    {
+      return mempool_multiple_reclaim(heap->mm_mpool);
+    }
+#endif
+
+  return 0;
+}
+
 /****************************************************************************
  * Name: mm_heapfree
  *
@@ -1694,5 +1737,63 @@ size_t mm_heapfree(FAR struct mm_heap_s *heap)
 
 size_t mm_heapfree_largest(FAR struct mm_heap_s *heap)
 {
-  return SIZE_MAX;
+  size_t largest;
+
+  if (mm_lock(heap) < 0)
+    {
+      return SIZE_MAX;
+    }
+
+  largest = tlsf_free_largest(heap->mm_tlsf);
+  mm_unlock(heap);
+  return largest;
+}
+
+/****************************************************************************
+ * Name: mm_fraginfo
+ *
+ * Description:
+ *   Return the free memory of the heap by size class, with the largest free
+ *   chunk and the fragmentation index.  tlsf keeps the free blocks counted
+ *   by size class, so unlike mm_mallinfo() the heap is not walked.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned if the heap can not
+ *   be locked.
+ *
+ ****************************************************************************/
+
+int mm_fraginfo(FAR struct mm_heap_s *heap, FAR struct mm_fraginfo_s *info)
+{
+  int ret;
+  int i;
+
+  DEBUGASSERT(info);
+
+  memset(info, 0, sizeof(*info));
+
+  ret = mm_lock(heap);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  tlsf_free_stat(heap->mm_tlsf, info->count, info->bytes,
+                 MM_FRAGINFO_NCLASSES);
+  info->largest = tlsf_free_largest(heap->mm_tlsf);
+  mm_unlock(heap);
+
+  for (i = 0; i < MM_FRAGINFO_NCLASSES; i++)
+    {
+      info->nfree    += info->count[i];
+      info->freesize += info->bytes[i];
+    }
+
+  if (info->freesize > 0)
+    {
+      info->fragindex = 1000 - (uint64_t)info->largest * 1000 /
+                               info->freesize;
+    }
+
+  return OK;
 }
@@ -45,7 +45,9 @@
 #include <netinet/arp.h>
 #include <netinet/in.h>
 
+#include <nuttx/hashtable.h>
 #include <nuttx/net/netdev.h>
+#include <nuttx/queue.h>
 #include <nuttx/semaphore.h>
 
 #include "devif/devif.h"
@@ -77,6 +79,17 @@
 
 #define RASIZE         4  /* Size of ROUTER ALERT */
 
+/* The states of the ARP table entries.  A free entry is in the free list,
+ * the others are in the LRU list and in the hash table.  An entry is
+ * FAILED if the last ARP request for its address got no reply: It is kept
+ * as a negative cache so that the senders fail at once.  Both FAILED and
+ * REACHABLE entries expire CONFIG_NET_ARP_MAXAGE after their last update.
+ */
+
+#define ARP_STATE_FREE      0
+#define ARP_STATE_FAILED    1
+#define ARP_STATE_REACHABLE 2
+
 /* Allocate a new ARP data callback */
 
 #define arp_callback_alloc(dev)   devif_callback_alloc(dev, \
@@ -161,9 +174,14 @@ struct arp_notify_s
 
 struct arp_entry_s
 {
+  dq_entry_t               at_lnode;    /* In the LRU or the free list */
+#if CONFIG_NET_ARP_HASH_BITS > 0
+  hash_node_t              at_hnode;    /* In a bucket of the hash table */
+#endif
   in_addr_t                at_ipaddr;   /* IP address */
   struct ether_addr        at_ethaddr;  /* Hardware address */
-  clock_t                  at_time;     /* Time of last usage */
+  uint8_t                  at_state;    /* See ARP_STATE_* */
+  clock_t                  at_time;     /* Time of last update */
   FAR struct net_driver_s *at_dev;      /* The device driver structure */
 };
 
@@ -516,6 +534,8 @@ void arp_hdr_update(FAR struct net_driver_s *dev, FAR uint16_t *pipaddr,
  *
  * Input Parameters:
  *   snapshot  - Location to return the ARP table copy
+ *   skip      - The number of valid entries to skip, to continue a snapshot
+ *               taken in several parts
  *   nentries  - The size of the user provided 'dest' in entries, each of
  *               size sizeof(struct arp_entry_s)
  *
@@ -529,10 +549,10 @@ void arp_hdr_update(FAR struct net_driver_s *dev, FAR uint16_t *pipaddr,
  ****************************************************************************/
 
 #ifdef CONFIG_NETLINK_ROUTE
-unsigned int arp_snapshot(FAR struct arpreq *snapshot,
+unsigned int arp_snapshot(FAR struct arpreq *snapshot, unsigned int skip,
                           unsigned int nentries);
 #else
-#  define arp_snapshot(s,n) (0)
+#  define arp_snapshot(s,k,n) (0)
 #endif
 
 /****************************************************************************
@@ -625,7 +645,7 @@ void arp_acd_setup(FAR struct net_driver_s *dev);
 #  define arp_cleanup(d)
 #  define arp_update(d,i,m);
 #  define arp_hdr_update(d,i,m);
-#  define arp_snapshot(s,n) (0)
+#  define arp_snapshot(s,k,n) (0)
 #  define arp_dump(arp)
 
 #endif /* CONFIG_NET_ARP */
@@ -56,6 +56,7 @@
 #include <net/ethernet.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -87,9 +88,23 @@ struct arp_table_info_s
  * Private Data
  ****************************************************************************/
 
-/* The table of known address mappings */
+/* The table of known address mappings:  The entries in use are in the LRU
+ * list, the most recently used first, and in the hash table by IP address.
+ * The entries are taken from the static table, or allocated in batches, as
+ * the table grows.
+ */
 
+#if CONFIG_NET_ARP_ALLOC_ENTRIES == 0
 static struct arp_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
+#endif
+
+static dq_queue_t g_arp_lru;
+static dq_queue_t g_arp_free;
+static unsigned int g_arp_nentries;
+
+#if CONFIG_NET_ARP_HASH_BITS > 0
+static DECLARE_HASHTABLE(g_arp_hash, CONFIG_NET_ARP_HASH_BITS);
+#endif
 
 static const struct ether_addr g_zero_ethaddr =
 {
@@ -149,32 +164,137 @@ static int arp_match(FAR struct net_driver_s *dev, FAR void *arg)
 }
 
 /****************************************************************************
- * Name: arp_return_old_entry
+ * Name: arp_hashentry and arp_lruentry
+ *
+ * Description:
+ *   Return the entry of a node of a hash bucket or of the LRU list, or NULL
+ *   at the end of the list.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_ARP_HASH_BITS > 0
+static inline FAR struct arp_entry_s *arp_hashentry(FAR hash_node_t *node)
+{
+  return node != NULL ? container_of(node, struct arp_entry_s, at_hnode) :
+                        NULL;
+}
+#endif
+
+static inline FAR struct arp_entry_s *arp_lruentry(FAR dq_entry_t *node)
+{
+  return node != NULL ? container_of(node, struct arp_entry_s, at_lnode) :
+                        NULL;
+}
+
+/* The entries that may have a given IP address:  Those of a bucket of the
+ * hash table, or all of them without the hash table.
+ */
+
+#if CONFIG_NET_ARP_HASH_BITS > 0
+#  define arp_firstkey(ipaddr) \
+     arp_hashentry(hashtable_bucket(g_arp_hash, ipaddr)->head)
+#  define arp_nextkey(tabptr)  arp_hashentry((tabptr)->at_hnode.flink)
+#else
+#  define arp_firstkey(ipaddr) arp_lruentry(dq_peek(&g_arp_lru))
+#  define arp_nextkey(tabptr)  arp_lruentry((tabptr)->at_lnode.flink)
+#endif
+
+/****************************************************************************
+ * Name: arp_alloc_entry
  *
  * Description:
- *   Compare and return the old ARP table entry.
+ *   Return a free entry, growing the table if it is not full, or NULL if
+ *   the table is full.
  *
  ****************************************************************************/
 
-static FAR struct arp_entry_s *
-arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
+static FAR struct arp_entry_s *arp_alloc_entry(void)
 {
-  if (e1->at_ipaddr == 0)
+  FAR struct arp_entry_s *tabptr;
+#if CONFIG_NET_ARP_ALLOC_ENTRIES > 0
+  unsigned int nalloc;
+  unsigned int i;
+#endif
+
+  tabptr = arp_lruentry(dq_remfirst(&g_arp_free));
+  if (tabptr != NULL || g_arp_nentries >= CONFIG_NET_ARPTAB_SIZE)
     {
-      return e1;
+      return tabptr;
     }
-  else if (e2->at_ipaddr == 0)
+
+#if CONFIG_NET_ARP_ALLOC_ENTRIES > 0
+  /* Allocate a batch of entries, the first one is returned */
+
+  nalloc = CONFIG_NET_ARPTAB_SIZE - g_arp_nentries;
+  if (nalloc > CONFIG_NET_ARP_ALLOC_ENTRIES)
     {
-      return e2;
+      nalloc = CONFIG_NET_ARP_ALLOC_ENTRIES;
     }
-  else if ((int)(e1->at_time - e2->at_time) <= 0)
+
+  tabptr = kmm_zalloc(nalloc * sizeof(struct arp_entry_s));
+  if (tabptr == NULL)
     {
-      return e1;
+      return NULL;
     }
-  else
+
+  for (i = 1; i < nalloc; i++)
     {
-      return e2;
+      dq_addlast(&tabptr[i].at_lnode, &g_arp_free);
     }
+
+  g_arp_nentries += nalloc;
+#else
+  tabptr = &g_arptable[g_arp_nentries++];
+#endif
+
+  return tabptr;
+}
+
+/****************************************************************************
+ * Name: arp_free_entry
+ *
+ * Description:
+ *   Remove an entry from the LRU list and the hash table and free it.
+ *
+ ****************************************************************************/
+
+static void arp_free_entry(FAR struct arp_entry_s *tabptr)
+{
+  dq_rem(&tabptr->at_lnode, &g_arp_lru);
+#if CONFIG_NET_ARP_HASH_BITS > 0
+  hashtable_delete(g_arp_hash, &tabptr->at_hnode, tabptr->at_ipaddr);
+#endif
+
+  tabptr->at_ipaddr = 0;
+  tabptr->at_state  = ARP_STATE_FREE;
+  tabptr->at_dev    = NULL;
+  dq_addlast(&tabptr->at_lnode, &g_arp_free);
+}
+
+/****************************************************************************
+ * Name: arp_search
+ *
+ * Description:
+ *   Find the entry of an IP address on a device, expired or not.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_entry_s *arp_search(in_addr_t ipaddr,
+                                          FAR struct net_driver_s *dev)
+{
+  FAR struct arp_entry_s *tabptr;
+
+  for (tabptr = arp_firstkey(ipaddr); tabptr != NULL;
+       tabptr = arp_nextkey(tabptr))
+    {
+      if (tabptr->at_dev == dev &&
+          net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr))
+        {
+          return tabptr;
+        }
+    }
+
+  return NULL;
 }
 
 /****************************************************************************
@@ -182,6 +302,7 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
  *
  * Description:
  *   Find the ARP entry corresponding to this IP address in the ARP table.
+ *   The entry found becomes the most recently used.
  *
  * Input Parameters:
  *   ipaddr - Refers to an IP address in network order
@@ -197,24 +318,25 @@ static FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr,
                                           FAR struct net_driver_s *dev)
 {
   FAR struct arp_entry_s *tabptr;
-  int i;
 
   /* Check if the IPv4 address is already in the ARP table. */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  tabptr = arp_search(ipaddr, dev);
+  if (tabptr == NULL ||
+      clock_systime_ticks() - tabptr->at_time > ARP_MAXAGE_TICK)
     {
-      tabptr = &g_arptable[i];
-      if (tabptr->at_dev == dev &&
-          net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr) &&
-          clock_systime_ticks() - tabptr->at_time <= ARP_MAXAGE_TICK)
-        {
-          return tabptr;
-        }
+      /* Not found, or expired */
+
+      return NULL;
     }
 
-  /* Not found */
+  if (dq_peek(&g_arp_lru) != &tabptr->at_lnode)
+    {
+      dq_rem(&tabptr->at_lnode, &g_arp_lru);
+      dq_addfirst(&tabptr->at_lnode, &g_arp_lru);
+    }
 
-  return NULL;
+  return tabptr;
 }
 
 /****************************************************************************
@@ -276,61 +398,62 @@ static void arp_get_arpreq(FAR struct arpreq *output,
 int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
                FAR const uint8_t *ethaddr)
 {
-  FAR struct arp_entry_s *tabptr = &g_arptable[0];
+  FAR struct arp_entry_s *tabptr;
 #ifdef CONFIG_NETLINK_ROUTE
   struct arpreq arp_notify;
-  bool found = false;
+  bool found = true;
   bool new_entry;
 #endif
-  int i;
+  uint8_t state = ARP_STATE_REACHABLE;
 
-  /* Walk through the ARP mapping table and try to find an entry to
-   * update. If none is found, the IP -> MAC address mapping is
-   * inserted in the ARP table.
+  if (ethaddr == NULL)
+    {
+      ethaddr = g_zero_ethaddr.ether_addr_octet;
+      state   = ARP_STATE_FAILED;
+    }
+
+  /* Find the entry to update.  If none is found, the IP -> MAC address
+   * mapping is inserted in a free entry, or replaces the least recently
+   * used one.
    */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  tabptr = arp_search(ipaddr, dev);
+  if (tabptr == NULL)
     {
-      /* Check if the source IP address of the incoming packet matches
-       * the IP address in this ARP table entry.
-       */
-
-      if (g_arptable[i].at_dev == dev &&
-          g_arptable[i].at_ipaddr != 0 &&
-          net_ipv4addr_cmp(ipaddr, g_arptable[i].at_ipaddr))
+#ifdef CONFIG_NETLINK_ROUTE
+      found  = false;
+#endif
+      tabptr = arp_alloc_entry();
+      if (tabptr == NULL)
         {
-          /* An old entry found, break. */
+          tabptr = arp_lruentry(dq_tail(&g_arp_lru));
+          if (tabptr == NULL)
+            {
+              return -ENOMEM;
+            }
+
+          /* When overwite old entry, notify old entry RTM_DELNEIGH */
 
-          tabptr = &g_arptable[i];
 #ifdef CONFIG_NETLINK_ROUTE
-          found = true;
+          arp_get_arpreq(&arp_notify, tabptr);
+          netlink_neigh_notify(&arp_notify, RTM_DELNEIGH, AF_INET);
 #endif
-          break;
-        }
-      else
-        {
-          /* Record the oldest entry. */
 
-          tabptr = arp_return_old_entry(tabptr, &g_arptable[i]);
+          arp_free_entry(tabptr);
+          tabptr = arp_alloc_entry();
         }
     }
-
-  if (ethaddr == NULL)
-    {
-      ethaddr = g_zero_ethaddr.ether_addr_octet;
-    }
-
-  /* When overwite old entry, notify old entry RTM_DELNEIGH */
-
-#ifdef CONFIG_NETLINK_ROUTE
-  if (!found && tabptr->at_ipaddr != 0)
+  else
     {
-      arp_get_arpreq(&arp_notify, tabptr);
-      netlink_neigh_notify(&arp_notify, RTM_DELNEIGH, AF_INET);
+      dq_rem(&tabptr->at_lnode, &g_arp_lru);
+#if CONFIG_NET_ARP_HASH_BITS > 0
+      hashtable_delete(g_arp_hash, &tabptr->at_hnode, ipaddr);
+#endif
     }
 
   /* Need to notify when entry is not found or changes in table */
 
+#ifdef CONFIG_NETLINK_ROUTE
   new_entry = !found || memcmp(tabptr->at_ethaddr.ether_addr_octet,
                                ethaddr, ETHER_ADDR_LEN) != 0;
 #endif
@@ -341,9 +464,15 @@ int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
 
   tabptr->at_ipaddr = ipaddr;
   memcpy(tabptr->at_ethaddr.ether_addr_octet, ethaddr, ETHER_ADDR_LEN);
+  tabptr->at_state = state;
   tabptr->at_dev = dev;
   tabptr->at_time = clock_systime_ticks();
 
+  dq_addfirst(&tabptr->at_lnode, &g_arp_lru);
+#if CONFIG_NET_ARP_HASH_BITS > 0
+  hashtable_add(g_arp_hash, &tabptr->at_hnode, ipaddr);
+#endif
+
   /* Notify the new entry */
 
 #ifdef CONFIG_NETLINK_ROUTE
@@ -423,8 +552,7 @@ int arp_find(in_addr_t ipaddr, FAR uint8_t *ethaddr,
        * error code so that the upper layer can return faster.
        */
 
-      if (memcmp(&tabptr->at_ethaddr, &g_zero_ethaddr,
-                 sizeof(tabptr->at_ethaddr)) == 0)
+      if (tabptr->at_state == ARP_STATE_FAILED)
         {
           return -ENETUNREACH;
         }
@@ -496,9 +624,9 @@ int arp_delete(in_addr_t ipaddr, FAR struct net_driver_s *dev)
       netlink_neigh_notify(&arp_notify, RTM_DELNEIGH, AF_INET);
 #endif
 
-      /* Yes.. Set the IP address to zero to "delete" it */
+      /* Yes.. Free the entry */
 
-      tabptr->at_ipaddr = 0;
+      arp_free_entry(tabptr);
       return OK;
     }
 
@@ -521,13 +649,16 @@ int arp_delete(in_addr_t ipaddr, FAR struct net_driver_s *dev)
 
 void arp_cleanup(FAR struct net_driver_s *dev)
 {
-  int i;
+  FAR dq_entry_t *node;
+  FAR dq_entry_t *next;
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  dq_for_every_safe(&g_arp_lru, node, next)
     {
-      if (dev == g_arptable[i].at_dev)
+      FAR struct arp_entry_s *tabptr = arp_lruentry(node);
+
+      if (tabptr->at_dev == dev)
         {
-          memset(&g_arptable[i], 0, sizeof(g_arptable[i]));
+          arp_free_entry(tabptr);
         }
     }
 }
@@ -540,6 +671,8 @@ void arp_cleanup(FAR struct net_driver_s *dev)
  *
  * Input Parameters:
  *   snapshot  - Location to return the ARP table copy
+ *   skip      - The number of valid entries to skip, to continue a snapshot
+ *               taken in several parts
  *   nentries  - The size of the user provided 'dest' in entries, each of
  *               size sizeof(struct arp_entry_s)
  *
@@ -553,27 +686,33 @@ void arp_cleanup(FAR struct net_driver_s *dev)
  ****************************************************************************/
 
 #ifdef CONFIG_NETLINK_ROUTE
-unsigned int arp_snapshot(FAR struct arpreq *snapshot,
+unsigned int arp_snapshot(FAR struct arpreq *snapshot, unsigned int skip,
                           unsigned int nentries)
 {
   FAR struct arp_entry_s *tabptr;
   clock_t now;
   unsigned int ncopied;
-  int i;
 
-  /* Copy all non-empty, non-expired entries in the ARP table. */
+  /* Copy all non-expired entries in the ARP table. */
 
-  for (i = 0, now = clock_systime_ticks(), ncopied = 0;
-       nentries > ncopied && i < CONFIG_NET_ARPTAB_SIZE;
-       i++)
+  for (tabptr = arp_lruentry(dq_peek(&g_arp_lru)),
+       now = clock_systime_ticks(), ncopied = 0;
+       nentries > ncopied && tabptr != NULL;
+       tabptr = arp_lruentry(tabptr->at_lnode.flink))
     {
-      tabptr = &g_arptable[i];
-      if (tabptr->at_ipaddr != 0 &&
-          now - tabptr->at_time <= ARP_MAXAGE_TICK)
+      if (now - tabptr->at_time > ARP_MAXAGE_TICK)
+        {
+          continue;
+        }
+
+      if (skip > 0)
         {
-          arp_get_arpreq(&snapshot[ncopied], tabptr);
-          ncopied++;
+          skip--;
+          continue;
         }
+
+      arp_get_arpreq(&snapshot[ncopied], tabptr);
+      ncopied++;
     }
 
   /* Return the number of entries copied into the user buffer */
@@ -31,6 +31,7 @@
 
 #include <sys/types.h>
 #include <poll.h>
+#include <stdbool.h>
 
 #include <nuttx/semaphore.h>
 #include <nuttx/can.h>
@@ -57,6 +58,13 @@
 #define can_callback_free(dev,conn,cb) \
   devif_conn_callback_free(dev, cb, &conn->sconn.list, &conn->sconn.list_tail)
 
+/* The sizes of the hashed receive filters of a connection: the number of
+ * distinct masks and the number of buckets per mask (a power of two).
+ */
+
+#define CAN_FILTER_NMASKS   4
+#define CAN_FILTER_NBUCKETS 16
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -106,6 +114,19 @@ struct can_conn_s
 #ifdef CONFIG_NET_CANPROTO_OPTIONS
   struct can_filter filters[CONFIG_NET_CAN_RAW_FILTER_MAX];
   int32_t filter_count;
+
+  /* The filters indexed by can_filter_update():  The filters that are not
+   * inverted are grouped by mask and hashed with the masked identifier in
+   * the buckets of their group, the others are tested one by one.  The
+   * indexes are those of the filters plus one, zero ends a list.
+   */
+
+  uint8_t nmasks;                    /* Number of mask groups */
+  uint8_t nlinear;                   /* Number of filters in linear */
+  canid_t masks[CAN_FILTER_NMASKS];
+  uint8_t buckets[CAN_FILTER_NMASKS][CAN_FILTER_NBUCKETS];
+  uint8_t chain[CONFIG_NET_CAN_RAW_FILTER_MAX];
+  uint8_t linear[CONFIG_NET_CAN_RAW_FILTER_MAX];
 #  ifdef CONFIG_NET_CAN_ERRORS
   can_err_mask_t err_mask;
 #  endif
@@ -420,6 +441,36 @@ int can_getsockopt(FAR struct socket *psock, int level, int option,
                    FAR void *value, FAR socklen_t *value_len);
 #endif
 
+/****************************************************************************
+ * Name: can_filter_update
+ *
+ * Description:
+ *   Index the filter_count filters of a connection after they are changed.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CANPROTO_OPTIONS
+void can_filter_update(FAR struct can_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: can_filter_match
+ *
+ * Description:
+ *   Check a CAN identifier against the receive filters of a connection.
+ *
+ * Returned Value:
+ *   True if the frame is accepted by the connection.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CANPROTO_OPTIONS
+bool can_filter_match(FAR struct can_conn_s *conn, canid_t id);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -143,11 +143,10 @@ uint16_t can_callback(FAR struct net_driver_s *dev,
           if (_SO_GETOPT(conn->sconn.s_options, SO_TIMESTAMP))
             {
               struct timeval tv;
-              FAR struct timespec *ts = (FAR struct timespec *)&tv;
               int len;
 
-              clock_systime_timespec(ts);
-              tv.tv_usec = ts->tv_nsec / 1000;
+              tv.tv_sec  = dev->d_rxtime.tv_sec;
+              tv.tv_usec = dev->d_rxtime.tv_nsec / 1000;
 
               len = iob_trycopyin(dev->d_iob, (FAR uint8_t *)&tv,
                                   sizeof(struct timeval),
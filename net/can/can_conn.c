@@ -152,6 +152,7 @@ FAR struct can_conn_s *can_alloc(void)
        */
 
       conn->filter_count = 1;
+      can_filter_update(conn);
 #endif
 
       /* Enqueue the connection into the active list */
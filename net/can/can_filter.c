@@ -0,0 +1,187 @@
+/****************************************************************************
+ * net/can/can_filter.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <string.h>
+
+#include <nuttx/can.h>
+
+#include "can/can.h"
+
+#ifdef CONFIG_NET_CANPROTO_OPTIONS
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: can_filter_hash
+ *
+ * Description:
+ *   Return the bucket of a masked identifier.
+ *
+ ****************************************************************************/
+
+static inline unsigned int can_filter_hash(canid_t key)
+{
+  key ^= key >> 16;
+  key ^= key >> 8;
+  key ^= key >> 4;
+  return key & (CAN_FILTER_NBUCKETS - 1);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: can_filter_update
+ *
+ * Description:
+ *   Index the filter_count filters of a connection after they are changed.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void can_filter_update(FAR struct can_conn_s *conn)
+{
+  FAR struct can_filter *filter;
+  unsigned int bucket;
+  unsigned int group;
+  int i;
+
+  conn->nmasks  = 0;
+  conn->nlinear = 0;
+  memset(conn->buckets, 0, sizeof(conn->buckets));
+
+  for (i = 0; i < conn->filter_count; i++)
+    {
+      filter = &conn->filters[i];
+
+      /* The inverted filters match most of the identifiers, they are not
+       * worth hashing.
+       */
+
+      if ((filter->can_id & CAN_INV_FILTER) == 0)
+        {
+          for (group = 0; group < conn->nmasks; group++)
+            {
+              if (conn->masks[group] == filter->can_mask)
+                {
+                  break;
+                }
+            }
+
+          if (group == conn->nmasks && group < CAN_FILTER_NMASKS)
+            {
+              conn->masks[conn->nmasks++] = filter->can_mask;
+            }
+
+          if (group < conn->nmasks)
+            {
+              bucket = can_filter_hash(filter->can_id & filter->can_mask);
+              conn->chain[i] = conn->buckets[group][bucket];
+              conn->buckets[group][bucket] = i + 1;
+              continue;
+            }
+        }
+
+      /* Inverted, or too many distinct masks */
+
+      conn->linear[conn->nlinear++] = i + 1;
+    }
+}
+
+/****************************************************************************
+ * Name: can_filter_match
+ *
+ * Description:
+ *   Check a CAN identifier against the receive filters of a connection.
+ *
+ * Returned Value:
+ *   True if the frame is accepted by the connection.
+ *
+ ****************************************************************************/
+
+bool can_filter_match(FAR struct can_conn_s *conn, canid_t id)
+{
+  FAR struct can_filter *filter;
+  unsigned int group;
+  unsigned int i;
+  canid_t key;
+
+#ifdef CONFIG_NET_CAN_ERRORS
+  /* error message frame */
+
+  if ((id & CAN_ERR_FLAG) != 0)
+    {
+      return (id & conn->err_mask) != 0;
+    }
+#endif
+
+  for (group = 0; group < conn->nmasks; group++)
+    {
+      key = id & conn->masks[group];
+      i   = conn->buckets[group][can_filter_hash(key)];
+
+      while (i != 0)
+        {
+          filter = &conn->filters[i - 1];
+          if ((filter->can_id & filter->can_mask) == key)
+            {
+              return true;
+            }
+
+          i = conn->chain[i - 1];
+        }
+    }
+
+  for (i = 0; i < conn->nlinear; i++)
+    {
+      filter = &conn->filters[conn->linear[i] - 1];
+      if ((filter->can_id & CAN_INV_FILTER) != 0)
+        {
+          if ((id & filter->can_mask) !=
+              ((filter->can_id & ~CAN_INV_FILTER) & filter->can_mask))
+            {
+              return true;
+            }
+        }
+      else if ((id & filter->can_mask) ==
+               (filter->can_id & filter->can_mask))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+#endif /* CONFIG_NET_CANPROTO_OPTIONS */
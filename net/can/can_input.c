@@ -28,6 +28,7 @@
 #if defined(CONFIG_NET) && defined(CONFIG_NET_CAN)
 
 #include <errno.h>
+#include <string.h>
 #include <debug.h>
 
 #include <nuttx/net/netdev.h>
@@ -132,6 +133,55 @@ const uint8_t g_len_to_can_dlc[65] =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: can_active_match
+ *
+ * Description:
+ *   Traverse the list of CAN connections that match dev and that accept
+ *   the received frame, so that the frame is neither cloned nor queued for
+ *   the sockets that would discard it.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure containing the received packet
+ *   conn - The current connection; may be NULL to start the search at the
+ *          beginning
+ *
+ ****************************************************************************/
+
+static FAR struct can_conn_s *
+can_active_match(FAR struct net_driver_s *dev, FAR struct can_conn_s *conn)
+{
+#ifdef CONFIG_NET_CANPROTO_OPTIONS
+  canid_t can_id;
+
+  memcpy(&can_id, dev->d_buf, sizeof(canid_t));
+#endif
+
+  while ((conn = can_active(dev, conn)) != NULL)
+    {
+#ifdef CONFIG_NET_CANPROTO_OPTIONS
+      if (!can_filter_match(conn, can_id))
+        {
+          continue;
+        }
+
+#  ifdef CONFIG_NET_CAN_CANFD
+      /* Do not pass frames with DLC > 8 to a legacy socket */
+
+      if (!_SO_GETOPT(conn->sconn.s_options, CAN_RAW_FD_FRAMES) &&
+          dev->d_len > sizeof(struct can_frame))
+        {
+          continue;
+        }
+#  endif
+#endif
+
+      break;
+    }
+
+  return conn;
+}
+
 /****************************************************************************
  * Name: can_input_conn
  *
@@ -215,12 +265,28 @@ static int can_input_conn(FAR struct net_driver_s *dev,
 
 static int can_in(FAR struct net_driver_s *dev)
 {
-  FAR struct can_conn_s *conn = can_active(dev, NULL);
+  FAR struct can_conn_s *conn;
   FAR struct can_conn_s *nextconn;
 
+#if defined(CONFIG_NET_TIMESTAMP) && !defined(CONFIG_ARCH_HAVE_NETDEV_TIMESTAMP)
+  /* Take the timestamp once for all the listeners, the driver provides it
+   * otherwise.
+   */
+
+  clock_systime_timespec(&dev->d_rxtime);
+#endif
+
+  conn = can_active_match(dev, NULL);
+  if (conn == NULL && can_active(dev, NULL) != NULL)
+    {
+      /* The frame is rejected by the filters of all the listeners */
+
+      return OK;
+    }
+
   /* Do we have second connection that can hold this packet? */
 
-  while ((nextconn = can_active(dev, conn)) != NULL)
+  while ((nextconn = can_active_match(dev, conn)) != NULL)
     {
       /* Yes... There are multiple listeners on the same dev.
        * We need to clone the packet and deliver it to each listener.
@@ -74,10 +74,6 @@ struct can_recvfrom_s
  * Private Functions
  ****************************************************************************/
 
-#ifdef CONFIG_NET_CANPROTO_OPTIONS
-static int can_recv_filter(FAR struct can_conn_s *conn, canid_t id);
-#endif
-
 /****************************************************************************
  * Name: can_add_recvlen
  *
@@ -137,8 +133,15 @@ static size_t can_recvfrom_newdata(FAR struct net_driver_s *dev,
   if (_SO_GETOPT(conn->sconn.s_options, SO_TIMESTAMP) &&
       pstate->pr_msglen == sizeof(struct timeval))
     {
-      iob_copyout(pstate->pr_msgbuf, dev->d_iob, sizeof(struct timeval),
-                  -CONFIG_NET_LL_GUARDSIZE);
+      struct timeval tv;
+
+      /* The frame is not from the read-ahead queue, its timestamp is that
+       * of the device.
+       */
+
+      tv.tv_sec  = dev->d_rxtime.tv_sec;
+      tv.tv_usec = dev->d_rxtime.tv_nsec / 1000;
+      memcpy(pstate->pr_msgbuf, &tv, sizeof(struct timeval));
     }
 #endif
 
@@ -242,12 +245,14 @@ static inline int can_readahead(struct can_recvfrom_s *pstate)
       DEBUGASSERT(iob->io_pktlen > 0);
 
 #ifdef CONFIG_NET_CANPROTO_OPTIONS
-      /* Check receive filters */
+      /* Check receive filters, they may have changed since the frame was
+       * queued.
+       */
 
       canid_t can_id;
       iob_copyout((uint8_t *)&can_id, iob, sizeof(canid_t), 0);
 
-      if (can_recv_filter(conn, can_id) == 0)
+      if (!can_filter_match(conn, can_id))
         {
           FAR struct iob_s *tmp;
 
@@ -330,45 +335,6 @@ static inline int can_readahead(struct can_recvfrom_s *pstate)
   return 0;
 }
 
-#ifdef CONFIG_NET_CANPROTO_OPTIONS
-static int can_recv_filter(FAR struct can_conn_s *conn, canid_t id)
-{
-  uint32_t i;
-
-#ifdef CONFIG_NET_CAN_ERRORS
-  /* error message frame */
-
-  if ((id & CAN_ERR_FLAG) != 0)
-    {
-      return id & conn->err_mask ? 1 : 0;
-    }
-#endif
-
-  for (i = 0; i < conn->filter_count; i++)
-    {
-      if (conn->filters[i].can_id & CAN_INV_FILTER)
-        {
-          if ((id & conn->filters[i].can_mask) !=
-                ((conn->filters[i].can_id & ~CAN_INV_FILTER) &
-                 conn->filters[i].can_mask))
-            {
-              return 1;
-            }
-        }
-      else
-        {
-          if ((id & conn->filters[i].can_mask) ==
-                (conn->filters[i].can_id & conn->filters[i].can_mask))
-            {
-              return 1;
-            }
-        }
-    }
-
-  return 0;
-}
-#endif
-
 static uint16_t can_recvfrom_eventhandler(FAR struct net_driver_s *dev,
                                           FAR void *pvpriv, uint16_t flags)
 {
@@ -384,19 +350,9 @@ static uint16_t can_recvfrom_eventhandler(FAR struct net_driver_s *dev,
 
       if ((flags & CAN_NEWDATA) != 0)
         {
-          /* If a new packet is available, check receive filters
-           * when is valid then complete the read action.
+          /* If a new packet is available, complete the read action.  The
+           * receive filters were checked by can_input().
            */
-#ifdef CONFIG_NET_CANPROTO_OPTIONS
-          canid_t can_id;
-          memcpy(&can_id, dev->d_appdata, sizeof(canid_t));
-
-          if (can_recv_filter(conn, can_id) == 0)
-            {
-              flags &= ~CAN_NEWDATA;
-              return flags;
-            }
-#endif
 
           /* do not pass frames with DLC > 8 to a legacy socket */
 #if defined(CONFIG_NET_CANPROTO_OPTIONS) && defined(CONFIG_NET_CAN_CANFD)
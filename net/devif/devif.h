@@ -470,6 +470,25 @@ uint16_t devif_dev_event(FAR struct net_driver_s *dev, uint16_t flags);
 int devif_send(FAR struct net_driver_s *dev, FAR const void *buf,
                int len, int offset);
 
+/****************************************************************************
+ * Name: devif_send_chksum
+ *
+ * Description:
+ *   Identical to devif_send(), except that the data is summed while it is
+ *   copied:  The sum is left in d_sndsum, as chksum(), for the checksum of
+ *   the protocol header that follows.  devif_send() is used instead if
+ *   CONFIG_NET_CHKSUM_SIMD is not selected.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CHKSUM_SIMD
+int devif_send_chksum(FAR struct net_driver_s *dev, FAR const void *buf,
+                      int len, int offset);
+#else
+#  define devif_send_chksum(dev, buf, len, offset) \
+     devif_send(dev, buf, len, offset)
+#endif
+
 /****************************************************************************
  * Name: devif_iob_send
  *
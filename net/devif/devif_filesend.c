@@ -26,6 +26,9 @@
 
 #include <nuttx/config.h>
 
+#include <sys/param.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 #include <assert.h>
 #include <debug.h>
@@ -37,6 +40,54 @@
 
 #ifdef CONFIG_MM_IOB
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_file_getref
+ *
+ * Description:
+ *   Return an I/O buffer that references the data of the file at 'offset'
+ *   (see file_getdata()), NULL if the file system cannot lend it.  The
+ *   buffer is full, as iob_update_pktlen() expects it, and gives the data
+ *   back when the driver frees it once transmitted.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+static FAR struct iob_s *devif_file_getref(FAR struct file *file,
+                                           off_t offset, unsigned int len)
+{
+  file_putdata_t putdata;
+  FAR struct iob_s *iob;
+  FAR void *base;
+  size_t skip;
+  ssize_t ret;
+
+  ret = file_getdata(file, offset, MIN(len, UINT16_MAX), &base, &skip,
+                     &putdata);
+  if (ret <= 0)
+    {
+      return NULL;
+    }
+
+  DEBUGASSERT(skip < UINT16_MAX);
+  ret = MIN(ret, UINT16_MAX - skip);
+
+  iob = iob_alloc_with_data(base, skip + ret, putdata);
+  if (iob == NULL)
+    {
+      putdata(base);
+      return NULL;
+    }
+
+  iob->io_offset = skip;
+  iob->io_len    = ret;
+  return iob;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -51,6 +102,11 @@
  *   This is identical to calling devif_file_send() except that the data is
  *   in a available file handle.
  *
+ *   With CONFIG_NET_SENDFILE_ZEROCOPY, the data that does not share the
+ *   first buffer with the headers is referenced instead of copied, if the
+ *   file system can lend it.  The position of the file is at the end of
+ *   the data sent in any case.
+ *
  * Assumptions:
  *   Called with the network locked.
  *
@@ -63,6 +119,10 @@ int devif_file_send(FAR struct net_driver_s *dev, FAR struct file *file,
   FAR struct iob_s *iob;
   unsigned int copyin;
   unsigned int remain;
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  bool byref = true;
+  bool seek = false;
+#endif
   int ret;
 
   if (dev == NULL)
@@ -107,11 +167,42 @@ int devif_file_send(FAR struct net_driver_s *dev, FAR struct file *file,
 
   while (remain > 0)
     {
-      if (iob->io_len + iob->io_offset == CONFIG_IOB_BUFSIZE)
+      if (iob->io_len + iob->io_offset == IOB_BUFSIZE(iob))
         {
           if (iob->io_flink == NULL)
             {
-              iob->io_flink = iob_tryalloc(false);
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+              if (byref)
+                {
+                  iob->io_flink = devif_file_getref(file,
+                                                    offset + len - remain,
+                                                    remain);
+                  if (iob->io_flink != NULL)
+                    {
+                      iob     = iob->io_flink;
+                      remain -= iob->io_len;
+                      seek    = true;
+                      continue;
+                    }
+
+                  byref = false;
+                }
+
+              /* Copy the rest from where the references stopped */
+
+              if (seek)
+                {
+                  ret = file_seek(file, offset + len - remain, SEEK_SET);
+                  if (ret < 0)
+                    {
+                      goto errout;
+                    }
+
+                  seek = false;
+                }
+#endif
+
+              iob->io_flink = iob_tryalloc_size(remain, false);
               if (iob->io_flink == NULL)
                 {
                   ret = -ENOMEM;
@@ -122,7 +213,7 @@ int devif_file_send(FAR struct net_driver_s *dev, FAR struct file *file,
           iob = iob->io_flink;
         }
 
-      copyin = CONFIG_IOB_BUFSIZE -
+      copyin = IOB_BUFSIZE(iob) -
                (iob->io_len + iob->io_offset);
       if (copyin > remain)
         {
@@ -144,6 +235,17 @@ int devif_file_send(FAR struct net_driver_s *dev, FAR struct file *file,
         }
     }
 
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  if (seek)
+    {
+      ret = file_seek(file, offset + len, SEEK_SET);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+    }
+#endif
+
   iob_update_pktlen(dev->d_iob, target_offset + len, false);
 
   dev->d_sndlen = len;
@@ -60,7 +60,9 @@
 
 /* IP/TCP/UDP/ICMP statistics for all network interfaces */
 
-#ifdef CONFIG_NET_STATISTICS
+#if defined(CONFIG_NET_STATISTICS_PERCPU)
+struct net_stats_s g_netstats_percpu[CONFIG_SMP_NCPUS];
+#elif defined(CONFIG_NET_STATISTICS)
 struct net_stats_s g_netstats;
 #endif
 
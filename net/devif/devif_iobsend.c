@@ -73,8 +73,19 @@ int devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
       goto errout;
     }
 
+#ifdef CONFIG_NETDEV_GSO
+  /* A TCP super-segment may exceed the MTU */
+
+  if (dev->d_gsosize > 0 && len > dev->d_gsomax - target_offset)
+    {
+      ret = -EMSGSIZE;
+      goto errout;
+    }
+#endif
+
 #ifndef CONFIG_NET_IPFRAG
-  if (len > NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev) - target_offset)
+  if (len > NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev) - target_offset &&
+      !NETDEV_GSO_PENDING(dev))
     {
       ret = -EMSGSIZE;
       goto errout;
@@ -111,6 +111,15 @@ int devif_loopback(FAR struct net_driver_s *dev)
        pkt_input(dev);
 #endif
 
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+      /* The checksum left to the device is not needed on the way back */
+
+      if ((dev->d_iob->io_csumflags & IOB_CSUM_PARTIAL) != 0)
+        {
+          dev->d_iob->io_csumflags = IOB_CSUM_VERIFIED;
+        }
+#endif
+
       /* We only accept IP packets of the configured type */
 
 #ifdef CONFIG_NET_IPv4
@@ -52,6 +52,7 @@
 #include "ipfilter/ipfilter.h"
 #include "ipfrag/ipfrag.h"
 #include "inet/inet.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Private Types
@@ -1036,10 +1037,13 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
   uint16_t llhdrlen;
   FAR uint8_t *buf;
   int bstop;
+  NET_LAYER_START(start);
 
   if (dev->d_buf == NULL)
     {
-      return devif_iob_poll(dev, callback);
+      bstop = devif_iob_poll(dev, callback);
+      NET_LAYER_STOP(NET_LAYER_POLL, start);
+      return bstop;
     }
 
   buf = dev->d_buf;
@@ -1095,6 +1099,7 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
 
   dev->d_buf = buf;
 
+  NET_LAYER_STOP(NET_LAYER_POLL, start);
   return bstop;
 }
 
@@ -1165,6 +1170,9 @@ int devif_poll_out(FAR struct net_driver_s *dev,
 
   if (dev->d_len == 0)
     {
+#ifdef CONFIG_NETDEV_GSO
+      dev->d_gsosize = 0;
+#endif
       return 0;
     }
 
@@ -1179,7 +1187,13 @@ int devif_poll_out(FAR struct net_driver_s *dev,
   if (callback)
     {
 #ifdef CONFIG_NET_IPFRAG
-      if (ip_fragout(dev) != OK)
+      /* A super-segment is segmented by the driver, not fragmented */
+
+      if (NETDEV_GSO_PENDING(dev))
+        {
+          return callback(dev);
+        }
+      else if (ip_fragout(dev) != OK)
         {
           netdev_iob_release(dev);
           return 1;
@@ -51,26 +51,28 @@
 #include <nuttx/net/netdev.h>
 
 #include "devif/devif.h"
+#include "utils/utils.h"
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: devif_send
+ * Name: devif_send_internal
  *
  * Description:
- *   Called from socket logic in response to a xmit or poll request from the
- *   the network interface driver.
- *
- * Assumptions:
- *   The network is locked.
+ *   Copy the data to send into the device buffer, and sum it if 'sum' is
+ *   true.
  *
  ****************************************************************************/
 
-int devif_send(FAR struct net_driver_s *dev, FAR const void *buf,
-               int len, int offset)
+static int devif_send_internal(FAR struct net_driver_s *dev,
+                               FAR const void *buf, int len, int offset,
+                               bool sum)
 {
+#ifdef CONFIG_NET_CHKSUM_SIMD
+  uint16_t chksum;
+#endif
   int ret;
 
   if (dev == NULL)
@@ -106,13 +108,31 @@ int devif_send(FAR struct net_driver_s *dev, FAR const void *buf,
 
   iob_update_pktlen(dev->d_iob, offset < 0 ? 0 : offset, false);
 
-  ret = iob_trycopyin(dev->d_iob, buf, len, offset, false);
+#ifdef CONFIG_NET_CHKSUM_SIMD
+  dev->d_sndsum = -1;
+  if (sum)
+    {
+      ret = net_iob_copyin_chksum(dev->d_iob, buf, len, offset, &chksum);
+    }
+  else
+#endif
+    {
+      ret = iob_trycopyin(dev->d_iob, buf, len, offset, false);
+    }
+
   if (ret != len)
     {
       netdev_iob_release(dev);
       goto errout;
     }
 
+#ifdef CONFIG_NET_CHKSUM_SIMD
+  if (sum)
+    {
+      dev->d_sndsum = chksum;
+    }
+#endif
+
   dev->d_sndlen = len;
 
   return dev->d_sndlen;
@@ -121,3 +141,45 @@ errout:
   nerr("ERROR: devif_send error: %d\n", ret);
   return ret;
 }
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_send
+ *
+ * Description:
+ *   Called from socket logic in response to a xmit or poll request from the
+ *   the network interface driver.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int devif_send(FAR struct net_driver_s *dev, FAR const void *buf,
+               int len, int offset)
+{
+  return devif_send_internal(dev, buf, len, offset, false);
+}
+
+/****************************************************************************
+ * Name: devif_send_chksum
+ *
+ * Description:
+ *   Identical to devif_send(), except that the data is summed while it is
+ *   copied, the sum is left in d_sndsum for the checksum of the protocol.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CHKSUM_SIMD
+int devif_send_chksum(FAR struct net_driver_s *dev, FAR const void *buf,
+                      int len, int offset)
+{
+  return devif_send_internal(dev, buf, len, offset, true);
+}
+#endif
@@ -160,7 +160,7 @@ static int ipv4_in(FAR struct net_driver_s *dev)
   /* This is where the input processing starts. */
 
 #ifdef CONFIG_NET_STATISTICS
-  g_netstats.ipv4.recv++;
+  NET_STATS(ipv4.recv)++;
 #endif
 
   /* Start of IP input header processing code.
@@ -177,8 +177,8 @@ static int ipv4_in(FAR struct net_driver_s *dev)
       /* IP version and header length. */
 
 #ifdef CONFIG_NET_STATISTICS
-      g_netstats.ipv4.drop++;
-      g_netstats.ipv4.vhlerr++;
+      NET_STATS(ipv4.drop)++;
+      NET_STATS(ipv4.vhlerr)++;
 #endif
       nwarn("WARNING: Invalid IP version or header length: %02x\n",
             ipv4->vhl);
@@ -230,8 +230,8 @@ static int ipv4_in(FAR struct net_driver_s *dev)
 
 #endif
 #ifdef CONFIG_NET_STATISTICS
-      g_netstats.ipv4.drop++;
-      g_netstats.ipv4.fragerr++;
+      NET_STATS(ipv4.drop)++;
+      NET_STATS(ipv4.fragerr)++;
 #endif
       nwarn("WARNING: IP fragment dropped\n");
       goto drop;
@@ -365,7 +365,7 @@ static int ipv4_in(FAR struct net_driver_s *dev)
                     "Dropping!\n");
 
 #ifdef CONFIG_NET_STATISTICS
-              g_netstats.ipv4.drop++;
+              NET_STATS(ipv4.drop)++;
 #endif
               goto drop;
             }
@@ -388,8 +388,8 @@ static int ipv4_in(FAR struct net_driver_s *dev)
       /* Compute and check the IP header checksum. */
 
 #ifdef CONFIG_NET_STATISTICS
-      g_netstats.ipv4.drop++;
-      g_netstats.ipv4.chkerr++;
+      NET_STATS(ipv4.drop)++;
+      NET_STATS(ipv4.chkerr)++;
 #endif
       nwarn("WARNING: Bad IP checksum\n");
       goto drop;
@@ -438,8 +438,8 @@ static int ipv4_in(FAR struct net_driver_s *dev)
 
       default:              /* Unrecognized/unsupported protocol */
 #ifdef CONFIG_NET_STATISTICS
-        g_netstats.ipv4.drop++;
-        g_netstats.ipv4.protoerr++;
+        NET_STATS(ipv4.drop)++;
+        NET_STATS(ipv4.protoerr)++;
 #endif
 
         nwarn("WARNING: Unrecognized IP protocol\n");
@@ -502,6 +502,7 @@ int ipv4_input(FAR struct net_driver_s *dev)
 {
   FAR uint8_t *buf;
   int ret;
+  NET_LAYER_START(start);
 
   /* Store reception timestamp if enabled and not provided by hardware. */
 
@@ -519,11 +520,14 @@ int ipv4_input(FAR struct net_driver_s *dev)
       ret = ipv4_in(dev);
 
       dev->d_buf = buf;
-
-      return ret;
+    }
+  else
+    {
+      ret = netdev_input(dev, ipv4_in, true);
     }
 
-  return netdev_input(dev, ipv4_in, true);
+  NET_LAYER_STOP(NET_LAYER_IPv4, start);
+  return ret;
 }
 
 #endif /* CONFIG_NET_IPv4 */
@@ -55,6 +55,7 @@
 #include "devif/devif.h"
 #include "ipfilter/ipfilter.h"
 #include "ipfrag/ipfrag.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Private Functions
@@ -202,7 +203,7 @@ static int ipv6_in(FAR struct net_driver_s *dev)
   /* This is where the input processing starts. */
 
 #ifdef CONFIG_NET_STATISTICS
-  g_netstats.ipv6.recv++;
+  NET_STATS(ipv6.recv)++;
 #endif
 
   /* Start of IP input header processing code.
@@ -217,7 +218,7 @@ static int ipv6_in(FAR struct net_driver_s *dev)
       nwarn("WARNING: Invalid IPv6 version: %d\n", ipv6->vtc >> 4);
 
 #ifdef CONFIG_NET_STATISTICS
-      g_netstats.ipv6.vhlerr++;
+      NET_STATS(ipv6.vhlerr)++;
 #endif
       goto drop;
     }
@@ -415,7 +416,7 @@ static int ipv6_in(FAR struct net_driver_s *dev)
       else
         {
 #ifdef CONFIG_NET_STATISTICS
-          g_netstats.ipv6.fragerr++;
+          NET_STATS(ipv6.fragerr)++;
 #endif
           goto drop;
         }
@@ -523,7 +524,7 @@ static int ipv6_in(FAR struct net_driver_s *dev)
         nwarn("WARNING: Unrecognized IP protocol: %04x\n", ipv6->proto);
 
 #ifdef CONFIG_NET_STATISTICS
-        g_netstats.ipv6.protoerr++;
+        NET_STATS(ipv6.protoerr)++;
 #endif
         goto drop;
     }
@@ -552,7 +553,7 @@ done:
 
 drop:
 #ifdef CONFIG_NET_STATISTICS
-  g_netstats.ipv6.drop++;
+  NET_STATS(ipv6.drop)++;
 #endif
   dev->d_len = 0;
   return OK;
@@ -629,6 +630,7 @@ int ipv6_input(FAR struct net_driver_s *dev)
 {
   FAR uint8_t *buf;
   int ret;
+  NET_LAYER_START(start);
 
   /* Store reception timestamp if enabled and not provided by hardware. */
 
@@ -646,10 +648,13 @@ int ipv6_input(FAR struct net_driver_s *dev)
       ret = ipv6_in(dev);
 
       dev->d_buf = buf;
-
-      return ret;
+    }
+  else
+    {
+      ret = netdev_input(dev, ipv6_in, true);
     }
 
-  return netdev_input(dev, ipv6_in, true);
+  NET_LAYER_STOP(NET_LAYER_IPv6, start);
+  return ret;
 }
 #endif /* CONFIG_NET_IPv6 */
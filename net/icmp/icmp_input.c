@@ -281,7 +281,7 @@ void icmp_input(FAR struct net_driver_s *dev)
 #endif
 
 #ifdef CONFIG_NET_STATISTICS
-  g_netstats.icmp.recv++;
+  NET_STATS(icmp.recv)++;
 #endif
 
   /* The ICMP header immediately follows the IP header */
@@ -344,8 +344,8 @@ void icmp_input(FAR struct net_driver_s *dev)
             dev->d_len, (ipv4->len[0] << 8) | ipv4->len[1]);
 
 #ifdef CONFIG_NET_STATISTICS
-      g_netstats.icmp.sent++;
-      g_netstats.ipv4.sent++;
+      NET_STATS(icmp.sent)++;
+      NET_STATS(ipv4.sent)++;
 #endif
     }
 
@@ -405,13 +405,13 @@ void icmp_input(FAR struct net_driver_s *dev)
 
 typeerr:
 #ifdef CONFIG_NET_STATISTICS
-  g_netstats.icmp.typeerr++;
+  NET_STATS(icmp.typeerr)++;
 #endif
 
 #ifdef CONFIG_NET_ICMP_SOCKET
 drop:
 #ifdef CONFIG_NET_STATISTICS
-  g_netstats.icmp.drop++;
+  NET_STATS(icmp.drop)++;
 #endif
 #endif
 
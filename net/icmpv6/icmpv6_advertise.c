@@ -122,8 +122,8 @@ void icmpv6_advertise(FAR struct net_driver_s *dev,
   ninfo("Outgoing ICMPv6 Neighbor Advertise length: %d\n", dev->d_len);
 
 #ifdef CONFIG_NET_STATISTICS
-  g_netstats.icmpv6.sent++;
-  g_netstats.ipv6.sent++;
+  NET_STATS(icmpv6.sent)++;
+  NET_STATS(ipv6.sent)++;
 #endif
 }
 
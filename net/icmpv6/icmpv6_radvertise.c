@@ -321,8 +321,8 @@ skip_prefix:
   ninfo("Outgoing ICMPv6 Router Advertise length: %d\n", dev->d_len);
 
 #ifdef CONFIG_NET_STATISTICS
-  g_netstats.icmpv6.sent++;
-  g_netstats.ipv6.sent++;
+  NET_STATS(icmpv6.sent)++;
+  NET_STATS(ipv6.sent)++;
 #endif
 }
 
@@ -142,11 +142,11 @@ int igmp_joingroup(struct net_driver_s *dev,
           return -EADDRNOTAVAIL;
         }
 
-      IGMP_STATINCR(g_netstats.igmp.joins);
+      IGMP_STATINCR(NET_STATS(igmp.joins));
 
       /* Send the Membership Report */
 
-      IGMP_STATINCR(g_netstats.igmp.report_sched);
+      IGMP_STATINCR(NET_STATS(igmp.report_sched));
       ret = igmp_waitmsg(group, IGMPv2_MEMBERSHIP_REPORT);
       if (ret < 0)
         {
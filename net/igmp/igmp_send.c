@@ -166,8 +166,8 @@ void igmp_send(FAR struct net_driver_s *dev, FAR struct igmp_group_s *group,
   igmp->chksum      = ~igmp_chksum(&igmp->type, IGMP_HDRLEN);
 #endif
 
-  IGMP_STATINCR(g_netstats.igmp.poll_send);
-  IGMP_STATINCR(g_netstats.ipv4.sent);
+  IGMP_STATINCR(NET_STATS(igmp.poll_send));
+  IGMP_STATINCR(NET_STATS(ipv4.sent));
 
   ninfo("Outgoing IGMP packet length: %d\n", dev->d_len);
   igmp_dumppkt(RA, iphdrlen + IGMP_HDRLEN);
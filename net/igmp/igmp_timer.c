@@ -122,7 +122,7 @@ static void igmp_timeout_work(FAR void *arg)
        * for the message to be sent.
        */
 
-      IGMP_STATINCR(g_netstats.igmp.report_sched);
+      IGMP_STATINCR(NET_STATS(igmp.report_sched));
       ret = igmp_schedmsg(group, IGMPv2_MEMBERSHIP_REPORT);
       if (ret < 0)
         {
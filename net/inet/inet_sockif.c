@@ -28,6 +28,7 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <poll.h>
 #include <stdbool.h>
 #include <assert.h>
 #include <errno.h>
@@ -38,6 +39,7 @@
 #include <nuttx/net/tcp.h>
 #include <nuttx/kmalloc.h>
 
+#include "netdev/netdev.h"
 #include "tcp/tcp.h"
 #include "udp/udp.h"
 #include "icmp/icmp.h"
@@ -1674,6 +1676,56 @@ static inline int inet_pollteardown(FAR struct socket *psock,
 }
 #endif /* NET_TCP_HAVE_STACK || NET_UDP_HAVE_STACK */
 
+/****************************************************************************
+ * Name: inet_pollready/inet_busypoll
+ *
+ * Description:
+ *   Busy poll the RX of the device of a socket with SO_BUSY_POLL once the
+ *   poll is set up, until one of the monitored events is reported or the
+ *   busy poll time expires.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_BUSYPOLL) && \
+    (defined(NET_TCP_HAVE_STACK) || defined(NET_UDP_HAVE_STACK))
+static bool inet_pollready(FAR void *arg)
+{
+  FAR struct pollfd *fds = arg;
+
+  return (fds->revents & fds->events) != 0;
+}
+
+static void inet_busypoll(FAR struct socket *psock, FAR struct pollfd *fds)
+{
+  FAR struct socket_conn_s *conn = psock->s_conn;
+  FAR struct net_driver_s *dev = NULL;
+
+  if (conn->s_busypoll == 0 || inet_pollready(fds))
+    {
+      return;
+    }
+
+  net_lock();
+
+#ifdef NET_TCP_HAVE_STACK
+  if (psock->s_type == SOCK_STREAM)
+    {
+      dev = ((FAR struct tcp_conn_s *)conn)->dev;
+    }
+#endif
+
+#ifdef NET_UDP_HAVE_STACK
+  if (psock->s_type == SOCK_DGRAM)
+    {
+      dev = udp_find_laddr_device((FAR struct udp_conn_s *)conn);
+    }
+#endif
+
+  netdev_busypoll(dev, conn->s_busypoll, inet_pollready, fds);
+  net_unlock();
+}
+#endif
+
 /****************************************************************************
  * Name: inet_poll
  *
@@ -1703,7 +1755,18 @@ static int inet_poll(FAR struct socket *psock, FAR struct pollfd *fds,
     {
       /* Perform the TCP/IP poll() setup */
 
+#ifdef CONFIG_NET_BUSYPOLL
+      int ret = inet_pollsetup(psock, fds);
+
+      if (ret >= 0)
+        {
+          inet_busypoll(psock, fds);
+        }
+
+      return ret;
+#else
       return inet_pollsetup(psock, fds);
+#endif
     }
   else
     {
@@ -86,6 +86,12 @@ int ipv4_getsockopt(FAR struct socket *psock, int option,
         break;
 #endif
 
+#ifdef CONFIG_NET_IPFILTER_SET
+      case SO_IP_SET:
+        ret = ipset_getsockopt(psock, value, value_len);
+        break;
+#endif
+
       case IP_TOS:
         {
           FAR struct socket_conn_s *conn = psock->s_conn;
@@ -385,6 +385,12 @@ int ipv4_setsockopt(FAR struct socket *psock, int option,
         break;
 #endif
 
+#ifdef CONFIG_NET_IPFILTER_SET
+      case SO_IP_SET:
+        ret = ipset_setsockopt(psock, value, value_len);
+        break;
+#endif
+
       default:
         nerr("ERROR: Unrecognized IPv4 option: %d\n", option);
         ret = -ENOPROTOOPT;
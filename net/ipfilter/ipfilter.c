@@ -27,6 +27,7 @@
 #include <nuttx/config.h>
 
 #include <debug.h>
+#include <string.h>
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/net/icmpv6.h>
@@ -37,6 +38,7 @@
 #include "icmp/icmp.h"
 #include "icmpv6/icmpv6.h"
 #include "ipfilter/ipfilter.h"
+#include "ipforward/ipforward.h"
 #include "utils/utils.h"
 
 #ifdef CONFIG_NET_IPFILTER
@@ -65,21 +67,158 @@
 #define IPv6_L4HDR(ipv6, proto) \
   ((FAR void *)(net_ipv6_payload((FAR struct ipv6_hdr_s *)(ipv6), &(proto))))
 
+/* The protocol classes of the jump tables */
+
+#define IPFILTER_CLASS_TCP   0
+#define IPFILTER_CLASS_UDP   1
+#define IPFILTER_CLASS_ICMP  2
+#define IPFILTER_CLASS_OTHER 3
+#define IPFILTER_CLASS_MAX   4
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The compiled form of a chain:  The entries that can match the packets of
+ * a protocol class are entries[start[class]] to entries[start[class + 1]]
+ * excluded, in the order of the chain.  The entries that match any
+ * protocol are in all the classes.  entries is NULL if the chain is not
+ * compiled, it is then matched entry by entry.
+ */
+
+struct ipfilter_jumptab_s
+{
+  FAR const struct ipfilter_entry_s **entries;
+  uint32_t start[IPFILTER_CLASS_MAX + 1];
+};
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
 #ifdef CONFIG_NET_IPv4
 static sq_queue_t g_ipv4_filters[IPFILTER_CHAIN_MAX];
+static struct ipfilter_jumptab_s g_ipv4_jumptabs[IPFILTER_CHAIN_MAX];
 #endif
 #ifdef CONFIG_NET_IPv6
 static sq_queue_t g_ipv6_filters[IPFILTER_CHAIN_MAX];
+static struct ipfilter_jumptab_s g_ipv6_jumptabs[IPFILTER_CHAIN_MAX];
 #endif
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: ipfilter_class
+ *
+ * Description:
+ *   Return the protocol class of a packet in the jump tables.
+ *
+ ****************************************************************************/
+
+static int ipfilter_class(uint8_t proto)
+{
+  switch (proto)
+    {
+      case IP_PROTO_TCP:
+        return IPFILTER_CLASS_TCP;
+
+      case IP_PROTO_UDP:
+        return IPFILTER_CLASS_UDP;
+
+      case IP_PROTO_ICMP:
+      case IP_PROTO_ICMP6:
+        return IPFILTER_CLASS_ICMP;
+
+      default:
+        return IPFILTER_CLASS_OTHER;
+    }
+}
+
+/****************************************************************************
+ * Name: ipfilter_jumptab_free
+ *
+ * Description:
+ *   Drop the compiled form of a chain, once the chain is changed.
+ *
+ ****************************************************************************/
+
+static void ipfilter_jumptab_free(FAR struct ipfilter_jumptab_s *tab)
+{
+  kmm_free(tab->entries);
+  tab->entries = NULL;
+}
+
+/****************************************************************************
+ * Name: ipfilter_jumptab_build
+ *
+ * Description:
+ *   Compile a chain into its jump table.  The chain is left uncompiled if
+ *   the memory is exhausted.
+ *
+ ****************************************************************************/
+
+static void ipfilter_jumptab_build(FAR struct ipfilter_jumptab_s *tab,
+                                   FAR const sq_queue_t *queue)
+{
+  FAR const struct ipfilter_entry_s *filter;
+  FAR const sq_entry_t *entry;
+  uint32_t next[IPFILTER_CLASS_MAX];
+  int cls;
+
+  ipfilter_jumptab_free(tab);
+  memset(next, 0, sizeof(next));
+
+  /* Count the entries of each class, then fill the classes in order */
+
+  sq_for_every(queue, entry)
+    {
+      filter = (FAR const struct ipfilter_entry_s *)entry;
+      for (cls = 0; cls < IPFILTER_CLASS_MAX; cls++)
+        {
+          if (filter->proto == 0 || filter->inv_proto ||
+              ipfilter_class(filter->proto) == cls)
+            {
+              next[cls]++;
+            }
+        }
+    }
+
+  tab->start[0] = 0;
+  for (cls = 0; cls < IPFILTER_CLASS_MAX; cls++)
+    {
+      tab->start[cls + 1] = tab->start[cls] + next[cls];
+      next[cls] = tab->start[cls];
+    }
+
+  if (tab->start[IPFILTER_CLASS_MAX] == 0)
+    {
+      return;
+    }
+
+  tab->entries = kmm_malloc(tab->start[IPFILTER_CLASS_MAX] *
+                            sizeof(*tab->entries));
+  if (tab->entries == NULL)
+    {
+      nwarn("WARNING: Failed to compile filter chain\n");
+      return;
+    }
+
+  sq_for_every(queue, entry)
+    {
+      filter = (FAR const struct ipfilter_entry_s *)entry;
+      for (cls = 0; cls < IPFILTER_CLASS_MAX; cls++)
+        {
+          if (filter->proto == 0 || filter->inv_proto ||
+              ipfilter_class(filter->proto) == cls)
+            {
+              tab->entries[next[cls]++] = filter;
+            }
+        }
+    }
+}
+
 /****************************************************************************
  * Name: ipfilter_match_device
  *
@@ -188,11 +327,165 @@ static bool ipfilter_match_proto(FAR const struct ipfilter_entry_s *entry,
     }
 }
 
+/****************************************************************************
+ * Name: ipv4_filter_match_set
+ *
+ * Description:
+ *   Match the address, and the port for a two dimensional match, of the
+ *   packet with the set of the filter entry.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPFILTER_SET)
+static bool ipv4_filter_match_set(FAR const struct ipfilter_entry_s *entry,
+                                  FAR const struct ipv4_hdr_s *ipv4,
+                                  FAR const void *l4hdr)
+{
+  FAR const struct xt_set_info *info = &entry->set;
+  in_addr_t ipaddr;
+  uint16_t port = 0;
+  bool matched;
+
+  if (info->flags & IPSET_DIM_ONE_SRC)
+    {
+      ipaddr = net_ip4addr_conv32(ipv4->srcipaddr);
+    }
+  else
+    {
+      ipaddr = net_ip4addr_conv32(ipv4->destipaddr);
+    }
+
+  if (info->dim > 1 &&
+      (ipv4->proto == IP_PROTO_TCP || ipv4->proto == IP_PROTO_UDP))
+    {
+      /* Ports in TCP & UDP headers have same offset. */
+
+      FAR const struct udp_hdr_s *udp = l4hdr;
+      port = (info->flags & IPSET_DIM_TWO_SRC) ? udp->srcport :
+                                                 udp->destport;
+    }
+
+  matched = ipfilter_set_match(info->index, ipaddr, ipv4->proto, port);
+  return matched ^ !!(info->flags & IPSET_INV_MATCH);
+}
+#endif
+
+/****************************************************************************
+ * Name: ipv4_filter_match_entry / ipv6_filter_match_entry
+ *
+ * Description:
+ *   Match the packet with one filter entry.
+ *
+ * Returned Value:
+ *   true  - The packet is matched
+ *   false - The packet is not matched
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static bool
+ipv4_filter_match_entry(FAR const struct ipv4_filter_entry_s *filter,
+                        FAR const struct net_driver_s *indev,
+                        FAR const struct net_driver_s *outdev,
+                        FAR const struct ipv4_hdr_s *ipv4,
+                        FAR const void *l4hdr)
+{
+  in_addr_t ipaddr;
+  bool matched;
+
+  /* Match device */
+
+  if (!ipfilter_match_device(&filter->common, indev, outdev))
+    {
+      return false;
+    }
+
+  /* Match addresses */
+
+  ipaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
+  matched = net_ipv4addr_maskcmp(filter->sip, ipaddr, filter->smsk)
+            ^ filter->common.inv_srcip;
+  if (!matched)
+    {
+      return false;
+    }
+
+  ipaddr  = net_ip4addr_conv32(ipv4->destipaddr);
+  matched = net_ipv4addr_maskcmp(filter->dip, ipaddr, filter->dmsk)
+            ^ filter->common.inv_dstip;
+  if (!matched)
+    {
+      return false;
+    }
+
+  /* Match protocol */
+
+  if (!ipfilter_match_proto(&filter->common, l4hdr, ipv4->proto))
+    {
+      return false;
+    }
+
+#ifdef CONFIG_NET_IPFILTER_SET
+  /* Match set */
+
+  if (filter->common.match_set &&
+      !ipv4_filter_match_set(&filter->common, ipv4, l4hdr))
+    {
+      return false;
+    }
+#endif
+
+  return true;
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static bool
+ipv6_filter_match_entry(FAR const struct ipv6_filter_entry_s *filter,
+                        FAR const struct net_driver_s *indev,
+                        FAR const struct net_driver_s *outdev,
+                        FAR const struct ipv6_hdr_s *ipv6,
+                        FAR const void *l4hdr, uint8_t proto)
+{
+  bool matched;
+
+  /* Match device */
+
+  if (!ipfilter_match_device(&filter->common, indev, outdev))
+    {
+      return false;
+    }
+
+  /* Match addresses */
+
+  matched = net_ipv6addr_maskcmp(filter->sip, ipv6->srcipaddr,
+                                 filter->smsk)
+            ^ filter->common.inv_srcip;
+  if (!matched)
+    {
+      return false;
+    }
+
+  matched = net_ipv6addr_maskcmp(filter->dip, ipv6->destipaddr,
+                                 filter->dmsk)
+            ^ filter->common.inv_dstip;
+  if (!matched)
+    {
+      return false;
+    }
+
+  /* Match protocol */
+
+  return ipfilter_match_proto(&filter->common, l4hdr, proto);
+}
+#endif
+
 /****************************************************************************
  * Name: ipv4_filter_match / ipv6_filter_match
  *
  * Description:
- *   Match the input packet with the filter entries in the specified chain.
+ *   Match the input packet with the filter entries in the specified chain,
+ *   through the jump table of the chain if it is compiled.
  *
  * Input Parameters:
  *   indev     - The network device that the packet comes from
@@ -213,12 +506,13 @@ static int ipv4_filter_match(FAR const struct net_driver_s *indev,
                              FAR const struct ipv4_hdr_s *ipv4,
                              enum ipfilter_chain_e chain)
 {
+  FAR const struct ipfilter_jumptab_s *tab = &g_ipv4_jumptabs[chain];
   FAR const struct ipv4_filter_entry_s *filter;
   FAR const sq_queue_t *queue = &g_ipv4_filters[chain];
   FAR const sq_entry_t *entry;
   FAR const void *l4hdr;
-  in_addr_t ipaddr;
-  bool matched;
+  uint32_t i;
+  int cls;
 
   /* Handle unexpected status, return ACCEPT to indicate doing nothing. */
 
@@ -229,45 +523,30 @@ static int ipv4_filter_match(FAR const struct net_driver_s *indev,
 
   l4hdr = IPv4_L4HDR(ipv4);
 
-  sq_for_every(queue, entry)
+  if (tab->entries != NULL)
     {
-      filter = (FAR struct ipv4_filter_entry_s *)entry;
-
-      /* Match device */
-
-      if (!ipfilter_match_device(&filter->common, indev, outdev))
+      cls = ipfilter_class(ipv4->proto);
+      for (i = tab->start[cls]; i < tab->start[cls + 1]; i++)
         {
-          continue;
+          filter = (FAR const struct ipv4_filter_entry_s *)tab->entries[i];
+          if (ipv4_filter_match_entry(filter, indev, outdev, ipv4, l4hdr))
+            {
+              return filter->common.target;
+            }
         }
-
-      /* Match addresses */
-
-      ipaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
-      matched = net_ipv4addr_maskcmp(filter->sip, ipaddr, filter->smsk)
-                ^ filter->common.inv_srcip;
-      if (!matched)
-        {
-          continue;
-        }
-
-      ipaddr  = net_ip4addr_conv32(ipv4->destipaddr);
-      matched = net_ipv4addr_maskcmp(filter->dip, ipaddr, filter->dmsk)
-                ^ filter->common.inv_dstip;
-      if (!matched)
+    }
+  else
+    {
+      sq_for_every(queue, entry)
         {
-          continue;
-        }
+          filter = (FAR struct ipv4_filter_entry_s *)entry;
+          if (ipv4_filter_match_entry(filter, indev, outdev, ipv4, l4hdr))
+            {
+              /* Return the target action if matched. */
 
-      /* Match protocol */
-
-      if (!ipfilter_match_proto(&filter->common, l4hdr, ipv4->proto))
-        {
-          continue;
+              return filter->common.target;
+            }
         }
-
-      /* Return the target action if matched. */
-
-      return filter->common.target;
     }
 
   /* Normally there should be a default rule in chain, won't reach here. */
@@ -283,12 +562,14 @@ static int ipv6_filter_match(FAR const struct net_driver_s *indev,
                              FAR const struct ipv6_hdr_s *ipv6,
                              enum ipfilter_chain_e chain)
 {
+  FAR const struct ipfilter_jumptab_s *tab = &g_ipv6_jumptabs[chain];
   FAR const struct ipv6_filter_entry_s *filter;
   FAR const sq_queue_t *queue = &g_ipv6_filters[chain];
   FAR const sq_entry_t *entry;
   FAR const void *l4hdr;
   uint8_t proto;
-  bool matched;
+  uint32_t i;
+  int cls;
 
   /* Handle unexpected status, return ACCEPT to indicate doing nothing. */
 
@@ -299,45 +580,32 @@ static int ipv6_filter_match(FAR const struct net_driver_s *indev,
 
   l4hdr = IPv6_L4HDR(ipv6, proto);
 
-  sq_for_every(queue, entry)
+  if (tab->entries != NULL)
     {
-      filter = (FAR struct ipv6_filter_entry_s *)entry;
-
-      /* Match device */
-
-      if (!ipfilter_match_device(&filter->common, indev, outdev))
-        {
-          continue;
-        }
-
-      /* Match addresses */
-
-      matched = net_ipv6addr_maskcmp(filter->sip, ipv6->srcipaddr,
-                                     filter->smsk)
-                ^ filter->common.inv_srcip;
-      if (!matched)
-        {
-          continue;
-        }
-
-      matched = net_ipv6addr_maskcmp(filter->dip, ipv6->destipaddr,
-                                     filter->dmsk)
-                ^ filter->common.inv_dstip;
-      if (!matched)
+      cls = ipfilter_class(proto);
+      for (i = tab->start[cls]; i < tab->start[cls + 1]; i++)
         {
-          continue;
+          filter = (FAR const struct ipv6_filter_entry_s *)tab->entries[i];
+          if (ipv6_filter_match_entry(filter, indev, outdev, ipv6, l4hdr,
+                                      proto))
+            {
+              return filter->common.target;
+            }
         }
-
-      /* Match protocol */
-
-      if (!ipfilter_match_proto(&filter->common, l4hdr, proto))
+    }
+  else
+    {
+      sq_for_every(queue, entry)
         {
-          continue;
+          filter = (FAR struct ipv6_filter_entry_s *)entry;
+          if (ipv6_filter_match_entry(filter, indev, outdev, ipv6, l4hdr,
+                                      proto))
+            {
+              /* Return the target action if matched. */
+
+              return filter->common.target;
+            }
         }
-
-      /* Return the target action if matched. */
-
-      return filter->common.target;
     }
 
   /* Normally there should be a default rule in chain, won't reach here. */
@@ -411,6 +679,8 @@ void ipfilter_cfg_add(FAR struct ipfilter_entry_s *entry,
   if (family == PF_INET)
     {
       sq_addlast((FAR sq_entry_t *)entry, &g_ipv4_filters[chain]);
+      ipfilter_jumptab_free(&g_ipv4_jumptabs[chain]);
+      ipfwd_flowcache_flush();
     }
 #endif
 
@@ -418,6 +688,7 @@ void ipfilter_cfg_add(FAR struct ipfilter_entry_s *entry,
   if (family == PF_INET6)
     {
       sq_addlast((FAR sq_entry_t *)entry, &g_ipv6_filters[chain]);
+      ipfilter_jumptab_free(&g_ipv6_jumptabs[chain]);
     }
 #endif
 }
@@ -444,10 +715,23 @@ void ipfilter_cfg_clear(sa_family_t family, enum ipfilter_chain_e chain)
   if (family == PF_INET)
     {
       FAR sq_queue_t *queue = &g_ipv4_filters[chain];
+      FAR struct ipfilter_entry_s *entry;
+
+      ipfilter_jumptab_free(&g_ipv4_jumptabs[chain]);
       while (!sq_empty(queue))
         {
-          kmm_free(sq_remfirst(queue));
+          entry = (FAR struct ipfilter_entry_s *)sq_remfirst(queue);
+#ifdef CONFIG_NET_IPFILTER_SET
+          if (entry->match_set)
+            {
+              ipfilter_set_release(entry->set.index);
+            }
+#endif
+
+          kmm_free(entry);
         }
+
+      ipfwd_flowcache_flush();
     }
 #endif
 
@@ -455,6 +739,8 @@ void ipfilter_cfg_clear(sa_family_t family, enum ipfilter_chain_e chain)
   if (family == PF_INET6)
     {
       FAR sq_queue_t *queue = &g_ipv6_filters[chain];
+
+      ipfilter_jumptab_free(&g_ipv6_jumptabs[chain]);
       while (!sq_empty(queue))
         {
           kmm_free(sq_remfirst(queue));
@@ -463,6 +749,45 @@ void ipfilter_cfg_clear(sa_family_t family, enum ipfilter_chain_e chain)
 #endif
 }
 
+/****************************************************************************
+ * Name: ipfilter_cfg_commit
+ *
+ * Description:
+ *   Compile the chains of the given address family once all their entries
+ *   are added.
+ *
+ * Input Parameters:
+ *   family - The address family of the chains to compile
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ipfilter_cfg_commit(sa_family_t family)
+{
+  int chain;
+
+  for (chain = 0; chain < IPFILTER_CHAIN_MAX; chain++)
+    {
+#ifdef CONFIG_NET_IPv4
+      if (family == PF_INET)
+        {
+          ipfilter_jumptab_build(&g_ipv4_jumptabs[chain],
+                                 &g_ipv4_filters[chain]);
+        }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+      if (family == PF_INET6)
+        {
+          ipfilter_jumptab_build(&g_ipv6_jumptabs[chain],
+                                 &g_ipv6_filters[chain]);
+        }
+#endif
+    }
+}
+
 /****************************************************************************
  * Name: ipv4_filter_in / ipv6_filter_in
  *
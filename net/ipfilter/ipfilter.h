@@ -29,10 +29,12 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <nuttx/compiler.h>
 #include <nuttx/net/ip.h>
+#include <nuttx/net/netfilter/ipset.h>
 
 #ifdef CONFIG_NET_IPFILTER
 
@@ -82,10 +84,15 @@ struct ipfilter_entry_s
   uint8_t proto;          /* Protocol to match, 0 = ALL (Same as Linux) */
   int8_t  target;
 
+#ifdef CONFIG_NET_IPFILTER_SET
+  struct xt_set_info set; /* The set to match, IPv4 only */
+#endif
+
   /* Match flags, whether we need to match protocol in detail */
 
   uint8_t match_tcpudp : 1; /* Match TCP/UDP */
   uint8_t match_icmp   : 1; /* Match ICMP */
+  uint8_t match_set    : 1; /* Match a set */
 
   /* Inverse flags */
 
@@ -182,6 +189,128 @@ void ipfilter_cfg_add(FAR struct ipfilter_entry_s *entry,
 
 void ipfilter_cfg_clear(sa_family_t family, enum ipfilter_chain_e chain);
 
+/****************************************************************************
+ * Name: ipfilter_cfg_commit
+ *
+ * Description:
+ *   Compile the chains of the given address family once all their entries
+ *   are added:  The entries of each chain are sorted in jump tables by the
+ *   protocol they can match, so that a packet is only matched with the
+ *   entries of its protocol.  The chains changed since their last commit
+ *   are matched entry by entry.
+ *
+ * Input Parameters:
+ *   family - The address family of the chains to compile
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ipfilter_cfg_commit(sa_family_t family);
+
+/****************************************************************************
+ * Name: ipfilter_set_create
+ *
+ * Description:
+ *   Create an empty set.
+ *
+ * Input Parameters:
+ *   name - The name of the set
+ *   type - The type of the set, IPSET_TYPE_*
+ *
+ * Returned Value:
+ *   The index of the set on success, a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The network is locked, as for all the functions of the sets.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFILTER_SET
+int ipfilter_set_create(FAR const char *name, uint8_t type);
+
+/****************************************************************************
+ * Name: ipfilter_set_destroy
+ *
+ * Description:
+ *   Destroy a set that no rule matches any more.
+ *
+ * Returned Value:
+ *   Zero (OK) on success, -ENOENT if there is no such set, -EBUSY if rules
+ *   still match the set.
+ *
+ ****************************************************************************/
+
+int ipfilter_set_destroy(ip_set_id_t index);
+
+/****************************************************************************
+ * Name: ipfilter_set_flush
+ *
+ * Description:
+ *   Remove all the elements of a set.
+ *
+ ****************************************************************************/
+
+int ipfilter_set_flush(ip_set_id_t index);
+
+/****************************************************************************
+ * Name: ipfilter_set_find / ipfilter_set_name
+ *
+ * Description:
+ *   Find the index of a set by name, return the name of a set.
+ *
+ * Returned Value:
+ *   ipfilter_set_find() returns -ENOENT, ipfilter_set_name() NULL if there
+ *   is no such set.
+ *
+ ****************************************************************************/
+
+int ipfilter_set_find(FAR const char *name);
+FAR const char *ipfilter_set_name(ip_set_id_t index);
+
+/****************************************************************************
+ * Name: ipfilter_set_add / ipfilter_set_del
+ *
+ * Description:
+ *   Add an element to a set, or remove it.
+ *
+ * Input Parameters:
+ *   req - The element and the index of the set
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure:  -EEXIST if the
+ *   element is already in the set, -ENOENT if it is not.
+ *
+ ****************************************************************************/
+
+int ipfilter_set_add(FAR const struct ip_set_req_elem *req);
+int ipfilter_set_del(FAR const struct ip_set_req_elem *req);
+
+/****************************************************************************
+ * Name: ipfilter_set_hold / ipfilter_set_release
+ *
+ * Description:
+ *   Take or drop the reference of a rule to a set.
+ *
+ ****************************************************************************/
+
+int ipfilter_set_hold(ip_set_id_t index);
+void ipfilter_set_release(ip_set_id_t index);
+
+/****************************************************************************
+ * Name: ipfilter_set_match
+ *
+ * Description:
+ *   Test whether an address, and a port for the hash:ip,port sets, is in a
+ *   set.  The address and the port are in network order.
+ *
+ ****************************************************************************/
+
+bool ipfilter_set_match(ip_set_id_t index, in_addr_t ip, uint8_t proto,
+                        uint16_t port);
+#endif
+
 /****************************************************************************
  * Name: ipv4_filter_in / ipv6_filter_in
  *
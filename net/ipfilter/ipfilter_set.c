@@ -0,0 +1,1013 @@
+/****************************************************************************
+ * net/ipfilter/ipfilter_set.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <string.h>
+#include <strings.h>
+
+#include <sys/param.h>
+
+#include <nuttx/hashtable.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/netfilter/ipset.h>
+
+#include "ipfilter/ipfilter.h"
+#include "ipforward/ipforward.h"
+
+#ifdef CONFIG_NET_IPFILTER_SET
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The hash tables start with 16 buckets and double each time they hold as
+ * many elements as they have buckets.
+ */
+
+#define IPSET_HASH_MINBITS  4
+#define IPSET_HASH_MAXBITS  16
+
+/* The network mask of a prefix length, 1 to 32, in network order */
+
+#define IPSET_NETMASK(cidr) HTONL(UINT32_MAX << (32 - (cidr)))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* An element of the hash types, the key of a bucket */
+
+struct ipset_elem_s
+{
+  FAR struct ipset_elem_s *next;
+  in_addr_t ip;                     /* Network order, masked for hash:net */
+  uint16_t  port;                   /* Network order, for hash:ip,port */
+  uint8_t   proto;                  /* For hash:ip,port */
+  uint8_t   cidr;                   /* For hash:net */
+};
+
+/* An interval of addresses of the range type, in host order.  The ranges
+ * of a set are sorted, disjoint and not adjacent.
+ */
+
+struct ipset_range_s
+{
+  uint32_t first;
+  uint32_t last;
+};
+
+struct ipset_s
+{
+  char     name[IPSET_MAXNAMELEN];
+  uint8_t  type;                    /* IPSET_TYPE_* */
+  uint8_t  bits;                    /* log2 of the number of buckets */
+  uint16_t refs;                    /* Rules that match the set */
+  uint32_t nelems;                  /* Elements, or ranges */
+
+  union
+  {
+    struct
+    {
+      FAR struct ipset_elem_s **buckets;
+      uint64_t cidrs;               /* Bit n set if there are /n networks */
+      uint32_t ncidr[33];           /* The number of /n networks */
+    } hash;
+
+    struct
+    {
+      FAR struct ipset_range_s *ranges;
+      uint32_t nalloc;              /* Allocated ranges */
+    } range;
+  } u;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR struct ipset_s *g_ipsets[CONFIG_NET_IPFILTER_NSETS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipset_get
+ *
+ * Description:
+ *   Return the set with an index, NULL if there is none.
+ *
+ ****************************************************************************/
+
+static FAR struct ipset_s *ipset_get(ip_set_id_t index)
+{
+  return index < CONFIG_NET_IPFILTER_NSETS ? g_ipsets[index] : NULL;
+}
+
+/****************************************************************************
+ * Name: ipset_hash
+ *
+ * Description:
+ *   Return the bucket of the key of an element.
+ *
+ ****************************************************************************/
+
+static uint32_t ipset_hash(FAR const struct ipset_s *set,
+                           FAR const struct ipset_elem_s *key)
+{
+  uint32_t val = key->ip ^ ((uint32_t)key->port << 16 |
+                            (uint32_t)key->proto << 8 | key->cidr);
+
+  return HASH(val, set->bits);
+}
+
+/****************************************************************************
+ * Name: ipset_hash_search
+ *
+ * Description:
+ *   Return the link to the element with the key of 'key' in a hash set, or
+ *   to the end of its bucket if there is none.
+ *
+ ****************************************************************************/
+
+static FAR struct ipset_elem_s **
+ipset_hash_search(FAR struct ipset_s *set,
+                  FAR const struct ipset_elem_s *key)
+{
+  FAR struct ipset_elem_s **link;
+
+  link = &set->u.hash.buckets[ipset_hash(set, key)];
+  while (*link != NULL)
+    {
+      FAR struct ipset_elem_s *elem = *link;
+
+      if (elem->ip == key->ip && elem->port == key->port &&
+          elem->proto == key->proto && elem->cidr == key->cidr)
+        {
+          break;
+        }
+
+      link = &elem->next;
+    }
+
+  return link;
+}
+
+/****************************************************************************
+ * Name: ipset_hash_grow
+ *
+ * Description:
+ *   Double the buckets of a hash set.  The set keeps its buckets if the
+ *   memory is exhausted, its lookups are just slower.
+ *
+ ****************************************************************************/
+
+static void ipset_hash_grow(FAR struct ipset_s *set)
+{
+  FAR struct ipset_elem_s **buckets = set->u.hash.buckets;
+  FAR struct ipset_elem_s *elem;
+  uint32_t nbuckets = 1 << set->bits;
+  uint32_t i;
+
+  set->u.hash.buckets = kmm_zalloc(2 * nbuckets * sizeof(*buckets));
+  if (set->u.hash.buckets == NULL)
+    {
+      set->u.hash.buckets = buckets;
+      return;
+    }
+
+  set->bits++;
+  for (i = 0; i < nbuckets; i++)
+    {
+      while ((elem = buckets[i]) != NULL)
+        {
+          FAR struct ipset_elem_s **head =
+            &set->u.hash.buckets[ipset_hash(set, elem)];
+
+          buckets[i] = elem->next;
+          elem->next = *head;
+          *head      = elem;
+        }
+    }
+
+  kmm_free(buckets);
+}
+
+/****************************************************************************
+ * Name: ipset_hash_key
+ *
+ * Description:
+ *   Fill the key of an element of a hash set from a request.
+ *
+ ****************************************************************************/
+
+static int ipset_hash_key(FAR const struct ipset_s *set,
+                          FAR const struct ip_set_req_elem *req,
+                          FAR struct ipset_elem_s *key)
+{
+  memset(key, 0, sizeof(*key));
+  key->ip = req->ip;
+
+  switch (set->type)
+    {
+      case IPSET_TYPE_HASH_IPPORT:
+        key->proto = req->proto != 0 ? req->proto : IPPROTO_TCP;
+        key->port  = req->port;
+        if (key->proto != IPPROTO_TCP && key->proto != IPPROTO_UDP)
+          {
+            return -EINVAL;
+          }
+        break;
+
+      case IPSET_TYPE_HASH_NET:
+        key->cidr = req->cidr != 0 ? req->cidr : 32;
+        if (key->cidr > 32)
+          {
+            return -EINVAL;
+          }
+
+        key->ip &= IPSET_NETMASK(key->cidr);
+        break;
+
+      default:
+        break;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ipset_hash_add / ipset_hash_del
+ *
+ * Description:
+ *   Add or remove an element of a hash set.
+ *
+ ****************************************************************************/
+
+static int ipset_hash_add(FAR struct ipset_s *set,
+                          FAR const struct ip_set_req_elem *req)
+{
+  FAR struct ipset_elem_s **link;
+  FAR struct ipset_elem_s *elem;
+  struct ipset_elem_s key;
+  int ret;
+
+  ret = ipset_hash_key(set, req, &key);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  link = ipset_hash_search(set, &key);
+  if (*link != NULL)
+    {
+      return -EEXIST;
+    }
+
+  if (set->nelems >= CONFIG_NET_IPFILTER_SET_MAXELEM)
+    {
+      return -ENOSPC;
+    }
+
+  elem = kmm_malloc(sizeof(*elem));
+  if (elem == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  *elem = key;
+  *link = elem;
+
+  if (set->type == IPSET_TYPE_HASH_NET &&
+      set->u.hash.ncidr[key.cidr]++ == 0)
+    {
+      set->u.hash.cidrs |= (uint64_t)1 << key.cidr;
+    }
+
+  if (++set->nelems >= (1u << set->bits) && set->bits < IPSET_HASH_MAXBITS)
+    {
+      ipset_hash_grow(set);
+    }
+
+  return OK;
+}
+
+static int ipset_hash_del(FAR struct ipset_s *set,
+                          FAR const struct ip_set_req_elem *req)
+{
+  FAR struct ipset_elem_s **link;
+  FAR struct ipset_elem_s *elem;
+  struct ipset_elem_s key;
+  int ret;
+
+  ret = ipset_hash_key(set, req, &key);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  link = ipset_hash_search(set, &key);
+  elem = *link;
+  if (elem == NULL)
+    {
+      return -ENOENT;
+    }
+
+  *link = elem->next;
+  kmm_free(elem);
+  set->nelems--;
+
+  if (set->type == IPSET_TYPE_HASH_NET &&
+      --set->u.hash.ncidr[key.cidr] == 0)
+    {
+      set->u.hash.cidrs &= ~((uint64_t)1 << key.cidr);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ipset_hash_match
+ *
+ * Description:
+ *   Test whether a packet address (and port) is in a hash set.  The
+ *   networks of a hash:net set are tried from the longest prefix, with one
+ *   lookup for each prefix length in the set.
+ *
+ ****************************************************************************/
+
+static bool ipset_hash_match(FAR struct ipset_s *set, in_addr_t ip,
+                             uint8_t proto, uint16_t port)
+{
+  struct ipset_elem_s key;
+  uint64_t cidrs;
+
+  memset(&key, 0, sizeof(key));
+  key.ip = ip;
+
+  switch (set->type)
+    {
+      case IPSET_TYPE_HASH_IPPORT:
+        if (proto != IPPROTO_TCP && proto != IPPROTO_UDP)
+          {
+            return false;
+          }
+
+        key.proto = proto;
+        key.port  = port;
+        break;
+
+      case IPSET_TYPE_HASH_NET:
+        for (cidrs = set->u.hash.cidrs; cidrs != 0;
+             cidrs &= ~((uint64_t)1 << key.cidr))
+          {
+            key.cidr = flsll(cidrs) - 1;
+            key.ip   = ip & IPSET_NETMASK(key.cidr);
+            if (*ipset_hash_search(set, &key) != NULL)
+              {
+                return true;
+              }
+          }
+
+        return false;
+
+      default:
+        break;
+    }
+
+  return *ipset_hash_search(set, &key) != NULL;
+}
+
+/****************************************************************************
+ * Name: ipset_range_search
+ *
+ * Description:
+ *   Return the index of the first range of a set that ends at or after
+ *   'addr', the number of ranges if there is none.
+ *
+ ****************************************************************************/
+
+static uint32_t ipset_range_search(FAR const struct ipset_s *set,
+                                   uint32_t addr)
+{
+  FAR const struct ipset_range_s *ranges = set->u.range.ranges;
+  uint32_t lo = 0;
+  uint32_t hi = set->nelems;
+
+  while (lo < hi)
+    {
+      uint32_t mid = lo + (hi - lo) / 2;
+
+      if (ranges[mid].last < addr)
+        {
+          lo = mid + 1;
+        }
+      else
+        {
+          hi = mid;
+        }
+    }
+
+  return lo;
+}
+
+/****************************************************************************
+ * Name: ipset_range_reserve
+ *
+ * Description:
+ *   Make room for one more range in a set.
+ *
+ ****************************************************************************/
+
+static int ipset_range_reserve(FAR struct ipset_s *set)
+{
+  FAR struct ipset_range_s *ranges;
+  uint32_t nalloc;
+
+  if (set->nelems < set->u.range.nalloc)
+    {
+      return OK;
+    }
+
+  if (set->nelems >= CONFIG_NET_IPFILTER_SET_MAXELEM)
+    {
+      return -ENOSPC;
+    }
+
+  nalloc = set->u.range.nalloc != 0 ? 2 * set->u.range.nalloc :
+           1 << IPSET_HASH_MINBITS;
+  ranges = kmm_realloc(set->u.range.ranges, nalloc * sizeof(*ranges));
+  if (ranges == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  set->u.range.ranges = ranges;
+  set->u.range.nalloc = nalloc;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ipset_range_add
+ *
+ * Description:
+ *   Add a range of addresses to a set:  The ranges that overlap or adjoin
+ *   it are merged with it.
+ *
+ ****************************************************************************/
+
+static int ipset_range_add(FAR struct ipset_s *set, uint32_t first,
+                           uint32_t last)
+{
+  FAR struct ipset_range_s *ranges;
+  uint32_t i;
+  uint32_t j;
+  int ret;
+
+  i = ipset_range_search(set, first > 0 ? first - 1 : 0);
+  j = i;
+
+  ranges = set->u.range.ranges;
+  while (j < set->nelems && (uint64_t)ranges[j].first <= (uint64_t)last + 1)
+    {
+      j++;
+    }
+
+  if (j == i)
+    {
+      ret = ipset_range_reserve(set);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      ranges = set->u.range.ranges;
+      memmove(&ranges[i + 1], &ranges[i],
+              (set->nelems - i) * sizeof(*ranges));
+      set->nelems++;
+    }
+  else
+    {
+      if (j == i + 1 && ranges[i].first <= first && ranges[i].last >= last)
+        {
+          return -EEXIST;
+        }
+
+      first = MIN(first, ranges[i].first);
+      last  = MAX(last, ranges[j - 1].last);
+
+      memmove(&ranges[i + 1], &ranges[j],
+              (set->nelems - j) * sizeof(*ranges));
+      set->nelems -= j - i - 1;
+    }
+
+  ranges[i].first = first;
+  ranges[i].last  = last;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ipset_range_del
+ *
+ * Description:
+ *   Remove a range of addresses from a set:  The ranges that overlap it are
+ *   removed, trimmed or split.
+ *
+ ****************************************************************************/
+
+static int ipset_range_del(FAR struct ipset_s *set, uint32_t first,
+                           uint32_t last)
+{
+  FAR struct ipset_range_s *ranges = set->u.range.ranges;
+  uint32_t i;
+  int ret = -ENOENT;
+
+  i = ipset_range_search(set, first);
+  while (i < set->nelems && ranges[i].first <= last)
+    {
+      if (ranges[i].first < first && ranges[i].last > last)
+        {
+          /* Split the range around the removed one */
+
+          ret = ipset_range_reserve(set);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          ranges = set->u.range.ranges;
+          memmove(&ranges[i + 1], &ranges[i],
+                  (set->nelems - i) * sizeof(*ranges));
+          set->nelems++;
+
+          ranges[i].last      = first - 1;
+          ranges[i + 1].first = last + 1;
+          return OK;
+        }
+
+      ret = OK;
+      if (ranges[i].first < first)
+        {
+          ranges[i++].last = first - 1;
+        }
+      else if (ranges[i].last > last)
+        {
+          ranges[i].first = last + 1;
+          break;
+        }
+      else
+        {
+          memmove(&ranges[i], &ranges[i + 1],
+                  (set->nelems - i - 1) * sizeof(*ranges));
+          set->nelems--;
+        }
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ipset_range_bounds
+ *
+ * Description:
+ *   Get the range of addresses of a request, in host order.
+ *
+ ****************************************************************************/
+
+static int ipset_range_bounds(FAR const struct ip_set_req_elem *req,
+                              FAR uint32_t *first, FAR uint32_t *last)
+{
+  *first = NTOHL(req->ip);
+  *last  = req->ip_to != 0 ? NTOHL(req->ip_to) : *first;
+
+  return *first <= *last ? OK : -EINVAL;
+}
+
+/****************************************************************************
+ * Name: ipset_flush
+ *
+ * Description:
+ *   Remove all the elements of a set.
+ *
+ ****************************************************************************/
+
+static void ipset_flush(FAR struct ipset_s *set)
+{
+  FAR struct ipset_elem_s *elem;
+  uint32_t i;
+
+  if (set->type == IPSET_TYPE_RANGE_IP)
+    {
+      set->nelems = 0;
+      return;
+    }
+
+  for (i = 0; i < (1u << set->bits); i++)
+    {
+      while ((elem = set->u.hash.buckets[i]) != NULL)
+        {
+          set->u.hash.buckets[i] = elem->next;
+          kmm_free(elem);
+        }
+    }
+
+  memset(set->u.hash.ncidr, 0, sizeof(set->u.hash.ncidr));
+  set->u.hash.cidrs = 0;
+  set->nelems       = 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipfilter_set_create
+ *
+ * Description:
+ *   Create an empty set.
+ *
+ * Input Parameters:
+ *   name - The name of the set
+ *   type - The type of the set, IPSET_TYPE_*
+ *
+ * Returned Value:
+ *   The index of the set on success, a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int ipfilter_set_create(FAR const char *name, uint8_t type)
+{
+  FAR struct ipset_s *set;
+  int index = -ENOSPC;
+  int i;
+
+  if (name[0] == '\0' || strnlen(name, IPSET_MAXNAMELEN) ==
+      IPSET_MAXNAMELEN || type < IPSET_TYPE_HASH_IP ||
+      type > IPSET_TYPE_RANGE_IP)
+    {
+      return -EINVAL;
+    }
+
+  for (i = CONFIG_NET_IPFILTER_NSETS - 1; i >= 0; i--)
+    {
+      if (g_ipsets[i] == NULL)
+        {
+          index = i;
+        }
+      else if (strcmp(g_ipsets[i]->name, name) == 0)
+        {
+          return -EEXIST;
+        }
+    }
+
+  if (index < 0)
+    {
+      return index;
+    }
+
+  set = kmm_zalloc(sizeof(*set));
+  if (set == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  if (type != IPSET_TYPE_RANGE_IP)
+    {
+      set->bits = IPSET_HASH_MINBITS;
+      set->u.hash.buckets = kmm_zalloc(sizeof(FAR struct ipset_elem_s *) <<
+                                       IPSET_HASH_MINBITS);
+      if (set->u.hash.buckets == NULL)
+        {
+          kmm_free(set);
+          return -ENOMEM;
+        }
+    }
+
+  strlcpy(set->name, name, sizeof(set->name));
+  set->type       = type;
+  g_ipsets[index] = set;
+  return index;
+}
+
+/****************************************************************************
+ * Name: ipfilter_set_destroy
+ *
+ * Description:
+ *   Destroy a set that no rule matches any more.
+ *
+ * Input Parameters:
+ *   index - The index of the set
+ *
+ * Returned Value:
+ *   Zero (OK) on success, -ENOENT if there is no such set, -EBUSY if rules
+ *   still match the set.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int ipfilter_set_destroy(ip_set_id_t index)
+{
+  FAR struct ipset_s *set = ipset_get(index);
+
+  if (set == NULL)
+    {
+      return -ENOENT;
+    }
+
+  if (set->refs > 0)
+    {
+      return -EBUSY;
+    }
+
+  ipset_flush(set);
+  if (set->type == IPSET_TYPE_RANGE_IP)
+    {
+      kmm_free(set->u.range.ranges);
+    }
+  else
+    {
+      kmm_free(set->u.hash.buckets);
+    }
+
+  kmm_free(set);
+  g_ipsets[index] = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ipfilter_set_flush
+ *
+ * Description:
+ *   Remove all the elements of a set.
+ *
+ * Returned Value:
+ *   Zero (OK) on success, -ENOENT if there is no such set.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int ipfilter_set_flush(ip_set_id_t index)
+{
+  FAR struct ipset_s *set = ipset_get(index);
+
+  if (set == NULL)
+    {
+      return -ENOENT;
+    }
+
+  ipset_flush(set);
+  ipfwd_flowcache_flush();
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ipfilter_set_find
+ *
+ * Description:
+ *   Find a set by name.
+ *
+ * Returned Value:
+ *   The index of the set, -ENOENT if there is no such set.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int ipfilter_set_find(FAR const char *name)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_NET_IPFILTER_NSETS; i++)
+    {
+      if (g_ipsets[i] != NULL &&
+          strncmp(g_ipsets[i]->name, name, IPSET_MAXNAMELEN) == 0)
+        {
+          return i;
+        }
+    }
+
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: ipfilter_set_name
+ *
+ * Description:
+ *   Return the name of a set, NULL if there is no such set.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR const char *ipfilter_set_name(ip_set_id_t index)
+{
+  FAR struct ipset_s *set = ipset_get(index);
+
+  return set != NULL ? set->name : NULL;
+}
+
+/****************************************************************************
+ * Name: ipfilter_set_add / ipfilter_set_del
+ *
+ * Description:
+ *   Add an element to a set, or remove it.  A range of a range set may
+ *   cover or split the ranges already in the set.
+ *
+ * Input Parameters:
+ *   req - The element and the index of the set
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure:  -EEXIST if the
+ *   element is already in the set, -ENOENT if it is not.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int ipfilter_set_add(FAR const struct ip_set_req_elem *req)
+{
+  FAR struct ipset_s *set = ipset_get(req->index);
+  uint32_t first;
+  uint32_t last;
+  int ret;
+
+  if (set == NULL)
+    {
+      return -ENOENT;
+    }
+
+  if (set->type != IPSET_TYPE_RANGE_IP)
+    {
+      ret = ipset_hash_add(set, req);
+    }
+  else
+    {
+      ret = ipset_range_bounds(req, &first, &last);
+      if (ret >= 0)
+        {
+          ret = ipset_range_add(set, first, last);
+        }
+    }
+
+  /* The cached verdicts of the forwarded flows may depend on the set */
+
+  if (ret >= 0)
+    {
+      ipfwd_flowcache_flush();
+    }
+
+  return ret;
+}
+
+int ipfilter_set_del(FAR const struct ip_set_req_elem *req)
+{
+  FAR struct ipset_s *set = ipset_get(req->index);
+  uint32_t first;
+  uint32_t last;
+  int ret;
+
+  if (set == NULL)
+    {
+      return -ENOENT;
+    }
+
+  if (set->type != IPSET_TYPE_RANGE_IP)
+    {
+      ret = ipset_hash_del(set, req);
+    }
+  else
+    {
+      ret = ipset_range_bounds(req, &first, &last);
+      if (ret >= 0)
+        {
+          ret = ipset_range_del(set, first, last);
+        }
+    }
+
+  if (ret >= 0)
+    {
+      ipfwd_flowcache_flush();
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ipfilter_set_hold / ipfilter_set_release
+ *
+ * Description:
+ *   Take or drop the reference of a rule to a set, so that the set is not
+ *   destroyed while rules match it.
+ *
+ * Returned Value:
+ *   ipfilter_set_hold() returns zero (OK) on success, -ENOENT if there is
+ *   no such set.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int ipfilter_set_hold(ip_set_id_t index)
+{
+  FAR struct ipset_s *set = ipset_get(index);
+
+  if (set == NULL)
+    {
+      return -ENOENT;
+    }
+
+  set->refs++;
+  return OK;
+}
+
+void ipfilter_set_release(ip_set_id_t index)
+{
+  FAR struct ipset_s *set = ipset_get(index);
+
+  if (set != NULL && set->refs > 0)
+    {
+      set->refs--;
+    }
+}
+
+/****************************************************************************
+ * Name: ipfilter_set_match
+ *
+ * Description:
+ *   Test whether an address, and a port for the hash:ip,port sets, is in a
+ *   set.  The cost of the test does not depend on the size of the hash
+ *   sets, it is logarithmic for the range sets.
+ *
+ * Input Parameters:
+ *   index - The index of the set
+ *   ip    - The address, in network order
+ *   proto - The protocol of the packet
+ *   port  - The port, in network order
+ *
+ * Returned Value:
+ *   true if the element is in the set.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool ipfilter_set_match(ip_set_id_t index, in_addr_t ip, uint8_t proto,
+                        uint16_t port)
+{
+  FAR struct ipset_s *set = ipset_get(index);
+  uint32_t addr;
+  uint32_t i;
+
+  if (set == NULL || set->nelems == 0)
+    {
+      return false;
+    }
+
+  if (set->type != IPSET_TYPE_RANGE_IP)
+    {
+      return ipset_hash_match(set, ip, proto, port);
+    }
+
+  addr = NTOHL(ip);
+  i    = ipset_range_search(set, addr);
+  return i < set->nelems && set->u.range.ranges[i].first <= addr;
+}
+
+#endif /* CONFIG_NET_IPFILTER_SET */
@@ -32,6 +32,8 @@
 #include <assert.h>
 #include <stdint.h>
 
+#include <netinet/in.h>
+
 #undef HAVE_FWDALLOC
 #ifdef CONFIG_NET_IPFORWARD
 
@@ -76,6 +78,22 @@ struct forward_s
 #endif
 };
 
+/* The identity of an IPv4 flow in the flow cache.  The ports are the ICMP
+ * type and code for ICMP, zero for the other protocols.
+ */
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+struct ipv4_flowkey_s
+{
+  FAR struct net_driver_s     *fk_dev;      /* The receiving device */
+  in_addr_t                    fk_srcipaddr;
+  in_addr_t                    fk_destipaddr;
+  uint16_t                     fk_srcport;
+  uint16_t                     fk_destport;
+  uint8_t                      fk_proto;
+};
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -368,5 +386,70 @@ void ipv4_dropstats(FAR struct ipv4_hdr_s *ipv4);
 #  define ipv4_dropstats(ipv4)
 #endif
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+/****************************************************************************
+ * Name: ipv4_flowcache_key
+ *
+ * Description:
+ *   Get the flow of an IPv4 packet received on 'dev'.  This must be done
+ *   before NAT rewrites the packet.
+ *
+ ****************************************************************************/
+
+void ipv4_flowcache_key(FAR struct net_driver_s *dev,
+                        FAR const struct ipv4_hdr_s *ipv4,
+                        FAR struct ipv4_flowkey_s *key);
+
+/****************************************************************************
+ * Name: ipv4_flowcache_lookup
+ *
+ * Description:
+ *   Return the forwarding device of a flow if the flow was forwarded
+ *   recently and the configuration did not change since then, otherwise
+ *   NULL.
+ *
+ * Assumptions:
+ *   The caller holds the network lock.
+ *
+ ****************************************************************************/
+
+FAR struct net_driver_s *
+ipv4_flowcache_lookup(FAR const struct ipv4_flowkey_s *key);
+
+/****************************************************************************
+ * Name: ipv4_flowcache_add
+ *
+ * Description:
+ *   Remember that a flow is forwarded through 'fwddev', after it passed the
+ *   FORWARD filter chain.  The entry replaces any other flow that maps to
+ *   the same entry of the cache.
+ *
+ * Assumptions:
+ *   The caller holds the network lock.
+ *
+ ****************************************************************************/
+
+void ipv4_flowcache_add(FAR const struct ipv4_flowkey_s *key,
+                        FAR struct net_driver_s *fwddev);
+#endif
+
 #endif /* CONFIG_NET_IPFORWARD */
+
+/****************************************************************************
+ * Name: ipfwd_flowcache_flush
+ *
+ * Description:
+ *   Forget all the cached forwarding decisions.  Called when a route, an
+ *   IPv4 address, a filter rule or the state of a device changes.
+ *
+ * Assumptions:
+ *   May be called with or without the network lock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+void ipfwd_flowcache_flush(void);
+#else
+#  define ipfwd_flowcache_flush()
+#endif
 #endif /* __NET_IPFORWARD_IPFORWARD_H */
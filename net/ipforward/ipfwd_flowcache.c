@@ -0,0 +1,247 @@
+/****************************************************************************
+ * net/ipforward/ipfwd_flowcache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/hashtable.h>
+#include <nuttx/net/icmp.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/udp.h>
+
+#include "ipforward/ipforward.h"
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define FLOWCACHE_SIZE       (1 << CONFIG_NET_IPFORWARD_FLOWCACHE_BITS)
+#define FLOWCACHE_EXPIRE_TICK \
+  SEC2TICK(CONFIG_NET_IPFORWARD_FLOWCACHE_EXPIRE_SEC)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* An entry of the flow cache.  The entry is valid only if its generation is
+ * the current one:  A flush takes a new generation.
+ */
+
+struct ipv4_flow_s
+{
+  struct ipv4_flowkey_s    fl_key;     /* The flow */
+  FAR struct net_driver_s *fl_fwddev;  /* The forwarding device */
+  clock_t                  fl_time;    /* When the flow was added */
+  uint32_t                 fl_gen;     /* The generation of the entry */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct ipv4_flow_s g_ipv4_flows[FLOWCACHE_SIZE];
+
+/* The current generation, never zero so that unused entries are invalid */
+
+static uint32_t g_ipv4_flowgen = 1;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipv4_flowcache_entry
+ *
+ * Description:
+ *   Return the entry of the cache where a flow may be.
+ *
+ ****************************************************************************/
+
+static FAR struct ipv4_flow_s *
+ipv4_flowcache_entry(FAR const struct ipv4_flowkey_s *key)
+{
+  uint32_t hash = key->fk_srcipaddr ^ key->fk_destipaddr ^
+                  ((uint32_t)key->fk_srcport << 16 | key->fk_destport) ^
+                  key->fk_proto;
+
+  return &g_ipv4_flows[HASH(hash, CONFIG_NET_IPFORWARD_FLOWCACHE_BITS)];
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipv4_flowcache_key
+ *
+ * Description:
+ *   Get the flow of an IPv4 packet received on 'dev'.  This must be done
+ *   before NAT rewrites the packet.
+ *
+ ****************************************************************************/
+
+void ipv4_flowcache_key(FAR struct net_driver_s *dev,
+                        FAR const struct ipv4_hdr_s *ipv4,
+                        FAR struct ipv4_flowkey_s *key)
+{
+  FAR const uint8_t *l4hdr;
+  unsigned int hdrlen;
+
+  memset(key, 0, sizeof(*key));
+  key->fk_dev        = dev;
+  key->fk_srcipaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
+  key->fk_destipaddr = net_ip4addr_conv32(ipv4->destipaddr);
+  key->fk_proto      = ipv4->proto;
+
+  /* The ports, or the ICMP type and code, are in the first 4 bytes of the
+   * L4 header, which follows the IPv4 header in the device buffer.
+   */
+
+  hdrlen = (ipv4->vhl & IPv4_HLMASK) << 2;
+  if (hdrlen + 4 > dev->d_len)
+    {
+      return;
+    }
+
+  l4hdr = (FAR const uint8_t *)ipv4 + hdrlen;
+
+  switch (ipv4->proto)
+    {
+      case IP_PROTO_TCP:
+      case IP_PROTO_UDP:
+        {
+          /* Ports in TCP & UDP headers have same offset. */
+
+          FAR const struct udp_hdr_s *udp =
+            (FAR const struct udp_hdr_s *)l4hdr;
+
+          key->fk_srcport  = udp->srcport;
+          key->fk_destport = udp->destport;
+        }
+        break;
+
+      case IP_PROTO_ICMP:
+        {
+          FAR const struct icmp_hdr_s *icmp =
+            (FAR const struct icmp_hdr_s *)l4hdr;
+
+          key->fk_srcport  = icmp->type;
+          key->fk_destport = icmp->icode;
+        }
+        break;
+
+      default:
+        break;
+    }
+}
+
+/****************************************************************************
+ * Name: ipv4_flowcache_lookup
+ *
+ * Description:
+ *   Return the forwarding device of a flow if the flow was forwarded
+ *   recently and the configuration did not change since then, otherwise
+ *   NULL.
+ *
+ * Assumptions:
+ *   The caller holds the network lock.
+ *
+ ****************************************************************************/
+
+FAR struct net_driver_s *
+ipv4_flowcache_lookup(FAR const struct ipv4_flowkey_s *key)
+{
+  FAR struct ipv4_flow_s *flow = ipv4_flowcache_entry(key);
+
+  if (flow->fl_gen != g_ipv4_flowgen ||
+      memcmp(&flow->fl_key, key, sizeof(*key)) != 0 ||
+      clock_systime_ticks() - flow->fl_time > FLOWCACHE_EXPIRE_TICK ||
+      !IFF_IS_UP(flow->fl_fwddev->d_flags))
+    {
+      return NULL;
+    }
+
+  return flow->fl_fwddev;
+}
+
+/****************************************************************************
+ * Name: ipv4_flowcache_add
+ *
+ * Description:
+ *   Remember that a flow is forwarded through 'fwddev', after it passed the
+ *   FORWARD filter chain.  The entry replaces any other flow that maps to
+ *   the same entry of the cache.
+ *
+ * Assumptions:
+ *   The caller holds the network lock.
+ *
+ ****************************************************************************/
+
+void ipv4_flowcache_add(FAR const struct ipv4_flowkey_s *key,
+                        FAR struct net_driver_s *fwddev)
+{
+  FAR struct ipv4_flow_s *flow = ipv4_flowcache_entry(key);
+
+  memcpy(&flow->fl_key, key, sizeof(*key));
+  flow->fl_fwddev = fwddev;
+  flow->fl_time   = clock_systime_ticks();
+  flow->fl_gen    = g_ipv4_flowgen;
+}
+
+/****************************************************************************
+ * Name: ipfwd_flowcache_flush
+ *
+ * Description:
+ *   Forget all the cached forwarding decisions.  Called when a route, an
+ *   IPv4 address, a filter rule or the state of a device changes.
+ *
+ * Assumptions:
+ *   May be called with or without the network lock.
+ *
+ ****************************************************************************/
+
+void ipfwd_flowcache_flush(void)
+{
+  net_lock();
+
+  if (++g_ipv4_flowgen == 0)
+    {
+      /* The generations wrapped:  Old entries could become valid again */
+
+      memset(g_ipv4_flows, 0, sizeof(g_ipv4_flows));
+      g_ipv4_flowgen = 1;
+    }
+
+  net_unlock();
+}
+
+#endif /* CONFIG_NET_IPFORWARD_FLOWCACHE */
@@ -26,6 +26,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <string.h>
 #include <assert.h>
 #include <debug.h>
@@ -199,6 +200,8 @@ static int ipv4_decr_ttl(FAR struct ipv4_hdr_s *ipv4)
  *              contains the IPv4 packet.
  *   fwdddev  - The device on which the packet must be forwarded.
  *   ipv4     - A pointer to the IPv4 header in within the IPv4 packet
+ *   filter   - False if the flow of the packet already passed the FORWARD
+ *              filter chain
  *
  * Returned Value:
  *   Zero is returned if the packet was successfully forward;  A negated
@@ -209,7 +212,7 @@ static int ipv4_decr_ttl(FAR struct ipv4_hdr_s *ipv4)
 
 static int ipv4_dev_forward(FAR struct net_driver_s *dev,
                             FAR struct net_driver_s *fwddev,
-                            FAR struct ipv4_hdr_s *ipv4)
+                            FAR struct ipv4_hdr_s *ipv4, bool filter)
 {
   FAR struct forward_s *fwd = NULL;
 #ifdef CONFIG_DEBUG_NET_WARN
@@ -222,7 +225,7 @@ static int ipv4_dev_forward(FAR struct net_driver_s *dev,
    * replying any other errors.
    */
 
-  ret = ipv4_filter_fwd(dev, fwddev, ipv4);
+  ret = filter ? ipv4_filter_fwd(dev, fwddev, ipv4) : OK;
   if (ret < 0)
     {
       ninfo("Drop/Reject FORWARD packet due to filter %d\n", ret);
@@ -403,7 +406,7 @@ static int ipv4_forward_callback(FAR struct net_driver_s *fwddev,
 
       /* Send the packet asynchrously on the forwarding device. */
 
-      ret = ipv4_dev_forward(dev, fwddev, ipv4);
+      ret = ipv4_dev_forward(dev, fwddev, ipv4, true);
       if (ret < 0)
         {
           iob_free_chain(iob);
@@ -458,23 +461,42 @@ int ipv4_forward(FAR struct net_driver_s *dev, FAR struct ipv4_hdr_s *ipv4)
   in_addr_t destipaddr;
   in_addr_t srcipaddr;
   FAR struct net_driver_s *fwddev;
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  struct ipv4_flowkey_s key;
+#endif
+  bool filter = true;
   int ret;
 #if defined(CONFIG_NET_ICMP) && !defined(CONFIG_NET_ICMP_NO_STACK)
   int icmp_reply_type;
   int icmp_reply_code;
 #endif /* CONFIG_NET_ICMP */
 
-  /* Search for a device that can forward this packet. */
-
-  destipaddr = net_ip4addr_conv32(ipv4->destipaddr);
-  srcipaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Reuse the forwarding decision of the flow if it is cached, the packet
+   * then skips the route lookup and the FORWARD filter chain.
+   */
 
-  fwddev     = netdev_findby_ripv4addr(srcipaddr, destipaddr);
-  if (fwddev == NULL)
+  ipv4_flowcache_key(dev, ipv4, &key);
+  fwddev = ipv4_flowcache_lookup(&key);
+  if (fwddev != NULL)
     {
-      nwarn("WARNING: Not routable\n");
-      ret = -ENETUNREACH;
-      goto drop;
+      filter = false;
+    }
+  else
+#endif
+    {
+      /* Search for a device that can forward this packet. */
+
+      destipaddr = net_ip4addr_conv32(ipv4->destipaddr);
+      srcipaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
+
+      fwddev     = netdev_findby_ripv4addr(srcipaddr, destipaddr);
+      if (fwddev == NULL)
+        {
+          nwarn("WARNING: Not routable\n");
+          ret = -ENETUNREACH;
+          goto drop;
+        }
     }
 
   /* Check if we are forwarding on the same device that we received the
@@ -485,12 +507,19 @@ int ipv4_forward(FAR struct net_driver_s *dev, FAR struct ipv4_hdr_s *ipv4)
     {
       /* Send the packet asynchrously on the forwarding device. */
 
-      ret = ipv4_dev_forward(dev, fwddev, ipv4);
+      ret = ipv4_dev_forward(dev, fwddev, ipv4, filter);
       if (ret < 0)
         {
           nwarn("WARNING: ipv4_dev_forward failed: %d\n", ret);
           goto drop;
         }
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      if (filter)
+        {
+          ipv4_flowcache_add(&key, fwddev);
+        }
+#endif
     }
   else
     {
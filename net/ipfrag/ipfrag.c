@@ -50,6 +50,7 @@
 #include "inet/inet.h"
 #include "icmp/icmp.h"
 #include "icmpv6/icmpv6.h"
+#include "utils/utils.h"
 #include "ipfrag.h"
 
 /****************************************************************************
@@ -94,7 +95,11 @@ do  \
 
 /* The maximum I/O buffer occupied by fragment reassembly cache */
 
-#define REASSEMBLY_MAXOCCUPYIOB        CONFIG_IOB_NBUFFERS / 5
+#if CONFIG_NET_IPFRAG_REASS_MAXIOB > 0
+#  define REASSEMBLY_MAXOCCUPYIOB      CONFIG_NET_IPFRAG_REASS_MAXIOB
+#else
+#  define REASSEMBLY_MAXOCCUPYIOB      (CONFIG_IOB_NBUFFERS / 5)
+#endif
 
 /* Deciding whether to fragment outgoing packets which target is to ourself */
 
@@ -115,21 +120,23 @@ static struct wdog_s g_wdfragtimeout;
 
 static struct work_s g_wkfragtimeout;
 
-/* Remember the number of I/O buffers currently in reassembly cache */
+/* Remember the number of I/O buffers and of datagrams currently in
+ * reassembly cache
+ */
 
-static uint8_t       g_bufoccupy;
+static uint16_t      g_bufoccupy;
+static uint16_t      g_nodecnt;
 
-/* Queue header definition, it links all fragments of all NICs by ascending
- * ipid.
- */
+/* Hash table of the datagrams of all NICs, by the key of the datagrams */
 
-static sq_queue_t    g_assemblyhead_ipid;
+static DECLARE_HASHTABLE(g_assemblyhead_ipid,
+                         CONFIG_NET_IPFRAG_REASS_HASH_BITS);
 
 /* Queue header definition, which connects all fragments of all NICs in order
  * of addition time.
  */
 
-static sq_queue_t    g_assemblyhead_time;
+static dq_queue_t    g_assemblyhead_time;
 
 /****************************************************************************
  * Public Data
@@ -149,8 +156,9 @@ static void ip_fragin_timerout_expiry(wdparm_t arg);
 static void ip_fragin_timerwork(FAR void *arg);
 static inline FAR struct ip_fraglink_s *
 ip_fragin_freelink(FAR struct ip_fraglink_s *fraglink);
-static void ip_fragin_check(FAR struct ip_fragsnode_s *fragsnode);
-static void ip_fragin_cachemonitor(FAR struct ip_fragsnode_s *curnode);
+static void ip_fragin_dropnode(FAR struct ip_fragsnode_s *node);
+static void ip_fragin_cachemonitor(FAR struct ip_fragsnode_s *curnode,
+                                   uint32_t bufcnt);
 static inline FAR struct iob_s *
 ip_fragout_allocfragbuf(FAR struct iob_queue_s *fragq);
 
@@ -193,8 +201,8 @@ static void ip_fragin_timerwork(FAR void *arg)
 {
   clock_t curtick = clock_systime_ticks();
   sclock_t interval = 0;
-  FAR sq_entry_t *entry;
-  FAR sq_entry_t *entrynext;
+  FAR dq_entry_t *entry;
+  FAR dq_entry_t *entrynext;
   FAR struct ip_fragsnode_s *node;
 
   ninfo("Start reassembly work queue\n");
@@ -205,13 +213,12 @@ static void ip_fragin_timerwork(FAR void *arg)
    * interval
    */
 
-  entry = sq_peek(&g_assemblyhead_time);
+  entry = dq_peek(&g_assemblyhead_time);
   while (entry != NULL)
     {
-      entrynext = sq_next(entry);
+      entrynext = dq_next(entry);
 
-      node = (FAR struct ip_fragsnode_s *)
-             container_of(entry, FAR struct ip_fragsnode_s, flinkat);
+      node = container_of(entry, struct ip_fragsnode_s, flinkat);
 
       /* Check for timeout, be careful with the calculation formula,
        * the tick counter may overflow
@@ -270,22 +277,9 @@ static void ip_fragin_timerwork(FAR void *arg)
             }
 #endif
 
-          /* Remove fragments of this node */
-
-          if (node->frags != NULL)
-            {
-              FAR struct ip_fraglink_s *fraglink = node->frags;
-
-              while (fraglink)
-                {
-                  fraglink = ip_fragin_freelink(fraglink);
-                }
-            }
-
-          /* Remove node from single-list and free node memory */
+          /* Remove fragments of this node and free node memory */
 
-          ip_frag_remnode(node);
-          kmm_free(node);
+          ip_fragin_dropnode(node);
         }
       else
         {
@@ -305,7 +299,7 @@ static void ip_fragin_timerwork(FAR void *arg)
 
   /* Be sure to start the timer, if there are nodes in the linked list */
 
-  if (sq_peek(&g_assemblyhead_time) != NULL)
+  if (!dq_empty(&g_assemblyhead_time))
     {
       clock_t delay = REASSEMBLY_TIMEOUT_MINIMALTICKS;
 
@@ -363,114 +357,211 @@ ip_fragin_freelink(FAR struct ip_fraglink_s *fraglink)
 }
 
 /****************************************************************************
- * Name: ip_fragin_check
+ * Name: ip_fragin_getkey
  *
  * Description:
- *   Check whether the zero fragment has been received or all fragments have
- *   been received.
+ *   Get the key of the datagram of a fragment from its IP header.
  *
- * Input Parameters:
- *   fragsnode - node of the upper-level linked list, it maintains
- *               information bout all fragments belonging to an IP datagram
+ ****************************************************************************/
+
+static void ip_fragin_getkey(FAR const struct ip_fraglink_s *fraglink,
+                             FAR struct ip_fragkey_s *key)
+{
+  FAR const uint8_t *iphdr = fraglink->frag->io_data +
+                             fraglink->frag->io_offset;
+
+  memset(key, 0, sizeof(*key));
+  key->ipid   = fraglink->ipid;
+  key->isipv4 = fraglink->isipv4;
+
+#ifdef CONFIG_NET_IPv4
+  if (fraglink->isipv4)
+    {
+      FAR const struct ipv4_hdr_s *ipv4 =
+        (FAR const struct ipv4_hdr_s *)iphdr;
+
+      key->srcipaddr.ipv4  = net_ip4addr_conv32(ipv4->srcipaddr);
+      key->destipaddr.ipv4 = net_ip4addr_conv32(ipv4->destipaddr);
+      key->proto           = ipv4->proto;
+      return;
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  net_ipv6addr_copy(key->srcipaddr.ipv6,
+                    ((FAR const struct ipv6_hdr_s *)iphdr)->srcipaddr);
+  net_ipv6addr_copy(key->destipaddr.ipv6,
+                    ((FAR const struct ipv6_hdr_s *)iphdr)->destipaddr);
+#endif
+}
+
+/****************************************************************************
+ * Name: ip_fragin_hash
  *
- * Returned Value:
- *   None
+ * Description:
+ *   Fold the key of a datagram into the key of the hash table.
  *
  ****************************************************************************/
 
-static void ip_fragin_check(FAR struct ip_fragsnode_s *fragsnode)
+static uint32_t ip_fragin_hash(FAR const struct ip_fragkey_s *key)
 {
-  uint16_t formerlen = 0;
-  FAR struct ip_fraglink_s *entry;
+  uint32_t hash = key->ipid ^ key->proto;
 
-  if (fragsnode->verifyflag & IP_FRAGVERIFY_RECVDTAILFRAG)
+#ifdef CONFIG_NET_IPv4
+  if (key->isipv4)
     {
-      entry = fragsnode->frags;
-      while (entry != NULL)
-        {
-          if (entry->morefrags)
-            {
-              formerlen += entry->fraglen;
-            }
-          else
-            {
-              /* Only the last entry has a 0 morefrags flag */
+      return hash ^ key->srcipaddr.ipv4 ^ (key->destipaddr.ipv4 << 7 |
+                                           key->destipaddr.ipv4 >> 25);
+    }
+#endif
 
-              if (entry->fragoff == formerlen)
-                {
-                  fragsnode->verifyflag |= IP_FRAGVERIFY_RECVDALLFRAGS;
-                }
-            }
+#ifdef CONFIG_NET_IPv6
+  hash ^= (uint32_t)key->srcipaddr.ipv6[6] << 16 | key->srcipaddr.ipv6[7];
+  hash ^= (uint32_t)key->destipaddr.ipv6[7] << 16 |
+          key->destipaddr.ipv6[6];
+#endif
 
-          entry = entry->flink;
-        }
-    }
+  return hash;
 }
 
 /****************************************************************************
- * Name: ip_fragin_cachemonitor
+ * Name: ip_fragin_findnode
  *
  * Description:
- *   Check the reassembly cache buffer size, if it exceeds the configured
- *   threshold, some I/O buffers need to be freed
+ *   Find the node of the datagram with a key received by a NIC.
  *
- * Input Parameters:
- *   curnode - node of the upper-level linked list, it maintains information
- *             about all fragments belonging to an IP datagram
+ ****************************************************************************/
+
+static FAR struct ip_fragsnode_s *
+ip_fragin_findnode(FAR struct net_driver_s *dev,
+                   FAR const struct ip_fragkey_s *key)
+{
+  FAR hash_node_t *p;
+
+  hashtable_for_every_possible(g_assemblyhead_ipid, p, ip_fragin_hash(key))
+    {
+      FAR struct ip_fragsnode_s *node =
+        container_of(p, struct ip_fragsnode_s, flink);
+
+      if (node->dev == dev && memcmp(&node->key, key, sizeof(*key)) == 0)
+        {
+          return node;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: ip_fragin_allocnode
  *
- * Returned Value:
- *   none
+ * Description:
+ *   Allocate and insert the node of a new datagram.  The oldest datagram is
+ *   evicted if CONFIG_NET_IPFRAG_REASS_MAXNODES datagrams are already in
+ *   reassembly.
  *
  ****************************************************************************/
 
-static void ip_fragin_cachemonitor(FAR struct ip_fragsnode_s *curnode)
+static FAR struct ip_fragsnode_s *
+ip_fragin_allocnode(FAR struct net_driver_s *dev,
+                    FAR const struct ip_fragkey_s *key)
 {
-  uint32_t        cleancnt = 0;
-  uint32_t        bufcnt;
-  FAR sq_entry_t *entry;
-  FAR sq_entry_t *entrynext;
   FAR struct ip_fragsnode_s *node;
 
-  /* Start cache cleaning if g_bufoccupy exceeds the cache threshold */
+  if (g_nodecnt >= CONFIG_NET_IPFRAG_REASS_MAXNODES)
+    {
+      ninfo("Evict the oldest datagram in reassembly\n");
+      ip_fragin_dropnode(container_of(dq_peek(&g_assemblyhead_time),
+                                      struct ip_fragsnode_s, flinkat));
+    }
 
-  if (g_bufoccupy > REASSEMBLY_MAXOCCUPYIOB)
+  node = kmm_zalloc(sizeof(struct ip_fragsnode_s));
+  if (node == NULL)
     {
-      cleancnt = g_bufoccupy - REASSEMBLY_MAXOCCUPYIOB;
-      entry = sq_peek(&g_assemblyhead_time);
+      return NULL;
+    }
 
-      while (entry != NULL && cleancnt > 0)
-        {
-          entrynext = sq_next(entry);
+  node->dev  = dev;
+  node->key  = *key;
+  node->tick = clock_systime_ticks();
 
-          node = (FAR struct ip_fragsnode_s *)
-                 container_of(entry, FAR struct ip_fragsnode_s, flinkat);
+  hashtable_add(g_assemblyhead_ipid, &node->flink, ip_fragin_hash(key));
 
-          /* Skip specified node */
+  /* Add this new node to the tail of linked list identified by
+   * g_assemblyhead_time
+   */
 
-          if (node != curnode)
-            {
-              /* Remove fragments of this node */
+  dq_addlast(&node->flinkat, &g_assemblyhead_time);
+  g_nodecnt++;
 
-              if (node->frags != NULL)
-                {
-                  FAR struct ip_fraglink_s *fraglink = node->frags;
+  return node;
+}
 
-                  while (fraglink != NULL)
-                    {
-                      fraglink = ip_fragin_freelink(fraglink);
-                    }
-                }
+/****************************************************************************
+ * Name: ip_fragin_dropnode
+ *
+ * Description:
+ *   Free all the fragments of a datagram and its node.
+ *
+ ****************************************************************************/
 
-              /* Remove node from single-list and free node memory */
+static void ip_fragin_dropnode(FAR struct ip_fragsnode_s *node)
+{
+  FAR struct ip_fraglink_s *fraglink = node->frags;
 
-              bufcnt = ip_frag_remnode(node);
-              kmm_free(node);
+  while (fraglink != NULL)
+    {
+      fraglink = ip_fragin_freelink(fraglink);
+    }
 
-              cleancnt = cleancnt > bufcnt ? cleancnt - bufcnt : 0;
-            }
+  /* Remove node from the hash table and free node memory */
+
+  ip_frag_remnode(node);
+  kmm_free(node);
+}
+
+/****************************************************************************
+ * Name: ip_fragin_cachemonitor
+ *
+ * Description:
+ *   Check the reassembly cache buffer size before 'bufcnt' more I/O buffers
+ *   are cached.  If it would exceed the configured threshold, the oldest
+ *   datagrams are freed.
+ *
+ * Input Parameters:
+ *   curnode - node of the upper-level linked list, it maintains information
+ *             about all fragments belonging to an IP datagram
+ *   bufcnt  - The I/O buffers of the fragment added to curnode
+ *
+ * Returned Value:
+ *   none
+ *
+ * Assumptions:
+ *   curnode alone does not exceed the threshold with the new fragment.
+ *
+ ****************************************************************************/
+
+static void ip_fragin_cachemonitor(FAR struct ip_fragsnode_s *curnode,
+                                   uint32_t bufcnt)
+{
+  FAR dq_entry_t *entry;
+  FAR dq_entry_t *entrynext;
+  FAR struct ip_fragsnode_s *node;
+
+  entry = dq_peek(&g_assemblyhead_time);
+  while (entry != NULL && g_bufoccupy + bufcnt > REASSEMBLY_MAXOCCUPYIOB)
+    {
+      entrynext = dq_next(entry);
+      node      = container_of(entry, struct ip_fragsnode_s, flinkat);
 
-          entry = entrynext;
+      /* Skip specified node */
+
+      if (node != curnode)
+        {
+          ip_fragin_dropnode(node);
         }
+
+      entry = entrynext;
     }
 }
 
@@ -530,8 +621,10 @@ uint32_t ip_frag_remnode(FAR struct ip_fragsnode_s *node)
   g_bufoccupy -= node->bufcnt;
   ASSERT(g_bufoccupy < CONFIG_IOB_NBUFFERS);
 
-  sq_rem((FAR sq_entry_t *)node, &g_assemblyhead_ipid);
-  sq_rem((FAR sq_entry_t *)&node->flinkat, &g_assemblyhead_time);
+  hashtable_delete(g_assemblyhead_ipid, &node->flink,
+                   ip_fragin_hash(&node->key));
+  dq_rem(&node->flinkat, &g_assemblyhead_time);
+  g_nodecnt--;
 
   return node->bufcnt;
 }
@@ -555,168 +648,141 @@ uint32_t ip_frag_remnode(FAR struct ip_fragsnode_s *node)
  *
  ****************************************************************************/
 
-bool ip_fragin_enqueue(FAR struct net_driver_s *dev,
-                       FAR struct ip_fraglink_s *curfraglink)
+int ip_fragin_enqueue(FAR struct net_driver_s *dev,
+                      FAR struct ip_fraglink_s *curfraglink)
 {
   FAR struct ip_fragsnode_s *node;
-  FAR sq_entry_t            *entry;
-  FAR sq_entry_t            *entrylast = NULL;
-  bool                       empty;
+  FAR struct ip_fraglink_s  *prev = NULL;
+  FAR struct ip_fraglink_s  *next;
+  struct ip_fragkey_s        key;
+  uint32_t                   bufcnt = IOBUF_CNT(curfraglink->frag);
+  uint32_t                   fragend;
+  int                        empty;
 
-  /* The linked list is ordered by IP ID value, walk through it and try to
-   * find a node that has the same IP ID value, otherwise need to create a
-   * new node and insert it into the linked list.
-   */
+  empty = dq_empty(&g_assemblyhead_time);
 
-  entry = sq_peek(&g_assemblyhead_ipid);
-  empty = (entry == NULL) ? true : false;
+  /* Find the datagram of the fragment, or start a new one */
 
-  while (entry != NULL)
+  ip_fragin_getkey(curfraglink, &key);
+  node = ip_fragin_findnode(dev, &key);
+  if (node == NULL)
     {
-      node = (struct ip_fragsnode_s *)entry;
-
-      if (dev == node->dev && curfraglink->ipid <= node->ipid)
+      node = ip_fragin_allocnode(dev, &key);
+      if (node == NULL)
         {
-          break;
+          nerr("ERROR: Failed to allocate buffer.\n");
+          return -ENOMEM;
         }
-
-      entrylast = entry;
-      entry = sq_next(entry);
     }
 
-  node = (FAR struct ip_fragsnode_s *)entry;
+  /* Find the fragments before and after this one:  A fragment that arrives
+   * in order goes after the last one without walking the list.
+   */
 
-  if (node != NULL && curfraglink->ipid == node->ipid)
+  if (node->lastfrag != NULL &&
+      node->lastfrag->fragoff < curfraglink->fragoff)
     {
-      FAR struct ip_fraglink_s *fraglink;
-      FAR struct ip_fraglink_s *lastlink = NULL;
-
-      /* Found a previously created ip_fragsnode_s, insert this new
-       * ip_fraglink_s to the subchain of this node.
-       */
-
-      fraglink = node->frags;
-
-      /* An ip_fragsnode_s must have an ip_fraglink_s because we allocate a
-       * new ip_fraglink_s when caching a new ip_fraglink_s with a new IP ID
-       */
-
-      while (fraglink != NULL)
+      prev = node->lastfrag;
+    }
+  else
+    {
+      for (next = node->frags;
+           next != NULL && next->fragoff < curfraglink->fragoff;
+           next = next->flink)
         {
-          /* The fragment list is ordered by fragment offset value */
-
-          if (curfraglink->fragoff <= fraglink->fragoff)
-            {
-              break;
-            }
-
-          lastlink = fraglink;
-          fraglink = fraglink->flink;
+          prev = next;
         }
+    }
 
-      if (fraglink == NULL)
-        {
-          /* This fragment offset is greater than the previous fragments,
-           * added to the last position
-           */
+  next    = prev != NULL ? prev->flink : node->frags;
+  fragend = curfraglink->fragoff + curfraglink->fraglen;
 
-          lastlink->flink      = curfraglink;
+  if (next != NULL && next->fragoff == curfraglink->fragoff &&
+      next->fraglen == curfraglink->fraglen &&
+      next->morefrags == curfraglink->morefrags)
+    {
+      /* Fragments with same offset value contain the same data, use the
+       * more recently arrived copy. Refer to RFC791, Section3.2, Page29.
+       * Replace and removed the old packet from the fragment list
+       */
 
-          /* Remember I/O buffer count */
+      FAR struct ip_fraglink_s *dup = next;
 
-          node->bufcnt += IOBUF_CNT(curfraglink->frag);
-          g_bufoccupy  += IOBUF_CNT(curfraglink->frag);
-        }
-      else if (curfraglink->fragoff == fraglink->fragoff)
+      next = dup->flink;
+      if (prev == NULL)
         {
-          /* Fragments with same offset value contain the same data, use the
-           * more recently arrived copy. Refer to RFC791, Section3.2, Page29.
-           * Replace and removed the old packet from the fragment list
-           */
-
-          curfraglink->flink = fraglink->flink;
-          if (lastlink == NULL)
-            {
-              node->frags = curfraglink;
-            }
-          else
-            {
-              lastlink->flink = curfraglink;
-            }
-
-          iob_free_chain(fraglink->frag);
-          kmm_free(fraglink);
+          node->frags = next;
         }
       else
         {
-          /* Insert into the fragment list */
-
-          if (lastlink == NULL)
-            {
-              /* Insert before the first node */
-
-              curfraglink->flink = node->frags;
-              node->frags = curfraglink;
-            }
-          else
-            {
-              /* Insert this node after lastlink */
+          prev->flink = next;
+        }
 
-              curfraglink->flink = lastlink->flink;
-              lastlink->flink = curfraglink;
-            }
+      if (node->lastfrag == dup)
+        {
+          node->lastfrag = prev;
+        }
 
-          /* Remember I/O buffer count */
+      node->bufcnt  -= IOBUF_CNT(dup->frag);
+      g_bufoccupy   -= IOBUF_CNT(dup->frag);
+      node->rcvdlen -= dup->fraglen;
+      node->nfrags--;
 
-          node->bufcnt += IOBUF_CNT(curfraglink->frag);
-          g_bufoccupy  += IOBUF_CNT(curfraglink->frag);
-        }
+      ip_fragin_freelink(dup);
     }
-  else
+  else if ((prev != NULL &&
+            prev->fragoff + prev->fraglen > curfraglink->fragoff) ||
+           (next != NULL && fragend > next->fragoff) ||
+           (node->totallen != 0 && fragend > node->totallen) ||
+           (!curfraglink->morefrags &&
+            (next != NULL || node->totallen != 0)))
     {
-      /* It's a new IP ID fragment, malloc a new node and insert it into the
-       * linked list
+      /* The fragment overlaps the others, or is beyond the end of the
+       * datagram.  Drop it, the datagram then times out unless the
+       * fragments are retransmitted as before (RFC 5722).
        */
 
-      node = kmm_malloc(sizeof(struct ip_fragsnode_s));
-      if (node == NULL)
-        {
-          nerr("ERROR: Failed to allocate buffer.\n");
-          return -ENOMEM;
-        }
+      nwarn("WARNING: Overlapping fragment dropped\n");
+      return -EINVAL;
+    }
 
-      node->flink      = NULL;
-      node->flinkat    = NULL;
-      node->dev        = dev;
-      node->ipid       = curfraglink->ipid;
-      node->frags      = curfraglink;
-      node->tick       = clock_systime_ticks();
-      node->bufcnt     = IOBUF_CNT(curfraglink->frag);
-      g_bufoccupy     += IOBUF_CNT(curfraglink->frag);
-      node->verifyflag = 0;
-      node->outgoframe = NULL;
-
-      /* Insert this new node into linked list identified by
-       * g_assemblyhead_ipid with correct position
-       */
+  /* Enforce the limits of the reassembly cache before the fragment is
+   * taken:  The oldest datagrams are evicted first, and a datagram that
+   * alone would exceed the limits is dropped.
+   */
 
-      if (sq_peek(&g_assemblyhead_ipid) == NULL || entrylast == NULL)
-        {
-          sq_addfirst((FAR sq_entry_t *)node, &g_assemblyhead_ipid);
-        }
-      else
-        {
-          sq_addafter(entrylast, (FAR sq_entry_t *)node,
-                      &g_assemblyhead_ipid);
-        }
+  if (node->nfrags >= CONFIG_NET_IPFRAG_REASS_MAXFRAGS ||
+      node->bufcnt + bufcnt > REASSEMBLY_MAXOCCUPYIOB)
+    {
+      nwarn("WARNING: Datagram too large for reassembly\n");
+      ip_fragin_dropnode(node);
+      return -ENOBUFS;
+    }
 
-      /* Add this new node to the tail of linked list identified by
-       * g_assemblyhead_time
-       */
+  ip_fragin_cachemonitor(node, bufcnt);
 
-      sq_addlast((FAR sq_entry_t *)&node->flinkat, &g_assemblyhead_time);
+  /* Link the fragment */
+
+  curfraglink->flink = next;
+  if (next == NULL)
+    {
+      node->lastfrag = curfraglink;
     }
 
+  if (prev == NULL)
+    {
+      node->frags = curfraglink;
+    }
+  else
+    {
+      prev->flink = curfraglink;
+    }
+
+  node->nfrags++;
+  node->rcvdlen += curfraglink->fraglen;
+  node->bufcnt  += bufcnt;
+  g_bufoccupy   += bufcnt;
+
   if (curfraglink->fragoff == 0)
     {
       /* Have received the zero fragment */
@@ -728,26 +794,26 @@ bool ip_fragin_enqueue(FAR struct net_driver_s *dev,
       /* Have received the tail fragment */
 
       node->verifyflag |= IP_FRAGVERIFY_RECVDTAILFRAG;
+      node->totallen    = fragend;
     }
 
-  /* For indexing convenience */
+  /* The fragments do not overlap, so they are all received once their
+   * lengths add up to the length of the datagram.
+   */
 
-  curfraglink->fragsnode = node;
+  if (node->totallen != 0 && node->rcvdlen == node->totallen)
+    {
+      node->verifyflag |= IP_FRAGVERIFY_RECVDALLFRAGS;
+    }
 
-  /* Check receiving status */
+  /* For indexing convenience */
 
-  ip_fragin_check(node);
+  curfraglink->fragsnode = node;
 
   /* Buffer is take away, clear original pointers in NIC */
 
   netdev_iob_clear(dev);
 
-  /* Perform cache cleaning when reassembly cache size exceeds the configured
-   * threshold
-   */
-
-  ip_fragin_cachemonitor(node);
-
   return empty;
 }
 
@@ -1110,36 +1176,26 @@ int32_t ip_frag_uninit(void)
 
 void ip_frag_stop(FAR struct net_driver_s *dev)
 {
-  FAR sq_entry_t *entry = NULL;
-  FAR sq_entry_t *entrynext;
+  FAR dq_entry_t *entry = NULL;
+  FAR dq_entry_t *entrynext;
 
   ninfo("Stop frag processing for NIC:%p\n", dev);
 
   nxmutex_lock(&g_ipfrag_lock);
 
-  entry = sq_peek(&g_assemblyhead_ipid);
+  entry = dq_peek(&g_assemblyhead_time);
 
   /* Drop those unassembled incoming fragments belonging to this NIC */
 
   while (entry != NULL)
     {
-      FAR struct ip_fragsnode_s *node = (FAR struct ip_fragsnode_s *)entry;
-      entrynext = sq_next(entry);
+      FAR struct ip_fragsnode_s *node =
+        container_of(entry, struct ip_fragsnode_s, flinkat);
+      entrynext = dq_next(entry);
 
       if (dev == node->dev)
         {
-          if (node->frags != NULL)
-            {
-              FAR struct ip_fraglink_s *fraglink = node->frags;
-
-              while (fraglink != NULL)
-                {
-                  fraglink = ip_fragin_freelink(fraglink);
-                }
-            }
-
-          ip_frag_remnode(node);
-          kmm_free(entry);
+          ip_fragin_dropnode(node);
         }
 
       entry = entrynext;
@@ -1166,44 +1222,25 @@ void ip_frag_stop(FAR struct net_driver_s *dev)
 
 void ip_frag_remallfrags(void)
 {
-  FAR sq_entry_t *entry = NULL;
-  FAR sq_entry_t *entrynext;
+  FAR dq_entry_t *entry = NULL;
+  FAR dq_entry_t *entrynext;
   FAR struct net_driver_s *dev;
 
   nxmutex_lock(&g_ipfrag_lock);
 
-  entry = sq_peek(&g_assemblyhead_ipid);
+  entry = dq_peek(&g_assemblyhead_time);
 
   /* Drop all unassembled incoming fragments */
 
   while (entry != NULL)
     {
-      FAR struct ip_fragsnode_s *node = (FAR struct ip_fragsnode_s *)entry;
-      entrynext = sq_next(entry);
-
-      if (node->frags != NULL)
-        {
-          FAR struct ip_fraglink_s *fraglink = node->frags;
-
-          while (fraglink != NULL)
-            {
-              fraglink = ip_fragin_freelink(fraglink);
-            }
-        }
-
-      /* Because nodes managed by the two queues are the same,
-       * and g_assemblyhead_ipid will be cleared after this loop ends,
-       * so only reset g_assemblyhead_time is needed after this loop ends
-       */
-
-      sq_rem(entry, &g_assemblyhead_ipid);
-      kmm_free(entry);
-
+      entrynext = dq_next(entry);
+      ip_fragin_dropnode(container_of(entry, struct ip_fragsnode_s,
+                                      flinkat));
       entry = entrynext;
     }
 
-  sq_init(&g_assemblyhead_time);
-  g_bufoccupy = 0;
+  DEBUGASSERT(g_bufoccupy == 0 && g_nodecnt == 0);
 
   nxmutex_unlock(&g_ipfrag_lock);
 
@@ -1266,6 +1303,10 @@ int32_t ip_fragout(FAR struct net_driver_s *dev)
 
   ninfo("pkt size: %d, MTU: %d\n", dev->d_iob->io_pktlen, mtu);
 
+  /* The device cannot calculate a checksum spread over fragments */
+
+  net_chksum_complete(dev);
+
 #ifdef CONFIG_NET_IPv4
   if (IFF_IS_IPv4(dev->d_flags))
     {
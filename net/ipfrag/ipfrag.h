@@ -33,6 +33,7 @@
 #include <stdint.h>
 #include <assert.h>
 
+#include <nuttx/hashtable.h>
 #include <nuttx/mutex.h>
 #include <nuttx/queue.h>
 #include <nuttx/mm/iob.h>
@@ -92,29 +93,46 @@ struct ip_fraglink_s
   uint32_t                   ipid;
 };
 
+/* The fragments of a datagram are identified by the source and destination
+ * addresses, the IP ID and, for IPv4, the protocol (RFC 791 and RFC 8200).
+ * The unused bytes of a key are zero.
+ */
+
+struct ip_fragkey_s
+{
+  union ip_addr_u            srcipaddr;
+  union ip_addr_u            destipaddr;
+
+  /* IP Identification (IP ID) field defined in ipv4 header or in ipv6
+   * fragment header.
+   */
+
+  uint32_t                   ipid;
+  uint8_t                    proto;     /* IPv4 protocol, 0 for IPv6 */
+  uint8_t                    isipv4;    /* IPv4 or IPv6 */
+};
+
 struct ip_fragsnode_s
 {
-  /* This link is used to maintain a single-linked list of ip_fragsnode_s.
-   * Must be the first field in the structure due to flink type casting.
+  /* This link is used to maintain the hash bucket of the key of the node.
+   * Must be the first field in the structure due to type casting.
    */
 
-  FAR struct ip_fragsnode_s *flink;
+  hash_node_t                flink;
 
   /* Another link which connects all ip_fragsnode_s in order of addition
    * time
    */
 
-  FAR sq_entry_t            *flinkat;
+  dq_entry_t                 flinkat;
 
   /* Interface understood by the network */
 
   FAR struct net_driver_s   *dev;
 
-  /* IP Identification (IP ID) field defined in ipv4 header or in ipv6
-   * fragment header.
-   */
+  /* The identification of the datagram */
 
-  uint32_t                   ipid;
+  struct ip_fragkey_s        key;
 
   /* Count ticks, used by ressembly timer */
 
@@ -128,9 +146,21 @@ struct ip_fragsnode_s
 
   uint32_t                   bufcnt;
 
-  /* Linked all fragments with the same IP ID. */
+  /* The number of fragments, the payload bytes received and the length of
+   * the payload once the tail fragment is received.  The fragments never
+   * overlap, so all are received when rcvdlen reaches totallen.
+   */
+
+  uint16_t                   nfrags;
+  uint32_t                   rcvdlen;
+  uint32_t                   totallen;
+
+  /* Linked all fragments with the same IP ID, by ascending offset, and the
+   * last of them for the fragments that arrive in order.
+   */
 
   FAR struct ip_fraglink_s  *frags;
+  FAR struct ip_fraglink_s  *lastfrag;
 
   /* Points to the reassembled outgoing IP frame */
 
@@ -149,8 +179,8 @@ extern "C"
 #  define EXTERN extern
 #endif
 
-/* Only one thread can access g_assemblyhead_ipid and g_assemblyhead_time
- * at a time
+/* Only one thread can access the reassembly hash table and
+ * g_assemblyhead_time at a time
  */
 
 extern mutex_t g_ipfrag_lock;
@@ -182,8 +212,8 @@ uint32_t ip_frag_remnode(FAR struct ip_fragsnode_s *node);
  * Description:
  *   Enqueue one fragment.
  *   All fragments belonging to one IP frame are organized in a linked list
- *   form, that is a ip_fragsnode_s node. All ip_fragsnode_s nodes are also
- *   organized in an upper-level linked list.
+ *   form, that is a ip_fragsnode_s node. The ip_fragsnode_s nodes are
+ *   hashed by the key of their datagram.
  *
  * Input Parameters:
  *   dev         - NIC Device instance
@@ -191,12 +221,15 @@ uint32_t ip_frag_remnode(FAR struct ip_fragsnode_s *node);
  *                 information of one fragment
  *
  * Returned Value:
- *   Whether queue is empty before enqueue the new node
+ *   1 if no datagram was in reassembly before, 0 if some were, a negated
+ *   errno value if the fragment is dropped:  It overlaps others, or it is
+ *   beyond the limits of the reassembly cache.  The caller still owns the
+ *   dropped fragment and its link.
  *
  ****************************************************************************/
 
-bool ip_fragin_enqueue(FAR struct net_driver_s *dev,
-                       FAR struct ip_fraglink_s *curfraglink);
+int ip_fragin_enqueue(FAR struct net_driver_s *dev,
+                      FAR struct ip_fraglink_s *curfraglink);
 
 /****************************************************************************
  * Name: ipv4_fragin
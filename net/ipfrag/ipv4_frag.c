@@ -122,6 +122,7 @@ ipv4_fragin_getinfo(FAR struct iob_s *iob,
 static uint32_t ipv4_fragin_reassemble(FAR struct ip_fragsnode_s *node)
 {
   FAR struct iob_s *head = NULL;
+  FAR struct iob_s *tail = NULL;
   FAR struct ipv4_hdr_s *ipv4;
   FAR struct ip_fraglink_s *fraglink;
 
@@ -154,15 +155,26 @@ static uint32_t ipv4_fragin_reassemble(FAR struct ip_fragsnode_s *node)
           iob->io_len    -= iphdrlen;
           iob->io_pktlen -= iphdrlen;
 
-          /* Concatenate this iob to the reassembly chain */
+          /* Link this iob chain after the tail of the reassembly chain,
+           * the data is not copied
+           */
 
-          iob_concat(head, iob);
+          head->io_pktlen += iob->io_pktlen;
+          iob->io_pktlen   = 0;
+          tail->io_flink   = iob;
+          tail             = iob;
         }
       else
         {
           /* Remember the head iob */
 
           head = iob;
+          tail = iob;
+        }
+
+      while (tail->io_flink != NULL)
+        {
+          tail = tail->io_flink;
         }
 
       linknext = fraglink->flink;
@@ -262,6 +274,7 @@ int32_t ipv4_fragin(FAR struct net_driver_s *dev)
   FAR struct ip_fragsnode_s *node;
   FAR struct ip_fraglink_s *fraginfo;
   bool restartwdog;
+  int ret;
 
   if (dev->d_len != dev->d_iob->io_pktlen)
     {
@@ -284,8 +297,15 @@ int32_t ipv4_fragin(FAR struct net_driver_s *dev)
 
   /* Need to restart reassembly worker if the original linked list is empty */
 
-  restartwdog = ip_fragin_enqueue(dev, fraginfo);
+  ret = ip_fragin_enqueue(dev, fraginfo);
+  if (ret < 0)
+    {
+      nxmutex_unlock(&g_ipfrag_lock);
+      kmm_free(fraginfo);
+      return ret;
+    }
 
+  restartwdog = ret > 0;
   node = fraginfo->fragsnode;
 
   if (node->verifyflag & IP_FRAGVERIFY_RECVDALLFRAGS)
@@ -426,7 +446,7 @@ int32_t ipv4_fragout(FAR struct net_driver_s *dev, uint16_t mtu)
     }
 
 #ifdef CONFIG_NET_STATISTICS
-  g_netstats.ipv4.sent += nfrags - 1;
+  NET_STATS(ipv4.sent) += nfrags - 1;
 #endif
 
   netdev_txnotify_dev(dev);
@@ -174,6 +174,7 @@ static int32_t ipv6_fragin_getinfo(FAR struct iob_s *iob,
 static uint32_t ipv6_fragin_reassemble(FAR struct ip_fragsnode_s *node)
 {
   FAR struct iob_s *head = NULL;
+  FAR struct iob_s *tail = NULL;
   FAR struct ipv6_hdr_s *ipv6;
   FAR struct ip_fraglink_s *fraglink;
 
@@ -246,6 +247,7 @@ static uint32_t ipv6_fragin_reassemble(FAR struct ip_fragsnode_s *node)
           /* Remember the head iob */
 
           head = iob;
+          tail = iob;
         }
       else
         {
@@ -260,9 +262,19 @@ static uint32_t ipv6_fragin_reassemble(FAR struct ip_fragsnode_s *node)
           iob->io_pktlen -= new_off - iob->io_offset;
           iob->io_offset  = new_off;
 
-          /* Concatenate this iob to the reassembly chain */
+          /* Link this iob chain after the tail of the reassembly chain,
+           * the data is not copied
+           */
 
-          iob_concat(head, iob);
+          head->io_pktlen += iob->io_pktlen;
+          iob->io_pktlen   = 0;
+          tail->io_flink   = iob;
+          tail             = iob;
+        }
+
+      while (tail->io_flink != NULL)
+        {
+          tail = tail->io_flink;
         }
 
       linknext = fraglink->flink;
@@ -469,6 +481,7 @@ int32_t ipv6_fragin(FAR struct net_driver_s *dev)
   FAR struct ip_fragsnode_s *node = NULL;
   FAR struct ip_fraglink_s *fraginfo = NULL;
   bool restartwdog;
+  int ret;
 
   if (dev->d_len != dev->d_iob->io_pktlen)
     {
@@ -485,14 +498,26 @@ int32_t ipv6_fragin(FAR struct net_driver_s *dev)
 
   /* Polulate fragment information from input packet data */
 
-  ipv6_fragin_getinfo(dev->d_iob, fraginfo);
+  ret = ipv6_fragin_getinfo(dev->d_iob, fraginfo);
+  if (ret < 0)
+    {
+      kmm_free(fraginfo);
+      return ret;
+    }
 
   nxmutex_lock(&g_ipfrag_lock);
 
   /* Need to restart reassembly worker if the original linked list is empty */
 
-  restartwdog = ip_fragin_enqueue(dev, fraginfo);
+  ret = ip_fragin_enqueue(dev, fraginfo);
+  if (ret < 0)
+    {
+      nxmutex_unlock(&g_ipfrag_lock);
+      kmm_free(fraginfo);
+      return ret;
+    }
 
+  restartwdog = ret > 0;
   node = fraginfo->fragsnode;
   if (node->verifyflag & IP_FRAGVERIFY_RECVDALLFRAGS)
     {
@@ -653,7 +678,7 @@ int32_t ipv6_fragout(FAR struct net_driver_s *dev, uint16_t mtu)
     }
 
 #ifdef CONFIG_NET_STATISTICS
-  g_netstats.ipv6.sent += nfrags - 1;
+  NET_STATS(ipv6.sent) += nfrags - 1;
 #endif
 
   netdev_txnotify_dev(dev);
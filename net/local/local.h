@@ -92,6 +92,27 @@ enum local_state_s
   LOCAL_STATE_DISCONNECTED     /* Peer disconnected */
 };
 
+/* The rings shared by the two peers of a SOCK_STREAM connection with the
+ * LOCAL_RING option:  lr_ring[i] is the transmit ring of lr_conns[i] and
+ * the receive ring of the other peer.  lr_size is the trusted copy of the
+ * size of the rings, the headers of the rings are in user memory.
+ */
+
+#ifdef CONFIG_NET_LOCAL_RING
+struct local_rings_s
+{
+  FAR uint8_t *lr_vaddr;         /* The two rings, in the user heap */
+  size_t lr_mapsize;             /* The size of lr_vaddr */
+  uint32_t lr_size;              /* The size of the data of each ring */
+  uint16_t lr_refs;              /* The peers and the mappings */
+  bool lr_shut[2];               /* The peer does not send anymore */
+  FAR struct local_ring *lr_ring[2];
+  FAR struct local_conn_s *lr_conns[2];
+  mutex_t lr_lock;               /* Protects lr_refs and lr_conns */
+  sem_t lr_waitsem[2];           /* Wakes up the send and recv of a peer */
+};
+#endif
+
 /* Representation of a local connection.  There are four types of
  * connection structures:
  *
@@ -156,6 +177,11 @@ struct local_conn_s
   FAR struct pollfd *lc_event_fds[LOCAL_NPOLLWAITERS];
   struct pollfd lc_inout_fds[2*LOCAL_NPOLLWAITERS];
 
+#ifdef CONFIG_NET_LOCAL_RING
+  FAR struct local_rings_s *lc_rings; /* Set up with LOCAL_RING */
+  uint8_t lc_ringside;                /* The index of this peer in lc_rings */
+#endif
+
   /* Union of fields unique to SOCK_STREAM client, server, and connected
    * peers.
    */
@@ -715,6 +741,95 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds);
 
 int local_pollteardown(FAR struct socket *psock, FAR struct pollfd *fds);
 
+/****************************************************************************
+ * Name: local_ring_setup
+ *
+ * Description:
+ *   Allocate the rings of a connected SOCK_STREAM socket and its peer, each
+ *   of 'size' bytes rounded up to a power of two.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+int local_ring_setup(FAR struct local_conn_s *conn, int size);
+
+/****************************************************************************
+ * Name: local_ring_getinfo
+ *
+ * Description:
+ *   Return the layout of the mapping of the rings of a socket.
+ *
+ ****************************************************************************/
+
+int local_ring_getinfo(FAR struct local_conn_s *conn,
+                       FAR struct local_ringinfo *info);
+
+/****************************************************************************
+ * Name: local_ring_shutdown
+ *
+ * Description:
+ *   Stop sending through the rings, for shutdown(SHUT_WR).
+ *
+ ****************************************************************************/
+
+void local_ring_shutdown(FAR struct local_conn_s *conn);
+
+/****************************************************************************
+ * Name: local_ring_release
+ *
+ * Description:
+ *   Detach a socket that is freed from its rings.
+ *
+ ****************************************************************************/
+
+void local_ring_release(FAR struct local_conn_s *conn);
+
+/****************************************************************************
+ * Name: local_mmap
+ *
+ * Description:
+ *   Map both rings of a socket from offset zero.
+ *
+ ****************************************************************************/
+
+int local_mmap(FAR struct socket *psock, FAR struct mm_map_entry_s *map);
+
+/****************************************************************************
+ * Name: local_ring_send
+ *
+ * Description:
+ *   Copy the data of 'iov' to the transmit ring of a socket, or only wake
+ *   up the peer if there is no data.
+ *
+ ****************************************************************************/
+
+ssize_t local_ring_send(FAR struct local_conn_s *conn,
+                        FAR const struct iovec *iov, size_t iovcnt,
+                        int flags);
+
+/****************************************************************************
+ * Name: local_ring_recv
+ *
+ * Description:
+ *   Copy up to 'len' bytes from the receive ring of a socket, or only give
+ *   the space back to the peer if 'len' is zero.
+ *
+ ****************************************************************************/
+
+ssize_t local_ring_recv(FAR struct local_conn_s *conn, FAR void *buf,
+                        size_t len, int flags);
+
+/****************************************************************************
+ * Name: local_ring_pollevents
+ *
+ * Description:
+ *   Return the poll events of a socket with rings.
+ *
+ ****************************************************************************/
+
+pollevent_t local_ring_pollevents(FAR struct local_conn_s *conn);
+#endif
+
 /****************************************************************************
  * Name: local_generate_instance_id
  *
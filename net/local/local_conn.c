@@ -336,6 +336,12 @@ void local_free(FAR struct local_conn_s *conn)
     }
 #endif /* CONFIG_NET_LOCAL_SCM */
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Detach the connection from its rings */
+
+  local_ring_release(conn);
+#endif
+
   /* Destroy all FIFOs associted with the connection */
 
   local_release_fifos(conn);
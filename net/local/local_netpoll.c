@@ -170,6 +170,21 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
       return local_event_pollsetup(conn, fds, true);
     }
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* The peer notifies the events of the rings */
+
+  if (conn->lc_rings != NULL)
+    {
+      ret = local_event_pollsetup(conn, fds, true);
+      if (ret == OK)
+        {
+          poll_notify(&fds, 1, local_ring_pollevents(conn));
+        }
+
+      return ret;
+    }
+#endif
+
   if (conn->lc_state == LOCAL_STATE_DISCONNECTED)
     {
       fds->priv = NULL;
@@ -319,6 +334,13 @@ int local_pollteardown(FAR struct socket *psock, FAR struct pollfd *fds)
       return local_event_pollsetup(conn, fds, false);
     }
 
+#ifdef CONFIG_NET_LOCAL_RING
+  if (conn->lc_rings != NULL)
+    {
+      return local_event_pollsetup(conn, fds, false);
+    }
+#endif
+
   if (conn->lc_state == LOCAL_STATE_DISCONNECTED)
     {
       return OK;
@@ -249,6 +249,30 @@ psock_stream_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
       return 0;
     }
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* The data sent through the FIFO before the rings were set up is
+   * received first.
+   */
+
+  if (conn->lc_rings != NULL)
+    {
+      int data_len = 0;
+
+      ret = file_ioctl(&conn->lc_infile, FIONREAD, &data_len);
+      if (ret < 0 || data_len == 0)
+        {
+          ret = local_ring_recv(conn, buf, len, flags);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          readlen = ret;
+          goto out;
+        }
+    }
+#endif
+
   /* If it is non-blocking mode, the data in fifo is 0 and
    * returns directly
    */
@@ -276,6 +300,10 @@ psock_stream_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
       return ret;
     }
 
+#ifdef CONFIG_NET_LOCAL_RING
+out:
+#endif
+
   /* Return the address family */
 
   if (from)
@@ -552,7 +580,7 @@ ssize_t local_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
       return 0;
     }
 
-  DEBUGASSERT(buf);
+  DEBUGASSERT(buf != NULL || len == 0);
 
   /* Check for a stream socket */
 
@@ -0,0 +1,616 @@
+/****************************************************************************
+ * net/local/local_ring.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/map.h>
+#include <nuttx/net/net.h>
+
+#include "local/local.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The smallest ring keeps the data of the next ring aligned */
+
+#define LOCAL_RING_MINSIZE sizeof(struct local_ring)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_ring_data
+ ****************************************************************************/
+
+static inline FAR uint8_t *local_ring_data(FAR struct local_ring *ring)
+{
+  return (FAR uint8_t *)(ring + 1);
+}
+
+/****************************************************************************
+ * Name: local_ring_used
+ *
+ * Description:
+ *   Return the number of bytes in a ring.  The indexes are in the memory
+ *   of the application and are not trusted.
+ *
+ ****************************************************************************/
+
+static ssize_t local_ring_used(FAR struct local_rings_s *rings,
+                               FAR struct local_ring *ring)
+{
+  uint32_t used = ring->lr_head - ring->lr_tail;
+
+  if (used > rings->lr_size)
+    {
+      nerr("ERROR: Corrupted ring: head %" PRIu32 " tail %" PRIu32 "\n",
+           ring->lr_head, ring->lr_tail);
+      return -EIO;
+    }
+
+  return used;
+}
+
+/****************************************************************************
+ * Name: local_ring_wakeup
+ *
+ * Description:
+ *   Wake up the send() or recv() waiting on one side of the rings and
+ *   notify the poll waiters of that side.
+ *
+ ****************************************************************************/
+
+static void local_ring_wakeup(FAR struct local_rings_s *rings, int side,
+                              pollevent_t eventset)
+{
+  int sval;
+
+  nxmutex_lock(&rings->lr_lock);
+
+  if (nxsem_get_value(&rings->lr_waitsem[side], &sval) >= 0 && sval <= 0)
+    {
+      nxsem_post(&rings->lr_waitsem[side]);
+    }
+
+  if (rings->lr_conns[side] != NULL)
+    {
+      local_event_pollnotify(rings->lr_conns[side], eventset);
+    }
+
+  nxmutex_unlock(&rings->lr_lock);
+}
+
+/****************************************************************************
+ * Name: local_ring_putref
+ ****************************************************************************/
+
+static void local_ring_putref(FAR struct local_rings_s *rings)
+{
+  uint16_t refs;
+
+  nxmutex_lock(&rings->lr_lock);
+  refs = --rings->lr_refs;
+  nxmutex_unlock(&rings->lr_lock);
+
+  if (refs == 0)
+    {
+      nxsem_destroy(&rings->lr_waitsem[0]);
+      nxsem_destroy(&rings->lr_waitsem[1]);
+      nxmutex_destroy(&rings->lr_lock);
+      kumm_free(rings->lr_vaddr);
+      kmm_free(rings);
+    }
+}
+
+/****************************************************************************
+ * Name: local_munmap
+ *
+ * Description:
+ *   Unmap the rings.  As with rammap(), a mapping can only be unmapped up
+ *   to its end.
+ *
+ ****************************************************************************/
+
+static int local_munmap(FAR struct task_group_s *group,
+                        FAR struct mm_map_entry_s *entry,
+                        FAR void *start, size_t length)
+{
+  off_t offset;
+
+  offset = (uintptr_t)start - (uintptr_t)entry->vaddr;
+  if (offset + length < entry->length)
+    {
+      nerr("ERROR: Cannot umap without unmapping to the end\n");
+      return -ENOSYS;
+    }
+
+  if (offset > 0)
+    {
+      entry->length = offset;
+      return OK;
+    }
+
+  local_ring_putref(entry->priv.p);
+  return mm_map_remove(get_group_mm(group), entry);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_ring_setup
+ *
+ * Description:
+ *   Allocate the rings of a connected SOCK_STREAM socket and its peer, each
+ *   of 'size' bytes rounded up to a power of two.  The two peers then send
+ *   and receive through the rings instead of the FIFOs.
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int local_ring_setup(FAR struct local_conn_s *conn, int size)
+{
+  FAR struct local_conn_s *peer = conn->lc_peer;
+  FAR struct local_rings_s *rings;
+  size_t ringlen;
+  uint32_t ringsize;
+
+  if (conn->lc_proto != SOCK_STREAM)
+    {
+      return -EOPNOTSUPP;
+    }
+
+  if (conn->lc_state != LOCAL_STATE_CONNECTED || peer == NULL)
+    {
+      return -ENOTCONN;
+    }
+
+  if (conn->lc_rings != NULL || peer->lc_rings != NULL)
+    {
+      return -EBUSY;
+    }
+
+  if (size <= 0 || size > CONFIG_NET_LOCAL_RING_MAXSIZE)
+    {
+      return -EINVAL;
+    }
+
+  ringsize = LOCAL_RING_MINSIZE;
+  while (ringsize < size)
+    {
+      ringsize <<= 1;
+    }
+
+  rings = kmm_zalloc(sizeof(struct local_rings_s));
+  if (rings == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* The rings are in the user heap to be mapped by the application */
+
+  ringlen         = sizeof(struct local_ring) + ringsize;
+  rings->lr_vaddr = kumm_zalloc(2 * ringlen);
+  if (rings->lr_vaddr == NULL)
+    {
+      kmm_free(rings);
+      return -ENOMEM;
+    }
+
+  rings->lr_mapsize = 2 * ringlen;
+  rings->lr_size    = ringsize;
+  rings->lr_ring[0] = (FAR struct local_ring *)rings->lr_vaddr;
+  rings->lr_ring[1] = (FAR struct local_ring *)(rings->lr_vaddr + ringlen);
+  rings->lr_ring[0]->lr_size = ringsize;
+  rings->lr_ring[1]->lr_size = ringsize;
+  rings->lr_conns[0] = conn;
+  rings->lr_conns[1] = peer;
+  rings->lr_refs     = 2;
+
+  nxmutex_init(&rings->lr_lock);
+  nxsem_init(&rings->lr_waitsem[0], 0, 0);
+  nxsem_init(&rings->lr_waitsem[1], 0, 0);
+
+  conn->lc_rings    = rings;
+  conn->lc_ringside = 0;
+  peer->lc_rings    = rings;
+  peer->lc_ringside = 1;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: local_ring_getinfo
+ *
+ * Description:
+ *   Return the layout of the mapping of the rings of a socket.
+ *
+ ****************************************************************************/
+
+int local_ring_getinfo(FAR struct local_conn_s *conn,
+                       FAR struct local_ringinfo *info)
+{
+  FAR struct local_rings_s *rings = conn->lc_rings;
+
+  if (rings == NULL)
+    {
+      return -EINVAL;
+    }
+
+  info->ri_mapsize = rings->lr_mapsize;
+  info->ri_txoff   = (FAR uint8_t *)rings->lr_ring[conn->lc_ringside] -
+                     rings->lr_vaddr;
+  info->ri_rxoff   = (FAR uint8_t *)rings->lr_ring[conn->lc_ringside ^ 1] -
+                     rings->lr_vaddr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: local_ring_shutdown
+ *
+ * Description:
+ *   Stop sending through the rings:  The peer receives the end of the
+ *   stream once its receive ring is empty.
+ *
+ ****************************************************************************/
+
+void local_ring_shutdown(FAR struct local_conn_s *conn)
+{
+  FAR struct local_rings_s *rings = conn->lc_rings;
+  int side = conn->lc_ringside;
+
+  if (rings != NULL && !rings->lr_shut[side])
+    {
+      rings->lr_shut[side] = true;
+      local_ring_wakeup(rings, side ^ 1, POLLIN | POLLHUP);
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_release
+ *
+ * Description:
+ *   Detach a socket that is freed from its rings.  The memory of the rings
+ *   is freed once the peer and all the mappings are gone.
+ *
+ ****************************************************************************/
+
+void local_ring_release(FAR struct local_conn_s *conn)
+{
+  FAR struct local_rings_s *rings = conn->lc_rings;
+  int side = conn->lc_ringside;
+
+  if (rings == NULL)
+    {
+      return;
+    }
+
+  conn->lc_rings = NULL;
+
+  nxmutex_lock(&rings->lr_lock);
+  rings->lr_conns[side] = NULL;
+  rings->lr_shut[side]  = true;
+  nxmutex_unlock(&rings->lr_lock);
+
+  local_ring_wakeup(rings, side ^ 1, POLLIN | POLLOUT | POLLHUP);
+  local_ring_putref(rings);
+}
+
+/****************************************************************************
+ * Name: local_mmap
+ *
+ * Description:
+ *   Map both rings of a socket from offset zero, see local_ring_getinfo().
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int local_mmap(FAR struct socket *psock, FAR struct mm_map_entry_s *map)
+{
+  FAR struct local_conn_s *conn = psock->s_conn;
+  FAR struct local_rings_s *rings;
+  int ret;
+
+  net_lock();
+
+  rings = conn->lc_rings;
+  if (rings == NULL || map->offset != 0 || map->length > rings->lr_mapsize)
+    {
+      net_unlock();
+      return -EINVAL;
+    }
+
+  nxmutex_lock(&rings->lr_lock);
+  rings->lr_refs++;
+  nxmutex_unlock(&rings->lr_lock);
+
+  net_unlock();
+
+  map->vaddr  = rings->lr_vaddr;
+  map->priv.p = rings;
+  map->munmap = local_munmap;
+
+  ret = mm_map_add(get_current_mm(), map);
+  if (ret < 0)
+    {
+      local_ring_putref(rings);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: local_ring_send
+ *
+ * Description:
+ *   Copy the data of 'iov' to the transmit ring of a socket, waiting for
+ *   space unless the socket is non-blocking.  Without data, only wake up
+ *   the peer:  The application produced the data in the mapped ring.
+ *
+ * Returned Value:
+ *   The number of bytes sent, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t local_ring_send(FAR struct local_conn_s *conn,
+                        FAR const struct iovec *iov, size_t iovcnt,
+                        int flags)
+{
+  FAR struct local_rings_s *rings = conn->lc_rings;
+  int side = conn->lc_ringside;
+  FAR struct local_ring *ring = rings->lr_ring[side];
+  FAR uint8_t *data = local_ring_data(ring);
+  uint32_t mask = rings->lr_size - 1;
+  bool nonblock;
+  ssize_t sent = 0;
+  ssize_t used;
+  int ret = OK;
+  size_t i;
+
+  nonblock = (flags & MSG_DONTWAIT) != 0 ||
+             _SS_ISNONBLOCK(conn->lc_conn.s_flags);
+
+  for (i = 0; i < iovcnt && ret >= 0; i++)
+    {
+      FAR const uint8_t *src = iov[i].iov_base;
+      size_t len = iov[i].iov_len;
+
+      while (len > 0)
+        {
+          uint32_t head;
+          uint32_t off;
+          size_t ncopy;
+          size_t nfirst;
+
+          if (rings->lr_conns[side ^ 1] == NULL)
+            {
+              ret = -EPIPE;
+              break;
+            }
+
+          used = local_ring_used(rings, ring);
+          if (used < 0)
+            {
+              ret = used;
+              break;
+            }
+
+          if (used == rings->lr_size)
+            {
+              if (nonblock)
+                {
+                  ret = -EAGAIN;
+                  break;
+                }
+
+              ret = nxsem_wait(&rings->lr_waitsem[side]);
+              if (ret < 0)
+                {
+                  break;
+                }
+
+              continue;
+            }
+
+          /* Copy up to the free space, wrapping at the end of the ring */
+
+          ncopy  = MIN(len, rings->lr_size - used);
+          head   = ring->lr_head;
+          off    = head & mask;
+          nfirst = MIN(ncopy, rings->lr_size - off);
+
+          memcpy(data + off, src, nfirst);
+          memcpy(data, src + nfirst, ncopy - nfirst);
+
+          /* Publish the data only once it is written */
+
+          SP_DMB();
+          ring->lr_head = head + ncopy;
+          local_ring_wakeup(rings, side ^ 1, POLLIN);
+
+          src  += ncopy;
+          len  -= ncopy;
+          sent += ncopy;
+        }
+    }
+
+  if (sent == 0 && ret == OK)
+    {
+      local_ring_wakeup(rings, side ^ 1, POLLIN);
+    }
+
+  return sent > 0 ? sent : ret;
+}
+
+/****************************************************************************
+ * Name: local_ring_recv
+ *
+ * Description:
+ *   Copy up to 'len' bytes from the receive ring of a socket, waiting for
+ *   data unless the socket is non-blocking.  With no buffer, only give the
+ *   space back to the peer:  The application consumed the data in the
+ *   mapped ring.
+ *
+ * Returned Value:
+ *   The number of bytes received, zero at the end of the stream, a negated
+ *   errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t local_ring_recv(FAR struct local_conn_s *conn, FAR void *buf,
+                        size_t len, int flags)
+{
+  FAR struct local_rings_s *rings = conn->lc_rings;
+  int side = conn->lc_ringside;
+  FAR struct local_ring *ring = rings->lr_ring[side ^ 1];
+  FAR uint8_t *data = local_ring_data(ring);
+  uint32_t mask = rings->lr_size - 1;
+  uint32_t tail;
+  uint32_t off;
+  size_t ncopy;
+  size_t nfirst;
+  ssize_t used;
+  int ret;
+
+  for (; ; )
+    {
+      used = local_ring_used(rings, ring);
+      if (used != 0 || len == 0)
+        {
+          break;
+        }
+
+      if (rings->lr_shut[side ^ 1])
+        {
+          return 0;
+        }
+
+      if ((flags & MSG_DONTWAIT) != 0 ||
+          _SS_ISNONBLOCK(conn->lc_conn.s_flags))
+        {
+          return -EAGAIN;
+        }
+
+      ret = nxsem_wait(&rings->lr_waitsem[side]);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  if (used < 0)
+    {
+      return used;
+    }
+
+  ncopy = MIN(len, used);
+  if (ncopy > 0)
+    {
+      /* Read the data only after the index that published it */
+
+      SP_DMB();
+
+      tail   = ring->lr_tail;
+      off    = tail & mask;
+      nfirst = MIN(ncopy, rings->lr_size - off);
+
+      memcpy(buf, data + off, nfirst);
+      memcpy((FAR uint8_t *)buf + nfirst, data, ncopy - nfirst);
+
+      if ((flags & MSG_PEEK) != 0)
+        {
+          return ncopy;
+        }
+
+      SP_DMB();
+      ring->lr_tail = tail + ncopy;
+    }
+
+  local_ring_wakeup(rings, side ^ 1, POLLOUT);
+  return ncopy;
+}
+
+/****************************************************************************
+ * Name: local_ring_pollevents
+ *
+ * Description:
+ *   Return the poll events of a socket with rings.
+ *
+ ****************************************************************************/
+
+pollevent_t local_ring_pollevents(FAR struct local_conn_s *conn)
+{
+  FAR struct local_rings_s *rings = conn->lc_rings;
+  int side = conn->lc_ringside;
+  pollevent_t eventset = 0;
+  ssize_t rxused;
+  ssize_t txused;
+
+  rxused = local_ring_used(rings, rings->lr_ring[side ^ 1]);
+  txused = local_ring_used(rings, rings->lr_ring[side]);
+  if (rxused < 0 || txused < 0)
+    {
+      return POLLERR;
+    }
+
+  if (rxused > 0)
+    {
+      eventset |= POLLIN;
+    }
+  else if (rings->lr_shut[side ^ 1])
+    {
+      eventset |= POLLIN | POLLHUP;
+    }
+
+  if (txused < rings->lr_size)
+    {
+      eventset |= POLLOUT;
+    }
+
+  return eventset;
+}
@@ -113,6 +113,12 @@ const struct sock_intf_s g_local_sockif =
   , local_getsockopt /* si_getsockopt */
   , local_setsockopt /* si_setsockopt */
 #endif
+#ifdef CONFIG_NET_LOCAL_RING
+#ifdef CONFIG_NET_SENDFILE
+  , NULL             /* si_sendfile */
+#endif
+  , local_mmap       /* si_mmap */
+#endif
 };
 
 /****************************************************************************
@@ -620,6 +626,28 @@ static int local_getsockopt(FAR struct socket *psock, int level, int option,
             }
         }
     }
+#ifdef CONFIG_NET_LOCAL_RING
+  else if (level == SOL_LOCAL && option == LOCAL_RING)
+    {
+      int ret;
+
+      if (*value_len < sizeof(struct local_ringinfo))
+        {
+          return -EINVAL;
+        }
+
+      net_lock();
+      ret = local_ring_getinfo(conn, value);
+      net_unlock();
+
+      if (ret == OK)
+        {
+          *value_len = sizeof(struct local_ringinfo);
+        }
+
+      return ret;
+    }
+#endif
 
   return -ENOPROTOOPT;
 }
@@ -758,6 +786,23 @@ static int local_setsockopt(FAR struct socket *psock, int level, int option,
             }
         }
     }
+#ifdef CONFIG_NET_LOCAL_RING
+  else if (level == SOL_LOCAL && option == LOCAL_RING)
+    {
+      int ret;
+
+      if (value_len < sizeof(int))
+        {
+          return -EINVAL;
+        }
+
+      net_lock();
+      ret = local_ring_setup(conn, *(FAR const int *)value);
+      net_unlock();
+
+      return ret;
+    }
+#endif
 
   return -ENOPROTOOPT;
 }
@@ -1167,6 +1212,10 @@ static int local_shutdown(FAR struct socket *psock, int how)
                   file_close(&conn->lc_outfile);
                   conn->lc_outfile.f_inode = NULL;
                 }
+
+#ifdef CONFIG_NET_LOCAL_RING
+              local_ring_shutdown(conn);
+#endif
             }
         }
 
@@ -67,7 +67,7 @@ static int mld_group_startup(FAR const struct ipv6_mreq *mrec,
    * initially).
    */
 
-  MLD_STATINCR(g_netstats.mld.report_sched);
+  MLD_STATINCR(NET_STATS(mld.report_sched));
 
   ret = mld_waitmsg(group, MLD_SEND_V2REPORT);
   if (ret < 0)
@@ -187,7 +187,7 @@ int mld_joingroup(FAR const struct ipv6_mreq *mrec)
           return ret;
         }
 
-      MLD_STATINCR(g_netstats.mld.njoins);
+      MLD_STATINCR(NET_STATS(mld.njoins));
 
       /* REVISIT: It is expected that higher level logic will set up
        * the routing table entry for the new multicast address.  That
@@ -234,7 +234,7 @@ int mld_joingroup(FAR const struct ipv6_mreq *mrec)
 
       DEBUGASSERT(group->njoins < UINT8_MAX);
       group->njoins++;
-      MLD_STATINCR(g_netstats.mld.njoins);
+      MLD_STATINCR(NET_STATS(mld.njoins));
     }
 
   return OK;
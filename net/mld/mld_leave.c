@@ -115,7 +115,7 @@ int mld_leavegroup(FAR const struct ipv6_mreq *mrec)
 
       DEBUGASSERT(group->njoins > 0);
       group->njoins--;
-      MLD_STATINCR(g_netstats.mld.nleaves);
+      MLD_STATINCR(NET_STATS(mld.nleaves));
 
       /* Take no further actions if there are other members of this group
        * on this host.
@@ -148,7 +148,7 @@ int mld_leavegroup(FAR const struct ipv6_mreq *mrec)
             {
               mldinfo("Schedule Done message\n");
 
-              MLD_STATINCR(g_netstats.mld.done_sched);
+              MLD_STATINCR(NET_STATS(mld.done_sched));
 
               /* REVISIT:  This will interfere if there are any other tasks
                * waiting for a message to be sent.  Can that happen?
@@ -322,7 +322,7 @@ int mld_query(FAR struct net_driver_s *dev,
       /* This is the general query */
 
       mldinfo("General multicast query\n");
-      MLD_STATINCR(g_netstats.mld.gm_query_received);
+      MLD_STATINCR(NET_STATS(mld.gm_query_received));
 
       /* Check if we are still the querier for this sub-net */
 
@@ -431,12 +431,12 @@ int mld_query(FAR struct net_driver_s *dev,
       if (query->nsources == 0)
         {
           mldinfo("Multicast Address Specific Query\n");
-          MLD_STATINCR(g_netstats.mld.mas_query_received);
+          MLD_STATINCR(NET_STATS(mld.mas_query_received));
         }
       else
         {
           mldinfo("Multicast Address and Source Specific Query\n");
-          MLD_STATINCR(g_netstats.mld.mass_query_received);
+          MLD_STATINCR(NET_STATS(mld.mass_query_received));
         }
 
       /* Check MLDv1 compatibility mode */
@@ -454,7 +454,7 @@ int mld_query(FAR struct net_driver_s *dev,
   else if (NETDEV_IS_MY_V6ADDR(dev, ipv6->destipaddr))
     {
       mldinfo("Unicast query\n");
-      MLD_STATINCR(g_netstats.mld.ucast_query_received);
+      MLD_STATINCR(NET_STATS(mld.ucast_query_received));
 
       /* Check MLDv1 compatibility mode */
 
@@ -468,7 +468,7 @@ int mld_query(FAR struct net_driver_s *dev,
   else
     {
       mldinfo("WARNING:  Unhandled query\n");
-      MLD_STATINCR(g_netstats.mld.bad_query_received);
+      MLD_STATINCR(NET_STATS(mld.bad_query_received));
 
       /* Need to set d_len to zero to indication that nothing is being sent */
 
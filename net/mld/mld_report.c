@@ -150,7 +150,7 @@ int mld_report_v1(FAR struct net_driver_s *dev,
   mldinfo("MLDv1 Multicast Listener Report\n");
   DEBUGASSERT(dev != NULL && report != NULL);
 
-  MLD_STATINCR(g_netstats.mld.v1report_received);
+  MLD_STATINCR(NET_STATS(mld.v1report_received));
   return mld_report(dev, report->mcastaddr);
 }
 
@@ -184,7 +184,7 @@ int mld_report_v2(FAR struct net_driver_s *dev,
   mldinfo("Version 2 Multicast Listener Report\n");
   DEBUGASSERT(dev != NULL && report != NULL);
 
-  MLD_STATINCR(g_netstats.mld.v2report_received);
+  MLD_STATINCR(NET_STATS(mld.v2report_received));
 
   naddrec = NTOHS(report->naddrec);
   for (i = 0; i < naddrec; i++)
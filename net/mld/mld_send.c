@@ -292,7 +292,7 @@ void mld_send(FAR struct net_driver_s *dev, FAR struct mld_group_s *group,
           query->chksum = ~icmpv6_chksum(dev, MLD_HDRLEN);
 #endif
 
-          MLD_STATINCR(g_netstats.mld.query_sent);
+          MLD_STATINCR(NET_STATS(mld.query_sent));
 
 #ifdef CONFIG_NET_MLD_ROUTER
           /* Save the number of members that reported in the previous query
@@ -337,7 +337,7 @@ void mld_send(FAR struct net_driver_s *dev, FAR struct mld_group_s *group,
 #endif
 
           SET_MLD_LASTREPORT(group->flags); /* Remember we were the last to report */
-          MLD_STATINCR(g_netstats.mld.v1report_sent);
+          MLD_STATINCR(NET_STATS(mld.v1report_sent));
         }
         break;
 
@@ -366,7 +366,7 @@ void mld_send(FAR struct net_driver_s *dev, FAR struct mld_group_s *group,
 #endif
 
           SET_MLD_LASTREPORT(group->flags); /* Remember we were the last to report */
-          MLD_STATINCR(g_netstats.mld.v2report_sent);
+          MLD_STATINCR(NET_STATS(mld.v2report_sent));
         }
         break;
 
@@ -388,7 +388,7 @@ void mld_send(FAR struct net_driver_s *dev, FAR struct mld_group_s *group,
           done->chksum    = ~icmpv6_chksum(dev, MLD_HDRLEN);
 #endif
 
-          MLD_STATINCR(g_netstats.mld.done_sent);
+          MLD_STATINCR(NET_STATS(mld.done_sent));
         }
         break;
 
@@ -396,8 +396,8 @@ void mld_send(FAR struct net_driver_s *dev, FAR struct mld_group_s *group,
         return;
     }
 
-  MLD_STATINCR(g_netstats.icmpv6.sent);
-  MLD_STATINCR(g_netstats.ipv6.sent);
+  MLD_STATINCR(NET_STATS(icmpv6.sent));
+  MLD_STATINCR(NET_STATS(ipv6.sent));
 
   mldinfo("Outgoing ICMPv6 MLD packet length: %d\n", dev->d_len);
 
@@ -31,6 +31,9 @@
 
 #include <net/ethernet.h>
 
+#include <nuttx/hashtable.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/queue.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/sixlowpan.h>
@@ -38,6 +41,60 @@
 
 #ifdef CONFIG_NET_IPv6
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Return the node of a Neighbor Table entry, and the entry of a node of the
+ * LRU list or of a hash bucket, or NULL at the end of the list.
+ */
+
+#define neighbor_node(neighbor) \
+  container_of(neighbor, struct neighbor_node_s, nn_entry)
+
+#define neighbor_lrunode(node) \
+  ((node) != NULL ? container_of(node, struct neighbor_node_s, nn_lnode) : \
+                    NULL)
+
+#if CONFIG_NET_IPv6_NCONF_HASH_BITS > 0
+#  define neighbor_hashnode(node) \
+     ((node) != NULL ? \
+      container_of(node, struct neighbor_node_s, nn_hnode) : NULL)
+#endif
+
+/* The nodes that may have a given IPv6 address:  Those of a bucket of the
+ * hash table, or all of them without the hash table.
+ */
+
+#if CONFIG_NET_IPv6_NCONF_HASH_BITS > 0
+#  define neighbor_firstkey(ipaddr) \
+     neighbor_hashnode(hashtable_bucket(g_neighbor_hash, \
+                                        neighbor_key(ipaddr))->head)
+#  define neighbor_nextkey(node) neighbor_hashnode((node)->nn_hnode.flink)
+#else
+#  define neighbor_firstkey(ipaddr) \
+     neighbor_lrunode(dq_peek(&g_neighbor_lru))
+#  define neighbor_nextkey(node)    neighbor_lrunode((node)->nn_lnode.flink)
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* An entry of the Neighbor table with its links.  The entries in use are in
+ * the LRU list, the most recently used first, and in the hash table by IPv6
+ * address.  The free entries are in the free list.
+ */
+
+struct neighbor_node_s
+{
+  dq_entry_t               nn_lnode;   /* In the LRU or the free list */
+#if CONFIG_NET_IPv6_NCONF_HASH_BITS > 0
+  hash_node_t              nn_hnode;   /* In a bucket of the hash table */
+#endif
+  struct neighbor_entry_s  nn_entry;   /* The entry seen by the users */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -46,12 +103,75 @@
  * this table.
  */
 
-extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+extern dq_queue_t g_neighbor_lru;
+
+#if CONFIG_NET_IPv6_NCONF_HASH_BITS > 0
+extern DECLARE_HASHTABLE(g_neighbor_hash, CONFIG_NET_IPv6_NCONF_HASH_BITS);
+#endif
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_key
+ *
+ * Description:
+ *   Return the key of an IPv6 address in the hash table.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_IPv6_NCONF_HASH_BITS > 0
+static inline uint32_t neighbor_key(FAR const uint16_t *ipaddr)
+{
+  uint32_t key = 0;
+  int i;
+
+  for (i = 0; i < 8; i += 2)
+    {
+      key ^= (uint32_t)ipaddr[i] << 16 | ipaddr[i + 1];
+    }
+
+  return key;
+}
+#endif
 
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: neighbor_allocnode
+ *
+ * Description:
+ *   Return a free node of the Neighbor Table, growing the table if it is
+ *   not full, or NULL if the table is full.  The node must be filled and
+ *   then added with neighbor_addnode().
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_node_s *neighbor_allocnode(void);
+
+/****************************************************************************
+ * Name: neighbor_addnode
+ *
+ * Description:
+ *   Add a filled node to the Neighbor Table as the most recently used one.
+ *
+ ****************************************************************************/
+
+void neighbor_addnode(FAR struct neighbor_node_s *node);
+
+/****************************************************************************
+ * Name: neighbor_freenode
+ *
+ * Description:
+ *   Remove a node from the Neighbor Table and free it.
+ *
+ ****************************************************************************/
+
+void neighbor_freenode(FAR struct neighbor_node_s *node);
+
 struct net_driver_s; /* Forward reference */
 
 /****************************************************************************
@@ -171,6 +291,8 @@ void neighbor_ethernet_out(FAR struct net_driver_s *dev);
  *
  * Input Parameters:
  *   snapshot  - Location to return the Neighbor table copy
+ *   skip      - The number of entries to skip, to continue a snapshot taken
+ *               in several parts
  *   nentries  - The size of the user provided 'dest' in entries, each of
  *               size sizeof(struct neighbor_entry_s)
  *
@@ -185,7 +307,7 @@ void neighbor_ethernet_out(FAR struct net_driver_s *dev);
 
 #ifdef CONFIG_NETLINK_ROUTE
 unsigned int neighbor_snapshot(FAR struct neighbor_entry_s *snapshot,
-                               unsigned int nentries);
+                               unsigned int skip, unsigned int nentries);
 #endif
 
 /****************************************************************************
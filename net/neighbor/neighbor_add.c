@@ -65,78 +65,82 @@
 void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
                   FAR uint8_t *addr)
 {
+  FAR struct neighbor_entry_s *neighbor;
+  FAR struct neighbor_node_s *node;
   uint8_t lltype;
-  clock_t oldest_time;
-  int     oldest_ndx;
-  bool    found = false;
   bool    new_entry;
-  int     i;
 
   DEBUGASSERT(dev != NULL && addr != NULL);
 
-  /* Find the matching entry, first unused entry, or the oldest used entry.
-   * The unused entry will have ne_time == 0 and should generate the oldest
-   * time.  REVISIT:  Could this fail on clock wraparound?  A more explicit
-   * check might be to compare ne_ipaddr with the IPv6 unspecified address.
+  /* Find the matching entry.  If none is found, the new entry is a free
+   * one, or replaces the least recently used one.
    */
 
-  oldest_time = g_neighbors[0].ne_time;
-  oldest_ndx  = 0;
-  lltype      = dev->d_lltype;
+  lltype = dev->d_lltype;
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  for (node = neighbor_firstkey(ipaddr); node != NULL;
+       node = neighbor_nextkey(node))
     {
-      if (g_neighbors[i].ne_addr.na_lltype == lltype &&
-          net_ipv6addr_cmp(g_neighbors[i].ne_ipaddr, ipaddr))
+      if (node->nn_entry.ne_addr.na_lltype == lltype &&
+          net_ipv6addr_cmp(node->nn_entry.ne_ipaddr, ipaddr))
         {
-          oldest_ndx = i;
-          found = true;
           break;
         }
-
-      if ((int)(g_neighbors[i].ne_time - oldest_time) < 0)
-        {
-          oldest_ndx = i;
-          oldest_time = g_neighbors[i].ne_time;
-        }
     }
 
-  /* When overwite old entry, need to notify RTM_DELNEIGH */
-
-  if (!found && g_neighbors[oldest_ndx].ne_time != 0)
+  if (node != NULL)
     {
-      netlink_neigh_notify(&g_neighbors[oldest_ndx], RTM_DELNEIGH,
-                           AF_INET6);
+      /* Need to notify when the entry changes in table */
+
+      neighbor  = &node->nn_entry;
+      new_entry = memcmp(&neighbor->ne_addr.u, addr,
+                         neighbor->ne_addr.na_llsize) != 0;
+
+      dq_rem(&node->nn_lnode, &g_neighbor_lru);
+      dq_addfirst(&node->nn_lnode, &g_neighbor_lru);
     }
+  else
+    {
+      node = neighbor_allocnode();
+      if (node == NULL)
+        {
+          node = neighbor_lrunode(dq_tail(&g_neighbor_lru));
+          if (node == NULL)
+            {
+              nerr("ERROR: No free neighbor entry\n");
+              return;
+            }
 
-  /* Need to notify when entry is not found or changes in table */
+          /* When overwite old entry, need to notify RTM_DELNEIGH */
 
-  new_entry = !found || memcmp(&g_neighbors[oldest_ndx].ne_addr.u, addr,
-                             g_neighbors[oldest_ndx].ne_addr.na_llsize) != 0;
+          netlink_neigh_notify(&node->nn_entry, RTM_DELNEIGH, AF_INET6);
 
-  /* Use the oldest or first free entry (either pointed to by the
-   * "oldest_ndx" variable).
-   */
+          neighbor_freenode(node);
+          node = neighbor_allocnode();
+        }
+
+      neighbor  = &node->nn_entry;
+      new_entry = true;
+      net_ipv6addr_copy(neighbor->ne_ipaddr, ipaddr);
+      neighbor_addnode(node);
+    }
 
-  g_neighbors[oldest_ndx].ne_dev  = dev;
-  g_neighbors[oldest_ndx].ne_time = clock_systime_ticks();
-  net_ipv6addr_copy(g_neighbors[oldest_ndx].ne_ipaddr, ipaddr);
+  neighbor->ne_dev  = dev;
+  neighbor->ne_time = clock_systime_ticks();
 
-  g_neighbors[oldest_ndx].ne_addr.na_lltype = lltype;
-  g_neighbors[oldest_ndx].ne_addr.na_llsize = netdev_lladdrsize(dev);
+  neighbor->ne_addr.na_lltype = lltype;
+  neighbor->ne_addr.na_llsize = netdev_lladdrsize(dev);
 
-  memcpy(&g_neighbors[oldest_ndx].ne_addr.u, addr,
-         g_neighbors[oldest_ndx].ne_addr.na_llsize);
+  memcpy(&neighbor->ne_addr.u, addr, neighbor->ne_addr.na_llsize);
 
   /* Notify the new entry */
 
   if (new_entry)
     {
-      netlink_neigh_notify(&g_neighbors[oldest_ndx], RTM_NEWNEIGH,
-                           AF_INET6);
+      netlink_neigh_notify(neighbor, RTM_NEWNEIGH, AF_INET6);
     }
 
   /* Dump the contents of the new entry */
 
-  neighbor_dumpentry("Added entry", &g_neighbors[oldest_ndx]);
+  neighbor_dumpentry("Added entry", neighbor);
 }
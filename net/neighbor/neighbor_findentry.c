@@ -41,6 +41,7 @@
  * Description:
  *   Find an entry in the Neighbor Table.  This interface is internal to
  *   the neighbor implementation; Consider using neighbor_lookup() instead;
+ *   The entry found becomes the most recently used.
  *
  * Input Parameters:
  *   ipaddr - The IPv6 address to use in the lookup;
@@ -53,14 +54,23 @@
 
 FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr)
 {
-  int i;
+  FAR struct neighbor_node_s *node;
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  for (node = neighbor_firstkey(ipaddr); node != NULL;
+       node = neighbor_nextkey(node))
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
+      FAR struct neighbor_entry_s *neighbor = &node->nn_entry;
 
       if (net_ipv6addr_cmp(neighbor->ne_ipaddr, ipaddr))
         {
+          /* The entry becomes the most recently used */
+
+          if (dq_peek(&g_neighbor_lru) != &node->nn_lnode)
+            {
+              dq_rem(&node->nn_lnode, &g_neighbor_lru);
+              dq_addfirst(&node->nn_lnode, &g_neighbor_lru);
+            }
+
           neighbor_dumpentry("Entry found", neighbor);
           return neighbor;
         }
@@ -26,6 +26,10 @@
 
 #include <nuttx/config.h>
 
+#include <string.h>
+
+#include <nuttx/kmalloc.h>
+
 #include "neighbor/neighbor.h"
 
 /****************************************************************************
@@ -36,8 +40,117 @@
  * this table.
  */
 
-struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+dq_queue_t g_neighbor_lru;
+
+#if CONFIG_NET_IPv6_NCONF_HASH_BITS > 0
+DECLARE_HASHTABLE(g_neighbor_hash, CONFIG_NET_IPv6_NCONF_HASH_BITS);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The entries are taken from the static table, or allocated in batches, as
+ * the table grows.
+ */
+
+#if CONFIG_NET_IPv6_NCONF_ALLOC_ENTRIES == 0
+static struct neighbor_node_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+#endif
+
+static dq_queue_t g_neighbor_free;
+static unsigned int g_neighbor_nentries;
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_allocnode
+ *
+ * Description:
+ *   Return a free node of the Neighbor Table, growing the table if it is
+ *   not full, or NULL if the table is full.  The node must be filled and
+ *   then added with neighbor_addnode().
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_node_s *neighbor_allocnode(void)
+{
+  FAR struct neighbor_node_s *node;
+#if CONFIG_NET_IPv6_NCONF_ALLOC_ENTRIES > 0
+  unsigned int nalloc;
+  unsigned int i;
+#endif
+
+  node = neighbor_lrunode(dq_remfirst(&g_neighbor_free));
+  if (node != NULL ||
+      g_neighbor_nentries >= CONFIG_NET_IPv6_NCONF_ENTRIES)
+    {
+      return node;
+    }
+
+#if CONFIG_NET_IPv6_NCONF_ALLOC_ENTRIES > 0
+  /* Allocate a batch of entries, the first one is returned */
+
+  nalloc = CONFIG_NET_IPv6_NCONF_ENTRIES - g_neighbor_nentries;
+  if (nalloc > CONFIG_NET_IPv6_NCONF_ALLOC_ENTRIES)
+    {
+      nalloc = CONFIG_NET_IPv6_NCONF_ALLOC_ENTRIES;
+    }
+
+  node = kmm_zalloc(nalloc * sizeof(struct neighbor_node_s));
+  if (node == NULL)
+    {
+      return NULL;
+    }
+
+  for (i = 1; i < nalloc; i++)
+    {
+      dq_addlast(&node[i].nn_lnode, &g_neighbor_free);
+    }
+
+  g_neighbor_nentries += nalloc;
+#else
+  node = &g_neighbors[g_neighbor_nentries++];
+#endif
+
+  return node;
+}
+
+/****************************************************************************
+ * Name: neighbor_addnode
+ *
+ * Description:
+ *   Add a filled node to the Neighbor Table as the most recently used one.
+ *
+ ****************************************************************************/
+
+void neighbor_addnode(FAR struct neighbor_node_s *node)
+{
+  dq_addfirst(&node->nn_lnode, &g_neighbor_lru);
+#if CONFIG_NET_IPv6_NCONF_HASH_BITS > 0
+  hashtable_add(g_neighbor_hash, &node->nn_hnode,
+                neighbor_key(node->nn_entry.ne_ipaddr));
+#endif
+}
+
+/****************************************************************************
+ * Name: neighbor_freenode
+ *
+ * Description:
+ *   Remove a node from the Neighbor Table and free it.
+ *
+ ****************************************************************************/
+
+void neighbor_freenode(FAR struct neighbor_node_s *node)
+{
+  dq_rem(&node->nn_lnode, &g_neighbor_lru);
+#if CONFIG_NET_IPv6_NCONF_HASH_BITS > 0
+  hashtable_delete(g_neighbor_hash, &node->nn_hnode,
+                   neighbor_key(node->nn_entry.ne_ipaddr));
+#endif
+
+  memset(&node->nn_entry, 0, sizeof(node->nn_entry));
+  dq_addlast(&node->nn_lnode, &g_neighbor_free);
+}
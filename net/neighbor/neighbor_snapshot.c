@@ -48,6 +48,8 @@
  *
  * Input Parameters:
  *   snapshot  - Location to return the Neighbor table copy
+ *   skip      - The number of entries to skip, to continue a snapshot taken
+ *               in several parts
  *   nentries  - The size of the user provided 'dest' in entries, each of
  *               size sizeof(struct neighbor_entry_s)
  *
@@ -61,30 +63,26 @@
  ****************************************************************************/
 
 unsigned int neighbor_snapshot(FAR struct neighbor_entry_s *snapshot,
-                               unsigned int nentries)
+                               unsigned int skip, unsigned int nentries)
 {
+  FAR struct neighbor_node_s *node;
   unsigned int ncopied;
-  int i;
 
-  /* Copy all non-empty entries in the Neighbor table. */
+  /* Copy all the entries in use, the most recently used first. */
 
-  for (i = 0, ncopied = 0;
-       nentries > ncopied && i < CONFIG_NET_IPv6_NCONF_ENTRIES;
-       i++)
+  for (node = neighbor_lrunode(dq_peek(&g_neighbor_lru)), ncopied = 0;
+       nentries > ncopied && node != NULL;
+       node = neighbor_lrunode(node->nn_lnode.flink))
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
-
-      /* An unused entry table entry will be nullified.  In particularly,
-       * the Neighbor IP address will be all zero (i.e., the unspecified
-       * IPv6 address).
-       */
-
-      if (!net_ipv6addr_cmp(neighbor->ne_ipaddr, g_ipv6_unspecaddr))
+      if (skip > 0)
         {
-          memcpy(&snapshot[ncopied], neighbor,
-                 sizeof(struct neighbor_entry_s));
-          ncopied++;
+          skip--;
+          continue;
         }
+
+      memcpy(&snapshot[ncopied], &node->nn_entry,
+             sizeof(struct neighbor_entry_s));
+      ncopied++;
     }
 
   /* Return the number of entries copied into the user buffer */
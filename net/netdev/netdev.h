@@ -32,6 +32,7 @@
 #include <sys/types.h>
 #include <stdbool.h>
 
+#include <nuttx/rcu.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/netdev.h>
 
@@ -39,6 +40,23 @@
 #  include <nuttx/wqueue.h>
 #endif
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Lookups that only walk g_netdevices and do not block are RCU readers if
+ * RCU is enabled.  netdev_unregister() waits for them before the removed
+ * device may be freed.
+ */
+
+#ifdef CONFIG_RCU
+#  define netdev_list_lock()     rcu_read_lock()
+#  define netdev_list_unlock()   rcu_read_unlock()
+#else
+#  define netdev_list_lock()     net_lock()
+#  define netdev_list_unlock()   net_unlock()
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -53,7 +71,8 @@ extern "C"
 #endif
 
 /* List of registered Ethernet device drivers.  You must have the network
- * locked in order to access this list.
+ * locked in order to modify this list.  Readers that do not block may use
+ * netdev_list_lock() instead.
  *
  * NOTE that this duplicates a declaration in net/tcp/tcp.h
  */
@@ -526,6 +545,70 @@ void netdev_ipv6_removemcastmac(FAR struct net_driver_s *dev,
 #  define netdev_ipv6_removemcastmac(dev,addr)
 #endif
 
+/****************************************************************************
+ * Name: netdev_busypoll
+ *
+ * Description:
+ *   Busy poll the RX of a device, or of all the devices if 'dev' is NULL,
+ *   until ready() returns true or 'usec' microseconds have elapsed.  The
+ *   devices are polled at least once.  The network lock is released
+ *   between the polls.
+ *
+ * Input Parameters:
+ *   dev   - The device to poll, NULL to poll all the devices
+ *   usec  - The busy poll time, from SO_BUSY_POLL
+ *   ready - Return true when the wait of the caller is satisfied
+ *   arg   - The argument of ready()
+ *
+ * Returned Value:
+ *   True if ready() returned true.
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_BUSYPOLL
+typedef CODE bool (*netdev_busypoll_t)(FAR void *arg);
+
+bool netdev_busypoll(FAR struct net_driver_s *dev, unsigned int usec,
+                     netdev_busypoll_t ready, FAR void *arg);
+
+/****************************************************************************
+ * Name: netdev_busypoll_sem
+ *
+ * Description:
+ *   A ready() function of netdev_busypoll() for the waits on a semaphore:
+ *   'arg' is the semaphore, ready once it has been posted.
+ *
+ ****************************************************************************/
+
+bool netdev_busypoll_sem(FAR void *arg);
+#endif
+
+/****************************************************************************
+ * Name: netdev_rxfilter_set, netdev_rxfilter_get and netdev_rxfilter_release
+ *
+ * Description:
+ *   Replace the receive filter rules of a device (SIOCSIFRXFILTER), return
+ *   them (SIOCGIFRXFILTER), or remove them and the redirections to the
+ *   device once it is unregistered.
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_RXFILTER
+struct rxfilter_s;
+
+int netdev_rxfilter_set(FAR struct net_driver_s *dev,
+                        FAR const struct rxfilter_s *args);
+int netdev_rxfilter_get(FAR struct net_driver_s *dev,
+                        FAR struct rxfilter_s *args);
+void netdev_rxfilter_release(FAR struct net_driver_s *dev);
+#endif
+
 #ifdef CONFIG_NETDEV_RSS
 void netdev_notify_recvcpu(FAR struct net_driver_s *dev,
                            int cpu, uint8_t domain,
@@ -0,0 +1,148 @@
+/****************************************************************************
+ * net/netdev/netdev_busypoll.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#include "netdev/netdev.h"
+#include "utils/utils.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_busypoll_callback
+ *
+ * Description:
+ *   Receive the pending frames of a device that is up.
+ *
+ ****************************************************************************/
+
+static int netdev_busypoll_callback(FAR struct net_driver_s *dev,
+                                    FAR void *arg)
+{
+  if (dev->d_rxpoll != NULL && IFF_IS_UP(dev->d_flags))
+    {
+      dev->d_rxpoll(dev);
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_busypoll
+ *
+ * Description:
+ *   Busy poll the RX of a device, or of all the devices if 'dev' is NULL,
+ *   until ready() returns true or 'usec' microseconds have elapsed.  The
+ *   devices are polled at least once.  The network lock is released
+ *   between the polls.
+ *
+ * Input Parameters:
+ *   dev   - The device to poll, NULL to poll all the devices
+ *   usec  - The busy poll time, from SO_BUSY_POLL
+ *   ready - Return true when the wait of the caller is satisfied
+ *   arg   - The argument of ready()
+ *
+ * Returned Value:
+ *   True if ready() returned true.
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+bool netdev_busypoll(FAR struct net_driver_s *dev, unsigned int usec,
+                     netdev_busypoll_t ready, FAR void *arg)
+{
+  clock_t start = perf_gettime();
+  clock_t budget;
+  unsigned int count;
+
+  /* The perf counter has a far finer resolution than the system tick */
+
+  budget = (clock_t)((uint64_t)usec * perf_getfreq() / USEC_PER_SEC);
+
+  for (; ; )
+    {
+      if (dev != NULL)
+        {
+          netdev_busypoll_callback(dev, NULL);
+        }
+      else
+        {
+          netdev_foreach(netdev_busypoll_callback, NULL);
+        }
+
+      if (ready(arg))
+        {
+          return true;
+        }
+
+      if (perf_gettime() - start >= budget)
+        {
+          return false;
+        }
+
+      /* Let the workers of the drivers and the other users of the network
+       * in between the polls.
+       */
+
+      if (net_breaklock(&count) >= 0 && net_restorelock(count) < 0)
+        {
+          return false;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_busypoll_sem
+ *
+ * Description:
+ *   A ready() function of netdev_busypoll() for the waits on a semaphore:
+ *   'arg' is the semaphore, ready once it has been posted.
+ *
+ ****************************************************************************/
+
+bool netdev_busypoll_sem(FAR void *arg)
+{
+  int semcount;
+
+  return nxsem_get_value((FAR sem_t *)arg, &semcount) == OK &&
+         semcount > 0;
+}
@@ -60,7 +60,8 @@
  *  1: Enumeration terminated early by callback
  *
  * Assumptions:
- *  The network is locked.
+ *  The network is locked.  Callers whose callback does not block may use
+ *  netdev_list_lock() instead.
  *
  ****************************************************************************/
 
@@ -71,7 +72,8 @@ int netdev_foreach(netdev_callback_t callback, FAR void *arg)
 
   if (callback != NULL)
     {
-      for (dev = g_netdevices; dev; dev = dev->flink)
+      for (dev = rcu_dereference(g_netdevices); dev;
+           dev = rcu_dereference(dev->flink))
         {
           if (callback(dev, arg) != 0)
             {
@@ -62,7 +62,19 @@ int netdev_iob_prepare(FAR struct net_driver_s *dev, bool throttled,
 
   if (dev->d_iob == NULL)
     {
-      dev->d_iob = net_iobtimedalloc(false, timeout);
+#ifdef CONFIG_IOB_LARGE
+      /* A large I/O buffer holds a whole frame of a device with a large
+       * MTU, if one is free.
+       */
+
+      dev->d_iob = iob_tryalloc_size(dev->d_pktsize +
+                                     CONFIG_NET_LL_GUARDSIZE, false);
+      if (dev->d_iob == NULL)
+#endif
+        {
+          dev->d_iob = net_iobtimedalloc(false, timeout);
+        }
+
       if (dev->d_iob == NULL && throttled)
         {
           dev->d_iob = net_iobtimedalloc(true, timeout);
@@ -167,6 +179,9 @@ void netdev_iob_clear(FAR struct net_driver_s *dev)
   dev->d_iob = NULL;
   dev->d_buf = NULL;
   dev->d_len = 0;
+#ifdef CONFIG_NET_CHKSUM_SIMD
+  dev->d_sndsum = -1;
+#endif
 }
 
 /****************************************************************************
@@ -191,6 +206,14 @@ void netdev_iob_release(FAR struct net_driver_s *dev)
     }
 
   dev->d_buf = NULL;
+
+#ifdef CONFIG_NET_CHKSUM_SIMD
+  /* The data of the next send is not summed unless devif_send_chksum()
+   * copies it.
+   */
+
+  dev->d_sndsum = -1;
+#endif
 }
 
 /****************************************************************************
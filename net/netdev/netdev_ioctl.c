@@ -83,6 +83,7 @@
 #include "devif/devif.h"
 #include "igmp/igmp.h"
 #include "icmpv6/icmpv6.h"
+#include "ipforward/ipforward.h"
 #include "route/route.h"
 #include "netlink/netlink.h"
 #include "utils/utils.h"
@@ -343,6 +344,7 @@ static void ioctl_set_ipv4addr(FAR in_addr_t *outaddr,
 {
   FAR const struct sockaddr_in *src = (FAR const struct sockaddr_in *)inaddr;
   *outaddr = src->sin_addr.s_addr;
+  ipfwd_flowcache_flush();
 }
 #endif
 
@@ -731,6 +733,8 @@ static ssize_t net_ioctl_ifreq_arglen(uint8_t domain, int cmd)
       case SIOCSIFNAME:
       case SIOCGIFNAME:
       case SIOCGIFINDEX:
+      case SIOCSIFRXFILTER:
+      case SIOCGIFRXFILTER:
         return sizeof(struct ifreq);
 
       case SIOCSIFADDR:
@@ -1124,6 +1128,7 @@ static int netdev_ifr_ioctl(FAR struct socket *psock, int cmd,
             netlink_device_notify_ipaddr(dev, RTM_DELADDR, AF_INET,
                          &dev->d_ipaddr, net_ipv4_mask2pref(dev->d_netmask));
             dev->d_ipaddr = 0;
+            ipfwd_flowcache_flush();
           }
 #endif
 
@@ -1235,6 +1240,16 @@ static int netdev_ifr_ioctl(FAR struct socket *psock, int cmd,
         break;
 #endif
 
+#ifdef CONFIG_NETDEV_RXFILTER
+      case SIOCSIFRXFILTER:  /* Set the receive filter rules */
+        ret = netdev_rxfilter_set(dev, req->ifr_data);
+        break;
+
+      case SIOCGIFRXFILTER:  /* Get the receive filter rules */
+        ret = netdev_rxfilter_get(dev, req->ifr_data);
+        break;
+#endif
+
       default:
         ret = -ENOTTY;
         break;
@@ -1961,6 +1976,7 @@ int netdev_ifup(FAR struct net_driver_s *dev)
               /* Mark the interface as up */
 
               dev->d_flags |= IFF_UP;
+              ipfwd_flowcache_flush();
 
               /* Update the driver status */
 
@@ -1995,6 +2011,7 @@ int netdev_ifdown(FAR struct net_driver_s *dev)
               /* Mark the interface as down */
 
               dev->d_flags &= ~(IFF_UP | IFF_RUNNING);
+              ipfwd_flowcache_flush();
 
               /* Update the driver status */
 
@@ -454,7 +454,11 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
 
       snprintf(dev->d_ifname, IFNAMSIZ, devfmt, devnum);
 
-      /* Add the device to the list of known network devices */
+      /* Add the device to the list of known network devices.  The device
+       * is published last, lock-free readers may find it immediately.
+       */
+
+      dev->flink = NULL;
 
       last = &g_netdevices;
       while (*last)
@@ -462,9 +466,7 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
           last = &((*last)->flink);
         }
 
-      *last = dev;
-
-      dev->flink = NULL;
+      rcu_assign_pointer(*last, dev);
 
 #ifdef CONFIG_NET_IGMP
       /* Configure the device for IGMP support */
@@ -0,0 +1,327 @@
+/****************************************************************************
+ * net/netdev/netdev_rxfilter.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <netinet/in.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/rxfilter.h>
+
+#include "netdev/netdev.h"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A rule with its output device resolved */
+
+struct netdev_rxrule_s
+{
+  struct rxfilter_rule_s   rule;
+  FAR struct net_driver_s *target;
+};
+
+/* The receive filter of a device */
+
+struct netdev_rxfilter_s
+{
+  uint16_t               nrules;
+  struct netdev_rxrule_s rules[1];
+};
+
+#define SIZEOF_NETDEV_RXFILTER_S(n) \
+  (sizeof(struct netdev_rxfilter_s) + \
+   ((n) - 1) * sizeof(struct netdev_rxrule_s))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_rxfilter_match
+ *
+ * Description:
+ *   Return true if a frame passes all the matches of a rule.
+ *
+ ****************************************************************************/
+
+static bool netdev_rxfilter_match(FAR const struct rxfilter_rule_s *rule,
+                                  FAR const uint8_t *data, unsigned int len)
+{
+  FAR const struct rxfilter_match_s *match;
+  uint32_t word;
+  int i;
+
+  for (i = 0; i < rule->rr_nmatch; i++)
+    {
+      match = &rule->rr_match[i];
+      if ((unsigned int)match->rm_offset + sizeof(word) > len)
+        {
+          return false;
+        }
+
+      memcpy(&word, data + match->rm_offset, sizeof(word));
+      if ((NTOHL(word) & match->rm_mask) != match->rm_value)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: netdev_rxfilter_unlink
+ *
+ * Description:
+ *   Drop, instead of redirecting, the frames redirected to a device that
+ *   is unregistered.
+ *
+ ****************************************************************************/
+
+static int netdev_rxfilter_unlink(FAR struct net_driver_s *dev,
+                                  FAR void *arg)
+{
+  FAR struct netdev_rxfilter_s *filter = dev->d_rxfilter;
+  int i;
+
+  if (filter != NULL)
+    {
+      for (i = 0; i < filter->nrules; i++)
+        {
+          if (filter->rules[i].target == arg)
+            {
+              filter->rules[i].target = NULL;
+              filter->rules[i].rule.rr_action = RXFILTER_DROP;
+            }
+        }
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_rxfilter
+ *
+ * Description:
+ *   Apply the receive filter rules of a device to a received frame.  See
+ *   include/nuttx/net/netdev.h.
+ *
+ ****************************************************************************/
+
+int netdev_rxfilter(FAR struct net_driver_s *dev, FAR const uint8_t *data,
+                    unsigned int len, FAR struct net_driver_s **target)
+{
+  FAR struct netdev_rxfilter_s *filter = dev->d_rxfilter;
+  FAR struct netdev_rxrule_s *rule;
+  int i;
+
+  if (filter == NULL)
+    {
+      return RXFILTER_PASS;
+    }
+
+  for (i = 0; i < filter->nrules; i++)
+    {
+      rule = &filter->rules[i];
+      if (netdev_rxfilter_match(&rule->rule, data, len))
+        {
+          rule->rule.rr_hits++;
+          *target = rule->target;
+          return rule->rule.rr_action;
+        }
+    }
+
+  return RXFILTER_PASS;
+}
+
+/****************************************************************************
+ * Name: netdev_rxfilter_set
+ *
+ * Description:
+ *   Replace the receive filter rules of a device (SIOCSIFRXFILTER).
+ *
+ * Input Parameters:
+ *   dev  - The device
+ *   args - The new rules, none to remove the filter
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.  The rules of
+ *   the device are unchanged on failure.
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+int netdev_rxfilter_set(FAR struct net_driver_s *dev,
+                        FAR const struct rxfilter_s *args)
+{
+  FAR struct netdev_rxfilter_s *filter = NULL;
+  FAR struct netdev_rxrule_s *rule;
+  int i;
+  int j;
+
+  if (args == NULL || args->rf_nrules > CONFIG_NETDEV_RXFILTER_MAXRULES ||
+      (args->rf_nrules > 0 && args->rf_rules == NULL))
+    {
+      return -EINVAL;
+    }
+
+  if (args->rf_nrules > 0)
+    {
+      filter = kmm_malloc(SIZEOF_NETDEV_RXFILTER_S(args->rf_nrules));
+      if (filter == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      filter->nrules = args->rf_nrules;
+      for (i = 0; i < args->rf_nrules; i++)
+        {
+          rule = &filter->rules[i];
+          memcpy(&rule->rule, &args->rf_rules[i], sizeof(rule->rule));
+          rule->rule.rr_hits = 0;
+          rule->target = NULL;
+
+          if (rule->rule.rr_nmatch > RXFILTER_MAXMATCH)
+            {
+              goto errout;
+            }
+
+          /* Mask the values once, instead of for each frame */
+
+          for (j = 0; j < rule->rule.rr_nmatch; j++)
+            {
+              rule->rule.rr_match[j].rm_value &=
+                rule->rule.rr_match[j].rm_mask;
+            }
+
+          switch (rule->rule.rr_action)
+            {
+              case RXFILTER_PASS:
+              case RXFILTER_DROP:
+                break;
+
+              case RXFILTER_REDIRECT:
+                rule->target = netdev_findbyindex(rule->rule.rr_ifindex);
+                if (rule->target == NULL || rule->target == dev)
+                  {
+                    goto errout;
+                  }
+                break;
+
+              default:
+                goto errout;
+            }
+        }
+    }
+
+  /* The frames are filtered with the network locked */
+
+  kmm_free(dev->d_rxfilter);
+  dev->d_rxfilter = filter;
+  return OK;
+
+errout:
+  kmm_free(filter);
+  return -EINVAL;
+}
+
+/****************************************************************************
+ * Name: netdev_rxfilter_get
+ *
+ * Description:
+ *   Return the receive filter rules of a device with their hit counts
+ *   (SIOCGIFRXFILTER).
+ *
+ * Input Parameters:
+ *   dev  - The device
+ *   args - Up to rf_nrules rules are returned in rf_rules, rf_nrules is
+ *          set to the number of rules of the device
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+int netdev_rxfilter_get(FAR struct net_driver_s *dev,
+                        FAR struct rxfilter_s *args)
+{
+  FAR struct netdev_rxfilter_s *filter = dev->d_rxfilter;
+  uint16_t nrules = filter != NULL ? filter->nrules : 0;
+  int i;
+
+  if (args == NULL || (args->rf_nrules > 0 && args->rf_rules == NULL))
+    {
+      return -EINVAL;
+    }
+
+  for (i = 0; i < nrules && i < args->rf_nrules; i++)
+    {
+      memcpy(&args->rf_rules[i], &filter->rules[i].rule,
+             sizeof(struct rxfilter_rule_s));
+    }
+
+  args->rf_nrules = nrules;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: netdev_rxfilter_release
+ *
+ * Description:
+ *   Remove the receive filter of a device that is unregistered, and the
+ *   redirections of the other devices to it.
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+void netdev_rxfilter_release(FAR struct net_driver_s *dev)
+{
+  kmm_free(dev->d_rxfilter);
+  dev->d_rxfilter = NULL;
+
+  netdev_foreach(netdev_rxfilter_unlink, dev);
+}
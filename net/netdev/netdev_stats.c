@@ -26,6 +26,7 @@
 
 #include <nuttx/config.h>
 
+#include <string.h>
 #include <syslog.h>
 
 #include <nuttx/net/netdev.h>
@@ -53,11 +54,76 @@
  *
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: netdev_statistics_fold
+ *
+ * Description:
+ *   Return the statistics of a network device summed over all the CPUs.
+ *
+ * Input Parameters:
+ *   dev   - The network device
+ *   stats - The location to return the statistics
+ *
+ ****************************************************************************/
+
+void netdev_statistics_fold(FAR struct net_driver_s *dev,
+                            FAR struct netdev_statistics_s *stats)
+{
+#ifdef CONFIG_NET_STATISTICS_PERCPU
+  FAR const struct netdev_statistics_s *cpu;
+  int i;
+
+  memset(stats, 0, sizeof(*stats));
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      cpu = &dev->d_statistics[i];
+
+      stats->rx_packets   += cpu->rx_packets;
+      stats->rx_fragments += cpu->rx_fragments;
+      stats->rx_errors    += cpu->rx_errors;
+#ifdef CONFIG_NET_IPv4
+      stats->rx_ipv4      += cpu->rx_ipv4;
+#endif
+#ifdef CONFIG_NET_IPv6
+      stats->rx_ipv6      += cpu->rx_ipv6;
+#endif
+#ifdef CONFIG_NET_ARP
+      stats->rx_arp       += cpu->rx_arp;
+#endif
+      stats->rx_dropped   += cpu->rx_dropped;
+      stats->rx_bytes     += cpu->rx_bytes;
+#ifdef CONFIG_NETDEV_NAPI
+      stats->rx_irqs      += cpu->rx_irqs;
+      stats->rx_polls     += cpu->rx_polls;
+      stats->rx_budgets   += cpu->rx_budgets;
+#endif
+      stats->tx_packets   += cpu->tx_packets;
+      stats->tx_done      += cpu->tx_done;
+      stats->tx_errors    += cpu->tx_errors;
+      stats->tx_timeouts  += cpu->tx_timeouts;
+      stats->tx_bytes     += cpu->tx_bytes;
+      stats->errors       += cpu->errors;
+    }
+#else
+  memcpy(stats, &dev->d_statistics, sizeof(*stats));
+#endif
+}
+
 #if CONFIG_NETDEV_STATISTICS_LOG_PERIOD > 0
 void netdev_statistics_log(FAR void *arg)
 {
   FAR struct net_driver_s *dev = arg;
-  FAR struct netdev_statistics_s *stats = &dev->d_statistics;
+  struct netdev_statistics_s devstats;
+  FAR struct netdev_statistics_s *stats = &devstats;
+#if defined(CONFIG_NET_TCP) || defined(CONFIG_NET_UDP) || \
+    defined(CONFIG_NET_ICMP) || defined(CONFIG_NET_ICMPv6)
+  struct net_stats_s netstats;
+
+  net_stats_fold(&netstats);
+#endif
+
+  netdev_statistics_fold(dev, stats);
 
   stats_log("%s:T%" PRIu32 "/%" PRIu32 "(%" PRIu64 "B)" ",R"
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
@@ -75,6 +141,9 @@ void netdev_statistics_log(FAR void *arg)
 #endif
 #ifdef CONFIG_NET_ICMPv6
             " ICMP6:T%" PRIu16 ",R%" PRIu16 ",D%" PRIu16
+#endif
+#ifdef CONFIG_NETDEV_NAPI
+            " NAPI:I%" PRIu32 ",P%" PRIu32 ",B%" PRIu32
 #endif
             "\n",
             dev->d_ifname,
@@ -84,18 +153,21 @@ void netdev_statistics_log(FAR void *arg)
 #endif
             , stats->rx_packets, stats->rx_bytes
 #ifdef CONFIG_NET_TCP
-            , g_netstats.tcp.sent, g_netstats.tcp.recv, g_netstats.tcp.drop
+            , netstats.tcp.sent, netstats.tcp.recv, netstats.tcp.drop
 #endif
 #ifdef CONFIG_NET_UDP
-            , g_netstats.udp.sent, g_netstats.udp.recv, g_netstats.udp.drop
+            , netstats.udp.sent, netstats.udp.recv, netstats.udp.drop
 #endif
 #ifdef CONFIG_NET_ICMP
-            , g_netstats.icmp.sent, g_netstats.icmp.recv,
-              g_netstats.icmp.drop
+            , netstats.icmp.sent, netstats.icmp.recv,
+              netstats.icmp.drop
 #endif
 #ifdef CONFIG_NET_ICMPv6
-            , g_netstats.icmpv6.sent, g_netstats.icmpv6.recv,
-              g_netstats.icmpv6.drop
+            , netstats.icmpv6.sent, netstats.icmpv6.recv,
+              netstats.icmpv6.drop
+#endif
+#ifdef CONFIG_NETDEV_NAPI
+            , stats->rx_irqs, stats->rx_polls, stats->rx_budgets
 #endif
             );
 }
@@ -38,6 +38,7 @@
 #include <nuttx/net/netdev.h>
 
 #include "utils/utils.h"
+#include "ipforward/ipforward.h"
 #include "netdev/netdev.h"
 
 /****************************************************************************
@@ -143,17 +144,29 @@ int netdev_unregister(FAR struct net_driver_s *dev)
 
               g_netdevices = curr->flink;
             }
-
-          curr->flink = NULL;
         }
 
 #ifdef CONFIG_NETDEV_IFINDEX
       free_ifindex(dev->d_ifindex);
+#endif
+      ipfwd_flowcache_flush();
+#ifdef CONFIG_NETDEV_RXFILTER
+      netdev_rxfilter_release(dev);
 #endif
       net_unlock();
 
+      /* Lock-free readers may still be walking through the device.  Wait
+       * for them before the link is cleared and the caller may free it.
+       */
+
+      if (curr)
+        {
+          synchronize_rcu();
+          curr->flink = NULL;
+        }
+
 #if CONFIG_NETDEV_STATISTICS_LOG_PERIOD > 0
-      work_cancel_sync(NETDEV_STATISTICS_WORK, &dev->d_statistics.logwork);
+      work_cancel_sync(NETDEV_STATISTICS_WORK, &dev->d_statlogwork);
 #endif
 
 #ifdef CONFIG_NET_ETHERNET
@@ -0,0 +1,250 @@
+/****************************************************************************
+ * net/netfilter/ipset_sockopt.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include <nuttx/net/netfilter/ipset.h>
+
+#include "ipfilter/ipfilter.h"
+#include "netfilter/iptables.h"
+
+#ifdef CONFIG_NET_IPFILTER_SET
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipset_check
+ *
+ * Description:
+ *   Check the length and the protocol version of a request.
+ *
+ ****************************************************************************/
+
+static int ipset_check(FAR const void *value, socklen_t value_len,
+                       size_t size)
+{
+  FAR const struct ip_set_req_version *req = value;
+
+  if (value == NULL || value_len != size)
+    {
+      return -EINVAL;
+    }
+
+  return req->version == IPSET_PROTOCOL ? OK : -EPROTO;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipset_setsockopt
+ *
+ * Description:
+ *   setsockopt function of the IP sets:  Create, destroy, flush a set, or
+ *   add and remove its elements.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int ipset_setsockopt(FAR struct socket *psock, FAR const void *value,
+                     socklen_t value_len)
+{
+  FAR const struct ip_set_req_version *req = value;
+  int ret;
+
+  if (value == NULL || value_len < sizeof(*req))
+    {
+      return -EINVAL;
+    }
+
+  switch (req->op)
+    {
+      case IP_SET_OP_CREATE:
+        {
+          FAR const struct ip_set_req_create *create = value;
+          char name[IPSET_MAXNAMELEN];
+
+          ret = ipset_check(value, value_len, sizeof(*create));
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          strlcpy(name, create->name, sizeof(name));
+          ret = ipfilter_set_create(name, create->type);
+          return ret < 0 ? ret : OK;
+        }
+
+      case IP_SET_OP_DESTROY:
+      case IP_SET_OP_FLUSH:
+        {
+          FAR const struct ip_set_req_get_set *set = value;
+
+          ret = ipset_check(value, value_len, sizeof(*set));
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          if (req->op == IP_SET_OP_DESTROY)
+            {
+              return ipfilter_set_destroy(set->set.index);
+            }
+
+          return ipfilter_set_flush(set->set.index);
+        }
+
+      case IP_SET_OP_ADD:
+      case IP_SET_OP_DEL:
+        {
+          FAR const struct ip_set_req_elem *elem = value;
+
+          ret = ipset_check(value, value_len, sizeof(*elem));
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          if (req->op == IP_SET_OP_ADD)
+            {
+              return ipfilter_set_add(elem);
+            }
+
+          return ipfilter_set_del(elem);
+        }
+
+      default:
+        return -EOPNOTSUPP;
+    }
+}
+
+/****************************************************************************
+ * Name: ipset_getsockopt
+ *
+ * Description:
+ *   getsockopt function of the IP sets:  Get the protocol version, find a
+ *   set by name or index, or test an element.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int ipset_getsockopt(FAR struct socket *psock, FAR void *value,
+                     FAR socklen_t *value_len)
+{
+  FAR struct ip_set_req_version *req = value;
+  int ret;
+
+  if (value == NULL || *value_len < sizeof(*req))
+    {
+      return -EINVAL;
+    }
+
+  if (req->op == IP_SET_OP_VERSION)
+    {
+      if (*value_len != sizeof(*req))
+        {
+          return -EINVAL;
+        }
+
+      req->version = IPSET_PROTOCOL;
+      return OK;
+    }
+
+  switch (req->op)
+    {
+      case IP_SET_OP_GET_BYNAME:
+        {
+          FAR struct ip_set_req_get_set *set = value;
+          char name[IPSET_MAXNAMELEN];
+
+          ret = ipset_check(value, *value_len, sizeof(*set));
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          /* As Linux, an unknown name gives the invalid index */
+
+          strlcpy(name, set->set.name, sizeof(name));
+          ret = ipfilter_set_find(name);
+          set->set.index = ret < 0 ? IPSET_INVALID_ID : ret;
+          return OK;
+        }
+
+      case IP_SET_OP_GET_BYINDEX:
+        {
+          FAR struct ip_set_req_get_set *set = value;
+          FAR const char *name;
+
+          ret = ipset_check(value, *value_len, sizeof(*set));
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          name = ipfilter_set_name(set->set.index);
+          strlcpy(set->set.name, name != NULL ? name : "",
+                  sizeof(set->set.name));
+          return OK;
+        }
+
+      case IP_SET_OP_TEST:
+        {
+          FAR struct ip_set_req_elem *elem = value;
+
+          ret = ipset_check(value, *value_len, sizeof(*elem));
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          if (ipfilter_set_name(elem->index) == NULL)
+            {
+              return -ENOENT;
+            }
+
+          return ipfilter_set_match(elem->index, elem->ip,
+                                    elem->proto != 0 ? elem->proto :
+                                    IPPROTO_TCP, elem->port) ?
+                 OK : -ENOENT;
+        }
+
+      default:
+        return -EOPNOTSUPP;
+    }
+}
+
+#endif /* CONFIG_NET_IPFILTER_SET */
@@ -28,11 +28,13 @@
 
 #include <debug.h>
 #include <errno.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/net/netfilter/ip_tables.h>
+#include <nuttx/net/netfilter/ipset.h>
 #include <nuttx/net/netfilter/x_tables.h>
 
 #include "ipfilter/ipfilter.h"
@@ -147,6 +149,40 @@ static void convert_icmp(FAR struct ipfilter_entry_s *entry, uint8_t type,
   entry->match_icmp = 1;
 }
 
+/****************************************************************************
+ * Name: convert_set
+ *
+ * Description:
+ *   Convert iptables set match to ipfilter entry, the entry then holds a
+ *   reference to the set.
+ *
+ * Input Parameters:
+ *   entry - The ipfilter entry to be filled.
+ *   match - The iptables set match to be converted.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFILTER_SET
+static void convert_set(FAR struct ipfilter_entry_s *entry,
+                        FAR const struct xt_entry_match *match)
+{
+  FAR const struct xt_set_info_match_v1 *info =
+    (FAR const struct xt_set_info_match_v1 *)match->data;
+
+  if (entry->match_set)
+    {
+      nwarn("WARNING: Only one set match per entry\n");
+      return;
+    }
+
+  if (ipfilter_set_hold(info->match_set.index) == OK)
+    {
+      entry->set       = info->match_set;
+      entry->match_set = 1;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: convert_target
  *
@@ -214,7 +250,6 @@ convert_ipv4entry(FAR const struct ipt_entry *entry)
       return NULL;
     }
 
-  match  = IPT_MATCH(entry);
   target = IPT_TARGET(entry);
 
   /* Convert common fields */
@@ -231,47 +266,52 @@ convert_ipv4entry(FAR const struct ipt_entry *entry)
 
   convert_invflags(&filter->common, entry->ip.invflags);
 
-  /* Convert match fields */
-
-  if (entry->target_offset < sizeof(struct xt_entry_match))
-    {
-      ninfo("No match inside entry, skip match conversion.\n");
-      goto skip_match;
-    }
+  /* Convert match fields, the protocol match and a set match */
 
-  switch (entry->ip.proto)
+  ipt_match_for_every(match, entry)
     {
-      case IPPROTO_TCP:
-        if (strcmp(match->u.user.name, XT_MATCH_NAME_TCP) == 0)
-          {
-            FAR struct xt_tcp *tcp = (FAR struct xt_tcp *)(match + 1);
-            convert_tcpudp(&filter->common, tcp->spts, tcp->dpts,
-                           tcp->invflags);
-          }
-        break;
-
-      case IPPROTO_UDP:
-        if (strcmp(match->u.user.name, XT_MATCH_NAME_TCP) == 0)
-          {
-            FAR struct xt_udp *udp = (FAR struct xt_udp *)(match + 1);
-            convert_tcpudp(&filter->common, udp->spts, udp->dpts,
-                           udp->invflags);
-          }
-        break;
-
-      case IPPROTO_ICMP:
-        if (strcmp(match->u.user.name, XT_MATCH_NAME_ICMP) == 0)
-          {
-            FAR struct ipt_icmp *icmp = (FAR struct ipt_icmp *)(match + 1);
-            convert_icmp(&filter->common, icmp->type, icmp->invflags);
-          }
-        break;
+#ifdef CONFIG_NET_IPFILTER_SET
+      if (strcmp(match->u.user.name, XT_MATCH_NAME_SET) == 0)
+        {
+          convert_set(&filter->common, match);
+          continue;
+        }
+#endif
 
-      default:
-        break;
+      switch (entry->ip.proto)
+        {
+          case IPPROTO_TCP:
+            if (strcmp(match->u.user.name, XT_MATCH_NAME_TCP) == 0)
+              {
+                FAR struct xt_tcp *tcp = (FAR struct xt_tcp *)(match + 1);
+                convert_tcpudp(&filter->common, tcp->spts, tcp->dpts,
+                               tcp->invflags);
+              }
+            break;
+
+          case IPPROTO_UDP:
+            if (strcmp(match->u.user.name, XT_MATCH_NAME_UDP) == 0)
+              {
+                FAR struct xt_udp *udp = (FAR struct xt_udp *)(match + 1);
+                convert_tcpudp(&filter->common, udp->spts, udp->dpts,
+                               udp->invflags);
+              }
+            break;
+
+          case IPPROTO_ICMP:
+            if (strcmp(match->u.user.name, XT_MATCH_NAME_ICMP) == 0)
+              {
+                FAR struct ipt_icmp *icmp =
+                                        (FAR struct ipt_icmp *)(match + 1);
+                convert_icmp(&filter->common, icmp->type, icmp->invflags);
+              }
+            break;
+
+          default:
+            break;
+        }
     }
 
-skip_match:
   return filter;
 }
 #endif
@@ -401,6 +441,10 @@ static void adjust_ipv4filter(FAR const struct ipt_replace *repl)
             }
         }
     }
+
+  /* Compile the chains into their jump tables. */
+
+  ipfilter_cfg_commit(PF_INET);
 }
 #endif
 
@@ -442,6 +486,10 @@ static void adjust_ipv6filter(FAR const struct ip6t_replace *repl)
             }
         }
     }
+
+  /* Compile the chains into their jump tables. */
+
+  ipfilter_cfg_commit(PF_INET6);
 }
 #endif
 
@@ -493,12 +541,11 @@ int ipt_filter_apply(FAR const struct ipt_replace *repl)
 
   ipt_entry_for_every(entry, repl->entries, repl->size)
     {
-      match  = IPT_MATCH(entry);
       target = IPT_TARGET(entry);
 
       /* Check match type matches the protocol */
 
-      if (entry->target_offset >= sizeof(struct xt_entry_match))
+      ipt_match_for_every(match, entry)
         {
           if (strcmp(match->u.user.name, XT_MATCH_NAME_TCP) == 0 &&
               entry->ip.proto != IPPROTO_TCP)
@@ -520,6 +567,27 @@ int ipt_filter_apply(FAR const struct ipt_replace *repl)
               nwarn("WARNING: ICMP match for non-ICMP protocol\n");
               return -EINVAL;
             }
+
+#ifdef CONFIG_NET_IPFILTER_SET
+          /* Check the set exists, only revision 1 is supported */
+
+          if (strcmp(match->u.user.name, XT_MATCH_NAME_SET) == 0)
+            {
+              FAR const struct xt_set_info_match_v1 *info =
+                (FAR const struct xt_set_info_match_v1 *)match->data;
+
+              if (match->u.match_size <
+                  offsetof(struct xt_entry_match, data) + sizeof(*info) ||
+                  match->u.user.revision != 1 ||
+                  info->match_set.dim < 1 ||
+                  info->match_set.dim > IPSET_DIM_MAX ||
+                  ipfilter_set_name(info->match_set.index) == NULL)
+                {
+                  nwarn("WARNING: Invalid set match\n");
+                  return -EINVAL;
+                }
+            }
+#endif
         }
 
       /* Check target type */
@@ -32,6 +32,7 @@
 #include <nuttx/net/net.h>
 #include <nuttx/net/netfilter/ip_tables.h>
 #include <nuttx/net/netfilter/ip6_tables.h>
+#include <nuttx/net/netfilter/ipset.h>
 
 #ifdef CONFIG_NET_IPTABLES
 
@@ -73,6 +74,21 @@ int ip6t_getsockopt(FAR struct socket *psock, int option,
                     FAR void *value, FAR socklen_t *value_len);
 #endif
 
+/****************************************************************************
+ * Name: ipset_setsockopt / ipset_getsockopt
+ *
+ * Description:
+ *   setsockopt and getsockopt functions of the IP sets (SO_IP_SET).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFILTER_SET
+int ipset_setsockopt(FAR struct socket *psock, FAR const void *value,
+                     socklen_t value_len);
+int ipset_getsockopt(FAR struct socket *psock, FAR void *value,
+                     FAR socklen_t *value_len);
+#endif
+
 /****************************************************************************
  * Name: ipt_alloc_table
  *
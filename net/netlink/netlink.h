@@ -178,6 +178,25 @@
  * Public Type Definitions
  ****************************************************************************/
 
+/* A dump in progress.  The responses of a dump are generated a few at a
+ * time as the reader consumes them, instead of all at once when the request
+ * is received:  'fill' queues the responses of the entries from 'index' and
+ * advances it, it returns the number of entries queued, zero once the end
+ * of the table is reached or a negated errno value on failure.
+ */
+
+struct netlink_dump_s;
+typedef CODE int (*netlink_dump_t)(NETLINK_HANDLE handle,
+                                   FAR struct netlink_dump_s *dump);
+
+struct netlink_dump_s
+{
+  netlink_dump_t fill;               /* NULL if no dump is in progress */
+  struct nlmsghdr req;               /* The header of the dump request */
+  int domain;                        /* The address family of the dump */
+  unsigned int index;                /* The first entry not yet queued */
+};
+
 /* This connection structure describes the underlying state of the socket. */
 
 struct netlink_conn_s
@@ -202,6 +221,7 @@ struct netlink_conn_s
   /* Queued response data */
 
   sq_queue_t resplist;               /* Singly linked list of responses */
+  struct netlink_dump_s dump;        /* The dump in progress */
 };
 
 /* Standard attribute types to specify validation policy */
@@ -427,12 +447,41 @@ void netlink_notifier_signal(FAR struct netlink_conn_s *conn);
 int netlink_add_terminator(NETLINK_HANDLE handle,
                            FAR const struct nlmsghdr *req, int group);
 
+/****************************************************************************
+ * Name: netlink_start_dump
+ *
+ * Description:
+ *   Start a dump on a connection:  The responses of the first entries are
+ *   queued at once, the next ones are queued by netlink_tryget_response()
+ *   when the reader has consumed the previous ones, so that only a few
+ *   responses of a large table are allocated at any time.  The dump is
+ *   terminated with NLMSG_DONE.
+ *
+ * Input Parameters:
+ *   handle - The handle previously provided to the sendto() implementation
+ *            for the protocol.
+ *   req    - The request message header.
+ *   domain - The address family of the dump.
+ *   fill   - Queue the responses of the next entries.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned if the dump was started.  -EBUSY is returned if
+ *   a dump is already in progress on the connection, the error of 'fill'
+ *   if the first entries could not be queued.
+ *
+ ****************************************************************************/
+
+int netlink_start_dump(NETLINK_HANDLE handle,
+                       FAR const struct nlmsghdr *req, int domain,
+                       netlink_dump_t fill);
+
 /****************************************************************************
  * Name: netlink_tryget_response
  *
  * Description:
  *   Return the next response from the head of the pending response list.
- *   Responses are returned one-at-a-time in FIFO order.
+ *   Responses are returned one-at-a-time in FIFO order.  The next
+ *   responses of a dump in progress are queued once the list is empty.
  *
  *   Note:  The network will be momentarily locked to support exclusive
  *   access to the pending response list.
@@ -132,6 +132,41 @@ netlink_get_terminator(FAR const struct nlmsghdr *req)
   return resp;
 }
 
+/****************************************************************************
+ * Name: netlink_dump_next
+ *
+ * Description:
+ *   Queue the responses of the next entries of the dump in progress, or
+ *   its terminator once the end of the table is reached.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void netlink_dump_next(FAR struct netlink_conn_s *conn)
+{
+  int ret;
+
+  ret = conn->dump.fill(conn, &conn->dump);
+  if (ret > 0)
+    {
+      return;
+    }
+
+  /* The dump is over.  It is terminated even on failure, the reader would
+   * wait for NLMSG_DONE otherwise.
+   */
+
+  conn->dump.fill = NULL;
+  if (ret < 0)
+    {
+      nerr("ERROR: The dump failed: %d\n", ret);
+    }
+
+  netlink_add_terminator(conn, &conn->dump.req, 0);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -441,6 +476,60 @@ void netlink_add_broadcast(int group, FAR struct netlink_response_s *data)
     }
 }
 
+/****************************************************************************
+ * Name: netlink_start_dump
+ *
+ * Description:
+ *   Start a dump on a connection:  The responses of the first entries are
+ *   queued at once, the next ones are queued by netlink_tryget_response()
+ *   when the reader has consumed the previous ones.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned if the dump was started.  -EBUSY is returned if
+ *   a dump is already in progress on the connection, the error of 'fill'
+ *   if the first entries could not be queued.
+ *
+ ****************************************************************************/
+
+int netlink_start_dump(NETLINK_HANDLE handle,
+                       FAR const struct nlmsghdr *req, int domain,
+                       netlink_dump_t fill)
+{
+  FAR struct netlink_conn_s *conn = handle;
+  int ret;
+
+  DEBUGASSERT(conn != NULL && req != NULL && fill != NULL);
+
+  net_lock();
+  if (conn->dump.fill != NULL)
+    {
+      net_unlock();
+      return -EBUSY;
+    }
+
+  conn->dump.req    = *req;
+  conn->dump.domain = domain;
+  conn->dump.index  = 0;
+
+  /* Keep the error of an empty table without terminator, as when the whole
+   * table was queued at once.
+   */
+
+  ret = fill(conn, &conn->dump);
+  if (ret > 0)
+    {
+      conn->dump.fill = fill;
+      ret = OK;
+    }
+  else if (ret == 0)
+    {
+      ret = netlink_add_terminator(conn, req, 0);
+    }
+
+  net_unlock();
+  return ret;
+}
+
 /****************************************************************************
  * Name: netlink_tryget_response
  *
@@ -466,10 +555,15 @@ netlink_tryget_response(FAR struct netlink_conn_s *conn)
   DEBUGASSERT(conn != NULL);
 
   /* Return the response at the head of the pending response list (may be
-   * NULL).
+   * NULL).  Queue the next responses of a dump first if there is none.
    */
 
   net_lock();
+  if (sq_peek(&conn->resplist) == NULL && conn->dump.fill != NULL)
+    {
+      netlink_dump_next(conn);
+    }
+
   resp = (FAR struct netlink_response_s *)sq_remfirst(&conn->resplist);
   net_unlock();
 
@@ -572,10 +666,11 @@ bool netlink_check_response(FAR struct netlink_conn_s *conn)
   DEBUGASSERT(conn != NULL);
 
   /* Check if the response is available.  It is not necessary to lock the
-   * network because the sq_peek() is an atomic operation.
+   * network because the sq_peek() is an atomic operation.  The next
+   * responses of a dump in progress are queued when they are read.
    */
 
-  return (sq_peek(&conn->resplist) != NULL);
+  return (sq_peek(&conn->resplist) != NULL || conn->dump.fill != NULL);
 }
 
 #endif /* CONFIG_NET_NETLINK */
@@ -220,6 +220,8 @@ struct nlroute_info_s
 {
   NETLINK_HANDLE handle;
   FAR const struct nlroute_sendto_request_s *req;
+  unsigned int skip;                 /* Routes already dumped */
+  unsigned int count;                /* Routes queued by this step */
 };
 
 /****************************************************************************
@@ -521,13 +523,14 @@ static int netlink_get_devlist(NETLINK_HANDLE handle,
  * Name: netlink_fill_arptable()
  *
  * Description:
- *   Return the entire ARP table.
+ *   Return up to 'nentries' entries of the ARP table from 'index'.
  *
  ****************************************************************************/
 
 #if defined(CONFIG_NET_ARP) && !defined(CONFIG_NETLINK_DISABLE_GETNEIGH)
 static size_t netlink_fill_arptable(
-                              FAR struct getneigh_recvfrom_rsplist_s **entry)
+                              FAR struct getneigh_recvfrom_rsplist_s **entry,
+                              unsigned int index, unsigned int nentries)
 {
   unsigned int ncopied;
   size_t allocsize;
@@ -540,14 +543,14 @@ static size_t netlink_fill_arptable(
 
   net_lock();
   ncopied = arp_snapshot((FAR struct arpreq *)(*entry)->payload.data,
-                         CONFIG_NET_ARPTAB_SIZE);
+                         index, nentries);
   net_unlock();
 
   /* Now we have the real number of valid entries in the ARP table and
    * we can trim the allocation.
    */
 
-  if (ncopied > 0)
+  if (ncopied > 0 && ncopied < nentries)
     {
       FAR struct getneigh_recvfrom_rsplist_s *newentry;
 
@@ -574,13 +577,15 @@ static size_t netlink_fill_arptable(
  * Name: netlink_fill_nbtable()
  *
  * Description:
- *   Return the entire IPv6 neighbor table.
+ *   Return up to 'nentries' entries of the IPv6 neighbor table from
+ *   'index'.
  *
  ****************************************************************************/
 
 #if defined(CONFIG_NET_IPv6) && !defined(CONFIG_NETLINK_DISABLE_GETNEIGH)
 static size_t netlink_fill_nbtable(
-                              FAR struct getneigh_recvfrom_rsplist_s **entry)
+                              FAR struct getneigh_recvfrom_rsplist_s **entry,
+                              unsigned int index, unsigned int nentries)
 {
   unsigned int ncopied;
   size_t allocsize;
@@ -594,14 +599,14 @@ static size_t netlink_fill_nbtable(
   net_lock();
   ncopied = neighbor_snapshot(
                       (FAR struct neighbor_entry_s *)(*entry)->payload.data,
-                      CONFIG_NET_IPv6_NCONF_ENTRIES);
+                      index, nentries);
   net_unlock();
 
   /* Now we have the real number of valid entries in the Neighbor table
    * and we can trim the allocation.
    */
 
-  if (ncopied > 0)
+  if (ncopied > 0 && ncopied < nentries)
     {
       FAR struct getneigh_recvfrom_rsplist_s *newentry;
 
@@ -625,17 +630,21 @@ static size_t netlink_fill_nbtable(
 #endif
 
 /****************************************************************************
- * Name: netlink_fill_nbtable()
+ * Name: netlink_get_neighbor()
  *
  * Description:
- *   Return the entire IPv6 neighbor table.
+ *   Return a response holding the 'neigh' entry, or the entries of the
+ *   ARP or IPv6 neighbor table from 'index' for a request.  At most
+ *   CONFIG_NETLINK_DUMP_ENTRIES entries are returned in a response,
+ *   'nentries' returns their number.
  *
  ****************************************************************************/
 
 #if !defined(CONFIG_NETLINK_DISABLE_GETNEIGH)
 static FAR struct netlink_response_s *
 netlink_get_neighbor(FAR const void *neigh, int domain, int type,
-                     FAR const struct nlroute_sendto_request_s *req)
+                     FAR const struct nlroute_sendto_request_s *req,
+                     unsigned int index, FAR size_t *nentries)
 {
   FAR struct getneigh_recvfrom_rsplist_s *alloc;
   FAR struct getneigh_recvfrom_response_s *resp;
@@ -644,16 +653,13 @@ netlink_get_neighbor(FAR const void *neigh, int domain, int type,
   size_t tabnum;
   size_t rspsize;
 
-  /* Preallocate memory to hold the maximum sized ARP table
-   * REVISIT:  This is probably excessively large and could cause false
-   * memory out conditions.  A better approach would be to actually count
-   * the number of valid entries in the ARP table.
-   */
+  /* Preallocate memory to hold the entries of a response */
 
 #if defined(CONFIG_NET_ARP)
   if (domain == AF_INET)
     {
-      tabnum  = req ? CONFIG_NET_ARPTAB_SIZE : 1;
+      tabnum  = req ? MIN(CONFIG_NET_ARPTAB_SIZE,
+                          CONFIG_NETLINK_DUMP_ENTRIES) : 1;
       tabsize = tabnum * sizeof(struct arpreq);
     }
   else
@@ -661,7 +667,8 @@ netlink_get_neighbor(FAR const void *neigh, int domain, int type,
 #if defined(CONFIG_NET_IPv6)
   if (domain == AF_INET6)
     {
-      tabnum  = req ? CONFIG_NET_IPv6_NCONF_ENTRIES : 1;
+      tabnum  = req ? MIN(CONFIG_NET_IPv6_NCONF_ENTRIES,
+                          CONFIG_NETLINK_DUMP_ENTRIES) : 1;
       tabsize = tabnum * sizeof(struct neighbor_entry_s);
     }
   else
@@ -682,12 +689,14 @@ netlink_get_neighbor(FAR const void *neigh, int domain, int type,
       return NULL;
     }
 
-  /* Initialize the response buffer */
+  /* Initialize the response buffer.  The parts of a table are terminated
+   * by NLMSG_DONE.
+   */
 
   resp                  = &alloc->payload;
   resp->hdr.nlmsg_len   = rspsize;
   resp->hdr.nlmsg_type  = type;
-  resp->hdr.nlmsg_flags = req ? req->hdr.nlmsg_flags : 0;
+  resp->hdr.nlmsg_flags = req ? req->hdr.nlmsg_flags | NLM_F_MULTI : 0;
   resp->hdr.nlmsg_seq   = req ? req->hdr.nlmsg_seq : 0;
   resp->hdr.nlmsg_pid   = req ? req->hdr.nlmsg_pid : 0;
 
@@ -700,6 +709,7 @@ netlink_get_neighbor(FAR const void *neigh, int domain, int type,
     {
       if (neigh == NULL)
         {
+          kmm_free(alloc);
           return NULL;
         }
 
@@ -710,13 +720,13 @@ netlink_get_neighbor(FAR const void *neigh, int domain, int type,
 #if defined(CONFIG_NET_ARP)
   else if (domain == AF_INET)
     {
-      tabnum = netlink_fill_arptable(&alloc);
+      tabnum = netlink_fill_arptable(&alloc, index, tabnum);
     }
 #endif
 #if defined(CONFIG_NET_IPv6)
   else if (domain == AF_INET6)
     {
-      tabnum = netlink_fill_nbtable(&alloc);
+      tabnum = netlink_fill_nbtable(&alloc, index, tabnum);
     }
 #endif
 
@@ -725,28 +735,59 @@ netlink_get_neighbor(FAR const void *neigh, int domain, int type,
   if (tabnum <= 0)
     {
       kmm_free(alloc);
-      nwarn("WARNING: Failed to get entry in %s table.\n",
-            domain == AF_INET ? "ARP" : "neighbor");
       return NULL;
     }
 
+  if (nentries != NULL)
+    {
+      *nentries = tabnum;
+    }
+
   return (FAR struct netlink_response_s *)alloc;
 }
 
-static int netlink_get_neighborlist(NETLINK_HANDLE handle, int domain,
-                              FAR const struct nlroute_sendto_request_s *req)
+/****************************************************************************
+ * Name: netlink_neighbor_dump()
+ *
+ * Description:
+ *   Queue the response of the next entries of a neighbor table dump.
+ *
+ ****************************************************************************/
+
+static int netlink_neighbor_dump(NETLINK_HANDLE handle,
+                                 FAR struct netlink_dump_s *dump)
 {
+  struct nlroute_sendto_request_s req;
   FAR struct netlink_response_s *resp;
+  size_t nentries;
 
-  resp = netlink_get_neighbor(NULL, domain, RTM_GETNEIGH, req);
+  req.hdr              = dump->req;
+  req.gen.rtgen_family = dump->domain;
+
+  resp = netlink_get_neighbor(NULL, dump->domain, RTM_GETNEIGH, &req,
+                              dump->index, &nentries);
   if (resp == NULL)
     {
+      if (dump->index > 0)
+        {
+          return 0;
+        }
+
+      nwarn("WARNING: Failed to get entry in %s table.\n",
+            dump->domain == AF_INET ? "ARP" : "neighbor");
       return -ENOENT;
     }
 
   netlink_add_response(handle, resp);
+  dump->index += nentries;
+  return nentries;
+}
 
-  return netlink_add_terminator(handle, &req->hdr, 0);
+static int netlink_get_neighborlist(NETLINK_HANDLE handle, int domain,
+                              FAR const struct nlroute_sendto_request_s *req)
+{
+  return netlink_start_dump(handle, &req->hdr, domain,
+                            netlink_neighbor_dump);
 }
 #endif /* CONFIG_NETLINK_DISABLE_GETNEIGH */
 
@@ -821,15 +862,30 @@ static int netlink_ipv4route_callback(FAR struct net_route_ipv4_s *route,
   FAR struct nlroute_info_s *info = arg;
   FAR struct netlink_response_s *resp;
 
+  /* Skip the routes queued by the previous steps of the dump */
+
+  if (info->skip > 0)
+    {
+      info->skip--;
+      return OK;
+    }
+
   resp = netlink_get_ipv4_route(route, RTM_NEWROUTE, info->req);
   if (resp == NULL)
     {
       return -ENOENT;
     }
 
-  /* Finally, add the response to the list of pending responses */
+  /* Finally, add the response to the list of pending responses, and stop
+   * at the end of the step.
+   */
 
   netlink_add_response(info->handle, resp);
+  if (++info->count >= CONFIG_NETLINK_DUMP_ENTRIES)
+    {
+      return 1;
+    }
+
   return OK;
 }
 #endif
@@ -843,16 +899,22 @@ static int netlink_ipv4route_callback(FAR struct net_route_ipv4_s *route,
  ****************************************************************************/
 
 #if defined(CONFIG_NET_IPv4) && !defined(CONFIG_NETLINK_DISABLE_GETROUTE)
-static int netlink_list_ipv4_route(NETLINK_HANDLE handle,
-                              FAR const struct nlroute_sendto_request_s *req)
+static int netlink_ipv4route_dump(NETLINK_HANDLE handle,
+                                  FAR struct netlink_dump_s *dump)
 {
+  struct nlroute_sendto_request_s req;
   struct nlroute_info_s info;
   int ret;
 
-  /* Visit each routing table entry */
+  req.hdr              = dump->req;
+  req.gen.rtgen_family = AF_INET;
+
+  /* Visit the routing table entries from the first one not yet dumped */
 
   info.handle = handle;
-  info.req    = req;
+  info.req    = &req;
+  info.skip   = dump->index;
+  info.count  = 0;
 
   ret = net_foreachroute_ipv4(netlink_ipv4route_callback, &info);
   if (ret < 0)
@@ -860,9 +922,15 @@ static int netlink_list_ipv4_route(NETLINK_HANDLE handle,
       return ret;
     }
 
-  /* Terminate the routing table */
+  dump->index += info.count;
+  return info.count;
+}
 
-  return netlink_add_terminator(handle, &req->hdr, 0);
+static int netlink_list_ipv4_route(NETLINK_HANDLE handle,
+                              FAR const struct nlroute_sendto_request_s *req)
+{
+  return netlink_start_dump(handle, &req->hdr, AF_INET,
+                            netlink_ipv4route_dump);
 }
 #endif
 
@@ -940,15 +1008,29 @@ static int netlink_ipv6route_callback(FAR struct net_route_ipv6_s *route,
   FAR struct nlroute_info_s *info = arg;
   FAR struct netlink_response_s *resp;
 
+  /* Skip the routes queued by the previous steps of the dump */
+
+  if (info->skip > 0)
+    {
+      info->skip--;
+      return OK;
+    }
+
   resp = netlink_get_ipv6_route(route, RTM_NEWROUTE, info->req);
   if (resp == NULL)
     {
       return -ENOENT;
     }
 
-  /* Finally, add the response to the list of pending responses */
+  /* Finally, add the response to the list of pending responses, and stop
+   * at the end of the step.
+   */
 
   netlink_add_response(info->handle, resp);
+  if (++info->count >= CONFIG_NETLINK_DUMP_ENTRIES)
+    {
+      return 1;
+    }
 
   return OK;
 }
@@ -963,16 +1045,22 @@ static int netlink_ipv6route_callback(FAR struct net_route_ipv6_s *route,
  ****************************************************************************/
 
 #if defined(CONFIG_NET_IPv6) && !defined(CONFIG_NETLINK_DISABLE_GETROUTE)
-static int netlink_list_ipv6_route(NETLINK_HANDLE handle,
-                              FAR const struct nlroute_sendto_request_s *req)
+static int netlink_ipv6route_dump(NETLINK_HANDLE handle,
+                                  FAR struct netlink_dump_s *dump)
 {
+  struct nlroute_sendto_request_s req;
   struct nlroute_info_s info;
   int ret;
 
-  /* Visit each routing table entry */
+  req.hdr              = dump->req;
+  req.gen.rtgen_family = AF_INET6;
+
+  /* Visit the routing table entries from the first one not yet dumped */
 
   info.handle = handle;
-  info.req    = req;
+  info.req    = &req;
+  info.skip   = dump->index;
+  info.count  = 0;
 
   ret = net_foreachroute_ipv6(netlink_ipv6route_callback, &info);
   if (ret < 0)
@@ -980,9 +1068,15 @@ static int netlink_list_ipv6_route(NETLINK_HANDLE handle,
       return ret;
     }
 
-  /* Terminate the routing table */
+  dump->index += info.count;
+  return info.count;
+}
 
-  return netlink_add_terminator(handle, &req->hdr, 0);
+static int netlink_list_ipv6_route(NETLINK_HANDLE handle,
+                              FAR const struct nlroute_sendto_request_s *req)
+{
+  return netlink_start_dump(handle, &req->hdr, AF_INET6,
+                            netlink_ipv6route_dump);
 }
 #endif
 
@@ -1652,7 +1746,7 @@ void netlink_neigh_notify(FAR const void *neigh, int type, int domain)
 {
   FAR struct netlink_response_s *resp;
 
-  resp = netlink_get_neighbor(neigh, domain, type, NULL);
+  resp = netlink_get_neighbor(neigh, domain, type, NULL, 0, NULL);
   if (resp == NULL)
     {
       return;
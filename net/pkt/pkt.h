@@ -30,7 +30,9 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <poll.h>
 
+#include <netpacket/packet.h>
 #include <nuttx/net/net.h>
 
 #ifdef CONFIG_NET_PKT
@@ -50,6 +52,30 @@
  * Public Type Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_NET_PKT_MMAP
+/* A ring of frames mapped by PACKET_RX_RING or PACKET_TX_RING */
+
+struct pkt_ring_s
+{
+  FAR uint8_t *base;       /* The first block, NULL if there is no ring */
+  uint32_t     blocksize;  /* tp_block_size */
+  uint32_t     framesize;  /* tp_frame_size */
+  uint32_t     framenr;    /* tp_frame_nr */
+  uint32_t     bframes;    /* The frames of a block */
+  uint32_t     head;       /* The next frame filled or sent by the kernel */
+  bool         losing;     /* Frames were dropped since the last one */
+};
+
+/* The memory of the rings, shared by the socket and its mappings */
+
+struct pkt_mmap_s
+{
+  FAR uint8_t *vaddr;      /* The receive ring then the transmit ring */
+  size_t       size;       /* The size of both rings */
+  uint16_t     refs;       /* The socket and each mapping */
+};
+#endif
+
 /* Representation of a packet socket connection */
 
 struct devif_callback_s; /* Forward reference */
@@ -69,11 +95,25 @@ struct pkt_conn_s
    *
    *   readahead - A singly linked list of type struct iob_qentry_s
    *               where the PKT read-ahead data is retained.
-   *
-   * TODO: Maybe support PACKET_MMAP for further optimize.
    */
 
   struct iob_queue_s readahead;   /* Read-ahead buffering */
+
+  /* The frames received and dropped, for PACKET_STATISTICS */
+
+  struct tpacket_stats stats;
+
+  /* The poll() waiters of the socket */
+
+  FAR struct pollfd *fds[CONFIG_NET_PKT_NPOLLWAITERS];
+
+#ifdef CONFIG_NET_PKT_MMAP
+  /* The rings replace the read-ahead buffer and sendmsg() once mapped */
+
+  FAR struct pkt_mmap_s *mmap;    /* The memory of the rings, or NULL */
+  struct pkt_ring_s rxring;       /* PACKET_RX_RING */
+  struct pkt_ring_s txring;       /* PACKET_TX_RING */
+#endif
 };
 
 /****************************************************************************
@@ -292,6 +332,123 @@ void pkt_poll(FAR struct net_driver_s *dev, FAR struct pkt_conn_s *conn);
 ssize_t pkt_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                     int flags);
 
+/****************************************************************************
+ * Name: pkt_netpoll
+ *
+ * Description:
+ *   Setup or teardown the monitoring of the events of a packet socket.
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int pkt_netpoll(FAR struct socket *psock, FAR struct pollfd *fds,
+                bool setup);
+
+/****************************************************************************
+ * Name: pkt_poll_notify
+ *
+ * Description:
+ *   Notify the poll() waiters of a packet socket of 'eventset'.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+void pkt_poll_notify(FAR struct pkt_conn_s *conn, pollevent_t eventset);
+
+#ifdef CONFIG_NET_PKT_MMAP
+/****************************************************************************
+ * Name: pkt_ring_setup
+ *
+ * Description:
+ *   Set the geometry of the PACKET_RX_RING or PACKET_TX_RING ring of a
+ *   packet socket, or release the ring if tp_frame_nr is zero.  The memory
+ *   of both rings is allocated again, their frames are given back to the
+ *   kernel.
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.  -EBUSY is
+ *   returned if the rings are mapped.
+ *
+ ****************************************************************************/
+
+int pkt_ring_setup(FAR struct pkt_conn_s *conn, int option,
+                   FAR const struct tpacket_req *req);
+
+/****************************************************************************
+ * Name: pkt_ring_release
+ *
+ * Description:
+ *   Release the reference of a packet socket on the memory of its rings,
+ *   before the socket is freed.  The memory stays until it is unmapped.
+ *
+ ****************************************************************************/
+
+void pkt_ring_release(FAR struct pkt_conn_s *conn);
+
+/****************************************************************************
+ * Name: pkt_mmap
+ *
+ * Description:
+ *   Map the rings of a packet socket:  The receive ring followed by the
+ *   transmit ring, from offset zero.
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int pkt_mmap(FAR struct socket *psock, FAR struct mm_map_entry_s *map);
+
+/****************************************************************************
+ * Name: pkt_ring_input
+ *
+ * Description:
+ *   Copy the received frame of dev->d_iob to the next frame of the receive
+ *   ring.  The frame is dropped if the user did not give that frame back.
+ *
+ * Assumptions:
+ *   This function is called with the network locked, dev->d_buf points to
+ *   the link layer header.
+ *
+ ****************************************************************************/
+
+void pkt_ring_input(FAR struct net_driver_s *dev,
+                    FAR struct pkt_conn_s *conn);
+
+/****************************************************************************
+ * Name: pkt_ring_send
+ *
+ * Description:
+ *   Send the frames of the transmit ring that the user marked with
+ *   TP_STATUS_SEND_REQUEST, in order, and wait until they are all sent.
+ *
+ * Returned Value:
+ *   The number of bytes sent, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t pkt_ring_send(FAR struct net_driver_s *dev,
+                      FAR struct pkt_conn_s *conn);
+
+/****************************************************************************
+ * Name: pkt_ring_pollevents
+ *
+ * Description:
+ *   Return POLLIN if the receive ring holds frames for the user and
+ *   POLLOUT if the next frame of the transmit ring is available.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+pollevent_t pkt_ring_pollevents(FAR struct pkt_conn_s *conn);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
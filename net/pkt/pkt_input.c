@@ -93,11 +93,14 @@ static uint16_t pkt_datahandler(FAR struct net_driver_s *dev,
   else
     {
       ninfo("Buffered %d bytes\n", dev->d_len);
+      conn->stats.tp_packets++;
+      pkt_poll_notify(conn, POLLIN);
       return dev->d_len;
     }
 
 errout:
   iob_free_chain(iob);
+  conn->stats.tp_drops++;
   return 0;
 }
 
@@ -135,6 +138,17 @@ static int pkt_in(FAR struct net_driver_s *dev)
   int ret = OK;
 
   conn = pkt_active(dev);
+#ifdef CONFIG_NET_PKT_MMAP
+  if (conn != NULL && conn->rxring.base != NULL)
+    {
+      /* The receive ring replaces the read-ahead buffer and recvmsg(), a
+       * frame that does not fit in the ring is dropped.
+       */
+
+      pkt_ring_input(dev, conn);
+    }
+  else
+#endif
   if (conn)
     {
       uint16_t flags;
@@ -166,6 +180,10 @@ static int pkt_in(FAR struct net_driver_s *dev)
               ret = -EAGAIN;
             }
         }
+      else
+        {
+          conn->stats.tp_packets++;
+        }
     }
   else
     {
@@ -0,0 +1,625 @@
+/****************************************************************************
+ * net/pkt/pkt_mmap.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_PKT_MMAP)
+
+#include <sys/param.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/map.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ethernet.h>
+
+#include "devif/devif.h"
+#include "netdev/netdev.h"
+#include "pkt/pkt.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The data of a received frame, and of a frame to send */
+
+#define PKT_RING_RXDATA   TPACKET_ALIGN(TPACKET_HDRLEN)
+#define PKT_RING_TXDATA   (TPACKET_HDRLEN - sizeof(struct sockaddr_ll))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of pkt_ring_send() until the frames are sent */
+
+struct pkt_ringsend_s
+{
+  FAR struct pkt_conn_s       *conn;
+  FAR struct devif_callback_s *cb;
+  sem_t                        sem;   /* Wakes up pkt_ring_send() */
+  ssize_t                      sent;  /* Bytes sent, or a negated errno */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_ring_frame
+ *
+ * Description:
+ *   Return the header of the frame 'index' of a ring.
+ *
+ ****************************************************************************/
+
+static FAR struct tpacket_hdr *pkt_ring_frame(FAR struct pkt_ring_s *ring,
+                                              uint32_t index)
+{
+  return (FAR struct tpacket_hdr *)
+         (ring->base + index / ring->bframes * ring->blocksize +
+          index % ring->bframes * ring->framesize);
+}
+
+/****************************************************************************
+ * Name: pkt_ring_next
+ *
+ * Description:
+ *   Go to the next frame of a ring.
+ *
+ ****************************************************************************/
+
+static void pkt_ring_next(FAR struct pkt_ring_s *ring)
+{
+  if (++ring->head >= ring->framenr)
+    {
+      ring->head = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: pkt_mmap_release
+ *
+ * Description:
+ *   Release a reference on the memory of the rings.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+static void pkt_mmap_release(FAR struct pkt_mmap_s *area)
+{
+  if (--area->refs == 0)
+    {
+      kumm_free(area->vaddr);
+      kmm_free(area);
+    }
+}
+
+/****************************************************************************
+ * Name: pkt_munmap
+ *
+ * Description:
+ *   Unmap the rings.  As with rammap(), a mapping can only be unmapped up
+ *   to its end.
+ *
+ ****************************************************************************/
+
+static int pkt_munmap(FAR struct task_group_s *group,
+                      FAR struct mm_map_entry_s *entry,
+                      FAR void *start, size_t length)
+{
+  off_t offset;
+
+  offset = (uintptr_t)start - (uintptr_t)entry->vaddr;
+  if (offset + length < entry->length)
+    {
+      nerr("ERROR: Cannot umap without unmapping to the end\n");
+      return -ENOSYS;
+    }
+
+  if (offset > 0)
+    {
+      entry->length = offset;
+      return OK;
+    }
+
+  net_lock();
+  pkt_mmap_release(entry->priv.p);
+  net_unlock();
+
+  return mm_map_remove(get_group_mm(group), entry);
+}
+
+/****************************************************************************
+ * Name: pkt_ringsend_eventhandler
+ *
+ * Description:
+ *   Send the next frame of the transmit ring on each poll of the device,
+ *   until no frame is marked with TP_STATUS_SEND_REQUEST.
+ *
+ ****************************************************************************/
+
+static uint16_t pkt_ringsend_eventhandler(FAR struct net_driver_s *dev,
+                                          FAR void *pvpriv, uint16_t flags)
+{
+  FAR struct pkt_ringsend_s *pstate = pvpriv;
+  FAR struct pkt_ring_s *ring;
+  FAR struct tpacket_hdr *hdr;
+
+  if (pstate == NULL)
+    {
+      return flags;
+    }
+
+  /* Wait for the next poll if the device buffer is busy */
+
+  if (dev->d_sndlen > 0 || (flags & PKT_NEWDATA) != 0)
+    {
+      return flags;
+    }
+
+  ring = &pstate->conn->txring;
+  hdr  = pkt_ring_frame(ring, ring->head);
+
+  while (hdr->tp_status == TP_STATUS_SEND_REQUEST)
+    {
+      unsigned int len = hdr->tp_len;
+      int ret;
+
+      /* Read the frame only after its status */
+
+      SP_DMB();
+
+      if (len == 0 || len > ring->framesize - PKT_RING_TXDATA ||
+          len > NETDEV_PKTSIZE(dev))
+        {
+          hdr->tp_status = TP_STATUS_WRONG_FORMAT;
+          pkt_ring_next(ring);
+          hdr = pkt_ring_frame(ring, ring->head);
+          continue;
+        }
+
+      ret = devif_send(dev, (FAR uint8_t *)hdr + PKT_RING_TXDATA, len,
+                       -NET_LL_HDRLEN(dev));
+      if (ret <= 0)
+        {
+          if (pstate->sent == 0)
+            {
+              pstate->sent = ret;
+            }
+
+          break;
+        }
+
+      dev->d_len    = dev->d_sndlen;
+      pstate->sent += len;
+
+      /* Make sure no ARP request overwrites this frame.  This flag will be
+       * cleared in arp_out().
+       */
+
+      IFF_SET_NOARP(dev->d_flags);
+
+      /* The frame is copied to the device buffer, give it back */
+
+      SP_DMB();
+      hdr->tp_status = TP_STATUS_AVAILABLE;
+      pkt_ring_next(ring);
+      pkt_poll_notify(pstate->conn, POLLOUT);
+
+      /* Send the next frame on the next poll */
+
+      hdr = pkt_ring_frame(ring, ring->head);
+      if (hdr->tp_status == TP_STATUS_SEND_REQUEST)
+        {
+          netdev_txnotify_dev(dev);
+          return flags;
+        }
+
+      break;
+    }
+
+  /* Don't allow any further call backs. */
+
+  pstate->cb->flags = 0;
+  pstate->cb->priv  = NULL;
+  pstate->cb->event = NULL;
+
+  nxsem_post(&pstate->sem);
+  return flags;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_ring_setup
+ *
+ * Description:
+ *   Set the geometry of the PACKET_RX_RING or PACKET_TX_RING ring of a
+ *   packet socket, or release the ring if tp_frame_nr is zero.  The memory
+ *   of both rings is allocated again, their frames are given back to the
+ *   kernel.
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.  -EBUSY is
+ *   returned if the rings are mapped.
+ *
+ ****************************************************************************/
+
+int pkt_ring_setup(FAR struct pkt_conn_s *conn, int option,
+                   FAR const struct tpacket_req *req)
+{
+  struct pkt_ring_s rxring;
+  struct pkt_ring_s txring;
+  FAR struct pkt_ring_s *ring;
+  FAR struct pkt_mmap_s *area = NULL;
+  size_t rxsize;
+  size_t txsize;
+  int ret = OK;
+
+  if (req->tp_frame_nr != 0 &&
+      (req->tp_block_size == 0 || req->tp_block_nr == 0 ||
+       req->tp_frame_size < TPACKET_HDRLEN ||
+       (req->tp_frame_size & (TPACKET_ALIGNMENT - 1)) != 0 ||
+       req->tp_frame_size > req->tp_block_size ||
+       req->tp_block_nr > SIZE_MAX / 2 / req->tp_block_size ||
+       req->tp_frame_nr != req->tp_block_size / req->tp_frame_size *
+                           req->tp_block_nr))
+    {
+      return -EINVAL;
+    }
+
+  net_lock();
+
+  if (conn->mmap != NULL && conn->mmap->refs > 1)
+    {
+      ret = -EBUSY;
+      goto errout_with_lock;
+    }
+
+  rxring = conn->rxring;
+  txring = conn->txring;
+  ring   = option == PACKET_RX_RING ? &rxring : &txring;
+
+  memset(ring, 0, sizeof(*ring));
+  if (req->tp_frame_nr != 0)
+    {
+      ring->blocksize = req->tp_block_size;
+      ring->framesize = req->tp_frame_size;
+      ring->framenr   = req->tp_frame_nr;
+      ring->bframes   = req->tp_block_size / req->tp_frame_size;
+    }
+
+  rxsize = rxring.framenr ?
+           (size_t)rxring.framenr / rxring.bframes * rxring.blocksize : 0;
+  txsize = txring.framenr ?
+           (size_t)txring.framenr / txring.bframes * txring.blocksize : 0;
+
+  if (rxsize + txsize > 0)
+    {
+      ret = -ENOMEM;
+      area = kmm_zalloc(sizeof(struct pkt_mmap_s));
+      if (area == NULL)
+        {
+          goto errout_with_lock;
+        }
+
+      area->vaddr = kumm_zalloc(rxsize + txsize);
+      if (area->vaddr == NULL)
+        {
+          kmm_free(area);
+          goto errout_with_lock;
+        }
+
+      area->size = rxsize + txsize;
+      area->refs = 1;
+      ret        = OK;
+    }
+
+  pkt_ring_release(conn);
+
+  rxring.head   = 0;
+  rxring.losing = false;
+  rxring.base   = rxsize > 0 ? area->vaddr : NULL;
+  txring.head   = 0;
+  txring.base   = txsize > 0 ? area->vaddr + rxsize : NULL;
+
+  conn->rxring  = rxring;
+  conn->txring  = txring;
+  conn->mmap    = area;
+
+errout_with_lock:
+  net_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_release
+ *
+ * Description:
+ *   Release the reference of a packet socket on the memory of its rings,
+ *   before the socket is freed.  The memory stays until it is unmapped.
+ *
+ ****************************************************************************/
+
+void pkt_ring_release(FAR struct pkt_conn_s *conn)
+{
+  net_lock();
+
+  if (conn->mmap != NULL)
+    {
+      pkt_mmap_release(conn->mmap);
+      conn->mmap = NULL;
+    }
+
+  conn->rxring.base = NULL;
+  conn->txring.base = NULL;
+
+  net_unlock();
+}
+
+/****************************************************************************
+ * Name: pkt_mmap
+ *
+ * Description:
+ *   Map the rings of a packet socket:  The receive ring followed by the
+ *   transmit ring, from offset zero.
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int pkt_mmap(FAR struct socket *psock, FAR struct mm_map_entry_s *map)
+{
+  FAR struct pkt_conn_s *conn = psock->s_conn;
+  FAR struct pkt_mmap_s *area;
+  int ret;
+
+  net_lock();
+
+  area = conn->mmap;
+  if (area == NULL || map->offset != 0 || map->length > area->size)
+    {
+      net_unlock();
+      return -EINVAL;
+    }
+
+  area->refs++;
+  net_unlock();
+
+  map->vaddr  = area->vaddr;
+  map->priv.p = area;
+  map->munmap = pkt_munmap;
+
+  ret = mm_map_add(get_current_mm(), map);
+  if (ret < 0)
+    {
+      net_lock();
+      pkt_mmap_release(area);
+      net_unlock();
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_input
+ *
+ * Description:
+ *   Copy the received frame of dev->d_iob to the next frame of the receive
+ *   ring.  The frame is dropped if the user did not give that frame back.
+ *
+ * Assumptions:
+ *   This function is called with the network locked, dev->d_buf points to
+ *   the link layer header.
+ *
+ ****************************************************************************/
+
+void pkt_ring_input(FAR struct net_driver_s *dev,
+                    FAR struct pkt_conn_s *conn)
+{
+  FAR struct pkt_ring_s *ring = &conn->rxring;
+  FAR struct tpacket_hdr *hdr = pkt_ring_frame(ring, ring->head);
+  FAR struct sockaddr_ll *sll;
+  struct timespec ts;
+  unsigned long status = TP_STATUS_USER;
+  unsigned int snaplen;
+  int ret;
+
+  if (hdr->tp_status != TP_STATUS_KERNEL)
+    {
+      ninfo("Receive ring full\n");
+      conn->stats.tp_drops++;
+      ring->losing = true;
+      return;
+    }
+
+  snaplen = MIN(dev->d_len, ring->framesize - PKT_RING_RXDATA);
+  ret = iob_copyout((FAR uint8_t *)hdr + PKT_RING_RXDATA, dev->d_iob,
+                    snaplen, -NET_LL_HDRLEN(dev));
+  if (ret < 0)
+    {
+      conn->stats.tp_drops++;
+      ring->losing = true;
+      return;
+    }
+
+  clock_gettime(CLOCK_REALTIME, &ts);
+
+  hdr->tp_len     = dev->d_len;
+  hdr->tp_snaplen = ret;
+  hdr->tp_mac     = PKT_RING_RXDATA;
+  hdr->tp_net     = PKT_RING_RXDATA + NET_LL_HDRLEN(dev);
+  hdr->tp_sec     = ts.tv_sec;
+  hdr->tp_usec    = ts.tv_nsec / 1000;
+
+  sll = (FAR struct sockaddr_ll *)
+        ((FAR uint8_t *)hdr + TPACKET_ALIGN(sizeof(struct tpacket_hdr)));
+  memset(sll, 0, sizeof(*sll));
+  sll->sll_family  = AF_PACKET;
+  sll->sll_ifindex = dev->d_ifindex;
+  sll->sll_hatype  = dev->d_lltype;
+
+#ifdef CONFIG_NET_ETHERNET
+  if (dev->d_lltype == NET_LL_ETHERNET)
+    {
+      FAR struct eth_hdr_s *eth = (FAR struct eth_hdr_s *)dev->d_buf;
+
+      sll->sll_protocol = eth->type;
+      sll->sll_halen    = sizeof(eth->src);
+      memcpy(sll->sll_addr, eth->src, sizeof(eth->src));
+    }
+#endif
+
+  if (ring->losing)
+    {
+      status      |= TP_STATUS_LOSING;
+      ring->losing = false;
+    }
+
+  /* Hand the frame over only once it is complete */
+
+  SP_DMB();
+  hdr->tp_status = status;
+
+  conn->stats.tp_packets++;
+  pkt_ring_next(ring);
+  pkt_poll_notify(conn, POLLIN);
+}
+
+/****************************************************************************
+ * Name: pkt_ring_send
+ *
+ * Description:
+ *   Send the frames of the transmit ring that the user marked with
+ *   TP_STATUS_SEND_REQUEST, in order, and wait until they are all sent.
+ *
+ * Returned Value:
+ *   The number of bytes sent, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t pkt_ring_send(FAR struct net_driver_s *dev,
+                      FAR struct pkt_conn_s *conn)
+{
+  struct pkt_ringsend_s state;
+  int ret;
+
+  net_lock();
+
+  if (pkt_ring_frame(&conn->txring, conn->txring.head)->tp_status !=
+      TP_STATUS_SEND_REQUEST)
+    {
+      net_unlock();
+      return 0;
+    }
+
+  memset(&state, 0, sizeof(state));
+  nxsem_init(&state.sem, 0, 0); /* Doesn't really fail */
+  state.conn = conn;
+
+  state.cb = pkt_callback_alloc(dev, conn);
+  if (state.cb == NULL)
+    {
+      nxsem_destroy(&state.sem);
+      net_unlock();
+      return -EBUSY;
+    }
+
+  state.cb->flags = PKT_POLL;
+  state.cb->priv  = &state;
+  state.cb->event = pkt_ringsend_eventhandler;
+
+  /* Notify the device driver that new TX data is available. */
+
+  netdev_txnotify_dev(dev);
+
+  /* Wait until the frames are sent, or a signal is received */
+
+  ret = net_sem_wait(&state.sem);
+
+  pkt_callback_free(dev, conn, state.cb);
+  nxsem_destroy(&state.sem);
+  net_unlock();
+
+  /* A signal does not hide the frames that are sent */
+
+  return state.sent != 0 ? state.sent : ret;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_pollevents
+ *
+ * Description:
+ *   Return POLLIN if the receive ring holds frames for the user and
+ *   POLLOUT if the next frame of the transmit ring is available.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+pollevent_t pkt_ring_pollevents(FAR struct pkt_conn_s *conn)
+{
+  FAR struct pkt_ring_s *ring;
+  pollevent_t eventset = 0;
+
+  /* The user consumes the frames in order, so the last frame filled is the
+   * last one consumed.
+   */
+
+  ring = &conn->rxring;
+  if (ring->base != NULL &&
+      pkt_ring_frame(ring, ring->head ? ring->head - 1 :
+                                        ring->framenr - 1)->tp_status !=
+      TP_STATUS_KERNEL)
+    {
+      eventset |= POLLIN;
+    }
+
+  ring = &conn->txring;
+  if (ring->base != NULL &&
+      pkt_ring_frame(ring, ring->head)->tp_status == TP_STATUS_AVAILABLE)
+    {
+      eventset |= POLLOUT;
+    }
+
+  return eventset;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_PKT_MMAP */
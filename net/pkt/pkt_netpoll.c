@@ -0,0 +1,143 @@
+/****************************************************************************
+ * net/pkt/pkt_netpoll.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_PKT)
+
+#include <poll.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+
+#include "pkt/pkt.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_poll_notify
+ *
+ * Description:
+ *   Notify the poll() waiters of a packet socket of 'eventset'.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+void pkt_poll_notify(FAR struct pkt_conn_s *conn, pollevent_t eventset)
+{
+  poll_notify(conn->fds, CONFIG_NET_PKT_NPOLLWAITERS, eventset);
+}
+
+/****************************************************************************
+ * Name: pkt_netpoll
+ *
+ * Description:
+ *   Setup or teardown the monitoring of the events of a packet socket.
+ *
+ * Input Parameters:
+ *   psock - The packet socket of interest
+ *   fds   - The structure describing the events to be monitored
+ *   setup - true: Setup up the poll; false: Teardown the poll
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int pkt_netpoll(FAR struct socket *psock, FAR struct pollfd *fds,
+                bool setup)
+{
+  FAR struct pkt_conn_s *conn = psock->s_conn;
+  pollevent_t eventset = 0;
+  int i;
+
+  net_lock();
+
+  if (!setup)
+    {
+      FAR struct pollfd **slot = fds->priv;
+
+      if (slot != NULL)
+        {
+          *slot     = NULL;
+          fds->priv = NULL;
+        }
+
+      net_unlock();
+      return OK;
+    }
+
+  /* Find an available slot */
+
+  for (i = 0; i < CONFIG_NET_PKT_NPOLLWAITERS; i++)
+    {
+      if (conn->fds[i] == NULL)
+        {
+          conn->fds[i] = fds;
+          fds->priv    = &conn->fds[i];
+          break;
+        }
+    }
+
+  if (i >= CONFIG_NET_PKT_NPOLLWAITERS)
+    {
+      net_unlock();
+      fds->priv = NULL;
+      return -EBUSY;
+    }
+
+  /* Report the events already in effect */
+
+#ifdef CONFIG_NET_PKT_MMAP
+  if (conn->rxring.base != NULL || conn->txring.base != NULL)
+    {
+      eventset = pkt_ring_pollevents(conn);
+    }
+
+  if (conn->txring.base == NULL)
+#endif
+    {
+      /* sendmsg() does not use the I/O buffers */
+
+      eventset |= POLLOUT;
+    }
+
+  if (!IOB_QEMPTY(&conn->readahead))
+    {
+      eventset |= POLLIN;
+    }
+
+  poll_notify(&fds, 1, eventset);
+  net_unlock();
+  return OK;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_PKT */
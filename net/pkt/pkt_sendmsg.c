@@ -214,6 +214,17 @@ ssize_t pkt_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
       return -ENODEV;
     }
 
+#ifdef CONFIG_NET_PKT_MMAP
+  /* Once the transmit ring is mapped, send() sends its frames instead of
+   * the buffer.
+   */
+
+  if (((FAR struct pkt_conn_s *)psock->s_conn)->txring.base != NULL)
+    {
+      return pkt_ring_send(dev, psock->s_conn);
+    }
+#endif
+
   /* Perform the send operation */
 
   /* Initialize the state structure. This is done with the network locked
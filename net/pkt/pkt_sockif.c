@@ -55,6 +55,12 @@ static void       pkt_addref(FAR struct socket *psock);
 static int        pkt_bind(FAR struct socket *psock,
                     FAR const struct sockaddr *addr, socklen_t addrlen);
 static int        pkt_close(FAR struct socket *psock);
+#ifdef CONFIG_NET_SOCKOPTS
+static int        pkt_getsockopt(FAR struct socket *psock, int level,
+                    int option, FAR void *value, FAR socklen_t *value_len);
+static int        pkt_setsockopt(FAR struct socket *psock, int level,
+                    int option, FAR const void *value, socklen_t value_len);
+#endif
 
 /****************************************************************************
  * Public Data
@@ -71,10 +77,23 @@ const struct sock_intf_s g_pkt_sockif =
   NULL,            /* si_listen */
   NULL,            /* si_connect */
   NULL,            /* si_accept */
-  NULL,            /* si_poll */
+  pkt_netpoll,     /* si_poll */
   pkt_sendmsg,     /* si_sendmsg */
   pkt_recvmsg,     /* si_recvmsg */
-  pkt_close        /* si_close */
+  pkt_close,       /* si_close */
+  NULL,            /* si_ioctl */
+  NULL,            /* si_socketpair */
+  NULL             /* si_shutdown */
+#ifdef CONFIG_NET_SOCKOPTS
+  , pkt_getsockopt /* si_getsockopt */
+  , pkt_setsockopt /* si_setsockopt */
+#endif
+#ifdef CONFIG_NET_SENDFILE
+  , NULL           /* si_sendfile */
+#endif
+#ifdef CONFIG_NET_PKT_MMAP
+  , pkt_mmap       /* si_mmap */
+#endif
 };
 
 /****************************************************************************
@@ -301,6 +320,12 @@ static int pkt_close(FAR struct socket *psock)
 
               iob_free_queue(&conn->readahead);
 
+#ifdef CONFIG_NET_PKT_MMAP
+              /* And the rings, once they are unmapped */
+
+              pkt_ring_release(conn);
+#endif
+
               /* Then free the connection structure */
 
               conn->crefs = 0;          /* No more references on the connection */
@@ -321,6 +346,105 @@ static int pkt_close(FAR struct socket *psock)
     }
 }
 
+/****************************************************************************
+ * Name: pkt_getsockopt
+ *
+ * Description:
+ *   Get the SOL_PACKET option PACKET_STATISTICS of a packet socket:  The
+ *   frames received and dropped since the last call.
+ *
+ * Input Parameters:
+ *   psock     Socket structure of the socket to query
+ *   level     Protocol level to set the option
+ *   option    identifies the option to get
+ *   value     Points to the argument value
+ *   value_len The length of the argument value
+ *
+ * Returned Value:
+ *   0 on success;  A negated errno value is returned on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SOCKOPTS
+static int pkt_getsockopt(FAR struct socket *psock, int level,
+                          int option, FAR void *value,
+                          FAR socklen_t *value_len)
+{
+  FAR struct pkt_conn_s *conn = psock->s_conn;
+
+  if (level != SOL_PACKET)
+    {
+      return -ENOPROTOOPT;
+    }
+
+  switch (option)
+    {
+      case PACKET_STATISTICS:
+        if (*value_len < sizeof(struct tpacket_stats))
+          {
+            return -EINVAL;
+          }
+
+        net_lock();
+        memcpy(value, &conn->stats, sizeof(struct tpacket_stats));
+        memset(&conn->stats, 0, sizeof(struct tpacket_stats));
+        net_unlock();
+
+        *value_len = sizeof(struct tpacket_stats);
+        return OK;
+
+      default:
+        return -ENOPROTOOPT;
+    }
+}
+
+/****************************************************************************
+ * Name: pkt_setsockopt
+ *
+ * Description:
+ *   Set the SOL_PACKET options PACKET_RX_RING and PACKET_TX_RING of a
+ *   packet socket.
+ *
+ * Input Parameters:
+ *   psock     Socket structure of the socket to query
+ *   level     Protocol level to set the option
+ *   option    identifies the option to set
+ *   value     Points to the argument value
+ *   value_len The length of the argument value
+ *
+ * Returned Value:
+ *   0 on success;  A negated errno value is returned on failure.
+ *
+ ****************************************************************************/
+
+static int pkt_setsockopt(FAR struct socket *psock, int level,
+                          int option, FAR const void *value,
+                          socklen_t value_len)
+{
+  if (level != SOL_PACKET)
+    {
+      return -ENOPROTOOPT;
+    }
+
+  switch (option)
+    {
+#ifdef CONFIG_NET_PKT_MMAP
+      case PACKET_RX_RING:
+      case PACKET_TX_RING:
+        if (value == NULL || value_len < sizeof(struct tpacket_req))
+          {
+            return -EINVAL;
+          }
+
+        return pkt_ring_setup(psock->s_conn, option, value);
+#endif
+
+      default:
+        return -ENOPROTOOPT;
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -0,0 +1,122 @@
+/****************************************************************************
+ * net/procfs/net_layers.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+
+#include "procfs/procfs.h"
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_LAYER_STATS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LAYER_LINELEN 80
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR const char *g_layer_names[NET_LAYER_NLAYERS] =
+{
+  "ipv4",
+  "ipv6",
+  "tcp",
+  "udp",
+  "poll"
+};
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_read_layerstats
+ *
+ * Description:
+ *   Read and format the timing statistics of the network layers.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which network status will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_layerstats(FAR struct netprocfs_file_s *priv,
+                                  FAR char *buffer, size_t buflen)
+{
+  struct net_layerstats_s stats[NET_LAYER_NLAYERS];
+  FAR struct net_layerstats_s *layer;
+  unsigned long freq = perf_getfreq();
+  int len = 0;
+  int i;
+
+  /* The whole table is returned at once */
+
+  if (priv->offset > 0 || buflen < (NET_LAYER_NLAYERS + 1) * LAYER_LINELEN)
+    {
+      return 0;
+    }
+
+  net_layerstats(stats);
+
+  len += snprintf(buffer + len, buflen - len,
+                  "%-6s %10s %12s %10s %10s\n",
+                  "layer", "count", "time_us", "avg_ns", "max_ns");
+
+  for (i = 0; i < NET_LAYER_NLAYERS; i++)
+    {
+      layer = &stats[i];
+      len += snprintf(buffer + len, buflen - len,
+                      "%-6s %10" PRIu32 " %12" PRIu64 " %10" PRIu64
+                      " %10" PRIu64 "\n",
+                      g_layer_names[i], layer->count,
+                      layer->time * USEC_PER_SEC / freq,
+                      layer->count > 0 ? layer->time / layer->count *
+                                         NSEC_PER_SEC / freq : 0,
+                      (uint64_t)layer->maxtime * NSEC_PER_SEC / freq);
+    }
+
+  priv->offset = 1;
+  return len;
+}
+
+#endif /* CONFIG_NET_LAYER_STATS */
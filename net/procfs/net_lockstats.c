@@ -0,0 +1,178 @@
+/****************************************************************************
+ * net/procfs/net_lockstats.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+
+#include "procfs/procfs.h"
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_LOCK_STATS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LOCK_LINELEN 80
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_usec
+ *
+ * Description:
+ *   Convert performance counter ticks to microseconds.
+ *
+ ****************************************************************************/
+
+static uint64_t netprocfs_usec(uint64_t ticks)
+{
+  return ticks * USEC_PER_SEC / perf_getfreq();
+}
+
+/****************************************************************************
+ * Name: netprocfs_sortsites
+ *
+ * Description:
+ *   Sort the call sites by decreasing total hold time.
+ *
+ ****************************************************************************/
+
+static void netprocfs_sortsites(FAR struct net_lockstats_s *stats)
+{
+  struct net_locksite_s tmp;
+  int i;
+  int j;
+
+  for (i = 1; i < CONFIG_NET_LOCK_STATS_SITES; i++)
+    {
+      tmp = stats->sites[i];
+      for (j = i; j > 0 && stats->sites[j - 1].holdtime < tmp.holdtime;
+           j--)
+        {
+          stats->sites[j] = stats->sites[j - 1];
+        }
+
+      stats->sites[j] = tmp;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_read_lockstats
+ *
+ * Description:
+ *   Read and format the statistics of the network lock.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which network status will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_lockstats(FAR struct netprocfs_file_s *priv,
+                                 FAR char *buffer, size_t buflen)
+{
+  struct net_lockstats_s stats;
+  FAR struct net_locksite_s *site;
+  int len = 0;
+  int i;
+
+  net_lockstats(&stats);
+  netprocfs_sortsites(&stats);
+
+  /* priv->offset is the number of lines already returned: The summary,
+   * then one line per call site.
+   */
+
+  if (priv->offset == 0)
+    {
+      if (buflen < 4 * LOCK_LINELEN)
+        {
+          return 0;
+        }
+
+      len += snprintf(buffer + len, buflen - len,
+                      "%10s %10s %12s %10s %12s %10s\n",
+                      "count", "contended", "wait_us", "maxwait",
+                      "hold_us", "maxhold");
+      len += snprintf(buffer + len, buflen - len,
+                      "%10" PRIu32 " %10" PRIu32 " %12" PRIu64
+                      " %10" PRIu64 " %12" PRIu64 " %10" PRIu64 "\n\n",
+                      stats.count, stats.contended,
+                      netprocfs_usec(stats.waittime),
+                      netprocfs_usec(stats.maxwait),
+                      netprocfs_usec(stats.holdtime),
+                      netprocfs_usec(stats.maxhold));
+      len += snprintf(buffer + len, buflen - len,
+                      "%-18s %10s %12s %10s\n",
+                      "caller", "count", "hold_us", "maxhold");
+      priv->offset = 1;
+    }
+
+  for (i = priv->offset - 1; i < CONFIG_NET_LOCK_STATS_SITES; i++)
+    {
+      site = &stats.sites[i];
+      if (site->caller == NULL)
+        {
+          break;
+        }
+
+      if (buflen - len < LOCK_LINELEN)
+        {
+          break;
+        }
+
+      len += snprintf(buffer + len, buflen - len,
+                      "%-18p %10" PRIu32 " %12" PRIu64 " %10" PRIu64 "\n",
+                      site->caller, site->count,
+                      netprocfs_usec(site->holdtime),
+                      netprocfs_usec(site->maxhold));
+      priv->offset++;
+    }
+
+  return len;
+}
+
+#endif /* CONFIG_NET_LOCK_STATS */
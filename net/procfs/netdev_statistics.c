@@ -424,12 +424,13 @@ static int netprocfs_rxstatistics_header(
 #ifdef CONFIG_NETDEV_STATISTICS
 static int netprocfs_rxstatistics(FAR struct netprocfs_file_s *netfile)
 {
-  FAR struct netdev_statistics_s *stats;
+  struct netdev_statistics_s devstats;
+  FAR struct netdev_statistics_s *stats = &devstats;
   FAR struct net_driver_s *dev;
 
   DEBUGASSERT(netfile != NULL && netfile->dev != NULL);
   dev = netfile->dev;
-  stats = &dev->d_statistics;
+  netdev_statistics_fold(dev, stats);
 
   return snprintf(netfile->line, NET_LINELEN, \
                   "\t    %08lx %08lx %08lx %-16llx\n",
@@ -484,13 +485,14 @@ static int netprocfs_rxpackets_header(FAR struct netprocfs_file_s *netfile)
 #ifdef CONFIG_NETDEV_STATISTICS
 static int netprocfs_rxpackets(FAR struct netprocfs_file_s *netfile)
 {
-  FAR struct netdev_statistics_s *stats;
+  struct netdev_statistics_s devstats;
+  FAR struct netdev_statistics_s *stats = &devstats;
   FAR struct net_driver_s *dev;
   FAR char *fmt;
 
   DEBUGASSERT(netfile != NULL && netfile->dev != NULL);
   dev = netfile->dev;
-  stats = &dev->d_statistics;
+  netdev_statistics_fold(dev, stats);
 
   fmt = "\t    "
 #ifdef CONFIG_NET_IPv4
@@ -541,12 +543,13 @@ static int netprocfs_txstatistics_header(
 #ifdef CONFIG_NETDEV_STATISTICS
 static int netprocfs_txstatistics(FAR struct netprocfs_file_s *netfile)
 {
-  FAR struct netdev_statistics_s *stats;
+  struct netdev_statistics_s devstats;
+  FAR struct netdev_statistics_s *stats = &devstats;
   FAR struct net_driver_s *dev;
 
   DEBUGASSERT(netfile != NULL && netfile->dev != NULL);
   dev = netfile->dev;
-  stats = &dev->d_statistics;
+  netdev_statistics_fold(dev, stats);
 
   return snprintf(netfile->line, NET_LINELEN,
                   "\t    %08lx %08lx %08lx %08lx %-16llx \n",
@@ -565,12 +568,13 @@ static int netprocfs_txstatistics(FAR struct netprocfs_file_s *netfile)
 #ifdef CONFIG_NETDEV_STATISTICS
 static int netprocfs_errors(FAR struct netprocfs_file_s *netfile)
 {
-  FAR struct netdev_statistics_s *stats;
+  struct netdev_statistics_s devstats;
+  FAR struct netdev_statistics_s *stats = &devstats;
   FAR struct net_driver_s *dev;
 
   DEBUGASSERT(netfile != NULL && netfile->dev != NULL);
   dev = netfile->dev;
-  stats = &dev->d_statistics;
+  netdev_statistics_fold(dev, stats);
 
   return snprintf(netfile->line, NET_LINELEN,
                   "\tTotal Errors: %08" PRIx32 "\n\n",
@@ -0,0 +1,168 @@
+/****************************************************************************
+ * net/route/lpmroute.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __NET_ROUTE_LPMROUTE_H
+#define __NET_ROUTE_LPMROUTE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include "route/route.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The longest-prefix-match tries index the in-memory routing tables */
+
+#if defined(CONFIG_ROUTE_LPM) && defined(CONFIG_ROUTE_IPv4_RAMROUTE)
+#  define ROUTE_IPv4_LPM 1
+#endif
+
+#if defined(CONFIG_ROUTE_LPM) && defined(CONFIG_ROUTE_IPv6_RAMROUTE)
+#  define ROUTE_IPv6_LPM 1
+#endif
+
+#if defined(ROUTE_IPv4_LPM) || defined(ROUTE_IPv6_LPM)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This structure links a route of the in-memory routing table in the trie.
+ * The routes of the same prefix are kept in the order they were added.
+ */
+
+struct lpm_route_s
+{
+  FAR struct lpm_route_s *next;  /* The next route of the same prefix */
+  FAR void *route;               /* struct net_route_ipv4/6_s */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_init_lpmroute
+ *
+ * Description:
+ *   Initialize the longest-prefix-match tries of the routing tables
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called early in initialization so that no special protection is needed.
+ *
+ ****************************************************************************/
+
+void net_init_lpmroute(void);
+
+/****************************************************************************
+ * Name: net_addlpm_ipv4 and net_addlpm_ipv6
+ *
+ * Description:
+ *   Add a route of the in-memory routing table to the trie
+ *
+ * Input Parameters:
+ *   route - The route, allocated by net_allocroute_ipv4/6()
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -EINVAL is returned if the netmask
+ *   of the route is not contiguous.
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+#ifdef ROUTE_IPv4_LPM
+int net_addlpm_ipv4(FAR struct net_route_ipv4_s *route);
+#endif
+
+#ifdef ROUTE_IPv6_LPM
+int net_addlpm_ipv6(FAR struct net_route_ipv6_s *route);
+#endif
+
+/****************************************************************************
+ * Name: net_dellpm_ipv4 and net_dellpm_ipv6
+ *
+ * Description:
+ *   Remove a route of the in-memory routing table from the trie
+ *
+ * Input Parameters:
+ *   route - The route added with net_addlpm_ipv4/6()
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+#ifdef ROUTE_IPv4_LPM
+void net_dellpm_ipv4(FAR struct net_route_ipv4_s *route);
+#endif
+
+#ifdef ROUTE_IPv6_LPM
+void net_dellpm_ipv6(FAR struct net_route_ipv6_s *route);
+#endif
+
+/****************************************************************************
+ * Name: net_foreachlpm_ipv4 and net_foreachlpm_ipv6
+ *
+ * Description:
+ *   Traverse the routes whose network contains an address, by increasing
+ *   prefix length:  Only the nodes on the path of the address in the trie
+ *   are visited, instead of the whole routing table.
+ *
+ * Input Parameters:
+ *   target  - The address to look up
+ *   handler - Will be called for each route of a network of the address.
+ *   arg     - An arbitrary value that will be passed to the handler.
+ *
+ * Returned Value:
+ *   Zero (OK) returned if all the routes were visited.  Handlers may also
+ *   terminate the search early with any non-zero, non-negative value.
+ *
+ ****************************************************************************/
+
+#ifdef ROUTE_IPv4_LPM
+int net_foreachlpm_ipv4(in_addr_t target, route_handler_ipv4_t handler,
+                        FAR void *arg);
+#endif
+
+#ifdef ROUTE_IPv6_LPM
+int net_foreachlpm_ipv6(const net_ipv6addr_t target,
+                        route_handler_ipv6_t handler, FAR void *arg);
+#endif
+
+#endif /* ROUTE_IPv4_LPM || ROUTE_IPv6_LPM */
+#endif /* __NET_ROUTE_LPMROUTE_H */
@@ -36,7 +36,9 @@
 
 #include <arch/irq.h>
 
+#include "ipforward/ipforward.h"
 #include "netlink/netlink.h"
+#include "route/lpmroute.h"
 #include "route/ramroute.h"
 #include "route/route.h"
 
@@ -63,6 +65,9 @@
 int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
 {
   FAR struct net_route_ipv4_s *route;
+#ifdef ROUTE_IPv4_LPM
+  int ret;
+#endif
 
   /* Allocate a route entry */
 
@@ -84,12 +89,25 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
 
   net_lock();
 
+#ifdef ROUTE_IPv4_LPM
+  /* Index the route in the trie, its netmask must be contiguous */
+
+  ret = net_addlpm_ipv4(route);
+  if (ret < 0)
+    {
+      net_unlock();
+      net_freeroute_ipv4(route);
+      return ret;
+    }
+#endif
+
   /* Then add the new entry to the table */
 
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
                         &g_ipv4_routes);
   net_unlock();
 
+  ipfwd_flowcache_flush();
   netlink_route_notify(route, RTM_NEWROUTE, AF_INET);
   return OK;
 }
@@ -100,6 +118,9 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
                       net_ipv6addr_t router)
 {
   FAR struct net_route_ipv6_s *route;
+#ifdef ROUTE_IPv6_LPM
+  int ret;
+#endif
 
   /* Allocate a route entry */
 
@@ -121,6 +142,18 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
 
   net_lock();
 
+#ifdef ROUTE_IPv6_LPM
+  /* Index the route in the trie, its netmask must be contiguous */
+
+  ret = net_addlpm_ipv6(route);
+  if (ret < 0)
+    {
+      net_unlock();
+      net_freeroute_ipv6(route);
+      return ret;
+    }
+#endif
+
   /* Then add the new entry to the table */
 
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
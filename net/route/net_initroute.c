@@ -28,6 +28,7 @@
 
 #include "route/ramroute.h"
 #include "route/cacheroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #ifdef CONFIG_NET_ROUTE
@@ -56,6 +57,10 @@ void net_init_route(void)
   net_init_ramroute();
 #endif
 
+#if defined(ROUTE_IPv4_LPM) || defined(ROUTE_IPv6_LPM)
+  net_init_lpmroute();
+#endif
+
 #if defined(CONFIG_ROUTE_IPv4_CACHEROUTE) || defined(CONFIG_ROUTE_IPv6_CACHEROUTE)
   net_init_cacheroute();
 #endif
@@ -0,0 +1,619 @@
+/****************************************************************************
+ * net/route/net_lpmroute.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/net/net.h>
+#include <nuttx/net/ip.h>
+
+#include "route/ramroute.h"
+#include "route/lpmroute.h"
+#include "route/route.h"
+
+#if defined(ROUTE_IPv4_LPM) || defined(ROUTE_IPv6_LPM)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The size of the keys of the trie nodes */
+
+#ifdef ROUTE_IPv6_LPM
+#  define LPM_KEYLEN sizeof(net_ipv6addr_t)
+#else
+#  define LPM_KEYLEN sizeof(in_addr_t)
+#endif
+
+/* A path-compressed binary trie with N prefixes has at most N - 1 branch
+ * nodes, since each branch node has two children:  Two nodes per route
+ * are enough, whatever the order of the additions and the deletions.
+ */
+
+#define LPM_IPv4_NODES (2 * CONFIG_ROUTE_MAX_IPv4_RAMROUTES)
+#define LPM_IPv6_NODES (2 * CONFIG_ROUTE_MAX_IPv6_RAMROUTES)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A node of the trie:  The prefix of a child extends the prefix of its
+ * parent, with the bit that follows the prefix of the parent selecting the
+ * child.  The nodes of a prefix without any route only join two subtries.
+ */
+
+struct lpm_node_s
+{
+  FAR struct lpm_node_s *child[2]; /* The subtries, child[0] links the
+                                    * free nodes */
+  FAR struct lpm_route_s *routes;  /* The routes of the prefix, NULL for a
+                                    * branch node */
+  uint8_t len;                     /* The prefix length in bits */
+  uint8_t key[LPM_KEYLEN];         /* The prefix, zero beyond len */
+};
+
+struct lpm_trie_s
+{
+  FAR struct lpm_node_s *root;     /* The root of the trie */
+  FAR struct lpm_node_s *free;     /* The free nodes */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef ROUTE_IPv4_LPM
+static struct lpm_trie_s g_ipv4_lpm;
+static struct lpm_node_s g_ipv4_lpmnodes[LPM_IPv4_NODES];
+#endif
+
+#ifdef ROUTE_IPv6_LPM
+static struct lpm_trie_s g_ipv6_lpm;
+static struct lpm_node_s g_ipv6_lpmnodes[LPM_IPv6_NODES];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lpm_bit
+ *
+ * Description:
+ *   Return the bit 'n' of an address in network order, the MS bit first.
+ *
+ ****************************************************************************/
+
+static inline int lpm_bit(FAR const uint8_t *key, unsigned int n)
+{
+  return (key[n >> 3] >> (7 - (n & 7))) & 1;
+}
+
+/****************************************************************************
+ * Name: lpm_common
+ *
+ * Description:
+ *   Return the length of the common prefix of two addresses, at most 'len'.
+ *
+ ****************************************************************************/
+
+static unsigned int lpm_common(FAR const uint8_t *a, FAR const uint8_t *b,
+                               unsigned int len)
+{
+  unsigned int n;
+  uint8_t diff;
+
+  for (n = 0; n < len; n += 8)
+    {
+      diff = a[n >> 3] ^ b[n >> 3];
+      if (diff != 0)
+        {
+          while ((diff & 0x80) == 0)
+            {
+              diff <<= 1;
+              n++;
+            }
+
+          break;
+        }
+    }
+
+  return n < len ? n : len;
+}
+
+/****************************************************************************
+ * Name: lpm_masklen
+ *
+ * Description:
+ *   Return the prefix length of a netmask of 'size' bytes, -EINVAL if the
+ *   netmask is not contiguous.
+ *
+ ****************************************************************************/
+
+static int lpm_masklen(FAR const uint8_t *mask, unsigned int size)
+{
+  unsigned int len;
+  unsigned int n;
+
+  for (len = 0; len < size * 8 && lpm_bit(mask, len) != 0; len++)
+    {
+    }
+
+  for (n = len; n < size * 8; n++)
+    {
+      if (lpm_bit(mask, n) != 0)
+        {
+          return -EINVAL;
+        }
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: lpm_alloc
+ *
+ * Description:
+ *   Allocate a node for the prefix of 'len' bits of 'key'.
+ *
+ ****************************************************************************/
+
+static FAR struct lpm_node_s *lpm_alloc(FAR struct lpm_trie_s *trie,
+                                        FAR const uint8_t *key,
+                                        unsigned int len)
+{
+  FAR struct lpm_node_s *node = trie->free;
+  unsigned int n;
+
+  DEBUGASSERT(node != NULL);
+  trie->free = node->child[0];
+
+  node->child[0] = NULL;
+  node->child[1] = NULL;
+  node->routes   = NULL;
+  node->len      = len;
+
+  memset(node->key, 0, sizeof(node->key));
+  memcpy(node->key, key, (len + 7) >> 3);
+
+  n = len & 7;
+  if (n != 0)
+    {
+      node->key[len >> 3] &= (uint8_t)(0xff << (8 - n));
+    }
+
+  return node;
+}
+
+/****************************************************************************
+ * Name: lpm_free
+ ****************************************************************************/
+
+static void lpm_free(FAR struct lpm_trie_s *trie,
+                     FAR struct lpm_node_s *node)
+{
+  node->child[0] = trie->free;
+  trie->free     = node;
+}
+
+/****************************************************************************
+ * Name: lpm_init
+ ****************************************************************************/
+
+static void lpm_init(FAR struct lpm_trie_s *trie,
+                     FAR struct lpm_node_s *nodes, unsigned int nnodes)
+{
+  unsigned int i;
+
+  trie->root = NULL;
+  trie->free = NULL;
+
+  for (i = 0; i < nnodes; i++)
+    {
+      lpm_free(trie, &nodes[i]);
+    }
+}
+
+/****************************************************************************
+ * Name: lpm_insert
+ *
+ * Description:
+ *   Add a route for the prefix of 'len' bits of 'key', after the routes of
+ *   the same prefix.
+ *
+ ****************************************************************************/
+
+static void lpm_insert(FAR struct lpm_trie_s *trie, FAR const uint8_t *key,
+                       unsigned int len, FAR struct lpm_route_s *route)
+{
+  FAR struct lpm_node_s **link = &trie->root;
+  FAR struct lpm_node_s *node;
+  FAR struct lpm_node_s *leaf;
+  FAR struct lpm_node_s *branch;
+  FAR struct lpm_route_s **tail;
+  unsigned int common = 0;
+
+  route->next = NULL;
+
+  /* Go down while the prefix of the node is a prefix of the key */
+
+  while ((node = *link) != NULL)
+    {
+      common = lpm_common(node->key, key,
+                          node->len < len ? node->len : len);
+      if (common < node->len)
+        {
+          break;
+        }
+
+      if (node->len == len)
+        {
+          /* The prefix exists already */
+
+          for (tail = &node->routes; *tail != NULL; tail = &(*tail)->next)
+            {
+            }
+
+          *tail = route;
+          return;
+        }
+
+      link = &node->child[lpm_bit(key, node->len)];
+    }
+
+  leaf = lpm_alloc(trie, key, len);
+  leaf->routes = route;
+
+  if (node == NULL)
+    {
+      *link = leaf;
+    }
+  else if (common == len)
+    {
+      /* The new prefix is a prefix of the node, it becomes its parent */
+
+      leaf->child[lpm_bit(node->key, len)] = node;
+      *link = leaf;
+    }
+  else
+    {
+      /* The prefixes diverge, join them with a branch node */
+
+      branch = lpm_alloc(trie, key, common);
+      branch->child[lpm_bit(key, common)]       = leaf;
+      branch->child[lpm_bit(node->key, common)] = node;
+      *link = branch;
+    }
+}
+
+/****************************************************************************
+ * Name: lpm_remove
+ *
+ * Description:
+ *   Remove a route of the prefix of 'len' bits of 'key', then the nodes
+ *   that are no longer needed.
+ *
+ ****************************************************************************/
+
+static void lpm_remove(FAR struct lpm_trie_s *trie, FAR const uint8_t *key,
+                       unsigned int len, FAR struct lpm_route_s *route)
+{
+  FAR struct lpm_node_s **plink = NULL;
+  FAR struct lpm_node_s **link = &trie->root;
+  FAR struct lpm_node_s *parent;
+  FAR struct lpm_node_s *node;
+  FAR struct lpm_route_s **prev;
+
+  while ((node = *link) != NULL && node->len < len)
+    {
+      plink = link;
+      link  = &node->child[lpm_bit(key, node->len)];
+    }
+
+  if (node == NULL || node->len != len ||
+      lpm_common(node->key, key, len) != len)
+    {
+      return;
+    }
+
+  for (prev = &node->routes; *prev != NULL; prev = &(*prev)->next)
+    {
+      if (*prev == route)
+        {
+          *prev = route->next;
+          break;
+        }
+    }
+
+  if (node->routes != NULL || (node->child[0] != NULL &&
+                               node->child[1] != NULL))
+    {
+      /* Other routes of the prefix, or a branch node now */
+
+      return;
+    }
+
+  /* Replace the node by its only child, if any */
+
+  *link = node->child[node->child[0] == NULL];
+  lpm_free(trie, node);
+
+  /* A branch node that is left with a single child goes too */
+
+  parent = plink != NULL ? *plink : NULL;
+  if (*link == NULL && parent != NULL && parent->routes == NULL)
+    {
+      *plink = parent->child[parent->child[0] == NULL];
+      lpm_free(trie, parent);
+    }
+}
+
+/****************************************************************************
+ * Name: lpm_next
+ *
+ * Description:
+ *   Return the next node on the path of 'addr' below 'node', or the root
+ *   if 'node' is NULL, whose prefix contains 'addr'.
+ *
+ ****************************************************************************/
+
+static FAR struct lpm_node_s *lpm_next(FAR struct lpm_trie_s *trie,
+                                       FAR struct lpm_node_s *node,
+                                       FAR const uint8_t *addr,
+                                       unsigned int maxlen)
+{
+  if (node == NULL)
+    {
+      node = trie->root;
+    }
+  else if (node->len < maxlen)
+    {
+      node = node->child[lpm_bit(addr, node->len)];
+    }
+  else
+    {
+      return NULL;
+    }
+
+  /* The prefixes below a node that does not contain the address do not
+   * contain it either.
+   */
+
+  if (node != NULL && lpm_common(node->key, addr, node->len) != node->len)
+    {
+      return NULL;
+    }
+
+  return node;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_init_lpmroute
+ *
+ * Description:
+ *   Initialize the longest-prefix-match tries of the routing tables
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called early in initialization so that no special protection is needed.
+ *
+ ****************************************************************************/
+
+void net_init_lpmroute(void)
+{
+#ifdef ROUTE_IPv4_LPM
+  lpm_init(&g_ipv4_lpm, g_ipv4_lpmnodes, LPM_IPv4_NODES);
+#endif
+
+#ifdef ROUTE_IPv6_LPM
+  lpm_init(&g_ipv6_lpm, g_ipv6_lpmnodes, LPM_IPv6_NODES);
+#endif
+}
+
+/****************************************************************************
+ * Name: net_addlpm_ipv4 and net_addlpm_ipv6
+ *
+ * Description:
+ *   Add a route of the in-memory routing table to the trie
+ *
+ * Input Parameters:
+ *   route - The route, allocated by net_allocroute_ipv4/6()
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -EINVAL is returned if the netmask
+ *   of the route is not contiguous.
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+#ifdef ROUTE_IPv4_LPM
+int net_addlpm_ipv4(FAR struct net_route_ipv4_s *route)
+{
+  FAR struct net_route_ipv4_entry_s *entry =
+    (FAR struct net_route_ipv4_entry_s *)route;
+  int len;
+
+  len = lpm_masklen((FAR const uint8_t *)&route->netmask,
+                    sizeof(in_addr_t));
+  if (len < 0)
+    {
+      return len;
+    }
+
+  entry->lpm.route = route;
+  lpm_insert(&g_ipv4_lpm, (FAR const uint8_t *)&route->target, len,
+             &entry->lpm);
+  return OK;
+}
+#endif
+
+#ifdef ROUTE_IPv6_LPM
+int net_addlpm_ipv6(FAR struct net_route_ipv6_s *route)
+{
+  FAR struct net_route_ipv6_entry_s *entry =
+    (FAR struct net_route_ipv6_entry_s *)route;
+  int len;
+
+  len = lpm_masklen((FAR const uint8_t *)route->netmask,
+                    sizeof(net_ipv6addr_t));
+  if (len < 0)
+    {
+      return len;
+    }
+
+  entry->lpm.route = route;
+  lpm_insert(&g_ipv6_lpm, (FAR const uint8_t *)route->target, len,
+             &entry->lpm);
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: net_dellpm_ipv4 and net_dellpm_ipv6
+ *
+ * Description:
+ *   Remove a route of the in-memory routing table from the trie
+ *
+ * Input Parameters:
+ *   route - The route added with net_addlpm_ipv4/6()
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+#ifdef ROUTE_IPv4_LPM
+void net_dellpm_ipv4(FAR struct net_route_ipv4_s *route)
+{
+  FAR struct net_route_ipv4_entry_s *entry =
+    (FAR struct net_route_ipv4_entry_s *)route;
+
+  lpm_remove(&g_ipv4_lpm, (FAR const uint8_t *)&route->target,
+             lpm_masklen((FAR const uint8_t *)&route->netmask,
+                         sizeof(in_addr_t)), &entry->lpm);
+}
+#endif
+
+#ifdef ROUTE_IPv6_LPM
+void net_dellpm_ipv6(FAR struct net_route_ipv6_s *route)
+{
+  FAR struct net_route_ipv6_entry_s *entry =
+    (FAR struct net_route_ipv6_entry_s *)route;
+
+  lpm_remove(&g_ipv6_lpm, (FAR const uint8_t *)route->target,
+             lpm_masklen((FAR const uint8_t *)route->netmask,
+                         sizeof(net_ipv6addr_t)), &entry->lpm);
+}
+#endif
+
+/****************************************************************************
+ * Name: net_foreachlpm_ipv4 and net_foreachlpm_ipv6
+ *
+ * Description:
+ *   Traverse the routes whose network contains an address, by increasing
+ *   prefix length:  Only the nodes on the path of the address in the trie
+ *   are visited, instead of the whole routing table.
+ *
+ * Input Parameters:
+ *   target  - The address to look up
+ *   handler - Will be called for each route of a network of the address.
+ *   arg     - An arbitrary value that will be passed to the handler.
+ *
+ * Returned Value:
+ *   Zero (OK) returned if all the routes were visited.  Handlers may also
+ *   terminate the search early with any non-zero, non-negative value.
+ *
+ ****************************************************************************/
+
+#ifdef ROUTE_IPv4_LPM
+int net_foreachlpm_ipv4(in_addr_t target, route_handler_ipv4_t handler,
+                        FAR void *arg)
+{
+  FAR const uint8_t *addr = (FAR const uint8_t *)&target;
+  FAR struct lpm_node_s *node = NULL;
+  FAR struct lpm_route_s *route;
+  int ret = 0;
+
+  net_lock();
+
+  while (ret == 0 && (node = lpm_next(&g_ipv4_lpm, node, addr, 32)) != NULL)
+    {
+      for (route = node->routes; ret == 0 && route != NULL;
+           route = route->next)
+        {
+          ret = handler(route->route, arg);
+        }
+    }
+
+  net_unlock();
+  return ret;
+}
+#endif
+
+#ifdef ROUTE_IPv6_LPM
+int net_foreachlpm_ipv6(const net_ipv6addr_t target,
+                        route_handler_ipv6_t handler, FAR void *arg)
+{
+  FAR const uint8_t *addr = (FAR const uint8_t *)target;
+  FAR struct lpm_node_s *node = NULL;
+  FAR struct lpm_route_s *route;
+  int ret = 0;
+
+  net_lock();
+
+  while (ret == 0 && (node = lpm_next(&g_ipv6_lpm, node, addr, 128)) != NULL)
+    {
+      for (route = node->routes; ret == 0 && route != NULL;
+           route = route->next)
+        {
+          ret = handler(route->route, arg);
+        }
+    }
+
+  net_unlock();
+  return ret;
+}
+#endif
+
+#endif /* ROUTE_IPv4_LPM || ROUTE_IPv6_LPM */
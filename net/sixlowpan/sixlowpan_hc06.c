@@ -59,7 +59,9 @@
 
 #include <nuttx/config.h>
 
+#include <stddef.h>
 #include <string.h>
+#include <assert.h>
 #include <debug.h>
 
 #include <nuttx/mm/iob.h>
@@ -86,6 +88,12 @@
 #define UNCOMPRESS_MACBASED (1 << 8)
 #define UNCOMPRESS_ZEROPAD  (1 << 9)
 
+/* The largest IPHC header: IPHC, SCI/DCI, TF, NH, HLIM and two full
+ * addresses
+ */
+
+#define HC06_TMPL_MAXLEN    (2 + 1 + 4 + 1 + 1 + 16 + 16)
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -101,6 +109,24 @@ struct sixlowpan_addrcontext_s
   uint8_t prefix[8];
 };
 
+#if CONFIG_NET_6LOWPAN_HC06_TEMPLATES > 0
+/* The IPHC bytes of a flow and the fields they were compressed from:  They
+ * only depend on the IPv6 header but its payload length, the link layer
+ * addresses and the address contexts, which are fixed.  The next packets
+ * of the flow copy them instead of compressing the IPv6 header again.
+ */
+
+struct sixlowpan_hc06tmpl_s
+{
+  FAR struct radio_driver_s *radio;  /* The radio, NULL if unused */
+  struct netdev_varaddr_s srcmac;    /* The link layer source address */
+  struct netdev_varaddr_s destmac;   /* The link layer destination address */
+  struct ipv6_hdr_s ipv6;            /* The IPv6 header compressed */
+  uint8_t iphclen;                   /* The length of the IPHC bytes */
+  uint8_t iphc[HC06_TMPL_MAXLEN];    /* The IPHC bytes */
+};
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -124,6 +150,13 @@ static struct sixlowpan_addrcontext_s
 
 static FAR uint8_t *g_hc06ptr;
 
+#if CONFIG_NET_6LOWPAN_HC06_TEMPLATES > 0
+/* The IPHC bytes compressed for the recent flows */
+
+static struct sixlowpan_hc06tmpl_s
+  g_hc06_templates[CONFIG_NET_6LOWPAN_HC06_TEMPLATES];
+#endif
+
 /* Constant Data ************************************************************/
 
 /* Uncompression of linklocal
@@ -569,189 +602,24 @@ static void uncompress_addr(FAR const struct netdev_varaddr_s *addr,
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: sixlowpan_hc06_initialize
+ * Name: compress_iphc
  *
  * Description:
- *   sixlowpan_hc06_initialize() is called during OS initialization at
- *   power-up reset.  It is called from the common sixlowpan_initialize()
- *   function. sixlowpan_hc06_initialize() configures HC06 networking data
- *   structures. It is called prior to platform-specific driver
- *   initialization so that the 6LoWPAN networking subsystem is prepared to
- *   deal with network driver initialization actions.
- *
- * Input Parameters:
- *   None
- *
- * Returned Value:
- *   None
+ *   Compress the IPv6 header into the IPHC bytes at 'iphc', leaving
+ *   g_hc06ptr after them.  The UDP header is compressed by the caller.
  *
  ****************************************************************************/
 
-void sixlowpan_hc06_initialize(void)
+static void compress_iphc(FAR struct radio_driver_s *radio,
+                          FAR const struct ipv6_hdr_s *ipv6,
+                          FAR const struct netdev_varaddr_s *destmac,
+                          FAR uint8_t *iphc)
 {
-#if CONFIG_NET_6LOWPAN_MAXADDRCONTEXT > 0
-#if CONFIG_NET_6LOWPAN_MAXADDRCONTEXT > 1
-  int i;
-#endif
-
-  /* Preinitialize any address contexts for better header compression
-   * (Saves up to 13 bytes per 6lowpan packet).
-   */
-
-  g_hc06_addrcontexts[0].used      = 1;
-  g_hc06_addrcontexts[0].number    = 0;
-
-  g_hc06_addrcontexts[0].prefix[0] =
-                         CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_0_0;
-  g_hc06_addrcontexts[0].prefix[1] =
-                         CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_0_1;
-  g_hc06_addrcontexts[0].prefix[2] =
-                         CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_0_2;
-  g_hc06_addrcontexts[0].prefix[3] =
-                         CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_0_3;
-  g_hc06_addrcontexts[0].prefix[4] =
-                         CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_0_4;
-  g_hc06_addrcontexts[0].prefix[5] =
-                         CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_0_5;
-  g_hc06_addrcontexts[0].prefix[6] =
-                         CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_0_6;
-  g_hc06_addrcontexts[0].prefix[7] =
-                         CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_0_7;
-
-#if CONFIG_NET_6LOWPAN_MAXADDRCONTEXT > 1
-  for (i = 1; i < CONFIG_NET_6LOWPAN_MAXADDRCONTEXT; i++)
-    {
-#ifdef CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREINIT_1
-      if (i == 1)
-        {
-          g_hc06_addrcontexts[1].used      = 1;
-          g_hc06_addrcontexts[1].number    = 1;
-
-          g_hc06_addrcontexts[1].prefix[0] =
-            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_1_0;
-          g_hc06_addrcontexts[1].prefix[1] =
-            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_1_1;
-          g_hc06_addrcontexts[1].prefix[2] =
-            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_1_2;
-          g_hc06_addrcontexts[1].prefix[3] =
-            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_1_3;
-          g_hc06_addrcontexts[1].prefix[4] =
-            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_1_4;
-          g_hc06_addrcontexts[1].prefix[5] =
-            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_1_5;
-          g_hc06_addrcontexts[1].prefix[6] =
-            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_1_6;
-          g_hc06_addrcontexts[1].prefix[7] =
-            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_1_7;
-        }
-      else
-#ifdef CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREINIT_2
-      if (i == 2)
-        {
-          g_hc06_addrcontexts[2].used      = 1;
-          g_hc06_addrcontexts[2].number    = 2;
-
-          g_hc06_addrcontexts[2].prefix[0] =
-            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_2_0;
-          g_hc06_addrcontexts[2].prefix[1] =
-            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_2_1;
-          g_hc06_addrcontexts[2].prefix[2] =
-            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_2_2;
-          g_hc06_addrcontexts[2].prefix[3] =
-            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_2_3;
-          g_hc06_addrcontexts[2].prefix[4] =
-            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_2_4;
-          g_hc06_addrcontexts[2].prefix[5] =
-            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_2_5;
-          g_hc06_addrcontexts[2].prefix[6] =
-            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_2_6;
-          g_hc06_addrcontexts[2].prefix[7] =
-            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_2_7;
-        }
-      else
-#endif /* SIXLOWPAN_CONF_ADDR_CONTEXT_2 */
-        {
-          g_hc06_addrcontexts[i].used = 0;
-        }
-#else
-      g_hc06_addrcontexts[i].used = 0;
-#endif /* SIXLOWPAN_CONF_ADDR_CONTEXT_1 */
-    }
-#endif /* CONFIG_NET_6LOWPAN_MAXADDRCONTEXT > 1 */
-#endif /* CONFIG_NET_6LOWPAN_MAXADDRCONTEXT > 0 */
-}
-
-/****************************************************************************
- * Name: sixlowpan_compresshdr_hc06
- *
- * Description:
- *   Compress IP/UDP header
- *
- *   This function is called by the 6lowpan code to create a compressed
- *   6lowpan packet in the frame buffer from a full IPv6 packet.
- *
- *     HC-06:
- *
- *     Originally draft-ietf-6lowpan-hc, version 6:
- *     http://tools.ietf.org/html/draft-ietf-6lowpan-hc-06,
- *
- *   Updated to:
- *
- *     RFC 6282:
- *     https://tools.ietf.org/html/rfc6282
- *
- *   NOTE: sixlowpan_compresshdr_hc06() does not support ISA100_UDP header
- *   compression
- *
- *   For LOWPAN_UDP compression, we either compress both ports or none.
- *   General format with LOWPAN_UDP compression is
- *                      1                   2                   3
- *    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
- *   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
- *   |0|1|1|TF |N|HLI|C|S|SAM|M|D|DAM| SCI   | DCI   | comp. IPv6 hdr|
- *   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
- *   | compressed IPv6 fields .....                                  |
- *   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
- *   | LOWPAN_UDP    | non compressed UDP fields ...                 |
- *   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
- *   | L4 data ...                                                   |
- *   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
- *
- *   NOTE: The address context number 00 is reserved for the link local
- *   prefix.  For unicast addresses, if we cannot compress the prefix, we
- *   neither compress the IID.
- *
- * Input Parameters:
- *   radio   - A reference to a radio network device instance
- *   ipv6    - The IPv6 header to be compressed
- *   destmac - L2 destination address, needed to compress the IP
- *             destination field
- *   fptr    - Pointer to frame to be compressed.
- *
- * Returned Value:
- *   On success the indications of the defines COMPRESS_HDR_* are returned.
- *   A negated errno value is returned on failure.
- *
- ****************************************************************************/
-
-int sixlowpan_compresshdr_hc06(FAR struct radio_driver_s *radio,
-                               FAR const struct ipv6_hdr_s *ipv6,
-                               FAR const struct netdev_varaddr_s *destmac,
-                               FAR uint8_t *fptr)
-{
-  FAR uint8_t *iphc = fptr + g_frame_hdrlen;
   FAR struct sixlowpan_addrcontext_s *saddrcontext;
   FAR struct sixlowpan_addrcontext_s *daddrcontext;
   uint8_t iphc0;
   uint8_t iphc1;
   uint8_t tmp;
-  int ret = COMPRESS_HDR_INLINE;
-
-  ninfo("fptr=%p g_frame_hdrlen=%u iphc=%p\n", fptr, g_frame_hdrlen, iphc);
 
   /* As we copy some bit-length fields, in the IPHC encoding bytes,
    * we sometimes use |=
@@ -1038,6 +906,293 @@ int sixlowpan_compresshdr_hc06(FAR struct radio_driver_s *radio,
         }
     }
 
+  iphc[0] = iphc0;
+  iphc[1] = iphc1;
+}
+
+#if CONFIG_NET_6LOWPAN_HC06_TEMPLATES > 0
+/****************************************************************************
+ * Name: compare_varaddr
+ *
+ * Description:
+ *   Return true if two link layer addresses are the same.
+ *
+ ****************************************************************************/
+
+static bool compare_varaddr(FAR const struct netdev_varaddr_s *addr1,
+                            FAR const struct netdev_varaddr_s *addr2)
+{
+  return addr1->nv_addrlen == addr2->nv_addrlen &&
+         memcmp(addr1->nv_addr, addr2->nv_addr, addr1->nv_addrlen) == 0;
+}
+
+/****************************************************************************
+ * Name: find_template
+ *
+ * Description:
+ *   Return the template of the flow of an IPv6 header, if it was compiled
+ *   for the same header fields and link layer addresses.  Otherwise NULL is
+ *   returned and 'slot' returns the template to replace.
+ *
+ ****************************************************************************/
+
+static FAR struct sixlowpan_hc06tmpl_s *
+  find_template(FAR struct radio_driver_s *radio,
+                FAR const struct ipv6_hdr_s *ipv6,
+                FAR const struct netdev_varaddr_s *destmac,
+                FAR struct sixlowpan_hc06tmpl_s **slot)
+{
+  FAR struct sixlowpan_hc06tmpl_s *tmpl;
+
+  tmpl  = &g_hc06_templates[(ipv6->srcipaddr[7] ^ ipv6->destipaddr[7] ^
+                             ipv6->proto) %
+                            CONFIG_NET_6LOWPAN_HC06_TEMPLATES];
+  *slot = tmpl;
+
+  /* All of the IPv6 header but the payload length is compressed */
+
+  if (tmpl->radio == radio &&
+      memcmp(&tmpl->ipv6, ipv6, offsetof(struct ipv6_hdr_s, len)) == 0 &&
+      memcmp(&tmpl->ipv6.proto, &ipv6->proto,
+             IPv6_HDRLEN - offsetof(struct ipv6_hdr_s, proto)) == 0 &&
+      compare_varaddr(&tmpl->destmac, destmac) &&
+      compare_varaddr(&tmpl->srcmac, &radio->r_dev.d_mac.radio))
+    {
+      return tmpl;
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: save_template
+ *
+ * Description:
+ *   Save the IPHC bytes just compressed at 'iphc' as the template of the
+ *   flow of the IPv6 header.
+ *
+ ****************************************************************************/
+
+static void save_template(FAR struct sixlowpan_hc06tmpl_s *tmpl,
+                          FAR struct radio_driver_s *radio,
+                          FAR const struct ipv6_hdr_s *ipv6,
+                          FAR const struct netdev_varaddr_s *destmac,
+                          FAR const uint8_t *iphc)
+{
+  DEBUGASSERT(g_hc06ptr - iphc <= HC06_TMPL_MAXLEN);
+
+  tmpl->radio   = radio;
+  tmpl->iphclen = g_hc06ptr - iphc;
+  memcpy(tmpl->iphc, iphc, tmpl->iphclen);
+  memcpy(&tmpl->ipv6, ipv6, IPv6_HDRLEN);
+  memcpy(&tmpl->srcmac, &radio->r_dev.d_mac.radio,
+         sizeof(struct netdev_varaddr_s));
+  memcpy(&tmpl->destmac, destmac, sizeof(struct netdev_varaddr_s));
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sixlowpan_hc06_initialize
+ *
+ * Description:
+ *   sixlowpan_hc06_initialize() is called during OS initialization at
+ *   power-up reset.  It is called from the common sixlowpan_initialize()
+ *   function. sixlowpan_hc06_initialize() configures HC06 networking data
+ *   structures. It is called prior to platform-specific driver
+ *   initialization so that the 6LoWPAN networking subsystem is prepared to
+ *   deal with network driver initialization actions.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sixlowpan_hc06_initialize(void)
+{
+#if CONFIG_NET_6LOWPAN_MAXADDRCONTEXT > 0
+#if CONFIG_NET_6LOWPAN_MAXADDRCONTEXT > 1
+  int i;
+#endif
+
+  /* Preinitialize any address contexts for better header compression
+   * (Saves up to 13 bytes per 6lowpan packet).
+   */
+
+  g_hc06_addrcontexts[0].used      = 1;
+  g_hc06_addrcontexts[0].number    = 0;
+
+  g_hc06_addrcontexts[0].prefix[0] =
+                         CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_0_0;
+  g_hc06_addrcontexts[0].prefix[1] =
+                         CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_0_1;
+  g_hc06_addrcontexts[0].prefix[2] =
+                         CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_0_2;
+  g_hc06_addrcontexts[0].prefix[3] =
+                         CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_0_3;
+  g_hc06_addrcontexts[0].prefix[4] =
+                         CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_0_4;
+  g_hc06_addrcontexts[0].prefix[5] =
+                         CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_0_5;
+  g_hc06_addrcontexts[0].prefix[6] =
+                         CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_0_6;
+  g_hc06_addrcontexts[0].prefix[7] =
+                         CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_0_7;
+
+#if CONFIG_NET_6LOWPAN_MAXADDRCONTEXT > 1
+  for (i = 1; i < CONFIG_NET_6LOWPAN_MAXADDRCONTEXT; i++)
+    {
+#ifdef CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREINIT_1
+      if (i == 1)
+        {
+          g_hc06_addrcontexts[1].used      = 1;
+          g_hc06_addrcontexts[1].number    = 1;
+
+          g_hc06_addrcontexts[1].prefix[0] =
+            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_1_0;
+          g_hc06_addrcontexts[1].prefix[1] =
+            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_1_1;
+          g_hc06_addrcontexts[1].prefix[2] =
+            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_1_2;
+          g_hc06_addrcontexts[1].prefix[3] =
+            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_1_3;
+          g_hc06_addrcontexts[1].prefix[4] =
+            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_1_4;
+          g_hc06_addrcontexts[1].prefix[5] =
+            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_1_5;
+          g_hc06_addrcontexts[1].prefix[6] =
+            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_1_6;
+          g_hc06_addrcontexts[1].prefix[7] =
+            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_1_7;
+        }
+      else
+#ifdef CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREINIT_2
+      if (i == 2)
+        {
+          g_hc06_addrcontexts[2].used      = 1;
+          g_hc06_addrcontexts[2].number    = 2;
+
+          g_hc06_addrcontexts[2].prefix[0] =
+            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_2_0;
+          g_hc06_addrcontexts[2].prefix[1] =
+            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_2_1;
+          g_hc06_addrcontexts[2].prefix[2] =
+            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_2_2;
+          g_hc06_addrcontexts[2].prefix[3] =
+            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_2_3;
+          g_hc06_addrcontexts[2].prefix[4] =
+            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_2_4;
+          g_hc06_addrcontexts[2].prefix[5] =
+            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_2_5;
+          g_hc06_addrcontexts[2].prefix[6] =
+            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_2_6;
+          g_hc06_addrcontexts[2].prefix[7] =
+            CONFIG_NET_6LOWPAN_MAXADDRCONTEXT_PREFIX_2_7;
+        }
+      else
+#endif /* SIXLOWPAN_CONF_ADDR_CONTEXT_2 */
+        {
+          g_hc06_addrcontexts[i].used = 0;
+        }
+#else
+      g_hc06_addrcontexts[i].used = 0;
+#endif /* SIXLOWPAN_CONF_ADDR_CONTEXT_1 */
+    }
+#endif /* CONFIG_NET_6LOWPAN_MAXADDRCONTEXT > 1 */
+#endif /* CONFIG_NET_6LOWPAN_MAXADDRCONTEXT > 0 */
+}
+
+/****************************************************************************
+ * Name: sixlowpan_compresshdr_hc06
+ *
+ * Description:
+ *   Compress IP/UDP header
+ *
+ *   This function is called by the 6lowpan code to create a compressed
+ *   6lowpan packet in the frame buffer from a full IPv6 packet.
+ *
+ *     HC-06:
+ *
+ *     Originally draft-ietf-6lowpan-hc, version 6:
+ *     http://tools.ietf.org/html/draft-ietf-6lowpan-hc-06,
+ *
+ *   Updated to:
+ *
+ *     RFC 6282:
+ *     https://tools.ietf.org/html/rfc6282
+ *
+ *   NOTE: sixlowpan_compresshdr_hc06() does not support ISA100_UDP header
+ *   compression
+ *
+ *   For LOWPAN_UDP compression, we either compress both ports or none.
+ *   General format with LOWPAN_UDP compression is
+ *                      1                   2                   3
+ *    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+ *   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *   |0|1|1|TF |N|HLI|C|S|SAM|M|D|DAM| SCI   | DCI   | comp. IPv6 hdr|
+ *   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *   | compressed IPv6 fields .....                                  |
+ *   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *   | LOWPAN_UDP    | non compressed UDP fields ...                 |
+ *   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *   | L4 data ...                                                   |
+ *   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *
+ *   NOTE: The address context number 00 is reserved for the link local
+ *   prefix.  For unicast addresses, if we cannot compress the prefix, we
+ *   neither compress the IID.
+ *
+ * Input Parameters:
+ *   radio   - A reference to a radio network device instance
+ *   ipv6    - The IPv6 header to be compressed
+ *   destmac - L2 destination address, needed to compress the IP
+ *             destination field
+ *   fptr    - Pointer to frame to be compressed.
+ *
+ * Returned Value:
+ *   On success the indications of the defines COMPRESS_HDR_* are returned.
+ *   A negated errno value is returned on failure.
+ *
+ ****************************************************************************/
+
+int sixlowpan_compresshdr_hc06(FAR struct radio_driver_s *radio,
+                               FAR const struct ipv6_hdr_s *ipv6,
+                               FAR const struct netdev_varaddr_s *destmac,
+                               FAR uint8_t *fptr)
+{
+  FAR uint8_t *iphc = fptr + g_frame_hdrlen;
+#if CONFIG_NET_6LOWPAN_HC06_TEMPLATES > 0
+  FAR struct sixlowpan_hc06tmpl_s *tmpl;
+#endif
+  int ret = COMPRESS_HDR_INLINE;
+
+  ninfo("fptr=%p g_frame_hdrlen=%u iphc=%p\n", fptr, g_frame_hdrlen, iphc);
+
+#if CONFIG_NET_6LOWPAN_HC06_TEMPLATES > 0
+  /* The IPHC bytes compiled for a previous packet of the flow are copied as
+   * such.
+   */
+
+  if (find_template(radio, ipv6, destmac, &tmpl) != NULL)
+    {
+      memcpy(iphc, tmpl->iphc, tmpl->iphclen);
+      g_hc06ptr = iphc + tmpl->iphclen;
+    }
+  else
+#endif
+    {
+      compress_iphc(radio, ipv6, destmac, iphc);
+#if CONFIG_NET_6LOWPAN_HC06_TEMPLATES > 0
+      save_template(tmpl, radio, ipv6, destmac, iphc);
+#endif
+    }
+
   g_uncomp_hdrlen = IPv6_HDRLEN;
 
 #ifdef CONFIG_NET_UDP
@@ -1126,11 +1281,6 @@ int sixlowpan_compresshdr_hc06(FAR struct radio_driver_s *radio,
     }
 #endif /* CONFIG_NET_UDP */
 
-  /* Before the g_frame_hdrlen operation */
-
-  iphc[0] = iphc0;
-  iphc[1] = iphc1;
-
   g_frame_hdrlen = g_hc06ptr - fptr;
 
   ninfo("fptr=%p g_frame_hdrlen=%u iphc=%02x:%02x:%02x g_hc06ptr=%p\n",
@@ -46,6 +46,13 @@
 
 #define NET_6LOWPAN_TIMEOUT SEC2TICK(CONFIG_NET_6LOWPAN_MAXAGE)
 
+/* The hash of a reassembly: The fragments of a datagram are identified by
+ * their tag and by the link layer address of the neighbor that sends them.
+ */
+
+#define REASS_HASH(tag, src) \
+  (((tag) ^ sixlowpan_fragsrc_hash(src)) % CONFIG_NET_6LOWPAN_REASS_HASHSIZE)
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -57,9 +64,17 @@
 
 static FAR struct sixlowpan_reassbuf_s *g_free_reass;
 
-/* This is a list of active, allocated reassemby buffers */
+/* The active, allocated reassemby buffers, hashed by tag and source */
+
+static FAR struct sixlowpan_reassbuf_s *
+              g_active_reass[CONFIG_NET_6LOWPAN_REASS_HASHSIZE];
+
+/* The number of active reassembly buffers and the time at which the oldest
+ * one expires:  The buffers are not visited until then.
+ */
 
-static FAR struct sixlowpan_reassbuf_s *g_active_reass;
+static unsigned int g_nactive_reass;
+static clock_t g_reass_expiry;
 
 /* Pool of pre-allocated reassembly buffer structures */
 
@@ -67,9 +82,32 @@ static struct sixlowpan_reassbuf_s
               g_metadata_pool[CONFIG_NET_6LOWPAN_NREASSBUF];
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sixlowpan_fragsrc_hash
+ *
+ * Description:
+ *   Hash the link layer source address of a fragment.  The last bytes of
+ *   the address are the most likely to differ between neighbors.
+ *
  ****************************************************************************/
 
+static uint16_t
+sixlowpan_fragsrc_hash(FAR const struct netdev_varaddr_s *fragsrc)
+{
+  uint16_t hash = 0;
+  int i;
+
+  for (i = 0; i < fragsrc->nv_addrlen; i++)
+    {
+      hash = (hash << 3) ^ (hash >> 13) ^ fragsrc->nv_addr[i];
+    }
+
+  return hash;
+}
+
 /****************************************************************************
  * Name: sixlowpan_compare_fragsrc
  *
@@ -119,43 +157,65 @@ static bool sixlowpan_compare_fragsrc(FAR struct sixlowpan_reassbuf_s *reass,
  *
  ****************************************************************************/
 
-static void sixlowpan_reass_expire(void)
+static void sixlowpan_reass_expire(bool force)
 {
   FAR struct sixlowpan_reassbuf_s *reass;
   FAR struct sixlowpan_reassbuf_s *next;
+  clock_t now = clock_systime_ticks();
   clock_t elapsed;
+  clock_t oldest;
+  int i;
+
+  /* Nothing can have expired before the oldest reassembly */
+
+  if (g_nactive_reass == 0 ||
+      (!force && (sclock_t)(now - g_reass_expiry) < 0))
+    {
+      return;
+    }
 
   /* If reassembly timed out, cancel it */
 
-  for (reass = g_active_reass; reass != NULL; reass = next)
+  oldest = now;
+  for (i = 0; i < CONFIG_NET_6LOWPAN_REASS_HASHSIZE; i++)
     {
-      /* Needed if 'reass' is freed */
+      for (reass = g_active_reass[i]; reass != NULL; reass = next)
+        {
+          /* Needed if 'reass' is freed */
 
-      next = reass->rb_flink;
+          next = reass->rb_flink;
 
-      /* Free any inactive reassembly buffers.  This is done because the life
-       * the reassembly buffer is not cerain.
-       */
+          /* Free any inactive reassembly buffers.  This is done because the
+           * life the reassembly buffer is not cerain.
+           */
+
+          if (!reass->rb_active)
+            {
+              sixlowpan_reass_free(reass);
+              continue;
+            }
 
-      if (!reass->rb_active)
-        {
-          sixlowpan_reass_free(reass);
-        }
-      else
-        {
           /* Get the elpased time of the reassembly */
 
-          elapsed = clock_systime_ticks() - reass->rb_time;
+          elapsed = now - reass->rb_time;
 
-          /* If the reassembly has expired, then free the reassembly buffer */
+          /* If the reassembly has expired, then free the reassembly
+           * buffer.
+           */
 
           if (elapsed >= NET_6LOWPAN_TIMEOUT)
             {
               nwarn("WARNING: Reassembly timed out\n");
               sixlowpan_reass_free(reass);
             }
+          else if ((sclock_t)(reass->rb_time - oldest) < 0)
+            {
+              oldest = reass->rb_time;
+            }
         }
     }
+
+  g_reass_expiry = oldest + NET_6LOWPAN_TIMEOUT;
 }
 
 /****************************************************************************
@@ -177,12 +237,22 @@ static void sixlowpan_reass_expire(void)
 
 static void sixlowpan_remove_active(FAR struct sixlowpan_reassbuf_s *reass)
 {
+  FAR struct sixlowpan_reassbuf_s **bucket;
   FAR struct sixlowpan_reassbuf_s *curr;
   FAR struct sixlowpan_reassbuf_s *prev;
 
-  /* Find the reassembly buffer in the list of active reassembly buffers */
+  /* The reassembly buffers provided by the driver are never active */
+
+  if (reass->rb_pool == REASS_POOL_RADIO)
+    {
+      return;
+    }
+
+  /* Find the reassembly buffer in its list of active reassembly buffers */
 
-  for (prev = NULL, curr = g_active_reass;
+  bucket = &g_active_reass[REASS_HASH(reass->rb_reasstag,
+                                      &reass->rb_fragsrc)];
+  for (prev = NULL, curr = *bucket;
        curr != NULL && curr != reass;
        prev = curr, curr = curr->rb_flink)
     {
@@ -196,12 +266,14 @@ static void sixlowpan_remove_active(FAR struct sixlowpan_reassbuf_s *reass)
 
       if (prev == NULL)
         {
-          g_active_reass = reass->rb_flink;
+          *bucket = reass->rb_flink;
         }
       else
         {
           prev->rb_flink = reass->rb_flink;
         }
+
+      g_nactive_reass--;
     }
 
   reass->rb_flink = NULL;
@@ -281,6 +353,7 @@ FAR struct sixlowpan_reassbuf_s *
   sixlowpan_reass_allocate(uint16_t reasstag,
                            FAR const struct netdev_varaddr_s *fragsrc)
 {
+  FAR struct sixlowpan_reassbuf_s **bucket;
   FAR struct sixlowpan_reassbuf_s *reass;
   uint8_t pool;
 
@@ -288,7 +361,7 @@ FAR struct sixlowpan_reassbuf_s *
    * free up a pre-allocated buffer for this allocation.
    */
 
-  sixlowpan_reass_expire();
+  sixlowpan_reass_expire(g_free_reass == NULL);
 
   /* Now, try the free list first */
 
@@ -326,10 +399,18 @@ FAR struct sixlowpan_reassbuf_s *
       reass->rb_reasstag = reasstag;
       reass->rb_time     = clock_systime_ticks();
 
-      /* Add the reassembly buffer to the list of active reassembly buffers */
+      /* Add the reassembly buffer to the list of active reassembly buffers
+       * of its hash.
+       */
+
+      bucket            = &g_active_reass[REASS_HASH(reasstag, fragsrc)];
+      reass->rb_flink   = *bucket;
+      *bucket           = reass;
 
-      reass->rb_flink   = g_active_reass;
-      g_active_reass    = reass;
+      if (g_nactive_reass++ == 0)
+        {
+          g_reass_expiry = reass->rb_time + NET_6LOWPAN_TIMEOUT;
+        }
     }
 
   return reass;
@@ -364,20 +445,21 @@ FAR struct sixlowpan_reassbuf_s *
    * to return old reassembly buffer with the same tag)
    */
 
-  sixlowpan_reass_expire();
+  sixlowpan_reass_expire(false);
 
   /* Now search for the matching reassembly buffer in the remainng, active
-   * reassembly buffers.
+   * reassembly buffers of the same hash.
    */
 
-  for (reass = g_active_reass; reass != NULL; reass = reass->rb_flink)
+  for (reass = g_active_reass[REASS_HASH(reasstag, fragsrc)];
+       reass != NULL; reass = reass->rb_flink)
     {
       /* In order to be a match, it must have the same reassembly tag as
        * well as source address (different sources might use the same
        * reassembly tag).
        */
 
-      if (reass->rb_reasstag == reasstag &&
+      if (reass->rb_active && reass->rb_reasstag == reasstag &&
           sixlowpan_compare_fragsrc(reass, fragsrc))
         {
           return reass;
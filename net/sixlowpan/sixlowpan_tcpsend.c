@@ -223,7 +223,7 @@ static int sixlowpan_tcp_header(FAR struct tcp_conn_s *conn,
         ((int)ipv6tcp->ipv6.len[0] << 8) + ipv6tcp->ipv6.len[1]);
 
 #ifdef CONFIG_NET_STATISTICS
-  g_netstats.ipv6.sent++;
+  NET_STATS(ipv6.sent)++;
 #endif
 
   /* Initialize the TCP header */
@@ -519,7 +519,7 @@ static uint16_t tcp_send_eventhandler(FAR struct net_driver_s *dev,
 #endif
 
 #ifdef CONFIG_NET_STATISTICS
-          g_netstats.tcp.sent++;
+          NET_STATS(tcp.sent)++;
 #endif
 
           ninfo("Sent: acked=%" PRId32 " sent=%zd "
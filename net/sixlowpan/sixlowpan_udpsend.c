@@ -257,7 +257,7 @@ ssize_t psock_6lowpan_udp_sendto(FAR struct socket *psock,
         ((int)ipv6udp.ipv6.len[0] << 8) + ipv6udp.ipv6.len[1]);
 
 #ifdef CONFIG_NET_STATISTICS
-  g_netstats.ipv6.sent++;
+  NET_STATS(ipv6.sent)++;
 #endif
 
   /* Initialize the UDP header */
@@ -278,7 +278,7 @@ ssize_t psock_6lowpan_udp_sendto(FAR struct socket *psock,
   ninfo("Outgoing UDP packet length: %d\n", iplen + IPv6_HDRLEN);
 
 #ifdef CONFIG_NET_STATISTICS
-  g_netstats.udp.sent++;
+  NET_STATS(udp.sent)++;
 #endif
 
   /* Get the IEEE 802.15.4 MAC address of the next hop. */
@@ -156,6 +156,9 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
       case SO_REUSEADDR:  /* Allow reuse of local addresses */
 #ifdef CONFIG_NET_TIMESTAMP
       case SO_TIMESTAMP:  /* Generates a timestamp for each incoming packet */
+#endif
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+      case SO_ZEROCOPY:   /* Allow the MSG_ZEROCOPY sends */
 #endif
         {
           sockopt_t optionset;
@@ -211,6 +214,20 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
         }
         break;
 
+#ifdef CONFIG_NET_BUSYPOLL
+      case SO_BUSY_POLL:  /* Busy poll time before blocking in a receive */
+        {
+          if (*value_len < sizeof(int))
+            {
+              return -EINVAL;
+            }
+
+          *(FAR int *)value = (int)conn->s_busypoll;
+          *value_len        = sizeof(int);
+        }
+        break;
+#endif
+
       default:
         return -ENOPROTOOPT;
     }
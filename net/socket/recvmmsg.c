@@ -0,0 +1,204 @@
+/****************************************************************************
+ * net/socket/recvmmsg.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <limits.h>
+#include <assert.h>
+#include <errno.h>
+#include <time.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/clock.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives up to 'vlen' messages from a socket with a
+ *   single hold of the network lock.  This is an internal OS interface.
+ *   It is functionally equivalent to recvmmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    The messages to receive
+ *   vlen      The number of messages in msgvec
+ *   flags     Receive flags
+ *   timeout   The time after which no more messages are waited for, or
+ *             NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received, the length of
+ *   each is in its msg_len.  If no message is received, a negated errno
+ *   value is returned (see comments with recvmsg() for a list of
+ *   appropriate errno values).
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout)
+{
+  clock_t deadline = 0;
+  unsigned int nrecv;
+  ssize_t ret = 0;
+
+  if (msgvec == NULL || vlen == 0)
+    {
+      return -EINVAL;
+    }
+
+  if (timeout != NULL)
+    {
+      if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+          timeout->tv_nsec >= NSEC_PER_SEC)
+        {
+          return -EINVAL;
+        }
+
+      deadline = clock_systime_ticks() + clock_time2ticks(timeout);
+    }
+
+  if (vlen > IOV_MAX)
+    {
+      vlen = IOV_MAX;
+    }
+
+  /* The lock is recursive:  The messages already queued are received
+   * without releasing it, it is only released while waiting.
+   */
+
+  net_lock();
+
+  for (nrecv = 0; nrecv < vlen; )
+    {
+      ret = psock_recvmsg(psock, &msgvec[nrecv].msg_hdr, flags);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[nrecv++].msg_len = ret;
+
+      /* Do not wait for more messages once one is received with
+       * MSG_WAITFORONE, or once the timeout has expired.
+       */
+
+      if ((flags & MSG_WAITFORONE) != 0)
+        {
+          flags |= MSG_DONTWAIT;
+        }
+
+      if (timeout != NULL && clock_compare(deadline, clock_systime_ticks()))
+        {
+          break;
+        }
+    }
+
+  net_unlock();
+
+  /* The error of a message is reported only if none was received before
+   * it, the next call reports it again if it persists.
+   */
+
+  return nrecv > 0 ? (int)nrecv : (int)ret;
+}
+
+/****************************************************************************
+ * Function: recvmmsg
+ *
+ * Description:
+ *   recvmmsg() receives up to 'vlen' messages from a socket, with a single
+ *   system call.  It waits for messages as recvmsg() until 'vlen' messages
+ *   are received, or until a message is received after 'timeout' has
+ *   expired if it is not NULL, or until a message is received if
+ *   MSG_WAITFORONE is in 'flags'.
+ *
+ * Parameters:
+ *   sockfd   Socket descriptor of socket
+ *   msgvec   The messages to receive
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags
+ *   timeout  The relative time after which no more messages are waited
+ *            for, or NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received, the length of
+ *   each is in its msg_len.  On error, -1 is returned, and errno is set
+ *   as for recvmsg().
+ *
+ ****************************************************************************/
+
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout)
+{
+  FAR struct socket *psock;
+  FAR struct file *filep;
+  int ret;
+
+  /* recvmmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  ret = sockfd_socket(sockfd, &filep, &psock);
+
+  /* Let psock_recvmmsg() do all of the work */
+
+  if (ret == OK)
+    {
+      ret = psock_recvmmsg(psock, msgvec, vlen, flags, timeout);
+      fs_putfilep(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
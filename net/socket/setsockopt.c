@@ -139,6 +139,9 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
       case SO_REUSEADDR:  /* Allow reuse of local addresses */
 #ifdef CONFIG_NET_TIMESTAMP
       case SO_TIMESTAMP:  /* Generates a timestamp for each incoming packet */
+#endif
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+      case SO_ZEROCOPY:   /* Allow the MSG_ZEROCOPY sends */
 #endif
         {
           int setting;
@@ -222,6 +225,27 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
         }
 #endif
 
+#ifdef CONFIG_NET_BUSYPOLL
+      case SO_BUSY_POLL:  /* Busy poll time before blocking in a receive */
+        {
+          int usec;
+
+          if (value_len != sizeof(int))
+            {
+              return -EINVAL;
+            }
+
+          usec = *(FAR int *)value;
+          if (usec < 0)
+            {
+              return -EINVAL;
+            }
+
+          conn->s_busypoll = usec;
+        }
+        break;
+#endif
+
       /* There options are only valid when used with getopt */
 
       case SO_ACCEPTCONN: /* Reports whether socket listening is enabled */
@@ -32,6 +32,7 @@
 #include <sys/types.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/hashtable.h>
 #include <nuttx/queue.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/mm/iob.h>
@@ -72,6 +73,9 @@
 #if defined(CONFIG_NET_TCP_FAST_RETRANSMIT) && !defined(CONFIG_NET_TCP_CC_NEWRENO)
 #  define TCP_WBNACK(wrb)            ((wrb)->wb_nack)
 #endif
+#ifdef CONFIG_NET_TCP_SELECTIVE_ACK
+#  define TCP_WBSACKED(wrb)          ((wrb)->wb_sacked)
+#endif
 #  define TCP_WBIOB(wrb)             ((wrb)->wb_iob)
 #  define TCP_WBCOPYOUT(wrb,dest,n)  (iob_copyout(dest,(wrb)->wb_iob,(n),0))
 #  define TCP_WBCOPYIN(wrb,src,n,off) \
@@ -114,6 +118,9 @@
 
 #endif
 
+#define TCP_SACK_RECOVERY     0x20U /* In the SACK based loss recovery */
+#define TCP_TSTAMP            0x40U /* Timestamps option enabled */
+
 /* The Max Range count of TCP Selective ACKs */
 
 #define TCP_SACK_RANGES_MAX   4
@@ -127,6 +134,26 @@
 #define TCP_RTO_MAX 240 /* 120s,The unit is half a second */
 #define TCP_RTO_MIN 1   /* 0.5s */
 
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+/* The Timestamps option is sent in all the segments once negotiated, after
+ * two NOOPs so that the timestamps are aligned.  The timestamps are in
+ * milliseconds (RFC 7323).
+ */
+
+#  define TCP_TS_OPTLEN       (TCP_OPT_TS_LEN + 2)
+#  define TCP_TS_CLOCK()      ((uint32_t)TICK2MSEC(clock_systime_ticks()))
+#endif
+
+/* The congestion control algorithm of the new sockets */
+
+#if defined(CONFIG_NET_TCP_CC_DEFAULT_CUBIC)
+#  define TCP_CC_DEFAULT (&g_tcp_cc_cubic)
+#elif defined(CONFIG_NET_TCP_CC_DEFAULT_BBR)
+#  define TCP_CC_DEFAULT (&g_tcp_cc_bbr)
+#else
+#  define TCP_CC_DEFAULT (&g_tcp_cc_newreno)
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -176,6 +203,79 @@ struct tcp_sack_s
   uint32_t right;   /* Right edge of the SACK */
 };
 
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+/* A congestion control algorithm, selected per socket with TCP_CONGESTION.
+ * The duplicate ACK counting, the fast retransmit and the fast recovery
+ * are common to all the algorithms:  An algorithm sets the slow start
+ * threshold after a loss and grows the congestion window when new data is
+ * ACKed out of the fast recovery.
+ */
+
+struct tcp_conn_s;        /* Forward reference */
+
+struct tcp_cc_ops_s
+{
+  FAR const char *name;   /* The name of the algorithm for TCP_CONGESTION */
+
+  /* Reset the state of the algorithm when the connection is established
+   * or starts to use the algorithm (optional).
+   */
+
+  CODE void (*init)(FAR struct tcp_conn_s *conn);
+
+  /* Return the slow start threshold after a fast retransmit or a
+   * retransmission timeout.
+   */
+
+  CODE uint32_t (*ssthresh)(FAR struct tcp_conn_s *conn);
+
+  /* A round trip ended:  It took 'rtt' milliseconds and 'delivered' bytes
+   * were ACKed meanwhile (optional).
+   */
+
+  CODE void (*round)(FAR struct tcp_conn_s *conn, uint32_t rtt,
+                     uint32_t delivered);
+
+  /* Update the congestion window, 'acked' new bytes were ACKed */
+
+  CODE void (*cong_avoid)(FAR struct tcp_conn_s *conn, uint32_t acked);
+};
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+/* The state of CUBIC (RFC 8312) */
+
+struct tcp_cubic_s
+{
+  uint32_t wmax;          /* The window before the last reduction */
+  uint32_t origin;        /* The window at the plateau of the function */
+  uint32_t k;             /* The milliseconds to reach the plateau */
+  uint32_t ackcnt;        /* The bytes ACKed since the last increase */
+  uint32_t rtt;           /* The smallest round trip time (ms) */
+  clock_t  epoch;         /* The start of the congestion avoidance */
+  bool     inepoch;       /* epoch is valid */
+};
+#endif
+
+#ifdef CONFIG_NET_TCP_CC_BBR
+/* The state of BBR */
+
+struct tcp_bbr_s
+{
+  uint32_t bw[2];         /* The delivery rates (bytes/s) of the current
+                           * and the previous bandwidth windows */
+  uint32_t minrtt;        /* The smallest round trip time (ms) */
+  clock_t  minrtt_stamp;  /* When minrtt was measured */
+  clock_t  probertt;      /* When PROBE_RTT started */
+  uint32_t fullbw;        /* The rate at the last growth of the startup */
+  uint8_t  fullbw_cnt;    /* Rounds without growth of the rate */
+  uint8_t  mode;          /* STARTUP, DRAIN, PROBE_BW or PROBE_RTT */
+  uint8_t  cycle;         /* The phase of the PROBE_BW gain cycle */
+  uint8_t  rounds;        /* Rounds in the current bandwidth window */
+  bool     fullpipe;      /* The startup found the bottleneck rate */
+};
+#endif
+#endif /* CONFIG_NET_TCP_CC_NEWRENO */
+
 struct tcp_conn_s
 {
   /* Common prologue of all connection structures. */
@@ -237,6 +337,10 @@ struct tcp_conn_s
 #endif
   uint16_t lport;         /* The local TCP port, in network byte order */
   uint16_t rport;         /* The remoteTCP port, in network byte order */
+#if CONFIG_NET_TCP_HASH_BITS > 0
+  hash_node_t hnode;      /* In the table of the connections by address */
+  hash_node_t pnode;      /* In the table of the connections by port */
+#endif
   uint16_t mss;           /* Current maximum segment size for the
                            * connection */
 #ifdef CONFIG_NET_TCPPROTO_OPTIONS
@@ -252,6 +356,27 @@ struct tcp_conn_s
   uint32_t cwnd;          /* The Congestion window */
   uint32_t max_cwnd;      /* The Congestion window maximum value */
   uint32_t ssthresh;      /* The Slow start threshold */
+
+  /* The congestion control algorithm and its measurement of the round
+   * trips
+   */
+
+  FAR const struct tcp_cc_ops_s *cc_ops;
+  uint32_t cc_delivered;  /* The number of bytes ACKed so far */
+  uint32_t cc_rnddlvd;    /* cc_delivered at the start of the round trip */
+  uint32_t cc_rndend;     /* cc_delivered at the end of the round trip */
+  clock_t  cc_rndstart;   /* The start time of the round trip */
+#if defined(CONFIG_NET_TCP_CC_CUBIC) || defined(CONFIG_NET_TCP_CC_BBR)
+  union
+  {
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+    struct tcp_cubic_s cubic;
+#endif
+#ifdef CONFIG_NET_TCP_CC_BBR
+    struct tcp_bbr_s bbr;
+#endif
+  } cc;                   /* The state of the algorithm */
+#endif
 #endif
 #ifdef CONFIG_NET_TCP_WINDOW_SCALE
   uint32_t snd_wnd;       /* Sequence and acknowledgement numbers of last
@@ -278,6 +403,11 @@ struct tcp_conn_s
   uint16_t tx_unacked;    /* Number bytes sent but not yet ACKed */
 #endif
   uint16_t flags;         /* Flags of TCP-specific options */
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  uint32_t ts_recent;     /* The timestamp of the peer to echo */
+  uint32_t ts_srtt;       /* The smoothed RTT (msec, scaled by 8) */
+  uint32_t ts_rttvar;     /* The RTT variation (msec, scaled by 4) */
+#endif
 #ifdef CONFIG_NET_SOLINGER
   sclock_t ltimeout;      /* Linger timeout expiration */
 #endif
@@ -326,6 +456,21 @@ struct tcp_conn_s
   uint32_t   isn;         /* Initial sequence number */
   uint32_t   sndseq_max;  /* The sequence number of next not-retransmitted
                            * segment (next greater sndseq) */
+#ifdef CONFIG_NET_TCP_SELECTIVE_ACK
+  uint32_t   sack_recover; /* sndseq_max when the SACK recovery started */
+  uint32_t   sack_hirxt;   /* The end of the data retransmitted by the SACK
+                            * recovery so far */
+#endif
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  /* MSG_ZEROCOPY sends, numbered from zero:  The sends below zc_done are
+   * complete, those below zc_notified were returned by MSG_ERRQUEUE.
+   */
+
+  uint32_t   zc_next;     /* The number of the next send */
+  uint32_t   zc_done;     /* The number of sends completed */
+  uint32_t   zc_notified; /* The number of completions returned */
+  uint16_t   zc_nwrbs;    /* The write buffers holding the data of sends */
+#endif
 #endif
 
 #ifdef CONFIG_NET_TCPBACKLOG
@@ -413,6 +558,13 @@ struct tcp_wrbuffer_s
                             * segment sent */
 #if defined(CONFIG_NET_TCP_FAST_RETRANSMIT) && !defined(CONFIG_NET_TCP_CC_NEWRENO)
   uint8_t    wb_nack;      /* The number of ack count */
+#endif
+#ifdef CONFIG_NET_TCP_SELECTIVE_ACK
+  bool       wb_sacked;    /* All the data has been selectively ACKed */
+#endif
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  bool       wb_zc;        /* Holds the data of MSG_ZEROCOPY sends */
+  uint32_t   wb_zcend;     /* The sends below are complete once released */
 #endif
   struct iob_s *wb_iob;    /* Head of the I/O buffer chain */
 };
@@ -455,6 +607,18 @@ extern "C"
 {
 #endif
 
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+/* The congestion control algorithms */
+
+extern const struct tcp_cc_ops_s g_tcp_cc_newreno;
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+extern const struct tcp_cc_ops_s g_tcp_cc_cubic;
+#endif
+#ifdef CONFIG_NET_TCP_CC_BBR
+extern const struct tcp_cc_ops_s g_tcp_cc_bbr;
+#endif
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -1579,6 +1743,31 @@ int psock_tcp_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
 ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
                            int flags);
 
+/****************************************************************************
+ * Name: psock_tcp_recviob
+ *
+ * Description:
+ *   Perform the recv_iob operation for a TCP/IP SOCK_STREAM:  Up to 'len'
+ *   bytes of received data are handed over in an IOB chain, instead of
+ *   being copied to a buffer.
+ *
+ * Input Parameters:
+ *   psock    Pointer to the socket structure for the SOCK_STREAM socket
+ *   iob      Receives the IOB chain, owned by the caller on success
+ *   len      The maximum number of bytes to receive
+ *   flags    Receive flags, MSG_PEEK is not supported
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes in the IOB chain.  On error,
+ *   -errno is returned (see recvfrom for list of errnos).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_RECV_IOB
+ssize_t psock_tcp_recviob(FAR struct socket *psock, FAR struct iob_s **iob,
+                          size_t len, int flags);
+#endif
+
 /****************************************************************************
  * Name: psock_tcp_send
  *
@@ -1895,6 +2084,82 @@ uint32_t tcp_wrbuffer_inqueue_size(FAR struct tcp_conn_s *conn);
 int tcp_wrbuffer_test(void);
 #endif /* CONFIG_NET_TCP_WRITE_BUFFERS */
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+
+/* True if MSG_ERRQUEUE has completions of MSG_ZEROCOPY sends to return */
+
+#define tcp_zerocopy_pending(conn) ((conn)->zc_done != (conn)->zc_notified)
+
+/****************************************************************************
+ * Name: tcp_zerocopy_attach
+ *
+ * Description:
+ *   Append IOBs that refer to the data of a MSG_ZEROCOPY send to a write
+ *   buffer, instead of copying the data.
+ *
+ * Returned Value:
+ *   'len' if all of the data is attached, -ENOMEM otherwise:  The data
+ *   attached is then in TCP_WBPKTLEN(wrb).
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+ssize_t tcp_zerocopy_attach(FAR struct tcp_conn_s *conn,
+                            FAR struct tcp_wrbuffer_s *wrb,
+                            FAR const uint8_t *buf, size_t len);
+
+/****************************************************************************
+ * Name: tcp_zerocopy_sent
+ *
+ * Description:
+ *   Close the current MSG_ZEROCOPY send once all of its data is queued.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_zerocopy_sent(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_zerocopy_release
+ *
+ * Description:
+ *   Account for a write buffer about to be released, the MSG_ZEROCOPY
+ *   sends whose data is no longer referenced are complete.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_zerocopy_release(FAR struct tcp_conn_s *conn,
+                          FAR struct tcp_wrbuffer_s *wrb);
+
+/****************************************************************************
+ * Name: tcp_zerocopy_recverr
+ *
+ * Description:
+ *   Return the completions of the MSG_ZEROCOPY sends in a control message
+ *   (recvmsg() with MSG_ERRQUEUE).
+ *
+ * Returned Value:
+ *   Zero (OK) on success, -EAGAIN if no send completed since the last
+ *   call.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+ssize_t tcp_zerocopy_recverr(FAR struct tcp_conn_s *conn,
+                             FAR struct msghdr *msg);
+#else
+#  define tcp_zerocopy_release(conn, wrb)
+#endif
+
 /****************************************************************************
  * Name: tcp_event_handler_dump
  *
@@ -2323,6 +2588,67 @@ void tcp_cc_update(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp);
  ****************************************************************************/
 
 void tcp_cc_recv_ack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp);
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Update the congestion control variables after a retransmission
+ *   timeout.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by its name
+ *   (TCP_CONGESTION).  The name needs not be NUL terminated.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   name   - The name of the algorithm
+ *   len    - The maximum length of the name
+ *
+ * Returned Value:
+ *   Zero (OK) on success, -ENOENT if there is no such algorithm.
+ *
+ ****************************************************************************/
+
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name,
+                  size_t len);
+
+/****************************************************************************
+ * Name: tcp_cc_slowstart
+ *
+ * Description:
+ *   Grow the congestion window exponentially (RFC 5681), for the
+ *   algorithms that share the slow start of NewReno.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   acked  - The number of bytes newly ACKed
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_slowstart(FAR struct tcp_conn_s *conn, uint32_t acked);
 #endif
 
 #ifdef __cplusplus
@@ -24,8 +24,13 @@
  * Included Files
  ****************************************************************************/
 
+#include <errno.h>
+#include <string.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
+#include <nuttx/net/net.h>
+
 #include "tcp/tcp.h"
 
 /****************************************************************************
@@ -74,10 +79,125 @@
     } \
  } while(0)
 
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static uint32_t tcp_newreno_ssthresh(FAR struct tcp_conn_s *conn);
+static void tcp_newreno_cong_avoid(FAR struct tcp_conn_s *conn,
+                                   uint32_t acked);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_newreno =
+{
+  "reno",                   /* name */
+  NULL,                     /* init */
+  tcp_newreno_ssthresh,     /* ssthresh */
+  NULL,                     /* round */
+  tcp_newreno_cong_avoid    /* cong_avoid */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR const struct tcp_cc_ops_s *const g_tcp_cc_ops[] =
+{
+  &g_tcp_cc_newreno,
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  &g_tcp_cc_cubic,
+#endif
+#ifdef CONFIG_NET_TCP_CC_BBR
+  &g_tcp_cc_bbr,
+#endif
+};
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_newreno_ssthresh
+ *
+ * Description:
+ *   ssthresh = max (FlightSize / 2, 2*SMSS) referring to rfc5681
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_newreno_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  return MAX(conn->tx_unacked / 2, 2 * conn->mss);
+}
+
+/****************************************************************************
+ * Name: tcp_newreno_cong_avoid
+ *
+ * Description:
+ *   Slow start below ssthresh, congestion avoidance above (RFC 5681).
+ *
+ ****************************************************************************/
+
+static void tcp_newreno_cong_avoid(FAR struct tcp_conn_s *conn,
+                                   uint32_t acked)
+{
+  uint32_t increase;
+
+  if (conn->cwnd < conn->ssthresh)
+    {
+      tcp_cc_slowstart(conn, acked);
+    }
+  else
+    {
+      /* cong avoid (RFC 5681):
+       * Grow cwnd linearly by approximately maxseg per RTT using
+       * maxseg^2 / cwnd per ACK as the increment.
+       * If cwnd > maxseg^2, fix the cwnd increment at 1 byte to
+       * avoid capping cwnd.
+       */
+
+      increase = MAX((conn->mss * conn->mss / conn->cwnd), 1);
+
+      CC_CWND_INC(conn->cwnd, increase);
+      conn->cwnd = MIN(conn->cwnd, conn->max_cwnd);
+      ninfo("update congestion avoidance cwnd to %u\n", conn->cwnd);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_round
+ *
+ * Description:
+ *   Count the bytes ACKed and report the end of each round trip to the
+ *   algorithm.  A round trip ends when the data outstanding at its start
+ *   has been ACKed.
+ *
+ ****************************************************************************/
+
+static void tcp_cc_round(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  clock_t now;
+
+  conn->cc_delivered += acked;
+  if ((int32_t)(conn->cc_delivered - conn->cc_rndend) < 0)
+    {
+      return;
+    }
+
+  now = clock_systime_ticks();
+  if (conn->cc_rndend != 0 && conn->cc_ops->round != NULL)
+    {
+      conn->cc_ops->round(conn, TICK2MSEC(now - conn->cc_rndstart),
+                          conn->cc_delivered - conn->cc_rnddlvd);
+    }
+
+  conn->cc_rndstart = now;
+  conn->cc_rnddlvd  = conn->cc_delivered;
+  conn->cc_rndend   = conn->cc_delivered + MAX(conn->tx_unacked, 1);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -117,6 +237,9 @@ void tcp_cc_init(FAR struct tcp_conn_s *conn)
 
   conn->ssthresh = 2 * TCP_IPV4_DEFAULT_MSS;
   conn->dupacks = 0;
+
+  conn->cc_delivered = 0;
+  conn->cc_rndend = 0;
 }
 
 /****************************************************************************
@@ -148,7 +271,7 @@ void tcp_cc_update(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp)
 
   if (conn->flags & TCP_INFT)
     {
-      conn->ssthresh = MAX(conn->tx_unacked / 2, 2 * conn->mss);
+      conn->ssthresh = conn->cc_ops->ssthresh(conn);
       conn->cwnd = conn->ssthresh + 3 * conn->mss;
 
       conn->flags &= ~TCP_INFT;
@@ -165,6 +288,11 @@ void tcp_cc_update(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp)
       CC_INIT_CWND(conn->cwnd, conn->mss);
       conn->max_cwnd = conn->snd_wnd;
       conn->ssthresh = MAX(conn->snd_wnd, conn->ssthresh);
+
+      if (conn->cc_ops->init != NULL)
+        {
+          conn->cc_ops->init(conn);
+        }
     }
 }
 
@@ -243,6 +371,8 @@ void tcp_cc_recv_ack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp)
       conn->dupacks = 0;
       conn->last_ackno = ackno;
 
+      tcp_cc_round(conn, acked);
+
       /* When the ackno covers more than the fr_recover, exit the
        * fast recovery. Then, reset the "IN Fast Recovery" flags.
        * Also reset the congestion window to the slow start threshold.
@@ -269,34 +399,127 @@ void tcp_cc_recv_ack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp)
 
       if (conn->tcpstateflags >= TCP_ESTABLISHED)
         {
-          uint32_t increase;
+          conn->cc_ops->cong_avoid(conn, acked);
+        }
+    }
+}
 
-          if (conn->cwnd < conn->ssthresh)
-            {
-              /* slow start (RFC 5681):
-               * Grow cwnd exponentially by maxseg(smss) per ACK.
-               */
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Update the congestion control variables after a retransmission
+ *   timeout.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
 
-              increase = acked > 0 ? MIN(acked, conn->mss) : conn->mss;
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn)
+{
+  /* If conn is TCP_INFR, it should enter to slow start */
 
-              CC_CWND_INC(conn->cwnd, increase);
-              ninfo("update slow start cwnd to %u\n", conn->cwnd);
-            }
-          else
-            {
-              /* cong avoid (RFC 5681):
-               * Grow cwnd linearly by approximately maxseg per RTT using
-               * maxseg^2 / cwnd per ACK as the increment.
-               * If cwnd > maxseg^2, fix the cwnd increment at 1 byte to
-               * avoid capping cwnd.
-               */
+  conn->flags &= ~TCP_INFR;
+
+  /* update the max_cwnd */
+
+  conn->max_cwnd = (conn->max_cwnd + 7 * conn->cwnd) >> 3;
+
+  /* reset cwnd and ssthresh, refers to RFC5861. */
+
+  conn->ssthresh = conn->cc_ops->ssthresh(conn);
+  conn->cwnd = conn->mss;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by its name
+ *   (TCP_CONGESTION).  The name needs not be NUL terminated.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   name   - The name of the algorithm
+ *   len    - The maximum length of the name
+ *
+ * Returned Value:
+ *   Zero (OK) on success, -ENOENT if there is no such algorithm.
+ *
+ ****************************************************************************/
 
-              increase = MAX((conn->mss * conn->mss / conn->cwnd), 1);
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name,
+                  size_t len)
+{
+  FAR const struct tcp_cc_ops_s *ops;
+  int i;
+
+  len = strnlen(name, len);
+
+  for (i = 0; i < nitems(g_tcp_cc_ops); i++)
+    {
+      ops = g_tcp_cc_ops[i];
+      if (strlen(ops->name) != len || strncmp(ops->name, name, len) != 0)
+        {
+          continue;
+        }
+
+      net_lock();
+      if (conn->cc_ops != ops)
+        {
+          conn->cc_ops = ops;
+
+          /* An established connection goes on from its current window */
 
-              CC_CWND_INC(conn->cwnd, increase);
-              conn->cwnd = MIN(conn->cwnd, conn->max_cwnd);
-              ninfo("update congestion avoidance cwnd to %u\n", conn->cwnd);
+          if (conn->tcpstateflags >= TCP_ESTABLISHED && ops->init != NULL)
+            {
+              ops->init(conn);
             }
         }
+
+      net_unlock();
+      return OK;
     }
+
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_slowstart
+ *
+ * Description:
+ *   Grow the congestion window exponentially (RFC 5681), for the
+ *   algorithms that share the slow start of NewReno.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   acked  - The number of bytes newly ACKed
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_slowstart(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  uint32_t increase;
+
+  /* slow start (RFC 5681):
+   * Grow cwnd exponentially by maxseg(smss) per ACK.
+   */
+
+  increase = acked > 0 ? MIN(acked, conn->mss) : conn->mss;
+
+  CC_CWND_INC(conn->cwnd, increase);
+  ninfo("update slow start cwnd to %u\n", conn->cwnd);
 }
@@ -0,0 +1,329 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_bbr.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The modes of BBR */
+
+#define BBR_STARTUP         0  /* Double the rate each round trip */
+#define BBR_DRAIN           1  /* Drain the queue made by the startup */
+#define BBR_PROBE_BW        2  /* Cycle around the bottleneck rate */
+#define BBR_PROBE_RTT       3  /* Empty the queue to measure the RTT */
+
+/* The gains, in thousandths.  The startup gain is 2 / ln(2). */
+
+#define BBR_HIGH_GAIN       2885
+#define BBR_CWND_GAIN       2000
+#define BBR_UNIT            1000
+
+/* The delivery rate is the maximum of the last BBR_BW_ROUNDS round trips,
+ * the round trip time the minimum of the last BBR_MINRTT_MS milliseconds.
+ */
+
+#define BBR_BW_ROUNDS       10
+#define BBR_MINRTT_MS       10000
+#define BBR_PROBERTT_MS     200
+
+/* The startup ends when the rate did not grow by 25% in 3 round trips */
+
+#define BBR_FULLBW_NUM      5
+#define BBR_FULLBW_DEN      4
+#define BBR_FULLBW_CNT      3
+
+/* The smallest window, in segments */
+
+#define BBR_MIN_CWND        4
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void tcp_bbr_init(FAR struct tcp_conn_s *conn);
+static uint32_t tcp_bbr_ssthresh(FAR struct tcp_conn_s *conn);
+static void tcp_bbr_round(FAR struct tcp_conn_s *conn, uint32_t rtt,
+                          uint32_t delivered);
+static void tcp_bbr_cong_avoid(FAR struct tcp_conn_s *conn,
+                               uint32_t acked);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_bbr =
+{
+  "bbr",                    /* name */
+  tcp_bbr_init,             /* init */
+  tcp_bbr_ssthresh,         /* ssthresh */
+  tcp_bbr_round,            /* round */
+  tcp_bbr_cong_avoid        /* cong_avoid */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The gains of the PROBE_BW cycle, one phase per round trip:  Probe for
+ * more bandwidth, drain the queue it made, then cruise.  Without pacing,
+ * they apply to the window.
+ */
+
+static const uint16_t g_bbr_cycle[] =
+{
+  1250, 750, 1000, 1000, 1000, 1000, 1000, 1000
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_bbr_bw
+ *
+ * Description:
+ *   Return the bottleneck delivery rate of the model, in bytes/s.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_bbr_bw(FAR struct tcp_bbr_s *b)
+{
+  return MAX(b->bw[0], b->bw[1]);
+}
+
+/****************************************************************************
+ * Name: tcp_bbr_bdp
+ *
+ * Description:
+ *   Return the bandwidth-delay product of the model times 'gain'
+ *   thousandths, in bytes.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_bbr_bdp(FAR struct tcp_bbr_s *b, uint32_t gain)
+{
+  uint64_t bdp = (uint64_t)tcp_bbr_bw(b) * b->minrtt / 1000;
+
+  return MIN(bdp * gain / BBR_UNIT, UINT32_MAX);
+}
+
+/****************************************************************************
+ * Name: tcp_bbr_init
+ ****************************************************************************/
+
+static void tcp_bbr_init(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_bbr_s *b = &conn->cc.bbr;
+
+  memset(b, 0, sizeof(*b));
+  b->mode         = BBR_STARTUP;
+  b->minrtt_stamp = clock_systime_ticks();
+}
+
+/****************************************************************************
+ * Name: tcp_bbr_ssthresh
+ *
+ * Description:
+ *   BBR does not take the losses as a sign of congestion:  The window
+ *   follows the model.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_bbr_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  return MAX(conn->cwnd, BBR_MIN_CWND * conn->mss);
+}
+
+/****************************************************************************
+ * Name: tcp_bbr_round
+ *
+ * Description:
+ *   Update the model with the delivery rate and the duration of a round
+ *   trip, and move through the modes.
+ *
+ ****************************************************************************/
+
+static void tcp_bbr_round(FAR struct tcp_conn_s *conn, uint32_t rtt,
+                          uint32_t delivered)
+{
+  FAR struct tcp_bbr_s *b = &conn->cc.bbr;
+  clock_t now = clock_systime_ticks();
+  uint32_t bw = 0;
+  bool expired;
+
+  /* The windowed maximum of the delivery rate, over two half windows */
+
+  if (rtt > 0)
+    {
+      bw = MIN((uint64_t)delivered * 1000 / rtt, UINT32_MAX);
+    }
+
+  if (++b->rounds >= BBR_BW_ROUNDS / 2)
+    {
+      b->bw[1]  = b->bw[0];
+      b->bw[0]  = 0;
+      b->rounds = 0;
+    }
+
+  b->bw[0] = MAX(b->bw[0], bw);
+
+  /* The windowed minimum of the round trip time.  When it is too old, the
+   * queue is emptied to measure it again.
+   */
+
+  expired = TICK2MSEC(now - b->minrtt_stamp) > BBR_MINRTT_MS;
+  if (rtt > 0 && (b->minrtt == 0 || rtt <= b->minrtt || expired))
+    {
+      b->minrtt       = rtt;
+      b->minrtt_stamp = now;
+    }
+
+  if (expired && b->mode != BBR_PROBE_RTT)
+    {
+      b->mode           = BBR_PROBE_RTT;
+      b->probertt = now;
+    }
+
+  switch (b->mode)
+    {
+      case BBR_STARTUP:
+        bw = tcp_bbr_bw(b);
+        if ((uint64_t)bw * BBR_FULLBW_DEN >=
+            (uint64_t)b->fullbw * BBR_FULLBW_NUM)
+          {
+            b->fullbw     = bw;
+            b->fullbw_cnt = 0;
+          }
+        else if (++b->fullbw_cnt >= BBR_FULLBW_CNT)
+          {
+            b->fullpipe = true;
+            b->mode     = BBR_DRAIN;
+          }
+        break;
+
+      case BBR_DRAIN:
+        if (conn->tx_unacked <= tcp_bbr_bdp(b, BBR_UNIT))
+          {
+            b->mode  = BBR_PROBE_BW;
+            b->cycle = 0;
+          }
+        break;
+
+      case BBR_PROBE_BW:
+        b->cycle = (b->cycle + 1) % nitems(g_bbr_cycle);
+        break;
+
+      case BBR_PROBE_RTT:
+        if (TICK2MSEC(now - b->probertt) >= BBR_PROBERTT_MS)
+          {
+            b->mode         = b->fullpipe ? BBR_PROBE_BW : BBR_STARTUP;
+            b->minrtt_stamp = now;
+          }
+        break;
+    }
+
+  ninfo("bbr mode %u bw %" PRIu32 " minrtt %" PRIu32 "\n",
+        b->mode, tcp_bbr_bw(b), b->minrtt);
+}
+
+/****************************************************************************
+ * Name: tcp_bbr_cong_avoid
+ *
+ * Description:
+ *   Set the window to the bandwidth-delay product of the model times the
+ *   gain of the mode.  Until the startup found the bottleneck, the window
+ *   only grows.
+ *
+ ****************************************************************************/
+
+static void tcp_bbr_cong_avoid(FAR struct tcp_conn_s *conn,
+                               uint32_t acked)
+{
+  FAR struct tcp_bbr_s *b = &conn->cc.bbr;
+  uint32_t mincwnd = BBR_MIN_CWND * conn->mss;
+  uint64_t target;
+  uint64_t cwnd;
+
+  if (tcp_bbr_bw(b) == 0 || b->minrtt == 0)
+    {
+      /* No model yet */
+
+      tcp_cc_slowstart(conn, acked);
+      return;
+    }
+
+  switch (b->mode)
+    {
+      case BBR_STARTUP:
+        target = tcp_bbr_bdp(b, BBR_HIGH_GAIN);
+        break;
+
+      case BBR_DRAIN:
+        target = tcp_bbr_bdp(b, BBR_UNIT);
+        break;
+
+      case BBR_PROBE_BW:
+        target = tcp_bbr_bdp(b, (uint32_t)BBR_CWND_GAIN *
+                                g_bbr_cycle[b->cycle] / BBR_UNIT);
+        break;
+
+      default:
+        target = mincwnd;
+        break;
+    }
+
+  /* Leave room for the delayed and aggregated ACKs */
+
+  target = MAX(target + 3 * conn->mss, mincwnd);
+
+  cwnd = (uint64_t)conn->cwnd + acked;
+  if (b->fullpipe)
+    {
+      cwnd = MIN(cwnd, target);
+    }
+  else if (conn->cwnd >= target)
+    {
+      cwnd = conn->cwnd;
+    }
+
+  if (b->mode == BBR_PROBE_RTT)
+    {
+      cwnd = MIN(cwnd, mincwnd);
+    }
+
+  conn->cwnd = MIN(MAX(cwnd, mincwnd), UINT32_MAX);
+}
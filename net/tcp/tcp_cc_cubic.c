@@ -0,0 +1,285 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_cubic.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The constants of RFC 8312:  The window is reduced to BETA after a loss,
+ * and grows as C * (t - K)^3 + W_max, with t and K in seconds and the
+ * windows in segments.
+ */
+
+#define CUBIC_BETA_NUM      7
+#define CUBIC_BETA_DEN      10
+#define CUBIC_C_NUM         4
+#define CUBIC_C_DEN         10
+
+/* The window before the loss is reduced further if it did not reach the
+ * previous one (fast convergence): W_max = cwnd * (1 + BETA) / 2.
+ */
+
+#define CUBIC_FC_NUM        17
+#define CUBIC_FC_DEN        20
+
+/* 3 * (1 - BETA) / (1 + BETA), the growth of the TCP friendly window in
+ * segments per round trip, in thousandths.
+ */
+
+#define CUBIC_FRIENDLY      529
+
+/* The bound of |t - K| in milliseconds, to keep the cube in 64 bits */
+
+#define CUBIC_MAX_DELTA     60000
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void tcp_cubic_init(FAR struct tcp_conn_s *conn);
+static uint32_t tcp_cubic_ssthresh(FAR struct tcp_conn_s *conn);
+static void tcp_cubic_round(FAR struct tcp_conn_s *conn, uint32_t rtt,
+                            uint32_t delivered);
+static void tcp_cubic_cong_avoid(FAR struct tcp_conn_s *conn,
+                                 uint32_t acked);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_cubic =
+{
+  "cubic",                  /* name */
+  tcp_cubic_init,           /* init */
+  tcp_cubic_ssthresh,       /* ssthresh */
+  tcp_cubic_round,          /* round */
+  tcp_cubic_cong_avoid      /* cong_avoid */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cubic_root
+ *
+ * Description:
+ *   Return the integer cube root of 'a', a < 2^63.
+ *
+ ****************************************************************************/
+
+static uint32_t cubic_root(uint64_t a)
+{
+  uint64_t x = 0;
+  uint64_t y;
+  int shift;
+
+  for (shift = 20; shift >= 0; shift--)
+    {
+      y = x | ((uint64_t)1 << shift);
+      if (y * y * y <= a)
+        {
+          x = y;
+        }
+    }
+
+  return (uint32_t)x;
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_init
+ ****************************************************************************/
+
+static void tcp_cubic_init(FAR struct tcp_conn_s *conn)
+{
+  memset(&conn->cc.cubic, 0, sizeof(conn->cc.cubic));
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_ssthresh
+ *
+ * Description:
+ *   Remember the window at the loss and reduce it to BETA.  The next
+ *   congestion avoidance starts a new epoch.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cubic_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_cubic_s *c = &conn->cc.cubic;
+
+  c->inepoch = false;
+
+  if (conn->cwnd < c->wmax)
+    {
+      c->wmax = (uint64_t)conn->cwnd * CUBIC_FC_NUM / CUBIC_FC_DEN;
+    }
+  else
+    {
+      c->wmax = conn->cwnd;
+    }
+
+  return MAX((uint64_t)conn->cwnd * CUBIC_BETA_NUM / CUBIC_BETA_DEN,
+             2 * conn->mss);
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_round
+ *
+ * Description:
+ *   Keep the smallest round trip time, the RTT of W(t + RTT).
+ *
+ ****************************************************************************/
+
+static void tcp_cubic_round(FAR struct tcp_conn_s *conn, uint32_t rtt,
+                            uint32_t delivered)
+{
+  FAR struct tcp_cubic_s *c = &conn->cc.cubic;
+
+  if (rtt > 0 && (c->rtt == 0 || rtt < c->rtt))
+    {
+      c->rtt = rtt;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_cong_avoid
+ *
+ * Description:
+ *   Slow start below ssthresh.  Above, grow the window toward the cubic
+ *   function W(t + RTT) of the time since the start of the epoch, or the
+ *   window NewReno would have if that is larger (the TCP friendly region).
+ *
+ ****************************************************************************/
+
+static void tcp_cubic_cong_avoid(FAR struct tcp_conn_s *conn,
+                                 uint32_t acked)
+{
+  FAR struct tcp_cubic_s *c = &conn->cc.cubic;
+  uint64_t target;
+  uint64_t cnt;
+  uint32_t elapsed;
+  int64_t delta;
+  int64_t d;
+  clock_t now;
+
+  if (conn->cwnd < conn->ssthresh)
+    {
+      tcp_cc_slowstart(conn, acked);
+      return;
+    }
+
+  now = clock_systime_ticks();
+  if (!c->inepoch)
+    {
+      /* A new epoch.  K is the time to get back to W_max, in ms:
+       * K = cubic_root((W_max - cwnd) / C)
+       */
+
+      c->epoch   = now;
+      c->inepoch = true;
+      c->ackcnt  = 0;
+
+      if (conn->cwnd < c->wmax)
+        {
+          c->k      = cubic_root((uint64_t)((c->wmax - conn->cwnd) /
+                                            conn->mss) *
+                                 CUBIC_C_DEN * 1000000000 / CUBIC_C_NUM);
+          c->origin = c->wmax;
+        }
+      else
+        {
+          c->k      = 0;
+          c->origin = conn->cwnd;
+        }
+    }
+
+  /* W(t + RTT) = C * (t + RTT - K)^3 + origin, in bytes */
+
+  elapsed = TICK2MSEC(now - c->epoch);
+  d = (int64_t)elapsed + c->rtt - c->k;
+  d = MIN(MAX(d, -CUBIC_MAX_DELTA), CUBIC_MAX_DELTA);
+
+  delta = d * d * d / 1000000 * conn->mss * CUBIC_C_NUM /
+          (CUBIC_C_DEN * 1000);
+  if (delta < -(int64_t)c->origin)
+    {
+      target = 0;
+    }
+  else
+    {
+      target = c->origin + delta;
+    }
+
+  /* The TCP friendly region:
+   * W_est(t) = W_max * BETA + 3 * (1 - BETA) / (1 + BETA) * t / RTT
+   */
+
+  if (c->rtt > 0)
+    {
+      uint64_t west = (uint64_t)c->wmax * CUBIC_BETA_NUM / CUBIC_BETA_DEN +
+                      (uint64_t)conn->mss * CUBIC_FRIENDLY * elapsed /
+                      (1000 * c->rtt);
+
+      target = MAX(target, west);
+    }
+
+  /* Grow by one segment every 'cnt' bytes ACKed, at most 1.5 times per
+   * round trip, by very little above the target.
+   */
+
+  if (target > conn->cwnd)
+    {
+      cnt = (uint64_t)conn->cwnd * conn->mss / (target - conn->cwnd);
+    }
+  else
+    {
+      cnt = (uint64_t)conn->cwnd * 100;
+    }
+
+  cnt = MIN(MAX(cnt, 2 * conn->mss), UINT32_MAX);
+
+  c->ackcnt += acked;
+  if (c->ackcnt >= cnt)
+    {
+      uint64_t cwnd = conn->cwnd + c->ackcnt / cnt * conn->mss;
+
+      c->ackcnt %= cnt;
+      conn->cwnd = MIN(cwnd, UINT32_MAX);
+      ninfo("update cubic cwnd to %" PRIu32 "\n", conn->cwnd);
+    }
+}
@@ -91,10 +91,149 @@ static dq_queue_t g_free_tcp_connections;
 
 static dq_queue_t g_active_tcp_connections;
 
+/* The connected TCP connections by remote address and ports, and by local
+ * port.
+ */
+
+#if CONFIG_NET_TCP_HASH_BITS > 0
+static DECLARE_HASHTABLE(g_tcp_conn_table, CONFIG_NET_TCP_HASH_BITS);
+static DECLARE_HASHTABLE(g_tcp_port_table, CONFIG_NET_TCP_HASH_BITS);
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#if CONFIG_NET_TCP_HASH_BITS > 0
+/****************************************************************************
+ * Name: tcp_ipv4_key, tcp_ipv6_key and tcp_conn_key
+ *
+ * Description:
+ *   Return the key of a connection in the table of the connections by
+ *   address.  The local address is not part of the key, a connection may
+ *   be bound to any address.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static inline uint32_t tcp_ipv4_key(in_addr_t raddr, uint16_t lport,
+                                    uint16_t rport)
+{
+  return raddr ^ ((uint32_t)lport << 16 | rport);
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static inline uint32_t tcp_ipv6_key(FAR const uint16_t *raddr,
+                                    uint16_t lport, uint16_t rport)
+{
+  uint32_t key = (uint32_t)lport << 16 | rport;
+  int i;
+
+  for (i = 0; i < 8; i += 2)
+    {
+      key ^= (uint32_t)raddr[i] << 16 | raddr[i + 1];
+    }
+
+  return key;
+}
+#endif
+
+static uint32_t tcp_conn_key(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      return tcp_ipv4_key(conn->u.ipv4.raddr, conn->lport, conn->rport);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return tcp_ipv6_key(conn->u.ipv6.raddr, conn->lport, conn->rport);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_hashconn and tcp_hashport
+ *
+ * Description:
+ *   Return the connection of an entry of the connection or port table, or
+ *   NULL at the end of a bucket.
+ *
+ ****************************************************************************/
+
+static inline FAR struct tcp_conn_s *tcp_hashconn(FAR hash_node_t *node)
+{
+  return node != NULL ? container_of(node, struct tcp_conn_s, hnode) : NULL;
+}
+
+static inline FAR struct tcp_conn_s *tcp_hashport(FAR hash_node_t *node)
+{
+  return node != NULL ? container_of(node, struct tcp_conn_s, pnode) : NULL;
+}
+
+/* The active connections that may have a given address key or local port:
+ * Those of a bucket of a table, or all of them without the tables.
+ */
+
+#  define tcp_firstkey(key) \
+     tcp_hashconn(hashtable_bucket(g_tcp_conn_table, key)->head)
+#  define tcp_nextkey(conn)   tcp_hashconn((conn)->hnode.flink)
+#  define tcp_firstport(port) \
+     tcp_hashport(hashtable_bucket(g_tcp_port_table, port)->head)
+#  define tcp_nextport(conn)  tcp_hashport((conn)->pnode.flink)
+#else
+#  define tcp_firstkey(key) \
+     ((FAR struct tcp_conn_s *)g_active_tcp_connections.head)
+#  define tcp_nextkey(conn) \
+     ((FAR struct tcp_conn_s *)(conn)->sconn.node.flink)
+#  define tcp_firstport(port) tcp_firstkey(port)
+#  define tcp_nextport(conn)  tcp_nextkey(conn)
+#endif
+
+/****************************************************************************
+ * Name: tcp_addactive
+ *
+ * Description:
+ *   Add a connection to the list of the active connections, and to the
+ *   tables once its addresses and ports are set.
+ *
+ ****************************************************************************/
+
+static void tcp_addactive(FAR struct tcp_conn_s *conn)
+{
+  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+#if CONFIG_NET_TCP_HASH_BITS > 0
+  hashtable_add(g_tcp_conn_table, &conn->hnode, tcp_conn_key(conn));
+  hashtable_add(g_tcp_port_table, &conn->pnode, conn->lport);
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_remactive
+ *
+ * Description:
+ *   Remove a connection from the list of the active connections and from
+ *   the tables.
+ *
+ ****************************************************************************/
+
+static void tcp_remactive(FAR struct tcp_conn_s *conn)
+{
+  dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+#if CONFIG_NET_TCP_HASH_BITS > 0
+  hashtable_delete(g_tcp_conn_table, &conn->hnode, tcp_conn_key(conn));
+  hashtable_delete(g_tcp_port_table, &conn->pnode, conn->lport);
+#endif
+}
+
 /****************************************************************************
  * Name: tcp_listener
  *
@@ -111,11 +250,12 @@ static FAR struct tcp_conn_s *
   tcp_listener(uint8_t domain, FAR const union ip_addr_u *ipaddr,
                uint16_t portno)
 {
-  FAR struct tcp_conn_s *conn = NULL;
+  FAR struct tcp_conn_s *conn;
 
   /* Check if this port number is in use by any active UIP TCP connection */
 
-  while ((conn = tcp_nextconn(conn)) != NULL)
+  for (conn = tcp_firstport(portno); conn != NULL;
+       conn = tcp_nextport(conn))
     {
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
@@ -189,9 +329,10 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
+  conn       = tcp_firstkey(tcp_ipv4_key(srcipaddr, tcp->destport,
+                                         tcp->srcport));
 
   while (conn)
     {
@@ -228,7 +369,7 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
-      conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+      conn = tcp_nextkey(conn);
     }
 
   return conn;
@@ -256,9 +397,10 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
+  conn       = tcp_firstkey(tcp_ipv6_key(*srcipaddr, tcp->destport,
+                                         tcp->srcport));
 
   while (conn)
     {
@@ -295,7 +437,7 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
-      conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+      conn = tcp_nextkey(conn);
     }
 
   return conn;
@@ -800,6 +942,9 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
 
       nxsem_init(&conn->snd_sem, 0, 0);
 #endif
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+      conn->cc_ops        = TCP_CC_DEFAULT;
+#endif
 
       /* Set the default value of mss to max, this field will changed when
        * receive SYN.
@@ -922,7 +1067,7 @@ void tcp_free(FAR struct tcp_conn_s *conn)
     {
       /* Remove the connection from the active list */
 
-      dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_remactive(conn);
     }
 
   tcp_free_rx_buffers(conn);
@@ -1181,6 +1326,9 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
       conn->snd_bufs         = listener->snd_bufs;
 #endif
       conn->mss              = listener->mss;
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+      conn->cc_ops           = listener->cc_ops;
+#endif
 
       /* Fill in the necessary fields for the new connection. */
 
@@ -1231,7 +1379,7 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        * Interrupts should already be disabled in this context.
        */
 
-      dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_addactive(conn);
       tcp_update_retrantimer(conn, TCP_RTO);
     }
 
@@ -1542,7 +1690,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
   /* And, finally, put the connection structure into the active list. */
 
-  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+  tcp_addactive(conn);
   ret = OK;
 
 errout_with_lock:
@@ -552,6 +552,9 @@ static void tcp_parse_option(FAR struct net_driver_s *dev,
 {
   FAR struct tcp_hdr_s *tcp;
   unsigned int tcpiplen;
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  bool tsopt = false;
+#endif
   uint16_t tmp16;
   uint8_t  opt;
   int i;
@@ -615,6 +618,14 @@ static void tcp_parse_option(FAR struct net_driver_s *dev,
         {
           conn->flags    |= TCP_SACK;
         }
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+      else if (opt == TCP_OPT_TS &&
+               IPDATA(tcpiplen + 1 + i) == TCP_OPT_TS_LEN)
+        {
+          conn->ts_recent = tcp_getsequence(IPBUF(tcpiplen + 2 + i));
+          tsopt           = true;
+        }
 #endif
       else
         {
@@ -634,7 +645,150 @@ static void tcp_parse_option(FAR struct net_driver_s *dev,
 
       i += IPDATA(tcpiplen + 1 + i);
     }
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  /* The option is in all the segments from now on, it takes room from the
+   * payload.
+   */
+
+  if (tsopt && (conn->flags & TCP_TSTAMP) == 0)
+    {
+      conn->flags |= TCP_TSTAMP;
+      conn->mss   -= TCP_TS_OPTLEN;
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_parse_timestamp
+ *
+ * Description:
+ *   Get the timestamps of the Timestamps option of an incoming segment.
+ *
+ * Input Parameters:
+ *   dev    - The device driver structure containing the received TCP packet.
+ *   iplen  - Length of the IP header (IPv4_HDRLEN or IPv6_HDRLEN).
+ *   tsval  - The location to return the timestamp of the peer
+ *   tsecr  - The location to return our timestamp echoed by the peer
+ *
+ * Returned Value:
+ *   true if the segment has the option.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+static bool tcp_parse_timestamp(FAR struct net_driver_s *dev,
+                                unsigned int iplen, FAR uint32_t *tsval,
+                                FAR uint32_t *tsecr)
+{
+  FAR struct tcp_hdr_s *tcp;
+  unsigned int tcpiplen;
+  int optlen;
+  uint8_t opt;
+  int i;
+
+  tcp      = IPBUF(iplen);
+  tcpiplen = iplen + TCP_HDRLEN;
+  optlen   = ((tcp->tcpoffset >> 4) - 5) << 2;
+
+  for (i = 0; i < optlen; )
+    {
+      opt = IPDATA(tcpiplen + i);
+      if (opt == TCP_OPT_END)
+        {
+          break;
+        }
+      else if (opt == TCP_OPT_NOOP)
+        {
+          i++;
+          continue;
+        }
+      else if (i + 1 >= optlen || IPDATA(tcpiplen + 1 + i) < 2)
+        {
+          /* The options are malformed */
+
+          break;
+        }
+      else if (opt == TCP_OPT_TS &&
+               IPDATA(tcpiplen + 1 + i) == TCP_OPT_TS_LEN &&
+               i + TCP_OPT_TS_LEN <= optlen)
+        {
+          *tsval = tcp_getsequence(IPBUF(tcpiplen + 2 + i));
+          *tsecr = tcp_getsequence(IPBUF(tcpiplen + 6 + i));
+          return true;
+        }
+
+      i += IPDATA(tcpiplen + 1 + i);
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: tcp_rtt_sample
+ *
+ * Description:
+ *   Update the retransmission time-out with a round trip time measured
+ *   with the timestamps, as in RFC 6298:
+ *
+ *     RTTVAR = 3/4 * RTTVAR + 1/4 * |SRTT - R|
+ *     SRTT   = 7/8 * SRTT + 1/8 * R
+ *     RTO    = SRTT + max(G, 4 * RTTVAR)
+ *
+ *   G, the granularity of the clock, is the half second of the timer.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   rtt    - The round trip time (msec)
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_rtt_sample(FAR struct tcp_conn_s *conn, uint32_t rtt)
+{
+  uint32_t rto;
+  int32_t m;
+
+  if (rtt > TCP_RTO_MAX * MSEC_PER_HSEC)
+    {
+      /* Not an echo of our clock */
+
+      return;
+    }
+
+  m = rtt;
+  if (conn->ts_srtt == 0)
+    {
+      conn->ts_srtt   = m << 3;
+      conn->ts_rttvar = m << 1;
+    }
+  else
+    {
+      m -= conn->ts_srtt >> 3;
+      conn->ts_srtt += m;
+      if (m < 0)
+        {
+          m = -m;
+        }
+
+      m -= conn->ts_rttvar >> 2;
+      conn->ts_rttvar += m;
+    }
+
+  rto = (conn->ts_srtt >> 3) + MAX(MSEC_PER_HSEC, conn->ts_rttvar);
+  rto = (rto + MSEC_PER_HSEC - 1) / MSEC_PER_HSEC;
+
+  conn->rto = MIN(MAX(rto, TCP_RTO_MIN), TCP_RTO_MAX);
 }
+#endif /* CONFIG_NET_TCP_TIMESTAMPS */
 
 /****************************************************************************
  * Name: tcp_clear_zero_probe
@@ -695,7 +849,10 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
   FAR struct tcp_conn_s *conn = NULL;
   FAR struct tcp_hdr_s *tcp;
   union ip_binding_u uaddr;
-  unsigned int tcpiplen;
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  uint32_t tsval;
+  uint32_t tsecr = 0;
+#endif
   uint16_t tmp16;
   uint16_t flags;
   uint16_t result;
@@ -704,7 +861,7 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 #ifdef CONFIG_NET_STATISTICS
   /* Bump up the count of TCP packets received */
 
-  g_netstats.tcp.recv++;
+  NET_STATS(tcp.recv)++;
 #endif
 
   /* Get a pointer to the TCP header.  The TCP header lies just after the
@@ -713,26 +870,16 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
   tcp = IPBUF(iplen);
 
-  /* Get the size of the IP header and the TCP header.
-   *
-   * REVISIT:  TCP header is *not* a constant!  It can be larger if the
-   * TCP header includes options.  The constant TCP_HDRLEN should be
-   * replaced with the macro TCP_OPT_HDRLEN(n) which will calculate the
-   * correct header length in all cases.
-   */
-
-  tcpiplen = iplen + TCP_HDRLEN;
-
 #ifdef CONFIG_NET_TCP_CHECKSUMS
   /* Start of TCP input header processing code. */
 
-  if (tcp_chksum(dev) != 0xffff)
+  if (!net_chksum_verified(dev) && tcp_chksum(dev) != 0xffff)
     {
       /* Compute and check the TCP checksum. */
 
 #ifdef CONFIG_NET_STATISTICS
-      g_netstats.tcp.drop++;
-      g_netstats.tcp.chkerr++;
+      NET_STATS(tcp.drop)++;
+      NET_STATS(tcp.chkerr)++;
 #endif
       nwarn("WARNING: Bad TCP checksum\n");
       goto drop;
@@ -850,7 +997,7 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
                */
 
 #ifdef CONFIG_NET_STATISTICS
-              g_netstats.tcp.syndrop++;
+              NET_STATS(tcp.syndrop)++;
 #endif
               nerr("ERROR: No free TCP connections\n");
               goto drop;
@@ -885,7 +1032,7 @@ reset:
     }
 
 #ifdef CONFIG_NET_STATISTICS
-  g_netstats.tcp.synrst++;
+  NET_STATS(tcp.synrst)++;
 #endif
   tcp_reset(dev, conn);
   return;
@@ -1004,16 +1151,16 @@ found:
 
   if (dev->d_len > 0)
     {
-      if ((g_netstats.tcp.recv %
+      if ((NET_STATS(tcp.recv) %
           CONFIG_NET_TCP_DEBUG_DROP_RECV_PROBABILITY) == 0)
         {
           uint32_t seq = tcp_getsequence(tcp->seqno);
 
-          g_netstats.tcp.drop++;
+          NET_STATS(tcp.drop)++;
 
           ninfo("TCP DROP RCVPKT: "
                 "[%d][%" PRIu32 " : %" PRIu32 " : %d]\n",
-                g_netstats.tcp.drop, seq, TCP_SEQ_ADD(seq, dev->d_len),
+                NET_STATS(tcp.drop), seq, TCP_SEQ_ADD(seq, dev->d_len),
                 dev->d_len);
 
           dev->d_len = 0;
@@ -1022,6 +1169,37 @@ found:
     }
 #endif
 
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  if ((conn->flags & TCP_TSTAMP) != 0 &&
+      tcp_parse_timestamp(dev, iplen, &tsval, &tsecr))
+    {
+      /* PAWS (RFC 7323, 5.3):  A segment with a timestamp older than the
+       * last one is an old duplicate, acknowledge and drop it.
+       */
+
+      if (TCP_SEQ_LT(tsval, conn->ts_recent))
+        {
+#ifdef CONFIG_NET_STATISTICS
+          NET_STATS(tcp.drop)++;
+#endif
+          ninfo("PAWS: TSval %" PRIu32 " < %" PRIu32 "\n",
+                tsval, conn->ts_recent);
+          tcp_send(dev, conn, TCP_ACK, tcpip_hdrsize(conn));
+          return;
+        }
+
+      /* Echo the timestamp of the segments that do not start beyond the
+       * data that we acknowledge.
+       */
+
+      if (TCP_SEQ_LTE(tcp_getsequence(tcp->seqno),
+                      tcp_getsequence(conn->rcvseq)))
+        {
+          conn->ts_recent = tsval;
+        }
+    }
+#endif
+
   /* Check if the incoming segment acknowledges any outstanding data. If so,
    * we update the sequence number, reset the length of the outstanding
    * data, calculate RTT estimations, and reset the retransmission timer.
@@ -1029,6 +1207,9 @@ found:
 
   if ((tcp->flags & TCP_ACK) != 0 && conn->tx_unacked > 0)
     {
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+      uint32_t unacked = conn->tx_unacked;
+#endif
       uint32_t unackseq;
       uint32_t ackseq;
       int timeout;
@@ -1116,8 +1297,23 @@ found:
         }
 #endif
 
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+      if ((conn->flags & TCP_TSTAMP) != 0)
+        {
+          /* Every ACK of new data echoes the time when the acknowledged
+           * segment was sent, even if it was retransmitted.
+           */
+
+          if (tsecr != 0 && conn->tx_unacked < unacked)
+            {
+              tcp_rtt_sample(conn, TCP_SEQ_SUB(TCP_TS_CLOCK(), tsecr));
+            }
+        }
+
       /* Do RTT estimation, unless we have done retransmissions. */
 
+      else
+#endif
       if (conn->nrtx == 0)
         {
           signed char m;
@@ -1210,7 +1406,7 @@ found:
                    * E.g. a keep-alive segment.
                    */
 
-                  tcp_send(dev, conn, TCP_ACK, tcpiplen);
+                  tcp_send(dev, conn, TCP_ACK, tcpip_hdrsize(conn));
                   return;
                 }
             }
@@ -1223,7 +1419,7 @@ found:
 #endif
               if ((conn->tcpstateflags & TCP_STATE_MASK) <= TCP_ESTABLISHED)
                 {
-                  tcp_send(dev, conn, TCP_ACK, tcpiplen);
+                  tcp_send(dev, conn, TCP_ACK, tcpip_hdrsize(conn));
                   return;
                 }
             }
@@ -1450,7 +1646,7 @@ found:
                 conn->sndseq_max    = tcp_getsequence(conn->sndseq) + 1;
 #endif
                 ninfo("TCP state: TCP_LAST_ACK\n");
-                tcp_send(dev, conn, TCP_FIN | TCP_ACK, tcpiplen);
+                tcp_send(dev, conn, TCP_FIN | TCP_ACK, tcpip_hdrsize(conn));
               }
             else
               {
@@ -1631,7 +1827,7 @@ found:
 
             net_incr32(conn->rcvseq, 1); /* ack FIN */
             tcp_callback(dev, conn, TCP_CLOSE);
-            tcp_send(dev, conn, TCP_ACK, tcpiplen);
+            tcp_send(dev, conn, TCP_ACK, tcpip_hdrsize(conn));
             return;
           }
         else if ((flags & TCP_ACKDATA) != 0 && conn->tx_unacked == 0)
@@ -1678,7 +1874,7 @@ found:
 
             net_incr32(conn->rcvseq, 1); /* ack FIN */
             tcp_callback(dev, conn, TCP_CLOSE);
-            tcp_send(dev, conn, TCP_ACK, tcpiplen);
+            tcp_send(dev, conn, TCP_ACK, tcpip_hdrsize(conn));
             return;
           }
 
@@ -1703,7 +1899,7 @@ found:
         goto drop;
 
       case TCP_TIME_WAIT:
-        tcp_send(dev, conn, TCP_ACK, tcpiplen);
+        tcp_send(dev, conn, TCP_ACK, tcpip_hdrsize(conn));
         return;
 
       case TCP_CLOSING:
@@ -1794,6 +1990,7 @@ void tcp_ipv4_input(FAR struct net_driver_s *dev)
 {
   FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
   uint16_t iphdrlen;
+  NET_LAYER_START(start);
 
   /* Configure to receive an TCP IPv4 packet */
 
@@ -1806,6 +2003,7 @@ void tcp_ipv4_input(FAR struct net_driver_s *dev)
   /* Then process in the TCP IPv4 input */
 
   tcp_input(dev, PF_INET, iphdrlen);
+  NET_LAYER_STOP(NET_LAYER_TCP, start);
 }
 #endif
 
@@ -1832,6 +2030,8 @@ void tcp_ipv4_input(FAR struct net_driver_s *dev)
 #ifdef CONFIG_NET_IPv6
 void tcp_ipv6_input(FAR struct net_driver_s *dev, unsigned int iplen)
 {
+  NET_LAYER_START(start);
+
   /* Configure to receive an TCP IPv6 packet */
 
   tcp_ipv6_select(dev);
@@ -1839,6 +2039,7 @@ void tcp_ipv6_input(FAR struct net_driver_s *dev, unsigned int iplen)
   /* Then process in the TCP IPv6 input */
 
   tcp_input(dev, PF_INET6, iplen);
+  NET_LAYER_STOP(NET_LAYER_TCP, start);
 }
 #endif
 
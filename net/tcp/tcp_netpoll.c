@@ -159,6 +159,15 @@ static uint16_t tcp_poll_eventhandler(FAR struct net_driver_s *dev,
           eventset |= POLLOUT;
         }
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+      /* MSG_ZEROCOPY sends completed */
+
+      if (tcp_zerocopy_pending(info->conn))
+        {
+          eventset |= POLLERR;
+        }
+#endif
+
       /* Awaken the caller of poll() if requested event occurred. */
 
       poll_notify(&info->fds, 1, eventset);
@@ -288,6 +297,12 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
       cb->flags |= TCP_NEWDATA | TCP_BACKLOG;
     }
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  /* The completions of the MSG_ZEROCOPY sends are found on these events */
+
+  cb->flags |= TCP_POLL | TCP_ACKDATA;
+#endif
+
   /* Save the reference in the poll info structure as fds private as well
    * for use during poll teardown as well.
    */
@@ -360,6 +375,13 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
       eventset |= POLLWRNORM;
     }
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  if (tcp_zerocopy_pending(conn))
+    {
+      eventset |= POLLERR;
+    }
+#endif
+
   /* Check if any requested events are already in effect */
 
   poll_notify(&fds, 1, eventset);
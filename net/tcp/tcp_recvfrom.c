@@ -61,6 +61,9 @@ struct tcp_recvfrom_s
   ssize_t                  ir_recvlen;   /* The received length */
   int                      ir_result;    /* Success:OK, failure:negated errno */
   int                      ir_flags;     /* Flags on received message.  */
+#ifdef CONFIG_NET_TCP_RECV_IOB
+  FAR struct iob_s       **ir_iob;       /* Receives the IOBs handed over */
+#endif
 };
 
 /****************************************************************************
@@ -174,10 +177,27 @@ static inline uint16_t tcp_newdata(FAR struct net_driver_s *dev,
                                    uint16_t flags)
 {
   FAR struct tcp_conn_s *conn = pstate->ir_conn;
+  size_t recvlen;
+
+#ifdef CONFIG_NET_TCP_RECV_IOB
+  if (pstate->ir_iob != NULL)
+    {
+      /* All of the data goes to the read-ahead buffers first, it is
+       * handed over from there.
+       */
 
-  /* Take as much data from the packet as we can */
+      dev->d_iob = iob_trimhead(dev->d_iob,
+                                (dev->d_appdata - dev->d_iob->io_data) -
+                                dev->d_iob->io_offset);
+      recvlen    = 0;
+    }
+  else
+#endif
+    {
+      /* Take as much data from the packet as we can */
 
-  size_t recvlen = tcp_recvfrom_newdata(dev, pstate);
+      recvlen = tcp_recvfrom_newdata(dev, pstate);
+    }
 
   /* If there is more data left in the packet that we could not buffer, then
    * add it to the read-ahead buffers.
@@ -223,6 +243,107 @@ static inline uint16_t tcp_newdata(FAR struct net_driver_s *dev,
   return flags;
 }
 
+/****************************************************************************
+ * Name: tcp_readahead_iob
+ *
+ * Description:
+ *   Hand over the read-ahead data to the caller of recv_iob():  The IOBs
+ *   are detached from the read-ahead buffers, up to the size still
+ *   requested.  The data is only copied if the first IOB holds more than
+ *   that.
+ *
+ * Input Parameters:
+ *   pstate   recvfrom state structure
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_RECV_IOB
+static void tcp_readahead_iob(FAR struct tcp_recvfrom_s *pstate)
+{
+  FAR struct tcp_conn_s *conn = pstate->ir_conn;
+  FAR struct iob_s *head = conn->readahead;
+  FAR struct iob_s *tail = NULL;
+  FAR struct iob_s *iob;
+  size_t recvlen = 0;
+
+  if (head == NULL || pstate->ir_buflen == 0)
+    {
+      return;
+    }
+
+  if (head->io_pktlen <= pstate->ir_buflen)
+    {
+      recvlen         = head->io_pktlen;
+      conn->readahead = NULL;
+    }
+  else
+    {
+      /* Detach the leading IOBs that fit */
+
+      for (iob = head; recvlen + iob->io_len <= pstate->ir_buflen;
+           iob = iob->io_flink)
+        {
+          recvlen += iob->io_len;
+          tail     = iob;
+        }
+
+      if (tail != NULL)
+        {
+          tail->io_flink  = NULL;
+          iob->io_pktlen  = head->io_pktlen - recvlen;
+          head->io_pktlen = recvlen;
+          conn->readahead = iob;
+        }
+      else
+        {
+          /* Copy the part of the first IOB that fits */
+
+          iob = iob_tryalloc(false);
+          if (iob == NULL ||
+              iob_clone_partial(head, pstate->ir_buflen, 0, iob, 0,
+                                false, false) < 0)
+            {
+              if (iob != NULL)
+                {
+                  iob_free_chain(iob);
+                }
+
+              return;
+            }
+
+          recvlen         = pstate->ir_buflen;
+          conn->readahead = iob_trimhead(head, recvlen);
+          head            = iob;
+        }
+    }
+
+  ninfo("Handed over %zu bytes\n", recvlen);
+
+  if (*pstate->ir_iob == NULL)
+    {
+      *pstate->ir_iob = head;
+    }
+  else
+    {
+      iob_concat(*pstate->ir_iob, head);
+    }
+
+  if (pstate->ir_recvlen < 0)
+    {
+      pstate->ir_recvlen = 0;
+    }
+
+  pstate->ir_recvlen += recvlen;
+  pstate->ir_buflen  -= recvlen;
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_readahead
  *
@@ -246,6 +367,14 @@ static inline void tcp_readahead(struct tcp_recvfrom_s *pstate)
   FAR struct iob_s *iob;
   int recvlen;
 
+#ifdef CONFIG_NET_TCP_RECV_IOB
+  if (pstate->ir_iob != NULL)
+    {
+      tcp_readahead_iob(pstate);
+      return;
+    }
+#endif
+
   /* Check there is any TCP data already buffered in a read-ahead
    * buffer.
    */
@@ -414,6 +543,13 @@ static uint16_t tcp_recvhandler(FAR struct net_driver_s *dev,
 
           flags = tcp_newdata(dev, pstate, flags);
 
+#ifdef CONFIG_NET_TCP_RECV_IOB
+          if (pstate->ir_iob != NULL)
+            {
+              tcp_readahead_iob(pstate);
+            }
+#endif
+
           /* Indicate that the data has been consumed and that an ACK
            * should be sent.
            */
@@ -632,18 +768,15 @@ static void tcp_notify_recvcpu(FAR struct tcp_conn_s *conn)
 #endif /* CONFIG_NETDEV_RSS */
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: psock_tcp_recvfrom
+ * Name: tcp_recvfrom_common
  *
  * Description:
- *   Perform the recvfrom operation for a TCP/IP SOCK_STREAM
+ *   Perform the receive operation described by the initialized state
+ *   structure.
  *
  * Input Parameters:
- *   psock    Pointer to the socket structure for the SOCK_DRAM socket
- *   msg      Receive info and buffer for receive data
+ *   psock    Pointer to the socket structure for the SOCK_STREAM socket
+ *   pstate   The initialized recvfrom state structure
  *   flags    Receive flags
  *
  * Returned Value:
@@ -651,37 +784,26 @@ static void tcp_notify_recvcpu(FAR struct tcp_conn_s *conn)
  *   -errno is returned (see recvfrom for list of errnos).
  *
  * Assumptions:
+ *   The network is locked.
  *
  ****************************************************************************/
 
-ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
-                           int flags)
+static ssize_t tcp_recvfrom_common(FAR struct socket *psock,
+                                   FAR struct tcp_recvfrom_s *pstate,
+                                   int flags)
 {
-  FAR struct sockaddr   *from    = msg->msg_name;
-  FAR socklen_t         *fromlen = &msg->msg_namelen;
-  FAR void              *buf     = msg->msg_iov->iov_base;
-  size_t                 len     = msg->msg_iov->iov_len;
-  struct tcp_recvfrom_s  state;
   FAR struct tcp_conn_s *conn;
   struct tcp_callback_s  info;
   int                    ret;
 
-  net_lock();
-
   conn = psock->s_conn;
 
-  /* Initialize the state structure.  This is done with the network locked
-   * because we don't want anything to happen until we are ready.
-   */
-
-  tcp_recvfrom_initialize(conn, buf, len, from, fromlen, &state, flags);
-
   /* Handle any any TCP data already buffered in a read-ahead buffer.  NOTE
    * that there may be read-ahead data to be retrieved even after the
    * socket has been disconnected.
    */
 
-  tcp_readahead(&state);
+  tcp_readahead(pstate);
 
   /* The default return value is the number of bytes that we just copied
    * into the user buffer.  We will return this if the socket has become
@@ -689,7 +811,7 @@ ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
    * data from the readahead buffers.
    */
 
-  ret = state.ir_recvlen;
+  ret = pstate->ir_recvlen;
 
   /* Verify that the SOCK_STREAM has been and still is connected */
 
@@ -749,7 +871,7 @@ ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
    * incoming TCP/IP data.  Just a few more conditions to check:
    *
    * 1) Make sure that there is buffer space to receive additional data
-   *    (state.ir_buflen > 0).  This could be zero, for example,  we filled
+   *    (pstate->ir_buflen > 0).  This could be zero, for example,  we filled
    *    the user buffer with data from the read-ahead buffers.  And
    * 2) then we not want to wait if we already obtained some data from the
    *    read-ahead buffer.  In that case, return now with what we have (don't
@@ -758,34 +880,46 @@ ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
    *    data are received (or there is a timeout / error).
    */
 
-  if (((flags & MSG_WAITALL) != 0 || state.ir_recvlen == 0) &&
-      state.ir_buflen > 0)
+  if (((flags & MSG_WAITALL) != 0 || pstate->ir_recvlen == 0) &&
+      pstate->ir_buflen > 0)
     {
       /* Set up the callback in the connection */
 
-      state.ir_cb = tcp_callback_alloc(conn);
-      if (state.ir_cb)
+      pstate->ir_cb = tcp_callback_alloc(conn);
+      if (pstate->ir_cb)
         {
-          state.ir_cb->flags   = (TCP_NEWDATA | TCP_DISCONN_EVENTS);
-          state.ir_cb->flags  |= (flags & MSG_WAITALL) ? TCP_WAITALL : 0;
-          state.ir_cb->priv    = (FAR void *)&state;
-          state.ir_cb->event   = tcp_recvhandler;
+          pstate->ir_cb->flags   = (TCP_NEWDATA | TCP_DISCONN_EVENTS);
+          pstate->ir_cb->flags  |= (flags & MSG_WAITALL) ? TCP_WAITALL : 0;
+          pstate->ir_cb->priv    = (FAR void *)pstate;
+          pstate->ir_cb->event   = tcp_recvhandler;
 
           /* Push a cancellation point onto the stack.  This will be
            * called if the thread is canceled.
            */
 
           info.tc_conn = conn;
-          info.tc_cb   = state.ir_cb;
-          info.tc_sem  = &state.ir_sem;
+          info.tc_cb   = pstate->ir_cb;
+          info.tc_sem  = &pstate->ir_sem;
           tls_cleanup_push(tls_get_info(), tcp_callback_cleanup, &info);
 
+#ifdef CONFIG_NET_BUSYPOLL
+          /* Spin on the RX of the device first, the data is then received
+           * without waiting for the interrupt and the worker of the driver.
+           */
+
+          if (conn->sconn.s_busypoll > 0)
+            {
+              netdev_busypoll(conn->dev, conn->sconn.s_busypoll,
+                              netdev_busypoll_sem, &pstate->ir_sem);
+            }
+#endif
+
           /* Wait for either the receive to complete or for an error/timeout
            * to occur.  net_sem_timedwait will also terminate if a signal is
            * received.
            */
 
-          ret = net_sem_timedwait(&state.ir_sem,
+          ret = net_sem_timedwait(&pstate->ir_sem,
                                _SO_TIMEOUT(conn->sconn.s_rcvtimeo));
           tls_cleanup_pop(tls_get_info(), 0);
           if (ret == -ETIMEDOUT)
@@ -795,8 +929,8 @@ ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
 
           /* Make sure that no further events are processed */
 
-          tcp_callback_free(conn, state.ir_cb);
-          ret = tcp_recvfrom_result(ret, &state);
+          tcp_callback_free(conn, pstate->ir_cb);
+          ret = tcp_recvfrom_result(ret, pstate);
         }
       else if (ret <= 0)
         {
@@ -818,9 +952,121 @@ ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
 
   tcp_notify_recvcpu(conn);
 
+  return (ssize_t)ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_tcp_recvfrom
+ *
+ * Description:
+ *   Perform the recvfrom operation for a TCP/IP SOCK_STREAM
+ *
+ * Input Parameters:
+ *   psock    Pointer to the socket structure for the SOCK_DRAM socket
+ *   msg      Receive info and buffer for receive data
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On  error,
+ *   -errno is returned (see recvfrom for list of errnos).
+ *
+ * Assumptions:
+ *
+ ****************************************************************************/
+
+ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
+                           int flags)
+{
+  FAR struct sockaddr   *from    = msg->msg_name;
+  FAR socklen_t         *fromlen = &msg->msg_namelen;
+  FAR void              *buf     = msg->msg_iov->iov_base;
+  size_t                 len     = msg->msg_iov->iov_len;
+  struct tcp_recvfrom_s  state;
+  ssize_t                ret;
+
+  net_lock();
+
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  /* The error queue only holds the completions of MSG_ZEROCOPY sends */
+
+  if ((flags & MSG_ERRQUEUE) != 0)
+    {
+      ret = tcp_zerocopy_recverr(psock->s_conn, msg);
+      net_unlock();
+      return ret;
+    }
+#endif
+
+  /* Initialize the state structure.  This is done with the network locked
+   * because we don't want anything to happen until we are ready.
+   */
+
+  tcp_recvfrom_initialize(psock->s_conn, buf, len, from, fromlen, &state,
+                          flags);
+  ret = tcp_recvfrom_common(psock, &state, flags);
+
   net_unlock();
   tcp_recvfrom_uninitialize(&state);
-  return (ssize_t)ret;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: psock_tcp_recviob
+ *
+ * Description:
+ *   Perform the recv_iob operation for a TCP/IP SOCK_STREAM:  Up to 'len'
+ *   bytes of received data are handed over in an IOB chain, instead of
+ *   being copied to a buffer.
+ *
+ * Input Parameters:
+ *   psock    Pointer to the socket structure for the SOCK_STREAM socket
+ *   iob      Receives the IOB chain, owned by the caller on success
+ *   len      The maximum number of bytes to receive
+ *   flags    Receive flags, MSG_PEEK is not supported
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes in the IOB chain.  On error,
+ *   -errno is returned (see recvfrom for list of errnos).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_RECV_IOB
+ssize_t psock_tcp_recviob(FAR struct socket *psock, FAR struct iob_s **iob,
+                          size_t len, int flags)
+{
+  struct tcp_recvfrom_s state;
+  ssize_t ret;
+
+  if ((flags & MSG_PEEK) != 0)
+    {
+      return -EINVAL;
+    }
+
+  *iob = NULL;
+
+  net_lock();
+
+  tcp_recvfrom_initialize(psock->s_conn, NULL, len, NULL, NULL, &state,
+                          flags);
+  state.ir_iob = iob;
+  ret = tcp_recvfrom_common(psock, &state, flags);
+
+  net_unlock();
+  tcp_recvfrom_uninitialize(&state);
+
+  /* The data handed over before an error is not lost */
+
+  if (ret < 0 && *iob != NULL)
+    {
+      ret = (*iob)->io_pktlen;
+    }
+
+  return ret;
 }
+#endif
 
 #endif /* CONFIG_NET_TCP */
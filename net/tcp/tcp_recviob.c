@@ -0,0 +1,177 @@
+/****************************************************************************
+ * net/tcp/tcp_recviob.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+
+#include "netdev/netdev.h"
+#include "inet/inet.h"
+#include "socket/socket.h"
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_recviob_socket
+ *
+ * Description:
+ *   Get the socket structure of a TCP socket descriptor.
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.  The file must
+ *   be released with fs_putfilep() on success.
+ *
+ ****************************************************************************/
+
+static int tcp_recviob_socket(int sockfd, FAR struct file **filep,
+                              FAR struct socket **psock)
+{
+  int ret;
+
+  ret = sockfd_socket(sockfd, filep, psock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if ((*psock)->s_type != SOCK_STREAM || (*psock)->s_conn == NULL ||
+      (*psock)->s_sockif != inet_sockif((*psock)->s_domain,
+                                        (*psock)->s_type,
+                                        (*psock)->s_proto))
+    {
+      fs_putfilep(*filep);
+      return -EOPNOTSUPP;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: recv_iob
+ *
+ * Description:
+ *   Receive up to 'len' bytes from a connected TCP socket, as recv() does,
+ *   but hand over the IOBs that hold the data instead of copying it:  On
+ *   success '*iob' is an IOB chain of io_pktlen bytes that the caller owns
+ *   and must give back with recv_iob_release().  The data of each IOB is
+ *   the io_len bytes at IOB_DATA().
+ *
+ * Input Parameters:
+ *   sockfd   Socket descriptor of the TCP socket
+ *   iob      Receives the IOB chain
+ *   len      The maximum number of bytes to receive
+ *   flags    Receive flags, as for recv() but MSG_PEEK
+ *
+ * Returned Value:
+ *   The number of bytes received, zero at the end of the stream.  -1
+ *   (ERROR) on failure with errno set appropriately, EOPNOTSUPP if the
+ *   socket is not a TCP socket and EINVAL for MSG_PEEK.
+ *
+ ****************************************************************************/
+
+ssize_t recv_iob(int sockfd, FAR struct iob_s **iob, size_t len, int flags)
+{
+  FAR struct socket *psock;
+  FAR struct file *filep;
+  ssize_t ret;
+
+  /* recv_iob() is a cancellation point */
+
+  enter_cancellation_point();
+
+  ret = tcp_recviob_socket(sockfd, &filep, &psock);
+  if (ret >= 0)
+    {
+      ret = psock_tcp_recviob(psock, iob, len, flags);
+      fs_putfilep(filep);
+    }
+
+  leave_cancellation_point();
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: recv_iob_release
+ *
+ * Description:
+ *   Give back an IOB chain returned by recv_iob() on the same socket.  The
+ *   peer is told of the larger receive window if the release opens it.
+ *
+ * Input Parameters:
+ *   sockfd   Socket descriptor of the TCP socket
+ *   iob      The IOB chain, may be NULL
+ *
+ ****************************************************************************/
+
+void recv_iob_release(int sockfd, FAR struct iob_s *iob)
+{
+  FAR struct socket *psock;
+  FAR struct file *filep;
+  FAR struct tcp_conn_s *conn;
+
+  if (iob != NULL)
+    {
+      iob_free_chain(iob);
+    }
+
+  if (tcp_recviob_socket(sockfd, &filep, &psock) < 0)
+    {
+      return;
+    }
+
+  net_lock();
+
+  conn = psock->s_conn;
+  if (_SS_ISCONNECTED(conn->sconn.s_flags) &&
+      tcp_should_send_recvwindow(conn))
+    {
+      netdev_txnotify_dev(conn->dev);
+    }
+
+  net_unlock();
+  fs_putfilep(filep);
+}
@@ -104,6 +104,29 @@ static inline FAR struct tcp_hdr_s *tcp_header(FAR struct net_driver_s *dev)
 #endif /* CONFIG_NET_IPv4 */
 }
 
+/****************************************************************************
+ * Name: tcp_put_timestamp
+ *
+ * Description:
+ *   Write the Timestamps option, with our clock and the last timestamp of
+ *   the peer, in the TCP_TS_OPTLEN bytes at 'optdata'.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+static void tcp_put_timestamp(FAR struct tcp_conn_s *conn,
+                              FAR uint8_t *optdata)
+{
+  optdata[0] = TCP_OPT_NOOP;
+  optdata[1] = TCP_OPT_NOOP;
+  optdata[2] = TCP_OPT_TS;
+  optdata[3] = TCP_OPT_TS_LEN;
+
+  tcp_setsequence(&optdata[4], TCP_TS_CLOCK());
+  tcp_setsequence(&optdata[8], conn->ts_recent);
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_sendcommon
  *
@@ -200,11 +223,15 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
       tcp->tcpchksum = 0;
 
 #ifdef CONFIG_NET_TCP_CHECKSUMS
-      tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+      if (!net_chksum_offload(dev, IP_PROTO_TCP, IPv6_HDRLEN,
+                              &tcp->tcpchksum))
+        {
+          tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+        }
 #endif
 
 #ifdef CONFIG_NET_STATISTICS
-      g_netstats.ipv6.sent++;
+      NET_STATS(ipv6.sent)++;
 #endif
     }
 #endif /* CONFIG_NET_IPv6 */
@@ -224,18 +251,22 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
       tcp->tcpchksum = 0;
 
 #ifdef CONFIG_NET_TCP_CHECKSUMS
-      tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+      if (!net_chksum_offload(dev, IP_PROTO_TCP, IPv4_HDRLEN,
+                              &tcp->tcpchksum))
+        {
+          tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+        }
 #endif
 
 #ifdef CONFIG_NET_STATISTICS
-      g_netstats.ipv4.sent++;
+      NET_STATS(ipv4.sent)++;
 #endif
     }
 #endif /* CONFIG_NET_IPv4 */
 
   ninfo("Outgoing TCP packet length: %d bytes\n", dev->d_len);
 #ifdef CONFIG_NET_STATISTICS
-  g_netstats.tcp.sent++;
+  NET_STATS(tcp.sent)++;
 #endif
 
 #if !defined(CONFIG_NET_TCP_WRITE_BUFFERS)
@@ -287,6 +318,7 @@ void tcp_send(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
               uint16_t flags, uint16_t len)
 {
   FAR struct tcp_hdr_s *tcp;
+  int optlen = 0;
 
   if (dev->d_iob == NULL)
     {
@@ -297,39 +329,56 @@ void tcp_send(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   tcp->flags = flags;
   dev->d_len = len;
 
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  if ((conn->flags & TCP_TSTAMP) != 0)
+    {
+      /* The room of the option is already in len, see tcpip_hdrsize() */
+
+      tcp_put_timestamp(conn, tcp->optdata);
+      optlen = TCP_TS_OPTLEN;
+    }
+#endif
+
 #ifdef CONFIG_NET_TCP_SELECTIVE_ACK
   if ((conn->flags & TCP_SACK) && (flags == TCP_ACK) && conn->nofosegs > 0)
     {
-      int optlen = conn->nofosegs * sizeof(struct tcp_sack_s);
+      FAR uint8_t *sack = &tcp->optdata[optlen];
+      int nsacks;
+      int sacklen;
       int i;
 
-      tcp->optdata[0] = TCP_OPT_NOOP;
-      tcp->optdata[1] = TCP_OPT_NOOP;
-      tcp->optdata[2] = TCP_OPT_SACK;
-      tcp->optdata[3] = TCP_OPT_SACK_PERM_LEN + optlen;
+      /* Send the blocks that fit in the room left by the other options */
+
+      nsacks  = (TCP_MAX_HDRLEN - TCP_HDRLEN - optlen - 4) /
+                sizeof(struct tcp_sack_s);
+      nsacks  = MIN(nsacks, conn->nofosegs);
+      sacklen = nsacks * sizeof(struct tcp_sack_s);
 
-      optlen += 4;
+      sack[0] = TCP_OPT_NOOP;
+      sack[1] = TCP_OPT_NOOP;
+      sack[2] = TCP_OPT_SACK;
+      sack[3] = TCP_OPT_SACK_PERM_LEN + sacklen;
 
-      for (i = 0; i < conn->nofosegs; i++)
+      sacklen += 4;
+
+      for (i = 0; i < nsacks; i++)
         {
           ninfo("TCP SACK [%d]"
                 "[%" PRIu32 " : %" PRIu32 " : %" PRIu32 "]\n", i,
                 conn->ofosegs[i].left, conn->ofosegs[i].right,
                 TCP_SEQ_SUB(conn->ofosegs[i].right, conn->ofosegs[i].left));
-          tcp_setsequence(&tcp->optdata[4 + i * 2 * sizeof(uint32_t)],
+          tcp_setsequence(&sack[4 + i * 2 * sizeof(uint32_t)],
                           conn->ofosegs[i].left);
-          tcp_setsequence(&tcp->optdata[4 + (i * 2 + 1) * sizeof(uint32_t)],
+          tcp_setsequence(&sack[4 + (i * 2 + 1) * sizeof(uint32_t)],
                           conn->ofosegs[i].right);
         }
 
-      dev->d_len += optlen;
-      tcp->tcpoffset = ((TCP_HDRLEN + optlen) / 4) << 4;
+      dev->d_len += sacklen;
+      optlen     += sacklen;
     }
-  else
 #endif /* CONFIG_NET_TCP_SELECTIVE_ACK */
-    {
-      tcp->tcpoffset = (TCP_HDRLEN / 4) << 4;
-    }
+
+  tcp->tcpoffset = ((TCP_HDRLEN + optlen) / 4) << 4;
 
   tcp_sendcommon(dev, conn, tcp);
 
@@ -346,14 +395,14 @@ void tcp_send(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
   if ((flags & TCP_PSH) != 0)
     {
-      if ((g_netstats.tcp.sent %
+      if ((NET_STATS(tcp.sent) %
           CONFIG_NET_TCP_DEBUG_DROP_SEND_PROBABILITY) == 0)
         {
           uint32_t seq = tcp_getsequence(tcp->seqno);
 
           ninfo("TCP DROP SNDPKT: "
                 "[%d][%" PRIu32 " : %" PRIu32 " : %d]\n",
-                g_netstats.tcp.sent, seq, TCP_SEQ_ADD(seq, dev->d_sndlen),
+                NET_STATS(tcp.sent), seq, TCP_SEQ_ADD(seq, dev->d_sndlen),
                 dev->d_sndlen);
 
           dev->d_len = 0;
@@ -393,7 +442,7 @@ void tcp_reset(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
     }
 
 #ifdef CONFIG_NET_STATISTICS
-  g_netstats.tcp.rst++;
+  NET_STATS(tcp.rst)++;
 #endif
 
   /* TCP setup */
@@ -503,7 +552,11 @@ void tcp_reset(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
       tcp->tcpchksum = 0;
 
 #ifdef CONFIG_NET_TCP_CHECKSUMS
-      tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+      if (!net_chksum_offload(dev, IP_PROTO_TCP, IPv6_HDRLEN,
+                              &tcp->tcpchksum))
+        {
+          tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+        }
 #endif
     }
 #endif /* CONFIG_NET_IPv6 */
@@ -523,7 +576,11 @@ void tcp_reset(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
       tcp->tcpchksum = 0;
 
 #ifdef CONFIG_NET_TCP_CHECKSUMS
-      tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+      if (!net_chksum_offload(dev, IP_PROTO_TCP, IPv4_HDRLEN,
+                              &tcp->tcpchksum))
+        {
+          tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+        }
 #endif
     }
 #endif /* CONFIG_NET_IPv4 */
@@ -607,9 +664,13 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
   tcp = tcp_header(dev);
 
-  /* Set the packet length for the TCP Maximum Segment Size */
+  /* Set the packet length for the TCP Maximum Segment Size.  The room of
+   * the options is added below.
+   */
 
-  dev->d_len = tcpip_hdrsize(conn);
+  dev->d_len = net_ip_domain_select(conn->domain,
+                                    IPv4_HDRLEN + TCP_HDRLEN,
+                                    IPv6_HDRLEN + TCP_HDRLEN);
 
   /* Set the packet length for the TCP Maximum Segment Size */
 
@@ -662,6 +723,15 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
     }
 #endif
 
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  if (tcp->flags == TCP_SYN ||
+      ((tcp->flags == (TCP_ACK | TCP_SYN)) && (conn->flags & TCP_TSTAMP)))
+    {
+      tcp_put_timestamp(conn, &tcp->optdata[optlen]);
+      optlen += TCP_TS_OPTLEN;
+    }
+#endif
+
   tcp->tcpoffset         = ((TCP_HDRLEN + optlen) / 4) << 4;
   dev->d_len            += optlen;
 
@@ -721,7 +791,8 @@ void tcp_send_txnotify(FAR struct socket *psock,
  * Name: tcpip_hdrsize
  *
  * Description:
- *   Get the total size of L3 and L4 TCP header
+ *   Get the total size of L3 and L4 TCP header, with the room of the
+ *   options sent in all the segments of the connection
  *
  * Input Parameters:
  *   conn     The connection structure associated with the socket
@@ -735,6 +806,15 @@ uint16_t tcpip_hdrsize(FAR struct tcp_conn_s *conn)
 {
   uint16_t hdrsize = sizeof(struct tcp_hdr_s);
 
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+  /* All the segments have the Timestamps option once it is negotiated */
+
+  if ((conn->flags & TCP_TSTAMP) != 0)
+    {
+      hdrsize += TCP_TS_OPTLEN;
+    }
+#endif
+
   UNUSED(conn);
   return net_ip_domain_select(conn->domain,
                               sizeof(struct ipv4_hdr_s) + hdrsize,
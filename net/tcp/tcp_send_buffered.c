@@ -185,6 +185,7 @@ static void retransmit_segment(FAR struct tcp_conn_s *conn,
 
       /* Return the write buffer to the free list */
 
+      tcp_zerocopy_release(conn, wrb);
       tcp_wrbuffer_release(wrb);
 
       /* Notify any waiters if the write buffers have been
@@ -236,6 +237,12 @@ static void retransmit_segment(FAR struct tcp_conn_s *conn,
 
       TCP_WBSENT(wrb) = 0;
 
+#ifdef CONFIG_NET_TCP_SELECTIVE_ACK
+      /* The receiver may have discarded the data it SACKed (RFC 2018) */
+
+      TCP_WBSACKED(wrb) = false;
+#endif
+
       /* Insert the write buffer into the write_q (in sequence
        * number order).  The retransmission will occur below
        * when the write buffer with the lowest sequence number
@@ -320,18 +327,21 @@ static inline void psock_lost_connection(FAR struct tcp_conn_s *conn,
 }
 
 /****************************************************************************
- * Name: parse_sack
+ * Name: psock_sack_update
  *
  * Description:
- *   Parse sack from incoming TCP options
+ *   Parse the SACK option of an incoming ACK (RFC 2018) and mark the write
+ *   buffers of the unacked_q that it covers entirely.  The marks form the
+ *   scoreboard of the SACK based loss recovery, they are kept until the
+ *   data is ACKed or retransmitted.
  *
  * Input Parameters:
  *   conn   - The TCP connection of interest
  *   tcp    - Header of tcp structure
- *   segs   - Segments edge of sacks
+ *   ackno  - The acknowledgement number of the ACK
  *
  * Returned Value:
- *   Number of sacks
+ *   None
  *
  * Assumptions:
  *   The network is locked.
@@ -339,79 +349,214 @@ static inline void psock_lost_connection(FAR struct tcp_conn_s *conn,
  ****************************************************************************/
 
 #ifdef CONFIG_NET_TCP_SELECTIVE_ACK
-static int parse_sack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp,
-                      FAR struct tcp_ofoseg_s *segs)
+static void psock_sack_update(FAR struct tcp_conn_s *conn,
+                              FAR struct tcp_hdr_s *tcp, uint32_t ackno)
 {
-  FAR struct tcp_sack_s *sacks;
-  int nsack = 0;
-  uint8_t opt;
+  struct tcp_sack_s sacks[TCP_SACK_RANGES_MAX];
+  FAR struct tcp_wrbuffer_s *wrb;
+  FAR sq_entry_t *entry;
+  FAR uint8_t *opt;
+  uint32_t lastseq;
+  int nsacks = 0;
+  int optlen;
   int i;
 
-  /* Get the size of the link layer header,
-   * the IP and TCP header
-   */
+  optlen = ((tcp->tcpoffset >> 4) - 5) << 2;
 
-  for (i = 0; i < ((tcp->tcpoffset >> 4) - 5) << 2 ; )
+  for (i = 0; i < optlen; )
     {
-      opt = *(tcp->optdata + i);
-      if (opt == TCP_OPT_END)
+      opt = tcp->optdata + i;
+      if (opt[0] == TCP_OPT_END)
         {
           /* End of options. */
 
           break;
         }
-      else if (opt == TCP_OPT_NOOP)
+      else if (opt[0] == TCP_OPT_NOOP)
         {
           /* NOP option. */
 
-          ++i;
+          i++;
           continue;
         }
-      else if (opt == TCP_OPT_SACK)
+      else if (i + 1 >= optlen || opt[1] < 2 || i + opt[1] > optlen)
         {
-          nsack = (*(tcp->optdata + 1 + i) -
-                   TCP_OPT_SACK_PERM_LEN) /
-                   (sizeof(uint32_t) * 2);
-          sacks = (FAR struct tcp_sack_s *)
-                  (tcp->optdata + i +
-                   TCP_OPT_SACK_PERM_LEN);
-
-          for (i = 0; i < nsack; i++)
-            {
-              /* Use the pointer to avoid the error of 4 byte alignment. */
+          /* The options are malformed, don't process them further */
+
+          break;
+        }
+      else if (opt[0] == TCP_OPT_SACK)
+        {
+          /* The blocks follow the kind and length bytes.  Use the pointer
+           * to avoid the error of 4 byte alignment.
+           */
 
-              segs[i].left = tcp_getsequence((uint8_t *)&sacks[i]);
-              segs[i].right = tcp_getsequence((uint8_t *)&sacks[i] + 4);
+          nsacks = (opt[1] - 2) / (2 * sizeof(uint32_t));
+          if (nsacks > TCP_SACK_RANGES_MAX)
+            {
+              nsacks = TCP_SACK_RANGES_MAX;
             }
 
-          tcp_reorder_ofosegs(nsack, segs);
+          for (i = 0; i < nsacks; i++)
+            {
+              sacks[i].left  = tcp_getsequence(opt + 2 + 8 * i);
+              sacks[i].right = tcp_getsequence(opt + 6 + 8 * i);
+
+              ninfo("TCP SACK [%d]"
+                    "[%" PRIu32 " : %" PRIu32 " : %" PRIu32 "]\n",
+                    i, sacks[i].left, sacks[i].right,
+                    TCP_SEQ_SUB(sacks[i].right, sacks[i].left));
+            }
 
           break;
         }
-      else
+
+      i += opt[1];
+    }
+
+  for (i = 0; i < nsacks; i++)
+    {
+      /* Ignore the blocks below the ACK number (D-SACK) and those beyond
+       * the data sent.
+       */
+
+      if (TCP_SEQ_LTE(sacks[i].left, ackno) ||
+          TCP_SEQ_GTE(sacks[i].left, sacks[i].right) ||
+          TCP_SEQ_GT(sacks[i].right, conn->sndseq_max))
         {
-          /* All other options have a length field,
-           * so that we easily can skip past them.
-           */
+          continue;
+        }
 
-          if (*(tcp->optdata + 1 + i) == 0)
+      for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+        {
+          wrb = (FAR struct tcp_wrbuffer_s *)entry;
+          if (TCP_SEQ_GTE(TCP_WBSEQNO(wrb), sacks[i].right))
             {
-              /* If the length field is zero,
-               * the options are malformed and
-               * we don't process them further.
-               */
-
               break;
             }
+
+          lastseq = TCP_WBSEQNO(wrb) + TCP_WBPKTLEN(wrb);
+          if (TCP_SEQ_GTE(TCP_WBSEQNO(wrb), sacks[i].left) &&
+              TCP_SEQ_LTE(lastseq, sacks[i].right))
+            {
+              TCP_WBSACKED(wrb) = true;
+            }
         }
+    }
+}
+
+/****************************************************************************
+ * Name: psock_sack_rexmit
+ *
+ * Description:
+ *   Retransmit the write buffers of the unacked_q that the scoreboard
+ *   reports lost, as RFC 6675 does:  The first hole once the duplicate ACK
+ *   threshold is reached, the others once more than
+ *   (TCP_FAST_RETRANSMISSION_THRESH - 1) * MSS bytes above them have been
+ *   selectively ACKed.  Each hole is retransmitted once per recovery, the
+ *   data that arrived is not sent again.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   ackno  - The acknowledgement number of the last ACK
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
 
-      i += *(tcp->optdata + 1 + i);
+static void psock_sack_rexmit(FAR struct tcp_conn_s *conn, uint32_t ackno)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+  FAR sq_entry_t *entry;
+  FAR sq_entry_t *next;
+  uint32_t sacked = 0;
+
+  for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+    {
+      wrb = (FAR struct tcp_wrbuffer_s *)entry;
+      if (TCP_WBSACKED(wrb))
+        {
+          sacked += TCP_WBPKTLEN(wrb);
+        }
     }
 
-  return nsack;
+  for (entry = sq_peek(&conn->unacked_q); entry; entry = next)
+    {
+      wrb  = (FAR struct tcp_wrbuffer_s *)entry;
+      next = sq_next(entry);
+
+      /* 'sacked' is the number of bytes SACKed above this write buffer */
+
+      if (TCP_WBSACKED(wrb))
+        {
+          sacked -= TCP_WBPKTLEN(wrb);
+          continue;
+        }
+
+      if (TCP_WBSEQNO(wrb) != ackno &&
+          sacked <= (TCP_FAST_RETRANSMISSION_THRESH - 1) * conn->mss)
+        {
+          break;
+        }
+
+      /* Already retransmitted by this recovery? */
+
+      if (TCP_SEQ_LT(TCP_WBSEQNO(wrb), conn->sack_hirxt))
+        {
+          continue;
+        }
+
+      ninfo("TCP REXMIT "
+            "[%" PRIu32 " : %" PRIu32 " : %d]\n",
+            TCP_WBSEQNO(wrb),
+            TCP_SEQ_ADD(TCP_WBSEQNO(wrb), TCP_WBPKTLEN(wrb)),
+            TCP_WBPKTLEN(wrb));
+
+      conn->sack_hirxt = TCP_WBSEQNO(wrb) + TCP_WBPKTLEN(wrb);
+      sq_rem(entry, &conn->unacked_q);
+      retransmit_segment(conn, (FAR void *)entry);
+    }
 }
 #endif /* CONFIG_NET_TCP_SELECTIVE_ACK */
 
+/****************************************************************************
+ * Name: psock_send_maxlen
+ *
+ * Description:
+ *   Get the largest amount of new data to send in a packet:  A segment, or
+ *   as many whole segments as fit in a super-segment if the driver supports
+ *   GSO.
+ *
+ * Input Parameters:
+ *   dev      The structure of the network driver
+ *   conn     The TCP connection
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_GSO
+static size_t psock_send_maxlen(FAR struct net_driver_s *dev,
+                                FAR struct tcp_conn_s *conn)
+{
+  uint16_t hdrlen = tcpip_hdrsize(conn);
+
+  if (dev->d_gsomax > hdrlen + conn->mss)
+    {
+      return (dev->d_gsomax - hdrlen) / conn->mss * conn->mss;
+    }
+
+  return conn->mss;
+}
+#else
+#  define psock_send_maxlen(dev, conn) ((conn)->mss)
+#endif
+
 /****************************************************************************
  * Name: psock_send_eventhandler
  *
@@ -437,8 +582,7 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 {
   FAR struct tcp_conn_s *conn = pvpriv;
 #ifdef CONFIG_NET_TCP_SELECTIVE_ACK
-  struct tcp_ofoseg_s ofosegs[TCP_SACK_RANGES_MAX];
-  uint8_t nsacks = 0;
+  bool sackrexmit = false;
 #endif
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
   uint32_t rexmitno = 0;
@@ -508,6 +652,15 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       ackno = tcp_getsequence(tcp->ackno);
       ninfo("ACK: ackno=%" PRIu32 " flags=%04x\n", ackno, flags);
 
+#ifdef CONFIG_NET_TCP_SELECTIVE_ACK
+      /* Update the scoreboard with the SACK blocks of the ACK */
+
+      if ((conn->flags & TCP_SACK) && (tcp->tcpoffset & 0xf0) > 0x50)
+        {
+          psock_sack_update(conn, tcp, ackno);
+        }
+#endif
+
       /* Look at every write buffer in the unacked_q.  The unacked_q
        * holds write buffers that have been entirely sent, but which
        * have not yet been ACKed.
@@ -551,6 +704,7 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
                    * buffers
                    */
 
+                  tcp_zerocopy_release(conn, wrb);
                   tcp_wrbuffer_release(wrb);
 
                   /* Notify any waiters if the write buffers have been
@@ -608,21 +762,29 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
                        * driver to send the message and marked as rexmit
                        */
 
+#ifndef CONFIG_NET_TCP_CC_NEWRENO
                       TCP_WBNACK(wrb) = 0;
+#endif
                       conn->timeout = true;
                       netdev_txnotify_dev(conn->dev);
                       return flags;
                     }
 
 #ifdef CONFIG_NET_TCP_SELECTIVE_ACK
-                  if ((conn->flags & TCP_SACK) &&
-                      (tcp->tcpoffset & 0xf0) > 0x50)
+                  if ((conn->flags & TCP_SACK) != 0)
                     {
-                      /* Parse s-ack from tcp options */
+                      /* Enter the SACK based loss recovery, which lasts
+                       * until the data sent so far is ACKed.
+                       */
 
-                      nsacks = parse_sack(conn, tcp, ofosegs);
+                      if ((conn->flags & TCP_SACK_RECOVERY) == 0)
+                        {
+                          conn->flags       |= TCP_SACK_RECOVERY;
+                          conn->sack_recover = conn->sndseq_max;
+                          conn->sack_hirxt   = ackno;
+                        }
 
-                      flags |= TCP_REXMIT;
+                      sackrexmit = true;
                     }
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
                   else
@@ -648,6 +810,40 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
             }
         }
 
+#ifdef CONFIG_NET_TCP_SELECTIVE_ACK
+      /* Each ACK of the recovery may report more lost data */
+
+      if ((conn->flags & TCP_SACK_RECOVERY) != 0)
+        {
+          if (TCP_SEQ_GTE(ackno, conn->sack_recover))
+            {
+              conn->flags &= ~TCP_SACK_RECOVERY;
+            }
+          else
+            {
+              sackrexmit = true;
+            }
+        }
+
+      if (sackrexmit)
+        {
+          psock_sack_rexmit(conn, ackno);
+
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+          /* After Fast retransmitted, set ssthresh to the maximum of
+           * the unacked and the 2*SMSS, and enter to Fast Recovery.
+           * ssthresh = max (FlightSize / 2, 2*SMSS) referring to rfc5681
+           * cwnd=ssthresh + 3*SMSS  referring to rfc5681
+           */
+
+          if (conn->flags & TCP_INFT)
+            {
+              tcp_cc_update(conn, NULL);
+            }
+#endif
+        }
+#endif
+
       /* A special case is the head of the write_q which may be partially
        * sent and so can still have un-ACKed bytes that could get ACKed
        * before the entire write buffer has even been sent.
@@ -802,70 +998,6 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
     }
 #endif
 
-#ifdef CONFIG_NET_TCP_SELECTIVE_ACK
-
-  /* Check if we are being asked to retransmit s-ack data */
-
-  if (nsacks > 0)
-    {
-      FAR struct tcp_wrbuffer_s *wrb;
-      FAR sq_entry_t *entry;
-      FAR sq_entry_t *next;
-      uint32_t right;
-      int i;
-
-      /* Dump s-ack edge */
-
-      for (i = 0, right = 0; i < nsacks; i++)
-        {
-          ninfo("TCP SACK [%d]"
-                "[%" PRIu32 " : %" PRIu32 " : %" PRIu32 "]\n",
-                i, ofosegs[i].left, ofosegs[i].right,
-                TCP_SEQ_SUB(ofosegs[i].right, ofosegs[i].left));
-        }
-
-      for (entry = sq_peek(&conn->unacked_q); entry; entry = next)
-        {
-          wrb  = (FAR struct tcp_wrbuffer_s *)entry;
-          next = sq_next(entry);
-
-          for (i = 0, right = 0; i < nsacks; i++)
-            {
-              /* Wrb seqno out of s-ack edge ? do retransmit ! */
-
-              if (TCP_SEQ_LT(TCP_WBSEQNO(wrb), ofosegs[i].left) &&
-                  TCP_SEQ_GTE(TCP_WBSEQNO(wrb), right))
-                {
-                  ninfo("TCP REXMIT "
-                        "[%" PRIu32 " : %" PRIu32 " : %d]\n",
-                        TCP_WBSEQNO(wrb),
-                        TCP_SEQ_ADD(TCP_WBSEQNO(wrb), TCP_WBPKTLEN(wrb)),
-                        TCP_WBPKTLEN(wrb));
-                  sq_rem(entry, &conn->unacked_q);
-                  retransmit_segment(conn, (FAR void *)entry);
-                  break;
-                }
-
-              right = ofosegs[i].right;
-            }
-        }
-
-#ifdef CONFIG_NET_TCP_CC_NEWRENO
-          /* After Fast retransmitted, set ssthresh to the maximum of
-           * the unacked and the 2*SMSS, and enter to Fast Recovery.
-           * ssthresh = max (FlightSize / 2, 2*SMSS) referring to rfc5681
-           * cwnd=ssthresh + 3*SMSS  referring to rfc5681
-           */
-
-          if (conn->flags & TCP_INFT)
-            {
-              tcp_cc_update(conn, NULL);
-            }
-#endif
-    }
-  else
-#endif
-
   /* Check if we are being asked to retransmit data */
 
   if ((flags & TCP_REXMIT) != 0)
@@ -875,6 +1007,12 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
       ninfo("REXMIT: %04x\n", flags);
 
+#ifdef CONFIG_NET_TCP_SELECTIVE_ACK
+      /* A timeout ends the SACK recovery, all the data is sent again */
+
+      conn->flags &= ~TCP_SACK_RECOVERY;
+#endif
+
       /* If there is a partially sent write buffer at the head of the
        * write_q?  Has anything been sent from that write buffer?
        */
@@ -903,6 +1041,7 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
               /* And return the write buffer to the free list */
 
+              tcp_zerocopy_release(conn, wrb);
               tcp_wrbuffer_release(wrb);
 
               /* Notify any waiters if the write buffers have been
@@ -1041,9 +1180,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           int ret;
 
           sndlen = TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
-          if (sndlen > conn->mss)
+          if (sndlen > psock_send_maxlen(dev, conn))
             {
-              sndlen = conn->mss;
+              sndlen = psock_send_maxlen(dev, conn);
             }
 
           remaining_snd_wnd = TCP_SEQ_SUB(snd_wnd_edge, seq);
@@ -1107,10 +1246,19 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
             }
 #endif
 
+#ifdef CONFIG_NETDEV_GSO
+          /* More than a segment is a super-segment for the driver */
+
+          dev->d_gsosize = sndlen > conn->mss ? conn->mss : 0;
+#endif
+
           ret = devif_iob_send(dev, TCP_WBIOB(wrb), sndlen,
                                TCP_WBSENT(wrb), tcpip_hdrsize(conn));
           if (ret <= 0)
             {
+#ifdef CONFIG_NETDEV_GSO
+              dev->d_gsosize = 0;
+#endif
               return flags;
             }
 
@@ -1321,6 +1469,9 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
   bool       nonblock;
   int        ret = OK;
   clock_t    start;
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  bool       zerocopy;
+#endif
 
   if (psock == NULL || psock->s_type != SOCK_STREAM ||
       psock->s_conn == NULL)
@@ -1375,6 +1526,13 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
   start    = clock_systime_ticks();
   timeout  = _SO_TIMEOUT(conn->sconn.s_sndtimeo);
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  /* The data of a MSG_ZEROCOPY send is referenced until it is ACKed */
+
+  zerocopy = (flags & MSG_ZEROCOPY) != 0 &&
+             _SO_GETOPT(conn->sconn.s_options, SO_ZEROCOPY);
+#endif
+
   /* Dump the incoming buffer */
 
   BUF_DUMP("psock_tcp_send", buf, len);
@@ -1547,7 +1705,17 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
            * remaining data.
            */
 
-          chunk_result = TCP_WBTRYCOPYIN(wrb, cp, chunk_len, off);
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+          if (zerocopy)
+            {
+              chunk_result = tcp_zerocopy_attach(conn, wrb, cp, chunk_len);
+            }
+          else
+#endif
+            {
+              chunk_result = TCP_WBTRYCOPYIN(wrb, cp, chunk_len, off);
+            }
+
           if (chunk_result == -ENOMEM)
             {
               if (TCP_WBPKTLEN(wrb) > 0)
@@ -1672,11 +1840,27 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
       goto errout;
     }
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  if (zerocopy && result > 0)
+    {
+      net_lock();
+      tcp_zerocopy_sent(conn);
+      net_unlock();
+    }
+#endif
+
   /* Return the number of bytes actually sent */
 
   return result;
 
 errout_with_lock:
+#ifdef CONFIG_NET_TCP_ZEROCOPY
+  if (zerocopy && result > 0)
+    {
+      tcp_zerocopy_sent(conn);
+    }
+#endif
+
   net_unlock();
 
 errout:
@@ -260,6 +260,16 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
           }
         break;
 
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+      case TCP_CONGESTION: /* The congestion control algorithm */
+        ret = tcp_cc_select(conn, value, value_len);
+        if (ret < 0)
+          {
+            nerr("ERROR: Unknown congestion control algorithm\n");
+          }
+        break;
+#endif
+
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
         ret = -ENOPROTOOPT;
@@ -599,7 +599,21 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
 
               /* Exponential backoff. */
 
-              conn->timer = TCP_RTO << (conn->nrtx > 4 ? 4: conn->nrtx);
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+              if ((conn->flags & TCP_TSTAMP) != 0)
+                {
+                  /* From the RTO measured with the timestamps */
+
+                  conn->timer = MIN(conn->rto <<
+                                    (conn->nrtx > 4 ? 4 : conn->nrtx),
+                                    TCP_RTO_MAX);
+                }
+              else
+#endif
+                {
+                  conn->timer = TCP_RTO << (conn->nrtx > 4 ? 4: conn->nrtx);
+                }
+
               conn->nrtx++;
 
               /* Ok, so we need to retransmit. We do this differently
@@ -611,7 +625,7 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
                */
 
 #ifdef CONFIG_NET_STATISTICS
-              g_netstats.tcp.rexmit++;
+              NET_STATS(tcp.rexmit)++;
 #endif
               switch (conn->tcpstateflags & TCP_STATE_MASK)
                 {
@@ -652,22 +666,9 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
                     tcp_rexmit(dev, conn, result);
 
 #ifdef CONFIG_NET_TCP_CC_NEWRENO
-                    /* If conn is TCP_INFR, it should enter to slow start */
-
-                    if (conn->flags & TCP_INFR)
-                      {
-                        conn->flags &= ~TCP_INFR;
-                      }
-
-                    /* update the max_cwnd */
-
-                    conn->max_cwnd = (conn->max_cwnd + 7 * conn->cwnd) >> 3;
-
-                    /* reset cwnd and ssthresh, refers to RFC5861. */
+                    /* Enter the slow start again */
 
-                    conn->ssthresh =
-                                    MAX(conn->tx_unacked / 2, 2 * conn->mss);
-                    conn->cwnd = conn->mss;
+                    tcp_cc_timeout(conn);
 #endif
                     goto done;
 
@@ -0,0 +1,260 @@
+/****************************************************************************
+ * net/tcp/tcp_zerocopy.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <netinet/in.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+
+#include "netdev/netdev.h"
+#include "tcp/tcp.h"
+#include "utils/utils.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_zerocopy_free
+ *
+ * Description:
+ *   The data of the IOBs built by tcp_zerocopy_attach() belongs to the
+ *   caller of send(), it is not freed with them.
+ *
+ ****************************************************************************/
+
+static void tcp_zerocopy_free(FAR void *data)
+{
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_zerocopy_attach
+ *
+ * Description:
+ *   Append IOBs that refer to the data of a MSG_ZEROCOPY send to a write
+ *   buffer, instead of copying the data.  The write buffer is marked to
+ *   hold the data of the send numbered conn->zc_next.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of the write buffer
+ *   wrb  - The write buffer
+ *   buf  - The data to send
+ *   len  - The length of the data
+ *
+ * Returned Value:
+ *   'len' if all of the data is attached, -ENOMEM otherwise:  The data
+ *   attached is then in TCP_WBPKTLEN(wrb).
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+ssize_t tcp_zerocopy_attach(FAR struct tcp_conn_s *conn,
+                            FAR struct tcp_wrbuffer_s *wrb,
+                            FAR const uint8_t *buf, size_t len)
+{
+  FAR struct iob_s *iob;
+  size_t seglen;
+  size_t n = 0;
+
+  while (n < len)
+    {
+      seglen = MIN(len - n, UINT16_MAX);
+      iob    = iob_alloc_with_data((FAR uint8_t *)buf + n, seglen,
+                                   tcp_zerocopy_free);
+      if (iob == NULL)
+        {
+          break;
+        }
+
+      iob->io_len    = seglen;
+      iob->io_pktlen = seglen;
+
+      /* The first, empty IOB of a new write buffer is replaced */
+
+      if (TCP_WBPKTLEN(wrb) == 0)
+        {
+          iob_free_chain(TCP_WBIOB(wrb));
+          TCP_WBIOB(wrb) = iob;
+        }
+      else
+        {
+          iob_concat(TCP_WBIOB(wrb), iob);
+        }
+
+      n += seglen;
+    }
+
+  if (n > 0)
+    {
+      if (!wrb->wb_zc)
+        {
+          wrb->wb_zc = true;
+          conn->zc_nwrbs++;
+        }
+
+      wrb->wb_zcend = conn->zc_next + 1;
+    }
+
+  return n < len ? -ENOMEM : (ssize_t)len;
+}
+
+/****************************************************************************
+ * Name: tcp_zerocopy_sent
+ *
+ * Description:
+ *   Close the MSG_ZEROCOPY send numbered conn->zc_next once all of its data
+ *   is queued.  The send is complete at once if its data was all released
+ *   meanwhile.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_zerocopy_sent(FAR struct tcp_conn_s *conn)
+{
+  conn->zc_next++;
+  if (conn->zc_nwrbs == 0)
+    {
+      conn->zc_done = conn->zc_next;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_zerocopy_release
+ *
+ * Description:
+ *   Account for a write buffer about to be released:  The MSG_ZEROCOPY
+ *   sends whose data was all in the write buffers released so far are
+ *   complete.  The write buffers are released in order.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_zerocopy_release(FAR struct tcp_conn_s *conn,
+                          FAR struct tcp_wrbuffer_s *wrb)
+{
+  uint32_t done;
+
+  if (!wrb->wb_zc)
+    {
+      return;
+    }
+
+  wrb->wb_zc = false;
+  conn->zc_nwrbs--;
+
+  /* A send still being queued is not complete */
+
+  if (conn->zc_nwrbs == 0 || (int32_t)(wrb->wb_zcend - conn->zc_next) > 0)
+    {
+      done = conn->zc_next;
+    }
+  else
+    {
+      done = wrb->wb_zcend;
+    }
+
+  if ((int32_t)(done - conn->zc_done) > 0)
+    {
+      conn->zc_done = done;
+
+      /* Poll the device soon, the poll callbacks then report POLLERR */
+
+      netdev_txnotify_dev(conn->dev);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_zerocopy_recverr
+ *
+ * Description:
+ *   Return the completions of the MSG_ZEROCOPY sends not returned yet, in
+ *   a single sock_extended_err control message (recvmsg() with
+ *   MSG_ERRQUEUE).
+ *
+ * Returned Value:
+ *   Zero (OK) on success, -EAGAIN if no send completed since the last
+ *   call.  MSG_CTRUNC is set in msg_flags if the control message does not
+ *   fit, the completions are then returned by the next call.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+ssize_t tcp_zerocopy_recverr(FAR struct tcp_conn_s *conn,
+                             FAR struct msghdr *msg)
+{
+  struct sock_extended_err ee;
+  int level = SOL_IP;
+  int type = IP_RECVERR;
+
+  if (!tcp_zerocopy_pending(conn))
+    {
+      return -EAGAIN;
+    }
+
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET6)
+    {
+      level = SOL_IPV6;
+      type  = IPV6_RECVERR;
+    }
+#endif
+
+  memset(&ee, 0, sizeof(ee));
+  ee.ee_origin = SO_EE_ORIGIN_ZEROCOPY;
+  ee.ee_info   = conn->zc_notified;
+  ee.ee_data   = conn->zc_done - 1;
+
+  if (cmsg_append(msg, level, type, &ee, sizeof(ee)) == NULL)
+    {
+      msg->msg_flags |= MSG_CTRUNC;
+      return OK;
+    }
+
+  conn->zc_notified = conn->zc_done;
+  msg->msg_flags   |= MSG_ERRQUEUE;
+  return OK;
+}
@@ -32,6 +32,7 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 
+#include <nuttx/hashtable.h>
 #include <nuttx/queue.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/net/ip.h>
@@ -70,8 +71,10 @@
 /* Definitions for the UDP connection struct flag field */
 
 #define _UDP_FLAG_CONNECTMODE (1 << 0) /* Bit 0:  UDP connection-mode */
+#define _UDP_FLAG_GRO         (1 << 1) /* Bit 1:  UDP_GRO is enabled */
 
 #define _UDP_ISCONNECTMODE(f) (((f) & _UDP_FLAG_CONNECTMODE) != 0)
+#define _UDP_ISGRO(f)         (((f) & _UDP_FLAG_GRO) != 0)
 
 /* This is a helper pointer for accessing the contents of the udp header */
 
@@ -113,6 +116,9 @@ struct udp_conn_s
   union ip_binding_u u;   /* IP address binding */
   uint16_t lport;         /* Bound local port number (network byte order) */
   uint16_t rport;         /* Remote port number (network byte order) */
+#if CONFIG_NET_UDP_HASH_BITS > 0
+  hash_node_t pnode;      /* In the table of the connections by port */
+#endif
   uint8_t  flags;         /* See _UDP_FLAG_* definitions */
   uint8_t  domain;        /* IP domain: PF_INET or PF_INET6 */
   uint8_t  crefs;         /* Reference counts on this instance */
@@ -162,6 +168,10 @@ struct udp_conn_s
 #ifdef CONFIG_NET_TIMESTAMP
   int timestamp; /* Nonzero when SO_TIMESTAMP is enabled */
 #endif
+
+#ifdef CONFIG_NET_UDP_GSO
+  uint16_t gsosize;              /* UDP_SEGMENT, 0 if disabled */
+#endif
 };
 
 /* This structure supports UDP write buffering.  It is simply a container
@@ -174,6 +184,10 @@ struct udp_wrbuffer_s
   sq_entry_t wb_node;              /* Supports a singly linked list */
   struct sockaddr_storage wb_dest; /* Destination address */
   FAR struct iob_s *wb_iob;        /* Head of the I/O buffer chain */
+#ifdef CONFIG_NET_UDP_GSO
+  uint16_t wb_gsosize;             /* Segment size, 0 for one datagram */
+  uint16_t wb_offset;              /* Payload of the segments sent */
+#endif
 };
 #endif
 
@@ -282,6 +296,22 @@ FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn);
 
 uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u);
 
+/****************************************************************************
+ * Name: udp_setport
+ *
+ * Description:
+ *   Set the local port number of a connection, in network byte order, and
+ *   move the connection to the bucket of the port in the port table.  Zero
+ *   unbinds the connection.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_UDP_HASH_BITS > 0
+void udp_setport(FAR struct udp_conn_s *conn, uint16_t portno);
+#else
+#  define udp_setport(conn, portno) ((conn)->lport = (portno))
+#endif
+
 /****************************************************************************
  * Name: udp_bind
  *
@@ -83,7 +83,7 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
     {
       netdev_iob_release(dev);
 #ifdef CONFIG_NET_STATISTICS
-      g_netstats.udp.drop++;
+      NET_STATS(udp.drop)++;
 #endif
       return 0;
     }
@@ -277,7 +277,7 @@ net_dataevent(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
      ninfo("Dropped %d bytes\n", dev->d_len);
 
 #ifdef CONFIG_NET_STATISTICS
-      g_netstats.udp.drop++;
+      NET_STATS(udp.drop)++;
 #endif
     }
 
@@ -93,10 +93,43 @@ static mutex_t g_free_lock = NXMUTEX_INITIALIZER;
 
 static dq_queue_t g_active_udp_connections;
 
+/* The UDP connections bound to a local port, by port */
+
+#if CONFIG_NET_UDP_HASH_BITS > 0
+static DECLARE_HASHTABLE(g_udp_port_table, CONFIG_NET_UDP_HASH_BITS);
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: udp_hashport
+ *
+ * Description:
+ *   Return the connection of an entry of the port table, or NULL at the end
+ *   of a bucket.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_UDP_HASH_BITS > 0
+static inline FAR struct udp_conn_s *udp_hashport(FAR hash_node_t *node)
+{
+  return node != NULL ? container_of(node, struct udp_conn_s, pnode) : NULL;
+}
+
+/* The connections that may be bound to a given local port:  Those of a
+ * bucket of the port table, or all of them without the table.
+ */
+
+#  define udp_firstport(port) \
+     udp_hashport(hashtable_bucket(g_udp_port_table, port)->head)
+#  define udp_nextport(conn)  udp_hashport((conn)->pnode.flink)
+#else
+#  define udp_firstport(port) udp_nextconn(NULL)
+#  define udp_nextport(conn)  udp_nextconn(conn)
+#endif
+
 /****************************************************************************
  * Name: udp_find_conn()
  *
@@ -119,14 +152,15 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
                                             FAR union ip_binding_u *ipaddr,
                                             uint16_t portno, sockopt_t opt)
 {
-  FAR struct udp_conn_s *conn = NULL;
+  FAR struct udp_conn_s *conn;
 #ifdef CONFIG_NET_SOCKOPTS
   bool skip_reusable = _SO_GETOPT(opt, SO_REUSEADDR);
 #endif
 
   /* Now search each connection structure. */
 
-  while ((conn = udp_nextconn(conn)) != NULL)
+  for (conn = udp_firstport(portno); conn != NULL;
+       conn = udp_nextport(conn))
     {
       /* With SO_REUSEADDR set for both sockets, we do not need to check its
        * address and port.
@@ -199,7 +233,7 @@ udp_ipv4_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 #endif
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
 
-  conn = udp_nextconn(conn);
+  conn = conn == NULL ? udp_firstport(udp->destport) : udp_nextport(conn);
 
   while (conn)
     {
@@ -313,7 +347,7 @@ udp_ipv4_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 
       /* Look at the next active connection */
 
-      conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+      conn = udp_nextport(conn);
     }
 
   return conn;
@@ -339,7 +373,7 @@ udp_ipv6_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 {
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
 
-  conn = udp_nextconn(conn);
+  conn = conn == NULL ? udp_firstport(udp->destport) : udp_nextport(conn);
 
   while (conn != NULL)
     {
@@ -453,7 +487,7 @@ udp_ipv6_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 
       /* Look at the next active connection */
 
-      conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+      conn = udp_nextport(conn);
     }
 
   return conn;
@@ -582,6 +616,38 @@ errout:
   return portno;
 }
 
+/****************************************************************************
+ * Name: udp_setport
+ *
+ * Description:
+ *   Set the local port number of a connection, in network byte order, and
+ *   move the connection to the bucket of the port in the port table.  Zero
+ *   unbinds the connection.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_UDP_HASH_BITS > 0
+void udp_setport(FAR struct udp_conn_s *conn, uint16_t portno)
+{
+  /* The table is searched by the network with the network locked */
+
+  net_lock();
+
+  if (conn->lport != 0)
+    {
+      hashtable_delete(g_udp_port_table, &conn->pnode, conn->lport);
+    }
+
+  if (portno != 0)
+    {
+      hashtable_add(g_udp_port_table, &conn->pnode, portno);
+    }
+
+  conn->lport = portno;
+  net_unlock();
+}
+#endif
+
 /****************************************************************************
  * Name: udp_initialize
  *
@@ -655,6 +721,9 @@ FAR struct udp_conn_s *udp_alloc(uint8_t domain)
       /* Initialize the write buffer lists */
 
       sq_init(&conn->write_q);
+#endif
+#ifdef CONFIG_NET_UDP_GSO
+      conn->gsosize     = 0;
 #endif
       /* Enqueue the connection into the active list */
 
@@ -684,8 +753,8 @@ void udp_free(FAR struct udp_conn_s *conn)
 
   DEBUGASSERT(conn->crefs == 0);
 
+  udp_setport(conn, 0);
   nxmutex_lock(&g_free_lock);
-  conn->lport = 0;
 
   /* Remove the connection from the active list */
 
@@ -928,7 +997,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         }
       else
         {
-          conn->lport = portno;
+          udp_setport(conn, portno);
           ret         = OK;
         }
     }
@@ -953,7 +1022,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         {
           /* No.. then bind the socket to the port */
 
-          conn->lport = portno;
+          udp_setport(conn, portno);
           ret         = OK;
         }
       else
@@ -1005,7 +1074,7 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
+      udp_setport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
       if (!conn->lport)
         {
           nerr("ERROR: Failed to get a local port!\n");
@@ -223,7 +223,7 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
   /* Update the count of UDP packets received */
 
 #ifdef CONFIG_NET_STATISTICS
-  g_netstats.udp.recv++;
+  NET_STATS(udp.recv)++;
 #endif
 
   /* Get a pointer to the UDP header.  The UDP header lies just after the
@@ -246,7 +246,11 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
 
 #ifdef CONFIG_NET_UDP_CHECKSUMS
   chksum = udp->udpchksum;
-  if (chksum != 0)
+  if (chksum != 0 && net_chksum_verified(dev))
+    {
+      chksum = 0;
+    }
+  else if (chksum != 0)
     {
 #ifdef CONFIG_NET_IPv6
 #ifdef CONFIG_NET_IPv4
@@ -270,8 +274,8 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
   if (chksum != 0)
     {
 #ifdef CONFIG_NET_STATISTICS
-      g_netstats.udp.drop++;
-      g_netstats.udp.chkerr++;
+      NET_STATS(udp.drop)++;
+      NET_STATS(udp.chkerr)++;
 #endif
       nwarn("WARNING: Bad UDP checksum\n");
       dev->d_len = 0;
@@ -404,6 +408,8 @@ int udp_ipv4_input(FAR struct net_driver_s *dev)
 {
   FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
   uint16_t iphdrlen;
+  int ret;
+  NET_LAYER_START(start);
 
   /* Configure to receive an UDP IPv4 packet */
 
@@ -415,7 +421,9 @@ int udp_ipv4_input(FAR struct net_driver_s *dev)
 
   /* Then process in the UDP IPv4 input */
 
-  return udp_input(dev, iphdrlen);
+  ret = udp_input(dev, iphdrlen);
+  NET_LAYER_STOP(NET_LAYER_UDP, start);
+  return ret;
 }
 #endif
 
@@ -444,13 +452,18 @@ int udp_ipv4_input(FAR struct net_driver_s *dev)
 #ifdef CONFIG_NET_IPv6
 int udp_ipv6_input(FAR struct net_driver_s *dev, unsigned int iplen)
 {
+  int ret;
+  NET_LAYER_START(start);
+
   /* Configure to receive an UDP IPv6 packet */
 
   udp_ipv6_select(dev);
 
   /* Then process in the UDP IPv6 input */
 
-  return udp_input(dev, iplen);
+  ret = udp_input(dev, iplen);
+  NET_LAYER_STOP(NET_LAYER_UDP, start);
+  return ret;
 }
 #endif
 
@@ -41,6 +41,7 @@
 #include <nuttx/net/udp.h>
 #include <nuttx/tls.h>
 #include <netinet/in.h>
+#include <netinet/udp.h>
 
 #include "netdev/netdev.h"
 #include "devif/devif.h"
@@ -121,6 +122,105 @@ static void udp_recvpktinfo(FAR struct udp_recvfrom_s *pstate,
 #define udp_recvpktinfo(p, s, i) {(void)(p); (void)(s); (void)(i);}
 #endif
 
+/****************************************************************************
+ * Name: udp_readahead_gro
+ *
+ * Description:
+ *   Coalesce the datagrams that follow the one just copied to the user
+ *   buffer in the read-ahead buffers (UDP_GRO):  The datagrams from the
+ *   same sender and of the same size are appended to the data while they
+ *   fit in the buffer, a shorter one ends the run.  The size of the
+ *   datagrams is returned in a UDP_GRO control message.
+ *
+ * Input Parameters:
+ *   pstate        recvfrom state structure
+ *   iob           The read-ahead buffers
+ *   offset        The offset of the datagram following the one copied
+ *   segsize       The size of the datagram copied
+ *   srcaddr       The address of its sender
+ *   src_addr_size The size of srcaddr
+ *   ifindex       The device that received it
+ *
+ * Returned Value:
+ *   The offset of the first datagram that is not coalesced.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_GRO
+static unsigned int udp_readahead_gro(FAR struct udp_recvfrom_s *pstate,
+                                      FAR struct iob_s *iob,
+                                      unsigned int offset,
+                                      uint16_t segsize,
+                                      FAR const uint8_t *srcaddr,
+                                      uint8_t src_addr_size,
+                                      uint8_t ifindex)
+{
+  FAR uint8_t *buffer = pstate->ir_msg->msg_iov->iov_base;
+  size_t buflen = pstate->ir_msg->msg_iov->iov_len;
+#ifdef CONFIG_NET_IPv6
+  uint8_t addr[sizeof(struct sockaddr_in6)];
+#else
+  uint8_t addr[sizeof(struct sockaddr_in)];
+#endif
+  unsigned int next;
+  uint16_t datalen = segsize;
+  uint8_t addr_size;
+  uint8_t index = 1;
+  int nsegs = 1;
+  int gsosize;
+
+  while (datalen == segsize && offset < iob->io_pktlen)
+    {
+      /* The header of the next datagram, as in udp_readahead() */
+
+      next = offset;
+      iob_copyout((FAR uint8_t *)&datalen, iob, sizeof(datalen), next);
+      next += sizeof(datalen);
+#ifdef CONFIG_NETDEV_IFINDEX
+      iob_copyout(&index, iob, sizeof(index), next);
+      next += sizeof(index);
+#endif
+      iob_copyout(&addr_size, iob, sizeof(addr_size), next);
+      next += sizeof(addr_size);
+
+      if (index != ifindex || addr_size != src_addr_size ||
+          datalen > segsize || datalen == 0 ||
+          pstate->ir_recvlen + datalen > buflen)
+        {
+          break;
+        }
+
+      iob_copyout(addr, iob, addr_size, next);
+      next += addr_size;
+      if (memcmp(addr, srcaddr, addr_size) != 0)
+        {
+          break;
+        }
+
+#ifdef CONFIG_NET_TIMESTAMP
+      next += sizeof(struct timespec);
+#endif
+
+      pstate->ir_recvlen += iob_copyout(buffer + pstate->ir_recvlen, iob,
+                                        datalen, next);
+      offset = next + datalen;
+      nsegs++;
+    }
+
+  if (nsegs > 1)
+    {
+      gsosize = segsize;
+      cmsg_append(pstate->ir_msg, SOL_UDP, UDP_GRO,
+                  &gsosize, sizeof(gsosize));
+    }
+
+  return offset;
+}
+#endif
+
 /****************************************************************************
  * Name: udp_recvfrom_newdata
  *
@@ -264,6 +364,16 @@ static inline void udp_readahead(struct udp_recvfrom_s *pstate)
 
       if (!(pstate->ir_flags & MSG_PEEK))
         {
+#ifdef CONFIG_NET_UDP_GRO
+          if (_UDP_ISGRO(conn->flags) && recvlen == datalen)
+            {
+              offset = udp_readahead_gro(pstate, iob, offset + datalen,
+                                         datalen, srcaddr, src_addr_size,
+                                         ifindex);
+              datalen = 0;
+            }
+#endif
+
           if (offset + datalen >= iob->io_pktlen)
             {
               iob_free_chain(iob);
@@ -760,6 +870,18 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
           info.sem = &state.ir_sem;
           tls_cleanup_push(tls_get_info(), udp_callback_cleanup, &info);
 
+#ifdef CONFIG_NET_BUSYPOLL
+          /* Spin on the RX of the device first, or of all the devices if
+           * the local address of the socket is not bound to one.
+           */
+
+          if (conn->sconn.s_busypoll > 0)
+            {
+              netdev_busypoll(dev, conn->sconn.s_busypoll,
+                              netdev_busypoll_sem, &state.ir_sem);
+            }
+#endif
+
           /* Wait for either the receive to complete or for an error/timeout
            * to occur.  net_sem_timedwait will also terminate if a signal is
            * received.
@@ -190,7 +190,7 @@ void udp_send(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn)
                             conn->sconn.s_tos, NULL);
 
 #ifdef CONFIG_NET_STATISTICS
-          g_netstats.ipv4.sent++;
+          NET_STATS(ipv4.sent)++;
 #endif
         }
 #endif /* CONFIG_NET_IPv4 */
@@ -231,7 +231,7 @@ void udp_send(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn)
           dev->d_len       += IPv6_HDRLEN;
 
 #ifdef CONFIG_NET_STATISTICS
-          g_netstats.ipv6.sent++;
+          NET_STATS(ipv6.sent)++;
 #endif
         }
 #endif /* CONFIG_NET_IPv6 */
@@ -248,36 +248,29 @@ void udp_send(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn)
       iob_update_pktlen(dev->d_iob, dev->d_len, false);
 
 #ifdef CONFIG_NET_UDP_CHECKSUMS
-      /* Calculate UDP checksum. */
-
-#ifdef CONFIG_NET_IPv4
-#ifdef CONFIG_NET_IPv6
-      if (IFF_IS_IPv4(dev->d_flags))
-#endif
-        {
-          udp->udpchksum = ~udp_ipv4_chksum(dev);
-        }
-#endif /* CONFIG_NET_IPv4 */
-
-#ifdef CONFIG_NET_IPv6
-#ifdef CONFIG_NET_IPv4
-      else
-#endif
+      /* Calculate UDP checksum, unless the device does it.  The checksums
+       * of the datagrams of a super-datagram are calculated when it is
+       * segmented.
+       */
+
+      if (!NETDEV_GSO_PENDING(dev) &&
+          !net_chksum_offload(dev, IP_PROTO_UDP,
+                              (FAR uint8_t *)udp -
+                              (FAR uint8_t *)IPBUF(0),
+                              &udp->udpchksum))
         {
-          udp->udpchksum = ~udp_ipv6_chksum(dev);
-        }
-#endif /* CONFIG_NET_IPv6 */
-
-      if (udp->udpchksum == 0)
-        {
-          udp->udpchksum = 0xffff;
+          udp->udpchksum = ~udp_send_chksum(dev);
+          if (udp->udpchksum == 0)
+            {
+              udp->udpchksum = 0xffff;
+            }
         }
 #endif /* CONFIG_NET_UDP_CHECKSUMS */
 
       ninfo("Outgoing UDP packet length: %d\n", dev->d_len);
 
 #ifdef CONFIG_NET_STATISTICS
-      g_netstats.udp.sent++;
+      NET_STATS(udp.sent)++;
 #endif
 
 #ifdef CONFIG_NET_SOCKOPTS
@@ -258,7 +258,7 @@ static int sendto_next_transfer(FAR struct udp_conn_s *conn)
        * connection structure.
        */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
+      udp_setport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
       if (!conn->lport)
         {
           nerr("ERROR: Failed to get a local port!\n");
@@ -344,6 +344,88 @@ static int sendto_next_transfer(FAR struct udp_conn_s *conn)
   return OK;
 }
 
+/****************************************************************************
+ * Name: sendto_segment
+ *
+ * Description:
+ *   Prepare the next datagram of a write buffer with a segment size
+ *   (UDP_SEGMENT).  The whole write buffer is sent as a super-datagram if
+ *   the device segments it (NETDEV_GSO), one datagram is copied from it
+ *   otherwise.
+ *
+ * Input Parameters:
+ *   dev      The structure of the network driver that caused the event
+ *   conn     The connection structure associated with the socket
+ *   wrb      The write buffer at the head of the write queue
+ *   udpiplen The size of the IP and UDP headers
+ *
+ * Returned Value:
+ *   True if a datagram was copied to the device buffer (or the write
+ *   buffer was dropped), false if the write buffer is to be sent as a
+ *   whole.
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_GSO
+static bool sendto_segment(FAR struct net_driver_s *dev,
+                           FAR struct udp_conn_s *conn,
+                           FAR struct udp_wrbuffer_s *wrb,
+                           uint16_t udpiplen)
+{
+  unsigned int paylen = wrb->wb_iob->io_pktlen - udpiplen;
+  unsigned int seglen;
+  int ret;
+
+#ifdef CONFIG_NETDEV_GSO
+  /* The upper half only segments the packets larger than the MTU, into
+   * datagrams that must fit in the MTU.
+   */
+
+  if (wrb->wb_offset == 0 && wrb->wb_iob->io_pktlen <= dev->d_gsomax &&
+      wrb->wb_iob->io_pktlen > NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev) &&
+      wrb->wb_gsosize + udpiplen <=
+      NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev))
+    {
+      dev->d_gsosize = wrb->wb_gsosize;
+      return false;
+    }
+#endif
+
+  seglen = MIN(wrb->wb_gsosize, paylen - wrb->wb_offset);
+  ret    = devif_iob_send(dev, wrb->wb_iob, seglen,
+                          udpiplen + wrb->wb_offset, udpiplen);
+  if (ret == -ENOMEM)
+    {
+      /* Try again on the next poll */
+
+      return true;
+    }
+
+  if (ret < 0)
+    {
+      nerr("ERROR: Dropped a segmented write buffer: %d\n", ret);
+      dev->d_sndlen = 0;
+      sendto_writebuffer_release(conn);
+      return true;
+    }
+
+  /* The write buffer stays at the head of the queue until its last
+   * segment is sent.
+   */
+
+  wrb->wb_offset += seglen;
+  if (wrb->wb_offset >= paylen)
+    {
+      sendto_writebuffer_release(conn);
+    }
+
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Name: sendto_eventhandler
  *
@@ -436,6 +518,17 @@ static uint16_t sendto_eventhandler(FAR struct net_driver_s *dev,
 
       udp_connect(conn, (FAR const struct sockaddr *)&wrb->wb_dest);
 
+#ifdef CONFIG_NET_UDP_GSO
+      if (wrb->wb_gsosize > 0 && sendto_segment(dev, conn, wrb, udpiplen))
+        {
+#ifdef NEED_IPDOMAIN_SUPPORT
+          sendto_ipselect(dev, conn);
+#endif
+          flags &= ~UDP_POLL;
+          return flags;
+        }
+#endif
+
       /* Then set-up to send that amount of data with the offset
        * corresponding to the size of the IP-dependent address structure.
        */
@@ -806,6 +899,15 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
           udp_connect(conn, to);
         }
 
+#ifdef CONFIG_NET_UDP_GSO
+      /* A send larger than the segment size is split into datagrams of
+       * that size when it is transmitted.
+       */
+
+      wrb->wb_gsosize = len > conn->gsosize ? conn->gsosize : 0;
+      wrb->wb_offset  = 0;
+#endif
+
       /* Skip l2/l3/l4 offset before copy */
 
       udpiplen = udpip_hdrsize(conn);
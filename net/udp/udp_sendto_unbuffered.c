@@ -197,8 +197,9 @@ static uint16_t sendto_eventhandler(FAR struct net_driver_s *dev,
         {
           /* Copy the user data into d_appdata and send it */
 
-          int ret = devif_send(dev, pstate->st_buffer, pstate->st_buflen,
-                               udpip_hdrsize(pstate->st_conn));
+          int ret = devif_send_chksum(dev, pstate->st_buffer,
+                                      pstate->st_buflen,
+                                      udpip_hdrsize(pstate->st_conn));
           if (ret <= 0)
             {
               pstate->st_sndlen = ret;
@@ -76,7 +76,57 @@
 int udp_setsockopt(FAR struct socket *psock, int option,
                    FAR const void *value, socklen_t value_len)
 {
-  return -ENOPROTOOPT;
+  FAR struct udp_conn_s *conn = psock->s_conn;
+  int ret = OK;
+
+  DEBUGASSERT(psock != NULL && conn != NULL);
+
+  if (value == NULL || value_len != sizeof(int))
+    {
+      return -EINVAL;
+    }
+
+  net_lock();
+
+  switch (option)
+    {
+#ifdef CONFIG_NET_UDP_GSO
+      case UDP_SEGMENT:
+        {
+          int gsosize = *(FAR const int *)value;
+
+          if (gsosize < 0 || gsosize > UINT16_MAX)
+            {
+              ret = -EINVAL;
+            }
+          else
+            {
+              conn->gsosize = gsosize;
+            }
+        }
+        break;
+#endif
+
+#ifdef CONFIG_NET_UDP_GRO
+      case UDP_GRO:
+        if (*(FAR const int *)value != 0)
+          {
+            conn->flags |= _UDP_FLAG_GRO;
+          }
+        else
+          {
+            conn->flags &= ~_UDP_FLAG_GRO;
+          }
+        break;
+#endif
+
+      default:
+        ret = -ENOPROTOOPT;
+        break;
+    }
+
+  net_unlock();
+  return ret;
 }
 
 #endif /* CONFIG_NET_UDPPROTO_OPTIONS */
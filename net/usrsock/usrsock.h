@@ -110,6 +110,10 @@ struct usrsock_conn_s
    */
 
   struct usrsock_poll_s pollinfo[CONFIG_NET_USRSOCK_NPOLLWAITERS];
+
+#ifdef CONFIG_NET_USRSOCK_EVENT_COALESCE
+  uint16_t   pendevents;             /* Events not delivered yet */
+#endif
 };
 
 struct usrsock_reqstate_s
@@ -37,31 +37,58 @@
 #include <assert.h>
 #include <debug.h>
 
+#include <nuttx/nuttx.h>
 #include <nuttx/random.h>
 #include <nuttx/mutex.h>
+#include <nuttx/queue.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/usrsock.h>
 
 #include "usrsock/usrsock.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LPWORK
+#  define USRSOCK_WORK LPWORK
+#else
+#  define USRSOCK_WORK HPWORK
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* A request waiting for its acknowledgment, on the stack of
+ * usrsock_do_request()
+ */
+
+struct usrsock_ack_s
+{
+  dq_entry_t node;            /* In the list of ackwaiters */
+  uint32_t   xid;             /* Exchange id of the request */
+  sem_t      sem;             /* Acknowledgment notification */
+};
+
 struct usrsock_req_s
 {
-  mutex_t  lock;              /* Request mutex (only one outstanding
-                               * request) */
-  sem_t    acksem;            /* Request acknowledgment notification */
-  uint32_t newxid;            /* New transcation Id */
-  uint32_t ackxid;            /* Exchange id for which waiting ack */
-  uint16_t nbusy;             /* Number of requests blocked from different
-                               * threads */
+  mutex_t    lock;            /* Serializes the submission of requests */
+  sem_t      slotsem;         /* Counts the requests that may still be
+                               * outstanding */
+  uint32_t   newxid;          /* New transcation Id */
+  dq_queue_t ackwaiters;      /* Requests waiting for acknowledgment,
+                               * protected by the network lock */
 
   /* Connection instance to receive data buffers. */
 
   FAR struct usrsock_conn_s *datain_conn;
+
+#ifdef CONFIG_NET_USRSOCK_EVENT_COALESCE
+  struct work_s work;         /* Delivers the coalesced events */
+#endif
 };
 
 /****************************************************************************
@@ -76,10 +103,12 @@ struct usrsock_req_s
 static struct usrsock_req_s g_usrsock_req =
 {
   NXMUTEX_INITIALIZER,
-  SEM_INITIALIZER(0),
-  0,
-  0,
+  SEM_INITIALIZER(CONFIG_NET_USRSOCK_NREQUESTS),
   0,
+  {
+    NULL,
+    NULL
+  },
   NULL
 };
 
@@ -190,6 +219,50 @@ out:
   return total;
 }
 
+/****************************************************************************
+ * Name: usrsock_flush_events
+ *
+ * Description:
+ *   Deliver the coalesced events of a connection.  Called with the network
+ *   locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_USRSOCK_EVENT_COALESCE
+static void usrsock_flush_events(FAR struct usrsock_conn_s *conn)
+{
+  if (conn->pendevents != 0)
+    {
+      conn->resp.events = conn->pendevents;
+      conn->pendevents  = 0;
+      usrsock_event(conn);
+    }
+}
+
+/****************************************************************************
+ * Name: usrsock_event_worker
+ *
+ * Description:
+ *   Deliver the events coalesced since the worker was queued:  A burst of
+ *   poll state changes of a socket wakes up its waiters once.
+ *
+ ****************************************************************************/
+
+static void usrsock_event_worker(FAR void *arg)
+{
+  FAR struct usrsock_conn_s *conn = NULL;
+
+  net_lock();
+
+  while ((conn = usrsock_nextconn(conn)) != NULL)
+    {
+      usrsock_flush_events(conn);
+    }
+
+  net_unlock();
+}
+#endif
+
 /****************************************************************************
  * Name: usrsock_handle_event
  ****************************************************************************/
@@ -237,12 +310,28 @@ static ssize_t usrsock_handle_event(FAR const void *buffer, size_t len)
 
         /* Handle event. */
 
+#ifdef CONFIG_NET_USRSOCK_EVENT_COALESCE
+        /* Merge the event with those not delivered yet */
+
+        UNUSED(ret);
+
+        net_lock();
+        conn->pendevents |= hdr->head.events & ~USRSOCK_EVENT_INTERNAL_MASK;
+        if (work_available(&g_usrsock_req.work))
+          {
+            work_queue(USRSOCK_WORK, &g_usrsock_req.work,
+                       usrsock_event_worker, NULL, 0);
+          }
+
+        net_unlock();
+#else
         conn->resp.events = hdr->head.events & ~USRSOCK_EVENT_INTERNAL_MASK;
         ret = usrsock_event(conn);
         if (ret < 0)
           {
             return ret;
           }
+#endif
       }
       break;
 
@@ -436,6 +525,8 @@ static ssize_t usrsock_handle_req_response(FAR const void *buffer,
   FAR const struct usrsock_message_req_ack_s *hdr = buffer;
   FAR struct usrsock_conn_s *conn = NULL;
   FAR struct usrsock_req_s *req = &g_usrsock_req;
+  FAR struct usrsock_ack_s *ack;
+  FAR dq_entry_t *entry;
   ssize_t (*handle_response)(FAR struct usrsock_conn_s *conn,
                              FAR const void *buffer,
                              size_t len);
@@ -484,21 +575,32 @@ static ssize_t usrsock_handle_req_response(FAR const void *buffer,
       goto unlock_out;
     }
 
-  if (req->ackxid == hdr->xid)
+  for (entry = dq_peek(&req->ackwaiters); entry; entry = dq_next(entry))
     {
-      req->ackxid = 0;
-      if (req_done)
+      ack = container_of(entry, struct usrsock_ack_s, node);
+      if (ack->xid == hdr->xid)
         {
-          *req_done = true;
-        }
+          dq_rem(entry, &req->ackwaiters);
+          if (req_done)
+            {
+              *req_done = true;
+            }
 
-      /* Signal that request was received and read by daemon and
-       * acknowledgment response was received.
-       */
+          /* Signal that request was received and read by daemon and
+           * acknowledgment response was received.
+           */
 
-      nxsem_post(&req->acksem);
+          nxsem_post(&ack->sem);
+          break;
+        }
     }
 
+#ifdef CONFIG_NET_USRSOCK_EVENT_COALESCE
+  /* The events that came before the response are delivered first */
+
+  usrsock_flush_events(conn);
+#endif
+
   conn->resp.events = hdr->head.events | USRSOCK_EVENT_REQ_COMPLETE;
   ret = handle_response(conn, buffer, len);
 
@@ -642,12 +744,19 @@ int usrsock_do_request(FAR struct usrsock_conn_s *conn,
 {
   FAR struct usrsock_request_common_s *req_head = NULL;
   FAR struct usrsock_req_s *req = &g_usrsock_req;
+  struct usrsock_ack_s ack;
   int ret;
 
   /* Get exchange id. */
 
   req_head = iov[0].iov_base;
 
+  /* Wait for a free request line:  Up to CONFIG_NET_USRSOCK_NREQUESTS
+   * requests of different connections are outstanding at the same time.
+   */
+
+  net_sem_wait_uninterruptible(&req->slotsem);
+
   /* Set outstanding request for daemon to handle. */
 
   net_mutex_lock(&req->lock);
@@ -663,25 +772,41 @@ int usrsock_do_request(FAR struct usrsock_conn_s *conn,
   conn->resp.xid = req_head->xid;
   conn->resp.result = -EACCES;
 
-  req->ackxid = req_head->xid;
+  ack.xid = req_head->xid;
+  nxsem_init(&ack.sem, 0, 0);
+  dq_addlast(&ack.node, &req->ackwaiters); /* net_lock held. */
 
   ret = usrsock_request(iov, iovcnt);
+  nxmutex_unlock(&req->lock);
+
   if (ret >= 0)
     {
       /* Wait ack for request. */
 
-      ++req->nbusy; /* net_lock held. */
-      net_sem_wait_uninterruptible(&req->acksem);
-      --req->nbusy; /* net_lock held. */
+      net_sem_wait_uninterruptible(&ack.sem);
     }
   else
     {
+      FAR dq_entry_t *entry;
+
       nerr("error: usrsock request failed with %d\n", ret);
+
+      /* usrsock_abort() may have removed the request meanwhile */
+
+      for (entry = dq_peek(&req->ackwaiters); entry; entry = dq_next(entry))
+        {
+          if (entry == &ack.node)
+            {
+              dq_rem(entry, &req->ackwaiters);
+              break;
+            }
+        }
     }
 
   /* Free request line for next command. */
 
-  nxmutex_unlock(&req->lock);
+  nxsem_destroy(&ack.sem);
+  nxsem_post(&req->slotsem);
   return ret;
 }
 
@@ -693,7 +818,7 @@ void usrsock_abort(void)
 {
   FAR struct usrsock_req_s *req = &g_usrsock_req;
   FAR struct usrsock_conn_s *conn = NULL;
-  int ret;
+  FAR struct usrsock_ack_s *ack;
 
   net_lock();
 
@@ -701,42 +826,22 @@ void usrsock_abort(void)
 
   while ((conn = usrsock_nextconn(conn)) != NULL)
     {
+#ifdef CONFIG_NET_USRSOCK_EVENT_COALESCE
+      conn->pendevents = 0;
+#endif
       conn->resp.inprogress = false;
       conn->resp.xid = 0;
       conn->resp.events = USRSOCK_EVENT_ABORT;
       usrsock_event(conn);
     }
 
-  do
-    {
-      /* Give other threads short time window to complete recently completed
-       * requests.
-       */
-
-      ret = net_mutex_timedlock(&req->lock, 10);
-      if (ret < 0)
-        {
-          if (ret != -ETIMEDOUT && ret != -EINTR)
-            {
-              ninfo("net_sem_timedwait errno: %d\n", ret);
-              DEBUGASSERT(false);
-            }
-        }
-      else
-        {
-          nxmutex_unlock(&req->lock);
-        }
-
-      /* Wake-up pending requests. */
+  /* Wake-up pending requests. */
 
-      if (req->nbusy == 0)
-        {
-          break;
-        }
-
-      nxsem_post(&req->acksem);
+  while ((ack = (FAR struct usrsock_ack_s *)
+                dq_remfirst(&req->ackwaiters)) != NULL)
+    {
+      nxsem_post(&ack->sem);
     }
-  while (true);
 
   net_unlock();
 }
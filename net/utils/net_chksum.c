@@ -27,12 +27,149 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#if defined(CONFIG_NET_CHKSUM_SIMD) && defined(__ARM_NEON)
+#  include <arm_neon.h>
+#elif defined(CONFIG_NET_CHKSUM_SIMD) && defined(__SSE2__)
+#  include <immintrin.h>
+#endif
+
 #include "utils/utils.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The user data is copied and summed by blocks small enough to be still in
+ * the data cache when they are summed.
+ */
+
+#define CHKSUM_COPY_BLOCK 512
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: chksum_block
+ *
+ * Description:
+ *   Calculate the one's complement sum of the 16-bit words of an even
+ *   number of bytes, with the vector instructions the compiler targets.
+ *   The words are summed in the native byte order in 32 or 64-bit
+ *   accumulators, the sum is byte swapped once it is folded (RFC 1071):
+ *   64 KiB of data cannot overflow the 32-bit lanes.
+ *
+ * Returned Value:
+ *   The sum in host byte order, as chksum().
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_CHKSUM_SIMD) && !defined(CONFIG_NET_ARCH_CHKSUM)
+static uint16_t chksum_block(FAR const uint8_t *data, uint16_t len)
+{
+  uint64_t acc = 0;
+  uint32_t lanes[8];
+  int i;
+
+#if defined(__ARM_NEON)
+  if (len >= 16)
+    {
+      uint32x4_t vacc = vdupq_n_u32(0);
+
+      do
+        {
+          vacc  = vpadalq_u16(vacc, vreinterpretq_u16_u8(vld1q_u8(data)));
+          data += 16;
+          len  -= 16;
+        }
+      while (len >= 16);
+
+      vst1q_u32(lanes, vacc);
+      for (i = 0; i < 4; i++)
+        {
+          acc += lanes[i];
+        }
+    }
+
+#else
+#  if defined(__AVX2__)
+  if (len >= 32)
+    {
+      __m256i zero = _mm256_setzero_si256();
+      __m256i vacc = zero;
+      __m256i v;
+
+      do
+        {
+          v     = _mm256_loadu_si256((FAR const __m256i *)data);
+          vacc  = _mm256_add_epi32(vacc, _mm256_unpacklo_epi16(v, zero));
+          vacc  = _mm256_add_epi32(vacc, _mm256_unpackhi_epi16(v, zero));
+          data += 32;
+          len  -= 32;
+        }
+      while (len >= 32);
+
+      _mm256_storeu_si256((FAR __m256i *)lanes, vacc);
+      for (i = 0; i < 8; i++)
+        {
+          acc += lanes[i];
+        }
+    }
+
+#  endif
+#  if defined(__SSE2__)
+  if (len >= 16)
+    {
+      __m128i zero = _mm_setzero_si128();
+      __m128i vacc = zero;
+      __m128i v;
+
+      do
+        {
+          v     = _mm_loadu_si128((FAR const __m128i *)data);
+          vacc  = _mm_add_epi32(vacc, _mm_unpacklo_epi16(v, zero));
+          vacc  = _mm_add_epi32(vacc, _mm_unpackhi_epi16(v, zero));
+          data += 16;
+          len  -= 16;
+        }
+      while (len >= 16);
+
+      _mm_storeu_si128((FAR __m128i *)lanes, vacc);
+      for (i = 0; i < 4; i++)
+        {
+          acc += lanes[i];
+        }
+    }
+
+#  endif
+#endif
+
+  /* The words left, or all of them without vector instructions */
+
+  while (len >= 2)
+    {
+#ifdef CONFIG_ENDIAN_BIG
+      acc  += ((uint16_t)data[0] << 8) | data[1];
+#else
+      acc  += ((uint16_t)data[1] << 8) | data[0];
+#endif
+      data += 2;
+      len  -= 2;
+    }
+
+  while ((acc >> 16) != 0)
+    {
+      acc = (acc & 0xffff) + (acc >> 16);
+    }
+
+#ifdef CONFIG_ENDIAN_BIG
+  return (uint16_t)acc;
+#else
+  return (uint16_t)((acc << 8) | (acc >> 8));
+#endif
+}
+#endif
+
 /****************************************************************************
  * Name: checksum
  *
@@ -54,6 +191,54 @@
  ****************************************************************************/
 
 #ifndef CONFIG_NET_ARCH_CHKSUM
+#ifdef CONFIG_NET_CHKSUM_SIMD
+uint16_t checksum(uint16_t sum, FAR const uint8_t *data,
+                    uint16_t len, bool *odd)
+{
+  uint16_t t;
+
+  if (len == 0)
+    {
+      return sum;
+    }
+
+  /* The first byte completes the odd word of the previous data */
+
+  if (*odd == true)
+    {
+      t = data[0];
+      sum += t;
+      if (sum < t)
+        {
+          sum++; /* carry */
+        }
+
+      data += 1;
+      len  -= 1;
+    }
+
+  t = chksum_block(data, len & ~1);
+  sum += t;
+  if (sum < t)
+    {
+      sum++; /* carry */
+    }
+
+  *odd = (len & 1) != 0;
+
+  if (*odd)
+    {
+      t = (uint16_t)data[len - 1] << 8;
+      sum += t;
+      if (sum < t)
+        {
+          sum++; /* carry */
+        }
+    }
+
+  return sum;
+}
+#else
 uint16_t checksum(uint16_t sum, FAR const uint8_t *data,
                     uint16_t len, bool *odd)
 {
@@ -108,6 +293,7 @@ uint16_t checksum(uint16_t sum, FAR const uint8_t *data,
 
   return sum;
 }
+#endif /* CONFIG_NET_CHKSUM_SIMD */
 
 /****************************************************************************
  * Public Functions
@@ -188,6 +374,57 @@ uint16_t chksum_iob(uint16_t sum, FAR struct iob_s *iob, uint16_t offset)
 }
 #endif /* CONFIG_MM_IOB */
 
+/****************************************************************************
+ * Name: net_iob_copyin_chksum
+ *
+ * Description:
+ *   Copy data into an iob chain at 'offset' as iob_trycopyin() and return
+ *   the sum of the data as chksum() through 'sum':  The data is summed
+ *   block by block right after it is copied, while it is in the data
+ *   cache.
+ *
+ * Returned Value:
+ *   The number of bytes copied, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_CHKSUM_SIMD) && defined(CONFIG_MM_IOB)
+int net_iob_copyin_chksum(FAR struct iob_s *iob, FAR const uint8_t *src,
+                          unsigned int len, int offset, FAR uint16_t *sum)
+{
+  unsigned int ncopied = 0;
+  unsigned int ncopy;
+  bool odd = false;
+  int ret;
+
+  *sum = 0;
+  while (ncopied < len)
+    {
+      ncopy = len - ncopied;
+      if (ncopy > CHKSUM_COPY_BLOCK)
+        {
+          ncopy = CHKSUM_COPY_BLOCK;
+        }
+
+      ret = iob_trycopyin(iob, src + ncopied, ncopy, offset + ncopied,
+                          false);
+      if (ret < 0)
+        {
+          return ncopied > 0 ? ncopied : ret;
+        }
+
+      *sum = checksum(*sum, src + ncopied, ret, &odd);
+      ncopied += ret;
+      if (ret < ncopy)
+        {
+          break;
+        }
+    }
+
+  return ncopied;
+}
+#endif
+
 /****************************************************************************
  * Name: net_chksum
  *
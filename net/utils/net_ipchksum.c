@@ -27,6 +27,7 @@
 #include <nuttx/config.h>
 
 #include <assert.h>
+#include <string.h>
 
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ip.h>
@@ -308,4 +309,121 @@ uint16_t ipv4_chksum(FAR struct ipv4_hdr_s *ipv4)
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
 
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+
+/****************************************************************************
+ * Name: net_chksum_offload
+ *
+ * Description:
+ *   Leave the TCP or UDP checksum of the packet in d_iob to the device if
+ *   it supports the offload:  The checksum field is set to the checksum of
+ *   the pseudo-header and the packet is marked IOB_CSUM_PARTIAL.
+ *
+ * Input Parameters:
+ *   dev    - The network device, with the IP header built
+ *   proto  - IP_PROTO_TCP or IP_PROTO_UDP
+ *   iplen  - The length of the IP header
+ *   csum   - The checksum field in the TCP or UDP header
+ *
+ * Returned Value:
+ *   True if the device calculates the checksum, false if the caller must.
+ *
+ ****************************************************************************/
+
+bool net_chksum_offload(FAR struct net_driver_s *dev, uint8_t proto,
+                        unsigned int iplen, FAR uint16_t *csum)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+  FAR uint8_t *ip = IOB_DATA(iob);
+  uint16_t sum = iob->io_pktlen - iplen + proto;
+
+  iob->io_csumflags = 0;
+
+  /* NAT adjusts the complete checksums only */
+
+  if (IFF_IS_NAT(dev->d_flags))
+    {
+      return false;
+    }
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      if ((dev->d_csumcaps & NETDEV_CSUM_IPv6) == 0)
+        {
+          return false;
+        }
+
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)ip;
+
+      sum = chksum(sum, (FAR uint8_t *)ipv6->srcipaddr,
+                   2 * sizeof(net_ipv6addr_t));
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      if ((dev->d_csumcaps & NETDEV_CSUM_IPv4) == 0)
+        {
+          return false;
+        }
+
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)ip;
+
+      sum = chksum(sum, (FAR uint8_t *)ipv4->srcipaddr,
+                   2 * sizeof(in_addr_t));
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  /* The device sums the data from io_csumstart, the checksum of the
+   * pseudo-header in the checksum field included.
+   */
+
+  *csum             = HTONS(sum);
+  iob->io_csumflags = IOB_CSUM_PARTIAL;
+  iob->io_csumstart = iplen;
+  iob->io_csumoff   = (FAR uint8_t *)csum - (ip + iplen);
+  return true;
+}
+
+/****************************************************************************
+ * Name: net_chksum_complete
+ *
+ * Description:
+ *   Calculate the checksum left to the device of the packet in d_iob, if
+ *   any, before the packet is changed in a way the device cannot handle.
+ *
+ ****************************************************************************/
+
+void net_chksum_complete(FAR struct net_driver_s *dev)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+  uint16_t sum;
+
+  if ((iob->io_csumflags & IOB_CSUM_PARTIAL) == 0)
+    {
+      return;
+    }
+
+  sum = ~HTONS(chksum_iob(0, iob, iob->io_csumstart));
+
+  /* Zero means no checksum for UDP, 0xffff is the same for TCP */
+
+  if (sum == 0)
+    {
+      sum = 0xffff;
+    }
+
+  memcpy(IOB_DATA(iob) + iob->io_csumstart + iob->io_csumoff, &sum,
+         sizeof(sum));
+  iob->io_csumflags = 0;
+}
+
+#endif /* CONFIG_NETDEV_CSUM_OFFLOAD */
+
 #endif /* CONFIG_NET */
@@ -0,0 +1,86 @@
+/****************************************************************************
+ * net/utils/net_layerstats.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/net.h>
+
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_LAYER_STATS
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The statistics of the layers, protected by the network lock */
+
+static struct net_layerstats_s g_net_layerstats[NET_LAYER_NLAYERS];
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_layerstats_add
+ *
+ * Description:
+ *   Account for a call of a layer that started at 'start'.
+ *
+ ****************************************************************************/
+
+void net_layerstats_add(enum net_layer_e layer, clock_t start)
+{
+  FAR struct net_layerstats_s *stats = &g_net_layerstats[layer];
+  clock_t elapsed = perf_gettime() - start;
+
+  stats->count++;
+  stats->time += elapsed;
+  if (elapsed > stats->maxtime)
+    {
+      stats->maxtime = elapsed;
+    }
+}
+
+/****************************************************************************
+ * Name: net_layerstats
+ *
+ * Description:
+ *   Return a snapshot of the statistics of the layers.
+ *
+ ****************************************************************************/
+
+void net_layerstats(FAR struct net_layerstats_s *stats)
+{
+  net_lock();
+  memcpy(stats, g_net_layerstats, sizeof(g_net_layerstats));
+  net_unlock();
+}
+
+#endif /* CONFIG_NET_LAYER_STATS */
@@ -31,6 +31,7 @@
 #include <assert.h>
 #include <errno.h>
 #include <debug.h>
+#include <string.h>
 #include <time.h>
 
 #include <nuttx/irq.h>
@@ -54,10 +55,110 @@
 
 static rmutex_t g_netlock = NXRMUTEX_INITIALIZER;
 
+#ifdef CONFIG_NET_LOCK_STATS
+/* The statistics and the current hold, protected by the lock itself */
+
+static struct net_lockstats_s g_netlock_stats;
+static FAR void *g_netlock_caller;
+static clock_t g_netlock_start;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_NET_LOCK_STATS
+/****************************************************************************
+ * Name: net_lockstat_take
+ *
+ * Description:
+ *   Account for an acquisition of the network lock that started at
+ *   'start', and start the hold time if the lock was not held yet.
+ *
+ ****************************************************************************/
+
+static void net_lockstat_take(FAR void *caller, clock_t start,
+                              bool contended, bool outermost)
+{
+  FAR struct net_lockstats_s *stats = &g_netlock_stats;
+  clock_t now;
+
+  if (!outermost)
+    {
+      return;
+    }
+
+  now = perf_gettime();
+  stats->count++;
+  if (contended)
+    {
+      stats->contended++;
+      stats->waittime += now - start;
+      if (now - start > stats->maxwait)
+        {
+          stats->maxwait = now - start;
+        }
+    }
+
+  g_netlock_caller = caller;
+  g_netlock_start  = now;
+}
+
+/****************************************************************************
+ * Name: net_lockstat_give
+ *
+ * Description:
+ *   Account for the hold time of the network lock, before it is released
+ *   by its outermost holder.  The hold is charged to the call site that
+ *   took the lock.
+ *
+ ****************************************************************************/
+
+static void net_lockstat_give(void)
+{
+  FAR struct net_lockstats_s *stats = &g_netlock_stats;
+  FAR struct net_locksite_s *site = NULL;
+  FAR struct net_locksite_s *least;
+  clock_t hold = perf_gettime() - g_netlock_start;
+  int i;
+
+  stats->holdtime += hold;
+  if (hold > stats->maxhold)
+    {
+      stats->maxhold = hold;
+    }
+
+  least = &stats->sites[0];
+  for (i = 0; i < CONFIG_NET_LOCK_STATS_SITES; i++)
+    {
+      if (stats->sites[i].caller == g_netlock_caller)
+        {
+          site = &stats->sites[i];
+          break;
+        }
+
+      if (stats->sites[i].holdtime < least->holdtime)
+        {
+          least = &stats->sites[i];
+        }
+    }
+
+  if (site == NULL)
+    {
+      site = least;
+      memset(site, 0, sizeof(*site));
+      site->caller = g_netlock_caller;
+    }
+
+  site->count++;
+  site->holdtime += hold;
+  if (hold > site->maxhold)
+    {
+      site->maxhold = hold;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: _net_timedwait
  ****************************************************************************/
@@ -135,7 +236,28 @@ _net_timedwait(FAR sem_t *sem, bool interruptible, unsigned int timeout)
 
 int net_lock(void)
 {
+#ifdef CONFIG_NET_LOCK_STATS
+  clock_t start = perf_gettime();
+  bool contended = false;
+  int ret;
+
+  ret = nxrmutex_trylock(&g_netlock);
+  if (ret < 0)
+    {
+      contended = true;
+      ret = nxrmutex_lock(&g_netlock);
+    }
+
+  if (ret >= 0)
+    {
+      net_lockstat_take(return_address(0), start, contended,
+                        g_netlock.count == 1);
+    }
+
+  return ret;
+#else
   return nxrmutex_lock(&g_netlock);
+#endif
 }
 
 /****************************************************************************
@@ -157,7 +279,21 @@ int net_lock(void)
 
 int net_trylock(void)
 {
+#ifdef CONFIG_NET_LOCK_STATS
+  clock_t start = perf_gettime();
+  int ret;
+
+  ret = nxrmutex_trylock(&g_netlock);
+  if (ret >= 0)
+    {
+      net_lockstat_take(return_address(0), start, false,
+                        g_netlock.count == 1);
+    }
+
+  return ret;
+#else
   return nxrmutex_trylock(&g_netlock);
+#endif
 }
 
 /****************************************************************************
@@ -176,6 +312,13 @@ int net_trylock(void)
 
 void net_unlock(void)
 {
+#ifdef CONFIG_NET_LOCK_STATS
+  if (nxrmutex_is_hold(&g_netlock) && g_netlock.count == 1)
+    {
+      net_lockstat_give();
+    }
+#endif
+
   nxrmutex_unlock(&g_netlock);
 }
 
@@ -191,6 +334,14 @@ void net_unlock(void)
 int net_breaklock(FAR unsigned int *count)
 {
   DEBUGASSERT(count != NULL);
+
+#ifdef CONFIG_NET_LOCK_STATS
+  if (nxrmutex_is_hold(&g_netlock))
+    {
+      net_lockstat_give();
+    }
+#endif
+
   return nxrmutex_breaklock(&g_netlock, count);
 }
 
@@ -208,9 +359,39 @@ int net_breaklock(FAR unsigned int *count)
 
 int net_restorelock(unsigned int count)
 {
+#ifdef CONFIG_NET_LOCK_STATS
+  clock_t start = perf_gettime();
+  int ret;
+
+  ret = nxrmutex_restorelock(&g_netlock, count);
+  if (ret >= 0)
+    {
+      net_lockstat_take(return_address(0), start, false, true);
+    }
+
+  return ret;
+#else
   return nxrmutex_restorelock(&g_netlock, count);
+#endif
 }
 
+/****************************************************************************
+ * Name: net_lockstats
+ *
+ * Description:
+ *   Return a snapshot of the statistics of the network lock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCK_STATS
+void net_lockstats(FAR struct net_lockstats_s *stats)
+{
+  net_lock();
+  memcpy(stats, &g_netlock_stats, sizeof(*stats));
+  net_unlock();
+}
+#endif
+
 /****************************************************************************
  * Name: net_sem_timedwait
  *
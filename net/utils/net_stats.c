@@ -1,5 +1,5 @@
 /****************************************************************************
- * libs/libc/uio/lib_pwritev.c
+ * net/utils/net_stats.c
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -24,70 +24,55 @@
  * Included Files
  ****************************************************************************/
 
-#include <sys/types.h>
-#include <sys/uio.h>
-#include <unistd.h>
-#include <errno.h>
+#include <nuttx/config.h>
+
+#include <string.h>
+
+#include <nuttx/net/netstats.h>
+
+#ifdef CONFIG_NET_STATISTICS
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: pwritev()
+ * Name: net_stats_fold
  *
  * Description:
- *   The pwritev() function is equivalent to write(), except it takes
- *   an iov array.
+ *   Return the statistics summed over all the CPUs.  The counters are not
+ *   read atomically with respect to each other.
+ *
+ * Input Parameters:
+ *   stats - The location to return the statistics
  *
  ****************************************************************************/
 
-ssize_t pwritev(int fildes, FAR const struct iovec *iov, int iovcnt,
-                off_t offset)
+void net_stats_fold(FAR struct net_stats_s *stats)
 {
-  ssize_t ntotal;
-  ssize_t nwritten;
-  size_t remaining;
-  FAR uint8_t *buffer;
-  int i;
+#ifdef CONFIG_NET_STATISTICS_PERCPU
+  FAR net_stats_t *dst = (FAR net_stats_t *)stats;
+  FAR const net_stats_t *src;
+  unsigned int i;
+  int cpu;
 
-  /* Process each entry in the struct iovec array */
+  /* All the counters are net_stats_t, the padding of the copies is never
+   * written.
+   */
 
-  for (i = 0, ntotal = 0; i < iovcnt; i++)
-    {
-      /* Ignore zero-length writes */
+  memset(stats, 0, sizeof(*stats));
 
-      if (iov[i].iov_len > 0)
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      src = (FAR const net_stats_t *)&g_netstats_percpu[cpu];
+      for (i = 0; i < sizeof(*stats) / sizeof(net_stats_t); i++)
         {
-          buffer    = iov[i].iov_base;
-          remaining = iov[i].iov_len;
-
-          /* Write repeatedly as necessary to write the entire buffer */
-
-          do
-            {
-              /* NOTE: pwrite() is a cancellation point */
-
-              nwritten = pwrite(fildes, buffer, remaining, offset + ntotal);
-
-              /* Check for a write error */
-
-              if (nwritten < 0)
-                {
-                  return ntotal ? ntotal : ERROR;
-                }
-
-              /* Update pointers and counts in order to handle partial
-               * buffer writes.
-               */
-
-              buffer    += nwritten;
-              remaining -= nwritten;
-              ntotal    += nwritten;
-            }
-          while (remaining > 0);
+          dst[i] += src[i];
         }
     }
-
-  return ntotal;
+#else
+  memcpy(stats, &g_netstats, sizeof(*stats));
+#endif
 }
+
+#endif /* CONFIG_NET_STATISTICS */
@@ -26,6 +26,7 @@
 
 #include <nuttx/config.h>
 #include <nuttx/net/netdev.h>
+#include <nuttx/net/udp.h>
 
 #include "utils/utils.h"
 
@@ -65,4 +66,78 @@ uint16_t udp_ipv6_chksum(FAR struct net_driver_s *dev)
 }
 #endif
 
+/****************************************************************************
+ * Name: udp_send_chksum
+ *
+ * Description:
+ *   Calculate the checksum of the UDP packet being sent in d_buf, from the
+ *   sum of the payload given by devif_send_chksum() if there is one.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_CHECKSUMS
+uint16_t udp_send_chksum(FAR struct net_driver_s *dev)
+{
+#ifdef CONFIG_NET_CHKSUM_SIMD
+  unsigned int iplen;
+  uint16_t sum;
+  uint16_t t;
+
+  if (dev->d_sndsum >= 0)
+    {
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+      if (IFF_IS_IPv4(dev->d_flags))
+#endif
+        {
+          iplen = (IPv4BUF->vhl & IPv4_HLMASK) << 2;
+          sum   = ipv4_upperlayer_header_chksum(dev, IP_PROTO_UDP);
+        }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+      else
+#endif
+        {
+          iplen = IPv6_HDRLEN;
+          sum   = ipv6_upperlayer_header_chksum(dev, IP_PROTO_UDP,
+                                                IPv6_HDRLEN);
+        }
+#endif
+
+      /* The payload follows the UDP header at an even offset */
+
+      sum = chksum(sum, IPBUF(iplen), UDP_HDRLEN);
+      t   = (uint16_t)dev->d_sndsum;
+      sum += t;
+      if (sum < t)
+        {
+          sum++; /* carry */
+        }
+
+      return (sum == 0) ? 0xffff : HTONS(sum);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (IFF_IS_IPv4(dev->d_flags))
+#endif
+    {
+      return udp_ipv4_chksum(dev);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return udp_ipv6_chksum(dev);
+    }
+#endif
+}
+#endif
+
 #endif /* CONFIG_NET_UDP */
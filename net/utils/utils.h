@@ -31,6 +31,7 @@
 
 #include <stdlib.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/netdev.h>
@@ -76,6 +77,19 @@
       (nport) = HTONS(hport); \
     } while (0)
 
+/* Time a layer of the network from NET_LAYER_START() to NET_LAYER_STOP(),
+ * in the same block.  NET_LAYER_START() declares the start time, it must
+ * follow the other declarations.
+ */
+
+#ifdef CONFIG_NET_LAYER_STATS
+#  define NET_LAYER_START(start)       clock_t start = perf_gettime()
+#  define NET_LAYER_STOP(layer, start) net_layerstats_add(layer, start)
+#else
+#  define NET_LAYER_START(start)
+#  define NET_LAYER_STOP(layer, start)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -89,6 +103,61 @@ enum tv2ds_remainder_e
   TV2DS_CEIL       /* Force to next larger full decisecond */
 };
 
+/* The statistics of the network lock, in performance counter ticks.  Only
+ * the outermost acquisitions of the re-entrant lock are counted.
+ */
+
+#ifdef CONFIG_NET_LOCK_STATS
+struct net_locksite_s
+{
+  FAR void *caller;       /* The return address of net_lock(), or NULL */
+  uint32_t  count;        /* Number of times the site took the lock */
+  uint64_t  holdtime;     /* Total hold time */
+  clock_t   maxhold;      /* Longest hold time */
+};
+
+struct net_lockstats_s
+{
+  uint32_t  count;        /* Number of acquisitions */
+  uint32_t  contended;    /* Number of acquisitions that had to wait */
+  uint64_t  waittime;     /* Total wait time */
+  clock_t   maxwait;      /* Longest wait time */
+  uint64_t  holdtime;     /* Total hold time */
+  clock_t   maxhold;      /* Longest hold time */
+
+  /* The call sites, in no particular order */
+
+  struct net_locksite_s sites[CONFIG_NET_LOCK_STATS_SITES];
+};
+#endif
+
+/* The layers timed by the layer statistics.  The time of a layer includes
+ * the layers that it calls:  The time of the IP input includes the TCP
+ * and UDP input, and the copy of the packet for the drivers without I/O
+ * buffers.
+ */
+
+#ifdef CONFIG_NET_LAYER_STATS
+enum net_layer_e
+{
+  NET_LAYER_IPv4 = 0,     /* ipv4_input() */
+  NET_LAYER_IPv6,         /* ipv6_input() */
+  NET_LAYER_TCP,          /* TCP input */
+  NET_LAYER_UDP,          /* UDP input */
+  NET_LAYER_POLL,         /* devif_poll(), the output of all the sockets */
+  NET_LAYER_NLAYERS
+};
+
+/* The statistics of a layer, in performance counter ticks */
+
+struct net_layerstats_s
+{
+  uint32_t  count;        /* Number of calls */
+  uint64_t  time;         /* Total time */
+  clock_t   maxtime;      /* Longest call */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -133,6 +202,41 @@ int net_breaklock(FAR unsigned int *count);
 
 int net_restorelock(unsigned int count);
 
+/****************************************************************************
+ * Name: net_lockstats
+ *
+ * Description:
+ *   Return a snapshot of the statistics of the network lock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCK_STATS
+void net_lockstats(FAR struct net_lockstats_s *stats);
+#endif
+
+/****************************************************************************
+ * Name: net_layerstats_add
+ *
+ * Description:
+ *   Account for a call of a layer that started at 'start'.  Called with the
+ *   network locked, use NET_LAYER_STOP().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LAYER_STATS
+void net_layerstats_add(enum net_layer_e layer, clock_t start);
+
+/****************************************************************************
+ * Name: net_layerstats
+ *
+ * Description:
+ *   Return a snapshot of the statistics of the NET_LAYER_NLAYERS layers.
+ *
+ ****************************************************************************/
+
+void net_layerstats(FAR struct net_layerstats_s *stats);
+#endif
+
 /****************************************************************************
  * Name: net_dsec2timeval
  *
@@ -345,6 +449,23 @@ void net_chksum_adjust(FAR uint16_t *chksum,
                        FAR const uint16_t *optr, ssize_t olen,
                        FAR const uint16_t *nptr, ssize_t nlen);
 
+/****************************************************************************
+ * Name: net_iob_copyin_chksum
+ *
+ * Description:
+ *   Copy data into an iob chain at 'offset' as iob_trycopyin() and return
+ *   the sum of the data as chksum() through 'sum'.
+ *
+ * Returned Value:
+ *   The number of bytes copied, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_CHKSUM_SIMD) && defined(CONFIG_MM_IOB)
+int net_iob_copyin_chksum(FAR struct iob_s *iob, FAR const uint8_t *src,
+                          unsigned int len, int offset, FAR uint16_t *sum);
+#endif
+
 /****************************************************************************
  * Name: tcp_chksum, tcp_ipv4_chksum, and tcp_ipv6_chksum
  *
@@ -380,6 +501,66 @@ uint16_t tcp_chksum(FAR struct net_driver_s *dev);
 #  define tcp_chksum(d) tcp_ipv6_chksum(d)
 #endif
 
+/****************************************************************************
+ * Name: net_chksum_offload
+ *
+ * Description:
+ *   Leave the TCP or UDP checksum of the packet in d_iob to the device if
+ *   it supports the offload:  The checksum field is set to the checksum of
+ *   the pseudo-header and the packet is marked IOB_CSUM_PARTIAL.  The
+ *   checksums of the interfaces with NAT are calculated by the stack,
+ *   since NAT adjusts them.
+ *
+ * Input Parameters:
+ *   dev    - The network device, with the IP header built
+ *   proto  - IP_PROTO_TCP or IP_PROTO_UDP
+ *   iplen  - The length of the IP header
+ *   csum   - The checksum field in the TCP or UDP header
+ *
+ * Returned Value:
+ *   True if the device calculates the checksum, false if the caller must.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+bool net_chksum_offload(FAR struct net_driver_s *dev, uint8_t proto,
+                        unsigned int iplen, FAR uint16_t *csum);
+#else
+#  define net_chksum_offload(dev, proto, iplen, csum) false
+#endif
+
+/****************************************************************************
+ * Name: net_chksum_complete
+ *
+ * Description:
+ *   Calculate the checksum left to the device of the packet in d_iob, if
+ *   any, before the packet is changed in a way the device cannot handle
+ *   (IP fragmentation).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+void net_chksum_complete(FAR struct net_driver_s *dev);
+#else
+#  define net_chksum_complete(dev)
+#endif
+
+/****************************************************************************
+ * Name: net_chksum_verified
+ *
+ * Description:
+ *   True if the device verified the TCP or UDP checksum of the received
+ *   packet in d_iob.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+#  define net_chksum_verified(dev) \
+     (((dev)->d_iob->io_csumflags & IOB_CSUM_VERIFIED) != 0)
+#else
+#  define net_chksum_verified(dev) false
+#endif
+
 /****************************************************************************
  * Name: udp_ipv4_chksum
  *
@@ -404,6 +585,19 @@ uint16_t udp_ipv4_chksum(FAR struct net_driver_s *dev);
 uint16_t udp_ipv6_chksum(FAR struct net_driver_s *dev);
 #endif
 
+/****************************************************************************
+ * Name: udp_send_chksum
+ *
+ * Description:
+ *   Calculate the checksum of the UDP packet being sent in d_buf, from the
+ *   sum of the payload given by devif_send_chksum() if there is one.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_CHECKSUMS
+uint16_t udp_send_chksum(FAR struct net_driver_s *dev);
+#endif
+
 /****************************************************************************
  * Name: icmp_chksum
  *
@@ -33,6 +33,7 @@
 
 #include <nuttx/clock.h>
 #include <nuttx/compiler.h>
+#include <nuttx/seqlock.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -65,7 +66,18 @@ extern volatile clock_t g_system_ticks;
 #endif
 
 #ifndef CONFIG_CLOCK_TIMEKEEPING
+/* The time-of-day at power up.  Writers use clock_set_basetime(), readers
+ * clock_get_basetime().
+ */
+
 extern struct timespec  g_basetime;
+extern seqlock_t        g_basetime_lock;
+#endif
+
+#ifdef CONFIG_SCHED_VDSO
+/* The time data shared with user space, see include/nuttx/vdso.h */
+
+extern FAR struct vdso_data_s *g_vdso_data;
 #endif
 
 /****************************************************************************
@@ -81,6 +93,14 @@ void clock_timer(void);
 #  define clock_timer()
 #endif
 
+#ifdef CONFIG_SCHED_VDSO
+void clock_vdso_initialize(void);
+void clock_vdso_update(void);
+#else
+#  define clock_vdso_initialize()
+#  define clock_vdso_update()
+#endif
+
 /****************************************************************************
  * perf_init
  ****************************************************************************/
@@ -91,4 +111,49 @@ void perf_init(void);
 void cpuload_init(void);
 #endif
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+#ifndef CONFIG_CLOCK_TIMEKEEPING
+/****************************************************************************
+ * Name: clock_get_basetime
+ *
+ * Description:
+ *   Return a consistent copy of g_basetime without disabling interrupts.
+ *
+ ****************************************************************************/
+
+static inline_function void clock_get_basetime(FAR struct timespec *ts)
+{
+  uint32_t seq;
+
+  do
+    {
+      seq = read_seqbegin(&g_basetime_lock);
+      *ts = g_basetime;
+    }
+  while (read_seqretry(&g_basetime_lock, seq));
+}
+
+/****************************************************************************
+ * Name: clock_set_basetime
+ *
+ * Description:
+ *   Update g_basetime.
+ *
+ ****************************************************************************/
+
+static inline_function void clock_set_basetime(FAR const struct timespec *ts)
+{
+  irqstate_t flags;
+
+  flags = write_seqlock_irqsave(&g_basetime_lock);
+  g_basetime = *ts;
+  write_sequnlock_irqrestore(&g_basetime_lock, flags);
+
+  clock_vdso_update();
+}
+#endif
+
 #endif /* __SCHED_CLOCK_CLOCK_H */
@@ -99,8 +99,8 @@ void nxclock_gettime(clockid_t clock_id, FAR struct timespec *tp)
   else if (clock_id == CLOCK_REALTIME)
     {
 #ifndef CONFIG_CLOCK_TIMEKEEPING
+      struct timespec base;
       struct timespec ts;
-      irqstate_t flags;
 
       clock_systime_timespec(&ts);
 
@@ -109,9 +109,8 @@ void nxclock_gettime(clockid_t clock_id, FAR struct timespec *tp)
        * was last set, this gives us the current time.
        */
 
-      flags = spin_lock_irqsave(NULL);
-      clock_timespec_add(&g_basetime, &ts, tp);
-      spin_unlock_irqrestore(NULL, flags);
+      clock_get_basetime(&base);
+      clock_timespec_add(&base, &ts, tp);
 #else
       clock_timekeeping_get_wall_time(tp);
 #endif
@@ -59,6 +59,7 @@ volatile uint32_t g_system_ticks = INITIAL_SYSTEM_TIMER_TICKS;
 
 #ifndef CONFIG_CLOCK_TIMEKEEPING
 struct timespec   g_basetime;
+seqlock_t         g_basetime_lock = SEQLOCK_INITIALIZER;
 #endif
 
 /****************************************************************************
@@ -162,28 +163,31 @@ static void clock_inittime(FAR const struct timespec *tp)
   /* (Re-)initialize the time value to match the RTC */
 
 #ifndef CONFIG_CLOCK_TIMEKEEPING
+  struct timespec base;
   struct timespec ts;
 
   if (tp)
     {
-      memcpy(&g_basetime, tp, sizeof(struct timespec));
+      memcpy(&base, tp, sizeof(struct timespec));
     }
   else
     {
-      clock_basetime(&g_basetime);
+      clock_basetime(&base);
     }
 
   clock_systime_timespec(&ts);
 
   /* Adjust base time to hide initial timer ticks. */
 
-  g_basetime.tv_sec  -= ts.tv_sec;
-  g_basetime.tv_nsec -= ts.tv_nsec;
-  while (g_basetime.tv_nsec < 0)
+  base.tv_sec  -= ts.tv_sec;
+  base.tv_nsec -= ts.tv_nsec;
+  while (base.tv_nsec < 0)
     {
-      g_basetime.tv_nsec += NSEC_PER_SEC;
-      g_basetime.tv_sec--;
+      base.tv_nsec += NSEC_PER_SEC;
+      base.tv_sec--;
     }
+
+  clock_set_basetime(&base);
 #else
   clock_inittimekeeping(tp);
 #endif
@@ -206,6 +210,12 @@ void clock_initialize(void)
 {
   sched_trace_begin();
 
+  /* Allocate the time data shared with user space before the timer starts
+   * to update it.
+   */
+
+  clock_vdso_initialize();
+
 #if !defined(CONFIG_SUPPRESS_INTERRUPTS) && \
     !defined(CONFIG_SUPPRESS_TIMER_INTS) && \
     !defined(CONFIG_SYSTEMTICK_EXTCLK)
@@ -349,7 +359,8 @@ void clock_resynchronize(FAR struct timespec *rtc_diff)
    * was last set, this gives us the current time.
    */
 
-  clock_timespec_add(&bias, &g_basetime, &curr_ts);
+  clock_get_basetime(&curr_ts);
+  clock_timespec_add(&bias, &curr_ts, &curr_ts);
 
   /* Check if RTC has advanced past system time. */
 
@@ -376,6 +387,7 @@ void clock_resynchronize(FAR struct timespec *rtc_diff)
 
       g_system_ticks += SEC2TICK(rtc_diff->tv_sec);
       g_system_ticks += NSEC2TICK(rtc_diff->tv_nsec);
+      clock_vdso_update();
     }
 
 skip:
@@ -399,5 +411,6 @@ void clock_timer(void)
   /* Increment the per-tick system counter */
 
   g_system_ticks++;
+  clock_vdso_update();
 }
 #endif
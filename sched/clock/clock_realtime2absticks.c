@@ -58,9 +58,11 @@ int clock_realtime2absticks(FAR const struct timespec *reltime,
                             FAR clock_t *absticks)
 {
 #ifndef CONFIG_CLOCK_TIMEKEEPING
+  struct timespec base;
   struct timespec mono;
 
-  clock_timespec_subtract(reltime, &g_basetime, &mono);
+  clock_get_basetime(&base);
+  clock_timespec_subtract(reltime, &base, &mono);
 
   *absticks = clock_time2ticks(&mono);
 
@@ -59,6 +59,7 @@ void nxclock_settime(clockid_t clock_id, FAR const struct timespec *tp)
 {
 #ifndef CONFIG_CLOCK_TIMEKEEPING
   struct timespec bias;
+  struct timespec base;
   irqstate_t flags;
 #  ifdef CONFIG_CLOCK_ADJTIME
   const struct timeval zerodelta = {
@@ -78,7 +79,8 @@ void nxclock_settime(clockid_t clock_id, FAR const struct timespec *tp)
    */
 
   clock_systime_timespec(&bias);
-  clock_timespec_subtract(tp, &bias, &g_basetime);
+  clock_timespec_subtract(tp, &bias, &base);
+  clock_set_basetime(&base);
 
   leave_critical_section(flags);
 
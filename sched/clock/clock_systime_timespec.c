@@ -33,7 +33,6 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
-#include <nuttx/spinlock.h>
 
 #include "clock/clock.h"
 
@@ -64,13 +63,12 @@ int clock_systime_timespec(FAR struct timespec *ts)
 #ifdef CONFIG_RTC_HIRES
   if (g_rtc_enabled)
     {
-      irqstate_t flags;
+      struct timespec base;
 
       up_rtc_gettime(ts);
 
-      flags = spin_lock_irqsave(NULL);
-      clock_timespec_subtract(ts, &g_basetime, ts);
-      spin_unlock_irqrestore(NULL, flags);
+      clock_get_basetime(&base);
+      clock_timespec_subtract(ts, &base, ts);
     }
   else
     {
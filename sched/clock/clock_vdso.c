@@ -0,0 +1,99 @@
+/****************************************************************************
+ * sched/clock/clock_vdso.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/vdso.h>
+
+#include "clock/clock.h"
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The time data shared with user space, NULL until clock_initialize() */
+
+FAR struct vdso_data_s *g_vdso_data;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clock_vdso_initialize
+ *
+ * Description:
+ *   Allocate the time data shared with user space.  The data must be
+ *   readable by user space, so it comes from the user heap.  User space
+ *   falls back to the clock system calls if the allocation fails and in the
+ *   task groups that are created before.
+ *
+ ****************************************************************************/
+
+void clock_vdso_initialize(void)
+{
+  FAR struct vdso_data_s *vdso;
+
+  vdso = kumm_zalloc(sizeof(struct vdso_data_s));
+  if (vdso != NULL)
+    {
+      seqlock_init(&vdso->vd_lock);
+      g_vdso_data = vdso;
+      clock_vdso_update();
+    }
+}
+
+/****************************************************************************
+ * Name: clock_vdso_update
+ *
+ * Description:
+ *   Copy the system timer and the time-of-day base to the time data shared
+ *   with user space.
+ *
+ ****************************************************************************/
+
+void clock_vdso_update(void)
+{
+  FAR struct vdso_data_s *vdso = g_vdso_data;
+  struct timespec base;
+  irqstate_t flags;
+
+  if (vdso == NULL)
+    {
+      return;
+    }
+
+  clock_get_basetime(&base);
+
+  flags = write_seqlock_irqsave(&vdso->vd_lock);
+  vdso->vd_ticks    = g_system_ticks;
+  vdso->vd_basetime = base;
+  write_sequnlock_irqrestore(&vdso->vd_lock, flags);
+}
@@ -39,6 +39,7 @@
 
 #include "sched/sched.h"
 #include "group/group.h"
+#include "signal/signal.h"
 #include "tls/tls.h"
 
 /****************************************************************************
@@ -178,6 +179,17 @@ int group_initialize(FAR struct task_tcb_s *tcb, uint8_t ttype)
       return ret;
     }
 
+#if CONFIG_SIG_PREALLOC_GROUP > 0
+  /* Allocate the pool of pending signals of the group */
+
+  ret = nxsig_group_initialize(group);
+  if (ret < 0)
+    {
+      task_uninit_info(group);
+      return ret;
+    }
+#endif
+
 #ifndef CONFIG_DISABLE_PTHREAD
   /* Initialize the task group join */
 
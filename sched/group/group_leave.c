@@ -43,6 +43,7 @@
 #endif
 
 #include "environ/environ.h"
+#include "sched/sched.h"
 #include "signal/signal.h"
 #include "pthread/pthread.h"
 #include "mqueue/mqueue.h"
@@ -250,7 +251,7 @@ void group_drop(FAR struct task_group_s *group)
 
       if (tcb->cmn.flags & TCB_FLAG_FREE_TCB)
         {
-          kmm_free(tcb);
+          nxsched_free_tcb(&tcb->cmn);
         }
     }
 }
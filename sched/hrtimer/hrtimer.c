@@ -0,0 +1,438 @@
+/****************************************************************************
+ * sched/hrtimer/hrtimer.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/hrtimer.h>
+#include <nuttx/spinlock.h>
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+RB_HEAD(hrtimer_tree_s, hrtimer_s);
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int hrtimer_compare(FAR struct hrtimer_s *a,
+                           FAR struct hrtimer_s *b);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* All active hrtimers, ordered by expiration time */
+
+static struct hrtimer_tree_s g_hrtimer_tree =
+  RB_INITIALIZER(&g_hrtimer_tree);
+
+/* The leftmost node of g_hrtimer_tree, i.e. the next hrtimer to expire */
+
+static FAR struct hrtimer_s *g_hrtimer_first;
+
+/* The hrtimer whose callback is running or NULL.  hrtimer_start() and
+ * hrtimer_cancel() clear it so that the timer is not restarted with the
+ * period returned by the callback.
+ */
+
+static FAR struct hrtimer_s *g_hrtimer_running;
+
+/* True while nxsched_hrtimer_expiration() walks the tree.  The oneshot is
+ * reprogrammed only once, when it is done.
+ */
+
+static bool g_hrtimer_dispatching;
+
+static spinlock_t g_hrtimer_lock = SP_UNLOCKED;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: RB_GENERATE_STATIC
+ ****************************************************************************/
+
+RB_GENERATE_STATIC(hrtimer_tree_s, hrtimer_s, node, hrtimer_compare)
+
+/****************************************************************************
+ * Name: hrtimer_compare
+ *
+ * Description:
+ *   Order hrtimers by expiration time.  Timers with the same expiration
+ *   time are ordered by address since the tree does not accept duplicate
+ *   keys.
+ *
+ ****************************************************************************/
+
+static int hrtimer_compare(FAR struct hrtimer_s *a,
+                           FAR struct hrtimer_s *b)
+{
+  if (a->expired != b->expired)
+    {
+      return a->expired < b->expired ? -1 : 1;
+    }
+
+  if (a != b)
+    {
+      return (uintptr_t)a < (uintptr_t)b ? -1 : 1;
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: hrtimer_insert
+ *
+ * Description:
+ *   Add an hrtimer to the tree.  Return true if it became the first timer
+ *   to expire.
+ *
+ ****************************************************************************/
+
+static bool hrtimer_insert(FAR struct hrtimer_s *hrtimer)
+{
+  RB_INSERT(hrtimer_tree_s, &g_hrtimer_tree, hrtimer);
+
+  if (g_hrtimer_first == NULL ||
+      hrtimer_compare(hrtimer, g_hrtimer_first) < 0)
+    {
+      g_hrtimer_first = hrtimer;
+      return true;
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: hrtimer_remove
+ *
+ * Description:
+ *   Remove an hrtimer from the tree.  Return true if it was the first timer
+ *   to expire.
+ *
+ ****************************************************************************/
+
+static bool hrtimer_remove(FAR struct hrtimer_s *hrtimer)
+{
+  bool first = hrtimer == g_hrtimer_first;
+
+  if (first)
+    {
+      g_hrtimer_first = RB_NEXT(hrtimer_tree_s, &g_hrtimer_tree, hrtimer);
+    }
+
+  RB_REMOVE(hrtimer_tree_s, &g_hrtimer_tree, hrtimer);
+  return first;
+}
+
+/****************************************************************************
+ * Name: hrtimer_reprogram
+ *
+ * Description:
+ *   Program the oneshot timer for the first hrtimer in the tree.
+ *
+ ****************************************************************************/
+
+static void hrtimer_reprogram(void)
+{
+  if (!g_hrtimer_dispatching)
+    {
+      up_hrtimer_start(g_hrtimer_first != NULL ?
+                       g_hrtimer_first->expired : UINT64_MAX);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: hrtimer_now
+ *
+ * Description:
+ *   Return the current time of CLOCK_MONOTONIC in nanoseconds, as seen by
+ *   the hrtimer subsystem.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_now(void)
+{
+  struct timespec ts;
+
+  up_timer_gettime(&ts);
+  return clock_time2nsec(&ts);
+}
+
+/****************************************************************************
+ * Name: hrtimer_start
+ *
+ * Description:
+ *   Start (or restart) an hrtimer.  The function 'func' will be called from
+ *   the interrupt context of the oneshot timer once CLOCK_MONOTONIC reaches
+ *   the expiration time.
+ *
+ * Input Parameters:
+ *   hrtimer - The hrtimer to start
+ *   func    - The function to call on expiration
+ *   arg     - Argument available to 'func' through hrtimer->arg
+ *   ns      - The expiration time in nanoseconds
+ *   mode    - HRTIMER_MODE_ABS or HRTIMER_MODE_REL
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+int hrtimer_start(FAR struct hrtimer_s *hrtimer, hrtimer_entry_t func,
+                  FAR void *arg, uint64_t ns, enum hrtimer_mode_e mode)
+{
+  irqstate_t flags;
+  bool reprogram = false;
+
+  if (hrtimer == NULL || func == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if (mode == HRTIMER_MODE_REL)
+    {
+      ns += hrtimer_now();
+    }
+
+  flags = spin_lock_irqsave(&g_hrtimer_lock);
+
+  if (HRTIMER_ISACTIVE(hrtimer))
+    {
+      reprogram = hrtimer_remove(hrtimer);
+    }
+
+  if (g_hrtimer_running == hrtimer)
+    {
+      g_hrtimer_running = NULL;
+    }
+
+  hrtimer->func    = func;
+  hrtimer->arg     = arg;
+  hrtimer->expired = ns;
+
+  reprogram |= hrtimer_insert(hrtimer);
+  if (reprogram)
+    {
+      hrtimer_reprogram();
+    }
+
+  spin_unlock_irqrestore(&g_hrtimer_lock, flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: hrtimer_cancel
+ *
+ * Description:
+ *   Stop an hrtimer.
+ *
+ * Input Parameters:
+ *   hrtimer - The hrtimer to cancel
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -EINVAL is returned if the timer was
+ *   not active.
+ *
+ ****************************************************************************/
+
+int hrtimer_cancel(FAR struct hrtimer_s *hrtimer)
+{
+  irqstate_t flags;
+  int ret = -EINVAL;
+
+  if (hrtimer == NULL)
+    {
+      return ret;
+    }
+
+  flags = spin_lock_irqsave(&g_hrtimer_lock);
+
+  if (HRTIMER_ISACTIVE(hrtimer))
+    {
+      if (hrtimer_remove(hrtimer))
+        {
+          hrtimer_reprogram();
+        }
+
+      hrtimer->func = NULL;
+      ret = OK;
+    }
+
+  /* The callback is running, just prevent the restart */
+
+  if (g_hrtimer_running == hrtimer)
+    {
+      g_hrtimer_running = NULL;
+      ret = OK;
+    }
+
+  spin_unlock_irqrestore(&g_hrtimer_lock, flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: hrtimer_gettime
+ *
+ * Description:
+ *   Return the time remaining before an hrtimer expires.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_gettime(FAR struct hrtimer_s *hrtimer)
+{
+  uint64_t remaining = 0;
+  irqstate_t flags;
+  uint64_t now;
+
+  DEBUGASSERT(hrtimer != NULL);
+
+  now   = hrtimer_now();
+  flags = spin_lock_irqsave(&g_hrtimer_lock);
+
+  if (HRTIMER_ISACTIVE(hrtimer) && hrtimer->expired > now)
+    {
+      remaining = hrtimer->expired - now;
+    }
+
+  spin_unlock_irqrestore(&g_hrtimer_lock, flags);
+  return remaining;
+}
+
+/****************************************************************************
+ * Name: hrtimer_getnext
+ *
+ * Description:
+ *   Return the time remaining before the next hrtimer expires.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_getnext(void)
+{
+  uint64_t remaining = UINT64_MAX;
+  irqstate_t flags;
+  uint64_t now;
+
+  now   = hrtimer_now();
+  flags = spin_lock_irqsave(&g_hrtimer_lock);
+
+  if (g_hrtimer_first != NULL)
+    {
+      remaining = g_hrtimer_first->expired > now ?
+                  g_hrtimer_first->expired - now : 0;
+    }
+
+  spin_unlock_irqrestore(&g_hrtimer_lock, flags);
+  return remaining;
+}
+
+/****************************************************************************
+ * Name: nxsched_hrtimer_expiration
+ *
+ * Description:
+ *   Called from the oneshot interrupt handler to run all the hrtimers that
+ *   are due at 'now'.  The oneshot is then reprogrammed for the next
+ *   hrtimer through up_hrtimer_start().
+ *
+ * Input Parameters:
+ *   now - The current time of CLOCK_MONOTONIC in nanoseconds
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from the interrupt handler of the oneshot timer.
+ *
+ ****************************************************************************/
+
+void nxsched_hrtimer_expiration(uint64_t now)
+{
+  FAR struct hrtimer_s *hrtimer;
+  hrtimer_entry_t func;
+  irqstate_t flags;
+  uint64_t expired;
+  uint64_t period;
+
+  flags = spin_lock_irqsave(&g_hrtimer_lock);
+
+  /* Only one CPU handles the oneshot interrupt at a time, but do not
+   * nest if some callback enables interrupts.
+   */
+
+  if (g_hrtimer_dispatching)
+    {
+      spin_unlock_irqrestore(&g_hrtimer_lock, flags);
+      return;
+    }
+
+  g_hrtimer_dispatching = true;
+
+  while ((hrtimer = g_hrtimer_first) != NULL && hrtimer->expired <= now)
+    {
+      hrtimer_remove(hrtimer);
+
+      func              = hrtimer->func;
+      expired           = hrtimer->expired;
+      hrtimer->func     = NULL;
+      g_hrtimer_running = hrtimer;
+
+      /* The callback may start or cancel any hrtimer, including this one */
+
+      spin_unlock_irqrestore(&g_hrtimer_lock, flags);
+      period = func(hrtimer, expired);
+      flags = spin_lock_irqsave(&g_hrtimer_lock);
+
+      if (period != 0 && g_hrtimer_running == hrtimer &&
+          !HRTIMER_ISACTIVE(hrtimer))
+        {
+          hrtimer->func    = func;
+          hrtimer->expired = expired + period;
+          hrtimer_insert(hrtimer);
+        }
+
+      g_hrtimer_running = NULL;
+    }
+
+  g_hrtimer_dispatching = false;
+  hrtimer_reprogram();
+
+  spin_unlock_irqrestore(&g_hrtimer_lock, flags);
+}
@@ -34,6 +34,8 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/board.h>
+#include <nuttx/boottrace.h>
+#include <nuttx/drivers/drivers_async.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/init.h>
 #include <nuttx/macro.h>
@@ -319,9 +321,17 @@ static inline void nx_start_application(void)
    * configured.
    */
 
+  boottrace_begin("board_late_init");
   board_late_initialize();
+  boottrace_end("board_late_init");
 #endif
 
+  /* Wait for the asynchronous driver probes */
+
+  boottrace_begin("async_probes");
+  drivers_async_wait();
+  boottrace_end("async_probes");
+
 #if defined(CONFIG_BOARD_COREDUMP_SYSLOG) || \
     defined(CONFIG_BOARD_COREDUMP_BLKDEV)
   coredump_initialize();
@@ -340,6 +350,7 @@ static inline void nx_start_application(void)
    */
 
   sinfo("Starting init thread\n");
+  boottrace_mark("init %s", CONFIG_INIT_ENTRYNAME);
 
 #  ifdef CONFIG_BUILD_PROTECTED
   DEBUGASSERT(USERSPACE->us_entrypoint != NULL);
@@ -368,6 +379,7 @@ static inline void nx_start_application(void)
    */
 
   sinfo("Starting init task: %s\n", CONFIG_INIT_FILEPATH);
+  boottrace_mark("init %s", CONFIG_INIT_FILEPATH);
 
   posix_spawnattr_init(&attr);
 
@@ -522,6 +534,10 @@ int nx_bringup(void)
 
   nx_workqueues();
 
+  /* Start the threads of the asynchronous driver probes */
+
+  drivers_async_start();
+
   /* Once the operating system has been initialized, the system must be
    * started by spawning the user initialization thread of execution.  This
    * will be the first user-mode thread.
@@ -87,6 +87,21 @@ void nx_idle_trampoline(void)
 
   for (; ; )
     {
+#ifdef CONFIG_SCHED_IDLE_BALANCE
+      /* Pull work from busy CPUs before going to sleep */
+
+      nxsched_idle_balance();
+#endif
+
+#ifdef CONFIG_SCHED_IDLE_POLL
+      /* Poll for a wakeup before entering a wait state */
+
+      if (nxsched_idle_poll())
+        {
+          continue;
+        }
+#endif
+
       /* Perform any processor-specific idle state operations */
 
       up_idle();
@@ -33,6 +33,7 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/board.h>
+#include <nuttx/boottrace.h>
 #include <nuttx/compiler.h>
 #include <nuttx/sched.h>
 #include <nuttx/fs/fs.h>
@@ -49,6 +50,10 @@
 #include <nuttx/init.h>
 #include <nuttx/lib/math32.h>
 
+#ifdef CONFIG_SCHED_PERF_EVENTS
+#  include <nuttx/perf.h>
+#endif
+
 #include "task/task.h"
 #include "sched/sched.h"
 #include "signal/signal.h"
@@ -522,6 +527,7 @@ void nx_start(void)
   int i;
 
   sinfo("Entry\n");
+  boottrace_mark("nx_start");
 
   /* Boot up is complete */
 
@@ -557,6 +563,7 @@ void nx_start(void)
     defined(CONFIG_MM_PGALLOC)
   /* Initialize the memory manager */
 
+    boottrace_begin("heap");
     {
       FAR void *heap_start;
       size_t heap_size;
@@ -589,6 +596,8 @@ void nx_start(void)
       mm_pginitialize(heap_start, heap_size);
 #endif
     }
+
+    boottrace_end("heap");
 #endif
 
 #ifdef CONFIG_MM_KMAP
@@ -609,6 +618,12 @@ void nx_start(void)
   iob_initialize();
 #endif
 
+#ifdef CONFIG_SCHED_TCBPOOL
+  /* Preallocate the TCB and stack pools */
+
+  nxsched_tcbpool_initialize();
+#endif
+
   /* Initialize the logic that determine unique process IDs. */
 
   i = 1 << LOG2_CEIL(CONFIG_PID_INITIAL_COUNT);
@@ -634,6 +649,7 @@ void nx_start(void)
 
   /* Initialize tasking data structures */
 
+  boottrace_begin("os_services");
   task_initialize();
 
   /* Initialize the instrument function */
@@ -652,6 +668,12 @@ void nx_start(void)
 
   clock_initialize();
 
+#ifdef CONFIG_SCHED_PERF_EVENTS
+  /* Initialize the performance events, before the PMU drivers register */
+
+  perf_event_init();
+#endif
+
 #ifndef CONFIG_DISABLE_POSIX_TIMERS
   timer_initialize();
 #endif
@@ -678,6 +700,8 @@ void nx_start(void)
   binfmt_initialize();
 #endif
 
+  boottrace_end("os_services");
+
   /* Initialize Hardware Facilities *****************************************/
 
   /* The processor specific details of running the operating system
@@ -686,11 +710,15 @@ void nx_start(void)
    * that are different for each  processor and hardware platform.
    */
 
+  boottrace_begin("up_initialize");
   up_initialize();
+  boottrace_end("up_initialize");
 
   /* Initialize common drivers */
 
+  boottrace_begin("drivers_initialize");
   drivers_initialize();
+  boottrace_end("drivers_initialize");
 
 #ifdef CONFIG_BOARD_EARLY_INITIALIZE
   /* Call the board-specific up_initialize() extension to support
@@ -698,7 +726,9 @@ void nx_start(void)
    * that cannot wait until board_late_initialize.
    */
 
+  boottrace_begin("board_early_init");
   board_early_initialize();
+  boottrace_end("board_early_init");
 #endif
 
   /* Hardware resources are now available */
@@ -742,7 +772,9 @@ void nx_start(void)
 
   /* Then start the other CPUs */
 
+  boottrace_begin("nx_smp_start");
   DEBUGVERIFY(nx_smp_start());
+  boottrace_end("nx_smp_start");
 
 #endif /* CONFIG_SMP */
 
@@ -754,7 +786,9 @@ void nx_start(void)
 
   /* Create initial tasks and bring-up the system */
 
+  boottrace_begin("nx_bringup");
   DEBUGVERIFY(nx_bringup());
+  boottrace_end("nx_bringup");
 
   /* Enter to idleloop */
 
@@ -773,6 +807,21 @@ void nx_start(void)
 #ifndef CONFIG_DISABLE_IDLE_LOOP
   for (; ; )
     {
+#ifdef CONFIG_SCHED_IDLE_BALANCE
+      /* Pull work from busy CPUs before going to sleep */
+
+      nxsched_idle_balance();
+#endif
+
+#ifdef CONFIG_SCHED_IDLE_POLL
+      /* Poll for a wakeup before entering a wait state */
+
+      if (nxsched_idle_poll())
+        {
+          continue;
+        }
+#endif
+
       /* Perform any processor-specific idle state operations */
 
       up_idle();
@@ -0,0 +1,638 @@
+/****************************************************************************
+ * sched/instrument/benchmark.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <sys/types.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <mqueue.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kthread.h>
+#include <nuttx/mqueue.h>
+#include <nuttx/mutex.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/wdog.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define BENCH_ITERATIONS     CONFIG_SCHED_BENCHMARK_ITERATIONS
+#define BENCH_PRIORITY       CONFIG_SCHED_BENCHMARK_PRIORITY
+#define BENCH_STACKSIZE      CONFIG_DEFAULT_TASK_STACKSIZE
+
+/* The watchdog benchmark samples at most one second */
+
+#define BENCH_WDOG_SAMPLES   MIN(BENCH_ITERATIONS, TICK_PER_SEC)
+
+/* Messages of the message queue benchmark */
+
+#define BENCH_MQ_PING        0
+#define BENCH_MQ_STOP        1
+
+#define BENCH_NBENCHMARKS    nitems(g_benchmarks)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one benchmark.  The driver thread takes the
+ * samples.  The peer thread, if any, is its counterpart and runs at the
+ * priority of the driver plus 'boost'.
+ */
+
+struct bench_s
+{
+  FAR const char *name;
+  CODE void (*driver)(void);
+  CODE void (*peer)(void);
+  uint8_t boost;
+};
+
+/* The statistics of the running benchmark, in perf counts */
+
+struct bench_stat_s
+{
+  uint32_t samples;
+  clock_t  min;
+  clock_t  max;
+  uint64_t sum;
+};
+
+/* The state shared by the benchmark threads.  Only one benchmark runs at a
+ * time.
+ */
+
+struct bench_ctx_s
+{
+  mutex_t lock;                  /* Serializes nxsched_benchmark() */
+  sem_t start;                   /* Starts the threads once set up */
+  sem_t done;                    /* Posted by each finished thread */
+  sem_t sem;                     /* Used by the benchmarks */
+  mutex_t mutex;                 /* Used by the mutex benchmark */
+#ifndef CONFIG_DISABLE_MQUEUE
+  struct file req;               /* Requests of the mqueue benchmark */
+  struct file rsp;               /* Responses of the mqueue benchmark */
+#endif
+  struct wdog_s wdog;            /* Used by the watchdog benchmark */
+  FAR const struct bench_s *bench;
+  volatile bool stop;            /* Tells the peer thread to finish */
+  volatile clock_t stamp;        /* Start time of the current sample */
+  struct bench_stat_s stat;
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void bench_yield_driver(void);
+static void bench_yield_peer(void);
+static void bench_sem_driver(void);
+static void bench_sem_peer(void);
+static void bench_mutex_driver(void);
+static void bench_mutex_peer(void);
+#ifndef CONFIG_DISABLE_MQUEUE
+static void bench_mq_driver(void);
+static void bench_mq_peer(void);
+#endif
+static void bench_wdog_driver(void);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct bench_s g_benchmarks[] =
+{
+  { "ctxswitch", bench_yield_driver, bench_yield_peer, 0 },
+  { "sem",       bench_sem_driver,   bench_sem_peer,   1 },
+  { "mutex",     bench_mutex_driver, bench_mutex_peer, 1 },
+#ifndef CONFIG_DISABLE_MQUEUE
+  { "mqueue",    bench_mq_driver,    bench_mq_peer,    1 },
+#endif
+  { "wdog",      bench_wdog_driver,  NULL,             0 },
+};
+
+static struct bench_ctx_s g_bench =
+{
+  NXMUTEX_INITIALIZER,
+  SEM_INITIALIZER(0),
+  SEM_INITIALIZER(0),
+  SEM_INITIALIZER(0),
+  NXMUTEX_INITIALIZER,
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bench_sample
+ *
+ * Description:
+ *   Add a sample of 'elapsed' perf counts to the statistics.
+ *
+ ****************************************************************************/
+
+static void bench_sample(clock_t elapsed)
+{
+  FAR struct bench_stat_s *stat = &g_bench.stat;
+
+  if (stat->samples == 0 || elapsed < stat->min)
+    {
+      stat->min = elapsed;
+    }
+
+  if (elapsed > stat->max)
+    {
+      stat->max = elapsed;
+    }
+
+  stat->sum += elapsed;
+  stat->samples++;
+}
+
+/****************************************************************************
+ * Name: bench_nsec
+ *
+ * Description:
+ *   Convert perf counts to nanoseconds.
+ *
+ ****************************************************************************/
+
+static uint32_t bench_nsec(clock_t elapsed)
+{
+  struct timespec ts;
+  uint64_t nsec;
+
+  perf_convert(elapsed, &ts);
+  nsec = (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+  return nsec > UINT32_MAX ? UINT32_MAX : (uint32_t)nsec;
+}
+
+/****************************************************************************
+ * Name: bench_yield_driver, bench_yield_peer
+ *
+ * Description:
+ *   Two threads of the same priority yield the CPU to each other.  A
+ *   sample is half of the time until the driver runs again.
+ *
+ ****************************************************************************/
+
+static void bench_yield_driver(void)
+{
+  clock_t start;
+  int i;
+
+  for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+      start = perf_gettime();
+      sched_yield();
+      bench_sample((perf_gettime() - start) / 2);
+    }
+
+  g_bench.stop = true;
+}
+
+static void bench_yield_peer(void)
+{
+  while (!g_bench.stop)
+    {
+      sched_yield();
+    }
+}
+
+/****************************************************************************
+ * Name: bench_sem_driver, bench_sem_peer
+ *
+ * Description:
+ *   A sample is the time from nxsem_post() by the driver until the return
+ *   from nxsem_wait() in the higher priority peer.
+ *
+ ****************************************************************************/
+
+static void bench_sem_driver(void)
+{
+  int i;
+
+  for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+      g_bench.stamp = perf_gettime();
+      nxsem_post(&g_bench.sem);
+    }
+
+  g_bench.stop = true;
+  nxsem_post(&g_bench.sem);
+}
+
+static void bench_sem_peer(void)
+{
+  for (; ; )
+    {
+      nxsem_wait_uninterruptible(&g_bench.sem);
+      if (g_bench.stop)
+        {
+          break;
+        }
+
+      bench_sample(perf_gettime() - g_bench.stamp);
+    }
+}
+
+/****************************************************************************
+ * Name: bench_mutex_driver, bench_mutex_peer
+ *
+ * Description:
+ *   A sample is the time from nxmutex_unlock() by the driver until the
+ *   higher priority peer that is blocked in nxmutex_lock() owns the mutex.
+ *
+ ****************************************************************************/
+
+static void bench_mutex_driver(void)
+{
+  int i;
+
+  for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+      nxmutex_lock(&g_bench.mutex);
+
+      /* Let the peer block on the mutex */
+
+      nxsem_post(&g_bench.sem);
+
+      g_bench.stamp = perf_gettime();
+      nxmutex_unlock(&g_bench.mutex);
+    }
+
+  g_bench.stop = true;
+  nxsem_post(&g_bench.sem);
+}
+
+static void bench_mutex_peer(void)
+{
+  for (; ; )
+    {
+      nxsem_wait_uninterruptible(&g_bench.sem);
+      if (g_bench.stop)
+        {
+          break;
+        }
+
+      nxmutex_lock(&g_bench.mutex);
+      bench_sample(perf_gettime() - g_bench.stamp);
+      nxmutex_unlock(&g_bench.mutex);
+    }
+}
+
+/****************************************************************************
+ * Name: bench_mq_driver, bench_mq_peer
+ *
+ * Description:
+ *   A sample is the time for a message to the higher priority peer and
+ *   its response.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_MQUEUE
+static void bench_mq_driver(void)
+{
+  clock_t start;
+  char msg;
+  int i;
+
+  for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+      msg   = BENCH_MQ_PING;
+      start = perf_gettime();
+      if (file_mq_send(&g_bench.req, &msg, 1, 0) < 0 ||
+          file_mq_receive(&g_bench.rsp, &msg, 1, NULL) < 0)
+        {
+          break;
+        }
+
+      bench_sample(perf_gettime() - start);
+    }
+
+  msg = BENCH_MQ_STOP;
+  file_mq_send(&g_bench.req, &msg, 1, 0);
+}
+
+static void bench_mq_peer(void)
+{
+  char msg;
+
+  while (file_mq_receive(&g_bench.req, &msg, 1, NULL) == 1 &&
+         msg != BENCH_MQ_STOP)
+    {
+      if (file_mq_send(&g_bench.rsp, &msg, 1, 0) < 0)
+        {
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: bench_mq_open
+ *
+ * Description:
+ *   Create an anonymous message queue of one byte messages.
+ *
+ ****************************************************************************/
+
+static int bench_mq_open(FAR struct file *mq, FAR const char *name)
+{
+  struct mq_attr attr;
+  int ret;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.mq_maxmsg  = 1;
+  attr.mq_msgsize = 1;
+
+  ret = file_mq_open(mq, name, O_RDWR | O_CREAT | O_EXCL, 0600, &attr);
+  if (ret >= 0)
+    {
+      file_mq_unlink(name);
+    }
+
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: bench_wdog_driver
+ *
+ * Description:
+ *   A watchdog restarts itself with a delay of one tick.  A sample is the
+ *   deviation of the time between two expirations from one tick.
+ *
+ ****************************************************************************/
+
+static void bench_wdog_callback(wdparm_t arg)
+{
+  clock_t period = (clock_t)arg;
+  clock_t now = perf_gettime();
+  clock_t elapsed;
+
+  if (g_bench.stamp != 0)
+    {
+      elapsed = now - g_bench.stamp;
+      bench_sample(elapsed > period ? elapsed - period : period - elapsed);
+    }
+
+  g_bench.stamp = now;
+
+  if (g_bench.stat.samples < BENCH_WDOG_SAMPLES)
+    {
+      wd_start(&g_bench.wdog, 1, bench_wdog_callback, arg);
+    }
+  else
+    {
+      nxsem_post(&g_bench.sem);
+    }
+}
+
+static void bench_wdog_driver(void)
+{
+  clock_t period = (uint64_t)perf_getfreq() * USEC_PER_TICK / USEC_PER_SEC;
+
+  g_bench.stamp = 0;
+  if (wd_start(&g_bench.wdog, 1, bench_wdog_callback, period) >= 0)
+    {
+      nxsem_wait_uninterruptible(&g_bench.sem);
+    }
+}
+
+/****************************************************************************
+ * Name: bench_driver_main, bench_peer_main
+ *
+ * Description:
+ *   The entry points of the benchmark threads.
+ *
+ ****************************************************************************/
+
+static int bench_driver_main(int argc, FAR char *argv[])
+{
+  nxsem_wait_uninterruptible(&g_bench.start);
+  g_bench.bench->driver();
+  nxsem_post(&g_bench.done);
+  return 0;
+}
+
+static int bench_peer_main(int argc, FAR char *argv[])
+{
+  nxsem_wait_uninterruptible(&g_bench.start);
+  if (!g_bench.stop)
+    {
+      g_bench.bench->peer();
+    }
+
+  nxsem_post(&g_bench.done);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: bench_create
+ *
+ * Description:
+ *   Create a benchmark thread.  In SMP mode all benchmark threads run on
+ *   the same CPU.
+ *
+ ****************************************************************************/
+
+static int bench_create(int priority, main_t entry, int cpu)
+{
+  int pid;
+#ifdef CONFIG_SMP
+  cpu_set_t cpuset;
+#endif
+
+  pid = kthread_create(g_bench.bench->name, priority, BENCH_STACKSIZE,
+                       entry, NULL);
+#ifdef CONFIG_SMP
+  if (pid > 0)
+    {
+      CPU_ZERO(&cpuset);
+      CPU_SET(cpu, &cpuset);
+      nxsched_set_affinity(pid, sizeof(cpuset), &cpuset);
+    }
+#else
+  UNUSED(cpu);
+#endif
+
+  return pid;
+}
+
+/****************************************************************************
+ * Name: bench_run
+ *
+ * Description:
+ *   Run one benchmark and wait until it has finished.
+ *
+ ****************************************************************************/
+
+static int bench_run(FAR const struct bench_s *bench, int cpu)
+{
+  int nthreads = 0;
+  int ret = OK;
+  int i;
+
+  memset(&g_bench.stat, 0, sizeof(g_bench.stat));
+  g_bench.bench = bench;
+  g_bench.stop  = false;
+
+  if (bench->peer != NULL)
+    {
+      ret = bench_create(BENCH_PRIORITY + bench->boost, bench_peer_main,
+                         cpu);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      nthreads++;
+    }
+
+  ret = bench_create(BENCH_PRIORITY, bench_driver_main, cpu);
+  if (ret < 0)
+    {
+      /* Let the peer finish without running */
+
+      g_bench.stop = true;
+    }
+  else
+    {
+      nthreads++;
+    }
+
+  /* Start the threads together:  The peer of the context switch benchmark
+   * must not run before the driver is ready to run.
+   */
+
+  sched_lock();
+  for (i = 0; i < nthreads; i++)
+    {
+      nxsem_post(&g_bench.start);
+    }
+
+  sched_unlock();
+
+  for (i = 0; i < nthreads; i++)
+    {
+      nxsem_wait_uninterruptible(&g_bench.done);
+    }
+
+  return ret < 0 ? ret : OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_benchmark
+ *
+ * Description:
+ *   Run the benchmarks of the scheduler primitives.
+ *
+ ****************************************************************************/
+
+int nxsched_benchmark(FAR struct sched_benchmark_s *results, int nresults)
+{
+  FAR const struct bench_s *bench;
+  FAR struct bench_stat_s *stat = &g_bench.stat;
+  int cpu = this_cpu();
+  int ret;
+  int i;
+
+  DEBUGASSERT(results != NULL || nresults == 0);
+
+  ret = nxmutex_lock(&g_bench.lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+#ifndef CONFIG_DISABLE_MQUEUE
+  ret = bench_mq_open(&g_bench.req, "/schedbench.req");
+  if (ret < 0)
+    {
+      goto errout_with_lock;
+    }
+
+  ret = bench_mq_open(&g_bench.rsp, "/schedbench.rsp");
+  if (ret < 0)
+    {
+      goto errout_with_req;
+    }
+#endif
+
+  for (i = 0; i < nresults && i < BENCH_NBENCHMARKS; i++)
+    {
+      bench = &g_benchmarks[i];
+
+      ret = bench_run(bench, cpu);
+      if (ret < 0)
+        {
+          serr("ERROR: Benchmark %s failed: %d\n", bench->name, ret);
+          break;
+        }
+
+      results[i].name    = bench->name;
+      results[i].samples = stat->samples;
+      results[i].min     = bench_nsec(stat->min);
+      results[i].max     = bench_nsec(stat->max);
+      results[i].avg     = stat->samples == 0 ? 0 :
+                           bench_nsec(stat->sum / stat->samples);
+    }
+
+  if (i > 0)
+    {
+      ret = i;
+    }
+
+#ifndef CONFIG_DISABLE_MQUEUE
+  file_mq_close(&g_bench.rsp);
+
+errout_with_req:
+  file_mq_close(&g_bench.req);
+
+errout_with_lock:
+#endif
+  nxmutex_unlock(&g_bench.lock);
+  return ret;
+}
@@ -0,0 +1,128 @@
+/****************************************************************************
+ * sched/instrument/boottrace.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/boottrace.h>
+#include <nuttx/spinlock.h>
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The records are in static memory, so that they can be added before the
+ * heap exists.
+ */
+
+static struct boottrace_s g_boottrace[CONFIG_SCHED_BOOTTRACE_NRECORDS];
+static int g_boottrace_nrecords;
+static uint32_t g_boottrace_dropped;
+static spinlock_t g_boottrace_lock = SP_UNLOCKED;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: boottrace_record
+ *
+ * Description:
+ *   Add a record of 'type' named by the format 'fmt'.
+ *
+ ****************************************************************************/
+
+void boottrace_record(int type, FAR const IPTR char *fmt, ...)
+{
+  FAR struct boottrace_s *record;
+  irqstate_t flags;
+  va_list ap;
+
+  flags = spin_lock_irqsave(&g_boottrace_lock);
+
+  if (g_boottrace_nrecords >= CONFIG_SCHED_BOOTTRACE_NRECORDS)
+    {
+      g_boottrace_dropped++;
+    }
+  else
+    {
+      record       = &g_boottrace[g_boottrace_nrecords++];
+      record->time = up_perf_gettime();
+      record->type = type;
+      record->cpu  = up_cpu_index();
+
+      va_start(ap, fmt);
+      vsnprintf(record->name, sizeof(record->name), fmt, ap);
+      va_end(ap);
+    }
+
+  spin_unlock_irqrestore(&g_boottrace_lock, flags);
+}
+
+/****************************************************************************
+ * Name: boottrace_get
+ *
+ * Description:
+ *   Get a copy of record 'index'.
+ *
+ ****************************************************************************/
+
+int boottrace_get(int index, FAR struct boottrace_s *record)
+{
+  irqstate_t flags;
+  int ret = OK;
+
+  flags = spin_lock_irqsave(&g_boottrace_lock);
+
+  if (index < 0 || index >= g_boottrace_nrecords)
+    {
+      ret = -ENOENT;
+    }
+  else
+    {
+      *record = g_boottrace[index];
+    }
+
+  spin_unlock_irqrestore(&g_boottrace_lock, flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: boottrace_dropped
+ *
+ * Description:
+ *   Return the number of records that were dropped.
+ *
+ ****************************************************************************/
+
+uint32_t boottrace_dropped(void)
+{
+  return g_boottrace_dropped;
+}
@@ -0,0 +1,364 @@
+/****************************************************************************
+ * sched/instrument/cpuprof.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/cpuprof.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wdog.h>
+
+#include "sched/sched.h"
+
+/* Each CPU samples its own running thread from the timer, or from the SMP
+ * call of the CPU that runs the timer, and counts the samples in its own
+ * open addressing hash table of call stacks:  The tables are only shared
+ * with the readers of the profile, so the locks are not contended while
+ * sampling.
+ */
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define CPUPROF_NSTACKS    CONFIG_SCHED_CPUPROF_NSTACKS
+
+/* The backtrace of a sample starts in the interrupt handler:  Up to
+ * CPUPROF_ISRFRAMES frames are taken in addition to the depth of the call
+ * stacks, and dropped up to the interrupted program counter.
+ */
+
+#define CPUPROF_ISRFRAMES  8
+#define CPUPROF_NFRAMES    (CONFIG_SCHED_CPUPROF_DEPTH + CPUPROF_ISRFRAMES)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The profile of one CPU */
+
+struct cpuprof_cpu_s
+{
+  struct cpuprof_stack_s stacks[CPUPROF_NSTACKS];
+  uint32_t hashes[CPUPROF_NSTACKS];
+  uint32_t dropped;              /* Samples dropped, the table was full */
+  spinlock_t lock;               /* Lock against the readers */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int cpuprof_sample(FAR void *arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct cpuprof_cpu_s g_cpuprof[CONFIG_SMP_NCPUS];
+static struct wdog_s g_cpuprof_timer;
+static clock_t g_cpuprof_period;
+static spinlock_t g_cpuprof_lock = SP_UNLOCKED;
+
+#ifdef CONFIG_SMP
+static struct smp_call_data_s g_cpuprof_call =
+SMP_CALL_INITIALIZER(cpuprof_sample, NULL);
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cpuprof_add
+ *
+ * Description:
+ *   Count a sample of a call stack, adding the call stack if it is new.
+ *
+ ****************************************************************************/
+
+static void cpuprof_add(FAR struct cpuprof_cpu_s *prof, pid_t pid,
+                        FAR void **frames, int nframes)
+{
+  FAR struct cpuprof_stack_s *stack;
+  uint32_t hash = 2166136261u;
+  int index;
+  int i;
+
+  hash = (hash ^ (uint32_t)pid) * 16777619u;
+  for (i = 0; i < nframes; i++)
+    {
+      hash = (hash ^ (uint32_t)(uintptr_t)frames[i]) * 16777619u;
+    }
+
+  index = hash % CPUPROF_NSTACKS;
+  for (i = 0; i < CPUPROF_NSTACKS; i++)
+    {
+      stack = &prof->stacks[index];
+
+      /* A call stack is in use once it has a sample */
+
+      if (stack->count == 0)
+        {
+          memcpy(stack->frames, frames, nframes * sizeof(FAR void *));
+          stack->nframes = nframes;
+          stack->pid = pid;
+          stack->count = 1;
+          prof->hashes[index] = hash;
+          return;
+        }
+
+      if (prof->hashes[index] == hash && stack->pid == pid &&
+          stack->nframes == nframes &&
+          memcmp(stack->frames, frames, nframes * sizeof(FAR void *)) == 0)
+        {
+          stack->count++;
+          return;
+        }
+
+      index = (index + 1) % CPUPROF_NSTACKS;
+    }
+
+  prof->dropped++;
+}
+
+/****************************************************************************
+ * Name: cpuprof_sample
+ *
+ * Description:
+ *   Sample the running thread of this CPU, in interrupt context.
+ *
+ ****************************************************************************/
+
+static int cpuprof_sample(FAR void *arg)
+{
+  FAR struct cpuprof_cpu_s *prof = &g_cpuprof[this_cpu()];
+  FAR struct tcb_s *tcb = this_task();
+  FAR void *frames[CPUPROF_NFRAMES];
+  FAR void *pc = (FAR void *)up_getusrpc(NULL);
+  int nframes;
+  int skip;
+
+  nframes = up_backtrace(tcb, frames, CPUPROF_NFRAMES, 0);
+  if (nframes <= 0)
+    {
+      frames[0] = pc;
+      nframes = pc != NULL;
+    }
+
+  /* Drop the frames of the interrupt handler, if the interrupted program
+   * counter is found in the backtrace.
+   */
+
+  for (skip = 0; skip < nframes && frames[skip] != pc; skip++)
+    {
+    }
+
+  if (skip < nframes)
+    {
+      nframes -= skip;
+    }
+  else
+    {
+      skip = 0;
+    }
+
+  if (nframes > CONFIG_SCHED_CPUPROF_DEPTH)
+    {
+      nframes = CONFIG_SCHED_CPUPROF_DEPTH;
+    }
+
+  spin_lock(&prof->lock);
+  cpuprof_add(prof, tcb->pid, &frames[skip], nframes);
+  spin_unlock(&prof->lock);
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: cpuprof_timer
+ ****************************************************************************/
+
+static void cpuprof_timer(wdparm_t arg)
+{
+  irqstate_t flags;
+#ifdef CONFIG_SMP
+  cpu_set_t cpus = (1 << CONFIG_SMP_NCPUS) - 1;
+
+  CPU_CLR(this_cpu(), &cpus);
+  nxsched_smp_call_async(cpus, &g_cpuprof_call);
+#endif
+
+  cpuprof_sample(NULL);
+
+  /* Restart the timer unless the profiler was stopped meanwhile */
+
+  flags = spin_lock_irqsave(&g_cpuprof_lock);
+  if (g_cpuprof_period > 0)
+    {
+      wd_start(&g_cpuprof_timer, g_cpuprof_period, cpuprof_timer, 0);
+    }
+
+  spin_unlock_irqrestore(&g_cpuprof_lock, flags);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cpuprof_start
+ *
+ * Description:
+ *   Start sampling all CPUs 'rate' times per second.
+ *
+ ****************************************************************************/
+
+int cpuprof_start(unsigned int rate)
+{
+  irqstate_t flags;
+  clock_t period;
+
+  if (rate == 0)
+    {
+      rate = CONFIG_SCHED_CPUPROF_RATE;
+    }
+  else if (rate > 10000)
+    {
+      return -EINVAL;
+    }
+
+  period = NSEC2TICK(NSEC_PER_SEC / rate);
+  if (period == 0)
+    {
+      period = 1;
+    }
+
+  flags = spin_lock_irqsave(&g_cpuprof_lock);
+  g_cpuprof_period = period;
+  wd_start(&g_cpuprof_timer, period, cpuprof_timer, 0);
+  spin_unlock_irqrestore(&g_cpuprof_lock, flags);
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: cpuprof_stop
+ *
+ * Description:
+ *   Stop sampling.
+ *
+ ****************************************************************************/
+
+void cpuprof_stop(void)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_cpuprof_lock);
+  g_cpuprof_period = 0;
+  wd_cancel(&g_cpuprof_timer);
+  spin_unlock_irqrestore(&g_cpuprof_lock, flags);
+}
+
+/****************************************************************************
+ * Name: cpuprof_getstack
+ *
+ * Description:
+ *   Get a copy of call stack 'index' of CPU 'cpu'.
+ *
+ ****************************************************************************/
+
+int cpuprof_getstack(int cpu, int index, FAR struct cpuprof_stack_s *stack)
+{
+  FAR struct cpuprof_cpu_s *prof;
+  irqstate_t flags;
+  int ret = OK;
+
+  if (cpu < 0 || cpu >= CONFIG_SMP_NCPUS ||
+      index < 0 || index >= CPUPROF_NSTACKS)
+    {
+      return -EINVAL;
+    }
+
+  prof  = &g_cpuprof[cpu];
+  flags = spin_lock_irqsave(&prof->lock);
+
+  if (prof->stacks[index].count == 0)
+    {
+      ret = -ENOENT;
+    }
+  else
+    {
+      *stack = prof->stacks[index];
+    }
+
+  spin_unlock_irqrestore(&prof->lock, flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: cpuprof_dropped
+ *
+ * Description:
+ *   Return the number of samples of CPU 'cpu' that were dropped.
+ *
+ ****************************************************************************/
+
+uint32_t cpuprof_dropped(int cpu)
+{
+  return cpu >= 0 && cpu < CONFIG_SMP_NCPUS ? g_cpuprof[cpu].dropped : 0;
+}
+
+/****************************************************************************
+ * Name: cpuprof_reset
+ *
+ * Description:
+ *   Forget all call stacks.
+ *
+ ****************************************************************************/
+
+void cpuprof_reset(void)
+{
+  FAR struct cpuprof_cpu_s *prof;
+  irqstate_t flags;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      prof  = &g_cpuprof[cpu];
+      flags = spin_lock_irqsave(&prof->lock);
+
+      memset(prof->stacks, 0, sizeof(prof->stacks));
+      prof->dropped = 0;
+
+      spin_unlock_irqrestore(&prof->lock, flags);
+    }
+}
@@ -36,6 +36,22 @@
 #include "irq/irq.h"
 #include "sched/sched.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* With per-CPU work queues the interrupt work is performed on the CPU that
+ * took the interrupt.
+ */
+
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+#  define IRQ_NWQUEUES      CONFIG_SMP_NCPUS
+#  define IRQ_WQUEUE_INDEX  this_cpu()
+#else
+#  define IRQ_NWQUEUES      1
+#  define IRQ_WQUEUE_INDEX  0
+#endif
+
 /****************************************************************************
  * Privte Types
  ****************************************************************************/
@@ -54,7 +70,7 @@ struct irq_work_info_s
   int irq;            /* Irq id */
   struct work_s work; /* Interrupt work to the wq */
 
-  FAR struct kwork_wqueue_s *wqueue;   /* Work queue. */
+  FAR struct kwork_wqueue_s *wqueue[IRQ_NWQUEUES];   /* Work queue(s) */
 };
 
 /****************************************************************************
@@ -69,30 +85,32 @@ static struct irq_work_info_s g_irq_work_vector[NR_IRQS];
 #endif
 
 static mutex_t g_irq_wqueue_lock = NXMUTEX_INITIALIZER;
-static FAR struct kwork_wqueue_s *g_irq_wqueue[CONFIG_IRQ_NWORKS];
+static FAR struct kwork_wqueue_s *
+g_irq_wqueue[CONFIG_IRQ_NWORKS][IRQ_NWQUEUES];
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
 static
-inline_function FAR struct kwork_wqueue_s *irq_get_wqueue(int priority)
+inline_function FAR struct kwork_wqueue_s *irq_get_wqueue(int priority,
+                                                          int index)
 {
   FAR struct kwork_wqueue_s *queue;
   int wqueue_priority;
   int i;
 
   nxmutex_lock(&g_irq_wqueue_lock);
-  for (i = 0; g_irq_wqueue[i] != NULL && i < CONFIG_IRQ_NWORKS; i++)
+  for (i = 0; g_irq_wqueue[i][index] != NULL && i < CONFIG_IRQ_NWORKS; i++)
     {
-      wqueue_priority = work_queue_priority_wq(g_irq_wqueue[i]);
+      wqueue_priority = work_queue_priority_wq(g_irq_wqueue[i][index]);
       DEBUGASSERT(wqueue_priority >= SCHED_PRIORITY_MIN &&
                   wqueue_priority <= SCHED_PRIORITY_MAX);
 
       if (wqueue_priority == priority)
         {
           nxmutex_unlock(&g_irq_wqueue_lock);
-          return g_irq_wqueue[i];
+          return g_irq_wqueue[i][index];
         }
     }
 
@@ -101,7 +119,14 @@ inline_function FAR struct kwork_wqueue_s *irq_get_wqueue(int priority)
   queue = work_queue_create("isrwork", priority,
                             CONFIG_IRQ_WORK_STACKSIZE, 1);
 
-  g_irq_wqueue[i] = queue;
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  if (queue != NULL)
+    {
+      DEBUGVERIFY(work_queue_bind_wq(queue, index));
+    }
+#endif
+
+  g_irq_wqueue[i][index] = queue;
   nxmutex_unlock(&g_irq_wqueue_lock);
   return queue;
 }
@@ -126,7 +151,8 @@ static int irq_default_handler(int irq, FAR void *regs, FAR void *arg)
 
   if (ret == IRQ_WAKE_THREAD)
     {
-      work_queue_wq(info->wqueue, &info->work, irq_work_handler, info, 0);
+      work_queue_wq(info->wqueue[IRQ_WQUEUE_INDEX], &info->work,
+                    irq_work_handler, info, 0);
       ret = OK;
     }
 
@@ -166,6 +192,7 @@ int irq_attach_wqueue(int irq, xcpt_t isr, xcpt_t isrwork,
 
 #if NR_IRQS > 0
   int ndx;
+  int i;
 
   if ((unsigned)irq >= NR_IRQS)
     {
@@ -188,7 +215,12 @@ int irq_attach_wqueue(int irq, xcpt_t isr, xcpt_t isrwork,
       info->isrwork = NULL;
       info->handler = NULL;
       info->arg     = NULL;
-      info->wqueue  = NULL;
+
+      for (i = 0; i < IRQ_NWQUEUES; i++)
+        {
+          info->wqueue[i] = NULL;
+        }
+
       return OK;
     }
 
@@ -196,9 +228,12 @@ int irq_attach_wqueue(int irq, xcpt_t isr, xcpt_t isrwork,
   info->handler = isr;
   info->arg     = arg;
   info->irq     = irq;
-  if (info->wqueue == NULL)
+  for (i = 0; i < IRQ_NWQUEUES; i++)
     {
-      info->wqueue = irq_get_wqueue(priority);
+      if (info->wqueue[i] == NULL)
+        {
+          info->wqueue[i] = irq_get_wqueue(priority, i);
+        }
     }
 
   irq_attach(irq, irq_default_handler, info);
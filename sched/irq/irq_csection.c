@@ -30,6 +30,7 @@
 #include <assert.h>
 
 #include <nuttx/init.h>
+#include <nuttx/lockstat.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/sched_note.h>
 #include <arch/irq.h>
@@ -71,6 +72,17 @@ volatile cpu_set_t g_cpu_irqset;
 volatile uint8_t g_cpu_nestcount[CONFIG_SMP_NCPUS];
 #endif
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+/* Contention statistics of g_cpu_irqlock */
+
+static struct lockstat_s g_cpu_irqlockstat =
+  LOCKSTAT_INITIALIZER("csection");
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -181,7 +193,7 @@ irqstate_t enter_critical_section(void)
                * no longer blocked by the critical section).
                */
 
-              spin_lock(&g_cpu_irqlock);
+              lockstat_spin_lock(&g_cpu_irqlock, &g_cpu_irqlockstat);
               cpu_irqlock_set(cpu);
             }
 
@@ -232,7 +244,7 @@ irqstate_t enter_critical_section(void)
 
           DEBUGASSERT((g_cpu_irqset & (1 << cpu)) == 0);
 
-          spin_lock(&g_cpu_irqlock);
+          lockstat_spin_lock(&g_cpu_irqlock, &g_cpu_irqlockstat);
 
           /* Then set the lock count to 1.
            *
@@ -28,6 +28,7 @@
 
 #include <debug.h>
 #include <nuttx/arch.h>
+#include <nuttx/critmon.h>
 #include <nuttx/irq.h>
 #include <nuttx/mm/mm.h>
 #include <nuttx/random.h>
@@ -51,6 +52,13 @@
  * interrupt request
  */
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+#  define IRQ_HISTOGRAM(vector, elapsed) \
+     nxsched_critmon_histogram(CRITMON_IRQ, (FAR void *)(vector), elapsed)
+#else
+#  define IRQ_HISTOGRAM(vector, elapsed)
+#endif
+
 #ifdef CONFIG_SCHED_IRQMONITOR
 #  define CALL_VECTOR(ndx, vector, irq, context, arg) \
      do \
@@ -60,6 +68,7 @@
          start = perf_gettime(); \
          vector(irq, context, arg); \
          elapsed = perf_gettime() - start; \
+         IRQ_HISTOGRAM(vector, elapsed); \
          if (ndx < NUSER_IRQS) \
            { \
              g_irqvector[ndx].count++; \
@@ -0,0 +1,415 @@
+/****************************************************************************
+ * sched/irq/irq_lockstat.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/stat.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/lockstat.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Output format:
+ *
+ *            1111111111222222222233333333334444444444555555555566
+ *   1234567890123456789012345678901234567890123456789012345678901
+ *
+ *   LOCK               ACQUIRED  CONTENDED      SPIN(us)   MAX(us)
+ *   SSSSSSSSSSSSSSSS DDDDDDDDDD DDDDDDDDDD DDDDDDDDDDDDD DDDDDDDDD
+ */
+
+#define HDR_FMT  "LOCK               ACQUIRED  CONTENDED      SPIN(us)" \
+                 "   MAX(us)\n"
+#define LOCK_FMT "%-16s %10lu %10lu %13llu %9lu\n"
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic (plus a couple of
+ * bytes).
+ */
+
+#define LOCKSTAT_LINELEN 80
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct lockstat_file_s
+{
+  struct procfs_file_s base;     /* Base open file structure */
+  char line[LOCKSTAT_LINELEN];   /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+/* File system methods */
+
+static int     lockstat_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     lockstat_close(FAR struct file *filep);
+static ssize_t lockstat_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     lockstat_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     lockstat_stat(FAR const char *relpath, FAR struct stat *buf);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* All locks that have been taken at least once.  Entries are only ever
+ * added at the head so the report may walk the list without the lock.
+ */
+
+static FAR struct lockstat_s *g_lockstat_head;
+static spinlock_t g_lockstat_lock = SP_UNLOCKED;
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+/* See fs_mount.c -- this structure is explicitly extern'ed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_lockstat_operations =
+{
+  lockstat_open,       /* open */
+  lockstat_close,      /* close */
+  lockstat_read,       /* read */
+  NULL,                /* write */
+  NULL,                /* poll */
+
+  lockstat_dup,        /* dup */
+
+  NULL,                /* opendir */
+  NULL,                /* closedir */
+  NULL,                /* readdir */
+  NULL,                /* rewinddir */
+
+  lockstat_stat        /* stat */
+};
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lockstat_register
+ *
+ * Description:
+ *   Add a lock to the report.  Called by the holder of the lock so the
+ *   same statistics cannot be registered twice.
+ *
+ ****************************************************************************/
+
+static void lockstat_register(FAR struct lockstat_s *stat)
+{
+  spin_lock_wo_note(&g_lockstat_lock);
+
+  stat->flink      = g_lockstat_head;
+  stat->registered = true;
+  SP_DMB();
+  g_lockstat_head  = stat;
+
+  spin_unlock_wo_note(&g_lockstat_lock);
+}
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+
+/****************************************************************************
+ * Name: lockstat_open
+ ****************************************************************************/
+
+static int lockstat_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct lockstat_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* This PROCFS file is read-only.  Any attempt to open with write access
+   * is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = kmm_zalloc(sizeof(struct lockstat_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lockstat_close
+ ****************************************************************************/
+
+static int lockstat_close(FAR struct file *filep)
+{
+  FAR struct lockstat_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct lockstat_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lockstat_read
+ ****************************************************************************/
+
+static ssize_t lockstat_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR struct lockstat_file_s *attr;
+  FAR struct lockstat_s *stat;
+  struct timespec spin;
+  struct timespec max;
+  unsigned long long spinus;
+  unsigned long maxus;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct lockstat_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset = filep->f_pos;
+
+  /* The first line to output is the header */
+
+  linesize  = procfs_snprintf(attr->line, LOCKSTAT_LINELEN, HDR_FMT);
+  copysize  = procfs_memcpy(attr->line, linesize, buffer, buflen, &offset);
+  totalsize = copysize;
+
+  /* Then one line per lock.  The counters are sampled without the lock so
+   * the values of one line may be slightly inconsistent.
+   */
+
+  for (stat = g_lockstat_head; stat != NULL && totalsize < buflen;
+       stat = stat->flink)
+    {
+      up_perf_convert(stat->spintime, &spin);
+      up_perf_convert(stat->maxspin, &max);
+
+      spinus = (unsigned long long)spin.tv_sec * USEC_PER_SEC +
+               spin.tv_nsec / NSEC_PER_USEC;
+      maxus  = (unsigned long)max.tv_sec * USEC_PER_SEC +
+               max.tv_nsec / NSEC_PER_USEC;
+
+      linesize = procfs_snprintf(attr->line, LOCKSTAT_LINELEN, LOCK_FMT,
+                                 stat->name,
+                                 (unsigned long)stat->acquired,
+                                 (unsigned long)stat->contended,
+                                 spinus, maxus);
+      copysize = procfs_memcpy(attr->line, linesize, buffer + totalsize,
+                               buflen - totalsize, &offset);
+
+      totalsize += copysize;
+    }
+
+  /* Update the file position */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: lockstat_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int lockstat_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct lockstat_file_s *oldattr;
+  FAR struct lockstat_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct lockstat_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct lockstat_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct lockstat_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lockstat_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int lockstat_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "lockstat" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lockstat_spin_lock
+ *
+ * Description:
+ *   Take a spinlock like spin_lock() and account for the time spent
+ *   waiting for it.
+ *
+ * Input Parameters:
+ *   lock - The spinlock to take
+ *   stat - The statistics of that spinlock
+ *
+ * Assumptions:
+ *   Interrupts are disabled on the local CPU.
+ *
+ ****************************************************************************/
+
+void lockstat_spin_lock(FAR volatile spinlock_t *lock,
+                        FAR struct lockstat_s *stat)
+{
+  clock_t start;
+  clock_t spin;
+
+  DEBUGASSERT(lock != NULL && stat != NULL);
+
+  if (spin_trylock(lock))
+    {
+      stat->acquired++;
+    }
+  else
+    {
+      start = up_perf_gettime();
+      spin_lock(lock);
+      spin  = up_perf_gettime() - start;
+
+      stat->acquired++;
+      stat->contended++;
+      stat->spintime += spin;
+      if (spin > stat->maxspin)
+        {
+          stat->maxspin = spin;
+        }
+    }
+
+  if (!stat->registered)
+    {
+      lockstat_register(stat);
+    }
+}
+
+/****************************************************************************
+ * Name: lockstat_spin_lock_irqsave
+ *
+ * Description:
+ *   Equivalent to spin_lock_irqsave() for a non-NULL lock, with the same
+ *   accounting as lockstat_spin_lock().
+ *
+ ****************************************************************************/
+
+irqstate_t lockstat_spin_lock_irqsave(FAR volatile spinlock_t *lock,
+                                      FAR struct lockstat_s *stat)
+{
+  irqstate_t flags = up_irq_save();
+
+  lockstat_spin_lock(lock, stat);
+  return flags;
+}
+
+#endif /* CONFIG_SCHED_LOCKSTAT */
@@ -64,6 +64,7 @@ struct elf_dumpinfo_s
 {
   FAR const struct memory_region_s *regions;
   FAR struct lib_outstream_s *stream;
+  FAR struct tcb_s           *first;  /* The crashing task, dumped first */
   pid_t                       pid;
 };
 
@@ -73,7 +74,9 @@ struct elf_dumpinfo_s
 
 static uint8_t g_running_regs[XCPTCONTEXT_SIZE] aligned_data(16);
 
-#ifdef CONFIG_BOARD_COREDUMP_COMPRESSION
+#ifdef CONFIG_BOARD_COREDUMP_COMPRESSION_LZ4
+static struct lib_lz4outstream_s  g_lz4stream;
+#elif defined(CONFIG_BOARD_COREDUMP_COMPRESSION)
 static struct lib_lzfoutstream_s  g_lzfstream;
 #endif
 
@@ -99,6 +102,10 @@ static struct memory_region_s g_memory_region[] =
 #endif
 static const struct memory_region_s *g_regions;
 
+#ifdef CONFIG_BOARD_COREDUMP_BLKDEV_CHECKPOINT
+static CODE void (*g_checkpoint)(void);
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -120,6 +127,26 @@ static int elf_flush(FAR struct elf_dumpinfo_s *cinfo)
   return lib_stream_flush(cinfo->stream);
 }
 
+/****************************************************************************
+ * Name: elf_checkpoint
+ *
+ * Description:
+ *   Flush the out stream and let the device record what was dumped so far,
+ *   so that a reset in the middle of the dump keeps a truncated core dump.
+ *
+ ****************************************************************************/
+
+static void elf_checkpoint(FAR struct elf_dumpinfo_s *cinfo)
+{
+#ifdef CONFIG_BOARD_COREDUMP_BLKDEV_CHECKPOINT
+  if (g_checkpoint != NULL)
+    {
+      elf_flush(cinfo);
+      g_checkpoint();
+    }
+#endif
+}
+
 /****************************************************************************
  * Name: elf_emit
  *
@@ -349,20 +376,20 @@ static void elf_emit_note(FAR struct elf_dumpinfo_s *cinfo)
 {
   int i;
 
+  /* The crashing task first, the debugger shows it as the current thread */
+
+  elf_emit_tcb_note(cinfo, cinfo->first);
+
   if (cinfo->pid == INVALID_PROCESS_ID)
     {
       for (i = 0; i < g_npidhash; i++)
         {
-          if (g_pidhash[i] != NULL)
+          if (g_pidhash[i] != NULL && g_pidhash[i] != cinfo->first)
             {
               elf_emit_tcb_note(cinfo, g_pidhash[i]);
             }
         }
     }
-  else
-    {
-      elf_emit_tcb_note(cinfo, nxsched_get_tcb(cinfo->pid));
-    }
 }
 
 /****************************************************************************
@@ -431,68 +458,93 @@ static void elf_emit_stack(FAR struct elf_dumpinfo_s *cinfo)
 {
   int i;
 
+  /* The stack of the crashing task first */
+
+  elf_emit_tcb_stack(cinfo, cinfo->first);
+  elf_checkpoint(cinfo);
+
   if (cinfo->pid == INVALID_PROCESS_ID)
     {
       for (i = 0; i < g_npidhash; i++)
         {
-          if (g_pidhash[i] != NULL)
+          if (g_pidhash[i] != NULL && g_pidhash[i] != cinfo->first)
             {
               elf_emit_tcb_stack(cinfo, g_pidhash[i]);
             }
         }
+
+      elf_checkpoint(cinfo);
+    }
+}
+
+/****************************************************************************
+ * Name: elf_emit_region
+ *
+ * Description:
+ *   Fill the memory of a region
+ *
+ ****************************************************************************/
+
+static void elf_emit_region(FAR struct elf_dumpinfo_s *cinfo,
+                            FAR const struct memory_region_s *region)
+{
+  if (region->flags & PF_REGISTER)
+    {
+      FAR uintptr_t *start = (FAR uintptr_t *)region->start;
+      FAR uintptr_t *end = (FAR uintptr_t *)region->end;
+      uintptr_t buf[64];
+      size_t offset = 0;
+
+      while (start < end)
+        {
+          buf[offset++] = *start++;
+
+          if (offset % (sizeof(buf) / sizeof(uintptr_t)) == 0)
+            {
+              elf_emit(cinfo, buf, sizeof(buf));
+              offset = 0;
+            }
+        }
+
+      if (offset != 0)
+        {
+          elf_emit(cinfo, buf, offset * sizeof(uintptr_t));
+        }
     }
   else
     {
-      elf_emit_tcb_stack(cinfo, nxsched_get_tcb(cinfo->pid));
+      elf_emit(cinfo, (FAR void *)region->start,
+               region->end - region->start);
     }
+
+  /* Align to page */
+
+  elf_emit_align(cinfo);
 }
 
 /****************************************************************************
  * Name: elf_emit_memory
  *
  * Description:
- *   Fill the note segment information
+ *   Fill the memory of the regions, in the order of their PF_PRIO()
  *
  ****************************************************************************/
 
 static void elf_emit_memory(FAR struct elf_dumpinfo_s *cinfo, int memsegs)
 {
+  uint32_t prio;
   int i;
 
-  for (i = 0; i < memsegs; i++)
+  for (prio = 0; prio <= PF_PRIO_MASK; prio += PF_PRIO(1))
     {
-      if (cinfo->regions[i].flags & PF_REGISTER)
+      for (i = 0; i < memsegs; i++)
         {
-          FAR uintptr_t *start = (FAR uintptr_t *)cinfo->regions[i].start;
-          FAR uintptr_t *end = (FAR uintptr_t *)cinfo->regions[i].end;
-          uintptr_t buf[64];
-          size_t offset = 0;
-
-          while (start < end)
-            {
-              buf[offset++] = *start++;
-
-              if (offset % (sizeof(buf) / sizeof(uintptr_t)) == 0)
-                {
-                  elf_emit(cinfo, buf, sizeof(buf));
-                  offset = 0;
-                }
-            }
-
-          if (offset != 0)
+          if ((cinfo->regions[i].flags & PF_PRIO_MASK) == prio)
             {
-              elf_emit(cinfo, buf, offset * sizeof(uintptr_t));
+              elf_emit_region(cinfo, &cinfo->regions[i]);
+              elf_checkpoint(cinfo);
             }
         }
-      else
-        {
-          elf_emit(cinfo, (FAR void *)cinfo->regions[i].start,
-                   cinfo->regions[i].end - cinfo->regions[i].start);
-        }
-
-      /* Align to page */
-
-      elf_emit_align(cinfo);
     }
 }
 
@@ -569,6 +621,7 @@ static void elf_emit_phdr(FAR struct elf_dumpinfo_s *cinfo,
   off_t offset = cinfo->stream->nput +
                  (stksegs + memsegs + 1) * sizeof(Elf_Phdr);
   Elf_Phdr phdr;
+  uint32_t prio;
   int i;
 
   memset(&phdr, 0, sizeof(Elf_Phdr));
@@ -580,36 +633,45 @@ static void elf_emit_phdr(FAR struct elf_dumpinfo_s *cinfo,
 
   elf_emit(cinfo, &phdr, sizeof(phdr));
 
+  /* The segments in the order they are dumped, see elf_emit_stack() and
+   * elf_emit_memory().
+   */
+
   phdr.p_align  = ELF_PAGESIZE;
+  elf_emit_tcb_phdr(cinfo, cinfo->first, &phdr, &offset);
+
   if (cinfo->pid == INVALID_PROCESS_ID)
     {
       for (i = 0; i < g_npidhash; i++)
         {
-          if (g_pidhash[i] != NULL)
+          if (g_pidhash[i] != NULL && g_pidhash[i] != cinfo->first)
             {
               elf_emit_tcb_phdr(cinfo, g_pidhash[i], &phdr, &offset);
             }
         }
     }
-  else
-    {
-      elf_emit_tcb_phdr(cinfo, nxsched_get_tcb(cinfo->pid),
-                        &phdr, &offset);
-    }
 
   /* Write program headers for segments dump */
 
-  for (i = 0; i < memsegs; i++)
+  for (prio = 0; prio <= PF_PRIO_MASK; prio += PF_PRIO(1))
     {
-      phdr.p_type   = PT_LOAD;
-      phdr.p_offset = ROUNDUP(offset, ELF_PAGESIZE);
-      phdr.p_vaddr  = cinfo->regions[i].start;
-      phdr.p_paddr  = phdr.p_vaddr;
-      phdr.p_filesz = cinfo->regions[i].end - cinfo->regions[i].start;
-      phdr.p_memsz  = phdr.p_filesz;
-      phdr.p_flags  = cinfo->regions[i].flags;
-      offset       += ROUNDUP(phdr.p_memsz, ELF_PAGESIZE);
-      elf_emit(cinfo, &phdr, sizeof(phdr));
+      for (i = 0; i < memsegs; i++)
+        {
+          if ((cinfo->regions[i].flags & PF_PRIO_MASK) != prio)
+            {
+              continue;
+            }
+
+          phdr.p_type   = PT_LOAD;
+          phdr.p_offset = ROUNDUP(offset, ELF_PAGESIZE);
+          phdr.p_vaddr  = cinfo->regions[i].start;
+          phdr.p_paddr  = phdr.p_vaddr;
+          phdr.p_filesz = cinfo->regions[i].end - cinfo->regions[i].start;
+          phdr.p_memsz  = phdr.p_filesz;
+          phdr.p_flags  = cinfo->regions[i].flags & ~PF_PRIO_MASK;
+          offset       += ROUNDUP(phdr.p_memsz, ELF_PAGESIZE);
+          elf_emit(cinfo, &phdr, sizeof(phdr));
+        }
     }
 }
 
@@ -646,7 +708,13 @@ static void coredump_dump_syslog(pid_t pid)
   streamname = "hex";
 #endif
 
-#  ifdef CONFIG_BOARD_COREDUMP_COMPRESSION
+#  ifdef CONFIG_BOARD_COREDUMP_COMPRESSION_LZ4
+
+  /* Initialize LZ4 compression stream */
+
+  lib_lz4outstream(&g_lz4stream, stream);
+  stream = &g_lz4stream;
+#  elif defined(CONFIG_BOARD_COREDUMP_COMPRESSION)
 
   /* Initialize LZF compression stream */
 
@@ -669,6 +737,47 @@ static void coredump_dump_syslog(pid_t pid)
 }
 #endif
 
+/****************************************************************************
+ * Name: coredump_blkdev_info
+ *
+ * Description:
+ *   Write the information of the coredump, with the size dumped so far, at
+ *   the end of the block device.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_BOARD_COREDUMP_BLKDEV
+static int coredump_blkdev_info(void)
+{
+  FAR struct coredump_info_s *info;
+  blkcnt_t nsectors;
+
+  nsectors = (sizeof(struct coredump_info_s) +
+              g_blockstream.geo.geo_sectorsize - 1) /
+             g_blockstream.geo.geo_sectorsize;
+
+  info = (FAR struct coredump_info_s *)g_blockinfo;
+  info->magic = COREDUMP_MAGIC;
+  info->size  = g_blockstream.common.nput;
+  clock_gettime(CLOCK_REALTIME, &info->time);
+  uname(&info->name);
+
+  return g_blockstream.inode->u.i_bops->write(g_blockstream.inode,
+      (FAR void *)info, g_blockstream.geo.geo_nsectors - nsectors, nsectors);
+}
+
+/****************************************************************************
+ * Name: coredump_blkdev_checkpoint
+ ****************************************************************************/
+
+#  ifdef CONFIG_BOARD_COREDUMP_BLKDEV_CHECKPOINT
+static void coredump_blkdev_checkpoint(void)
+{
+  coredump_blkdev_info();
+}
+#  endif
+#endif
+
 /****************************************************************************
  * Name: coredump_dump_blkdev
  *
@@ -705,25 +814,33 @@ static void coredump_dump_blkdev(pid_t pid)
 
   info = (FAR struct coredump_info_s *)g_blockinfo;
 
-#ifdef CONFIG_BOARD_COREDUMP_COMPRESSION
+#ifdef CONFIG_BOARD_COREDUMP_COMPRESSION_LZ4
+  lib_lz4outstream(&g_lz4stream,
+                   (FAR struct lib_outstream_s *)&g_blockstream);
+  stream = &g_lz4stream;
+#elif defined(CONFIG_BOARD_COREDUMP_COMPRESSION)
   lib_lzfoutstream(&g_lzfstream,
                    (FAR struct lib_outstream_s *)&g_blockstream);
   stream = &g_lzfstream;
 #endif
 
+#ifdef CONFIG_BOARD_COREDUMP_BLKDEV_CHECKPOINT
+  g_checkpoint = coredump_blkdev_checkpoint;
+#endif
+
   ret = coredump(g_regions, stream, pid);
+
+#ifdef CONFIG_BOARD_COREDUMP_BLKDEV_CHECKPOINT
+  g_checkpoint = NULL;
+#endif
+
   if (ret < 0)
     {
       _alert("Coredump fail\n");
       return;
     }
 
-  info->magic = COREDUMP_MAGIC;
-  info->size  = g_blockstream.common.nput;
-  clock_gettime(CLOCK_REALTIME, &info->time);
-  uname(&info->name);
-  ret = g_blockstream.inode->u.i_bops->write(g_blockstream.inode,
-      (FAR void *)info, g_blockstream.geo.geo_nsectors - nsectors, nsectors);
+  ret = coredump_blkdev_info();
   if (ret < 0)
     {
       _alert("Coredump information write fail\n");
@@ -940,7 +1057,8 @@ int coredump(FAR const struct memory_region_s *regions,
 
   if (cinfo.pid != INVALID_PROCESS_ID)
     {
-      if (nxsched_get_tcb(cinfo.pid) == NULL)
+      cinfo.first = nxsched_get_tcb(cinfo.pid);
+      if (cinfo.first == NULL)
         {
           leave_critical_section(flags);
           return -EINVAL;
@@ -950,6 +1068,7 @@ int coredump(FAR const struct memory_region_s *regions,
     }
   else
     {
+      cinfo.first = running_task();
       stksegs = elf_get_ntcb();
     }
 
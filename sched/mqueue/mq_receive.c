@@ -140,10 +140,8 @@ ssize_t file_mq_timedreceive_internal(FAR struct file *mq, FAR char *msg,
                                       FAR const struct timespec *abstime,
                                       sclock_t ticks)
 {
-  FAR struct mqueue_inode_s *msgq;
   FAR struct mqueue_msg_s *mqmsg;
-  irqstate_t flags;
-  ssize_t ret = 0;
+  ssize_t ret;
 
   DEBUGASSERT(up_interrupt_context() == false);
 
@@ -171,6 +169,64 @@ ssize_t file_mq_timedreceive_internal(FAR struct file *mq, FAR char *msg,
     }
 #endif
 
+  ret = nxmq_dequeue_msg(mq, &mqmsg, abstime, ticks);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Return the message to the caller */
+
+  if (prio)
+    {
+      *prio = mqmsg->priority;
+    }
+
+  memcpy(msg, mqmsg->mail, mqmsg->msglen);
+  ret = mqmsg->msglen;
+
+  /* Free the message structure */
+
+  nxmq_free_msg(mqmsg);
+
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmq_dequeue_msg
+ *
+ * Description:
+ *   This is internal, common logic shared by [nx]mq_receive,
+ *   [nx]mq_timedreceive and mq_peek.  Remove the oldest of the highest
+ *   priority messages from the message queue, waiting for a message if
+ *   necessary.  The caller owns the message and must free it with
+ *   nxmq_free_msg().
+ *
+ * Input Parameters:
+ *   mq      - Message Queue Descriptor
+ *   rcvmsg  - The location to return the message
+ *   abstime - the absolute time to wait until a timeout is declared.
+ *   ticks   - Ticks to wait from the start time until the semaphore is
+ *             posted.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned
+ *   on failure (see file_mq_timedreceive()).
+ *
+ ****************************************************************************/
+
+int nxmq_dequeue_msg(FAR struct file *mq, FAR struct mqueue_msg_s **rcvmsg,
+                     FAR const struct timespec *abstime, sclock_t ticks)
+{
+  FAR struct mqueue_inode_s *msgq;
+  FAR struct mqueue_msg_s *mqmsg;
+  irqstate_t flags;
+  int ret;
+
   msgq = mq->f_inode->i_private;
 
   /* Furthermore, nxmq_wait_receive() expects to have interrupts disabled
@@ -215,27 +271,10 @@ ssize_t file_mq_timedreceive_internal(FAR struct file *mq, FAR char *msg,
 
   leave_critical_section(flags);
 
-  /* Return the message to the caller */
-
-  if (prio)
-    {
-      *prio = mqmsg->priority;
-    }
-
-  memcpy(msg, mqmsg->mail, mqmsg->msglen);
-  ret = mqmsg->msglen;
-
-  /* Free the message structure */
-
-  nxmq_free_msg(mqmsg);
-
-  return ret;
+  *rcvmsg = mqmsg;
+  return OK;
 }
 
-/****************************************************************************
- * Public Functions
- ****************************************************************************/
-
 /****************************************************************************
  * Name: file_mq_timedreceive
  *
@@ -105,85 +105,6 @@ static int nxmq_verify_send(FAR FAR struct file *mq, FAR const char *msg,
 }
 #endif
 
-/****************************************************************************
- * Name: nxmq_alloc_msg
- *
- * Description:
- *   The nxmq_alloc_msg function will get a free message for use by the
- *   operating system.  The message will be allocated from the g_msgfree
- *   list.
- *
- *   If the list is empty AND the message is NOT being allocated from the
- *   interrupt level, then the message will be allocated.  If a message
- *   cannot be obtained, the operating system is dead and therefore cannot
- *   continue.
- *
- *   If the list is empty AND the message IS being allocated from the
- *   interrupt level.  This function will attempt to get a message from
- *   the g_msgfreeirq list.  If this is unsuccessful, the calling interrupt
- *   handler will be notified.
- *
- * Input Parameters:
- *   None
- *
- * Returned Value:
- *   A reference to the allocated msg structure.  On a failure to allocate,
- *   this function PANICs.
- *
- ****************************************************************************/
-
-static FAR struct mqueue_msg_s *nxmq_alloc_msg(uint16_t msgsize)
-{
-  FAR struct mqueue_msg_s *mqmsg;
-  irqstate_t flags;
-
-  /* Try to get the message from the generally available free list. */
-
-  flags = spin_lock_irqsave(NULL);
-  mqmsg = (FAR struct mqueue_msg_s *)list_remove_head(&g_msgfree);
-  spin_unlock_irqrestore(NULL, flags);
-  if (mqmsg == NULL)
-    {
-      /* If we were called from an interrupt handler, then try to get the
-       * message from generally available list of messages. If this fails,
-       * then try the list of messages reserved for interrupt handlers
-       */
-
-      if (up_interrupt_context())
-        {
-          /* Try the free list reserved for interrupt handlers */
-
-          flags = spin_lock_irqsave(NULL);
-          mqmsg = (FAR struct mqueue_msg_s *)list_remove_head(&g_msgfreeirq);
-          spin_unlock_irqrestore(NULL, flags);
-        }
-
-      /* We were not called from an interrupt handler. */
-
-      else
-        {
-          /* If we cannot a message from the free list, then we will have to
-           * allocate one.
-           */
-
-          mqmsg = kmm_malloc(MQ_MSG_SIZE(msgsize));
-
-          /* Check if we allocated the message */
-
-          if (mqmsg != NULL)
-            {
-              /* Yes... remember that this message was dynamically
-               * allocated.
-               */
-
-              mqmsg->type = MQ_ALLOC_DYN;
-            }
-        }
-    }
-
-  return mqmsg;
-}
-
 /****************************************************************************
  * Name: nxmq_add_queue
  *
@@ -277,10 +198,10 @@ int file_mq_timedsend_internal(FAR struct file *mq, FAR const char *msg,
                                FAR const struct timespec *abstime,
                                sclock_t ticks)
 {
-  FAR struct mqueue_inode_s *msgq;
   FAR struct mqueue_msg_s *mqmsg;
-  irqstate_t flags;
-  int ret = 0;
+#ifdef CONFIG_DEBUG_FEATURES
+  int ret;
+#endif
 
   /* Verify the input parameters */
 
@@ -304,8 +225,6 @@ int file_mq_timedsend_internal(FAR struct file *mq, FAR const char *msg,
     }
 #endif
 
-  msgq = mq->f_inode->i_private;
-
   /* Pre-allocate a message structure */
 
   mqmsg = nxmq_alloc_msg(msglen);
@@ -315,8 +234,126 @@ int file_mq_timedsend_internal(FAR struct file *mq, FAR const char *msg,
     }
 
   memcpy(mqmsg->mail, msg, msglen);
+  mqmsg->msglen = msglen;
+
+  return nxmq_queue_msg(mq, mqmsg, prio, abstime, ticks);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmq_alloc_msg
+ *
+ * Description:
+ *   The nxmq_alloc_msg function will get a free message for use by the
+ *   operating system.  The message will be allocated from the g_msgfree
+ *   list.
+ *
+ *   If the list is empty AND the message is NOT being allocated from the
+ *   interrupt level, then the message will be allocated.  If a message
+ *   cannot be obtained, the operating system is dead and therefore cannot
+ *   continue.
+ *
+ *   If the list is empty AND the message IS being allocated from the
+ *   interrupt level.  This function will attempt to get a message from
+ *   the g_msgfreeirq list.  If this is unsuccessful, the calling interrupt
+ *   handler will be notified.
+ *
+ * Input Parameters:
+ *   msgsize - The size of the message data
+ *
+ * Returned Value:
+ *   A reference to the allocated msg structure.  On a failure to allocate,
+ *   this function PANICs.
+ *
+ ****************************************************************************/
+
+FAR struct mqueue_msg_s *nxmq_alloc_msg(uint16_t msgsize)
+{
+  FAR struct mqueue_msg_s *mqmsg;
+  irqstate_t flags;
+
+  /* Try to get the message from the generally available free list. */
+
+  flags = spin_lock_irqsave(NULL);
+  mqmsg = (FAR struct mqueue_msg_s *)list_remove_head(&g_msgfree);
+  spin_unlock_irqrestore(NULL, flags);
+  if (mqmsg == NULL)
+    {
+      /* If we were called from an interrupt handler, then try to get the
+       * message from generally available list of messages. If this fails,
+       * then try the list of messages reserved for interrupt handlers
+       */
+
+      if (up_interrupt_context())
+        {
+          /* Try the free list reserved for interrupt handlers */
+
+          flags = spin_lock_irqsave(NULL);
+          mqmsg = (FAR struct mqueue_msg_s *)list_remove_head(&g_msgfreeirq);
+          spin_unlock_irqrestore(NULL, flags);
+        }
+
+      /* We were not called from an interrupt handler. */
+
+      else
+        {
+          /* If we cannot a message from the free list, then we will have to
+           * allocate one.
+           */
+
+          mqmsg = kmm_malloc(MQ_MSG_SIZE(msgsize));
+
+          /* Check if we allocated the message */
+
+          if (mqmsg != NULL)
+            {
+              /* Yes... remember that this message was dynamically
+               * allocated.
+               */
+
+              mqmsg->type = MQ_ALLOC_DYN;
+            }
+        }
+    }
+
+  return mqmsg;
+}
+
+/****************************************************************************
+ * Name: nxmq_queue_msg
+ *
+ * Description:
+ *   This is internal, common logic shared by [nx]mq_send, [nx]mq_timesend
+ *   and mq_commit.  Add a message that was allocated by nxmq_alloc_msg()
+ *   and filled in by the caller to the message queue, waiting for space in
+ *   the queue if necessary.  On failure the message is freed.
+ *
+ * Input Parameters:
+ *   mq      - Message queue descriptor
+ *   mqmsg   - The message to send, with the data and its length set
+ *   prio    - The priority of the message
+ *   abstime - the absolute time to wait until a timeout is decleared
+ *   ticks   - Ticks to wait from the start time until the semaphore is
+ *             posted.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned
+ *   on failure (see file_mq_timedsend()).
+ *
+ ****************************************************************************/
+
+int nxmq_queue_msg(FAR struct file *mq, FAR struct mqueue_msg_s *mqmsg,
+                   unsigned int prio, FAR const struct timespec *abstime,
+                   sclock_t ticks)
+{
+  FAR struct mqueue_inode_s *msgq = mq->f_inode->i_private;
+  irqstate_t flags;
+  int ret = 0;
+
   mqmsg->priority = prio;
-  mqmsg->msglen   = msglen;
 
   /* Disable interruption */
 
@@ -369,10 +406,6 @@ out:
   return ret;
 }
 
-/****************************************************************************
- * Public Functions
- ****************************************************************************/
-
 /****************************************************************************
  * Name: file_mq_timedsend
  *
@@ -0,0 +1,384 @@
+/****************************************************************************
+ * sched/mqueue/mq_zerocopy.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <mqueue.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/fs/fs.h>
+
+#include "mqueue/mqueue.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Recover the message from the address of its data */
+
+#define MQ_BUF2MSG(buf) \
+  ((FAR struct mqueue_msg_s *) \
+   ((FAR char *)(buf) - offsetof(struct mqueue_msg_s, mail)))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmq_verify_zerocopy
+ *
+ * Description:
+ *   Verify that the message queue was opened with the access 'oflag'.
+ *
+ ****************************************************************************/
+
+static int nxmq_verify_zerocopy(FAR struct file *mq, int oflag)
+{
+  if (mq->f_inode == NULL || mq->f_inode->i_private == NULL)
+    {
+      return -EBADF;
+    }
+
+  if ((mq->f_oflags & oflag) == 0)
+    {
+      return -EBADF;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: file_mq_reserve
+ *
+ * Description:
+ *   Get a message buffer of at least 'msglen' bytes from the message queue
+ *   'mq'.  The message is sent with file_mq_commit() or discarded with
+ *   mq_release().
+ *
+ ****************************************************************************/
+
+static int file_mq_reserve(FAR struct file *mq, size_t msglen,
+                           FAR void **buf)
+{
+  FAR struct mqueue_inode_s *msgq;
+  FAR struct mqueue_msg_s *mqmsg;
+  int ret;
+
+  ret = nxmq_verify_zerocopy(mq, O_WROK);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  msgq = mq->f_inode->i_private;
+  if (msglen > (size_t)msgq->maxmsgsize)
+    {
+      return -EMSGSIZE;
+    }
+
+  mqmsg = nxmq_alloc_msg(msglen);
+  if (mqmsg == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* Remember the reserved size until the message is committed */
+
+  mqmsg->msglen = msglen;
+  *buf = mqmsg->mail;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: file_mq_commit
+ *
+ * Description:
+ *   Send the message in the buffer 'buf' that was returned by
+ *   file_mq_reserve().  The buffer belongs to the queue afterwards, also if
+ *   the message could not be sent.
+ *
+ ****************************************************************************/
+
+static int file_mq_commit(FAR struct file *mq, FAR void *buf,
+                          size_t msglen, unsigned int prio)
+{
+  FAR struct mqueue_msg_s *mqmsg = MQ_BUF2MSG(buf);
+  int ret;
+
+  ret = nxmq_verify_zerocopy(mq, O_WROK);
+  if (ret < 0 || msglen > mqmsg->msglen || prio >= MQ_PRIO_MAX)
+    {
+      nxmq_free_msg(mqmsg);
+      return ret < 0 ? ret : -EINVAL;
+    }
+
+  mqmsg->msglen = msglen;
+  return nxmq_queue_msg(mq, mqmsg, prio, NULL, -1);
+}
+
+/****************************************************************************
+ * Name: file_mq_peek
+ *
+ * Description:
+ *   Take the oldest of the highest priority messages from the message queue
+ *   'mq' without copying it.  The message must be returned with
+ *   mq_release().
+ *
+ ****************************************************************************/
+
+static ssize_t file_mq_peek(FAR struct file *mq, FAR void **buf,
+                            FAR unsigned int *prio)
+{
+  FAR struct mqueue_msg_s *mqmsg;
+  int ret;
+
+  DEBUGASSERT(up_interrupt_context() == false);
+
+  ret = nxmq_verify_zerocopy(mq, O_RDOK);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = nxmq_dequeue_msg(mq, &mqmsg, NULL, -1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (prio)
+    {
+      *prio = mqmsg->priority;
+    }
+
+  *buf = mqmsg->mail;
+  return mqmsg->msglen;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mq_reserve
+ *
+ * Description:
+ *   Reserve a message buffer of the message queue "mqdes" that can hold a
+ *   message of up to "msglen" bytes.  The caller builds the message in the
+ *   buffer and sends it with mq_commit() or gives the buffer back with
+ *   mq_release().  The buffer is not counted against the queue until it is
+ *   committed and mq_reserve() does not block.
+ *
+ * Input Parameters:
+ *   mqdes  - Message queue descriptor
+ *   msglen - The maximum length of the message
+ *
+ * Returned Value:
+ *   The message buffer, aligned to a pointer size.  On failure, NULL is
+ *   returned and the errno is set appropriately:
+ *
+ *   EBADF    'mqdes' is invalid or not opened for writing.
+ *   EMSGSIZE 'msglen' was greater than the maxmsgsize attribute of the
+ *            message queue.
+ *   ENOMEM   No message buffer is available.
+ *
+ ****************************************************************************/
+
+FAR void *mq_reserve(mqd_t mqdes, size_t msglen)
+{
+  FAR struct file *filep;
+  FAR void *buf = NULL;
+  int ret;
+
+  ret = fs_getfilep(mqdes, &filep);
+  if (ret >= 0)
+    {
+      ret = file_mq_reserve(filep, msglen, &buf);
+      fs_putfilep(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      return NULL;
+    }
+
+  return buf;
+}
+
+/****************************************************************************
+ * Name: mq_commit
+ *
+ * Description:
+ *   Add the message in the buffer "buf" returned by mq_reserve() to the
+ *   message queue "mqdes".  mq_commit() behaves like mq_send():  If the
+ *   queue is full and O_NONBLOCK is not set, it blocks until there is room
+ *   for the message.  The buffer must not be used by the caller after the
+ *   call, whether it succeeded or not.
+ *
+ * Input Parameters:
+ *   mqdes  - Message queue descriptor
+ *   buf    - The buffer returned by mq_reserve()
+ *   msglen - The length of the message, not more than was reserved
+ *   prio   - The priority of the message
+ *
+ * Returned Value:
+ *   On success, mq_commit() returns 0 (OK); on error, -1 (ERROR) is
+ *   returned, with errno set to indicate the error (see mq_send()).
+ *
+ ****************************************************************************/
+
+int mq_commit(mqd_t mqdes, FAR void *buf, size_t msglen, unsigned int prio)
+{
+  FAR struct file *filep;
+  int ret;
+
+  DEBUGASSERT(buf != NULL);
+
+  /* mq_commit() is a cancellation point */
+
+  enter_cancellation_point();
+
+  ret = fs_getfilep(mqdes, &filep);
+  if (ret < 0)
+    {
+      nxmq_free_msg(MQ_BUF2MSG(buf));
+    }
+  else
+    {
+      ret = file_mq_commit(filep, buf, msglen, prio);
+      fs_putfilep(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mq_peek
+ *
+ * Description:
+ *   Remove the oldest of the highest priority messages from the message
+ *   queue "mqdes" like mq_receive(), but return the message buffer itself
+ *   instead of copying the message.  The buffer must be given back with
+ *   mq_release() once the message has been consumed.
+ *
+ * Input Parameters:
+ *   mqdes - Message queue descriptor
+ *   buf   - The location to return the message buffer
+ *   prio  - If not NULL, the location to store message priority.
+ *
+ * Returned Value:
+ *   On success, the length of the message in bytes is returned.  On
+ *   failure, -1 (ERROR) is returned and the errno is set appropriately
+ *   (see mq_receive()).
+ *
+ ****************************************************************************/
+
+ssize_t mq_peek(mqd_t mqdes, FAR void **buf, FAR unsigned int *prio)
+{
+  FAR struct file *filep;
+  ssize_t ret;
+
+  DEBUGASSERT(buf != NULL);
+
+  /* mq_peek() is a cancellation point */
+
+  enter_cancellation_point();
+
+  ret = fs_getfilep(mqdes, &filep);
+  if (ret >= 0)
+    {
+      ret = file_mq_peek(filep, buf, prio);
+      fs_putfilep(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mq_release
+ *
+ * Description:
+ *   Give back a message buffer returned by mq_peek(), or a buffer returned
+ *   by mq_reserve() that is not going to be committed.
+ *
+ * Input Parameters:
+ *   mqdes - Message queue descriptor
+ *   buf   - The message buffer
+ *
+ * Returned Value:
+ *   On success, mq_release() returns 0 (OK); on error, -1 (ERROR) is
+ *   returned, with errno set to indicate the error:
+ *
+ *   EBADF    'mqdes' is invalid.
+ *   EINVAL   'buf' is NULL.
+ *
+ ****************************************************************************/
+
+int mq_release(mqd_t mqdes, FAR void *buf)
+{
+  FAR struct file *filep;
+  int ret;
+
+  if (buf == NULL)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  /* The buffer is given back even if 'mqdes' is not valid any more */
+
+  nxmq_free_msg(MQ_BUF2MSG(buf));
+
+  ret = fs_getfilep(mqdes, &filep);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      return ERROR;
+    }
+
+  fs_putfilep(filep);
+  return OK;
+}
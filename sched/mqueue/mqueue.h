@@ -74,7 +74,11 @@ struct mqueue_msg_s
 #else
   uint16_t msglen;         /* Message data length */
 #endif
+#ifdef CONFIG_MQ_ZEROCOPY
+  char mail[1] aligned_data(sizeof(uintptr_t)); /* Message data */
+#else
   char mail[1];            /* Message data */
+#endif
 };
 
 /****************************************************************************
@@ -112,6 +116,18 @@ struct task_group_s; /* Forward reference */
 
 void nxmq_initialize(void);
 
+/* mq_send.c ****************************************************************/
+
+FAR struct mqueue_msg_s *nxmq_alloc_msg(uint16_t msgsize);
+int nxmq_queue_msg(FAR struct file *mq, FAR struct mqueue_msg_s *mqmsg,
+                   unsigned int prio, FAR const struct timespec *abstime,
+                   sclock_t ticks);
+
+/* mq_receive.c *************************************************************/
+
+int nxmq_dequeue_msg(FAR struct file *mq, FAR struct mqueue_msg_s **rcvmsg,
+                     FAR const struct timespec *abstime, sclock_t ticks);
+
 /* mq_msgfree.c *************************************************************/
 
 void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg);
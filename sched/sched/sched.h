@@ -360,6 +360,20 @@ uint32_t nxsched_process_sporadic(FAR struct tcb_s *tcb, uint32_t ticks,
 void nxsched_sporadic_lowpriority(FAR struct tcb_s *tcb);
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+int  nxsched_start_deadline(FAR struct tcb_s *tcb, clock_t runtime,
+                            clock_t deadline, clock_t period);
+void nxsched_stop_deadline(FAR struct tcb_s *tcb);
+void nxsched_suspend_deadline(FAR struct tcb_s *tcb);
+void nxsched_wakeup_deadline(FAR struct tcb_s *tcb);
+uint32_t nxsched_process_deadline(FAR struct tcb_s *tcb, uint32_t ticks,
+                                  bool noswitches);
+#endif
+
+#if defined(CONFIG_RCU) && defined(CONFIG_SMP)
+void nxsched_rcu_quiescent(void);
+#endif
+
 #ifdef CONFIG_SIG_SIGSTOP_ACTION
 void nxsched_suspend(FAR struct tcb_s *tcb);
 #endif
@@ -395,21 +409,51 @@ static inline_function FAR struct tcb_s *this_task(void)
 
 #ifdef CONFIG_SMP
 void nxsched_process_delivered(int cpu);
+#  ifdef CONFIG_SCHED_PERCPU_READYTORUN
+FAR struct tcb_s *nxsched_find_stealable(int cpu, FAR struct tcb_s *nxttcb);
+#  endif
+#  ifdef CONFIG_SCHED_IDLE_BALANCE
+void nxsched_idle_balance(void);
+#  endif
 #else
 #  define nxsched_select_cpu(a)     (0)
 #endif
 
 #define nxsched_islocked_tcb(tcb)   ((tcb)->lockcount > 0)
 
+/* True if 'tcb' must be placed before 'next' in a prioritized list */
+
+#ifdef CONFIG_SCHED_DEADLINE
+#  define nxsched_is_deadline(tcb) \
+     (((tcb)->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+#  define nxsched_deadline_before(tcb, next) \
+     (nxsched_is_deadline(tcb) && (!nxsched_is_deadline(next) || \
+      (sclock_t)((tcb)->deadline.absdeadline - \
+                 (next)->deadline.absdeadline) < 0))
+#  define nxsched_precedes(tcb, next) \
+     ((tcb)->sched_priority > (next)->sched_priority || \
+      ((tcb)->sched_priority == (next)->sched_priority && \
+       nxsched_deadline_before(tcb, next)))
+#else
+#  define nxsched_precedes(tcb, next) \
+     ((tcb)->sched_priority > (next)->sched_priority)
+#endif
+
 /* CPU load measurement support */
 
 #if defined(CONFIG_SCHED_CPULOAD_SYSCLK) || \
-    defined (CONFIG_SCHED_CPULOAD_CRITMONITOR)
+    defined (CONFIG_SCHED_CPULOAD_CRITMONITOR) || \
+    defined (CONFIG_SCHED_CPULOAD_PERFCOUNT)
 void nxsched_process_taskload_ticks(FAR struct tcb_s *tcb, clock_t ticks);
 void nxsched_process_cpuload_ticks(clock_t ticks);
 #define nxsched_process_cpuload() nxsched_process_cpuload_ticks(1)
 #endif
 
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+void nxsched_cpuload_suspend(FAR struct tcb_s *tcb);
+void nxsched_cpuload_resume(FAR struct tcb_s *tcb);
+#endif
+
 /* Critical section monitor */
 
 #ifdef CONFIG_SCHED_CRITMONITOR
@@ -428,10 +472,53 @@ void nxsched_critmon_csection(FAR struct tcb_s *tcb, bool state,
                               FAR void *caller);
 #endif
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+void nxsched_critmon_histogram(int type, FAR void *caller, clock_t elapsed);
+#endif
+
+/* Wakeup latency histograms */
+
+#ifdef CONFIG_SCHED_LATENCY
+void nxsched_latency_ready(FAR struct tcb_s *tcb);
+void nxsched_latency_resume(FAR struct tcb_s *tcb);
+#endif
+
+/* Per-CPU utilization tracking */
+
+#ifdef CONFIG_SCHED_UTIL
+void nxsched_util_resume(FAR struct tcb_s *tcb);
+#endif
+
+/* IDLE loop polling */
+
+#ifdef CONFIG_SCHED_IDLE_POLL
+bool nxsched_idle_poll(void);
+void nxsched_idle_wakeup(int cpu);
+void nxsched_idle_resume(FAR struct tcb_s *tcb);
+#endif
+
 /* TCB operations */
 
 bool nxsched_verify_tcb(FAR struct tcb_s *tcb);
 
+/* TCB and stack allocation */
+
+#ifdef CONFIG_SCHED_TCBPOOL
+void nxsched_tcbpool_initialize(void);
+FAR void *nxsched_alloc_tcb(size_t size);
+void nxsched_free_tcb(FAR struct tcb_s *tcb);
+int nxsched_create_stack(FAR struct tcb_s *tcb, size_t stack_size,
+                         uint8_t ttype);
+void nxsched_release_stack(FAR struct tcb_s *tcb, uint8_t ttype);
+#else
+#  define nxsched_alloc_tcb(size)  kmm_zalloc(size)
+#  define nxsched_free_tcb(tcb)    kmm_free(tcb)
+#  define nxsched_create_stack(tcb, stack_size, ttype) \
+     up_create_stack(tcb, stack_size, ttype)
+#  define nxsched_release_stack(tcb, ttype) \
+     up_release_stack(tcb, ttype)
+#endif
+
 /* Obtain TLS from kernel */
 
 struct tls_info_s; /* Forward declare */
@@ -447,19 +534,20 @@ static inline_function bool nxsched_add_prioritized(FAR struct tcb_s *tcb,
 {
   FAR struct tcb_s *next;
   FAR struct tcb_s *prev;
-  uint8_t sched_priority = tcb->sched_priority;
   bool ret = false;
 
   /* Lets do a sanity check before we get started. */
 
-  DEBUGASSERT(sched_priority >= SCHED_PRIORITY_MIN);
+  DEBUGASSERT(tcb->sched_priority >= SCHED_PRIORITY_MIN);
 
   /* Search the list to find the location to insert the new Tcb.
    * Each is list is maintained in descending sched_priority order.
+   * SCHED_DEADLINE tasks of the same priority are further ordered by
+   * their absolute deadline.
    */
 
   for (next = (FAR struct tcb_s *)list->head;
-       (next && sched_priority <= next->sched_priority);
+       (next && !nxsched_precedes(tcb, next));
        next = next->flink);
 
   /* Add the tcb to the spot found in the list.  Check if the tcb
@@ -71,13 +71,30 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
   FAR struct tcb_s *rtcb = this_task();
   bool ret;
 
+#ifdef CONFIG_SCHED_LATENCY
+  nxsched_latency_ready(btcb);
+#endif
+
+#ifdef CONFIG_SCHED_IDLE_POLL
+  nxsched_idle_wakeup(0);
+#endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Apply the wakeup rule before the deadline is used to queue the task */
+
+  if (nxsched_is_deadline(btcb))
+    {
+      nxsched_wakeup_deadline(btcb);
+    }
+#endif
+
   /* Check if pre-emption is disabled for the current running task and if
    * the new ready-to-run task would cause the current running task to be
    * pre-empted.  NOTE that IRQs disabled implies that pre-emption is
    * also disabled.
    */
 
-  if (rtcb->lockcount > 0 && rtcb->sched_priority < btcb->sched_priority)
+  if (rtcb->lockcount > 0 && nxsched_precedes(btcb, rtcb))
     {
       /* Yes.  Preemption would occur!  Add the new ready-to-run task to the
        * g_pendingtasks task list for now.
@@ -125,7 +142,8 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
  *   1. The g_readytorun list if the task is ready-to-run but not running
  *      and not assigned to a CPU.
  *   2. The g_assignedtask[cpu] list if the task is running or if has been
- *      assigned to a CPU.
+ *      assigned to a CPU.  With CONFIG_SCHED_PERCPU_READYTORUN, this is
+ *      also where tasks that are ready-to-run but not running are queued.
  *
  *   If the currently active task has preemption disabled and the new TCB
  *   would cause this task to be pre-empted, the new task is added to the
@@ -161,8 +179,25 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
   int cpu;
   int me;
 
+#ifdef CONFIG_SCHED_LATENCY
+  nxsched_latency_ready(btcb);
+#endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Apply the wakeup rule before the deadline is used to queue the task */
+
+  if (nxsched_is_deadline(btcb))
+    {
+      nxsched_wakeup_deadline(btcb);
+    }
+#endif
+
   cpu = nxsched_select_cpu(btcb->affinity);
 
+#ifdef CONFIG_SCHED_IDLE_POLL
+  nxsched_idle_wakeup(cpu);
+#endif
+
   /* Get the task currently running on the CPU (may be the IDLE task) */
 
   rtcb = current_task(cpu);
@@ -173,7 +208,7 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
    * required.
    */
 
-  if (rtcb->sched_priority < btcb->sched_priority)
+  if (nxsched_precedes(btcb, rtcb))
     {
       task_state = TSTATE_TASK_RUNNING;
     }
@@ -215,9 +250,22 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
        * Add the task to the ready-to-run (but not running) task list
        */
 
+#ifdef CONFIG_SCHED_PERCPU_READYTORUN
+      /* Queue the task behind the running task of the selected CPU.  Its
+       * priority does not exceed that of the running task so it cannot
+       * become the head of the list.  Other CPUs will steal it if they
+       * become free first.
+       */
+
+      nxsched_add_prioritized(btcb, list_assignedtasks(cpu));
+
+      btcb->cpu        = cpu;
+      btcb->task_state = TSTATE_TASK_ASSIGNED;
+#else
       nxsched_add_prioritized(btcb, list_readytorun());
 
       btcb->task_state = TSTATE_TASK_READYTORUN;
+#endif
       doswitch         = false;
     }
   else /* (task_state == TSTATE_TASK_RUNNING) */
@@ -239,7 +287,7 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
           else
             {
               rtcb = g_delivertasks[cpu];
-              if (rtcb->sched_priority < btcb->sched_priority)
+              if (nxsched_precedes(btcb, rtcb))
                 {
                   g_delivertasks[cpu] = btcb;
                   btcb->cpu = cpu;
@@ -28,9 +28,12 @@
 
 #include <errno.h>
 #include <assert.h>
+#include <limits.h>
+#include <sys/param.h>
 
 #include <nuttx/clock.h>
 #include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/wdog.h>
 
 #include "sched/sched.h"
@@ -48,6 +51,8 @@
 #    error CONFIG_SCHED_CPULOAD_TICKSPERSEC is not defined
 #  endif
 #  define CPULOAD_TICKSPERSEC CONFIG_SCHED_CPULOAD_TICKSPERSEC
+#elif defined(CONFIG_SCHED_CPULOAD_PERFCOUNT)
+#  define CPULOAD_TICKSPERSEC ((uint64_t)perf_getfreq())
 #else
 #  define CPULOAD_TICKSPERSEC CLOCKS_PER_SEC
 #endif
@@ -57,10 +62,21 @@
  * will be incremented multiple times per tick.
  */
 
-#define CPULOAD_TIMECONSTANT \
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+/* The time constant in counts of a fast performance counter might not fit
+ * into a 32-bit clock_t:  The counts are scaled back earlier then.
+ */
+
+#  define CPULOAD_TIMECONSTANT \
+     MIN(CONFIG_SMP_NCPUS * \
+         CONFIG_SCHED_CPULOAD_TIMECONSTANT * \
+         CPULOAD_TICKSPERSEC, CLOCK_MAX / 2)
+#else
+#  define CPULOAD_TIMECONSTANT \
      (CONFIG_SMP_NCPUS * \
       CONFIG_SCHED_CPULOAD_TIMECONSTANT * \
       CPULOAD_TICKSPERSEC)
+#endif
 
 /* The sampling period in system timer ticks */
 
@@ -94,6 +110,16 @@ volatile clock_t g_cpuload_total;
 static struct wdog_s g_cpuload_wdog;
 #endif
 
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+/* The time when the thread running on each CPU was last accounted */
+
+static clock_t g_cpuload_start[CONFIG_SMP_NCPUS];
+
+/* Serializes the accounting of the CPUs */
+
+static spinlock_t g_cpuload_lock = SP_UNLOCKED;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -122,6 +148,43 @@ static void cpuload_callback(wdparm_t arg)
 }
 #endif
 
+/****************************************************************************
+ * Name: cpuload_account
+ *
+ * Description:
+ *   Charge the time since it was last accounted to the thread running on
+ *   'cpu'.  Called with g_cpuload_lock held.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+static void cpuload_account(int cpu, FAR struct tcb_s *tcb, clock_t now)
+{
+  nxsched_process_taskload_ticks(tcb, now - g_cpuload_start[cpu]);
+  g_cpuload_start[cpu] = now;
+}
+
+/****************************************************************************
+ * Name: cpuload_report
+ *
+ * Description:
+ *   Convert accumulated counts of the performance counter to the units
+ *   reported by clock_cpuload().  The users compute percentages like
+ *   1000 * active / total, which would overflow a 32-bit clock_t with raw
+ *   counts:  System ticks are reported then.
+ *
+ ****************************************************************************/
+
+static clock_t cpuload_report(clock_t count)
+{
+#ifdef CONFIG_SYSTEM_TIME64
+  return count;
+#else
+  return (uint64_t)count * CLOCKS_PER_SEC / perf_getfreq();
+#endif
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -148,7 +211,7 @@ void nxsched_process_taskload_ticks(FAR struct tcb_s *tcb, clock_t ticks)
 
   if (g_cpuload_total > CPULOAD_TIMECONSTANT)
     {
-      uint32_t total = 0;
+      clock_t total = 0;
       int i;
 
       /* Divide the tick count for every task by two and recalculate the
@@ -204,6 +267,56 @@ void nxsched_process_cpuload_ticks(clock_t ticks)
     }
 }
 
+/****************************************************************************
+ * Name: nxsched_cpuload_suspend
+ *
+ * Description:
+ *   Called when 'tcb' suspends execution on this CPU.  Charge the exact
+ *   time that it has been running to the thread.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread that is being suspended.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+void nxsched_cpuload_suspend(FAR struct tcb_s *tcb)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_cpuload_lock);
+  cpuload_account(this_cpu(), tcb, perf_gettime());
+  spin_unlock_irqrestore(&g_cpuload_lock, flags);
+}
+
+/****************************************************************************
+ * Name: nxsched_cpuload_resume
+ *
+ * Description:
+ *   Called when 'tcb' resumes execution on this CPU.  Start accounting its
+ *   run time.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread that is being resumed.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxsched_cpuload_resume(FAR struct tcb_s *tcb)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_cpuload_lock);
+  g_cpuload_start[this_cpu()] = perf_gettime();
+  spin_unlock_irqrestore(&g_cpuload_lock, flags);
+}
+#endif
+
 /****************************************************************************
  * Name:  clock_cpuload
  *
@@ -229,6 +342,11 @@ int clock_cpuload(int pid, FAR struct cpuload_s *cpuload)
   irqstate_t flags;
   int hash_index;
   int ret = -ESRCH;
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+  clock_t now = perf_gettime();
+  irqstate_t lock;
+  int i;
+#endif
 
   DEBUGASSERT(cpuload);
 
@@ -259,12 +377,34 @@ int clock_cpuload(int pid, FAR struct cpuload_s *cpuload)
    * do this too, but this would require a little more overhead.
    */
 
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+  /* Bring the threads that are running now up to date, so that a thread
+   * that has been running for a long time is accounted as well.
+   */
+
+  lock = spin_lock_irqsave(&g_cpuload_lock);
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      cpuload_account(i, current_task(i), now);
+    }
+
+  if (g_pidhash[hash_index] && g_pidhash[hash_index]->pid == pid)
+    {
+      cpuload->total  = cpuload_report(g_cpuload_total);
+      cpuload->active = cpuload_report(g_pidhash[hash_index]->ticks);
+      ret = OK;
+    }
+
+  spin_unlock_irqrestore(&g_cpuload_lock, lock);
+#else
   if (g_pidhash[hash_index] && g_pidhash[hash_index]->pid == pid)
     {
       cpuload->total  = g_cpuload_total;
       cpuload->active = g_pidhash[hash_index]->ticks;
       ret = OK;
     }
+#endif
 
   leave_critical_section(flags);
   return ret;
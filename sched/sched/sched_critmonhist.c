@@ -0,0 +1,231 @@
+/****************************************************************************
+ * sched/sched/sched_critmonhist.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+
+#include <nuttx/critmon.h>
+#include <nuttx/spinlock.h>
+
+#include "sched/sched.h"
+
+/* Each CPU counts the durations that end on it in its own open addressing
+ * hash tables of call sites, one per kind of duration:  The tables are only
+ * shared with the readers, so the locks are not contended while measuring.
+ * The locks do not instrument themselves, they are taken in the middle of
+ * enter_critical_section() and leave_critical_section().
+ */
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define CRITMON_NSITES  CONFIG_SCHED_CRITMONITOR_HISTOGRAM_NSITES
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The call sites of one kind of duration on one CPU */
+
+struct critmon_table_s
+{
+  struct critmon_site_s sites[CRITMON_NSITES];
+  uint32_t dropped;              /* Durations dropped, the table was full */
+  spinlock_t lock;               /* Lock against the readers */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct critmon_table_s
+g_critmon_hist[CONFIG_SMP_NCPUS][CRITMON_NTYPES];
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_critmon_histogram
+ *
+ * Description:
+ *   Count a duration of kind 'type' for call site 'caller' on this CPU.
+ *
+ * Input Parameters:
+ *   type    - CRITMON_PREEMPTION, CRITMON_CSECTION or CRITMON_IRQ
+ *   caller  - The call site that started the duration
+ *   elapsed - The duration in perf counts
+ *
+ * Assumptions:
+ *   Might be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void nxsched_critmon_histogram(int type, FAR void *caller, clock_t elapsed)
+{
+  FAR struct critmon_table_s *table;
+  FAR struct critmon_site_s *site;
+  irqstate_t flags;
+  int index;
+  int bin;
+  int i;
+
+  bin = elapsed > 1 ? flsll((long long)elapsed) - 1 : 0;
+  if (bin >= CRITMON_NBINS)
+    {
+      bin = CRITMON_NBINS - 1;
+    }
+
+  /* The code addresses are at least 2-byte aligned */
+
+  index = ((uintptr_t)caller >> 1) % CRITMON_NSITES;
+  table = &g_critmon_hist[this_cpu()][type];
+  flags = spin_lock_irqsave_wo_note(&table->lock);
+
+  for (i = 0; i < CRITMON_NSITES; i++)
+    {
+      site = &table->sites[index];
+
+      /* A call site is in use once it has a duration */
+
+      if (site->count == 0)
+        {
+          site->caller = caller;
+        }
+
+      if (site->caller == caller)
+        {
+          site->count++;
+          site->total += elapsed;
+          site->bins[bin]++;
+          if (elapsed > site->max)
+            {
+              site->max = elapsed;
+            }
+
+          spin_unlock_irqrestore_wo_note(&table->lock, flags);
+          return;
+        }
+
+      index = (index + 1) % CRITMON_NSITES;
+    }
+
+  table->dropped++;
+  spin_unlock_irqrestore_wo_note(&table->lock, flags);
+}
+
+/****************************************************************************
+ * Name: critmon_getsite
+ *
+ * Description:
+ *   Get a copy of call site 'index' of kind 'type' on CPU 'cpu'.
+ *
+ ****************************************************************************/
+
+int critmon_getsite(int cpu, int type, int index,
+                    FAR struct critmon_site_s *site)
+{
+  FAR struct critmon_table_s *table;
+  irqstate_t flags;
+  int ret = OK;
+
+  if (cpu < 0 || cpu >= CONFIG_SMP_NCPUS ||
+      type < 0 || type >= CRITMON_NTYPES ||
+      index < 0 || index >= CRITMON_NSITES)
+    {
+      return -EINVAL;
+    }
+
+  table = &g_critmon_hist[cpu][type];
+  flags = spin_lock_irqsave_wo_note(&table->lock);
+
+  if (table->sites[index].count == 0)
+    {
+      ret = -ENOENT;
+    }
+  else
+    {
+      *site = table->sites[index];
+    }
+
+  spin_unlock_irqrestore_wo_note(&table->lock, flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: critmon_dropped
+ *
+ * Description:
+ *   Return the number of durations of kind 'type' on CPU 'cpu' that were
+ *   dropped.
+ *
+ ****************************************************************************/
+
+uint32_t critmon_dropped(int cpu, int type)
+{
+  if (cpu < 0 || cpu >= CONFIG_SMP_NCPUS ||
+      type < 0 || type >= CRITMON_NTYPES)
+    {
+      return 0;
+    }
+
+  return g_critmon_hist[cpu][type].dropped;
+}
+
+/****************************************************************************
+ * Name: critmon_reset
+ *
+ * Description:
+ *   Forget all call sites.
+ *
+ ****************************************************************************/
+
+void critmon_reset(void)
+{
+  FAR struct critmon_table_s *table;
+  irqstate_t flags;
+  int cpu;
+  int type;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      for (type = 0; type < CRITMON_NTYPES; type++)
+        {
+          table = &g_critmon_hist[cpu][type];
+          flags = spin_lock_irqsave_wo_note(&table->lock);
+
+          memset(table->sites, 0, sizeof(table->sites));
+          table->dropped = 0;
+
+          spin_unlock_irqrestore_wo_note(&table->lock, flags);
+        }
+    }
+}
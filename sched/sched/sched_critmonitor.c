@@ -32,6 +32,8 @@
 #include <debug.h>
 #include <time.h>
 
+#include <nuttx/critmon.h>
+
 #include "sched/sched.h"
 
 /****************************************************************************
@@ -86,6 +88,15 @@
 #  define CHECK_THREAD(pid, elapsed)
 #endif
 
+/* Count the duration in the histogram of its call site */
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+#  define CRITMON_HISTOGRAM(type, caller, elapsed) \
+     nxsched_critmon_histogram(type, caller, elapsed)
+#else
+#  define CRITMON_HISTOGRAM(type, caller, elapsed)
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -192,6 +203,8 @@ void nxsched_critmon_preemption(FAR struct tcb_s *tcb, bool state,
       clock_t elapsed = current - tcb->premp_start;
       int cpu         = this_cpu();
 
+      CRITMON_HISTOGRAM(CRITMON_PREEMPTION, tcb->premp_caller, elapsed);
+
       if (elapsed > tcb->premp_max)
         {
           tcb->premp_max        = elapsed;
@@ -244,6 +257,8 @@ void nxsched_critmon_csection(FAR struct tcb_s *tcb, bool state,
       clock_t elapsed = current - tcb->crit_start;
       int cpu         = this_cpu();
 
+      CRITMON_HISTOGRAM(CRITMON_CSECTION, tcb->crit_caller, elapsed);
+
       if (elapsed > tcb->crit_max)
         {
           tcb->crit_max        = elapsed;
@@ -350,6 +365,8 @@ void nxsched_suspend_critmon(FAR struct tcb_s *tcb)
       /* Possibly re-enabling.. Check for the max elapsed time */
 
       elapsed = current - tcb->premp_start;
+      CRITMON_HISTOGRAM(CRITMON_PREEMPTION, tcb->premp_caller, elapsed);
+
       if (elapsed > tcb->premp_max)
         {
           tcb->premp_max        = elapsed;
@@ -376,6 +393,8 @@ void nxsched_suspend_critmon(FAR struct tcb_s *tcb)
       /* Possibly leaving .. Check for the max elapsed time */
 
       elapsed = current - tcb->crit_start;
+      CRITMON_HISTOGRAM(CRITMON_CSECTION, tcb->crit_caller, elapsed);
+
       if (elapsed > tcb->crit_max)
         {
           tcb->crit_max        = elapsed;
@@ -0,0 +1,382 @@
+/****************************************************************************
+ * sched/sched/sched_deadline.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sched.h>
+#include <errno.h>
+#include <assert.h>
+#include <sys/param.h>
+
+#include <nuttx/sched.h>
+#include <nuttx/clock.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_DEADLINE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Bandwidths are fixed point fractions of one CPU */
+
+#define DEADLINE_BW_SHIFT   20
+#define DEADLINE_BW_ONE     (UINT64_C(1) << DEADLINE_BW_SHIFT)
+
+/* The admission control limit for the whole system */
+
+#define DEADLINE_BW_MAX     (DEADLINE_BW_ONE * CONFIG_SCHED_DEADLINE_MAXUTIL * \
+                             CONFIG_SMP_NCPUS / 100)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The sum of the bandwidths of all SCHED_DEADLINE threads */
+
+static uint64_t g_deadline_bw;
+
+#ifdef CONFIG_SMP
+static struct smp_call_data_s g_call_data;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_deadline_handler
+ *
+ * Description:
+ *   Requeue a deadline thread that exhausted its runtime while running on
+ *   another CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+static int nxsched_deadline_handler(FAR void *cookie)
+{
+  pid_t pid = (uintptr_t)cookie;
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  tcb = nxsched_get_tcb(pid);
+
+  if (!tcb || tcb->task_state == TSTATE_TASK_INVALID ||
+      (tcb->flags & TCB_FLAG_EXIT_PROCESSING) != 0)
+    {
+      /* There is no TCB with this pid or, if there is, it is not a task. */
+
+      leave_critical_section(flags);
+      return OK;
+    }
+
+  if (tcb->task_state == TSTATE_TASK_RUNNING && tcb->cpu == this_cpu() &&
+      nxsched_reprioritize_rtr(tcb, tcb->sched_priority))
+    {
+      up_switch_context(this_task(), tcb);
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: nxsched_replenish_deadline
+ *
+ * Description:
+ *   Start a new period with a full runtime and the given absolute deadline.
+ *
+ ****************************************************************************/
+
+static inline void nxsched_replenish_deadline(FAR struct tcb_s *tcb,
+                                              clock_t absdeadline)
+{
+  tcb->deadline.absdeadline = absdeadline;
+  tcb->timeslice            = tcb->deadline.runtime;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_start_deadline
+ *
+ * Description:
+ *   Switch a thread to the SCHED_DEADLINE policy, or change the parameters
+ *   of a thread that already uses it.  The new reservation is subject to
+ *   admission control:  the sum of runtime / period of all deadline threads
+ *   may not exceed CONFIG_SCHED_DEADLINE_MAXUTIL % of all CPUs.
+ *
+ * Input Parameters:
+ *   tcb      - The TCB of the thread
+ *   runtime  - Execution budget per period, in ticks
+ *   deadline - Relative deadline, in ticks
+ *   period   - Replenishment period, in ticks
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success or a negated errno value on failure:
+ *
+ *   EINVAL - The parameters are not runtime <= deadline <= period
+ *   EBUSY  - The reservation does not pass admission control
+ *
+ * Assumptions:
+ *   Interrupts are disabled.  The caller sets the priority of the thread
+ *   to CONFIG_SCHED_DEADLINE_PRIORITY.
+ *
+ ****************************************************************************/
+
+int nxsched_start_deadline(FAR struct tcb_s *tcb, clock_t runtime,
+                           clock_t deadline, clock_t period)
+{
+  uint64_t total = g_deadline_bw;
+  uint32_t bw;
+
+  DEBUGASSERT(tcb != NULL);
+
+  if (runtime < 1 || runtime > deadline || deadline > period ||
+      runtime > INT32_MAX)
+    {
+      return -EINVAL;
+    }
+
+  bw = (uint32_t)(((uint64_t)runtime << DEADLINE_BW_SHIFT) / period);
+
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      total -= tcb->deadline.bandwidth;
+    }
+
+  if (total + bw > DEADLINE_BW_MAX)
+    {
+      return -EBUSY;
+    }
+
+  g_deadline_bw            = total + bw;
+
+  tcb->deadline.blocked    = false;
+  tcb->deadline.runtime    = runtime;
+  tcb->deadline.deadline   = deadline;
+  tcb->deadline.period     = period;
+  tcb->deadline.bandwidth  = bw;
+
+  tcb->flags              &= ~TCB_FLAG_POLICY_MASK;
+  tcb->flags              |= TCB_FLAG_SCHED_DEADLINE;
+
+  nxsched_replenish_deadline(tcb, clock_systime_ticks() + deadline);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxsched_stop_deadline
+ *
+ * Description:
+ *   Release the reservation of a SCHED_DEADLINE thread that exits or
+ *   switches to another policy.  The caller is responsible for updating
+ *   the policy bits of tcb->flags.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void nxsched_stop_deadline(FAR struct tcb_s *tcb)
+{
+  DEBUGASSERT(tcb != NULL && g_deadline_bw >= tcb->deadline.bandwidth);
+
+  g_deadline_bw          -= tcb->deadline.bandwidth;
+  tcb->deadline.bandwidth = 0;
+  tcb->timeslice          = 0;
+}
+
+/****************************************************************************
+ * Name: nxsched_suspend_deadline
+ *
+ * Description:
+ *   Called when a SCHED_DEADLINE thread loses the CPU.  Remember whether
+ *   it blocked so that the wakeup rule is applied when it becomes
+ *   ready-to-run again.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxsched_suspend_deadline(FAR struct tcb_s *tcb)
+{
+  if (tcb->task_state >= FIRST_BLOCKED_STATE)
+    {
+      tcb->deadline.blocked = true;
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_wakeup_deadline
+ *
+ * Description:
+ *   Called when a blocked SCHED_DEADLINE thread is made ready-to-run,
+ *   before it is placed in the ready-to-run list.  The remaining runtime
+ *   may be used until the current deadline only if that does not exceed
+ *   the reserved bandwidth, i.e. if
+ *
+ *     remaining / (absdeadline - now) <= runtime / period
+ *
+ *   Otherwise a new period is started now.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void nxsched_wakeup_deadline(FAR struct tcb_s *tcb)
+{
+  FAR struct deadline_s *dl = &tcb->deadline;
+  clock_t now = clock_systime_ticks();
+  sclock_t laxity;
+
+  if (!dl->blocked)
+    {
+      return;
+    }
+
+  dl->blocked = false;
+  laxity      = (sclock_t)(dl->absdeadline - now);
+
+  if (laxity <= 0 ||
+      (uint64_t)MAX(tcb->timeslice, 0) * dl->period >
+      (uint64_t)laxity * dl->runtime)
+    {
+      nxsched_replenish_deadline(tcb, now + dl->deadline);
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_process_deadline
+ *
+ * Description:
+ *   Charge the running SCHED_DEADLINE thread for the elapsed time.  Once
+ *   its runtime is exhausted, the deadline is postponed by one period and
+ *   the runtime is replenished.  The thread is then requeued behind the
+ *   deadline threads with an earlier deadline.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the currently executing task
+ *   ticks - The number of ticks that have elapsed on the interval timer.
+ *   noswitches - True: Can't do context switches now.
+ *
+ * Returned Value:
+ *   The number if ticks remaining until the runtime of the thread is
+ *   exhausted.  The value one is returned if the budget is exhausted but
+ *   noswitches == true so that the timer expires as soon as possible.
+ *
+ * Assumptions:
+ *   - Interrupts are disabled
+ *   - The task associated with TCB uses the deadline scheduling policy
+ *
+ ****************************************************************************/
+
+uint32_t nxsched_process_deadline(FAR struct tcb_s *tcb, uint32_t ticks,
+                                  bool noswitches)
+{
+  FAR struct deadline_s *dl;
+  uint32_t ret;
+  int decr;
+
+  DEBUGASSERT(tcb != NULL);
+  dl = &tcb->deadline;
+
+  /* Consume the runtime of the current period */
+
+  decr = MIN(tcb->timeslice, ticks);
+  tcb->timeslice -= decr;
+
+  ret = tcb->timeslice;
+  if (tcb->timeslice <= 0 && !nxsched_islocked_tcb(tcb))
+    {
+      if (noswitches)
+        {
+          ret = 1;
+        }
+      else
+        {
+          /* Postpone the deadline and replenish the runtime */
+
+          nxsched_replenish_deadline(tcb, dl->absdeadline + dl->period);
+          ret = tcb->timeslice;
+
+          /* Reinsert the task in the ready-to-run list.  It will be placed
+           * behind any task at the same priority with an earlier deadline.
+           */
+
+          if (tcb->flink &&
+              tcb->flink->sched_priority >= tcb->sched_priority)
+            {
+              FAR struct tcb_s *rtcb = this_task();
+
+#ifdef CONFIG_SMP
+              if (tcb->task_state == TSTATE_TASK_RUNNING &&
+                  tcb->cpu != this_cpu())
+                {
+                  nxsched_smp_call_init(&g_call_data,
+                                        nxsched_deadline_handler,
+                                        (FAR void *)(uintptr_t)tcb->pid);
+                  nxsched_smp_call_single_async(tcb->cpu, &g_call_data);
+                }
+              else
+#endif
+              if (nxsched_reprioritize_rtr(tcb, tcb->sched_priority))
+                {
+                  up_switch_context(this_task(), rtcb);
+                }
+            }
+        }
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_SCHED_DEADLINE */
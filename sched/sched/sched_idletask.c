@@ -27,13 +27,48 @@
 #include <nuttx/config.h>
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <assert.h>
+#include <time.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/init.h>
 #include <nuttx/sched.h>
 
 #include "sched/sched.h"
 
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_IDLE_POLL
+struct idle_poll_s g_idle_poll[CONFIG_SMP_NCPUS];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_idle_usec
+ *
+ * Description:
+ *   Convert a perf_gettime() interval to microseconds.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_IDLE_POLL
+static uint32_t nxsched_idle_usec(clock_t elapsed)
+{
+  struct timespec ts;
+  uint64_t usec;
+
+  perf_convert(elapsed, &ts);
+  usec = (uint64_t)ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+  return usec > UINT32_MAX ? UINT32_MAX : (uint32_t)usec;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -85,3 +120,116 @@ bool sched_idletask(void)
 
   return true;
 }
+
+#ifdef CONFIG_SCHED_IDLE_POLL
+/****************************************************************************
+ * Name: nxsched_idle_poll
+ *
+ * Description:
+ *   Called by the IDLE loop before up_idle().  Spin until a task is made
+ *   ready-to-run on this CPU or until CONFIG_SCHED_IDLE_POLL_USEC
+ *   microseconds have passed.  Interrupts are serviced immediately
+ *   meanwhile since the CPU is not in a wait state.
+ *
+ * Returned Value:
+ *   True if polling was ended by a wakeup request:  The caller should loop
+ *   again instead of calling up_idle().
+ *
+ ****************************************************************************/
+
+bool nxsched_idle_poll(void)
+{
+  static clock_t timeout;
+  FAR struct idle_poll_s *poll;
+  clock_t wakeup;
+  clock_t start;
+  clock_t now;
+  uint32_t usec;
+  int cpu = this_cpu();
+
+  if ((CONFIG_SCHED_IDLE_POLL_CPUS & (1ul << cpu)) == 0)
+    {
+      return false;
+    }
+
+  if (timeout == 0)
+    {
+      timeout = (uint64_t)perf_getfreq() * CONFIG_SCHED_IDLE_POLL_USEC /
+                USEC_PER_SEC + 1;
+    }
+
+  poll  = &g_idle_poll[cpu];
+  start = perf_gettime();
+
+  do
+    {
+      wakeup = poll->wakeup;
+      now    = perf_gettime();
+    }
+  while (wakeup == 0 && now - start < timeout);
+
+  poll->polls++;
+  poll->spin += nxsched_idle_usec(now - start);
+
+  if (wakeup == 0)
+    {
+      return false;
+    }
+
+  poll->wakeup = 0;
+  poll->hits++;
+
+  /* The request may have been made just before the time stamp 'now' on
+   * another CPU, so 'now' is not always later.
+   */
+
+  if (now - wakeup < timeout)
+    {
+      usec = nxsched_idle_usec(now - wakeup);
+      if (usec > poll->maxlat)
+        {
+          poll->maxlat = usec;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: nxsched_idle_wakeup
+ *
+ * Description:
+ *   Called when a task is made ready-to-run on 'cpu'.  End the polling of
+ *   the IDLE task of the CPU if it is running.
+ *
+ ****************************************************************************/
+
+void nxsched_idle_wakeup(int cpu)
+{
+  FAR struct idle_poll_s *poll = &g_idle_poll[cpu];
+
+  if (poll->wakeup == 0 && is_idle_task(current_task(cpu)))
+    {
+      /* Zero means "no request", so avoid it as a time stamp */
+
+      poll->wakeup = perf_gettime() | 1;
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_idle_resume
+ *
+ * Description:
+ *   Called when 'tcb' resumes.  A wakeup request that made the IDLE task
+ *   switch away is stale once the IDLE task runs again.
+ *
+ ****************************************************************************/
+
+void nxsched_idle_resume(FAR struct tcb_s *tcb)
+{
+  if (is_idle_task(tcb))
+    {
+      g_idle_poll[this_cpu()].wakeup = 0;
+    }
+}
+#endif /* CONFIG_SCHED_IDLE_POLL */
@@ -0,0 +1,152 @@
+/****************************************************************************
+ * sched/sched/sched_latency.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <strings.h>
+#include <time.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/sched.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* Wakeup latency histogram of each CPU */
+
+struct sched_latency_s g_sched_latency[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_latency_add
+ *
+ * Description:
+ *   Add one latency sample to a histogram.
+ *
+ ****************************************************************************/
+
+static void nxsched_latency_add(FAR struct sched_latency_s *latency,
+                                uint32_t usec, int bucket)
+{
+  latency->count++;
+  latency->hist[bucket]++;
+
+  if (usec > latency->max)
+    {
+      latency->max = usec;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_latency_ready
+ *
+ * Description:
+ *   Called from nxsched_add_readytorun() when a thread is made
+ *   ready-to-run.  A thread that is already waiting to run keeps its
+ *   original time stamp.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread that is made ready-to-run.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_latency_ready(FAR struct tcb_s *tcb)
+{
+  if (tcb->ready_start == 0)
+    {
+      /* Zero means "not waiting", so avoid it as a time stamp */
+
+      tcb->ready_start = perf_gettime() | 1;
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_latency_resume
+ *
+ * Description:
+ *   Called from nxsched_resume_scheduler() on the CPU that starts running
+ *   the thread.  Account the time since the thread was made ready-to-run
+ *   in the histograms of the thread and of the CPU.
+ *
+ *   Each histogram is only updated with interrupts disabled:  The thread
+ *   histogram by the CPU that runs the thread and the CPU histogram by its
+ *   own CPU.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread that is about to run.
+ *
+ ****************************************************************************/
+
+void nxsched_latency_resume(FAR struct tcb_s *tcb)
+{
+  struct timespec ts;
+  uint64_t usec;
+  int bucket;
+
+  if (tcb->ready_start == 0)
+    {
+      /* Resumed without being made ready-to-run, e.g. the first switch to
+       * the IDLE thread.
+       */
+
+      return;
+    }
+
+  perf_convert(perf_gettime() - tcb->ready_start, &ts);
+  tcb->ready_start = 0;
+
+  usec = (uint64_t)ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+  if (usec > UINT32_MAX)
+    {
+      usec = UINT32_MAX;
+    }
+
+  /* Bucket n holds [2^n, 2^(n+1)) microseconds */
+
+  bucket = usec > 1 ? fls((unsigned int)usec) - 1 : 0;
+  if (bucket >= CONFIG_SCHED_LATENCY_NBUCKETS)
+    {
+      bucket = CONFIG_SCHED_LATENCY_NBUCKETS - 1;
+    }
+
+  nxsched_latency_add(&tcb->latency, (uint32_t)usec, bucket);
+  nxsched_latency_add(&g_sched_latency[this_cpu()], (uint32_t)usec, bucket);
+}
@@ -107,7 +107,7 @@ bool nxsched_merge_pending(void)
            */
 
           for (;
-               (rtcb && ptcb->sched_priority <= rtcb->sched_priority);
+               (rtcb && !nxsched_precedes(ptcb, rtcb));
                rtcb = rtcb->flink)
             {
             }
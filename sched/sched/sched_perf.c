@@ -31,6 +31,7 @@
 #include <poll.h>
 
 #include <nuttx/atomic.h>
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/mutex.h>
 #include <nuttx/perf.h>
@@ -169,6 +170,7 @@ static void perf_sample_data_init(FAR struct perf_sample_data_s *data,
 {
   data->sample_flags = PERF_SAMPLE_PERIOD;
   data->period = period;
+  data->callchain = NULL;
 }
 
 static uint16_t perf_prepare_sample(FAR struct perf_sample_data_s *data,
@@ -220,6 +222,41 @@ static uint16_t perf_prepare_sample(FAR struct perf_sample_data_s *data,
       size += sizeof(data->tid_entry);
     }
 
+  if (sample_type & PERF_SAMPLE_TIME)
+    {
+      struct timespec ts;
+
+      clock_systime_timespec(&ts);
+      data->time = (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+      data->sample_flags |= PERF_SAMPLE_TIME;
+      size += sizeof(data->time);
+    }
+
+  if (sample_type & PERF_SAMPLE_CPU)
+    {
+      data->cpu_entry.cpu = this_cpu();
+      data->cpu_entry.reserved = 0;
+      data->sample_flags |= PERF_SAMPLE_CPU;
+      size += sizeof(data->cpu_entry);
+    }
+
+  if (sample_type & PERF_SAMPLE_PERIOD)
+    {
+      size += sizeof(data->period);
+    }
+  else
+    {
+      data->sample_flags &= ~PERF_SAMPLE_PERIOD;
+    }
+
+#if CONFIG_SCHED_PERF_EVENTS_CALLCHAIN > 0
+  if ((sample_type & PERF_SAMPLE_CALLCHAIN) && data->callchain != NULL)
+    {
+      data->sample_flags |= PERF_SAMPLE_CALLCHAIN;
+      size += sizeof(uint64_t) * (data->callchain->nr + 1);
+    }
+#endif
+
   return size;
 }
 
@@ -243,10 +280,35 @@ static void perf_output_sample(FAR struct perf_event_header_s *header,
                         sizeof(data->tid_entry));
     }
 
+  if (sample_type & PERF_SAMPLE_TIME)
+    {
+      circbuf_overwrite(&(event->buf->rb), &data->time, sizeof(data->time));
+    }
+
   if (sample_type & PERF_SAMPLE_ID)
     {
       circbuf_overwrite(&(event->buf->rb), &data->id, sizeof(data->id));
     }
+
+  if (sample_type & PERF_SAMPLE_CPU)
+    {
+      circbuf_overwrite(&(event->buf->rb), &data->cpu_entry,
+                        sizeof(data->cpu_entry));
+    }
+
+  if (sample_type & PERF_SAMPLE_PERIOD)
+    {
+      circbuf_overwrite(&(event->buf->rb), &data->period,
+                        sizeof(data->period));
+    }
+
+#if CONFIG_SCHED_PERF_EVENTS_CALLCHAIN > 0
+  if (sample_type & PERF_SAMPLE_CALLCHAIN)
+    {
+      circbuf_overwrite(&(event->buf->rb), data->callchain,
+                        sizeof(uint64_t) * (data->callchain->nr + 1));
+    }
+#endif
 }
 
 static int perf_event_data_overflow(FAR struct perf_event_s *event,
@@ -262,7 +324,6 @@ static int perf_event_data_overflow(FAR struct perf_event_s *event,
     }
 
   space = circbuf_space(&(event->buf->rb));
-  event->count++;
   header.size = perf_prepare_sample(data, event, ip);
   header.type = PERF_RECORD_SAMPLE;
 
@@ -500,6 +561,7 @@ perf_get_context(FAR struct perf_event_s *event,
       if (ctx == NULL)
         {
           serr("task perf event alloc fail\n");
+          nxmutex_unlock(&tcb->perf_event_mutex);
           return NULL;
         }
 
@@ -1333,7 +1395,7 @@ static int perf_task_function_call(FAR struct tcb_s *tcb,
 #ifdef CONFIG_SMP
   if (tcb->cpu != this_cpu())
     {
-      return nxsched_smp_call_single(tcb->cpu, func, event, true);
+      return nxsched_smp_call_single(tcb->cpu, func, event);
     }
 #endif
 
@@ -1363,7 +1425,7 @@ static int perf_cpu_function_call(int cpu, FAR struct perf_event_s *event,
 #ifdef CONFIG_SMP
   if (cpu != this_cpu())
     {
-      return nxsched_smp_call_single(cpu, func, event, true);
+      return nxsched_smp_call_single(cpu, func, event);
     }
 #endif
 
@@ -1970,7 +2032,7 @@ static int perf_setup_task_context(FAR struct tcb_s *tcb)
   FAR struct perf_event_context_s *parent_ctx = parent->perf_event_ctx;
   FAR struct perf_event_s *group_leader;
   irqstate_t flags;
-  int ret;
+  int ret = OK;
 
   /* Inherit parent event if it has */
 
@@ -2257,6 +2319,7 @@ static void perf_swevent_timer_handle(wdparm_t arg)
 
   perf_sample_data_init(&data, event->attr.sample_period);
 
+  event->count++;
   flags = spin_lock_irqsave(&event->buf->lock);
   perf_event_data_overflow(event, &data, pc);
   spin_unlock_irqrestore(&event->buf->lock, flags);
@@ -2471,9 +2534,74 @@ static int perf_swevent_match(FAR struct perf_event_s *event)
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: perf_event_overflow
+ *
+ * Description:
+ *   Record a sample of a sampling event, called by the PMU drivers from
+ *   the overflow interrupt once the count of the event has been updated
+ *   and the counter reloaded with the next period.  The sample goes to
+ *   the ring buffer mapped by the event, and to the instrumentation
+ *   buffer as a mark of the interrupted address.
+ *
+ * Input Parameters:
+ *   event - The event whose counter overflowed
+ *
+ * Returned Value:
+ *   Zero (OK) is returned if the event keeps counting; a negated errno
+ *   value is returned if the PMU driver should stop the event.
+ *
+ ****************************************************************************/
+
 int perf_event_overflow(FAR struct perf_event_s *event)
 {
-  return 0;
+  struct perf_sample_data_s data;
+#if CONFIG_SCHED_PERF_EVENTS_CALLCHAIN > 0
+  struct perf_callchain_entry callchain;
+  FAR void *ips[CONFIG_SCHED_PERF_EVENTS_CALLCHAIN];
+  int i;
+#endif
+  uintptr_t pc;
+  irqstate_t flags;
+  int ret;
+
+  /* The counter of a counting event just wrapped, keep it running */
+
+  if (event->attr.freq || event->attr.sample_period == 0)
+    {
+      return OK;
+    }
+
+  pc = up_getusrpc(NULL);
+  perf_sample_data_init(&data, event->attr.sample_period);
+
+#if CONFIG_SCHED_PERF_EVENTS_CALLCHAIN > 0
+  if (event->attr.sample_type & PERF_SAMPLE_CALLCHAIN)
+    {
+      ret = up_backtrace(this_task(), ips,
+                         CONFIG_SCHED_PERF_EVENTS_CALLCHAIN, 0);
+      callchain.nr = ret > 0 ? ret : 0;
+      for (i = 0; i < callchain.nr; i++)
+        {
+          callchain.ip[i] = (uintptr_t)ips[i];
+        }
+
+      data.callchain = &callchain;
+    }
+#endif
+
+  sched_note_event_ip(NOTE_TAG_SCHED, pc, NOTE_DUMP_MARK, "perf", 4);
+
+  if (event->buf == NULL)
+    {
+      return OK;
+    }
+
+  flags = spin_lock_irqsave(&event->buf->lock);
+  ret = perf_event_data_overflow(event, &data, pc);
+  spin_unlock_irqrestore(&event->buf->lock, flags);
+
+  return ret;
 }
 
 void perf_swevent(uint32_t event_id, uintptr_t ip)
@@ -2492,6 +2620,7 @@ void perf_swevent(uint32_t event_id, uintptr_t ip)
       if (node->attr.type == PERF_TYPE_SOFTWARE &&
           node->attr.config == event_id && node->hw.state == 1)
         {
+          node->count++;
           perf_event_data_overflow(node, &data, ip);
         }
     }
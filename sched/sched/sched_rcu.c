@@ -0,0 +1,267 @@
+/****************************************************************************
+ * sched/sched/sched_rcu.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sched.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/rcu.h>
+#include <nuttx/signal.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wqueue.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_RCU
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+/* The RCU state of one CPU.  Readers cannot be pre-empted or migrated, so
+ * a CPU has passed through a quiescent state once it has been seen outside
+ * of any read-side critical section or once it has switched context.
+ */
+
+struct rcu_cpu_s
+{
+  volatile unsigned int nesting;  /* Read-side critical section nesting */
+  volatile unsigned int qscount;  /* Number of context switches */
+};
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+static struct rcu_cpu_s g_rcu_cpu[CONFIG_SMP_NCPUS];
+#endif
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+/* Callbacks waiting for the next grace period */
+
+static FAR struct rcu_head *g_rcu_pending;
+static spinlock_t g_rcu_lock = SP_UNLOCKED;
+static struct work_s g_rcu_work;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rcu_worker
+ *
+ * Description:
+ *   Invoke the pending call_rcu() callbacks after a grace period.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+static void rcu_worker(FAR void *arg)
+{
+  FAR struct rcu_head *head;
+  FAR struct rcu_head *next;
+  irqstate_t flags;
+
+  for (; ; )
+    {
+      flags = spin_lock_irqsave(&g_rcu_lock);
+      head          = g_rcu_pending;
+      g_rcu_pending = NULL;
+      spin_unlock_irqrestore(&g_rcu_lock, flags);
+
+      if (head == NULL)
+        {
+          break;
+        }
+
+      synchronize_rcu();
+
+      for (; head != NULL; head = next)
+        {
+          next = head->next;
+          head->func(head);
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rcu_read_lock
+ *
+ * Description:
+ *   Enter an RCU read-side critical section.
+ *
+ ****************************************************************************/
+
+void rcu_read_lock(void)
+{
+  sched_lock();
+
+#ifdef CONFIG_SMP
+  g_rcu_cpu[this_cpu()].nesting++;
+  SP_DMB();
+#endif
+}
+
+/****************************************************************************
+ * Name: rcu_read_unlock
+ *
+ * Description:
+ *   Leave an RCU read-side critical section.
+ *
+ ****************************************************************************/
+
+void rcu_read_unlock(void)
+{
+#ifdef CONFIG_SMP
+  FAR struct rcu_cpu_s *rcpu = &g_rcu_cpu[this_cpu()];
+
+  DEBUGASSERT(rcpu->nesting > 0);
+  SP_DMB();
+  rcpu->nesting--;
+#endif
+
+  sched_unlock();
+}
+
+/****************************************************************************
+ * Name: synchronize_rcu
+ *
+ * Description:
+ *   Wait until all RCU read-side critical sections that were entered
+ *   before the call have been left.
+ *
+ *   With a single CPU, readers cannot be pre-empted:  no reader is active
+ *   while the caller runs and there is nothing to wait for.
+ *
+ ****************************************************************************/
+
+void synchronize_rcu(void)
+{
+#ifdef CONFIG_SMP
+  unsigned int snap[CONFIG_SMP_NCPUS];
+  cpu_set_t pending = 0;
+  int cpu;
+
+  DEBUGASSERT(!up_interrupt_context());
+
+  /* Order the updates of the caller before the check of the readers */
+
+  SP_DMB();
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      snap[cpu] = g_rcu_cpu[cpu].qscount;
+      pending  |= (cpu_set_t)1 << cpu;
+    }
+
+  for (; ; )
+    {
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          if ((pending & ((cpu_set_t)1 << cpu)) != 0 &&
+              (g_rcu_cpu[cpu].nesting == 0 ||
+               g_rcu_cpu[cpu].qscount != snap[cpu]))
+            {
+              pending &= ~((cpu_set_t)1 << cpu);
+            }
+        }
+
+      if (pending == 0)
+        {
+          break;
+        }
+
+      /* Some CPU is still in a read-side critical section that may have
+       * been entered before the call.  Readers are short, check again on
+       * the next tick.
+       */
+
+      nxsig_usleep(USEC_PER_TICK);
+    }
+
+  SP_DMB();
+#endif
+}
+
+/****************************************************************************
+ * Name: call_rcu
+ *
+ * Description:
+ *   Call 'func' with 'head' after a grace period.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+void call_rcu(FAR struct rcu_head *head, rcu_callback_t func)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(head != NULL && func != NULL);
+
+  head->func = func;
+
+  flags = spin_lock_irqsave(&g_rcu_lock);
+  head->next    = g_rcu_pending;
+  g_rcu_pending = head;
+  spin_unlock_irqrestore(&g_rcu_lock, flags);
+
+  if (work_available(&g_rcu_work))
+    {
+      work_queue(LPWORK, &g_rcu_work, rcu_worker, NULL, 0);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: nxsched_rcu_quiescent
+ *
+ * Description:
+ *   Called when the current CPU switches context.  Readers never hold the
+ *   CPU across a context switch, so this ends any grace period for this
+ *   CPU even if it enters read-side critical sections back to back.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+void nxsched_rcu_quiescent(void)
+{
+  g_rcu_cpu[this_cpu()].qscount++;
+}
+#endif
+
+#endif /* CONFIG_RCU */
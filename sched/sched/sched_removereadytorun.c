@@ -184,6 +184,30 @@ void nxsched_remove_running(FAR struct tcb_s *tcb)
 
   dq_rem_head((FAR dq_entry_t *)tcb, tasklist);
 
+#ifdef CONFIG_SCHED_PERCPU_READYTORUN
+  /* Take the next task from this CPU's own queue unless some other queue
+   * holds a more important task that may run here.  In that case, steal
+   * it.
+   */
+
+  rtrtcb = nxsched_find_stealable(cpu, nxttcb);
+  if (rtrtcb != nxttcb)
+    {
+      if (rtrtcb->task_state == TSTATE_TASK_READYTORUN)
+        {
+          dq_rem((FAR dq_entry_t *)rtrtcb, list_readytorun());
+        }
+      else
+        {
+          dq_rem_mid(rtrtcb);
+        }
+
+      dq_addfirst_nonempty((FAR dq_entry_t *)rtrtcb, tasklist);
+
+      rtrtcb->cpu = cpu;
+      nxttcb = rtrtcb;
+    }
+#else
   /* Find the highest priority non-running tasks in the g_assignedtasks
    * list of other CPUs, and also non-idle tasks, place them in the
    * g_readytorun list. so as to find the task with the highest priority,
@@ -260,6 +284,8 @@ void nxsched_remove_running(FAR struct tcb_s *tcb)
       nxttcb = rtrtcb;
     }
 
+#endif
+
   /* NOTE: If the task runs on another CPU(cpu), adjusting global IRQ
    * controls will be done in the pause handler on the new CPU(cpu).
    * If the task is scheduled on this CPU(me), do nothing because
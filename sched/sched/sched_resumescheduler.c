@@ -31,6 +31,7 @@
 #include <nuttx/sched.h>
 #include <nuttx/clock.h>
 #include <nuttx/sched_note.h>
+#include <nuttx/tls.h>
 
 #ifdef CONFIG_SCHED_PERF_EVENTS
 #  include <nuttx/perf.h>
@@ -77,6 +78,18 @@ void nxsched_resume_scheduler(FAR struct tcb_s *tcb)
 #ifdef CONFIG_SCHED_CRITMONITOR
   nxsched_resume_critmon(tcb);
 #endif
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+  nxsched_cpuload_resume(tcb);
+#endif
+#ifdef CONFIG_SCHED_LATENCY
+  nxsched_latency_resume(tcb);
+#endif
+#ifdef CONFIG_SCHED_UTIL
+  nxsched_util_resume(tcb);
+#endif
+#ifdef CONFIG_SCHED_IDLE_POLL
+  nxsched_idle_resume(tcb);
+#endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION
   sched_note_resume(tcb);
 #endif
@@ -84,6 +97,19 @@ void nxsched_resume_scheduler(FAR struct tcb_s *tcb)
 #ifdef CONFIG_SCHED_PERF_EVENTS
   perf_event_task_sched_in(tcb);
 #endif
+
+#if defined(CONFIG_SCHED_VDSO) && defined(CONFIG_SMP)
+  /* Tell sched_getcpu() in user space where the thread runs now.  Kernel
+   * threads, and the IDLE threads in particular, have no user space.
+   */
+
+  if ((tcb->flags & TCB_FLAG_TTYPE_MASK) != TCB_FLAG_TTYPE_KERNEL)
+    {
+      FAR struct tls_info_s *info = tcb->stack_alloc_ptr;
+
+      info->tl_cpu = tcb->cpu;
+    }
+#endif
 }
 
 #endif /* CONFIG_SCHED_RESUMESCHEDULER */
@@ -0,0 +1,263 @@
+/****************************************************************************
+ * sched/sched/sched_setattr.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <sched.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/sched.h>
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_DEADLINE
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_set_deadline
+ *
+ * Description:
+ *   Switch the thread 'pid' to the SCHED_DEADLINE policy.
+ *
+ ****************************************************************************/
+
+static int nxsched_set_deadline(pid_t pid,
+                                FAR const struct sched_attr *attr)
+{
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  uint64_t period;
+  int ret;
+
+  /* Like Linux, a zero period means that the period equals the deadline */
+
+  period = attr->sched_period != 0 ? attr->sched_period :
+                                     attr->sched_deadline;
+
+  if (attr->sched_runtime == 0 || attr->sched_runtime > period ||
+      period > INT32_MAX * (uint64_t)NSEC_PER_TICK)
+    {
+      return -EINVAL;
+    }
+
+  if (pid == 0)
+    {
+      pid = nxsched_gettid();
+    }
+
+  tcb = nxsched_get_tcb(pid);
+  if (!tcb)
+    {
+      return -ESRCH;
+    }
+
+  /* Prohibit any context switches while we muck with priority and scheduler
+   * settings.
+   */
+
+  sched_lock();
+
+  flags = enter_critical_section();
+
+#ifdef CONFIG_SCHED_SPORADIC
+  /* Cancel any on-going sporadic scheduling */
+
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_SPORADIC)
+    {
+      DEBUGVERIFY(nxsched_stop_sporadic(tcb));
+    }
+#endif
+
+  ret = nxsched_start_deadline(tcb, NSEC2TICK(attr->sched_runtime),
+                               NSEC2TICK(attr->sched_deadline),
+                               NSEC2TICK(period));
+
+  leave_critical_section(flags);
+
+  /* All deadline threads run at the same priority */
+
+  if (ret >= 0)
+    {
+      ret = nxsched_reprioritize(tcb, CONFIG_SCHED_DEADLINE_PRIORITY);
+    }
+
+  sched_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_setattr
+ *
+ * Description:
+ *   sched_setattr() sets the scheduling policy and the associated
+ *   attributes of the thread identified by pid.  If pid equals zero, the
+ *   calling thread is modified.  This is the only interface that may
+ *   select the SCHED_DEADLINE policy; the other policies are handled by
+ *   sched_setscheduler().
+ *
+ * Input Parameters:
+ *   pid   - The ID of the thread to modify, zero for the calling thread.
+ *   attr  - The new scheduling policy and attributes.  For SCHED_DEADLINE,
+ *           sched_runtime, sched_deadline and sched_period are given in
+ *           nanoseconds and must satisfy
+ *           runtime <= deadline <= period.
+ *   flags - Must be zero.
+ *
+ * Returned Value:
+ *   On success, sched_setattr() returns OK (zero).  On error, ERROR (-1)
+ *   is returned, and errno is set appropriately:
+ *
+ *   EINVAL The policy or one of the attributes is not valid.
+ *   ESRCH  The thread whose ID is pid could not be found.
+ *   EBUSY  The SCHED_DEADLINE reservation exceeds the available bandwidth.
+ *
+ ****************************************************************************/
+
+int sched_setattr(pid_t pid, FAR const struct sched_attr *attr,
+                  unsigned int flags)
+{
+  struct sched_param param;
+  int ret;
+
+  if (attr == NULL || flags != 0 || attr->sched_flags != 0)
+    {
+      ret = -EINVAL;
+    }
+  else if (attr->sched_policy == SCHED_DEADLINE)
+    {
+      ret = nxsched_set_deadline(pid, attr);
+    }
+  else if (attr->sched_policy == SCHED_SPORADIC)
+    {
+      /* The sporadic parameters do not fit in struct sched_attr */
+
+      ret = -EINVAL;
+    }
+  else
+    {
+      memset(&param, 0, sizeof(param));
+      param.sched_priority = attr->sched_priority;
+      ret = nxsched_set_scheduler(pid, attr->sched_policy, &param);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: sched_getattr
+ *
+ * Description:
+ *   sched_getattr() returns the scheduling policy and the associated
+ *   attributes of the thread identified by pid.  If pid equals zero, the
+ *   attributes of the calling thread are returned.
+ *
+ * Input Parameters:
+ *   pid   - The ID of the thread to query, zero for the calling thread.
+ *   attr  - The location to return the attributes.
+ *   size  - The size of the buffer pointed to by attr.
+ *   flags - Must be zero.
+ *
+ * Returned Value:
+ *   On success, sched_getattr() returns OK (zero).  On error, ERROR (-1)
+ *   is returned, and errno is set appropriately:
+ *
+ *   EINVAL attr is NULL, size is too small or flags is not zero.
+ *   ESRCH  The thread whose ID is pid could not be found.
+ *
+ ****************************************************************************/
+
+int sched_getattr(pid_t pid, FAR struct sched_attr *attr,
+                  unsigned int size, unsigned int flags)
+{
+  struct sched_param param;
+  FAR struct tcb_s *tcb;
+  irqstate_t irqflags;
+  int ret;
+
+  if (attr == NULL || size < sizeof(struct sched_attr) || flags != 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  ret = nxsched_get_param(pid, &param);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      return ERROR;
+    }
+
+  memset(attr, 0, sizeof(*attr));
+  attr->size           = sizeof(*attr);
+  attr->sched_priority = param.sched_priority;
+
+  irqflags = enter_critical_section();
+
+  tcb = pid == 0 ? this_task() : nxsched_get_tcb(pid);
+  if (tcb == NULL)
+    {
+      leave_critical_section(irqflags);
+      set_errno(ESRCH);
+      return ERROR;
+    }
+
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      attr->sched_policy   = SCHED_DEADLINE;
+      attr->sched_runtime  = TICK2NSEC((uint64_t)tcb->deadline.runtime);
+      attr->sched_deadline = TICK2NSEC((uint64_t)tcb->deadline.deadline);
+      attr->sched_period   = TICK2NSEC((uint64_t)tcb->deadline.period);
+    }
+  else
+    {
+      attr->sched_policy   = ((tcb->flags & TCB_FLAG_POLICY_MASK) >>
+                              TCB_FLAG_POLICY_SHIFT) + 1;
+    }
+
+  leave_critical_section(irqflags);
+  return OK;
+}
+
+#endif /* CONFIG_SCHED_DEADLINE */
@@ -107,7 +107,9 @@ static int reprioritize_handler(FAR void *cookie)
 static FAR struct tcb_s *nxsched_nexttcb(FAR struct tcb_s *tcb)
 {
   FAR struct tcb_s *nxttcb = tcb->flink;
+#ifndef CONFIG_SCHED_PERCPU_READYTORUN
   FAR struct tcb_s *rtrtcb;
+#endif
 
   /* Which task should run next?  It will be either the next tcb in the
    * assigned task list (nxttcb) or a TCB in the g_readytorun list.  We can
@@ -120,6 +122,11 @@ static FAR struct tcb_s *nxsched_nexttcb(FAR struct tcb_s *tcb)
 
   if (!nxsched_islocked_tcb(this_task()))
     {
+#ifdef CONFIG_SCHED_PERCPU_READYTORUN
+      /* Consider the queues of the other CPUs as well */
+
+      return nxsched_find_stealable(tcb->cpu, nxttcb);
+#else
       /* Search for the highest priority task that can run on tcb->cpu. */
 
       for (rtrtcb = (FAR struct tcb_s *)list_readytorun()->head;
@@ -135,6 +142,7 @@ static FAR struct tcb_s *nxsched_nexttcb(FAR struct tcb_s *tcb)
         {
           return rtrtcb;
         }
+#endif
     }
 
   /* Otherwise, return the next TCB in the g_assignedtasks[] list...
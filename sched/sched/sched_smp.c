@@ -26,16 +26,49 @@
 
 #include <nuttx/config.h>
 
+#include <sys/stat.h>
 #include <assert.h>
+#include <debug.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+
 #include <nuttx/arch.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/nuttx.h>
 #include <nuttx/queue.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/sched.h>
 #include <nuttx/spinlock.h>
+#include <nuttx/fs/procfs.h>
 
 #include "sched/sched.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_SMPCALL_STATS
+/* Output format:
+ *
+ *            1111111111222222222233333333334444
+ *   1234567890123456789012345678901234567890123
+ *
+ *   CPU      CALLS       IPIS  COALESCED
+ *   DDD DDDDDDDDDD DDDDDDDDDD DDDDDDDDDD
+ */
+
+#  define HDR_FMT  "CPU      CALLS       IPIS  COALESCED\n"
+#  define CPU_FMT  "%3d %10lu %10lu %10lu\n"
+
+#  define SMPCALL_LINELEN 48
+
+#  define smp_call_count(cpu, field) (g_smp_call_cpu[cpu].field++)
+#else
+#  define smp_call_count(cpu, field)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -46,12 +79,83 @@ struct smp_call_cookie_s
   int         error;
 };
 
+/* The calls pending on one CPU.  An IPI is only sent when the queue
+ * becomes non-empty: the handler drains the queue completely, so calls
+ * added while an IPI is pending are coalesced into it.
+ */
+
+struct smp_call_cpu_s
+{
+  sq_queue_t    queue;       /* Pending calls */
+  spinlock_t    lock;        /* Protects the queue */
+#ifdef CONFIG_SCHED_SMPCALL_STATS
+  unsigned long calls;       /* Calls performed by this CPU */
+  unsigned long ipis;        /* IPIs sent to this CPU */
+  unsigned long coalesced;   /* Calls that did not need an IPI */
+#endif
+};
+
+#ifdef CONFIG_SCHED_SMPCALL_STATS
+/* This structure describes one open "file" */
+
+struct smpcall_file_s
+{
+  struct procfs_file_s base;     /* Base open file structure */
+  char line[SMPCALL_LINELEN];    /* Pre-allocated buffer for formatted lines */
+};
+#endif
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_SMPCALL_STATS
+/* File system methods */
+
+static int     smpcall_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     smpcall_close(FAR struct file *filep);
+static ssize_t smpcall_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     smpcall_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     smpcall_stat(FAR const char *relpath, FAR struct stat *buf);
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
-static sq_queue_t g_smp_call_queue[CONFIG_SMP_NCPUS];
-static spinlock_t g_smp_call_lock;
+static struct smp_call_cpu_s g_smp_call_cpu[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_SMPCALL_STATS
+/* See fs_mount.c -- this structure is explicitly extern'ed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_smpcall_operations =
+{
+  smpcall_open,        /* open */
+  smpcall_close,       /* close */
+  smpcall_read,        /* read */
+  NULL,                /* write */
+  NULL,                /* poll */
+
+  smpcall_dup,         /* dup */
+
+  NULL,                /* opendir */
+  NULL,                /* closedir */
+  NULL,                /* readdir */
+  NULL,                /* rewinddir */
+
+  smpcall_stat         /* stat */
+};
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -68,24 +172,202 @@ static spinlock_t g_smp_call_lock;
  *   data  - Call data
  *
  * Returned Value:
- *   None
+ *   True if the target CPU has to be interrupted, false if an interrupt
+ *   is already pending and will perform the call as well.
  *
  ****************************************************************************/
 
-static void nxsched_smp_call_add(int cpu,
+static bool nxsched_smp_call_add(int cpu,
                                  FAR struct smp_call_data_s *data)
 {
+  FAR struct smp_call_cpu_s *call = &g_smp_call_cpu[cpu];
   irqstate_t flags;
+  bool notify;
+
+  flags  = spin_lock_irqsave(&call->lock);
+  notify = sq_empty(&call->queue);
+  if (!sq_inqueue(&data->node[cpu], &call->queue))
+    {
+      sq_addlast(&data->node[cpu], &call->queue);
+    }
+
+  if (notify)
+    {
+      smp_call_count(cpu, ipis);
+    }
+  else
+    {
+      smp_call_count(cpu, coalesced);
+    }
+
+  spin_unlock_irqrestore(&call->lock, flags);
+  return notify;
+}
+
+#ifdef CONFIG_SCHED_SMPCALL_STATS
+
+/****************************************************************************
+ * Name: smpcall_open
+ ****************************************************************************/
+
+static int smpcall_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct smpcall_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* This PROCFS file is read-only.  Any attempt to open with write access
+   * is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = kmm_zalloc(sizeof(struct smpcall_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: smpcall_close
+ ****************************************************************************/
+
+static int smpcall_close(FAR struct file *filep)
+{
+  FAR struct smpcall_file_s *attr;
 
-  flags = spin_lock_irqsave(&g_smp_call_lock);
-  if (!sq_inqueue(&data->node[cpu], &g_smp_call_queue[cpu]))
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct smpcall_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: smpcall_read
+ ****************************************************************************/
+
+static ssize_t smpcall_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct smpcall_file_s *attr;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int cpu;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct smpcall_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset = filep->f_pos;
+
+  /* The first line to output is the header */
+
+  linesize  = procfs_snprintf(attr->line, SMPCALL_LINELEN, HDR_FMT);
+  copysize  = procfs_memcpy(attr->line, linesize, buffer, buflen, &offset);
+  totalsize = copysize;
+
+  /* Then one line per CPU.  The counters are sampled without the lock */
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS && totalsize < buflen; cpu++)
     {
-      sq_addlast(&data->node[cpu], &g_smp_call_queue[cpu]);
+      linesize = procfs_snprintf(attr->line, SMPCALL_LINELEN, CPU_FMT, cpu,
+                                 g_smp_call_cpu[cpu].calls,
+                                 g_smp_call_cpu[cpu].ipis,
+                                 g_smp_call_cpu[cpu].coalesced);
+      copysize = procfs_memcpy(attr->line, linesize, buffer + totalsize,
+                               buflen - totalsize, &offset);
+
+      totalsize += copysize;
     }
 
-  spin_unlock_irqrestore(&g_smp_call_lock, flags);
+  /* Update the file position */
+
+  filep->f_pos += totalsize;
+  return totalsize;
 }
 
+/****************************************************************************
+ * Name: smpcall_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int smpcall_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct smpcall_file_s *oldattr;
+  FAR struct smpcall_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct smpcall_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct smpcall_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct smpcall_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: smpcall_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int smpcall_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "smpcall" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* CONFIG_SCHED_SMPCALL_STATS */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -109,41 +391,46 @@ static void nxsched_smp_call_add(int cpu,
 int nxsched_smp_call_handler(int irq, FAR void *context,
                              FAR void *arg)
 {
-  FAR sq_queue_t *call_queue;
-  FAR sq_entry_t *curr;
-  FAR sq_entry_t *next;
   int cpu = this_cpu();
+  FAR struct smp_call_cpu_s *call = &g_smp_call_cpu[cpu];
+  FAR struct smp_call_data_s *data;
+  FAR sq_entry_t *curr;
+  irqstate_t flags;
+  int ret;
 
-  irqstate_t flags = spin_lock_irqsave(&g_smp_call_lock);
-
-  call_queue = &g_smp_call_queue[cpu];
+  /* Perform all pending calls, including those that are added while the
+   * calls are performed.  Their IPI has been coalesced into this one.
+   */
 
-  sq_for_every_safe(call_queue, curr, next)
+  for (; ; )
     {
-      FAR struct smp_call_data_s *data =
-        container_of(curr, struct smp_call_data_s, node[cpu]);
-      int ret;
-
-      sq_rem(&data->node[cpu], call_queue);
-
-      spin_unlock_irqrestore(&g_smp_call_lock, flags);
+      flags = spin_lock_irqsave(&call->lock);
+      curr  = sq_remfirst(&call->queue);
+      if (curr == NULL)
+        {
+          spin_unlock_irqrestore(&call->lock, flags);
+          break;
+        }
 
-      ret = data->func(data->arg);
+      smp_call_count(cpu, calls);
+      spin_unlock_irqrestore(&call->lock, flags);
 
-      flags = spin_lock_irqsave(&g_smp_call_lock);
+      data = container_of(curr, struct smp_call_data_s, node[cpu]);
+      ret  = data->func(data->arg);
 
       if (data->cookie != NULL)
         {
+          flags = spin_lock_irqsave(&call->lock);
           if (ret < 0)
             {
               data->cookie->error = ret;
             }
 
           nxsem_post(&data->cookie->sem);
+          spin_unlock_irqrestore(&call->lock, flags);
         }
     }
 
-  spin_unlock_irqrestore(&g_smp_call_lock, flags);
   return OK;
 }
 
@@ -303,6 +590,7 @@ int nxsched_smp_call_single_async(int cpuid,
 int nxsched_smp_call_async(cpu_set_t cpuset,
                            FAR struct smp_call_data_s *data)
 {
+  cpu_set_t ipiset;
   int cpucnt;
   int ret = OK;
   int i;
@@ -336,11 +624,19 @@ int nxsched_smp_call_async(cpu_set_t cpuset,
       goto out;
     }
 
+  /* Only interrupt the CPUs that do not have an interrupt pending */
+
+  CPU_ZERO(&ipiset);
+
   for (i = 0; i < CONFIG_SMP_NCPUS; i++)
     {
       if (CPU_ISSET(i, &cpuset))
         {
-          nxsched_smp_call_add(i, data);
+          if (nxsched_smp_call_add(i, data))
+            {
+              CPU_SET(i, &ipiset);
+            }
+
           if (--cpucnt == 0)
             {
               break;
@@ -348,7 +644,10 @@ int nxsched_smp_call_async(cpu_set_t cpuset,
         }
     }
 
-  up_send_smp_call(cpuset);
+  if (CPU_COUNT(&ipiset) > 0)
+    {
+      up_send_smp_call(ipiset);
+    }
 
 out:
   if (!up_interrupt_context())
@@ -34,6 +34,10 @@
 #include <nuttx/clock.h>
 #include <nuttx/sched_note.h>
 
+#ifdef CONFIG_SCHED_PERF_EVENTS
+#  include <nuttx/perf.h>
+#endif
+
 #include "clock/clock.h"
 #include "sched/sched.h"
 
@@ -61,6 +65,12 @@
 
 void nxsched_suspend_scheduler(FAR struct tcb_s *tcb)
 {
+#if defined(CONFIG_RCU) && defined(CONFIG_SMP)
+  /* A context switch is a quiescent state for RCU */
+
+  nxsched_rcu_quiescent();
+#endif
+
   /* Handle the task exiting case */
 
   if (tcb == NULL)
@@ -77,14 +87,30 @@ void nxsched_suspend_scheduler(FAR struct tcb_s *tcb)
     }
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Note if the deadline task is blocking */
+
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      nxsched_suspend_deadline(tcb);
+    }
+#endif
+
   /* Indicate that the task has been suspended */
 
 #ifdef CONFIG_SCHED_CRITMONITOR
   nxsched_suspend_critmon(tcb);
 #endif
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+  nxsched_cpuload_suspend(tcb);
+#endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION
   sched_note_suspend(tcb);
 #endif
+
+#ifdef CONFIG_SCHED_PERF_EVENTS
+  perf_event_task_sched_out(tcb);
+#endif
 }
 
 #endif /* CONFIG_SCHED_SUSPENDSCHEDULER */
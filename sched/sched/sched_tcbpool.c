@@ -0,0 +1,369 @@
+/****************************************************************************
+ * sched/sched/sched_tcbpool.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+#include <string.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/sched.h>
+#include <nuttx/mm/mempool.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TCBPOOL_BLOCKSIZE(size)  ALIGN_UP(size, MEMPOOL_ALIGN)
+
+/* A pooled stack is preceded by a header that holds its class */
+
+#define STACKPOOL_HDRSIZE        MEMPOOL_ALIGN
+#define STACKPOOL_NCLASSES       3
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Task TCBs include the task group.  Kernel threads use them as well. */
+
+static struct mempool_s g_task_tcbpool;
+
+#ifndef CONFIG_DISABLE_PTHREAD
+static struct mempool_s g_pthread_tcbpool;
+#endif
+
+#ifdef CONFIG_SCHED_TCBPOOL_STACK
+static struct mempool_s g_stackpool[STACKPOOL_NCLASSES];
+
+static const size_t g_stackpool_size[STACKPOOL_NCLASSES] =
+{
+  CONFIG_SCHED_TCBPOOL_STACKSIZE1,
+  CONFIG_SCHED_TCBPOOL_STACKSIZE2,
+  CONFIG_SCHED_TCBPOOL_STACKSIZE3
+};
+
+static FAR const char * const g_stackpool_name[STACKPOOL_NCLASSES] =
+{
+  "stack1",
+  "stack2",
+  "stack3"
+};
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcbpool_alloc, tcbpool_free
+ *
+ * Description:
+ *   Memory of the TCB pools, allocated once at boot time.
+ *
+ ****************************************************************************/
+
+static FAR void *tcbpool_alloc(FAR struct mempool_s *pool, size_t size)
+{
+  return kmm_malloc(size);
+}
+
+static void tcbpool_free(FAR struct mempool_s *pool, FAR void *addr)
+{
+  kmm_free(addr);
+}
+
+/****************************************************************************
+ * Name: stackpool_alloc, stackpool_free
+ *
+ * Description:
+ *   Memory of the stack pools.  Only the stacks of tasks and pthreads are
+ *   pooled so they come from the user heap like in up_create_stack().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TCBPOOL_STACK
+static FAR void *stackpool_alloc(FAR struct mempool_s *pool, size_t size)
+{
+  return kumm_malloc(size);
+}
+
+static void stackpool_free(FAR struct mempool_s *pool, FAR void *addr)
+{
+  kumm_free(addr);
+}
+#endif
+
+/****************************************************************************
+ * Name: tcbpool_init
+ ****************************************************************************/
+
+static void tcbpool_init(FAR struct mempool_s *pool, FAR const char *name,
+                         size_t blocksize, size_t nblocks, bool stack)
+{
+  int ret;
+
+  pool->blocksize   = TCBPOOL_BLOCKSIZE(blocksize);
+  pool->initialsize = MEMPOOL_REALBLOCKSIZE(pool) * nblocks +
+                      sizeof(sq_entry_t);
+#ifdef CONFIG_SCHED_TCBPOOL_STACK
+  pool->alloc       = stack ? stackpool_alloc : tcbpool_alloc;
+  pool->free        = stack ? stackpool_free : tcbpool_free;
+#else
+  pool->alloc       = tcbpool_alloc;
+  pool->free        = tcbpool_free;
+#endif
+
+  /* The pool is not expanded and does not wait:  When it is empty, the
+   * allocation falls back to the heap.
+   */
+
+  ret = mempool_init(pool, name);
+  if (ret < 0)
+    {
+      serr("ERROR: Failed to initialize the %s pool: %d\n", name, ret);
+    }
+}
+
+/****************************************************************************
+ * Name: tcbpool_select
+ *
+ * Description:
+ *   Return the pool of the TCBs of a thread type.
+ *
+ ****************************************************************************/
+
+static FAR struct mempool_s *tcbpool_select(uint8_t ttype)
+{
+#ifndef CONFIG_DISABLE_PTHREAD
+  if (ttype == TCB_FLAG_TTYPE_PTHREAD)
+    {
+      return &g_pthread_tcbpool;
+    }
+#endif
+
+  return &g_task_tcbpool;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_tcbpool_initialize
+ *
+ * Description:
+ *   Preallocate the TCB and stack pools.  Called once during boot after
+ *   the heaps have been initialized.
+ *
+ ****************************************************************************/
+
+void nxsched_tcbpool_initialize(void)
+{
+#ifdef CONFIG_SCHED_TCBPOOL_STACK
+  int i;
+#endif
+
+  tcbpool_init(&g_task_tcbpool, "task_tcb", sizeof(struct task_tcb_s),
+               CONFIG_SCHED_TCBPOOL_NTASKS, false);
+
+#ifndef CONFIG_DISABLE_PTHREAD
+  tcbpool_init(&g_pthread_tcbpool, "pthread_tcb",
+               sizeof(struct pthread_tcb_s),
+               CONFIG_SCHED_TCBPOOL_NPTHREADS, false);
+#endif
+
+#ifdef CONFIG_SCHED_TCBPOOL_STACK
+  for (i = 0; i < STACKPOOL_NCLASSES; i++)
+    {
+      if (g_stackpool_size[i] > 0)
+        {
+          DEBUGASSERT(i == 0 ||
+                      g_stackpool_size[i] > g_stackpool_size[i - 1]);
+
+          tcbpool_init(&g_stackpool[i], g_stackpool_name[i],
+                       STACKPOOL_HDRSIZE + g_stackpool_size[i],
+                       CONFIG_SCHED_TCBPOOL_NSTACKS, true);
+        }
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: nxsched_alloc_tcb
+ *
+ * Description:
+ *   Allocate a zeroed TCB.  A pthread TCB (struct pthread_tcb_s) is taken
+ *   from the pthread pool, any other TCB from the task pool.  A TCB from a
+ *   pool is marked with TCB_FLAG_POOL_TCB:  The caller must add to the
+ *   flags, not overwrite them.
+ *
+ * Input Parameters:
+ *   size - The size of the TCB
+ *
+ * Returned Value:
+ *   The new TCB or NULL if no memory is available.
+ *
+ ****************************************************************************/
+
+FAR void *nxsched_alloc_tcb(size_t size)
+{
+  FAR struct mempool_s *pool;
+  FAR struct tcb_s *tcb;
+
+  /* The flags are not set yet, so the TCB type is identified by its size */
+
+#ifndef CONFIG_DISABLE_PTHREAD
+  if (size == sizeof(struct pthread_tcb_s))
+    {
+      pool = tcbpool_select(TCB_FLAG_TTYPE_PTHREAD);
+    }
+  else
+#endif
+    {
+      DEBUGASSERT(size <= sizeof(struct task_tcb_s));
+      pool = tcbpool_select(TCB_FLAG_TTYPE_TASK);
+    }
+
+  tcb = mempool_allocate(pool);
+  if (tcb == NULL)
+    {
+      return kmm_zalloc(size);
+    }
+
+  memset(tcb, 0, size);
+  tcb->flags = TCB_FLAG_POOL_TCB;
+  return tcb;
+}
+
+/****************************************************************************
+ * Name: nxsched_free_tcb
+ *
+ * Description:
+ *   Free a TCB that was allocated with nxsched_alloc_tcb() or from the
+ *   heap.
+ *
+ ****************************************************************************/
+
+void nxsched_free_tcb(FAR struct tcb_s *tcb)
+{
+  if ((tcb->flags & TCB_FLAG_POOL_TCB) != 0)
+    {
+      mempool_release(tcbpool_select(tcb->flags & TCB_FLAG_TTYPE_MASK),
+                      tcb);
+    }
+  else
+    {
+      kmm_free(tcb);
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_create_stack
+ *
+ * Description:
+ *   Allocate the stack of a thread like up_create_stack(), but take it from
+ *   the smallest stack pool that fits if there is one.  A stack from a pool
+ *   is marked with TCB_FLAG_POOL_STACK.
+ *
+ ****************************************************************************/
+
+int nxsched_create_stack(FAR struct tcb_s *tcb, size_t stack_size,
+                         uint8_t ttype)
+{
+#ifdef CONFIG_SCHED_TCBPOOL_STACK
+  FAR uintptr_t *hdr;
+  int i;
+
+  if (ttype != TCB_FLAG_TTYPE_KERNEL && tcb->stack_alloc_ptr == NULL)
+    {
+      for (i = 0; i < STACKPOOL_NCLASSES; i++)
+        {
+          if (g_stackpool_size[i] > 0 && g_stackpool_size[i] >= stack_size)
+            {
+              break;
+            }
+        }
+
+      if (i < STACKPOOL_NCLASSES)
+        {
+          hdr = mempool_allocate(&g_stackpool[i]);
+          if (hdr != NULL)
+            {
+              *hdr = i;
+              if (up_use_stack(tcb, (FAR char *)hdr + STACKPOOL_HDRSIZE,
+                               g_stackpool_size[i]) == OK)
+                {
+                  tcb->flags |= TCB_FLAG_POOL_STACK;
+                  return OK;
+                }
+
+              mempool_release(&g_stackpool[i], hdr);
+            }
+        }
+    }
+#endif
+
+  return up_create_stack(tcb, stack_size, ttype);
+}
+
+/****************************************************************************
+ * Name: nxsched_release_stack
+ *
+ * Description:
+ *   Release the stack of a thread, returning it to its pool if it came
+ *   from one.
+ *
+ ****************************************************************************/
+
+void nxsched_release_stack(FAR struct tcb_s *tcb, uint8_t ttype)
+{
+#ifdef CONFIG_SCHED_TCBPOOL_STACK
+  FAR uintptr_t *hdr;
+
+  if ((tcb->flags & TCB_FLAG_POOL_STACK) != 0)
+    {
+      hdr = (FAR uintptr_t *)((FAR char *)tcb->stack_alloc_ptr -
+                              STACKPOOL_HDRSIZE);
+      DEBUGASSERT(*hdr < STACKPOOL_NCLASSES);
+
+      /* The architecture does not free a stack passed to up_use_stack() */
+
+      up_release_stack(tcb, ttype);
+      tcb->flags &= ~TCB_FLAG_POOL_STACK;
+
+      mempool_release(&g_stackpool[*hdr], hdr);
+      return;
+    }
+#endif
+
+  up_release_stack(tcb, ttype);
+}
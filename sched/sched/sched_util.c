@@ -0,0 +1,207 @@
+/****************************************************************************
+ * sched/sched/sched_util.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/sched.h>
+#include <nuttx/spinlock.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The utilization of one CPU */
+
+struct sched_util_s
+{
+  clock_t  last;                 /* perf_gettime() of the last update */
+  uint32_t util;                 /* The utilization at 'last' */
+  bool     busy;                 /* A thread other than IDLE runs */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct sched_util_s g_sched_util[CONFIG_SMP_NCPUS];
+static spinlock_t g_sched_util_lock = SP_UNLOCKED;
+
+/* The half-life in perf counts, computed on first use */
+
+static clock_t g_sched_util_halflife;
+
+/* The callback of nxsched_util_register() */
+
+static nxsched_util_t g_sched_util_hook;
+static FAR void *g_sched_util_arg;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_util_update
+ *
+ * Description:
+ *   Decay the utilization of a CPU towards fully busy or idle up to 'now':
+ *   The distance to the target halves for each elapsed half-life, and the
+ *   fraction of a half-life is interpolated linearly.
+ *
+ * Assumptions:
+ *   Called with g_sched_util_lock held.
+ *
+ ****************************************************************************/
+
+static uint32_t nxsched_util_update(FAR struct sched_util_s *util,
+                                    clock_t now)
+{
+  int32_t target = util->busy ? SCHED_UTIL_SCALE : 0;
+  int32_t value = util->util;
+  clock_t elapsed = now - util->last;
+  clock_t halflife = g_sched_util_halflife;
+  clock_t halves;
+
+  if (halflife == 0)
+    {
+      halflife = (clock_t)perf_getfreq() / 1000 *
+                 CONFIG_SCHED_UTIL_HALFLIFE;
+      if (halflife == 0)
+        {
+          halflife = 1;
+        }
+
+      g_sched_util_halflife = halflife;
+    }
+
+  halves = elapsed / halflife;
+  if (halves > 10)
+    {
+      value = target;
+    }
+  else
+    {
+      value  = target + (value - target) / (1 << halves);
+      value += (int64_t)(target - value) * (elapsed % halflife) /
+               (2 * halflife);
+    }
+
+  util->util = value;
+  util->last = now;
+  return value;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_util_resume
+ *
+ * Description:
+ *   Called from nxsched_resume_scheduler() on the CPU that starts running
+ *   the thread.  Account the time since the last context switch of the CPU
+ *   as busy or idle and pass the utilization to the registered callback.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread that is about to run.
+ *
+ ****************************************************************************/
+
+void nxsched_util_resume(FAR struct tcb_s *tcb)
+{
+  FAR struct sched_util_s *util;
+  nxsched_util_t hook;
+  FAR void *arg;
+  irqstate_t flags;
+  uint32_t value;
+  int cpu;
+
+  cpu   = this_cpu();
+  util  = &g_sched_util[cpu];
+  flags = spin_lock_irqsave(&g_sched_util_lock);
+
+  value      = nxsched_util_update(util, perf_gettime());
+  util->busy = !is_idle_task(tcb);
+  hook       = g_sched_util_hook;
+  arg        = g_sched_util_arg;
+
+  spin_unlock_irqrestore(&g_sched_util_lock, flags);
+
+  if (hook != NULL)
+    {
+      hook(cpu, value, arg);
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_get_util
+ *
+ * Description:
+ *   Return the current utilization of a CPU.
+ *
+ ****************************************************************************/
+
+unsigned int nxsched_get_util(int cpu)
+{
+  irqstate_t flags;
+  uint32_t value;
+
+  if (cpu < 0 || cpu >= CONFIG_SMP_NCPUS)
+    {
+      return 0;
+    }
+
+  flags = spin_lock_irqsave(&g_sched_util_lock);
+  value = nxsched_util_update(&g_sched_util[cpu], perf_gettime());
+  spin_unlock_irqrestore(&g_sched_util_lock, flags);
+
+  return value;
+}
+
+/****************************************************************************
+ * Name: nxsched_util_register
+ *
+ * Description:
+ *   Register the callback that receives the utilization of the CPU at each
+ *   context switch.
+ *
+ ****************************************************************************/
+
+void nxsched_util_register(nxsched_util_t hook, FAR void *arg)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_sched_util_lock);
+  g_sched_util_hook = hook;
+  g_sched_util_arg  = arg;
+  spin_unlock_irqrestore(&g_sched_util_lock, flags);
+}
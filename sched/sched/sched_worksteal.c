@@ -0,0 +1,218 @@
+/****************************************************************************
+ * sched/sched/sched_worksteal.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+
+#include "irq/irq.h"
+#include "sched/queue.h"
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PERCPU_READYTORUN
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_queued_task
+ *
+ * Description:
+ *   Return the highest priority task in the assigned task list of 'other'
+ *   that is not running and that may be migrated to 'cpu'.
+ *
+ ****************************************************************************/
+
+static FAR struct tcb_s *nxsched_queued_task(int other, int cpu)
+{
+  FAR struct tcb_s *tcb;
+
+  /* The head of the list is the running task and the tail is always the
+   * IDLE task.  Only the tasks in between are candidates.
+   */
+
+  tcb = (FAR struct tcb_s *)list_assignedtasks(other)->head;
+  for (tcb = tcb->flink; tcb != NULL && !is_idle_task(tcb);
+       tcb = tcb->flink)
+    {
+      if ((tcb->flags & TCB_FLAG_CPU_LOCKED) == 0 &&
+          CPU_ISSET(cpu, &tcb->affinity))
+        {
+          return tcb;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_find_stealable
+ *
+ * Description:
+ *   Select the task that should run next on 'cpu'.  The local candidate,
+ *   normally the next task in g_assignedtasks[cpu], is kept unless the
+ *   g_readytorun list holds a task of greater or equal priority or the
+ *   queue of some other CPU holds a task of strictly greater priority.
+ *   Ties with remote queues are resolved in favor of the local task to
+ *   avoid needless migrations.
+ *
+ *   The selected task is NOT removed from its list.  The caller may use
+ *   nxsched_remove_readytorun() for that.
+ *
+ * Input Parameters:
+ *   cpu    - The CPU that is selecting its next task.
+ *   nxttcb - The local candidate.
+ *
+ * Returned Value:
+ *   Either nxttcb or the TCB of a ready-to-run task that should be
+ *   migrated to 'cpu'.
+ *
+ * Assumptions:
+ *   The caller holds the critical section.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *nxsched_find_stealable(int cpu, FAR struct tcb_s *nxttcb)
+{
+  FAR struct tcb_s *best = nxttcb;
+  FAR struct tcb_s *tcb;
+  int i;
+
+  /* Tasks that have not yet been queued on any CPU */
+
+  for (tcb = (FAR struct tcb_s *)list_readytorun()->head;
+       tcb != NULL && !CPU_ISSET(cpu, &tcb->affinity);
+       tcb = tcb->flink);
+
+  if (tcb != NULL && tcb->sched_priority >= best->sched_priority)
+    {
+      best = tcb;
+    }
+
+  /* Tasks queued behind the running task of some other CPU */
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      if (i == cpu)
+        {
+          continue;
+        }
+
+      tcb = nxsched_queued_task(i, cpu);
+      if (tcb != NULL && tcb->sched_priority > best->sched_priority)
+        {
+          best = tcb;
+        }
+    }
+
+  return best;
+}
+
+/****************************************************************************
+ * Name: nxsched_idle_balance
+ *
+ * Description:
+ *   Called from the IDLE loop of each CPU.  If some other CPU has queued
+ *   ready-to-run tasks that may run on this CPU, the highest priority one
+ *   is taken and started here.
+ *
+ *   A CPU with nothing to steal does not enter the critical section.  The
+ *   unlocked check only reads the list heads and the links of the IDLE
+ *   TCBs, which are never freed, so a stale value only causes a spurious
+ *   (or a missed) balancing attempt.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_IDLE_BALANCE
+void nxsched_idle_balance(void)
+{
+  FAR struct tcb_s *rtcb;
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  bool found;
+  int me;
+  int i;
+
+  me    = this_cpu();
+  found = list_readytorun()->head != NULL;
+
+  for (i = 0; i < CONFIG_SMP_NCPUS && !found; i++)
+    {
+      FAR dq_queue_t *tasklist = list_assignedtasks(i);
+      FAR struct tcb_s *idle = (FAR struct tcb_s *)tasklist->tail;
+
+      if (i != me && tasklist->head != (FAR dq_entry_t *)idle &&
+          tasklist->head != (FAR dq_entry_t *)idle->blink)
+        {
+          found = true;
+        }
+    }
+
+  if (!found)
+    {
+      return;
+    }
+
+  flags = enter_critical_section();
+
+  rtcb = this_task();
+  if (is_idle_task(rtcb) && !nxsched_islocked_tcb(rtcb))
+    {
+      tcb = nxsched_find_stealable(me, rtcb);
+      if (tcb != rtcb)
+        {
+          /* Move the task to whichever CPU nxsched_add_readytorun() thinks
+           * is best.  That is normally this one since it is idle.
+           */
+
+          nxsched_remove_readytorun(tcb);
+          if (nxsched_add_readytorun(tcb))
+            {
+              up_switch_context(this_task(), rtcb);
+            }
+        }
+    }
+
+  leave_critical_section(flags);
+}
+#endif /* CONFIG_SCHED_IDLE_BALANCE */
+
+#endif /* CONFIG_SCHED_PERCPU_READYTORUN */
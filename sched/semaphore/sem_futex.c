@@ -0,0 +1,330 @@
+/****************************************************************************
+ * sched/semaphore/sem_futex.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/queue.h>
+#include <nuttx/sched.h>
+#include <nuttx/futex.h>
+
+#include "sched/sched.h"
+#include "semaphore/semaphore.h"
+
+#ifdef CONFIG_FUTEX
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Waiters are kept in a small hash table indexed by the futex address */
+
+#define FUTEX_HASH_SIZE       16
+#define FUTEX_HASH(addr)      ((((uintptr_t)(addr)) >> 2) & \
+                               (FUTEX_HASH_SIZE - 1))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One thread waiting in nxfutex_wait().  The structure lives on the stack
+ * of the waiting thread.
+ */
+
+struct futex_waiter_s
+{
+  dq_entry_t node;                  /* Link in the hash bucket */
+  FAR struct tcb_s *tcb;            /* The waiting thread */
+  FAR volatile uint32_t *addr;      /* The futex word, NULL once woken up */
+#ifdef CONFIG_ARCH_ADDRENV
+  FAR struct task_group_s *group;   /* The address environment of addr */
+#endif
+  sem_t sem;                        /* The waiting thread blocks here */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static dq_queue_t g_futex_hash[FUTEX_HASH_SIZE];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxfutex_match
+ *
+ * Description:
+ *   Return true if the waiter waits on the futex word 'addr' of the
+ *   calling thread.
+ *
+ ****************************************************************************/
+
+static inline bool nxfutex_match(FAR struct futex_waiter_s *waiter,
+                                 FAR volatile uint32_t *addr)
+{
+#ifdef CONFIG_ARCH_ADDRENV
+  if (waiter->group != this_task()->group)
+    {
+      return false;
+    }
+#endif
+
+  return waiter->addr == addr;
+}
+
+/****************************************************************************
+ * Name: nxfutex_enqueue
+ *
+ * Description:
+ *   Add a waiter to its hash bucket behind all waiters of the same or
+ *   higher priority.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+static void nxfutex_enqueue(FAR dq_queue_t *bucket,
+                            FAR struct futex_waiter_s *waiter)
+{
+  FAR struct futex_waiter_s *curr;
+  FAR dq_entry_t *node;
+
+  for (node = dq_peek(bucket); node != NULL; node = dq_next(node))
+    {
+      curr = container_of(node, struct futex_waiter_s, node);
+      if (curr->tcb->sched_priority < waiter->tcb->sched_priority)
+        {
+          dq_addbefore(node, &waiter->node, bucket);
+          return;
+        }
+    }
+
+  dq_addlast(&waiter->node, bucket);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxfutex_wait
+ *
+ * Description:
+ *   Block the calling thread until the 32-bit word at 'addr' is signalled
+ *   by nxfutex_wake().  The thread is only blocked if the word still holds
+ *   the value 'val'.
+ *
+ * Input Parameters:
+ *   addr    - The address of the futex word.  Must be 32-bit aligned.
+ *   val     - The value that the futex word is expected to hold.
+ *   clockid - The clock to be used as the time base of abstime
+ *   abstime - The absolute time to wait until, or NULL to wait forever.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned when the thread was woken up.  A negated errno
+ *   value is returned on failure.  See include/nuttx/futex.h.
+ *
+ ****************************************************************************/
+
+int nxfutex_wait(FAR volatile uint32_t *addr, uint32_t val,
+                 clockid_t clockid, FAR const struct timespec *abstime)
+{
+  FAR dq_queue_t *bucket = &g_futex_hash[FUTEX_HASH(addr)];
+  struct futex_waiter_s waiter;
+  irqstate_t flags;
+  int ret;
+
+  if (addr == NULL || ((uintptr_t)addr & 3) != 0)
+    {
+      return -EINVAL;
+    }
+
+  /* The semaphore is only used for signaling */
+
+  nxsem_init(&waiter.sem, 0, 0);
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  nxsem_set_protocol(&waiter.sem, SEM_PRIO_NONE);
+#endif
+
+  waiter.tcb   = this_task();
+  waiter.addr  = addr;
+#ifdef CONFIG_ARCH_ADDRENV
+  waiter.group = waiter.tcb->group;
+#endif
+
+  /* Check the futex word and queue the waiter atomically with respect to
+   * nxfutex_wake().
+   */
+
+  flags = enter_critical_section();
+
+  if (*addr != val)
+    {
+      ret = -EAGAIN;
+    }
+  else
+    {
+      nxfutex_enqueue(bucket, &waiter);
+
+      if (abstime != NULL)
+        {
+          ret = nxsem_clockwait(&waiter.sem, clockid, abstime);
+        }
+      else
+        {
+          ret = nxsem_wait(&waiter.sem);
+        }
+
+      if (waiter.addr == NULL)
+        {
+          /* We were woken up, possibly at the same time as the timeout
+           * or a signal.  Report the wake up, the waker has counted it.
+           */
+
+          ret = OK;
+        }
+      else
+        {
+          dq_rem(&waiter.node, bucket);
+        }
+    }
+
+  leave_critical_section(flags);
+
+  nxsem_destroy(&waiter.sem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nxfutex_wake
+ *
+ * Description:
+ *   Wake up at most 'nwake' of the threads that are waiting in
+ *   nxfutex_wait() on the futex word at 'addr'.
+ *
+ * Input Parameters:
+ *   addr  - The address of the futex word.
+ *   nwake - The maximum number of threads to wake up.
+ *
+ * Returned Value:
+ *   The number of threads that were woken up or a negated errno value on
+ *   failure.
+ *
+ ****************************************************************************/
+
+int nxfutex_wake(FAR volatile uint32_t *addr, int nwake)
+{
+  FAR dq_queue_t *bucket = &g_futex_hash[FUTEX_HASH(addr)];
+  FAR struct futex_waiter_s *waiter;
+  FAR dq_entry_t *node;
+  FAR dq_entry_t *next;
+  irqstate_t flags;
+  int nwoken = 0;
+
+  if (addr == NULL || ((uintptr_t)addr & 3) != 0 || nwake < 0)
+    {
+      return -EINVAL;
+    }
+
+  /* Do not switch to a woken up thread before the bucket has been
+   * traversed.
+   */
+
+  flags = enter_critical_section();
+  sched_lock();
+
+  for (node = dq_peek(bucket); node != NULL && nwoken < nwake; node = next)
+    {
+      next   = dq_next(node);
+      waiter = container_of(node, struct futex_waiter_s, node);
+
+      if (nxfutex_match(waiter, addr))
+        {
+          dq_rem(node, bucket);
+          waiter->addr = NULL;
+          nxsem_post(&waiter->sem);
+          nwoken++;
+        }
+    }
+
+  sched_unlock();
+  leave_critical_section(flags);
+
+  return nwoken;
+}
+
+/****************************************************************************
+ * Name: nxfutex_recover
+ *
+ * Description:
+ *   This function is called from nxtask_recover() when a task is deleted
+ *   via task_delete() or via pthread_cancel().  It removes the task from
+ *   the futex wait queues if it is deleted while waiting.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the terminated task or thread
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void nxfutex_recover(FAR struct tcb_s *tcb)
+{
+  FAR struct futex_waiter_s *waiter;
+  FAR dq_entry_t *node;
+  irqstate_t flags;
+  int i;
+
+  flags = enter_critical_section();
+
+  for (i = 0; i < FUTEX_HASH_SIZE; i++)
+    {
+      for (node = dq_peek(&g_futex_hash[i]); node != NULL;
+           node = dq_next(node))
+        {
+          waiter = container_of(node, struct futex_waiter_s, node);
+          if (waiter->tcb == tcb)
+            {
+              dq_rem(node, &g_futex_hash[i]);
+              leave_critical_section(flags);
+              return;
+            }
+        }
+    }
+
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_FUTEX */
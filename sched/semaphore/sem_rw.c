@@ -27,6 +27,7 @@
 #include <nuttx/rwsem.h>
 #include <nuttx/sched.h>
 #include <assert.h>
+#include <string.h>
 
 /****************************************************************************
  * Private Functions
@@ -45,6 +46,112 @@ static inline void up_wait(FAR rw_semaphore_t *rwsem)
     }
 }
 
+#ifdef CONFIG_RWSEM_PERCPU
+/****************************************************************************
+ * Name: rwsem_readers
+ *
+ * Description:
+ *   Return the number of readers.  A reader may leave on another CPU than
+ *   the one it entered on, so only the sum is meaningful.
+ *
+ ****************************************************************************/
+
+static int rwsem_readers(FAR rw_semaphore_t *rwsem)
+{
+  int readers = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      readers += atomic_load(&rwsem->percpu[cpu].count);
+    }
+
+  return readers;
+}
+
+/****************************************************************************
+ * Name: rwsem_read_blocked
+ *
+ * Description:
+ *   Return true if a new reader has to wait.  A waiting writer blocks new
+ *   readers, but not the threads that already hold a read lock, since the
+ *   writer may be waiting for them.
+ *
+ ****************************************************************************/
+
+static bool rwsem_read_blocked(FAR rw_semaphore_t *rwsem)
+{
+  return rwsem->writer > 0 ||
+         (atomic_load(&rwsem->writing) > 0 && nxsched_self()->rdlocks == 0);
+}
+
+/****************************************************************************
+ * Name: rwsem_read_acquire and rwsem_read_release
+ *
+ * Description:
+ *   Count a reader in or out.  The atomic operations are sequentially
+ *   consistent:  Either the reader sees the 'writing' count of a new
+ *   writer, or the writer sees the reader.
+ *
+ ****************************************************************************/
+
+static bool rwsem_read_acquire(FAR rw_semaphore_t *rwsem)
+{
+  atomic_fetch_add(&rwsem->percpu[this_cpu()].count, 1);
+  if (atomic_load(&rwsem->writing) > 0)
+    {
+      return false;
+    }
+
+  nxsched_self()->rdlocks++;
+  return true;
+}
+
+static void rwsem_read_release(FAR rw_semaphore_t *rwsem)
+{
+  atomic_fetch_sub(&rwsem->percpu[this_cpu()].count, 1);
+  if (atomic_load(&rwsem->writing) > 0)
+    {
+      /* A writer may be waiting for this reader */
+
+      nxmutex_lock(&rwsem->protected);
+      up_wait(rwsem);
+      nxmutex_unlock(&rwsem->protected);
+    }
+}
+
+/****************************************************************************
+ * Name: rwsem_read_fast
+ *
+ * Description:
+ *   Take a read lock without the mutex if no writer is waiting or holding
+ *   the lock.
+ *
+ * Returned Value:
+ *   True if the read lock was taken.
+ *
+ ****************************************************************************/
+
+static bool rwsem_read_fast(FAR rw_semaphore_t *rwsem)
+{
+  if (rwsem->holder == _SCHED_GETTID())
+    {
+      return false;
+    }
+
+  if (rwsem_read_acquire(rwsem))
+    {
+      return true;
+    }
+
+  rwsem_read_release(rwsem);
+  return false;
+}
+#else
+#  define rwsem_readers(rwsem)       ((rwsem)->reader)
+#  define rwsem_read_blocked(rwsem)  ((rwsem)->writer > 0)
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -65,6 +172,13 @@ static inline void up_wait(FAR rw_semaphore_t *rwsem)
 
 int down_read_trylock(FAR rw_semaphore_t *rwsem)
 {
+#ifdef CONFIG_RWSEM_PERCPU
+  if (rwsem_read_fast(rwsem))
+    {
+      return 1;
+    }
+#endif
+
   nxmutex_lock(&rwsem->protected);
 
   /* if the write lock is already held by oneself and since the write lock
@@ -78,7 +192,7 @@ int down_read_trylock(FAR rw_semaphore_t *rwsem)
       goto out;
     }
 
-  if (rwsem->writer > 0)
+  if (rwsem_read_blocked(rwsem))
     {
       nxmutex_unlock(&rwsem->protected);
       return 0;
@@ -88,7 +202,12 @@ int down_read_trylock(FAR rw_semaphore_t *rwsem)
    * read base +1.
    */
 
+#ifdef CONFIG_RWSEM_PERCPU
+  atomic_fetch_add(&rwsem->percpu[this_cpu()].count, 1);
+  nxsched_self()->rdlocks++;
+#else
   rwsem->reader++;
+#endif
 
 out:
   nxmutex_unlock(&rwsem->protected);
@@ -109,6 +228,13 @@ out:
 
 void down_read(FAR rw_semaphore_t *rwsem)
 {
+#ifdef CONFIG_RWSEM_PERCPU
+  if (rwsem_read_fast(rwsem))
+    {
+      return;
+    }
+#endif
+
   /* we have to check if there is a write-lock scenario, if there is then we
    * block and wait for the write-lock to be unlocked.
    */
@@ -126,7 +252,7 @@ void down_read(FAR rw_semaphore_t *rwsem)
       goto out;
     }
 
-  while (rwsem->writer > 0)
+  while (rwsem_read_blocked(rwsem))
     {
       rwsem->waiter++;
       nxmutex_unlock(&rwsem->protected);
@@ -139,7 +265,12 @@ void down_read(FAR rw_semaphore_t *rwsem)
    * read base +1.
    */
 
+#ifdef CONFIG_RWSEM_PERCPU
+  atomic_fetch_add(&rwsem->percpu[this_cpu()].count, 1);
+  nxsched_self()->rdlocks++;
+#else
   rwsem->reader++;
+#endif
 
 out:
   nxmutex_unlock(&rwsem->protected);
@@ -158,6 +289,16 @@ out:
 
 void up_read(FAR rw_semaphore_t *rwsem)
 {
+#ifdef CONFIG_RWSEM_PERCPU
+  if (rwsem->holder != _SCHED_GETTID())
+    {
+      DEBUGASSERT(nxsched_self()->rdlocks > 0);
+      nxsched_self()->rdlocks--;
+      rwsem_read_release(rwsem);
+      return;
+    }
+#endif
+
   nxmutex_lock(&rwsem->protected);
 
   /* when releasing a read lock and holder is oneself, the read lock is a
@@ -208,8 +349,28 @@ int down_write_trylock(FAR rw_semaphore_t *rwsem)
 
   nxmutex_lock(&rwsem->protected);
 
-  if (rwsem->reader > 0 || (rwsem->writer > 0 && tid != rwsem->holder))
+#ifdef CONFIG_RWSEM_PERCPU
+  /* Announce the writer before the readers are counted */
+
+  if (tid != rwsem->holder)
+    {
+      atomic_fetch_add(&rwsem->writing, 1);
+    }
+#endif
+
+  if (rwsem_readers(rwsem) > 0 ||
+      (rwsem->writer > 0 && tid != rwsem->holder))
     {
+#ifdef CONFIG_RWSEM_PERCPU
+      if (tid != rwsem->holder)
+        {
+          /* Let the readers that saw this writer go again */
+
+          atomic_fetch_sub(&rwsem->writing, 1);
+          up_wait(rwsem);
+        }
+#endif
+
       nxmutex_unlock(&rwsem->protected);
       return 0;
     }
@@ -241,7 +402,17 @@ void down_write(FAR rw_semaphore_t *rwsem)
 
   nxmutex_lock(&rwsem->protected);
 
-  while (rwsem->reader > 0 || (rwsem->writer > 0 && rwsem->holder != tid))
+#ifdef CONFIG_RWSEM_PERCPU
+  /* Announce the writer, so that new readers wait from now on */
+
+  if (rwsem->holder != tid)
+    {
+      atomic_fetch_add(&rwsem->writing, 1);
+    }
+#endif
+
+  while (rwsem_readers(rwsem) > 0 ||
+         (rwsem->writer > 0 && rwsem->holder != tid))
     {
       rwsem->waiter++;
       nxmutex_unlock(&rwsem->protected);
@@ -279,6 +450,9 @@ void up_write(FAR rw_semaphore_t *rwsem)
   if (--rwsem->writer <= 0)
     {
       rwsem->holder = RWSEM_NO_HOLDER;
+#ifdef CONFIG_RWSEM_PERCPU
+      atomic_fetch_sub(&rwsem->writing, 1);
+#endif
     }
 
   up_wait(rwsem);
@@ -325,6 +499,11 @@ int init_rwsem(FAR rw_semaphore_t *rwsem)
   rwsem->waiter = 0;
   rwsem->holder = RWSEM_NO_HOLDER;
 
+#ifdef CONFIG_RWSEM_PERCPU
+  memset(rwsem->percpu, 0, sizeof(rwsem->percpu));
+  atomic_init(&rwsem->writing, 0);
+#endif
+
   return OK;
 }
 
@@ -344,7 +523,7 @@ void destroy_rwsem(FAR rw_semaphore_t *rwsem)
 {
   /* Need to check if there is still an unlocked or waiting state */
 
-  DEBUGASSERT(rwsem->waiter == 0 && rwsem->reader == 0 &&
+  DEBUGASSERT(rwsem->waiter == 0 && rwsem_readers(rwsem) == 0 &&
               rwsem->writer == 0 && rwsem->holder == RWSEM_NO_HOLDER);
 
   nxmutex_destroy(&rwsem->protected);
@@ -74,6 +74,12 @@ void nxsem_timeout(wdparm_t arg);
 
 void nxsem_recover(FAR struct tcb_s *tcb);
 
+/* Remove a destroyed task or thread from the futex wait queues */
+
+#ifdef CONFIG_FUTEX
+void nxfutex_recover(FAR struct tcb_s *tcb);
+#endif
+
 /* Special logic needed only by priority inheritance to manage collections of
  * holders of semaphores.
  */
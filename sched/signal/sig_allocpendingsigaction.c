@@ -42,15 +42,31 @@
  * Name: nxsig_alloc_pendingsigaction
  *
  * Description:
- *   Allocate a new element for the pending signal action queue
+ *   Allocate a new element for the pending signal action queue of a
+ *   thread of 'group'
  *
  ****************************************************************************/
 
-FAR sigq_t *nxsig_alloc_pendingsigaction(void)
+FAR sigq_t *nxsig_alloc_pendingsigaction(FAR struct task_group_s *group)
 {
   FAR sigq_t    *sigq;
   irqstate_t flags;
 
+#if CONFIG_SIG_PREALLOC_GROUP > 0
+  /* Try the pool of the group first.  It is not shared with other groups,
+   * so it cannot be exhausted by them.
+   */
+
+  flags = enter_critical_section();
+  sigq = (FAR sigq_t *)sq_remfirst(&group->tg_sigfreeaction);
+  leave_critical_section(flags);
+
+  if (sigq)
+    {
+      return sigq;
+    }
+#endif
+
   /* Check if we were called from an interrupt handler. */
 
   if (up_interrupt_context())
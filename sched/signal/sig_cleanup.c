@@ -51,14 +51,14 @@ void nxsig_cleanup(FAR struct tcb_s *stcb)
 
   while ((sigq = (FAR sigq_t *)sq_remfirst(&stcb->sigpendactionq)) != NULL)
     {
-      nxsig_release_pendingsigaction(sigq);
+      nxsig_release_pendingsigaction(stcb->group, sigq);
     }
 
   /* Deallocate all entries in the list of posted signal actions */
 
   while ((sigq = (FAR sigq_t *)sq_remfirst(&stcb->sigpostedq)) != NULL)
     {
-      nxsig_release_pendingsigaction(sigq);
+      nxsig_release_pendingsigaction(stcb->group, sigq);
     }
 
   /* Misc. signal-related clean-up */
@@ -96,6 +96,15 @@ void nxsig_release(FAR struct task_group_s *group)
   while ((sigpend = (FAR sigpendq_t *)sq_remfirst(&group->tg_sigpendingq))
          != NULL)
     {
-      nxsig_release_pendingsignal(sigpend);
+      nxsig_release_pendingsignal(group, sigpend);
     }
+
+#if CONFIG_SIG_PREALLOC_GROUP > 0
+  /* Free the pool of the group.  All of its structures are unused now. */
+
+  kmm_free(group->tg_sigpool);
+  group->tg_sigpool = NULL;
+  sq_init(&group->tg_sigfreeaction);
+  sq_init(&group->tg_sigfreepending);
+#endif
 }
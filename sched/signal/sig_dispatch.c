@@ -132,7 +132,7 @@ static int nxsig_queue_action(FAR struct tcb_s *stcb, siginfo_t *info)
        * unable to allocate memory for the signal data.
        */
 
-      sigq = nxsig_alloc_pendingsigaction();
+      sigq = nxsig_alloc_pendingsigaction(stcb->group);
       if (!sigq)
         {
           ret = -ENOMEM;
@@ -208,15 +208,29 @@ static int nxsig_queue_action(FAR struct tcb_s *stcb, siginfo_t *info)
  * Name: nxsig_alloc_pendingsignal
  *
  * Description:
- *   Allocate a pending signal list entry
+ *   Allocate a pending signal list entry for 'group'
  *
  ****************************************************************************/
 
-static FAR sigpendq_t *nxsig_alloc_pendingsignal(void)
+static FAR sigpendq_t *
+nxsig_alloc_pendingsignal(FAR struct task_group_s *group)
 {
   FAR sigpendq_t *sigpend;
   irqstate_t      flags;
 
+#if CONFIG_SIG_PREALLOC_GROUP > 0
+  /* Try the pool of the group first */
+
+  flags = enter_critical_section();
+  sigpend = (FAR sigpendq_t *)sq_remfirst(&group->tg_sigfreepending);
+  leave_critical_section(flags);
+
+  if (sigpend)
+    {
+      return sigpend;
+    }
+#endif
+
   /* Check if we were called from an interrupt handler. */
 
   if (up_interrupt_context())
@@ -359,7 +373,7 @@ static void nxsig_add_pendingsignal(FAR struct tcb_s *stcb,
     {
       /* Allocate a new pending signal entry */
 
-      sigpend = nxsig_alloc_pendingsignal();
+      sigpend = nxsig_alloc_pendingsignal(group);
       if (sigpend != NULL)
         {
           /* Put the signal information into the allocated structure */
@@ -492,6 +506,13 @@ int nxsig_tcbdispatch(FAR struct tcb_s *stcb, siginfo_t *info)
               wd_cancel(&stcb->waitdog);
             }
 
+#ifdef CONFIG_HRTIMER_CLOCKWAIT
+          if (HRTIMER_ISACTIVE(&stcb->waithrtimer))
+            {
+              hrtimer_cancel(&stcb->waithrtimer);
+            }
+#endif
+
           /* Remove the task from waitting list */
 
           dq_rem((FAR dq_entry_t *)stcb, list_waitingforsignal());
@@ -559,6 +580,13 @@ int nxsig_tcbdispatch(FAR struct tcb_s *stcb, siginfo_t *info)
               wd_cancel(&stcb->waitdog);
             }
 
+#ifdef CONFIG_HRTIMER_CLOCKWAIT
+          if (HRTIMER_ISACTIVE(&stcb->waithrtimer))
+            {
+              hrtimer_cancel(&stcb->waithrtimer);
+            }
+#endif
+
           /* Remove the task from waitting list */
 
           dq_rem((FAR dq_entry_t *)stcb, list_waitingforsignal());
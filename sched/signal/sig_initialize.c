@@ -28,6 +28,7 @@
 
 #include <stdint.h>
 #include <assert.h>
+#include <errno.h>
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/queue.h>
@@ -181,3 +182,39 @@ void nxsig_initialize(void)
                                           SIG_ALLOC_IRQ);
   sched_trace_end();
 }
+
+/****************************************************************************
+ * Name: nxsig_group_initialize
+ *
+ * Description:
+ *   Allocate the pool of pending signal structures of a new task group.
+ *   The pool is freed by nxsig_release().
+ *
+ * Returned Value:
+ *   0 (OK) on success; -ENOMEM if the pool could not be allocated.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SIG_PREALLOC_GROUP > 0
+int nxsig_group_initialize(FAR struct task_group_s *group)
+{
+  FAR void *sigpool;
+
+  sigpool = kmm_malloc(CONFIG_SIG_PREALLOC_GROUP *
+                       (sizeof(sigq_t) + sizeof(sigpendq_t)));
+  if (sigpool == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  group->tg_sigpool = sigpool;
+  sq_init(&group->tg_sigfreeaction);
+  sq_init(&group->tg_sigfreepending);
+
+  sigpool = nxsig_init_block(&group->tg_sigfreeaction, sigpool,
+                             CONFIG_SIG_PREALLOC_GROUP, SIG_ALLOC_GROUP);
+  nxsig_init_pendingsignalblock(&group->tg_sigfreepending, sigpool,
+                                CONFIG_SIG_PREALLOC_GROUP, SIG_ALLOC_GROUP);
+  return OK;
+}
+#endif
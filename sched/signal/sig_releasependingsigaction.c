@@ -27,6 +27,7 @@
 #include <nuttx/config.h>
 
 #include <sched.h>
+#include <assert.h>
 
 #include <nuttx/irq.h>
 
@@ -40,11 +41,13 @@
  * Name: nxsig_release_pendingsigaction
  *
  * Description:
- *   Deallocate a pending signal action Q entry
+ *   Deallocate a pending signal action Q entry.  'group' is the task group
+ *   of the thread that the entry was queued to.
  *
  ****************************************************************************/
 
-void nxsig_release_pendingsigaction(FAR sigq_t *sigq)
+void nxsig_release_pendingsigaction(FAR struct task_group_s *group,
+                                    FAR sigq_t *sigq)
 {
   irqstate_t flags;
 
@@ -78,6 +81,21 @@ void nxsig_release_pendingsigaction(FAR sigq_t *sigq)
       leave_critical_section(flags);
     }
 
+#if CONFIG_SIG_PREALLOC_GROUP > 0
+  /* If this is a structure of the pool of the task group,
+   * then put it back in the free list of the group.
+   */
+
+  else if (sigq->type == SIG_ALLOC_GROUP)
+    {
+      DEBUGASSERT(group != NULL);
+
+      flags = enter_critical_section();
+      sq_addlast((FAR sq_entry_t *)sigq, &group->tg_sigfreeaction);
+      leave_critical_section(flags);
+    }
+#endif
+
   /* Otherwise, deallocate it.  Note:  interrupt handlers
    * will never deallocate signals because they will not
    * receive them.
@@ -48,11 +48,13 @@
  * Name: nxsig_release_pendingsignal
  *
  * Description:
- *   Deallocate a pending signal list entry
+ *   Deallocate a pending signal list entry.  'group' is the task group
+ *   that the entry was pending for.
  *
  ****************************************************************************/
 
-void nxsig_release_pendingsignal(FAR sigpendq_t *sigpend)
+void nxsig_release_pendingsignal(FAR struct task_group_s *group,
+                                 FAR sigpendq_t *sigpend)
 {
   irqstate_t flags;
 
@@ -86,6 +88,21 @@ void nxsig_release_pendingsignal(FAR sigpendq_t *sigpend)
       leave_critical_section(flags);
     }
 
+#if CONFIG_SIG_PREALLOC_GROUP > 0
+  /* If this is a structure of the pool of the task group,
+   * then put it back in the free list of the group.
+   */
+
+  else if (sigpend->type == SIG_ALLOC_GROUP)
+    {
+      DEBUGASSERT(group != NULL);
+
+      flags = enter_critical_section();
+      sq_addlast((FAR sq_entry_t *)sigpend, &group->tg_sigfreepending);
+      leave_critical_section(flags);
+    }
+#endif
+
   /* Otherwise, deallocate it.  Note:  interrupt handlers
    * will never deallocate signals because they will not
    * receive them.
@@ -38,6 +38,7 @@
 
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
+#include <nuttx/hrtimer.h>
 #include <nuttx/wdog.h>
 #include <nuttx/signal.h>
 #include <nuttx/cancelpt.h>
@@ -132,6 +133,27 @@ static void nxsig_timeout(wdparm_t arg)
 #endif
 }
 
+/****************************************************************************
+ * Name: nxsig_hrtimeout
+ *
+ * Description:
+ *   The hrtimer flavor of nxsig_timeout().
+ *
+ * Assumptions:
+ *   This function executes in the context of the oneshot timer interrupt
+ *   handler.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER_CLOCKWAIT
+static uint64_t nxsig_hrtimeout(FAR struct hrtimer_s *hrtimer,
+                                uint64_t expired)
+{
+  nxsig_timeout((wdparm_t)(uintptr_t)hrtimer->arg);
+  return 0;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -254,8 +276,14 @@ int nxsig_clockwait(int clockid, int flags,
 {
   FAR struct tcb_s *rtcb = this_task();
   irqstate_t iflags;
+#ifdef CONFIG_HRTIMER_CLOCKWAIT
+  struct timespec reltime;
+  uint64_t expect = 0;
+  uint64_t stop;
+#else
   clock_t expect = 0;
   clock_t stop;
+#endif
 
   if (rqtp && (rqtp->tv_nsec < 0 || rqtp->tv_nsec >= 1000000000))
     {
@@ -300,6 +328,29 @@ int nxsig_clockwait(int clockid, int flags,
 
   if (rqtp)
     {
+#ifdef CONFIG_HRTIMER_CLOCKWAIT
+      /* Start the hrtimer, an absolute time is converted to a delay
+       * from now.
+       */
+
+      if ((flags & TIMER_ABSTIME) == 0)
+        {
+          reltime = *rqtp;
+        }
+      else
+        {
+          nxclock_gettime(clockid, &reltime);
+          clock_timespec_subtract(rqtp, &reltime, &reltime);
+        }
+
+      hrtimer_start(&rtcb->waithrtimer, nxsig_hrtimeout, rtcb,
+                    clock_time2nsec(&reltime), HRTIMER_MODE_REL);
+
+      if ((flags & TIMER_ABSTIME) == 0)
+        {
+          expect = rtcb->waithrtimer.expired;
+        }
+#else
       /* Start the watchdog timer */
 
       if ((flags & TIMER_ABSTIME) == 0)
@@ -318,6 +369,7 @@ int nxsig_clockwait(int clockid, int flags,
           wd_start_abstime(&rtcb->waitdog, rqtp,
                            nxsig_timeout, (uintptr_t)rtcb);
         }
+#endif
     }
 
   /* Remove the tcb task from the ready-to-run list. */
@@ -337,15 +389,24 @@ int nxsig_clockwait(int clockid, int flags,
 
   if (rqtp)
     {
+#ifdef CONFIG_HRTIMER_CLOCKWAIT
+      hrtimer_cancel(&rtcb->waithrtimer);
+      stop = hrtimer_now();
+#else
       wd_cancel(&rtcb->waitdog);
       stop = clock_systime_ticks();
+#endif
     }
 
   leave_critical_section(iflags);
 
   if (rqtp && rmtp && expect)
     {
+#ifdef CONFIG_HRTIMER_CLOCKWAIT
+      clock_nsec2time(rmtp, expect > stop ? expect - stop : 0);
+#else
       clock_ticks2time(rmtp, expect > stop ? expect - stop : 0);
+#endif
     }
 
   return 0;
@@ -441,7 +502,7 @@ int nxsig_timedwait(FAR const sigset_t *set, FAR struct siginfo *info,
 
       /* Then dispose of the pending signal structure properly */
 
-      nxsig_release_pendingsignal(sigpend);
+      nxsig_release_pendingsignal(rtcb->group, sigpend);
     }
 
   /* We will have to wait for a signal to be posted to this task. */
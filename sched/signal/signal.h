@@ -58,7 +58,8 @@ enum sigalloc_e
 {
   SIG_ALLOC_FIXED = 0,  /* pre-allocated; never freed */
   SIG_ALLOC_DYN,        /* dynamically allocated; free when unused */
-  SIG_ALLOC_IRQ         /* Preallocated, reserved for interrupt handling */
+  SIG_ALLOC_IRQ,        /* Preallocated, reserved for interrupt handling */
+  SIG_ALLOC_GROUP       /* Preallocated in the pool of a task group */
 };
 
 /* The following defines the sigaction queue entry */
@@ -150,6 +151,9 @@ struct task_group_s;
 /* sig_initializee.c */
 
 void               nxsig_initialize(void);
+#if CONFIG_SIG_PREALLOC_GROUP > 0
+int                nxsig_group_initialize(FAR struct task_group_s *group);
+#endif
 
 /* sig_action.c */
 
@@ -185,13 +189,18 @@ void nxsig_wait_irq(FAR struct tcb_s *wtcb, int errcode);
 
 /* In files of the same name */
 
-FAR sigq_t        *nxsig_alloc_pendingsigaction(void);
+FAR sigq_t        *nxsig_alloc_pendingsigaction(
+                                     FAR struct task_group_s *group);
 void               nxsig_deliver(FAR struct tcb_s *stcb);
 FAR sigactq_t     *nxsig_find_action(FAR struct task_group_s *group,
                                      int signo);
 int                nxsig_lowest(FAR sigset_t *set);
-void               nxsig_release_pendingsigaction(FAR sigq_t *sigq);
-void               nxsig_release_pendingsignal(FAR sigpendq_t *sigpend);
+void               nxsig_release_pendingsigaction(
+                                     FAR struct task_group_s *group,
+                                     FAR sigq_t *sigq);
+void               nxsig_release_pendingsignal(
+                                     FAR struct task_group_s *group,
+                                     FAR sigpendq_t *sigpend);
 FAR sigpendq_t    *nxsig_remove_pendingsignal(FAR struct tcb_s *stcb,
                                               int signo);
 bool               nxsig_unmask_pendingsignal(void);
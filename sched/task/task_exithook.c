@@ -37,6 +37,10 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/mm/mm.h>
 
+#ifdef CONFIG_SCHED_PERF_EVENTS
+#  include <nuttx/perf.h>
+#endif
+
 #include "sched/sched.h"
 #include "group/group.h"
 #include "signal/signal.h"
@@ -444,6 +448,12 @@ void nxtask_exithook(FAR struct tcb_s *tcb, int status)
 
   sched_unlock();
 
+#ifdef CONFIG_FS_POLL_CACHE
+  /* Tear down the cached polls while the files of the group still exist */
+
+  poll_cache_release(tcb);
+#endif
+
   /* Leave the task group.  Perhaps discarding any un-reaped child
    * status (no zombies here!)
    */
@@ -454,6 +464,10 @@ void nxtask_exithook(FAR struct tcb_s *tcb, int status)
 
   nxsig_cleanup(tcb); /* Deallocate Signal lists */
 
+#ifdef CONFIG_SCHED_PERF_EVENTS
+  perf_event_task_exit(tcb); /* Release the events of the task */
+#endif
+
 #ifdef CONFIG_SCHED_DUMP_LEAK
   if ((tcb->flags & TCB_FLAG_TTYPE_MASK) == TCB_FLAG_TTYPE_KERNEL)
     {
@@ -80,6 +80,12 @@ void nxtask_recover(FAR struct tcb_s *tcb)
 
   nxsem_recover(tcb);
 
+#ifdef CONFIG_FUTEX
+  /* Handle cases where the thread was waiting on a futex */
+
+  nxfutex_recover(tcb);
+#endif
+
 #if !defined(CONFIG_DISABLE_MQUEUE) || !defined(CONFIG_DISABLE_MQUEUE_SYSV)
   /* Handle cases where the thread was waiting for a message queue event */
 
@@ -94,4 +100,13 @@ void nxtask_recover(FAR struct tcb_s *tcb)
       DEBUGVERIFY(nxsched_stop_sporadic(tcb));
     }
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      /* Release the deadline bandwidth reservation */
+
+      nxsched_stop_deadline(tcb);
+    }
+#endif
 }
@@ -412,6 +412,22 @@ static int nxthread_setup_scheduler(FAR struct tcb_s *tcb, int priority,
   ret = nxtask_assign_pid(tcb);
   if (ret == OK)
     {
+#ifdef CONFIG_SCHED_VDSO
+      FAR struct tls_info_s *info = tcb->stack_alloc_ptr;
+
+      /* Save the IDs in the TLS for getpid() and gettid().  A pthread
+       * belongs to the task group of its creator.
+       */
+
+      if (info != NULL)
+        {
+          info->tl_tid = tcb->pid;
+          info->tl_pid = (ttype & TCB_FLAG_TTYPE_MASK) ==
+                         TCB_FLAG_TTYPE_PTHREAD ?
+                         tcb->group->tg_pid : tcb->pid;
+        }
+#endif
+
       /* Save task priority and entry point in the TCB */
 
       tcb->sched_priority = (uint8_t)priority;
@@ -33,6 +33,7 @@
 #include <stdint.h>
 
 #include <nuttx/compiler.h>
+#include <nuttx/hrtimer.h>
 #include <nuttx/signal.h>
 #include <nuttx/wdog.h>
 
@@ -59,9 +60,15 @@ struct posix_timer_s
   uint8_t          pt_crefs;       /* Reference count */
   pid_t            pt_owner;       /* Creator of timer */
   int              pt_overrun;     /* Overrun time */
+#ifdef CONFIG_HRTIMER_POSIX_TIMERS
+  uint64_t         pt_delay;       /* If non-zero, period of repetitive timers (ns) */
+  uint64_t         pt_expected;    /* Expected absolute time (ns) */
+  struct hrtimer_s pt_hrtimer;     /* The hrtimer that provides the timing */
+#else
   sclock_t         pt_delay;       /* If non-zero, used to reset repetitive timers */
   clock_t          pt_expected;    /* Expected absolute time */
   struct wdog_s    pt_wdog;        /* The watchdog that provides the timing */
+#endif
   struct sigevent  pt_event;       /* Notification information */
 #ifdef CONFIG_SIG_EVTHREAD
   struct sigwork_s pt_work;
@@ -73,7 +73,9 @@
 int timer_gettime(timer_t timerid, FAR struct itimerspec *value)
 {
   FAR struct posix_timer_s *timer = timer_gethandle(timerid);
+#ifndef CONFIG_HRTIMER_POSIX_TIMERS
   sclock_t ticks;
+#endif
 
   if (!timer || !value)
     {
@@ -81,6 +83,10 @@ int timer_gettime(timer_t timerid, FAR struct itimerspec *value)
       return ERROR;
     }
 
+#ifdef CONFIG_HRTIMER_POSIX_TIMERS
+  clock_nsec2time(&value->it_value, hrtimer_gettime(&timer->pt_hrtimer));
+  clock_nsec2time(&value->it_interval, timer->pt_delay);
+#else
   /* Get the number of ticks before the underlying watchdog expires */
 
   ticks = wd_gettime(&timer->pt_wdog);
@@ -89,6 +95,7 @@ int timer_gettime(timer_t timerid, FAR struct itimerspec *value)
 
   clock_ticks2time(&value->it_value, ticks);
   clock_ticks2time(&value->it_interval, timer->pt_delay);
+#endif
   return OK;
 }
 
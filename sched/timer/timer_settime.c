@@ -44,9 +44,14 @@
  ****************************************************************************/
 
 static inline void timer_signotify(FAR struct posix_timer_s *timer);
+#ifdef CONFIG_HRTIMER_POSIX_TIMERS
+static uint64_t timer_hrtimeout(FAR struct hrtimer_s *hrtimer,
+                                uint64_t expired);
+#else
 static inline void timer_restart(FAR struct posix_timer_s *timer,
                                  wdparm_t itimer);
 static void timer_timeout(wdparm_t itimer);
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -81,6 +86,72 @@ static inline void timer_signotify(FAR struct posix_timer_s *timer)
 #endif
 }
 
+/****************************************************************************
+ * Name: timer_hrtimeout
+ *
+ * Description:
+ *   The hrtimer flavor of timer_timeout().  A periodic timer is restarted
+ *   by returning the delay to its next expected time, counting the periods
+ *   that were missed as overruns.
+ *
+ * Input Parameters:
+ *   hrtimer - The hrtimer of the POSIX timer that just timed out
+ *   expired - The time at which the hrtimer was due (ns)
+ *
+ * Returned Value:
+ *   The delay to the next expiration from 'expired' or zero.
+ *
+ * Assumptions:
+ *   This function executes in the context of the oneshot timer interrupt.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER_POSIX_TIMERS
+static uint64_t timer_hrtimeout(FAR struct hrtimer_s *hrtimer,
+                                uint64_t expired)
+{
+  FAR struct posix_timer_s *timer =
+    timer_gethandle((timer_t)hrtimer->arg);
+  uint64_t frame;
+  uint64_t now;
+
+  if (timer == NULL)
+    {
+      return 0;
+    }
+
+  /* Send the specified signal to the specified task.   Increment the
+   * reference count on the timer first so that will not be deleted until
+   * after the signal handler returns.
+   */
+
+  timer->pt_crefs++;
+  timer_signotify(timer);
+
+  /* Release the reference.  timer_release will return nonzero if the timer
+   * was not deleted.
+   */
+
+  if (timer_release(timer) == 0 || timer->pt_delay == 0)
+    {
+      return 0;
+    }
+
+  /* Same computation as timer_restart(), in nanoseconds */
+
+  now   = hrtimer_now();
+  frame = 1;
+  if (now > timer->pt_expected)
+    {
+      frame += (now - timer->pt_expected) / timer->pt_delay;
+    }
+
+  timer->pt_overrun   = frame - 1;
+  timer->pt_expected += frame * timer->pt_delay;
+
+  return timer->pt_expected - expired;
+}
+#else
 /****************************************************************************
  * Name: timer_restart
  *
@@ -182,6 +253,7 @@ static void timer_timeout(wdparm_t itimer)
       timer_restart(timer, itimer);
     }
 }
+#endif /* CONFIG_HRTIMER_POSIX_TIMERS */
 
 /****************************************************************************
  * Public Functions
@@ -256,7 +328,11 @@ int timer_settime(timer_t timerid, int flags,
                   FAR struct itimerspec *ovalue)
 {
   FAR struct posix_timer_s *timer = timer_gethandle(timerid);
+#ifdef CONFIG_HRTIMER_POSIX_TIMERS
+  struct timespec reltime;
+#else
   sclock_t delay;
+#endif
   int ret = OK;
 
   /* Some sanity checks */
@@ -269,6 +345,11 @@ int timer_settime(timer_t timerid, int flags,
 
   if (ovalue)
     {
+#ifdef CONFIG_HRTIMER_POSIX_TIMERS
+      clock_nsec2time(&ovalue->it_value,
+                      hrtimer_gettime(&timer->pt_hrtimer));
+      clock_nsec2time(&ovalue->it_interval, timer->pt_delay);
+#else
       /* Get the number of ticks before the underlying watchdog expires */
 
       delay = wd_gettime(&timer->pt_wdog);
@@ -277,13 +358,18 @@ int timer_settime(timer_t timerid, int flags,
 
       clock_ticks2time(&ovalue->it_value, delay);
       clock_ticks2time(&ovalue->it_interval, timer->pt_delay);
+#endif
     }
 
   /* Disarm the timer (in case the timer was already armed when
    * timer_settime() is called).
    */
 
+#ifdef CONFIG_HRTIMER_POSIX_TIMERS
+  hrtimer_cancel(&timer->pt_hrtimer);
+#else
   wd_cancel(&timer->pt_wdog);
+#endif
 
   /* Cancel any pending notification */
 
@@ -298,6 +384,31 @@ int timer_settime(timer_t timerid, int flags,
       return OK;
     }
 
+#ifdef CONFIG_HRTIMER_POSIX_TIMERS
+  /* Setup up any repetitive timer */
+
+  timer->pt_delay = clock_time2nsec(&value->it_interval);
+
+  /* Check if abstime is selected, an absolute time in the past expires
+   * immediately.
+   */
+
+  if ((flags & TIMER_ABSTIME) != 0)
+    {
+      nxclock_gettime(timer->pt_clock, &reltime);
+      clock_timespec_subtract(&value->it_value, &reltime, &reltime);
+    }
+  else
+    {
+      reltime = value->it_value;
+    }
+
+  /* Then start the hrtimer */
+
+  timer->pt_expected = hrtimer_now() + clock_time2nsec(&reltime);
+  ret = hrtimer_start(&timer->pt_hrtimer, timer_hrtimeout, timer,
+                      timer->pt_expected, HRTIMER_MODE_ABS);
+#else
   /* Setup up any repetitive timer */
 
   if (value->it_interval.tv_sec > 0 || value->it_interval.tv_nsec > 0)
@@ -335,6 +446,7 @@ int timer_settime(timer_t timerid, int flags,
 
   ret = wd_start_abstick(&timer->pt_wdog, timer->pt_expected,
                          timer_timeout, (wdparm_t)timer);
+#endif
 
   if (ret < 0)
     {
@@ -31,6 +31,9 @@
 #include <nuttx/mutex.h>
 
 #include "tls.h"
+#ifdef CONFIG_SCHED_VDSO
+#  include "clock/clock.h"
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -145,5 +148,11 @@ int task_init_info(FAR struct task_group_s *group)
   task_init_stream(&info->ta_streamlist);
 #endif
 
+#ifdef CONFIG_SCHED_VDSO
+  /* Share the time data of the kernel with the task group */
+
+  info->ta_vdso = g_vdso_data;
+#endif
+
   return OK;
 }
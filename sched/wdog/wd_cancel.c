@@ -38,6 +38,61 @@
 #include "sched/sched.h"
 #include "wdog/wdog.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_dequeue
+ *
+ * Description:
+ *   Remove a watchdog from the active queue and mark it inactive.
+ *
+ * Input Parameters:
+ *   wdog - ID of the watchdog to cancel.
+ *
+ * Returned Value:
+ *   One if the watchdog was the first one to expire, zero if it was not or
+ *   -EINVAL if the watchdog was not active.
+ *
+ ****************************************************************************/
+
+static int wd_dequeue(FAR struct wdog_s *wdog)
+{
+  irqstate_t flags;
+  bool head;
+
+  flags = wd_lock();
+
+  /* Make sure that the watchdog is still active. */
+
+  if (!WDOG_ISACTIVE(wdog))
+    {
+      wd_unlock(flags);
+      return -EINVAL;
+    }
+
+  sched_note_wdog(NOTE_WDOG_CANCEL, (FAR void *)wdog->func,
+                  (FAR void *)(uintptr_t)wdog->expired);
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  head = wd_wheel_remove(wdog);
+#else
+  head = list_is_head(&g_wdactivelist, &wdog->node);
+
+  /* Now, remove the watchdog from the timer queue */
+
+  list_delete(&wdog->node);
+#endif
+
+  /* Mark the watchdog inactive */
+
+  wdog->func = NULL;
+
+  wd_unlock(flags);
+  return head;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -63,13 +118,32 @@ int wd_cancel(FAR struct wdog_s *wdog)
   irqstate_t flags;
   int ret;
 
-  flags = enter_critical_section();
+  if (wdog == NULL)
+    {
+      return -EINVAL;
+    }
+
+  ret = wd_dequeue(wdog);
+  if (ret != 0)
+    {
+      /* The watchdog function runs in a critical section.  If the watchdog
+       * has just been removed by the timer on another CPU, entering the
+       * critical section waits until its function has returned.  If the
+       * watchdog was at the head of the timer queue, the interval timer
+       * must be re-adjusted.
+       */
+
+      flags = enter_critical_section();
 
-  ret = wd_cancel_irq(wdog);
+      if (ret > 0)
+        {
+          nxsched_reassess_timer();
+        }
 
-  leave_critical_section(flags);
+      leave_critical_section(flags);
+    }
 
-  return ret;
+  return ret < 0 ? ret : OK;
 }
 
 /****************************************************************************
@@ -91,33 +165,17 @@ int wd_cancel(FAR struct wdog_s *wdog)
 
 int wd_cancel_irq(FAR struct wdog_s *wdog)
 {
-  bool head;
+  int ret;
 
-  /* Make sure that the watchdog is valid and still active. */
+  /* Make sure that the watchdog is valid. */
 
-  if (wdog == NULL || !WDOG_ISACTIVE(wdog))
+  if (wdog == NULL)
     {
       return -EINVAL;
     }
 
-  sched_note_wdog(NOTE_WDOG_CANCEL, (FAR void *)wdog->func,
-                  (FAR void *)(uintptr_t)wdog->expired);
-
-  /* Prohibit timer interactions with the timer queue until the
-   * cancellation is complete
-   */
-
-  head = list_is_head(&g_wdactivelist, &wdog->node);
-
-  /* Now, remove the watchdog from the timer queue */
-
-  list_delete(&wdog->node);
-
-  /* Mark the watchdog inactive */
-
-  wdog->func = NULL;
-
-  if (head)
+  ret = wd_dequeue(wdog);
+  if (ret > 0)
     {
       /* If the watchdog is at the head of the timer queue, then
        * we will need to re-adjust the interval timer that will
@@ -127,5 +185,5 @@ int wd_cancel_irq(FAR struct wdog_s *wdog)
       nxsched_reassess_timer();
     }
 
-  return OK;
+  return ret < 0 ? ret : OK;
 }
@@ -65,3 +65,44 @@ sclock_t wd_gettime(FAR struct wdog_s *wdog)
 
   return delay < 0 ? 0 : delay;
 }
+
+/****************************************************************************
+ * Name: wd_getnext
+ *
+ * Description:
+ *   This function returns the time remaining before the next watchdog
+ *   timer expires.
+ *
+ ****************************************************************************/
+
+sclock_t wd_getnext(void)
+{
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  clock_t expired;
+#else
+  FAR struct wdog_s *wdog;
+#endif
+  irqstate_t flags;
+  sclock_t delay = -1;
+
+  flags = wd_lock();
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  if (wd_wheel_earliest(&expired))
+    {
+      delay = expired - clock_systime_ticks();
+      delay = delay < 0 ? 0 : delay;
+    }
+#else
+  if (!list_is_empty(&g_wdactivelist))
+    {
+      wdog  = list_first_entry(&g_wdactivelist, struct wdog_s, node);
+      delay = wdog->expired - clock_systime_ticks();
+      delay = delay < 0 ? 0 : delay;
+    }
+#endif
+
+  wd_unlock(flags);
+
+  return delay;
+}
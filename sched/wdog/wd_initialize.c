@@ -39,7 +39,17 @@
  * this linked list are removed and the function is called.
  */
 
+#ifndef CONFIG_WDOG_TIMERWHEEL
 struct list_node g_wdactivelist = LIST_INITIAL_VALUE(g_wdactivelist);
+#endif
+
+/* This spinlock protects the active watchdog queue */
+
+spinlock_t g_wdspinlock = SP_UNLOCKED;
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+struct lockstat_s g_wdlockstat = LOCKSTAT_INITIALIZER("wdog");
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -66,4 +66,8 @@ void wd_recover(FAR struct tcb_s *tcb)
    */
 
   wd_cancel(&tcb->waitdog);
+
+#ifdef CONFIG_HRTIMER_CLOCKWAIT
+  hrtimer_cancel(&tcb->waithrtimer);
+#endif
 }
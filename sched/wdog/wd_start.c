@@ -94,6 +94,85 @@ static unsigned int g_wdtimernested;
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: wd_next_expired
+ *
+ * Description:
+ *   Remove and return the first watchdog of the active queue if it has
+ *   expired.
+ *
+ * Input Parameters:
+ *   ticks - current time in ticks
+ *
+ * Returned Value:
+ *   The expired watchdog or NULL if there is none.
+ *
+ ****************************************************************************/
+
+static inline_function FAR struct wdog_s *wd_next_expired(clock_t ticks)
+{
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  return wd_wheel_expired(ticks);
+#else
+  FAR struct wdog_s *wdog;
+
+  if (list_is_empty(&g_wdactivelist))
+    {
+      return NULL;
+    }
+
+  wdog = list_first_entry(&g_wdactivelist, struct wdog_s, node);
+
+  /* Check if expected time is expired */
+
+  if (!clock_compare(wdog->expired, ticks))
+    {
+      return NULL;
+    }
+
+  /* Remove the watchdog from the head of the list */
+
+  list_delete(&wdog->node);
+  return wdog;
+#endif
+}
+
+/****************************************************************************
+ * Name: wd_pending
+ *
+ * Description:
+ *   Check if the first watchdog of the active queue has expired.
+ *
+ * Input Parameters:
+ *   ticks - current time in ticks
+ *
+ * Returned Value:
+ *   True if there is at least one watchdog to expire.
+ *
+ * Assumptions:
+ *   The caller holds g_wdspinlock.
+ *
+ ****************************************************************************/
+
+static inline_function bool wd_pending(clock_t ticks)
+{
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  clock_t expired;
+
+  return wd_wheel_earliest(&expired) && clock_compare(expired, ticks);
+#else
+  FAR struct wdog_s *wdog;
+
+  if (list_is_empty(&g_wdactivelist))
+    {
+      return false;
+    }
+
+  wdog = list_first_entry(&g_wdactivelist, struct wdog_s, node);
+  return clock_compare(wdog->expired, ticks);
+#endif
+}
+
 /****************************************************************************
  * Name: wd_expiration
  *
@@ -113,9 +192,29 @@ static inline_function void wd_expiration(clock_t ticks)
 {
   FAR struct wdog_s *wdog;
   irqstate_t flags;
+  irqstate_t lock;
   wdentry_t func;
+  wdparm_t arg;
+
+  /* Most timer interrupts have nothing to expire.  Check that first so
+   * that they do not need to take the global critical section.
+   */
+
+  lock = wd_lock();
+  if (!wd_pending(ticks))
+    {
+      wd_unlock(lock);
+      return;
+    }
+
+  wd_unlock(lock);
+
+  /* The watchdog functions still run in a critical section.  wd_cancel()
+   * relies on this to wait for a function that is being executed.
+   */
 
   flags = enter_critical_section();
+  lock  = wd_lock();
 
 #ifdef CONFIG_SCHED_TICKLESS
   /* Increment the nested watchdog timer count to handle cases where wd_start
@@ -129,30 +228,24 @@ static inline_function void wd_expiration(clock_t ticks)
    * other watchdogs that became ready to run at this time
    */
 
-  while (!list_is_empty(&g_wdactivelist))
+  while ((wdog = wd_next_expired(ticks)) != NULL)
     {
-      wdog = list_first_entry(&g_wdactivelist, struct wdog_s, node);
-
-      /* Check if expected time is expired */
-
-      if (!clock_compare(wdog->expired, ticks))
-        {
-          break;
-        }
-
-      /* Remove the watchdog from the head of the list */
-
-      list_delete(&wdog->node);
-
       /* Indicate that the watchdog is no longer active. */
 
       func = wdog->func;
+      arg  = wdog->arg;
       wdog->func = NULL;
 
-      /* Execute the watchdog function */
+      /* Execute the watchdog function without the queue lock so that it
+       * may restart or cancel watchdogs.
+       */
 
       up_setpicbase(wdog->picbase);
-      CALL_FUNC(func, wdog->arg);
+      wd_unlock(lock);
+
+      CALL_FUNC(func, arg);
+
+      lock = wd_lock();
     }
 
 #ifdef CONFIG_SCHED_TICKLESS
@@ -161,6 +254,7 @@ static inline_function void wd_expiration(clock_t ticks)
   g_wdtimernested--;
 #endif
 
+  wd_unlock(lock);
   leave_critical_section(flags);
 }
 
@@ -181,14 +275,23 @@ static inline_function void wd_expiration(clock_t ticks)
  *   wdog and wdentry is not NULL.
  *
  * Returned Value:
- *   None.
+ *   True if the watchdog is (or, with the timer wheel, may be) the first
+ *   one to expire.
  *
  ****************************************************************************/
 
 static inline_function
-void wd_insert(FAR struct wdog_s *wdog, clock_t expired,
+bool wd_insert(FAR struct wdog_s *wdog, clock_t expired,
                wdentry_t wdentry, wdparm_t arg)
 {
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  wdog->func = wdentry;
+  up_getpicbase(&wdog->picbase);
+  wdog->arg = arg;
+  wdog->expired = expired;
+
+  return wd_wheel_insert(wdog);
+#else
   FAR struct wdog_s *curr;
 
   /* Traverse the watchdog list */
@@ -216,6 +319,9 @@ void wd_insert(FAR struct wdog_s *wdog, clock_t expired,
   up_getpicbase(&wdog->picbase);
   wdog->arg = arg;
   wdog->expired = expired;
+
+  return list_is_head(&g_wdactivelist, &wdog->node);
+#endif
 }
 
 /****************************************************************************
@@ -290,31 +396,39 @@ int wd_start_abstick(FAR struct wdog_s *wdog, clock_t ticks,
 
   /* NOTE:  There is a race condition here... the caller may receive
    * the watchdog between the time that wd_start_abstick is called and
-   * the critical section is established.
+   * the queue lock is taken.
    */
 
-  flags = enter_critical_section();
+  flags = wd_lock();
 #ifdef CONFIG_SCHED_TICKLESS
   /* We need to reassess timer if the watchdog list head has changed. */
 
   if (WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMERWHEEL
+      reassess |= wd_wheel_remove(wdog);
+#else
       reassess |= list_is_head(&g_wdactivelist, &wdog->node);
       list_delete(&wdog->node);
+#endif
       wdog->func = NULL;
     }
 
-  wd_insert(wdog, ticks, wdentry, arg);
+  reassess |= wd_insert(wdog, ticks, wdentry, arg);
+  reassess &= !g_wdtimernested;
+
+  wd_unlock(flags);
 
-  if (!g_wdtimernested &&
-      (reassess || list_is_head(&g_wdactivelist, &wdog->node)))
+  if (reassess)
     {
       /* Resume the interval timer that will generate the next
        * interval event. If the timer at the head of the list changed,
        * then this will pick that new delay.
        */
 
+      flags = enter_critical_section();
       nxsched_reassess_timer();
+      leave_critical_section(flags);
     }
 #else
   UNUSED(reassess);
@@ -323,13 +437,18 @@ int wd_start_abstick(FAR struct wdog_s *wdog, clock_t ticks,
 
   if (WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMERWHEEL
+      wd_wheel_remove(wdog);
+#else
       list_delete(&wdog->node);
+#endif
       wdog->func = NULL;
     }
 
   wd_insert(wdog, ticks, wdentry, arg);
+
+  wd_unlock(flags);
 #endif
-  leave_critical_section(flags);
 
   sched_note_wdog(NOTE_WDOG_START, wdentry, (FAR void *)(uintptr_t)ticks);
   return OK;
@@ -414,7 +533,11 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
 #ifdef CONFIG_SCHED_TICKLESS
 clock_t wd_timer(clock_t ticks, bool noswitches)
 {
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  clock_t expired;
+#else
   FAR struct wdog_s *wdog;
+#endif
   irqstate_t flags;
   sclock_t ret;
 
@@ -425,13 +548,22 @@ clock_t wd_timer(clock_t ticks, bool noswitches)
       wd_expiration(ticks);
     }
 
-  flags = enter_critical_section();
+  flags = wd_lock();
 
   /* Return the delay for the next watchdog to expire */
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  if (!wd_wheel_earliest(&expired))
+    {
+      wd_unlock(flags);
+      return 0;
+    }
+
+  ret = expired - ticks;
+#else
   if (list_is_empty(&g_wdactivelist))
     {
-      leave_critical_section(flags);
+      wd_unlock(flags);
       return 0;
     }
 
@@ -441,8 +573,9 @@ clock_t wd_timer(clock_t ticks, bool noswitches)
 
   wdog = list_first_entry(&g_wdactivelist, struct wdog_s, node);
   ret = wdog->expired - ticks;
+#endif
 
-  leave_critical_section(flags);
+  wd_unlock(flags);
 
   /* Return the delay for the next watchdog to expire */
 
@@ -0,0 +1,558 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+#include <assert.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/wdog.h>
+
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Watchdogs that expire within 2^BITS ticks of the wheel base are kept in
+ * level 0, one slot per tick.  Level n holds watchdogs that expire within
+ * 2^(BITS * (n + 1)) ticks, one slot per 2^(BITS * n) ticks.  When the low
+ * BITS * n bits of the base wrap to zero, the current slot of level n is
+ * re-filed into the finer levels ("cascaded").
+ */
+
+#define WHEEL_BITS         CONFIG_WDOG_TIMERWHEEL_BITS
+#define WHEEL_LEVELS       CONFIG_WDOG_TIMERWHEEL_LEVELS
+#define WHEEL_SLOTS        (1 << WHEEL_BITS)
+#define WHEEL_MASK         (WHEEL_SLOTS - 1)
+#define WHEEL_SHIFT(l)     ((l) * WHEEL_BITS)
+#define WHEEL_INDEX(t, l)  ((int)(((t) >> WHEEL_SHIFT(l)) & WHEEL_MASK))
+
+#ifdef CONFIG_SYSTEM_TIME64
+#  define WHEEL_CLOCKBITS  63
+#else
+#  define WHEEL_CLOCKBITS  31
+#endif
+
+/* Delays that do not fit in the wheel are kept in an overflow list */
+
+#define WHEEL_MAXDELTA     (((sclock_t)1 << (WHEEL_BITS * WHEEL_LEVELS)) - 1)
+
+#if WHEEL_BITS * WHEEL_LEVELS >= WHEEL_CLOCKBITS
+#  error WDOG_TIMERWHEEL_BITS * WDOG_TIMERWHEEL_LEVELS is too large
+#endif
+
+#if WHEEL_BITS > 5
+#  define WHEEL_FFS(b)     ffsll((long long)(b))
+typedef uint64_t wd_bitmap_t;
+#else
+#  define WHEEL_FFS(b)     ffs((int)(b))
+typedef uint32_t wd_bitmap_t;
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct wd_wheel_s
+{
+  clock_t     base;                  /* Next tick to be processed */
+  clock_t     next;                  /* Cached earliest expiration time */
+  bool        nextvalid;             /* True: 'next' is up to date */
+  wd_bitmap_t bitmap[WHEEL_LEVELS];  /* Non-empty slots of each level */
+  struct list_node overflow;         /* Beyond the reach of the wheel */
+  struct list_node slot[WHEEL_LEVELS][WHEEL_SLOTS];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct wd_wheel_s g_wdwheel;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_nextslot
+ *
+ * Description:
+ *   Return the first non-empty slot of 'level' at or after 'start' in
+ *   circular order, or -1 if the level is empty.
+ *
+ ****************************************************************************/
+
+static int wd_wheel_nextslot(int level, int start)
+{
+  wd_bitmap_t bitmap = g_wdwheel.bitmap[level];
+  wd_bitmap_t upper;
+
+  if (bitmap == 0)
+    {
+      return -1;
+    }
+
+  upper = bitmap & ~(((wd_bitmap_t)1 << start) - 1);
+  return WHEEL_FFS(upper != 0 ? upper : bitmap) - 1;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_file
+ *
+ * Description:
+ *   File the watchdog in the slot matching its expiration time relative to
+ *   the current wheel base.  Watchdogs re-filed by a cascade were started
+ *   before any watchdog already in the destination slot with the same
+ *   expiration time, so they are put in front of the slot to keep the
+ *   first-in, first-out order of the sorted list implementation.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_file(FAR struct wdog_s *wdog, bool front)
+{
+  FAR struct list_node *slot;
+  clock_t expired = wdog->expired;
+  sclock_t delta = (sclock_t)(expired - g_wdwheel.base);
+  int level = 0;
+  int index;
+
+  if (delta <= 0)
+    {
+      /* Already due.  File it in the current slot, ahead of those watchdogs
+       * that expire later (or at the same time if re-filed by a cascade).
+       */
+
+      FAR struct wdog_s *curr;
+
+      index = WHEEL_INDEX(g_wdwheel.base, 0);
+      slot  = &g_wdwheel.slot[0][index];
+      if (list_is_clear(slot))
+        {
+          list_initialize(slot);
+        }
+
+      list_for_every_entry(slot, curr, struct wdog_s, node)
+        {
+          sclock_t diff = (sclock_t)(curr->expired - expired);
+
+          if (diff > 0 || (front && diff == 0))
+            {
+              break;
+            }
+        }
+
+      list_add_before(&curr->node, &wdog->node);
+      g_wdwheel.bitmap[0] |= (wd_bitmap_t)1 << index;
+      return;
+    }
+
+  if (delta > WHEEL_MAXDELTA)
+    {
+      /* Re-examined each time the last level wraps */
+
+      slot = &g_wdwheel.overflow;
+      if (list_is_clear(slot))
+        {
+          list_initialize(slot);
+        }
+
+      list_add_tail(slot, &wdog->node);
+      return;
+    }
+
+  while (level < WHEEL_LEVELS - 1 &&
+         (delta >> WHEEL_SHIFT(level + 1)) != 0)
+    {
+      level++;
+    }
+
+  index = WHEEL_INDEX(expired, level);
+  slot  = &g_wdwheel.slot[level][index];
+  if (list_is_clear(slot))
+    {
+      list_initialize(slot);
+    }
+
+  if (front)
+    {
+      list_add_head(slot, &wdog->node);
+    }
+  else
+    {
+      list_add_tail(slot, &wdog->node);
+    }
+
+  g_wdwheel.bitmap[level] |= (wd_bitmap_t)1 << index;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_unlink
+ *
+ * Description:
+ *   Remove the watchdog from its slot, updating the slot bitmap if the slot
+ *   becomes empty.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_unlink(FAR struct wdog_s *wdog)
+{
+  FAR struct list_node *head = wdog->node.prev;
+
+  if (head == wdog->node.next && head != &g_wdwheel.overflow)
+    {
+      /* This was the only watchdog in the slot, so 'head' is the slot
+       * itself.
+       */
+
+      int offset = head - &g_wdwheel.slot[0][0];
+
+      DEBUGASSERT(offset >= 0 && offset < WHEEL_LEVELS * WHEEL_SLOTS);
+      g_wdwheel.bitmap[offset >> WHEEL_BITS] &=
+        ~((wd_bitmap_t)1 << (offset & WHEEL_MASK));
+    }
+
+  list_delete(&wdog->node);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Re-file the current slot of 'level' and, if that level wrapped as
+ *   well, the current slot of the next level and so on.  Slots are walked
+ *   from their tail so that front insertion preserves their order.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_cascade(int level)
+{
+  for (; level < WHEEL_LEVELS; level++)
+    {
+      int index = WHEEL_INDEX(g_wdwheel.base, level);
+      FAR struct list_node *slot = &g_wdwheel.slot[level][index];
+
+      if ((g_wdwheel.bitmap[level] & ((wd_bitmap_t)1 << index)) != 0)
+        {
+          g_wdwheel.bitmap[level] &= ~((wd_bitmap_t)1 << index);
+          while (!list_is_empty(slot))
+            {
+              FAR struct wdog_s *wdog =
+                list_last_entry(slot, struct wdog_s, node);
+
+              list_delete(&wdog->node);
+              wd_wheel_file(wdog, true);
+            }
+        }
+
+      if (index != 0)
+        {
+          return;
+        }
+    }
+
+  /* The last level wrapped as well.  Bring in the overflowed watchdogs
+   * that are now within reach.
+   */
+
+  if (!list_is_clear(&g_wdwheel.overflow))
+    {
+      FAR struct list_node *node = g_wdwheel.overflow.prev;
+
+      while (node != &g_wdwheel.overflow)
+        {
+          FAR struct wdog_s *wdog = list_entry(node, struct wdog_s, node);
+
+          node = node->prev;
+          if ((sclock_t)(wdog->expired - g_wdwheel.base) <= WHEEL_MAXDELTA)
+            {
+              list_delete(&wdog->node);
+              wd_wheel_file(wdog, true);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_advance
+ *
+ * Description:
+ *   Move the wheel base forward by at least one tick, skipping runs of
+ *   empty level 0 slots, but never beyond 'ticks' + 1.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_advance(clock_t ticks)
+{
+  int index = WHEEL_INDEX(g_wdwheel.base, 0);
+  wd_bitmap_t upper;
+  clock_t next;
+
+  upper = index < WHEEL_MASK ?
+          g_wdwheel.bitmap[0] & ~(((wd_bitmap_t)2 << index) - 1) : 0;
+
+  if (upper != 0)
+    {
+      next = (g_wdwheel.base & ~(clock_t)WHEEL_MASK) +
+             WHEEL_FFS(upper) - 1;
+    }
+  else
+    {
+      next = (g_wdwheel.base | WHEEL_MASK) + 1;
+    }
+
+  if (clock_compare(next, ticks))
+    {
+      g_wdwheel.base = next;
+      if (WHEEL_INDEX(next, 0) == 0)
+        {
+          wd_wheel_cascade(1);
+        }
+    }
+  else
+    {
+      /* Stop right after 'ticks'.  This is never past a level 0 boundary
+       * that has not been cascaded since 'next' is at most that boundary.
+       */
+
+      g_wdwheel.base = ticks + 1;
+      if (WHEEL_INDEX(g_wdwheel.base, 0) == 0)
+        {
+          wd_wheel_cascade(1);
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_insert
+ *
+ * Description:
+ *   Add an initialized watchdog to the wheel.  wdog->expired must be valid.
+ *
+ * Returned Value:
+ *   True if the watchdog may now be the first one to expire.
+ *
+ * Assumptions:
+ *   The caller holds g_wdspinlock.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_insert(FAR struct wdog_s *wdog)
+{
+  wd_wheel_file(wdog, false);
+
+  if (!g_wdwheel.nextvalid)
+    {
+      return true;
+    }
+
+  if ((sclock_t)(wdog->expired - g_wdwheel.next) < 0)
+    {
+      g_wdwheel.next = wdog->expired;
+      return true;
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ *
+ * Description:
+ *   Remove an active watchdog from the wheel.
+ *
+ * Returned Value:
+ *   True if the watchdog may have been the first one to expire.
+ *
+ * Assumptions:
+ *   The caller holds g_wdspinlock.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_remove(FAR struct wdog_s *wdog)
+{
+  bool first = !g_wdwheel.nextvalid || wdog->expired == g_wdwheel.next;
+
+  wd_wheel_unlink(wdog);
+  if (first)
+    {
+      g_wdwheel.nextvalid = false;
+    }
+
+  return first;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_expired
+ *
+ * Description:
+ *   Remove and return the next watchdog whose expiration time is not after
+ *   'ticks'.  Watchdogs are returned in the same order the sorted list
+ *   implementation would expire them.
+ *
+ * Returned Value:
+ *   The expired watchdog or NULL if there are no more.
+ *
+ * Assumptions:
+ *   The caller holds g_wdspinlock.
+ *
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_expired(clock_t ticks)
+{
+  FAR struct wdog_s *wdog;
+
+  for (; ; )
+    {
+      int index = WHEEL_INDEX(g_wdwheel.base, 0);
+
+      /* The current slot may also hold watchdogs that were started with
+       * an expiration time that had already been processed.
+       */
+
+      if ((g_wdwheel.bitmap[0] & ((wd_bitmap_t)1 << index)) != 0)
+        {
+          wdog = list_first_entry(&g_wdwheel.slot[0][index],
+                                  struct wdog_s, node);
+          if (clock_compare(wdog->expired, ticks))
+            {
+              wd_wheel_unlink(wdog);
+              g_wdwheel.nextvalid = false;
+              return wdog;
+            }
+        }
+
+      if (!clock_compare(g_wdwheel.base, ticks))
+        {
+          return NULL;
+        }
+
+      wd_wheel_advance(ticks);
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_earliest
+ *
+ * Description:
+ *   Get the expiration time of the first watchdog to expire.
+ *
+ * Input Parameters:
+ *   expired - Location to return the expiration time.
+ *
+ * Returned Value:
+ *   False if there are no active watchdogs.
+ *
+ * Assumptions:
+ *   The caller holds g_wdspinlock.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_earliest(FAR clock_t *expired)
+{
+  FAR struct wdog_s *wdog;
+  bool found = false;
+  clock_t best = 0;
+  int level;
+
+  if (g_wdwheel.nextvalid)
+    {
+      *expired = g_wdwheel.next;
+      return true;
+    }
+
+  for (level = 0; level < WHEEL_LEVELS; level++)
+    {
+      int start = WHEEL_INDEX(g_wdwheel.base, level);
+      int index;
+
+      /* The current slot of a coarser level holds watchdogs that are a
+       * full revolution away, so the search starts with the next slot.
+       */
+
+      if (level > 0)
+        {
+          start = (start + 1) & WHEEL_MASK;
+        }
+
+      index = wd_wheel_nextslot(level, start);
+      if (index < 0)
+        {
+          continue;
+        }
+
+      /* Level 0 slots are kept in order.  Other slots cover a range of
+       * ticks and must be searched.
+       */
+
+      list_for_every_entry(&g_wdwheel.slot[level][index], wdog,
+                           struct wdog_s, node)
+        {
+          if (!found || (sclock_t)(wdog->expired - best) < 0)
+            {
+              best  = wdog->expired;
+              found = true;
+            }
+
+          if (level == 0)
+            {
+              break;
+            }
+        }
+    }
+
+  if (!list_is_clear(&g_wdwheel.overflow))
+    {
+      list_for_every_entry(&g_wdwheel.overflow, wdog, struct wdog_s, node)
+        {
+          if (!found || (sclock_t)(wdog->expired - best) < 0)
+            {
+              best  = wdog->expired;
+              found = true;
+            }
+        }
+    }
+
+  if (found)
+    {
+      g_wdwheel.next      = best;
+      g_wdwheel.nextvalid = true;
+      *expired            = best;
+    }
+
+  return found;
+}
+
+#endif /* CONFIG_WDOG_TIMERWHEEL */
@@ -34,7 +34,9 @@
 
 #include <nuttx/compiler.h>
 #include <nuttx/clock.h>
+#include <nuttx/lockstat.h>
 #include <nuttx/queue.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/wdog.h>
 #include <nuttx/list.h>
 
@@ -46,6 +48,15 @@
 
 #define list_node wdlist_node
 
+/* Serialize accesses to the active watchdog queue.  The spinlock nests
+ * inside of the critical section: it may be taken with the critical section
+ * held but the critical section must never be entered while it is held.
+ */
+
+#define wd_lock()       lockstat_spin_lock_irqsave(&g_wdspinlock, \
+                                                   &g_wdlockstat)
+#define wd_unlock(f)    spin_unlock_irqrestore(&g_wdspinlock, f)
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -63,7 +74,19 @@ extern "C"
  * this linked list are removed and the function is called.
  */
 
+#ifndef CONFIG_WDOG_TIMERWHEEL
 extern struct list_node g_wdactivelist;
+#endif
+
+/* This spinlock protects the active watchdog queue, g_wdactivelist or the
+ * timer wheel, in place of the global critical section.
+ */
+
+extern spinlock_t g_wdspinlock;
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+extern struct lockstat_s g_wdlockstat;
+#endif
 
 /****************************************************************************
  * Public Function Prototypes
@@ -123,6 +146,23 @@ void wd_timer(clock_t ticks);
 struct tcb_s;
 void wd_recover(FAR struct tcb_s *tcb);
 
+/****************************************************************************
+ * Name: wd_wheel_insert, wd_wheel_remove, wd_wheel_expired and
+ *       wd_wheel_earliest
+ *
+ * Description:
+ *   Timer wheel implementation of the active watchdog queue.  See
+ *   wd_wheel.c.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+bool wd_wheel_insert(FAR struct wdog_s *wdog);
+bool wd_wheel_remove(FAR struct wdog_s *wdog);
+FAR struct wdog_s *wd_wheel_expired(clock_t ticks);
+bool wd_wheel_earliest(FAR clock_t *expired);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -42,6 +42,38 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_qid2wq_work
+ *
+ * Description:
+ *   Return the queue of 'qid' that 'work' was last queued to.  With per-CPU
+ *   work queues that may be the queue of any CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+static FAR struct kwork_wqueue_s *work_qid2wq_work(int qid,
+                                                   FAR struct work_s *work)
+{
+  int cpu;
+
+  if (work != NULL)
+    {
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          if (work->wq != NULL && work->wq == work_cpu2wq(qid, cpu))
+            {
+              return work->wq;
+            }
+        }
+    }
+
+  return work_qid2wq(qid);
+}
+#else
+#  define work_qid2wq_work(qid, work) work_qid2wq(qid)
+#endif
+
 static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, bool sync,
                         FAR struct work_s *work)
 {
@@ -124,7 +156,7 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, bool sync,
 
 int work_cancel(int qid, FAR struct work_s *work)
 {
-  return work_qcancel(work_qid2wq(qid), false, work);
+  return work_qcancel(work_qid2wq_work(qid, work), false, work);
 }
 
 int work_cancel_wq(FAR struct kwork_wqueue_s *wqueue,
@@ -159,7 +191,7 @@ int work_cancel_wq(FAR struct kwork_wqueue_s *wqueue,
 
 int work_cancel_sync(int qid, FAR struct work_s *work)
 {
-  return work_qcancel(work_qid2wq(qid), true, work);
+  return work_qcancel(work_qid2wq_work(qid, work), true, work);
 }
 
 int work_cancel_sync_wq(FAR struct kwork_wqueue_s *wqueue,
@@ -147,11 +147,13 @@ int work_queue_wq(FAR struct kwork_wqueue_s *wqueue,
 
   flags = enter_critical_section();
 
-  /* Remove the entry from the timer and work queue. */
+  /* Remove the entry from the timer and work queue.  That is the queue it
+   * was queued to, which may be another CPU's queue.
+   */
 
   if (work->worker != NULL)
     {
-      work_cancel_wq(wqueue, work);
+      work_cancel_wq(work->wq, work);
     }
 
   if (work_is_canceling(wqueue->worker, wqueue->nthreads, work))
@@ -187,4 +189,28 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
   return work_queue_wq(work_qid2wq(qid), work, worker, arg, delay);
 }
 
+/****************************************************************************
+ * Name: work_queue_on
+ *
+ * Description:
+ *   Queue work to the worker thread of the work queue 'qid' that is bound
+ *   to 'cpu'.
+ *
+ ****************************************************************************/
+
+int work_queue_on(int qid, int cpu, FAR struct work_s *work,
+                  worker_t worker, FAR void *arg, clock_t delay)
+{
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  FAR struct kwork_wqueue_s *wqueue = work_cpu2wq(qid, cpu);
+
+  if (wqueue != NULL)
+    {
+      return work_queue_wq(wqueue, work, worker, arg, delay);
+    }
+#endif
+
+  return work_queue(qid, work, worker, arg, delay);
+}
+
 #endif /* CONFIG_SCHED_WORKQUEUE */
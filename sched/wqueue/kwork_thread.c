@@ -104,6 +104,17 @@ struct lp_wqueue_s g_lpwork =
 
 #endif /* CONFIG_SCHED_LPWORK */
 
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+/* The work queues bound to each CPU */
+
+#  ifdef CONFIG_SCHED_HPWORK
+FAR struct kwork_wqueue_s *g_hpwork_percpu[CONFIG_SMP_NCPUS];
+#  endif
+#  ifdef CONFIG_SCHED_LPWORK
+FAR struct kwork_wqueue_s *g_lpwork_percpu[CONFIG_SMP_NCPUS];
+#  endif
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -282,6 +293,56 @@ static int work_thread_create(FAR const char *name, int priority,
   return OK;
 }
 
+/****************************************************************************
+ * Name: work_start_percpu
+ *
+ * Description:
+ *   Create one work queue with a single worker thread for each CPU and
+ *   bind the worker thread to its CPU.
+ *
+ * Input Parameters:
+ *   name       - Name prefix of the new tasks
+ *   priority   - Priority of the new tasks
+ *   stack_size - Size (in bytes) of the stack needed
+ *   percpu     - Receives the work queue handles
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+static int work_start_percpu(FAR const char *name, int priority,
+                             int stack_size,
+                             FAR struct kwork_wqueue_s **percpu)
+{
+  char cpuname[32];
+  int cpu;
+  int ret;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      snprintf(cpuname, sizeof(cpuname), "%s%d", name, cpu);
+
+      percpu[cpu] = work_queue_create(cpuname, priority, stack_size, 1);
+      if (percpu[cpu] == NULL)
+        {
+          serr("ERROR: Failed to create %s\n", cpuname);
+          return -ENOMEM;
+        }
+
+      ret = work_queue_bind_wq(percpu[cpu], cpu);
+      if (ret < 0)
+        {
+          serr("ERROR: Failed to bind %s: %d\n", cpuname, ret);
+          return ret;
+        }
+    }
+
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -435,6 +496,50 @@ int work_queue_priority(int qid)
   return work_queue_priority_wq(work_qid2wq(qid));
 }
 
+/****************************************************************************
+ * Name: work_queue_bind_wq
+ *
+ * Description:
+ *   Bind all worker threads of a work queue to one CPU.
+ *
+ * Input Parameters:
+ *   wqueue - The work queue handle
+ *   cpu    - The CPU to run the worker threads on
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+int work_queue_bind_wq(FAR struct kwork_wqueue_s *wqueue, int cpu)
+{
+  cpu_set_t cpuset;
+  int wndx;
+  int ret;
+
+  if (wqueue == NULL || cpu < 0 || cpu >= CONFIG_SMP_NCPUS)
+    {
+      return -EINVAL;
+    }
+
+  CPU_ZERO(&cpuset);
+  CPU_SET(cpu, &cpuset);
+
+  for (wndx = 0; wndx < wqueue->nthreads; wndx++)
+    {
+      ret = nxsched_set_affinity(wqueue->worker[wndx].pid,
+                                 sizeof(cpu_set_t), &cpuset);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: work_start_highpri
  *
@@ -453,13 +558,30 @@ int work_queue_priority(int qid)
 #ifdef CONFIG_SCHED_HPWORK
 int work_start_highpri(void)
 {
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  int ret;
+#endif
+
   /* Start the high-priority, kernel mode worker thread(s) */
 
   sinfo("Starting high-priority kernel worker thread(s)\n");
 
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  ret = work_thread_create(HPWORKNAME, CONFIG_SCHED_HPWORKPRIORITY,
+                           CONFIG_SCHED_HPWORKSTACKSIZE,
+                           (FAR struct kwork_wqueue_s *)&g_hpwork);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return work_start_percpu(HPWORKNAME, CONFIG_SCHED_HPWORKPRIORITY,
+                           CONFIG_SCHED_HPWORKSTACKSIZE, g_hpwork_percpu);
+#else
   return work_thread_create(HPWORKNAME, CONFIG_SCHED_HPWORKPRIORITY,
                             CONFIG_SCHED_HPWORKSTACKSIZE,
                             (FAR struct kwork_wqueue_s *)&g_hpwork);
+#endif
 }
 #endif /* CONFIG_SCHED_HPWORK */
 
@@ -481,13 +603,30 @@ int work_start_highpri(void)
 #ifdef CONFIG_SCHED_LPWORK
 int work_start_lowpri(void)
 {
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  int ret;
+#endif
+
   /* Start the low-priority, kernel mode worker thread(s) */
 
   sinfo("Starting low-priority kernel worker thread(s)\n");
 
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  ret = work_thread_create(LPWORKNAME, CONFIG_SCHED_LPWORKPRIORITY,
+                           CONFIG_SCHED_LPWORKSTACKSIZE,
+                           (FAR struct kwork_wqueue_s *)&g_lpwork);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return work_start_percpu(LPWORKNAME, CONFIG_SCHED_LPWORKPRIORITY,
+                           CONFIG_SCHED_LPWORKSTACKSIZE, g_lpwork_percpu);
+#else
   return work_thread_create(LPWORKNAME, CONFIG_SCHED_LPWORKPRIORITY,
                             CONFIG_SCHED_LPWORKSTACKSIZE,
                             (FAR struct kwork_wqueue_s *)&g_lpwork);
+#endif
 }
 #endif /* CONFIG_SCHED_LPWORK */
 
@@ -126,6 +126,17 @@ extern struct hp_wqueue_s g_hpwork;
 extern struct lp_wqueue_s g_lpwork;
 #endif
 
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+/* The work queues bound to each CPU */
+
+#  ifdef CONFIG_SCHED_HPWORK
+extern FAR struct kwork_wqueue_s *g_hpwork_percpu[CONFIG_SMP_NCPUS];
+#  endif
+#  ifdef CONFIG_SCHED_LPWORK
+extern FAR struct kwork_wqueue_s *g_lpwork_percpu[CONFIG_SMP_NCPUS];
+#  endif
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -151,6 +162,35 @@ static inline_function FAR struct kwork_wqueue_s *work_qid2wq(int qid)
     }
 }
 
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+static inline_function FAR struct kwork_wqueue_s *
+work_cpu2wq(int qid, int cpu)
+{
+  if (cpu < 0 || cpu >= CONFIG_SMP_NCPUS)
+    {
+      return NULL;
+    }
+
+#ifdef CONFIG_SCHED_HPWORK
+  if (qid == HPWORK)
+    {
+      return g_hpwork_percpu[cpu];
+    }
+  else
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+  if (qid == LPWORK)
+    {
+      return g_lpwork_percpu[cpu];
+    }
+  else
+#endif
+    {
+      return NULL;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: work_start_highpri
  *
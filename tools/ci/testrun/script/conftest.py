@@ -79,6 +79,19 @@ def pytest_addoption(parser):
         default="sim",
         help="specify the target type: target|qemu|sim|module, default is sim",
     )
+    parser.addoption(
+        "--perf-repeat",
+        action="store",
+        type=int,
+        default=3,
+        help="specify the runs of each benchmark of test_perf, default is 3",
+    )
+    parser.addoption(
+        "--perf-json",
+        action="store",
+        default=None,
+        help="specify the report of test_perf, default is <log path>/perf.json",
+    )
 
 
 @pytest.fixture(scope="session")
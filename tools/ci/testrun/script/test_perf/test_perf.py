@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+############################################################################
+# tools/ci/testrun/script/test_perf/test_perf.py
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed to the Apache Software Foundation (ASF) under one or more
+# contributor license agreements.  See the NOTICE file distributed with
+# this work for additional information regarding copyright ownership.  The
+# ASF licenses this file to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance with the
+# License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+# License for the specific language governing permissions and limitations
+# under the License.
+#
+############################################################################
+# encoding: utf-8
+
+# Performance suite, meant for the sim:perf configuration (or a QEMU
+# configuration with the same applications).  Every benchmark is run
+# --perf-repeat times and the median is written, with all the samples, to
+# --perf-json.  Compare two of these reports with tools/perfcompare.py.
+#
+# A benchmark whose command is not built into the image is skipped, so the
+# suite can be run on any configuration.
+
+import json
+import os
+import statistics
+import subprocess
+import time
+
+import pytest
+
+pytestmark = [pytest.mark.perf, pytest.mark.disable_autouse]
+
+# The time measured by the nsh "time" command, and the bandwidth reported
+# by the iperf client
+
+ELAPSED = r"command not found|(\d+\.\d+) sec\r?\n"
+BANDWIDTH = r"command not found|(\d+\.\d+) Mbits/sec"
+
+PERF_MOUNT = "/perf"
+PERF_FILE = PERF_MOUNT + "/perf.bin"
+
+# name, command, pattern, unit, better
+
+BENCHMARKS = [
+    ("sched_ipc", 'time "osperf"', ELAPSED, "sec", "lower"),
+    ("heap", 'time "mm"', ELAPSED, "sec", "lower"),
+    (
+        "vfs_write",
+        'time "dd if=/dev/zero of=%s bs=4096 count=1024"' % PERF_FILE,
+        ELAPSED,
+        "sec",
+        "lower",
+    ),
+    (
+        "vfs_read",
+        'time "dd if=%s of=/dev/null bs=4096"' % PERF_FILE,
+        ELAPSED,
+        "sec",
+        "lower",
+    ),
+    ("md5", 'time "md5 -f %s"' % PERF_FILE, ELAPSED, "sec", "lower"),
+    ("aescbc", 'time "aescbc"', ELAPSED, "sec", "lower"),
+    ("hmac", 'time "hmac"', ELAPSED, "sec", "lower"),
+    (
+        "tcp_loopback",
+        "iperf -c 127.0.0.1 -p 5001 -t 5 -i 5",
+        BANDWIDTH,
+        "Mbits/sec",
+        "higher",
+    ),
+    (
+        "udp_loopback",
+        "iperf -c 127.0.0.1 -u -p 5002 -t 5 -i 5",
+        BANDWIDTH,
+        "Mbits/sec",
+        "higher",
+    ),
+]
+
+
+def get_commit(path):
+    try:
+        return (
+            subprocess.check_output(
+                ["git", "-C", path, "rev-parse", "HEAD"], stderr=subprocess.DEVNULL
+            )
+            .decode()
+            .strip()
+        )
+    except Exception:
+        return "unknown"
+
+
+@pytest.fixture(scope="module", name="report")
+def perf_report(request, p):
+    repeat = request.config.getoption("--perf-repeat")
+    output = request.config.getoption("--perf-json")
+    if output is None:
+        output = os.path.join(p.log_path, "perf.json")
+
+    p.sendCommand("mkdir %s" % PERF_MOUNT)
+    p.sendCommand("mount -t tmpfs %s" % PERF_MOUNT)
+    p.sendCommand("iperf -s -p 5001 &")
+    p.sendCommand("iperf -s -u -p 5002 &")
+
+    report = {
+        "board": p.board,
+        "target": p.target,
+        "commit": get_commit(p.path or "."),
+        "date": time.strftime("%Y-%m-%dT%H:%M:%S", time.localtime()),
+        "repeat": repeat,
+        "benchmarks": {},
+    }
+    yield repeat, report
+
+    p.sendCommand("rm %s" % PERF_FILE)
+    p.sendCommand("umount %s" % PERF_MOUNT)
+
+    with open(output, "w") as f:
+        json.dump(report, f, indent=2, sort_keys=True)
+    print("perf report: %s" % output)
+
+
+@pytest.mark.parametrize(
+    "name,cmd,pattern,unit,better", BENCHMARKS, ids=[b[0] for b in BENCHMARKS]
+)
+def test_perf(p, report, name, cmd, pattern, unit, better):
+    repeat, result = report
+    samples = []
+
+    for i in range(repeat):
+        ret = p.sendCommand(cmd, pattern, timeout=300)
+        assert ret == 0
+        value = p.process.match.group(1)
+        if value is None:
+            pytest.skip("'%s' is not in this image" % cmd)
+        samples.append(float(value))
+
+    result["benchmarks"][name] = {
+        "command": cmd,
+        "unit": unit,
+        "better": better,
+        "samples": samples,
+        "value": statistics.median(samples),
+    }
@@ -30,6 +30,8 @@ import sys
 
 import lzf
 
+LZ4_MAGIC = b"\x04\x22\x4d\x18"
+
 
 def decompress(lzffile, outfile):
     chunk_number = 1
@@ -58,6 +60,18 @@ def decompress(lzffile, outfile):
         chunk_number += 1
 
 
+def decompress_lz4(lz4file, outfile):
+    import lz4.frame
+
+    # The stream is made of concatenated frames, one per flush
+
+    data = lz4file.read()
+    while data[:4] == LZ4_MAGIC:
+        decompressor = lz4.frame.LZ4FrameDecompressor()
+        outfile.write(decompressor.decompress(data))
+        data = decompressor.unused_data
+
+
 def unhexlify(infile, outfile):
     for line in infile.readlines():
         line = line.strip()
@@ -133,6 +147,13 @@ def main():
         tmpfile.close()
         outfile.close()
         os.unlink(tmp)
+    elif lzfhdr + tmpfile.read(2) == LZ4_MAGIC:
+        outfile = open(args.output, "wb")
+        tmpfile.seek(0, 0)
+        decompress_lz4(tmpfile, outfile)
+        tmpfile.close()
+        outfile.close()
+        os.unlink(tmp)
     else:
         tmpfile.close()
         os.rename(tmp, args.output)
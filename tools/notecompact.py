@@ -0,0 +1,244 @@
+#!/usr/bin/env python3
+############################################################################
+# tools/notecompact.py
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed to the Apache Software Foundation (ASF) under one or more
+# contributor license agreements.  See the NOTICE file distributed with
+# this work for additional information regarding copyright ownership.  The
+# ASF licenses this file to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance with the
+# License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+# License for the specific language governing permissions and limitations
+# under the License.
+#
+############################################################################
+
+# Convert the compact note stream of CONFIG_DRIVERS_NOTESTREAM_COMPACT,
+# captured from the lower output or the note file, to a systrace text file
+# that Perfetto (ui.perfetto.dev) opens.  The encoding is described in
+# include/nuttx/note/notestream_driver.h.
+
+import argparse
+import struct
+import sys
+
+RECORD_SYNC = 0xFF
+RECORD_STRING = 0xFE
+
+FLAG_CPU = 1 << 0
+FLAG_PID = 1 << 1
+FLAG_PRIO = 1 << 2
+
+# enum note_type_e of include/nuttx/sched_note.h
+
+NOTE_START = 0
+NOTE_STOP = 1
+NOTE_SUSPEND = 2
+NOTE_RESUME = 3
+NOTE_IRQ_ENTER = 20
+NOTE_IRQ_LEAVE = 21
+NOTE_DUMP_BEGIN = 31
+NOTE_DUMP_END = 32
+NOTE_DUMP_MARK = 33
+
+
+class Decoder:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+        self.synced = False
+        self.freq = 1
+        self.ptrsize = 4
+        self.names = {}
+        self.tasks = {0: "Idle_Task"}
+        self.running = {}
+        self.systime = 0
+        self.cpu = 0
+        self.pid = 0
+        self.prio = 0
+
+    def byte(self):
+        value = self.data[self.pos]
+        self.pos += 1
+        return value
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            byte = self.byte()
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if byte < 0x80:
+                return value
+
+    def bytes(self, length):
+        value = self.data[self.pos : self.pos + length]
+        if len(value) < length:
+            raise IndexError
+        self.pos += length
+        return value
+
+    def sync(self):
+        if self.bytes(4) != b"NXTC" or self.byte() != 1:
+            return False
+
+        self.ptrsize = self.byte()
+        self.freq = self.varint() or 1
+        self.systime = self.varint()
+        self.names = {}
+        self.synced = True
+        return True
+
+    def resync(self):
+        # Skip to the next sync record, after a loss of data or when the
+        # capture started in the middle of the stream
+
+        index = self.data.find(b"\xffNXTC", self.pos)
+        if index < 0:
+            self.pos = len(self.data)
+        else:
+            self.pos = index
+
+    def records(self):
+        while self.pos < len(self.data):
+            start = self.pos
+            try:
+                rtype = self.byte()
+                if rtype == RECORD_SYNC:
+                    if not self.sync():
+                        self.synced = False
+                        self.pos = start + 1
+                        self.resync()
+                    continue
+
+                if not self.synced:
+                    self.pos = start + 1
+                    self.resync()
+                    continue
+
+                if rtype == RECORD_STRING:
+                    ident = self.varint()
+                    self.names[ident] = self.bytes(self.varint()).decode(
+                        errors="replace"
+                    )
+                    continue
+
+                flags = self.byte()
+                delta = self.varint()
+                self.systime += (delta >> 1) ^ -(delta & 1)
+                if flags & FLAG_CPU:
+                    self.cpu = self.byte()
+                if flags & FLAG_PID:
+                    self.pid = self.varint()
+                if flags & FLAG_PRIO:
+                    self.prio = self.byte()
+                payload = self.bytes(self.varint())
+            except IndexError:
+                return
+
+            yield rtype, payload
+
+    def pointer(self, payload):
+        fmt = "<Q" if self.ptrsize == 8 else "<I"
+        return struct.unpack_from(fmt, payload)[0]
+
+    def event(self, rtype, payload):
+        if rtype == NOTE_START:
+            self.tasks[self.pid] = self.names.get(
+                Decoder(payload).varint(), str(self.pid)
+            )
+            return "sched_wakeup_new: comm=%s pid=%d prio=%d target_cpu=%03d" % (
+                self.comm(self.pid),
+                self.pid,
+                self.prio,
+                self.cpu,
+            )
+
+        if rtype == NOTE_SUSPEND:
+            self.running[self.cpu] = (self.pid, self.prio)
+            return None
+
+        if rtype == NOTE_RESUME:
+            prev_pid, prev_prio = self.running.get(self.cpu, (0, 0))
+            self.running[self.cpu] = (self.pid, self.prio)
+            return (
+                "sched_switch: prev_comm=%s prev_pid=%d prev_prio=%d "
+                "prev_state=S ==> next_comm=%s next_pid=%d next_prio=%d"
+                % (
+                    self.comm(prev_pid),
+                    prev_pid,
+                    prev_prio,
+                    self.comm(self.pid),
+                    self.pid,
+                    self.prio,
+                )
+            )
+
+        if rtype in (NOTE_IRQ_ENTER, NOTE_IRQ_LEAVE):
+            irq = payload[self.ptrsize] if len(payload) > self.ptrsize else 0
+            if rtype == NOTE_IRQ_ENTER:
+                return "irq_handler_entry: irq=%d name=%#x" % (
+                    irq,
+                    self.pointer(payload),
+                )
+            return "irq_handler_exit: irq=%d ret=handled" % irq
+
+        if rtype in (NOTE_DUMP_BEGIN, NOTE_DUMP_END, NOTE_DUMP_MARK):
+            data = payload[self.ptrsize :].split(b"\0")[0].decode(errors="replace")
+            if not data:
+                data = "%#x" % self.pointer(payload)
+            mark = {NOTE_DUMP_BEGIN: "B", NOTE_DUMP_END: "E", NOTE_DUMP_MARK: "I"}
+            return "tracing_mark_write: %s|%d|%s" % (mark[rtype], self.pid, data)
+
+        return None
+
+    def comm(self, pid):
+        return self.tasks.get(pid, str(pid)).replace(" ", "_")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert a compact note stream to a systrace text file"
+    )
+    parser.add_argument("input", help="the captured compact note stream")
+    parser.add_argument(
+        "-o", "--output", help="the systrace text file, stdout by default"
+    )
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        decoder = Decoder(f.read())
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    out.write("# tracer: nop\n#\n")
+    for rtype, payload in decoder.records():
+        line = decoder.event(rtype, payload)
+        if line is None:
+            continue
+
+        out.write(
+            "%16s-%-5d [%03d] %12.6f: %s\n"
+            % (
+                decoder.comm(decoder.pid)[:16],
+                decoder.pid,
+                decoder.cpu,
+                decoder.systime / decoder.freq,
+                line,
+            )
+        )
+
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -332,6 +332,8 @@ static const char *g_white_content_list[] =
    * fs/nfs/nfs_vfsops.c
    */
 
+  "COMMIT3args",
+  "COMMIT3resok",
   "CREATE3args",
   "CREATE3resok",
   "LOOKUP3args",
@@ -617,6 +619,11 @@ static const char *g_white_content_list[] =
   "unzGetCurrentFileInfo64",
   "unzGoToNextFile",
   "unzGoToFirstFile",
+  "unzGetCurrentFileZStreamPos64",
+  "inflateInit2",
+  "inflateReset",
+  "inflatePrime",
+  "inflateSetDictionary",
   NULL
 };
 
@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+# tools/perfcompare.py
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed to the Apache Software Foundation (ASF) under one or more
+# contributor license agreements.  See the NOTICE file distributed with
+# this work for additional information regarding copyright ownership.  The
+# ASF licenses this file to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance with the
+# License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+# License for the specific language governing permissions and limitations
+# under the License.
+#
+import argparse
+import json
+import sys
+
+program_description = """
+This program compares two reports of the test_perf suite of
+tools/ci/testrun, a baseline and a new run, and flags the benchmarks
+that became slower than the threshold allows.  It exits with 1 if
+any benchmark regressed, 0 otherwise.
+"""
+
+
+def load_report(path):
+    with open(path) as f:
+        report = json.load(f)
+    if "benchmarks" not in report:
+        sys.exit("%s: not a perf report" % path)
+    return report
+
+
+def parse_thresholds(args):
+    thresholds = {}
+    for item in args or []:
+        name, sep, value = item.partition("=")
+        if not sep:
+            sys.exit("bad threshold '%s', expected <name>=<percent>" % item)
+        thresholds[name] = float(value)
+    return thresholds
+
+
+def compare(baseline, current, threshold, thresholds):
+    """Return the rows of the comparison and the number of regressions"""
+
+    rows = []
+    regressions = 0
+
+    for name in sorted(set(baseline) | set(current)):
+        if name not in current:
+            rows.append((name, baseline[name]["value"], None, None, "missing"))
+            continue
+        if name not in baseline:
+            rows.append((name, None, current[name]["value"], None, "new"))
+            continue
+
+        base = baseline[name]["value"]
+        value = current[name]["value"]
+        better = baseline[name].get("better", "lower")
+        limit = thresholds.get(name, threshold)
+
+        if base == 0:
+            rows.append((name, base, value, None, "ok"))
+            continue
+
+        # The change is positive when the benchmark became slower
+
+        change = (value - base) * 100.0 / base
+        if better == "higher":
+            change = -change
+
+        if change > limit:
+            status = "REGRESSED"
+            regressions += 1
+        elif change < -limit:
+            status = "improved"
+        else:
+            status = "ok"
+
+        rows.append((name, base, value, change, status))
+
+    return rows, regressions
+
+
+def print_rows(rows):
+    def fmt(value):
+        return "-" if value is None else "%.4f" % value
+
+    print("%-20s %14s %14s %9s" % ("benchmark", "baseline", "current", "slower"))
+    for name, base, value, change, status in rows:
+        print(
+            "%-20s %14s %14s %9s  %s"
+            % (
+                name,
+                fmt(base),
+                fmt(value),
+                "-" if change is None else "%+.1f%%" % change,
+                status,
+            )
+        )
+
+
+def main():
+    parser = argparse.ArgumentParser(description=program_description)
+    parser.add_argument("baseline", help="report of the baseline commit")
+    parser.add_argument("current", help="report of the commit to check")
+    parser.add_argument(
+        "-t",
+        "--threshold",
+        type=float,
+        default=5.0,
+        help="percent of slowdown that is a regression, default is 5",
+    )
+    parser.add_argument(
+        "-T",
+        "--benchmark-threshold",
+        action="append",
+        metavar="NAME=PERCENT",
+        help="threshold of one benchmark, may be repeated",
+    )
+    parser.add_argument(
+        "-s",
+        "--strict",
+        action="store_true",
+        help="also fail if a benchmark of the baseline is missing",
+    )
+    args = parser.parse_args()
+
+    baseline = load_report(args.baseline)
+    current = load_report(args.current)
+
+    if baseline.get("board") != current.get("board"):
+        print(
+            "warning: comparing board %s with %s"
+            % (baseline.get("board"), current.get("board"))
+        )
+
+    print("baseline: %s" % baseline.get("commit", "unknown"))
+    print("current:  %s" % current.get("commit", "unknown"))
+
+    rows, regressions = compare(
+        baseline["benchmarks"],
+        current["benchmarks"],
+        args.threshold,
+        parse_thresholds(args.benchmark_threshold),
+    )
+    print_rows(rows)
+
+    missing = sum(1 for row in rows if row[4] == "missing")
+    if regressions or (args.strict and missing):
+        print("%d benchmark(s) regressed, %d missing" % (regressions, missing))
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()